@@ -1,10 +1,34 @@
 #include "agent_manager.hpp"
 
+#include <juce_events/juce_events.h>
+
 #include <algorithm>
 
-AgentManager::AgentManager() {}
+#include "core/UndoManager.hpp"
+
+AgentManager::AgentManager()
+    : mutations_(std::make_shared<MutationQueue>()),
+      pool_(std::make_unique<juce::ThreadPool>(
+          juce::jlimit(2, 8, juce::SystemStats::getNumCpus()))) {}
 
 AgentManager::~AgentManager() {
+    {
+        std::lock_guard<std::mutex> lock(agentsMutex_);
+        for (const auto& pair : mailboxes_) {
+            closeMailbox(*pair.second);
+        }
+    }
+
+    // Waits for any message being processed; the jobs left see closed mailboxes
+    pool_->removeAllJobs(true, 10000);
+    pool_.reset();
+
+    {
+        std::lock_guard<std::mutex> lock(mutations_->mutex);
+        mutations_->closed = true;
+        mutations_->pending.clear();
+    }
+
     stopAllAgents();
 }
 
@@ -34,6 +58,10 @@ bool AgentManager::registerAgent(std::shared_ptr<AgentInterface> agent) {
         return false;
     }
 
+    auto mailbox = std::make_shared<Mailbox>();
+    mailbox->agent = agent;
+    mailboxes_[agentId] = mailbox;
+
     return true;
 }
 
@@ -45,6 +73,11 @@ bool AgentManager::unregisterAgent(const std::string& agentId) {
         return false;
     }
 
+    if (auto box = mailboxes_.find(agentId); box != mailboxes_.end()) {
+        closeMailbox(*box->second);
+        mailboxes_.erase(box);
+    }
+
     // Stop the agent
     it->second->stop();
     agents_.erase(it);
@@ -76,22 +109,100 @@ std::vector<std::shared_ptr<AgentInterface>> AgentManager::getAllAgents() const
     return result;
 }
 
+AgentManager::Delivery AgentManager::postToAgent(const std::string& agentId,
+                                                 const std::string& message,
+                                                 ResponseCallback onResponse) {
+    Delivery delivery;
+
+    auto mailbox = findMailbox(agentId);
+    if (!mailbox || !mailbox->agent->isRunning()) {
+        return delivery;
+    }
+
+    bool schedule = false;
+    {
+        std::lock_guard<std::mutex> lock(mailbox->mutex);
+        if (mailbox->closed || mailbox->queue.size() >= mailboxCapacity_) {
+            return delivery;
+        }
+
+        Envelope envelope;
+        envelope.message = message;
+        envelope.onResponse = std::move(onResponse);
+        delivery.response = envelope.response.get_future();
+        delivery.accepted = true;
+        mailbox->queue.push_back(std::move(envelope));
+
+        schedule = !mailbox->scheduled;
+        mailbox->scheduled = true;
+    }
+
+    if (schedule) {
+        pool_->addJob([this, mailbox] { processNext(mailbox); });
+    }
+    return delivery;
+}
+
 std::string AgentManager::sendToAgent(const std::string& agentId, const std::string& message) {
-    auto agent = getAgent(agentId);
-    if (agent && agent->isRunning()) {
-        return agent->processMessage(message);
+    auto delivery = postToAgent(agentId, message);
+    if (!delivery.accepted) {
+        return "";
     }
 
-    return "";
+    return delivery.response.get();
 }
 
-void AgentManager::broadcastMessage(const std::string& message) {
+size_t AgentManager::broadcastMessage(const std::string& message) {
+    std::vector<std::string> agentIds;
+    {
+        std::lock_guard<std::mutex> lock(agentsMutex_);
+        for (const auto& pair : agents_) {
+            agentIds.push_back(pair.first);
+        }
+    }
+
+    size_t accepted = 0;
+    for (const auto& agentId : agentIds) {
+        if (postToAgent(agentId, message).accepted) {
+            ++accepted;
+        }
+    }
+    return accepted;
+}
+
+size_t AgentManager::getPendingMessageCount(const std::string& agentId) const {
+    auto mailbox = findMailbox(agentId);
+    if (!mailbox) {
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> lock(mailbox->mutex);
+    return mailbox->queue.size();
+}
+
+void AgentManager::setMailboxCapacity(size_t capacity) {
     std::lock_guard<std::mutex> lock(agentsMutex_);
+    mailboxCapacity_ = std::max<size_t>(1, capacity);
+}
 
-    for (const auto& pair : agents_) {
-        if (pair.second->isRunning()) {
-            pair.second->processMessage(message);
+void AgentManager::postToMessageThread(std::function<void()> mutation) {
+    if (!mutation) {
+        return;
+    }
+
+    bool schedule = false;
+    {
+        std::lock_guard<std::mutex> lock(mutations_->mutex);
+        if (mutations_->closed) {
+            return;
         }
+        mutations_->pending.push_back(std::move(mutation));
+        schedule = !mutations_->flushScheduled;
+        mutations_->flushScheduled = true;
+    }
+
+    if (schedule) {
+        juce::MessageManager::callAsync([queue = mutations_] { flushMutations(*queue); });
     }
 }
 
@@ -120,6 +231,85 @@ void AgentManager::stopAllAgents() {
     }
 }
 
+std::shared_ptr<AgentManager::Mailbox> AgentManager::findMailbox(
+    const std::string& agentId) const {
+    std::lock_guard<std::mutex> lock(agentsMutex_);
+
+    auto it = mailboxes_.find(agentId);
+    return it != mailboxes_.end() ? it->second : nullptr;
+}
+
+void AgentManager::processNext(const std::shared_ptr<Mailbox>& mailbox) {
+    Envelope envelope;
+    {
+        std::lock_guard<std::mutex> lock(mailbox->mutex);
+        if (mailbox->closed || mailbox->queue.empty()) {
+            mailbox->scheduled = false;
+            return;
+        }
+        envelope = std::move(mailbox->queue.front());
+        mailbox->queue.pop_front();
+    }
+
+    std::string response;
+    if (mailbox->agent->isRunning()) {
+        try {
+            response = mailbox->agent->processMessage(envelope.message);
+        } catch (const std::exception& e) {
+            juce::Logger::writeToLog("Agent " + mailbox->agent->getId() +
+                                     " failed to process message: " + e.what());
+        }
+    }
+
+    envelope.response.set_value(response);
+    if (envelope.onResponse) {
+        juce::MessageManager::callAsync(
+            [callback = std::move(envelope.onResponse), response] { callback(response); });
+    }
+
+    // One message per job, so agents sharing the pool take turns
+    bool more = false;
+    {
+        std::lock_guard<std::mutex> lock(mailbox->mutex);
+        more = !mailbox->closed && !mailbox->queue.empty();
+        mailbox->scheduled = more;
+    }
+    if (more) {
+        pool_->addJob([this, mailbox] { processNext(mailbox); });
+    }
+}
+
+void AgentManager::closeMailbox(Mailbox& mailbox) {
+    std::lock_guard<std::mutex> lock(mailbox.mutex);
+
+    mailbox.closed = true;
+    for (auto& envelope : mailbox.queue) {
+        envelope.response.set_value("");
+    }
+    mailbox.queue.clear();
+}
+
+void AgentManager::flushMutations(MutationQueue& queue) {
+    std::vector<std::function<void()>> batch;
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        batch.swap(queue.pending);
+        queue.flushScheduled = false;
+        if (queue.closed) {
+            return;
+        }
+    }
+
+    if (batch.empty()) {
+        return;
+    }
+
+    magda::CompoundOperationScope scope("Agent Edit");
+    for (auto& mutation : batch) {
+        mutation();
+    }
+}
+
 void AgentManager::handleAgentMessage(const std::string& fromAgent, const std::string& message) {
     // For now, just log the message
     // In the future, this could route messages between agents or to the DAW
@@ -2,6 +2,10 @@
 
 #include <juce_core/juce_core.h>
 
+#include <deque>
+#include <functional>
+#include <future>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <vector>
@@ -13,9 +17,27 @@
  *
  * The AgentManager coordinates communication between agents and the DAW,
  * handles agent lifecycle, and provides a simple message routing system.
+ *
+ * Each agent has a mailbox, drained by a shared worker pool one message at a time, so an
+ * agent sees its messages in order while a slow one (an LLM round trip) only holds up its
+ * own queue. Mailboxes are bounded: a post to a full one is refused rather than queued, so
+ * a caller outpacing an agent finds out. Agents run off the message thread and must not
+ * touch the project directly; they hand edits to postToMessageThread() instead.
  */
 class AgentManager {
   public:
+    using ResponseCallback = std::function<void(const std::string& response)>;
+
+    static constexpr size_t kDefaultMailboxCapacity = 64;
+
+    /**
+     * @brief Outcome of posting a message to an agent
+     */
+    struct Delivery {
+        bool accepted = false;               // false: unknown, stopped or mailbox full
+        std::future<std::string> response;  // Valid only if accepted
+    };
+
     AgentManager();
     ~AgentManager();
 
@@ -47,18 +69,52 @@ class AgentManager {
     std::vector<std::shared_ptr<AgentInterface>> getAllAgents() const;
 
     /**
-     * @brief Send a message to a specific agent
+     * @brief Queue a message for an agent without waiting for it
      * @param agentId The ID of the target agent
      * @param message The message to send
-     * @return The agent's response (empty if no response)
+     * @param onResponse Called on the message thread with the agent's response
+     * @return Whether the message was queued, and a future for the response
+     */
+    Delivery postToAgent(const std::string& agentId, const std::string& message,
+                         ResponseCallback onResponse = nullptr);
+
+    /**
+     * @brief Send a message to a specific agent and wait for its response
+     *
+     * Blocks only the caller. Must not be called from the target agent's own
+     * processMessage(), which would wait on itself.
+     *
+     * @param agentId The ID of the target agent
+     * @param message The message to send
+     * @return The agent's response (empty if no response or the message was refused)
      */
     std::string sendToAgent(const std::string& agentId, const std::string& message);
 
     /**
-     * @brief Broadcast a message to all agents
+     * @brief Queue a message for every running agent
      * @param message The message to broadcast
+     * @return How many agents accepted it
      */
-    void broadcastMessage(const std::string& message);
+    size_t broadcastMessage(const std::string& message);
+
+    /**
+     * @brief Messages queued for an agent but not yet processed
+     */
+    size_t getPendingMessageCount(const std::string& agentId) const;
+
+    /**
+     * @brief Most messages a mailbox holds before posts to it are refused
+     */
+    void setMailboxCapacity(size_t capacity);
+
+    /**
+     * @brief Run a project edit on the message thread
+     *
+     * Safe from any thread. Edits posted before the message thread gets round to them run
+     * together, inside one undo step, so an agent issuing many small edits costs one sync
+     * of the engine rather than one per edit.
+     */
+    void postToMessageThread(std::function<void()> mutation);
 
     /**
      * @brief Get the number of registered agents
@@ -83,6 +139,38 @@ class AgentManager {
      */
     void handleAgentMessage(const std::string& fromAgent, const std::string& message);
 
+    struct Envelope {
+        std::string message;
+        std::promise<std::string> response;
+        ResponseCallback onResponse;
+    };
+
+    struct Mailbox {
+        std::shared_ptr<AgentInterface> agent;
+        std::mutex mutex;
+        std::deque<Envelope> queue;
+        bool scheduled = false;  // A pool job is queued or running for this mailbox
+        bool closed = false;     // Agent unregistered; refuse posts, drop the queue
+    };
+
+    struct MutationQueue {
+        std::mutex mutex;
+        std::vector<std::function<void()>> pending;
+        bool flushScheduled = false;
+        bool closed = false;
+    };
+
+    std::shared_ptr<Mailbox> findMailbox(const std::string& agentId) const;
+    void processNext(const std::shared_ptr<Mailbox>& mailbox);
+    static void closeMailbox(Mailbox& mailbox);
+    static void flushMutations(MutationQueue& queue);
+
     mutable std::mutex agentsMutex_;
     std::map<std::string, std::shared_ptr<AgentInterface>> agents_;
+    std::map<std::string, std::shared_ptr<Mailbox>> mailboxes_;
+    size_t mailboxCapacity_ = kDefaultMailboxCapacity;
+
+    // Shared with pending callAsync()s, which may outlive the manager
+    std::shared_ptr<MutationQueue> mutations_;
+    std::unique_ptr<juce::ThreadPool> pool_;
 };
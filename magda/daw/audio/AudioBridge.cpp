@@ -1,13 +1,70 @@
 #include "AudioBridge.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <utility>
 #include <unordered_set>
 
+#include "../core/AutomationRecorder.hpp"
+#include "../core/ClipCommands.hpp"
+#include "../core/ModulatorEngine.hpp"
+#include "../core/ProjectManager.hpp"
 #include "../engine/PluginWindowManager.hpp"
+#include "../profiling/MemoryAccounting.hpp"
+#include "../profiling/LoadProfiler.hpp"
+#include "../profiling/MemoryEstimates.hpp"
 #include "../profiling/PerformanceProfiler.hpp"
+#include "../profiling/RealtimeSafety.hpp"
+#include "AudioFileImporter.hpp"
+#include "DeviceTimingProbePlugin.hpp"
+#include "MidiNoteDiff.hpp"
+#include "RenderThreadPolicy.hpp"
+#include "SandboxedPlugin.hpp"
+#include "TrackMeterPlugin.hpp"
 
 namespace magda {
 
+namespace {
+
+// Per-plugin instantiation times for the startup / project load report
+void recordPluginLoad(const DeviceInfo& device, double startMs, bool loaded) {
+    LoadProfiler::getInstance().recordItem(
+        "Plugin", device.name + " (" + device.getFormatString() + ")", startMs,
+        juce::Time::getMillisecondCounterHiRes() - startMs, loaded);
+}
+
+// A plugin's full state as bytes, for state snapshots and comparing against them
+juce::MemoryBlock encodePluginState(te::Plugin& plugin) {
+    plugin.flushPluginStateToValueTree();
+    juce::MemoryBlock bytes;
+    {
+        juce::MemoryOutputStream stream(bytes, false);
+        plugin.state.writeToStream(stream);
+    }
+    return bytes;
+}
+
+// External devices, in racks too, that load in-process and so can come from the pool
+void collectPoolableDevices(const std::vector<ChainElement>& elements,
+                            std::vector<const DeviceInfo*>& devices) {
+    for (const auto& element : elements) {
+        if (isDevice(element)) {
+            const auto& device = getDevice(element);
+            if (device.format != PluginFormat::Internal && !device.sandboxed &&
+                (device.uniqueId.isNotEmpty() || device.fileOrIdentifier.isNotEmpty())) {
+                devices.push_back(&device);
+            }
+        } else {
+            for (const auto& chain : getRack(element).chains) {
+                collectPoolableDevices(chain.elements, devices);
+            }
+        }
+    }
+}
+
+}  // namespace
+
 AudioBridge::AudioBridge(te::Engine& engine, te::Edit& edit) : engine_(engine), edit_(edit) {
     // Register as TrackManager listener
     TrackManager::getInstance().addListener(this);
@@ -15,8 +72,64 @@ AudioBridge::AudioBridge(te::Engine& engine, te::Edit& edit) : engine_(engine),
     // Register as ClipManager listener
     ClipManager::getInstance().addListener(this);
 
+    // Deferred sync waits for compound operations to finish
+    UndoManager::getInstance().addListener(this);
+
+    // Automation lanes are compiled for playback on the audio thread
+    AutomationManager::getInstance().addListener(this);
+
+    // Mods are evaluated on the audio thread; the UI timer only reads them back
+    ModulatorEngine::getInstance().setValueSource([this] { return readBackModulation(); });
+
+    // Session launches are timed on the audio thread; the model follows once they fire
+    ClipManager::getInstance().setClipLauncher(this);
+    clipLaunchedSubscription_ =
+        subscribeToEvents(AudioEvent::Type::ClipLaunched, [](const AudioEvent& event) {
+            ClipManager::getInstance().clipLaunchFired(event.data1);
+        });
+    clipStoppedSubscription_ =
+        subscribeToEvents(AudioEvent::Type::ClipStopped, [](const AudioEvent& event) {
+            ClipManager::getInstance().clipStopFired(event.data1);
+        });
+    countInSubscription_ =
+        subscribeToEvents(AudioEvent::Type::CountInFinished, [this](const AudioEvent&) {
+            if (onCountInFinished) {
+                onCountInFinished();
+            }
+        });
+
+    // Input-to-output MIDI latency, measured on the audio thread
+    midiLatencySubscription_ =
+        subscribeToEvents(AudioEvent::Type::MidiLatency, [](const AudioEvent& event) {
+            static const Symbol category("MIDIInputLatency");
+            PerformanceMonitor::getInstance().addSample(category, event.data1 * 0.001);
+        });
+
+    // The disk couldn't keep up with the armed inputs; the takes get silence there
+    recordDropoutSubscription_ =
+        subscribeToEvents(AudioEvent::Type::RecordDropout, [](const AudioEvent& event) {
+            std::cerr << "Recording dropout: " << event.data1 << " input frames lost" << std::endl;
+        });
+
+    // Saves ask for the state of each instantiated plugin
+    ProjectManager::getInstance().setPluginStateProvider([this](DeviceId deviceId) {
+        return getPluginStateForSave(deviceId);
+    });
+
+    // Report the bridge and its plugins' state alongside the model in memory accounting
+    auto& memory = MemoryAccounting::getInstance();
+    memorySubscription_ = memory.addSource("Audio bridge", [this] { return getSizeInBytes(); });
+    pluginMemorySubscription_ =
+        memory.addSource("Plugin state", [this] { return getPluginStateSizeInBytes(); });
+    metricsSubscription_ = MetricsExporter::getInstance().addSource(
+        [this](MetricsWriter& writer) { writeMetrics(writer); });
+
+    // Constructed on the message thread; label it in exported traces
+    TraceRecorder::getInstance().setCurrentThreadName("Message");
+
     // Master metering will be registered when playback context is available
-    // (done in timerCallback when context exists)
+    // (done in timerCallback when context exists); taps listen to the render path itself
+    attachMasterTap();
 
     // Start timer for metering updates (30 FPS for smooth UI)
     startTimerHz(30);
@@ -32,10 +145,27 @@ AudioBridge::~AudioBridge() {
 
     // Stop timer immediately
     stopTimer();
+    cancelPendingUpdate();
+    pendingPluginLoads_.clear();
+    loadingDevices_.clear();
+    pluginPool_.clear();  // Warm instances belong to the Edit
+
+    // Hosts live as long as their plugins in the Edit; they mustn't call back into us
+    for (auto& [trackId, weakHost] : sandboxHosts_) {
+        if (auto host = weakHost.lock()) {
+            host->onPluginLoaded = nullptr;
+            host->onCrashed = nullptr;
+        }
+    }
 
     // Remove listeners to stop receiving notifications
+    ModulatorEngine::getInstance().setValueSource(nullptr);
+    ProjectManager::getInstance().setPluginStateProvider(nullptr);
     TrackManager::getInstance().removeListener(this);
     ClipManager::getInstance().removeListener(this);
+    ClipManager::getInstance().setClipLauncher(nullptr);
+    UndoManager::getInstance().removeListener(this);
+    AutomationManager::getInstance().removeListener(this);
 
     // NOTE: Plugin windows are now closed by PluginWindowManager BEFORE AudioBridge
     // is destroyed (in TracktionEngineWrapper::shutdown()). No window cleanup needed here.
@@ -51,23 +181,23 @@ AudioBridge::~AudioBridge() {
             }
         }
 
-        // Unregister all track meter clients
-        for (auto& [trackId, track] : trackMapping_) {
-            if (track) {
-                auto* levelMeter = track->getLevelMeterPlugin();
-                if (levelMeter) {
-                    auto it = meterClients_.find(trackId);
-                    if (it != meterClients_.end()) {
-                        levelMeter->measurer.removeClient(it->second);
-                    }
-                }
-            }
+        // Stop track meters publishing into meteringBuffer_ before it goes away
+        trackMapping_.forEach([](TrackId, te::AudioTrack* track) { detachTrackMeters(track); });
+        if (auto* meter = dynamic_cast<TrackMeterPlugin*>(masterTap_.get())) {
+            meter->setMeteringTarget(nullptr, INVALID_TRACK_ID);
         }
 
         trackMapping_.clear();
         deviceToPlugin_.clear();
         pluginToDevice_.clear();
-        meterClients_.clear();
+        chainGate_.clear();
+        suspendedPlugins_.clear();
+
+        // Audio callbacks have stopped by now, so every table can go
+        parameterTable_.clear();
+        directMonitorRoutes_.clear();
+        modulator_.clear();
+        automationPlayer_.clear();
     }
 
     std::cout << "AudioBridge destroyed" << std::endl;
@@ -78,12 +208,27 @@ AudioBridge::~AudioBridge() {
 // =============================================================================
 
 void AudioBridge::tracksChanged() {
+    // Inside a compound operation (a batch creating many tracks) sync once, at the flush
+    if (UndoManager::getInstance().isInCompoundOperation()) {
+        trackListDirty_ = true;
+        triggerAsyncUpdate();
+        return;
+    }
+
     // Tracks were added/removed/reordered - sync all
     syncAll();
+    rebuildModulation();
 }
 
 void AudioBridge::trackPropertyChanged(int trackId) {
-    // Track property changed (volume, pan, mute, solo) - sync to Tracktion Engine
+    // Track property changed (volume, pan, mute, solo) - synced on the next flush
+    dirtyTracks_.insert(trackId);
+    triggerAsyncUpdate();
+}
+
+void AudioBridge::syncTrackProperties(TrackId trackId) {
+    wakeChain(trackId);  // An unmute, a new input or a fader move: let the chain run again
+
     auto* track = getAudioTrack(trackId);
     if (track) {
         auto* trackInfo = TrackManager::getInstance().getTrack(trackId);
@@ -95,6 +240,14 @@ void AudioBridge::trackPropertyChanged(int trackId) {
             // Sync volume/pan to VolumeAndPanPlugin
             setTrackVolume(trackId, trackInfo->volume);
             setTrackPan(trackId, trackInfo->pan);
+
+            // Becoming or no longer being an Aux moves buses around; otherwise only this
+            // track's sends can have changed
+            if ((trackInfo->type == TrackType::Aux) != (auxBuses_.count(trackId) != 0)) {
+                syncAuxBuses();
+            } else {
+                syncTrackSends(trackId);
+            }
         }
     }
 }
@@ -102,6 +255,7 @@ void AudioBridge::trackPropertyChanged(int trackId) {
 void AudioBridge::trackDevicesChanged(TrackId trackId) {
     // Devices on a track changed - resync that track's plugins
     syncTrackPlugins(trackId);
+    rebuildModulation();
 }
 
 void AudioBridge::masterChannelChanged() {
@@ -109,6 +263,7 @@ void AudioBridge::masterChannelChanged() {
     const auto& master = TrackManager::getInstance().getMasterChannel();
     setMasterVolume(master.volume);
     setMasterPan(master.pan);
+    updateDirectMonitoring();
 
     // TODO: Handle master mute (may need different approach than track mute)
 }
@@ -127,8 +282,31 @@ void AudioBridge::deviceParameterChanged(DeviceId deviceId, int paramIndex, floa
 }
 
 void AudioBridge::devicePropertyChanged(DeviceId deviceId) {
-    // A device property changed (gain, bypass, etc.) - sync to processor
-    DBG("AudioBridge::devicePropertyChanged deviceId=" << deviceId);
+    // A device property changed (gain, bypass, etc.) - synced on the next flush
+    dirtyDevices_.insert(deviceId);
+    triggerAsyncUpdate();
+}
+
+void AudioBridge::syncDeviceProperties(DeviceId deviceId) {
+    DBG("AudioBridge::syncDeviceProperties deviceId=" << deviceId);
+
+    // Sandboxed devices have no processor: their plugin is swapped, or bypassed, here
+    if (const auto* device = TrackManager::getInstance().findDevice(deviceId)) {
+        auto plugin = getPlugin(deviceId);
+        const bool isSandboxed = dynamic_cast<SandboxedPlugin*>(plugin.get()) != nullptr;
+        const auto trackId = TrackManager::getInstance().findDevicePath(deviceId).trackId;
+        if (plugin != nullptr && device->format != PluginFormat::Internal &&
+            isSandboxed != device->sandboxed) {
+            resandboxDevice(trackId, *device);
+            return;
+        }
+        if (isSandboxed) {
+            wakeChain(trackId);
+            plugin->setEnabled(!device->bypassed);
+            syncSandboxBatches(getAudioTrack(trackId));
+            return;
+        }
+    }
 
     auto* processor = getDeviceProcessor(deviceId);
     if (!processor) {
@@ -137,20 +315,21 @@ void AudioBridge::devicePropertyChanged(DeviceId deviceId) {
     }
 
     // Find the DeviceInfo to get updated values
-    // We need to search through all tracks to find this device
-    auto& tm = TrackManager::getInstance();
-    for (const auto& track : tm.getTracks()) {
-        for (const auto& element : track.chainElements) {
-            if (std::holds_alternative<DeviceInfo>(element)) {
-                const auto& device = std::get<DeviceInfo>(element);
-                if (device.id == deviceId) {
-                    DBG("  Found device in track " << track.id << ", syncing...");
-                    // Sync processor from the updated DeviceInfo
-                    processor->syncFromDeviceInfo(device);
-                    return;
+    const auto& tm = TrackManager::getInstance();
+    if (const auto* device = tm.findDevice(deviceId)) {
+        DBG("  Found device, syncing...");
+        // Before the sync, so a bypass applied now isn't undone by the resume
+        if (auto plugin = getPlugin(deviceId)) {
+            juce::ScopedLock lock(mappingLock_);
+            trackMapping_.forEach([&](TrackId trackId, te::AudioTrack* track) {
+                if (track == plugin->getOwnerTrack()) {
+                    wakeChain(trackId);
                 }
-            }
+            });
         }
+        // Sync processor from the updated DeviceInfo
+        processor->syncFromDeviceInfo(*device);
+        return;
     }
     DBG("  Device not found in any track!");
 }
@@ -160,7 +339,14 @@ void AudioBridge::devicePropertyChanged(DeviceId deviceId) {
 // =============================================================================
 
 void AudioBridge::clipsChanged() {
-    DBG("AudioBridge::clipsChanged - clips list changed");
+    // Clips added or removed - the whole list is reconciled on the next flush
+    clipListDirty_ = true;
+    readAheadClipsDirty_ = true;
+    triggerAsyncUpdate();
+}
+
+void AudioBridge::syncClipList() {
+    DBG("AudioBridge::syncClipList - reconciling clips with engine");
 
     // If we're shutting down, don't attempt to modify the engine graph
     if (isShuttingDown_.load(std::memory_order_acquire))
@@ -177,11 +363,11 @@ void AudioBridge::clipsChanged() {
 
     // Find clips that are in the engine but no longer in ClipManager (deleted)
     std::vector<ClipId> clipsToRemove;
-    for (const auto& [clipId, engineId] : clipIdToEngineId_) {
+    clipIdToEngineId_.forEach([&](ClipId clipId, te::EditItemID) {
         if (currentClipIds.find(clipId) == currentClipIds.end()) {
             clipsToRemove.push_back(clipId);
         }
-    }
+    });
 
     // Remove deleted clips from engine
     for (ClipId clipId : clipsToRemove) {
@@ -194,12 +380,14 @@ void AudioBridge::clipsChanged() {
         syncClipToEngine(clip.id);
     }
 
-    DBG("AudioBridge::clipsChanged - synced " << clips.size() << " clips to engine");
+    DBG("AudioBridge::syncClipList - synced " << clips.size() << " clips to engine");
 }
 
 void AudioBridge::clipPropertyChanged(ClipId clipId) {
-    // A specific clip's properties changed - sync to engine
-    syncClipToEngine(clipId);
+    // A specific clip's properties changed - synced on the next flush
+    dirtyClips_.insert(clipId);
+    readAheadClipsDirty_ = true;
+    triggerAsyncUpdate();
 }
 
 void AudioBridge::clipSelectionChanged(ClipId clipId) {
@@ -208,6 +396,301 @@ void AudioBridge::clipSelectionChanged(ClipId clipId) {
     juce::ignoreUnused(clipId);
 }
 
+void AudioBridge::clipAudiblePreview(const ClipInfo& preview) {
+    // Applied straight away (the caller throttles it); the commit on drop resyncs from the
+    // model, which replaces whatever the preview left in the engine
+    if (preview.type == ClipType::Audio && clipIdToEngineId_.find(preview.id) != nullptr) {
+        syncAudioClipToEngine(preview.id, &preview);
+    }
+}
+
+// =============================================================================
+// AutomationManagerListener implementation
+// =============================================================================
+
+// Edits only mark the plan stale: a drag moves points many times per timer tick
+void AudioBridge::automationLanesChanged() {
+    automationDirty_ = true;
+}
+
+void AudioBridge::automationClipsChanged(AutomationLaneId /*laneId*/) {
+    automationDirty_ = true;
+}
+
+void AudioBridge::automationPointsChanged(AutomationLaneId /*laneId*/) {
+    automationDirty_ = true;
+}
+
+// =============================================================================
+// Deferred Synchronization
+// =============================================================================
+
+void AudioBridge::undoStateChanged() {
+    // A compound operation that held back a flush has finished
+    if (flushAfterCompound_ && !UndoManager::getInstance().isInCompoundOperation()) {
+        triggerAsyncUpdate();
+    }
+}
+
+void AudioBridge::handleAsyncUpdate() {
+    MAGDA_MONITOR_SCOPE("EngineSync");
+
+    // Apply a multi-command gesture to the engine in one go, once it is complete
+    if (UndoManager::getInstance().isInCompoundOperation()) {
+        flushAfterCompound_ = true;
+    } else {
+        flushPendingSync();
+    }
+
+    // One slice of plugin instantiation per tick (re-triggers while loads remain)
+    loadPendingPlugins();
+}
+
+void AudioBridge::flushPendingSync() {
+    flushAfterCompound_ = false;
+
+    if (isShuttingDown_.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    // Take the pending work first: syncing can send notifications that queue more
+    const bool trackList = std::exchange(trackListDirty_, false);
+    const bool clipList = std::exchange(clipListDirty_, false);
+    auto clips = std::exchange(dirtyClips_, {});
+    auto tracks = std::exchange(dirtyTracks_, {});
+    auto devices = std::exchange(dirtyDevices_, {});
+
+    // Engine tracks first: the clips and properties below sync onto them
+    if (trackList) {
+        syncAll();
+        rebuildModulation();
+    }
+
+    for (auto trackId : tracks) {
+        syncTrackProperties(trackId);
+    }
+    if (trackList || !tracks.empty()) {
+        updateDirectMonitoring();  // Arming, inputs, faders and mutes all change the routes
+    }
+
+    for (auto deviceId : devices) {
+        syncDeviceProperties(deviceId);
+    }
+
+    // Reconciling the list syncs every clip, so individual clips are only needed without it
+    if (clipList) {
+        syncClipList();
+    } else {
+        for (auto clipId : clips) {
+            syncClipToEngine(clipId);
+        }
+    }
+
+    // Device and clip syncs re-enable what a freeze suspended
+    reapplyFreezes();
+}
+
+void AudioBridge::loadPendingPlugins() {
+    if (pendingPluginLoads_.empty() || isShuttingDown_.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    HighResTimer slice;
+    std::vector<TrackId> touchedTracks;
+    bool addedPlugins = false;
+
+    // Always make progress, then keep going while the slice has time left
+    do {
+        const auto load = pendingPluginLoads_.front();
+        pendingPluginLoads_.pop_front();
+        loadingDevices_.erase(load.deviceId);
+        markDeviceStatusChanged(load.deviceId);
+
+        // The device or its track may have been removed while queued
+        auto* device = TrackManager::getInstance().getDevice(load.trackId, load.deviceId);
+        if (device == nullptr || getAudioTrack(load.trackId) == nullptr) {
+            clonedPluginStates_.erase(load.deviceId);
+            continue;
+        }
+
+        juce::ScopedLock lock(mappingLock_);
+        if (deviceToPlugin_.contains(load.deviceId)) {
+            continue;
+        }
+
+        const double loadStartMs = juce::Time::getMillisecondCounterHiRes();
+        auto plugin = loadDeviceAsPlugin(load.trackId, *device);
+        recordPluginLoad(*device, loadStartMs, plugin != nullptr);
+        if (plugin) {
+            deviceToPlugin_.assign(load.deviceId, plugin);
+            pluginToDevice_[plugin.get()] = load.deviceId;
+            addedPlugins = true;
+
+            if (std::find(touchedTracks.begin(), touchedTracks.end(), load.trackId) ==
+                touchedTracks.end()) {
+                touchedTracks.push_back(load.trackId);
+            }
+        }
+    } while (!pendingPluginLoads_.empty() && slice.elapsedMilliseconds() < kPluginLoadSliceMs);
+
+    if (addedPlugins) {
+        juce::ScopedLock lock(mappingLock_);
+        rebuildParameterTable();
+    }
+
+    // New plugins were appended: restore the fader and meter positions at the chain end
+    for (auto trackId : touchedTracks) {
+        if (auto* track = getAudioTrack(trackId)) {
+            ensureVolumePluginPosition(track);
+            addLevelMeterToTrack(trackId);
+            syncTrackSends(trackId);
+            syncTimingProbes(trackId, track);
+            syncSandboxBatches(track);
+        }
+    }
+
+    if (pendingPluginLoads_.empty()) {
+        // Mods targeting the queued plugins can resolve now
+        rebuildModulation();
+        LoadProfiler::getInstance().setItemsPending(false);
+    } else {
+        triggerAsyncUpdate();
+    }
+}
+
+bool AudioBridge::isDeviceLoading(DeviceId deviceId) const {
+    return loadingDevices_.count(deviceId) != 0;
+}
+
+void AudioBridge::markDeviceStatusChanged(DeviceId deviceId) {
+    if (!allDeviceStatusChanged_ && std::find(statusChangedDevices_.begin(),
+                                              statusChangedDevices_.end(),
+                                              deviceId) == statusChangedDevices_.end()) {
+        statusChangedDevices_.push_back(deviceId);
+    }
+}
+
+void AudioBridge::dispatchDeviceStatus() {
+    if (!allDeviceStatusChanged_ && statusChangedDevices_.empty()) {
+        return;
+    }
+
+    // One event either way: slots ignore another device's, and check theirs on "several"
+    const DeviceId deviceId = !allDeviceStatusChanged_ && statusChangedDevices_.size() == 1
+                                  ? statusChangedDevices_.front()
+                                  : INVALID_DEVICE_ID;
+    statusChangedDevices_.clear();
+    allDeviceStatusChanged_ = false;
+    eventDispatcher_.dispatch({AudioEvent::Type::DeviceStatusChanged, INVALID_TRACK_ID, deviceId});
+}
+
+// =============================================================================
+// Memory Accounting
+// =============================================================================
+
+namespace {
+
+size_t estimateValueTreeBytes(const juce::ValueTree& tree) {
+    size_t bytes = sizeof(juce::ValueTree);
+    for (int i = 0; i < tree.getNumProperties(); ++i) {
+        const auto& value = tree.getProperty(tree.getPropertyName(i));
+        bytes += sizeof(juce::NamedValueSet::NamedValue);
+        if (const auto* block = value.getBinaryData()) {
+            bytes += block->getSize();
+        } else if (value.isString()) {
+            bytes += value.toString().getNumBytesAsUTF8();
+        }
+    }
+    for (const auto& child : tree) {
+        bytes += estimateValueTreeBytes(child);
+    }
+    return bytes;
+}
+
+}  // namespace
+
+size_t AudioBridge::getSizeInBytes() const {
+    size_t bytes = sizeof(*this) + trackMapping_.getSizeInBytes() +
+                   deviceToPlugin_.getSizeInBytes() + memory::hashContainerBytes(pluginToDevice_) +
+                   clipIdToEngineId_.getSizeInBytes() +
+                   memory::hashContainerBytes(engineIdToClipId_) +
+                   midiClipShadows_.getSizeInBytes() + deviceProcessors_.getSizeInBytes() +
+                   memory::hashContainerBytes(loadingDevices_) +
+                   memory::hashContainerBytes(dirtyClips_) +
+                   memory::hashContainerBytes(dirtyTracks_) +
+                   memory::hashContainerBytes(dirtyDevices_) +
+                   memory::hashContainerBytes(frozenTracks_);
+
+    midiClipShadows_.forEach([&bytes](ClipId, const MidiClipShadow& shadow) {
+        bytes += memory::vectorBytes(shadow.notes) + memory::vectorBytes(shadow.engineNotes);
+    });
+    deviceProcessors_.forEach([&bytes](DeviceId, const std::unique_ptr<DeviceProcessor>& p) {
+        bytes += p ? sizeof(*p) : 0;
+    });
+    return bytes;
+}
+
+size_t AudioBridge::getPluginStateSizeInBytes() const {
+    size_t bytes = 0;
+    deviceToPlugin_.forEach([&bytes](DeviceId, const te::Plugin::Ptr& plugin) {
+        if (plugin) {
+            bytes += estimateValueTreeBytes(plugin->state);
+        }
+    });
+    return bytes;
+}
+
+void AudioBridge::writeMetrics(MetricsWriter& writer) const {
+    auto& deviceManager = engine_.getDeviceManager().deviceManager;
+    writer.gauge("audio_cpu_ratio", "Share of the audio device cycle spent processing",
+                 deviceManager.getCpuUsage());
+    if (auto* device = deviceManager.getCurrentAudioDevice()) {
+        writer.gauge("audio_sample_rate_hertz", "Audio device sample rate",
+                     device->getCurrentSampleRate());
+        writer.gauge("audio_buffer_size_samples", "Audio device buffer size",
+                     device->getCurrentBufferSizeSamples());
+        if (const int xruns = device->getXRunCount(); xruns >= 0) {
+            writer.counter("audio_device_xruns_total", "Xruns reported by the audio device",
+                           xruns);
+        }
+    }
+    writer.counter("audio_events_dropped_total", "Audio thread events lost to a full queue",
+                   static_cast<double>(eventQueue_.getDroppedCount()));
+    writer.counter("audio_parameter_changes_dropped_total",
+                   "Parameter changes lost to a full queue",
+                   static_cast<double>(parameterQueue_.getDroppedCount()));
+
+    const auto readAhead = readAhead_.getStats();
+    writer.gauge("disk_read_ahead_queued_blocks", "Blocks waiting to be read ahead of playback",
+                 readAhead.queuedBlocks);
+    writer.counter("disk_read_ahead_blocks_total", "Blocks read ahead of playback",
+                   static_cast<double>(readAhead.blocksFetched));
+    writer.gauge("disk_read_ahead_open_files", "Files held open for read-ahead",
+                 readAhead.openFiles);
+
+    const auto recording = diskRecorder_.getStats();
+    writer.gauge("disk_record_buffer_fill_ratio", "Fullest recording ring buffer",
+                 recording.bufferFill);
+    writer.gauge("disk_record_buffer_peak_fill_ratio",
+                 "Fullest any recording ring buffer has been this take", recording.peakBufferFill);
+    writer.counter("disk_record_dropped_frames_total", "Input frames lost this take",
+                   static_cast<double>(recording.droppedFrames));
+    writer.gauge("disk_record_error", "1 if the recording failed to write to disk",
+                 recording.diskError ? 1.0 : 0.0);
+
+    size_t plugins = 0;
+    {
+        juce::ScopedLock lock(mappingLock_);
+        plugins = pluginToDevice_.size();
+    }
+    writer.gauge("plugins_loaded", "Plugins instantiated for devices",
+                 static_cast<double>(plugins));
+    writer.gauge("plugins_pending", "Plugin loads still queued",
+                 static_cast<double>(getNumPendingPluginLoads()));
+    writer.gauge("tracks_frozen", "Tracks playing a frozen render",
+                 static_cast<double>(frozenTracks_.size()));
+}
+
 // =============================================================================
 // Clip Synchronization
 // =============================================================================
@@ -243,25 +726,17 @@ void AudioBridge::syncMidiClipToEngine(ClipId clipId, const ClipInfo* clip) {
     te::MidiClip* midiClipPtr = nullptr;
 
     // Check if clip already exists in Tracktion Engine
-    auto it = clipIdToEngineId_.find(clipId);
-    if (it != clipIdToEngineId_.end()) {
-        // Clip exists - find it and update
-        std::string engineId = it->second;
-
-        // Find the MidiClip in the track
-        for (auto* teClip : audioTrack->getClips()) {
-            if (teClip->itemID.toString().toStdString() == engineId) {
-                midiClipPtr = dynamic_cast<te::MidiClip*>(teClip);
-                break;
-            }
-        }
+    if (auto* engineId = clipIdToEngineId_.find(clipId)) {
+        // Clip exists - find it in the track and update
+        midiClipPtr = dynamic_cast<te::MidiClip*>(audioTrack->findClipForID(*engineId));
 
         if (!midiClipPtr) {
             DBG("syncClipToEngine: Clip " << clipId
                                           << " mapping exists but clip not found in engine");
             // Clear stale mapping and recreate
-            clipIdToEngineId_.erase(it);
-            engineIdToClipId_.erase(engineId);
+            engineIdToClipId_.erase(*engineId);
+            clipIdToEngineId_.erase(clipId);
+            midiClipShadows_.erase(clipId);
         } else {
             DBG("syncClipToEngine: Updating existing clip " << clipId);
         }
@@ -281,10 +756,10 @@ void AudioBridge::syncMidiClipToEngine(ClipId clipId, const ClipInfo* clip) {
 
         midiClipPtr = clipRef.get();
 
-        // Store clip ID mapping (use clip's EditItemID as string)
-        std::string engineClipId = midiClipPtr->itemID.toString().toStdString();
-        clipIdToEngineId_[clipId] = engineClipId;
-        engineIdToClipId_[engineClipId] = clipId;
+        // Store clip ID mapping
+        clipIdToEngineId_.assign(clipId, midiClipPtr->itemID);
+        engineIdToClipId_[midiClipPtr->itemID] = clipId;
+        midiClipShadows_.erase(clipId);
 
         DBG("syncClipToEngine: Created new clip " << clipId);
     }
@@ -298,58 +773,102 @@ void AudioBridge::syncMidiClipToEngine(ClipId clipId, const ClipInfo* clip) {
     // Force offset to 0 to ensure notes play from clip start
     midiClipPtr->setOffset(te::TimeDuration::fromSeconds(0.0));
 
-    // Clear existing notes and add all notes from ClipManager
-    auto& sequence = midiClipPtr->getSequence();
-    sequence.clear(nullptr);  // Clear all notes
+    syncMidiClipLoop(*midiClipPtr, *clip);
+    syncMidiNotesToEngine(clipId, *clip, midiClipPtr->getSequence());
+}
+
+void AudioBridge::syncMidiClipLoop(te::MidiClip& engineClip, const ClipInfo& clip) {
+    // A looped clip is its loop body plus a loop range: the engine repeats the body up to
+    // the clip's end, so lengthening it, however far, only moves the end
+    if (clip.internalLoopEnabled) {
+        const auto loopLength = te::BeatDuration::fromBeats(clip.internalLoopLength);
+        if (!engineClip.isLooping() || engineClip.getLoopStartBeats() != te::BeatPosition() ||
+            engineClip.getLoopLengthBeats() != loopLength) {
+            engineClip.setLoopRangeBeats(te::BeatRange(te::BeatPosition(), loopLength));
+        }
+    } else if (engineClip.isLooping()) {
+        engineClip.disableLooping();
+    }
+}
 
-    // Get tempo info for conversion verification
-    auto& tempoSeq = midiClipPtr->edit.tempoSequence;
-    auto clipStartTime = te::TimePosition::fromSeconds(clip->startTime);
-    auto clipStartBeat = tempoSeq.timeToBeats(clipStartTime);
+void AudioBridge::syncMidiNotesToEngine(ClipId clipId, const ClipInfo& clip,
+                                        te::MidiList& sequence) {
+    auto addNote = [&sequence](const MidiNote& note) {
+        return sequence.addNote(note.noteNumber, te::BeatPosition::fromBeats(note.startBeat),
+                                te::BeatDuration::fromBeats(note.lengthBeats), note.velocity,
+                                0,         // colour index
+                                nullptr);  // undo manager
+    };
+
+    auto* shadow = midiClipShadows_.find(clipId);
+
+    // New clip, or the engine notes no longer match what we wrote: rebuild from scratch
+    if (!shadow || shadow->engineNotes.size() != static_cast<size_t>(sequence.getNumNotes())) {
+        sequence.clear(nullptr);
+
+        shadow = midiClipShadows_.assign(clipId, MidiClipShadow{});
+        shadow->engineNotes.reserve(clip.midiNotes.size());
+        for (const auto& note : clip.midiNotes) {
+            shadow->engineNotes.push_back(addNote(note));
+        }
+        shadow->notes = clip.midiNotes.getNotes();
 
-    DBG("=== syncClipToEngine Debug ===");
-    DBG("Clip ID: " << clipId);
-    DBG("Clip startTime: " << clip->startTime << "s, length: " << clip->length << "s");
-    DBG("Clip END time: " << (clip->startTime + clip->length) << "s");
-    DBG("Clip startBeat on timeline: " << clipStartBeat.inBeats());
-    DBG("Current tempo: " << tempoSeq.getTempoAt(clipStartTime).getBpm());
-    DBG("Number of notes: " << clip->midiNotes.size());
+        DBG("syncClipToEngine: Rebuilt clip " << clipId << " with " << clip.midiNotes.size()
+                                              << " notes");
+        return;
+    }
 
-    // Calculate clip end beat for boundary checking
-    auto clipEndTime = te::TimePosition::fromSeconds(clip->startTime + clip->length);
-    auto clipEndBeat = tempoSeq.timeToBeats(clipEndTime);
-    double clipLengthInBeats = clipEndBeat.inBeats() - clipStartBeat.inBeats();
-    DBG("Clip length in beats: " << clipLengthInBeats);
+    const auto diff = diffMidiNotes(shadow->notes, clip.midiNotes.getNotes());
+    if (diff.isEmpty()) {
+        return;
+    }
 
-    for (const auto& note : clip->midiNotes) {
-        te::BeatPosition startBeat = te::BeatPosition::fromBeats(note.startBeat);
-        te::BeatDuration lengthBeats = te::BeatDuration::fromBeats(note.lengthBeats);
+    // Notes present on both sides of the changed run are updated in place; the rest of the
+    // run is inserted or removed
+    const size_t numOld = diff.oldEnd - diff.begin;
+    const size_t numNew = diff.newEnd - diff.begin;
+    const size_t numUpdated = std::min(numOld, numNew);
 
-        // Convert to absolute timeline time for verification
-        auto noteAbsoluteTime = tempoSeq.beatsToTime(
-            te::BeatPosition::fromBeats(clipStartBeat.inBeats() + note.startBeat));
-        auto noteEndTime = tempoSeq.beatsToTime(te::BeatPosition::fromBeats(
-            clipStartBeat.inBeats() + note.startBeat + note.lengthBeats));
+    for (size_t i = diff.begin; i < diff.begin + numUpdated; ++i) {
+        const auto& note = clip.midiNotes[i];
+        auto& engineNote = *shadow->engineNotes[i];
 
-        // Check if note is within clip boundary
-        bool noteStartWithinClip = note.startBeat < clipLengthInBeats;
-        bool noteEndWithinClip = (note.startBeat + note.lengthBeats) <= clipLengthInBeats;
+        const auto startBeat = te::BeatPosition::fromBeats(note.startBeat);
+        const auto lengthBeats = te::BeatDuration::fromBeats(note.lengthBeats);
+        if (engineNote.getStartBeat() != startBeat || engineNote.getLengthBeats() != lengthBeats) {
+            engineNote.setStartAndLength(startBeat, lengthBeats, nullptr);
+        }
+        if (engineNote.getNoteNumber() != note.noteNumber) {
+            engineNote.setNoteNumber(note.noteNumber, nullptr);
+        }
+        if (engineNote.getVelocity() != note.velocity) {
+            engineNote.setVelocity(note.velocity, nullptr);
+        }
+    }
 
-        DBG("  Note " << note.noteNumber << ": clip-relative beat=" << note.startBeat
-                      << ", length=" << note.lengthBeats << ", velocity=" << note.velocity);
-        DBG("    -> Absolute timeline: " << noteAbsoluteTime.inSeconds() << "s to "
-                                         << noteEndTime.inSeconds() << "s");
-        DBG("    -> Within clip boundary? start=" << (noteStartWithinClip ? "YES" : "NO")
-                                                  << ", end="
-                                                  << (noteEndWithinClip ? "YES" : "NO"));
+    auto& engineNotes = shadow->engineNotes;
+    const auto tail = static_cast<std::ptrdiff_t>(diff.begin + numUpdated);
 
-        sequence.addNote(note.noteNumber, startBeat, lengthBeats, note.velocity,
-                         0,         // colour index
-                         nullptr);  // undo manager
+    if (numOld > numNew) {
+        const auto removeEnd = static_cast<std::ptrdiff_t>(diff.oldEnd);
+        for (auto i = tail; i < removeEnd; ++i) {
+            sequence.removeNote(*engineNotes[static_cast<size_t>(i)], nullptr);
+        }
+        engineNotes.erase(engineNotes.begin() + tail, engineNotes.begin() + removeEnd);
+    } else if (numNew > numOld) {
+        std::vector<te::MidiNote*> added;
+        added.reserve(numNew - numOld);
+        for (size_t i = diff.begin + numUpdated; i < diff.newEnd; ++i) {
+            added.push_back(addNote(clip.midiNotes[i]));
+        }
+        engineNotes.insert(engineNotes.begin() + tail, added.begin(), added.end());
     }
 
-    DBG("syncClipToEngine: Synced clip " << clipId << " with " << clip->midiNotes.size()
-                                         << " notes");
+    shadow->notes = clip.midiNotes.getNotes();
+
+    DBG("syncClipToEngine: Clip " << clipId << " updated " << numUpdated << ", removed "
+                                  << (numOld - numUpdated) << ", added " << (numNew - numUpdated)
+                                  << " notes");
 }
 
 void AudioBridge::syncAudioClipToEngine(ClipId clipId, const ClipInfo* clip) {
@@ -364,25 +883,16 @@ void AudioBridge::syncAudioClipToEngine(ClipId clipId, const ClipInfo* clip) {
 
     // 2. Check if clip already synced
     te::WaveAudioClip* audioClipPtr = nullptr;
-    auto it = clipIdToEngineId_.find(clipId);
-
-    if (it != clipIdToEngineId_.end()) {
-        // UPDATE existing clip
-        std::string engineId = it->second;
 
-        // Find clip in track by engine ID
-        for (auto* teClip : audioTrack->getClips()) {
-            if (teClip->itemID.toString().toStdString() == engineId) {
-                audioClipPtr = dynamic_cast<te::WaveAudioClip*>(teClip);
-                break;
-            }
-        }
+    if (auto* engineId = clipIdToEngineId_.find(clipId)) {
+        // UPDATE existing clip - find it in the track by engine ID
+        audioClipPtr = dynamic_cast<te::WaveAudioClip*>(audioTrack->findClipForID(*engineId));
 
         // If mapping is stale, clear it
         if (!audioClipPtr) {
             DBG("AudioBridge: Clip mapping stale, recreating for clip " << clipId);
-            clipIdToEngineId_.erase(it);
-            engineIdToClipId_.erase(engineId);
+            engineIdToClipId_.erase(*engineId);
+            clipIdToEngineId_.erase(clipId);
         }
     }
 
@@ -417,14 +927,14 @@ void AudioBridge::syncAudioClipToEngine(ClipId clipId, const ClipInfo* clip) {
 
         // Enable timestretcher at creation time (before any speedRatio changes)
         // Must be set before setSpeedRatio() to avoid assertion failures
-        audioClipPtr->setTimeStretchMode(te::TimeStretcher::defaultMode);
+        audioClipPtr->setTimeStretchMode(getStretchMode());
 
         // Store bidirectional mapping
-        std::string engineClipId = audioClipPtr->itemID.toString().toStdString();
-        clipIdToEngineId_[clipId] = engineClipId;
-        engineIdToClipId_[engineClipId] = clipId;
+        clipIdToEngineId_.assign(clipId, audioClipPtr->itemID);
+        engineIdToClipId_[audioClipPtr->itemID] = clipId;
 
-        DBG("AudioBridge: Created WaveAudioClip (engine ID: " << engineClipId << ")");
+        DBG("AudioBridge: Created WaveAudioClip (engine ID: " << audioClipPtr->itemID.toString()
+                                                              << ")");
     }
 
     // 4. UPDATE clip position/length using audio source position within clip
@@ -470,25 +980,45 @@ void AudioBridge::syncAudioClipToEngine(ClipId clipId, const ClipInfo* clip) {
         audioClipPtr->setPosition(te::ClipPosition{newTimeRange, currentPos.getOffset()});
     }
 
-    // 5. UPDATE audio offset (trim point in file)
+    // 5. SELECT what plays: a settled stretch plays its pre-rendered file at normal speed,
+    // anything else (including a stretch still being rendered) the source file
+    bool playsRender = false;
+    if (!clip->audioSources.empty()) {
+        const auto& source = clip->audioSources[0];
+        juce::File playFile(source.filePath);
+        const auto renderFile =
+            stretchRenderCache_.getRender(clipId, playFile, source.stretchFactor);
+        if (renderFile != juce::File()) {
+            playFile = renderFile;
+            playsRender = true;
+            engineOffset *= source.stretchFactor;  // The render's time is already stretched
+        }
+
+        auto& sourceRef = audioClipPtr->getSourceFileReference();
+        if (sourceRef.getFile() != playFile) {
+            sourceRef.setToDirectFileReference(playFile, false);
+        }
+    }
+
+    // 6. UPDATE audio offset (trim point in file)
     auto currentOffset = audioClipPtr->getPosition().getOffset().inSeconds();
     if (std::abs(currentOffset - engineOffset) > 0.001) {
         audioClipPtr->setOffset(te::TimeDuration::fromSeconds(engineOffset));
     }
 
-    // 6. UPDATE speed ratio for time-stretching
+    // 7. UPDATE speed ratio for time-stretching
     // TE speedRatio: 1.0 = normal, 2.0 = 2x faster, 0.5 = 2x slower
     // Our stretchFactor: 1.0 = normal, 2.0 = 2x slower, 0.5 = 2x faster
     // Mapping: TE speedRatio = 1.0 / stretchFactor
     if (!clip->audioSources.empty()) {
         const auto& source = clip->audioSources[0];
-        double teSpeedRatio = 1.0 / source.stretchFactor;
+        double teSpeedRatio = playsRender ? 1.0 : 1.0 / source.stretchFactor;
         double currentSpeedRatio = audioClipPtr->getSpeedRatio();
 
         if (std::abs(currentSpeedRatio - teSpeedRatio) > 0.001) {
             // Ensure timestretcher is enabled (may not be set for pre-existing clips)
             if (audioClipPtr->getTimeStretchMode() == te::TimeStretcher::disabled) {
-                audioClipPtr->setTimeStretchMode(te::TimeStretcher::defaultMode);
+                audioClipPtr->setTimeStretchMode(getStretchMode());
             }
             // Disable autoTempo which blocks setSpeedRatio in AudioClipBase
             if (audioClipPtr->getAutoTempo()) {
@@ -496,38 +1026,78 @@ void AudioBridge::syncAudioClipToEngine(ClipId clipId, const ClipInfo* clip) {
             }
             audioClipPtr->setSpeedRatio(teSpeedRatio);
         }
+
+        // A render plays as it is, with no stretcher running
+        if (playsRender && audioClipPtr->getTimeStretchMode() != te::TimeStretcher::disabled) {
+            audioClipPtr->setTimeStretchMode(te::TimeStretcher::disabled);
+        }
+    }
+
+    // 8. UPDATE fades: the engine clip's own, with the nearest curve (it has no tension)
+    if (!clip->audioSources.empty()) {
+        const auto& source = clip->audioSources[0];
+        const double playing = engineEnd - engineStart;
+        auto fadeType = [](FadeCurve curve) {
+            switch (curve) {
+                case FadeCurve::Linear:
+                    return te::AudioFadeCurve::linear;
+                case FadeCurve::EqualPower:
+                    return te::AudioFadeCurve::convex;
+                case FadeCurve::SCurve:
+                    return te::AudioFadeCurve::sCurve;
+            }
+            return te::AudioFadeCurve::linear;
+        };
+
+        const auto fadeIn = te::TimeDuration::fromSeconds(std::min(source.fadeIn.length, playing));
+        if (audioClipPtr->getFadeIn() != fadeIn) {
+            audioClipPtr->setFadeIn(fadeIn);
+        }
+        if (audioClipPtr->getFadeInType() != fadeType(source.fadeIn.curve)) {
+            audioClipPtr->setFadeInType(fadeType(source.fadeIn.curve));
+        }
+
+        const auto fadeOut =
+            te::TimeDuration::fromSeconds(std::min(source.fadeOut.length, playing));
+        if (audioClipPtr->getFadeOut() != fadeOut) {
+            audioClipPtr->setFadeOut(fadeOut);
+        }
+        if (audioClipPtr->getFadeOutType() != fadeType(source.fadeOut.curve)) {
+            audioClipPtr->setFadeOutType(fadeType(source.fadeOut.curve));
+        }
     }
 }
 
 void AudioBridge::removeClipFromEngine(ClipId clipId) {
+    stretchRenderCache_.release(clipId);
+
     // Remove clip from engine
-    auto it = clipIdToEngineId_.find(clipId);
-    if (it == clipIdToEngineId_.end()) {
+    auto* mapped = clipIdToEngineId_.find(clipId);
+    if (!mapped) {
         DBG("removeClipFromEngine: Clip not in engine: " << clipId);
         return;
     }
 
-    std::string engineId = it->second;
+    const auto engineId = *mapped;
 
     // Find the clip in Tracktion Engine and remove it
     // We need to find which track contains this clip
     for (auto* track : tracktion::getAudioTracks(edit_)) {
-        for (auto* clip : track->getClips()) {
-            if (clip->itemID.toString().toStdString() == engineId) {
-                // Found the clip - remove it
-                clip->removeFromParent();
+        if (auto* clip = track->findClipForID(engineId)) {
+            // Found the clip - remove it
+            clip->removeFromParent();
 
-                // Remove from mappings
-                clipIdToEngineId_.erase(it);
-                engineIdToClipId_.erase(engineId);
+            // Remove from mappings
+            clipIdToEngineId_.erase(clipId);
+            engineIdToClipId_.erase(engineId);
+            midiClipShadows_.erase(clipId);
 
-                DBG("removeClipFromEngine: Removed clip " << clipId);
-                return;
-            }
+            DBG("removeClipFromEngine: Removed clip " << clipId);
+            return;
         }
     }
 
-    DBG("removeClipFromEngine: Clip not found in Tracktion Engine: " << engineId);
+    DBG("removeClipFromEngine: Clip not found in Tracktion Engine: " << engineId.toString());
 }
 
 // =============================================================================
@@ -587,10 +1157,39 @@ te::Plugin::Ptr AudioBridge::loadBuiltInPlugin(const TrackId TRACK_ID, const juc
     return plugin;
 }
 
+juce::PluginDescription AudioBridge::getMatchableDescription(
+    const juce::PluginDescription& description) {
+    // WORKAROUND for Tracktion Engine bug: When multiple plugins share the same
+    // uniqueId (common in VST3 bundles with multiple components like Serum 2 + Serum 2 FX),
+    // TE's findMatchingPlugin() matches by uniqueId first and returns the wrong plugin.
+    // By clearing uniqueId, we force it to fall through to deprecatedUid matching,
+    // which correctly distinguishes between plugins in the same bundle.
+    juce::PluginDescription descCopy = description;
+    if (descCopy.deprecatedUid != 0) {
+        DBG("  Clearing uniqueId to force deprecatedUid matching (workaround for TE bug)");
+        descCopy.uniqueId = 0;
+    }
+    return descCopy;
+}
+
+te::Plugin::Ptr AudioBridge::createExternalPluginInstance(
+    const juce::PluginDescription& description) {
+    if (isShuttingDown_.load(std::memory_order_acquire)) {
+        return nullptr;
+    }
+
+    try {
+        auto plugin = edit_.getPluginCache().createNewPlugin(te::ExternalPlugin::xmlTypeName,
+                                                             getMatchableDescription(description));
+        auto* extPlugin = dynamic_cast<te::ExternalPlugin*>(plugin.get());
+        return extPlugin != nullptr && extPlugin->isEnabled() ? plugin : nullptr;
+    } catch (...) {
+        return nullptr;
+    }
+}
+
 PluginLoadResult AudioBridge::loadExternalPlugin(TrackId trackId,
                                                  const juce::PluginDescription& description) {
-    MAGDA_MONITOR_SCOPE("PluginLoad");
-
     auto* track = getAudioTrack(trackId);
     if (!track) {
         auto* trackInfo = TrackManager::getInstance().getTrack(trackId);
@@ -612,20 +1211,16 @@ PluginLoadResult AudioBridge::loadExternalPlugin(TrackId trackId,
         DBG("  isInstrument: " << (description.isInstrument ? "true" : "false"));
         DBG("  createIdentifierString: " << description.createIdentifierString());
 
-        // WORKAROUND for Tracktion Engine bug: When multiple plugins share the same
-        // uniqueId (common in VST3 bundles with multiple components like Serum 2 + Serum 2 FX),
-        // TE's findMatchingPlugin() matches by uniqueId first and returns the wrong plugin.
-        // By clearing uniqueId, we force it to fall through to deprecatedUid matching,
-        // which correctly distinguishes between plugins in the same bundle.
-        juce::PluginDescription descCopy = description;
-        if (descCopy.deprecatedUid != 0) {
-            DBG("  Clearing uniqueId to force deprecatedUid matching (workaround for TE bug)");
-            descCopy.uniqueId = 0;
+        // A warm instance from the pool is already initialised; otherwise create one now
+        // (timed for BenchmarkSuite)
+        HighResTimer loadTimer;
+        auto plugin = pluginPool_.take(description);
+        if (!plugin) {
+            plugin = edit_.getPluginCache().createNewPlugin(te::ExternalPlugin::xmlTypeName,
+                                                            getMatchableDescription(description));
         }
-
-        // Create external plugin using the description
-        auto plugin =
-            edit_.getPluginCache().createNewPlugin(te::ExternalPlugin::xmlTypeName, descCopy);
+        PerformanceMonitor::getInstance().addSample("PluginLoad",
+                                                    loadTimer.elapsedMilliseconds());
 
         if (plugin) {
             // Check if plugin actually initialized successfully
@@ -650,6 +1245,9 @@ PluginLoadResult AudioBridge::loadExternalPlugin(TrackId trackId,
             track->pluginList.insertPlugin(plugin, -1, nullptr);
             std::cout << "Loaded external plugin: " << description.name << " on track " << trackId
                       << std::endl;
+            if (onExternalPluginLoaded) {
+                onExternalPluginLoaded(description);
+            }
             return PluginLoadResult::Success(plugin);
         } else {
             juce::String error = "Failed to create plugin: " + description.name;
@@ -667,6 +1265,37 @@ PluginLoadResult AudioBridge::loadExternalPlugin(TrackId trackId,
     }
 }
 
+PluginLoadResult AudioBridge::loadSandboxedPlugin(TrackId trackId,
+                                                  const juce::PluginDescription& description) {
+    auto* track = getAudioTrack(trackId);
+    if (!track) {
+        auto* trackInfo = TrackManager::getInstance().getTrack(trackId);
+        juce::String name = trackInfo ? trackInfo->name : "Track";
+        track = createAudioTrack(trackId, name);
+    }
+
+    if (!track) {
+        return PluginLoadResult::Failure("Failed to create or find track for plugin");
+    }
+
+    auto plugin = edit_.getPluginCache().createNewPlugin(SandboxedPlugin::create(description));
+    auto* sandboxed = dynamic_cast<SandboxedPlugin*>(plugin.get());
+    if (sandboxed == nullptr) {
+        return PluginLoadResult::Failure("Failed to create plugin: " + description.name);
+    }
+    if (!sandboxed->setHost(getSandboxHost(trackId))) {
+        return PluginLoadResult::Failure("No plugin host process for " + description.name);
+    }
+
+    track->pluginList.insertPlugin(plugin, -1, nullptr);
+    std::cout << "Loaded sandboxed plugin: " << description.name << " on track " << trackId
+              << std::endl;
+    if (onExternalPluginLoaded) {
+        onExternalPluginLoaded(description);
+    }
+    return PluginLoadResult::Success(plugin);
+}
+
 te::Plugin::Ptr AudioBridge::addLevelMeterToTrack(TrackId trackId) {
     auto* track = getAudioTrack(trackId);
     if (!track) {
@@ -675,34 +1304,20 @@ te::Plugin::Ptr AudioBridge::addLevelMeterToTrack(TrackId trackId) {
     }
 
     // Remove any existing LevelMeter plugins first to avoid duplicates
+    detachTrackMeters(track);
     auto& plugins = track->pluginList;
     for (int i = plugins.size() - 1; i >= 0; --i) {
         if (auto* levelMeter = dynamic_cast<te::LevelMeterPlugin*>(plugins[i])) {
-            // Unregister meter client from the old LevelMeter
-            {
-                juce::ScopedLock lock(mappingLock_);
-                auto it = meterClients_.find(trackId);
-                if (it != meterClients_.end()) {
-                    levelMeter->measurer.removeClient(it->second);
-                }
-            }
-
             levelMeter->deleteFromParent();
         }
     }
 
-    // Now add a fresh LevelMeter at the end
+    // Now add a fresh LevelMeter at the end; it pushes levels from the audio thread
     auto plugin = loadBuiltInPlugin(trackId, "levelmeter");
-
-    // Register meter client with the new LevelMeter
-    if (plugin) {
-        if (auto* levelMeter = dynamic_cast<te::LevelMeterPlugin*>(plugin.get())) {
-            juce::ScopedLock lock(mappingLock_);
-
-            // Create or get existing client
-            auto [it, inserted] = meterClients_.try_emplace(trackId);
-            levelMeter->measurer.addClient(it->second);
-        }
+    if (auto* meter = dynamic_cast<TrackMeterPlugin*>(plugin.get())) {
+        meteringBuffer_.assignSlot(trackId);
+        meter->setMeteringTarget(&meteringBuffer_, trackId, &modulator_.getSidechainBus(),
+                                 &audioTaps_);
     }
 
     return plugin;
@@ -736,9 +1351,14 @@ void AudioBridge::ensureVolumePluginPosition(te::AudioTrack* track) const {
     }
 
     // If VolumeAndPan is not at the end, move it there
-    // (It will end up second-to-last after LevelMeter is added)
-    int lastIndex = plugins.size() - 1;
-    if (volPanIndex < lastIndex) {
+    // (It will end up second-to-last after LevelMeter is added). Post-fader sends and the
+    // meter may follow it; anything else means a device was appended behind it.
+    bool onlyTailAfter = true;
+    for (int i = volPanIndex + 1; i < plugins.size() && onlyTailAfter; ++i) {
+        onlyTailAfter = dynamic_cast<te::AuxSendPlugin*>(plugins[i]) != nullptr ||
+                        dynamic_cast<te::LevelMeterPlugin*>(plugins[i]) != nullptr;
+    }
+    if (!onlyTailAfter) {
         // Move to end: remove from current position and re-insert at end
         // Keep a reference to prevent deletion
         volPanPlugin->removeFromParent();
@@ -746,35 +1366,163 @@ void AudioBridge::ensureVolumePluginPosition(te::AudioTrack* track) const {
     }
 }
 
-// =============================================================================
-// Track Mapping
-// =============================================================================
+void AudioBridge::ensureNotePreviewer(TrackId trackId, te::AudioTrack* track) {
+    if (!track)
+        return;
 
-te::AudioTrack* AudioBridge::getAudioTrack(TrackId trackId) const {
-    juce::ScopedLock lock(mappingLock_);
-    auto it = trackMapping_.find(trackId);
-    return it != trackMapping_.end() ? it->second : nullptr;
-}
+    auto& plugins = track->pluginList;
+    te::Plugin::Ptr previewer;
+    for (int i = 0; i < plugins.size(); ++i) {
+        if (dynamic_cast<NotePreviewPlugin*>(plugins[i])) {
+            previewer = plugins[i];
+            break;
+        }
+    }
+
+    if (!previewer) {
+        previewer = edit_.getPluginCache().createNewPlugin(NotePreviewPlugin::create());
+        if (!previewer)
+            return;
+        plugins.insertPlugin(previewer, 0, nullptr);
+    } else if (plugins.indexOf(previewer.get()) != 0) {
+        // Ahead of the instrument, so the notes reach it
+        previewer->removeFromParent();
+        plugins.insertPlugin(previewer, 0, nullptr);
+    }
 
-te::Plugin::Ptr AudioBridge::getPlugin(DeviceId deviceId) const {
     juce::ScopedLock lock(mappingLock_);
-    auto it = deviceToPlugin_.find(deviceId);
-    return it != deviceToPlugin_.end() ? it->second : nullptr;
+    notePreviewers_.assign(trackId, previewer);
+}
+
+bool AudioBridge::previewNote(TrackId trackId, int noteNumber, int velocity, bool isNoteOn) {
+    const double timeMs = juce::Time::getMillisecondCounterHiRes();
+
+    te::Plugin::Ptr previewer;
+    {
+        juce::ScopedLock lock(mappingLock_);
+        if (auto* mapped = notePreviewers_.find(trackId)) {
+            previewer = *mapped;
+        }
+    }
+
+    auto* plugin = dynamic_cast<NotePreviewPlugin*>(previewer.get());
+    if (plugin == nullptr || !plugin->post(noteNumber, velocity, isNoteOn, timeMs)) {
+        return false;
+    }
+
+    // A suspended chain would swallow the note; off the message thread the timer wakes it
+    if (juce::MessageManager::existsAndIsCurrentThread()) {
+        plugin->takeActivity();
+        wakeChain(trackId);
+    }
+    return true;
+}
+
+// =============================================================================
+// Track Mapping
+// =============================================================================
+
+te::AudioTrack* AudioBridge::getAudioTrack(TrackId trackId) const {
+    juce::ScopedLock lock(mappingLock_);
+    auto* track = trackMapping_.find(trackId);
+    return track ? *track : nullptr;
+}
+
+te::Plugin::Ptr AudioBridge::getPlugin(DeviceId deviceId) const {
+    juce::ScopedLock lock(mappingLock_);
+    auto* plugin = deviceToPlugin_.find(deviceId);
+    return plugin ? *plugin : nullptr;
+}
+
+juce::ValueTree AudioBridge::getPluginStateForSave(DeviceId deviceId) const {
+    auto plugin = getPlugin(deviceId);
+    if (plugin == nullptr) {
+        return {};
+    }
+
+    // A deep copy: the save encodes it on another thread
+    plugin->flushPluginStateToValueTree();
+    return plugin->state.createCopy();
+}
+
+void AudioBridge::clonePluginStates(const std::vector<std::pair<DeviceId, DeviceId>>& devices) {
+    for (const auto& [sourceId, copyId] : devices) {
+        // A source still loading has no state yet: its copy starts from the device's settings
+        auto state = getPluginStateForSave(sourceId);
+        if (state.isValid()) {
+            clonedPluginStates_[copyId] = std::move(state);
+        }
+    }
+}
+
+std::shared_ptr<const DeviceStateSnapshot> AudioBridge::captureDeviceState(
+    DeviceId deviceId) const {
+    auto plugin = getPlugin(deviceId);
+    const auto* device = TrackManager::getInstance().findDevice(deviceId);
+    if (plugin == nullptr || device == nullptr) {
+        return nullptr;
+    }
+
+    auto snapshot = std::make_shared<DeviceStateSnapshot>();
+    snapshot->state = encodePluginState(*plugin);
+    snapshot->parameterValues.reserve(device->parameters.size());
+    for (size_t i = 0; i < device->parameters.size(); ++i) {
+        snapshot->parameterValues.push_back(device->parameters.getValue(i));
+    }
+    return snapshot;
+}
+
+AudioBridge::StateRestore AudioBridge::restoreDeviceState(DeviceId deviceId,
+                                                          const DeviceStateSnapshot& snapshot) {
+    auto& tm = TrackManager::getInstance();
+    auto plugin = getPlugin(deviceId);
+    const auto* device = tm.findDevice(deviceId);
+    if (plugin == nullptr || device == nullptr) {
+        return StateRestore::Failed;
+    }
+    auto* processor = getDeviceProcessor(deviceId);
+
+    // Parameters first: between A/B states they are usually the whole difference, and
+    // reading a plugin's state back is far cheaper than loading one
+    if (processor != nullptr) {
+        DeviceInfo target = *device;
+        if (snapshot.applyParameters(target.parameters) >= 0) {
+            processor->syncFromDeviceInfo(target);
+            if (encodePluginState(*plugin) == snapshot.state) {
+                tm.updateDeviceParameters(deviceId, target.parameters);
+                return StateRestore::Parameters;
+            }
+        }
+    }
+
+    // Something besides parameters differs (a sample, a program, ...): load it all
+    auto state = juce::ValueTree::readFromData(snapshot.state.getData(), snapshot.state.getSize());
+    if (!state.isValid()) {
+        return StateRestore::Failed;
+    }
+    plugin->restorePluginStateFromValueTree(state);
+    if (processor != nullptr) {
+        processor->invalidateAppliedParameters();
+        DeviceInfo readBack;
+        processor->populateParameters(readBack);
+        tm.updateDeviceParameters(deviceId, readBack.parameters);
+    }
+    return StateRestore::Full;
 }
 
 DeviceProcessor* AudioBridge::getDeviceProcessor(DeviceId deviceId) const {
     juce::ScopedLock lock(mappingLock_);
-    auto it = deviceProcessors_.find(deviceId);
-    return it != deviceProcessors_.end() ? it->second.get() : nullptr;
+    auto* processor = deviceProcessors_.find(deviceId);
+    return processor ? processor->get() : nullptr;
 }
 
 te::AudioTrack* AudioBridge::createAudioTrack(TrackId trackId, const juce::String& name) {
     // Check if track already exists
     {
         juce::ScopedLock lock(mappingLock_);
-        auto it = trackMapping_.find(trackId);
-        if (it != trackMapping_.end() && it->second != nullptr) {
-            return it->second;
+        auto* existing = trackMapping_.find(trackId);
+        if (existing && *existing != nullptr) {
+            return *existing;
         }
     }
 
@@ -790,9 +1538,11 @@ te::AudioTrack* AudioBridge::createAudioTrack(TrackId trackId, const juce::Strin
         track->getOutput().setOutputToDefaultDevice(false);  // false = audio (not MIDI)
 
         juce::ScopedLock lock(mappingLock_);
-        trackMapping_[trackId] = track;
+        trackMapping_.assign(trackId, track);
 
-        // Don't register meter client yet - will do it when LevelMeter is added
+        // Meter slot for levels and MIDI activity; the LevelMeter is attached later
+        meteringBuffer_.assignSlot(trackId);
+        modulator_.addTrack(trackId);
         std::cout << "Created Tracktion AudioTrack for MAGDA track " << trackId << ": " << name
                   << " (routed to master)" << std::endl;
     }
@@ -805,25 +1555,21 @@ void AudioBridge::removeAudioTrack(TrackId trackId) {
 
     {
         juce::ScopedLock lock(mappingLock_);
-        auto it = trackMapping_.find(trackId);
-        if (it != trackMapping_.end()) {
-            track = it->second;
-
-            // Unregister meter client before removing track
-            if (track) {
-                auto* levelMeter = track->getLevelMeterPlugin();
-                if (levelMeter) {
-                    auto clientIt = meterClients_.find(trackId);
-                    if (clientIt != meterClients_.end()) {
-                        levelMeter->measurer.removeClient(clientIt->second);
-                        meterClients_.erase(clientIt);
-                    }
-                }
-            }
+        if (auto* mapped = trackMapping_.find(trackId)) {
+            track = *mapped;
 
-            trackMapping_.erase(it);
+            // Stop metering before removing track
+            detachTrackMeters(track);
+            meteringBuffer_.releaseSlot(trackId);
+            modulator_.removeTrack(trackId);
+
+            trackMapping_.erase(trackId);
+            notePreviewers_.erase(trackId);
         }
     }
+    frozenTracks_.erase(trackId);
+    chainGate_.remove(trackId);
+    suspendedPlugins_.erase(trackId);
 
     if (track) {
         edit_.deleteTrack(track);
@@ -831,15 +1577,563 @@ void AudioBridge::removeAudioTrack(TrackId trackId) {
     }
 }
 
+// =============================================================================
+// Track Freeze
+// =============================================================================
+
+void AudioBridge::setTrackFrozen(TrackId trackId, const juce::File& renderFile,
+                                 double startSeconds) {
+    auto* track = getAudioTrack(trackId);
+    if (!track || isTrackFrozen(trackId)) {
+        return;
+    }
+
+    const double length = te::AudioFile(engine_, renderFile).getLength();
+    if (length <= 0.0) {
+        DBG("AudioBridge::setTrackFrozen - unreadable render " << renderFile.getFullPathName());
+        return;
+    }
+
+    const auto range = te::TimeRange(te::TimePosition::fromSeconds(startSeconds),
+                                     te::TimeDuration::fromSeconds(length));
+    auto clip = insertWaveClip(*track, "Freeze", renderFile, te::ClipPosition{range},
+                               te::DeleteExistingClips::no);
+    if (!clip) {
+        DBG("AudioBridge::setTrackFrozen - couldn't create the render clip");
+        return;
+    }
+
+    wakeChain(trackId);  // The freeze takes over disabling its plugins
+    frozenTracks_[trackId] = clip->itemID;
+    reapplyFreezes();
+}
+
+void AudioBridge::clearTrackFrozen(TrackId trackId) {
+    const auto it = frozenTracks_.find(trackId);
+    if (it == frozenTracks_.end()) {
+        return;
+    }
+    const auto freezeClipId = it->second;
+    frozenTracks_.erase(it);
+
+    auto* track = getAudioTrack(trackId);
+    if (!track) {
+        return;
+    }
+
+    if (auto* freezeClip = track->findClipForID(freezeClipId)) {
+        freezeClip->removeFromParent();
+    }
+    for (auto* clip : track->getClips()) {
+        clip->setMuted(false);
+    }
+
+    // Plugins come back as the model has them, bypass included
+    const auto& tm = TrackManager::getInstance();
+    juce::ScopedLock lock(mappingLock_);
+    for (const auto& [plugin, deviceId] : pluginToDevice_) {
+        if (plugin->getOwnerTrack() == track) {
+            const auto* device = tm.findDevice(deviceId);
+            plugin->setEnabled(device == nullptr || !device->bypassed);
+        }
+    }
+}
+
+void AudioBridge::reapplyFreezes() {
+    if (frozenTracks_.empty()) {
+        return;
+    }
+
+    juce::ScopedLock lock(mappingLock_);
+    std::unordered_set<te::Track*> frozen;
+    trackMapping_.forEach([&](TrackId trackId, te::AudioTrack* track) {
+        const auto it = frozenTracks_.find(trackId);
+        if (it != frozenTracks_.end()) {
+            frozen.insert(track);
+        }
+
+        // Clips are muted only by freezing, so clips moved off a frozen track play again
+        for (auto* clip : track->getClips()) {
+            const bool mute = it != frozenTracks_.end() && clip->itemID != it->second;
+            if (clip->isMuted() != mute) {
+                clip->setMuted(mute);
+            }
+        }
+    });
+
+    for (const auto& [plugin, deviceId] : pluginToDevice_) {
+        if (plugin->isEnabled() && frozen.count(plugin->getOwnerTrack()) != 0) {
+            plugin->setEnabled(false);
+        }
+    }
+}
+
+// =============================================================================
+// Idle Chain Suspension
+// =============================================================================
+
+namespace {
+
+double chainGateNow() {
+    return juce::Time::getMillisecondCounterHiRes() * 0.001;
+}
+
+}  // namespace
+
+void AudioBridge::setChainSuspendTailSeconds(double seconds) {
+    chainGate_.setTailSeconds(seconds);
+    if (seconds <= 0.0) {
+        wakeAllChains();
+    }
+}
+
+void AudioBridge::wakeAllChains() {
+    const double now = chainGateNow();
+    auto suspended = std::exchange(suspendedPlugins_, {});
+    for (auto& [trackId, plugins] : suspended) {
+        chainGate_.wake(trackId, now);
+        for (auto& plugin : plugins) {
+            plugin->setEnabled(true);
+        }
+    }
+}
+
+void AudioBridge::setChainSuspensionPaused(bool paused) {
+    chainSuspensionPaused_ = paused;
+    if (paused) {
+        wakeAllChains();
+    }
+}
+
+void AudioBridge::setRenderQuality(RenderQuality quality) {
+    if (quality == renderQuality_) {
+        return;
+    }
+    renderQuality_ = quality;
+
+    // Clips playing a render (or a freeze) have no stretcher running and keep it that way
+    for (auto* track : te::getAudioTracks(edit_)) {
+        for (auto* clip : track->getClips()) {
+            auto* waveClip = dynamic_cast<te::WaveAudioClip*>(clip);
+            if (waveClip != nullptr &&
+                waveClip->getTimeStretchMode() != te::TimeStretcher::disabled) {
+                waveClip->setTimeStretchMode(getStretchMode());
+            }
+        }
+    }
+}
+
+te::TimeStretcher::Mode AudioBridge::getStretchMode() const {
+    // The best stretcher the build has is the default; SoundTouch's normal mode costs less
+    return renderQuality_ == RenderQuality::Final ? te::TimeStretcher::defaultMode
+                                                  : te::TimeStretcher::soundtouchNormal;
+}
+
+void AudioBridge::wakeChain(TrackId trackId) {
+    if (chainGate_.wake(trackId, chainGateNow())) {
+        resumeChain(trackId);
+    }
+}
+
+void AudioBridge::suspendChain(TrackId trackId, te::AudioTrack* track) {
+    auto& disabled = suspendedPlugins_[trackId];
+    for (const auto& [plugin, deviceId] : pluginToDevice_) {
+        // Bypassed devices are already out of the graph, and stay that way on resume
+        if (plugin->getOwnerTrack() == track && plugin->isEnabled()) {
+            plugin->setEnabled(false);
+            disabled.push_back(plugin);
+        }
+    }
+}
+
+void AudioBridge::resumeChain(TrackId trackId) {
+    const auto it = suspendedPlugins_.find(trackId);
+    if (it == suspendedPlugins_.end()) {
+        return;
+    }
+
+    auto plugins = std::move(it->second);
+    suspendedPlugins_.erase(it);
+    for (auto& plugin : plugins) {
+        plugin->setEnabled(true);  // Removed plugins are only held here until now
+    }
+}
+
+ChainSilenceGate::Observation AudioBridge::observeChain(const TrackInfo& track,
+                                                        te::AudioTrack& teTrack, int numDevices,
+                                                        double position, bool playing) {
+    ChainSilenceGate::Observation observation;
+    observation.numDevices = numDevices;
+
+    // Muted: nothing it produces is heard, whatever is coming in
+    if (track.muted) {
+        observation.outputSilent = true;
+        return observation;
+    }
+
+    // Inputs that can't be predicted: other tracks, live audio, notes into an instrument
+    bool takesNotes = false;
+    for (auto* plugin : teTrack.pluginList) {
+        takesNotes = takesNotes || (pluginToDevice_.count(plugin) != 0 && plugin->isSynth());
+    }
+    if (track.type == TrackType::Group || track.type == TrackType::Aux ||
+        track.type == TrackType::Master || track.recordArmed ||
+        track.audioInputDevice.isNotEmpty() || (takesNotes && track.midiInputDevice.isNotEmpty())) {
+        observation.inputExpected = true;
+        return observation;
+    }
+
+    // A clip under the playhead or about to reach it (across the loop point when looping)
+    if (playing) {
+        const auto& index = ClipManager::getInstance().getTrackClipIndex(track.id);
+        std::vector<ClipIntervalIndex::Interval> hits;
+        const double end = position + kChainWakeLookaheadSeconds;
+        index.query(position, end, hits);
+
+        auto& transport = edit_.getTransport();
+        const auto loop = transport.getLoopRange();
+        if (hits.empty() && transport.looping && end > loop.getEnd().inSeconds()) {
+            const double loopStart = loop.getStart().inSeconds();
+            index.query(loopStart, loopStart + (end - loop.getEnd().inSeconds()), hits);
+        }
+        observation.inputExpected = !hits.empty();
+    }
+
+    MeterData levels;
+    observation.outputSilent = meteringBuffer_.readLevels(track.id, levels) &&
+                               levels.peakL <= MeteringBuffer::kSilenceLevel &&
+                               levels.peakR <= MeteringBuffer::kSilenceLevel;
+    return observation;
+}
+
+void AudioBridge::updateChainSuspension() {
+    if (chainSuspensionPaused_) {
+        return;
+    }
+
+    // Devices per engine track, counted once per tick
+    std::unordered_map<te::Track*, int> deviceCounts;
+    for (const auto& [plugin, deviceId] : pluginToDevice_) {
+        ++deviceCounts[plugin->getOwnerTrack()];
+    }
+
+    auto& transport = edit_.getTransport();
+    const bool playing = transport.isPlaying();
+    const double position = transport.getPosition().inSeconds();
+    const double now = chainGateNow();
+    const auto& tm = TrackManager::getInstance();
+
+    trackMapping_.forEach([&](TrackId trackId, te::AudioTrack* teTrack) {
+        const auto* track = tm.getTrack(trackId);
+        if (track == nullptr || teTrack == nullptr || frozenTracks_.count(trackId) != 0) {
+            // Not gated (a freeze already has the plugins disabled)
+            if (chainGate_.remove(trackId)) {
+                resumeChain(trackId);
+            }
+            return;
+        }
+
+        const auto count = deviceCounts.find(teTrack);
+        const int numDevices = count != deviceCounts.end() ? count->second : 0;
+        const auto observation = observeChain(*track, *teTrack, numDevices, position, playing);
+
+        switch (chainGate_.update(trackId, observation, now)) {
+            case ChainSilenceGate::Action::Suspend:
+                suspendChain(trackId, teTrack);
+                break;
+            case ChainSilenceGate::Action::Resume:
+                resumeChain(trackId);
+                break;
+            case ChainSilenceGate::Action::None:
+                break;
+        }
+    });
+}
+
+// =============================================================================
+// Device CPU Measurement
+// =============================================================================
+
+void AudioBridge::setDeviceCpuMeasurementEnabled(bool enabled) {
+    if (enabled == deviceCpuMeasurement_) {
+        return;
+    }
+
+    deviceCpuMeasurement_ = enabled;
+    if (!enabled) {
+        deviceCpuMeter_.clear();
+    }
+    allDeviceStatusChanged_ = true;  // Every slot's CPU overlay comes or goes
+
+    std::vector<std::pair<TrackId, te::AudioTrack*>> tracks;
+    {
+        juce::ScopedLock lock(mappingLock_);
+        trackMapping_.forEach(
+            [&](TrackId trackId, te::AudioTrack* track) { tracks.emplace_back(trackId, track); });
+    }
+    for (const auto& [trackId, track] : tracks) {
+        syncTimingProbes(trackId, track);
+        syncSandboxBatches(track);
+    }
+}
+
+ChainCpuUsage AudioBridge::getChainCpuUsage(TrackId trackId) const {
+    const auto* track = TrackManager::getInstance().getTrack(trackId);
+    if (track == nullptr) {
+        return {};
+    }
+    return ChainCpuUsage::build(
+        *track, [this](DeviceId deviceId) { return deviceCpuMeter_.getReading(deviceId); });
+}
+
+GroupRenderPlan AudioBridge::getGroupRenderPlan() const {
+    const auto& tracks = TrackManager::getInstance().getTracks();
+    std::vector<GroupRenderPlan::Track> planTracks;
+    planTracks.reserve(tracks.size());
+    for (const auto& track : tracks) {
+        GroupRenderPlan::Track planTrack;
+        planTrack.id = track.id;
+        if (track.parentId != INVALID_TRACK_ID) {
+            planTrack.feeds.push_back(track.parentId);
+        }
+        for (const auto& send : track.sends) {
+            planTrack.feeds.push_back(send.destinationId);
+        }
+
+        const auto usage =
+            ChainCpuUsage::build(track, [this](DeviceId deviceId) {
+                return deviceCpuMeter_.getReading(deviceId);
+            }).getTrackUsage();
+        planTrack.cost = GroupRenderPlan::estimateTrackCost(usage.load, usage.devices,
+                                                            usage.measuredDevices);
+        planTracks.push_back(std::move(planTrack));
+    }
+    return GroupRenderPlan::build(planTracks);
+}
+
+void AudioBridge::syncTimingProbes(TrackId trackId, te::AudioTrack* track) {
+    if (track == nullptr) {
+        return;
+    }
+
+    // Start from a clean chain: the devices may have moved since the probes went in
+    auto& plugins = track->pluginList;
+    for (int i = plugins.size() - 1; i >= 0; --i) {
+        if (dynamic_cast<DeviceTimingProbePlugin*>(plugins[i])) {
+            plugins[i]->deleteFromParent();
+        }
+    }
+
+    if (!deviceCpuMeasurement_) {
+        return;
+    }
+
+    // The track's devices in render order
+    std::vector<std::pair<te::Plugin::Ptr, DeviceId>> devices;
+    {
+        juce::ScopedLock lock(mappingLock_);
+        for (int i = 0; i < plugins.size(); ++i) {
+            const auto it = pluginToDevice_.find(plugins[i]);
+            if (it != pluginToDevice_.end()) {
+                devices.emplace_back(plugins[i], it->second);
+            }
+        }
+    }
+    if (devices.empty()) {
+        return;
+    }
+
+    auto cursor = std::make_shared<DeviceTimingProbePlugin::Cursor>();
+    std::shared_ptr<DeviceCpuMeter::Counters> previous;
+    auto insertProbe = [&](int index) {
+        auto plugin = edit_.getPluginCache().createNewPlugin(DeviceTimingProbePlugin::create());
+        if (auto* probe = dynamic_cast<DeviceTimingProbePlugin*>(plugin.get())) {
+            probe->setTarget(cursor, previous);
+            plugins.insertPlugin(plugin, index, nullptr);
+        }
+    };
+
+    for (const auto& [plugin, deviceId] : devices) {
+        insertProbe(plugins.indexOf(plugin.get()));
+        previous = deviceCpuMeter_.getCounters(deviceId);
+    }
+    insertProbe(plugins.indexOf(devices.back().first.get()) + 1);
+}
+
+// =============================================================================
+// Sandboxed plugins
+// =============================================================================
+
+void AudioBridge::syncSandboxBatches(te::AudioTrack* track) {
+    if (track == nullptr) {
+        return;
+    }
+
+    // A run is consecutive enabled sandboxed plugins in one host; anything between two of
+    // them renders between them, so it ends the run
+    SandboxedPlugin* leader = nullptr;
+    std::vector<SandboxedPlugin*> followers;
+    auto endRun = [&] {
+        if (leader != nullptr) {
+            std::vector<int> slots;
+            for (auto* follower : followers) {
+                slots.push_back(follower->getSlot());
+            }
+            // The leader takes the followers on before they stop rendering themselves
+            leader->setBatch(slots);
+            for (auto* follower : followers) {
+                follower->setFollower(true);
+            }
+        }
+        leader = nullptr;
+        followers.clear();
+    };
+
+    auto& plugins = track->pluginList;
+    for (int i = 0; i < plugins.size(); ++i) {
+        auto* sandboxed = dynamic_cast<SandboxedPlugin*>(plugins[i]);
+        if (sandboxed == nullptr || !sandboxed->isEnabled() || sandboxed->getHost() == nullptr) {
+            if (sandboxed != nullptr) {
+                sandboxed->setBatch({});
+                sandboxed->setFollower(false);
+            }
+            endRun();
+            continue;
+        }
+
+        if (leader != nullptr && sandboxed->getHost() == leader->getHost() &&
+            static_cast<int>(followers.size()) + 1 < SandboxTransport::kMaxSlots) {
+            followers.push_back(sandboxed);
+        } else {
+            endRun();
+            leader = sandboxed;
+            leader->setFollower(false);
+        }
+    }
+    endRun();
+}
+
+void AudioBridge::resandboxDevice(TrackId trackId, const DeviceInfo& device) {
+    auto* track = getAudioTrack(trackId);
+    auto old = getPlugin(device.id);
+    if (track == nullptr || old == nullptr) {
+        return;
+    }
+
+    wakeChain(trackId);
+    if (windowManager_) {
+        windowManager_->closeWindowsForDevice(device.id);
+    }
+
+    // Both kinds keep the plugin's state in the same property, so it carries across
+    old->flushPluginStateToValueTree();
+    clonedPluginStates_[device.id] = old->state.createCopy();
+    const int index = track->pluginList.indexOf(old.get());
+    {
+        juce::ScopedLock lock(mappingLock_);
+        pluginToDevice_.erase(old.get());
+        deviceToPlugin_.erase(device.id);
+        deviceProcessors_.erase(device.id);
+        removeTransportSyncedDevice(device.id);
+        old->deleteFromParent();
+        old = nullptr;
+    }
+
+    const double loadStartMs = juce::Time::getMillisecondCounterHiRes();
+    auto plugin = loadDeviceAsPlugin(trackId, device);
+    recordPluginLoad(device, loadStartMs, plugin != nullptr);
+    clonedPluginStates_.erase(device.id);
+    {
+        juce::ScopedLock lock(mappingLock_);
+        if (plugin != nullptr) {
+            // Loaded at the end of the chain: back to where the old one was
+            if (index >= 0 && track->pluginList.indexOf(plugin.get()) != index) {
+                plugin->removeFromParent();
+                track->pluginList.insertPlugin(plugin, index, nullptr);
+            }
+            deviceToPlugin_.assign(device.id, plugin);
+            pluginToDevice_[plugin.get()] = device.id;
+        }
+        rebuildParameterTable();
+    }
+
+    ensureVolumePluginPosition(track);
+    addLevelMeterToTrack(trackId);
+    syncTrackSends(trackId);
+    syncTimingProbes(trackId, track);
+    syncSandboxBatches(track);
+    rebuildModulation();
+    markDeviceStatusChanged(device.id);
+}
+
+std::shared_ptr<SandboxHost> AudioBridge::getSandboxHost(TrackId trackId) {
+    auto& weakHost = sandboxHosts_[trackId];
+    if (auto host = weakHost.lock()) {
+        return host;
+    }
+
+    const auto* trackInfo = TrackManager::getInstance().getTrack(trackId);
+    auto host = std::make_shared<SandboxHost>(
+        trackInfo != nullptr ? trackInfo->name : "track " + juce::String(trackId));
+    const auto* key = host.get();
+    host->onPluginLoaded = [this, key](int slot, const juce::String& error) {
+        handleSandboxLoaded(key, slot, error);
+    };
+    host->onCrashed = [this, key] { handleSandboxCrashed(key); };
+    weakHost = host;
+    return host;
+}
+
+DeviceId AudioBridge::findSandboxedDevice(const SandboxHost* host, int slot) const {
+    juce::ScopedLock lock(mappingLock_);
+    for (const auto& [plugin, deviceId] : pluginToDevice_) {
+        const auto* sandboxed = dynamic_cast<const SandboxedPlugin*>(plugin);
+        if (sandboxed != nullptr && sandboxed->getHost() == host && sandboxed->getSlot() == slot) {
+            return deviceId;
+        }
+    }
+    return INVALID_DEVICE_ID;
+}
+
+void AudioBridge::handleSandboxLoaded(const SandboxHost* host, int slot,
+                                      const juce::String& error) {
+    const auto deviceId = findSandboxedDevice(host, slot);
+    if (deviceId == INVALID_DEVICE_ID) {
+        return;
+    }
+    if (error.isNotEmpty()) {
+        if (onPluginLoadFailed) {
+            onPluginLoadFailed(deviceId, error);
+        }
+        return;
+    }
+
+    // The plugin's latency is only known now, so the graph is compensated again
+    if (host->getLatencySamples(slot) > 0) {
+        edit_.restartPlayback();
+    }
+}
+
+void AudioBridge::handleSandboxCrashed(const SandboxHost* host) {
+    for (int slot = 0; slot < SandboxTransport::kMaxSlots; ++slot) {
+        const auto deviceId = findSandboxedDevice(host, slot);
+        if (deviceId != INVALID_DEVICE_ID && onPluginLoadFailed) {
+            onPluginLoadFailed(deviceId, "The plugin's host process crashed");
+        }
+    }
+}
+
 // =============================================================================
 // Parameter Queue
 // =============================================================================
 
-bool AudioBridge::pushParameterChange(DeviceId deviceId, int paramIndex, float value) {
+bool AudioBridge::pushParameterChange(DeviceId deviceId, int paramIndex, float value,
+                                      float rampMs) {
     ParameterChange change;
     change.deviceId = deviceId;
     change.paramIndex = paramIndex;
     change.value = value;
+    change.rampMs = rampMs;
     change.source = ParameterChange::Source::User;
     return parameterQueue_.push(change);
 }
@@ -857,6 +2151,9 @@ void AudioBridge::syncAll() {
         syncTrackPlugins(track.id);
     }
 
+    // Sends resolve against the aux tracks that exist now
+    syncAuxBuses();
+
     // Sync master channel volume/pan to Tracktion Engine
     masterChannelChanged();
 }
@@ -874,14 +2171,20 @@ void AudioBridge::syncTrackPlugins(TrackId trackId) {
     if (!teTrack)
         return;
 
+    // Plugins are about to be added, removed or re-enabled: start from the awake state
+    wakeChain(trackId);
+
     // For Phase 1, we'll sync top-level devices on the track
-    // (Full nested rack support comes in Phase 3)
+    // (Full nested rack support comes in Phase 3). Racks should map onto te::RackType:
+    // its chains become independent branches of the playback graph, which the
+    // multi-threaded player already spreads across the render threads, and the rack's
+    // summing node adds them in a fixed order whichever thread finished first.
 
     // Get current MAGDA devices
     std::vector<DeviceId> magdaDevices;
     for (const auto& element : trackInfo->chainElements) {
-        if (std::holds_alternative<DeviceInfo>(element)) {
-            magdaDevices.push_back(std::get<DeviceInfo>(element).id);
+        if (isDevice(element)) {
+            magdaDevices.push_back(getDevice(element).id);
         }
     }
 
@@ -889,9 +2192,8 @@ void AudioBridge::syncTrackPlugins(TrackId trackId) {
     {
         juce::ScopedLock lock(mappingLock_);
         std::vector<DeviceId> toRemove;
-        for (const auto& [deviceId, plugin] : deviceToPlugin_) {
-            auto pluginIt = pluginToDevice_.find(plugin.get());
-            if (pluginIt != pluginToDevice_.end()) {
+        deviceToPlugin_.forEach([&](DeviceId deviceId, const te::Plugin::Ptr& plugin) {
+            if (pluginToDevice_.find(plugin.get()) != pluginToDevice_.end()) {
                 // Check if this plugin belongs to this track
                 auto* owner = plugin->getOwnerTrack();
                 if (owner == teTrack) {
@@ -903,7 +2205,7 @@ void AudioBridge::syncTrackPlugins(TrackId trackId) {
                     }
                 }
             }
-        }
+        });
 
         for (auto deviceId : toRemove) {
             // Close plugin window before removing device (via PluginWindowManager)
@@ -911,122 +2213,977 @@ void AudioBridge::syncTrackPlugins(TrackId trackId) {
                 windowManager_->closeWindowsForDevice(deviceId);
             }
 
-            auto it = deviceToPlugin_.find(deviceId);
-            if (it != deviceToPlugin_.end()) {
-                auto plugin = it->second;
-                pluginToDevice_.erase(plugin.get());
-                deviceToPlugin_.erase(it);
-                plugin->deleteFromParent();
+            if (auto* mapped = deviceToPlugin_.find(deviceId)) {
+                auto plugin = *mapped;
+                pluginToDevice_.erase(plugin.get());
+                deviceToPlugin_.erase(deviceId);
+                plugin->deleteFromParent();
+            }
+
+            // Clean up device processor
+            deviceProcessors_.erase(deviceId);
+            removeTransportSyncedDevice(deviceId);
+            parameterQueue_.releaseDevice(deviceId);
+            deviceCpuMeter_.remove(deviceId);
+        }
+
+        if (!toRemove.empty()) {
+            rebuildParameterTable();
+        }
+    }
+
+    // Add new plugins for MAGDA devices that don't have TE counterparts
+    bool addedPlugins = false;
+    bool queuedPlugins = false;
+    bool trackHasQueuedLoad = std::any_of(
+        pendingPluginLoads_.begin(), pendingPluginLoads_.end(),
+        [trackId](const PendingPluginLoad& load) { return load.trackId == trackId; });
+
+    for (const auto& element : trackInfo->chainElements) {
+        if (isDevice(element)) {
+            const auto& device = getDevice(element);
+
+            if (loadingDevices_.count(device.id) != 0) {
+                continue;
+            }
+
+            juce::ScopedLock lock(mappingLock_);
+            if (!deviceToPlugin_.contains(device.id)) {
+                // External plugins are slow to instantiate, as is restoring a copy's state:
+                // queue them (and anything after them on this track) instead of blocking
+                // the message thread
+                if (device.format != PluginFormat::Internal || trackHasQueuedLoad ||
+                    clonedPluginStates_.count(device.id) != 0) {
+                    pendingPluginLoads_.push_back({trackId, device.id});
+                    loadingDevices_.insert(device.id);
+                    markDeviceStatusChanged(device.id);
+                    trackHasQueuedLoad = true;
+                    queuedPlugins = true;
+                    continue;
+                }
+
+                // Load this device as a plugin
+                const double loadStartMs = juce::Time::getMillisecondCounterHiRes();
+                auto plugin = loadDeviceAsPlugin(trackId, device);
+                recordPluginLoad(device, loadStartMs, plugin != nullptr);
+                if (plugin) {
+                    deviceToPlugin_.assign(device.id, plugin);
+                    pluginToDevice_[plugin.get()] = device.id;
+                    addedPlugins = true;
+                }
+            }
+        }
+    }
+
+    if (addedPlugins) {
+        juce::ScopedLock lock(mappingLock_);
+        rebuildParameterTable();
+    }
+
+    if (queuedPlugins) {
+        LoadProfiler::getInstance().setItemsPending(true);
+        triggerAsyncUpdate();
+    }
+
+    // Ensure VolumeAndPan is near the end of the chain (before LevelMeter)
+    // This is the track's fader control - it should come AFTER audio sources
+    ensureVolumePluginPosition(teTrack);
+
+    // Ensure LevelMeter is at the end of the plugin chain for metering
+    addLevelMeterToTrack(trackId);
+    ensureNotePreviewer(trackId, teTrack);
+    syncTrackSends(trackId);
+    syncTimingProbes(trackId, teTrack);
+    syncSandboxBatches(teTrack);
+
+    reapplyFreezes();
+}
+
+void AudioBridge::ensureTrackMapping(TrackId trackId) {
+    if (!getAudioTrack(trackId)) {
+        auto* trackInfo = TrackManager::getInstance().getTrack(trackId);
+        if (trackInfo) {
+            createAudioTrack(trackId, trackInfo->name);
+        }
+    }
+}
+
+// =============================================================================
+// Audio Callback Support
+// =============================================================================
+
+void AudioBridge::processParameterChanges(int numSamples, double sampleRate) {
+    MonitoredProfiler monitor(paramChangesCounter_);
+
+    if (!parameterQueue_.hasPending() && parameterRamps_.getNumActive() == 0) {
+        return;
+    }
+
+    auto* table = parameterTable_.acquire();
+
+    // Values are written without notification: a synchronous one would run every listener
+    // (including ExternalPluginProcessor's) here on the audio thread. The UI already has
+    // these values, and the plugin reads them from the parameter directly
+    parameterQueue_.popAll([this, table, sampleRate](const ParameterChange& change) {
+        auto* param = table != nullptr ? table->find(change.deviceId, change.paramIndex) : nullptr;
+        if (param == nullptr) {
+            return;
+        }
+
+        const int rampSamples = static_cast<int>(change.rampMs * 0.001 * sampleRate);
+        if (!parameterRamps_.start({change.deviceId, change.paramIndex},
+                                   param->getCurrentValue(), change.value, rampSamples)) {
+            param->setParameter(change.value, juce::dontSendNotification);
+        }
+    });
+
+    // Ramps are resolved against the current table, so one that outlives its device (or
+    // the table it started on) just stops being applied. Sub-block values are written in
+    // sample order, so the parameter always holds the latest one
+    parameterRamps_.advance(numSamples, [table](const RampKey& key, float value,
+                                                int /*sampleOffset*/) {
+        auto* param = table != nullptr ? table->find(key.deviceId, key.paramIndex) : nullptr;
+        if (param != nullptr) {
+            param->setParameter(value, juce::dontSendNotification);
+        }
+    });
+
+    parameterTable_.release();
+}
+
+void AudioBridge::rebuildParameterTable() {
+    auto table = std::make_unique<ParameterTable>();
+
+    // Same indexing as deviceToPlugin_, so the table is sized by its capacity
+    table->ranges.resize(deviceToPlugin_.getCapacity());
+    table->plugins.reserve(deviceToPlugin_.size());
+
+    deviceToPlugin_.forEach([&table](DeviceId deviceId, const te::Plugin::Ptr& plugin) {
+        if (!plugin) {
+            return;
+        }
+
+        auto params = plugin->getAutomatableParameters();
+        auto& range = table->ranges[static_cast<size_t>(deviceId)];
+        range.begin = static_cast<int>(table->parameters.size());
+        range.count = static_cast<int>(params.size());
+        for (auto* param : params) {
+            table->parameters.push_back(param);
+        }
+        table->plugins.push_back(plugin);
+    });
+
+    parameterTable_.publish(std::move(table));
+
+    // Automation targets resolve against the same plugins
+    automationDirty_ = true;
+}
+
+void AudioBridge::rebuildModulation() {
+    if (isShuttingDown_.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    juce::ScopedLock lock(mappingLock_);
+    modulator_.compile(TrackManager::getInstance(),
+                       [this](DeviceId deviceId, int paramIndex,
+                              AudioModulator::ResolvedTarget& resolved) {
+                           auto* plugin = deviceToPlugin_.find(deviceId);
+                           if (!plugin || !*plugin) {
+                               return false;
+                           }
+
+                           // By index: getAutomatableParameters() would copy the whole list
+                           // for every target
+                           if (paramIndex < 0 ||
+                               paramIndex >= (*plugin)->getNumAutomatableParameters()) {
+                               return false;
+                           }
+
+                           auto param = (*plugin)->getAutomatableParameter(paramIndex);
+                           if (!param) {
+                               return false;
+                           }
+                           resolved.parameter = param.get();
+                           resolved.plugin = *plugin;
+                           return true;
+                       },
+                       // Followers listen to the same input channels the track records
+                       [this](TrackId trackId) {
+                           const auto* track = TrackManager::getInstance().getTrack(trackId);
+                           if (track == nullptr || track->audioInputDevice.isEmpty()) {
+                               return std::vector<int>{};
+                           }
+                           return getRecordingChannels(track->audioInputDevice);
+                       });
+}
+
+void AudioBridge::rebuildAutomation() {
+    if (isShuttingDown_.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    juce::ScopedLock lock(mappingLock_);
+    automationDirty_ = false;
+    automationPlayer_.compile(
+        AutomationManager::getInstance(),
+        [this](const AutomationTarget& target, AutomationPlayer::ResolvedTarget& resolved) {
+            switch (target.type) {
+                case AutomationTargetType::TrackVolume:
+                case AutomationTargetType::TrackPan: {
+                    auto* track = getAudioTrack(target.trackId);
+                    auto* volPan = track ? track->getVolumePlugin() : nullptr;
+                    if (!volPan) {
+                        return false;
+                    }
+                    const bool volume = target.type == AutomationTargetType::TrackVolume;
+                    resolved.parameter = volume ? volPan->volParam.get() : volPan->panParam.get();
+                    resolved.plugin = volPan;
+                    resolved.info = target.getParameterInfo();
+                    resolved.faderPosition = volume;
+                    return true;
+                }
+                case AutomationTargetType::DeviceParameter: {
+                    auto* device =
+                        TrackManager::getInstance().getDeviceInChainByPath(target.devicePath);
+                    if (!device || target.paramIndex < 0 ||
+                        target.paramIndex >= static_cast<int>(device->parameters.size())) {
+                        return false;
+                    }
+                    auto* plugin = deviceToPlugin_.find(device->id);
+                    if (!plugin || !*plugin ||
+                        target.paramIndex >= (*plugin)->getNumAutomatableParameters()) {
+                        return false;
+                    }
+                    auto param = (*plugin)->getAutomatableParameter(target.paramIndex);
+                    if (!param) {
+                        return false;
+                    }
+                    resolved.parameter = param.get();
+                    resolved.plugin = *plugin;
+                    resolved.info = device->parameters[static_cast<size_t>(target.paramIndex)];
+                    return true;
+                }
+                case AutomationTargetType::Macro:
+                case AutomationTargetType::ModParameter:
+                    break;
+            }
+            return false;
+        });
+}
+
+bool AudioBridge::readBackModulation() {
+    if (!audioCallbackRunning_.load(std::memory_order_acquire) ||
+        isShuttingDown_.load(std::memory_order_acquire)) {
+        return false;
+    }
+
+    // Mod settings are edited in place without notifications; pick them up here
+    if (!modulator_.readBack(TrackManager::getInstance())) {
+        rebuildModulation();
+    }
+    return true;
+}
+
+// =============================================================================
+// AudioIODeviceCallback implementation
+// =============================================================================
+
+void AudioBridge::audioDeviceIOCallbackWithContext(
+    const float* const* inputChannelData, int numInputChannels,
+    float* const* outputChannelData, int numOutputChannels, int numSamples,
+    const juce::AudioIODeviceCallbackContext& /*context*/) {
+    // Tracktion renders the audio; this callback only adds the click and directly monitored
+    // inputs to the device mix
+    for (int channel = 0; channel < numOutputChannels; ++channel) {
+        if (outputChannelData[channel] != nullptr) {
+            juce::FloatVectorOperations::clear(outputChannelData[channel], numSamples);
+        }
+    }
+
+    if (isShuttingDown_.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    ScopedRealtimeContext realtime;
+    TraceRecorder::getInstance().setCurrentThreadName("Audio");
+    MonitoredProfiler monitor(audioCallbackCounter_);
+    RenderThreadPolicy::getInstance().applyToCurrentThread();
+
+    // Stage timings for the profiler (wait-free clock reads, pushed to a ring at the end)
+    const auto callbackStart = juce::Time::getHighResolutionTicks();
+    auto stageStart = callbackStart;
+    AudioCallbackTiming timing;
+    auto endStage = [&stageStart, &timing](AudioCallbackTiming::Stage stage) {
+        const auto now = juce::Time::getHighResolutionTicks();
+        timing.stageMs[stage] +=
+            static_cast<float>(juce::Time::highResolutionTicksToSeconds(now - stageStart) * 1000.0);
+        stageStart = now;
+    };
+
+    const double sampleRate = deviceSampleRate_.load(std::memory_order_relaxed);
+    processParameterChanges(numSamples, sampleRate);
+    endStage(AudioCallbackTiming::Parameters);
+
+    // Derive per-block trigger edges from the UI-published transport state
+    const bool playing = transportPlaying_.load(std::memory_order_acquire);
+
+    AudioModulator::Transport transport;
+    transport.bpm = tempoBpm_.load(std::memory_order_relaxed);
+    transport.justStarted = playing && !audioSawPlaying_;
+    audioSawPlaying_ = playing;
+
+    if (transport.justStarted) {
+        eventQueue_.push({AudioEvent::Type::TransportStarted});
+    }
+
+    // Jumps reach the audio thread's clock before anything reads it this block
+    const auto seeks = transportSeekCount_.load(std::memory_order_acquire);
+    const bool seeked = seeks != audioSeenSeekCount_;
+    if (seeked) {
+        audioSeenSeekCount_ = seeks;
+        audioPositionSeconds_ = transportSeekSeconds_.load(std::memory_order_relaxed);
+        audioWrapAtBlockStart_ = false;
+    }
+    const double blockStartSeconds = audioPositionSeconds_;
+    const int loopSample = processBeatClock(numSamples, sampleRate, playing, transport.bpm,
+                                            outputChannelData, numOutputChannels);
+    mixDirectMonitoring(inputChannelData, numInputChannels, outputChannelData, numOutputChannels,
+                        numSamples);
+
+    // The wrap comes from the audio thread's own clock, so triggers see it in the block
+    // that plays the loop start rather than whenever the UI timer notices
+    transport.justLooped = loopSample >= 0;
+    if (transport.justLooped) {
+        eventQueue_.push({AudioEvent::Type::LoopWrapped, INVALID_TRACK_ID, loopSample});
+    }
+    publishPlayheadClock(blockStartSeconds, transport, playing, loopSample, numSamples,
+                         sampleRate);
+
+    // This input was played against output heard a block each way plus the device
+    // latencies ago, so it belongs that much earlier on the timeline
+    if (playing && sampleRate > 0.0) {
+        const int roundTripSamples = 2 * numSamples +
+                                     inputLatencySamples_.load(std::memory_order_relaxed) +
+                                     outputLatencySamples_.load(std::memory_order_relaxed);
+        const int dropped =
+            diskRecorder_.process(inputChannelData, numInputChannels, numSamples,
+                                  blockStartSeconds - roundTripSamples / sampleRate);
+        if (dropped > 0) {
+            eventQueue_.push({AudioEvent::Type::RecordDropout, INVALID_TRACK_ID, dropped});
+        }
+    }
+
+    // Tracktion renders MIDI that arrived before this block in this block; it is heard one
+    // block plus the device's output latency from now
+    const double midiInputTime = pendingMidiInputTime_.exchange(0.0, std::memory_order_acquire);
+    if (midiInputTime > 0.0 && sampleRate > 0.0) {
+        const double nowSeconds = juce::Time::getMillisecondCounterHiRes() * 0.001;
+        const double outputSeconds =
+            (numSamples + outputLatencySamples_.load(std::memory_order_relaxed)) / sampleRate;
+        const double latencySeconds = nowSeconds - midiInputTime + outputSeconds;
+        eventQueue_.push({AudioEvent::Type::MidiLatency, INVALID_TRACK_ID,
+                          static_cast<int>(latencySeconds * 1.0e6)});
+    }
+
+    int newXruns = 0;
+    if (auto* device = audioDevice_.load(std::memory_order_acquire)) {
+        const int xruns = device->getXRunCount();  // -1 if the device doesn't report them
+        if (xruns > audioSeenXruns_) {
+            newXruns = xruns - audioSeenXruns_;
+            eventQueue_.push({AudioEvent::Type::Xrun, INVALID_TRACK_ID, newXruns});
+            audioSeenXruns_ = xruns;
+        }
+    }
+    endStage(AudioCallbackTiming::Events);
+
+    // Automation sets parameters' own values; modulation rides on top as their modifiers
+    automationPlayer_.process(blockStartSeconds, playing,
+                              seeked || transport.justStarted || transport.justLooped);
+    endStage(AudioCallbackTiming::Automation);
+
+    modulator_.process(numSamples, sampleRate, transport, {inputChannelData, numInputChannels});
+    endStage(AudioCallbackTiming::Modulation);
+
+    if (sampleRate > 0.0) {
+        timing.totalMs = static_cast<float>(
+            juce::Time::highResolutionTicksToSeconds(stageStart - callbackStart) * 1000.0);
+        timing.budgetMs = static_cast<float>(numSamples * 1000.0 / sampleRate);
+        if (audioLastCallbackTicks_ != 0) {
+            timing.intervalMs = static_cast<float>(
+                juce::Time::highResolutionTicksToSeconds(callbackStart - audioLastCallbackTicks_) *
+                1000.0);
+        }
+        callbackTimings_.push(timing);
+
+        if (timing.overran() || newXruns > 0) {
+            DropoutLog::Event dropout;
+            dropout.wallTimeMs = juce::Time::currentTimeMillis();
+            dropout.numSamples = numSamples;
+            dropout.sampleRate = sampleRate;
+            dropout.callbackMs = timing.totalMs;
+            dropout.budgetMs = timing.budgetMs;
+            dropout.intervalMs = timing.intervalMs;
+            dropout.stage = AudioCallbackTiming::getStageName(timing.slowestStage());
+            dropout.deviceXruns = newXruns;
+            dropout.positionSeconds = blockStartSeconds;
+            dropout.bpm = transport.bpm;
+            dropout.playing = playing;
+            dropoutLog_.push(dropout);
+        }
+    }
+    audioLastCallbackTicks_ = callbackStart;
+}
+
+void AudioBridge::audioDeviceAboutToStart(juce::AudioIODevice* device) {
+    deviceSampleRate_.store(device ? device->getCurrentSampleRate() : 0.0,
+                            std::memory_order_relaxed);
+    // Imported files are converted to the rate the session runs at. A restart for a new
+    // buffer size leaves both alone, so a click that's sounding carries on
+    if (device && device->getCurrentSampleRate() != preparedSampleRate_) {
+        preparedSampleRate_ = device->getCurrentSampleRate();
+        AudioFileImporter::getInstance().setSessionSampleRate(preparedSampleRate_);
+        clickGenerator_.prepare(preparedSampleRate_);
+    }
+    // The callback isn't running yet, so its xrun baseline can be set from here
+    audioSeenXruns_ = device ? juce::jmax(0, device->getXRunCount()) : 0;
+    outputLatencySamples_.store(device ? device->getOutputLatencyInSamples() : 0,
+                                std::memory_order_relaxed);
+    inputLatencySamples_.store(device ? device->getInputLatencyInSamples() : 0,
+                               std::memory_order_relaxed);
+    audioLastCallbackTicks_ = 0;  // Don't count the restart gap as a late callback
+    audioDevice_.store(device, std::memory_order_release);
+    audioCallbackRunning_.store(true, std::memory_order_release);
+}
+
+void AudioBridge::audioDeviceStopped() {
+    audioCallbackRunning_.store(false, std::memory_order_release);
+    audioDevice_.store(nullptr, std::memory_order_release);
+}
+
+// =============================================================================
+// Transport State
+// =============================================================================
+
+void AudioBridge::updateTransportState(bool isPlaying, double bpm) {
+    // UI thread writes, audio thread reads - use release/acquire semantics
+    transportPlaying_.store(isPlaying, std::memory_order_release);
+    tempoBpm_.store(bpm, std::memory_order_relaxed);
+
+    // Called every UI frame; synced devices only need switching on a start or stop
+    if (isPlaying == transportSyncedPlaying_) {
+        return;
+    }
+    transportSyncedPlaying_ = isPlaying;
+
+    juce::ScopedLock lock(mappingLock_);
+    for (const auto deviceId : transportSyncedDevices_) {
+        if (auto* processor = deviceProcessors_.find(deviceId)) {
+            // Test Tone is always transport-synced: bypassed when stopped
+            (*processor)->setBypassed(!isPlaying);
+            DBG("AudioBridge::updateTransportState - Tone generator device "
+                << deviceId << " bypassed=" << (!isPlaying ? "YES" : "NO"));
+        }
+    }
+}
+
+void AudioBridge::removeTransportSyncedDevice(DeviceId deviceId) {
+    transportSyncedDevices_.erase(
+        std::remove(transportSyncedDevices_.begin(), transportSyncedDevices_.end(), deviceId),
+        transportSyncedDevices_.end());
+}
+
+void AudioBridge::transportStarting(double positionSeconds) {
+    transportSeeked(positionSeconds);
+    transportPlaying_.store(true, std::memory_order_release);
+}
+
+void AudioBridge::transportSeeked(double positionSeconds) {
+    transportSeekSeconds_.store(positionSeconds, std::memory_order_relaxed);
+    transportSeekCount_.fetch_add(1, std::memory_order_release);
+}
+
+// =============================================================================
+// Read-ahead
+// =============================================================================
+
+void AudioBridge::updateReadAhead() {
+    if (readAheadClipsDirty_) {
+        readAheadClipsDirty_ = false;
+        readAheadClips_.clear();
+        const auto& clipManager = ClipManager::getInstance();
+        const auto& geometry = clipManager.getClipGeometry();
+        for (size_t i = 0; i < geometry.size(); ++i) {
+            // Session clips play from wherever they are launched; only the arrangement's
+            // positions are known ahead of time
+            if (geometry[i].type != ClipType::Audio || geometry[i].sceneIndex >= 0) {
+                continue;
+            }
+            const auto& clip = clipManager.getClips()[i];
+            for (const auto& source : clip.audioSources) {
+                AudioReadAhead::ClipSpan span;
+                span.filePath = source.filePath;
+                span.startSeconds = clip.startTime + source.position;
+                span.lengthSeconds = clip.internalLoopEnabled
+                                         ? clip.length - source.position
+                                         : std::min(source.length, clip.length - source.position);
+                span.fileOffsetSeconds = source.offset;
+                span.stretchFactor = source.stretchFactor;
+                span.looped = clip.internalLoopEnabled;
+                span.loopFileSeconds = source.length / source.stretchFactor;
+                readAheadClips_.push_back(span);
+            }
+        }
+    }
+
+    // Direction and speed from how far the playhead moved since the last tick, which
+    // covers scrubbing as well as playback
+    const auto& transport = edit_.getTransport();
+    const double position = transport.position.get().inSeconds();
+    const double nowMs = juce::Time::getMillisecondCounterHiRes();
+    const double elapsed = (nowMs - readAheadTimeMs_) * 0.001;
+    double speed = elapsed > 0.0 ? (position - readAheadPosition_) / elapsed : 0.0;
+    if (std::abs(speed) > AudioReadAhead::kMaxSpeed) {
+        speed = transport.isPlaying() ? 1.0 : 0.0;
+    }
+    readAheadPosition_ = position;
+    readAheadTimeMs_ = nowMs;
+
+    // Looping, the loop start is read in before the playhead wraps into it
+    AudioReadAhead::Loop loop;
+    if (transport.looping.get()) {
+        const auto range = transport.getLoopRange();
+        loop.startSeconds = range.getStart().inSeconds();
+        loop.endSeconds = range.getEnd().inSeconds();
+    }
+    readAhead_.update(position, speed, readAheadClips_, loop);
+}
+
+// =============================================================================
+// Recording
+// =============================================================================
+
+bool AudioBridge::startRecording(const juce::File& folder) {
+    const double sampleRate = deviceSampleRate_.load(std::memory_order_relaxed);
+    if (diskRecorder_.isRecording() || sampleRate <= 0.0) {
+        return false;
+    }
+
+    const auto stamp = juce::Time::getCurrentTime().formatted("%Y%m%d-%H%M%S");
+    std::vector<DiskRecorder::Input> inputs;
+    for (const auto& track : TrackManager::getInstance().getTracks()) {
+        if (!track.recordArmed || track.type != TrackType::Audio ||
+            track.audioInputDevice.isEmpty()) {
+            continue;
+        }
+        auto channels = getRecordingChannels(track.audioInputDevice);
+        if (channels.empty()) {
+            DBG("AudioBridge::startRecording - no active channels for input '"
+                << track.audioInputDevice << "' on track " << track.id);
+            continue;
+        }
+        const auto name = juce::File::createLegalFileName(track.name + " " + stamp);
+        inputs.push_back(
+            {track.id, std::move(channels), folder.getNonexistentChildFile(name, ".wav", false)});
+    }
+    if (inputs.empty()) {
+        return false;
+    }
+
+    DiskRecorder::Options options;
+    options.sampleRate = sampleRate;
+    if (!diskRecorder_.start(inputs, options)) {
+        return false;
+    }
+    recordingSampleRate_ = sampleRate;
+    return true;
+}
+
+int AudioBridge::stopRecording() {
+    const auto takes = diskRecorder_.stop();
+    if (takes.empty()) {
+        return 0;
+    }
+
+    auto& undoManager = UndoManager::getInstance();
+    undoManager.beginCompoundOperation("Record");
+    int created = 0;
+    for (const auto& take : takes) {
+        const double length = static_cast<double>(take.numFrames) / recordingSampleRate_;
+        // Audio from before the timeline's start stays in the file, ahead of the clip
+        const double trim = std::max(0.0, -take.startSeconds);
+        if (length <= trim) {
+            continue;
+        }
+        if (take.droppedFrames > 0) {
+            std::cerr << "Recorded take on track " << take.trackId << " has "
+                      << take.droppedFrames << " frames of silence from dropouts" << std::endl;
+        }
+        undoManager.executeCommand(std::make_unique<CreateClipCommand>(
+            ClipType::Audio, take.trackId, take.startSeconds + trim, length - trim,
+            take.file.getFullPathName(), trim));
+        ++created;
+    }
+    undoManager.endCompoundOperation();
+    return created;
+}
+
+void AudioBridge::updateDirectMonitoring() {
+    if (isShuttingDown_.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    auto& trackManager = TrackManager::getInstance();
+    const auto& master = trackManager.getMasterChannel();
+    const auto& tracks = trackManager.getTracks();
+    const bool anySoloed =
+        std::any_of(tracks.begin(), tracks.end(), [](const TrackInfo& t) { return t.soloed; });
+
+    auto routes = std::make_unique<DirectMonitorRoutes>();
+    juce::StringArray directInputs;
+    for (const auto& track : tracks) {
+        if (!track.directMonitor || !track.recordArmed || track.type != TrackType::Audio ||
+            track.audioInputDevice.isEmpty()) {
+            continue;
+        }
+        directInputs.addIfNotAlreadyThere(track.audioInputDevice);
+        if (track.muted || master.muted || (anySoloed && !track.soloed) ||
+            routes->size() == kMaxDirectMonitors) {
+            continue;
+        }
+        const auto channels = getRecordingChannels(track.audioInputDevice);
+        if (channels.empty()) {
+            continue;
+        }
+
+        // Balance rather than a pan law: centred, the input is heard at the fader's level
+        DirectMonitorRoute route;
+        route.trackId = track.id;
+        route.left = channels.front();
+        route.right = channels.size() > 1 ? channels[1] : channels.front();
+        const float gain = track.volume * master.volume;
+        route.gainL = gain * std::min(1.0f, 1.0f - track.pan);
+        route.gainR = gain * std::min(1.0f, 1.0f + track.pan);
+        routes->push_back(route);
+    }
+    directMonitorRoutes_.publish(std::move(routes));
+    directMonitorDevice_ = audioDevice_.load(std::memory_order_acquire);
+
+    // The graph's monitoring of those inputs would be heard again, a compensation later
+    std::vector<te::InputDevice*> silenced;
+    if (auto* playbackContext = edit_.getCurrentPlaybackContext()) {
+        bool defaultTaken = false;  // "default" is the first wave input, as when recording
+        for (auto* inputDeviceInstance : playbackContext->getAllInputs()) {
+            auto* waveInput = dynamic_cast<te::WaveInputDevice*>(&inputDeviceInstance->owner);
+            if (waveInput == nullptr) {
+                continue;
+            }
+            const bool isDefault = !std::exchange(defaultTaken, true);
+            if (directInputs.contains(waveInput->getName()) ||
+                (isDefault && directInputs.contains("default"))) {
+                silenced.push_back(waveInput);
             }
-
-            // Clean up device processor
-            deviceProcessors_.erase(deviceId);
         }
     }
+    for (auto* device : directMonitorSilenced_) {
+        if (std::find(silenced.begin(), silenced.end(), device) == silenced.end()) {
+            device->setMonitorMode(te::InputDevice::MonitorMode::automatic);
+        }
+    }
+    for (auto* device : silenced) {
+        device->setMonitorMode(te::InputDevice::MonitorMode::off);
+    }
+    directMonitorSilenced_ = std::move(silenced);
+}
 
-    // Add new plugins for MAGDA devices that don't have TE counterparts
-    for (const auto& element : trackInfo->chainElements) {
-        if (std::holds_alternative<DeviceInfo>(element)) {
-            const auto& device = std::get<DeviceInfo>(element);
+namespace {
 
-            juce::ScopedLock lock(mappingLock_);
-            if (deviceToPlugin_.find(device.id) == deviceToPlugin_.end()) {
-                // Load this device as a plugin
-                auto plugin = loadDeviceAsPlugin(trackId, device);
-                if (plugin) {
-                    deviceToPlugin_[device.id] = plugin;
-                    pluginToDevice_[plugin.get()] = device.id;
-                }
-            }
+// Adds input * gain to output, the gain moving linearly across the block
+void addWithRamp(float* output, const float* input, int numSamples, float from, float to) {
+    if (from == to) {
+        if (to != 0.0f) {
+            juce::FloatVectorOperations::addWithMultiply(output, input, to, numSamples);
         }
+        return;
     }
+    const float step = (to - from) / static_cast<float>(numSamples);
+    float gain = from;
+    for (int i = 0; i < numSamples; ++i) {
+        output[i] += input[i] * gain;
+        gain += step;
+    }
+}
 
-    // Ensure VolumeAndPan is near the end of the chain (before LevelMeter)
-    // This is the track's fader control - it should come AFTER audio sources
-    ensureVolumePluginPosition(teTrack);
+}  // namespace
 
-    // Ensure LevelMeter is at the end of the plugin chain for metering
-    addLevelMeterToTrack(trackId);
+void AudioBridge::mixDirectMonitoring(const float* const* inputChannelData, int numInputChannels,
+                                      float* const* outputChannelData, int numOutputChannels,
+                                      int numSamples) noexcept {
+    if (numOutputChannels <= 0 || outputChannelData[0] == nullptr) {
+        return;
+    }
+    float* outL = outputChannelData[0];
+    float* outR = numOutputChannels > 1 && outputChannelData[1] != nullptr ? outputChannelData[1]
+                                                                           : nullptr;
+
+    auto mix = [&](const DirectMonitorRoute& route, float fromL, float fromR, float toL,
+                   float toR) {
+        if (route.left >= numInputChannels || route.right >= numInputChannels ||
+            inputChannelData[route.left] == nullptr || inputChannelData[route.right] == nullptr) {
+            return;
+        }
+        if (outR != nullptr) {
+            addWithRamp(outL, inputChannelData[route.left], numSamples, fromL, toL);
+            addWithRamp(outR, inputChannelData[route.right], numSamples, fromR, toR);
+        } else {
+            // A mono output hears both sides
+            addWithRamp(outL, inputChannelData[route.left], numSamples, fromL * 0.5f, toL * 0.5f);
+            addWithRamp(outL, inputChannelData[route.right], numSamples, fromR * 0.5f,
+                        toR * 0.5f);
+        }
+    };
+
+    const auto* routes = directMonitorRoutes_.acquire();
+    for (size_t slot = 0; slot < kMaxDirectMonitors; ++slot) {
+        const auto* route = routes != nullptr && slot < routes->size() ? &(*routes)[slot] : nullptr;
+        auto& applied = directMonitorApplied_[slot];
+
+        // A route that went away (or moved to another slot) fades out over this block
+        if (applied.trackId != INVALID_TRACK_ID &&
+            (route == nullptr || route->trackId != applied.trackId)) {
+            mix(applied, applied.gainL, applied.gainR, 0.0f, 0.0f);
+            applied = {};
+        }
+        if (route != nullptr) {
+            mix(*route, applied.gainL, applied.gainR, route->gainL, route->gainR);
+            applied = *route;
+        }
+    }
+    directMonitorRoutes_.release();
 }
 
-void AudioBridge::ensureTrackMapping(TrackId trackId) {
-    if (!getAudioTrack(trackId)) {
-        auto* trackInfo = TrackManager::getInstance().getTrack(trackId);
-        if (trackInfo) {
-            createAudioTrack(trackId, trackInfo->name);
+std::vector<int> AudioBridge::getRecordingChannels(const juce::String& deviceId) const {
+    auto* playbackContext = edit_.getCurrentPlaybackContext();
+    auto* device = audioDevice_.load(std::memory_order_acquire);
+    if (playbackContext == nullptr || device == nullptr) {
+        return {};
+    }
+
+    // The callback is handed only the active input channels, packed together
+    const auto active = device->getActiveInputChannels();
+    auto packedIndex = [&active](int deviceChannel) {
+        int index = 0;
+        for (int channel = 0; channel < deviceChannel; ++channel) {
+            index += active[channel] ? 1 : 0;
+        }
+        return index;
+    };
+
+    for (auto* inputDeviceInstance : playbackContext->getAllInputs()) {
+        auto* waveInput = dynamic_cast<te::WaveInputDevice*>(&inputDeviceInstance->owner);
+        if (waveInput == nullptr ||
+            (deviceId != "default" && waveInput->getName() != deviceId)) {
+            continue;
+        }
+        std::vector<int> channels;
+        for (const auto& channel : waveInput->getChannels()) {
+            if (active[channel.indexInDevice]) {
+                channels.push_back(packedIndex(channel.indexInDevice));
+            }
         }
+        return channels;
     }
+    return {};
 }
 
 // =============================================================================
-// Audio Callback Support
+// Session Clip Launching
 // =============================================================================
 
-void AudioBridge::processParameterChanges() {
-    MAGDA_MONITOR_SCOPE("ParamChanges");
+bool AudioBridge::scheduleClipLaunches(const std::vector<ClipLaunchRequest>& requests) {
+    if (!audioCallbackRunning_.load(std::memory_order_acquire)) {
+        return false;
+    }
+    return sessionLauncher_.push(requests);
+}
+
+bool AudioBridge::startCountIn(int beats) {
+    if (beats <= 0 || !audioCallbackRunning_.load(std::memory_order_acquire)) {
+        return false;
+    }
+    clickGenerator_.startCountIn(beats);
+    return true;
+}
 
-    ParameterChange change;
-    while (parameterQueue_.pop(change)) {
-        auto plugin = getPlugin(change.deviceId);
-        if (plugin) {
-            // NOLINTNEXTLINE(clang-analyzer-core.uninitialized.Assign) - false positive from
-            // profiling macros
+int AudioBridge::processBeatClock(int numSamples, double sampleRate, bool playing, double bpm,
+                                  float* const* outputChannelData, int numOutputChannels) {
+    auto click = [&](const SessionLaunchScheduler::Block& block) {
+        ClickGenerator::Block clickBlock;
+        clickBlock.startBeat = block.startBeat;
+        clickBlock.beatsPerSample = block.beatsPerSample;
+        clickBlock.numSamples = block.numSamples;
+        clickBlock.firstSample = block.firstSample;
+        clickBlock.playing = block.playing;
+        const int countInEnd =
+            clickGenerator_.process(clickBlock, bpm, outputChannelData, numOutputChannels);
+        if (countInEnd >= 0) {
+            eventQueue_.push({AudioEvent::Type::CountInFinished, INVALID_TRACK_ID, countInEnd});
+        }
+    };
+
+    auto fire = [this](const SessionLaunchScheduler::Fired& fired) {
+        const auto type = fired.request.action == ClipLaunchRequest::Action::Launch
+                              ? AudioEvent::Type::ClipLaunched
+                              : AudioEvent::Type::ClipStopped;
+        eventQueue_.push(
+            {type, fired.request.trackId, fired.request.clipId, fired.sampleOffset});
+    };
+
+    if (!playing || sampleRate <= 0.0) {
+        SessionLaunchScheduler::Block block;
+        block.numSamples = numSamples;
+        sessionLauncher_.process(block, fire);
+        click(block);
+        audioWrapAtBlockStart_ = false;
+        return -1;
+    }
+
+    // The block runs from audioPositionSeconds_, split where it wraps at the loop end
+    const double beatsPerSecond = bpm / 60.0;
+    const bool looping = loopEnabled_.load(std::memory_order_relaxed);
+    const double loopStart = loopStartSeconds_.load(std::memory_order_relaxed);
+    const double loopEnd = loopEndSeconds_.load(std::memory_order_relaxed);
+    const bool wraps = looping && loopEnd > loopStart && audioPositionSeconds_ < loopEnd;
+
+    // A wrap on the last block's final sample plays from the loop start in this one
+    int loopSample = audioWrapAtBlockStart_ ? 0 : -1;
+    audioWrapAtBlockStart_ = false;
+
+    int done = 0;
+    while (done < numSamples) {
+        int length = numSamples - done;
+        if (wraps) {
+            const auto toLoopEnd =
+                static_cast<int>(std::ceil((loopEnd - audioPositionSeconds_) * sampleRate));
+            length = juce::jlimit(1, length, toLoopEnd);
+        }
 
-            auto params = plugin->getAutomatableParameters();
-            if (change.paramIndex >= 0 && change.paramIndex < static_cast<int>(params.size())) {
-                params[static_cast<size_t>(change.paramIndex)]->setParameter(
-                    change.value, juce::sendNotificationSync);
+        SessionLaunchScheduler::Block block;
+        block.startBeat = audioPositionSeconds_ * beatsPerSecond;
+        block.beatsPerSample = beatsPerSecond / sampleRate;
+        block.numSamples = length;
+        block.firstSample = done;
+        block.playing = true;
+        sessionLauncher_.process(block, fire);
+        click(block);
+
+        audioPositionSeconds_ += length / sampleRate;
+        done += length;
+        if (wraps && audioPositionSeconds_ >= loopEnd) {
+            audioPositionSeconds_ = loopStart + (audioPositionSeconds_ - loopEnd);
+            if (done == numSamples) {
+                audioWrapAtBlockStart_ = true;
+            } else if (loopSample < 0) {
+                loopSample = done;
             }
         }
     }
+    return loopSample;
 }
 
-// =============================================================================
-// Transport State
-// =============================================================================
+void AudioBridge::publishPlayheadClock(double blockStartSeconds,
+                                       const AudioModulator::Transport& transport, bool playing,
+                                       int loopWrapSample, int numSamples, double sampleRate) {
+    // This block is heard after the one the device is playing now, plus its output latency
+    double heardInMs = 0.0;
+    if (sampleRate > 0.0) {
+        heardInMs = (numSamples + outputLatencySamples_.load(std::memory_order_relaxed)) * 1000.0 /
+                    sampleRate;
+    }
 
-void AudioBridge::updateTransportState(bool isPlaying, bool justStarted, bool justLooped) {
-    // UI thread writes, audio thread reads - use release/acquire semantics
-    transportPlaying_.store(isPlaying, std::memory_order_release);
-    justStartedFlag_.store(justStarted, std::memory_order_release);
-    justLoopedFlag_.store(justLooped, std::memory_order_release);
+    PlayheadClock::Sample sample;
+    sample.positionSeconds = blockStartSeconds;
+    sample.hostTimeMs = juce::Time::getMillisecondCounterHiRes() + heardInMs;
+    if (loopEnabled_.load(std::memory_order_relaxed)) {
+        sample.loopStartSeconds = loopStartSeconds_.load(std::memory_order_relaxed);
+        sample.loopEndSeconds = loopEndSeconds_.load(std::memory_order_relaxed);
+    }
+    sample.bpm = transport.bpm;
+    sample.loopWrapSample = loopWrapSample;
+    sample.playing = playing;
+    sample.justStarted = transport.justStarted;
+    playheadClock_.publish(sample);
+}
 
-    // Enable/disable tone generators based on transport state
-    juce::ScopedLock lock(mappingLock_);
+void AudioBridge::collectCallbackTimings(PerformanceMonitor& monitor) {
+    // Always drain so the ring doesn't fill while profiling is off
+    AudioCallbackTiming timing;
+    while (callbackTimings_.pop(timing)) {
+        if (!monitor.isEnabled()) {
+            continue;
+        }
 
-    for (const auto& [deviceId, processor] : deviceProcessors_) {
-        if (auto* toneProc = dynamic_cast<ToneGeneratorProcessor*>(processor.get())) {
-            // Test Tone is always transport-synced
-            // Simply bypass when stopped, enable when playing
-            toneProc->setBypassed(!isPlaying);
-            DBG("AudioBridge::updateTransportState - Tone generator device "
-                << deviceId << " bypassed=" << (!isPlaying ? "YES" : "NO")
-                << " (isPlaying=" << (isPlaying ? "YES" : "NO") << ")");
+        monitor.addSample("AudioCallback", timing.totalMs);
+        if (timing.overran()) {
+            const auto stage = timing.slowestStage();
+            ++callbackOverruns_;
+            ++stageOverruns_[stage];
+            DBG("AudioBridge: callback overrun (" << AudioCallbackTiming::getStageName(stage)
+                                                  << ", " << timing.totalMs << " ms, interval "
+                                                  << timing.intervalMs << " ms, budget "
+                                                  << timing.budgetMs << " ms)");
         }
     }
-}
 
-// =============================================================================
-// MIDI Activity Monitoring
-// =============================================================================
+    if (!monitor.isEnabled()) {
+        return;
+    }
 
-void AudioBridge::triggerMidiActivity(TrackId trackId) {
-    if (trackId >= 0 && trackId < kMaxTracks) {
-        midiActivityFlags_[trackId].store(true, std::memory_order_release);
+    monitor.setCounter("AudioCallbackOverruns", callbackOverruns_);
+    for (size_t i = 0; i < stageOverruns_.size(); ++i) {
+        const auto stage = static_cast<AudioCallbackTiming::Stage>(i);
+        const juce::String name = juce::String("AudioOverruns.") +
+                                  AudioCallbackTiming::getStageName(stage);
+        monitor.setCounter(name, stageOverruns_[i]);
     }
+    monitor.setCounter("AudioCallbackTimingsDropped",
+                       static_cast<juce::int64>(callbackTimings_.getDroppedCount()));
+
+    // The device manager measures the whole device cycle, engine render included
+    monitor.addSample("AudioCPU", engine_.getDeviceManager().deviceManager.getCpuUsage() * 100.0);
 }
 
-bool AudioBridge::consumeMidiActivity(TrackId trackId) {
-    if (trackId >= 0 && trackId < kMaxTracks) {
-        // Read and clear flag atomically
-        return midiActivityFlags_[trackId].exchange(false, std::memory_order_acq_rel);
+std::vector<DropoutLog::Hotspot> AudioBridge::getDropoutHotspots() const {
+    std::vector<DropoutLog::Hotspot> hotspots;
+    if (!deviceCpuMeasurement_) {
+        return hotspots;
     }
-    return false;
+
+    auto& trackManager = TrackManager::getInstance();
+    for (const auto& [deviceId, reading] :
+         deviceCpuMeter_.getSlowestBlocks(DropoutLog::kMaxHotspots)) {
+        DropoutLog::Hotspot hotspot;
+        hotspot.blockMs = reading.blockPeakMs;
+        const auto* device = trackManager.findDevice(deviceId);
+        hotspot.device = device != nullptr ? device->name : "Device " + juce::String(deviceId);
+        const auto trackId = trackManager.findDevicePath(deviceId).trackId;
+        if (const auto* track = trackManager.getTrack(trackId)) {
+            hotspot.track = track->name;
+        }
+        hotspots.push_back(std::move(hotspot));
+    }
+    return hotspots;
 }
 
-void AudioBridge::updateMetering() {
-    // This would be called from the audio thread
-    // For now, we use the timer callback for metering
+void AudioBridge::detachTrackMeters(te::AudioTrack* track) {
+    if (!track)
+        return;
+
+    for (auto* plugin : track->pluginList) {
+        if (auto* meter = dynamic_cast<TrackMeterPlugin*>(plugin)) {
+            meter->setMeteringTarget(nullptr, INVALID_TRACK_ID);
+        }
+    }
 }
 
 void AudioBridge::onMidiDevicesAvailable() {
@@ -1075,46 +3232,69 @@ void AudioBridge::timerCallback() {
         return;
     }
 
+    MAGDA_MONITOR_SCOPE("AudioBridgeTimer");
+
     // Apply any pending MIDI routes now that playback context may be available
     applyPendingMidiRoutes();
 
-    // NOTE: Window state sync is now handled by PluginWindowManager's timer
-
-    // Update metering from level measurers (runs at 30 FPS on message thread)
-    juce::ScopedLock lock(mappingLock_);
-
-    // Update track metering
-    for (const auto& [trackId, track] : trackMapping_) {
-        if (!track)
-            continue;
-
-        // Get the meter client for this track
-        auto clientIt = meterClients_.find(trackId);
-        if (clientIt == meterClients_.end())
-            continue;
+    // The loop for the audio thread's launch clock
+    {
+        auto& transport = edit_.getTransport();
+        const auto loop = transport.getLoopRange();
+        loopStartSeconds_.store(loop.getStart().inSeconds(), std::memory_order_relaxed);
+        loopEndSeconds_.store(loop.getEnd().inSeconds(), std::memory_order_relaxed);
+        loopEnabled_.store(transport.looping.get(), std::memory_order_relaxed);
+    }
 
-        auto& client = clientIt->second;
+    // Deliver audio/MIDI thread events before taking the lock (handlers may call back in)
+    eventDispatcher_.drain(eventQueue_);
+    dispatchDeviceStatus();
 
-        MeterData data;
+    updateReadAhead();
 
-        // Read and clear audio levels from the client (returns DbTimePair)
-        auto levelL = client.getAndClearAudioLevel(0);
-        auto levelR = client.getAndClearAudioLevel(1);
+    // NOTE: Window state sync is now handled by PluginWindowManager's timer
 
-        // Convert from dB to linear gain (allow > 1.0 for headroom)
-        data.peakL = juce::Decibels::decibelsToGain(levelL.dB);
-        data.peakR = juce::Decibels::decibelsToGain(levelR.dB);
+    juce::ScopedLock lock(mappingLock_);
 
-        // Check for clipping
-        data.clipped = data.peakL > 1.0f || data.peakR > 1.0f;
+    // Drop parameter tables the audio thread has moved past
+    if (parameterTable_.hasRetired()) {
+        parameterTable_.collectGarbage();
+    }
+    if (directMonitorRoutes_.hasRetired()) {
+        directMonitorRoutes_.collectGarbage();
+    }
 
-        // RMS would require accumulation over time - simplified for now
-        data.rmsL = data.peakL * 0.7f;  // Rough approximation
-        data.rmsR = data.peakR * 0.7f;
+    // Direct monitoring's channels are packed indices on a particular device
+    if (audioDevice_.load(std::memory_order_acquire) != directMonitorDevice_) {
+        updateDirectMonitoring();
+    }
+    modulator_.collectGarbage();
 
-        meteringBuffer_.pushLevels(trackId, data);
+    // Pick up automation edits, then suspend the lanes the recorder is writing
+    if (automationDirty_) {
+        rebuildAutomation();
+    }
+    automationPlayer_.updateSuspended([](AutomationLaneId laneId) {
+        return AutomationRecorder::getInstance().isWriting(laneId);
+    });
+    automationPlayer_.collectGarbage();
+
+    // Report parameter queue pressure
+    auto& monitor = PerformanceMonitor::getInstance();
+    if (monitor.isEnabled()) {
+        monitor.setCounter("ParamQueueCoalesced",
+                           static_cast<juce::int64>(parameterQueue_.getCoalescedCount()));
+        monitor.setCounter("ParamQueueDropped",
+                           static_cast<juce::int64>(parameterQueue_.getDroppedCount()));
+        monitor.setCounter("AudioEventsDropped",
+                           static_cast<juce::int64>(eventQueue_.getDroppedCount()));
+        const auto readAhead = readAhead_.getStats();
+        monitor.setCounter("ReadAheadBlocks", readAhead.blocksFetched);
+        monitor.setCounter("ReadAheadQueued", readAhead.queuedBlocks);
     }
+    collectCallbackTimings(monitor);
 
+    // Track meters push from the audio thread (TrackMeterPlugin); only the master is polled.
     // Register master meter client with playback context if not done yet
     if (!masterMeterRegistered_) {
         if (auto* ctx = edit_.getCurrentPlaybackContext()) {
@@ -1135,6 +3315,36 @@ void AudioBridge::timerCallback() {
         masterPeakL_.store(peakL, std::memory_order_relaxed);
         masterPeakR_.store(peakR, std::memory_order_relaxed);
     }
+
+    // Wake meter views while anything is audible; they go idle again once their meters settle
+    const bool masterAudible = masterPeakL_.load(std::memory_order_relaxed) >
+                                   MeteringBuffer::kSilenceLevel ||
+                               masterPeakR_.load(std::memory_order_relaxed) >
+                                   MeteringBuffer::kSilenceLevel;
+    if (meteringBuffer_.consumeAudible() || masterAudible) {
+        eventDispatcher_.dispatch({AudioEvent::Type::MeterActivity});
+    }
+
+    // Notes auditioned from other threads since the last tick
+    notePreviewers_.forEach([this](TrackId trackId, const te::Plugin::Ptr& plugin) {
+        auto* previewer = dynamic_cast<NotePreviewPlugin*>(plugin.get());
+        if (previewer != nullptr && previewer->takeActivity()) {
+            wakeChain(trackId);
+        }
+    });
+
+    updateChainSuspension();
+
+    if (deviceCpuMeasurement_) {
+        deviceCpuMeter_.update();
+        // Readings move every update; slots only need them at a readable rate
+        if (++cpuStatusTicks_ >= kCpuStatusTicks) {
+            cpuStatusTicks_ = 0;
+            allDeviceStatusChanged_ = true;
+        }
+    }
+    // After the update, so the device peaks cover the blocks the dropouts happened in
+    dropoutLog_.collect([this]() { return getDropoutHotspots(); });
 }
 
 // =============================================================================
@@ -1171,14 +3381,30 @@ te::Plugin::Ptr AudioBridge::createLevelMeter(te::AudioTrack* track) {
     if (!track)
         return nullptr;
 
-    // LevelMeterPlugin has create() that returns ValueTree
-    auto plugin = edit_.getPluginCache().createNewPlugin(te::LevelMeterPlugin::create());
+    // A LevelMeterPlugin that also publishes levels to meteringBuffer_
+    auto plugin = edit_.getPluginCache().createNewPlugin(TrackMeterPlugin::create());
     if (plugin) {
         track->pluginList.insertPlugin(plugin, -1, nullptr);
     }
     return plugin;
 }
 
+void AudioBridge::attachMasterTap() {
+    // The master's levels come from the playback context; this meter publishes none
+    auto& masterPlugins = edit_.getMasterPluginList();
+    for (int i = masterPlugins.size() - 1; i >= 0; --i) {
+        if (dynamic_cast<TrackMeterPlugin*>(masterPlugins[i])) {
+            masterPlugins[i]->deleteFromParent();
+        }
+    }
+
+    masterTap_ = edit_.getPluginCache().createNewPlugin(TrackMeterPlugin::create());
+    if (auto* meter = dynamic_cast<TrackMeterPlugin*>(masterTap_.get())) {
+        masterPlugins.insertPlugin(masterTap_, -1, nullptr);
+        meter->setMeteringTarget(nullptr, AudioTaps::kMasterPoint, nullptr, &audioTaps_);
+    }
+}
+
 te::Plugin::Ptr AudioBridge::createFourOscSynth(te::AudioTrack* track) {
     if (!track)
         return nullptr;
@@ -1197,6 +3423,111 @@ te::Plugin::Ptr AudioBridge::createFourOscSynth(te::AudioTrack* track) {
     return plugin;
 }
 
+int AudioBridge::preloadPlugins(const std::vector<TrackInfo>& tracks) {
+    std::vector<const DeviceInfo*> devices;
+    for (const auto& track : tracks) {
+        collectPoolableDevices(track.chainElements, devices);
+    }
+
+    juce::Array<juce::PluginDescription> descriptions;
+    for (const auto* device : devices) {
+        descriptions.add(findPluginDescription(*device));
+    }
+
+    pluginPool_.reserve(descriptions);
+    return descriptions.size();
+}
+
+juce::PluginDescription AudioBridge::findPluginDescription(const DeviceInfo& device) const {
+    // Build PluginDescription from DeviceInfo
+    juce::PluginDescription desc;
+    desc.name = device.name;
+    desc.manufacturerName = device.manufacturer;
+    desc.fileOrIdentifier = device.fileOrIdentifier;
+    desc.isInstrument = device.isInstrument;
+
+    // Set format
+    switch (device.format) {
+        case PluginFormat::VST3:
+            desc.pluginFormatName = "VST3";
+            break;
+        case PluginFormat::AU:
+            desc.pluginFormatName = "AudioUnit";
+            break;
+        case PluginFormat::VST:
+            desc.pluginFormatName = "VST";
+            break;
+        default:
+            break;
+    }
+
+    // Try to find a matching plugin in KnownPluginList
+    DBG("Plugin lookup: searching for name='"
+        << device.name << "' manufacturer='" << device.manufacturer
+        << "' isInstrument=" << (device.isInstrument ? "true" : "false") << " fileOrId='"
+        << device.fileOrIdentifier << "'");
+
+    auto& knownPlugins = engine_.getPluginManager().knownPluginList;
+
+    // Debug: dump all plugins that match the name (case insensitive)
+    DBG("  All matching plugins in KnownPluginList:");
+    for (const auto& kd : knownPlugins.getTypes()) {
+        if (kd.name.containsIgnoreCase(device.name) ||
+            device.name.containsIgnoreCase(kd.name.toStdString())) {
+            DBG("    - name='"
+                << kd.name << "' isInstrument=" << (kd.isInstrument ? "true" : "false")
+                << " fileOrId='" << kd.fileOrIdentifier << "'"
+                << " uniqueId='" << kd.uniqueId << "'"
+                << " identifierString='" << kd.createIdentifierString() << "'");
+        }
+    }
+    bool found = false;
+    for (const auto& knownDesc : knownPlugins.getTypes()) {
+        // Match by fileOrIdentifier (most specific) BUT also check isInstrument
+        // to avoid loading FX when instrument is requested
+        if (knownDesc.fileOrIdentifier == device.fileOrIdentifier &&
+            knownDesc.isInstrument == device.isInstrument) {
+            DBG("  -> MATCHED by fileOrIdentifier + isInstrument: " << knownDesc.name);
+            desc = knownDesc;
+            found = true;
+            break;
+        }
+    }
+
+    // Second pass: match by name, manufacturer, AND isInstrument flag
+    if (!found) {
+        for (const auto& knownDesc : knownPlugins.getTypes()) {
+            if (knownDesc.name == device.name &&
+                knownDesc.manufacturerName == device.manufacturer &&
+                knownDesc.isInstrument == device.isInstrument) {
+                DBG("  -> MATCHED by name+manufacturer+isInstrument: " << knownDesc.name);
+                desc = knownDesc;
+                found = true;
+                break;
+            }
+        }
+    }
+
+    // Third pass: match by fileOrIdentifier only (fallback)
+    if (!found) {
+        for (const auto& knownDesc : knownPlugins.getTypes()) {
+            if (knownDesc.fileOrIdentifier == device.fileOrIdentifier) {
+                DBG("  -> MATCHED by fileOrIdentifier only (fallback): "
+                    << knownDesc.name
+                    << " isInstrument=" << (knownDesc.isInstrument ? "true" : "false"));
+                desc = knownDesc;
+                found = true;
+                break;
+            }
+        }
+    }
+
+    if (!found) {
+        DBG("  -> NO MATCH FOUND in KnownPluginList!");
+    }
+    return desc;
+}
+
 te::Plugin::Ptr AudioBridge::loadDeviceAsPlugin(TrackId trackId, const DeviceInfo& device) {
     auto* track = getAudioTrack(trackId);
     if (!track)
@@ -1248,95 +3579,14 @@ te::Plugin::Ptr AudioBridge::loadDeviceAsPlugin(TrackId trackId, const DeviceInf
     } else {
         // External plugin - find matching description from KnownPluginList
         if (device.uniqueId.isNotEmpty() || device.fileOrIdentifier.isNotEmpty()) {
-            // Build PluginDescription from DeviceInfo
-            juce::PluginDescription desc;
-            desc.name = device.name;
-            desc.manufacturerName = device.manufacturer;
-            desc.fileOrIdentifier = device.fileOrIdentifier;
-            desc.isInstrument = device.isInstrument;
-
-            // Set format
-            switch (device.format) {
-                case PluginFormat::VST3:
-                    desc.pluginFormatName = "VST3";
-                    break;
-                case PluginFormat::AU:
-                    desc.pluginFormatName = "AudioUnit";
-                    break;
-                case PluginFormat::VST:
-                    desc.pluginFormatName = "VST";
-                    break;
-                default:
-                    break;
-            }
-
-            // Try to find a matching plugin in KnownPluginList
-            DBG("Plugin lookup: searching for name='"
-                << device.name << "' manufacturer='" << device.manufacturer
-                << "' isInstrument=" << (device.isInstrument ? "true" : "false") << " fileOrId='"
-                << device.fileOrIdentifier << "'");
-
-            auto& knownPlugins = engine_.getPluginManager().knownPluginList;
-
-            // Debug: dump all plugins that match the name (case insensitive)
-            DBG("  All matching plugins in KnownPluginList:");
-            for (const auto& kd : knownPlugins.getTypes()) {
-                if (kd.name.containsIgnoreCase(device.name) ||
-                    device.name.containsIgnoreCase(kd.name.toStdString())) {
-                    DBG("    - name='"
-                        << kd.name << "' isInstrument=" << (kd.isInstrument ? "true" : "false")
-                        << " fileOrId='" << kd.fileOrIdentifier << "'"
-                        << " uniqueId='" << kd.uniqueId << "'"
-                        << " identifierString='" << kd.createIdentifierString() << "'");
-                }
-            }
-            bool found = false;
-            for (const auto& knownDesc : knownPlugins.getTypes()) {
-                // Match by fileOrIdentifier (most specific) BUT also check isInstrument
-                // to avoid loading FX when instrument is requested
-                if (knownDesc.fileOrIdentifier == device.fileOrIdentifier &&
-                    knownDesc.isInstrument == device.isInstrument) {
-                    DBG("  -> MATCHED by fileOrIdentifier + isInstrument: " << knownDesc.name);
-                    desc = knownDesc;
-                    found = true;
-                    break;
-                }
-            }
-
-            // Second pass: match by name, manufacturer, AND isInstrument flag
-            if (!found) {
-                for (const auto& knownDesc : knownPlugins.getTypes()) {
-                    if (knownDesc.name == device.name &&
-                        knownDesc.manufacturerName == device.manufacturer &&
-                        knownDesc.isInstrument == device.isInstrument) {
-                        DBG("  -> MATCHED by name+manufacturer+isInstrument: " << knownDesc.name);
-                        desc = knownDesc;
-                        found = true;
-                        break;
-                    }
-                }
-            }
-
-            // Third pass: match by fileOrIdentifier only (fallback)
-            if (!found) {
-                for (const auto& knownDesc : knownPlugins.getTypes()) {
-                    if (knownDesc.fileOrIdentifier == device.fileOrIdentifier) {
-                        DBG("  -> MATCHED by fileOrIdentifier only (fallback): "
-                            << knownDesc.name
-                            << " isInstrument=" << (knownDesc.isInstrument ? "true" : "false"));
-                        desc = knownDesc;
-                        found = true;
-                        break;
-                    }
-                }
-            }
-
-            if (!found) {
-                DBG("  -> NO MATCH FOUND in KnownPluginList!");
-            }
+            const auto desc = findPluginDescription(device);
 
-            auto result = loadExternalPlugin(trackId, desc);
-            if (result.success && result.plugin) {
+            auto result = device.sandboxed ? loadSandboxedPlugin(trackId, desc)
+                                           : loadExternalPlugin(trackId, desc);
+            if (result.success && result.plugin && device.sandboxed) {
+                // Its parameters stay in the host process, so there is no processor
+                plugin = result.plugin;
+            } else if (result.success && result.plugin) {
                 plugin = result.plugin;
                 auto extProcessor = std::make_unique<ExternalPluginProcessor>(device.id, plugin);
                 // Start listening for parameter changes from the plugin's native UI
@@ -1358,6 +3608,20 @@ te::Plugin::Ptr AudioBridge::loadDeviceAsPlugin(TrackId trackId, const DeviceInf
     }
 
     if (plugin) {
+        // A project that was just opened hands over the state saved for this device
+        auto savedState = ProjectManager::getInstance().takePluginState(device.id);
+
+        // ... as does the original of a duplicated device
+        auto cloned = clonedPluginStates_.find(device.id);
+        if (cloned != clonedPluginStates_.end()) {
+            savedState = cloned->second;
+            clonedPluginStates_.erase(cloned);
+        }
+
+        if (savedState.isValid()) {
+            plugin->restorePluginStateFromValueTree(savedState);
+        }
+
         // Store the processor if we created one
         if (processor) {
             // Initialize defaults first if DeviceInfo has no parameters
@@ -1376,18 +3640,23 @@ te::Plugin::Ptr AudioBridge::loadDeviceAsPlugin(TrackId trackId, const DeviceInf
             processor->populateParameters(tempInfo);
             TrackManager::getInstance().updateDeviceParameters(device.id, tempInfo.parameters);
 
-            deviceProcessors_[device.id] = std::move(processor);
+            // Tone generators are always transport-synced; the rest never are
+            removeTransportSyncedDevice(device.id);
+            if (dynamic_cast<ToneGeneratorProcessor*>(processor.get()) != nullptr) {
+                transportSyncedDevices_.push_back(device.id);
+            }
+
+            deviceProcessors_.assign(device.id, std::move(processor));
         }
 
         // Apply device state
         plugin->setEnabled(!device.bypassed);
 
-        // For tone generators (always transport-synced), sync initial state with transport
-        if (auto* toneProc = dynamic_cast<ToneGeneratorProcessor*>(processor.get())) {
-            // Get current transport state
-            bool isPlaying = transportPlaying_.load(std::memory_order_acquire);
-            // Bypass if transport is not playing
-            toneProc->setBypassed(!isPlaying);
+        // A transport-synced device is bypassed until the transport plays
+        if (!transportSyncedDevices_.empty() && transportSyncedDevices_.back() == device.id) {
+            if (auto* synced = deviceProcessors_.find(device.id)) {
+                (*synced)->setBypassed(!transportSyncedPlaying_);
+            }
         }
 
         // If this is an instrument, automatically route all MIDI inputs to this track
@@ -1458,13 +3727,24 @@ float AudioBridge::getTrackPan(TrackId trackId) const {
 }
 
 void AudioBridge::setMasterVolume(float volume) {
+    masterVolume_ = volume;
     if (auto masterPlugin = edit_.getMasterVolumePlugin()) {
-        float db = volume > 0.0f ? juce::Decibels::gainToDecibels(volume) : -100.0f;
+        const float gain = volume * masterFade_;
+        float db = gain > 0.0f ? juce::Decibels::gainToDecibels(gain) : -100.0f;
         masterPlugin->setVolumeDb(db);
     }
 }
 
+void AudioBridge::setMasterFade(float gain) {
+    masterFade_ = juce::jlimit(0.0f, 1.0f, gain);
+    setMasterVolume(masterVolume_);
+}
+
 float AudioBridge::getMasterVolume() const {
+    // Mid-fade the plugin is quieter than the project's volume
+    if (masterFade_ < 1.0f) {
+        return masterVolume_;
+    }
     if (auto masterPlugin = edit_.getMasterVolumePlugin()) {
         return juce::Decibels::decibelsToGain(masterPlugin->getVolumeDb());
     }
@@ -1566,6 +3846,159 @@ void AudioBridge::setTrackAudioInput(TrackId trackId, const juce::String& device
     }
 }
 
+int AudioBridge::getAuxBus(TrackId auxTrackId) const {
+    auto it = auxBuses_.find(auxTrackId);
+    return it != auxBuses_.end() ? it->second : -1;
+}
+
+void AudioBridge::syncAuxBuses() {
+    auto& tm = TrackManager::getInstance();
+
+    // Buses stay with their aux track, so existing sends aren't rebuilt
+    for (auto it = auxBuses_.begin(); it != auxBuses_.end();) {
+        const auto* track = tm.getTrack(it->first);
+        if (track == nullptr || track->type != TrackType::Aux) {
+            it = auxBuses_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    std::array<bool, kMaxAuxBuses> used{};
+    for (const auto& [trackId, bus] : auxBuses_) {
+        used[static_cast<size_t>(bus)] = true;
+    }
+    for (const auto& track : tm.getTracks()) {
+        if (track.type != TrackType::Aux || auxBuses_.count(track.id) != 0) {
+            continue;
+        }
+        auto freeBus = std::find(used.begin(), used.end(), false);
+        if (freeBus == used.end()) {
+            DBG("AudioBridge::syncAuxBuses - no free aux bus for track " << track.id);
+            continue;
+        }
+        *freeBus = true;
+        auxBuses_[track.id] = static_cast<int>(freeBus - used.begin());
+    }
+
+    for (const auto& [trackId, bus] : auxBuses_) {
+        if (const auto* track = tm.getTrack(trackId)) {
+            edit_.setAuxBusName(bus, track->name);
+        }
+    }
+    for (const auto& track : tm.getTracks()) {
+        syncTrackSends(track.id);
+    }
+}
+
+void AudioBridge::syncTrackSends(TrackId trackId) {
+    auto* track = getAudioTrack(trackId);
+    const auto* trackInfo = TrackManager::getInstance().getTrack(trackId);
+    if (!track || !trackInfo) {
+        return;
+    }
+
+    auto& plugins = track->pluginList;
+
+    // An aux track plays its bus from the top of its chain, behind the note previewer
+    const int bus = getAuxBus(trackId);
+    te::Plugin::Ptr auxReturn;
+    for (int i = plugins.size(); --i >= 0;) {
+        if (auto* existing = dynamic_cast<te::AuxReturnPlugin*>(plugins[i])) {
+            if (bus < 0 || auxReturn) {
+                existing->deleteFromParent();
+            } else {
+                auxReturn = existing;
+            }
+        }
+    }
+    if (bus >= 0) {
+        if (!auxReturn) {
+            auxReturn =
+                edit_.getPluginCache().createNewPlugin(te::AuxReturnPlugin::xmlTypeName, {});
+        }
+        if (auto* returnPlugin = dynamic_cast<te::AuxReturnPlugin*>(auxReturn.get())) {
+            returnPlugin->busNumber = bus;
+            const int wanted =
+                plugins.size() > 0 && dynamic_cast<NotePreviewPlugin*>(plugins[0]) ? 1 : 0;
+            if (plugins.indexOf(returnPlugin) != wanted) {
+                returnPlugin->removeFromParent();
+                plugins.insertPlugin(auxReturn, wanted, nullptr);
+            }
+        }
+    }
+
+    // Sends in the order they sit around the fader: pre-fader ones just before it, then
+    // post-fader ones just after it (ahead of the meter)
+    struct WantedSend {
+        int bus = 0;
+        float gainDb = 0.0f;
+        bool preFader = false;
+    };
+    std::vector<WantedSend> wanted;
+    for (bool pre : {true, false}) {
+        for (const auto& send : trackInfo->sends) {
+            const int sendBus = getAuxBus(send.destinationId);
+            if (send.preFader == pre && sendBus >= 0 && send.destinationId != trackId) {
+                wanted.push_back(
+                    {sendBus, juce::Decibels::gainToDecibels(send.level, -100.0f), pre});
+            }
+        }
+    }
+
+    int faderIndex = -1;
+    std::vector<te::AuxSendPlugin*> existing;
+    for (int i = 0; i < plugins.size(); ++i) {
+        if (auto* send = dynamic_cast<te::AuxSendPlugin*>(plugins[i])) {
+            existing.push_back(send);
+        } else if (dynamic_cast<te::VolumeAndPanPlugin*>(plugins[i])) {
+            faderIndex = i;
+        }
+    }
+    if (faderIndex < 0) {
+        return;  // Not set up yet; the plugin sync calls back here once it is
+    }
+
+    // Level changes are the common case: retune the sends in place, without touching the
+    // plugin list (which would rebuild the playback graph)
+    bool sameLayout = existing.size() == wanted.size();
+    for (size_t i = 0; sameLayout && i < existing.size(); ++i) {
+        const bool pre = plugins.indexOf(existing[i]) < faderIndex;
+        sameLayout = existing[i]->busNumber.get() == wanted[i].bus && pre == wanted[i].preFader;
+    }
+    if (sameLayout) {
+        for (size_t i = 0; i < existing.size(); ++i) {
+            if (std::abs(existing[i]->getGainDb() - wanted[i].gainDb) > 0.001f) {
+                existing[i]->setGainDb(wanted[i].gainDb);
+            }
+        }
+        return;
+    }
+
+    for (auto* send : existing) {
+        send->deleteFromParent();
+    }
+    int postFaderCount = 0;
+    for (const auto& send : wanted) {
+        auto plugin = edit_.getPluginCache().createNewPlugin(te::AuxSendPlugin::xmlTypeName, {});
+        auto* auxSend = dynamic_cast<te::AuxSendPlugin*>(plugin.get());
+        if (!auxSend) {
+            continue;
+        }
+        auxSend->busNumber = send.bus;
+        auxSend->setGainDb(send.gainDb);
+
+        int fader = -1;
+        for (int i = 0; i < plugins.size() && fader < 0; ++i) {
+            if (dynamic_cast<te::VolumeAndPanPlugin*>(plugins[i])) {
+                fader = i;
+            }
+        }
+        plugins.insertPlugin(plugin, send.preFader ? fader : fader + 1 + postFaderCount++,
+                             nullptr);
+    }
+}
+
 juce::String AudioBridge::getTrackAudioOutput(TrackId trackId) const {
     auto* track = getAudioTrack(trackId);
     if (!track) {
@@ -1834,6 +4267,18 @@ juce::String AudioBridge::getTrackMidiInput(TrackId trackId) const {
 // Plugin Editor Windows (delegates to PluginWindowManager)
 // =============================================================================
 
+void AudioBridge::setPluginWindowManager(PluginWindowManager* manager) {
+    if (windowManager_) {
+        windowManager_->onWindowStateChanged = nullptr;
+    }
+    windowManager_ = manager;
+    if (windowManager_) {
+        windowManager_->onWindowStateChanged = [this](DeviceId deviceId, bool) {
+            markDeviceStatusChanged(deviceId);
+        };
+    }
+}
+
 void AudioBridge::showPluginWindow(DeviceId deviceId) {
     if (windowManager_) {
         auto plugin = getPlugin(deviceId);
@@ -2,23 +2,57 @@
 
 #include <tracktion_engine/tracktion_engine.h>
 
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <deque>
 #include <functional>
 #include <map>
 #include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
+#include "../core/AutomationManager.hpp"
 #include "../core/ClipManager.hpp"
 #include "../core/DeviceInfo.hpp"
 #include "../core/TrackManager.hpp"
 #include "../core/TypeIds.hpp"
+#include "../core/UndoManager.hpp"
+#include "../core/ViewModeState.hpp"
+#include "../profiling/DropoutLog.hpp"
+#include "../profiling/MetricsExporter.hpp"
+#include "../profiling/ProfilingCounters.hpp"
+#include "AudioCallbackStats.hpp"
+#include "AudioEventQueue.hpp"
+#include "AudioModulator.hpp"
+#include "AudioReadAhead.hpp"
+#include "AudioTaps.hpp"
+#include "AutomationPlayer.hpp"
+#include "ChainSilenceGate.hpp"
+#include "ClickGenerator.hpp"
+#include "DeviceCpuMeter.hpp"
 #include "DeviceProcessor.hpp"
+#include "DiskRecorder.hpp"
+#include "GroupRenderPlan.hpp"
+#include "IdSlotMap.hpp"
 #include "MeteringBuffer.hpp"
+#include "NotePreviewPlugin.hpp"
 #include "ParameterQueue.hpp"
+#include "ParameterRamp.hpp"
+#include "PlayheadClock.hpp"
+#include "PluginInstancePool.hpp"
+#include "RealtimeSnapshot.hpp"
+#include "SessionLaunchScheduler.hpp"
+#include "StretchRenderCache.hpp"
 
 namespace magda {
 
 // Forward declarations
 namespace te = tracktion;
+class PerformanceMonitor;
 class PluginWindowManager;
+class SandboxHost;
 class TracktionEngineWrapper;
 
 /**
@@ -48,12 +82,28 @@ struct PluginLoadResult {
  * - Maps ClipId to tracktion::Clip instances
  * - Loads built-in and external plugins
  * - Manages metering and parameter communication
+ * - Evaluates mods per audio block and applies them to plugin parameters
+ * - Plays automation lanes into track and plugin parameters per audio block
+ *
+ * Clip, track-property and device-property notifications only mark work as pending. The
+ * work is applied once per message-loop tick (or when an undo compound operation ends), so
+ * a gesture that touches many objects edits the engine in one batch.
  *
  * Thread Safety:
  * - UI thread: Receives TrackManager/ClipManager notifications, updates mappings
  * - Audio thread: Reads mappings, processes parameter changes, pushes metering
+ *
+ * The bridge registers itself as an extra device callback (see TracktionEngineWrapper) to get
+ * a per-block hook for parameter changes and modulation. It always outputs silence.
  */
-class AudioBridge : public TrackManagerListener, public ClipManagerListener, public juce::Timer {
+class AudioBridge : public TrackManagerListener,
+                    public ClipManagerListener,
+                    public ClipLauncher,
+                    public UndoManagerListener,
+                    public AutomationManagerListener,
+                    public juce::AudioIODeviceCallback,
+                    public juce::AsyncUpdater,
+                    public juce::Timer {
   public:
     /**
      * @brief Construct AudioBridge with Tracktion Engine references
@@ -81,17 +131,60 @@ class AudioBridge : public TrackManagerListener, public ClipManagerListener, pub
     void clipsChanged() override;
     void clipPropertyChanged(ClipId clipId) override;
     void clipSelectionChanged(ClipId clipId) override;
+    void clipAudiblePreview(const ClipInfo& preview) override;
+
+    // =========================================================================
+    // UndoManagerListener implementation
+    // =========================================================================
+
+    void undoStateChanged() override;
+
+    // =========================================================================
+    // AutomationManagerListener implementation
+    // =========================================================================
+
+    void automationLanesChanged() override;
+    void automationClipsChanged(AutomationLaneId laneId) override;
+    void automationPointsChanged(AutomationLaneId laneId) override;
+
+    // =========================================================================
+    // AudioIODeviceCallback implementation (audio thread, control-rate work only)
+    // =========================================================================
+
+    void audioDeviceIOCallbackWithContext(
+        const float* const* inputChannelData, int numInputChannels,
+        float* const* outputChannelData, int numOutputChannels, int numSamples,
+        const juce::AudioIODeviceCallbackContext& context) override;
+    void audioDeviceAboutToStart(juce::AudioIODevice* device) override;
+    void audioDeviceStopped() override;
 
     // =========================================================================
     // Clip Synchronization
     // =========================================================================
 
+    /**
+     * @brief Apply pending clip, track and device notifications to the engine now
+     *
+     * Normally runs on the next message-loop tick; call before anything that needs the
+     * engine to be current (e.g. starting playback).
+     */
+    void flushPendingSync();
+
     /**
      * @brief Sync a single clip to Tracktion Engine
      * @param clipId The MAGDA clip ID to sync
      */
     void syncClipToEngine(ClipId clipId);
 
+    /**
+     * @brief Give an engine MIDI clip the loop range of a MAGDA clip
+     *
+     * A looped clip loops its first internalLoopLength beats up to its end; an unlooped
+     * one plays straight through. The range is only touched when it differs, so resizing a
+     * looped clip leaves the engine's loop alone.
+     */
+    static void syncMidiClipLoop(te::MidiClip& engineClip, const ClipInfo& clip);
+
     /**
      * @brief Remove a clip from Tracktion Engine
      * @param clipId The MAGDA clip ID to remove
@@ -119,12 +212,82 @@ class AudioBridge : public TrackManagerListener, public ClipManagerListener, pub
     PluginLoadResult loadExternalPlugin(TrackId trackId,
                                         const juce::PluginDescription& description);
 
+    /**
+     * @brief Load an external plugin into the track's plugin host process
+     *
+     * The plugin runs in a magda_plugin_host (see SandboxHost) and a SandboxedPlugin
+     * stands in for it on the track. It loads there in the background; a failure is
+     * reported through onPluginLoadFailed.
+     */
+    PluginLoadResult loadSandboxedPlugin(TrackId trackId,
+                                         const juce::PluginDescription& description);
+
     /**
      * @brief Callback invoked when a plugin fails to load
      * Parameters: deviceId, error message
      */
     std::function<void(DeviceId, const juce::String&)> onPluginLoadFailed;
 
+    /**
+     * @brief Callback invoked when an external plugin is inserted (for usage counts)
+     */
+    std::function<void(const juce::PluginDescription&)> onExternalPluginLoaded;
+
+    /**
+     * @brief Warm instances of the most-used plugins, taken by loadExternalPlugin()
+     */
+    PluginInstancePool& getPluginPool() {
+        return pluginPool_;
+    }
+
+    /**
+     * @brief Reserve pool instances for the external devices in tracks (a project to come)
+     *
+     * Sandboxed devices load in their host process and aren't reserved.
+     * @return How many instances were reserved
+     */
+    int preloadPlugins(const std::vector<TrackInfo>& tracks);
+
+    /**
+     * @brief True while a device's plugin is queued for, or in, asynchronous loading
+     *
+     * External plugins are instantiated in time slices on the message thread (see
+     * syncTrackPlugins()), so a device can exist in TrackManager before its plugin does.
+     */
+    bool isDeviceLoading(DeviceId deviceId) const;
+
+    /**
+     * @brief Number of plugin loads still queued
+     */
+    size_t getNumPendingPluginLoads() const {
+        return pendingPluginLoads_.size();
+    }
+
+    // =========================================================================
+    // Memory accounting (message thread, see MemoryAccounting)
+    // =========================================================================
+
+    /**
+     * @brief Approximate heap footprint of the bridge: id mappings, MIDI note shadows,
+     *        device processors and the fixed audio-thread buffers
+     */
+    size_t getSizeInBytes() const;
+
+    /**
+     * @brief Approximate size of the engine-side state of every mapped plugin
+     *
+     * Walks each plugin's ValueTree, counting property text and binary blobs. External
+     * plugins write their opaque state there when the Edit is flushed, so this is the
+     * state as of the last save or flush.
+     */
+    size_t getPluginStateSizeInBytes() const;
+
+    /**
+     * @brief Engine figures for the metrics endpoint: device CPU and xruns, disk stream
+     *        buffers, queue drops and plugin counts (message thread)
+     */
+    void writeMetrics(MetricsWriter& writer) const;
+
     /**
      * @brief Add a level meter plugin to a track for metering
      * @param trackId The MAGDA track ID
@@ -138,6 +301,22 @@ class AudioBridge : public TrackManagerListener, public ClipManagerListener, pub
      */
     void ensureVolumePluginPosition(te::AudioTrack* track) const;
 
+    /**
+     * @brief Ensure the track's NotePreviewPlugin is first in its chain
+     */
+    void ensureNotePreviewer(TrackId trackId, te::AudioTrack* track);
+
+    /**
+     * @brief Audition a note on a track's instrument (any thread)
+     *
+     * Lock-free on the render side and allocation-free throughout: the note goes into the
+     * track's NotePreviewPlugin and is played in the next block, offset within it by when
+     * this was called.
+     *
+     * @return false if the track has no previewer yet or its queue is full
+     */
+    bool previewNote(TrackId trackId, int noteNumber, int velocity, bool isNoteOn);
+
     // =========================================================================
     // Track Mapping
     // =========================================================================
@@ -156,6 +335,43 @@ class AudioBridge : public TrackManagerListener, public ClipManagerListener, pub
      */
     te::Plugin::Ptr getPlugin(DeviceId deviceId) const;
 
+    /**
+     * @brief Copy of a device's plugin state for a project save
+     * @return An invalid tree if the device has no plugin (yet)
+     */
+    juce::ValueTree getPluginStateForSave(DeviceId deviceId) const;
+
+    /**
+     * @brief Start copies of devices from their originals' plugin state (track duplication)
+     *
+     * Each source's state is read now; the copy's plugin is queued like any slow load,
+     * showing as loading until it is instantiated, and the state is applied as it loads.
+     * @param devices Pairs of (source device, copy device)
+     */
+    void clonePluginStates(const std::vector<std::pair<DeviceId, DeviceId>>& devices);
+
+    /**
+     * @brief Snapshot a device's plugin state and parameter values (for its A/B slots)
+     * @return Null if the device has no plugin (yet)
+     */
+    std::shared_ptr<const DeviceStateSnapshot> captureDeviceState(DeviceId deviceId) const;
+
+    enum class StateRestore {
+        Failed,
+        Parameters,  // Only the parameters that differed were set
+        Full         // The whole plugin state was loaded
+    };
+
+    /**
+     * @brief Bring a device back to a snapshot
+     *
+     * The snapshot's parameter values are set first, only those that differ; if the
+     * plugin's state then matches the snapshot, that was all it took. Otherwise the full
+     * state is loaded. The device's DeviceInfo parameters are updated without a
+     * notification; the caller sends one.
+     */
+    StateRestore restoreDeviceState(DeviceId deviceId, const DeviceStateSnapshot& snapshot);
+
     /**
      * @brief Get the DeviceProcessor for a MAGDA device
      * @param deviceId MAGDA device ID
@@ -177,6 +393,113 @@ class AudioBridge : public TrackManagerListener, public ClipManagerListener, pub
      */
     void removeAudioTrack(TrackId trackId);
 
+    // =========================================================================
+    // Track Freeze
+    // =========================================================================
+
+    /**
+     * @brief Swap a track's playback to a render of it (see TrackFreezer)
+     * @param renderFile The track rendered without its fader, from startSeconds
+     *
+     * The render plays as a clip on the track itself, so the fader, pan, mute and meters
+     * keep working. The track's own clips are muted and its device plugins disabled, which
+     * takes them out of the playback graph while their state stays in the Edit. Both are
+     * re-applied after every sync, so edits made while frozen wait for the unfreeze.
+     */
+    void setTrackFrozen(TrackId trackId, const juce::File& renderFile, double startSeconds);
+
+    /**
+     * @brief Remove the render clip and restore the track's clips and plugins
+     */
+    void clearTrackFrozen(TrackId trackId);
+
+    bool isTrackFrozen(TrackId trackId) const {
+        return frozenTracks_.count(trackId) != 0;
+    }
+
+    // =========================================================================
+    // Idle Chain Suspension
+    // =========================================================================
+
+    /**
+     * @brief How long a chain's output must stay silent before its devices are suspended
+     *
+     * A track's devices are disabled (taken out of processing, state kept) once the track
+     * has nothing coming in and its meter has been silent for the tail. Input is predicted
+     * rather than detected, so the chain is processing again before it arrives: a clip
+     * within kChainWakeLookaheadSeconds of the playhead, transport start and locate (see
+     * wakeAllChains()), and any edit to the track or its devices wake it. Tracks with live
+     * input (an audio input, record arm, or MIDI input into an instrument), group and aux
+     * tracks, and frozen tracks are never suspended, unless muted.
+     *
+     * @param seconds 0 or less turns suspension off
+     */
+    void setChainSuspendTailSeconds(double seconds);
+    double getChainSuspendTailSeconds() const {
+        return chainGate_.getTailSeconds();
+    }
+
+    /**
+     * @brief Re-enable every suspended chain now (before the transport starts or jumps)
+     */
+    void wakeAllChains();
+
+    /**
+     * @brief Keep every chain awake until released (offline renders read the Edit)
+     */
+    void setChainSuspensionPaused(bool paused);
+
+    /**
+     * @brief Which stretcher clips stretching in real time use (Draft: the cheaper one)
+     *
+     * Set from the view mode's profile; offline renders switch to Final while they run.
+     */
+    void setRenderQuality(RenderQuality quality);
+    RenderQuality getRenderQuality() const {
+        return renderQuality_;
+    }
+
+    ChainSilenceGate::Stats getChainSuspensionStats() const {
+        return chainGate_.getStats();
+    }
+
+    static constexpr double kChainWakeLookaheadSeconds = 0.25;
+
+    // =========================================================================
+    // Device CPU Measurement
+    // =========================================================================
+
+    /**
+     * @brief Time every device on every track (off by default)
+     *
+     * While on, a DeviceTimingProbePlugin sits before each device and after the last one,
+     * so turning it on or off rebuilds each track's plugin list. Off clears the readings.
+     */
+    void setDeviceCpuMeasurementEnabled(bool enabled);
+    bool isDeviceCpuMeasurementEnabled() const {
+        return deviceCpuMeasurement_;
+    }
+
+    /**
+     * @brief A device's latest load (unmeasured unless measurement is on and it rendered)
+     */
+    DeviceCpuMeter::Reading getDeviceCpuReading(DeviceId deviceId) const {
+        return deviceCpuMeter_.getReading(deviceId);
+    }
+
+    /**
+     * @brief A track's device loads summed per chain, per rack and for the whole track
+     */
+    ChainCpuUsage getChainCpuUsage(TrackId trackId) const;
+
+    /**
+     * @brief The track graph's render dependencies, costed from the device loads
+     *
+     * Tracks feed their group and the aux tracks they send to. Unmeasured devices are
+     * costed at GroupRenderPlan::kUnmeasuredDeviceLoad.
+     */
+    GroupRenderPlan getGroupRenderPlan() const;
+
     // =========================================================================
     // Metering
     // =========================================================================
@@ -191,21 +514,35 @@ class AudioBridge : public TrackManagerListener, public ClipManagerListener, pub
         return meteringBuffer_;
     }
 
+    /**
+     * @brief Tap a track's output (by TrackId) or the master's (AudioTaps::kMasterPoint)
+     *
+     * For views that analyse audio: their analysers run on the taps' own thread.
+     */
+    AudioTaps& getAudioTaps() {
+        return audioTaps_;
+    }
+
     // =========================================================================
     // Parameter Queue
     // =========================================================================
 
     /**
      * @brief Get the parameter queue for pushing changes from UI
+     *
+     * Pending values coalesce per (device, param), so the queue never overflows during
+     * fast gestures and each parameter is applied at most once per audio callback.
      */
-    ParameterQueue& getParameterQueue() {
+    CoalescingParameterQueue& getParameterQueue() {
         return parameterQueue_;
     }
 
     /**
      * @brief Push a parameter change to the audio thread
+     * @param rampMs Glide to the new value over this many milliseconds (0 = step)
      */
-    bool pushParameterChange(DeviceId deviceId, int paramIndex, float value);
+    bool pushParameterChange(DeviceId deviceId, int paramIndex, float value,
+                             float rampMs = 0.0f);
 
     // =========================================================================
     // Synchronization
@@ -227,14 +564,15 @@ class AudioBridge : public TrackManagerListener, public ClipManagerListener, pub
     // =========================================================================
 
     /**
-     * @brief Process pending parameter changes (call from audio thread)
-     */
-    void processParameterChanges();
-
-    /**
-     * @brief Update metering from level measurers (call from audio thread)
+     * @brief Process pending parameter changes and advance ramps (call from audio thread)
+     * @param numSamples Length of the block about to be rendered
+     * @param sampleRate Current device sample rate (for converting ramp times)
+     *
+     * Changes with a ramp time glide in sub-blocks of ParameterRampPool::kSubBlockSamples
+     * rather than stepping once per block, which lets the larger buffers of
+     * AudioEngineProfile::getMixProfile() run without zipper noise.
      */
-    void updateMetering();
+    void processParameterChanges(int numSamples, double sampleRate);
 
     // =========================================================================
     // Transport State (for trigger sync)
@@ -242,49 +580,191 @@ class AudioBridge : public TrackManagerListener, public ClipManagerListener, pub
 
     /**
      * @brief Update transport state from UI thread (called by TracktionEngineWrapper)
+     *
+     * Only the inputs: the audio thread works out starts and loop wraps on its own clock
+     * and publishes what each block played through getPlayheadClock(). Transport-synced
+     * devices are switched when the play state changes.
      * @param isPlaying Current transport playing state
-     * @param justStarted True if transport just started this frame
-     * @param justLooped True if transport just looped this frame
+     * @param bpm Current tempo (for tempo-synced mods on the audio thread)
+     */
+    void updateTransportState(bool isPlaying, double bpm = 120.0);
+
+    /**
+     * @brief The tempo changed (message thread); the next block plays at it
+     */
+    void setTempo(double bpm) {
+        tempoBpm_.store(bpm, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief The transport is about to play from here (message thread, before it starts)
+     *
+     * Starts the audio thread's beat clock for session launches with the engine's, rather
+     * than at the next UI tick.
+     */
+    void transportStarting(double positionSeconds);
+
+    /**
+     * @brief The playhead was moved (message thread); waiting launches are re-timed
      */
-    void updateTransportState(bool isPlaying, bool justStarted, bool justLooped);
+    void transportSeeked(double positionSeconds);
 
     /**
-     * @brief Get current transport playing state (audio thread safe)
+     * @brief The transport as each audio callback played it - position and heard time,
+     *        tempo, play state, start and loop wrap - in one consistent sample (any thread)
      */
-    bool isTransportPlaying() const {
-        return transportPlaying_.load(std::memory_order_acquire);
+    const PlayheadClock& getPlayheadClock() const {
+        return playheadClock_;
     }
 
+    // =========================================================================
+    // Recording
+    // =========================================================================
+
     /**
-     * @brief Get just-started flag (audio thread safe)
+     * @brief Record each armed audio track's input to its own file in folder
+     *
+     * Capture runs through the bridge's DiskRecorder and begins with the next block the
+     * transport plays. Takes are placed one device round trip earlier than the block they
+     * arrived in, so they line up with what the player heard.
+     * @return False if no armed track has an input, or the files couldn't be created
      */
-    bool didJustStart() const {
-        return justStartedFlag_.load(std::memory_order_acquire);
+    bool startRecording(const juce::File& folder);
+
+    /**
+     * @brief Finish the files and add each take as an audio clip on its track (one undo
+     *        step)
+     * @return Number of clips created
+     */
+    int stopRecording();
+
+    bool isRecordingToDisk() const {
+        return diskRecorder_.isRecording();
     }
 
     /**
-     * @brief Get just-looped flag (audio thread safe)
+     * @brief Ring fill level and dropouts of the recording in progress (message thread)
      */
-    bool didJustLoop() const {
-        return justLoopedFlag_.load(std::memory_order_acquire);
+    DiskRecorder::Stats getRecordingStats() const {
+        return diskRecorder_.getStats();
     }
 
     // =========================================================================
-    // MIDI Activity Monitoring
+    // Session Clip Launching
+    // =========================================================================
+
+    /**
+     * @brief Queue launches and stops for the audio thread (ClipLauncher)
+     *
+     * The bridge is ClipManager's launcher while it exists. Each block works out the
+     * playhead's beat from the tempo and the position the transport started or was moved
+     * to (wrapping at the loop end), fires what is due at its sample, and reports it back
+     * as ClipLaunched / ClipStopped events, which move the clips' state in ClipManager.
+     * @return False when no audio callback is running, so the launches apply at once
+     */
+    bool scheduleClipLaunches(const std::vector<ClipLaunchRequest>& requests) override;
+
+    // =========================================================================
+    // Metronome
     // =========================================================================
 
     /**
-     * @brief Trigger MIDI activity for a track (audio thread safe)
-     * @param trackId The track that received MIDI
+     * @brief The click, mixed into the device output on the beats of the audio-thread clock
      */
-    void triggerMidiActivity(TrackId trackId);
+    void setMetronomeEnabled(bool enabled) {
+        clickGenerator_.setEnabled(enabled);
+    }
+    bool isMetronomeEnabled() const {
+        return clickGenerator_.isEnabled();
+    }
 
     /**
-     * @brief Check and clear MIDI activity flag for a track (UI thread)
-     * @param trackId The track to check
-     * @return true if MIDI activity occurred since last check
+     * @brief Beats per bar, so the click accents bar starts (the time signature's numerator)
      */
-    bool consumeMidiActivity(TrackId trackId);
+    void setMetronomeBeatsPerBar(int beats) {
+        clickGenerator_.setBeatsPerBar(beats);
+    }
+
+    /**
+     * @brief Click this many beats at the tempo while stopped, then call onCountInFinished
+     *
+     * The count-in clicks whether or not the metronome is on. It ends on the beat after its
+     * last click, which is where the caller starts the transport.
+     * @return False when no audio callback is running to click it
+     */
+    bool startCountIn(int beats);
+    void cancelCountIn() {
+        clickGenerator_.cancelCountIn();
+    }
+
+    /**
+     * @brief Called on the message thread when a count-in reaches its end
+     */
+    std::function<void()> onCountInFinished;
+
+    // =========================================================================
+    // Audio Events
+    // =========================================================================
+
+    /**
+     * @brief Queue an event for the UI (any thread, lock-free)
+     *
+     * Events are delivered to subscribers on the message thread, once per metering tick.
+     * @return false if the queue was full and the event was dropped
+     */
+    bool postEvent(const AudioEvent& event) {
+        return eventQueue_.push(event);
+    }
+
+    /**
+     * @brief Receive events of one type on the message thread (MIDI activity, transport
+     *        edges, xruns) until the returned Subscription is reset or destroyed
+     */
+    [[nodiscard]] Subscription subscribeToEvents(AudioEvent::Type type,
+                                                 AudioEventDispatcher::Handler handler) {
+        return eventDispatcher_.subscribe(type, std::move(handler));
+    }
+
+    /**
+     * @brief Mark a device's status (loading, editor window, CPU reading) as changed
+     *
+     * Collected on the message thread and dispatched as one DeviceStatusChanged event at
+     * the start of the next tick, so slots refresh from the getters only when something
+     * they show changed, instead of each polling.
+     */
+    void markDeviceStatusChanged(DeviceId deviceId);
+
+    /**
+     * @brief Note that MIDI arrived at timestampSeconds (MIDI thread, lock-free)
+     *
+     * The next audio block measures input-to-output latency from the oldest unmeasured
+     * arrival and reports it as a MidiLatency event; the bridge records those into
+     * PerformanceMonitor as "MIDIInputLatency".
+     * @param timestampSeconds Driver timestamp, on the Time::getMillisecondCounterHiRes clock
+     */
+    void markMidiInput(double timestampSeconds) {
+        double none = 0.0;
+        pendingMidiInputTime_.compare_exchange_strong(none, timestampSeconds,
+                                                      std::memory_order_release,
+                                                      std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief A note arrived for a track (MIDI thread, wait-free)
+     *
+     * Gates and retriggers the track's envelopes and MIDI-triggered mods.
+     * @param channel 1-16
+     */
+    void modNoteInput(TrackId trackId, int channel, int note, bool isNoteOn) {
+        modulator_.noteInput(trackId, channel, note, isNoteOn);
+    }
+
+    /**
+     * @brief A macro knob moved; its links are applied on the next audio block
+     */
+    void setMacroValue(ModOwner owner, int ownerId, int macroIndex, float value) {
+        modulator_.setMacroValue(owner, ownerId, macroIndex, value);
+    }
 
     // =========================================================================
     // Mixer Controls
@@ -330,6 +810,17 @@ class AudioBridge : public TrackManagerListener, public ClipManagerListener, pub
      */
     float getMasterVolume() const;
 
+    /**
+     * @brief Scale the master output on top of its volume (0 = silent, 1 = as mixed)
+     *
+     * For fades outside the project, such as ProjectSwitcher's around a project change;
+     * not saved, and getMasterVolume() keeps returning the project's volume.
+     */
+    void setMasterFade(float gain);
+    float getMasterFade() const {
+        return masterFade_;
+    }
+
     /**
      * @brief Set master pan
      * @param pan Pan position (-1.0 to 1.0)
@@ -387,6 +878,11 @@ class AudioBridge : public TrackManagerListener, public ClipManagerListener, pub
      */
     juce::String getTrackAudioOutput(TrackId trackId) const;
 
+    /**
+     * @brief The engine aux bus an Aux track returns, or -1 if it has none
+     */
+    int getAuxBus(TrackId auxTrackId) const;
+
     /**
      * @brief Get current audio input source for a track
      * @return Input device ID
@@ -439,9 +935,7 @@ class AudioBridge : public TrackManagerListener, public ClipManagerListener, pub
      * @brief Set the plugin window manager (for delegation)
      * @param manager Pointer to PluginWindowManager (owned by TracktionEngineWrapper)
      */
-    void setPluginWindowManager(PluginWindowManager* manager) {
-        windowManager_ = manager;
-    }
+    void setPluginWindowManager(PluginWindowManager* manager);
 
     /**
      * @brief Set the engine wrapper (for accessing ClipInterface methods)
@@ -485,54 +979,332 @@ class AudioBridge : public TrackManagerListener, public ClipManagerListener, pub
     // Timer callback for metering updates (runs on message thread)
     void timerCallback() override;
 
+    // Flushes deferred sync work (message thread)
+    void handleAsyncUpdate() override;
+
+    // Drain callback timings into the monitor: durations, overruns by stage, CPU load
+    void collectCallbackTimings(PerformanceMonitor& monitor);
+
+    // The devices with the longest blocks since the last meter update, named for the log
+    std::vector<DropoutLog::Hotspot> getDropoutHotspots() const;
+
+    // Instantiate queued plugins for up to kPluginLoadSliceMs (at least one per call)
+    void loadPendingPlugins();
+
+    // Immediate sync work behind the deferred notifications
+    void syncClipList();
+    void syncTrackProperties(TrackId trackId);
+    void syncDeviceProperties(DeviceId deviceId);
+
     // Clip synchronization helpers
     void syncMidiClipToEngine(ClipId clipId, const ClipInfo* clip);
     void syncAudioClipToEngine(ClipId clipId, const ClipInfo* clip);
 
+    // Apply only the edited run of notes to the engine clip (full rebuild the first time)
+    void syncMidiNotesToEngine(ClipId clipId, const ClipInfo& clip, te::MidiList& sequence);
+
     // Create track mapping
     void ensureTrackMapping(TrackId trackId);
 
+    // Mute, and disable the device plugins of, every frozen track (after syncs undo it)
+    void reapplyFreezes();
+
+    // Observe every chain and suspend or resume it (timer)
+    void updateChainSuspension();
+    ChainSilenceGate::Observation observeChain(const TrackInfo& track, te::AudioTrack& teTrack,
+                                               int numDevices, double position, bool playing);
+    void suspendChain(TrackId trackId, te::AudioTrack* track);
+    void resumeChain(TrackId trackId);
+    void wakeChain(TrackId trackId);
+
+    // Put timing probes around the track's devices, or take them out when measurement is
+    // off (after every change to the track's plugin list)
+    void syncTimingProbes(TrackId trackId, te::AudioTrack* track);
+
+    // Send each run of consecutive sandboxed devices on the track to its host in one round
+    // trip (after every change to the track's plugin list, after the probes)
+    void syncSandboxBatches(te::AudioTrack* track);
+
+    // Replace the plugin of a device moved into or out of the sandbox, in place and keeping
+    // its state
+    void resandboxDevice(TrackId trackId, const DeviceInfo& device);
+
+    // The track's plugin host process, created on first use
+    std::shared_ptr<SandboxHost> getSandboxHost(TrackId trackId);
+    DeviceId findSandboxedDevice(const SandboxHost* host, int slot) const;
+    void handleSandboxLoaded(const SandboxHost* host, int slot, const juce::String& error);
+    void handleSandboxCrashed(const SandboxHost* host);
+
+    // Give every Aux track an engine bus and resync all sends (after track list or type
+    // changes)
+    void syncAuxBuses();
+    // Place a track's aux return and sends around its fader (after every change to the
+    // track's plugin list or sends)
+    void syncTrackSends(TrackId trackId);
+
     // Plugin creation helpers
     te::Plugin::Ptr createToneGenerator(te::AudioTrack* track);
     // Note: createVolumeAndPan removed - track volume is separate infrastructure
     te::Plugin::Ptr createLevelMeter(te::AudioTrack* track);
+
+    // Put a TrackMeterPlugin at the end of the master plugins, feeding the master's taps
+    void attachMasterTap();
+
+    // Stop a track's meters publishing (blocks until any in-flight push is done)
+    static void detachTrackMeters(te::AudioTrack* track);
     te::Plugin::Ptr createFourOscSynth(te::AudioTrack* track);
 
     // Convert DeviceInfo to plugin
     te::Plugin::Ptr loadDeviceAsPlugin(TrackId trackId, const DeviceInfo& device);
 
+    /**
+     * @brief Immutable DeviceId -> AutomatableParameter lookup used by the audio thread
+     *
+     * Built on the message thread from deviceToPlugin_ and published atomically, so that
+     * processParameterChanges() can resolve a change with two array indexes and no lock
+     * or allocation. Holds plugin refs so the raw parameter pointers stay valid for the
+     * lifetime of the table.
+     */
+    struct ParameterTable {
+        struct Range {
+            int begin = 0;
+            int count = 0;
+        };
+        std::vector<Range> ranges;  // Indexed directly by DeviceId
+        std::vector<te::AutomatableParameter*> parameters;
+        std::vector<te::Plugin::Ptr> plugins;
+
+        te::AutomatableParameter* find(DeviceId deviceId, int paramIndex) const {
+            if (deviceId < 0 || deviceId >= static_cast<int>(ranges.size())) {
+                return nullptr;
+            }
+            const auto& range = ranges[static_cast<size_t>(deviceId)];
+            if (paramIndex < 0 || paramIndex >= range.count) {
+                return nullptr;
+            }
+            return parameters[static_cast<size_t>(range.begin + paramIndex)];
+        }
+    };
+
+    /**
+     * @brief A ramped parameter, by device and index rather than pointer
+     *
+     * Resolved against whichever table is current, so a ramp carries on across a table
+     * rebuild and simply stops applying if its device has gone.
+     */
+    struct RampKey {
+        DeviceId deviceId = INVALID_DEVICE_ID;
+        int paramIndex = -1;
+
+        bool operator==(const RampKey& other) const = default;
+    };
+
+    // Rebuild and publish the parameter table (message thread, caller holds mappingLock_)
+    void rebuildParameterTable();
+
+    // Recompile the mod tree for the audio thread (message thread)
+    void rebuildModulation();
+
+    // Recompile automation lanes for the audio thread (message thread)
+    void rebuildAutomation();
+
+    // ModulatorEngine value source: copies audio-thread mod values into ModInfo for display.
+    // Returns false while no audio device is running.
+    bool readBackModulation();
+
     // References to Tracktion Engine (not owned)
     te::Engine& engine_;
     te::Edit& edit_;
 
-    // Bidirectional mappings
-    std::map<TrackId, te::AudioTrack*> trackMapping_;
-    std::map<TrackId, std::string> trackIdToEngineId_;  // MAGDA TrackId → Engine string ID
-    std::map<DeviceId, te::Plugin::Ptr> deviceToPlugin_;
-    std::map<te::Plugin*, DeviceId> pluginToDevice_;
+    float masterVolume_ = 1.0f;  // As set, before masterFade_
+    float masterFade_ = 1.0f;
+
+    struct EditItemIDHash {
+        size_t operator()(te::EditItemID id) const noexcept {
+            return std::hash<uint64_t>()(id.getRawID());
+        }
+    };
+
+    // Bidirectional mappings (indexed directly by the MAGDA IDs)
+    IdSlotMap<TrackId, te::AudioTrack*> trackMapping_;
+    IdSlotMap<DeviceId, te::Plugin::Ptr> deviceToPlugin_;
+    std::unordered_map<te::Plugin*, DeviceId> pluginToDevice_;
+    IdSlotMap<TrackId, te::Plugin::Ptr> notePreviewers_;  // NotePreviewPlugin per track
 
     // Clip ID mappings (MAGDA ClipId <-> Tracktion Engine clip ID)
-    std::map<ClipId, std::string> clipIdToEngineId_;  // MAGDA → TE
-    std::map<std::string, ClipId> engineIdToClipId_;  // TE → MAGDA
+    IdSlotMap<ClipId, te::EditItemID> clipIdToEngineId_;                           // MAGDA → TE
+    std::unordered_map<te::EditItemID, ClipId, EditItemIDHash> engineIdToClipId_;  // TE → MAGDA
 
-    // Device processors (own the processing logic for each device)
-    std::map<DeviceId, std::unique_ptr<DeviceProcessor>> deviceProcessors_;
+    /**
+     * @brief What was last written to an engine MIDI clip, index for index
+     *
+     * engineNotes[i] is the te::MidiNote created for notes[i], so an edit can be diffed
+     * against notes and applied to just the notes that changed.
+     */
+    struct MidiClipShadow {
+        std::vector<MidiNote> notes;
+        std::vector<te::MidiNote*> engineNotes;
+    };
+    IdSlotMap<ClipId, MidiClipShadow> midiClipShadows_;
 
-    // Per-track level measurer clients (needed to read levels)
-    std::map<TrackId, te::LevelMeasurer::Client> meterClients_;
+    // Settled stretches play from a background render; a ready render re-syncs its clip
+    StretchRenderCache stretchRenderCache_{[this](ClipId clipId) { clipPropertyChanged(clipId); }};
 
-    // Lock-free communication buffers
-    MeteringBuffer meteringBuffer_;
-    ParameterQueue parameterQueue_;
+    // Aux track -> the engine aux bus its return plays. One shared effect chain on the
+    // aux track serves every track that sends to it.
+    static constexpr int kMaxAuxBuses = 32;
+    std::map<TrackId, int> auxBuses_;
+
+    // Frozen tracks and the engine clip that plays each one's render
+    std::unordered_map<TrackId, te::EditItemID> frozenTracks_;
+
+    // Idle chain suspension: the plugins each suspended chain disabled (to re-enable)
+    ChainSilenceGate chainGate_;
+    std::unordered_map<TrackId, std::vector<te::Plugin::Ptr>> suspendedPlugins_;
+    bool chainSuspensionPaused_ = false;
+
+    // Per-device CPU measurement (probes charge deviceCpuMeter_ from the audio thread)
+    DeviceCpuMeter deviceCpuMeter_;
+    bool deviceCpuMeasurement_ = false;
 
-    // Transport state (UI thread writes, audio thread reads - lock-free)
+    // Device processors (own the processing logic for each device)
+    IdSlotMap<DeviceId, std::unique_ptr<DeviceProcessor>> deviceProcessors_;
+
+    // Lock-free communication buffers (track meters push into meteringBuffer_)
+    MeteringBuffer meteringBuffer_;
+    AudioTaps audioTaps_;        // Track meters copy tapped blocks into it
+    te::Plugin::Ptr masterTap_;  // Master output's meter, only feeding audioTaps_
+    CoalescingParameterQueue parameterQueue_;
+    AudioEventQueue eventQueue_;
+    AudioEventDispatcher eventDispatcher_;  // Message thread, drained in timerCallback()
+    // Devices marked since the last DeviceStatusChanged, and whether that was all of them
+    std::vector<DeviceId> statusChangedDevices_;
+    bool allDeviceStatusChanged_ = false;
+    int cpuStatusTicks_ = 0;  // Ticks since CPU readings were last pushed
+    static constexpr int kCpuStatusTicks = 3;  // 10 Hz at the 30 Hz tick
+    void dispatchDeviceStatus();
+    Subscription midiLatencySubscription_;   // Records MidiLatency events for profiling
+    Subscription memorySubscription_;        // Bridge footprint in MemoryAccounting
+    Subscription pluginMemorySubscription_;  // Plugin state in MemoryAccounting
+    Subscription metricsSubscription_;       // Engine figures in MetricsExporter
+    std::atomic<double> pendingMidiInputTime_{0.0};  // Oldest unmeasured arrival, 0 if none
+
+    // Published parameter table (message thread writes, audio thread reads)
+    RealtimeSnapshot<ParameterTable> parameterTable_;
+    // Audio thread only: ramps in flight
+    ParameterRampPool<RampKey> parameterRamps_;
+
+    // Audio-thread modulation
+    AudioModulator modulator_;
+
+    // Audio-thread automation playback; edits mark it dirty and timerCallback() recompiles
+    AutomationPlayer automationPlayer_;
+    bool automationDirty_ = true;
+    std::atomic<double> deviceSampleRate_{0.0};
+    std::atomic<bool> audioCallbackRunning_{false};
+
+    // Transport inputs (UI thread writes, audio thread reads - lock-free); what each block
+    // made of them is published through playheadClock_
     std::atomic<bool> transportPlaying_{false};
-    std::atomic<bool> justStartedFlag_{false};
-    std::atomic<bool> justLoopedFlag_{false};
+    std::atomic<double> tempoBpm_{120.0};
+
+    // Devices that follow the transport (tone generators, bypassed while stopped), noted as
+    // they load so a start or stop switches just those. Message thread only
+    std::vector<DeviceId> transportSyncedDevices_;
+    bool transportSyncedPlaying_ = false;  // What they were last switched to
+    void removeTransportSyncedDevice(DeviceId deviceId);
+    // Audio thread only: edge detection for mod triggers
+    bool audioSawPlaying_ = false;
+
+    // Session launch timing: where play started or jumped to, and the loop (message thread
+    // writes); the audio thread runs its own clock from there
+    SessionLaunchScheduler sessionLauncher_;
+    std::atomic<double> transportSeekSeconds_{0.0};
+    std::atomic<uint32_t> transportSeekCount_{0};
+    std::atomic<bool> loopEnabled_{false};
+    std::atomic<double> loopStartSeconds_{0.0};
+    std::atomic<double> loopEndSeconds_{0.0};
+    double audioPositionSeconds_ = 0.0;  // Audio thread only
+    uint32_t audioSeenSeekCount_ = 0;    // Audio thread only
+    bool audioWrapAtBlockStart_ = false;  // Audio thread only: the last block ended on a wrap
+    Subscription clipLaunchedSubscription_;
+    Subscription clipStoppedSubscription_;
+
+    // Clicks and count-ins run on the same clock as the launches
+    ClickGenerator clickGenerator_;
+    Subscription countInSubscription_;  // Calls onCountInFinished
+    double preparedSampleRate_ = 0.0;  // The click's and importer's; kept across restarts
+
+    RenderQuality renderQuality_ = RenderQuality::Draft;
+    te::TimeStretcher::Mode getStretchMode() const;
 
-    // MIDI activity flags (audio thread writes, UI thread reads/clears - lock-free)
-    static constexpr int kMaxTracks = 128;
-    std::array<std::atomic<bool>, kMaxTracks> midiActivityFlags_;
+    /**
+     * @brief Advance the audio-thread clock over the block, firing launches and adding clicks
+     * @return Sample the block wrapped to the loop start on, or -1
+     */
+    int processBeatClock(int numSamples, double sampleRate, bool playing, double bpm,
+                          float* const* outputChannelData, int numOutputChannels);
+
+    // Audio thread publishes each block's transport state and when it is heard
+    PlayheadClock playheadClock_;
+    void publishPlayheadClock(double blockStartSeconds, const AudioModulator::Transport& transport,
+                              bool playing, int loopWrapSample, int numSamples,
+                              double sampleRate);
+
+    // Device the callback is running on, for xrun reporting (set in audioDeviceAboutToStart)
+    std::atomic<juce::AudioIODevice*> audioDevice_{nullptr};
+    std::atomic<int> outputLatencySamples_{0};
+    std::atomic<int> inputLatencySamples_{0};
+
+    // Pages in the arrangement's audio around the playhead (timerCallback() drives it)
+    AudioReadAhead readAhead_;
+    std::vector<AudioReadAhead::ClipSpan> readAheadClips_;
+    bool readAheadClipsDirty_ = true;
+    double readAheadPosition_ = 0.0;
+    double readAheadTimeMs_ = 0.0;
+    void updateReadAhead();
+
+    // Armed inputs stream to disk while recording (the callback feeds it)
+    DiskRecorder diskRecorder_;
+    double recordingSampleRate_ = 0.0;
+    Subscription recordDropoutSubscription_;  // Logs RecordDropout events
+    std::vector<int> getRecordingChannels(const juce::String& deviceId) const;
+
+    // Direct monitoring: armed inputs mixed dry into the device output by the callback,
+    // ahead of the graph and its latency compensation
+    struct DirectMonitorRoute {
+        TrackId trackId = INVALID_TRACK_ID;
+        int left = 0;  // Packed input channels (the same channel twice for mono)
+        int right = 0;
+        float gainL = 0.0f;
+        float gainR = 0.0f;
+    };
+    using DirectMonitorRoutes = std::vector<DirectMonitorRoute>;
+    static constexpr size_t kMaxDirectMonitors = 16;
+    RealtimeSnapshot<DirectMonitorRoutes> directMonitorRoutes_;
+    // Audio thread: what each slot played last block, so gain changes ramp
+    std::array<DirectMonitorRoute, kMaxDirectMonitors> directMonitorApplied_{};
+    juce::AudioIODevice* directMonitorDevice_ = nullptr;  // Channels were resolved on it
+    std::vector<te::InputDevice*> directMonitorSilenced_;  // Graph monitoring turned off
+    void updateDirectMonitoring();
+    void mixDirectMonitoring(const float* const* inputChannelData, int numInputChannels,
+                             float* const* outputChannelData, int numOutputChannels,
+                             int numSamples) noexcept;
+
+    // Callback profiling (audio thread pushes, timerCallback() aggregates)
+    AudioCallbackTimingRing callbackTimings_;
+    juce::int64 audioLastCallbackTicks_ = 0;  // Audio thread only
+    juce::int64 callbackOverruns_ = 0;
+    std::array<juce::int64, AudioCallbackTiming::NumStages + 1> stageOverruns_{};
+    // Dropouts go to the log's ring (audio thread) and are collected in timerCallback();
+    // bound here so the audio thread never runs the singleton's construction
+    DropoutLog& dropoutLog_ = DropoutLog::getInstance();
+    // Registered here so the audio thread never takes the registration lock
+    const ProfilingCounters::Id paramChangesCounter_ =
+        ProfilingCounters::getInstance().registerCounter("ParamChanges");
+    const ProfilingCounters::Id audioCallbackCounter_ =
+        ProfilingCounters::getInstance().registerCounter("AudioBridgeCallback");
+    int audioSeenXruns_ = 0;  // Audio thread only
 
     // Master channel metering (lock-free atomics for thread safety)
     std::atomic<float> masterPeakL_{0.0f};
@@ -554,6 +1326,56 @@ class AudioBridge : public TrackManagerListener, public ClipManagerListener, pub
     // Engine wrapper (owns this AudioBridge, used for ClipInterface access)
     TracktionEngineWrapper* engineWrapper_ = nullptr;
 
+    /**
+     * @brief A device whose plugin is waiting to be instantiated
+     *
+     * Plugin instances are created by Tracktion's PluginCache, and VST3/AU instantiation
+     * must happen on the message thread, so loads can't move to worker threads. Instead they
+     * are spread over message-loop ticks: the UI keeps painting and handling input between
+     * plugins. Devices behind a queued one on the same track queue too, keeping chain order.
+     */
+    struct PendingPluginLoad {
+        TrackId trackId = INVALID_TRACK_ID;
+        DeviceId deviceId = INVALID_DEVICE_ID;
+    };
+    std::deque<PendingPluginLoad> pendingPluginLoads_;
+    std::unordered_set<DeviceId> loadingDevices_;
+    std::unordered_map<DeviceId, juce::ValueTree> clonedPluginStates_;  // By copy device
+
+    // One plugin host process per track, owned by the SandboxedPlugins using it
+    std::unordered_map<TrackId, std::weak_ptr<SandboxHost>> sandboxHosts_;
+
+    // Refilled only while no loads are queued, so it never delays a real insertion
+    PluginInstancePool pluginPool_{
+        [this](const juce::PluginDescription& description) {
+            return createExternalPluginInstance(description);
+        },
+        [this] { return pendingPluginLoads_.empty(); }};
+
+    /**
+     * @brief Instantiate an external plugin outside any track
+     * @return Nullptr if it couldn't be created or failed to initialise
+     */
+    te::Plugin::Ptr createExternalPluginInstance(const juce::PluginDescription& description);
+
+    // The KnownPluginList entry a device refers to, or one built from its fields
+    juce::PluginDescription findPluginDescription(const DeviceInfo& device) const;
+
+    // The description with the Tracktion uniqueId workaround applied (see the .cpp)
+    static juce::PluginDescription getMatchableDescription(
+        const juce::PluginDescription& description);
+
+    // Instantiation time per slice before yielding to the message loop
+    static constexpr double kPluginLoadSliceMs = 8.0;
+
+    // Deferred sync work (message thread), flushed by handleAsyncUpdate()
+    bool trackListDirty_ = false;  // Only deferred inside compound operations
+    bool clipListDirty_ = false;
+    std::unordered_set<ClipId> dirtyClips_;
+    std::unordered_set<TrackId> dirtyTracks_;
+    std::unordered_set<DeviceId> dirtyDevices_;
+    bool flushAfterCompound_ = false;  // Held back while an undo compound operation is open
+
     // Shutdown flag to prevent operations during cleanup
     std::atomic<bool> isShuttingDown_{false};
 
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace magda {
+
+/**
+ * @brief How long one audio callback took, split by stage
+ */
+struct AudioCallbackTiming {
+    enum Stage : uint8_t {
+        Parameters,  // Queued parameter changes and ramps
+        Modulation,  // Mod tree evaluation
+        Events,      // Transport, xrun and latency reporting
+        Automation,  // Automation lane playback
+        NumStages,
+        Engine = NumStages,  // Outside this callback: the engine render before it
+    };
+
+    // A callback that starts this much later than one buffer after the previous one means
+    // something ahead of it in the device cycle overran
+    static constexpr float kLateFactor = 1.5f;
+
+    std::array<float, NumStages> stageMs{};
+    float totalMs = 0.0f;     // Whole callback
+    float budgetMs = 0.0f;    // Buffer duration
+    float intervalMs = 0.0f;  // Since the previous callback started (0 for the first)
+
+    bool isLate() const {
+        return intervalMs > budgetMs * kLateFactor;
+    }
+
+    bool overran() const {
+        return budgetMs > 0.0f && (totalMs > budgetMs || isLate());
+    }
+
+    /**
+     * @brief The stage to blame for an overrun: the slowest stage of this callback, or
+     *        Engine if it arrived late without running long itself
+     */
+    Stage slowestStage() const {
+        if (isLate() && totalMs <= budgetMs) {
+            return Engine;
+        }
+        size_t slowest = 0;
+        for (size_t i = 1; i < stageMs.size(); ++i) {
+            if (stageMs[i] > stageMs[slowest]) {
+                slowest = i;
+            }
+        }
+        return static_cast<Stage>(slowest);
+    }
+
+    static const char* getStageName(Stage stage) {
+        switch (stage) {
+            case Parameters:
+                return "Parameters";
+            case Modulation:
+                return "Modulation";
+            case Events:
+                return "Events";
+            case Automation:
+                return "Automation";
+            default:
+                return "Engine";
+        }
+    }
+};
+
+/**
+ * @brief Wait-free SPSC ring of callback timings, audio thread to message thread
+ *
+ * The audio callback pushes one timing per block; the message thread drains them into
+ * PerformanceMonitor, which locks and hashes and so can't be called from the callback.
+ * A full ring drops the new timing and counts it.
+ */
+class AudioCallbackTimingRing {
+  public:
+    static constexpr size_t kSize = 512;  // Power of 2; ~5 s of 256-sample blocks at 48 kHz
+
+    bool push(const AudioCallbackTiming& timing) {
+        const size_t write = writeIndex_.load(std::memory_order_relaxed);
+        const size_t next = (write + 1) & (kSize - 1);
+        if (next == readIndex_.load(std::memory_order_acquire)) {
+            droppedCount_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        buffer_[write] = timing;
+        writeIndex_.store(next, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(AudioCallbackTiming& timing) {
+        const size_t read = readIndex_.load(std::memory_order_relaxed);
+        if (read == writeIndex_.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        timing = buffer_[read];
+        readIndex_.store((read + 1) & (kSize - 1), std::memory_order_release);
+        return true;
+    }
+
+    uint64_t getDroppedCount() const {
+        return droppedCount_.load(std::memory_order_relaxed);
+    }
+
+  private:
+    std::array<AudioCallbackTiming, kSize> buffer_{};
+    alignas(64) std::atomic<size_t> writeIndex_{0};
+    alignas(64) std::atomic<size_t> readIndex_{0};
+    std::atomic<uint64_t> droppedCount_{0};
+};
+
+}  // namespace magda
@@ -2,9 +2,11 @@
 
 #include <juce_core/juce_core.h>
 
+#include "../engine/TracktionEngineWrapper.hpp"
+
 namespace magda {
 
-AudioEngineOptimizer::AudioEngineOptimizer() {
+AudioEngineOptimizer::AudioEngineOptimizer(TracktionEngineWrapper& engine) : engine_(engine) {
     ViewModeController::getInstance().addListener(this);
 }
 
@@ -18,11 +20,11 @@ void AudioEngineOptimizer::viewModeChanged(const ViewMode mode, const AudioEngin
 }
 
 void AudioEngineOptimizer::applyProfile(const AudioEngineProfile& profile) {
-    // TODO: Apply profile to TracktionEngineWrapper
     DBG("Applying audio profile - Buffer: "
         << profile.bufferSize << " samples, Latency: " << profile.latencyMs
         << "ms, Low latency: " << (profile.lowLatencyMode ? "yes" : "no")
         << ", Multi-threaded: " << (profile.multiThreaded ? "yes" : "no"));
+    engine_.applyAudioProfile(profile);
 }
 
 }  // namespace magda
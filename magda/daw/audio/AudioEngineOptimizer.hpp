@@ -7,16 +7,18 @@
 
 namespace magda {
 
+class TracktionEngineWrapper;
+
 /**
  * @brief Bridge to apply audio profiles to the audio engine
  *
- * This class listens for view mode changes and applies the corresponding
- * audio engine optimization profile. Currently a stub for future
- * TracktionEngineWrapper integration.
+ * This class listens for view mode changes and hands the corresponding audio engine
+ * optimization profile to TracktionEngineWrapper, which applies it to the device and
+ * engine (deferred to the next stop if the transport is running).
  */
 class AudioEngineOptimizer final : public ViewModeListener {
   public:
-    AudioEngineOptimizer();
+    explicit AudioEngineOptimizer(TracktionEngineWrapper& engine);
     ~AudioEngineOptimizer() override;
 
     // ViewModeListener interface
@@ -28,6 +30,8 @@ class AudioEngineOptimizer final : public ViewModeListener {
     void applyProfile(const AudioEngineProfile& profile);
 
   private:
+    TracktionEngineWrapper& engine_;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AudioEngineOptimizer)
 };
 
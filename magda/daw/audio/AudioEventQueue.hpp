@@ -0,0 +1,236 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "../core/Subscription.hpp"
+#include "../core/TypeIds.hpp"
+
+namespace magda {
+
+/**
+ * @brief Something the audio or MIDI threads want the UI to know about
+ */
+struct AudioEvent {
+    enum class Type : uint8_t {
+        NoteOn,               // data1 = note number, data2 = velocity
+        NoteOff,              // data1 = note number, data2 = velocity
+        Controller,           // data1 = controller number, data2 = value
+        TransportStarted,     // First audio block after play
+        LoopWrapped,          // data1 = sample in the block the playhead wrapped on
+        Xrun,                 // data1 = xruns since the last report
+        MidiLatency,          // data1 = MIDI input to rendered output, in microseconds
+        MeterActivity,        // Meters above silence (dispatched by the bridge timer, not queued)
+        ClipLaunched,         // data1 = clip id, data2 = sample in the block it started on
+        ClipStopped,          // data1 = clip id, data2 = sample in the block it stopped on
+        RecordDropout,        // data1 = input frames lost because the disk fell behind
+        CountInFinished,      // data1 = sample in the block the count-in ended on
+        DeviceStatusChanged,  // data1 = device id, or INVALID_DEVICE_ID for several (not queued)
+    };
+    static constexpr size_t kNumTypes = 13;
+
+    Type type = Type::NoteOn;
+    TrackId trackId = INVALID_TRACK_ID;  // Track the event belongs to, if any
+    int data1 = 0;
+    int data2 = 0;
+};
+
+/**
+ * @brief Lock-free MPSC queue of events from the audio/MIDI threads to one consumer
+ *
+ * Any number of threads may push (the audio callback and each MIDI input thread); only one
+ * thread pops. A fixed ring of cells, each with a sequence number that tells producers
+ * whether it is free and the consumer whether it has been published, so push() is a
+ * single CAS on the write position and never blocks or allocates. When the consumer falls
+ * behind, new events are dropped and counted rather than stalling the producer.
+ */
+template <typename Event, size_t QueueSize>
+class MpscEventQueue {
+  public:
+    static constexpr size_t kQueueSize = QueueSize;
+    static_assert((kQueueSize & (kQueueSize - 1)) == 0, "Power of 2 for fast modulo");
+
+    MpscEventQueue() {
+        for (size_t i = 0; i < kQueueSize; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Queue an event (any thread)
+     * @return false if the queue was full and the event was dropped
+     */
+    bool push(const Event& event) {
+        size_t pos = writePos_.load(std::memory_order_relaxed);
+        for (;;) {
+            auto& cell = cells_[pos & (kQueueSize - 1)];
+            const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(sequence - pos);
+
+            if (diff == 0) {
+                // Cell is free for this lap; claim it
+                if (writePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.event = event;
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                // Consumer hasn't freed this cell yet: full
+                droppedCount_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            } else {
+                pos = writePos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Take the oldest published event (consumer thread only)
+     * @return false if nothing is waiting
+     */
+    bool pop(Event& event) {
+        auto& cell = cells_[readPos_ & (kQueueSize - 1)];
+        if (cell.sequence.load(std::memory_order_acquire) != readPos_ + 1) {
+            return false;  // Empty, or the next producer hasn't finished writing
+        }
+
+        event = cell.event;
+        cell.sequence.store(readPos_ + kQueueSize, std::memory_order_release);
+        ++readPos_;
+        return true;
+    }
+
+    /**
+     * @brief Events dropped because the queue was full
+     */
+    uint64_t getDroppedCount() const {
+        return droppedCount_.load(std::memory_order_relaxed);
+    }
+
+  private:
+    struct Cell {
+        std::atomic<size_t> sequence{0};
+        Event event;
+    };
+
+    std::array<Cell, kQueueSize> cells_;
+    alignas(64) std::atomic<size_t> writePos_{0};
+    alignas(64) size_t readPos_ = 0;  // Consumer only
+    std::atomic<uint64_t> droppedCount_{0};
+};
+
+/**
+ * @brief AudioEvents from the audio/MIDI threads to the message thread
+ */
+using AudioEventQueue = MpscEventQueue<AudioEvent, 1024>;
+
+/**
+ * @brief Routes drained AudioEvents to the UI components that asked for them
+ *
+ * Message thread only. Components subscribe per event type and keep the returned
+ * Subscription; it may outlive the dispatcher, and a handler may unsubscribe itself (or
+ * others) while being called.
+ */
+class AudioEventDispatcher {
+  public:
+    using Handler = std::function<void(const AudioEvent&)>;
+
+    AudioEventDispatcher() : state_(std::make_shared<State>()) {}
+
+    [[nodiscard]] Subscription subscribe(AudioEvent::Type type, Handler handler) {
+        const int id = state_->nextId++;
+        state_->handlers[static_cast<size_t>(type)].push_back({id, std::move(handler)});
+
+        std::weak_ptr<State> weak = state_;
+        return Subscription([weak, type, id]() {
+            if (auto state = weak.lock()) {
+                state->remove(type, id);
+            }
+        });
+    }
+
+    /**
+     * @brief Deliver every queued event to its subscribers
+     * @return How many events were taken from the queue
+     */
+    int drain(AudioEventQueue& queue) {
+        int count = 0;
+        AudioEvent event;
+        while (queue.pop(event)) {
+            ++count;
+            dispatch(event);
+        }
+        return count;
+    }
+
+    void dispatch(const AudioEvent& event) {
+        auto& handlers = state_->handlers[static_cast<size_t>(event.type)];
+        ++state_->dispatchDepth;
+        // Index loop with removals deferred; the copy keeps a handler alive even if it
+        // subscribes someone else and the vector reallocates under it
+        for (size_t i = 0; i < handlers.size(); ++i) {
+            if (auto handler = handlers[i].handler) {
+                handler(event);
+            }
+        }
+        if (--state_->dispatchDepth == 0 && state_->needsCompact) {
+            state_->compact();
+        }
+    }
+
+    bool hasSubscribers(AudioEvent::Type type) const {
+        for (const auto& entry : state_->handlers[static_cast<size_t>(type)]) {
+            if (entry.handler) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+  private:
+    struct Entry {
+        int id = 0;
+        Handler handler;
+    };
+
+    struct State {
+        std::array<std::vector<Entry>, AudioEvent::kNumTypes> handlers;
+        int nextId = 1;
+        int dispatchDepth = 0;
+        bool needsCompact = false;
+
+        void remove(AudioEvent::Type type, int id) {
+            auto& list = handlers[static_cast<size_t>(type)];
+            for (auto& entry : list) {
+                if (entry.id == id) {
+                    entry.handler = nullptr;
+                }
+            }
+            if (dispatchDepth > 0) {
+                needsCompact = true;
+            } else {
+                compactList(list);
+            }
+        }
+
+        void compact() {
+            for (auto& list : handlers) {
+                compactList(list);
+            }
+            needsCompact = false;
+        }
+
+        static void compactList(std::vector<Entry>& list) {
+            std::erase_if(list, [](const Entry& entry) { return !entry.handler; });
+        }
+    };
+
+    std::shared_ptr<State> state_;
+};
+
+}  // namespace magda
@@ -0,0 +1,396 @@
+#include "AudioFileImporter.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "AudioThumbnailManager.hpp"
+#include "TempoCache.hpp"
+
+namespace magda {
+
+namespace {
+
+// Formats the engine can memory-map and play without decoding
+bool isUncompressed(const juce::File& file) {
+    return file.hasFileExtension("wav;aiff;aif");
+}
+
+void shiftDown(juce::AudioBuffer<float>& buffer, int by, int count) {
+    for (int ch = 0; ch < buffer.getNumChannels(); ++ch) {
+        auto* data = buffer.getWritePointer(ch);
+        std::memmove(data, data + by, static_cast<size_t>(count) * sizeof(float));
+    }
+}
+
+/**
+ * @brief Pulls a reader's audio through one sinc interpolator per channel, block by block
+ *
+ * Produces exactly the source's length at the target rate, lined up with the source: the
+ * interpolators' latency is produced and dropped at the start, and silence is fed past the
+ * end to bring out their tail.
+ */
+class Resampler {
+  public:
+    Resampler(juce::AudioFormatReader& reader, double targetRate)
+        : reader_(reader),
+          ratio_(reader.sampleRate / targetRate),
+          interpolators_(static_cast<size_t>(reader.numChannels)),
+          input_(static_cast<int>(reader.numChannels), AudioFileImporter::kBlockFrames * 2) {
+        skip_ = static_cast<int>(
+            std::lround(juce::WindowedSincInterpolator::getBaseLatency() / ratio_));
+        remaining_ = static_cast<juce::int64>(
+            std::llround(static_cast<double>(reader.lengthInSamples) / ratio_));
+    }
+
+    /**
+     * @brief Fill the start of output; returns the frames written, 0 at the end
+     */
+    int read(juce::AudioBuffer<float>& output) {
+        while (remaining_ > 0) {
+            fillInput();
+
+            // A frame spare, so no interpolator reads past what is buffered
+            const auto wanted = static_cast<int>(std::min<juce::int64>(
+                {static_cast<juce::int64>((available_ - 1) / ratio_), output.getNumSamples(),
+                 remaining_ + skip_}));
+
+            int consumed = 0;
+            for (size_t ch = 0; ch < interpolators_.size(); ++ch) {
+                const int channel = static_cast<int>(ch);
+                consumed = interpolators_[ch].process(ratio_, input_.getReadPointer(channel),
+                                                      output.getWritePointer(channel), wanted,
+                                                      available_, 0);
+            }
+            consumed = std::min(consumed, available_);
+            available_ -= consumed;
+            shiftDown(input_, consumed, available_);
+
+            int produced = wanted;
+            if (skip_ > 0) {
+                const int dropped = std::min(skip_, produced);
+                skip_ -= dropped;
+                produced -= dropped;
+                shiftDown(output, dropped, produced);
+            }
+            produced = static_cast<int>(std::min<juce::int64>(produced, remaining_));
+            remaining_ -= produced;
+            if (produced > 0) {
+                return produced;
+            }
+        }
+        return 0;
+    }
+
+  private:
+    void fillInput() {
+        const int space = input_.getNumSamples() - available_;
+        const auto count = static_cast<int>(
+            std::min<juce::int64>(space, reader_.lengthInSamples - readPosition_));
+        if (count > 0) {
+            reader_.read(&input_, available_, count, readPosition_, true, true);
+            readPosition_ += count;
+            available_ += count;
+        }
+        if (readPosition_ >= reader_.lengthInSamples && available_ < input_.getNumSamples()) {
+            input_.clear(available_, input_.getNumSamples() - available_);
+            available_ = input_.getNumSamples();
+        }
+    }
+
+    juce::AudioFormatReader& reader_;
+    const double ratio_;  // Source frames per output frame
+    std::vector<juce::WindowedSincInterpolator> interpolators_;
+    juce::AudioBuffer<float> input_;
+    int available_ = 0;
+    juce::int64 readPosition_ = 0;
+    juce::int64 remaining_ = 0;  // Output frames still to hand out
+    int skip_ = 0;               // Latency frames still to drop
+};
+
+}  // namespace
+
+// =============================================================================
+// ImportJob
+// =============================================================================
+
+/**
+ * @brief Prepares one file of a batch on a pool thread
+ */
+class AudioFileImporter::ImportJob : public juce::ThreadPoolJob {
+  public:
+    ImportJob(juce::AudioFormatManager& formatManager, const juce::File& source,
+              const juce::File& folder, const Format& format, int batchId, size_t index,
+              std::shared_ptr<std::atomic<bool>> alive)
+        : juce::ThreadPoolJob("Import audio"),
+          formatManager_(formatManager),
+          source_(source),
+          folder_(folder),
+          format_(format),
+          batchId_(batchId),
+          index_(index),
+          alive_(std::move(alive)) {}
+
+    JobStatus runJob() override {
+        auto result =
+            importFile(formatManager_, source_, folder_, format_, [this] { return shouldExit(); });
+        if (shouldExit()) {
+            return jobHasFinished;
+        }
+
+        auto alive = alive_;
+        auto batchId = batchId_;
+        auto index = index_;
+        juce::MessageManager::callAsync([alive, batchId, index, result]() {
+            if (alive->load()) {
+                AudioFileImporter::getInstance().fileImported(batchId, index, result);
+            }
+        });
+        return jobHasFinished;
+    }
+
+  private:
+    juce::AudioFormatManager& formatManager_;
+    juce::File source_;
+    juce::File folder_;
+    Format format_;
+    int batchId_;
+    size_t index_;
+    std::shared_ptr<std::atomic<bool>> alive_;
+};
+
+// =============================================================================
+// AudioFileImporter
+// =============================================================================
+
+AudioFileImporter::AudioFileImporter() {
+    formatManager_.registerBasicFormats();
+
+    // Decoding and resampling are CPU-bound; leave cores for the audio and message threads
+    pool_ =
+        std::make_unique<juce::ThreadPool>(juce::jlimit(1, 4, juce::SystemStats::getNumCpus() / 2));
+}
+
+AudioFileImporter& AudioFileImporter::getInstance() {
+    static AudioFileImporter instance;
+    return instance;
+}
+
+AudioFileImporter::Format AudioFileImporter::getSessionFormat() const {
+    Format format;
+    format.sampleRate = sessionSampleRate_.load(std::memory_order_relaxed);
+    return format;
+}
+
+bool AudioFileImporter::isSupportedFile(const juce::File& file) {
+    return file.hasFileExtension("wav;aiff;aif;mp3;ogg;flac");
+}
+
+void AudioFileImporter::importFiles(const juce::Array<juce::File>& files,
+                                    const juce::File& folder, Callback onDone) {
+    if (!pool_ || files.isEmpty()) {
+        return;
+    }
+
+    const int batchId = ++nextBatchId_;
+    auto& batch = batches_[batchId];
+    batch.results.resize(static_cast<size_t>(files.size()));
+    batch.remaining = files.size();
+    batch.onDone = std::move(onDone);
+    total_ += files.size();
+
+    const auto format = getSessionFormat();
+    for (int i = 0; i < files.size(); ++i) {
+        pool_->addJob(new ImportJob(formatManager_, files[i], folder, format, batchId,
+                                    static_cast<size_t>(i), alive_),
+                      true);
+    }
+}
+
+void AudioFileImporter::fileImported(int batchId, size_t index, Result result) {
+    auto it = batches_.find(batchId);
+    if (it == batches_.end()) {
+        return;
+    }
+
+    const auto fileName = result.source.getFileName();
+    auto& batch = it->second;
+    batch.results[index] = std::move(result);
+    --batch.remaining;
+    ++completed_;
+
+    Progress progress{completed_, total_, fileName};
+
+    Batch finished;
+    if (batch.remaining == 0) {
+        finished = std::move(batch);
+        batches_.erase(it);
+    }
+    // Counts restart once nothing is running
+    if (batches_.empty()) {
+        completed_ = 0;
+        total_ = 0;
+        progress.total = 0;
+    }
+
+    if (onProgress) {
+        onProgress(progress);
+    }
+    if (finished.onDone) {
+        finished.onDone(finished.results);
+    }
+}
+
+AudioFileImporter::Result AudioFileImporter::importFile(juce::AudioFormatManager& formatManager,
+                                                        const juce::File& source,
+                                                        const juce::File& folder,
+                                                        const Format& format,
+                                                        const std::function<bool()>& shouldExit) {
+    auto cancelled = [&shouldExit] { return shouldExit && shouldExit(); };
+
+    Result result;
+    result.source = source;
+    result.file = source;
+
+    std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(source));
+    if (reader == nullptr || reader->numChannels == 0 || reader->sampleRate <= 0.0) {
+        result.failed = true;
+        return result;
+    }
+
+    const int numChannels = static_cast<int>(reader->numChannels);
+    const double targetRate = format.sampleRate > 0.0 ? format.sampleRate : reader->sampleRate;
+    const bool resample = std::abs(reader->sampleRate - targetRate) > 0.5;
+    result.converted = resample || !isUncompressed(source);
+    result.lengthSeconds = static_cast<double>(reader->lengthInSamples) / reader->sampleRate;
+
+    auto pyramid = std::make_shared<PeakPyramid>();
+    pyramid->begin(numChannels, targetRate);
+    TempoAnalyser tempo;
+    tempo.begin(numChannels, targetRate);
+    juce::AudioBuffer<float> buffer(numChannels, kBlockFrames);
+
+    // Already playable as it is: only the peaks and tempo are wanted, and maybe not even those
+    if (!result.converted) {
+        const bool wantPeaks = !AudioThumbnailManager::hasPeaks(source);
+        if (!wantPeaks && TempoCache::hasTempo(source)) {
+            return result;
+        }
+        for (juce::int64 pos = 0; pos < reader->lengthInSamples; pos += kBlockFrames) {
+            if (cancelled()) {
+                return result;
+            }
+            const auto count = static_cast<int>(
+                std::min<juce::int64>(kBlockFrames, reader->lengthInSamples - pos));
+            reader->read(&buffer, 0, count, pos, true, true);
+            if (wantPeaks) {
+                pyramid->addSamples(buffer.getArrayOfReadPointers(), count);
+            }
+            tempo.addSamples(buffer.getArrayOfReadPointers(), count);
+        }
+        auto analysis = std::make_shared<TempoAnalysis>(tempo.finish());
+        TempoCache::saveTempo(source, *analysis);
+        result.tempo = std::move(analysis);
+        if (wantPeaks) {
+            pyramid->finish();
+            AudioThumbnailManager::savePeaks(source, *pyramid);
+            result.peaks = std::move(pyramid);
+        }
+        return result;
+    }
+
+    // Named after the source, with the rate if that changed
+    auto name = source.getFileNameWithoutExtension();
+    if (resample) {
+        name << " " << juce::roundToInt(targetRate);
+    }
+    if (folder.createDirectory().failed()) {
+        result.failed = true;
+        return result;
+    }
+    const auto output = folder.getNonexistentChildFile(name, ".wav", false);
+
+    auto stream = output.createOutputStream();
+    if (stream == nullptr) {
+        result.failed = true;
+        return result;
+    }
+    juce::WavAudioFormat wav;
+    std::unique_ptr<juce::AudioFormatWriter> writer(
+        wav.createWriterFor(stream.get(), targetRate, static_cast<unsigned int>(numChannels),
+                            format.bitsPerSample, {}, 0));
+    if (writer == nullptr) {
+        stream.reset();
+        output.deleteFile();
+        result.failed = true;
+        return result;
+    }
+    stream.release();  // Owned by the writer now
+
+    auto abandon = [&] {
+        writer.reset();
+        output.deleteFile();
+        result.file = source;
+        result.converted = false;
+        return result;
+    };
+
+    juce::int64 written = 0;
+    if (resample) {
+        Resampler resampler(*reader, targetRate);
+        while (const int count = resampler.read(buffer)) {
+            if (cancelled()) {
+                return abandon();
+            }
+            if (!writer->writeFromAudioSampleBuffer(buffer, 0, count)) {
+                abandon();
+                result.failed = true;
+                return result;
+            }
+            pyramid->addSamples(buffer.getArrayOfReadPointers(), count);
+            tempo.addSamples(buffer.getArrayOfReadPointers(), count);
+            written += count;
+        }
+    } else {
+        for (juce::int64 pos = 0; pos < reader->lengthInSamples; pos += kBlockFrames) {
+            if (cancelled()) {
+                return abandon();
+            }
+            const auto count = static_cast<int>(
+                std::min<juce::int64>(kBlockFrames, reader->lengthInSamples - pos));
+            reader->read(&buffer, 0, count, pos, true, true);
+            if (!writer->writeFromAudioSampleBuffer(buffer, 0, count)) {
+                abandon();
+                result.failed = true;
+                return result;
+            }
+            pyramid->addSamples(buffer.getArrayOfReadPointers(), count);
+            tempo.addSamples(buffer.getArrayOfReadPointers(), count);
+            written += count;
+        }
+    }
+    writer.reset();  // Closes the file, so its peak key is final
+
+    pyramid->finish();
+    AudioThumbnailManager::savePeaks(output, *pyramid);
+    auto analysis = std::make_shared<TempoAnalysis>(tempo.finish());
+    TempoCache::saveTempo(output, *analysis);
+    result.file = output;
+    result.lengthSeconds = static_cast<double>(written) / targetRate;
+    result.peaks = std::move(pyramid);
+    result.tempo = std::move(analysis);
+    return result;
+}
+
+void AudioFileImporter::shutdown() {
+    alive_->store(false);
+    if (pool_) {
+        pool_->removeAllJobs(true, 2000);
+        pool_.reset();
+    }
+    batches_.clear();
+    completed_ = 0;
+    total_ = 0;
+}
+
+}  // namespace magda
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_events/juce_events.h>
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "PeakPyramid.hpp"
+#include "TempoAnalysis.hpp"
+
+namespace magda {
+
+/**
+ * @brief Prepares dropped audio files for playback on a pool of background threads
+ *
+ * Each file is read once on a pool thread. A file at a different sample rate from the
+ * session is resampled (windowed sinc) and written as a WAV at the session's rate and bit
+ * depth, so the engine doesn't resample it while playing; compressed files (MP3, Ogg,
+ * FLAC) are decoded to WAV the same way so playback doesn't decode them. The file's peak
+ * pyramid and tempo analysis are built from the same pass and stored with
+ * AudioThumbnailManager and TempoCache, so the new clips draw their waveforms and can be
+ * matched to the project tempo straight away. WAV and AIFF files already at the session
+ * rate are used in place and only read for their peaks and tempo (if they have none yet).
+ *
+ * Files of a batch are prepared in parallel and handed back together, in the order given,
+ * so the caller can create all the clips in one undoable step. onProgress reports each
+ * finished file, across all running batches.
+ *
+ * Message thread only, apart from the pool's threads.
+ */
+class AudioFileImporter {
+  public:
+    static AudioFileImporter& getInstance();
+
+    /**
+     * @brief Target format for converted files
+     */
+    struct Format {
+        double sampleRate = 0.0;  // 0 keeps each file's own rate
+        int bitsPerSample = 24;
+    };
+
+    /**
+     * @brief One prepared file
+     */
+    struct Result {
+        juce::File source;
+        juce::File file;  // What the clip should play: the source or its converted copy
+        double lengthSeconds = 0.0;
+        bool converted = false;
+        bool failed = false;  // Unreadable, or the converted copy couldn't be written
+        std::shared_ptr<const PeakPyramid> peaks;    // Null if the file already had peaks
+        std::shared_ptr<const TempoAnalysis> tempo;  // Null if it was already analysed
+    };
+
+    struct Progress {
+        int completed = 0;  // Files finished, across running batches
+        int total = 0;
+        juce::String fileName;  // The file that just finished
+    };
+
+    using Callback = std::function<void(const std::vector<Result>& results)>;
+
+    /**
+     * @brief Prepare files in the background
+     * @param folder Where converted copies are written (created if needed)
+     * @param onDone Called on the message thread once every file is done, unless shut down
+     */
+    void importFiles(const juce::Array<juce::File>& files, const juce::File& folder,
+                     Callback onDone);
+
+    bool isImporting() const {
+        return !batches_.empty();
+    }
+
+    /**
+     * @brief Called on the message thread as files finish; total is 0 once all are done
+     */
+    std::function<void(const Progress&)> onProgress;
+
+    /**
+     * @brief The session's rate, from the audio device (any thread)
+     */
+    void setSessionSampleRate(double sampleRate) {
+        sessionSampleRate_.store(sampleRate, std::memory_order_relaxed);
+    }
+
+    Format getSessionFormat() const;
+
+    /**
+     * @brief Whether a file has an extension the importer reads
+     */
+    static bool isSupportedFile(const juce::File& file);
+
+    /**
+     * @brief Prepare one file on the calling thread (what each pool job runs)
+     * @param shouldExit Polled between blocks; a cancelled conversion leaves no file
+     */
+    static Result importFile(juce::AudioFormatManager& formatManager, const juce::File& source,
+                             const juce::File& folder, const Format& format,
+                             const std::function<bool()>& shouldExit = nullptr);
+
+    /**
+     * @brief Cancel running imports (their callbacks are dropped) and stop the pool
+     */
+    void shutdown();
+
+    static constexpr int kBlockFrames = 65536;
+
+  private:
+    AudioFileImporter();
+    ~AudioFileImporter() = default;
+
+    class ImportJob;
+
+    struct Batch {
+        std::vector<Result> results;
+        int remaining = 0;
+        Callback onDone;
+    };
+
+    void fileImported(int batchId, size_t index, Result result);
+
+    juce::AudioFormatManager formatManager_;
+    std::unique_ptr<juce::ThreadPool> pool_;
+    std::map<int, Batch> batches_;
+    int nextBatchId_ = 0;
+    int completed_ = 0;  // Files finished in the running batches
+    int total_ = 0;
+    std::atomic<double> sessionSampleRate_{0.0};
+
+    // Validity flag for async callbacks - set to false in shutdown()
+    std::shared_ptr<std::atomic<bool>> alive_ = std::make_shared<std::atomic<bool>>(true);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AudioFileImporter)
+};
+
+}  // namespace magda
@@ -0,0 +1,751 @@
+#include "AudioModulator.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <tuple>
+
+#include "../core/ModulatorEngine.hpp"
+#include "../core/TrackManager.hpp"
+#include "ParameterModifiers.hpp"
+
+namespace magda {
+
+namespace {
+
+// Device input channels measured per source (a track records one stereo pair at most)
+constexpr int kMaxSourceChannels = 8;
+
+/**
+ * @brief Whether a note matching a mod's filter is set (channel 0 and note -1 match any)
+ * @param words Two words per channel, one bit per note
+ */
+bool matchesNote(const uint64_t* words, int channel, int note) {
+    const bool oneChannel = channel >= 1 && channel <= 16;
+    const int first = oneChannel ? channel - 1 : 0;
+    const int end = oneChannel ? channel : 16;
+    for (int ch = first; ch < end; ++ch) {
+        const uint64_t* notes = words + ch * 2;
+        if (note < 0 || note > 127) {
+            if ((notes[0] | notes[1]) != 0) {
+                return true;
+            }
+        } else if (((notes[note / 64] >> (note % 64)) & 1u) != 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}  // namespace
+
+// =============================================================================
+// Message thread
+// =============================================================================
+
+void AudioModulator::compile(const TrackManager& trackManager, const Resolver& resolver,
+                             const InputResolver& inputResolver) {
+    auto plan = std::make_unique<Plan>();
+    const auto* previous = plan_.getPublished();
+
+    // Carry phases, outputs and modifier sources over from the previous plan
+    std::map<std::tuple<ModOwner, int, int>, float> previousPhases;
+    std::map<std::tuple<ModOwner, int, int>, float> previousValues;
+    std::map<std::pair<DeviceId, int>, size_t> previousTargets;
+    if (previous) {
+        for (size_t i = 0; i < previous->getNumMods(); ++i) {
+            const auto key = std::make_tuple(previous->owners[i], previous->ownerIds[i],
+                                             previous->modIndices[i]);
+            previousPhases[key] = previous->displayPhases[i].load();
+            previousValues[key] = previous->values[i].load();
+        }
+        for (size_t i = 0; i < previous->targetDevices.size(); ++i) {
+            previousTargets[{previous->targetDevices[i], previous->targetParams[i]}] = i;
+        }
+    }
+
+    std::map<std::pair<DeviceId, int>, int> targetIndices;
+    std::map<std::tuple<TrackId, TrackId, bool>, int> sourceIndices;
+    std::vector<float> phases;
+    std::vector<float> levels;
+
+    auto findOrAddTarget = [&](const ModTarget& modTarget) -> int {
+        auto key = std::make_pair(modTarget.deviceId, modTarget.paramIndex);
+        auto it = targetIndices.find(key);
+        if (it != targetIndices.end()) {
+            return it->second;
+        }
+
+        ResolvedTarget resolved;
+        if (!resolver(modTarget.deviceId, modTarget.paramIndex, resolved) ||
+            resolved.parameter == nullptr || resolved.plugin == nullptr) {
+            return -1;
+        }
+
+        // The same parameter keeps its source; a new or reloaded one is given one
+        te::AutomatableParameter::Ptr source;
+        auto prev = previousTargets.find(key);
+        if (prev != previousTargets.end() &&
+            previous->targetParameters[prev->second] == resolved.parameter) {
+            source = previous->targetSources[prev->second];
+        } else {
+            source = ParameterModifiers::attach(*resolved.plugin, *resolved.parameter);
+        }
+        if (source == nullptr) {
+            return -1;
+        }
+
+        plan->targetDevices.push_back(modTarget.deviceId);
+        plan->targetParams.push_back(modTarget.paramIndex);
+        plan->targetParameters.push_back(resolved.parameter);
+        plan->targetSources.push_back(std::move(source));
+        plan->plugins.push_back(std::move(resolved.plugin));
+        const int index = static_cast<int>(plan->targetDevices.size()) - 1;
+        targetIndices.emplace(key, index);
+        return index;
+    };
+
+    auto findOrAddSource = [&](TrackId trackId, TrackId sidechain, bool usesAudio) -> int {
+        if (!usesAudio) {
+            sidechain = INVALID_TRACK_ID;
+        }
+        const auto key = std::make_tuple(trackId, sidechain, usesAudio);
+        auto it = sourceIndices.find(key);
+        if (it != sourceIndices.end()) {
+            return it->second;
+        }
+
+        const int index = static_cast<int>(plan->sourceTracks.size());
+        plan->sourceTracks.push_back(trackId);
+        plan->sourceSidechains.push_back(sidechain);
+        plan->sourceUsesAudio.push_back(usesAudio ? 1 : 0);
+        plan->sourceChannelBegin.push_back(static_cast<int>(plan->sourceChannels.size()));
+        if (usesAudio && sidechain == INVALID_TRACK_ID && inputResolver) {
+            const auto channels = inputResolver(trackId);
+            plan->sourceChannels.insert(plan->sourceChannels.end(), channels.begin(),
+                                        channels.end());
+        }
+        sourceIndices.emplace(key, index);
+        return index;
+    };
+
+    trackManager.forEachTrackMod([&](TrackId trackId, ModOwner owner, int ownerId, int modIndex,
+                                     const ModInfo& info) {
+        uint8_t flags = 0;
+        if (info.enabled) {
+            flags |= Plan::kEnabled;
+        }
+        if (info.type == ModType::LFO) {
+            flags |= Plan::kLFO;
+        }
+        if (info.tempoSync) {
+            flags |= Plan::kTempoSync;
+        }
+        if (info.waveform == LFOWaveform::Custom) {
+            flags |= Plan::kCurveTable;
+        }
+        if (runsAtControlRate(info)) {
+            flags |= Plan::kControlRate;
+        }
+
+        plan->flags.push_back(flags);
+        plan->rates.push_back(info.rate);
+        // Sync rates scale linearly with tempo, so store the rate at 60 BPM (one beat/s)
+        plan->syncFactors.push_back(ModulatorEngine::calculateSyncRateHz(info.syncDivision, 60.0));
+        plan->phaseOffsets.push_back(info.phaseOffset);
+        plan->waveforms.push_back(info.waveform);
+        plan->triggerModes.push_back(info.triggerMode);
+        plan->heldValues.push_back(info.enabled ? info.value : 0.0f);
+
+        plan->types.push_back(info.type);
+        plan->attacks.push_back(info.attack);
+        plan->decays.push_back(info.decay);
+        plan->sustains.push_back(info.sustain);
+        plan->releases.push_back(info.release);
+        plan->smoothings.push_back(info.smoothing);
+        plan->midiChannels.push_back(info.midiChannel);
+        plan->midiNotes.push_back(info.midiNote);
+        plan->followerDetectors.push_back(info.followerDetector);
+        // Envelopes play their track's notes and followers follow audio; LFOs and random
+        // mods only listen when a note or an onset triggers them
+        const bool usesNotes =
+            info.type == ModType::Envelope || info.triggerMode == LFOTriggerMode::MIDI;
+        const bool usesAudio =
+            info.type == ModType::Follower || info.triggerMode == LFOTriggerMode::Audio;
+        plan->modSources.push_back(usesNotes || usesAudio
+                                       ? findOrAddSource(trackId, info.sidechainTrack, usesAudio)
+                                       : -1);
+
+        plan->linkBegin.push_back(static_cast<int>(plan->linkTargets.size()));
+        for (const auto& link : info.links) {
+            if (!link.isValid()) {
+                continue;
+            }
+            int target = findOrAddTarget(link.target);
+            if (target >= 0) {
+                plan->linkTargets.push_back(target);
+                plan->linkAmounts.push_back(link.amount);
+            }
+        }
+
+        // Custom curves are baked here; edits to the points make readBack() request a
+        // recompile, which re-bakes them
+        if (info.waveform == LFOWaveform::Custom) {
+            const size_t offset = plan->curveTables.size();
+            plan->curveTableOffsets.push_back(static_cast<int>(offset));
+            plan->curveTables.resize(offset + ModulatorEngine::kCurveTableSize + 1);
+            ModulatorEngine::bakeCurveTable(info, plan->curveTables.data() + offset);
+        } else {
+            plan->curveTableOffsets.push_back(-1);
+        }
+
+        plan->owners.push_back(owner);
+        plan->ownerIds.push_back(ownerId);
+        plan->modIndices.push_back(modIndex);
+        plan->sidechainTracks.push_back(info.sidechainTrack);
+        plan->syncDivisions.push_back(info.syncDivision);
+        plan->curvePresets.push_back(info.curvePreset);
+        plan->resolutions.push_back(info.resolution);
+        plan->curveBegin.push_back(static_cast<int>(plan->curvePoints.size()));
+        plan->curvePoints.insert(plan->curvePoints.end(), info.curvePoints.begin(),
+                                 info.curvePoints.end());
+        plan->sourceLinkBegin.push_back(static_cast<int>(plan->sourceLinks.size()));
+        plan->sourceLinks.insert(plan->sourceLinks.end(), info.links.begin(), info.links.end());
+
+        auto phase = previousPhases.find({owner, ownerId, modIndex});
+        phases.push_back(phase != previousPhases.end() ? phase->second : info.phase);
+        auto value = previousValues.find({owner, ownerId, modIndex});
+        levels.push_back(value != previousValues.end() ? value->second : info.value);
+    });
+
+    // Macros with links; the rest have nothing to drive
+    std::vector<float> macroValues;
+    trackManager.forEachTrackMacro([&](TrackId, ModOwner owner, int ownerId, int macroIndex,
+                                       const MacroInfo& macro) {
+        if (macro.links.empty()) {
+            return;
+        }
+
+        plan->macroSlots.emplace(std::make_tuple(owner, ownerId, macroIndex),
+                                 macroValues.size());
+        plan->macroLinkBegin.push_back(static_cast<int>(plan->macroLinkTargets.size()));
+        for (const auto& link : macro.links) {
+            if (!link.target.isValid()) {
+                continue;
+            }
+            int target = findOrAddTarget(ModTarget{link.target.deviceId, link.target.paramIndex});
+            if (target >= 0) {
+                plan->macroLinkTargets.push_back(target);
+                plan->macroLinkAmounts.push_back(link.amount);
+                plan->macroLinkRangeStarts.push_back(link.rangeStart);
+                plan->macroLinkRangeEnds.push_back(link.rangeEnd);
+                plan->macroLinkCurves.push_back(link.curve);
+            }
+        }
+
+        plan->macroOwners.push_back(owner);
+        plan->macroOwnerIds.push_back(ownerId);
+        plan->macroIndices.push_back(macroIndex);
+        plan->sourceMacroLinkBegin.push_back(static_cast<int>(plan->sourceMacroLinks.size()));
+        plan->sourceMacroLinks.insert(plan->sourceMacroLinks.end(), macro.links.begin(),
+                                      macro.links.end());
+        macroValues.push_back(macro.value);
+    });
+
+    // Close the CSR ranges
+    plan->sourceChannelBegin.push_back(static_cast<int>(plan->sourceChannels.size()));
+    plan->linkBegin.push_back(static_cast<int>(plan->linkTargets.size()));
+    plan->curveBegin.push_back(static_cast<int>(plan->curvePoints.size()));
+    plan->sourceLinkBegin.push_back(static_cast<int>(plan->sourceLinks.size()));
+    plan->macroLinkBegin.push_back(static_cast<int>(plan->macroLinkTargets.size()));
+    plan->sourceMacroLinkBegin.push_back(static_cast<int>(plan->sourceMacroLinks.size()));
+
+    // Targets that lost all their links, or whose parameter went, give up their source;
+    // the old plan may write to it until it is retired, which no longer reaches anything
+    if (previous) {
+        for (size_t i = 0; i < previous->targetDevices.size(); ++i) {
+            auto kept = targetIndices.find({previous->targetDevices[i], previous->targetParams[i]});
+            if (kept != targetIndices.end() &&
+                plan->targetParameters[static_cast<size_t>(kept->second)] ==
+                    previous->targetParameters[i]) {
+                continue;
+            }
+            ParameterModifiers::detach(*previous->plugins[i], *previous->targetParameters[i]);
+        }
+    }
+
+    const size_t numMods = plan->getNumMods();
+    plan->phases = std::make_unique<float[]>(numMods);
+    plan->values = std::make_unique<std::atomic<float>[]>(numMods);
+    plan->displayPhases = std::make_unique<std::atomic<float>[]>(numMods);
+    plan->triggered = std::make_unique<std::atomic<bool>[]>(numMods);
+    for (size_t i = 0; i < numMods; ++i) {
+        plan->phases[i] = phases[i];
+        plan->displayPhases[i].store(phases[i]);
+        plan->values[i].store(plan->heldValues[i]);
+        plan->triggered[i].store(false);
+    }
+
+    plan->macroValues = std::make_unique<std::atomic<float>[]>(macroValues.size());
+    for (size_t i = 0; i < macroValues.size(); ++i) {
+        plan->macroValues[i].store(macroValues[i]);
+    }
+
+    const size_t numTargets = plan->targetDevices.size();
+    plan->targetApplied.resize(numTargets, -1.0f);
+    plan->modulation.resize(numTargets, 0.0f);
+    plan->effectivePhases.resize(numMods, 0.0f);
+    plan->outputs.resize(numMods, 0.0f);
+
+    // Generators pick up from their last output: an envelope that was sounding decays to
+    // its sustain (or releases, if the note has gone), a random mod glides on from there
+    plan->levels = levels;
+    plan->randomFrom = levels;
+    plan->randomTo = levels;
+    plan->envelopeStages.resize(numMods);
+    plan->randomSeeds.resize(numMods);
+    plan->owedTimes.resize(numMods, 0.0f);
+    plan->controlElapsed = kControlSeconds;  // Control-rate mods start on the first block
+    for (size_t i = 0; i < numMods; ++i) {
+        const auto stage = levels[i] > 0.0f ? ModulatorEngine::EnvelopeStage::Decay
+                                             : ModulatorEngine::EnvelopeStage::Idle;
+        plan->envelopeStages[i] = static_cast<uint8_t>(stage);
+        // Distinct, non-zero and stable per mod
+        plan->randomSeeds[i] = (static_cast<uint32_t>(plan->ownerIds[i]) * 73856093u ^
+                                static_cast<uint32_t>(plan->modIndices[i]) * 19349663u) |
+                               1u;
+    }
+
+    const size_t numSources = plan->sourceTracks.size();
+    plan->sourceDetectors.resize(numSources);
+    plan->sourceOnsetsSeen.resize(numSources, 0);
+    plan->sourceHeld.resize(numSources * kNoteWords, 0);
+    plan->sourceStarted.resize(numSources * kNoteWords, 0);
+    plan->sourceReadings.resize(numSources);
+
+    // Measure exactly the tracks that are followed; onsets from before now don't count
+    std::vector<bool> followed(static_cast<size_t>(SidechainBus::kMaxTracks), false);
+    for (size_t s = 0; s < numSources; ++s) {
+        const TrackId sidechain = plan->sourceSidechains[s];
+        if (sidechain >= 0 && sidechain < SidechainBus::kMaxTracks) {
+            followed[static_cast<size_t>(sidechain)] = true;
+            sidechain_.read(sidechain, plan->sourceOnsetsSeen[s]);
+        }
+    }
+    for (int trackId = 0; trackId < SidechainBus::kMaxTracks; ++trackId) {
+        sidechain_.setListening(trackId, followed[static_cast<size_t>(trackId)]);
+    }
+
+    plan_.publish(std::move(plan));
+}
+
+bool AudioModulator::runsAtControlRate(const ModInfo& info) {
+    switch (info.resolution) {
+        case ModResolution::Control:
+            return true;
+        case ModResolution::Block:
+            return false;
+        case ModResolution::Auto:
+            break;
+    }
+
+    // Envelopes and followers chase notes and hits; they need every block
+    if (info.type != ModType::LFO && info.type != ModType::Random) {
+        return false;
+    }
+    const float rate = info.tempoSync
+                           ? ModulatorEngine::calculateSyncRateHz(info.syncDivision, 120.0)
+                           : info.rate;
+    return rate <= kControlMaxHz;
+}
+
+void AudioModulator::addTrack(TrackId trackId) {
+    notes_.assign(trackId);
+}
+
+void AudioModulator::removeTrack(TrackId trackId) {
+    notes_.release(trackId);
+}
+
+void AudioModulator::setMacroValue(ModOwner owner, int ownerId, int macroIndex, float value) {
+    auto* plan = plan_.getPublished();
+    if (!plan) {
+        return;
+    }
+
+    auto it = plan->macroSlots.find({owner, ownerId, macroIndex});
+    if (it != plan->macroSlots.end()) {
+        plan->macroValues[it->second].store(juce::jlimit(0.0f, 1.0f, value),
+                                            std::memory_order_relaxed);
+    }
+}
+
+bool AudioModulator::readBack(TrackManager& trackManager) {
+    auto* plan = plan_.getPublished();
+    if (!plan) {
+        return false;
+    }
+
+    const size_t numMods = plan->getNumMods();
+    size_t index = 0;
+    bool matches = true;
+    trackManager.forEachMod([&](ModOwner owner, int ownerId, int modIndex, ModInfo& info) {
+        if (!matches) {
+            return;
+        }
+        if (index >= numMods || plan->owners[index] != owner ||
+            plan->ownerIds[index] != ownerId || plan->modIndices[index] != modIndex ||
+            !matchesPlan(*plan, index, info)) {
+            matches = false;
+            return;
+        }
+
+        info.value = plan->values[index].load(std::memory_order_relaxed);
+        info.phase = plan->displayPhases[index].load(std::memory_order_relaxed);
+        info.triggered = plan->triggered[index].exchange(false, std::memory_order_relaxed);
+        ++index;
+    });
+    if (!matches || index != numMods) {
+        return false;
+    }
+
+    // Macro values are pushed by setMacroValue(); only a change of links needs a compile
+    const size_t numMacros = plan->getNumMacros();
+    size_t macro = 0;
+    trackManager.forEachTrackMacro([&](TrackId, ModOwner owner, int ownerId, int macroIndex,
+                                       const MacroInfo& info) {
+        if (!matches || info.links.empty()) {
+            return;
+        }
+        if (macro >= numMacros || plan->macroOwners[macro] != owner ||
+            plan->macroOwnerIds[macro] != ownerId || plan->macroIndices[macro] != macroIndex ||
+            !matchesPlan(*plan, macro, info)) {
+            matches = false;
+            return;
+        }
+        ++macro;
+    });
+
+    return matches && macro == numMacros;
+}
+
+void AudioModulator::collectGarbage() {
+    if (plan_.hasRetired()) {
+        plan_.collectGarbage();
+    }
+}
+
+void AudioModulator::clear() {
+    plan_.clear();
+    sidechain_.stopListeningToAll();
+}
+
+bool AudioModulator::matchesPlan(const Plan& plan, size_t mod, const ModInfo& info) {
+    const uint8_t flags = plan.flags[mod];
+    if (info.enabled != ((flags & Plan::kEnabled) != 0) || info.type != plan.types[mod] ||
+        info.tempoSync != ((flags & Plan::kTempoSync) != 0) || info.rate != plan.rates[mod] ||
+        info.syncDivision != plan.syncDivisions[mod] ||
+        info.phaseOffset != plan.phaseOffsets[mod] || info.waveform != plan.waveforms[mod] ||
+        info.curvePreset != plan.curvePresets[mod] ||
+        info.triggerMode != plan.triggerModes[mod]) {
+        return false;
+    }
+    if (info.attack != plan.attacks[mod] || info.decay != plan.decays[mod] ||
+        info.sustain != plan.sustains[mod] || info.release != plan.releases[mod] ||
+        info.smoothing != plan.smoothings[mod] || info.midiChannel != plan.midiChannels[mod] ||
+        info.midiNote != plan.midiNotes[mod] || info.sidechainTrack != plan.sidechainTracks[mod] ||
+        info.followerDetector != plan.followerDetectors[mod] ||
+        info.resolution != plan.resolutions[mod]) {
+        return false;
+    }
+
+    const auto linkBegin = static_cast<size_t>(plan.sourceLinkBegin[mod]);
+    const auto numLinks = static_cast<size_t>(plan.sourceLinkBegin[mod + 1]) - linkBegin;
+    if (info.links.size() != numLinks) {
+        return false;
+    }
+    for (size_t i = 0; i < numLinks; ++i) {
+        const auto& link = plan.sourceLinks[linkBegin + i];
+        if (info.links[i].target != link.target || info.links[i].amount != link.amount) {
+            return false;
+        }
+    }
+
+    const auto curveBegin = static_cast<size_t>(plan.curveBegin[mod]);
+    const auto numPoints = static_cast<size_t>(plan.curveBegin[mod + 1]) - curveBegin;
+    if (info.curvePoints.size() != numPoints) {
+        return false;
+    }
+    for (size_t i = 0; i < numPoints; ++i) {
+        const auto& a = info.curvePoints[i];
+        const auto& b = plan.curvePoints[curveBegin + i];
+        if (a.phase != b.phase || a.value != b.value || a.tension != b.tension) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// =============================================================================
+// MIDI threads
+// =============================================================================
+
+bool AudioModulator::matchesPlan(const Plan& plan, size_t macro, const MacroInfo& info) {
+    const auto linkBegin = static_cast<size_t>(plan.sourceMacroLinkBegin[macro]);
+    const auto numLinks = static_cast<size_t>(plan.sourceMacroLinkBegin[macro + 1]) - linkBegin;
+    if (info.links.size() != numLinks) {
+        return false;
+    }
+    for (size_t i = 0; i < numLinks; ++i) {
+        const auto& a = info.links[i];
+        const auto& b = plan.sourceMacroLinks[linkBegin + i];
+        if (a.target != b.target || a.amount != b.amount || a.rangeStart != b.rangeStart ||
+            a.rangeEnd != b.rangeEnd || a.curve != b.curve) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void AudioModulator::noteInput(TrackId trackId, int channel, int note, bool isNoteOn) {
+    if (channel < 1 || channel > 16 || note < 0 || note > 127) {
+        return;
+    }
+    auto* notes = notes_.find(trackId);
+    if (notes == nullptr) {
+        return;
+    }
+
+    const auto word = static_cast<size_t>((channel - 1) * 2 + note / 64);
+    const uint64_t bit = uint64_t{1} << (note % 64);
+    if (isNoteOn) {
+        notes->held[word].fetch_or(bit, std::memory_order_relaxed);
+        notes->started[word].fetch_or(bit, std::memory_order_release);
+    } else {
+        notes->held[word].fetch_and(~bit, std::memory_order_relaxed);
+    }
+}
+
+// =============================================================================
+// Audio thread
+// =============================================================================
+
+void AudioModulator::process(int numSamples, double sampleRate, const Transport& transport,
+                             const Input& input) {
+    auto* plan = plan_.acquire();
+    if (plan == nullptr || numSamples <= 0 || sampleRate <= 0.0) {
+        plan_.release();
+        return;
+    }
+
+    const double deltaTime = numSamples / sampleRate;
+    const auto beatsPerSecond = static_cast<float>(transport.bpm / 60.0);
+    std::fill(plan->modulation.begin(), plan->modulation.end(), 0.0f);
+
+    const size_t numMods = plan->getNumMods();
+    float* effectivePhases = plan->effectivePhases.data();
+    float* outputs = plan->outputs.data();
+
+    // Pass 0: the notes each source track received and the audio it follows this block
+    const size_t numSources = plan->sourceTracks.size();
+    for (size_t s = 0; s < numSources; ++s) {
+        uint64_t* held = plan->sourceHeld.data() + s * kNoteWords;
+        uint64_t* started = plan->sourceStarted.data() + s * kNoteWords;
+        const TrackId trackId = plan->sourceTracks[s];
+        if (auto* notes = notes_.find(trackId)) {
+            for (size_t w = 0; w < kNoteWords; ++w) {
+                started[w] = notes->started[w].exchange(0, std::memory_order_acquire);
+                held[w] = notes->held[w].load(std::memory_order_relaxed);
+            }
+        }
+
+        auto& reading = plan->sourceReadings[s];
+        reading = {};
+        if (plan->sourceUsesAudio[s] == 0) {
+            continue;
+        }
+
+        // Another track's output, measured as it rendered
+        const TrackId sidechain = plan->sourceSidechains[s];
+        if (sidechain != INVALID_TRACK_ID) {
+            reading = sidechain_.read(sidechain, plan->sourceOnsetsSeen[s]);
+            continue;
+        }
+
+        // The track's own input, straight from the device
+        const float* channels[kMaxSourceChannels];
+        int numChannels = 0;
+        const int channelEnd = plan->sourceChannelBegin[s + 1];
+        for (int c = plan->sourceChannelBegin[s];
+             c < channelEnd && numChannels < kMaxSourceChannels; ++c) {
+            const int channel = plan->sourceChannels[static_cast<size_t>(c)];
+            if (input.channels != nullptr && channel >= 0 && channel < input.numChannels) {
+                channels[numChannels++] = input.channels[channel];
+            }
+        }
+        reading = plan->sourceDetectors[s].process(channels, numChannels, numSamples, sampleRate);
+    }
+
+    // Control-rate mods advance once enough audio has built up
+    plan->controlElapsed += deltaTime;
+    const bool controlDue = plan->controlElapsed >= kControlSeconds;
+    if (controlDue) {
+        plan->controlElapsed = 0.0;
+    }
+
+    // Pass 1: triggers, phase advance and the generators
+    for (size_t i = 0; i < numMods; ++i) {
+        const uint8_t flags = plan->flags[i];
+        if ((flags & Plan::kEnabled) == 0) {
+            effectivePhases[i] = 0.0f;
+            continue;
+        }
+
+        const int source = plan->modSources[i];
+        const auto sourceIndex = static_cast<size_t>(std::max(source, 0));
+        const bool noteStarted =
+            source >= 0 && matchesNote(plan->sourceStarted.data() + sourceIndex * kNoteWords,
+                                       plan->midiChannels[i], plan->midiNotes[i]);
+        const bool onset = source >= 0 && plan->sourceReadings[sourceIndex].onset;
+
+        // A held control-rate mod keeps its phase and level, so Passes 2 and 3 give the
+        // same value again; a trigger can't wait for the next step
+        double modDeltaTime = deltaTime;
+        if ((flags & Plan::kControlRate) != 0) {
+            plan->owedTimes[i] += static_cast<float>(deltaTime);
+            if (!controlDue && !noteStarted && !onset && !transport.justStarted &&
+                !transport.justLooped) {
+                continue;
+            }
+            modDeltaTime = plan->owedTimes[i];
+            plan->owedTimes[i] = 0.0f;
+        }
+
+        const float rate = (flags & Plan::kTempoSync) != 0 ? plan->syncFactors[i] * beatsPerSecond
+                                                           : plan->rates[i];
+        float& level = plan->levels[i];
+
+        switch (plan->types[i]) {
+            case ModType::LFO: {
+                float& phase = plan->phases[i];
+                if (ModulatorEngine::shouldTrigger(plan->triggerModes[i], transport.justStarted,
+                                                   transport.justLooped, noteStarted, onset)) {
+                    phase = 0.0f;
+                    plan->triggered[i].store(true, std::memory_order_relaxed);
+                }
+                phase = ModulatorEngine::advancePhase(phase, rate, modDeltaTime);
+                effectivePhases[i] = std::fmod(phase + plan->phaseOffsets[i], 1.0f);
+                plan->displayPhases[i].store(phase, std::memory_order_relaxed);
+                break;
+            }
+            case ModType::Envelope: {
+                const bool gate =
+                    source >= 0 && matchesNote(plan->sourceHeld.data() + sourceIndex * kNoteWords,
+                                               plan->midiChannels[i], plan->midiNotes[i]);
+                auto stage = static_cast<ModulatorEngine::EnvelopeStage>(plan->envelopeStages[i]);
+                level = ModulatorEngine::advanceEnvelope(
+                    stage, level, noteStarted, gate, plan->attacks[i], plan->decays[i],
+                    plan->sustains[i], plan->releases[i], modDeltaTime);
+                plan->envelopeStages[i] = static_cast<uint8_t>(stage);
+                if (noteStarted) {
+                    plan->triggered[i].store(true, std::memory_order_relaxed);
+                }
+                break;
+            }
+            case ModType::Random: {
+                // A new step each time the phase wraps, or when triggered
+                float& phase = plan->phases[i];
+                const bool reset =
+                    ModulatorEngine::shouldTrigger(plan->triggerModes[i], transport.justStarted,
+                                                   transport.justLooped, noteStarted, onset);
+                if (reset) {
+                    phase = 0.0f;
+                    plan->triggered[i].store(true, std::memory_order_relaxed);
+                }
+                const float advanced = ModulatorEngine::advancePhase(phase, rate, modDeltaTime);
+                if (reset || advanced < phase) {
+                    plan->randomFrom[i] = level;
+                    plan->randomTo[i] = ModulatorEngine::nextRandom(plan->randomSeeds[i]);
+                }
+                phase = advanced;
+                level = ModulatorEngine::smoothRandom(plan->randomFrom[i], plan->randomTo[i],
+                                                      phase, plan->smoothings[i]);
+                plan->displayPhases[i].store(phase, std::memory_order_relaxed);
+                break;
+            }
+            case ModType::Follower: {
+                float follow = 0.0f;
+                if (source >= 0) {
+                    const auto& reading = plan->sourceReadings[sourceIndex];
+                    follow = plan->followerDetectors[i] == FollowerDetector::RMS ? reading.rms
+                                                                                 : reading.peak;
+                }
+                level = ModulatorEngine::followLevel(level, std::min(follow, 1.0f),
+                                                     plan->attacks[i], plan->releases[i],
+                                                     modDeltaTime);
+                break;
+            }
+        }
+    }
+
+    // Pass 2: every standard waveform in one vectorised batch
+    ModulatorEngine::generateWaveformBatch(plan->waveforms.data(), effectivePhases, outputs,
+                                           static_cast<int>(numMods));
+
+    // Pass 3: baked curves, held values, and link accumulation
+    for (size_t i = 0; i < numMods; ++i) {
+        const uint8_t flags = plan->flags[i];
+
+        // Disabled mods output 0
+        float value = plan->heldValues[i];
+        if ((flags & Plan::kEnabled) != 0 && (flags & Plan::kLFO) == 0) {
+            value = plan->levels[i];
+        } else if ((flags & Plan::kEnabled) != 0) {
+            if ((flags & Plan::kCurveTable) != 0) {
+                const float* table =
+                    plan->curveTables.data() + static_cast<size_t>(plan->curveTableOffsets[i]);
+                value = ModulatorEngine::lookupCurveTable(table, effectivePhases[i]);
+            } else {
+                value = outputs[i];
+            }
+        }
+        plan->values[i].store(value, std::memory_order_relaxed);
+
+        const int linkEnd = plan->linkBegin[i + 1];
+        for (int l = plan->linkBegin[i]; l < linkEnd; ++l) {
+            plan->modulation[static_cast<size_t>(plan->linkTargets[static_cast<size_t>(l)])] +=
+                value * plan->linkAmounts[static_cast<size_t>(l)];
+        }
+    }
+
+    // Pass 4: macros, each knob's value fanned out through its links
+    const size_t numMacros = plan->getNumMacros();
+    for (size_t m = 0; m < numMacros; ++m) {
+        const float value = plan->macroValues[m].load(std::memory_order_relaxed);
+        const int linkEnd = plan->macroLinkBegin[m + 1];
+        for (int l = plan->macroLinkBegin[m]; l < linkEnd; ++l) {
+            const auto link = static_cast<size_t>(l);
+            plan->modulation[static_cast<size_t>(plan->macroLinkTargets[link])] +=
+                plan->macroLinkAmounts[link] *
+                shapeMacroValue(value, plan->macroLinkRangeStarts[link],
+                                plan->macroLinkRangeEnds[link], plan->macroLinkCurves[link]);
+        }
+    }
+
+    // The engine adds each source to its parameter's own value as the plugin renders
+    const size_t numTargets = plan->targetDevices.size();
+    for (size_t i = 0; i < numTargets; ++i) {
+        const float value = std::clamp(plan->modulation[i], 0.0f, 1.0f);
+
+        // Only touch the source when the value actually moves
+        if (value != plan->targetApplied[i]) {
+            plan->targetSources[i]->setNormalisedParameter(value, juce::dontSendNotification);
+            plan->targetApplied[i] = value;
+        }
+    }
+
+    plan_.release();
+}
+
+}  // namespace magda
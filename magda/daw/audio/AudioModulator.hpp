@@ -0,0 +1,352 @@
+#pragma once
+
+#include <tracktion_engine/tracktion_engine.h>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include "../core/MacroInfo.hpp"
+#include "../core/ModInfo.hpp"
+#include "../core/TypeIds.hpp"
+#include "RealtimeSnapshot.hpp"
+#include "SidechainDetector.hpp"
+#include "TrackSlotDirectory.hpp"
+
+namespace magda {
+
+namespace te = tracktion;
+class TrackManager;
+
+/**
+ * @brief Evaluates device and rack mods on the audio thread and applies them to parameters
+ *
+ * The message thread compiles the TrackManager mod tree into an immutable plan (mod
+ * settings, flattened links and resolved parameter targets). Once per audio block the
+ * audio thread advances every mod, sums linked contributions per target and writes the
+ * sum into the target's modifier source (see ParameterModifiers); the engine adds it to
+ * the parameter as the plugin renders, leaving the parameter's own value alone. Results
+ * are exposed through atomics so the UI can read them back into ModInfo::value for
+ * display.
+ *
+ * Besides LFOs: envelopes run an ADSR gated by MIDI notes arriving for the mod's track,
+ * Random mods step through smoothed sample-and-hold values, and followers track the peak
+ * or RMS level of an audio source. MIDI and Audio trigger modes restart LFOs and random
+ * steps on those same notes and on onsets in the audio source. The MIDI threads post notes
+ * through noteInput(), so none of this involves the message thread.
+ *
+ * A mod's audio source is its track's recording input, measured here from the device
+ * input, or the output of any track (ModInfo::sidechainTrack), measured by that track's
+ * TrackMeterPlugin and read from getSidechainBus(). Both run a SidechainDetector once per
+ * block, so following or triggering from audio adds no latency beyond the block, and
+ * tracks nothing listens to aren't measured at all.
+ *
+ * Macros are compiled into the same plan: each linked macro is one atomic value and a
+ * flat run of links, each with its amount, range and curve (see shapeMacroValue). Turning
+ * a knob is a single setMacroValue() store however many parameters it drives; the audio
+ * thread fans it out in the same pass that applies the mods, so a parameter driven by
+ * both gets their sum and is written once.
+ *
+ * Each mod runs at its ModResolution: every block, or at control rate, advancing only once
+ * kControlSeconds of audio has built up (or on a trigger) and holding its value between.
+ * With small audio blocks that spares the slow mods most of their evaluations.
+ *
+ * Modulation is unipolar in normalised parameter space, matching the UI's display: the
+ * engine renders clamp(base + sum(modValue * linkAmount) + sum(macro link contributions),
+ * 0, 1), base being the parameter's own value.
+ *
+ * Threading: compile(), addTrack(), removeTrack(), setMacroValue(), readBack() and
+ * collectGarbage() on the message thread; noteInput() on MIDI threads; process() on the
+ * audio thread only.
+ */
+class AudioModulator {
+  public:
+    /**
+     * @brief Transport state for one audio block
+     */
+    struct Transport {
+        double bpm = 120.0;
+        bool justStarted = false;
+        bool justLooped = false;
+    };
+
+    /**
+     * @brief Device input for one audio block
+     */
+    struct Input {
+        const float* const* channels = nullptr;  // Active device inputs, packed
+        int numChannels = 0;
+    };
+
+    /**
+     * @brief A mod target resolved to an engine parameter
+     */
+    struct ResolvedTarget {
+        te::AutomatableParameter* parameter = nullptr;
+        te::Plugin::Ptr plugin;  // Keeps parameter alive while the plan exists
+    };
+
+    /**
+     * @brief Resolves (deviceId, paramIndex) to a parameter, or returns false
+     */
+    using Resolver = std::function<bool(DeviceId, int, ResolvedTarget&)>;
+
+    /**
+     * @brief The packed device input channels feeding a track, empty if none
+     */
+    using InputResolver = std::function<std::vector<int>(TrackId)>;
+
+    AudioModulator() = default;
+    ~AudioModulator() = default;
+
+    // =========================================================================
+    // Message thread
+    // =========================================================================
+
+    /**
+     * @brief Rebuild the plan from the current mod tree and publish it
+     *
+     * Phases carry over for mods that survive the rebuild, modifier sources for targets
+     * that do. Call when the device/rack layout changes, or when readBack() reports an
+     * edit. Targets that are no longer linked lose their modifier source.
+     * Followers and audio-triggered mods listen to the channels inputResolver gives, or to
+     * their sidechain track on the bus.
+     */
+    void compile(const TrackManager& trackManager, const Resolver& resolver,
+                 const InputResolver& inputResolver = nullptr);
+
+    /**
+     * @brief Give a track note state, so its envelopes and MIDI triggers follow noteInput()
+     *
+     * Does nothing if the track already has it. Notes for tracks without it are ignored.
+     */
+    void addTrack(TrackId trackId);
+
+    /**
+     * @brief Drop a track's note state once the track is gone
+     */
+    void removeTrack(TrackId trackId);
+
+    /**
+     * @brief Set a macro knob's value (0 to 1), applied to its links on the next block
+     *
+     * Ignored for macros with no links in the plan; the next compile reads their value
+     * from the model.
+     */
+    void setMacroValue(ModOwner owner, int ownerId, int macroIndex, float value);
+
+    /**
+     * @brief Copy audio-thread mod values, phases and triggers into ModInfo for display
+     * @return false if the mod tree or the macro links no longer match the plan (caller
+     *         should compile)
+     */
+    bool readBack(TrackManager& trackManager);
+
+    /**
+     * @brief Free plans the audio thread has moved past
+     */
+    void collectGarbage();
+
+    /**
+     * @brief Drop all plans (only when the audio thread can't be processing)
+     */
+    void clear();
+
+    /**
+     * @brief Where track meters publish the outputs mods follow (see TrackMeterPlugin)
+     */
+    SidechainBus& getSidechainBus() {
+        return sidechain_;
+    }
+
+    // =========================================================================
+    // MIDI threads
+    // =========================================================================
+
+    /**
+     * @brief A note started or ended on a MIDI input routed to a track (wait-free)
+     * @param channel 1-16
+     */
+    void noteInput(TrackId trackId, int channel, int note, bool isNoteOn);
+
+    // =========================================================================
+    // Audio thread
+    // =========================================================================
+
+    /**
+     * @brief Advance all mods by one block and write each target's modulation
+     *
+     * Lock-free and allocation-free.
+     */
+    void process(int numSamples, double sampleRate, const Transport& transport,
+                 const Input& input = {});
+
+    // Control-rate mods advance once this much audio has passed
+    static constexpr double kControlSeconds = 0.01;
+
+    // Auto resolution puts LFOs and random mods at or below this rate on control rate;
+    // tempo-synced rates are taken at 120 BPM
+    static constexpr float kControlMaxHz = 1.0f;
+
+    /**
+     * @brief Whether a mod runs at control rate (resolving Auto)
+     */
+    static bool runsAtControlRate(const ModInfo& info);
+
+  private:
+    /**
+     * @brief Compiled, structure-of-arrays form of the mod tree
+     *
+     * Per-mod settings live in parallel arrays indexed by mod, links in CSR form
+     * (linkBegin[i]..linkBegin[i + 1]), so process() is one linear pass with no pointer
+     * chasing through ChainElement variants. Custom curves are baked into fixed-size
+     * tables. Cold data that is only needed to detect edits on the message thread sits at
+     * the end.
+     */
+    // Note state per track, one bit per channel and note: 16 channels x 128 notes
+    static constexpr size_t kNoteWords = 32;
+
+    struct TrackNotes {
+        std::array<std::atomic<uint64_t>, kNoteWords> held{};
+        std::array<std::atomic<uint64_t>, kNoteWords> started{};  // Since the last block
+
+        void clear() {
+            for (size_t w = 0; w < kNoteWords; ++w) {
+                held[w].store(0, std::memory_order_relaxed);
+                started[w].store(0, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    // Note state slots, allocated together; up to 4096 tracks at once
+    static constexpr int kNoteSlotsPerChunk = 64;
+    static constexpr int kMaxNoteChunks = 64;
+
+    struct Plan {
+        // Mod flags
+        static constexpr uint8_t kEnabled = 1 << 0;
+        static constexpr uint8_t kLFO = 1 << 1;
+        static constexpr uint8_t kTempoSync = 1 << 2;
+        static constexpr uint8_t kCurveTable = 1 << 3;
+        static constexpr uint8_t kControlRate = 1 << 4;
+
+        // Hot per-mod settings
+        std::vector<uint8_t> flags;
+        std::vector<float> rates;        // Hz (free-running)
+        std::vector<float> syncFactors;  // Cycles per beat (tempo-synced)
+        std::vector<float> phaseOffsets;
+        std::vector<LFOWaveform> waveforms;
+        std::vector<LFOTriggerMode> triggerModes;
+        std::vector<int> curveTableOffsets;  // Into curveTables, for kCurveTable mods
+        std::vector<float> heldValues;  // Output when disabled
+
+        // Envelope, Random and Follower settings
+        std::vector<ModType> types;
+        std::vector<float> attacks;
+        std::vector<float> decays;
+        std::vector<float> sustains;
+        std::vector<float> releases;
+        std::vector<float> smoothings;
+        std::vector<int> midiChannels;
+        std::vector<int> midiNotes;
+        std::vector<FollowerDetector> followerDetectors;
+        std::vector<int> modSources;  // Into the sources, -1 if the mod needs none
+
+        // Sources: the track whose notes drive mods, and the audio they follow - a track's
+        // output on the bus, or (sourceSidechains[s] invalid) the track's device input
+        std::vector<TrackId> sourceTracks;
+        std::vector<TrackId> sourceSidechains;
+        std::vector<uint8_t> sourceUsesAudio;  // Otherwise only its notes are wanted
+        std::vector<int> sourceChannelBegin;  // CSR into sourceChannels
+        std::vector<int> sourceChannels;      // Packed device input channels
+
+        // Links (CSR by mod)
+        std::vector<int> linkBegin;
+        std::vector<int> linkTargets;
+        std::vector<float> linkAmounts;
+
+        // Macros: links in CSR form (macroLinkBegin[m]..macroLinkBegin[m + 1])
+        std::vector<int> macroLinkBegin;
+        std::vector<int> macroLinkTargets;
+        std::vector<float> macroLinkAmounts;
+        std::vector<float> macroLinkRangeStarts;
+        std::vector<float> macroLinkRangeEnds;
+        std::vector<MacroCurve> macroLinkCurves;
+
+        // Baked Custom curves, ModulatorEngine::kCurveTableSize + 1 values each
+        std::vector<float> curveTables;
+
+        // Targets
+        std::vector<DeviceId> targetDevices;
+        std::vector<int> targetParams;
+        std::vector<te::AutomatableParameter*> targetParameters;
+        std::vector<te::AutomatableParameter::Ptr> targetSources;  // Modifiers written
+        std::vector<te::Plugin::Ptr> plugins;  // Keep targetParameters alive
+
+        // State shared between threads
+        std::unique_ptr<float[]> phases;  // Audio thread only
+        // Audio thread only: envelope and follower level, or the random output
+        std::vector<float> levels;
+        std::vector<uint8_t> envelopeStages;  // ModulatorEngine::EnvelopeStage
+        std::vector<float> randomFrom;
+        std::vector<float> randomTo;
+        std::vector<uint32_t> randomSeeds;
+        std::vector<float> owedTimes;  // Control-rate mods: seconds not yet advanced
+        double controlElapsed = 0.0;   // Since control-rate mods last advanced
+        std::vector<SidechainDetector> sourceDetectors;  // Device input sources
+        std::vector<uint32_t> sourceOnsetsSeen;          // Bus sources
+        std::unique_ptr<std::atomic<float>[]> values;
+        std::unique_ptr<std::atomic<float>[]> displayPhases;
+        std::unique_ptr<std::atomic<bool>[]> triggered;  // Sticky until read back
+        std::unique_ptr<std::atomic<float>[]> macroValues;  // Written by setMacroValue()
+        std::vector<float> targetApplied;  // Audio thread only: last source value (-1 = never)
+        // Audio thread scratch: one per target, then one per mod
+        std::vector<float> modulation;
+        std::vector<float> effectivePhases;
+        std::vector<float> outputs;
+        // Audio thread scratch per source: notes (kNoteWords each) and the audio reading
+        std::vector<uint64_t> sourceHeld;
+        std::vector<uint64_t> sourceStarted;
+        std::vector<SidechainDetector::Reading> sourceReadings;
+
+        // Cold: identity and source settings, for read-back and edit detection
+        std::vector<ModOwner> owners;
+        std::vector<int> ownerIds;
+        std::vector<int> modIndices;
+        std::vector<TrackId> sidechainTracks;
+        std::vector<SyncDivision> syncDivisions;
+        std::vector<CurvePreset> curvePresets;
+        std::vector<ModResolution> resolutions;
+        std::vector<int> curveBegin;  // Source curve points (CSR by mod)
+        std::vector<CurvePointData> curvePoints;
+        std::vector<int> sourceLinkBegin;
+        std::vector<ModLink> sourceLinks;  // Including links that didn't resolve
+        std::vector<ModOwner> macroOwners;
+        std::vector<int> macroOwnerIds;
+        std::vector<int> macroIndices;
+        std::vector<int> sourceMacroLinkBegin;  // Source macro links (CSR by macro)
+        std::vector<MacroLink> sourceMacroLinks;
+        std::map<std::tuple<ModOwner, int, int>, size_t> macroSlots;  // Every linked macro
+
+        size_t getNumMods() const {
+            return flags.size();
+        }
+        size_t getNumMacros() const {
+            return macroLinkBegin.empty() ? 0 : macroLinkBegin.size() - 1;
+        }
+    };
+
+    static bool matchesPlan(const Plan& plan, size_t mod, const ModInfo& info);
+    static bool matchesPlan(const Plan& plan, size_t macro, const MacroInfo& info);
+
+    RealtimeSnapshot<Plan> plan_;
+    TrackSlotDirectory<TrackNotes, kNoteSlotsPerChunk, kMaxNoteChunks> notes_;
+    SidechainBus sidechain_;
+};
+
+}  // namespace magda
@@ -0,0 +1,268 @@
+#include "AudioReadAhead.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <set>
+
+namespace magda {
+
+namespace {
+// Touch one sample per page; the OS reads the rest of the page with it
+constexpr juce::int64 kPageBytes = 4096;
+
+double nowSeconds() {
+    return juce::Time::getMillisecondCounterHiRes() * 0.001;
+}
+}  // namespace
+
+// =============================================================================
+// FetchJob
+// =============================================================================
+
+/**
+ * @brief Works through the shared queue, one block per run so it can be stopped between
+ */
+class AudioReadAhead::FetchJob : public juce::ThreadPoolJob {
+  public:
+    explicit FetchJob(AudioReadAhead& owner)
+        : juce::ThreadPoolJob("Audio read-ahead"), owner_(owner) {}
+
+    JobStatus runJob() override {
+        if (shouldExit() || !owner_.fetchNext()) {
+            return jobHasFinished;
+        }
+        return jobNeedsRunningAgain;
+    }
+
+  private:
+    AudioReadAhead& owner_;
+};
+
+// =============================================================================
+// AudioReadAhead
+// =============================================================================
+
+AudioReadAhead::AudioReadAhead(int numThreads) : numThreads_(std::max(1, numThreads)) {
+    formatManager_.registerBasicFormats();
+    pool_ = std::make_unique<juce::ThreadPool>(numThreads_);
+}
+
+AudioReadAhead::~AudioReadAhead() {
+    pool_->removeAllJobs(true, 2000);
+    pool_.reset();
+}
+
+AudioReadAhead::Window AudioReadAhead::getWindow(double speed) {
+    if (speed == 0.0) {
+        return {kStillSeconds, kStillSeconds};
+    }
+    const double ahead =
+        std::min(kMaxAheadSeconds, kStillSeconds + kSecondsPerSpeed * std::abs(speed));
+    return speed > 0.0 ? Window{kBehindSeconds, ahead} : Window{ahead, kBehindSeconds};
+}
+
+std::vector<AudioReadAhead::Request> AudioReadAhead::plan(double positionSeconds, double speed,
+                                                          const std::vector<ClipSpan>& clips,
+                                                          const Loop& loop) {
+    const auto window = getWindow(speed);
+    const double low = positionSeconds - window.before;
+    double high = positionSeconds + window.after;
+
+    std::vector<Request> requests;
+    if (speed > 0.0 && loop.isActive() && positionSeconds >= loop.startSeconds &&
+        positionSeconds < loop.endSeconds && high > loop.endSeconds) {
+        // Past the loop end the playhead is back at the start
+        const double wrappedAfter =
+            std::min(high - loop.endSeconds, loop.endSeconds - loop.startSeconds);
+        planWindow(loop.startSeconds, loop.startSeconds + wrappedAfter, loop.startSeconds,
+                   speed, window, loop.endSeconds - positionSeconds, clips, requests);
+        high = loop.endSeconds;
+    }
+    planWindow(low, high, positionSeconds, speed, window, 0.0, clips, requests);
+
+    std::stable_sort(requests.begin(), requests.end(), [](const Request& a, const Request& b) {
+        return a.distanceSeconds < b.distanceSeconds;
+    });
+    return requests;
+}
+
+void AudioReadAhead::planWindow(double low, double high, double positionSeconds, double speed,
+                                const Window& window, double distanceSeconds,
+                                const std::vector<ClipSpan>& clips,
+                                std::vector<Request>& requests) {
+    for (const auto& clip : clips) {
+        const double from = std::max(low, clip.startSeconds);
+        const double to = std::min(high, clip.startSeconds + clip.lengthSeconds);
+        if (clip.filePath.isEmpty() || to <= from || clip.stretchFactor <= 0.0) {
+            continue;
+        }
+
+        Request request;
+        request.filePath = clip.filePath;
+        if (clip.looped) {
+            request.fileStartSeconds = clip.fileOffsetSeconds;
+            request.fileEndSeconds = clip.fileOffsetSeconds + clip.loopFileSeconds;
+        } else {
+            request.fileStartSeconds =
+                clip.fileOffsetSeconds + (from - clip.startSeconds) / clip.stretchFactor;
+            request.fileEndSeconds =
+                clip.fileOffsetSeconds + (to - clip.startSeconds) / clip.stretchFactor;
+        }
+
+        // How soon the playhead gets there going its way; what it is moving away from
+        // comes after everything it is moving towards
+        if (from > positionSeconds) {
+            request.distanceSeconds = from - positionSeconds;
+            if (speed < 0.0) {
+                request.distanceSeconds += window.before;
+            }
+        } else if (to <= positionSeconds) {
+            request.distanceSeconds = positionSeconds - to;
+            if (speed > 0.0) {
+                request.distanceSeconds += window.after;
+            }
+        }
+        request.distanceSeconds += distanceSeconds;
+        requests.push_back(std::move(request));
+    }
+}
+
+void AudioReadAhead::update(double positionSeconds, double speed,
+                            const std::vector<ClipSpan>& clips, const Loop& loop) {
+    const auto requests = plan(positionSeconds, speed, clips, loop);
+    const double now = nowSeconds();
+
+    size_t queued = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        // Nearest first, and within a region in the order the playhead will read it
+        std::vector<Block> blocks;
+        for (const auto& request : requests) {
+            const auto first = std::max<juce::int64>(
+                0, static_cast<juce::int64>(std::floor(request.fileStartSeconds / kBlockSeconds)));
+            const auto last =
+                static_cast<juce::int64>(std::ceil(request.fileEndSeconds / kBlockSeconds));
+            const auto fetched = fetched_.find(request.filePath);
+            auto wanted = [&](juce::int64 block) {
+                if (fetched == fetched_.end()) {
+                    return true;
+                }
+                const auto it = fetched->second.find(block);
+                return it == fetched->second.end() || now - it->second >= kRefreshSeconds;
+            };
+            for (auto i = first; i < last; ++i) {
+                const auto block = speed < 0.0 ? last - 1 - (i - first) : i;
+                if (wanted(block)) {
+                    blocks.push_back({request.filePath, block, request.distanceSeconds});
+                }
+            }
+        }
+        queue_.assign(blocks.rbegin(), blocks.rend());
+        queued = queue_.size();
+
+        // Files no clip plays from any more close once no fetch is using them
+        std::set<juce::String> inUse;
+        for (const auto& clip : clips) {
+            inUse.insert(clip.filePath);
+        }
+        for (auto it = files_.begin(); it != files_.end();) {
+            if (inUse.count(it->first) == 0) {
+                fetched_.erase(it->first);
+                it = files_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    const int wantedJobs = static_cast<int>(std::min<size_t>(numThreads_, queued));
+    for (int jobs = pool_->getNumJobs(); jobs < wantedJobs; ++jobs) {
+        pool_->addJob(new FetchJob(*this), true);
+    }
+}
+
+void AudioReadAhead::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    queue_.clear();
+    files_.clear();
+    fetched_.clear();
+}
+
+AudioReadAhead::Stats AudioReadAhead::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats stats;
+    stats.blocksFetched = blocksFetched_;
+    stats.pagesTouched = pagesTouched_;
+    stats.queuedBlocks = static_cast<int>(queue_.size());
+    stats.openFiles = static_cast<int>(files_.size());
+    return stats;
+}
+
+// =============================================================================
+// Pool threads
+// =============================================================================
+
+bool AudioReadAhead::fetchNext() {
+    Block block;
+    std::shared_ptr<MappedFile> file;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (queue_.empty()) {
+            return false;
+        }
+        block = std::move(queue_.back());
+        queue_.pop_back();
+        // Marked now, so the next update doesn't queue it again while it is read
+        fetched_[block.filePath][block.index] = nowSeconds();
+        file = getFile(block.filePath);
+    }
+    fetch(*file, block.index);
+    return true;
+}
+
+std::shared_ptr<AudioReadAhead::MappedFile> AudioReadAhead::getFile(const juce::String& filePath) {
+    auto& file = files_[filePath];
+    if (file == nullptr) {
+        file = std::make_shared<MappedFile>();
+        file->file = juce::File(filePath);
+    }
+    return file;
+}
+
+void AudioReadAhead::fetch(MappedFile& file, juce::int64 block) {
+    std::lock_guard<std::mutex> lock(file.mutex);
+    if (!file.opened) {
+        file.opened = true;
+        const auto extension = file.file.getFileExtension();
+        if (auto* format = formatManager_.findFormatForFileExtension(extension)) {
+            file.reader.reset(format->createMemoryMappedReader(file.file));
+            if (file.reader != nullptr && !file.reader->mapEntireFile()) {
+                file.reader.reset();
+            }
+        }
+    }
+    auto* reader = file.reader.get();
+    if (reader == nullptr || reader->sampleRate <= 0.0) {
+        return;
+    }
+
+    const auto blockFrames = static_cast<juce::int64>(kBlockSeconds * reader->sampleRate);
+    const auto begin = std::min(block * blockFrames, reader->lengthInSamples);
+    const auto end = std::min(begin + blockFrames, reader->lengthInSamples);
+    const auto bytesPerFrame =
+        std::max<juce::int64>(1, static_cast<juce::int64>(reader->getBytesPerFrame()));
+    const auto framesPerPage = std::max<juce::int64>(1, kPageBytes / bytesPerFrame);
+
+    juce::int64 pages = 0;
+    for (auto frame = begin; frame < end; frame += framesPerPage) {
+        reader->touchSample(frame);
+        ++pages;
+    }
+
+    std::lock_guard<std::mutex> statsLock(mutex_);
+    ++blocksFetched_;
+    pagesTouched_ += pages;
+}
+
+}  // namespace magda
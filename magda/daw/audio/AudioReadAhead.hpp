@@ -0,0 +1,164 @@
+#pragma once
+
+#include <juce_audio_formats/juce_audio_formats.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace magda {
+
+/**
+ * @brief Pages audio files into memory ahead of the playhead on a shared I/O pool
+ *
+ * Playback reads clips through Tracktion's AudioFileCache, which memory-maps the files; a
+ * page that isn't resident faults on the audio thread and waits for the disk. With long
+ * recordings and many stems that shows up as stalls on play, after a jump and while
+ * scrubbing. AudioBridge describes the arrangement's audio clips and the transport every
+ * timer tick, and the file regions the clips around the playhead will read next are mapped
+ * and touched here, so the engine's own mapping finds them in the page cache.
+ *
+ * The window reaches further in the direction the playhead is moving, and further still
+ * the faster it moves. Regions are fetched nearest first, and each update replaces
+ * whatever is still queued, so a jump doesn't wait behind reads for where the playhead
+ * was. Only formats JUCE can memory-map (WAV, AIFF) are read ahead; the engine decodes
+ * compressed files into its own cache.
+ *
+ * While the transport loops, the window doesn't run on past the loop end: what it would
+ * reach there is read from the loop start instead, so the files the playhead wraps into
+ * are resident well before the wrap.
+ *
+ * Message thread only, apart from the pool's threads.
+ */
+class AudioReadAhead {
+  public:
+    /**
+     * @brief Part of a file that plays on the timeline
+     */
+    struct ClipSpan {
+        juce::String filePath;
+        double startSeconds = 0.0;  // On the timeline
+        double lengthSeconds = 0.0;
+        double fileOffsetSeconds = 0.0;  // File position at startSeconds
+        double stretchFactor = 1.0;      // Timeline seconds per file second
+        // A looping clip reads the same region on every pass, so all of it is wanted
+        bool looped = false;
+        double loopFileSeconds = 0.0;  // Length of that region in the file
+    };
+
+    /**
+     * @brief Timeline seconds either side of the playhead to have resident
+     */
+    struct Window {
+        double before = 0.0;
+        double after = 0.0;
+    };
+
+    /**
+     * @brief The transport's loop, if it's looping (timeline seconds)
+     */
+    struct Loop {
+        double startSeconds = 0.0;
+        double endSeconds = 0.0;
+
+        bool isActive() const {
+            return endSeconds > startSeconds;
+        }
+    };
+
+    /**
+     * @brief A region of a file to have resident
+     */
+    struct Request {
+        juce::String filePath;
+        double fileStartSeconds = 0.0;
+        double fileEndSeconds = 0.0;
+        double distanceSeconds = 0.0;  // How soon the playhead gets there; nearest first
+    };
+
+    struct Stats {
+        juce::int64 blocksFetched = 0;
+        juce::int64 pagesTouched = 0;
+        int queuedBlocks = 0;
+        int openFiles = 0;
+    };
+
+    explicit AudioReadAhead(int numThreads = kDefaultThreads);
+    ~AudioReadAhead();
+
+    /**
+     * @brief Queue the blocks the playhead is heading into, replacing the previous queue
+     * @param speed Timeline seconds per second: 1 when playing, negative when scrubbing
+     *        backwards, 0 when still
+     */
+    void update(double positionSeconds, double speed, const std::vector<ClipSpan>& clips,
+                const Loop& loop = {});
+
+    /**
+     * @brief Forget what was fetched and close the files (e.g. before one is overwritten)
+     */
+    void clear();
+
+    Stats getStats() const;
+
+    static Window getWindow(double speed);
+
+    /**
+     * @brief The regions to fetch for the clips inside the window, nearest first
+     *
+     * Playing forward inside a loop, the window stops at the loop end and carries on from
+     * the loop start, at the distance the playhead will be there after the wrap.
+     */
+    static std::vector<Request> plan(double positionSeconds, double speed,
+                                     const std::vector<ClipSpan>& clips, const Loop& loop = {});
+
+    static constexpr int kDefaultThreads = 2;
+    static constexpr double kBlockSeconds = 1.0;     // Fetch granularity, in file time
+    static constexpr double kStillSeconds = 2.0;     // Each way while the playhead is still
+    static constexpr double kBehindSeconds = 1.0;    // Behind a moving playhead
+    static constexpr double kSecondsPerSpeed = 6.0;  // Further ahead per 1x of speed
+    static constexpr double kMaxAheadSeconds = 30.0;
+    // Moving faster than this is a jump rather than a direction to read ahead in
+    static constexpr double kMaxSpeed = 8.0;
+    // A fetched block is fetched again after this long, in case the OS dropped it
+    static constexpr double kRefreshSeconds = 20.0;
+
+  private:
+    class FetchJob;
+
+    struct MappedFile {
+        juce::File file;
+        std::mutex mutex;  // Opening and touching; touchSample() isn't thread-safe
+        bool opened = false;
+        std::unique_ptr<juce::MemoryMappedAudioFormatReader> reader;
+    };
+
+    struct Block {
+        juce::String filePath;
+        juce::int64 index = 0;
+        double distanceSeconds = 0.0;
+    };
+
+    // Adds the requests for the clips inside [low, high), distanceSeconds further away
+    static void planWindow(double low, double high, double positionSeconds, double speed,
+                           const Window& window, double distanceSeconds,
+                           const std::vector<ClipSpan>& clips, std::vector<Request>& requests);
+
+    bool fetchNext();
+    void fetch(MappedFile& file, juce::int64 block);
+    std::shared_ptr<MappedFile> getFile(const juce::String& filePath);
+
+    juce::AudioFormatManager formatManager_;
+    const int numThreads_;
+    std::unique_ptr<juce::ThreadPool> pool_;
+
+    mutable std::mutex mutex_;  // Everything below
+    std::vector<Block> queue_;  // Farthest first, so the nearest pops off the back
+    std::map<juce::String, std::shared_ptr<MappedFile>> files_;
+    std::map<juce::String, std::map<juce::int64, double>> fetched_;  // Block -> fetched at
+    juce::int64 blocksFetched_ = 0;
+    juce::int64 pagesTouched_ = 0;
+};
+
+}  // namespace magda
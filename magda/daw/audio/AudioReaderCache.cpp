@@ -0,0 +1,96 @@
+#include "AudioReaderCache.hpp"
+
+namespace magda {
+
+AudioReaderCache::AudioReaderCache() {
+    formatManager_.registerBasicFormats();
+}
+
+AudioReaderCache& AudioReaderCache::getInstance() {
+    static AudioReaderCache instance;
+    return instance;
+}
+
+AudioReaderCache::Entry* AudioReaderCache::getEntry(const juce::File& audioFile) {
+    const auto path = audioFile.getFullPathName();
+    const auto modificationTime = audioFile.getLastModificationTime();
+    const auto size = audioFile.getSize();
+
+    auto it = readers_.find(path);
+    if (it != readers_.end()) {
+        if (it->second.modificationTime == modificationTime && it->second.size == size) {
+            it->second.lastUsed = ++useCounter_;
+            return &it->second;
+        }
+        readers_.erase(it);  // Changed on disk: the old mapping is stale
+    }
+
+    if (!audioFile.existsAsFile()) {
+        return nullptr;
+    }
+
+    Entry entry;
+    entry.modificationTime = modificationTime;
+    entry.size = size;
+    entry.lastUsed = ++useCounter_;
+
+    if (auto* format = formatManager_.findFormatForFileExtension(audioFile.getFileExtension())) {
+        // Only uncompressed formats return a memory-mapped reader
+        std::unique_ptr<juce::MemoryMappedAudioFormatReader> mapped(
+            format->createMemoryMappedReader(audioFile));
+        if (mapped != nullptr && mapped->mapEntireFile()) {
+            entry.reader = std::move(mapped);
+            entry.memoryMapped = true;
+        }
+    }
+
+    if (entry.reader == nullptr) {
+        entry.reader.reset(formatManager_.createReaderFor(audioFile));
+    }
+
+    if (entry.reader == nullptr) {
+        return nullptr;
+    }
+
+    if (readers_.size() >= MAX_OPEN_READERS) {
+        evictLeastRecentlyUsed();
+    }
+
+    return &(readers_[path] = std::move(entry));
+}
+
+void AudioReaderCache::evictLeastRecentlyUsed() {
+    auto oldest = readers_.end();
+    for (auto it = readers_.begin(); it != readers_.end(); ++it) {
+        if (oldest == readers_.end() || it->second.lastUsed < oldest->second.lastUsed) {
+            oldest = it;
+        }
+    }
+    if (oldest != readers_.end()) {
+        readers_.erase(oldest);
+    }
+}
+
+juce::AudioFormatReader* AudioReaderCache::getReader(const juce::File& audioFile) {
+    auto* entry = getEntry(audioFile);
+    return entry != nullptr ? entry->reader.get() : nullptr;
+}
+
+bool AudioReaderCache::isMemoryMapped(const juce::File& audioFile) {
+    auto* entry = getEntry(audioFile);
+    return entry != nullptr && entry->memoryMapped;
+}
+
+void AudioReaderCache::release(const juce::File& audioFile) {
+    readers_.erase(audioFile.getFullPathName());
+}
+
+void AudioReaderCache::clear() {
+    readers_.clear();
+}
+
+void AudioReaderCache::shutdown() {
+    readers_.clear();
+}
+
+}  // namespace magda
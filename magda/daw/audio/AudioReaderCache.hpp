@@ -0,0 +1,75 @@
+#pragma once
+
+#include <juce_audio_formats/juce_audio_formats.h>
+
+#include <map>
+#include <memory>
+
+namespace magda {
+
+/**
+ * @brief Shared random-access audio readers for UI-side sample reads
+ *
+ * Uncompressed files (WAV/AIFF) get a juce::MemoryMappedAudioFormatReader mapped over the
+ * whole file, so reads come straight from the page cache with no stream buffer copies and
+ * no syscalls; other formats fall back to a streaming reader. One reader is kept per file
+ * and reopened if the file changes on disk.
+ *
+ * Readers are not thread-safe: use them on the message thread only. Engine playback reads
+ * through Tracktion's AudioFileCache, which maps the same files itself.
+ */
+class AudioReaderCache {
+  public:
+    static AudioReaderCache& getInstance();
+
+    /**
+     * @brief Get the reader for a file, opening it if needed
+     * @return The reader (owned by the cache; don't hold it across message-loop turns), or
+     *         nullptr if the file can't be read
+     */
+    juce::AudioFormatReader* getReader(const juce::File& audioFile);
+
+    /**
+     * @brief True if the file is read through a memory map
+     */
+    bool isMemoryMapped(const juce::File& audioFile);
+
+    /**
+     * @brief Close the reader for a file (e.g. before it is overwritten)
+     */
+    void release(const juce::File& audioFile);
+
+    void clear();
+
+    /**
+     * @brief Shutdown and release all resources
+     * Call during app shutdown to prevent JUCE leak detection issues
+     */
+    void shutdown();
+
+  private:
+    AudioReaderCache();
+    ~AudioReaderCache() = default;
+
+    struct Entry {
+        juce::Time modificationTime;
+        juce::int64 size = 0;
+        std::unique_ptr<juce::AudioFormatReader> reader;
+        bool memoryMapped = false;
+        juce::uint32 lastUsed = 0;
+    };
+
+    Entry* getEntry(const juce::File& audioFile);
+    void evictLeastRecentlyUsed();
+
+    juce::AudioFormatManager formatManager_;
+    std::map<juce::String, Entry> readers_;
+    juce::uint32 useCounter_ = 0;
+
+    // Each open reader holds a file handle and, when mapped, address space
+    static constexpr size_t MAX_OPEN_READERS = 64;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AudioReaderCache)
+};
+
+}  // namespace magda
@@ -0,0 +1,233 @@
+#include "AudioTaps.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <thread>
+
+namespace magda {
+
+namespace {
+
+constexpr uint64_t kRingMask = AudioTaps::kRingFrames - 1;
+
+// Copies count frames into or out of a ring starting at frame, wrapping at its end
+void copyIn(std::vector<float>& ring, uint64_t frame, const float* from, int count) {
+    const auto start = static_cast<size_t>(frame & kRingMask);
+    const auto first = std::min(static_cast<size_t>(count), ring.size() - start);
+    std::memcpy(ring.data() + start, from, first * sizeof(float));
+    std::memcpy(ring.data(), from + first, (static_cast<size_t>(count) - first) * sizeof(float));
+}
+
+void copyOut(const std::vector<float>& ring, uint64_t frame, float* to, int count) {
+    const auto start = static_cast<size_t>(frame & kRingMask);
+    const auto first = std::min(static_cast<size_t>(count), ring.size() - start);
+    std::memcpy(to, ring.data() + start, first * sizeof(float));
+    std::memcpy(to + first, ring.data(), (static_cast<size_t>(count) - first) * sizeof(float));
+}
+
+}  // namespace
+
+// =============================================================================
+// AudioTaps
+// =============================================================================
+
+AudioTaps::AudioTaps(bool runAnalysisThread)
+    : juce::Thread("Audio taps"), points_(std::make_unique<Point[]>(kNumPoints)) {
+    if (runAnalysisThread) {
+        startThread(juce::Thread::Priority::low);
+    }
+}
+
+AudioTaps::~AudioTaps() {
+    stopThread(2000);
+}
+
+Subscription AudioTaps::addTap(int point, std::shared_ptr<Analyser> analyser) {
+    if (point < 0 || point >= kNumPoints || analyser == nullptr) {
+        return {};
+    }
+
+    auto& slot = points_[static_cast<size_t>(point)];
+    auto it = std::find_if(slot.rings.begin(), slot.rings.end(),
+                           [](const auto& ring) { return ring.load() == nullptr; });
+    if (it == slot.rings.end()) {
+        return {};
+    }
+
+    int tapId = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tapId = ++nextTapId_;
+        auto& tap = taps_[tapId];
+        tap.point = point;
+        tap.ring = std::make_unique<Ring>();
+        tap.analyser = std::move(analyser);
+        it->store(tap.ring.get());
+    }
+    slot.numTaps.fetch_add(1);
+    notify();
+
+    return Subscription([this, tapId] { removeTap(tapId); });
+}
+
+void AudioTaps::removeTap(int tapId) {
+    // Holding the lock keeps the analysis thread off the tap while it goes
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = taps_.find(tapId);
+    if (it == taps_.end()) {
+        return;
+    }
+
+    auto& slot = points_[static_cast<size_t>(it->second.point)];
+    for (auto& ring : slot.rings) {
+        if (ring.load() == it->second.ring.get()) {
+            ring.store(nullptr);
+        }
+    }
+    slot.numTaps.fetch_sub(1);
+
+    // A write that started before the ring was unpublished may still be copying into it
+    while (slot.writers.load() != 0) {
+        std::this_thread::yield();
+    }
+    taps_.erase(it);
+}
+
+bool AudioTaps::isTapped(int point) const {
+    return point >= 0 && point < kNumPoints &&
+           points_[static_cast<size_t>(point)].numTaps.load(std::memory_order_relaxed) > 0;
+}
+
+int AudioTaps::getNumTaps() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return static_cast<int>(taps_.size());
+}
+
+void AudioTaps::write(int point, const float* const* channels, int numChannels, int numSamples,
+                      double sampleRate) noexcept {
+    if (!isTapped(point) || numChannels <= 0 || numSamples <= 0) {
+        return;
+    }
+
+    auto& slot = points_[static_cast<size_t>(point)];
+    // Announce the write before reading the rings; removeTap() waits on it
+    slot.writers.fetch_add(1);
+    const float* left = channels[0];
+    const float* right = numChannels > 1 ? channels[1] : channels[0];
+    for (auto& published : slot.rings) {
+        auto* ring = published.load();
+        if (ring == nullptr) {
+            continue;
+        }
+        const auto written = ring->written.load(std::memory_order_relaxed);
+        // Never more than a ring at once; a longer block keeps its end
+        const int count = std::min(numSamples, kRingFrames);
+        const int skip = numSamples - count;
+        copyIn(ring->left, written, left + skip, count);
+        copyIn(ring->right, written, right + skip, count);
+        ring->sampleRate.store(sampleRate, std::memory_order_relaxed);
+        ring->written.store(written + static_cast<uint64_t>(count), std::memory_order_release);
+    }
+    slot.writers.fetch_sub(1);
+}
+
+void AudioTaps::analyse() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& [tapId, tap] : taps_) {
+        drain(tap);
+    }
+}
+
+void AudioTaps::drain(Tap& tap) {
+    const auto written = tap.ring->written.load(std::memory_order_acquire);
+    if (written == tap.read) {
+        return;
+    }
+
+    const double sampleRate = tap.ring->sampleRate.load(std::memory_order_relaxed);
+    if (sampleRate != tap.preparedRate) {
+        tap.preparedRate = sampleRate;
+        tap.analyser->prepare(sampleRate);
+    }
+
+    // Fallen behind: the oldest half of the ring may be overwritten while it's read
+    const auto maxBehind = static_cast<uint64_t>(kRingFrames / 2);
+    if (written - tap.read > maxBehind) {
+        tap.read = written - maxBehind;
+    }
+
+    const auto count = static_cast<int>(written - tap.read);
+    copyOut(tap.ring->left, tap.read, scratchLeft_.data(), count);
+    copyOut(tap.ring->right, tap.read, scratchRight_.data(), count);
+    tap.read = written;
+    tap.analyser->process(scratchLeft_.data(), scratchRight_.data(), count);
+}
+
+void AudioTaps::run() {
+    while (!threadShouldExit()) {
+        analyse();
+
+        // Idle until a tap is added; then at about the rate views repaint
+        bool tapped = false;
+        for (int point = 0; point < kNumPoints && !tapped; ++point) {
+            tapped = isTapped(point);
+        }
+        wait(tapped ? kPollMs : -1);
+    }
+}
+
+// =============================================================================
+// ScopeAnalyser
+// =============================================================================
+
+void ScopeAnalyser::prepare(double /*sampleRate*/) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::fill(left_.begin(), left_.end(), 0.0f);
+    std::fill(right_.begin(), right_.end(), 0.0f);
+    next_ = 0;
+}
+
+void ScopeAnalyser::process(const float* left, const float* right, int numSamples) {
+    // Only the newest kScopeFrames can be seen
+    const int count = std::min(numSamples, kScopeFrames);
+    const int skip = numSamples - count;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (int i = 0; i < count; ++i) {
+        left_[next_] = left[skip + i];
+        right_[next_] = right[skip + i];
+        next_ = (next_ + 1) % left_.size();
+    }
+}
+
+ScopeAnalyser::Snapshot ScopeAnalyser::getSnapshot() const {
+    Snapshot snapshot;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        snapshot.left.reserve(left_.size());
+        snapshot.right.reserve(right_.size());
+        snapshot.left.insert(snapshot.left.end(), left_.begin() + static_cast<long>(next_),
+                             left_.end());
+        snapshot.left.insert(snapshot.left.end(), left_.begin(),
+                             left_.begin() + static_cast<long>(next_));
+        snapshot.right.insert(snapshot.right.end(), right_.begin() + static_cast<long>(next_),
+                              right_.end());
+        snapshot.right.insert(snapshot.right.end(), right_.begin(),
+                              right_.begin() + static_cast<long>(next_));
+    }
+
+    double sumLR = 0.0;
+    double sumLL = 0.0;
+    double sumRR = 0.0;
+    for (size_t i = 0; i < snapshot.left.size(); ++i) {
+        sumLR += snapshot.left[i] * snapshot.right[i];
+        sumLL += snapshot.left[i] * snapshot.left[i];
+        sumRR += snapshot.right[i] * snapshot.right[i];
+    }
+    const double energy = std::sqrt(sumLL * sumRR);
+    snapshot.correlation = energy > 0.0 ? static_cast<float>(sumLR / energy) : 0.0f;
+    return snapshot;
+}
+
+}  // namespace magda
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "../core/Subscription.hpp"
+
+namespace magda {
+
+/**
+ * @brief Audio from track and master outputs, copied out for visualisers and analysers
+ *
+ * A view that wants to see a signal (a spectrum, a scope, a correlation meter, a mod's
+ * input) adds a tap with an Analyser on a point: a track's output or the master's. The
+ * point's TrackMeterPlugin, which sees every rendered block anyway, copies the block into
+ * each of the point's rings; a point nobody taps costs it one relaxed load per block. A
+ * shared analysis thread drains the rings about 60 times a second into their analysers,
+ * which keep whatever their views draw, so no FFT or analysis runs on a render thread or
+ * in paint().
+ *
+ * The writer never waits: if the analysis thread falls more than half a ring behind, it
+ * skips ahead to the newest audio.
+ *
+ * Threading: addTap() and resetting its Subscription on the message thread (a reset waits
+ * for an in-flight write or analysis of that tap); write() on render threads, wait-free;
+ * analysers and analyse() on the analysis thread.
+ */
+class AudioTaps : private juce::Thread {
+  public:
+    static constexpr int kMaxTracks = 256;           // Track IDs at or past this can't be tapped
+    static constexpr int kMasterPoint = kMaxTracks;  // The master output's point
+    static constexpr int kNumPoints = kMaxTracks + 1;
+    static constexpr int kMaxTapsPerPoint = 4;
+    static constexpr int kRingFrames = 1 << 15;  // About 0.7 s at 48 kHz; power of two
+    static constexpr int kPollMs = 16;
+
+    /**
+     * @brief Receives a point's audio on the analysis thread
+     */
+    class Analyser {
+      public:
+        virtual ~Analyser() = default;
+
+        /**
+         * @brief Before the first audio, and whenever the point's sample rate changes
+         */
+        virtual void prepare(double sampleRate) = 0;
+
+        /**
+         * @brief The next stretch of audio, in order; right is left for a mono point
+         */
+        virtual void process(const float* left, const float* right, int numSamples) = 0;
+    };
+
+    /**
+     * @param runAnalysisThread False to drain only through analyse() (tests)
+     */
+    explicit AudioTaps(bool runAnalysisThread = true);
+    ~AudioTaps() override;
+
+    AudioTaps(const AudioTaps&) = delete;
+    AudioTaps& operator=(const AudioTaps&) = delete;
+
+    /**
+     * @brief Feed an analyser from a point (a TrackId, or kMasterPoint)
+     * @return The tap, removed when the subscription is reset; empty if the point is out of
+     *         range or already has kMaxTapsPerPoint taps
+     */
+    Subscription addTap(int point, std::shared_ptr<Analyser> analyser);
+
+    bool isTapped(int point) const;
+
+    /**
+     * @brief Copy a rendered block into the point's taps (render thread, wait-free)
+     */
+    void write(int point, const float* const* channels, int numChannels, int numSamples,
+               double sampleRate) noexcept;
+
+    /**
+     * @brief Hand every tap's new audio to its analyser (what the analysis thread runs)
+     */
+    void analyse();
+
+    int getNumTaps() const;
+
+  private:
+    struct Ring {
+        std::vector<float> left = std::vector<float>(kRingFrames);
+        std::vector<float> right = std::vector<float>(kRingFrames);
+        std::atomic<uint64_t> written{0};  // Frames ever written (render thread)
+        std::atomic<double> sampleRate{0.0};
+    };
+
+    struct Tap {
+        int point = 0;
+        std::unique_ptr<Ring> ring;
+        std::shared_ptr<Analyser> analyser;
+        uint64_t read = 0;  // Analysis thread
+        double preparedRate = 0.0;
+    };
+
+    struct alignas(64) Point {
+        std::atomic<int> numTaps{0};
+        std::array<std::atomic<Ring*>, kMaxTapsPerPoint> rings{};
+        std::atomic<int> writers{0};  // Writes in flight; a removal waits for them
+    };
+
+    void run() override;
+    void removeTap(int tapId);
+    void drain(Tap& tap);
+
+    std::unique_ptr<Point[]> points_;
+
+    mutable std::mutex mutex_;  // taps_, against the analysis thread
+    std::map<int, Tap> taps_;
+    int nextTapId_ = 0;
+
+    // Analysis thread: the stretch being handed over
+    std::vector<float> scratchLeft_ = std::vector<float>(kRingFrames / 2);
+    std::vector<float> scratchRight_ = std::vector<float>(kRingFrames / 2);
+};
+
+/**
+ * @brief The latest stretch of a point's audio and its stereo correlation, for scopes
+ *
+ * Analysis thread writes, views read copies with getSnapshot().
+ */
+class ScopeAnalyser : public AudioTaps::Analyser {
+  public:
+    static constexpr int kScopeFrames = 2048;
+
+    struct Snapshot {
+        std::vector<float> left;   // Oldest first, kScopeFrames long
+        std::vector<float> right;
+        float correlation = 0.0f;  // -1 (out of phase) to 1 (mono) over the stretch
+    };
+
+    void prepare(double sampleRate) override;
+    void process(const float* left, const float* right, int numSamples) override;
+
+    Snapshot getSnapshot() const;
+
+  private:
+    mutable std::mutex mutex_;
+    std::vector<float> left_ = std::vector<float>(kScopeFrames);
+    std::vector<float> right_ = std::vector<float>(kScopeFrames);
+    size_t next_ = 0;  // Where the next frame goes; left_[next_] is the oldest
+};
+
+}  // namespace magda
@@ -1,14 +1,150 @@
 #include "AudioThumbnailManager.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "../core/Config.hpp"
+#include "../profiling/LoadProfiler.hpp"
+#include "AudioReaderCache.hpp"
+
 namespace magda {
 
+namespace {
+
+constexpr int kBuildBlockSize = 65536;
+
+/**
+ * @brief Draw one column per pixel, each channel in its own horizontal band
+ *
+ * getColumn(x, ranges) fills a PeakPyramid::Range per channel for pixel x and returns
+ * false past the end of the audio. RMS is drawn inside the peak where it is known. Columns
+ * outside the context's clip region are skipped.
+ */
+template <typename GetColumn>
+void drawColumns(juce::Graphics& g, const juce::Rectangle<int>& bounds, int numChannels,
+                 const juce::Colour& colour, float verticalZoom, GetColumn&& getColumn) {
+    if (numChannels <= 0)
+        return;
+
+    const float bandHeight = static_cast<float>(bounds.getHeight()) / numChannels;
+    std::vector<PeakPyramid::Range> ranges(static_cast<size_t>(numChannels));
+    juce::RectangleList<float> peaks;
+    juce::RectangleList<float> rms;
+
+    // Only the columns inside the clip region (e.g. one cached tile of a wide clip)
+    const auto visible = g.getClipBounds().getIntersection(bounds);
+    const int firstColumn = visible.getX() - bounds.getX();
+    const int endColumn = visible.getRight() - bounds.getX();
+
+    for (int x = firstColumn; x < endColumn; ++x) {
+        if (!getColumn(x, ranges.data()))
+            break;
+
+        const auto left = static_cast<float>(bounds.getX() + x);
+        for (int ch = 0; ch < numChannels; ++ch) {
+            const auto& range = ranges[static_cast<size_t>(ch)];
+            const float halfHeight = bandHeight * 0.5f;
+            const float midY = static_cast<float>(bounds.getY()) + bandHeight * ch + halfHeight;
+
+            const float top =
+                midY - juce::jlimit(-1.0f, 1.0f, range.max * verticalZoom) * halfHeight;
+            const float bottom =
+                midY - juce::jlimit(-1.0f, 1.0f, range.min * verticalZoom) * halfHeight;
+            peaks.addWithoutMerging({left, top, 1.0f, std::max(1.0f, bottom - top)});
+
+            if (range.rms > 0.0f) {
+                const float rmsHeight = std::min(1.0f, range.rms * verticalZoom) * halfHeight;
+                rms.addWithoutMerging({left, midY - rmsHeight, 1.0f, rmsHeight * 2.0f});
+            }
+        }
+    }
+
+    g.setColour(colour);
+    g.fillRectList(peaks);
+    g.setColour(colour.brighter(0.4f));
+    g.fillRectList(rms);
+}
+
+}  // namespace
+
+// =============================================================================
+// PyramidBuildJob
+// =============================================================================
+
+/**
+ * @brief Reads an audio file once on a pool thread, builds its pyramid and saves it
+ */
+class AudioThumbnailManager::PyramidBuildJob : public juce::ThreadPoolJob {
+  public:
+    PyramidBuildJob(juce::AudioFormatManager& formatManager, Symbol audioFilePath,
+                    juce::int64 peakHash, std::shared_ptr<std::atomic<bool>> alive)
+        : juce::ThreadPoolJob("Build peaks"),
+          formatManager_(formatManager),
+          audioFilePath_(audioFilePath),
+          peakHash_(peakHash),
+          alive_(std::move(alive)) {}
+
+    JobStatus runJob() override {
+        const double startMs = juce::Time::getMillisecondCounterHiRes();
+        std::shared_ptr<PeakPyramid> pyramid;
+
+        std::unique_ptr<juce::AudioFormatReader> reader(
+            formatManager_.createReaderFor(juce::File(audioFilePath_.getString())));
+        if (reader != nullptr && reader->numChannels > 0) {
+            pyramid = std::make_shared<PeakPyramid>();
+            const int numChannels = static_cast<int>(reader->numChannels);
+            pyramid->begin(numChannels, reader->sampleRate);
+
+            juce::AudioBuffer<float> buffer(numChannels, kBuildBlockSize);
+            for (juce::int64 pos = 0; pos < reader->lengthInSamples; pos += kBuildBlockSize) {
+                if (shouldExit())
+                    return jobHasFinished;
+
+                const auto count = static_cast<int>(
+                    std::min<juce::int64>(kBuildBlockSize, reader->lengthInSamples - pos));
+                reader->read(&buffer, 0, count, pos, true, true);
+                pyramid->addSamples(buffer.getArrayOfReadPointers(), count);
+            }
+            pyramid->finish();
+
+            savePeakFile(getPeakFile(peakHash_), *pyramid);
+        }
+        LoadProfiler::getInstance().recordItem(
+            "Thumbnail", juce::File(audioFilePath_.getString()).getFileName() + " (built)", startMs,
+            juce::Time::getMillisecondCounterHiRes() - startMs, pyramid != nullptr);
+
+        auto alive = alive_;
+        auto path = audioFilePath_;
+        auto hash = peakHash_;
+        juce::MessageManager::callAsync([alive, path, hash, pyramid]() {
+            if (alive->load()) {
+                AudioThumbnailManager::getInstance().pyramidBuilt(path, hash, pyramid);
+            }
+        });
+        return jobHasFinished;
+    }
+
+  private:
+    juce::AudioFormatManager& formatManager_;
+    Symbol audioFilePath_;
+    juce::int64 peakHash_;
+    std::shared_ptr<std::atomic<bool>> alive_;
+};
+
+// =============================================================================
+// AudioThumbnailManager
+// =============================================================================
+
 AudioThumbnailManager::AudioThumbnailManager() {
     // Register standard audio formats
     formatManager_.registerBasicFormats();
 
-    // Create thumbnail cache with max 100 thumbnails in memory
-    // Thumbnails are also cached to disk in a temp directory
-    thumbnailCache_ = std::make_unique<juce::AudioThumbnailCache>(100);
+    prunePeakCache(getPeakCacheDirectory());
+
+    // Peak building is mostly file I/O; a few threads let several files build at once
+    buildPool_ =
+        std::make_unique<juce::ThreadPool>(juce::jlimit(1, 4, juce::SystemStats::getNumCpus() / 2));
 }
 
 AudioThumbnailManager& AudioThumbnailManager::getInstance() {
@@ -16,91 +152,364 @@ AudioThumbnailManager& AudioThumbnailManager::getInstance() {
     return instance;
 }
 
-juce::AudioThumbnail* AudioThumbnailManager::getThumbnail(const juce::String& audioFilePath) {
-    // Check if thumbnail already exists in cache
-    auto it = thumbnails_.find(audioFilePath);
-    if (it != thumbnails_.end()) {
-        return it->second.get();
+juce::File AudioThumbnailManager::getPeakCacheDirectory() {
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+        .getChildFile("MAGDA")
+        .getChildFile("PeakCache");
+}
+
+juce::int64 AudioThumbnailManager::getPeakHash(const juce::File& audioFile) {
+    // Include the resolution so a change to it never loads incompatible peak data
+    auto key = audioFile.getFullPathName() + "|" +
+               juce::String(audioFile.getLastModificationTime().toMilliseconds()) + "|" +
+               juce::String(audioFile.getSize()) + "|" +
+               juce::String(PeakPyramid::BASE_SAMPLES_PER_PEAK);
+    return key.hashCode64();
+}
+
+juce::File AudioThumbnailManager::getPeakFile(juce::int64 peakHash) {
+    return getPeakCacheDirectory().getChildFile(juce::String::toHexString(peakHash) + ".peaks");
+}
+
+bool AudioThumbnailManager::hasPeaks(const juce::File& audioFile) {
+    return getPeakFile(getPeakHash(audioFile)).existsAsFile();
+}
+
+void AudioThumbnailManager::savePeaks(const juce::File& audioFile, const PeakPyramid& pyramid) {
+    savePeakFile(getPeakFile(getPeakHash(audioFile)), pyramid);
+}
+
+std::shared_ptr<const PeakPyramid> AudioThumbnailManager::loadPeakFile(const juce::File& peakFile) {
+    if (!peakFile.existsAsFile()) {
+        return nullptr;
+    }
+
+    juce::MemoryBlock data;
+    auto pyramid = std::make_shared<PeakPyramid>();
+    if (!peakFile.loadFileAsData(data) || !pyramid->deserialise(data.getData(), data.getSize())) {
+        peakFile.deleteFile();  // Corrupt or from an incompatible version
+        return nullptr;
+    }
+
+    // Touch so pruning keeps recently used files
+    peakFile.setLastModificationTime(juce::Time::getCurrentTime());
+    return pyramid;
+}
+
+void AudioThumbnailManager::savePeakFile(const juce::File& peakFile,
+                                         const PeakPyramid& pyramid) {
+    auto directory = peakFile.getParentDirectory();
+    if (!directory.isDirectory() && !directory.createDirectory()) {
+        return;
     }
 
-    // Create new thumbnail
-    return createThumbnail(audioFilePath);
+    std::vector<char> data;
+    pyramid.serialise(data);
+
+    // Write to a temporary file first so a crash never leaves a truncated peak file
+    juce::TemporaryFile temp(peakFile);
+    if (temp.getFile().replaceWithData(data.data(), data.size())) {
+        temp.overwriteTargetFileWithTemporary();
+    }
+}
+
+void AudioThumbnailManager::prunePeakCache(const juce::File& directory) {
+    if (!directory.isDirectory()) {
+        return;
+    }
+
+    auto peakFiles =
+        directory.findChildFiles(juce::File::findFiles, false, "*.peak*;*.spectra;*.tempo");
+    if (peakFiles.size() <= MAX_PEAK_FILES) {
+        return;
+    }
+
+    // Oldest first (loading a peak file touches it)
+    std::sort(peakFiles.begin(), peakFiles.end(), [](const juce::File& a, const juce::File& b) {
+        return a.getLastModificationTime() < b.getLastModificationTime();
+    });
+
+    for (int i = 0; i < peakFiles.size() - MAX_PEAK_FILES; ++i) {
+        peakFiles.getReference(i).deleteFile();
+    }
 }
 
-juce::AudioThumbnail* AudioThumbnailManager::createThumbnail(const juce::String& audioFilePath) {
+AudioThumbnailManager::WaveformSource* AudioThumbnailManager::getSource(Symbol audioFilePath) {
+    // Check if this file is already known
+    auto it = sources_.find(audioFilePath);
+    if (it != sources_.end()) {
+        return it->second.get();
+    }
+
+    if (!buildPool_) {
+        return nullptr;  // Shut down
+    }
+
     // Validate file exists
-    juce::File audioFile(audioFilePath);
+    juce::File audioFile(audioFilePath.getString());
     if (!audioFile.existsAsFile()) {
-        DBG("AudioThumbnailManager: File not found: " << audioFilePath);
+        DBG("AudioThumbnailManager: File not found: " << audioFilePath.getString());
         return nullptr;
     }
 
-    // Create new AudioThumbnail
-    // 512 samples per thumbnail point is a good balance for performance and quality
-    auto thumbnail =
-        std::make_unique<juce::AudioThumbnail>(512,              // samples per thumbnail point
-                                               formatManager_,   // format manager for reading files
-                                               *thumbnailCache_  // cache for storing thumbnail data
-        );
-
-    // Load the audio file into the thumbnail
-    auto* reader = formatManager_.createReaderFor(audioFile);
+    // Opening a reader only parses the header
+    auto* reader = AudioReaderCache::getInstance().getReader(audioFile);
     if (reader == nullptr) {
-        DBG("AudioThumbnailManager: Could not create reader for: " << audioFilePath);
+        DBG("AudioThumbnailManager: Could not create reader for: " << audioFilePath.getString());
         return nullptr;
     }
 
-    // Set the reader with hash code for caching
-    // Thumbnail loads asynchronously - drawWaveform handles the not-yet-loaded case
-    thumbnail->setReader(reader, audioFile.hashCode64());
+    auto source = std::make_unique<WaveformSource>();
+    source->peakHash = getPeakHash(audioFile);
+    source->sampleRate = reader->sampleRate;
+    source->lengthInSamples = reader->lengthInSamples;
+    source->numChannels = static_cast<int>(reader->numChannels);
+
+    DBG("AudioThumbnailManager: Opened " << audioFilePath.getString()
+                                         << " (channels: " << source->numChannels << ")");
+
+    auto* sourcePtr = source.get();
+    sources_[audioFilePath] = std::move(source);
+    return sourcePtr;
+}
+
+void AudioThumbnailManager::requestPyramid(Symbol audioFilePath, WaveformSource& source) {
+    source.lastUsed = ++useClock_;
+
+    if (source.pyramid != nullptr) {
+        ++cacheHits_;
+        return;
+    }
+    if (source.building || source.buildFailed || !buildPool_) {
+        return;
+    }
+
+    ++cacheMisses_;
+
+    // A matching peak file draws immediately; otherwise build in the background
+    const double startMs = juce::Time::getMillisecondCounterHiRes();
+    auto pyramid = loadPeakFile(getPeakFile(source.peakHash));
+    if (pyramid != nullptr) {
+        LoadProfiler::getInstance().recordItem(
+            "Thumbnail", juce::File(audioFilePath.getString()).getFileName() + " (peak file)",
+            startMs,
+            juce::Time::getMillisecondCounterHiRes() - startMs, true);
+        setPyramid(source, std::move(pyramid));
+        evictToBudget(&source);
+        return;
+    }
+
+    source.building = true;
+    buildPool_->addJob(
+        new PyramidBuildJob(formatManager_, audioFilePath, source.peakHash, alive_), true);
+}
+
+void AudioThumbnailManager::setPyramid(WaveformSource& source,
+                                       std::shared_ptr<const PeakPyramid> pyramid) {
+    residentBytes_ -= source.pyramidBytes;
+    source.pyramid = std::move(pyramid);
+    source.pyramidBytes = source.pyramid != nullptr ? source.pyramid->getMemoryUsage() : 0;
+    residentBytes_ += source.pyramidBytes;
+}
+
+size_t AudioThumbnailManager::getBudgetBytes() {
+    const auto megabytes = std::max(0, Config::getInstance().getWaveformCacheSizeMB());
+    return static_cast<size_t>(megabytes) * 1024 * 1024;
+}
+
+void AudioThumbnailManager::evictToBudget(const WaveformSource* keep) {
+    const size_t budget = getBudgetBytes();
+
+    while (residentBytes_ > budget) {
+        // Least recently drawn first; a linear scan is fine for a project's worth of files
+        WaveformSource* victim = nullptr;
+        for (auto& [path, source] : sources_) {
+            if (source->pyramid == nullptr || source->retainCount > 0 || source.get() == keep)
+                continue;
+            if (victim == nullptr || source->lastUsed < victim->lastUsed)
+                victim = source.get();
+        }
+
+        if (victim == nullptr) {
+            return;  // Everything left is on screen
+        }
+
+        setPyramid(*victim, nullptr);
+        ++cacheEvictions_;
+    }
+}
+
+void AudioThumbnailManager::pyramidBuilt(Symbol audioFilePath, juce::int64 peakHash,
+                                         std::shared_ptr<const PeakPyramid> pyramid) {
+    auto it = sources_.find(audioFilePath);
+    if (it == sources_.end() || it->second->peakHash != peakHash) {
+        return;  // Cleared, or the file changed since
+    }
+
+    auto& source = *it->second;
+    source.building = false;
+    source.buildFailed = pyramid == nullptr;
+    setPyramid(source, std::move(pyramid));
+    evictToBudget(&source);
+    thumbnailsChanged_.sendChangeMessage();
+}
+
+void AudioThumbnailManager::retainWaveform(Symbol audioFilePath) {
+    if (auto* source = getSource(audioFilePath)) {
+        ++source->retainCount;
+    }
+}
+
+void AudioThumbnailManager::releaseWaveform(Symbol audioFilePath) {
+    auto it = sources_.find(audioFilePath);
+    if (it == sources_.end() || it->second->retainCount == 0) {
+        return;  // Cleared while retained
+    }
+
+    // Anything kept over budget only because it was on screen can go now
+    if (--it->second->retainCount == 0) {
+        evictToBudget(nullptr);
+    }
+}
+
+AudioThumbnailManager::CacheStats AudioThumbnailManager::getCacheStats() const {
+    CacheStats stats;
+    stats.hits = cacheHits_;
+    stats.misses = cacheMisses_;
+    stats.evictions = cacheEvictions_;
+    stats.residentBytes = residentBytes_;
+    stats.budgetBytes = getBudgetBytes();
+
+    for (const auto& [path, source] : sources_) {
+        if (source->pyramid != nullptr)
+            ++stats.numResident;
+        if (source->retainCount > 0)
+            ++stats.numRetained;
+    }
+    return stats;
+}
+
+std::shared_ptr<const PeakPyramid> AudioThumbnailManager::getPeakPyramid(Symbol audioFilePath) {
+    auto* source = getSource(audioFilePath);
+    if (source == nullptr) {
+        return nullptr;
+    }
+    requestPyramid(audioFilePath, *source);
+    return source->pyramid;
+}
 
-    // Store in cache
-    auto* thumbnailPtr = thumbnail.get();
-    thumbnails_[audioFilePath] = std::move(thumbnail);
+double AudioThumbnailManager::getFileDuration(Symbol audioFilePath) {
+    auto* source = getSource(audioFilePath);
+    if (source == nullptr || source->sampleRate <= 0.0) {
+        return 0.0;
+    }
+    return static_cast<double>(source->lengthInSamples) / source->sampleRate;
+}
 
-    DBG("AudioThumbnailManager: Created thumbnail for "
-        << audioFilePath << " (channels: " << thumbnailPtr->getNumChannels()
-        << ", length: " << thumbnailPtr->getTotalLength() << "s)");
+void AudioThumbnailManager::addListener(juce::ChangeListener* listener) {
+    thumbnailsChanged_.addChangeListener(listener);
+}
 
-    return thumbnailPtr;
+void AudioThumbnailManager::removeListener(juce::ChangeListener* listener) {
+    thumbnailsChanged_.removeChangeListener(listener);
 }
 
 void AudioThumbnailManager::drawWaveform(juce::Graphics& g, const juce::Rectangle<int>& bounds,
-                                         const juce::String& audioFilePath, double startTime,
-                                         double endTime, const juce::Colour& colour,
-                                         float verticalZoom) {
+                                         Symbol audioFilePath, double startTime, double endTime,
+                                         const juce::Colour& colour, float verticalZoom) {
     if (bounds.getWidth() <= 0 || bounds.getHeight() <= 0)
         return;
 
-    auto* thumbnail = getThumbnail(audioFilePath);
-    if (thumbnail == nullptr || !thumbnail->isFullyLoaded()) {
-        // Draw placeholder if thumbnail not ready
-        g.setColour(colour.withAlpha(0.3f));
-        g.drawText("Loading...", bounds, juce::Justification::centred);
+    auto* source = getSource(audioFilePath);
+    if (source == nullptr || source->sampleRate <= 0.0) {
         return;
     }
+    requestPyramid(audioFilePath, *source);
 
     // Clamp times to valid range
-    double totalLength = thumbnail->getTotalLength();
+    const double totalLength = static_cast<double>(source->lengthInSamples) / source->sampleRate;
     startTime = juce::jlimit(0.0, totalLength, startTime);
     endTime = juce::jlimit(startTime, totalLength, endTime);
 
-    // Draw the waveform
-    g.setColour(colour);
+    const double startSample = startTime * source->sampleRate;
+    const double samplesPerPixel = (endTime - startTime) * source->sampleRate / bounds.getWidth();
+    if (samplesPerPixel <= 0.0) {
+        return;
+    }
+
+    const auto length = static_cast<double>(source->lengthInSamples);
+    const int numChannels = source->numChannels;
+    const int level = source->pyramid ? source->pyramid->chooseLevel(samplesPerPixel) : -1;
+
+    if (level >= 0) {
+        // Each pixel aggregates one or two peaks of the chosen level
+        const auto& pyramid = *source->pyramid;
+        drawColumns(g, bounds, numChannels, colour, verticalZoom,
+                    [&](int x, PeakPyramid::Range* ranges) {
+                        const double s0 = startSample + x * samplesPerPixel;
+                        if (s0 >= length)
+                            return false;
+                        const auto first = static_cast<juce::int64>(s0);
+                        const auto last = static_cast<juce::int64>(std::ceil(s0 + samplesPerPixel));
+                        for (int ch = 0; ch < numChannels; ++ch)
+                            ranges[ch] = pyramid.getRange(level, ch, first, last);
+                        return true;
+                    });
+        return;
+    }
+
+    if (source->pyramid == nullptr && samplesPerPixel >= PeakPyramid::BASE_SAMPLES_PER_PEAK) {
+        // Too far out to scan raw samples while peaks are still building
+        if (source->building) {
+            g.setColour(colour.withAlpha(0.3f));
+            g.drawText("Loading...", bounds, juce::Justification::centred);
+        }
+        return;
+    }
 
-    // Draw all channels (stereo files will show both channels mixed)
-    thumbnail->drawChannels(g, bounds, startTime, endTime, verticalZoom);
+    // Zoomed in past the finest level: read the samples under each pixel directly. For
+    // WAV/AIFF this scans the memory map in place
+    auto* sampleReader =
+        AudioReaderCache::getInstance().getReader(juce::File(audioFilePath.getString()));
+    if (sampleReader == nullptr) {
+        return;
+    }
+
+    std::vector<juce::Range<float>> levels(static_cast<size_t>(numChannels));
+    auto& reader = *sampleReader;
+    drawColumns(g, bounds, numChannels, colour, verticalZoom,
+                [&](int x, PeakPyramid::Range* ranges) {
+                    const double s0 = startSample + x * samplesPerPixel;
+                    if (s0 >= length)
+                        return false;
+                    const auto first = static_cast<juce::int64>(s0);
+                    const auto count = std::max<juce::int64>(
+                        1, static_cast<juce::int64>(std::ceil(s0 + samplesPerPixel)) - first);
+                    reader.readMaxLevels(first, count, levels.data(), numChannels);
+                    for (int ch = 0; ch < numChannels; ++ch) {
+                        ranges[ch].min = levels[static_cast<size_t>(ch)].getStart();
+                        ranges[ch].max = levels[static_cast<size_t>(ch)].getEnd();
+                        ranges[ch].rms = 0.0f;
+                    }
+                    return true;
+                });
 }
 
 void AudioThumbnailManager::clearCache() {
-    thumbnails_.clear();
-    thumbnailCache_->clear();
+    sources_.clear();
+    residentBytes_ = 0;
+    AudioReaderCache::getInstance().clear();
     DBG("AudioThumbnailManager: Cache cleared");
 }
 
 void AudioThumbnailManager::shutdown() {
-    thumbnails_.clear();
-    thumbnailCache_.reset();
+    alive_->store(false);
+    if (buildPool_) {
+        buildPool_->removeAllJobs(true, 2000);
+        buildPool_.reset();
+    }
+    sources_.clear();
+    residentBytes_ = 0;
 }
 
 }  // namespace magda
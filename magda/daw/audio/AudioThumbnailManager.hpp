@@ -1,31 +1,59 @@
 #pragma once
 
 #include <juce_audio_formats/juce_audio_formats.h>
-#include <juce_audio_utils/juce_audio_utils.h>
 #include <juce_gui_basics/juce_gui_basics.h>
 
-#include <map>
+#include <atomic>
 #include <memory>
 #include <string>
+#include <unordered_map>
+
+#include "../core/Symbol.hpp"
+#include "PeakPyramid.hpp"
 
 namespace magda {
 
 /**
  * @brief Manages audio waveform thumbnails for visualization
  *
- * Provides caching and rendering of audio waveforms using JUCE's AudioThumbnail.
- * Thumbnails are cached by file path for efficient reuse across clips using the same audio file.
+ * Each audio file gets a PeakPyramid (min/max/RMS at power-of-two decimations), cached by
+ * file path for reuse across clips using the same audio file. Paths are interned (Symbol),
+ * so per-paint lookups hash an integer rather than a path; callers that draw often hold the
+ * Symbol. drawWaveform picks the level matching the zoom, so paint cost follows the pixel
+ * width rather than the audio length; zoomed in past the finest level it reads raw samples
+ * through the shared AudioReaderCache (memory-mapped for WAV/AIFF).
+ *
+ * Pyramids are built on a small pool of background threads and written to a peak file in
+ * the user's cache directory keyed by path, modification time and size. A reopened project
+ * loads those files instead of re-reading the audio, so its waveforms draw immediately.
+ * Listeners are notified when a pyramid finishes building.
+ *
+ * Resident peak data is bounded by Config's waveform cache size. Past it, the least recently
+ * drawn pyramids are dropped (their peak files stay on disk, so re-showing them is a file
+ * load rather than a rebuild). Files shown by a ClipComponent are retained and never
+ * evicted, even if that means running over budget.
  */
 class AudioThumbnailManager {
   public:
     static AudioThumbnailManager& getInstance();
 
     /**
-     * @brief Get or create a thumbnail for an audio file
+     * @brief Get the peak pyramid for an audio file, starting to build it if needed
      * @param audioFilePath Absolute path to the audio file
-     * @return Pointer to the AudioThumbnail, or nullptr if file couldn't be loaded
+     * @return The pyramid, or nullptr while it is being built or if the file can't be read
+     */
+    std::shared_ptr<const PeakPyramid> getPeakPyramid(Symbol audioFilePath);
+    std::shared_ptr<const PeakPyramid> getPeakPyramid(const juce::String& audioFilePath) {
+        return getPeakPyramid(Symbol(audioFilePath));
+    }
+
+    /**
+     * @brief Length of an audio file in seconds (from its header; 0 if unreadable)
      */
-    juce::AudioThumbnail* getThumbnail(const juce::String& audioFilePath);
+    double getFileDuration(Symbol audioFilePath);
+    double getFileDuration(const juce::String& audioFilePath) {
+        return getFileDuration(Symbol(audioFilePath));
+    }
 
     /**
      * @brief Draw the waveform for an audio file
@@ -37,11 +65,55 @@ class AudioThumbnailManager {
      * @param colour Color to use for drawing the waveform
      */
     void drawWaveform(juce::Graphics& g, const juce::Rectangle<int>& bounds,
-                      const juce::String& audioFilePath, double startTime, double endTime,
+                      Symbol audioFilePath, double startTime, double endTime,
                       const juce::Colour& colour, float verticalZoom = 1.0f);
+    void drawWaveform(juce::Graphics& g, const juce::Rectangle<int>& bounds,
+                      const juce::String& audioFilePath, double startTime, double endTime,
+                      const juce::Colour& colour, float verticalZoom = 1.0f) {
+        drawWaveform(g, bounds, Symbol(audioFilePath), startTime, endTime, colour,
+                     verticalZoom);
+    }
+
+    /**
+     * @brief Be told (on the message thread) when a waveform has finished building
+     *
+     * Components that drew a "Loading..." placeholder should repaint.
+     */
+    void addListener(juce::ChangeListener* listener);
+    void removeListener(juce::ChangeListener* listener);
+
+    /**
+     * @brief Keep a file's peaks resident while a component shows it
+     *
+     * Calls nest; each retainWaveform must be balanced by a releaseWaveform.
+     */
+    void retainWaveform(Symbol audioFilePath);
+    void releaseWaveform(Symbol audioFilePath);
+
+    /**
+     * @brief Cache counters for the debug panel
+     */
+    struct CacheStats {
+        juce::int64 hits = 0;       // Draws that found their peaks resident
+        juce::int64 misses = 0;     // Draws that had to load or build peaks
+        juce::int64 evictions = 0;  // Pyramids dropped to stay within budget
+        size_t residentBytes = 0;
+        size_t budgetBytes = 0;
+        int numResident = 0;
+        int numRetained = 0;
+
+        double getHitRate() const {
+            const auto total = hits + misses;
+            return total > 0 ? static_cast<double>(hits) / static_cast<double>(total) : 0.0;
+        }
+    };
+
+    CacheStats getCacheStats() const;
 
     /**
      * @brief Clear the thumbnail cache (useful for freeing memory)
+     *
+     * Peak files on disk are kept. Outstanding retains are dropped with their entries.
      */
     void clearCache();
 
@@ -51,21 +123,96 @@ class AudioThumbnailManager {
      */
     void shutdown();
 
+    /**
+     * @brief Directory holding the persistent peak files
+     */
+    static juce::File getPeakCacheDirectory();
+
+    /**
+     * @brief Whether a peak file matching the audio file as it is on disk exists
+     */
+    static bool hasPeaks(const juce::File& audioFile);
+
+    /**
+     * @brief Store a pyramid built elsewhere (e.g. while importing) as the file's peak file
+     *
+     * The first draw of the file then loads it instead of reading the audio. Any thread;
+     * call once the audio file is closed, as its peak file is keyed by size and time.
+     */
+    static void savePeaks(const juce::File& audioFile, const PeakPyramid& pyramid);
+
+    /**
+     * @brief Cache key of data derived from an audio file: changes whenever the file does
+     *
+     * Also keys the file's spectral and tempo analyses (SpectralCache, TempoCache), so all
+     * invalidate together.
+     */
+    static juce::int64 getPeakHash(const juce::File& audioFile);
+
   private:
     AudioThumbnailManager();
     ~AudioThumbnailManager() = default;
 
+    /**
+     * @brief Per-file waveform state (message thread only)
+     */
+    struct WaveformSource {
+        juce::int64 peakHash = 0;
+        double sampleRate = 0.0;
+        juce::int64 lengthInSamples = 0;
+        int numChannels = 0;
+        std::shared_ptr<const PeakPyramid> pyramid;  // Null until loaded or built, or evicted
+        size_t pyramidBytes = 0;
+        juce::uint64 lastUsed = 0;  // useClock_ value at the last draw
+        int retainCount = 0;        // ClipComponents currently showing this file
+        bool building = false;
+        bool buildFailed = false;
+    };
+
+    class PyramidBuildJob;
+
     // Audio format manager for reading audio files
     juce::AudioFormatManager formatManager_;
 
-    // Thumbnail cache (stores thumbnail data on disk)
-    std::unique_ptr<juce::AudioThumbnailCache> thumbnailCache_;
+    // Map of file paths to waveform state
+    std::unordered_map<Symbol, std::unique_ptr<WaveformSource>> sources_;
+
+    // Background pyramid builders
+    std::unique_ptr<juce::ThreadPool> buildPool_;
+
+    // Notifies listeners when pyramids finish building
+    juce::ChangeBroadcaster thumbnailsChanged_;
+
+    // Set to false on shutdown so late build results are dropped
+    std::shared_ptr<std::atomic<bool>> alive_ = std::make_shared<std::atomic<bool>>(true);
+
+    // Eviction bookkeeping
+    size_t residentBytes_ = 0;
+    juce::uint64 useClock_ = 0;
+    juce::int64 cacheHits_ = 0;
+    juce::int64 cacheMisses_ = 0;
+    juce::int64 cacheEvictions_ = 0;
+
+    WaveformSource* getSource(Symbol audioFilePath);
+
+    // Mark a source used and make its pyramid resident (from the peak file or a build)
+    void requestPyramid(Symbol audioFilePath, WaveformSource& source);
+    void setPyramid(WaveformSource& source, std::shared_ptr<const PeakPyramid> pyramid);
+
+    // Drop least recently used, unretained pyramids until within budget
+    void evictToBudget(const WaveformSource* keep);
+    static size_t getBudgetBytes();
+    void pyramidBuilt(Symbol audioFilePath, juce::int64 peakHash,
+                      std::shared_ptr<const PeakPyramid> pyramid);
+
+    static juce::File getPeakFile(juce::int64 peakHash);
+    static std::shared_ptr<const PeakPyramid> loadPeakFile(const juce::File& peakFile);
+    static void savePeakFile(const juce::File& peakFile, const PeakPyramid& pyramid);
 
-    // Map of file paths to thumbnails
-    std::map<juce::String, std::unique_ptr<juce::AudioThumbnail>> thumbnails_;
+    // Keep the peak directory (peak, spectral and tempo files) bounded
+    static void prunePeakCache(const juce::File& directory);
 
-    // Create a new thumbnail for a file
-    juce::AudioThumbnail* createThumbnail(const juce::String& audioFilePath);
+    static constexpr int MAX_PEAK_FILES = 2000;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AudioThumbnailManager)
 };
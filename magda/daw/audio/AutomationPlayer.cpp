@@ -0,0 +1,121 @@
+#include "AutomationPlayer.hpp"
+
+#include <unordered_set>
+
+#include "../core/AutomationManager.hpp"
+
+namespace magda {
+
+// =============================================================================
+// Message thread
+// =============================================================================
+
+void AutomationPlayer::compile(const AutomationManager& automationManager,
+                               const Resolver& resolver) {
+    auto plan = std::make_unique<Plan>();
+
+    std::unordered_set<AutomationLaneId> previouslySuspended;
+    if (const auto* previous = plan_.getPublished()) {
+        for (size_t i = 0; i < previous->curves.getNumLanes(); ++i) {
+            if (previous->suspended[i].load()) {
+                previouslySuspended.insert(previous->curves.getLaneId(i));
+            }
+        }
+    }
+
+    for (const auto& lane : automationManager.getLanes()) {
+        if (!lane.hasData()) {
+            continue;
+        }
+
+        ResolvedTarget resolved;
+        if (!resolver(lane.target, resolved) || resolved.parameter == nullptr) {
+            continue;
+        }
+
+        plan->curves.addLane(automationManager, lane);
+        plan->parameters.push_back(resolved.parameter);
+        plan->conversions.emplace_back(resolved.info);
+        plan->faderPositions.push_back(resolved.faderPosition ? 1 : 0);
+        plan->plugins.push_back(std::move(resolved.plugin));
+    }
+
+    const size_t numLanes = plan->curves.getNumLanes();
+    plan->suspended = std::make_unique<std::atomic<bool>[]>(numLanes);
+    for (size_t i = 0; i < numLanes; ++i) {
+        plan->suspended[i].store(previouslySuspended.count(plan->curves.getLaneId(i)) > 0);
+    }
+    plan->cursors.resize(numLanes);
+    plan->written.assign(numLanes, -1.0f);
+
+    plan_.publish(std::move(plan));
+}
+
+void AutomationPlayer::updateSuspended(const std::function<bool(AutomationLaneId)>& isSuspended) {
+    auto* plan = plan_.getPublished();
+    if (!plan) {
+        return;
+    }
+
+    for (size_t i = 0; i < plan->curves.getNumLanes(); ++i) {
+        plan->suspended[i].store(isSuspended(plan->curves.getLaneId(i)));
+    }
+}
+
+size_t AutomationPlayer::getNumLanes() const {
+    const auto* plan = plan_.getPublished();
+    return plan ? plan->curves.getNumLanes() : 0;
+}
+
+void AutomationPlayer::collectGarbage() {
+    if (plan_.hasRetired()) {
+        plan_.collectGarbage();
+    }
+}
+
+void AutomationPlayer::clear() {
+    plan_.clear();
+}
+
+// =============================================================================
+// Audio thread
+// =============================================================================
+
+void AutomationPlayer::process(double positionSeconds, bool playing, bool jumped) {
+    auto* plan = plan_.acquire();
+    if (plan == nullptr || !playing) {
+        plan_.release();
+        return;
+    }
+
+    const size_t numLanes = plan->curves.getNumLanes();
+    for (size_t i = 0; i < numLanes; ++i) {
+        if (plan->suspended[i].load(std::memory_order_relaxed)) {
+            // Resuming writes the current value even if the curve is flat there
+            plan->written[i] = -1.0f;
+            continue;
+        }
+
+        double normalised = 0.0;
+        if (!plan->curves.evaluate(i, positionSeconds, plan->cursors[i], normalised)) {
+            continue;
+        }
+
+        const auto value = static_cast<float>(normalised);
+        if (value == plan->written[i] && !jumped) {
+            continue;
+        }
+        plan->written[i] = value;
+
+        // Values are written without notification, as in AudioBridge's parameter changes
+        float real = plan->conversions[i].toReal(value);
+        if (plan->faderPositions[i] != 0) {
+            real = te::decibelsToVolumeFaderPosition(real);
+        }
+        plan->parameters[i]->setParameter(real, juce::dontSendNotification);
+    }
+
+    plan_.release();
+}
+
+}  // namespace magda
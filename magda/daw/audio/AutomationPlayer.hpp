@@ -0,0 +1,124 @@
+#pragma once
+
+#include <tracktion_engine/tracktion_engine.h>
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "../core/AutomationInfo.hpp"
+#include "../core/CompiledAutomation.hpp"
+#include "../core/ParameterConversion.hpp"
+#include "../core/ParameterInfo.hpp"
+#include "RealtimeSnapshot.hpp"
+
+namespace magda {
+
+namespace te = tracktion;
+class AutomationManager;
+
+/**
+ * @brief Plays automation lanes into engine parameters on the audio thread
+ *
+ * The message thread compiles every lane whose target resolves to an engine parameter into
+ * an immutable plan: the lanes' curves as CompiledAutomation, plus per lane the parameter
+ * pointer and the conversion from the lane's normalised values to what the parameter takes.
+ * Once per audio block the audio thread reads each lane at the block's transport position
+ * (a cursor check and one segment evaluation, no search while playing forward) and writes
+ * the parameter when the value has changed.
+ *
+ * Lanes the recorder is writing are suspended, so playback doesn't fight the user's hand.
+ * Macro and mod-parameter targets have no engine parameter and aren't played. Automation
+ * sets a parameter's own value; AudioModulator's modulation goes through a modifier that the
+ * engine adds on top as the plugin renders (see ParameterModifiers), so a parameter can be
+ * both automated and modulated, and the order the two run in doesn't matter.
+ *
+ * Threading: compile(), updateSuspended(), collectGarbage() and clear() on the message
+ * thread; process() on the audio thread only.
+ */
+class AutomationPlayer {
+  public:
+    /**
+     * @brief An automation target resolved to an engine parameter
+     */
+    struct ResolvedTarget {
+        te::AutomatableParameter* parameter = nullptr;
+        te::Plugin::Ptr plugin;      // Keeps parameter alive while the plan exists
+        ParameterInfo info;          // Maps the lane's normalised values to real ones
+        bool faderPosition = false;  // Real values are dB, written as a fader position
+    };
+
+    /**
+     * @brief Resolves a lane's target to a parameter, or returns false
+     */
+    using Resolver = std::function<bool(const AutomationTarget&, ResolvedTarget&)>;
+
+    AutomationPlayer() = default;
+    ~AutomationPlayer() = default;
+
+    // =========================================================================
+    // Message thread
+    // =========================================================================
+
+    /**
+     * @brief Rebuild the plan from the current lanes and publish it
+     *
+     * Call after automation edits and when devices change. Suspended lanes stay suspended.
+     */
+    void compile(const AutomationManager& automationManager, const Resolver& resolver);
+
+    /**
+     * @brief Suspend the lanes isSuspended() picks, resume the others
+     */
+    void updateSuspended(const std::function<bool(AutomationLaneId)>& isSuspended);
+
+    /**
+     * @brief Number of lanes in the published plan
+     */
+    size_t getNumLanes() const;
+
+    /**
+     * @brief Free plans the audio thread has moved past
+     */
+    void collectGarbage();
+
+    /**
+     * @brief Drop all plans (only when the audio thread can't be processing)
+     */
+    void clear();
+
+    // =========================================================================
+    // Audio thread
+    // =========================================================================
+
+    /**
+     * @brief Write every playing lane's value at the block start to its parameter
+     * @param jumped The transport started, looped or seeked: write even unchanged values
+     *
+     * Lock-free and allocation-free. Does nothing while stopped.
+     */
+    void process(double positionSeconds, bool playing, bool jumped);
+
+  private:
+    struct Plan {
+        CompiledAutomation curves;
+
+        // Per lane
+        std::vector<te::AutomatableParameter*> parameters;
+        std::vector<ParameterConversion> conversions;  // Compiled from each lane's info
+        std::vector<uint8_t> faderPositions;
+        std::vector<te::Plugin::Ptr> plugins;  // Keep parameters alive
+
+        // State shared between threads
+        std::unique_ptr<std::atomic<bool>[]> suspended;
+        // Audio thread only
+        std::vector<CompiledAutomation::Cursor> cursors;
+        std::vector<float> written;  // Last normalised value written (-1 = never)
+    };
+
+    RealtimeSnapshot<Plan> plan_;
+};
+
+}  // namespace magda
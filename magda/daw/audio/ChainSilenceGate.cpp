@@ -0,0 +1,87 @@
+#include "ChainSilenceGate.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace magda {
+
+ChainSilenceGate::Action ChainSilenceGate::update(TrackId trackId, const Observation& observation,
+                                                  double nowSeconds) {
+    auto [it, inserted] = chains_.try_emplace(trackId);
+    auto& chain = it->second;
+    if (inserted) {
+        chain.silentSince = nowSeconds;
+        chain.lastUpdate = nowSeconds;
+    }
+
+    const double elapsed = std::max(0.0, nowSeconds - chain.lastUpdate) * chain.numDevices;
+    deviceSeconds_ += elapsed;
+    if (chain.suspended) {
+        savedDeviceSeconds_ += elapsed;
+    }
+    chain.lastUpdate = nowSeconds;
+    chain.numDevices = observation.numDevices;
+
+    const bool active = observation.inputExpected || !observation.outputSilent ||
+                        observation.numDevices == 0 || tailSeconds_ <= 0.0;
+    if (active) {
+        chain.silentSince = nowSeconds;
+        if (chain.suspended) {
+            chain.suspended = false;
+            return Action::Resume;
+        }
+        return Action::None;
+    }
+
+    if (!chain.suspended && nowSeconds - chain.silentSince >= tailSeconds_) {
+        chain.suspended = true;
+        return Action::Suspend;
+    }
+    return Action::None;
+}
+
+bool ChainSilenceGate::wake(TrackId trackId, double nowSeconds) {
+    const auto it = chains_.find(trackId);
+    if (it == chains_.end()) {
+        return false;
+    }
+
+    it->second.silentSince = nowSeconds;
+    return std::exchange(it->second.suspended, false);
+}
+
+bool ChainSilenceGate::isSuspended(TrackId trackId) const {
+    const auto it = chains_.find(trackId);
+    return it != chains_.end() && it->second.suspended;
+}
+
+bool ChainSilenceGate::remove(TrackId trackId) {
+    const auto it = chains_.find(trackId);
+    if (it == chains_.end()) {
+        return false;
+    }
+
+    const bool wasSuspended = it->second.suspended;
+    chains_.erase(it);
+    return wasSuspended;
+}
+
+ChainSilenceGate::Stats ChainSilenceGate::getStats() const {
+    Stats stats;
+    for (const auto& [trackId, chain] : chains_) {
+        if (chain.numDevices == 0) {
+            continue;
+        }
+        ++stats.chains;
+        stats.devices += chain.numDevices;
+        if (chain.suspended) {
+            ++stats.suspendedChains;
+            stats.suspendedDevices += chain.numDevices;
+        }
+    }
+    stats.deviceSeconds = deviceSeconds_;
+    stats.savedDeviceSeconds = savedDeviceSeconds_;
+    return stats;
+}
+
+}  // namespace magda
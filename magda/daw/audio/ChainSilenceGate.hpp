@@ -0,0 +1,109 @@
+#pragma once
+
+#include <unordered_map>
+
+#include "../core/TypeIds.hpp"
+
+namespace magda {
+
+/**
+ * @brief Decides when a track's device chain is idle enough to suspend
+ *
+ * Pure bookkeeping: AudioBridge observes each chain on its timer (is input on its way, is
+ * the chain's output silent) and acts on the Suspend / Resume it gets back. A chain is
+ * suspended once nothing is expected at its input and its output has stayed silent for
+ * the tail, so reverb and delay tails decay before their plugins stop. Anything that
+ * could bring input back wakes it straight away.
+ *
+ * Also keeps the "device time saved" figure for the mixer debug panel: device-seconds
+ * spent suspended over device-seconds observed. Message thread only.
+ */
+class ChainSilenceGate {
+  public:
+    static constexpr double kDefaultTailSeconds = 2.0;
+
+    enum class Action {
+        None,
+        Suspend,  // Disable the chain's devices
+        Resume    // Re-enable them
+    };
+
+    struct Observation {
+        bool inputExpected = false;  // A clip inside the lookahead, live input, ...
+        bool outputSilent = false;   // The chain's meter is at or below silence
+        int numDevices = 0;          // Devices that suspending would disable
+    };
+
+    struct Stats {
+        int chains = 0;  // Chains with devices
+        int suspendedChains = 0;
+        int devices = 0;
+        int suspendedDevices = 0;
+        double deviceSeconds = 0.0;       // Observed, across all devices
+        double savedDeviceSeconds = 0.0;  // Of which suspended
+
+        double getSavedPercent() const {
+            return deviceSeconds > 0.0 ? 100.0 * savedDeviceSeconds / deviceSeconds : 0.0;
+        }
+    };
+
+    /**
+     * @brief Silence a chain's output must hold before it is suspended (0 or less: never
+     *        suspend; suspended chains resume on their next update)
+     */
+    void setTailSeconds(double seconds) {
+        tailSeconds_ = seconds;
+    }
+    double getTailSeconds() const {
+        return tailSeconds_;
+    }
+
+    /**
+     * @brief Feed one observation of a chain
+     * @param nowSeconds Monotonic time, used for the tail and the statistics
+     */
+    Action update(TrackId trackId, const Observation& observation, double nowSeconds);
+
+    /**
+     * @brief Mark a chain active now (an edit, transport start...) and restart its tail
+     * @return True if it was suspended, so the caller must re-enable its devices
+     */
+    bool wake(TrackId trackId, double nowSeconds);
+
+    bool isSuspended(TrackId trackId) const;
+
+    /**
+     * @brief Forget a chain (its track was removed or is no longer gated)
+     * @return True if it was suspended
+     */
+    bool remove(TrackId trackId);
+
+    void clear() {
+        chains_.clear();
+    }
+
+    Stats getStats() const;
+
+    /**
+     * @brief Zero the time totals (chain states are kept)
+     */
+    void resetStats() {
+        deviceSeconds_ = 0.0;
+        savedDeviceSeconds_ = 0.0;
+    }
+
+  private:
+    struct Chain {
+        bool suspended = false;
+        double silentSince = 0.0;
+        double lastUpdate = 0.0;
+        int numDevices = 0;
+    };
+
+    std::unordered_map<TrackId, Chain> chains_;
+    double tailSeconds_ = kDefaultTailSeconds;
+    double deviceSeconds_ = 0.0;
+    double savedDeviceSeconds_ = 0.0;
+};
+
+}  // namespace magda
@@ -0,0 +1,142 @@
+#include "ClickGenerator.hpp"
+
+#include <juce_audio_basics/juce_audio_basics.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace magda {
+
+namespace {
+
+// A sine burst that decays to silence over the click's length
+std::vector<float> renderClick(double sampleRate, double frequency, float peak) {
+    const auto numSamples = static_cast<size_t>(ClickGenerator::kClickSeconds * sampleRate);
+    std::vector<float> click(numSamples);
+    const double decaySeconds = ClickGenerator::kClickSeconds / 6.0;
+    for (size_t i = 0; i < numSamples; ++i) {
+        const double t = static_cast<double>(i) / sampleRate;
+        click[i] = static_cast<float>(peak * std::exp(-t / decaySeconds) *
+                                      std::sin(juce::MathConstants<double>::twoPi * frequency * t));
+    }
+    return click;
+}
+
+}  // namespace
+
+void ClickGenerator::prepare(double sampleRate) {
+    sampleRate_ = sampleRate;
+    accentClick_ = renderClick(sampleRate, kAccentHz, 1.0f);
+    beatClick_ = renderClick(sampleRate, kBeatHz, 0.7f);
+    voice_ = nullptr;
+    voicePosition_ = 0;
+}
+
+int ClickGenerator::process(const Block& block, double bpm, float* const* outputs,
+                            int numChannels) {
+    const int request = countInRequest_.exchange(0, std::memory_order_acquire);
+    if (request == kCancelCountIn) {
+        countInBeats_ = 0;
+    } else if (request > 0) {
+        countInBeats_ = request;
+        countInBeat_ = 0;
+        countInSamplesToBeat_ = 0.0;
+    }
+
+    // Clicks carry on from one stretch into the next, so mix up to each new one in turn
+    int mixed = 0;
+    auto mixUntil = [&](int sample) {
+        if (sample > mixed) {
+            mixClick(outputs, numChannels, block.firstSample + mixed, sample - mixed);
+            mixed = sample;
+        }
+    };
+
+    int countInEnd = -1;
+    if (block.playing) {
+        countInBeats_ = 0;  // The transport is running: nothing left to count in
+        const double endBeat = block.startBeat + block.beatsPerSample * block.numSamples;
+
+        // A tempo change moves the clock by a fraction of a beat: carry on from where the
+        // last stretch ended so no beat is dropped or repeated. Anything more is a jump
+        double fromBeat = block.startBeat;
+        if (!std::isnan(lastEndBeat_) && std::abs(block.startBeat - lastEndBeat_) < 0.5) {
+            fromBeat = lastEndBeat_;
+        }
+        lastEndBeat_ = endBeat;
+
+        if (isEnabled() && block.beatsPerSample > 0.0) {
+            for (double beat = std::ceil(fromBeat - kBeatEpsilon); beat < endBeat - kBeatEpsilon;
+                 beat += 1.0) {
+                int sample = 0;
+                if (beat > block.startBeat) {
+                    sample = static_cast<int>(std::ceil((beat - block.startBeat) /
+                                                            block.beatsPerSample -
+                                                        kBeatEpsilon));
+                    sample = std::min(sample, block.numSamples - 1);
+                }
+                mixUntil(sample);
+                startClick(isAccent(static_cast<int64_t>(beat)));
+            }
+        }
+    } else {
+        lastEndBeat_ = std::numeric_limits<double>::quiet_NaN();
+        if (countInBeats_ > 0 && bpm > 0.0 && sampleRate_ > 0.0) {
+            const double samplesPerBeat = sampleRate_ * 60.0 / bpm;
+            for (;;) {
+                const int sample =
+                    std::max(0, static_cast<int>(std::ceil(countInSamplesToBeat_ - kBeatEpsilon)));
+                if (sample >= block.numSamples) {
+                    break;
+                }
+                mixUntil(sample);
+                if (countInBeat_ == countInBeats_) {
+                    // The beat after the last click: where the transport starts
+                    countInBeats_ = 0;
+                    countInEnd = block.firstSample + sample;
+                    break;
+                }
+                startClick(countInBeat_ % getBeatsPerBar() == 0);
+                ++countInBeat_;
+                countInSamplesToBeat_ += samplesPerBeat;
+            }
+            countInSamplesToBeat_ -= block.numSamples;
+        }
+    }
+
+    mixUntil(block.numSamples);
+    return countInEnd;
+}
+
+bool ClickGenerator::isAccent(int64_t beat) const {
+    const int64_t beatsPerBar = getBeatsPerBar();
+    return ((beat % beatsPerBar) + beatsPerBar) % beatsPerBar == 0;
+}
+
+void ClickGenerator::startClick(bool accented) {
+    // A new click cuts the last one short (only at very fast tempos)
+    voice_ = accented ? &accentClick_ : &beatClick_;
+    voicePosition_ = 0;
+}
+
+void ClickGenerator::mixClick(float* const* outputs, int numChannels, int start,
+                              int numSamples) {
+    if (voice_ == nullptr || numSamples <= 0) {
+        return;
+    }
+    const auto count = std::min(static_cast<size_t>(numSamples), voice_->size() - voicePosition_);
+    const float gain = level_.load(std::memory_order_relaxed);
+    for (int channel = 0; channel < numChannels; ++channel) {
+        if (outputs[channel] != nullptr) {
+            juce::FloatVectorOperations::addWithMultiply(outputs[channel] + start,
+                                                         voice_->data() + voicePosition_, gain,
+                                                         static_cast<int>(count));
+        }
+    }
+    voicePosition_ += count;
+    if (voicePosition_ >= voice_->size()) {
+        voice_ = nullptr;
+    }
+}
+
+}  // namespace magda
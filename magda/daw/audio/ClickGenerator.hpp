@@ -0,0 +1,127 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace magda {
+
+/**
+ * @brief The metronome: pre-rendered clicks mixed into the device output on the audio thread
+ *
+ * prepare() renders an accented and a plain click once for the device rate. Each block then
+ * only works out which beats fall inside it and adds the click from the sample each beat
+ * lands on, so a block costs a multiply-add per sample while a click sounds and nothing
+ * otherwise, at any buffer size. The beat comes from the bridge's audio-thread clock block
+ * by block, so clicks follow a tempo change from the next block on without dropping or
+ * repeating a beat.
+ *
+ * A count-in clicks whole bars at the tempo on its own clock while the transport is
+ * stopped, and reports the sample the beat after its last one falls on, where the
+ * transport is to start.
+ *
+ * Threading: prepare() while the device is stopped; the setters, startCountIn() and
+ * cancelCountIn() on any thread; process() on the audio thread. process() doesn't allocate
+ * or block.
+ */
+class ClickGenerator {
+  public:
+    /**
+     * @brief A stretch of the playhead (a whole block, or the part before or after a wrap)
+     */
+    struct Block {
+        double startBeat = 0.0;
+        double beatsPerSample = 0.0;
+        int numSamples = 0;
+        int firstSample = 0;  // Offset of this stretch within the device block
+        bool playing = false;
+    };
+
+    static constexpr double kClickSeconds = 0.03;
+    static constexpr double kAccentHz = 1500.0;
+    static constexpr double kBeatHz = 1000.0;
+
+    /**
+     * @brief Render the clicks for this device rate (not the audio thread)
+     */
+    void prepare(double sampleRate);
+
+    void setEnabled(bool enabled) {
+        enabled_.store(enabled, std::memory_order_relaxed);
+    }
+    bool isEnabled() const {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Beats per bar; the first of each is accented (the time signature's numerator)
+     */
+    void setBeatsPerBar(int beats) {
+        beatsPerBar_.store(beats > 0 ? beats : 1, std::memory_order_relaxed);
+    }
+    int getBeatsPerBar() const {
+        return beatsPerBar_.load(std::memory_order_relaxed);
+    }
+
+    void setLevel(float gain) {
+        level_.store(gain, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Click a count-in of this many beats from the next block on (stopped transport)
+     */
+    void startCountIn(int beats) {
+        countInRequest_.store(beats > 0 ? beats : kCancelCountIn, std::memory_order_release);
+    }
+    void cancelCountIn() {
+        countInRequest_.store(kCancelCountIn, std::memory_order_release);
+    }
+
+    /**
+     * @brief Add this stretch's clicks to the output (audio thread)
+     * @param bpm Tempo the count-in clicks at
+     * @return Offset within the device block at which a count-in ended, or -1
+     */
+    int process(const Block& block, double bpm, float* const* outputs, int numChannels);
+
+    /**
+     * @brief Whether a count-in is running (audio thread)
+     */
+    bool isCountingIn() const {
+        return countInBeats_ > 0;
+    }
+
+    const std::vector<float>& getClick(bool accented) const {
+        return accented ? accentClick_ : beatClick_;
+    }
+
+    // Beats closer than this are the same beat (well under a sample at any tempo)
+    static constexpr double kBeatEpsilon = 1.0e-9;
+
+  private:
+    static constexpr int kCancelCountIn = -1;
+
+    std::vector<float> accentClick_;
+    std::vector<float> beatClick_;
+    double sampleRate_ = 0.0;
+
+    std::atomic<bool> enabled_{false};
+    std::atomic<int> beatsPerBar_{4};
+    std::atomic<float> level_{0.5f};
+    std::atomic<int> countInRequest_{0};  // Beats to count in, kCancelCountIn, or 0 for none
+
+    // Audio thread only
+    const std::vector<float>* voice_ = nullptr;  // The click sounding, if any
+    size_t voicePosition_ = 0;
+    double lastEndBeat_ = std::numeric_limits<double>::quiet_NaN();  // NaN while stopped
+    int countInBeats_ = 0;  // Beats of the count-in running, 0 for none
+    int countInBeat_ = 0;   // Next one to click
+    double countInSamplesToBeat_ = 0.0;
+
+    bool isAccent(int64_t beat) const;
+    void startClick(bool accented);
+    void mixClick(float* const* outputs, int numChannels, int start, int numSamples);
+};
+
+}  // namespace magda
@@ -0,0 +1,407 @@
+#include "ClipProcessor.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "../core/ClipCommands.hpp"
+#include "../core/ClipManager.hpp"
+#include "../core/UndoManager.hpp"
+#include "AudioThumbnailManager.hpp"
+#include "FadeCurveCache.hpp"
+#include "MixKernels.hpp"
+#include "PeakPyramid.hpp"
+
+namespace magda {
+
+namespace {
+
+bool sameSources(const std::vector<AudioSource>& a, const std::vector<AudioSource>& b) {
+    return std::equal(a.begin(), a.end(), b.begin(), b.end(),
+                      [](const AudioSource& x, const AudioSource& y) {
+                          return x.filePath == y.filePath && x.position == y.position &&
+                                 x.offset == y.offset && x.length == y.length &&
+                                 x.stretchFactor == y.stretchFactor && x.fadeIn == y.fadeIn &&
+                                 x.fadeOut == y.fadeOut;
+                      });
+}
+
+/**
+ * @brief One source placed in the clip, in frames
+ */
+struct Span {
+    std::unique_ptr<juce::AudioFormatReader> reader;
+    juce::int64 start = 0;   // In the clip
+    juce::int64 length = 0;  // In the clip, to the end if looped
+    juce::int64 offset = 0;  // In the file
+    juce::int64 loop = 0;    // Frames of file per repeat, 0 if not looped
+    std::shared_ptr<const FadeCurveCache::Table> fadeIn;   // From start, null if none
+    std::shared_ptr<const FadeCurveCache::Table> fadeOut;  // Ending at start + length
+};
+
+// Multiplies scratch, read for clip frames [from, from + count), by the span's fade gains
+void applyFades(const Span& span, juce::int64 from, int count, juce::AudioBuffer<float>& scratch,
+                int numChannels) {
+    auto apply = [&](const FadeCurveCache::Table& gains, juce::int64 tableStart) {
+        const auto begin = std::max(from, tableStart);
+        const auto end =
+            std::min(from + count, tableStart + static_cast<juce::int64>(gains.size()));
+        if (begin >= end) {
+            return;
+        }
+        for (int ch = 0; ch < numChannels; ++ch) {
+            MixKernels::applyGainTable(scratch.getWritePointer(ch, static_cast<int>(begin - from)),
+                                       gains.data() + (begin - tableStart),
+                                       static_cast<int>(end - begin));
+        }
+    };
+    if (span.fadeIn) {
+        apply(*span.fadeIn, span.start);
+    }
+    if (span.fadeOut) {
+        apply(*span.fadeOut,
+              span.start + span.length - static_cast<juce::int64>(span.fadeOut->size()));
+    }
+}
+
+// Mixes every span's audio for clip frames [start, start + count) into mix
+void mixBlock(std::vector<Span>& spans, juce::int64 start, int count,
+              juce::AudioBuffer<float>& mix, juce::AudioBuffer<float>& scratch) {
+    mix.clear(0, count);
+    for (auto& span : spans) {
+        auto from = std::max(start, span.start);
+        const auto to = std::min(start + count, span.start + span.length);
+        while (from < to) {
+            auto position = from - span.start;
+            auto run = to - from;
+            if (span.loop > 0) {
+                position %= span.loop;
+                run = std::min(run, span.loop - position);
+            }
+            const auto frames = static_cast<int>(run);
+            span.reader->read(&scratch, 0, frames, span.offset + position, true, true);
+            applyFades(span, from, frames, scratch, mix.getNumChannels());
+            for (int ch = 0; ch < mix.getNumChannels(); ++ch) {
+                mix.addFrom(ch, static_cast<int>(from - start), scratch, ch, 0, frames);
+            }
+            from += run;
+        }
+    }
+}
+
+}  // namespace
+
+// =============================================================================
+// RenderJob
+// =============================================================================
+
+/**
+ * @brief Renders one clip on a pool thread
+ */
+class ClipProcessor::RenderJob : public juce::ThreadPoolJob {
+  public:
+    RenderJob(juce::AudioFormatManager& formatManager, const Render& spec,
+              const juce::File& output, ClipId clipId, std::shared_ptr<std::atomic<bool>> alive)
+        : juce::ThreadPoolJob("Process clip"),
+          formatManager_(formatManager),
+          render_(spec),
+          output_(output),
+          clipId_(clipId),
+          alive_(std::move(alive)) {}
+
+    JobStatus runJob() override {
+        auto alive = alive_;
+        auto clipId = clipId_;
+
+        // A few hundred updates at most, however long the clip
+        float reported = 0.0f;
+        auto progressed = [&](float fraction) {
+            if (fraction - reported < 0.02f) {
+                return;
+            }
+            reported = fraction;
+            juce::MessageManager::callAsync([alive, clipId, fraction]() {
+                if (alive->load()) {
+                    ClipProcessor::getInstance().jobProgressed(clipId, fraction);
+                }
+            });
+        };
+
+        const auto result = ClipProcessor::render(
+            formatManager_, render_, output_, [this] { return shouldExit(); }, progressed);
+        if (shouldExit()) {
+            return jobHasFinished;
+        }
+
+        juce::MessageManager::callAsync([alive, clipId, result]() {
+            if (alive->load()) {
+                ClipProcessor::getInstance().jobFinished(clipId, result);
+            }
+        });
+        return jobHasFinished;
+    }
+
+  private:
+    juce::AudioFormatManager& formatManager_;
+    Render render_;
+    juce::File output_;
+    ClipId clipId_;
+    std::shared_ptr<std::atomic<bool>> alive_;
+};
+
+// =============================================================================
+// ClipProcessor
+// =============================================================================
+
+ClipProcessor::ClipProcessor() {
+    formatManager_.registerBasicFormats();
+
+    // Mostly disk-bound; two jobs keep the disk busy without crowding out imports
+    pool_ = std::make_unique<juce::ThreadPool>(2);
+}
+
+ClipProcessor& ClipProcessor::getInstance() {
+    static ClipProcessor instance;
+    return instance;
+}
+
+juce::String ClipProcessor::getOperationName(Operation operation) {
+    switch (operation) {
+        case Operation::Normalise:
+            return "Normalise";
+        case Operation::Reverse:
+            return "Reverse";
+        case Operation::Consolidate:
+            return "Consolidate";
+    }
+    return {};
+}
+
+bool ClipProcessor::process(ClipId clipId, Operation operation, const juce::File& folder) {
+    const auto* clip = ClipManager::getInstance().getClip(clipId);
+    if (!pool_ || clip == nullptr || clip->type != ClipType::Audio ||
+        clip->audioSources.empty() || isProcessing(clipId)) {
+        return false;
+    }
+
+    // Claimed now, so two clips with the same name don't pick the same file
+    if (folder.createDirectory().failed()) {
+        return false;
+    }
+    const auto output = folder.getNonexistentChildFile(
+        juce::File::createLegalFileName(clip->name + " " + getOperationName(operation)), ".wav",
+        false);
+    if (output.create().failed()) {
+        return false;
+    }
+
+    auto& job = jobs_[clipId];
+    job.render.sources = clip->audioSources.read();
+    job.render.length = clip->length;
+    job.render.looped = clip->internalLoopEnabled;
+    job.render.operation = operation;
+    job.clipName = clip->name;
+
+    pool_->addJob(new RenderJob(formatManager_, job.render, output, clipId, alive_), true);
+    reportProgress(job.clipName);
+    return true;
+}
+
+bool ClipProcessor::isProcessing(ClipId clipId) const {
+    return jobs_.count(clipId) > 0;
+}
+
+void ClipProcessor::jobProgressed(ClipId clipId, float fraction) {
+    auto it = jobs_.find(clipId);
+    if (it == jobs_.end()) {
+        return;
+    }
+    it->second.fraction = fraction;
+    reportProgress(it->second.clipName);
+}
+
+void ClipProcessor::jobFinished(ClipId clipId, const Result& result) {
+    auto it = jobs_.find(clipId);
+    if (it == jobs_.end()) {
+        return;
+    }
+    const Job job = std::move(it->second);
+    jobs_.erase(it);
+
+    // Only swapped in if the clip is still the one that was rendered
+    const auto* clip = ClipManager::getInstance().getClip(clipId);
+    const bool unchanged = clip != nullptr && sameSources(clip->audioSources, job.render.sources) &&
+                           clip->length == job.render.length &&
+                           clip->internalLoopEnabled == job.render.looped;
+    if (result.failed || !unchanged) {
+        DBG("ClipProcessor: Dropped " << getOperationName(job.render.operation) << " of "
+                                      << job.clipName << (result.failed ? " (failed)" : ""));
+        result.file.deleteFile();
+    } else {
+        AudioSource source;
+        source.filePath = result.file.getFullPathName();
+        source.length = result.lengthSeconds;
+        UndoManager::getInstance().executeCommand(std::make_unique<ReplaceAudioSourcesCommand>(
+            clipId, std::vector<AudioSource>{source},
+            getOperationName(job.render.operation) + " Clip"));
+    }
+
+    reportProgress(job.clipName);
+}
+
+void ClipProcessor::reportProgress(const juce::String& clipName) {
+    if (!onProgress) {
+        return;
+    }
+
+    Progress progress;
+    progress.running = static_cast<int>(jobs_.size());
+    progress.clipName = clipName;
+    for (const auto& [id, job] : jobs_) {
+        progress.fraction += job.fraction / static_cast<float>(jobs_.size());
+    }
+    onProgress(progress);
+}
+
+ClipProcessor::Result ClipProcessor::render(juce::AudioFormatManager& formatManager,
+                                            const Render& spec, const juce::File& output,
+                                            const std::function<bool()>& shouldExit,
+                                            const std::function<void(float)>& onProgress) {
+    auto cancelled = [&shouldExit] { return shouldExit && shouldExit(); };
+
+    Result result;
+    result.file = output;
+    result.failed = true;
+
+    // Every source at one rate and unstretched, or the job can't run
+    std::vector<Span> spans;
+    double sampleRate = 0.0;
+    int numChannels = 0;
+    for (const auto& source : spec.sources) {
+        std::unique_ptr<juce::AudioFormatReader> reader(
+            formatManager.createReaderFor(juce::File(source.filePath)));
+        if (reader == nullptr || reader->numChannels == 0 || reader->sampleRate <= 0.0 ||
+            std::abs(source.stretchFactor - 1.0) > 1.0e-6) {
+            return result;
+        }
+        if (sampleRate == 0.0) {
+            sampleRate = reader->sampleRate;
+        } else if (std::abs(reader->sampleRate - sampleRate) > 0.5) {
+            return result;
+        }
+        numChannels = std::max(numChannels, static_cast<int>(reader->numChannels));
+
+        Span span;
+        span.reader = std::move(reader);
+        span.start = std::llround(source.position * sampleRate);
+        span.offset = std::llround(source.offset * sampleRate);
+        const double visible = std::min(source.length, spec.length - source.position);
+        span.length = std::llround((spec.looped ? spec.length - source.position : visible) *
+                                   sampleRate);
+        span.loop = spec.looped ? std::llround(source.length * sampleRate) : 0;
+        if (span.length > 0 && (!spec.looped || span.loop > 0)) {
+            // Either fade is at most what plays; overlapping sources with fades crossfade
+            auto& fades = FadeCurveCache::getInstance();
+            auto fadeFrames = [&](const AudioFade& fade) {
+                return std::min(span.length, std::llround(fade.length * sampleRate));
+            };
+            span.fadeIn = fades.getTable(source.fadeIn, fadeFrames(source.fadeIn), true);
+            span.fadeOut = fades.getTable(source.fadeOut, fadeFrames(source.fadeOut), false);
+            spans.push_back(std::move(span));
+        }
+    }
+
+    const auto total = std::llround(spec.length * sampleRate);
+    if (spans.empty() || total <= 0 || output.getParentDirectory().createDirectory().failed()) {
+        return result;
+    }
+
+    juce::AudioBuffer<float> mix(numChannels, kBlockFrames);
+    juce::AudioBuffer<float> scratch(numChannels, kBlockFrames);
+    const int passes = spec.operation == Operation::Normalise ? 2 : 1;
+    juce::int64 done = 0;
+    auto advance = [&](int count) {
+        done += count;
+        if (onProgress) {
+            onProgress(static_cast<float>(done) / static_cast<float>(total * passes));
+        }
+    };
+
+    // Normalising needs the mix's peak before anything is written
+    float gain = 1.0f;
+    if (spec.operation == Operation::Normalise) {
+        float peak = 0.0f;
+        for (juce::int64 pos = 0; pos < total; pos += kBlockFrames) {
+            if (cancelled()) {
+                return result;
+            }
+            const auto count = static_cast<int>(std::min<juce::int64>(kBlockFrames, total - pos));
+            mixBlock(spans, pos, count, mix, scratch);
+            peak = std::max(peak, mix.getMagnitude(0, count));
+            advance(count);
+        }
+        if (peak > 0.0f) {
+            gain = kNormalisePeak / peak;
+        }
+    }
+
+    // Reuses the file process() claimed, from the start
+    std::unique_ptr<juce::FileOutputStream> stream(output.createOutputStream());
+    if (stream == nullptr || !stream->setPosition(0) || stream->truncate().failed()) {
+        return result;
+    }
+    juce::WavAudioFormat wav;
+    std::unique_ptr<juce::AudioFormatWriter> writer(wav.createWriterFor(
+        stream.get(), sampleRate, static_cast<unsigned int>(numChannels), 32, {}, 0));
+    if (writer == nullptr) {
+        return result;
+    }
+    stream.release();  // Owned by the writer now
+
+    auto abandon = [&] {
+        writer.reset();
+        output.deleteFile();
+        return result;
+    };
+
+    PeakPyramid pyramid;
+    pyramid.begin(numChannels, sampleRate);
+    const bool reverse = spec.operation == Operation::Reverse;
+    for (juce::int64 pos = 0; pos < total; pos += kBlockFrames) {
+        if (cancelled()) {
+            return abandon();
+        }
+        const auto count = static_cast<int>(std::min<juce::int64>(kBlockFrames, total - pos));
+
+        // Reversed, the file's first block is the clip's last
+        mixBlock(spans, reverse ? total - pos - count : pos, count, mix, scratch);
+        if (reverse) {
+            mix.reverse(0, count);
+        }
+        if (gain != 1.0f) {
+            mix.applyGain(0, count, gain);
+        }
+        if (!writer->writeFromAudioSampleBuffer(mix, 0, count)) {
+            return abandon();
+        }
+        pyramid.addSamples(mix.getArrayOfReadPointers(), count);
+        advance(count);
+    }
+    writer.reset();  // Closes the file, so its peak key is final
+
+    pyramid.finish();
+    AudioThumbnailManager::savePeaks(output, pyramid);
+    result.lengthSeconds = static_cast<double>(total) / sampleRate;
+    result.failed = false;
+    return result;
+}
+
+void ClipProcessor::shutdown() {
+    alive_->store(false);
+    if (pool_) {
+        pool_->removeAllJobs(true, 2000);
+        pool_.reset();
+    }
+    jobs_.clear();
+}
+
+}  // namespace magda
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_events/juce_events.h>
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "../core/ClipInfo.hpp"
+#include "../core/TypeIds.hpp"
+
+namespace magda {
+
+/**
+ * @brief Renders audio clip edits (normalise, reverse, consolidate) to new files on a pool
+ *        of background threads
+ *
+ * A job snapshots the clip's audio sources and renders what the clip plays, start to end,
+ * into one 32-bit float WAV: every source mixed at its position, from its trim offset, and
+ * repeated to the clip's end if the clip loops. Each source's fades are applied from
+ * FadeCurveCache's tables, so overlapping sources with fades crossfade. Normalise scales the
+ * mix so its peak reaches kNormalisePeak, reverse plays it backwards; consolidate writes it
+ * as it is. The file's peak pyramid is built in the same pass so the clip draws straight
+ * away.
+ *
+ * When the job is done the clip is switched to the new file in a single undoable step
+ * (ReplaceAudioSourcesCommand), which leaves it with one source, so it also needs only one
+ * reader to play. Nothing is deleted: the original files stay where they are for undo.
+ * If the clip was deleted or its sources edited while rendering, the result is discarded.
+ *
+ * Sources are read at their own rate, which must be the first readable source's (imported
+ * and recorded files are at the session rate); a time-stretched source can't be rendered
+ * here and fails the job.
+ *
+ * Message thread only, apart from the pool's threads.
+ */
+class ClipProcessor {
+  public:
+    static ClipProcessor& getInstance();
+
+    enum class Operation { Normalise, Reverse, Consolidate };
+
+    /**
+     * @brief What a job renders: the clip's sources laid out in clip time
+     */
+    struct Render {
+        std::vector<AudioSource> sources;
+        double length = 0.0;  // Clip length, seconds
+        bool looped = false;  // Sources repeat to the clip's end
+        Operation operation = Operation::Consolidate;
+    };
+
+    struct Result {
+        juce::File file;
+        double lengthSeconds = 0.0;
+        bool failed = false;  // Unreadable or stretched source, or the file couldn't be written
+    };
+
+    struct Progress {
+        int running = 0;        // Jobs still rendering (0 once all are done)
+        float fraction = 0.0f;  // Of the running jobs' work, 0 to 1
+        juce::String clipName;  // The clip that just reported
+    };
+
+    /**
+     * @brief Render an audio clip's edit in the background and swap it in when done
+     * @param folder Where the new file is written (created if needed)
+     * @return false if the clip isn't an audio clip with sources, or is already processing
+     */
+    bool process(ClipId clipId, Operation operation, const juce::File& folder);
+
+    bool isProcessing(ClipId clipId) const;
+
+    bool isProcessing() const {
+        return !jobs_.empty();
+    }
+
+    /**
+     * @brief Called on the message thread as jobs advance; running is 0 once all are done
+     */
+    std::function<void(const Progress&)> onProgress;
+
+    /**
+     * @brief Render on the calling thread (what each pool job runs)
+     * @param shouldExit Polled between blocks; a cancelled render leaves no file
+     * @param onProgress Called between blocks with the fraction done
+     */
+    static Result render(juce::AudioFormatManager& formatManager, const Render& spec,
+                         const juce::File& output,
+                         const std::function<bool()>& shouldExit = nullptr,
+                         const std::function<void(float)>& onProgress = nullptr);
+
+    static juce::String getOperationName(Operation operation);
+
+    /**
+     * @brief Cancel running jobs (their results are dropped) and stop the pool
+     */
+    void shutdown();
+
+    static constexpr int kBlockFrames = 65536;
+    static constexpr float kNormalisePeak = 0.989f;  // -0.1 dBFS
+
+  private:
+    ClipProcessor();
+    ~ClipProcessor() = default;
+
+    class RenderJob;
+
+    struct Job {
+        Render render;
+        juce::String clipName;
+        float fraction = 0.0f;
+    };
+
+    void jobProgressed(ClipId clipId, float fraction);
+    void jobFinished(ClipId clipId, const Result& result);
+    void reportProgress(const juce::String& clipName);
+
+    juce::AudioFormatManager formatManager_;
+    std::unique_ptr<juce::ThreadPool> pool_;
+    std::map<ClipId, Job> jobs_;
+
+    // Validity flag for async callbacks - set to false in shutdown()
+    std::shared_ptr<std::atomic<bool>> alive_ = std::make_shared<std::atomic<bool>>(true);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ClipProcessor)
+};
+
+}  // namespace magda
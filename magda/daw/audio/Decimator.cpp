@@ -0,0 +1,71 @@
+#include "Decimator.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace magda {
+
+Decimator::Decimator(int factor) : factor_(std::max(1, factor)) {
+    if (factor_ == 1) {
+        return;
+    }
+
+    // Cut off so the window's transition ends at the lower rate's Nyquist frequency
+    const int numTaps = kTapsPerFactor * factor_ + 1;
+    const double transition = 5.5 / numTaps;  // Blackman, in cycles per input sample
+    const double cutoff = 0.5 / factor_ - transition / 2.0;
+    const double centre = (numTaps - 1) / 2.0;
+    constexpr double kPi = 3.14159265358979323846;
+
+    std::vector<double> taps(static_cast<size_t>(numTaps));
+    double sum = 0.0;
+    for (int i = 0; i < numTaps; ++i) {
+        const double x = i - centre;
+        const double sinc =
+            x == 0.0 ? 2.0 * cutoff : std::sin(2.0 * kPi * cutoff * x) / (kPi * x);
+        const double window = 0.42 - 0.5 * std::cos(2.0 * kPi * i / (numTaps - 1)) +
+                              0.08 * std::cos(4.0 * kPi * i / (numTaps - 1));
+        taps[static_cast<size_t>(i)] = sinc * window;
+        sum += sinc * window;
+    }
+    coefficients_.resize(taps.size());
+    for (size_t i = 0; i < taps.size(); ++i) {
+        coefficients_[i] = static_cast<float>(taps[i] / sum);  // Unity gain at DC
+    }
+    history_.assign(coefficients_.size() * 2, 0.0f);
+}
+
+int Decimator::process(const float* input, int numInput, float* output) {
+    if (factor_ == 1) {
+        std::copy(input, input + numInput, output);
+        return numInput;
+    }
+
+    const int numTaps = static_cast<int>(coefficients_.size());
+    int written = 0;
+    for (int i = 0; i < numInput; ++i) {
+        history_[static_cast<size_t>(position_)] = input[i];
+        history_[static_cast<size_t>(position_ + numTaps)] = input[i];
+        position_ = position_ + 1 == numTaps ? 0 : position_ + 1;
+
+        // Kept on the first sample of each group, so output n lines up with input n * factor
+        if (phase_ == 0) {
+            const float* window = history_.data() + position_;
+            float acc = 0.0f;
+            for (int tap = 0; tap < numTaps; ++tap) {
+                acc += coefficients_[static_cast<size_t>(tap)] * window[tap];
+            }
+            output[written++] = acc;
+        }
+        phase_ = phase_ + 1 == factor_ ? 0 : phase_ + 1;
+    }
+    return written;
+}
+
+void Decimator::reset() {
+    std::fill(history_.begin(), history_.end(), 0.0f);
+    position_ = 0;
+    phase_ = 0;
+}
+
+}  // namespace magda
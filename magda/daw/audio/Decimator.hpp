@@ -0,0 +1,56 @@
+#pragma once
+
+#include <vector>
+
+namespace magda {
+
+/**
+ * @brief Brings audio rendered at a multiple of a rate back down to that rate
+ *
+ * A linear-phase low pass (a Blackman-windowed sinc of kTapsPerFactor taps per unit of the
+ * factor) takes out everything above the lower rate's Nyquist frequency, then every
+ * factor-th sample is kept. The pass band is flat to about 0.46 of the lower rate and the
+ * stop band, from its Nyquist frequency up, is at least 70 dB down, so what an oversampled
+ * render added above the audible band doesn't fold back into it.
+ *
+ * The filter delays its output by getLatency() samples (at the lower rate): callers drop
+ * that many from the start and feed as many factor's worth of silence at the end. One
+ * channel per instance; nothing is allocated after construction.
+ */
+class Decimator {
+  public:
+    static constexpr int kTapsPerFactor = 128;
+
+    /**
+     * @param factor How many input samples make one output sample (1 passes them through)
+     */
+    explicit Decimator(int factor);
+
+    int getFactor() const {
+        return factor_;
+    }
+
+    /**
+     * @brief Output samples the filter lags its input by
+     */
+    int getLatency() const {
+        return factor_ > 1 ? kTapsPerFactor / 2 : 0;
+    }
+
+    /**
+     * @brief Filters numInput samples and writes the ones kept to output
+     * @return How many were written (numInput / factor, give or take one, by phase)
+     */
+    int process(const float* input, int numInput, float* output);
+
+    void reset();
+
+  private:
+    int factor_;
+    std::vector<float> coefficients_;
+    std::vector<float> history_;  // The last taps twice over, so the window is contiguous
+    int position_ = 0;
+    int phase_ = 0;  // Input samples since the last one kept
+};
+
+}  // namespace magda
@@ -0,0 +1,172 @@
+#include "DeviceCpuMeter.hpp"
+
+#include <algorithm>
+
+namespace magda {
+
+// =============================================================================
+// DeviceCpuMeter
+// =============================================================================
+
+std::shared_ptr<DeviceCpuMeter::Counters> DeviceCpuMeter::getCounters(DeviceId deviceId) {
+    auto& entry = entries_[deviceId];
+    if (!entry.counters) {
+        entry.counters = std::make_shared<Counters>();
+    }
+    return entry.counters;
+}
+
+void DeviceCpuMeter::update() {
+    for (auto& [deviceId, entry] : entries_) {
+        // A block charged between the two exchanges lands split across two updates, which
+        // the smoothing absorbs
+        const auto busy = entry.counters->busyNs.exchange(0, std::memory_order_relaxed);
+        const auto audio = entry.counters->audioNs.exchange(0, std::memory_order_relaxed);
+        const auto peakBlock = entry.counters->peakBlockNs.exchange(0, std::memory_order_relaxed);
+        auto& reading = entry.reading;
+        reading.blockPeakMs = double(peakBlock) / 1.0e6;
+        if (audio <= 0) {
+            continue;  // Not rendered since the last update: keep the last reading
+        }
+
+        const double load = double(busy) / double(audio);
+        reading.load =
+            reading.measured ? reading.load + kSmoothing * (load - reading.load) : load;
+        reading.peakLoad = std::max(reading.peakLoad, load);
+        reading.measured = true;
+    }
+}
+
+DeviceCpuMeter::Reading DeviceCpuMeter::getReading(DeviceId deviceId) const {
+    const auto it = entries_.find(deviceId);
+    return it != entries_.end() ? it->second.reading : Reading();
+}
+
+std::vector<std::pair<DeviceId, DeviceCpuMeter::Reading>> DeviceCpuMeter::getSlowestBlocks(
+    size_t maxCount) const {
+    std::vector<std::pair<DeviceId, Reading>> slowest;
+    for (const auto& [deviceId, entry] : entries_) {
+        if (entry.reading.blockPeakMs > 0.0) {
+            slowest.emplace_back(deviceId, entry.reading);
+        }
+    }
+
+    std::sort(slowest.begin(), slowest.end(), [](const auto& a, const auto& b) {
+        return a.second.blockPeakMs > b.second.blockPeakMs ||
+               (a.second.blockPeakMs == b.second.blockPeakMs && a.first < b.first);
+    });
+    if (slowest.size() > maxCount) {
+        slowest.resize(maxCount);
+    }
+    return slowest;
+}
+
+void DeviceCpuMeter::remove(DeviceId deviceId) {
+    entries_.erase(deviceId);
+}
+
+void DeviceCpuMeter::clear() {
+    entries_.clear();
+}
+
+// =============================================================================
+// ChainCpuUsage
+// =============================================================================
+
+ChainCpuUsage ChainCpuUsage::build(const TrackInfo& track, const ReadingSource& readingFor) {
+    ChainCpuUsage usage;
+    ChainNodePath root;
+    root.trackId = track.id;
+    usage.track_ = usage.addElements(track.chainElements, root, readingFor);
+    return usage;
+}
+
+const ChainCpuUsage::Node* ChainCpuUsage::find(const ChainNodePath& path) const {
+    const auto it = std::find_if(nodes_.begin(), nodes_.end(),
+                                 [&path](const Node& node) { return node.path == path; });
+    return it != nodes_.end() ? &*it : nullptr;
+}
+
+std::vector<ChainCpuUsage::Node> ChainCpuUsage::getHotspots(size_t maxCount) const {
+    std::vector<Node> hotspots;
+    for (const auto& node : nodes_) {
+        const bool isDevice =
+            node.type == ChainNodeType::Device || node.type == ChainNodeType::TopLevelDevice;
+        if (isDevice && node.usage.isMeasured()) {
+            hotspots.push_back(node);
+        }
+    }
+
+    std::stable_sort(hotspots.begin(), hotspots.end(), [](const Node& a, const Node& b) {
+        return a.usage.load > b.usage.load;
+    });
+    if (hotspots.size() > maxCount) {
+        hotspots.resize(maxCount);
+    }
+    return hotspots;
+}
+
+ChainCpuUsage::Usage ChainCpuUsage::addElements(const std::vector<ChainElement>& elements,
+                                                const ChainNodePath& parent,
+                                                const ReadingSource& readingFor) {
+    // The track's own chain is addressed by top-level paths, anything deeper by steps
+    const bool topLevel = parent.steps.empty();
+    Usage total;
+
+    for (const auto& element : elements) {
+        if (isDevice(element)) {
+            const auto& device = getDevice(element);
+            const auto path = topLevel ? ChainNodePath::topLevelDevice(parent.trackId, device.id)
+                                       : parent.withDevice(device.id);
+
+            Usage usage;
+            usage.devices = 1;
+            const auto reading = readingFor(device.id);
+            if (reading.measured) {
+                usage.load = reading.load;
+                usage.peakLoad = reading.peakLoad;
+                usage.measuredDevices = 1;
+            }
+
+            nodes_.push_back({path, path.getType(), device.name, usage});
+            accumulate(total, usage);
+        } else if (isRack(element)) {
+            const auto& rack = getRack(element);
+            const auto path = topLevel ? ChainNodePath::rack(parent.trackId, rack.id)
+                                       : parent.withRack(rack.id);
+            accumulate(total, addRack(rack, path, readingFor));
+        }
+    }
+
+    return total;
+}
+
+ChainCpuUsage::Usage ChainCpuUsage::addRack(const RackInfo& rack, const ChainNodePath& path,
+                                            const ReadingSource& readingFor) {
+    // Reserve the rack's place before its children; its total is filled in afterwards
+    const size_t rackIndex = nodes_.size();
+    nodes_.push_back({path, ChainNodeType::Rack, rack.name, {}});
+
+    Usage total;
+    for (const auto& chain : rack.chains) {
+        const auto chainPath = path.withChain(chain.id);
+        const size_t chainIndex = nodes_.size();
+        nodes_.push_back({chainPath, ChainNodeType::Chain, chain.name, {}});
+
+        const auto chainUsage = addElements(chain.elements, chainPath, readingFor);
+        nodes_[chainIndex].usage = chainUsage;
+        accumulate(total, chainUsage);
+    }
+
+    nodes_[rackIndex].usage = total;
+    return total;
+}
+
+void ChainCpuUsage::accumulate(Usage& total, const Usage& part) {
+    total.load += part.load;
+    total.peakLoad += part.peakLoad;
+    total.devices += part.devices;
+    total.measuredDevices += part.measuredDevices;
+}
+
+}  // namespace magda
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../core/SelectionManager.hpp"
+#include "../core/TrackInfo.hpp"
+#include "../core/TypeIds.hpp"
+
+namespace magda {
+
+/**
+ * @brief Per-device processing time, as a share of the real-time budget
+ *
+ * The render path charges each device the time it spent on a block, plus the audio time
+ * that block covered, to the device's Counters (relaxed atomics, no locks). On the
+ * message thread update() folds the counters into a smoothed load: 0.1 means the device
+ * took a tenth of the time the audio it rendered lasts. A device has no reading until one
+ * of its blocks has been measured. The longest single block since the last update is kept
+ * too, so a dropout can be pinned on the device that was slow at the time.
+ *
+ * Everything but Counters::add() is message thread only.
+ */
+class DeviceCpuMeter {
+  public:
+    // Weight of the newest reading in the smoothed load (at the bridge's 30 Hz updates)
+    static constexpr double kSmoothing = 0.3;
+
+    struct Counters {
+        std::atomic<int64_t> busyNs{0};       // Time spent processing
+        std::atomic<int64_t> audioNs{0};      // Audio time those blocks covered
+        std::atomic<int64_t> peakBlockNs{0};  // Longest of those blocks
+
+        /**
+         * @brief Charge one block (audio thread)
+         */
+        void add(int64_t busy, int64_t audio) noexcept {
+            busyNs.fetch_add(busy, std::memory_order_relaxed);
+            audioNs.fetch_add(audio, std::memory_order_relaxed);
+            auto peak = peakBlockNs.load(std::memory_order_relaxed);
+            while (busy > peak &&
+                   !peakBlockNs.compare_exchange_weak(peak, busy, std::memory_order_relaxed)) {
+            }
+        }
+    };
+
+    struct Reading {
+        double load = 0.0;      // Smoothed share of real time
+        double peakLoad = 0.0;  // Highest single update since the device was first measured
+        double blockPeakMs = 0.0;  // Longest block in the last update (0 if none rendered)
+        bool measured = false;     // False until a block has been charged
+    };
+
+    /**
+     * @brief The counters a device's blocks are charged to (created on first use)
+     *
+     * Shared so the render path can keep charging a device that has just been removed.
+     */
+    std::shared_ptr<Counters> getCounters(DeviceId deviceId);
+
+    /**
+     * @brief Fold everything charged since the last update into the readings
+     */
+    void update();
+
+    Reading getReading(DeviceId deviceId) const;
+
+    /**
+     * @brief Devices rendered since the previous update, longest block first
+     */
+    std::vector<std::pair<DeviceId, Reading>> getSlowestBlocks(size_t maxCount) const;
+
+    void remove(DeviceId deviceId);
+    void clear();
+
+  private:
+    struct Entry {
+        std::shared_ptr<Counters> counters;
+        Reading reading;
+    };
+
+    std::unordered_map<DeviceId, Entry> entries_;
+};
+
+/**
+ * @brief A track's device loads summed up its chain tree
+ *
+ * Chains add up their devices and nested racks, racks add up their chains, and the track
+ * adds up everything. Only measured devices count towards a total; a container whose
+ * devices were never measured (racks aren't rendered yet) reports measuredDevices == 0.
+ */
+class ChainCpuUsage {
+  public:
+    struct Usage {
+        double load = 0.0;
+        double peakLoad = 0.0;  // Sum of peaks: an upper bound, as they needn't coincide
+        int devices = 0;
+        int measuredDevices = 0;
+
+        bool isMeasured() const {
+            return measuredDevices > 0;
+        }
+    };
+
+    struct Node {
+        ChainNodePath path;
+        ChainNodeType type = ChainNodeType::None;
+        juce::String name;
+        Usage usage;
+    };
+
+    using ReadingSource = std::function<DeviceCpuMeter::Reading(DeviceId)>;
+
+    static ChainCpuUsage build(const TrackInfo& track, const ReadingSource& readingFor);
+
+    const Usage& getTrackUsage() const {
+        return track_;
+    }
+
+    /**
+     * @brief Every device, rack and chain, parents before their children
+     */
+    const std::vector<Node>& getNodes() const {
+        return nodes_;
+    }
+
+    const Node* find(const ChainNodePath& path) const;
+
+    /**
+     * @brief Measured devices, highest load first
+     */
+    std::vector<Node> getHotspots(size_t maxCount) const;
+
+  private:
+    Usage track_;
+    std::vector<Node> nodes_;
+
+    Usage addElements(const std::vector<ChainElement>& elements, const ChainNodePath& parent,
+                      const ReadingSource& readingFor);
+    Usage addRack(const RackInfo& rack, const ChainNodePath& path,
+                  const ReadingSource& readingFor);
+    static void accumulate(Usage& total, const Usage& part);
+};
+
+}  // namespace magda
@@ -1,6 +1,8 @@
 #include "DeviceProcessor.hpp"
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 #include <utility>
 
 #include "../core/TrackManager.hpp"
@@ -71,18 +73,49 @@ void DeviceProcessor::syncFromDeviceInfo(const DeviceInfo& info) {
     setGainDb(info.gainDb);
     setBypassed(info.bypassed);
 
-    // Sync parameter values (ParameterInfo stores actual values in real units)
-    auto names = getParameterNames();
+    // Sync changed parameter values (ParameterInfo stores actual values in real units)
+    std::vector<juce::String> names;
     for (size_t i = 0; i < info.parameters.size(); ++i) {
-        const auto& param = info.parameters[i];
+        const int index = static_cast<int>(i);
+        const float value = info.parameters.getValue(i);
+        if (isKnownParameterValue(index, value)) {
+            continue;
+        }
+
+        if (names.empty()) {
+            names = getParameterNames();  // Only once something has changed
+        }
         if (i < names.size()) {
-            DBG("  Syncing param " << i << " (" << names[i] << ") = " << param.currentValue << " "
-                                   << param.unit);
-            setParameter(names[i], param.currentValue);
+            applyParameter(index, names[i], value);
+            noteParameterValue(index, value);
         }
     }
 }
 
+void DeviceProcessor::applyParameter(int index, const juce::String& name, float value) {
+    juce::ignoreUnused(index);
+    setParameter(name, value);
+}
+
+void DeviceProcessor::noteParameterValue(int index, float value) {
+    if (index < 0) {
+        return;
+    }
+    if (index >= static_cast<int>(appliedValues_.size())) {
+        appliedValues_.resize(static_cast<size_t>(index) + 1,
+                              std::numeric_limits<float>::quiet_NaN());
+    }
+    appliedValues_[static_cast<size_t>(index)] = value;
+}
+
+bool DeviceProcessor::isKnownParameterValue(int index, float value) const {
+    if (index < 0 || index >= static_cast<int>(appliedValues_.size())) {
+        return false;
+    }
+    // NaN (never written) compares unequal to everything
+    return appliedValues_[static_cast<size_t>(index)] == value;
+}
+
 void DeviceProcessor::syncToDeviceInfo(DeviceInfo& info) const {
     info.gainDb = gainDb_;
     info.gainValue = gainLinear_;
@@ -318,7 +351,7 @@ std::vector<juce::String> VolumeProcessor::getParameterNames() const {
 void VolumeProcessor::setVolume(float db) {
     if (auto* volPan = getVolPanPlugin()) {
         if (volPan->volParam) {
-            volPan->volParam->setParameter(db, juce::sendNotificationSync);
+            volPan->volParam->setParameter(db, juce::dontSendNotification);
         }
     }
 }
@@ -335,7 +368,7 @@ float VolumeProcessor::getVolume() const {
 void VolumeProcessor::setPan(float pan) {
     if (auto* volPan = getVolPanPlugin()) {
         if (volPan->panParam) {
-            volPan->panParam->setParameter(pan, juce::sendNotificationSync);
+            volPan->panParam->setParameter(pan, juce::dontSendNotification);
         }
     }
 }
@@ -363,96 +396,143 @@ ExternalPluginProcessor::ExternalPluginProcessor(DeviceId deviceId, te::Plugin::
 
 ExternalPluginProcessor::~ExternalPluginProcessor() {
     stopParameterListening();
+    cancelPendingUpdate();
 }
 
 te::ExternalPlugin* ExternalPluginProcessor::getExternalPlugin() const {
     return dynamic_cast<te::ExternalPlugin*>(plugin_.get());
 }
 
-void ExternalPluginProcessor::cacheParameterNames() const {
-    if (parametersCached_)
-        return;
+const ExternalPluginProcessor::ParameterTable& ExternalPluginProcessor::getParameterTable() const {
+    auto* ext = getExternalPlugin();
+    const int count = ext ? ext->getNumAutomatableParameters() : 0;
+    if (parameterTableBuilt_ && count == static_cast<int>(parameterTable_.parameters.size())) {
+        return parameterTable_;
+    }
 
-    parameterNames_.clear();
-    if (auto* ext = getExternalPlugin()) {
+    auto* self = const_cast<ExternalPluginProcessor*>(this);  // Only for the listeners
+    if (listeningForChanges_) {
+        for (auto& param : parameterTable_.parameters) {
+            param->removeListener(self);
+        }
+    }
+
+    parameterTable_ = ParameterTable();
+    metadata_.reset();
+    self->invalidateAppliedParameters();  // Indices may now mean other parameters
+    {
+        const int size = juce::jmax(0, count);
+        const juce::SpinLock::ScopedLockType lock(self->pendingLock_);
+        pendingValues_.assign(static_cast<size_t>(size), std::numeric_limits<float>::quiet_NaN());
+        pendingIndices_.clear();
+        pendingIndices_.reserve(static_cast<size_t>(size));
+    }
+    if (ext) {
         auto params = ext->getAutomatableParameters();
+        parameterTable_.parameters.reserve(static_cast<size_t>(params.size()));
+        parameterTable_.names.reserve(static_cast<size_t>(params.size()));
         for (auto* param : params) {
-            if (param) {
-                parameterNames_.push_back(param->getParameterName());
+            if (!param) {
+                continue;
+            }
+            const int index = static_cast<int>(parameterTable_.parameters.size());
+            const Symbol name(param->getParameterName());
+            parameterTable_.parameters.push_back(param);
+            parameterTable_.names.push_back(name.getString());
+            parameterTable_.indexByName.emplace(Symbol(name.getString().toLowerCase()), index);
+            parameterTable_.indexByParameter.emplace(param, index);
+            if (listeningForChanges_) {
+                param->addListener(self);
             }
         }
     }
-    parametersCached_ = true;
+    parameterTableBuilt_ = true;
+    return parameterTable_;
+}
+
+te::AutomatableParameter* ExternalPluginProcessor::getParameterAt(int paramIndex) const {
+    const auto& params = getParameterTable().parameters;
+    if (paramIndex < 0 || paramIndex >= static_cast<int>(params.size())) {
+        return nullptr;
+    }
+    return params[static_cast<size_t>(paramIndex)].get();
+}
+
+int ExternalPluginProcessor::getParameterIndex(const juce::String& paramName) const {
+    // Built first, so every name of the plugin is interned; one that isn't can't match
+    const auto& byName = getParameterTable().indexByName;
+    const auto symbol = Symbol::find(paramName.toLowerCase());
+    if (!symbol) {
+        return -1;
+    }
+    const auto it = byName.find(*symbol);
+    return it != byName.end() ? it->second : -1;
 }
 
 void ExternalPluginProcessor::setParameter(const juce::String& paramName, float value) {
-    if (auto* ext = getExternalPlugin()) {
-        for (auto params = ext->getAutomatableParameters(); auto* param : params) {
-            if (param && param->getParameterName().equalsIgnoreCase(paramName)) {
-                param->setParameter(value, juce::sendNotificationSync);
-                return;
-            }
-        }
+    const int index = getParameterIndex(paramName);
+    if (auto* param = getParameterAt(index)) {
+        settingParameterFromUI_ = true;
+        param->setParameter(value, juce::dontSendNotification);
+        noteParameterValue(index, value);
+        settingParameterFromUI_ = false;
     }
 }
 
 float ExternalPluginProcessor::getParameter(const juce::String& paramName) const {
-    if (auto* ext = getExternalPlugin()) {
-        auto params = ext->getAutomatableParameters();
-        for (auto* param : params) {
-            if (param && param->getParameterName().equalsIgnoreCase(paramName)) {
-                return param->getCurrentValue();
-            }
-        }
+    if (auto* param = getParameterAt(getParameterIndex(paramName))) {
+        return param->getCurrentValue();
     }
     return 0.0f;
 }
 
 std::vector<juce::String> ExternalPluginProcessor::getParameterNames() const {
-    cacheParameterNames();
-    return parameterNames_;
+    return getParameterTable().names;
 }
 
 int ExternalPluginProcessor::getParameterCount() const {
-    if (auto* ext = getExternalPlugin()) {
-        return static_cast<int>(ext->getAutomatableParameters().size());
-    }
-    return 0;
+    return static_cast<int>(getParameterTable().parameters.size());
 }
 
 ParameterInfo ExternalPluginProcessor::getParameterInfo(int index) const {
+    getParameterTable();  // Drops metadata_ if the parameters changed
+    if (metadata_ != nullptr && index >= 0 && index < static_cast<int>(metadata_->size())) {
+        auto info = (*metadata_)[static_cast<size_t>(index)];
+        if (auto* param = getParameterAt(index)) {
+            info.currentValue = param->getCurrentValue();
+        }
+        return info;
+    }
+    return readParameterInfo(index);
+}
+
+ParameterInfo ExternalPluginProcessor::readParameterInfo(int index) const {
     ParameterInfo info;
     info.paramIndex = index;
 
-    if (auto* ext = getExternalPlugin()) {
-        auto params = ext->getAutomatableParameters();
-        if (index >= 0 && index < static_cast<int>(params.size())) {
-            auto* param = params[static_cast<size_t>(index)];
-            if (param) {
-                info.name = param->getParameterName();
-                info.unit = param->getLabel();
-
-                // Get range from parameter
-                auto range = param->getValueRange();
-                info.minValue = range.getStart();
-                info.maxValue = range.getEnd();
-
-                // getDefaultValue returns optional<float>
-                auto defaultVal = param->getDefaultValue();
-                info.defaultValue = defaultVal.has_value() ? *defaultVal : info.minValue;
-                info.currentValue = param->getCurrentValue();
-
-                // Determine scale type
-                // Default to linear scale (could be enhanced to detect logarithmic ranges)
-                info.scale = ParameterScale::Linear;
-
-                // Check if parameter has discrete states
-                int numStates = param->getNumberOfStates();
-                if (numStates > 0 && numStates <= 10) {
-                    info.scale = ParameterScale::Discrete;
-                    // Could populate choices from parameter if available
-                }
-            }
+    if (auto* param = getParameterAt(index)) {
+        info.name = getParameterTable().names[static_cast<size_t>(index)];  // Interned
+        info.unit = param->getLabel();
+
+        // Get range from parameter
+        auto range = param->getValueRange();
+        info.minValue = range.getStart();
+        info.maxValue = range.getEnd();
+
+        // getDefaultValue returns optional<float>
+        auto defaultVal = param->getDefaultValue();
+        info.defaultValue = defaultVal.has_value() ? *defaultVal : info.minValue;
+        info.currentValue = param->getCurrentValue();
+
+        // Determine scale type
+        // Default to linear scale (could be enhanced to detect logarithmic ranges)
+        info.scale = ParameterScale::Linear;
+
+        // Check if parameter has discrete states
+        int numStates = param->getNumberOfStates();
+        if (numStates > 0 && numStates <= 10) {
+            info.scale = ParameterScale::Discrete;
+            // Could populate choices from parameter if available
         }
     }
 
@@ -462,60 +542,67 @@ ParameterInfo ExternalPluginProcessor::getParameterInfo(int index) const {
 void ExternalPluginProcessor::populateParameters(DeviceInfo& info) const {
     info.parameters.clear();
 
-    if (auto* ext = getExternalPlugin()) {
-        auto params = ext->getAutomatableParameters();
-        // Load all parameters - UI uses user-selectable visibility and pagination
-        int maxParams = static_cast<int>(params.size());
+    // Load all parameters - UI uses user-selectable visibility and pagination
+    const auto& table = getParameterTable();
+    const int count = static_cast<int>(table.parameters.size());
+    auto* ext = getExternalPlugin();
+    const auto key = ext ? PluginParameterCache::getKey(ext->desc) : juce::String();
+    auto& cache = PluginParameterCache::getInstance();
 
-        for (int i = 0; i < maxParams; ++i) {
-            info.parameters.push_back(getParameterInfo(i));
+    // The first instance of a plugin type reads its metadata; later ones copy it
+    if (metadata_ == nullptr) {
+        metadata_ = cache.find(key, table.names);
+    }
+    if (metadata_ == nullptr) {
+        PluginParameterCache::Parameters parameters;
+        parameters.reserve(static_cast<size_t>(count));
+        for (int i = 0; i < count; ++i) {
+            parameters.push_back(readParameterInfo(i));
         }
+        metadata_ = cache.store(key, std::move(parameters));
     }
+
+    // Only the values are this device's own; the rest is shared until a parameter is viewed
+    std::vector<float> values(static_cast<size_t>(count));
+    for (size_t i = 0; i < values.size(); ++i) {
+        values[i] = table.parameters[i]->getCurrentValue();
+    }
+    info.parameters = ParameterList(metadata_, std::move(values));
 }
 
 void ExternalPluginProcessor::syncFromDeviceInfo(const DeviceInfo& info) {
-    // Call base class for gain and bypass
-    DeviceProcessor::syncFromDeviceInfo(info);
-
     // Set flag to prevent our listener from triggering a feedback loop
     settingParameterFromUI_ = true;
 
-    // Sync parameter values
-    if (auto* ext = getExternalPlugin()) {
-        auto params = ext->getAutomatableParameters();
-        for (size_t i = 0; i < info.parameters.size() && i < static_cast<size_t>(params.size());
-             ++i) {
-            if (params[i]) {
-                params[i]->setParameter(info.parameters[i].currentValue,
-                                        juce::dontSendNotification);
-            }
-        }
-    }
+    // Gain, bypass and the parameters that changed (applied by index, see applyParameter)
+    DeviceProcessor::syncFromDeviceInfo(info);
 
     settingParameterFromUI_ = false;
 }
 
+void ExternalPluginProcessor::applyParameter(int index, const juce::String& name, float value) {
+    // DeviceInfo parameters are in plugin index order
+    juce::ignoreUnused(name);
+    if (auto* param = getParameterAt(index)) {
+        param->setParameter(value, juce::dontSendNotification);
+    }
+}
+
 void ExternalPluginProcessor::setParameterByIndex(int paramIndex, float value) {
     // Set flag to prevent our listener from triggering a feedback loop
     settingParameterFromUI_ = true;
 
-    if (auto* ext = getExternalPlugin()) {
-        auto params = ext->getAutomatableParameters();
-        if (paramIndex >= 0 && paramIndex < static_cast<int>(params.size())) {
-            params[static_cast<size_t>(paramIndex)]->setParameter(value,
-                                                                  juce::sendNotificationSync);
-        }
+    if (auto* param = getParameterAt(paramIndex)) {
+        param->setParameter(value, juce::dontSendNotification);
+        noteParameterValue(paramIndex, value);
     }
 
     settingParameterFromUI_ = false;
 }
 
 float ExternalPluginProcessor::getParameterByIndex(int paramIndex) const {
-    if (auto* ext = getExternalPlugin()) {
-        auto params = ext->getAutomatableParameters();
-        if (paramIndex >= 0 && paramIndex < static_cast<int>(params.size())) {
-            return params[static_cast<size_t>(paramIndex)]->getCurrentValue();
-        }
+    if (auto* param = getParameterAt(paramIndex)) {
+        return param->getCurrentValue();
     }
     return 0.0f;
 }
@@ -524,12 +611,11 @@ void ExternalPluginProcessor::startParameterListening() {
     if (listeningForChanges_)
         return;
 
-    if (auto* ext = getExternalPlugin()) {
-        auto params = ext->getAutomatableParameters();
-        for (auto* param : params) {
-            if (param) {
-                param->addListener(this);
-            }
+    if (getExternalPlugin()) {
+        // The plugin is loaded: index its parameters now rather than on the first sync
+        const auto& params = getParameterTable().parameters;
+        for (auto& param : params) {
+            param->addListener(this);
         }
         listeningForChanges_ = true;
         DBG("Started parameter listening for device " << deviceId_ << " with " << params.size()
@@ -541,13 +627,9 @@ void ExternalPluginProcessor::stopParameterListening() {
     if (!listeningForChanges_)
         return;
 
-    if (auto* ext = getExternalPlugin()) {
-        auto params = ext->getAutomatableParameters();
-        for (auto* param : params) {
-            if (param) {
-                param->removeListener(this);
-            }
-        }
+    // The table the listeners were added from, even if the plugin has changed since
+    for (auto& param : parameterTable_.parameters) {
+        param->removeListener(this);
     }
     listeningForChanges_ = false;
 }
@@ -563,51 +645,58 @@ void ExternalPluginProcessor::parameterChanged(te::AutomatableParameter& param,
     if (settingParameterFromUI_)
         return;
 
-    // Find the parameter index
-    int parameterIndex = -1;
-    if (auto* ext = getExternalPlugin()) {
-        auto params = ext->getAutomatableParameters();
-        for (size_t i = 0; i < static_cast<size_t>(params.size()); ++i) {
-            if (params[i] == &param) {
-                parameterIndex = static_cast<int>(i);
-                break;
-            }
+    // May be called from the plugin's own threads: read the table as built, never rebuild it
+    const auto found = parameterTable_.indexByParameter.find(&param);
+    if (found == parameterTable_.indexByParameter.end())
+        return;
+    const auto parameterIndex = static_cast<size_t>(found->second);
+
+    // A knob turned in the plugin's UI sends a change per mouse move: keep the latest value
+    // per parameter and hand them to the model together on the message thread
+    {
+        const juce::SpinLock::ScopedLockType lock(pendingLock_);
+        if (parameterIndex >= pendingValues_.size())
+            return;
+        if (std::isnan(pendingValues_[parameterIndex]))
+            pendingIndices_.push_back(static_cast<int>(parameterIndex));
+        pendingValues_[parameterIndex] = newValue;
+    }
+    triggerAsyncUpdate();
+}
+
+void ExternalPluginProcessor::handleAsyncUpdate() {
+    std::vector<std::pair<int, float>> changes;
+    {
+        const juce::SpinLock::ScopedLockType lock(pendingLock_);
+        changes.reserve(pendingIndices_.size());
+        for (int index : pendingIndices_) {
+            auto& pending = pendingValues_[static_cast<size_t>(index)];
+            changes.emplace_back(index, pending);
+            pending = std::numeric_limits<float>::quiet_NaN();
         }
+        pendingIndices_.clear();
     }
 
-    if (parameterIndex < 0)
+    // Plugins that report changes later, or from another thread, echo our own writes
+    // back: the model already has those values
+    changes.erase(std::remove_if(changes.begin(), changes.end(),
+                                 [this](const std::pair<int, float>& change) {
+                                     return isKnownParameterValue(change.first, change.second);
+                                 }),
+                  changes.end());
+    if (changes.empty())
         return;
+    for (const auto& [index, value] : changes) {
+        noteParameterValue(index, value);
+    }
 
-    // Update TrackManager on the message thread to avoid threading issues
-    // Use callAsync to ensure we're on the message thread
-    juce::MessageManager::callAsync([this, parameterIndex, newValue]() {
-        // Find this device in TrackManager and update its parameter
-        // Use a special method that doesn't trigger AudioBridge notification
-        auto& tm = TrackManager::getInstance();
-
-        // Search through all tracks to find this device
-        for (const auto& track : tm.getTracks()) {
-            for (const auto& element : track.chainElements) {
-                if (std::holds_alternative<DeviceInfo>(element)) {
-                    const auto& device = std::get<DeviceInfo>(element);
-                    if (device.id == deviceId_) {
-                        // Build a path to this device
-                        ChainNodePath path;
-                        path.trackId = track.id;
-                        path.topLevelDeviceId = deviceId_;
-                        // Note: For top-level devices, no steps needed
-
-                        // Update parameter without triggering audio bridge notification
-                        tm.setDeviceParameterValueFromPlugin(path, parameterIndex, newValue);
-                        return;
-                    }
-                }
-            }
-
-            // Also search in racks/chains (nested devices)
-            // TODO: Implement nested device search if needed
-        }
-    });
+    // Resolves devices nested in racks as well as top-level ones. The model is updated
+    // without notifying AudioBridge, which would write the values straight back
+    auto& tm = TrackManager::getInstance();
+    ChainNodePath path = tm.findDevicePath(deviceId_);
+    if (path.isValid()) {
+        tm.setDeviceParameterValuesFromPlugin(path, changes);
+    }
 }
 
 }  // namespace magda
@@ -2,8 +2,13 @@
 
 #include <tracktion_engine/tracktion_engine.h>
 
+#include <unordered_map>
+#include <vector>
+
 #include "../core/DeviceInfo.hpp"
+#include "../core/Symbol.hpp"
 #include "../core/TypeIds.hpp"
+#include "PluginParameterCache.hpp"
 
 namespace magda {
 
@@ -120,9 +125,19 @@ class DeviceProcessor {
     /**
      * @brief Update processor state from DeviceInfo
      * Call this when DeviceInfo changes
+     *
+     * Only parameters whose value differs from the one this processor last wrote are
+     * pushed, so a bypass toggle or rename doesn't rewrite every plugin parameter.
      */
     virtual void syncFromDeviceInfo(const DeviceInfo& info);
 
+    /**
+     * @brief Forget what was written, so the next sync pushes every parameter
+     */
+    void invalidateAppliedParameters() {
+        appliedValues_.clear();
+    }
+
     /**
      * @brief Update DeviceInfo from processor state
      * Call this to persist changes back to the model
@@ -139,6 +154,19 @@ class DeviceProcessor {
 
     // Apply gain to the appropriate plugin parameter
     virtual void applyGain();
+
+    // Push one DeviceInfo parameter to the plugin (by name here; subclasses can index)
+    virtual void applyParameter(int index, const juce::String& name, float value);
+
+    // Record a value the plugin now holds, whoever wrote it (for syncs and echo filtering)
+    void noteParameterValue(int index, float value);
+
+    // True if value is what the plugin was last known to hold for this parameter
+    bool isKnownParameterValue(int index, float value) const;
+
+  private:
+    // Last value known to be in the plugin, per parameter index (NaN: unknown)
+    std::vector<float> appliedValues_;
 };
 
 // =============================================================================
@@ -217,7 +245,9 @@ class VolumeProcessor : public DeviceProcessor {
  * Also listens for parameter changes from the plugin's native UI
  * and propagates them to TrackManager.
  */
-class ExternalPluginProcessor : public DeviceProcessor, public te::AutomatableParameter::Listener {
+class ExternalPluginProcessor : public DeviceProcessor,
+                                public te::AutomatableParameter::Listener,
+                                private juce::AsyncUpdater {
   public:
     ExternalPluginProcessor(DeviceId deviceId, te::Plugin::Ptr plugin);
     ~ExternalPluginProcessor() override;
@@ -245,6 +275,13 @@ class ExternalPluginProcessor : public DeviceProcessor, public te::AutomatablePa
      */
     float getParameterByIndex(int paramIndex) const;
 
+    /**
+     * @brief Index of a parameter by name (case-insensitive), or -1
+     *
+     * For resolving names from the UI or a saved project once; keep the index after that.
+     */
+    int getParameterIndex(const juce::String& paramName) const;
+
     /**
      * @brief Start listening for parameter changes from the plugin's native UI
      * Call this after the plugin is fully loaded
@@ -264,15 +301,49 @@ class ExternalPluginProcessor : public DeviceProcessor, public te::AutomatablePa
   private:
     te::ExternalPlugin* getExternalPlugin() const;
 
-    // Cache parameter names for fast lookup
-    mutable std::vector<juce::String> parameterNames_;
-    mutable bool parametersCached_ = false;
+    /**
+     * @brief The plugin's parameters, indexed once
+     *
+     * getAutomatableParameters() copies the whole list, so every by-index access through
+     * it was O(n) and every by-name access a string scan on top; syncing a device with a
+     * few thousand parameters was quadratic. Built at load (startParameterListening) or on
+     * first use, and rebuilt if the plugin's parameter count changes. Holds refs, so the
+     * listeners added to one table can always be removed from it. Names are interned, so
+     * every instance of a plugin shares one copy of them and a lookup by name hashes an
+     * integer.
+     */
+    struct ParameterTable {
+        std::vector<te::AutomatableParameter::Ptr> parameters;
+        std::vector<juce::String> names;  // The interned text, shared between instances
+        std::unordered_map<Symbol, int> indexByName;  // Lower-case, first of duplicates
+        std::unordered_map<const te::AutomatableParameter*, int> indexByParameter;
+    };
+    mutable ParameterTable parameterTable_;
+    mutable bool parameterTableBuilt_ = false;
     bool listeningForChanges_ = false;
 
+    // This plugin type's names, ranges and labels (see PluginParameterCache), found or read
+    // by populateParameters; matches parameterTable_ while set
+    mutable std::shared_ptr<const PluginParameterCache::Parameters> metadata_;
+
     // Flag to prevent feedback loops when we're setting a parameter ourselves
     bool settingParameterFromUI_ = false;
 
-    void cacheParameterNames() const;
+    // Values from the plugin's native UI, coalesced per parameter until the message thread
+    // takes them (parameterChanged can run on any thread, so these never allocate there)
+    juce::SpinLock pendingLock_;
+    mutable std::vector<float> pendingValues_;  // Per parameter index, NaN if none
+    mutable std::vector<int> pendingIndices_;   // Reserved to the parameter count
+
+    void handleAsyncUpdate() override;
+
+    const ParameterTable& getParameterTable() const;
+    te::AutomatableParameter* getParameterAt(int paramIndex) const;
+
+    // Asks the plugin for everything about a parameter (slow for large plugins)
+    ParameterInfo readParameterInfo(int index) const;
+
+    void applyParameter(int index, const juce::String& name, float value) override;
 };
 
 }  // namespace magda
@@ -0,0 +1,50 @@
+#include "DeviceTimingProbePlugin.hpp"
+
+#include "../profiling/RealtimeSafety.hpp"
+
+namespace magda {
+
+const char* DeviceTimingProbePlugin::xmlTypeName = "magdatimingprobe";
+
+DeviceTimingProbePlugin::DeviceTimingProbePlugin(const te::PluginCreationInfo& info)
+    : Plugin(info),
+      nsPerTick_(1.0e9 / double(juce::Time::getHighResolutionTicksPerSecond())) {}
+
+DeviceTimingProbePlugin::~DeviceTimingProbePlugin() {
+    notifyListenersOfDeletion();
+}
+
+juce::ValueTree DeviceTimingProbePlugin::create() {
+    juce::ValueTree v(te::IDs::PLUGIN);
+    v.setProperty(te::IDs::type, xmlTypeName, nullptr);
+    return v;
+}
+
+void DeviceTimingProbePlugin::setTarget(std::shared_ptr<Cursor> cursor,
+                                        std::shared_ptr<DeviceCpuMeter::Counters> previous) {
+    cursor_ = std::move(cursor);
+    previous_ = std::move(previous);
+}
+
+void DeviceTimingProbePlugin::initialise(const te::PluginInitialisationInfo& info) {
+    sampleRate_ = info.sampleRate > 0.0 ? info.sampleRate : 44100.0;
+}
+
+void DeviceTimingProbePlugin::applyToBuffer(const te::PluginRenderContext& fc) {
+    ScopedRealtimeContext realtime;
+    const auto now = juce::Time::getHighResolutionTicks();
+    if (cursor_ == nullptr) {
+        return;  // Restored from a saved Edit rather than placed by the bridge
+    }
+
+    const auto last = cursor_->lastTicks.exchange(now, std::memory_order_relaxed);
+    if (previous_ == nullptr || last == 0 || now < last || fc.bufferNumSamples <= 0) {
+        return;
+    }
+
+    const auto busyNs = static_cast<int64_t>(double(now - last) * nsPerTick_);
+    const auto audioNs = static_cast<int64_t>(1.0e9 * fc.bufferNumSamples / sampleRate_);
+    previous_->add(busyNs, audioNs);
+}
+
+}  // namespace magda
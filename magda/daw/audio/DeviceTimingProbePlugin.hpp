@@ -0,0 +1,94 @@
+#pragma once
+
+#include <tracktion_engine/tracktion_engine.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "DeviceCpuMeter.hpp"
+
+namespace magda {
+
+namespace te = tracktion;
+
+/**
+ * @brief Pass-through plugin that times the device in front of it
+ *
+ * While device CPU measurement is on, AudioBridge puts one probe before each of a track's
+ * devices and one after the last. A track's plugins render one after another, so each
+ * probe stamps the time into the track's shared cursor and charges the time since the
+ * previous stamp to the device it follows. The figure includes the engine's hand-over
+ * between the two plugins, which is small next to any real device.
+ *
+ * The probe leaves audio and MIDI untouched. Threading: setTarget() on the message thread
+ * before the probe is inserted, applyToBuffer() on the audio thread.
+ */
+class DeviceTimingProbePlugin : public te::Plugin {
+  public:
+    /**
+     * @brief Shared by the probes of one track: when the previous one ran
+     */
+    struct Cursor {
+        std::atomic<int64_t> lastTicks{0};
+    };
+
+    explicit DeviceTimingProbePlugin(const te::PluginCreationInfo& info);
+    ~DeviceTimingProbePlugin() override;
+
+    static const char* getPluginName() {
+        return "Device Timing Probe";
+    }
+    static const char* xmlTypeName;
+
+    /**
+     * @brief Create the ValueTree for a new instance
+     */
+    static juce::ValueTree create();
+
+    juce::String getName() const override {
+        return getPluginName();
+    }
+    juce::String getPluginType() override {
+        return xmlTypeName;
+    }
+    juce::String getShortName(int) override {
+        return "Probe";
+    }
+    juce::String getSelectableDescription() override {
+        return getName();
+    }
+
+    /**
+     * @param cursor The track's cursor
+     * @param previous Counters of the device before this probe (nullptr for the first probe)
+     */
+    void setTarget(std::shared_ptr<Cursor> cursor,
+                   std::shared_ptr<DeviceCpuMeter::Counters> previous);
+
+    void initialise(const te::PluginInitialisationInfo&) override;
+    void deinitialise() override {}
+    void applyToBuffer(const te::PluginRenderContext&) override;
+
+    bool takesMidiInput() override {
+        return true;
+    }
+    bool takesAudioInput() override {
+        return true;
+    }
+    bool producesAudioWhenNoAudioInput() override {
+        return false;
+    }
+    double getTailLength() const override {
+        return 0.0;
+    }
+
+  private:
+    std::shared_ptr<Cursor> cursor_;
+    std::shared_ptr<DeviceCpuMeter::Counters> previous_;
+
+    double sampleRate_ = 44100.0;
+    double nsPerTick_ = 0.0;
+};
+
+}  // namespace magda
@@ -0,0 +1,317 @@
+#include "DiskRecorder.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+namespace magda {
+
+DiskRecorder::DiskRecorder() : juce::Thread("Disk Recorder") {}
+
+DiskRecorder::~DiskRecorder() {
+    stop();
+}
+
+// =============================================================================
+// Message thread
+// =============================================================================
+
+bool DiskRecorder::start(const std::vector<Input>& inputs, const Options& options) {
+    if (session_ != nullptr || options.sampleRate <= 0.0 || options.chunkFrames <= 0) {
+        return false;
+    }
+
+    auto session = std::make_unique<Session>();
+    session->chunkFrames = options.chunkFrames;
+
+    // Whole chunks, so writes in the steady state never straddle the wrap
+    const auto wantedFrames =
+        static_cast<juce::int64>(std::ceil(options.bufferSeconds * options.sampleRate));
+    const auto numChunks =
+        std::max<juce::int64>(2, (wantedFrames + options.chunkFrames - 1) / options.chunkFrames);
+    const int capacity = static_cast<int>(numChunks * options.chunkFrames);
+
+    // Nothing is left half-open if a later input fails
+    auto abandon = [&session] {
+        for (auto& stream : session->streams) {
+            stream->writer.reset();
+            stream->file.deleteFile();
+        }
+        return false;
+    };
+
+    juce::WavAudioFormat wav;
+    int maxChannels = 0;
+    for (const auto& input : inputs) {
+        if (input.channels.empty()) {
+            continue;
+        }
+        const int numChannels = static_cast<int>(input.channels.size());
+
+        auto stream = std::make_unique<Stream>();
+        stream->trackId = input.trackId;
+        stream->file = input.file;
+        stream->channels = input.channels;
+        stream->ring.setSize(numChannels, capacity);
+        stream->ring.clear();
+        stream->channelPointers.resize(input.channels.size());
+
+        if (!input.file.getParentDirectory().createDirectory()) {
+            return abandon();
+        }
+        // The stream hands the OS a whole chunk at a time
+        const auto bytesPerChunk = static_cast<size_t>(options.chunkFrames) *
+                                   static_cast<size_t>(numChannels) *
+                                   static_cast<size_t>(options.bitsPerSample / 8);
+        auto output = input.file.createOutputStream(bytesPerChunk);
+        if (output == nullptr) {
+            return abandon();
+        }
+        output->setPosition(0);
+        output->truncate();
+        stream->writer.reset(wav.createWriterFor(output.get(), options.sampleRate,
+                                                 static_cast<unsigned int>(numChannels),
+                                                 options.bitsPerSample, {}, 0));
+        if (stream->writer == nullptr) {
+            return abandon();
+        }
+        output.release();  // Owned by the writer now
+
+        maxChannels = std::max(maxChannels, numChannels);
+        session->streams.push_back(std::move(stream));
+    }
+    if (session->streams.empty()) {
+        return false;
+    }
+
+    session->silence.setSize(maxChannels, options.chunkFrames);
+    session->silence.clear();
+
+    dropouts_.store(0);
+    diskError_.store(false);
+    draining_.store(false);
+    session_ = std::move(session);
+    startThread(juce::Thread::Priority::high);
+    live_.store(session_.get());
+    return true;
+}
+
+std::vector<DiskRecorder::Take> DiskRecorder::stop() {
+    if (session_ == nullptr) {
+        return {};
+    }
+
+    // Once the audio thread is seen outside process() it can't pick the session up again
+    // (both sides are sequentially consistent, so one of them sees the other)
+    live_.store(nullptr);
+    while (processing_.load()) {
+        std::this_thread::yield();
+    }
+
+    // The disk thread writes what is still buffered, then exits
+    draining_.store(true, std::memory_order_release);
+    notify();
+    waitForThreadToExit(-1);
+
+    std::vector<Take> takes;
+    const bool started = session_->started.load(std::memory_order_acquire);
+    for (auto& stream : session_->streams) {
+        stream->writer.reset();  // Finishes the header
+        if (!started || stream->framesOnDisk == 0) {
+            stream->file.deleteFile();
+            continue;
+        }
+        takes.push_back({stream->trackId, stream->file, session_->startSeconds,
+                         stream->framesOnDisk, stream->dropped.load()});
+    }
+    session_.reset();
+    return takes;
+}
+
+DiskRecorder::Stats DiskRecorder::getStats() const {
+    Stats stats;
+    stats.dropouts = dropouts_.load(std::memory_order_relaxed);
+    stats.diskError = diskError_.load(std::memory_order_relaxed);
+    if (session_ == nullptr) {
+        return stats;
+    }
+
+    for (const auto& stream : session_->streams) {
+        const auto capacity = static_cast<float>(stream->ring.getNumSamples());
+        const auto backlog = stream->written.load(std::memory_order_relaxed) -
+                             stream->read.load(std::memory_order_relaxed);
+        stats.bufferFill = std::max(stats.bufferFill, static_cast<float>(backlog) / capacity);
+        stats.peakBufferFill =
+            std::max(stats.peakBufferFill,
+                     static_cast<float>(stream->maxBacklog.load(std::memory_order_relaxed)) /
+                         capacity);
+        stats.droppedFrames += stream->dropped.load(std::memory_order_relaxed);
+    }
+    return stats;
+}
+
+// =============================================================================
+// Audio thread
+// =============================================================================
+
+int DiskRecorder::process(const float* const* inputs, int numInputChannels, int numSamples,
+                          double blockStartSeconds) noexcept {
+    processing_.store(true);
+
+    int dropped = 0;
+    auto* session = live_.load();
+    if (session != nullptr && numSamples > 0) {
+        if (!session->started.load(std::memory_order_relaxed)) {
+            session->startSeconds = blockStartSeconds;
+            session->started.store(true, std::memory_order_release);
+        }
+        for (auto& stream : session->streams) {
+            if (!pushBlock(*stream, inputs, numInputChannels, numSamples)) {
+                dropped += numSamples;
+            }
+        }
+    }
+
+    processing_.store(false, std::memory_order_release);
+    return dropped;
+}
+
+bool DiskRecorder::pushBlock(Stream& stream, const float* const* inputs, int numInputChannels,
+                             int numSamples) noexcept {
+    const int capacity = stream.ring.getNumSamples();
+    const auto written = stream.written.load(std::memory_order_relaxed);
+    const auto backlog = written - stream.read.load(std::memory_order_acquire);
+    const auto gapsPushed = stream.gapsPushed.load(std::memory_order_relaxed);
+    const bool gapFits =
+        stream.pendingGap == 0 ||
+        gapsPushed - stream.gapsWritten.load(std::memory_order_acquire) < kMaxGaps;
+
+    if (backlog + numSamples > capacity || !gapFits) {
+        if (stream.pendingGap == 0) {
+            dropouts_.fetch_add(1, std::memory_order_relaxed);
+        }
+        stream.pendingGap += numSamples;
+        stream.dropped.fetch_add(numSamples, std::memory_order_relaxed);
+        return false;
+    }
+
+    // The disk thread writes the dropped run as silence just before this block
+    if (stream.pendingGap > 0) {
+        stream.gaps[gapsPushed % kMaxGaps] = {written, stream.pendingGap};
+        stream.gapsPushed.store(gapsPushed + 1, std::memory_order_release);
+        stream.pendingGap = 0;
+    }
+
+    const int offset = static_cast<int>(written % capacity);
+    const int first = std::min(numSamples, capacity - offset);
+    for (size_t channel = 0; channel < stream.channels.size(); ++channel) {
+        auto* dest = stream.ring.getWritePointer(static_cast<int>(channel));
+        const int source = stream.channels[channel];
+        const float* input =
+            source >= 0 && source < numInputChannels ? inputs[source] : nullptr;
+        if (input != nullptr) {
+            juce::FloatVectorOperations::copy(dest + offset, input, first);
+            juce::FloatVectorOperations::copy(dest, input + first, numSamples - first);
+        } else {
+            juce::FloatVectorOperations::clear(dest + offset, first);
+            juce::FloatVectorOperations::clear(dest, numSamples - first);
+        }
+    }
+    stream.written.store(written + numSamples, std::memory_order_release);
+
+    if (backlog + numSamples > stream.maxBacklog.load(std::memory_order_relaxed)) {
+        stream.maxBacklog.store(backlog + numSamples, std::memory_order_relaxed);
+    }
+    return true;
+}
+
+// =============================================================================
+// Disk thread
+// =============================================================================
+
+void DiskRecorder::run() {
+    auto& session = *session_;
+    for (;;) {
+        const bool draining = draining_.load(std::memory_order_acquire);
+        bool wrote = false;
+        for (auto& stream : session.streams) {
+            wrote = writeStream(session, *stream, draining) || wrote;
+        }
+        if (draining && !wrote) {
+            return;
+        }
+        if (!wrote) {
+            wait(kPollMs);
+        }
+    }
+}
+
+bool DiskRecorder::writeStream(Session& session, Stream& stream, bool draining) {
+    bool wrote = false;
+    for (;;) {
+        const auto read = stream.read.load(std::memory_order_relaxed);
+        const auto written = stream.written.load(std::memory_order_acquire);
+        auto end = written;
+
+        const auto gapIndex = stream.gapsWritten.load(std::memory_order_relaxed);
+        if (gapIndex != stream.gapsPushed.load(std::memory_order_acquire)) {
+            const auto gap = stream.gaps[gapIndex % kMaxGaps];
+            if (gap.at <= read) {
+                writeSilence(session, stream, gap.length);
+                stream.gapsWritten.store(gapIndex + 1, std::memory_order_release);
+                wrote = true;
+                continue;
+            }
+            end = std::min(end, gap.at);
+        }
+
+        // Whole chunks while recording, unless a gap comes first; the remainder once stopped
+        const auto available = end - read;
+        if (available <= 0 || (available < session.chunkFrames && end == written && !draining)) {
+            return wrote;
+        }
+
+        const auto count = static_cast<int>(std::min<juce::int64>(available, session.chunkFrames));
+        writeFrames(stream, read, count);
+        stream.read.store(read + count, std::memory_order_release);
+        wrote = true;
+    }
+}
+
+void DiskRecorder::writeFrames(Stream& stream, juce::int64 from, int count) {
+    const int capacity = stream.ring.getNumSamples();
+    const auto numChannels = static_cast<int>(stream.channels.size());
+    int offset = static_cast<int>(from % capacity);
+    while (count > 0) {
+        const int frames = std::min(count, capacity - offset);
+        for (int channel = 0; channel < numChannels; ++channel) {
+            stream.channelPointers[static_cast<size_t>(channel)] =
+                stream.ring.getReadPointer(channel, offset);
+        }
+        // A failed file keeps draining its ring, so the other inputs aren't held up
+        if (stream.writer->writeFromFloatArrays(stream.channelPointers.data(), numChannels,
+                                                frames)) {
+            stream.framesOnDisk += frames;
+        } else {
+            diskError_.store(true, std::memory_order_relaxed);
+        }
+        count -= frames;
+        offset = 0;
+    }
+}
+
+void DiskRecorder::writeSilence(Session& session, Stream& stream, juce::int64 count) {
+    const auto numChannels = static_cast<int>(stream.channels.size());
+    while (count > 0) {
+        const auto frames = static_cast<int>(std::min<juce::int64>(count, session.chunkFrames));
+        if (stream.writer->writeFromFloatArrays(session.silence.getArrayOfReadPointers(),
+                                                numChannels, frames)) {
+            stream.framesOnDisk += frames;
+        } else {
+            diskError_.store(true, std::memory_order_relaxed);
+        }
+        count -= frames;
+    }
+}
+
+}  // namespace magda
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_core/juce_core.h>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "../core/TypeIds.hpp"
+
+namespace magda {
+
+/**
+ * @brief Records device inputs straight to disk, one file per armed track
+ *
+ * The audio callback copies each input's channels into a ring allocated when recording
+ * starts and returns; a dedicated disk thread drains the rings in large chunks through a
+ * WAV writer. The callback never allocates, locks or touches the file system, so a session
+ * of dozens of inputs at high sample rates only needs the disk to keep up on average,
+ * with the ring (bufferSeconds) covering stalls.
+ *
+ * If the disk falls behind far enough that a ring fills, the block is dropped for that
+ * input and counted. The gap is written as silence, so the take stays in time with the
+ * others and with the transport.
+ *
+ * Threading: start(), stop() and getStats() on the message thread; process() on the audio
+ * thread. Recording starts at the first process() call after start(), which fixes where
+ * the takes begin on the timeline.
+ */
+class DiskRecorder : private juce::Thread {
+  public:
+    struct Input {
+        TrackId trackId = INVALID_TRACK_ID;
+        std::vector<int> channels;  // Device input channels, one per channel of the file
+        juce::File file;            // Created (or replaced) when recording starts
+    };
+
+    struct Options {
+        double sampleRate = 48000.0;
+        int bitsPerSample = 24;
+        double bufferSeconds = 4.0;  // Ring per input: the longest disk stall survived
+        int chunkFrames = 32768;     // Frames per write; the ring is a multiple of this
+    };
+
+    /**
+     * @brief A finished recording, for the caller to turn into a clip
+     */
+    struct Take {
+        TrackId trackId = INVALID_TRACK_ID;
+        juce::File file;
+        double startSeconds = 0.0;  // Timeline position of the first frame
+        juce::int64 numFrames = 0;  // Including dropped frames written as silence
+        juce::int64 droppedFrames = 0;  // Any after the last captured block aren't written
+    };
+
+    struct Stats {
+        float bufferFill = 0.0f;      // Fullest ring now, 0-1
+        float peakBufferFill = 0.0f;  // Fullest any ring has been this recording
+        juce::int64 droppedFrames = 0;
+        int dropouts = 0;  // Runs of dropped blocks, across inputs
+        bool diskError = false;
+    };
+
+    DiskRecorder();
+    ~DiskRecorder() override;
+
+    /**
+     * @brief Open the files, allocate the rings and start the disk thread
+     * @return False if already recording, there are no inputs with channels, or a file
+     *         couldn't be opened (nothing is left open then)
+     */
+    bool start(const std::vector<Input>& inputs, const Options& options);
+
+    /**
+     * @brief Stop capturing, write everything still buffered and close the files
+     * @return Takes with at least one frame; empty files are deleted
+     */
+    std::vector<Take> stop();
+
+    bool isRecording() const {
+        return session_ != nullptr;
+    }
+
+    Stats getStats() const;
+
+    /**
+     * @brief Copy one block of device input (audio thread, wait-free)
+     * @param blockStartSeconds Timeline position this block's input belongs at
+     * @return Frames dropped this block because a ring was full (summed over inputs)
+     */
+    int process(const float* const* inputs, int numInputChannels, int numSamples,
+                double blockStartSeconds) noexcept;
+
+  private:
+    static constexpr uint32_t kMaxGaps = 64;  // Unwritten dropout runs per input
+    static constexpr int kPollMs = 10;        // Disk thread wake-up when there's nothing to write
+
+    // A run of dropped frames, written as silence before the frame it was dropped ahead of
+    struct Gap {
+        juce::int64 at = 0;
+        juce::int64 length = 0;
+    };
+
+    struct Stream {
+        TrackId trackId = INVALID_TRACK_ID;
+        juce::File file;
+        std::vector<int> channels;
+        juce::AudioBuffer<float> ring;
+        std::unique_ptr<juce::AudioFormatWriter> writer;
+
+        std::atomic<juce::int64> written{0};  // Frames copied in (audio thread)
+        std::atomic<juce::int64> read{0};     // Frames written out (disk thread)
+        std::atomic<juce::int64> maxBacklog{0};
+        std::atomic<juce::int64> dropped{0};
+
+        std::array<Gap, kMaxGaps> gaps;
+        std::atomic<uint32_t> gapsPushed{0};   // Audio thread
+        std::atomic<uint32_t> gapsWritten{0};  // Disk thread
+        juce::int64 pendingGap = 0;            // Audio thread: dropped, not yet published
+
+        std::vector<const float*> channelPointers;  // Disk thread: scratch for writes
+        juce::int64 framesOnDisk = 0;
+    };
+
+    struct Session {
+        std::vector<std::unique_ptr<Stream>> streams;
+        juce::AudioBuffer<float> silence;  // One chunk of zeros for gaps
+        int chunkFrames = 0;
+        double startSeconds = 0.0;  // Written by the first process() call
+        std::atomic<bool> started{false};
+    };
+
+    void run() override;
+    bool pushBlock(Stream& stream, const float* const* inputs, int numInputChannels,
+                   int numSamples) noexcept;
+    bool writeStream(Session& session, Stream& stream, bool draining);
+    void writeFrames(Stream& stream, juce::int64 from, int count);
+    void writeSilence(Session& session, Stream& stream, juce::int64 count);
+
+    std::unique_ptr<Session> session_;  // Message thread owns it while recording
+    std::atomic<Session*> live_{nullptr};
+    std::atomic<bool> processing_{false};  // Audio thread inside process()
+    std::atomic<bool> draining_{false};
+
+    std::atomic<int> dropouts_{0};
+    std::atomic<bool> diskError_{false};
+};
+
+}  // namespace magda
@@ -0,0 +1,71 @@
+#include "FadeCurveCache.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace magda {
+
+FadeCurveCache& FadeCurveCache::getInstance() {
+    static FadeCurveCache instance;
+    return instance;
+}
+
+float FadeCurveCache::getGain(FadeCurve curve, float tension, float x) {
+    x = std::clamp(x, 0.0f, 1.0f);
+    tension = std::clamp(tension, -1.0f, 1.0f);
+    if (tension != 0.0f) {
+        x = std::pow(x, std::pow(4.0f, -tension));  // x^0.25 at full tension, x^4 at -1
+    }
+
+    constexpr float pi = juce::MathConstants<float>::pi;
+    switch (curve) {
+        case FadeCurve::Linear:
+            return x;
+        case FadeCurve::EqualPower:
+            return std::sin(x * pi * 0.5f);
+        case FadeCurve::SCurve:
+            return 0.5f - 0.5f * std::cos(x * pi);
+    }
+    return x;
+}
+
+std::shared_ptr<const FadeCurveCache::Table> FadeCurveCache::getTable(const AudioFade& fade,
+                                                                      int64_t numFrames,
+                                                                      bool rising) {
+    if (numFrames <= 0) {
+        return nullptr;
+    }
+
+    const float tension = std::clamp(fade.tension, -1.0f, 1.0f);
+    const Key key{fade.curve, tension, numFrames, rising};
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (auto it = tables_.find(key); it != tables_.end()) {
+        if (auto table = it->second.lock()) {
+            return table;
+        }
+    }
+
+    auto table = std::make_shared<Table>(static_cast<size_t>(numFrames));
+    const auto frames = static_cast<double>(numFrames);
+    for (int64_t i = 0; i < numFrames; ++i) {
+        const auto x = static_cast<float>(static_cast<double>(i) / frames);
+        (*table)[static_cast<size_t>(i)] = getGain(fade.curve, tension, rising ? x : 1.0f - x);
+    }
+
+    // Tables nothing holds any more go as new ones come in
+    for (auto it = tables_.begin(); it != tables_.end();) {
+        it = it->second.expired() ? tables_.erase(it) : std::next(it);
+    }
+    tables_[key] = table;
+    return table;
+}
+
+int FadeCurveCache::getNumTables() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return static_cast<int>(std::count_if(tables_.begin(), tables_.end(), [](const auto& entry) {
+        return !entry.second.expired();
+    }));
+}
+
+}  // namespace magda
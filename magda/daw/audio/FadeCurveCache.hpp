@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+#include "../core/ClipInfo.hpp"
+
+namespace magda {
+
+/**
+ * @brief Gain tables for audio source fades, worked out once and shared by every edge with
+ *        the same fade
+ *
+ * Evaluating a fade curve per sample - a sine for equal power, a cosine for an S-curve, a
+ * power for the tension - across every faded edge of every clip in a render adds up. A
+ * table holds one gain per frame of a fade, computed when the fade is first asked for, so
+ * applying it is a vector multiply (MixKernels::applyGainTable). Tables are keyed by curve,
+ * tension, length in frames and direction: edges with the same fade at the same rate share
+ * one table, which the cache keeps only for as long as something holds it.
+ *
+ * A rising table starts at 0 and ends a frame short of 1; a falling one starts at 1 and ends
+ * a frame short of 0. An untensioned fade out and fade in of the same curve overlapping frame
+ * for frame keep constant amplitude (Linear, SCurve) or constant power (EqualPower).
+ *
+ * Tables never change once made, so they can be read from any thread; getTable() locks.
+ */
+class FadeCurveCache {
+  public:
+    using Table = std::vector<float>;
+
+    static FadeCurveCache& getInstance();
+
+    /**
+     * @brief The gains for fade over numFrames frames
+     * @param rising True for a fade in, false for a fade out
+     * @return Nullptr for an empty fade
+     */
+    std::shared_ptr<const Table> getTable(const AudioFade& fade, int64_t numFrames, bool rising);
+
+    /**
+     * @brief The gain of a fade in of this curve and tension at x, 0 (start) to 1 (end)
+     *
+     * A fade out is the same curve at 1 - x.
+     */
+    static float getGain(FadeCurve curve, float tension, float x);
+
+    /**
+     * @brief How many tables are held (by the cache and something else)
+     */
+    int getNumTables();
+
+  private:
+    FadeCurveCache() = default;
+
+    using Key = std::tuple<FadeCurve, float, int64_t, bool>;
+
+    std::mutex mutex_;
+    std::map<Key, std::weak_ptr<const Table>> tables_;
+};
+
+}  // namespace magda
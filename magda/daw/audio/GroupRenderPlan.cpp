@@ -0,0 +1,230 @@
+#include "GroupRenderPlan.hpp"
+
+#include <algorithm>
+#include <queue>
+#include <unordered_map>
+
+namespace magda {
+
+GroupRenderPlan GroupRenderPlan::build(const std::vector<Track>& tracks) {
+    GroupRenderPlan plan;
+    const size_t count = tracks.size();
+
+    std::unordered_map<TrackId, size_t> indexOf;
+    for (size_t i = 0; i < count; ++i) {
+        indexOf.emplace(tracks[i].id, i);
+    }
+
+    // Edges between the given tracks; feeds to unknown tracks (or itself) go to the master
+    std::vector<std::vector<size_t>> outputs(count);
+    std::vector<std::vector<size_t>> inputs(count);
+    for (size_t i = 0; i < count; ++i) {
+        for (TrackId feed : tracks[i].feeds) {
+            const auto it = indexOf.find(feed);
+            if (it == indexOf.end() || it->second == i) {
+                continue;
+            }
+            auto& out = outputs[i];
+            if (std::find(out.begin(), out.end(), it->second) == out.end()) {
+                out.push_back(it->second);
+                inputs[it->second].push_back(i);
+            }
+        }
+    }
+
+    // Any render order first, to rank each track from the master back
+    std::vector<size_t> order;
+    order.reserve(count);
+    {
+        std::vector<size_t> pending(count);
+        std::vector<size_t> ready;
+        for (size_t i = 0; i < count; ++i) {
+            pending[i] = inputs[i].size();
+            if (pending[i] == 0) {
+                ready.push_back(i);
+            }
+        }
+        while (!ready.empty()) {
+            const size_t i = ready.back();
+            ready.pop_back();
+            order.push_back(i);
+            for (size_t out : outputs[i]) {
+                if (--pending[out] == 0) {
+                    ready.push_back(out);
+                }
+            }
+        }
+    }
+
+    std::vector<bool> ordered(count, false);
+    for (size_t i : order) {
+        ordered[i] = true;
+    }
+    std::vector<double> rank(count, 0.0);
+    auto rankOf = [&](size_t i) {
+        double downstream = 0.0;
+        for (size_t out : outputs[i]) {
+            if (ordered[out]) {
+                downstream = std::max(downstream, rank[out]);
+            }
+        }
+        return std::max(0.0, tracks[i].cost) + downstream;
+    };
+    for (auto it = order.rbegin(); it != order.rend(); ++it) {
+        rank[*it] = rankOf(*it);
+    }
+    for (size_t i = 0; i < count; ++i) {
+        if (!ordered[i]) {
+            rank[i] = rankOf(i);
+        }
+    }
+
+    // The order to hand out: of the tracks whose inputs are done, the highest rank first
+    // (the first given on a tie)
+    auto lowerPriority = [&](size_t a, size_t b) {
+        return rank[a] != rank[b] ? rank[a] < rank[b] : a > b;
+    };
+    std::vector<size_t> renderOrder;
+    renderOrder.reserve(count);
+    {
+        std::vector<size_t> pending(count);
+        std::priority_queue<size_t, std::vector<size_t>, decltype(lowerPriority)> ready(
+            lowerPriority);
+        for (size_t i = 0; i < count; ++i) {
+            pending[i] = inputs[i].size();
+            if (pending[i] == 0) {
+                ready.push(i);
+            }
+        }
+        while (!ready.empty()) {
+            const size_t i = ready.top();
+            ready.pop();
+            renderOrder.push_back(i);
+            for (size_t out : outputs[i]) {
+                if (--pending[out] == 0) {
+                    ready.push(out);
+                }
+            }
+        }
+    }
+    plan.numCyclicNodes_ = static_cast<int>(count - renderOrder.size());
+    for (size_t i = 0; i < count; ++i) {
+        if (!ordered[i]) {
+            renderOrder.push_back(i);
+        }
+    }
+
+    std::vector<int> position(count);
+    for (size_t p = 0; p < count; ++p) {
+        position[renderOrder[p]] = static_cast<int>(p);
+    }
+
+    plan.nodes_.reserve(count);
+    for (size_t i : renderOrder) {
+        Node node;
+        node.id = tracks[i].id;
+        node.cost = std::max(0.0, tracks[i].cost);
+        node.rank = rank[i];
+        for (size_t in : inputs[i]) {
+            node.inputs.push_back(position[in]);
+        }
+        for (size_t out : outputs[i]) {
+            node.outputs.push_back(position[out]);
+        }
+        std::sort(node.inputs.begin(), node.inputs.end());
+        std::sort(node.outputs.begin(), node.outputs.end());
+        plan.nodes_.push_back(std::move(node));
+    }
+
+    // Inputs placed later only happen inside a loop, which can't wait for them
+    for (size_t p = 0; p < count; ++p) {
+        auto& node = plan.nodes_[p];
+        for (int in : node.inputs) {
+            if (static_cast<size_t>(in) < p) {
+                const auto& input = plan.nodes_[static_cast<size_t>(in)];
+                node.earliestStart = std::max(node.earliestStart, input.earliestStart + input.cost);
+            }
+        }
+        plan.totalCost_ += node.cost;
+        plan.criticalPathCost_ = std::max(plan.criticalPathCost_, node.earliestStart + node.cost);
+    }
+
+    return plan;
+}
+
+int GroupRenderPlan::find(TrackId trackId) const {
+    for (size_t i = 0; i < nodes_.size(); ++i) {
+        if (nodes_[i].id == trackId) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+std::vector<TrackId> GroupRenderPlan::getCriticalPath() const {
+    std::vector<TrackId> path;
+    if (nodes_.empty()) {
+        return path;
+    }
+
+    auto finish = [this](int i) {
+        const auto& node = nodes_[static_cast<size_t>(i)];
+        return node.earliestStart + node.cost;
+    };
+
+    // From the node that finishes last, back through whichever input held it up
+    int current = 0;
+    for (int i = 1; i < static_cast<int>(nodes_.size()); ++i) {
+        if (finish(i) > finish(current)) {
+            current = i;
+        }
+    }
+    while (current >= 0) {
+        path.push_back(nodes_[static_cast<size_t>(current)].id);
+        int latest = -1;
+        for (int in : nodes_[static_cast<size_t>(current)].inputs) {
+            if (in < current && (latest < 0 || finish(in) > finish(latest))) {
+                latest = in;
+            }
+        }
+        current = latest;
+    }
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+double GroupRenderPlan::estimateMakespan(int numThreads) const {
+    std::vector<double> workerFree(static_cast<size_t>(std::max(1, numThreads)), 0.0);
+    std::vector<double> finish(nodes_.size(), 0.0);
+    double makespan = 0.0;
+
+    for (size_t p = 0; p < nodes_.size(); ++p) {
+        const auto& node = nodes_[p];
+        double ready = 0.0;
+        for (int in : node.inputs) {
+            if (static_cast<size_t>(in) < p) {
+                ready = std::max(ready, finish[static_cast<size_t>(in)]);
+            }
+        }
+
+        // The worker that frees up first takes the next node
+        auto worker = std::min_element(workerFree.begin(), workerFree.end());
+        finish[p] = std::max(*worker, ready) + node.cost;
+        *worker = finish[p];
+        makespan = std::max(makespan, finish[p]);
+    }
+    return makespan;
+}
+
+int GroupRenderPlan::getUsefulThreads(int maxThreads, double tolerance) const {
+    const int limit = std::max(1, maxThreads);
+    const double best = estimateMakespan(limit);
+    for (int threads = 1; threads < limit; ++threads) {
+        if (estimateMakespan(threads) <= best * (1.0 + tolerance)) {
+            return threads;
+        }
+    }
+    return limit;
+}
+
+}  // namespace magda
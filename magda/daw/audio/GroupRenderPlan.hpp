@@ -0,0 +1,115 @@
+#pragma once
+
+#include <vector>
+
+#include "../core/TypeIds.hpp"
+
+namespace magda {
+
+/**
+ * @brief The track graph as a render scheduler sees it: who waits for whom, and how long
+ *
+ * Each track feeds the group it sits in and the aux tracks it sends to; a track that
+ * feeds nothing goes to the master. A track can render once everything feeding it has,
+ * so sibling subtrees are independent and only meet where a group sums them. Each node
+ * carries an estimated cost (a share of real time, as DeviceCpuMeter reports it) and its
+ * rank: its own cost plus the most expensive chain from it to the master. Nodes come in
+ * a valid render order, and among those that could go next the highest rank goes first,
+ * which is the order a worker pool should pick them up in to finish soonest.
+ *
+ * Feeds that would close a loop can't be rendered in order; the tracks caught in one are
+ * placed last, in the order given, and counted in getNumCyclicNodes().
+ *
+ * Pure arithmetic over track costs, so it can be planned (and tested) without an engine.
+ */
+class GroupRenderPlan {
+  public:
+    // Mixing and metering a track costs something even with an empty chain
+    static constexpr double kTrackBaseLoad = 0.002;
+    // Assumed for a device that hasn't been measured (measurement off, or not rendered yet)
+    static constexpr double kUnmeasuredDeviceLoad = 0.01;
+
+    struct Track {
+        TrackId id = INVALID_TRACK_ID;
+        std::vector<TrackId> feeds;  // Parent group and send destinations (none = master)
+        double cost = 0.0;
+    };
+
+    struct Node {
+        TrackId id = INVALID_TRACK_ID;
+        double cost = 0.0;
+        double rank = 0.0;           // cost plus the costliest chain on to the master
+        double earliestStart = 0.0;  // With a thread per node: costliest chain feeding it
+        std::vector<int> inputs;     // Nodes feeding this one (indices into getNodes())
+        std::vector<int> outputs;    // Nodes this one feeds
+    };
+
+    static GroupRenderPlan build(const std::vector<Track>& tracks);
+
+    /**
+     * @brief A track's estimated cost from its chain's measured load
+     */
+    static double estimateTrackCost(double measuredLoad, int devices, int measuredDevices) {
+        const int unmeasured = devices > measuredDevices ? devices - measuredDevices : 0;
+        return kTrackBaseLoad + measuredLoad + unmeasured * kUnmeasuredDeviceLoad;
+    }
+
+    /**
+     * @brief Every track, in render order
+     */
+    const std::vector<Node>& getNodes() const {
+        return nodes_;
+    }
+
+    /**
+     * @brief Index of a track's node, or -1
+     */
+    int find(TrackId trackId) const;
+
+    double getTotalCost() const {
+        return totalCost_;
+    }
+
+    /**
+     * @brief The costliest chain of feeds: the least time any number of threads can take
+     */
+    double getCriticalPathCost() const {
+        return criticalPathCost_;
+    }
+
+    /**
+     * @brief The tracks on that chain, from its first input to the one reaching the master
+     */
+    std::vector<TrackId> getCriticalPath() const;
+
+    /**
+     * @brief How many threads the graph can keep busy on average (total / critical path)
+     */
+    double getParallelism() const {
+        return criticalPathCost_ > 0.0 ? totalCost_ / criticalPathCost_ : 0.0;
+    }
+
+    /**
+     * @brief Time to render a block with numThreads workers taking nodes in render order
+     */
+    double estimateMakespan(int numThreads) const;
+
+    /**
+     * @brief The fewest threads (up to maxThreads) that come within tolerance of the best
+     *
+     * Threads past this count would mostly wait on the critical path.
+     */
+    int getUsefulThreads(int maxThreads, double tolerance = 0.05) const;
+
+    int getNumCyclicNodes() const {
+        return numCyclicNodes_;
+    }
+
+  private:
+    std::vector<Node> nodes_;
+    double totalCost_ = 0.0;
+    double criticalPathCost_ = 0.0;
+    int numCyclicNodes_ = 0;
+};
+
+}  // namespace magda
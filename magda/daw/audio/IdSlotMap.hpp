@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace magda {
+
+/**
+ * @brief Flat map keyed by the dense integer IDs MAGDA hands out (TrackId, DeviceId, ClipId)
+ *
+ * IDs are allocated sequentially from small integers, so a vector indexed by ID is both
+ * smaller and faster than a node-based map: a lookup is a bounds check and an index, and
+ * iteration walks contiguous memory in ascending ID order (the same order std::map gave).
+ * Negative IDs are never stored. Erasing leaves the slot empty; storage only grows.
+ *
+ * Threading: none - callers provide their own synchronisation.
+ */
+template <typename Id, typename T> class IdSlotMap {
+  public:
+    /**
+     * @brief The value stored for an ID, or nullptr
+     */
+    T* find(Id id) {
+        return contains(id) ? &values_[static_cast<size_t>(id)] : nullptr;
+    }
+
+    const T* find(Id id) const {
+        return contains(id) ? &values_[static_cast<size_t>(id)] : nullptr;
+    }
+
+    bool contains(Id id) const {
+        return id >= 0 && static_cast<size_t>(id) < occupied_.size() &&
+               occupied_[static_cast<size_t>(id)] != 0;
+    }
+
+    /**
+     * @brief Store a value, replacing any existing one
+     * @return The stored value, or nullptr for a negative ID
+     */
+    T* assign(Id id, T value) {
+        if (id < 0)
+            return nullptr;
+
+        const auto index = static_cast<size_t>(id);
+        if (index >= occupied_.size()) {
+            values_.resize(index + 1);
+            occupied_.resize(index + 1, 0);
+        }
+
+        if (occupied_[index] == 0) {
+            occupied_[index] = 1;
+            ++count_;
+        }
+        values_[index] = std::move(value);
+        return &values_[index];
+    }
+
+    /**
+     * @brief Remove an ID's value (destroying it)
+     * @return true if a value was stored
+     */
+    bool erase(Id id) {
+        if (!contains(id))
+            return false;
+
+        const auto index = static_cast<size_t>(id);
+        values_[index] = T{};
+        occupied_[index] = 0;
+        --count_;
+        return true;
+    }
+
+    void clear() {
+        values_.clear();
+        occupied_.clear();
+        count_ = 0;
+    }
+
+    size_t size() const {
+        return count_;
+    }
+
+    bool empty() const {
+        return count_ == 0;
+    }
+
+    /**
+     * @brief One past the highest ID that has ever been stored
+     */
+    size_t getCapacity() const {
+        return occupied_.size();
+    }
+
+    /**
+     * @brief Heap bytes held by the slot arrays (not by anything the values point to)
+     */
+    size_t getSizeInBytes() const {
+        return values_.capacity() * sizeof(T) + occupied_.capacity() * sizeof(uint8_t);
+    }
+
+    /**
+     * @brief Call fn(id, value) for every stored value, in ascending ID order
+     */
+    template <typename Fn> void forEach(Fn&& fn) {
+        for (size_t i = 0; i < occupied_.size(); ++i) {
+            if (occupied_[i] != 0)
+                fn(static_cast<Id>(i), values_[i]);
+        }
+    }
+
+    template <typename Fn> void forEach(Fn&& fn) const {
+        for (size_t i = 0; i < occupied_.size(); ++i) {
+            if (occupied_[i] != 0)
+                fn(static_cast<Id>(i), values_[i]);
+        }
+    }
+
+  private:
+    std::vector<T> values_;
+    std::vector<uint8_t> occupied_;
+    size_t count_ = 0;
+};
+
+}  // namespace magda
@@ -0,0 +1,75 @@
+#include "LatencyPlanner.hpp"
+
+#include <algorithm>
+
+namespace magda {
+
+namespace {
+
+// Reported latencies are whole samples converted to seconds; below this they are noise
+constexpr double kLatencyEpsilon = 1.0e-9;
+
+}  // namespace
+
+LatencyPlanner::Plan LatencyPlanner::plan(const std::vector<Track>& tracks, Policy policy,
+                                          double budgetSeconds) {
+    Plan plan;
+    plan.bypass.resize(tracks.size());
+    plan.trackSeconds.assign(tracks.size(), 0.0);
+
+    for (size_t t = 0; t < tracks.size(); ++t) {
+        const auto& plugins = tracks[t].pluginSeconds;
+        plan.bypass[t].assign(plugins.size(), false);
+
+        for (size_t p = 0; p < plugins.size(); ++p) {
+            const bool latent = plugins[p] > kLatencyEpsilon;
+            if (policy == Policy::BypassLatent && latent) {
+                plan.bypass[t][p] = true;
+                ++plan.bypassedCount;
+            } else {
+                plan.trackSeconds[t] += plugins[p];
+            }
+        }
+    }
+
+    if (policy == Policy::Constrain) {
+        const double budget = std::max(0.0, budgetSeconds);
+        for (;;) {
+            // The track that sets the compensation, then its most latent plugin still active
+            const auto worst = std::max_element(plan.trackSeconds.begin(), plan.trackSeconds.end());
+            if (worst == plan.trackSeconds.end() || *worst <= budget + kLatencyEpsilon) {
+                break;
+            }
+
+            const auto t = static_cast<size_t>(worst - plan.trackSeconds.begin());
+            const auto& plugins = tracks[t].pluginSeconds;
+            size_t victim = plugins.size();
+            for (size_t p = 0; p < plugins.size(); ++p) {
+                if (!plan.bypass[t][p] && plugins[p] > kLatencyEpsilon &&
+                    (victim == plugins.size() || plugins[p] > plugins[victim])) {
+                    victim = p;
+                }
+            }
+            if (victim == plugins.size()) {
+                break;  // Only negative or zero latencies left
+            }
+
+            plan.bypass[t][victim] = true;
+            ++plan.bypassedCount;
+            // Re-summed rather than subtracted, so an emptied track comes out at exactly 0
+            plan.trackSeconds[t] = 0.0;
+            for (size_t p = 0; p < plugins.size(); ++p) {
+                if (!plan.bypass[t][p]) {
+                    plan.trackSeconds[t] += plugins[p];
+                }
+            }
+        }
+    }
+
+    for (const double seconds : plan.trackSeconds) {
+        plan.compensatedSeconds = std::max(plan.compensatedSeconds, seconds);
+    }
+    return plan;
+}
+
+}  // namespace magda
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <vector>
+
+namespace magda {
+
+/**
+ * @brief Chooses which latent plugins to bypass so compensation fits a latency budget
+ *
+ * The engine delays every track to line up with the slowest one, so compensation costs
+ * the largest sum of plugin latencies on any track, and monitored input arrives that much
+ * later too. For monitoring at a target latency (Live mode) there are three policies:
+ * - Compensate: bypass nothing and compensate everything (the normal case)
+ * - BypassLatent: bypass every plugin that reports latency
+ * - Constrain: bypass as few plugins as possible to bring each track within the budget,
+ *   always taking the most latent plugin on the most latent track next
+ *
+ * Pure arithmetic over plugin latencies, so it can be planned (and tested) without an
+ * engine.
+ */
+class LatencyPlanner {
+  public:
+    enum class Policy { Compensate = 0, BypassLatent = 1, Constrain = 2 };
+
+    struct Track {
+        std::vector<double> pluginSeconds;  // Each plugin's reported latency, in chain order
+    };
+
+    struct Plan {
+        std::vector<std::vector<bool>> bypass;  // Per track, per plugin
+        std::vector<double> trackSeconds;       // Latency each track keeps after bypassing
+        double compensatedSeconds = 0.0;        // The largest of those: what PDC will add
+        int bypassedCount = 0;
+    };
+
+    /**
+     * @param budgetSeconds Plugin latency allowed under Constrain (device latency already
+     *        taken off; 0 or less bypasses every latent plugin)
+     */
+    static Plan plan(const std::vector<Track>& tracks, Policy policy, double budgetSeconds);
+
+    /**
+     * @brief What's left of a round-trip target once the device's own latency is paid
+     */
+    static double pluginBudgetSeconds(double targetMs, double deviceSeconds) {
+        const double budget = targetMs / 1000.0 - deviceSeconds;
+        return budget > 0.0 ? budget : 0.0;
+    }
+};
+
+}  // namespace magda
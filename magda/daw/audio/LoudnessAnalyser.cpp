@@ -0,0 +1,153 @@
+#include "LoudnessAnalyser.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace magda {
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+// BS.1770's offset, so a full-scale 1 kHz sine in one channel reads -3.01 LUFS
+constexpr double kLoudnessOffset = -0.691;
+constexpr double kRelativeGateLu = -10.0;
+
+double energyToLufs(double energy) {
+    if (energy <= 0.0)
+        return LoudnessAnalyser::kSilenceLufs;
+    return std::max(static_cast<double>(LoudnessAnalyser::kSilenceLufs),
+                    kLoudnessOffset + 10.0 * std::log10(energy));
+}
+
+}  // namespace
+
+void LoudnessAnalyser::prepare(double sampleRate) {
+    if (sampleRate <= 0.0)
+        sampleRate = 48000.0;
+
+    // BS.1770's 48 kHz filters, redesigned for the tap's rate (as libebur128 does)
+    for (auto& weighting : weighting_) {
+        {
+            const double f0 = 1681.974450955533;
+            const double gainDb = 3.999843853973347;
+            const double q = 0.7071752369554196;
+            const double k = std::tan(kPi * f0 / sampleRate);
+            const double vh = std::pow(10.0, gainDb / 20.0);
+            const double vb = std::pow(vh, 0.4996667741545416);
+            const double a0 = 1.0 + k / q + k * k;
+            weighting.shelf = {};
+            weighting.shelf.b0 = (vh + vb * k / q + k * k) / a0;
+            weighting.shelf.b1 = 2.0 * (k * k - vh) / a0;
+            weighting.shelf.b2 = (vh - vb * k / q + k * k) / a0;
+            weighting.shelf.a1 = 2.0 * (k * k - 1.0) / a0;
+            weighting.shelf.a2 = (1.0 - k / q + k * k) / a0;
+        }
+        {
+            const double f0 = 38.13547087602444;
+            const double q = 0.5003270373238773;
+            const double k = std::tan(kPi * f0 / sampleRate);
+            const double a0 = 1.0 + k / q + k * k;
+            weighting.highPass = {};
+            weighting.highPass.b0 = 1.0;
+            weighting.highPass.b1 = -2.0;
+            weighting.highPass.b2 = 1.0;
+            weighting.highPass.a1 = 2.0 * (k * k - 1.0) / a0;
+            weighting.highPass.a2 = (1.0 - k / q + k * k) / a0;
+        }
+    }
+
+    for (auto& detector : truePeak_)
+        detector.reset();
+    truePeakGain_ = 0.0f;
+
+    stepSamples_ = std::max(1, static_cast<int>(sampleRate / 10.0));
+    stepPosition_ = 0;
+    stepEnergy_ = 0.0;
+    std::fill(steps_.begin(), steps_.end(), 0.0);
+    numSteps_ = 0;
+    histogramCounts_.fill(0);
+    histogramEnergy_.fill(0.0);
+
+    momentary_.store(kSilenceLufs, std::memory_order_relaxed);
+    shortTerm_.store(kSilenceLufs, std::memory_order_relaxed);
+    integrated_.store(kSilenceLufs, std::memory_order_relaxed);
+    truePeakDb_.store(-100.0f, std::memory_order_relaxed);
+}
+
+void LoudnessAnalyser::process(const float* left, const float* right, int numSamples) {
+    truePeakGain_ = std::max({truePeakGain_, truePeak_[0].process(left, numSamples),
+                              truePeak_[1].process(right, numSamples)});
+    truePeakDb_.store(truePeakGain_ > 0.0f ? 20.0f * std::log10(truePeakGain_) : -100.0f,
+                      std::memory_order_relaxed);
+
+    auto& weightL = weighting_[0];
+    auto& weightR = weighting_[1];
+    for (int i = 0; i < numSamples; ++i) {
+        const double l = weightL.highPass.process(weightL.shelf.process(left[i]));
+        const double r = weightR.highPass.process(weightR.shelf.process(right[i]));
+        stepEnergy_ += l * l + r * r;
+        if (++stepPosition_ == stepSamples_)
+            stepComplete();
+    }
+}
+
+void LoudnessAnalyser::stepComplete() {
+    steps_[static_cast<size_t>(numSteps_ % kShortTermSteps)] = stepEnergy_ / stepSamples_;
+    ++numSteps_;
+    stepEnergy_ = 0.0;
+    stepPosition_ = 0;
+
+    // Mean energy of the last count steps (fewer at the start count as silence)
+    auto meanOfLast = [this](int count) {
+        double sum = 0.0;
+        for (int i = 1; i <= std::min(count, numSteps_); ++i)
+            sum += steps_[static_cast<size_t>((numSteps_ - i) % kShortTermSteps)];
+        return sum / count;
+    };
+
+    const double blockEnergy = meanOfLast(kMomentarySteps);
+    momentary_.store(static_cast<float>(energyToLufs(blockEnergy)), std::memory_order_relaxed);
+    shortTerm_.store(static_cast<float>(energyToLufs(meanOfLast(kShortTermSteps))),
+                     std::memory_order_relaxed);
+
+    // A gating block every 100 ms, overlapping by 75%, once the first 400 ms have passed
+    if (numSteps_ < kMomentarySteps)
+        return;
+    const double blockLufs = energyToLufs(blockEnergy);
+    if (blockLufs <= kSilenceLufs)
+        return;
+    const int bin = std::min(kNumBins - 1, static_cast<int>((blockLufs - kSilenceLufs) / kBinLu));
+    ++histogramCounts_[static_cast<size_t>(bin)];
+    histogramEnergy_[static_cast<size_t>(bin)] += blockEnergy;
+    updateIntegrated();
+}
+
+void LoudnessAnalyser::updateIntegrated() {
+    // Blocks above the absolute gate are all in the histogram; their average sets the
+    // relative gate, and the blocks above that make the reading
+    int count = 0;
+    double energy = 0.0;
+    for (int bin = 0; bin < kNumBins; ++bin) {
+        count += histogramCounts_[static_cast<size_t>(bin)];
+        energy += histogramEnergy_[static_cast<size_t>(bin)];
+    }
+    if (count == 0)
+        return;
+
+    const double relativeGate = energyToLufs(energy / count) + kRelativeGateLu;
+    const int firstBin =
+        std::clamp(static_cast<int>(std::ceil((relativeGate - kSilenceLufs) / kBinLu)), 0,
+                   kNumBins - 1);
+    count = 0;
+    energy = 0.0;
+    for (int bin = firstBin; bin < kNumBins; ++bin) {
+        count += histogramCounts_[static_cast<size_t>(bin)];
+        energy += histogramEnergy_[static_cast<size_t>(bin)];
+    }
+    if (count > 0)
+        integrated_.store(static_cast<float>(energyToLufs(energy / count)),
+                          std::memory_order_relaxed);
+}
+
+}  // namespace magda
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <vector>
+
+#include "AudioTaps.hpp"
+#include "MeteringBuffer.hpp"
+
+namespace magda {
+
+/**
+ * @brief ITU-R BS.1770 / EBU R128 loudness and true peak of a stereo tap
+ *
+ * Each channel is K-weighted (a high shelf and a high pass, designed for the tap's sample
+ * rate) and its energy summed in 100 ms steps. Momentary loudness is the last 400 ms,
+ * short-term the last 3 s; integrated loudness gates the 400 ms blocks at -70 LUFS and
+ * then 10 LU below their average, from a histogram so a long session stays bounded.
+ * True peak is the largest 4x-oversampled peak since the analyser was prepared.
+ *
+ * Analysis thread writes; readings are atomics any thread can read.
+ */
+class LoudnessAnalyser : public AudioTaps::Analyser {
+  public:
+    static constexpr float kSilenceLufs = -70.0f;  // Reported while there's nothing to measure
+
+    void prepare(double sampleRate) override;
+    void process(const float* left, const float* right, int numSamples) override;
+
+    float getMomentaryLufs() const {
+        return momentary_.load(std::memory_order_relaxed);
+    }
+    float getShortTermLufs() const {
+        return shortTerm_.load(std::memory_order_relaxed);
+    }
+    float getIntegratedLufs() const {
+        return integrated_.load(std::memory_order_relaxed);
+    }
+    float getTruePeakDb() const {
+        return truePeakDb_.load(std::memory_order_relaxed);
+    }
+
+  private:
+    static constexpr int kMomentarySteps = 4;   // 400 ms
+    static constexpr int kShortTermSteps = 30;  // 3 s
+    // Gated blocks by loudness, in 0.1 LU bins from the absolute gate up
+    static constexpr float kBinLu = 0.1f;
+    static constexpr int kNumBins = 800;  // -70 to +10 LUFS
+
+    struct Biquad {
+        double b0 = 1.0, b1 = 0.0, b2 = 0.0, a1 = 0.0, a2 = 0.0;
+        double z1 = 0.0, z2 = 0.0;
+
+        double process(double x) {
+            const double y = b0 * x + z1;
+            z1 = b1 * x - a1 * y + z2;
+            z2 = b2 * x - a2 * y;
+            return y;
+        }
+    };
+
+    struct KWeighting {
+        Biquad shelf;
+        Biquad highPass;
+    };
+
+    void stepComplete();
+    void updateIntegrated();
+
+    std::array<KWeighting, 2> weighting_;
+    std::array<TruePeakDetector, 2> truePeak_;
+    float truePeakGain_ = 0.0f;
+
+    int stepSamples_ = 4800;  // 100 ms
+    int stepPosition_ = 0;
+    double stepEnergy_ = 0.0;             // Summed weighted squares of both channels
+    std::vector<double> steps_ = std::vector<double>(kShortTermSteps);  // Mean energy, ring
+    int numSteps_ = 0;                    // Steps ever completed
+
+    std::array<int, kNumBins> histogramCounts_{};
+    std::array<double, kNumBins> histogramEnergy_{};
+
+    std::atomic<float> momentary_{kSilenceLufs};
+    std::atomic<float> shortTerm_{kSilenceLufs};
+    std::atomic<float> integrated_{kSilenceLufs};
+    std::atomic<float> truePeakDb_{-100.0f};
+};
+
+}  // namespace magda
@@ -1,9 +1,14 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
 
 #include "../core/TypeIds.hpp"
+#include "TrackSlotDirectory.hpp"
 
 namespace magda {
 
@@ -24,138 +29,289 @@ struct MeterData {
 };
 
 /**
- * @brief Lock-free SPSC ring buffer for track metering data
+ * @brief Latest meter reading per track, readable by any number of UI views
  *
- * Audio thread pushes meter readings, UI thread pops them.
- * Uses double-buffering per track for simplicity and low latency.
+ * The audio thread publishes each reading into the track's slot under a sequence lock:
+ * the writer never waits, and readers (mixer strips, arrange headers, anything else)
+ * sample the newest value without consuming it, retrying only if they raced a write.
+ * Peak hold and decay are applied once as readings are published, so a reader polling
+ * slower than the writer still sees peaks that arrived between its polls, and every view
+ * shows the same ballistics.
+ *
+ * Each metered track gets a dense slot (assigned on the message thread, see
+ * TrackSlotDirectory), so the number of tracks is bounded by live tracks rather than by how
+ * high track IDs have grown. Each slot sits on its own cache line so neighbouring tracks
+ * don't false-share. Lookups by TrackId are lock-free from any thread.
  */
 class MeteringBuffer {
   public:
-    static constexpr int kMaxTracks = 128;
-    static constexpr int kBufferSize = 8;  // Ring buffer size per track
-
-    MeteringBuffer() {
-        // Initialize all track buffers
-        for (int i = 0; i < kMaxTracks; ++i) {
-            trackBuffers_[i].writeIndex.store(0);
-            trackBuffers_[i].readIndex.store(0);
-        }
+    static constexpr int kSlotsPerChunk = 64;  // Slots allocated together
+    static constexpr int kMaxChunks = 64;      // Up to 4096 metered tracks at once
+    static constexpr int kIdsPerPage = 256;    // TrackId -> slot directory page size
+    static constexpr int kMaxIdPages = 256;    // Track IDs below 65536
+    static constexpr int kNoSlot = -1;
+    static constexpr size_t kCacheLineSize = 64;
+    // Held peaks fall by this factor per published reading (~20 dB/s at 60 readings/s)
+    static constexpr float kPeakDecay = 0.962f;
+    // Held peaks at or below this (-80 dBFS) count as silent, letting meter views go idle
+    static constexpr float kSilenceLevel = 1.0e-4f;
+
+    MeteringBuffer() = default;
+
+    MeteringBuffer(const MeteringBuffer&) = delete;
+    MeteringBuffer& operator=(const MeteringBuffer&) = delete;
+
+    // =========================================================================
+    // Slot management (message thread)
+    // =========================================================================
+
+    /**
+     * @brief Give a track a slot, reusing freed ones first
+     * @return The slot, or kNoSlot if the track ID or slot count is out of range
+     *
+     * Does nothing if the track already has a slot.
+     */
+    int assignSlot(TrackId trackId) {
+        return slots_.assign(trackId);
     }
 
     /**
-     * @brief Push meter data for a track (called from audio thread)
+     * @brief Return a track's slot for reuse
+     *
+     * The track's writer must have stopped pushing (see TrackMeterPlugin).
+     */
+    void releaseSlot(TrackId trackId) {
+        slots_.release(trackId);
+    }
+
+    // =========================================================================
+    // Levels
+    // =========================================================================
+
+    /**
+     * @brief Publish a reading for a track (audio thread; one writer per track)
      * @param trackId The track to push data for
-     * @param data The meter data
-     * @return true if successfully pushed, false if buffer full
+     * @param data The reading (peaks for this window only)
+     * @return false if the track has no slot
+     *
+     * Wait-free. Peaks are held and decayed, RMS is the latest, and clipped stays set
+     * while the held peak is above full scale.
      */
     bool pushLevels(TrackId trackId, const MeterData& data) {
-        if (trackId < 0 || trackId >= kMaxTracks)
+        auto* buffer = slots_.find(trackId);
+        if (!buffer)
             return false;
 
-        auto& buffer = trackBuffers_[trackId];
-        int writeIdx = buffer.writeIndex.load(std::memory_order_relaxed);
-        int readIdx = buffer.readIndex.load(std::memory_order_acquire);
-
-        int nextWrite = (writeIdx + 1) % kBufferSize;
-        if (nextWrite == readIdx) {
-            // Buffer full, drop oldest
-            return false;
+        // Single writer: its own previous values can be read back without the lock
+        const float peakL =
+            std::max(data.peakL, buffer->peakL.load(std::memory_order_relaxed) * kPeakDecay);
+        const float peakR =
+            std::max(data.peakR, buffer->peakR.load(std::memory_order_relaxed) * kPeakDecay);
+
+        const auto sequence = buffer->sequence.load(std::memory_order_relaxed);
+        buffer->sequence.store(sequence + 1, std::memory_order_relaxed);  // Odd: writing
+        std::atomic_thread_fence(std::memory_order_release);
+
+        buffer->peakL.store(peakL, std::memory_order_relaxed);
+        buffer->peakR.store(peakR, std::memory_order_relaxed);
+        buffer->rmsL.store(data.rmsL, std::memory_order_relaxed);
+        buffer->rmsR.store(data.rmsR, std::memory_order_relaxed);
+        buffer->clipped.store(data.clipped || peakL > 1.0f || peakR > 1.0f,
+                              std::memory_order_relaxed);
+
+        buffer->sequence.store(sequence + 2, std::memory_order_release);
+
+        // Checked before storing so render threads don't keep bouncing the line between them
+        if ((peakL > kSilenceLevel || peakR > kSilenceLevel) &&
+            !audible_.load(std::memory_order_relaxed)) {
+            audible_.store(true, std::memory_order_relaxed);
         }
-
-        buffer.data[writeIdx] = data;
-        buffer.writeIndex.store(nextWrite, std::memory_order_release);
         return true;
     }
 
     /**
-     * @brief Pop meter data for a track (called from UI thread)
-     * @param trackId The track to pop data for
-     * @param data Output parameter for the meter data
-     * @return true if data was available, false if buffer empty
+     * @brief Whether any track was above silence since the last call (message thread)
      */
-    bool popLevels(TrackId trackId, MeterData& data) {
-        if (trackId < 0 || trackId >= kMaxTracks)
-            return false;
-
-        auto& buffer = trackBuffers_[trackId];
-        int writeIdx = buffer.writeIndex.load(std::memory_order_acquire);
-        int readIdx = buffer.readIndex.load(std::memory_order_relaxed);
-
-        if (readIdx == writeIdx) {
-            // Buffer empty
-            return false;
-        }
-
-        data = buffer.data[readIdx];
-        buffer.readIndex.store((readIdx + 1) % kBufferSize, std::memory_order_release);
-        return true;
+    bool consumeAudible() {
+        return audible_.exchange(false, std::memory_order_relaxed);
     }
 
     /**
-     * @brief Get latest meter data for a track without removing it
-     * @param trackId The track to peek data for
-     * @param data Output parameter for the meter data
-     * @return true if data was available, false if buffer empty
+     * @brief Latest published reading for a track, without consuming it (any thread)
+     * @param trackId The track to read
+     * @param data Output: held peaks, latest RMS and clip state
+     * @return false if the track has no slot or nothing has been published yet
      */
-    bool peekLatest(TrackId trackId, MeterData& data) {
-        if (trackId < 0 || trackId >= kMaxTracks)
+    bool readLevels(TrackId trackId, MeterData& data) const {
+        const auto* buffer = slots_.find(trackId);
+        if (!buffer)
             return false;
 
-        auto& buffer = trackBuffers_[trackId];
-        int writeIdx = buffer.writeIndex.load(std::memory_order_acquire);
-        int readIdx = buffer.readIndex.load(std::memory_order_relaxed);
+        for (;;) {
+            const auto before = buffer->sequence.load(std::memory_order_acquire);
+            if (before == 0)
+                return false;
+            if (before & 1u)
+                continue;  // Mid-write; the writer finishes within a few stores
+
+            data.peakL = buffer->peakL.load(std::memory_order_relaxed);
+            data.peakR = buffer->peakR.load(std::memory_order_relaxed);
+            data.rmsL = buffer->rmsL.load(std::memory_order_relaxed);
+            data.rmsR = buffer->rmsR.load(std::memory_order_relaxed);
+            data.clipped = buffer->clipped.load(std::memory_order_relaxed);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (buffer->sequence.load(std::memory_order_relaxed) == before)
+                return true;
+        }
+    }
 
-        if (readIdx == writeIdx) {
-            return false;
+  private:
+    struct alignas(kCacheLineSize) TrackBuffer {
+        std::atomic<uint32_t> sequence{0};  // Odd while the writer is publishing
+        std::atomic<float> peakL{0.0f};
+        std::atomic<float> peakR{0.0f};
+        std::atomic<float> rmsL{0.0f};
+        std::atomic<float> rmsR{0.0f};
+        std::atomic<bool> clipped{false};
+
+        // Nobody writes a free slot, so it can be cleared without the sequence lock
+        void clear() {
+            peakL.store(0.0f, std::memory_order_relaxed);
+            peakR.store(0.0f, std::memory_order_relaxed);
+            rmsL.store(0.0f, std::memory_order_relaxed);
+            rmsR.store(0.0f, std::memory_order_relaxed);
+            clipped.store(false, std::memory_order_relaxed);
+            sequence.store(0, std::memory_order_release);
         }
+    };
 
-        // Get the most recent data (one before write index)
-        int latestIdx = (writeIdx - 1 + kBufferSize) % kBufferSize;
-        data = buffer.data[latestIdx];
-        return true;
-    }
+    TrackSlotDirectory<TrackBuffer, kSlotsPerChunk, kMaxChunks> slots_;
+    alignas(kCacheLineSize) std::atomic<bool> audible_{false};
+};
 
-    /**
-     * @brief Drain all pending data for a track, keeping only the latest
-     * @param trackId The track to drain
-     * @param data Output parameter for the latest meter data
-     * @return true if any data was available
-     */
-    bool drainToLatest(TrackId trackId, MeterData& data) {
-        if (trackId < 0 || trackId >= kMaxTracks)
-            return false;
+// ============================================================================
+// Level kernels
+// ============================================================================
 
-        bool hasData = false;
-        while (popLevels(trackId, data)) {
-            hasData = true;
+/**
+ * @brief Peak and sum of squares of a block in one pass
+ * @param peak Raised to the block's absolute peak (not reset)
+ * @param sumSquares Incremented by the block's sum of squares (not reset)
+ *
+ * Accumulates in independent float lanes so the compiler can vectorise without
+ * reassociating, and folds the lanes into the double total every kFlushInterval samples
+ * so long blocks keep their precision.
+ */
+inline void measureBlock(const float* samples, int numSamples, float& peak, double& sumSquares) {
+    constexpr int kLanes = 8;
+    constexpr int kFlushInterval = 1024;
+
+    float lanePeaks[kLanes] = {};
+    int i = 0;
+    while (numSamples - i >= kLanes) {
+        float laneSums[kLanes] = {};
+        const int end = i + std::min(kFlushInterval, (numSamples - i) / kLanes * kLanes);
+        for (; i < end; i += kLanes) {
+            // Keep the lane loop rolled: fully unrolled, GCC -O3 gives up on vectorising it
+#pragma GCC unroll 1
+            for (int lane = 0; lane < kLanes; ++lane) {
+                const float x = samples[i + lane];
+                laneSums[lane] += x * x;
+                lanePeaks[lane] = std::max(lanePeaks[lane], std::abs(x));
+            }
         }
-        return hasData;
+        for (float laneSum : laneSums)
+            sumSquares += laneSum;
+    }
+
+    for (; i < numSamples; ++i) {
+        sumSquares += samples[i] * samples[i];
+        peak = std::max(peak, std::abs(samples[i]));
+    }
+    for (float lanePeak : lanePeaks)
+        peak = std::max(peak, lanePeak);
+}
+
+/**
+ * @brief Inter-sample ("true") peak detector for one channel
+ *
+ * Upsamples 4x with a 48-tap windowed-sinc polyphase filter, as ITU-R BS.1770
+ * recommends, and reports the largest interpolated magnitude. Roughly 50 multiply-adds
+ * per sample, so it's meant for the master strip rather than every track.
+ */
+class TruePeakDetector {
+  public:
+    static constexpr int kOversampling = 4;
+    static constexpr int kTapsPerPhase = 12;
+
+    void reset() {
+        history_.fill(0.0f);
+        position_ = 0;
     }
 
     /**
-     * @brief Clear all data for a track
+     * @brief Feed a block and return its true peak (always >= the sample peak)
      */
-    void clearTrack(TrackId trackId) {
-        if (trackId < 0 || trackId >= kMaxTracks)
-            return;
+    float process(const float* samples, int numSamples) {
+        const auto& phases = getPhases();
+        float peak = 0.0f;
 
-        auto& buffer = trackBuffers_[trackId];
-        buffer.writeIndex.store(0, std::memory_order_relaxed);
-        buffer.readIndex.store(0, std::memory_order_relaxed);
+        for (int i = 0; i < numSamples; ++i) {
+            // Duplicated delay line: taps are always contiguous at history_[position_]
+            position_ = (position_ == 0 ? kTapsPerPhase : position_) - 1;
+            history_[static_cast<size_t>(position_)] = samples[i];
+            history_[static_cast<size_t>(position_ + kTapsPerPhase)] = samples[i];
+            const float* taps = history_.data() + position_;
+
+            peak = std::max(peak, std::abs(samples[i]));
+            for (const auto& phase : phases) {
+                float y = 0.0f;
+                for (int tap = 0; tap < kTapsPerPhase; ++tap)
+                    y += phase[static_cast<size_t>(tap)] * taps[tap];
+                peak = std::max(peak, std::abs(y));
+            }
+        }
+        return peak;
     }
 
   private:
-    struct TrackBuffer {
-        std::array<MeterData, kBufferSize> data{};
-        std::atomic<int> writeIndex{0};
-        std::atomic<int> readIndex{0};
-    };
+    using Phase = std::array<float, kTapsPerPhase>;
+
+    // Blackman-windowed sinc split into kOversampling phases, each normalised to unity gain
+    static const std::array<Phase, kOversampling>& getPhases() {
+        static const auto phases = [] {
+            constexpr int kTaps = kOversampling * kTapsPerPhase;
+            constexpr double kPi = 3.14159265358979323846;
+            const double centre = (kTaps - 1) / 2.0;
+
+            std::array<Phase, kOversampling> result{};
+            for (int p = 0; p < kOversampling; ++p) {
+                double sum = 0.0;
+                for (int tap = 0; tap < kTapsPerPhase; ++tap) {
+                    const int k = tap * kOversampling + p;
+                    const double x = (k - centre) / kOversampling;
+                    const double sinc = std::sin(kPi * x) / (kPi * x);
+                    const double w = 0.42 - 0.5 * std::cos(2.0 * kPi * k / (kTaps - 1)) +
+                                     0.08 * std::cos(4.0 * kPi * k / (kTaps - 1));
+                    result[static_cast<size_t>(p)][static_cast<size_t>(tap)] =
+                        static_cast<float>(sinc * w);
+                    sum += sinc * w;
+                }
+                for (auto& c : result[static_cast<size_t>(p)])
+                    c = static_cast<float>(c / sum);
+            }
+            return result;
+        }();
+        return phases;
+    }
 
-    std::array<TrackBuffer, kMaxTracks> trackBuffers_;
+    std::array<float, kTapsPerPhase * 2> history_{};
+    int position_ = 0;
 };
 
 /**
- * @brief Helper class to accumulate RMS values over time
+ * @brief Helper class to accumulate peak and RMS values over time
  */
 class RMSAccumulator {
   public:
@@ -163,28 +319,72 @@ class RMSAccumulator {
         reset();
     }
 
+    /**
+     * @brief Clear the window (true-peak filter history is kept, it spans windows)
+     */
     void reset() {
         sumSquaresL_ = 0.0;
         sumSquaresR_ = 0.0;
+        peakL_ = 0.0f;
+        peakR_ = 0.0f;
         sampleCount_ = 0;
     }
 
+    /**
+     * @brief Measure inter-sample peaks instead of sample peaks (costlier)
+     */
+    void setTruePeak(bool enabled) {
+        if (enabled && !truePeak_) {
+            truePeakL_.reset();
+            truePeakR_.reset();
+        }
+        truePeak_ = enabled;
+    }
+
+    bool isTruePeak() const {
+        return truePeak_;
+    }
+
     void addSample(float left, float right) {
         sumSquaresL_ += left * left;
         sumSquaresR_ += right * right;
+        peakL_ = std::max(peakL_, std::abs(left));
+        peakR_ = std::max(peakR_, std::abs(right));
         sampleCount_++;
     }
 
+    /**
+     * @brief Add a stereo block (a null channel counts as silence)
+     */
     void addBlock(const float* leftChannel, const float* rightChannel, int numSamples) {
-        for (int i = 0; i < numSamples; ++i) {
-            float l = leftChannel ? leftChannel[i] : 0.0f;
-            float r = rightChannel ? rightChannel[i] : 0.0f;
-            sumSquaresL_ += l * l;
-            sumSquaresR_ += r * r;
-        }
+        if (leftChannel)
+            addChannel(leftChannel, numSamples, peakL_, sumSquaresL_, truePeakL_);
+        if (rightChannel)
+            addChannel(rightChannel, numSamples, peakR_, sumSquaresR_, truePeakR_);
         sampleCount_ += numSamples;
     }
 
+    /**
+     * @brief Add a block with any channel count
+     *
+     * Mono is metered on both sides; beyond stereo, channels 2+ are folded into the left
+     * (even) and right (odd) peaks so a multichannel bus still shows its loudest channel.
+     * RMS follows the first two channels.
+     */
+    void addBlock(const float* const* channels, int numChannels, int numSamples) {
+        if (numChannels <= 0) {
+            sampleCount_ += numSamples;
+            return;
+        }
+
+        addBlock(channels[0], numChannels > 1 ? channels[1] : channels[0], numSamples);
+
+        for (int ch = 2; ch < numChannels; ++ch) {
+            double ignored = 0.0;
+            measureBlock(channels[ch], numSamples, (ch % 2) ? peakR_ : peakL_, ignored);
+        }
+    }
+
     bool isWindowComplete() const {
         return sampleCount_ >= windowSize_;
     }
@@ -197,15 +397,36 @@ class RMSAccumulator {
         return sampleCount_ > 0 ? std::sqrt(static_cast<float>(sumSquaresR_ / sampleCount_)) : 0.0f;
     }
 
+    float getPeakL() const {
+        return peakL_;
+    }
+
+    float getPeakR() const {
+        return peakR_;
+    }
+
     int getSampleCount() const {
         return sampleCount_;
     }
 
   private:
+    void addChannel(const float* samples, int numSamples, float& peak, double& sumSquares,
+                    TruePeakDetector& truePeak) {
+        measureBlock(samples, numSamples, peak, sumSquares);
+        if (truePeak_)
+            peak = std::max(peak, truePeak.process(samples, numSamples));
+    }
+
     int windowSize_;
     double sumSquaresL_;
     double sumSquaresR_;
+    float peakL_;
+    float peakR_;
     int sampleCount_;
+
+    bool truePeak_ = false;
+    TruePeakDetector truePeakL_;
+    TruePeakDetector truePeakR_;
 };
 
 }  // namespace magda
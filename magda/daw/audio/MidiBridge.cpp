@@ -1,5 +1,7 @@
 #include "MidiBridge.hpp"
 
+#include <optional>
+
 #include "AudioBridge.hpp"
 
 namespace magda {
@@ -15,7 +17,7 @@ void MidiBridge::setAudioBridge(AudioBridge* audioBridge) {
 MidiBridge::~MidiBridge() {
     // IMPORTANT: Release MIDI inputs carefully to avoid CoreMIDI crashes
     // Don't hold lock while destroying MIDI inputs (can cause deadlock)
-    std::unordered_map<juce::String, std::unique_ptr<juce::MidiInput>> inputsToDestroy;
+    std::unordered_map<juce::String, ActiveInput> inputsToDestroy;
 
     {
         juce::ScopedLock lock(routingLock_);
@@ -26,12 +28,15 @@ MidiBridge::~MidiBridge() {
     }
 
     // Destroy MIDI inputs outside of lock
-    for (auto& [deviceId, midiInput] : inputsToDestroy) {
-        if (midiInput) {
-            midiInput->stop();
+    for (auto& [deviceId, active] : inputsToDestroy) {
+        if (active.input) {
+            active.input->stop();
         }
     }
     inputsToDestroy.clear();
+
+    // No input thread can be reading the routing table now
+    routingTable_.clear();
 }
 
 std::vector<MidiDeviceInfo> MidiBridge::getAvailableMidiInputs() const {
@@ -85,10 +90,20 @@ void MidiBridge::enableMidiInput(const juce::String& deviceId) {
 
     for (const auto& deviceInfo : availableDevices) {
         if (deviceInfo.identifier == deviceId) {
-            auto midiInput = juce::MidiInput::openDevice(deviceInfo.identifier, this);
-            if (midiInput) {
-                midiInput->start();
-                activeMidiInputs_[deviceId] = std::move(midiInput);
+            const size_t inputIndex = internInput(deviceId);
+            if (inputIndex >= kMaxInputs) {
+                DBG("Too many MIDI inputs, not monitoring: " << deviceInfo.name);
+                break;
+            }
+
+            ActiveInput active;
+            active.listener = std::make_unique<InputListener>(*this, inputIndex);
+            active.input =
+                juce::MidiInput::openDevice(deviceInfo.identifier, active.listener.get());
+            if (active.input) {
+                publishRoutingTable();  // Make sure the table covers the new index
+                active.input->start();
+                activeMidiInputs_[deviceId] = std::move(active);
                 DBG("Started MIDI activity monitoring for: " << deviceInfo.name);
             }
             break;
@@ -101,8 +116,8 @@ void MidiBridge::disableMidiInput(const juce::String& deviceId) {
     juce::ScopedLock lock(routingLock_);
     auto it = activeMidiInputs_.find(deviceId);
     if (it != activeMidiInputs_.end()) {
-        if (it->second) {
-            it->second->stop();
+        if (it->second.input) {
+            it->second.input->stop();
         }
         activeMidiInputs_.erase(it);
     }
@@ -142,11 +157,61 @@ void MidiBridge::setTrackMidiInput(TrackId trackId, const juce::String& midiDevi
         }
     }
 
-    // Debug: print current routing state
-    DBG("  -> Current track routings:");
-    for (const auto& [tid, did] : trackMidiInputs_) {
-        DBG("     track " << tid << " -> '" << did << "'");
+    publishRoutingTable();
+}
+
+size_t MidiBridge::internInput(const juce::String& deviceId) {
+    auto it = inputIndices_.find(deviceId);
+    if (it != inputIndices_.end()) {
+        return it->second;
     }
+    if (inputIndices_.size() >= kMaxInputs) {
+        return kMaxInputs;
+    }
+
+    const size_t index = inputIndices_.size();
+    inputIndices_.emplace(deviceId, index);
+    return index;
+}
+
+void MidiBridge::publishRoutingTable() {
+    // Bucket routed tracks by input index; "all" routings go into every bucket
+    std::vector<std::vector<RoutingTable::Target>> buckets(inputIndices_.size());
+    std::vector<RoutingTable::Target> allInputs;
+    for (const auto& [trackId, deviceId] : trackMidiInputs_) {
+        RoutingTable::Target target{trackId, monitoredTracks_.count(trackId) > 0};
+        const auto capture = captures_.find(trackId);
+        if (capture != captures_.end()) {
+            target.capture = capture->second.get();
+        }
+        if (deviceId == "all") {
+            allInputs.push_back(target);
+            continue;
+        }
+
+        const size_t index = internInput(deviceId);
+        if (index >= kMaxInputs) {
+            continue;  // Can't be opened, so it can't deliver anything either
+        }
+        if (index >= buckets.size()) {
+            buckets.resize(index + 1);
+        }
+        buckets[index].push_back(target);
+    }
+
+    auto table = std::make_unique<RoutingTable>();
+    for (const auto& [trackId, queue] : captures_) {
+        table->captures.push_back(queue);
+    }
+    table->ranges.resize(buckets.size());
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        table->ranges[i].begin = static_cast<int>(table->targets.size());
+        table->targets.insert(table->targets.end(), buckets[i].begin(), buckets[i].end());
+        table->targets.insert(table->targets.end(), allInputs.begin(), allInputs.end());
+        table->ranges[i].count = static_cast<int>(table->targets.size()) - table->ranges[i].begin;
+    }
+
+    routingTable_.publish(std::move(table));
 }
 
 juce::String MidiBridge::getTrackMidiInput(TrackId trackId) const {
@@ -163,84 +228,103 @@ void MidiBridge::clearTrackMidiInput(TrackId trackId) {
     setTrackMidiInput(trackId, {});  // This will trigger the callback
 }
 
-void MidiBridge::handleIncomingMidiMessage(juce::MidiInput* source,
-                                           const juce::MidiMessage& message) {
-    if (!source) {
-        return;
-    }
-
-    // Skip MIDI clock and other system messages for activity/routing
-    if (message.isMidiClock() || message.isActiveSense() || message.isMidiStart() ||
-        message.isMidiStop() || message.isMidiContinue()) {
+void MidiBridge::handleInputMessage(size_t inputIndex, const juce::MidiMessage& message) {
+    if (!audioBridge_) {
         return;
     }
 
-    // Get the device ID for this input
-    juce::String sourceDeviceId = source->getIdentifier();
-
-    // Debug: Log MIDI message receipt
+    // NOTE: MIDI routing to plugins is handled by Tracktion Engine's native
+    // InputDeviceInstance -> MidiInputDeviceNode system. MidiBridge only reports
+    // activity to the UI, through AudioBridge's event queue.
+    AudioEvent event;
     if (message.isNoteOn()) {
-        DBG("MidiBridge: Note ON received - note="
-            << message.getNoteNumber() << " vel=" << message.getVelocity() << " from '"
-            << source->getName() << "' (id='" << sourceDeviceId << "')"
-            << " trackRoutings=" << trackMidiInputs_.size());
+        event.type = AudioEvent::Type::NoteOn;
+        event.data1 = message.getNoteNumber();
+        event.data2 = message.getVelocity();
+    } else if (message.isNoteOff()) {
+        event.type = AudioEvent::Type::NoteOff;
+        event.data1 = message.getNoteNumber();
+        event.data2 = message.getVelocity();
+    } else if (message.isController()) {
+        event.type = AudioEvent::Type::Controller;
+        event.data1 = message.getControllerNumber();
+        event.data2 = message.getControllerValue();
+    } else {
+        return;  // Clock, active sense and other system messages
     }
 
-    // Find all tracks routing this MIDI input
-    juce::ScopedLock lock(routingLock_);
-
-    for (const auto& [trackId, deviceId] : trackMidiInputs_) {
-        // Check if this track is routing this device (or "all" inputs)
-        bool matches = (deviceId == sourceDeviceId || deviceId == "all");
-
-        if (message.isNoteOn()) {
-            DBG("  -> Checking track " << trackId << ": routing='" << deviceId << "' vs source='"
-                                       << sourceDeviceId << "' -> "
-                                       << (matches ? "MATCH" : "no match"));
-        }
-
-        if (matches) {
-            // NOTE: MIDI routing to plugins is now handled by Tracktion Engine's
-            // native InputDeviceInstance -> MidiInputDeviceNode system.
-            // MidiBridge only monitors MIDI activity for UI visualization.
-
-            // Trigger MIDI activity indicator (only for notes)
-            if (audioBridge_ && message.isNoteOn()) {
-                audioBridge_->triggerMidiActivity(trackId);
-            }
+    // Note-ons always go out (they drive the activity indicators); the rest only for
+    // monitored tracks
+    const bool always = event.type == AudioEvent::Type::NoteOn;
+    if (always) {
+        audioBridge_->markMidiInput(message.getTimeStamp());
+    }
 
-            // Check if monitoring is enabled for this track for callbacks
-            if (monitoredTracks_.find(trackId) != monitoredTracks_.end()) {
-                // Call callbacks if set (for note/CC monitoring)
-                if (message.isNoteOn() || message.isNoteOff()) {
-                    if (onNoteEvent) {
-                        MidiNoteEvent noteEvent;
-                        noteEvent.noteNumber = message.getNoteNumber();
-                        noteEvent.velocity = message.getVelocity();
-                        noteEvent.isNoteOn = message.isNoteOn();
-                        onNoteEvent(trackId, noteEvent);
-                    }
-                } else if (message.isController()) {
-                    if (onCCEvent) {
-                        MidiCCEvent ccEvent;
-                        ccEvent.controller = message.getControllerNumber();
-                        ccEvent.value = message.getControllerValue();
-                        onCCEvent(trackId, ccEvent);
+    // Where the transport was being heard when the message arrived, for recording tracks
+    std::optional<CapturedMidiEvent> captured;
+
+    auto* table = routingTable_.acquire(inputIndex);
+    if (table && inputIndex < table->ranges.size()) {
+        const auto& range = table->ranges[inputIndex];
+        for (int i = range.begin; i < range.begin + range.count; ++i) {
+            const auto& target = table->targets[static_cast<size_t>(i)];
+            if (message.isNoteOnOrOff()) {
+                audioBridge_->modNoteInput(target.trackId, message.getChannel(),
+                                           message.getNoteNumber(), message.isNoteOn());
+                if (target.capture) {
+                    if (!captured) {
+                        captured = captureEvent(message);
                     }
+                    target.capture->push(*captured);
                 }
             }
+            if (always || target.monitored) {
+                event.trackId = target.trackId;
+                audioBridge_->postEvent(event);
+            }
         }
     }
+    routingTable_.release(inputIndex);
+}
+
+CapturedMidiEvent MidiBridge::captureEvent(const juce::MidiMessage& message) const {
+    CapturedMidiEvent event;
+    PlayheadClock::Sample sample;
+    if (audioBridge_->getPlayheadClock().read(sample)) {
+        event.timeSeconds = PlayheadClock::extrapolate(sample, message.getTimeStamp() * 1000.0);
+    }
+    event.channel = static_cast<uint8_t>(message.getChannel());
+    event.noteNumber = static_cast<uint8_t>(message.getNoteNumber());
+    event.velocity = message.getVelocity();
+    event.noteOn = message.isNoteOn();
+    return event;
+}
+
+void MidiBridge::startCapture(TrackId trackId, std::shared_ptr<MidiCaptureQueue> queue) {
+    juce::ScopedLock lock(routingLock_);
+    captures_[trackId] = std::move(queue);
+    publishRoutingTable();
+}
+
+void MidiBridge::stopCapture(TrackId trackId) {
+    juce::ScopedLock lock(routingLock_);
+    if (captures_.erase(trackId) > 0) {
+        publishRoutingTable();
+    }
 }
 
 void MidiBridge::startMonitoring(TrackId trackId) {
     juce::ScopedLock lock(routingLock_);
-    monitoredTracks_.insert(trackId);
+    if (monitoredTracks_.insert(trackId).second) {
+        publishRoutingTable();
+    }
 }
 
 void MidiBridge::stopMonitoring(TrackId trackId) {
     juce::ScopedLock lock(routingLock_);
-    monitoredTracks_.erase(trackId);
+    if (monitoredTracks_.erase(trackId) > 0) {
+        publishRoutingTable();
+    }
     DBG("Stopped MIDI monitoring for track " << trackId);
 }
 
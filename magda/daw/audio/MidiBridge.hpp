@@ -5,9 +5,13 @@
 #include <functional>
 #include <memory>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "../core/MidiTypes.hpp"
 #include "../core/TypeIds.hpp"
+#include "MidiCapture.hpp"
+#include "RealtimeSnapshot.hpp"
 
 namespace magda {
 
@@ -23,11 +27,13 @@ class AudioBridge;
  * - Enumerate and manage MIDI input devices
  * - Route MIDI inputs to tracks
  * - Monitor MIDI activity for visualization
+ * - Capture routed input into recording tracks' queues
  * - Thread-safe communication between UI and audio threads
  *
- * Similar to AudioBridge, but for MIDI.
+ * Similar to AudioBridge, but for MIDI. Each open input gets a small interned index, and
+ * routing edits compile an index -> tracks table that the MIDI threads read lock-free.
  */
-class MidiBridge : public juce::MidiInputCallback {
+class MidiBridge {
   public:
     explicit MidiBridge(te::Engine& engine);
     ~MidiBridge() override;
@@ -37,7 +43,7 @@ class MidiBridge : public juce::MidiInputCallback {
     MidiBridge& operator=(MidiBridge&&) = delete;
 
     /**
-     * @brief Set AudioBridge reference for triggering MIDI activity and track lookup
+     * @brief Set AudioBridge reference for posting MIDI events and track lookup
      * Must be called after AudioBridge is created
      */
     void setAudioBridge(AudioBridge* audioBridge);
@@ -114,23 +120,11 @@ class MidiBridge : public juce::MidiInputCallback {
     // MIDI Monitoring (for visualization)
     // =========================================================================
 
-    /**
-     * @brief Callback when MIDI note event received on a track
-     * Parameters: (trackId, noteEvent)
-     * Called from audio thread - keep handlers lightweight!
-     */
-    std::function<void(TrackId, const MidiNoteEvent&)> onNoteEvent;
-
-    /**
-     * @brief Callback when MIDI CC event received on a track
-     * Parameters: (trackId, ccEvent)
-     * Called from audio thread - keep handlers lightweight!
-     */
-    std::function<void(TrackId, const MidiCCEvent&)> onCCEvent;
-
     /**
      * @brief Start monitoring MIDI events for a track
-     * Enables callbacks for note/CC events
+     *
+     * Note-ons on routed tracks are always posted to AudioBridge's event queue (for the
+     * activity indicators); monitoring adds the track's note-offs and CCs.
      */
     void startMonitoring(TrackId trackId);
 
@@ -144,26 +138,101 @@ class MidiBridge : public juce::MidiInputCallback {
      */
     bool isMonitoring(TrackId trackId) const;
 
+    // =========================================================================
+    // MIDI Capture (recording)
+    // =========================================================================
+
+    /**
+     * @brief Push the track's routed note events into queue until stopCapture()
+     *
+     * The MIDI threads stamp each event with the transport position being heard when it
+     * arrived (from AudioBridge's PlayheadClock) and push it without taking a lock.
+     */
+    void startCapture(TrackId trackId, std::shared_ptr<MidiCaptureQueue> queue);
+    void stopCapture(TrackId trackId);
+
+    // Most MIDI inputs that can be open at once (one routing-table reader slot each)
+    static constexpr size_t kMaxInputs = 32;
+
   private:
-    // MidiInputCallback implementation
-    void handleIncomingMidiMessage(juce::MidiInput* source,
-                                   const juce::MidiMessage& message) override;
+    /**
+     * @brief Receives one input's messages and tags them with its interned index
+     */
+    class InputListener : public juce::MidiInputCallback {
+      public:
+        InputListener(MidiBridge& owner, size_t inputIndex)
+            : owner_(owner), inputIndex_(inputIndex) {}
+
+        void handleIncomingMidiMessage(juce::MidiInput* /*source*/,
+                                       const juce::MidiMessage& message) override {
+            owner_.handleInputMessage(inputIndex_, message);
+        }
+
+      private:
+        MidiBridge& owner_;
+        size_t inputIndex_;
+    };
+
+    struct ActiveInput {
+        std::unique_ptr<InputListener> listener;
+        std::unique_ptr<juce::MidiInput> input;  // Declared last: stops before listener goes
+    };
+
+    /**
+     * @brief Compiled routing for the MIDI threads: input index -> tracks listening to it
+     *
+     * "all" routings are expanded into every input's range, and monitoring is baked in, so
+     * a message costs one array index and a walk over its targets.
+     */
+    struct RoutingTable {
+        struct Target {
+            TrackId trackId = INVALID_TRACK_ID;
+            bool monitored = false;
+            MidiCaptureQueue* capture = nullptr;  // Recording into it, kept alive by captures
+        };
+        struct Range {
+            int begin = 0;
+            int count = 0;
+        };
+        std::vector<Range> ranges;  // Indexed by input index
+        std::vector<Target> targets;
+        std::vector<std::shared_ptr<MidiCaptureQueue>> captures;
+    };
+
+    // MIDI thread: post a message to every track routed to this input
+    void handleInputMessage(size_t inputIndex, const juce::MidiMessage& message);
+    CapturedMidiEvent captureEvent(const juce::MidiMessage& message) const;
+
+    // Stable index for a device id (kMaxInputs if all slots are taken); caller holds lock
+    size_t internInput(const juce::String& deviceId);
+
+    // Rebuild and publish routingTable_ (message thread, caller holds routingLock_)
+    void publishRoutingTable();
 
     te::Engine& engine_;
 
-    // AudioBridge reference for triggering MIDI activity (not owned)
+    // AudioBridge reference for posting MIDI events to the UI (not owned)
     AudioBridge* audioBridge_ = nullptr;
 
     // Track MIDI input routing (trackId → MIDI device ID)
     std::unordered_map<TrackId, juce::String> trackMidiInputs_;
 
+    // Interned input indices (never reused, so a stale table can't misroute)
+    std::unordered_map<juce::String, size_t> inputIndices_;
+
+    // Published routing (message thread writes, MIDI threads read - lock-free)
+    RealtimeSnapshot<RoutingTable, kMaxInputs> routingTable_;
+
     // Tracks being monitored for MIDI activity
     std::unordered_set<TrackId> monitoredTracks_;
 
+    // Tracks recording their input (trackId -> queue the MIDI threads push into)
+    std::unordered_map<TrackId, std::shared_ptr<MidiCaptureQueue>> captures_;
+
     // Active MIDI input listeners (deviceId → MidiInput)
-    std::unordered_map<juce::String, std::unique_ptr<juce::MidiInput>> activeMidiInputs_;
+    std::unordered_map<juce::String, ActiveInput> activeMidiInputs_;
 
-    // Synchronization for UI thread access
+    // Synchronization for message-thread edits (never taken by the MIDI threads)
     mutable juce::CriticalSection routingLock_;
 
     // Whether to forward MIDI to instrument plugins
@@ -0,0 +1,49 @@
+#include "MidiCapture.hpp"
+
+#include <algorithm>
+
+namespace magda {
+
+void MidiTakeBuilder::add(const CapturedMidiEvent& event) {
+    const size_t channel = static_cast<size_t>(std::clamp<int>(event.channel, 1, 16) - 1);
+    const size_t noteNumber = std::min<size_t>(event.noteNumber, 127);
+    auto& held = held_[channel * 128 + noteNumber];
+
+    if (held.velocity > 0) {
+        end(held, static_cast<int>(noteNumber), event.timeSeconds);
+    }
+    if (event.noteOn && event.velocity > 0) {
+        held.startSeconds = event.timeSeconds;
+        held.velocity = event.velocity;
+        ++numHeld_;
+    }
+}
+
+void MidiTakeBuilder::finish(double endSeconds) {
+    for (size_t i = 0; i < held_.size() && numHeld_ > 0; ++i) {
+        if (held_[i].velocity > 0) {
+            end(held_[i], static_cast<int>(i % 128), endSeconds);
+        }
+    }
+}
+
+std::vector<MidiTakeBuilder::Note> MidiTakeBuilder::takeFinished() {
+    std::vector<Note> notes;
+    notes.swap(finished_);
+    return notes;
+}
+
+void MidiTakeBuilder::end(Held& held, int noteNumber, double endSeconds) {
+    Note note;
+    note.noteNumber = noteNumber;
+    note.velocity = held.velocity;
+    note.startSeconds = held.startSeconds;
+    note.endSeconds = std::max(endSeconds, held.startSeconds + kMinNoteSeconds);
+    finished_.push_back(note);
+    latestEndSeconds_ = std::max(latestEndSeconds_, note.endSeconds);
+
+    held.velocity = 0;
+    --numHeld_;
+}
+
+}  // namespace magda
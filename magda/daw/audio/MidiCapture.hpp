@@ -0,0 +1,91 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "AudioEventQueue.hpp"
+
+namespace magda {
+
+/**
+ * @brief One note event from a track's MIDI input, placed where it was heard
+ */
+struct CapturedMidiEvent {
+    double timeSeconds = 0.0;  // Transport position being heard when it arrived
+    uint8_t channel = 1;       // 1-16
+    uint8_t noteNumber = 0;
+    uint8_t velocity = 0;
+    bool noteOn = false;
+};
+
+/**
+ * @brief A recording track's input, from the MIDI threads to the message thread
+ *
+ * Sized for a few seconds of dense playing between drains; beyond that events are dropped
+ * and counted like any MpscEventQueue.
+ */
+using MidiCaptureQueue = MpscEventQueue<CapturedMidiEvent, 4096>;
+
+/**
+ * @brief Pairs a take's note-ons with their note-offs
+ *
+ * Events arrive in the order played. A note-on starts a note on its channel and pitch; the
+ * matching note-off (or a repeated note-on, which retriggers) ends it. Ended notes collect
+ * until takeFinished() hands them over, so the caller can add them to a clip in bulk at
+ * whatever rate it displays them. finish() ends any notes still held.
+ *
+ * Times are transport seconds; the caller converts to the clip's beats. Pure bookkeeping,
+ * no engine or clip access.
+ */
+class MidiTakeBuilder {
+  public:
+    struct Note {
+        int noteNumber = 0;
+        int velocity = 0;
+        double startSeconds = 0.0;
+        double endSeconds = 0.0;
+    };
+
+    // Shortest note kept: an off at (or, across a loop wrap, before) its on still sounds
+    static constexpr double kMinNoteSeconds = 0.005;
+
+    void add(const CapturedMidiEvent& event);
+
+    /**
+     * @brief End every held note at endSeconds
+     */
+    void finish(double endSeconds);
+
+    /**
+     * @brief Notes ended since the last call, in the order they ended
+     */
+    std::vector<Note> takeFinished();
+
+    int getNumHeld() const {
+        return numHeld_;
+    }
+
+    /**
+     * @brief Latest end of any note so far (0 before the first one ends)
+     */
+    double getLatestEndSeconds() const {
+        return latestEndSeconds_;
+    }
+
+  private:
+    struct Held {
+        double startSeconds = 0.0;
+        int velocity = 0;  // 0 while not held
+    };
+
+    void end(Held& held, int noteNumber, double endSeconds);
+
+    std::array<Held, 16 * 128> held_{};  // By channel and note
+    std::vector<Note> finished_;
+    int numHeld_ = 0;
+    double latestEndSeconds_ = 0.0;
+};
+
+}  // namespace magda
@@ -0,0 +1,339 @@
+#include "MidiFileImporter.hpp"
+
+#include <algorithm>
+#include <array>
+
+namespace magda {
+
+namespace {
+
+// A note with no length still gets one, so it can be seen and played
+constexpr double kMinNoteBeats = 1.0 / 64.0;
+constexpr double kDefaultBpm = 120.0;
+
+// Notes are paired by readTrack(), in one pass, rather than by JUCE on reading
+std::unique_ptr<juce::MidiFile> readMidiFile(const juce::File& file) {
+    juce::FileInputStream stream(file);
+    auto midiFile = std::make_unique<juce::MidiFile>();
+    if (!stream.openedOk() || !midiFile->readFrom(stream, false)) {
+        return nullptr;
+    }
+    return midiFile;
+}
+
+/**
+ * @brief Timestamps per beat, converting a timecode file's to seconds first
+ *
+ * Timecode (SMPTE) files count in frames rather than beats; their notes are placed at
+ * the file's first tempo.
+ */
+double prepareTimestamps(juce::MidiFile& midiFile) {
+    const auto timeFormat = midiFile.getTimeFormat();
+    if (timeFormat > 0) {
+        return timeFormat;
+    }
+
+    juce::MidiMessageSequence tempos;
+    midiFile.findAllTempoEvents(tempos);
+    double bpm = kDefaultBpm;
+    if (tempos.getNumEvents() > 0) {
+        const auto& tempo = tempos.getEventPointer(0)->message;
+        const double secondsPerBeat = tempo.getTempoSecondsPerQuarterNote();
+        if (secondsPerBeat > 0.0) {
+            bpm = 60.0 / secondsPerBeat;
+        }
+    }
+    midiFile.convertTimestampTicksToSeconds();
+    return 60.0 / bpm;
+}
+
+}  // namespace
+
+// =============================================================================
+// Jobs
+// =============================================================================
+
+class MidiFileImporter::ReadJob : public juce::ThreadPoolJob {
+  public:
+    ReadJob(const juce::File& source, int importId, std::shared_ptr<std::atomic<bool>> alive)
+        : juce::ThreadPoolJob("Read MIDI file"),
+          source_(source),
+          importId_(importId),
+          alive_(std::move(alive)) {}
+
+    JobStatus runJob() override {
+        // Timecode files are converted here, before the tracks are shared between jobs
+        std::shared_ptr<juce::MidiFile> midiFile = readMidiFile(source_);
+        const double ticksPerBeat = midiFile != nullptr ? prepareTimestamps(*midiFile) : 0.0;
+        if (shouldExit()) {
+            return jobHasFinished;
+        }
+
+        auto alive = alive_;
+        auto importId = importId_;
+        juce::MessageManager::callAsync([alive, importId, midiFile, ticksPerBeat]() {
+            if (alive->load()) {
+                MidiFileImporter::getInstance().fileRead(importId, midiFile, ticksPerBeat);
+            }
+        });
+        return jobHasFinished;
+    }
+
+  private:
+    juce::File source_;
+    int importId_;
+    std::shared_ptr<std::atomic<bool>> alive_;
+};
+
+class MidiFileImporter::TrackJob : public juce::ThreadPoolJob {
+  public:
+    TrackJob(std::shared_ptr<const juce::MidiFile> midiFile, double ticksPerBeat, int importId,
+             size_t index, std::shared_ptr<std::atomic<bool>> alive)
+        : juce::ThreadPoolJob("Read MIDI track"),
+          midiFile_(std::move(midiFile)),
+          ticksPerBeat_(ticksPerBeat),
+          importId_(importId),
+          index_(index),
+          alive_(std::move(alive)) {}
+
+    JobStatus runJob() override {
+        auto track = std::make_shared<Track>(
+            readTrack(*midiFile_->getTrack(static_cast<int>(index_)), ticksPerBeat_));
+        if (shouldExit()) {
+            return jobHasFinished;
+        }
+
+        auto alive = alive_;
+        auto importId = importId_;
+        auto index = index_;
+        juce::MessageManager::callAsync([alive, importId, index, track]() {
+            if (alive->load()) {
+                MidiFileImporter::getInstance().trackRead(importId, index, std::move(*track));
+            }
+        });
+        return jobHasFinished;
+    }
+
+  private:
+    std::shared_ptr<const juce::MidiFile> midiFile_;
+    double ticksPerBeat_;
+    int importId_;
+    size_t index_;
+    std::shared_ptr<std::atomic<bool>> alive_;
+};
+
+// =============================================================================
+// MidiFileImporter
+// =============================================================================
+
+MidiFileImporter::MidiFileImporter() {
+    // Pairing notes is CPU-bound; leave cores for the audio and message threads
+    pool_ =
+        std::make_unique<juce::ThreadPool>(juce::jlimit(1, 4, juce::SystemStats::getNumCpus() / 2));
+}
+
+MidiFileImporter& MidiFileImporter::getInstance() {
+    static MidiFileImporter instance;
+    return instance;
+}
+
+bool MidiFileImporter::isSupportedFile(const juce::File& file) {
+    return file.hasFileExtension("mid;midi");
+}
+
+void MidiFileImporter::importFile(const juce::File& file, Callback onDone) {
+    if (!pool_) {
+        return;
+    }
+
+    const int importId = ++nextImportId_;
+    auto& pending = imports_[importId];
+    pending.result.source = file;
+    pending.onDone = std::move(onDone);
+    pool_->addJob(new ReadJob(file, importId, alive_), true);
+}
+
+void MidiFileImporter::fileRead(int importId, std::shared_ptr<const juce::MidiFile> midiFile,
+                                double ticksPerBeat) {
+    auto it = imports_.find(importId);
+    if (it == imports_.end()) {
+        return;
+    }
+    auto& pending = it->second;
+    if (midiFile == nullptr || !pool_) {
+        pending.result.failed = true;
+        finish(it);
+        return;
+    }
+
+    const int numTracks = midiFile->getNumTracks();
+    pending.result.tracks.resize(static_cast<size_t>(numTracks));
+    pending.remaining = numTracks;
+    if (numTracks == 0) {
+        finish(it);
+        return;
+    }
+    for (int i = 0; i < numTracks; ++i) {
+        pool_->addJob(
+            new TrackJob(midiFile, ticksPerBeat, importId, static_cast<size_t>(i), alive_), true);
+    }
+}
+
+void MidiFileImporter::trackRead(int importId, size_t index, Track track) {
+    auto it = imports_.find(importId);
+    if (it == imports_.end()) {
+        return;
+    }
+    auto& pending = it->second;
+    pending.result.tracks[index] = std::move(track);
+    if (--pending.remaining == 0) {
+        finish(it);
+    }
+}
+
+void MidiFileImporter::finish(std::map<int, Import>::iterator it) {
+    auto finished = std::move(it->second);
+    imports_.erase(it);
+
+    auto& tracks = finished.result.tracks;
+    tracks.erase(std::remove_if(tracks.begin(), tracks.end(),
+                                [](const Track& track) { return track.notes.empty(); }),
+                 tracks.end());
+    if (finished.onDone) {
+        finished.onDone(finished.result);
+    }
+}
+
+MidiFileImporter::Result MidiFileImporter::readFile(const juce::File& file) {
+    Result result;
+    result.source = file;
+
+    auto midiFile = readMidiFile(file);
+    if (midiFile == nullptr) {
+        result.failed = true;
+        return result;
+    }
+
+    const double ticksPerBeat = prepareTimestamps(*midiFile);
+    for (int i = 0; i < midiFile->getNumTracks(); ++i) {
+        auto track = readTrack(*midiFile->getTrack(i), ticksPerBeat);
+        if (!track.notes.empty()) {
+            result.tracks.push_back(std::move(track));
+        }
+    }
+    return result;
+}
+
+MidiFileImporter::Track MidiFileImporter::readTrack(const juce::MidiMessageSequence& sequence,
+                                                    double ticksPerBeat) {
+    Track track;
+    if (ticksPerBeat <= 0.0) {
+        return track;
+    }
+
+    // Notes sounding on each channel and pitch, earliest first, by position in track.notes
+    std::array<std::vector<size_t>, 16 * MidiNoteList::NUM_PITCHES> sounding;
+    auto soundingFor = [&sounding](const juce::MidiMessage& message) -> std::vector<size_t>& {
+        const int channel = juce::jlimit(1, 16, message.getChannel()) - 1;
+        return sounding[static_cast<size_t>(channel * MidiNoteList::NUM_PITCHES +
+                                            message.getNoteNumber())];
+    };
+
+    track.notes.reserve(static_cast<size_t>(sequence.getNumEvents() / 2));
+    double lastBeat = 0.0;
+    for (int i = 0; i < sequence.getNumEvents(); ++i) {
+        const auto& message = sequence.getEventPointer(i)->message;
+        const double beat = message.getTimeStamp() / ticksPerBeat;
+        lastBeat = std::max(lastBeat, beat);
+
+        if (message.isTrackNameEvent()) {
+            if (track.name.isEmpty()) {
+                track.name = message.getTextFromTextMetaEvent();
+            }
+        } else if (message.isNoteOn()) {
+            MidiNote note;
+            note.noteNumber = message.getNoteNumber();
+            note.velocity = message.getVelocity();
+            note.startBeat = beat;
+            note.lengthBeats = 0.0;
+            soundingFor(message).push_back(track.notes.size());
+            track.notes.push_back(note);
+        } else if (message.isNoteOff()) {
+            auto& open = soundingFor(message);
+            if (!open.empty()) {
+                auto& note = track.notes[open.front()];
+                note.lengthBeats = beat - note.startBeat;
+                open.erase(open.begin());
+            }
+        }
+    }
+
+    for (const auto& open : sounding) {
+        for (const auto index : open) {
+            track.notes[index].lengthBeats = lastBeat - track.notes[index].startBeat;
+        }
+    }
+
+    // Events come in time order, so this only reorders chords into MidiNoteList's order
+    std::stable_sort(track.notes.begin(), track.notes.end(),
+                     [](const MidiNote& a, const MidiNote& b) {
+                         if (a.startBeat != b.startBeat) {
+                             return a.startBeat < b.startBeat;
+                         }
+                         return a.noteNumber < b.noteNumber;
+                     });
+    for (auto& note : track.notes) {
+        note.lengthBeats = std::max(note.lengthBeats, kMinNoteBeats);
+        track.lengthBeats = std::max(track.lengthBeats, note.startBeat + note.lengthBeats);
+    }
+    return track;
+}
+
+std::vector<BatchOperation> MidiFileImporter::makeBatch(const Result& result, double startTime,
+                                                       double bpm) {
+    std::vector<BatchOperation> operations;
+    if (result.failed || bpm <= 0.0) {
+        return operations;
+    }
+
+    const double secondsPerBeat = 60.0 / bpm;
+    operations.reserve(result.tracks.size() * 3);
+    for (size_t i = 0; i < result.tracks.size(); ++i) {
+        const auto& track = result.tracks[i];
+
+        BatchOperation createTrack;
+        createTrack.type = BatchOperation::Type::CreateTrack;
+        createTrack.trackType = TrackType::Instrument;
+        createTrack.name = (track.name.isNotEmpty()
+                                ? track.name
+                                : result.source.getFileNameWithoutExtension() + " " +
+                                      juce::String(static_cast<int>(i) + 1))
+                               .toStdString();
+        operations.push_back(std::move(createTrack));
+
+        BatchOperation addClip;
+        addClip.type = BatchOperation::Type::AddMidiClip;
+        addClip.idFrom = static_cast<int>(operations.size()) - 1;
+        addClip.startTime = startTime;
+        addClip.length = track.lengthBeats * secondsPerBeat;
+        operations.push_back(std::move(addClip));
+
+        BatchOperation addNotes;
+        addNotes.type = BatchOperation::Type::AddNotes;
+        addNotes.idFrom = static_cast<int>(operations.size()) - 1;
+        addNotes.notes = track.notes;
+        operations.push_back(std::move(addNotes));
+    }
+    return operations;
+}
+
+void MidiFileImporter::shutdown() {
+    alive_->store(false);
+    if (pool_) {
+        pool_->removeAllJobs(true, 2000);
+        pool_.reset();
+    }
+    imports_.clear();
+}
+
+}  // namespace magda
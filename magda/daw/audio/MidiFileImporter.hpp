@@ -0,0 +1,125 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_events/juce_events.h>
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "../core/BatchOperations.hpp"
+#include "../core/MidiNoteList.hpp"
+
+namespace magda {
+
+/**
+ * @brief Reads dropped MIDI files into notes on a pool of background threads
+ *
+ * A file is read once on a pool thread, then each of its tracks is turned into notes by a
+ * job of its own, so a large file (an orchestral mockup with hundreds of thousands of notes)
+ * uses every thread of the pool. Notes are paired in one pass over a track's events, in
+ * start order, ready for MidiNoteList to take in bulk.
+ *
+ * makeBatch() describes the import as one batch edit: a track and a clip per file track
+ * with all its notes, applied as one undo step so the engine syncs each clip once rather
+ * than per note.
+ *
+ * Message thread only, apart from the pool's threads.
+ */
+class MidiFileImporter {
+  public:
+    static MidiFileImporter& getInstance();
+
+    /**
+     * @brief One track of the file, as a clip's notes
+     */
+    struct Track {
+        juce::String name;
+        std::vector<MidiNote> notes;  // In start order, beats from the start of the file
+        double lengthBeats = 0.0;     // To the end of the last note
+    };
+
+    /**
+     * @brief One read file; tracks without notes are left out
+     */
+    struct Result {
+        juce::File source;
+        std::vector<Track> tracks;
+        bool failed = false;  // Unreadable, or not a MIDI file
+    };
+
+    using Callback = std::function<void(const Result& result)>;
+
+    /**
+     * @brief Read a file in the background
+     * @param onDone Called on the message thread once every track is read, unless shut down
+     */
+    void importFile(const juce::File& file, Callback onDone);
+
+    bool isImporting() const {
+        return !imports_.empty();
+    }
+
+    /**
+     * @brief Whether a file has an extension the importer reads
+     */
+    static bool isSupportedFile(const juce::File& file);
+
+    /**
+     * @brief Read a file and all its tracks on the calling thread
+     */
+    static Result readFile(const juce::File& file);
+
+    /**
+     * @brief Pair a track's note-ons and note-offs into notes, in start order
+     *
+     * A note-off (or a note-on at velocity 0) ends the earliest sounding note of its channel
+     * and pitch; notes still sounding at the end of the track end at its last event.
+     */
+    static Track readTrack(const juce::MidiMessageSequence& sequence, double ticksPerBeat);
+
+    /**
+     * @brief The batch that creates a track and a clip for each of the file's tracks
+     * @param startTime Where the clips start on the timeline, in seconds
+     * @param bpm Tempo that places the clips' ends
+     */
+    static std::vector<BatchOperation> makeBatch(const Result& result, double startTime,
+                                                 double bpm);
+
+    /**
+     * @brief Cancel running imports (their callbacks are dropped) and stop the pool
+     */
+    void shutdown();
+
+  private:
+    MidiFileImporter();
+    ~MidiFileImporter() = default;
+
+    class ReadJob;
+    class TrackJob;
+
+    struct Import {
+        Result result;
+        int remaining = 0;
+        Callback onDone;
+    };
+
+    // A null midiFile couldn't be read
+    void fileRead(int importId, std::shared_ptr<const juce::MidiFile> midiFile,
+                  double ticksPerBeat);
+    void trackRead(int importId, size_t index, Track track);
+    void finish(std::map<int, Import>::iterator it);
+
+    std::unique_ptr<juce::ThreadPool> pool_;
+    std::map<int, Import> imports_;
+    int nextImportId_ = 0;
+
+    // Validity flag for async callbacks - set to false in shutdown()
+    std::shared_ptr<std::atomic<bool>> alive_ = std::make_shared<std::atomic<bool>>(true);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MidiFileImporter)
+};
+
+}  // namespace magda
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "../core/ClipInfo.hpp"
+
+namespace magda {
+
+/**
+ * @brief The contiguous run of notes that differs between two versions of a clip's notes
+ *
+ * Two versions are matched by position in start order (see MidiNoteList): everything
+ * before begin and everything after the trailing common run is unchanged. Old notes
+ * [begin, oldEnd) became new notes [begin, newEnd). A resize, insert or delete produces a
+ * run of at most one note; a move spans the notes it passed over.
+ */
+struct MidiNoteDiff {
+    size_t begin = 0;
+    size_t oldEnd = 0;
+    size_t newEnd = 0;
+
+    bool isEmpty() const {
+        return begin == oldEnd && begin == newEnd;
+    }
+};
+
+inline bool sameMidiNote(const MidiNote& a, const MidiNote& b) {
+    return a.noteNumber == b.noteNumber && a.velocity == b.velocity &&
+           a.startBeat == b.startBeat && a.lengthBeats == b.lengthBeats;
+}
+
+/**
+ * @brief Find the changed run by trimming the common prefix and suffix (linear, no allocation)
+ */
+inline MidiNoteDiff diffMidiNotes(const std::vector<MidiNote>& oldNotes,
+                                  const std::vector<MidiNote>& newNotes) {
+    const size_t common = std::min(oldNotes.size(), newNotes.size());
+
+    size_t begin = 0;
+    while (begin < common && sameMidiNote(oldNotes[begin], newNotes[begin]))
+        ++begin;
+
+    size_t oldEnd = oldNotes.size();
+    size_t newEnd = newNotes.size();
+    while (oldEnd > begin && newEnd > begin &&
+           sameMidiNote(oldNotes[oldEnd - 1], newNotes[newEnd - 1])) {
+        --oldEnd;
+        --newEnd;
+    }
+
+    return {begin, oldEnd, newEnd};
+}
+
+}  // namespace magda
@@ -0,0 +1,138 @@
+#include "MidiTakeRecorder.hpp"
+
+#include <algorithm>
+#include <iostream>
+
+#include "../core/ClipCommands.hpp"
+#include "../core/ClipManager.hpp"
+#include "../core/TempoMap.hpp"
+#include "../core/TrackManager.hpp"
+#include "../core/UndoManager.hpp"
+#include "MidiBridge.hpp"
+
+namespace magda {
+
+MidiTakeRecorder::MidiTakeRecorder(MidiBridge& midiBridge) : midiBridge_(midiBridge) {}
+
+MidiTakeRecorder::~MidiTakeRecorder() {
+    stopTimer();
+    for (const auto& take : takes_) {
+        midiBridge_.stopCapture(take.trackId);
+    }
+}
+
+int MidiTakeRecorder::start(double startSeconds) {
+    if (isRecording()) {
+        return 0;
+    }
+
+    // An empty clip from the start, so the take shows while it's played
+    const auto& tempoMap = TempoMap::getInstance();
+    const double initialLength =
+        tempoMap.beatsToSeconds(tempoMap.secondsToBeats(startSeconds) + 1.0) - startSeconds;
+
+    auto& clipManager = ClipManager::getInstance();
+    startSeconds_ = startSeconds;
+    for (const auto& track : TrackManager::getInstance().getTracks()) {
+        if (!track.recordArmed || track.type == TrackType::Audio ||
+            track.midiInputDevice.isEmpty()) {
+            continue;
+        }
+
+        Take take;
+        take.trackId = track.id;
+        take.clipId = clipManager.createMidiClip(track.id, startSeconds, initialLength);
+        if (take.clipId == INVALID_CLIP_ID) {
+            continue;
+        }
+        take.queue = std::make_shared<MidiCaptureQueue>();
+        take.builder = std::make_unique<MidiTakeBuilder>();
+        midiBridge_.startCapture(track.id, take.queue);
+        takes_.push_back(std::move(take));
+    }
+
+    if (isRecording()) {
+        startTimerHz(kDisplayRateHz);
+    }
+    return static_cast<int>(takes_.size());
+}
+
+int MidiTakeRecorder::stop(double endSeconds) {
+    stopTimer();
+
+    auto& clipManager = ClipManager::getInstance();
+    int kept = 0;
+    for (auto& take : takes_) {
+        midiBridge_.stopCapture(take.trackId);
+        drain(take);
+        take.builder->finish(endSeconds);
+        addNotes(take, take.builder->takeFinished());
+
+        if (take.queue->getDroppedCount() > 0) {
+            std::cerr << "Recorded MIDI take on track " << take.trackId << " lost "
+                      << take.queue->getDroppedCount() << " events to a full queue" << std::endl;
+        }
+
+        const auto* clip = clipManager.getClip(take.clipId);
+        if (clip == nullptr) {
+            continue;  // Deleted while recording
+        }
+        if (clip->midiNotes.empty()) {
+            clipManager.deleteClip(take.clipId);
+            continue;
+        }
+        UndoManager::getInstance().executeCommand(std::make_unique<RecordMidiTakeCommand>(*clip));
+        ++kept;
+    }
+    takes_.clear();
+    return kept;
+}
+
+void MidiTakeRecorder::timerCallback() {
+    for (auto& take : takes_) {
+        drain(take);
+        addNotes(take, take.builder->takeFinished());
+    }
+}
+
+void MidiTakeRecorder::drain(Take& take) {
+    CapturedMidiEvent event;
+    while (take.queue->pop(event)) {
+        take.builder->add(event);
+    }
+}
+
+void MidiTakeRecorder::addNotes(const Take& take,
+                                const std::vector<MidiTakeBuilder::Note>& notes) {
+    auto& clipManager = ClipManager::getInstance();
+    const auto* clip = clipManager.getClip(take.clipId);
+    if (notes.empty() || clip == nullptr) {
+        return;
+    }
+
+    const auto& tempoMap = TempoMap::getInstance();
+    const double originBeat = tempoMap.secondsToBeats(startSeconds_);
+    std::vector<MidiNote> midiNotes;
+    midiNotes.reserve(notes.size());
+    for (const auto& note : notes) {
+        // Played before the take's start (a count-in, or a loop wrap) lands at its start
+        const double startBeat =
+            std::max(0.0, tempoMap.secondsToBeats(note.startSeconds) - originBeat);
+        const double endBeat = tempoMap.secondsToBeats(note.endSeconds) - originBeat;
+        MidiNote midiNote;
+        midiNote.noteNumber = note.noteNumber;
+        midiNote.velocity = note.velocity;
+        midiNote.startBeat = startBeat;
+        midiNote.lengthBeats = std::max(endBeat - startBeat, 1.0 / 128.0);
+        midiNotes.push_back(midiNote);
+    }
+    clipManager.addMidiNotes(take.clipId, midiNotes);
+
+    // Grow the clip over the latest note
+    const double length = take.builder->getLatestEndSeconds() - startSeconds_;
+    if (length > clip->length) {
+        clipManager.resizeClip(take.clipId, length, false, tempoMap.getBpmAtTime(startSeconds_));
+    }
+}
+
+}  // namespace magda
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <juce_events/juce_events.h>
+
+#include <memory>
+#include <vector>
+
+#include "../core/TypeIds.hpp"
+#include "MidiCapture.hpp"
+
+namespace magda {
+
+class MidiBridge;
+
+/**
+ * @brief Records armed tracks' MIDI input into new MIDI clips while the transport records
+ *
+ * Each armed track with a MIDI input gets a MidiCaptureQueue that MidiBridge's MIDI threads
+ * push its note events into, stamped with the transport position being heard, without a
+ * lock or a trip through the message thread per note. A timer drains the queues at
+ * kDisplayRateHz, pairs ons and offs (MidiTakeBuilder), and adds the notes that ended to the
+ * take's clip in one bulk edit per tick, so the clip fills in live with one change
+ * notification per tick rather than per note. stop() ends held notes and records each take
+ * as one undo step; a take with no notes leaves no clip behind.
+ *
+ * Message thread only (the queues are the MIDI threads' side).
+ */
+class MidiTakeRecorder : private juce::Timer {
+  public:
+    static constexpr int kDisplayRateHz = 10;
+
+    explicit MidiTakeRecorder(MidiBridge& midiBridge);
+    ~MidiTakeRecorder() override;
+
+    MidiTakeRecorder(const MidiTakeRecorder&) = delete;
+    MidiTakeRecorder& operator=(const MidiTakeRecorder&) = delete;
+
+    /**
+     * @brief Capture every armed track with a MIDI input into a clip starting at startSeconds
+     * @return Number of tracks capturing
+     */
+    int start(double startSeconds);
+
+    /**
+     * @brief End held notes at endSeconds and record each take as one undo step
+     * @return Number of takes kept
+     */
+    int stop(double endSeconds);
+
+    bool isRecording() const {
+        return !takes_.empty();
+    }
+
+  private:
+    struct Take {
+        TrackId trackId = INVALID_TRACK_ID;
+        ClipId clipId = INVALID_CLIP_ID;
+        std::shared_ptr<MidiCaptureQueue> queue;
+        std::unique_ptr<MidiTakeBuilder> builder;  // Large (a slot per channel and note)
+    };
+
+    void timerCallback() override;
+
+    // Move the queue's events into the builder and the notes that ended into the clip
+    void drain(Take& take);
+    void addNotes(const Take& take, const std::vector<MidiTakeBuilder::Note>& notes);
+
+    MidiBridge& midiBridge_;
+    std::vector<Take> takes_;
+    double startSeconds_ = 0.0;
+};
+
+}  // namespace magda
@@ -0,0 +1,251 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace magda {
+
+/**
+ * @brief Left and right gains for a mono-compatible pan position
+ */
+struct PanGains {
+    float left = 1.0f;
+    float right = 1.0f;
+};
+
+/**
+ * @brief Block kernels for mixing: gain (fixed or ramped), constant-power pan, N-way sum
+ *
+ * Fixed gains and pairwise sums go through juce::FloatVectorOperations, which uses the
+ * platform's SIMD. Ramps compute each sample's gain from the block start (start + step * i)
+ * rather than accumulating it, so the loop has no carried dependency and the compiler
+ * vectorises it too. A ramp from a to b over n samples gives the first sample a and reaches
+ * b at sample n, so a ramp split over consecutive blocks is seamless.
+ *
+ * Audio thread safe: no allocation, no locks.
+ */
+class MixKernels {
+  public:
+    /**
+     * @brief Constant-power law: -3 dB per side at the centre, unity at the hard sides
+     * @param pan -1 (left) to 1 (right)
+     */
+    static PanGains constantPowerPan(float pan) {
+        const float angle = (std::clamp(pan, -1.0f, 1.0f) + 1.0f) *
+                            juce::MathConstants<float>::pi * 0.25f;
+        return {std::cos(angle), std::sin(angle)};
+    }
+
+    /**
+     * @brief Scale in place by a gain gliding from start to end across the block
+     */
+    static void applyGain(float* data, int numSamples, float start, float end) {
+        if (numSamples <= 0) {
+            return;
+        }
+        if (start == end) {
+            if (start == 0.0f) {
+                juce::FloatVectorOperations::clear(data, numSamples);
+            } else if (start != 1.0f) {
+                juce::FloatVectorOperations::multiply(data, start, numSamples);
+            }
+            return;
+        }
+        const float step = (end - start) / static_cast<float>(numSamples);
+        for (int i = 0; i < numSamples; ++i) {
+            data[i] *= start + step * static_cast<float>(i);
+        }
+    }
+
+    /**
+     * @brief Scale in place by a gain per sample, as from a precomputed fade table
+     */
+    static void applyGainTable(float* data, const float* gains, int numSamples) {
+        if (numSamples > 0) {
+            juce::FloatVectorOperations::multiply(data, gains, numSamples);
+        }
+    }
+
+    /**
+     * @brief dest += source * gain, the gain gliding from start to end across the block
+     */
+    static void addWithGain(float* dest, const float* source, int numSamples, float start,
+                            float end) {
+        if (numSamples <= 0 || (start == 0.0f && end == 0.0f)) {
+            return;
+        }
+        if (start == end) {
+            if (start == 1.0f) {
+                juce::FloatVectorOperations::add(dest, source, numSamples);
+            } else {
+                juce::FloatVectorOperations::addWithMultiply(dest, source, start, numSamples);
+            }
+            return;
+        }
+        const float step = (end - start) / static_cast<float>(numSamples);
+        for (int i = 0; i < numSamples; ++i) {
+            dest[i] += source[i] * (start + step * static_cast<float>(i));
+        }
+    }
+
+    /**
+     * @brief dest = the sum of numSources buffers (silence for none)
+     *
+     * Sources are taken four at a time, so dest is read and written once per four sources
+     * instead of once per source.
+     */
+    static void sum(float* dest, const float* const* sources, int numSources, int numSamples) {
+        if (numSamples <= 0) {
+            return;
+        }
+        if (numSources <= 0) {
+            juce::FloatVectorOperations::clear(dest, numSamples);
+            return;
+        }
+
+        const int first = std::min(numSources, 4);
+        if (first == 1) {
+            juce::FloatVectorOperations::copy(dest, sources[0], numSamples);
+        } else if (first == 2) {
+            juce::FloatVectorOperations::add(dest, sources[0], sources[1], numSamples);
+        } else {
+            const float *a = sources[0], *b = sources[1], *c = sources[2];
+            const float* d = first == 4 ? sources[3] : nullptr;
+            if (d != nullptr) {
+                for (int i = 0; i < numSamples; ++i) {
+                    dest[i] = (a[i] + b[i]) + (c[i] + d[i]);
+                }
+            } else {
+                for (int i = 0; i < numSamples; ++i) {
+                    dest[i] = a[i] + b[i] + c[i];
+                }
+            }
+        }
+
+        int next = first;
+        for (; numSources - next >= 4; next += 4) {
+            const float *a = sources[next], *b = sources[next + 1];
+            const float *c = sources[next + 2], *d = sources[next + 3];
+            for (int i = 0; i < numSamples; ++i) {
+                dest[i] += (a[i] + b[i]) + (c[i] + d[i]);
+            }
+        }
+        for (; next < numSources; ++next) {
+            juce::FloatVectorOperations::add(dest, sources[next], numSamples);
+        }
+    }
+};
+
+/**
+ * @brief A gain that glides linearly to each new target instead of stepping
+ *
+ * The first target after a reset is taken at once, so a chain starting up doesn't fade in.
+ * A ramp that ends part way through a block is stretched to the block's end, which keeps
+ * each block a single kernel call.
+ */
+class SmoothedGain {
+  public:
+    void setTarget(float target, int rampSamples) {
+        if (!primed_ || rampSamples <= 0) {
+            current_ = target;
+            remaining_ = 0;
+            primed_ = true;
+        } else if (target != target_) {
+            remaining_ = rampSamples;
+        }
+        target_ = target;
+    }
+
+    /**
+     * @brief Gains at the start and end of the next block, and advance past it
+     */
+    void advance(int numSamples, float& start, float& end) {
+        start = current_;
+        if (remaining_ > numSamples) {
+            current_ += (target_ - current_) * static_cast<float>(numSamples) /
+                        static_cast<float>(remaining_);
+            remaining_ -= numSamples;
+        } else {
+            current_ = target_;
+            remaining_ = 0;
+        }
+        end = current_;
+    }
+
+    bool isSmoothing() const {
+        return remaining_ > 0;
+    }
+
+    void reset() {
+        primed_ = false;
+        remaining_ = 0;
+    }
+
+  private:
+    float current_ = 1.0f;
+    float target_ = 1.0f;
+    int remaining_ = 0;
+    bool primed_ = false;
+};
+
+/**
+ * @brief Volume and pan of one parallel chain, summed into a shared output
+ *
+ * Holds each side's smoothed gain between blocks, so volume and pan changes glide over
+ * kRampSeconds. Stereo sources are balanced by the constant-power law; other channel
+ * layouts get the volume only. One per chain, on the thread that renders it.
+ */
+class ChainMixer {
+  public:
+    static constexpr double kRampSeconds = 0.02;
+
+    /**
+     * @param volumeDb Chain volume in dB (0 = unity)
+     * @param pan -1 to 1
+     */
+    void setVolumeAndPan(float volumeDb, float pan, double sampleRate) {
+        const float gain = juce::Decibels::decibelsToGain(volumeDb);
+        const auto sides = MixKernels::constantPowerPan(pan);
+        const auto rampSamples = static_cast<int>(sampleRate * kRampSeconds);
+        // The centre is -3 dB per side; normalise so a centred chain stays at unity
+        constexpr float kCentre = 1.41421356f;
+        left_.setTarget(gain * sides.left * kCentre, rampSamples);
+        right_.setTarget(gain * sides.right * kCentre, rampSamples);
+        mono_.setTarget(gain, rampSamples);
+    }
+
+    /**
+     * @brief Add a chain's rendered block into the output with its volume and pan
+     */
+    void mixInto(float* const* dest, const float* const* source, int numChannels,
+                 int numSamples) {
+        float start = 0.0f, end = 0.0f;
+        if (numChannels == 2) {
+            left_.advance(numSamples, start, end);
+            MixKernels::addWithGain(dest[0], source[0], numSamples, start, end);
+            right_.advance(numSamples, start, end);
+            MixKernels::addWithGain(dest[1], source[1], numSamples, start, end);
+            mono_.advance(numSamples, start, end);
+            return;
+        }
+        mono_.advance(numSamples, start, end);
+        for (int ch = 0; ch < numChannels; ++ch) {
+            MixKernels::addWithGain(dest[ch], source[ch], numSamples, start, end);
+        }
+        left_.advance(numSamples, start, end);
+        right_.advance(numSamples, start, end);
+    }
+
+    void reset() {
+        left_.reset();
+        right_.reset();
+        mono_.reset();
+    }
+
+  private:
+    SmoothedGain left_, right_, mono_;
+};
+
+}  // namespace magda
@@ -0,0 +1,102 @@
+#include "NotePreviewPlugin.hpp"
+
+#include <algorithm>
+
+#include "../profiling/RealtimeSafety.hpp"
+
+namespace magda {
+
+const char* NotePreviewPlugin::xmlTypeName = "magdanotepreview";
+
+NotePreviewPlugin::NotePreviewPlugin(const te::PluginCreationInfo& info)
+    : Plugin(info), sourceId_(te::createUniqueMPESourceID()) {
+    for (size_t i = 0; i < kQueueSize; ++i) {
+        cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+NotePreviewPlugin::~NotePreviewPlugin() {
+    notifyListenersOfDeletion();
+}
+
+juce::ValueTree NotePreviewPlugin::create() {
+    juce::ValueTree v(te::IDs::PLUGIN);
+    v.setProperty(te::IDs::type, xmlTypeName, nullptr);
+    return v;
+}
+
+bool NotePreviewPlugin::post(int noteNumber, int velocity, bool isNoteOn, double timeMs) {
+    size_t pos = writePos_.load(std::memory_order_relaxed);
+    for (;;) {
+        auto& cell = cells_[pos & (kQueueSize - 1)];
+        const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        const auto diff = static_cast<std::ptrdiff_t>(sequence - pos);
+
+        if (diff == 0) {
+            if (writePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                cell.note = {noteNumber, velocity, isNoteOn, timeMs};
+                cell.sequence.store(pos + 1, std::memory_order_release);
+                activity_.store(true, std::memory_order_relaxed);
+                return true;
+            }
+        } else if (diff < 0) {
+            return false;  // Full: the render thread hasn't caught up
+        } else {
+            pos = writePos_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool NotePreviewPlugin::pop(Note& note) {
+    auto& cell = cells_[readPos_ & (kQueueSize - 1)];
+    if (cell.sequence.load(std::memory_order_acquire) != readPos_ + 1) {
+        return false;
+    }
+
+    note = cell.note;
+    cell.sequence.store(readPos_ + kQueueSize, std::memory_order_release);
+    ++readPos_;
+    return true;
+}
+
+void NotePreviewPlugin::initialise(const te::PluginInitialisationInfo& info) {
+    sampleRate_ = info.sampleRate > 0.0 ? info.sampleRate : 44100.0;
+    lastBlockMs_ = 0.0;
+}
+
+void NotePreviewPlugin::applyToBuffer(const te::PluginRenderContext& fc) {
+    ScopedRealtimeContext realtime;
+    const double nowMs = juce::Time::getMillisecondCounterHiRes();
+    const double previousMs = lastBlockMs_ > 0.0 ? lastBlockMs_ : nowMs;
+    lastBlockMs_ = nowMs;
+
+    if (fc.bufferForMidiMessages == nullptr || fc.bufferNumSamples <= 0) {
+        Note discarded;
+        while (pop(discarded)) {
+        }
+        return;
+    }
+
+    // Notes posted since the previous block keep their offset from it, up to the last
+    // sample of this block
+    const double lastSampleSeconds = (fc.bufferNumSamples - 1) / sampleRate_;
+    bool added = false;
+    Note note;
+    while (pop(note)) {
+        const auto noteNumber = juce::jlimit(0, 127, note.noteNumber);
+        const auto velocity = static_cast<juce::uint8>(juce::jlimit(0, 127, note.velocity));
+        const auto message = note.isNoteOn && velocity > 0
+                                 ? juce::MidiMessage::noteOn(1, noteNumber, velocity)
+                                 : juce::MidiMessage::noteOff(1, noteNumber, velocity);
+        const double offsetSeconds =
+            std::clamp((note.timeMs - previousMs) * 0.001, 0.0, lastSampleSeconds);
+        fc.bufferForMidiMessages->addMidiMessage(message, offsetSeconds, sourceId_);
+        added = true;
+    }
+
+    if (added) {
+        fc.bufferForMidiMessages->sortByTimestamp();
+    }
+}
+
+}  // namespace magda
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <tracktion_engine/tracktion_engine.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+namespace magda {
+
+namespace te = tracktion;
+
+/**
+ * @brief First plugin on each track: plays auditioned notes into the track's instrument
+ *
+ * Piano roll auditioning and agents queue notes with post() from any thread, without
+ * locks or allocation; the render thread adds them to the block's MIDI ahead of the
+ * track's devices. A note is placed in the block at the same distance from the previous
+ * block as it was posted, so a fast drag keeps its spacing instead of every note landing
+ * on a block boundary: one block of fixed latency in place of a block of jitter.
+ *
+ * Audio and other MIDI pass through untouched. AudioBridge puts one at the head of every
+ * track it syncs.
+ */
+class NotePreviewPlugin : public te::Plugin {
+  public:
+    static constexpr size_t kQueueSize = 256;  // Power of 2 for fast modulo
+
+    explicit NotePreviewPlugin(const te::PluginCreationInfo& info);
+    ~NotePreviewPlugin() override;
+
+    static const char* getPluginName() {
+        return "Note Preview";
+    }
+    static const char* xmlTypeName;
+
+    /**
+     * @brief Create the ValueTree for a new instance
+     */
+    static juce::ValueTree create();
+
+    juce::String getName() const override {
+        return getPluginName();
+    }
+    juce::String getPluginType() override {
+        return xmlTypeName;
+    }
+    juce::String getShortName(int) override {
+        return "Preview";
+    }
+    juce::String getSelectableDescription() override {
+        return getName();
+    }
+
+    /**
+     * @brief Queue a note for the next block (any thread)
+     * @param timeMs When it was played, from juce::Time::getMillisecondCounterHiRes()
+     * @return false if the queue was full and the note was dropped
+     */
+    bool post(int noteNumber, int velocity, bool isNoteOn, double timeMs);
+
+    /**
+     * @brief Whether notes were posted since the last call (so a suspended chain can be
+     *        woken to play them)
+     */
+    bool takeActivity() {
+        return activity_.exchange(false, std::memory_order_relaxed);
+    }
+
+    void initialise(const te::PluginInitialisationInfo&) override;
+    void deinitialise() override {}
+    void applyToBuffer(const te::PluginRenderContext&) override;
+
+    bool takesMidiInput() override {
+        return true;
+    }
+    bool takesAudioInput() override {
+        return true;
+    }
+    bool producesAudioWhenNoAudioInput() override {
+        return false;
+    }
+    double getTailLength() const override {
+        return 0.0;
+    }
+
+  private:
+    struct Note {
+        int noteNumber = 60;
+        int velocity = 100;
+        bool isNoteOn = true;
+        double timeMs = 0.0;
+    };
+
+    // Multi-producer, single-consumer ring, as in AudioEventQueue
+    struct Cell {
+        std::atomic<size_t> sequence{0};
+        Note note;
+    };
+
+    bool pop(Note& note);
+
+    std::array<Cell, kQueueSize> cells_;
+    alignas(64) std::atomic<size_t> writePos_{0};
+    alignas(64) size_t readPos_ = 0;  // Render thread only
+    std::atomic<bool> activity_{false};
+
+    // Render thread only
+    te::MPESourceID sourceId_;
+    double sampleRate_ = 44100.0;
+    double lastBlockMs_ = 0.0;
+};
+
+}  // namespace magda
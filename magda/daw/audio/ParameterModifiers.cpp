@@ -0,0 +1,53 @@
+#include "ParameterModifiers.hpp"
+
+namespace magda {
+
+te::AutomatableParameter::Ptr ParameterModifiers::attach(te::Plugin& plugin,
+                                                         te::AutomatableParameter& target) {
+    te::MacroParameter::Ptr source = findSource(plugin, target);
+    if (source == nullptr) {
+        source = plugin.getMacroParameterListForWriting().createMacroParameter();
+        if (source == nullptr) {
+            return nullptr;
+        }
+        source->macroName = getSourceName(target);
+        // Nothing until the modulator's first block
+        source->setNormalisedParameter(0.0f, juce::dontSendNotification);
+    }
+
+    // Full depth, no offset: the source's 0..1 adds straight onto the normalised value
+    target.addModifier(*source, 1.0f, 0.0f, 0.5f);
+    return source.get();
+}
+
+void ParameterModifiers::detach(te::Plugin& plugin, te::AutomatableParameter& target) {
+    if (auto* source = findSource(plugin, target)) {
+        te::MacroParameter::Ptr keepAlive = source;
+        target.removeModifier(*source);
+        if (auto* list = plugin.getMacroParameterList()) {
+            list->removeMacroParameter(*source);
+        }
+    }
+}
+
+juce::String ParameterModifiers::getSourceName(const te::AutomatableParameter& target) {
+    return "magda.mod." + target.paramID;
+}
+
+te::MacroParameter* ParameterModifiers::findSource(te::Plugin& plugin,
+                                                   const te::AutomatableParameter& target) {
+    auto* list = plugin.getMacroParameterList();
+    if (list == nullptr) {
+        return nullptr;
+    }
+
+    const auto name = getSourceName(target);
+    for (auto* macro : list->getMacroParameters()) {
+        if (macro != nullptr && macro->macroName.get() == name) {
+            return macro;
+        }
+    }
+    return nullptr;
+}
+
+}  // namespace magda
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <tracktion_engine/tracktion_engine.h>
+
+namespace magda {
+
+namespace te = tracktion;
+
+/**
+ * @brief Backs modulated parameters with Tracktion modifier sources
+ *
+ * Each parameter the modulator drives gets a te::MacroParameter on its plugin, assigned to
+ * the parameter as a full-depth modifier. The audio thread writes the summed modulation
+ * into that source and the engine adds it to the parameter's own value when the plugin
+ * renders, so the parameter's base value - what the user and automation set, and what
+ * DeviceInfo stores - is never rewritten, and its listeners don't hear about modulation.
+ *
+ * Sources are named after the parameter they drive and found again by name, so a plugin
+ * restored from saved state reuses its sources rather than growing new ones.
+ *
+ * Message thread only.
+ */
+class ParameterModifiers {
+  public:
+    /**
+     * @brief The source that modulates target, created and assigned if need be
+     * @return null if the plugin can't hold modifier sources
+     */
+    static te::AutomatableParameter::Ptr attach(te::Plugin& plugin,
+                                                te::AutomatableParameter& target);
+
+    /**
+     * @brief Unassign and delete target's source, leaving the parameter at its base value
+     */
+    static void detach(te::Plugin& plugin, te::AutomatableParameter& target);
+
+  private:
+    static juce::String getSourceName(const te::AutomatableParameter& target);
+    static te::MacroParameter* findSource(te::Plugin& plugin,
+                                          const te::AutomatableParameter& target);
+};
+
+}  // namespace magda
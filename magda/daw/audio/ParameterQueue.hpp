@@ -4,6 +4,9 @@
 
 #include <array>
 #include <atomic>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
 
 #include "../core/TypeIds.hpp"
 
@@ -17,6 +20,9 @@ struct ParameterChange {
     int paramIndex = -1;
     float value = 0.0f;
 
+    // Optional: glide to value over this many milliseconds instead of stepping (0 = step)
+    float rampMs = 0.0f;
+
     // Optional: for identifying the source of the change
     enum class Source {
         User,        // Direct user interaction
@@ -159,4 +165,235 @@ class BatchedParameterQueue {
     ParameterQueue queue_;
 };
 
+/**
+ * @brief Coalescing UI-to-audio parameter queue
+ *
+ * Each (DeviceId, paramIndex) pair owns a pending slot. A push overwrites the slot's value
+ * in place and sets its bit in a dirty bitmap, so a fast drag or a macro sweep can never
+ * fill the queue and the audio thread applies each parameter at most once per drain.
+ *
+ * A removed device's slots are handed back with releaseDevice(). Its pending values are
+ * discarded, and a slot is only reused once the audio thread has finished a drain that
+ * began after the release, so a drain in progress never reads a slot being reassigned.
+ * Slots are therefore only exhausted by kMaxSlots pairs live at once.
+ *
+ * Threading: push(), releaseDevice() and reset() from a single producer (UI thread),
+ * popAll() from the audio thread. Slot assignment happens on the producer side only, so the
+ * audio thread never touches the key map.
+ */
+class CoalescingParameterQueue {
+  public:
+    static constexpr int kMaxSlots = 4096;  // Distinct (device, param) pairs
+    static constexpr int kBitsPerWord = 64;
+    static constexpr int kNumWords = kMaxSlots / kBitsPerWord;
+
+    /**
+     * @brief Queue or overwrite the pending value for a parameter (UI thread)
+     * @return false only if no slot is left for a new (device, param) pair
+     */
+    bool push(const ParameterChange& change) {
+        const auto key = makeKey(change.deviceId, change.paramIndex);
+        int slotIndex;
+
+        auto it = slotForKey_.find(key);
+        if (it != slotForKey_.end()) {
+            slotIndex = it->second;
+        } else {
+            slotIndex = takeFreeSlot();
+            if (slotIndex < 0) {
+                droppedCount_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            slotForKey_.emplace(key, slotIndex);
+            // Key is published to the audio thread by the release on the dirty bit below
+            slots_[static_cast<size_t>(slotIndex)].deviceId = change.deviceId;
+            slots_[static_cast<size_t>(slotIndex)].paramIndex = change.paramIndex;
+        }
+
+        auto& slot = slots_[static_cast<size_t>(slotIndex)];
+        slot.value.store(change.value, std::memory_order_relaxed);
+        slot.rampMs.store(change.rampMs, std::memory_order_relaxed);
+        slot.source.store(change.source, std::memory_order_relaxed);
+
+        const auto bit = uint64_t{1} << (slotIndex % kBitsPerWord);
+        const auto previous = dirty_[static_cast<size_t>(slotIndex / kBitsPerWord)].fetch_or(
+            bit, std::memory_order_release);
+        if ((previous & bit) != 0) {
+            coalescedCount_.fetch_add(1, std::memory_order_relaxed);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Hand every dirty parameter to the callback and clear it (audio thread)
+     * @param fn Callable taking const ParameterChange&
+     * @return Number of changes delivered
+     */
+    template <typename Fn> int popAll(Fn&& fn) {
+        int delivered = 0;
+        const int usedWords = (usedSlots() + kBitsPerWord - 1) / kBitsPerWord;
+
+        for (int w = 0; w < usedWords; ++w) {
+            auto bits = dirty_[static_cast<size_t>(w)].exchange(0, std::memory_order_acquire);
+            while (bits != 0) {
+                const int bitIndex = countTrailingZeros(bits);
+                bits &= bits - 1;
+
+                const auto& slot = slots_[static_cast<size_t>(w * kBitsPerWord + bitIndex)];
+                ParameterChange change;
+                change.deviceId = slot.deviceId;
+                change.paramIndex = slot.paramIndex;
+                change.value = slot.value.load(std::memory_order_relaxed);
+                change.rampMs = slot.rampMs.load(std::memory_order_relaxed);
+                change.source = slot.source.load(std::memory_order_relaxed);
+                fn(change);
+                ++delivered;
+            }
+        }
+
+        // Slots released before this drain began can now be reassigned
+        drainCount_.fetch_add(1, std::memory_order_release);
+        return delivered;
+    }
+
+    /**
+     * @brief Hand back every slot of a removed device, discarding its pending values
+     *        (UI thread)
+     */
+    void releaseDevice(DeviceId deviceId) {
+        const auto drains = drainCount_.load(std::memory_order_acquire);
+        for (auto it = slotForKey_.begin(); it != slotForKey_.end();) {
+            if (static_cast<DeviceId>(static_cast<uint32_t>(it->first >> 32)) != deviceId) {
+                ++it;
+                continue;
+            }
+
+            const int slotIndex = it->second;
+            const auto bit = uint64_t{1} << (slotIndex % kBitsPerWord);
+            dirty_[static_cast<size_t>(slotIndex / kBitsPerWord)].fetch_and(
+                ~bit, std::memory_order_acq_rel);
+            retiredSlots_.push_back({slotIndex, drains});
+            it = slotForKey_.erase(it);
+        }
+    }
+
+    /**
+     * @brief Number of (device, param) pairs holding a slot
+     */
+    int getNumAssignedSlots() const {
+        return static_cast<int>(slotForKey_.size());
+    }
+
+    /**
+     * @brief Check if any parameter is waiting to be applied
+     */
+    bool hasPending() const {
+        const int usedWords = (usedSlots() + kBitsPerWord - 1) / kBitsPerWord;
+        for (int w = 0; w < usedWords; ++w) {
+            if (dirty_[static_cast<size_t>(w)].load(std::memory_order_acquire) != 0)
+                return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Pushes that overwrote a value the audio thread had not consumed yet
+     */
+    uint64_t getCoalescedCount() const {
+        return coalescedCount_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Pushes rejected because every slot was already assigned
+     */
+    uint64_t getDroppedCount() const {
+        return droppedCount_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Forget all slot assignments (call only when audio is stopped)
+     */
+    void reset() {
+        for (auto& word : dirty_)
+            word.store(0, std::memory_order_relaxed);
+        slotForKey_.clear();
+        freeSlots_.clear();
+        retiredSlots_.clear();
+        nextFreeSlot_ = 0;
+        usedSlots_.store(0, std::memory_order_relaxed);
+    }
+
+  private:
+    struct Slot {
+        DeviceId deviceId = INVALID_DEVICE_ID;
+        int paramIndex = -1;
+        std::atomic<float> value{0.0f};
+        std::atomic<float> rampMs{0.0f};
+        std::atomic<ParameterChange::Source> source{ParameterChange::Source::User};
+    };
+
+    static uint64_t makeKey(DeviceId deviceId, int paramIndex) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(deviceId)) << 32) |
+               static_cast<uint32_t>(paramIndex);
+    }
+
+    static int countTrailingZeros(uint64_t bits) {
+        int count = 0;
+        while ((bits & 1) == 0) {
+            bits >>= 1;
+            ++count;
+        }
+        return count;
+    }
+
+    int usedSlots() const {
+        return usedSlots_.load(std::memory_order_acquire);
+    }
+
+    // A released slot the audio thread is done with, else a fresh one, else -1 (producer)
+    int takeFreeSlot() {
+        const auto drains = drainCount_.load(std::memory_order_acquire);
+        for (size_t i = 0; i < retiredSlots_.size();) {
+            if (drains > retiredSlots_[i].drainCount) {
+                freeSlots_.push_back(retiredSlots_[i].slotIndex);
+                retiredSlots_[i] = retiredSlots_.back();
+                retiredSlots_.pop_back();
+            } else {
+                ++i;
+            }
+        }
+
+        if (!freeSlots_.empty()) {
+            const int slotIndex = freeSlots_.back();
+            freeSlots_.pop_back();
+            return slotIndex;
+        }
+        if (nextFreeSlot_ >= kMaxSlots) {
+            return -1;
+        }
+        usedSlots_.store(nextFreeSlot_ + 1, std::memory_order_release);
+        return nextFreeSlot_++;
+    }
+
+    struct RetiredSlot {
+        int slotIndex;
+        uint64_t drainCount;  // drainCount_ when released
+    };
+
+    std::array<Slot, kMaxSlots> slots_;
+    std::array<std::atomic<uint64_t>, kNumWords> dirty_{};
+
+    // Producer-side bookkeeping
+    std::unordered_map<uint64_t, int> slotForKey_;
+    std::vector<int> freeSlots_;
+    std::vector<RetiredSlot> retiredSlots_;  // Released, maybe still being read
+    int nextFreeSlot_ = 0;
+
+    std::atomic<int> usedSlots_{0};  // Published slot count, bounds the consumer's scan
+    std::atomic<uint64_t> drainCount_{0};  // Completed popAll() calls
+
+    std::atomic<uint64_t> coalescedCount_{0};
+    std::atomic<uint64_t> droppedCount_{0};
+};
+
 }  // namespace magda
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace magda {
+
+/**
+ * @brief Fixed-capacity pool of linear parameter ramps (audio thread only)
+ *
+ * Replaces step changes with a linear glide from the parameter's current value to its
+ * target over a given number of samples. Starting a ramp on a key that is already ramping
+ * retargets it from wherever it currently is, so a stream of UI changes produces one
+ * continuous glide instead of restarting each time.
+ *
+ * Blocks are split into sub-blocks of at most kSubBlockSamples, and at the sample where a
+ * ramp lands, so a large device buffer still yields a fine-grained glide rather than one
+ * step per block. Each value is worked out from the samples left to the target rather than
+ * accumulated, so it doesn't drift however the ramp is split.
+ *
+ * No allocation: when every slot is busy, start() returns false and the caller should
+ * apply the value immediately.
+ *
+ * @tparam Key Identifies the ramped parameter (e.g. a parameter pointer)
+ */
+template <typename Key, int Capacity = 256> class ParameterRampPool {
+  public:
+    static constexpr int kCapacity = Capacity;
+    static constexpr int kSubBlockSamples = 32;
+
+    /**
+     * @brief Begin (or retarget) a ramp
+     * @param key Parameter to ramp
+     * @param currentValue Parameter value right now (ignored when retargeting)
+     * @param targetValue Value reached at the end of the ramp
+     * @param rampSamples Ramp length; <= 0 means "no ramp" and cancels any ramp on key, so
+     *        it can't overwrite the value applied instead
+     * @return false if the ramp could not be scheduled (apply immediately instead)
+     */
+    bool start(Key key, float currentValue, float targetValue, int rampSamples) {
+        if (rampSamples <= 0) {
+            cancel(key);
+            return false;
+        }
+
+        Ramp* slot = nullptr;
+        for (int i = 0; i < numActive_; ++i) {
+            if (ramps_[static_cast<size_t>(i)].key == key) {
+                slot = &ramps_[static_cast<size_t>(i)];
+                currentValue = slot->current;
+                break;
+            }
+        }
+
+        if (slot == nullptr) {
+            if (numActive_ >= kCapacity)
+                return false;
+            slot = &ramps_[static_cast<size_t>(numActive_++)];
+            slot->key = key;
+        }
+
+        slot->current = currentValue;
+        slot->target = targetValue;
+        slot->increment = (targetValue - currentValue) / static_cast<float>(rampSamples);
+        slot->samplesRemaining = rampSamples;
+        return true;
+    }
+
+    /**
+     * @brief Stop the ramp on key (if any) where it is, without applying its target
+     */
+    void cancel(Key key) {
+        for (int i = 0; i < numActive_; ++i) {
+            if (ramps_[static_cast<size_t>(i)].key == key) {
+                ramps_[static_cast<size_t>(i)] = ramps_[static_cast<size_t>(--numActive_)];
+                return;
+            }
+        }
+    }
+
+    /**
+     * @brief Advance every ramp by a block, reporting its value at each sub-block boundary
+     * @param numSamples Block length in samples
+     * @param apply Callable taking (Key, float value, int sampleOffset), where value is what
+     *        the parameter has reached sampleOffset samples into the block. Offsets rise
+     *        for each key and end at numSamples, or at the sample a ramp lands on its target
+     */
+    template <typename Fn> void advance(int numSamples, Fn&& apply) {
+        for (int i = 0; i < numActive_;) {
+            auto& ramp = ramps_[static_cast<size_t>(i)];
+
+            int offset = 0;
+            while (offset < numSamples && ramp.samplesRemaining > 0) {
+                const int step =
+                    std::min({kSubBlockSamples, numSamples - offset, ramp.samplesRemaining});
+                offset += step;
+                ramp.samplesRemaining -= step;
+                ramp.current = ramp.samplesRemaining == 0
+                                   ? ramp.target
+                                   : ramp.target - ramp.increment *
+                                                       static_cast<float>(ramp.samplesRemaining);
+                apply(ramp.key, ramp.current, offset);
+            }
+
+            if (ramp.samplesRemaining == 0) {
+                // Swap-remove: order of ramps doesn't matter
+                ramp = ramps_[static_cast<size_t>(--numActive_)];
+                continue;
+            }
+            ++i;
+        }
+    }
+
+    /**
+     * @brief Number of ramps currently in flight
+     */
+    int getNumActive() const {
+        return numActive_;
+    }
+
+    /**
+     * @brief Drop every ramp without applying targets
+     */
+    void clear() {
+        numActive_ = 0;
+    }
+
+  private:
+    struct Ramp {
+        Key key{};
+        float current = 0.0f;
+        float target = 0.0f;
+        float increment = 0.0f;
+        int samplesRemaining = 0;
+    };
+
+    std::array<Ramp, kCapacity> ramps_{};
+    int numActive_ = 0;
+};
+
+}  // namespace magda
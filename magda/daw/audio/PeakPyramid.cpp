@@ -0,0 +1,254 @@
+#include "PeakPyramid.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace magda {
+
+namespace {
+constexpr char kMagic[4] = {'M', 'P', 'K', '1'};
+
+template <typename T>
+void append(std::vector<char>& out, const T& value) {
+    const auto* bytes = reinterpret_cast<const char*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T>
+bool extract(const char*& data, const char* end, T& value) {
+    if (static_cast<size_t>(end - data) < sizeof(T))
+        return false;
+    std::memcpy(&value, data, sizeof(T));
+    data += sizeof(T);
+    return true;
+}
+}  // namespace
+
+int16_t PeakPyramid::quantise(float value) {
+    value = std::clamp(value, -1.0f, 1.0f);
+    return static_cast<int16_t>(std::lround(value * 32767.0f));
+}
+
+// =============================================================================
+// Building
+// =============================================================================
+
+void PeakPyramid::begin(int numChannels, double sampleRate) {
+    numChannels_ = std::max(0, numChannels);
+    sampleRate_ = sampleRate;
+    lengthInSamples_ = 0;
+    levels_.assign(1, {});
+
+    accMin_.assign(static_cast<size_t>(numChannels_), 0.0f);
+    accMax_.assign(static_cast<size_t>(numChannels_), 0.0f);
+    accSquares_.assign(static_cast<size_t>(numChannels_), 0.0);
+    accCount_ = 0;
+}
+
+void PeakPyramid::addSamples(const float* const* channels, int numSamples) {
+    if (levels_.empty() || numChannels_ == 0)
+        return;
+
+    int pos = 0;
+    while (pos < numSamples) {
+        const int count = std::min(numSamples - pos, BASE_SAMPLES_PER_PEAK - accCount_);
+
+        for (int ch = 0; ch < numChannels_; ++ch) {
+            const float* samples = channels[ch] + pos;
+            float lo = accCount_ == 0 ? samples[0] : accMin_[static_cast<size_t>(ch)];
+            float hi = accCount_ == 0 ? samples[0] : accMax_[static_cast<size_t>(ch)];
+            double squares = accCount_ == 0 ? 0.0 : accSquares_[static_cast<size_t>(ch)];
+
+            for (int i = 0; i < count; ++i) {
+                const float s = samples[i];
+                lo = std::min(lo, s);
+                hi = std::max(hi, s);
+                squares += static_cast<double>(s) * s;
+            }
+
+            accMin_[static_cast<size_t>(ch)] = lo;
+            accMax_[static_cast<size_t>(ch)] = hi;
+            accSquares_[static_cast<size_t>(ch)] = squares;
+        }
+
+        accCount_ += count;
+        pos += count;
+        lengthInSamples_ += count;
+
+        if (accCount_ == BASE_SAMPLES_PER_PEAK)
+            flushBasePeak();
+    }
+}
+
+void PeakPyramid::flushBasePeak() {
+    for (int ch = 0; ch < numChannels_; ++ch) {
+        const auto c = static_cast<size_t>(ch);
+        Peak peak;
+        peak.min = quantise(accMin_[c]);
+        peak.max = quantise(accMax_[c]);
+        peak.rms = quantise(static_cast<float>(std::sqrt(accSquares_[c] / accCount_)));
+        levels_[0].push_back(peak);
+    }
+    accCount_ = 0;
+}
+
+void PeakPyramid::finish() {
+    if (levels_.empty() || numChannels_ == 0)
+        return;
+
+    if (accCount_ > 0)
+        flushBasePeak();
+
+    // Level 0 grew one peak at a time; drop the slack before it stays resident
+    levels_.front().shrink_to_fit();
+
+    // Each level merges pairs of peaks from the one below, until a single peak remains
+    const auto channels = static_cast<size_t>(numChannels_);
+    while (levels_.back().size() > channels) {
+        const auto& finer = levels_.back();
+        const size_t finerPeaks = finer.size() / channels;
+        std::vector<Peak> coarser((finerPeaks + 1) / 2 * channels);
+
+        for (size_t i = 0; i < finerPeaks; i += 2) {
+            const bool pair = i + 1 < finerPeaks;
+            for (size_t ch = 0; ch < channels; ++ch) {
+                const auto& a = finer[i * channels + ch];
+                const auto& b = pair ? finer[(i + 1) * channels + ch] : a;
+                auto& merged = coarser[i / 2 * channels + ch];
+                merged.min = std::min(a.min, b.min);
+                merged.max = std::max(a.max, b.max);
+                const double meanSquares =
+                    (static_cast<double>(a.rms) * a.rms + static_cast<double>(b.rms) * b.rms) /
+                    2.0;
+                merged.rms = static_cast<int16_t>(std::lround(std::sqrt(meanSquares)));
+            }
+        }
+
+        levels_.push_back(std::move(coarser));
+    }
+
+    accMin_.clear();
+    accMax_.clear();
+    accSquares_.clear();
+}
+
+// =============================================================================
+// Queries
+// =============================================================================
+
+size_t PeakPyramid::getNumPeaks(int level) const {
+    if (level < 0 || level >= getNumLevels() || numChannels_ == 0)
+        return 0;
+    return levels_[static_cast<size_t>(level)].size() / static_cast<size_t>(numChannels_);
+}
+
+size_t PeakPyramid::getMemoryUsage() const {
+    size_t bytes = 0;
+    for (const auto& level : levels_)
+        bytes += level.capacity() * sizeof(Peak);
+    return bytes;
+}
+
+int PeakPyramid::chooseLevel(double samplesPerPixel) const {
+    if (levels_.empty() || samplesPerPixel < BASE_SAMPLES_PER_PEAK)
+        return -1;
+
+    int level = 0;
+    while (level + 1 < getNumLevels() &&
+           static_cast<double>(getSamplesPerPeak(level + 1)) <= samplesPerPixel) {
+        ++level;
+    }
+    return level;
+}
+
+PeakPyramid::Range PeakPyramid::getRange(int level, int channel, int64_t startSample,
+                                         int64_t endSample) const {
+    Range range;
+    const size_t numPeaks = getNumPeaks(level);
+    if (numPeaks == 0 || channel < 0 || channel >= numChannels_)
+        return range;
+
+    const int64_t samplesPerPeak = getSamplesPerPeak(level);
+    const auto lastPeak = static_cast<int64_t>(numPeaks) - 1;
+    const int64_t first = std::clamp<int64_t>(startSample / samplesPerPeak, 0, lastPeak);
+    const int64_t last = std::clamp<int64_t>(
+        std::max<int64_t>(endSample - 1, startSample) / samplesPerPeak, first, lastPeak);
+
+    const auto& peaks = levels_[static_cast<size_t>(level)];
+    const auto channels = static_cast<size_t>(numChannels_);
+    int16_t lo = INT16_MAX;
+    int16_t hi = INT16_MIN;
+    double squares = 0.0;
+
+    for (int64_t i = first; i <= last; ++i) {
+        const auto& peak = peaks[static_cast<size_t>(i) * channels + static_cast<size_t>(channel)];
+        lo = std::min(lo, peak.min);
+        hi = std::max(hi, peak.max);
+        squares += static_cast<double>(peak.rms) * peak.rms;
+    }
+
+    range.min = dequantise(lo);
+    range.max = dequantise(hi);
+    range.rms = static_cast<float>(std::sqrt(squares / static_cast<double>(last - first + 1)) /
+                                   32767.0);
+    return range;
+}
+
+// =============================================================================
+// Serialization
+// =============================================================================
+
+void PeakPyramid::serialise(std::vector<char>& out) const {
+    out.clear();
+    out.insert(out.end(), kMagic, kMagic + sizeof(kMagic));
+    append(out, static_cast<int32_t>(numChannels_));
+    append(out, sampleRate_);
+    append(out, static_cast<int64_t>(lengthInSamples_));
+    append(out, static_cast<int32_t>(levels_.size()));
+
+    for (const auto& level : levels_) {
+        append(out, static_cast<uint64_t>(level.size()));
+        const auto* bytes = reinterpret_cast<const char*>(level.data());
+        out.insert(out.end(), bytes, bytes + level.size() * sizeof(Peak));
+    }
+}
+
+bool PeakPyramid::deserialise(const void* data, size_t size) {
+    const auto* pos = static_cast<const char*>(data);
+    const auto* end = pos + size;
+
+    if (size < sizeof(kMagic) || std::memcmp(pos, kMagic, sizeof(kMagic)) != 0)
+        return false;
+    pos += sizeof(kMagic);
+
+    int32_t numChannels = 0;
+    double sampleRate = 0.0;
+    int64_t length = 0;
+    int32_t numLevels = 0;
+    if (!extract(pos, end, numChannels) || !extract(pos, end, sampleRate) ||
+        !extract(pos, end, length) || !extract(pos, end, numLevels) || numChannels <= 0 ||
+        numLevels <= 0 || numLevels > 64) {
+        return false;
+    }
+
+    std::vector<std::vector<Peak>> levels(static_cast<size_t>(numLevels));
+    for (auto& level : levels) {
+        uint64_t count = 0;
+        if (!extract(pos, end, count) ||
+            count > static_cast<uint64_t>(end - pos) / sizeof(Peak)) {
+            return false;
+        }
+        level.resize(static_cast<size_t>(count));
+        std::memcpy(level.data(), pos, level.size() * sizeof(Peak));
+        pos += level.size() * sizeof(Peak);
+    }
+
+    numChannels_ = numChannels;
+    sampleRate_ = sampleRate;
+    lengthInSamples_ = length;
+    levels_ = std::move(levels);
+    return true;
+}
+
+}  // namespace magda
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace magda {
+
+/**
+ * @brief Multi-resolution min/max/RMS summary of an audio file
+ *
+ * Level 0 holds one peak per BASE_SAMPLES_PER_PEAK samples and each further level halves
+ * the resolution, down to a single peak. Drawing picks the coarsest level that still has at
+ * least one peak per pixel (chooseLevel), so each pixel aggregates at most a few peaks and
+ * paint cost follows the pixel width rather than the audio length. Zoomed in further than
+ * level 0, callers read raw samples instead (chooseLevel returns -1).
+ *
+ * Values are stored as int16 (full scale = 32767) to keep an hour of stereo audio at a
+ * few tens of megabytes across all levels.
+ *
+ * Built incrementally: begin(), any number of addSamples() blocks, then finish().
+ */
+class PeakPyramid {
+  public:
+    static constexpr int BASE_SAMPLES_PER_PEAK = 256;  // Power of two
+
+    struct Peak {
+        int16_t min = 0;
+        int16_t max = 0;
+        int16_t rms = 0;
+    };
+
+    struct Range {
+        float min = 0.0f;
+        float max = 0.0f;
+        float rms = 0.0f;
+    };
+
+    // =========================================================================
+    // Building
+    // =========================================================================
+
+    void begin(int numChannels, double sampleRate);
+    void addSamples(const float* const* channels, int numSamples);
+    void finish();
+
+    // =========================================================================
+    // Queries
+    // =========================================================================
+
+    int getNumChannels() const {
+        return numChannels_;
+    }
+    double getSampleRate() const {
+        return sampleRate_;
+    }
+    int64_t getLengthInSamples() const {
+        return lengthInSamples_;
+    }
+    int getNumLevels() const {
+        return static_cast<int>(levels_.size());
+    }
+    bool isEmpty() const {
+        return levels_.empty();
+    }
+
+    static int64_t getSamplesPerPeak(int level) {
+        return static_cast<int64_t>(BASE_SAMPLES_PER_PEAK) << level;
+    }
+
+    size_t getNumPeaks(int level) const;
+
+    /**
+     * @brief Bytes held by the peak data across all levels
+     */
+    size_t getMemoryUsage() const;
+
+    /**
+     * @brief Coarsest level with at most samplesPerPixel samples per peak, or -1 if even
+     *        level 0 is too coarse (draw from raw samples)
+     */
+    int chooseLevel(double samplesPerPixel) const;
+
+    /**
+     * @brief Aggregate the peaks of one channel covering [startSample, endSample)
+     */
+    Range getRange(int level, int channel, int64_t startSample, int64_t endSample) const;
+
+    // =========================================================================
+    // Serialization (native byte order - the data is a local cache)
+    // =========================================================================
+
+    void serialise(std::vector<char>& out) const;
+    bool deserialise(const void* data, size_t size);
+
+  private:
+    void flushBasePeak();
+
+    static int16_t quantise(float value);
+    static float dequantise(int16_t value) {
+        return static_cast<float>(value) / 32767.0f;
+    }
+
+    int numChannels_ = 0;
+    double sampleRate_ = 0.0;
+    int64_t lengthInSamples_ = 0;
+
+    // levels_[level][peak * numChannels + channel]
+    std::vector<std::vector<Peak>> levels_;
+
+    // Accumulators for the level-0 peak being built
+    std::vector<float> accMin_;
+    std::vector<float> accMax_;
+    std::vector<double> accSquares_;
+    int accCount_ = 0;
+};
+
+}  // namespace magda
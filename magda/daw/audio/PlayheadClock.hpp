@@ -0,0 +1,133 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+
+namespace magda {
+
+/**
+ * @brief Where the transport is, published by the audio thread with the time it is heard
+ *
+ * Each callback publishes the position its block starts at and the host time that block
+ * reaches the speakers. The UI reads the latest pair once per display frame and
+ * extrapolates to the frame's own time, so the playhead moves every vsync instead of
+ * jumping whenever a polling timer fires, and stays in step with what is heard.
+ *
+ * The sample is the whole transport state of that block - play state, tempo, whether it
+ * is the first block since play started and where in it the loop wrapped - as the audio
+ * thread played it, so a reader never combines the play state of one block with the loop
+ * wrap of another. version counts publishes: a reader that sees it unchanged has already
+ * seen this block.
+ *
+ * A seqlock: one writer (the audio thread) never waits, readers retry the rare read that
+ * overlaps a publish. Fields are atomics so a torn read is only ever discarded, never UB.
+ */
+class PlayheadClock {
+  public:
+    struct Sample {
+        double positionSeconds = 0.0;  // Transport position at the start of the block
+        double hostTimeMs = 0.0;       // When that position is heard (millisecond counter)
+        double loopStartSeconds = 0.0;
+        double loopEndSeconds = 0.0;  // Not looping when <= loopStartSeconds
+        double bpm = 120.0;           // Tempo the block played at
+        int loopWrapSample = -1;      // Sample the block wrapped to the loop start on, or -1
+        bool playing = false;
+        bool justStarted = false;  // First block since play started
+        uint32_t version = 0;      // Set by read(): publishes so far
+    };
+
+    /**
+     * @brief Audio thread only
+     */
+    void publish(const Sample& sample) noexcept {
+        const auto sequence = sequence_.load(std::memory_order_relaxed);
+        sequence_.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        position_.store(sample.positionSeconds, std::memory_order_relaxed);
+        hostTime_.store(sample.hostTimeMs, std::memory_order_relaxed);
+        loopStart_.store(sample.loopStartSeconds, std::memory_order_relaxed);
+        loopEnd_.store(sample.loopEndSeconds, std::memory_order_relaxed);
+        bpm_.store(sample.bpm, std::memory_order_relaxed);
+        loopWrap_.store(sample.loopWrapSample, std::memory_order_relaxed);
+        playing_.store(sample.playing, std::memory_order_relaxed);
+        justStarted_.store(sample.justStarted, std::memory_order_relaxed);
+
+        sequence_.store(sequence + 2, std::memory_order_release);
+    }
+
+    /**
+     * @brief The latest sample, from any thread
+     * @return False if nothing was published yet, or every attempt overlapped a publish
+     */
+    bool read(Sample& out) const noexcept {
+        for (int attempt = 0; attempt < kMaxReadAttempts; ++attempt) {
+            const auto before = sequence_.load(std::memory_order_acquire);
+            if (before == 0) {
+                return false;
+            }
+            if ((before & 1u) != 0) {
+                continue;
+            }
+
+            Sample sample;
+            sample.positionSeconds = position_.load(std::memory_order_relaxed);
+            sample.hostTimeMs = hostTime_.load(std::memory_order_relaxed);
+            sample.loopStartSeconds = loopStart_.load(std::memory_order_relaxed);
+            sample.loopEndSeconds = loopEnd_.load(std::memory_order_relaxed);
+            sample.bpm = bpm_.load(std::memory_order_relaxed);
+            sample.loopWrapSample = loopWrap_.load(std::memory_order_relaxed);
+            sample.playing = playing_.load(std::memory_order_relaxed);
+            sample.justStarted = justStarted_.load(std::memory_order_relaxed);
+            sample.version = before / 2;
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sequence_.load(std::memory_order_relaxed) == before) {
+                out = sample;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief The position being heard at nowMs, wrapping at the loop end
+     *
+     * The heard position trails the latest block by the output latency, so just after a
+     * loop wraps it is still near the loop end; inside a loop it wraps both ways.
+     */
+    static double extrapolate(const Sample& sample, double nowMs) {
+        if (!sample.playing) {
+            return sample.positionSeconds;
+        }
+
+        double position = sample.positionSeconds + (nowMs - sample.hostTimeMs) * 0.001;
+        const double loopLength = sample.loopEndSeconds - sample.loopStartSeconds;
+        if (loopLength > 0.0 && sample.positionSeconds >= sample.loopStartSeconds &&
+            sample.positionSeconds < sample.loopEndSeconds) {
+            position = sample.loopStartSeconds +
+                       std::fmod(position - sample.loopStartSeconds, loopLength);
+            if (position < sample.loopStartSeconds) {
+                position += loopLength;
+            }
+        }
+        return std::max(0.0, position);
+    }
+
+  private:
+    static constexpr int kMaxReadAttempts = 8;
+
+    std::atomic<uint32_t> sequence_{0};  // Odd while a publish is in progress
+    std::atomic<double> position_{0.0};
+    std::atomic<double> hostTime_{0.0};
+    std::atomic<double> loopStart_{0.0};
+    std::atomic<double> loopEnd_{0.0};
+    std::atomic<double> bpm_{120.0};
+    std::atomic<int> loopWrap_{-1};
+    std::atomic<bool> playing_{false};
+    std::atomic<bool> justStarted_{false};
+};
+
+}  // namespace magda
@@ -0,0 +1,169 @@
+#include "PluginInstancePool.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace magda {
+
+PluginInstancePool::PluginInstancePool(Factory createInstance, std::function<bool()> canRefill)
+    : createInstance_(std::move(createInstance)), canRefill_(std::move(canRefill)) {}
+
+PluginInstancePool::~PluginInstancePool() {
+    clear();
+}
+
+void PluginInstancePool::setWarmPlugins(const juce::Array<juce::PluginDescription>& descriptions) {
+    std::vector<Entry> entries;
+    for (const auto& description : descriptions) {
+        if (static_cast<int>(entries.size()) >= MAX_PLUGINS) {
+            break;
+        }
+
+        // Plugins that stay listed keep their instances
+        const auto identifier = description.createIdentifierString();
+        auto it = std::find_if(entries_.begin(), entries_.end(),
+                               [&](const Entry& entry) { return entry.identifier == identifier; });
+        if (it != entries_.end()) {
+            entries.push_back(std::move(*it));
+            entries_.erase(it);
+        } else {
+            entries.push_back({description, identifier, {}, false});
+        }
+    }
+
+    entries_ = std::move(entries);  // Releases the instances of plugins no longer listed
+    scheduleRefill(INITIAL_DELAY_MS);
+}
+
+PluginInstancePool::Entry* PluginInstancePool::find(const juce::PluginDescription& description) {
+    const auto identifier = description.createIdentifierString();
+    auto it = std::find_if(entries_.begin(), entries_.end(),
+                           [&](const Entry& entry) { return entry.identifier == identifier; });
+    return it != entries_.end() ? &*it : nullptr;
+}
+
+te::Plugin::Ptr PluginInstancePool::take(const juce::PluginDescription& description) {
+    const auto identifier = description.createIdentifierString();
+    auto reserved = std::find_if(reserved_.begin(), reserved_.end(), [&](const Reservation& r) {
+        return r.identifier == identifier && r.instance != nullptr;
+    });
+    if (reserved != reserved_.end()) {
+        auto plugin = std::move(reserved->instance);
+        reserved_.erase(reserved);
+        return plugin;
+    }
+
+    auto* entry = find(description);
+    if (entry == nullptr || entry->instances.empty()) {
+        return nullptr;
+    }
+
+    auto plugin = entry->instances.back();
+    entry->instances.pop_back();
+    scheduleRefill(REFILL_INTERVAL_MS);
+    return plugin;
+}
+
+bool PluginInstancePool::isWarm(const juce::PluginDescription& description) const {
+    const auto identifier = description.createIdentifierString();
+    return std::any_of(entries_.begin(), entries_.end(), [&](const Entry& entry) {
+        return entry.identifier == identifier && !entry.instances.empty();
+    });
+}
+
+int PluginInstancePool::getNumInstances() const {
+    int count = 0;
+    for (const auto& entry : entries_) {
+        count += static_cast<int>(entry.instances.size());
+    }
+    return count;
+}
+
+void PluginInstancePool::reserve(const juce::Array<juce::PluginDescription>& descriptions) {
+    std::vector<Reservation> reserved;
+    for (const auto& description : descriptions) {
+        // Instances made for the earlier reservation carry over where they still fit
+        const auto identifier = description.createIdentifierString();
+        auto it = std::find_if(reserved_.begin(), reserved_.end(), [&](const Reservation& r) {
+            return r.identifier == identifier;
+        });
+        if (it != reserved_.end()) {
+            reserved.push_back(std::move(*it));
+            reserved_.erase(it);
+        } else {
+            reserved.push_back({description, identifier, nullptr, false});
+        }
+    }
+
+    reserved_ = std::move(reserved);
+    if (!reserved_.empty()) {
+        startTimer(RESERVE_INTERVAL_MS);  // Sooner than a refill already due
+    }
+}
+
+void PluginInstancePool::releaseReserved() {
+    reserved_.clear();
+}
+
+int PluginInstancePool::getNumReservedReady() const {
+    return static_cast<int>(
+        std::count_if(reserved_.begin(), reserved_.end(),
+                      [](const Reservation& r) { return r.instance != nullptr; }));
+}
+
+bool PluginInstancePool::isReservationComplete() const {
+    return std::all_of(reserved_.begin(), reserved_.end(), [](const Reservation& r) {
+        return r.instance != nullptr || r.failed;
+    });
+}
+
+void PluginInstancePool::clear() {
+    stopTimer();
+    entries_.clear();
+    reserved_.clear();
+}
+
+void PluginInstancePool::scheduleRefill(int delayMs) {
+    // A refill already due goes ahead as planned
+    if (!isTimerRunning()) {
+        startTimer(delayMs);
+    }
+}
+
+void PluginInstancePool::timerCallback() {
+    auto unmade = std::find_if(reserved_.begin(), reserved_.end(), [](const Reservation& r) {
+        return r.instance == nullptr && !r.failed;
+    });
+    if (unmade != reserved_.end()) {
+        startTimer(RESERVE_INTERVAL_MS);
+        if (canRefill_ && !canRefill_()) {
+            return;
+        }
+        unmade->instance = createInstance_ ? createInstance_(unmade->description) : nullptr;
+        unmade->failed = unmade->instance == nullptr;
+        return;
+    }
+
+    auto missing = std::find_if(entries_.begin(), entries_.end(), [](const Entry& entry) {
+        return !entry.failed && static_cast<int>(entry.instances.size()) < INSTANCES_PER_PLUGIN;
+    });
+    if (missing == entries_.end()) {
+        stopTimer();  // Full; the next take() restarts it
+        return;
+    }
+
+    startTimer(REFILL_INTERVAL_MS);
+    if (canRefill_ && !canRefill_()) {
+        return;  // Busy: try again next tick
+    }
+
+    // One instance per tick, so the message loop runs between them
+    auto plugin = createInstance_ ? createInstance_(missing->description) : nullptr;
+    if (plugin == nullptr) {
+        missing->failed = true;
+        return;
+    }
+    missing->instances.push_back(std::move(plugin));
+}
+
+}  // namespace magda
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <tracktion_engine/tracktion_engine.h>
+
+#include <functional>
+#include <vector>
+
+namespace magda {
+
+namespace te = tracktion;
+
+/**
+ * @brief Initialised instances of the most-used plugins, ready to be inserted
+ *
+ * Instantiating a big VST3 instrument takes seconds, so inserting one waits that long, again
+ * for every duplicate. The pool keeps INSTANCES_PER_PLUGIN instances of each warm plugin
+ * created in advance (by the owner's factory, from the Edit's PluginCache); an insertion takes
+ * one, the caller applies the device's state, and the pool makes a replacement later.
+ *
+ * VST3/AU instantiation must happen on the message thread, so refills can't run on a worker:
+ * they are made one instance per timer tick, and only while canRefill() says the message
+ * thread is otherwise idle (no queued plugin loads). The instances sit outside any track, so
+ * they are never rendered.
+ *
+ * A project about to be opened can also reserve() an instance for each of its external
+ * devices, so switching to it doesn't wait for its plugins (see ProjectSwitcher). Reserved
+ * instances are made before warm ones, at a shorter interval, and take() hands them out
+ * first. Message thread only.
+ */
+class PluginInstancePool : private juce::Timer {
+  public:
+    static constexpr int MAX_PLUGINS = 4;  // Warm plugins, each holding its instances' memory
+    static constexpr int INSTANCES_PER_PLUGIN = 1;
+    static constexpr int MIN_USES = 2;  // Inserted at least this often to be kept warm
+    static constexpr int REFILL_INTERVAL_MS = 500;
+    static constexpr int INITIAL_DELAY_MS = 3000;  // Let startup finish first
+    static constexpr int RESERVE_INTERVAL_MS = 50;  // Reserved instances are wanted soon
+
+    using Factory = std::function<te::Plugin::Ptr(const juce::PluginDescription&)>;
+
+    PluginInstancePool(Factory createInstance, std::function<bool()> canRefill);
+    ~PluginInstancePool() override;
+
+    /**
+     * @brief Which plugins to keep warm (at most MAX_PLUGINS, most used first)
+     *
+     * Instances of plugins no longer listed are released; new ones are created over the
+     * following ticks.
+     */
+    void setWarmPlugins(const juce::Array<juce::PluginDescription>& descriptions);
+
+    /**
+     * @brief An initialised instance of the plugin, or nullptr if none is warm
+     */
+    te::Plugin::Ptr take(const juce::PluginDescription& description);
+
+    bool isWarm(const juce::PluginDescription& description) const;
+    int getNumInstances() const;
+
+    /**
+     * @brief Create one instance per description, ahead of a project that needs them
+     *
+     * List a plugin once per device using it. Replaces any earlier reservation, keeping
+     * the instances it still covers.
+     */
+    void reserve(const juce::Array<juce::PluginDescription>& descriptions);
+
+    /**
+     * @brief Release the reserved instances nobody took
+     */
+    void releaseReserved();
+
+    /**
+     * @brief Reserved instances not taken yet, and how many of them exist so far
+     */
+    int getNumReserved() const {
+        return static_cast<int>(reserved_.size());
+    }
+    int getNumReservedReady() const;
+
+    /**
+     * @brief True once every reserved instance has been made or has failed
+     */
+    bool isReservationComplete() const;
+
+    /**
+     * @brief Release every instance and stop refilling (before the Edit goes away)
+     */
+    void clear();
+
+  private:
+    void timerCallback() override;
+
+    struct Entry {
+        juce::PluginDescription description;
+        juce::String identifier;
+        std::vector<te::Plugin::Ptr> instances;
+        bool failed = false;  // Couldn't be created; not retried until listed again
+    };
+
+    struct Reservation {
+        juce::PluginDescription description;
+        juce::String identifier;
+        te::Plugin::Ptr instance;
+        bool failed = false;
+    };
+
+    Entry* find(const juce::PluginDescription& description);
+    void scheduleRefill(int delayMs);
+
+    Factory createInstance_;
+    std::function<bool()> canRefill_;
+    std::vector<Entry> entries_;
+    std::vector<Reservation> reserved_;
+};
+
+}  // namespace magda
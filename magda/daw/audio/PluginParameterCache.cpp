@@ -0,0 +1,183 @@
+#include "PluginParameterCache.hpp"
+
+#include <utility>
+
+namespace magda {
+
+namespace {
+const juce::Identifier kParametersTag("PLUGINPARAMETERS");
+const juce::Identifier kParameterTag("PARAM");
+const juce::Identifier kChoiceTag("CHOICE");
+const juce::Identifier kKeyAttr("key");
+const juce::Identifier kNameAttr("name");
+const juce::Identifier kUnitAttr("unit");
+const juce::Identifier kMinAttr("min");
+const juce::Identifier kMaxAttr("max");
+const juce::Identifier kDefaultAttr("default");
+const juce::Identifier kScaleAttr("scale");
+const juce::Identifier kSkewAttr("skew");
+const juce::Identifier kModulatableAttr("modulatable");
+const juce::Identifier kBipolarAttr("bipolar");
+const juce::Identifier kTextAttr("text");
+
+bool namesMatch(const PluginParameterCache::Parameters& parameters,
+                const std::vector<juce::String>& names) {
+    if (parameters.size() != names.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < names.size(); ++i) {
+        // Both sides are usually the same interned text (see Symbol); compare bytes otherwise
+        if (parameters[i].name.getCharPointer() != names[i].getCharPointer() &&
+            parameters[i].name != names[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+}  // namespace
+
+PluginParameterCache& PluginParameterCache::getInstance() {
+    static PluginParameterCache instance;
+    return instance;
+}
+
+juce::String PluginParameterCache::getKey(const juce::PluginDescription& description) {
+    return description.createIdentifierString() + "-" + description.version;
+}
+
+juce::File PluginParameterCache::getCacheDirectory() {
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+        .getChildFile("MAGDA")
+        .getChildFile("ParameterCache");
+}
+
+juce::File PluginParameterCache::getCacheFile(const juce::String& key) {
+    return getCacheDirectory().getChildFile(juce::String::toHexString(key.hashCode64()) +
+                                            ".params");
+}
+
+std::shared_ptr<const PluginParameterCache::Parameters> PluginParameterCache::find(
+    const juce::String& key, const std::vector<juce::String>& names) {
+    if (key.isEmpty()) {
+        return nullptr;
+    }
+
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+        // First instance of this plugin type this session: try the disk
+        const auto file = getCacheFile(key);
+        juce::MemoryBlock data;
+        auto parameters = std::make_shared<Parameters>();
+        if (!file.existsAsFile() || !file.loadFileAsData(data) ||
+            !fromValueTree(juce::ValueTree::readFromData(data.getData(), data.getSize()), key,
+                           *parameters)) {
+            return nullptr;
+        }
+        it = entries_.emplace(key, std::move(parameters)).first;
+    }
+
+    if (!namesMatch(*it->second, names)) {
+        entries_.erase(it);
+        getCacheFile(key).deleteFile();
+        return nullptr;
+    }
+    return it->second;
+}
+
+std::shared_ptr<const PluginParameterCache::Parameters> PluginParameterCache::store(
+    const juce::String& key, Parameters parameters) {
+    auto entry = std::make_shared<const Parameters>(std::move(parameters));
+    if (key.isEmpty()) {
+        return entry;
+    }
+    entries_[key] = entry;
+
+    const auto file = getCacheFile(key);
+    auto directory = file.getParentDirectory();
+    if (!directory.isDirectory() && !directory.createDirectory()) {
+        return entry;
+    }
+
+    juce::MemoryOutputStream data;
+    toValueTree(key, *entry).writeToStream(data);
+
+    // Write to a temporary file first so a crash never leaves a truncated file
+    juce::TemporaryFile temp(file);
+    if (temp.getFile().replaceWithData(data.getData(), data.getDataSize())) {
+        temp.overwriteTargetFileWithTemporary();
+    }
+    return entry;
+}
+
+void PluginParameterCache::clear() {
+    entries_.clear();
+    getCacheDirectory().deleteRecursively();
+}
+
+// =============================================================================
+// Serialization
+// =============================================================================
+
+juce::ValueTree PluginParameterCache::toValueTree(const juce::String& key,
+                                                  const Parameters& parameters) {
+    juce::ValueTree tree(kParametersTag);
+    tree.setProperty(kKeyAttr, key, nullptr);
+    for (const auto& info : parameters) {
+        juce::ValueTree param(kParameterTag);
+        param.setProperty(kNameAttr, info.name, nullptr);
+        param.setProperty(kUnitAttr, info.unit, nullptr);
+        param.setProperty(kMinAttr, info.minValue, nullptr);
+        param.setProperty(kMaxAttr, info.maxValue, nullptr);
+        param.setProperty(kDefaultAttr, info.defaultValue, nullptr);
+        param.setProperty(kScaleAttr, static_cast<int>(info.scale), nullptr);
+        param.setProperty(kSkewAttr, info.skewFactor, nullptr);
+        param.setProperty(kModulatableAttr, info.modulatable, nullptr);
+        param.setProperty(kBipolarAttr, info.bipolarModulation, nullptr);
+        for (const auto& choice : info.choices) {
+            juce::ValueTree choiceTree(kChoiceTag);
+            choiceTree.setProperty(kTextAttr, choice, nullptr);
+            param.appendChild(choiceTree, nullptr);
+        }
+        tree.appendChild(param, nullptr);
+    }
+    return tree;
+}
+
+bool PluginParameterCache::fromValueTree(const juce::ValueTree& tree, const juce::String& key,
+                                         Parameters& parameters) {
+    // The file name is a hash of the key, so check it's this plugin's
+    if (!tree.hasType(kParametersTag) || tree[kKeyAttr].toString() != key) {
+        return false;
+    }
+
+    Parameters loaded;
+    loaded.reserve(static_cast<size_t>(tree.getNumChildren()));
+    for (const auto& param : tree) {
+        if (!param.hasType(kParameterTag)) {
+            continue;
+        }
+        ParameterInfo info;
+        info.paramIndex = static_cast<int>(loaded.size());
+        info.name = param[kNameAttr].toString();
+        info.unit = param[kUnitAttr].toString();
+        info.minValue = static_cast<float>(param[kMinAttr]);
+        info.maxValue = static_cast<float>(param[kMaxAttr]);
+        info.defaultValue = static_cast<float>(param[kDefaultAttr]);
+        info.currentValue = info.defaultValue;
+        info.scale = static_cast<ParameterScale>(
+            juce::jlimit(0, static_cast<int>(ParameterScale::FaderDB),
+                         static_cast<int>(param[kScaleAttr])));
+        info.skewFactor = static_cast<float>(param.getProperty(kSkewAttr, 1.0f));
+        info.modulatable = static_cast<bool>(param.getProperty(kModulatableAttr, true));
+        info.bipolarModulation = static_cast<bool>(param.getProperty(kBipolarAttr, true));
+        for (const auto& choice : param) {
+            info.choices.push_back(choice[kTextAttr].toString());
+        }
+        loaded.push_back(std::move(info));
+    }
+
+    parameters = std::move(loaded);
+    return true;
+}
+
+}  // namespace magda
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <juce_data_structures/juce_data_structures.h>
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "../core/ParameterList.hpp"
+
+namespace magda {
+
+/**
+ * @brief Parameter metadata of each plugin type, kept on disk after its first load
+ *
+ * Asking a plugin for the name, label, range and states of every parameter is slow for
+ * plugins with thousands of them, and the answers only change with the plugin's version.
+ * ExternalPluginProcessor reads them from the plugin once, stores them here keyed by plugin
+ * identifier and version, and later instances of that plugin - this session or the next -
+ * copy them instead, asking the plugin only for current values. Value text is formatted on
+ * demand from the metadata (ParameterUtils::formatValue), never queried up front.
+ *
+ * Message thread only; entries are read from disk the first time a plugin type asks.
+ */
+class PluginParameterCache {
+  public:
+    using Parameters = ParameterList::Metadata;
+
+    static PluginParameterCache& getInstance();
+
+    /**
+     * @brief The key for a plugin type: its identifier string and version
+     */
+    static juce::String getKey(const juce::PluginDescription& description);
+
+    /**
+     * @brief The cached metadata of a plugin type
+     * @param names The live plugin's parameter names, in index order: an entry that doesn't
+     *              match them (a plugin updated without changing its version) is discarded
+     * @return Nullptr if the plugin type has no entry yet; current values are not meaningful
+     */
+    std::shared_ptr<const Parameters> find(const juce::String& key,
+                                           const std::vector<juce::String>& names);
+
+    /**
+     * @brief Keep a plugin type's metadata, in memory and on disk (not with an empty key)
+     * @return The kept metadata
+     */
+    std::shared_ptr<const Parameters> store(const juce::String& key, Parameters parameters);
+
+    /**
+     * @brief Forget every entry, on disk too
+     */
+    void clear();
+
+    static juce::File getCacheDirectory();
+
+    // Serialization
+    static juce::ValueTree toValueTree(const juce::String& key, const Parameters& parameters);
+    static bool fromValueTree(const juce::ValueTree& tree, const juce::String& key,
+                              Parameters& parameters);
+
+  private:
+    PluginParameterCache() = default;
+    ~PluginParameterCache() = default;
+
+    static juce::File getCacheFile(const juce::String& key);
+
+    std::map<juce::String, std::shared_ptr<const Parameters>> entries_;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PluginParameterCache)
+};
+
+}  // namespace magda
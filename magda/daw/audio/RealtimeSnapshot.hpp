@@ -0,0 +1,115 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace magda {
+
+/**
+ * @brief Immutable data published from the message thread to real-time readers
+ *
+ * The message thread builds a new T and publish()es it; the audio thread brackets each
+ * use with acquire()/release(). A hazard pointer records which snapshot the audio thread
+ * is reading, so replaced snapshots are only destroyed on the message thread once it has
+ * moved on. The audio thread never allocates, frees or blocks.
+ *
+ * NumReaders gives each real-time thread its own hazard slot (for example one per MIDI
+ * input); a reader passes its slot to acquire()/release().
+ *
+ * Threading: publish(), collectGarbage() and clear() from the message thread only;
+ * acquire() and release() for a given slot from one real-time thread at a time.
+ */
+template <typename T, size_t NumReaders = 1> class RealtimeSnapshot {
+  public:
+    // =========================================================================
+    // Message thread
+    // =========================================================================
+
+    /**
+     * @brief Make a new snapshot visible to the audio thread
+     */
+    void publish(std::unique_ptr<T> snapshot) {
+        active_.store(snapshot.get());
+        owned_.push_back(std::move(snapshot));
+        collectGarbage();
+    }
+
+    /**
+     * @brief The most recently published snapshot (message thread view)
+     */
+    T* getPublished() const {
+        return active_.load();
+    }
+
+    /**
+     * @brief Destroy replaced snapshots the audio thread is no longer reading
+     */
+    void collectGarbage() {
+        auto* active = active_.load();
+        std::array<T*, NumReaders> inUse;
+        for (size_t i = 0; i < NumReaders; ++i)
+            inUse[i] = inUse_[i].load();
+
+        owned_.erase(std::remove_if(owned_.begin(), owned_.end(),
+                                    [active, &inUse](const auto& snapshot) {
+                                        return snapshot.get() != active &&
+                                               std::find(inUse.begin(), inUse.end(),
+                                                         snapshot.get()) == inUse.end();
+                                    }),
+                     owned_.end());
+    }
+
+    /**
+     * @brief True if replaced snapshots are still waiting to be destroyed
+     */
+    bool hasRetired() const {
+        return owned_.size() > 1;
+    }
+
+    /**
+     * @brief Drop everything (call only when the audio thread can't be reading)
+     */
+    void clear() {
+        active_.store(nullptr);
+        owned_.clear();
+    }
+
+    // =========================================================================
+    // Audio thread
+    // =========================================================================
+
+    /**
+     * @brief Pin the current snapshot for reading until release()
+     * @return The snapshot, or nullptr if none has been published
+     */
+    T* acquire(size_t reader = 0) {
+        // Announce which snapshot we are about to read, then confirm it is still the
+        // published one. Once confirmed, collectGarbage() won't free it.
+        T* snapshot = active_.load();
+        for (;;) {
+            inUse_[reader].store(snapshot);
+            auto* current = active_.load();
+            if (current == snapshot)
+                return snapshot;
+            snapshot = current;
+        }
+    }
+
+    /**
+     * @brief Unpin the snapshot returned by acquire()
+     */
+    void release(size_t reader = 0) {
+        inUse_[reader].store(nullptr);
+    }
+
+  private:
+    std::atomic<T*> active_{nullptr};
+    std::array<std::atomic<T*>, NumReaders> inUse_{};  // Hazard pointer per reader
+    std::vector<std::unique_ptr<T>> owned_;
+};
+
+}  // namespace magda
@@ -0,0 +1,66 @@
+#include "RenderThreadPolicy.hpp"
+
+#include <juce_core/juce_core.h>
+
+#if JUCE_MAC
+    #include <mach/mach.h>
+    #include <mach/thread_policy.h>
+    #include <pthread.h>
+#elif JUCE_WINDOWS
+    #include <windows.h>
+#endif
+
+namespace magda {
+
+namespace {
+
+#if JUCE_MAC
+// Threads the audio driver already made time-constraint must keep that policy
+bool isTimeConstraintThread() {
+    thread_time_constraint_policy_data_t policy;
+    mach_msg_type_number_t count = THREAD_TIME_CONSTRAINT_POLICY_COUNT;
+    boolean_t getDefault = FALSE;
+    const auto result =
+        thread_policy_get(pthread_mach_thread_np(pthread_self()), THREAD_TIME_CONSTRAINT_POLICY,
+                          reinterpret_cast<thread_policy_t>(&policy), &count, &getDefault);
+    return result == KERN_SUCCESS && !getDefault;
+}
+#endif
+
+void setPerformanceScheduling(bool performanceCores) {
+#if JUCE_MAC
+    // QoS steers threads between performance and efficiency cores on Apple silicon
+    if (!isTimeConstraintThread()) {
+        pthread_set_qos_class_self_np(
+            performanceCores ? QOS_CLASS_USER_INTERACTIVE : QOS_CLASS_DEFAULT, 0);
+    }
+#elif JUCE_WINDOWS
+    // Opt out of EcoQoS, which hybrid CPUs schedule onto efficiency cores
+    THREAD_POWER_THROTTLING_STATE state{};
+    state.Version = THREAD_POWER_THROTTLING_CURRENT_VERSION;
+    state.ControlMask = THREAD_POWER_THROTTLING_EXECUTION_SPEED;
+    state.StateMask = performanceCores ? 0 : THREAD_POWER_THROTTLING_EXECUTION_SPEED;
+    SetThreadInformation(GetCurrentThread(), ThreadPowerThrottling, &state, sizeof(state));
+#else
+    juce::ignoreUnused(performanceCores);  // No hybrid-core hint on Linux
+#endif
+}
+
+}  // namespace
+
+void RenderThreadPolicy::configureCurrentThread(int threadIndex) {
+    const int numCpus = juce::jlimit(1, 32, juce::SystemStats::getNumCpus());  // Mask width
+    const auto allCores = static_cast<juce::uint32>((uint64_t{1} << numCpus) - 1);
+
+    // Unpinning restores every core, in case an earlier setting pinned this thread
+    if (pinToCores_.load(std::memory_order_relaxed)) {
+        const int core = RenderThreadSettings::coreForThread(threadIndex, numCpus);
+        juce::Thread::setCurrentThreadAffinityMask(juce::uint32{1} << core);
+    } else {
+        juce::Thread::setCurrentThreadAffinityMask(allCores);
+    }
+
+    setPerformanceScheduling(performanceCores_.load(std::memory_order_relaxed));
+}
+
+}  // namespace magda
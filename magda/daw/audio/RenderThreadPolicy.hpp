@@ -0,0 +1,125 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
+namespace magda {
+
+/**
+ * @brief How the engine's render threads are sized and scheduled
+ */
+struct RenderThreadSettings {
+    static constexpr int kAutomatic = 0;
+
+    int numThreads = kAutomatic;   // Multi-threaded profiles' thread count (0 = half the cores)
+    bool pinToCores = false;       // Give each render thread a core of its own
+    bool performanceCores = true;  // Ask the OS to keep render threads off efficiency cores
+
+    int resolveNumThreads(int numCpus) const {
+        const int cpus = std::max(1, numCpus);
+        return numThreads > 0 ? std::min(numThreads, cpus) : std::max(1, cpus / 2);
+    }
+
+    /**
+     * @brief Core for the index-th render thread when pinning
+     *
+     * Assigned from the last core down, so core 0 (where the OS tends to service
+     * interrupts and the message thread usually runs) is used last.
+     */
+    static int coreForThread(int threadIndex, int numCpus) {
+        const int cpus = std::max(1, numCpus);
+        return cpus - 1 - (std::max(0, threadIndex) % cpus);
+    }
+
+    /**
+     * @brief Cores for background work that shouldn't compete with rendering (the local
+     *        model worker)
+     *
+     * The cores below the ones render threads are pinned to, leaving out core 0 when there
+     * are others; 0 if rendering may use every core.
+     */
+    uint32_t backgroundCoreMask(int numCpus) const {
+        const int cpus = std::clamp(numCpus, 1, 32);  // Mask width
+        const int free = cpus - resolveNumThreads(cpus);
+        if (free <= 0) {
+            return 0;
+        }
+        const int first = free > 1 ? 1 : 0;
+        return static_cast<uint32_t>(((uint64_t{1} << free) - 1) & ~((uint64_t{1} << first) - 1));
+    }
+
+    bool operator==(const RenderThreadSettings&) const = default;
+};
+
+/**
+ * @brief Applies RenderThreadSettings to the threads that render the graph
+ *
+ * Tracktion creates its render threads internally, so each one configures itself from
+ * the first MAGDA code it runs in a block (the meter plugin on every track, the bridge's
+ * device callback). A settings change bumps a generation; each thread sees it on its
+ * next block and re-applies affinity and scheduling class once, claiming the next core.
+ * Between changes the check is one atomic load.
+ */
+class RenderThreadPolicy {
+  public:
+    static RenderThreadPolicy& getInstance() {
+        static RenderThreadPolicy instance;
+        return instance;
+    }
+
+    /**
+     * @brief Publish new settings (message thread)
+     */
+    void setSettings(const RenderThreadSettings& settings) {
+        numThreads_.store(settings.numThreads, std::memory_order_relaxed);
+        pinToCores_.store(settings.pinToCores, std::memory_order_relaxed);
+        performanceCores_.store(settings.performanceCores, std::memory_order_relaxed);
+        nextThreadIndex_.store(0, std::memory_order_relaxed);
+        generation_.fetch_add(1, std::memory_order_release);
+    }
+
+    RenderThreadSettings getSettings() const {
+        RenderThreadSettings settings;
+        settings.numThreads = numThreads_.load(std::memory_order_relaxed);
+        settings.pinToCores = pinToCores_.load(std::memory_order_relaxed);
+        settings.performanceCores = performanceCores_.load(std::memory_order_relaxed);
+        return settings;
+    }
+
+    /**
+     * @brief Configure the calling render thread if the settings changed since it last did
+     *
+     * Call at the top of render callbacks. The first call after a change makes a few
+     * scheduler syscalls; every other call is a load and a compare.
+     */
+    void applyToCurrentThread() {
+        thread_local uint32_t appliedGeneration = 0;
+        const auto generation = generation_.load(std::memory_order_acquire);
+        if (generation != appliedGeneration) {
+            appliedGeneration = generation;
+            configureCurrentThread(nextThreadIndex_.fetch_add(1, std::memory_order_relaxed));
+        }
+    }
+
+    /**
+     * @brief Render threads that have applied the current settings
+     */
+    int getNumConfiguredThreads() const {
+        return nextThreadIndex_.load(std::memory_order_relaxed);
+    }
+
+  private:
+    RenderThreadPolicy() = default;
+
+    // Platform affinity and scheduling calls for the calling thread
+    void configureCurrentThread(int threadIndex);
+
+    std::atomic<int> numThreads_{RenderThreadSettings::kAutomatic};
+    std::atomic<bool> pinToCores_{false};
+    std::atomic<bool> performanceCores_{true};
+    std::atomic<int> nextThreadIndex_{0};
+    std::atomic<uint32_t> generation_{0};  // Threads leave the OS defaults until a change
+};
+
+}  // namespace magda
@@ -0,0 +1,335 @@
+#include "SandboxHost.hpp"
+
+#include <iostream>
+
+namespace magda {
+
+// =============================================================================
+// Worker
+// =============================================================================
+
+class SandboxHost::Worker : public GenerationTaggedWorker<SandboxHost> {
+  public:
+    using GenerationTaggedWorker::GenerationTaggedWorker;
+
+  protected:
+    bool handleOnIpcThread(const juce::MemoryBlock& message) override {
+        juce::MemoryInputStream stream(message, false);
+        if (stream.readString() != SandboxIPC::MSG_STATE) {
+            return false;
+        }
+
+        const auto requestId = stream.readInt64();
+        juce::MemoryBlock state;
+        stream.readIntoMemoryBlock(state);
+        getOwner().handleState(requestId, state);
+        return true;
+    }
+};
+
+// =============================================================================
+// SandboxHost
+// =============================================================================
+
+SandboxHost::SandboxHost(const juce::String& name) : name_(name) {
+    // Installed (and copied into the macOS bundle) beside the app
+    const auto executable = juce::File::getSpecialLocation(juce::File::currentExecutableFile);
+#if JUCE_WINDOWS
+    hostExecutable_ = executable.getSiblingFile("magda_plugin_host.exe");
+#else
+    hostExecutable_ = executable.getSiblingFile("magda_plugin_host");
+#endif
+    slots_.resize(SandboxTransport::kMaxSlots);
+    createRegion();
+}
+
+SandboxHost::~SandboxHost() {
+    validFlag_->store(false);
+    running_.store(false, std::memory_order_release);
+    if (worker_ != nullptr) {
+        juce::MemoryBlock quitMsg;
+        juce::MemoryOutputStream quitStream(quitMsg, false);
+        quitStream.writeString(SandboxIPC::MSG_QUIT);
+        worker_->send(quitMsg);
+        worker_.reset();  // Terminates the process if QUIT didn't
+    }
+    transport_.reset();
+    region_.reset();
+    regionFile_.deleteFile();
+}
+
+bool SandboxHost::createRegion() {
+    // Memory-backed where the system has it, so the pages are never written back to a disk
+    const juce::File shm("/dev/shm");
+    const auto folder = shm.isDirectory()
+                            ? shm
+                            : juce::File::getSpecialLocation(juce::File::tempDirectory);
+    regionFile_ = folder.getNonexistentChildFile(
+        "magda-sandbox-" + juce::String(juce::Time::currentTimeMillis()), ".shm", false);
+
+    juce::MemoryBlock zeros(SandboxTransport::getRegionBytes(), true);
+    if (!regionFile_.replaceWithData(zeros.getData(), zeros.getSize())) {
+        std::cerr << "[Sandbox] Can't create " << regionFile_.getFullPathName() << std::endl;
+        return false;
+    }
+    region_ = std::make_unique<juce::MemoryMappedFile>(regionFile_,
+                                                       juce::MemoryMappedFile::readWrite, false);
+    if (region_->getData() == nullptr || region_->getSize() < zeros.getSize()) {
+        std::cerr << "[Sandbox] Can't map " << regionFile_.getFullPathName() << std::endl;
+        region_.reset();
+        return false;
+    }
+    transport_ = std::make_unique<SandboxTransport>(region_->getData());
+    transport_->initialise();
+    return true;
+}
+
+bool SandboxHost::start() {
+    if (running_.load(std::memory_order_acquire)) {
+        return true;
+    }
+    if (transport_ == nullptr) {
+        return false;
+    }
+    if (!hostExecutable_.existsAsFile()) {
+        std::cerr << "[Sandbox] No plugin host at " << hostExecutable_.getFullPathName()
+                  << std::endl;
+        return false;
+    }
+
+    if (worker_ == nullptr) {
+        worker_ = std::make_unique<Worker>(*this);
+    }
+    // Pings are answered on the host's IPC thread, so a slow plugin load doesn't miss one
+    if (!worker_->launch(hostExecutable_, SandboxIPC::WORKER_ID, nextGeneration_++, 10000)) {
+        std::cerr << "[Sandbox] Failed to launch the plugin host for " << name_ << std::endl;
+        return false;
+    }
+
+    juce::MemoryBlock msg;
+    juce::MemoryOutputStream stream(msg, false);
+    stream.writeString(SandboxIPC::MSG_OPEN);
+    stream.writeString(regionFile_.getFullPathName());
+    worker_->send(msg);
+    prepare(sampleRate_, blockSize_);
+
+    // A relaunch brings back every slot as it last was
+    for (int slot = 0; slot < static_cast<int>(slots_.size()); ++slot) {
+        if (slots_[static_cast<size_t>(slot)].used) {
+            sendLoad(slot);
+        }
+    }
+
+    running_.store(true, std::memory_order_release);
+    std::cout << "[Sandbox] Plugin host started for " << name_ << std::endl;
+    return true;
+}
+
+int SandboxHost::addPlugin(const juce::PluginDescription& description,
+                           const juce::MemoryBlock& state) {
+    int slot = 0;
+    while (slot < static_cast<int>(slots_.size()) && slots_[static_cast<size_t>(slot)].used) {
+        ++slot;
+    }
+    if (slot == static_cast<int>(slots_.size())) {
+        return -1;
+    }
+
+    auto& entry = slots_[static_cast<size_t>(slot)];
+    entry.used = true;
+    entry.description = description;
+    entry.state = state;
+
+    if (running_.load(std::memory_order_acquire)) {
+        sendLoad(slot);
+    } else if (!start()) {  // Sends the load
+        entry = {};
+        return -1;
+    }
+    return slot;
+}
+
+void SandboxHost::removePlugin(int slot) {
+    if (slot < 0 || slot >= static_cast<int>(slots_.size())) {
+        return;
+    }
+    slots_[static_cast<size_t>(slot)] = {};
+    if (running_.load(std::memory_order_acquire)) {
+        juce::MemoryBlock msg;
+        juce::MemoryOutputStream stream(msg, false);
+        stream.writeString(SandboxIPC::MSG_REMOVE);
+        stream.writeInt(slot);
+        worker_->send(msg);
+    }
+}
+
+void SandboxHost::sendLoad(int slot) {
+    const auto& entry = slots_[static_cast<size_t>(slot)];
+    juce::MemoryBlock msg;
+    juce::MemoryOutputStream stream(msg, false);
+    stream.writeString(SandboxIPC::MSG_LOAD);
+    stream.writeInt(slot);
+    if (auto xml = entry.description.createXml()) {
+        stream.writeString(xml->toString());
+    } else {
+        stream.writeString({});
+    }
+    stream.writeInt(static_cast<int>(entry.state.getSize()));
+    stream.write(entry.state.getData(), entry.state.getSize());
+    stream.writeDouble(sampleRate_);
+    stream.writeInt(blockSize_);
+    worker_->send(msg);
+}
+
+void SandboxHost::setState(int slot, const juce::MemoryBlock& state) {
+    if (slot < 0 || slot >= static_cast<int>(slots_.size()) ||
+        !slots_[static_cast<size_t>(slot)].used) {
+        return;
+    }
+    slots_[static_cast<size_t>(slot)].state = state;
+    if (running_.load(std::memory_order_acquire)) {
+        juce::MemoryBlock msg;
+        juce::MemoryOutputStream stream(msg, false);
+        stream.writeString(SandboxIPC::MSG_SET_STATE);
+        stream.writeInt(slot);
+        stream.writeInt(static_cast<int>(state.getSize()));
+        stream.write(state.getData(), state.getSize());
+        worker_->send(msg);
+    }
+}
+
+bool SandboxHost::fetchState(int slot, juce::MemoryBlock& state, int timeoutMs) {
+    if (slot < 0 || slot >= static_cast<int>(slots_.size()) ||
+        !slots_[static_cast<size_t>(slot)].used) {
+        return false;
+    }
+    auto& entry = slots_[static_cast<size_t>(slot)];
+    state = entry.state;
+    if (!running_.load(std::memory_order_acquire)) {
+        return false;
+    }
+
+    juce::int64 requestId = 0;
+    {
+        const std::lock_guard<std::mutex> lock(stateMutex_);
+        requestId = nextStateRequest_++;
+        pendingStateRequest_ = requestId;
+        stateReady_.reset();
+    }
+
+    juce::MemoryBlock msg;
+    juce::MemoryOutputStream stream(msg, false);
+    stream.writeString(SandboxIPC::MSG_GET_STATE);
+    stream.writeInt(slot);
+    stream.writeInt64(requestId);
+    worker_->send(msg);
+
+    const bool answered = stateReady_.wait(timeoutMs);
+    const std::lock_guard<std::mutex> lock(stateMutex_);
+    pendingStateRequest_ = 0;
+    if (!answered) {
+        std::cerr << "[Sandbox] No state from slot " << slot << " of " << name_ << std::endl;
+        return false;
+    }
+    entry.state = fetchedState_;
+    state = entry.state;
+    return true;
+}
+
+void SandboxHost::handleState(juce::int64 requestId, const juce::MemoryBlock& state) {
+    const std::lock_guard<std::mutex> lock(stateMutex_);
+    if (requestId == pendingStateRequest_) {
+        fetchedState_ = state;
+        stateReady_.signal();
+    }
+}
+
+void SandboxHost::prepare(double sampleRate, int blockSize) {
+    sampleRate_ = sampleRate;
+    blockSize_ = juce::jlimit(1, SandboxTransport::kMaxFrames, blockSize);
+    if (worker_ != nullptr && worker_->getGeneration() >= 0) {
+        juce::MemoryBlock msg;
+        juce::MemoryOutputStream stream(msg, false);
+        stream.writeString(SandboxIPC::MSG_PREPARE);
+        stream.writeDouble(sampleRate_);
+        stream.writeInt(blockSize_);
+        worker_->send(msg);
+    }
+}
+
+int SandboxHost::getLatencySamples(int slot) const {
+    return slot >= 0 && slot < static_cast<int>(slots_.size())
+               ? slots_[static_cast<size_t>(slot)].latencySamples
+               : 0;
+}
+
+double SandboxHost::getTailSeconds(int slot) const {
+    return slot >= 0 && slot < static_cast<int>(slots_.size())
+               ? slots_[static_cast<size_t>(slot)].tailSeconds
+               : 0.0;
+}
+
+// =============================================================================
+// Worker events
+// =============================================================================
+
+void SandboxHost::handleWorkerMessage(int /*workerIndex*/, int generation,
+                                      const juce::MemoryBlock& message) {
+    if (worker_ == nullptr || worker_->getGeneration() != generation) {
+        return;  // From a process that has since been killed or replaced
+    }
+
+    juce::MemoryInputStream stream(message, false);
+    const juce::String msgType = stream.readString();
+
+    if (msgType == SandboxIPC::MSG_LOADED) {
+        const int slot = stream.readInt();
+        const bool ok = stream.readBool();
+        const int latency = stream.readInt();
+        const double tail = stream.readDouble();
+        const auto error = stream.readString();
+        if (slot < 0 || slot >= static_cast<int>(slots_.size()) ||
+            !slots_[static_cast<size_t>(slot)].used) {
+            return;  // Removed while it loaded
+        }
+        auto& entry = slots_[static_cast<size_t>(slot)];
+        entry.latencySamples = ok ? latency : 0;
+        entry.tailSeconds = ok ? tail : 0.0;
+        if (!ok) {
+            std::cerr << "[Sandbox] " << error << std::endl;
+        }
+        if (onPluginLoaded) {
+            onPluginLoaded(slot, ok ? juce::String() : error);
+        }
+    }
+}
+
+void SandboxHost::handleWorkerLost(int /*workerIndex*/, int generation) {
+    if (worker_ == nullptr || worker_->getGeneration() != generation) {
+        return;  // Already handled or replaced
+    }
+
+    std::cout << "[Sandbox] Plugin host for " << name_ << " lost" << std::endl;
+    running_.store(false, std::memory_order_release);
+    worker_->kill();
+    if (onCrashed) {
+        onCrashed();
+    }
+
+    if (++relaunches_ <= MAX_RELAUNCHES) {
+        relaunchLater();
+    }
+}
+
+void SandboxHost::relaunchLater() {
+    auto validFlag = validFlag_;
+
+    // Give the crashed process time to fully terminate
+    juce::Timer::callAfterDelay(RECOVERY_DELAY_MS, [this, validFlag]() {
+        if (validFlag->load() && !running_.load(std::memory_order_acquire)) {
+            start();
+        }
+    });
+}
+
+}  // namespace magda
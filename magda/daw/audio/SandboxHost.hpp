@@ -0,0 +1,191 @@
+#pragma once
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <juce_events/juce_events.h>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "../engine/GenerationTaggedWorker.hpp"
+#include "SandboxTransport.hpp"
+
+namespace magda {
+
+/**
+ * @brief IPC message types between a SandboxHost and its magda_plugin_host process
+ *
+ * Only control goes this way; audio and MIDI go through the shared SandboxTransport.
+ */
+namespace SandboxIPC {
+constexpr const char* WORKER_ID = "magda-plugin-host";
+constexpr const char* MSG_OPEN = "OPEN";       // Region file
+constexpr const char* MSG_LOAD = "LOAD";       // Slot, description XML, state, rate, block size
+constexpr const char* MSG_LOADED = "LODD";     // Slot, ok, latency samples, tail, error
+constexpr const char* MSG_PREPARE = "PREP";    // Rate, block size
+constexpr const char* MSG_REMOVE = "REMV";     // Slot
+constexpr const char* MSG_SET_STATE = "SETS";  // Slot, state
+constexpr const char* MSG_GET_STATE = "GETS";  // Slot, request id
+constexpr const char* MSG_STATE = "STAT";      // Request id, state
+constexpr const char* MSG_QUIT = "QUIT";
+}  // namespace SandboxIPC
+
+/**
+ * @brief One magda_plugin_host process and the plugins loaded in it
+ *
+ * Plugins in the sandbox run in this child process, so one that crashes or hangs takes
+ * down only its host. The host's plugins are numbered slots; SandboxedPlugin proxies them
+ * in the Edit and exchanges each block with the host through a SandboxTransport over a
+ * file both processes map (in /dev/shm where there is one, so it never touches a disk).
+ *
+ * AudioBridge keeps one host per track, so a track's sandboxed devices, which render one
+ * after another, can share a round trip, and tracks that render in parallel never wait
+ * on each other's host. If the process dies it is relaunched after a moment with each
+ * slot's plugin and last known state; the proxies pass audio through meanwhile.
+ *
+ * Threading: everything on the message thread, apart from getTransport(), isRunning()
+ * and tryAcquire()/release(), for the audio thread.
+ */
+class SandboxHost {
+  public:
+    explicit SandboxHost(const juce::String& name);
+    ~SandboxHost();
+
+    /**
+     * @brief The magda_plugin_host to launch (default: beside the running executable)
+     */
+    void setHostExecutable(const juce::File& executable) {
+        hostExecutable_ = executable;
+    }
+
+    /**
+     * @brief Launch the process, if it isn't running (addPlugin() does this too)
+     * @return false if it couldn't be launched
+     */
+    bool start();
+
+    /**
+     * @brief The process is up and has the region mapped
+     */
+    bool isRunning() const {
+        return running_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief The block exchange, or nullptr if the region couldn't be mapped
+     */
+    SandboxTransport* getTransport() const {
+        return transport_.get();
+    }
+
+    /**
+     * @brief Load a plugin into a free slot; it loads in the background
+     * @return The slot, or -1 if the host is full or can't be launched
+     */
+    int addPlugin(const juce::PluginDescription& description, const juce::MemoryBlock& state);
+
+    /**
+     * @brief Unload a slot's plugin and free the slot
+     */
+    void removePlugin(int slot);
+
+    /**
+     * @brief Restore a slot's plugin to a saved state
+     */
+    void setState(int slot, const juce::MemoryBlock& state);
+
+    /**
+     * @brief Ask a slot's plugin for its state, waiting up to timeoutMs for the answer
+     * @return false if the host didn't answer; state is then the last one known
+     */
+    bool fetchState(int slot, juce::MemoryBlock& state, int timeoutMs = STATE_TIMEOUT_MS);
+
+    /**
+     * @brief Prepare every plugin for a rate and block size (and those loaded later)
+     */
+    void prepare(double sampleRate, int blockSize);
+
+    /**
+     * @brief The latency and tail a slot's plugin reported when it loaded
+     */
+    int getLatencySamples(int slot) const;
+    double getTailSeconds(int slot) const;
+
+    /**
+     * @brief Take the transport for one round trip; false if another thread has it
+     */
+    bool tryAcquire() {
+        return !inUse_.test_and_set(std::memory_order_acquire);
+    }
+    void release() {
+        inUse_.clear(std::memory_order_release);
+    }
+
+    // Called on the message thread: a slot's plugin loaded (error empty) or failed to
+    std::function<void(int slot, const juce::String& error)> onPluginLoaded;
+
+    // Called on the message thread when the process dies; it is relaunched after this
+    std::function<void()> onCrashed;
+
+    static constexpr int STATE_TIMEOUT_MS = 2000;
+
+  private:
+    struct Slot {
+        bool used = false;
+        juce::PluginDescription description;
+        juce::MemoryBlock state;  // Last known, for a relaunch
+        int latencySamples = 0;
+        double tailSeconds = 0.0;
+    };
+
+    /**
+     * @brief The magda_plugin_host child process
+     *
+     * State replies are taken on the IPC thread, as fetchState() holds the message thread.
+     */
+    class Worker;
+    friend class GenerationTaggedWorker<SandboxHost>;
+
+    // Worker events (message thread)
+    void handleWorkerMessage(int workerIndex, int generation, const juce::MemoryBlock& message);
+    void handleWorkerLost(int workerIndex, int generation);
+    void handleState(juce::int64 requestId, const juce::MemoryBlock& state);  // IPC thread
+
+    bool createRegion();
+    void sendLoad(int slot);
+    void relaunchLater();
+
+    const juce::String name_;
+    juce::File hostExecutable_;
+    juce::File regionFile_;
+    std::unique_ptr<juce::MemoryMappedFile> region_;
+    std::unique_ptr<SandboxTransport> transport_;
+    std::unique_ptr<Worker> worker_;
+    int nextGeneration_ = 0;
+    std::atomic<bool> running_{false};
+    int relaunches_ = 0;
+
+    std::vector<Slot> slots_;
+    double sampleRate_ = 44100.0;
+    int blockSize_ = 512;
+    std::atomic_flag inUse_ = ATOMIC_FLAG_INIT;
+
+    // fetchState() in flight
+    std::mutex stateMutex_;
+    juce::int64 nextStateRequest_ = 1;
+    juce::int64 pendingStateRequest_ = 0;
+    juce::MemoryBlock fetchedState_;
+    juce::WaitableEvent stateReady_;
+
+    static constexpr int MAX_RELAUNCHES = 3;  // Then its plugins stay dry
+    static constexpr int RECOVERY_DELAY_MS = 1000;
+
+    // Validity flag for async callbacks - set to false in destructor
+    std::shared_ptr<std::atomic<bool>> validFlag_ = std::make_shared<std::atomic<bool>>(true);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SandboxHost)
+};
+
+}  // namespace magda
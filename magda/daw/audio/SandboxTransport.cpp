@@ -0,0 +1,187 @@
+#include "SandboxTransport.hpp"
+
+#include <algorithm>
+#include <new>
+#include <thread>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <climits>
+#include <ctime>
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+
+namespace magda {
+
+namespace {
+
+constexpr size_t kAlignment = 64;
+
+constexpr size_t alignUp(size_t bytes) {
+    return (bytes + kAlignment - 1) / kAlignment * kAlignment;
+}
+
+constexpr size_t kHeaderBytes = alignUp(sizeof(SandboxTransport::Header));
+constexpr size_t kChannelBytes = alignUp(sizeof(float) * SandboxTransport::kMaxFrames);
+constexpr size_t kMidiBytes =
+    alignUp(sizeof(SandboxTransport::MidiEvent) * SandboxTransport::kMaxMidiEvents);
+
+constexpr size_t kChannelsOffset = kHeaderBytes;
+constexpr size_t kMidiInOffset = kChannelsOffset + kChannelBytes * SandboxTransport::kMaxChannels;
+constexpr size_t kMidiOutOffset = kMidiInOffset + kMidiBytes;
+constexpr size_t kRegionBytes = kMidiOutOffset + kMidiBytes;
+
+// Before giving the core away: a round trip usually answers within this
+constexpr int kSpinIterations = 2000;
+
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(_M_X64)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+#if defined(__linux__)
+// Not FUTEX_PRIVATE_FLAG: the other side is another process
+void futexWait(const std::atomic<uint32_t>& word, uint32_t value,
+               std::chrono::nanoseconds timeout) {
+    const auto ns = timeout.count();
+    timespec ts{static_cast<time_t>(ns / 1000000000), static_cast<long>(ns % 1000000000)};
+    syscall(SYS_futex, reinterpret_cast<const uint32_t*>(&word), FUTEX_WAIT, value, &ts,
+            nullptr, 0);
+}
+#endif
+
+}  // namespace
+
+size_t SandboxTransport::getRegionBytes() {
+    return kRegionBytes;
+}
+
+void SandboxTransport::initialise() {
+    auto* header = new (region_) Header();
+    header->magic = kMagic;
+    header->version = kVersion;
+}
+
+bool SandboxTransport::isValid() const {
+    return header().magic == kMagic && header().version == kVersion;
+}
+
+float* SandboxTransport::getChannel(int channel) const {
+    return reinterpret_cast<float*>(region_ + kChannelsOffset +
+                                    kChannelBytes * static_cast<size_t>(channel));
+}
+
+SandboxTransport::MidiEvent* SandboxTransport::getMidiIn() const {
+    return reinterpret_cast<MidiEvent*>(region_ + kMidiInOffset);
+}
+
+SandboxTransport::MidiEvent* SandboxTransport::getMidiOut() const {
+    return reinterpret_cast<MidiEvent*>(region_ + kMidiOutOffset);
+}
+
+// =============================================================================
+// DAW side
+// =============================================================================
+
+uint32_t SandboxTransport::post() {
+    auto& h = header();
+    const auto sequence = h.request.load(std::memory_order_relaxed) + 1;
+    h.request.store(sequence, std::memory_order_release);
+    wake(h.request);
+    return sequence;
+}
+
+bool SandboxTransport::waitForReply(uint32_t sequence, std::chrono::nanoseconds timeout) const {
+    const auto& reply = header().reply;
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    for (;;) {
+        const auto seen = reply.load(std::memory_order_acquire);
+        if (seen == sequence) {
+            return true;
+        }
+        const auto remaining = deadline - std::chrono::steady_clock::now();
+        if (remaining <= std::chrono::nanoseconds::zero()) {
+            return false;
+        }
+        waitWhileEqual(reply, seen, remaining, false);
+    }
+}
+
+bool SandboxTransport::isIdle() const {
+    const auto& h = header();
+    return h.reply.load(std::memory_order_acquire) == h.request.load(std::memory_order_relaxed);
+}
+
+// =============================================================================
+// Host side
+// =============================================================================
+
+bool SandboxTransport::waitForRequest(uint32_t& lastSeen, std::chrono::nanoseconds timeout) const {
+    const auto& request = header().request;
+    if (!waitWhileEqual(request, lastSeen, timeout, true)) {
+        return false;
+    }
+    lastSeen = request.load(std::memory_order_acquire);
+    return true;
+}
+
+void SandboxTransport::reply(uint32_t sequence) {
+    auto& h = header();
+    h.reply.store(sequence, std::memory_order_release);
+    wake(h.reply);
+}
+
+// =============================================================================
+// Waiting
+// =============================================================================
+
+bool SandboxTransport::waitWhileEqual(const std::atomic<uint32_t>& word, uint32_t value,
+                                      std::chrono::nanoseconds timeout, bool idleBackoff) {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    for (int i = 0; i < (idleBackoff ? kSpinIterations / 10 : kSpinIterations); ++i) {
+        if (word.load(std::memory_order_acquire) != value) {
+            return true;
+        }
+        cpuRelax();
+    }
+
+    for (;;) {
+        if (word.load(std::memory_order_acquire) != value) {
+            return true;
+        }
+        const auto remaining = deadline - std::chrono::steady_clock::now();
+        if (remaining <= std::chrono::nanoseconds::zero()) {
+            return false;
+        }
+#if defined(__linux__)
+        futexWait(word, value, remaining);
+#else
+        if (idleBackoff) {
+            std::this_thread::sleep_for(std::min<std::chrono::nanoseconds>(
+                remaining, std::chrono::microseconds(500)));
+        } else {
+            std::this_thread::yield();
+        }
+#endif
+    }
+}
+
+void SandboxTransport::wake(std::atomic<uint32_t>& word) {
+#if defined(__linux__)
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE, INT_MAX, nullptr,
+            nullptr, 0);
+#else
+    (void)word;  // Waiters poll
+#endif
+}
+
+}  // namespace magda
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace magda {
+
+/**
+ * @brief The block exchange shared by sandboxed plugins and the process hosting them
+ *
+ * One region of memory, mapped by both processes: a header, then the audio channels, then
+ * the MIDI going in and coming out. For each block the DAW writes the audio and MIDI in
+ * place, lists the host's plugins to run (several at once when they sit next to each
+ * other on a track, so they cost one round trip between them) and bumps the request
+ * sequence. The host runs the plugins directly on the shared channels, writes the MIDI
+ * they produce and bumps the reply sequence to match. Nothing is serialised or copied on
+ * the way through the host.
+ *
+ * The sequences are also what each side waits on: a futex on Linux, which both processes
+ * can wait on and wake because the word is in shared memory. Elsewhere the waiter spins,
+ * then yields, until its deadline: the DAW only waits a fraction of a block, and the host
+ * backs off to short sleeps once it has been idle a while.
+ *
+ * The class holds only a pointer to the region; mapping it is up to the caller (it is a
+ * file both processes map, see SandboxHost).
+ *
+ * Threading: one writer each side. The DAW side (post(), waitForReply()) from the one
+ * render thread using the host at a time; the host side (waitForRequest(), reply()) from
+ * the host's render thread.
+ */
+class SandboxTransport {
+  public:
+    static constexpr uint32_t kMagic = 0x4d534258;  // "MSBX"
+    static constexpr uint32_t kVersion = 1;
+    static constexpr int kMaxChannels = 8;
+    static constexpr int kMaxFrames = 8192;      // Longer blocks aren't sent
+    static constexpr int kMaxMidiEvents = 1024;  // Per direction, per block
+    static constexpr int kMaxSlots = 16;         // Plugins in one host
+
+    /**
+     * @brief A short MIDI message at a frame of the block (SysEx isn't carried)
+     */
+    struct MidiEvent {
+        int32_t frame = 0;
+        uint8_t size = 0;
+        uint8_t data[3] = {};
+    };
+
+    struct Header {
+        uint32_t magic;
+        uint32_t version;
+        std::atomic<uint32_t> request;  // Bumped by the DAW once a block is written
+        std::atomic<uint32_t> reply;    // Set to the request by the host once it's done
+
+        // The block, written before request
+        int32_t numFrames;
+        int32_t numChannels;
+        int32_t numMidiIn;
+        int32_t numSlots;
+        int32_t slots[kMaxSlots];  // Host plugins to run, in order
+        int64_t position;          // Timeline position of the block, in samples
+        uint32_t playing;
+
+        // Written by the host before reply
+        int32_t numMidiOut;
+        int64_t hostBusyNs;  // Time the plugins took, to tell it apart from the transport
+    };
+
+    static_assert(std::atomic<uint32_t>::is_always_lock_free,
+                  "The sequences are shared between processes and so must be lock-free");
+
+    /**
+     * @brief Bytes to map for a region
+     */
+    static size_t getRegionBytes();
+
+    /**
+     * @param region At least getRegionBytes(), suitably aligned (a mapping is)
+     */
+    explicit SandboxTransport(void* region) : region_(static_cast<char*>(region)) {}
+
+    /**
+     * @brief Lay out a new region (the DAW, before the host opens it)
+     */
+    void initialise();
+
+    /**
+     * @brief The region was laid out by initialise() of this version
+     */
+    bool isValid() const;
+
+    Header& header() const {
+        return *reinterpret_cast<Header*>(region_);
+    }
+    float* getChannel(int channel) const;
+    MidiEvent* getMidiIn() const;
+    MidiEvent* getMidiOut() const;
+
+    // =========================================================================
+    // DAW side
+    // =========================================================================
+
+    /**
+     * @brief Hand the written block to the host
+     * @return The request's sequence, to wait for
+     */
+    uint32_t post();
+
+    /**
+     * @brief Wait until the host has answered the request, or the timeout
+     */
+    bool waitForReply(uint32_t sequence, std::chrono::nanoseconds timeout) const;
+
+    /**
+     * @brief The host has answered every request posted
+     */
+    bool isIdle() const;
+
+    // =========================================================================
+    // Host side
+    // =========================================================================
+
+    /**
+     * @brief Wait for a request after the one last answered, or the timeout
+     * @param lastSeen The sequence last answered, updated to the new one
+     */
+    bool waitForRequest(uint32_t& lastSeen, std::chrono::nanoseconds timeout) const;
+
+    /**
+     * @brief Tell the DAW the request has been run
+     */
+    void reply(uint32_t sequence);
+
+    /**
+     * @brief Wait until word no longer holds value, or the timeout
+     * @param idleBackoff Spin only briefly then sleep, for waits that are usually long
+     */
+    static bool waitWhileEqual(const std::atomic<uint32_t>& word, uint32_t value,
+                               std::chrono::nanoseconds timeout, bool idleBackoff);
+
+    /**
+     * @brief Wake whatever waits on word (in either process)
+     */
+    static void wake(std::atomic<uint32_t>& word);
+
+  private:
+    char* region_;
+};
+
+}  // namespace magda
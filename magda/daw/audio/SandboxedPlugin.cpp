@@ -0,0 +1,232 @@
+#include "SandboxedPlugin.hpp"
+
+#include <cstring>
+
+#include "../profiling/RealtimeSafety.hpp"
+
+namespace magda {
+
+namespace {
+
+const juce::Identifier kDescriptionId("sandboxedDescription");
+
+}  // namespace
+
+const char* SandboxedPlugin::xmlTypeName = "magdasandboxed";
+
+SandboxedPlugin::SandboxedPlugin(const te::PluginCreationInfo& info) : Plugin(info) {
+    if (auto xml = juce::parseXML(state.getProperty(kDescriptionId).toString())) {
+        description_.loadFromXml(*xml);
+    }
+    batch_.publish(std::make_unique<Batch>());
+}
+
+SandboxedPlugin::~SandboxedPlugin() {
+    notifyListenersOfDeletion();
+    if (host_ != nullptr) {
+        host_->removePlugin(slot_);
+    }
+}
+
+juce::ValueTree SandboxedPlugin::create(const juce::PluginDescription& description) {
+    juce::ValueTree v(te::IDs::PLUGIN);
+    v.setProperty(te::IDs::type, xmlTypeName, nullptr);
+    if (auto xml = description.createXml()) {
+        v.setProperty(kDescriptionId, xml->toString(), nullptr);
+    }
+    return v;
+}
+
+juce::String SandboxedPlugin::getName() const {
+    return description_.name.isNotEmpty() ? description_.name : juce::String(getPluginName());
+}
+
+bool SandboxedPlugin::setHost(std::shared_ptr<SandboxHost> host) {
+    if (host_ != nullptr) {
+        host_->removePlugin(slot_);
+        host_.reset();
+        slot_ = -1;
+    }
+    if (host == nullptr) {
+        return false;
+    }
+
+    juce::MemoryBlock saved;
+    saved.fromBase64Encoding(state.getProperty(te::IDs::state).toString());
+    slot_ = host->addPlugin(description_, saved);
+    if (slot_ < 0) {
+        return false;
+    }
+    host_ = std::move(host);
+    setBatch({});
+    return true;
+}
+
+void SandboxedPlugin::setBatch(const std::vector<int>& followerSlots) {
+    auto batch = std::make_unique<Batch>();
+    if (slot_ >= 0) {
+        batch->slots[batch->numSlots++] = slot_;
+    }
+    for (auto slot : followerSlots) {
+        if (batch->numSlots < SandboxTransport::kMaxSlots) {
+            batch->slots[batch->numSlots++] = slot;
+        }
+    }
+    batch_.publish(std::move(batch));
+}
+
+void SandboxedPlugin::initialise(const te::PluginInitialisationInfo& info) {
+    sampleRate_ = info.sampleRate > 0.0 ? info.sampleRate : 44100.0;
+    if (host_ == nullptr) {
+        return;
+    }
+    auto host = host_;
+    const double sampleRate = sampleRate_;
+    const int blockSize = info.blockSizeSamples;
+    juce::MessageManager::callAsync([host, sampleRate, blockSize]() {
+        host->prepare(sampleRate, blockSize);
+    });
+}
+
+double SandboxedPlugin::getLatencySeconds() {
+    return host_ != nullptr ? host_->getLatencySamples(slot_) / sampleRate_ : 0.0;
+}
+
+double SandboxedPlugin::getTailLength() const {
+    return host_ != nullptr ? host_->getTailSeconds(slot_) : 0.0;
+}
+
+// =============================================================================
+// State
+// =============================================================================
+
+void SandboxedPlugin::flushPluginStateToValueTree() {
+    Plugin::flushPluginStateToValueTree();
+    juce::MemoryBlock saved;
+    if (host_ != nullptr && host_->fetchState(slot_, saved)) {
+        state.setProperty(te::IDs::state, saved.toBase64Encoding(), nullptr);
+    }
+}
+
+void SandboxedPlugin::restorePluginStateFromValueTree(const juce::ValueTree& v) {
+    if (!v.hasProperty(te::IDs::state)) {
+        return;
+    }
+    const auto encoded = v.getProperty(te::IDs::state).toString();
+    state.setProperty(te::IDs::state, encoded, nullptr);
+
+    juce::MemoryBlock saved;
+    if (host_ != nullptr && saved.fromBase64Encoding(encoded)) {
+        host_->setState(slot_, saved);
+    }
+}
+
+// =============================================================================
+// Rendering
+// =============================================================================
+
+void SandboxedPlugin::missBlock(const te::PluginRenderContext& fc) {
+    stats_.missed.fetch_add(1, std::memory_order_relaxed);
+    if (description_.isInstrument) {
+        fc.destBuffer->clear(fc.bufferStartSample, fc.bufferNumSamples);
+    }
+}
+
+void SandboxedPlugin::applyToBuffer(const te::PluginRenderContext& fc) {
+    ScopedRealtimeContext realtime;
+    if (fc.destBuffer == nullptr || fc.bufferNumSamples <= 0 ||
+        follower_.load(std::memory_order_acquire)) {
+        return;
+    }
+    stats_.blocks.fetch_add(1, std::memory_order_relaxed);
+
+    auto* transport = host_ != nullptr ? host_->getTransport() : nullptr;
+    if (transport == nullptr || !host_->isRunning() ||
+        fc.bufferNumSamples > SandboxTransport::kMaxFrames || !host_->tryAcquire()) {
+        missBlock(fc);
+        return;
+    }
+
+    // Still on a block it missed the deadline for: the region is the host's until it's done
+    if (!transport->isIdle()) {
+        host_->release();
+        missBlock(fc);
+        return;
+    }
+    auto& h = transport->header();
+
+    const int numFrames = fc.bufferNumSamples;
+    const int numChannels = juce::jmin(fc.destBuffer->getNumChannels(),
+                                       SandboxTransport::kMaxChannels);
+    for (int ch = 0; ch < numChannels; ++ch) {
+        std::memcpy(transport->getChannel(ch),
+                    fc.destBuffer->getReadPointer(ch, fc.bufferStartSample),
+                    sizeof(float) * static_cast<size_t>(numFrames));
+    }
+
+    int numMidi = 0;
+    if (fc.bufferForMidiMessages != nullptr) {
+        auto* midiIn = transport->getMidiIn();
+        for (const auto& message : *fc.bufferForMidiMessages) {
+            const int size = message.getRawDataSize();
+            if (size > 3 || numMidi == SandboxTransport::kMaxMidiEvents) {
+                continue;  // SysEx isn't carried
+            }
+            auto& event = midiIn[numMidi++];
+            event.frame = juce::jlimit(0, numFrames - 1,
+                                       juce::roundToInt(message.getTimeStamp() * sampleRate_));
+            event.size = static_cast<uint8_t>(size);
+            std::memcpy(event.data, message.getRawData(), static_cast<size_t>(size));
+        }
+    }
+
+    h.numFrames = numFrames;
+    h.numChannels = numChannels;
+    h.numMidiIn = numMidi;
+    h.numMidiOut = 0;
+    h.hostBusyNs = 0;
+    h.position = te::toSamples(fc.editTime.getStart(), sampleRate_);
+    h.playing = fc.isPlaying ? 1 : 0;
+    {
+        auto* batch = batch_.acquire();
+        h.numSlots = batch != nullptr ? batch->numSlots : 0;
+        for (int i = 0; i < h.numSlots; ++i) {
+            h.slots[i] = batch->slots[i];
+        }
+        batch_.release();
+    }
+
+    // Waiting longer than the block lasts would make the device itself late
+    const auto start = std::chrono::steady_clock::now();
+    const auto sequence = transport->post();
+    const auto deadline = std::chrono::nanoseconds(
+        static_cast<int64_t>(1.0e9 * numFrames / sampleRate_));
+    if (!transport->waitForReply(sequence, deadline)) {
+        host_->release();
+        missBlock(fc);
+        return;
+    }
+    const auto waitedNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              std::chrono::steady_clock::now() - start)
+                              .count();
+    stats_.roundTripNs.fetch_add(juce::jmax<int64_t>(0, waitedNs - h.hostBusyNs),
+                                 std::memory_order_relaxed);
+
+    for (int ch = 0; ch < numChannels; ++ch) {
+        std::memcpy(fc.destBuffer->getWritePointer(ch, fc.bufferStartSample),
+                    transport->getChannel(ch), sizeof(float) * static_cast<size_t>(numFrames));
+    }
+    if (fc.bufferForMidiMessages != nullptr) {
+        fc.bufferForMidiMessages->clear();
+        const auto* midiOut = transport->getMidiOut();
+        for (int i = 0; i < juce::jmin(h.numMidiOut, SandboxTransport::kMaxMidiEvents); ++i) {
+            const auto& event = midiOut[i];
+            fc.bufferForMidiMessages->addMidiMessage(
+                juce::MidiMessage(event.data, event.size), event.frame / sampleRate_,
+                midiSourceId_);
+        }
+    }
+    host_->release();
+}
+
+}  // namespace magda
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <tracktion_engine/tracktion_engine.h>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "RealtimeSnapshot.hpp"
+#include "SandboxHost.hpp"
+
+namespace magda {
+
+namespace te = tracktion;
+
+/**
+ * @brief Stands in the Edit for an external plugin running in a SandboxHost process
+ *
+ * Each block is written into the host's shared region, run there and read back, waiting
+ * at most the block's own length. A host that misses the deadline, isn't running yet or
+ * has crashed leaves the block dry (silent for an instrument) instead of holding up the
+ * audio thread, as are the blocks after a missed one until the host catches up.
+ * AudioBridge batches a run of consecutive sandboxed devices on a track: the first sends
+ * the whole run in one round trip and the rest pass their blocks straight through.
+ *
+ * The plugin's state is kept in the same property an ExternalPlugin keeps it in, so a
+ * device can move into and out of the sandbox, and projects load either way. Its
+ * parameters and editor stay in the host process and aren't reachable from the DAW.
+ *
+ * Threading: setHost() and setBatch() on the message thread; applyToBuffer() on the
+ * audio thread.
+ */
+class SandboxedPlugin : public te::Plugin {
+  public:
+    explicit SandboxedPlugin(const te::PluginCreationInfo& info);
+    ~SandboxedPlugin() override;
+
+    static const char* getPluginName() {
+        return "Sandboxed Plugin";
+    }
+    static const char* xmlTypeName;
+
+    /**
+     * @brief Create the ValueTree for a new instance hosting the described plugin
+     */
+    static juce::ValueTree create(const juce::PluginDescription& description);
+
+    /**
+     * @brief Load the plugin into a host process (with any state the tree already has)
+     * @return false if the host had no room or couldn't be launched
+     */
+    bool setHost(std::shared_ptr<SandboxHost> host);
+    SandboxHost* getHost() const {
+        return host_.get();
+    }
+    int getSlot() const {
+        return slot_;
+    }
+
+    /**
+     * @brief Send these host slots after this plugin's own, in the same round trip
+     *        (followers are passed through; an empty list sends only this plugin)
+     */
+    void setBatch(const std::vector<int>& followerSlots);
+
+    /**
+     * @brief Let this plugin's blocks through untouched: a leader runs it
+     */
+    void setFollower(bool follower) {
+        follower_.store(follower, std::memory_order_release);
+    }
+
+    /**
+     * @brief Blocks sent and those the host missed the deadline for (or that went dry)
+     */
+    struct Stats {
+        std::atomic<int64_t> blocks{0};
+        std::atomic<int64_t> missed{0};
+        std::atomic<int64_t> roundTripNs{0};  // Total waited beyond the plugins' own time
+    };
+    const Stats& getStats() const {
+        return stats_;
+    }
+
+    juce::String getName() const override;
+    juce::String getPluginType() override {
+        return xmlTypeName;
+    }
+    juce::String getShortName(int) override {
+        return getName();
+    }
+    juce::String getSelectableDescription() override {
+        return getName();
+    }
+
+    void initialise(const te::PluginInitialisationInfo&) override;
+    void deinitialise() override {}
+    void applyToBuffer(const te::PluginRenderContext&) override;
+
+    bool takesMidiInput() override {
+        return true;
+    }
+    bool takesAudioInput() override {
+        return true;
+    }
+    bool isSynth() override {
+        return description_.isInstrument;
+    }
+    bool producesAudioWhenNoAudioInput() override {
+        return description_.isInstrument;
+    }
+    double getLatencySeconds() override;
+    double getTailLength() const override;
+
+    void flushPluginStateToValueTree() override;
+    void restorePluginStateFromValueTree(const juce::ValueTree&) override;
+
+  private:
+    struct Batch {
+        int numSlots = 0;
+        int slots[SandboxTransport::kMaxSlots] = {};
+    };
+
+    // Leave the block as the host would have had it: dry, or silent for an instrument
+    void missBlock(const te::PluginRenderContext& fc);
+
+    juce::PluginDescription description_;
+    std::shared_ptr<SandboxHost> host_;
+    int slot_ = -1;
+    RealtimeSnapshot<Batch> batch_;
+    std::atomic<bool> follower_{false};
+
+    double sampleRate_ = 44100.0;
+    te::MPESourceID midiSourceId_ = te::createUniqueMPESourceID();
+    Stats stats_;
+};
+
+}  // namespace magda
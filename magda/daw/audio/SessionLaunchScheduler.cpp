@@ -0,0 +1,188 @@
+#include "SessionLaunchScheduler.hpp"
+
+namespace magda {
+
+bool SessionLaunchScheduler::push(const std::vector<ClipLaunchRequest>& requests) {
+    const size_t write = writePos_.load(std::memory_order_relaxed);
+    const size_t read = readPos_.load(std::memory_order_acquire);
+    if (requests.size() > kQueueSize - (write - read)) {
+        droppedCount_.fetch_add(requests.size(), std::memory_order_relaxed);
+        return false;
+    }
+
+    for (size_t i = 0; i < requests.size(); ++i) {
+        ring_[(write + i) & (kQueueSize - 1)] = requests[i];
+    }
+    // One store publishes the whole batch, so the audio thread takes it in one block
+    writePos_.store(write + requests.size(), std::memory_order_release);
+    return true;
+}
+
+void SessionLaunchScheduler::takeNewRequests(const Block& block) {
+    size_t read = readPos_.load(std::memory_order_relaxed);
+    const size_t write = writePos_.load(std::memory_order_acquire);
+    for (; read != write; ++read) {
+        const auto& request = ring_[read & (kQueueSize - 1)];
+        if (request.isFollowUp()) {
+            addFollowUp(request);
+        } else {
+            addPending(request,
+                       block.playing ? resolve(block.startBeat, request) : block.startBeat);
+        }
+    }
+    readPos_.store(read, std::memory_order_release);
+}
+
+void SessionLaunchScheduler::addPending(const ClipLaunchRequest& request, double targetBeat) {
+    using Action = ClipLaunchRequest::Action;
+
+    // Anything waiting for the same clip, another launch waiting on the same track, and
+    // follow-ups timed from this clip's last launch
+    for (size_t i = numPending_; i-- > 0;) {
+        const auto& waiting = pending_[i].request;
+        if (waiting.clipId == request.clipId || waiting.afterClipId == request.clipId ||
+            (request.action == Action::Launch && waiting.action == Action::Launch &&
+             waiting.trackId == request.trackId)) {
+            removePending(i);
+        }
+    }
+
+    // Follow-ups still waiting for a launch that's just been called off
+    for (size_t i = numPending_; i-- > 0;) {
+        const auto& waiting = pending_[i];
+        if (!waiting.resolved && !isLaunchPending(waiting.request.afterClipId)) {
+            removePending(i);
+        }
+    }
+
+    if (numPending_ == kMaxPending) {
+        droppedCount_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    pending_[numPending_++] = {request, targetBeat, true};
+}
+
+void SessionLaunchScheduler::addFollowUp(const ClipLaunchRequest& request) {
+    Pending pending{request, 0.0, false};
+    if (const auto* launched = findLaunched(request.afterClipId)) {
+        pending.targetBeat = launched->beat + request.afterBeats;
+        pending.resolved = true;
+    } else if (!isLaunchPending(request.afterClipId)) {
+        return;  // Its clip stopped or was replaced before this arrived
+    }
+
+    // One follow-up per track, the latest
+    for (size_t i = numPending_; i-- > 0;) {
+        const auto& waiting = pending_[i].request;
+        if (waiting.isFollowUp() && waiting.trackId == request.trackId) {
+            removePending(i);
+        }
+    }
+
+    if (numPending_ == kMaxPending) {
+        droppedCount_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    pending_[numPending_++] = pending;
+}
+
+void SessionLaunchScheduler::removePending(size_t index) {
+    // Shifted down rather than swapped, so requests keep the order they arrived in
+    for (size_t i = index + 1; i < numPending_; ++i) {
+        pending_[i - 1] = pending_[i];
+    }
+    --numPending_;
+}
+
+void SessionLaunchScheduler::retime(double startBeat, bool jumped) {
+    // Waiting launches go to the grid from the new position. Follow-ups keep the playing
+    // time they have left after a jump, and count it again from the start after a stop
+    const double shift = startBeat - lastEndBeat_;
+    for (size_t i = 0; i < numLaunched_; ++i) {
+        launched_[i].beat = jumped ? launched_[i].beat + shift : startBeat;
+    }
+    for (size_t i = 0; i < numPending_; ++i) {
+        auto& pending = pending_[i];
+        if (!pending.request.isFollowUp()) {
+            pending.targetBeat = resolve(startBeat, pending.request);
+        } else if (pending.resolved) {
+            pending.targetBeat =
+                jumped ? pending.targetBeat + shift : startBeat + pending.request.afterBeats;
+        }
+    }
+}
+
+void SessionLaunchScheduler::recordFired(const ClipLaunchRequest& request, double beat) {
+    if (request.action == ClipLaunchRequest::Action::Stop) {
+        for (size_t i = numLaunched_; i-- > 0;) {
+            if (launched_[i].clipId == request.clipId) {
+                removeLaunched(i);
+            }
+        }
+        removeFollowUpsOf(request.clipId, false);
+        return;
+    }
+
+    // The clip replaces whatever played on its track, and follow-ups timed from that are
+    // void - except this one's siblings (the rest of a scene chain's next scene)
+    for (size_t i = numLaunched_; i-- > 0;) {
+        const auto& replaced = launched_[i];
+        if (replaced.trackId == request.trackId || replaced.clipId == request.clipId) {
+            if (replaced.clipId != request.afterClipId) {
+                removeFollowUpsOf(replaced.clipId, true);
+            }
+            removeLaunched(i);
+        }
+    }
+    if (numLaunched_ == kMaxPending) {
+        removeLaunched(0);  // The longest playing
+    }
+    launched_[numLaunched_++] = {request.clipId, request.trackId, beat};
+
+    // Follow-ups that came with this launch start counting
+    for (size_t i = 0; i < numPending_; ++i) {
+        auto& pending = pending_[i];
+        if (!pending.resolved && pending.request.afterClipId == request.clipId) {
+            pending.targetBeat = beat + pending.request.afterBeats;
+            pending.resolved = true;
+        }
+    }
+}
+
+void SessionLaunchScheduler::removeFollowUpsOf(ClipId clipId, bool resolvedOnly) {
+    for (size_t i = numPending_; i-- > 0;) {
+        const auto& pending = pending_[i];
+        if (pending.request.afterClipId == clipId && (pending.resolved || !resolvedOnly)) {
+            removePending(i);
+        }
+    }
+}
+
+void SessionLaunchScheduler::removeLaunched(size_t index) {
+    for (size_t i = index + 1; i < numLaunched_; ++i) {
+        launched_[i - 1] = launched_[i];
+    }
+    --numLaunched_;
+}
+
+const SessionLaunchScheduler::Launched* SessionLaunchScheduler::findLaunched(
+    ClipId clipId) const {
+    for (size_t i = 0; i < numLaunched_; ++i) {
+        if (launched_[i].clipId == clipId) {
+            return &launched_[i];
+        }
+    }
+    return nullptr;
+}
+
+bool SessionLaunchScheduler::isLaunchPending(ClipId clipId) const {
+    for (size_t i = 0; i < numPending_; ++i) {
+        const auto& request = pending_[i].request;
+        if (request.clipId == clipId && request.action == ClipLaunchRequest::Action::Launch) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}  // namespace magda
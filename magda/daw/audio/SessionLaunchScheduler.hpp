@@ -0,0 +1,194 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "../core/ClipLauncher.hpp"
+
+namespace magda {
+
+/**
+ * @brief Times session clip launches and stops on the audio thread
+ *
+ * The message thread pushes requests into a lock-free single-producer ring; each audio block
+ * takes whatever has been published, resolves every new request to the next multiple of its
+ * quantisation at or after the block's start, and fires requests whose beat falls inside the
+ * block at the sample it falls on. A batch (a scene launch) is published with one store, so
+ * its requests are taken in the same block, resolve to the same beat and fire in the same
+ * sample.
+ *
+ * Waiting requests follow the musical rules of a clip launcher: a launch replaces any
+ * launch still waiting on its track, and a launch or stop of a clip replaces anything
+ * waiting for that clip. When the playhead jumps (loop wrap, locate) they are resolved
+ * again from the new position, and while the transport is stopped there is no grid to wait
+ * for, so they fire at the start of the next block.
+ *
+ * Follow-ups (ClipLaunchRequest::isFollowUp()) are timed from the launch of another clip
+ * instead: the scheduler remembers the beat each clip was launched on, so a follow-up fires
+ * exactly afterBeats of playing time later, however late the message thread hands it over.
+ * One waits per track, the latest; one that arrives with its clip's launch waits for that
+ * launch to fire. Launching or stopping that clip again or replacing it on its track calls
+ * the follow-up off. Follow-ups never fire while the transport is stopped. A jump keeps the
+ * playing time they have left, and playing from a stop restarts the count.
+ *
+ * Threading: push() on the message thread, process() and getNumPending() on the audio
+ * thread. Neither allocates or blocks.
+ */
+class SessionLaunchScheduler {
+  public:
+    static constexpr size_t kQueueSize = 256;  // Power of 2 for fast modulo
+    static constexpr size_t kMaxPending = 128;
+
+    /**
+     * @brief A stretch of the playhead (a whole block, or the part before or after a wrap)
+     */
+    struct Block {
+        double startBeat = 0.0;
+        double beatsPerSample = 0.0;
+        int numSamples = 0;
+        int firstSample = 0;  // Offset of this stretch within the device block
+        bool playing = false;
+    };
+
+    struct Fired {
+        ClipLaunchRequest request;
+        int sampleOffset = 0;  // Within the device block
+    };
+
+    /**
+     * @brief Queue requests to be timed together (message thread)
+     * @return False, queuing none of them, if they don't all fit
+     */
+    bool push(const std::vector<ClipLaunchRequest>& requests);
+
+    /**
+     * @brief Take new requests and fire those due in this block (audio thread)
+     * @param onFired Called as onFired(const Fired&) for each, in sample order
+     */
+    template <typename Callback> void process(const Block& block, Callback&& onFired) {
+        const double endBeat = block.startBeat + block.beatsPerSample * block.numSamples;
+        const bool jumped = block.playing && hasPosition_ &&
+                            (block.startBeat < lastEndBeat_ - kBeatEpsilon ||
+                             block.startBeat > lastEndBeat_ + kBeatEpsilon);
+        if (jumped || (block.playing && !hasPosition_)) {
+            retime(block.startBeat, jumped);
+        }
+        hasPosition_ = block.playing;
+        lastEndBeat_ = endBeat;
+
+        takeNewRequests(block);
+
+        // Fire in sample order, keeping the order requests arrived in for the same sample
+        for (;;) {
+            size_t next = numPending_;
+            for (size_t i = 0; i < numPending_; ++i) {
+                const auto& pending = pending_[i];
+                const double target = pending.targetBeat;
+                const bool due = pending.request.isFollowUp()
+                                     ? block.playing && pending.resolved &&
+                                           target < endBeat - kBeatEpsilon
+                                     : !block.playing || target < endBeat - kBeatEpsilon;
+                if (due && (next == numPending_ || target < pending_[next].targetBeat)) {
+                    next = i;
+                }
+            }
+            if (next == numPending_) {
+                break;
+            }
+
+            Fired fired;
+            fired.request = pending_[next].request;
+            fired.sampleOffset =
+                block.firstSample + sampleWithin(block, pending_[next].targetBeat);
+            const double firedBeat = block.playing ? pending_[next].targetBeat : block.startBeat;
+            removePending(next);
+            recordFired(fired.request, firedBeat);
+            onFired(fired);
+        }
+    }
+
+    /**
+     * @brief Requests waiting for their beat (audio thread)
+     */
+    size_t getNumPending() const {
+        return numPending_;
+    }
+
+    /**
+     * @brief Requests dropped because the ring or the pending table was full
+     */
+    uint64_t getDroppedCount() const {
+        return droppedCount_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief The next multiple of quantiseBeats at or after beat (beat itself for 0)
+     */
+    static double quantiseUp(double beat, double quantiseBeats) {
+        if (quantiseBeats <= 0.0) {
+            return beat;
+        }
+        return std::ceil(beat / quantiseBeats - kBeatEpsilon) * quantiseBeats;
+    }
+
+    // Beats closer than this are the same beat (well under a sample at any tempo)
+    static constexpr double kBeatEpsilon = 1.0e-9;
+
+  private:
+    struct Pending {
+        ClipLaunchRequest request;
+        double targetBeat = 0.0;
+        bool resolved = true;  // False for a follow-up whose clip hasn't launched yet
+    };
+
+    // The beat each playing clip was launched on, for timing follow-ups
+    struct Launched {
+        ClipId clipId = INVALID_CLIP_ID;
+        TrackId trackId = INVALID_TRACK_ID;
+        double beat = 0.0;
+    };
+
+    std::array<ClipLaunchRequest, kQueueSize> ring_{};
+    alignas(64) std::atomic<size_t> writePos_{0};
+    alignas(64) std::atomic<size_t> readPos_{0};
+    std::atomic<uint64_t> droppedCount_{0};
+
+    // Audio thread only
+    std::array<Pending, kMaxPending> pending_{};
+    size_t numPending_ = 0;
+    std::array<Launched, kMaxPending> launched_{};
+    size_t numLaunched_ = 0;
+    double lastEndBeat_ = 0.0;
+    bool hasPosition_ = false;
+
+    static double resolve(double startBeat, const ClipLaunchRequest& request) {
+        return quantiseUp(startBeat, request.quantiseBeats);
+    }
+
+    static int sampleWithin(const Block& block, double beat) {
+        if (!block.playing || block.beatsPerSample <= 0.0 || beat <= block.startBeat) {
+            return 0;
+        }
+        const auto sample =
+            static_cast<int>(std::ceil((beat - block.startBeat) / block.beatsPerSample -
+                                       kBeatEpsilon));
+        return sample < block.numSamples ? sample : block.numSamples - 1;
+    }
+
+    void takeNewRequests(const Block& block);
+    void addPending(const ClipLaunchRequest& request, double targetBeat);
+    void addFollowUp(const ClipLaunchRequest& request);
+    void removePending(size_t index);
+    void retime(double startBeat, bool jumped);
+    void recordFired(const ClipLaunchRequest& request, double beat);
+    void removeFollowUpsOf(ClipId clipId, bool resolvedOnly);
+    void removeLaunched(size_t index);
+    const Launched* findLaunched(ClipId clipId) const;
+    bool isLaunchPending(ClipId clipId) const;
+};
+
+}  // namespace magda
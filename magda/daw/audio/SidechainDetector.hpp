@@ -0,0 +1,195 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+
+#include "../core/TypeIds.hpp"
+
+namespace magda {
+
+/**
+ * @brief Block-based level and onset detection for audio that drives mods
+ *
+ * Each block is reduced to its peak and RMS across all channels in a single pass, with no
+ * look-ahead, buffering or allocation, so the figures describe the block just rendered.
+ * Onsets are energy based: a block whose mean-square energy jumps kOnsetRatio above the
+ * recent average (a one-pole average over kAverageSeconds) and above kOnsetFloor is an
+ * onset. The next one needs the energy to have dropped back under that ratio first, so a
+ * sustained sound counts once, and can't fire within kHoldSeconds. Comparing against the signal's
+ * own average, rather than a fixed threshold, picks out hits in quiet and loud material
+ * alike. Time constants are in seconds, so results don't depend on the block size. The
+ * first block after a reset only seeds the average, so a detector that starts on a signal
+ * already playing doesn't report an onset for it.
+ *
+ * One detector per signal; not thread-safe.
+ */
+class SidechainDetector {
+  public:
+    struct Reading {
+        float peak = 0.0f;
+        float rms = 0.0f;
+        bool onset = false;
+    };
+
+    static constexpr float kOnsetRatio = 4.0f;     // Energy +6 dB over the average
+    static constexpr float kOnsetFloor = 1.0e-4f;  // Mean square of -40 dBFS
+    static constexpr double kAverageSeconds = 0.25;
+    static constexpr double kHoldSeconds = 0.05;
+
+    /**
+     * @brief Measure one block
+     * @param channels numChannels pointers to numSamples samples; null pointers are skipped
+     */
+    Reading process(const float* const* channels, int numChannels, int numSamples,
+                    double sampleRate) {
+        Reading reading;
+        if (channels == nullptr || numChannels <= 0 || numSamples <= 0 || sampleRate <= 0.0) {
+            return reading;
+        }
+
+        float peak = 0.0f;
+        float sumSquares = 0.0f;
+        int measured = 0;
+        for (int ch = 0; ch < numChannels; ++ch) {
+            const float* data = channels[ch];
+            if (data == nullptr) {
+                continue;
+            }
+            for (int i = 0; i < numSamples; ++i) {
+                peak = std::max(peak, std::abs(data[i]));
+                sumSquares += data[i] * data[i];
+            }
+            ++measured;
+        }
+        if (measured == 0) {
+            return reading;
+        }
+
+        const float energy = sumSquares / static_cast<float>(measured * numSamples);
+        const double deltaTime = numSamples / sampleRate;
+        reading.peak = peak;
+        reading.rms = std::sqrt(energy);
+
+        if (!primed_) {
+            average_ = energy;
+            primed_ = true;
+            return reading;
+        }
+
+        sinceOnset_ += deltaTime;
+        const bool jump = energy > average_ * kOnsetRatio;
+        if (jump && armed_ && energy > kOnsetFloor && sinceOnset_ >= kHoldSeconds) {
+            reading.onset = true;
+            armed_ = false;
+            sinceOnset_ = 0.0;
+        } else if (!jump) {
+            armed_ = true;
+        }
+
+        const auto coefficient = static_cast<float>(1.0 - std::exp(-deltaTime / kAverageSeconds));
+        average_ += (energy - average_) * coefficient;
+        return reading;
+    }
+
+    void reset() {
+        primed_ = false;
+        armed_ = true;
+        average_ = 0.0f;
+        sinceOnset_ = kHoldSeconds;
+    }
+
+  private:
+    bool primed_ = false;
+    bool armed_ = true;
+    float average_ = 0.0f;  // Mean-square energy
+    double sinceOnset_ = kHoldSeconds;
+};
+
+/**
+ * @brief Latest detector readings of track outputs, for mods that follow another track
+ *
+ * Each track's TrackMeterPlugin runs a SidechainDetector over its rendered output while
+ * the track is listened to, and publishes here: peak and RMS as the latest block's values,
+ * onsets as a counter that readers compare against the count they last saw, so an onset
+ * is never lost or seen twice however the writer and reader blocks interleave. Slots are
+ * spaced a cache line apart so tracks rendering on different threads don't false-share.
+ *
+ * Threading: setListening() on the message thread, publish() on a render thread, the
+ * rest from the modulator on the audio thread. All wait-free.
+ */
+class SidechainBus {
+  public:
+    static constexpr int kMaxTracks = 256;  // Track IDs at or past this can't be followed
+
+    SidechainBus() : slots_(std::make_unique<Slot[]>(static_cast<size_t>(kMaxTracks))) {}
+
+    /**
+     * @brief Turn measurement of a track's output on or off; off clears its readings
+     */
+    void setListening(TrackId trackId, bool listening) {
+        if (auto* slot = find(trackId)) {
+            if (!listening) {
+                slot->peak.store(0.0f, std::memory_order_relaxed);
+                slot->rms.store(0.0f, std::memory_order_relaxed);
+            }
+            slot->listening.store(listening, std::memory_order_relaxed);
+        }
+    }
+
+    void stopListeningToAll() {
+        for (int i = 0; i < kMaxTracks; ++i) {
+            setListening(i, false);
+        }
+    }
+
+    bool isListening(TrackId trackId) const {
+        const auto* slot = find(trackId);
+        return slot != nullptr && slot->listening.load(std::memory_order_relaxed);
+    }
+
+    void publish(TrackId trackId, const SidechainDetector::Reading& reading) {
+        if (auto* slot = find(trackId)) {
+            slot->peak.store(reading.peak, std::memory_order_relaxed);
+            slot->rms.store(reading.rms, std::memory_order_relaxed);
+            if (reading.onset) {
+                slot->onsets.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief The latest reading; onset is set if the count moved past onsetsSeen
+     * @param onsetsSeen The reader's count for this track, updated
+     */
+    SidechainDetector::Reading read(TrackId trackId, uint32_t& onsetsSeen) const {
+        SidechainDetector::Reading reading;
+        if (const auto* slot = find(trackId)) {
+            reading.peak = slot->peak.load(std::memory_order_relaxed);
+            reading.rms = slot->rms.load(std::memory_order_relaxed);
+            const uint32_t onsets = slot->onsets.load(std::memory_order_relaxed);
+            reading.onset = onsets != onsetsSeen;
+            onsetsSeen = onsets;
+        }
+        return reading;
+    }
+
+  private:
+    struct alignas(64) Slot {
+        std::atomic<bool> listening{false};
+        std::atomic<float> peak{0.0f};
+        std::atomic<float> rms{0.0f};
+        std::atomic<uint32_t> onsets{0};
+    };
+
+    Slot* find(TrackId trackId) const {
+        return trackId >= 0 && trackId < kMaxTracks ? &slots_[static_cast<size_t>(trackId)]
+                                                    : nullptr;
+    }
+
+    std::unique_ptr<Slot[]> slots_;
+};
+
+}  // namespace magda
@@ -1,5 +1,10 @@
 #include "SimpleSynthPlugin.hpp"
 
+#include <cmath>
+
+#include "../profiling/RealtimeSafety.hpp"
+#include "MixKernels.hpp"
+
 namespace magda::daw::audio {
 
 namespace te = tracktion::engine;
@@ -16,6 +21,11 @@ SimpleSynthVoice::SimpleSynthVoice() {
     adsrParams.sustain = 0.8f;
     adsrParams.release = 0.2f;
     adsr.setParameters(adsrParams);
+
+    // Every voice gets its own noise, seeded once here rather than on the audio thread
+    auto& random = juce::Random::getSystemRandom();
+    for (auto& lane : noiseState)
+        lane = static_cast<juce::uint32>(random.nextInt()) | 1u;
 }
 
 void SimpleSynthVoice::setADSR(float attack, float decay, float sustain, float release) {
@@ -31,11 +41,16 @@ bool SimpleSynthVoice::canPlaySound(juce::SynthesiserSound* sound) {
 }
 
 void SimpleSynthVoice::startNote(int midiNoteNumber, float velocity, juce::SynthesiserSound*,
-                                 int /*currentPitchWheelPosition*/) {
+                                 int currentPitchWheelPosition) {
+    lastEnvelope = 0.0f;
     currentAngle = 0.0;
     level = velocity * 0.15;
-    angleDelta = juce::MathConstants<double>::twoPi *
-                 juce::MidiMessage::getMidiNoteInHertz(midiNoteNumber) / getSampleRate();
+    pressureGain = lastPressureGain = 1.0f;
+    noteAngleDelta = juce::MathConstants<double>::twoPi *
+                     juce::MidiMessage::getMidiNoteInHertz(midiNoteNumber) / getSampleRate();
+
+    // A bend sent on the channel before the note-on applies to it
+    pitchWheelMoved(currentPitchWheelPosition);
 
     adsr.setSampleRate(getSampleRate());
     adsr.noteOn();
@@ -45,36 +60,235 @@ void SimpleSynthVoice::stopNote(float /*velocity*/, bool allowTailOff) {
     if (allowTailOff) {
         adsr.noteOff();
     } else {
+        // Stolen (or hard stopped): if a new note starts on this voice, the old one fades
+        // out underneath it rather than being cut mid-cycle
+        tailWaveform = waveform;
+        tailAngle = currentAngle;
+        tailAngleDelta = angleDelta;
+        tailGain = static_cast<float>(level) * lastPressureGain * lastEnvelope;
+        tailSamplesLeft = tailGain > 0.0f ? kStealFadeSamples : 0;
+
         adsr.reset();
         clearCurrentNote();
     }
 }
 
+void SimpleSynthVoice::pitchWheelMoved(int newPitchWheelValue) {
+    const double range = isPlayingChannel(1) ? kMasterBendSemitones : kNoteBendSemitones;
+    const double semitones = (newPitchWheelValue - 8192) / 8192.0 * range;
+    angleDelta = noteAngleDelta * std::exp2(semitones / 12.0);
+}
+
+void SimpleSynthVoice::channelPressureChanged(int newChannelPressureValue) {
+    const int pressure = juce::jlimit(0, 127, newChannelPressureValue);
+    pressureGain = 1.0f + static_cast<float>(pressure) / 127.0f;
+}
+
 void SimpleSynthVoice::renderNextBlock(juce::AudioBuffer<float>& outputBuffer, int startSample,
                                        int numSamples) {
-    adsr.setSampleRate(getSampleRate());
+    if (!isVoiceActive()) {
+        tailSamplesLeft = 0;  // Hard stopped with nothing started after it
+        return;
+    }
+
+    const int numChannels = outputBuffer.getNumChannels();
+
+    while (numSamples > 0 && isVoiceActive()) {
+        const int blockSamples = juce::jmin(numSamples, kBlockSize);
+        float* block = scratch.data();
+
+        renderOscillator(waveform, block, blockSamples, currentAngle, angleDelta);
 
-    for (int i = 0; i < numSamples; ++i) {
-        float env = adsr.getNextSample();
-        float sample = 0.0f;
-
-        if (waveform == Waveform::Sine) {
-            // Sine wave
-            sample = static_cast<float>(std::sin(currentAngle) * level * env);
-            currentAngle += angleDelta;
-        } else {
-            // White noise
-            sample = (random.nextFloat() * 2.0f - 1.0f) * static_cast<float>(level * env);
+        // The envelope is a per-sample state machine, so it stays scalar
+        float envelope = lastEnvelope;
+        for (int i = 0; i < blockSamples; ++i) {
+            envelope = adsr.getNextSample();
+            block[i] *= envelope;
         }
+        lastEnvelope = envelope;
+
+        // Pressure glides over the block rather than stepping, which would click
+        const auto gain = static_cast<float>(level) * outputGain;
+        MixKernels::applyGain(block, blockSamples, gain * lastPressureGain, gain * pressureGain);
+        lastPressureGain = pressureGain;
+
+        // Fade out the note this voice was stolen from
+        if (tailSamplesLeft > 0) {
+            const int tailSamples = juce::jmin(blockSamples, tailSamplesLeft);
+            float* tail = tailScratch.data();
+            renderOscillator(tailWaveform, tail, tailSamples, tailAngle, tailAngleDelta);
+
+            const float step = tailGain * outputGain / static_cast<float>(kStealFadeSamples);
+            MixKernels::addWithGain(block, tail, tailSamples,
+                                    step * static_cast<float>(tailSamplesLeft),
+                                    step * static_cast<float>(tailSamplesLeft - tailSamples));
+            tailSamplesLeft -= tailSamples;
+        }
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            juce::FloatVectorOperations::add(outputBuffer.getWritePointer(channel, startSample),
+                                             block, blockSamples);
 
-        for (int channel = 0; channel < outputBuffer.getNumChannels(); ++channel)
-            outputBuffer.addSample(channel, startSample, sample);
+        startSample += blockSamples;
+        numSamples -= blockSamples;
 
-        ++startSample;
+        if (!adsr.isActive())
+            clearCurrentNote();
     }
+}
 
-    if (!adsr.isActive())
-        clearCurrentNote();
+void SimpleSynthVoice::renderOscillator(Waveform wf, float* dest, int numSamples, double& angle,
+                                        double delta) {
+    if (wf == Waveform::Sine) {
+        renderSine(dest, numSamples, angle, delta);
+        angle = std::fmod(angle + delta * numSamples, juce::MathConstants<double>::twoPi);
+    } else {
+        renderNoise(dest, numSamples, noiseState);
+    }
+}
+
+void SimpleSynthVoice::renderSine(float* dest, int numSamples, double startAngle,
+                                  double angleDelta) {
+    // Lane k holds the phasor for sample i + k; a step rotates every lane four samples on
+    float re[4], im[4];
+    for (int k = 0; k < 4; ++k) {
+        re[k] = static_cast<float>(std::cos(startAngle + angleDelta * k));
+        im[k] = static_cast<float>(std::sin(startAngle + angleDelta * k));
+    }
+    const auto stepRe = static_cast<float>(std::cos(angleDelta * 4.0));
+    const auto stepIm = static_cast<float>(std::sin(angleDelta * 4.0));
+
+    int i = 0;
+    for (; i + 4 <= numSamples; i += 4) {
+        for (int k = 0; k < 4; ++k) {
+            dest[i + k] = im[k];
+            const float nextRe = re[k] * stepRe - im[k] * stepIm;
+            im[k] = re[k] * stepIm + im[k] * stepRe;
+            re[k] = nextRe;
+        }
+    }
+    for (int k = 0; i < numSamples; ++i, ++k)
+        dest[i] = im[k];
+}
+
+void SimpleSynthVoice::renderNoise(float* dest, int numSamples,
+                                   std::array<juce::uint32, 4>& state) {
+    // Numerical Recipes LCG per lane; the sign-extended state scales to [-1, 1)
+    constexpr float scale = 1.0f / 2147483648.0f;
+    juce::uint32 lanes[4] = {state[0], state[1], state[2], state[3]};
+
+    int i = 0;
+    for (; i + 4 <= numSamples; i += 4) {
+        for (int k = 0; k < 4; ++k) {
+            lanes[k] = lanes[k] * 1664525u + 1013904223u;
+            dest[i + k] = static_cast<float>(static_cast<juce::int32>(lanes[k])) * scale;
+        }
+    }
+    for (int k = 0; i < numSamples; ++i, ++k) {
+        lanes[k] = lanes[k] * 1664525u + 1013904223u;
+        dest[i] = static_cast<float>(static_cast<juce::int32>(lanes[k])) * scale;
+    }
+
+    for (int k = 0; k < 4; ++k)
+        state[static_cast<size_t>(k)] = lanes[k];
+}
+
+//==============================================================================
+// SimpleSynthesiser Implementation
+//==============================================================================
+
+SimpleSynthesiser::SimpleSynthesiser(int numVoices) {
+    addSound(new SimpleSynthSound());
+    for (int i = 0; i < numVoices; ++i)
+        addVoice(new SimpleSynthVoice());
+}
+
+void SimpleSynthesiser::setPolyphony(int numVoices) {
+    polyphony.store(juce::jlimit(1, juce::jmax(1, getNumVoices()), numVoices),
+                    std::memory_order_relaxed);
+}
+
+bool SimpleSynthesiser::hasActiveVoices() const {
+    for (auto* voice : voices) {
+        if (voice->isVoiceActive())
+            return true;
+    }
+    return false;
+}
+
+juce::SynthesiserVoice* SimpleSynthesiser::findFreeVoice(juce::SynthesiserSound* soundToPlay,
+                                                         int midiChannel, int midiNoteNumber,
+                                                         bool stealIfNoneAvailable) const {
+    const int limit = juce::jmin(getPolyphony(), voices.size());
+    for (int i = 0; i < limit; ++i) {
+        auto* voice = voices.getUnchecked(i);
+        if (!voice->isVoiceActive() && voice->canPlaySound(soundToPlay))
+            return voice;
+    }
+
+    if (stealIfNoneAvailable)
+        return findVoiceToSteal(soundToPlay, midiChannel, midiNoteNumber);
+
+    return nullptr;
+}
+
+juce::SynthesiserVoice* SimpleSynthesiser::findVoiceToSteal(juce::SynthesiserSound* soundToPlay,
+                                                            int /*midiChannel*/,
+                                                            int midiNoteNumber) const {
+    const int limit = juce::jmin(getPolyphony(), voices.size());
+
+    auto older = [](juce::SynthesiserVoice* candidate, juce::SynthesiserVoice* current) {
+        return current == nullptr || candidate->wasStartedBefore(*current);
+    };
+
+    juce::SynthesiserVoice* oldest = nullptr;
+    juce::SynthesiserVoice* oldestReleased = nullptr;
+    juce::SynthesiserVoice* lowestHeld = nullptr;
+    juce::SynthesiserVoice* highestHeld = nullptr;
+    int numHeld = 0;
+
+    for (int i = 0; i < limit; ++i) {
+        auto* voice = voices.getUnchecked(i);
+        if (!voice->canPlaySound(soundToPlay))
+            continue;
+
+        if (voice->getCurrentlyPlayingNote() == midiNoteNumber)
+            return voice;
+
+        if (older(voice, oldest))
+            oldest = voice;
+
+        if (voice->isPlayingButReleased()) {
+            if (older(voice, oldestReleased))
+                oldestReleased = voice;
+        } else if (voice->isVoiceActive()) {
+            ++numHeld;
+            const int note = voice->getCurrentlyPlayingNote();
+            if (lowestHeld == nullptr || note < lowestHeld->getCurrentlyPlayingNote())
+                lowestHeld = voice;
+            if (highestHeld == nullptr || note > highestHeld->getCurrentlyPlayingNote())
+                highestHeld = voice;
+        }
+    }
+
+    if (oldestReleased != nullptr)
+        return oldestReleased;
+
+    if (numHeld > 2) {
+        juce::SynthesiserVoice* oldestInner = nullptr;
+        for (int i = 0; i < limit; ++i) {
+            auto* voice = voices.getUnchecked(i);
+            if (voice == lowestHeld || voice == highestHeld || !voice->isVoiceActive() ||
+                voice->isPlayingButReleased() || !voice->canPlaySound(soundToPlay))
+                continue;
+            if (older(voice, oldestInner))
+                oldestInner = voice;
+        }
+        if (oldestInner != nullptr)
+            return oldestInner;
+    }
+
+    return oldest;
 }
 
 //==============================================================================
@@ -84,6 +298,10 @@ void SimpleSynthVoice::renderNextBlock(juce::AudioBuffer<float>& outputBuffer, i
 SimpleSynthPlugin::SimpleSynthPlugin(const te::PluginCreationInfo& info) : Plugin(info) {
     auto um = getUndoManager();
 
+    // Polyphony: all kMaxVoices voices always exist, this is how many new notes may use
+    polyphonyValue.referTo(state, "polyphony", um, 8);
+    synthesiser.setPolyphony(polyphonyValue.get());
+
     // Waveform: 0 = Sine, 1 = Noise
     waveformValue.referTo(state, te::IDs::waveform, um, 0.0f);
     waveformParam = addParam(
@@ -125,15 +343,6 @@ SimpleSynthPlugin::SimpleSynthPlugin(const te::PluginCreationInfo& info) : Plugi
         [](const juce::String& s) {
             return s.upToFirstOccurrenceOf(" ", false, false).getFloatValue();
         });
-
-    // Initialize synthesiser
-    synthesiser.clearVoices();
-    synthesiser.clearSounds();
-
-    synthesiser.addSound(new SimpleSynthSound());
-
-    for (int i = 0; i < numVoices; ++i)
-        synthesiser.addVoice(new SimpleSynthVoice());
 }
 
 SimpleSynthPlugin::~SimpleSynthPlugin() {
@@ -157,38 +366,56 @@ double SimpleSynthPlugin::getTailLength() const {
     return releaseValue.get();
 }
 
+void SimpleSynthPlugin::setPolyphony(int numVoices) {
+    polyphonyValue = juce::jlimit(1, SimpleSynthesiser::kMaxVoices, numVoices);
+}
+
 void SimpleSynthPlugin::updateVoiceParameters() {
     float attack = juce::jlimit(0.001f, 5.0f, attackParam->getCurrentValue());
     float decay = juce::jlimit(0.001f, 5.0f, decayParam->getCurrentValue());
     float sustain = juce::jlimit(0.0f, 1.0f, sustainParam->getCurrentValue());
     float release = juce::jlimit(0.001f, 10.0f, releaseParam->getCurrentValue());
 
-    SimpleSynthVoice::Waveform wf = waveformParam->getCurrentValue() < 0.5f
-                                        ? SimpleSynthVoice::Waveform::Sine
-                                        : SimpleSynthVoice::Waveform::Noise;
+    int waveform = waveformParam->getCurrentValue() < 0.5f ? 0 : 1;
+    float levelLinear = juce::Decibels::decibelsToGain(levelParam->getCurrentValue());
+
+    synthesiser.setPolyphony(polyphonyValue.get());
+
+    if (attack == lastAttack && decay == lastDecay && sustain == lastSustain &&
+        release == lastRelease && waveform == lastWaveform && levelLinear == lastLevel)
+        return;
+
+    lastAttack = attack;
+    lastDecay = decay;
+    lastSustain = sustain;
+    lastRelease = release;
+    lastWaveform = waveform;
+    lastLevel = levelLinear;
 
     // Update all voices
-    for (int i = 0; i < synthesiser.getNumVoices(); ++i) {
-        if (auto* voice = dynamic_cast<SimpleSynthVoice*>(synthesiser.getVoice(i))) {
-            voice->setWaveform(wf);
-            voice->setADSR(attack, decay, sustain, release);
-        }
-    }
+    synthesiser.forEachVoice([&](SimpleSynthVoice& voice) {
+        voice.setWaveform(static_cast<SimpleSynthVoice::Waveform>(waveform));
+        voice.setADSR(attack, decay, sustain, release);
+        voice.setOutputGain(levelLinear);
+    });
 }
 
 void SimpleSynthPlugin::applyToBuffer(const te::PluginRenderContext& fc) {
+    ScopedRealtimeContext realtime;
     if (fc.destBuffer == nullptr)
         return;
 
-    // Update voice parameters from current parameter values
-    updateVoiceParameters();
+    const bool hasMidi = fc.bufferForMidiMessages && !fc.bufferForMidiMessages->isEmpty();
 
-    // Get level in linear from dB
-    float levelDb = levelParam->getCurrentValue();
-    float levelLinear = juce::Decibels::decibelsToGain(levelDb);
+    // Asleep: nothing sounding and nothing to start, so there is nothing to add
+    if (!hasMidi && !synthesiser.hasActiveVoices())
+        return;
+
+    // Update voice parameters from current parameter values (level is applied per voice)
+    updateVoiceParameters();
 
     // Render MIDI to audio
-    if (fc.bufferForMidiMessages && !fc.bufferForMidiMessages->isEmpty()) {
+    if (hasMidi) {
         synthesiser.renderNextBlock(*fc.destBuffer, *fc.bufferForMidiMessages, fc.bufferStartSample,
                                     fc.bufferNumSamples);
     } else {
@@ -197,14 +424,11 @@ void SimpleSynthPlugin::applyToBuffer(const te::PluginRenderContext& fc) {
         synthesiser.renderNextBlock(*fc.destBuffer, emptyMidi, fc.bufferStartSample,
                                     fc.bufferNumSamples);
     }
-
-    // Apply level
-    fc.destBuffer->applyGain(fc.bufferStartSample, fc.bufferNumSamples, levelLinear);
 }
 
 void SimpleSynthPlugin::restorePluginStateFromValueTree(const juce::ValueTree& v) {
-    te::copyPropertiesToCachedValues(v, waveformValue, levelValue, attackValue, decayValue,
-                                     sustainValue, releaseValue);
+    te::copyPropertiesToCachedValues(v, polyphonyValue, waveformValue, levelValue, attackValue,
+                                     decayValue, sustainValue, releaseValue);
 
     for (auto p : getAutomatableParameters())
         p->updateFromAttachedValue();
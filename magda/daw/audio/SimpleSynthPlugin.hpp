@@ -2,6 +2,9 @@
 
 #include <tracktion_engine/tracktion_engine.h>
 
+#include <array>
+#include <atomic>
+
 namespace magda::daw::audio {
 
 namespace te = tracktion::engine;
@@ -22,11 +25,27 @@ struct SimpleSynthSound : public juce::SynthesiserSound {
 //==============================================================================
 /**
  * @brief Synth voice with sine/noise oscillator and ADSR envelope
+ *
+ * Renders in blocks: the oscillator fills a fixed scratch block, the envelope is applied
+ * over it, and the result is added to each output channel with FloatVectorOperations. A
+ * voice that is stolen fades its old note out over a few samples instead of clicking.
+ * Nothing is allocated after construction.
+ *
+ * Pitch bend and channel pressure apply to the voices on their channel, so an MPE
+ * controller (one channel per note) bends and swells each note on its own. The synthesiser
+ * splits the block at every message, so both take effect on the sample they arrive at. As
+ * in MPE's default lower zone, channel 1 bends by kMasterBendSemitones and the member
+ * channels by kNoteBendSemitones; pressure raises the level by up to 6 dB.
  */
 class SimpleSynthVoice : public juce::SynthesiserVoice {
   public:
     enum class Waveform { Sine = 0, Noise = 1 };
 
+    static constexpr int kBlockSize = 128;        // Scratch size; longer blocks are chunked
+    static constexpr int kStealFadeSamples = 64;  // Fade of a stolen note
+    static constexpr double kMasterBendSemitones = 2.0;
+    static constexpr double kNoteBendSemitones = 48.0;
+
     SimpleSynthVoice();
 
     void setWaveform(Waveform wf) {
@@ -34,6 +53,13 @@ class SimpleSynthVoice : public juce::SynthesiserVoice {
     }
     void setADSR(float attack, float decay, float sustain, float release);
 
+    /**
+     * @brief Gain applied to everything the voice renders (the plugin's level)
+     */
+    void setOutputGain(float gain) {
+        outputGain = gain;
+    }
+
     bool canPlaySound(juce::SynthesiserSound* sound) override;
     void startNote(int midiNoteNumber, float velocity, juce::SynthesiserSound*,
                    int currentPitchWheelPosition) override;
@@ -41,22 +67,108 @@ class SimpleSynthVoice : public juce::SynthesiserVoice {
     void renderNextBlock(juce::AudioBuffer<float>& outputBuffer, int startSample,
                          int numSamples) override;
 
-    void pitchWheelMoved(int) override {}
+    void pitchWheelMoved(int newPitchWheelValue) override;
+    void channelPressureChanged(int newChannelPressureValue) override;
     void controllerMoved(int, int) override {}
 
+    //==============================================================================
+    // Oscillator kernels. Both run four independent lanes, which the compiler turns into
+    // SIMD: the sine as four rotating phasors a sample apart, the noise as four LCGs.
+
+    /**
+     * @brief sin(startAngle + i * angleDelta) for i in [0, numSamples), to about 1e-6 over a
+     *        scratch block (the phasors drift, so callers restart them every block)
+     */
+    static void renderSine(float* dest, int numSamples, double startAngle, double angleDelta);
+
+    /**
+     * @brief White noise in [-1, 1), advancing the four lane states
+     */
+    static void renderNoise(float* dest, int numSamples, std::array<juce::uint32, 4>& state);
+
   private:
     Waveform waveform = Waveform::Sine;
 
     // Sine oscillator state
     double currentAngle = 0.0;
     double angleDelta = 0.0;
+    double noteAngleDelta = 0.0;  // Before pitch bend
 
     // Noise generator
-    juce::Random random;
+    std::array<juce::uint32, 4> noiseState{};
 
     double level = 0.0;
+    float outputGain = 1.0f;
+    float pressureGain = 1.0f;
+    float lastPressureGain = 1.0f;  // Ramped from here to pressureGain over the next block
+    float lastEnvelope = 0.0f;
     juce::ADSR adsr;
     juce::ADSR::Parameters adsrParams;
+
+    // The note this voice was playing when it was stolen, fading out under the new one
+    Waveform tailWaveform = Waveform::Sine;
+    double tailAngle = 0.0;
+    double tailAngleDelta = 0.0;
+    float tailGain = 0.0f;
+    int tailSamplesLeft = 0;
+
+    std::array<float, kBlockSize> scratch{};
+    std::array<float, kBlockSize> tailScratch{};
+
+    void renderOscillator(Waveform wf, float* dest, int numSamples, double& angle,
+                          double delta);
+};
+
+//==============================================================================
+/**
+ * @brief Synthesiser with a polyphony limit and a musical voice-stealing policy
+ *
+ * All voices are created up front, so changing the polyphony never allocates: only the
+ * first getPolyphony() voices take new notes, and voices past the limit finish their
+ * release. When every allowed voice is busy, a new note takes, in order:
+ * 1. a voice already playing the same note;
+ * 2. the oldest voice that has been released and is only sounding its tail;
+ * 3. the oldest held voice that is neither the lowest nor the highest held note, so the
+ *    bass and the top line survive a dense chord;
+ * 4. the oldest voice.
+ */
+class SimpleSynthesiser : public juce::Synthesiser {
+  public:
+    static constexpr int kMaxVoices = 32;
+
+    explicit SimpleSynthesiser(int numVoices = kMaxVoices);
+
+    /**
+     * @brief Number of voices new notes may use (clamped to [1, getNumVoices()]); safe to
+     *        call while rendering
+     */
+    void setPolyphony(int numVoices);
+    int getPolyphony() const {
+        return polyphony.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief True if any voice is sounding (including tails past the polyphony limit)
+     */
+    bool hasActiveVoices() const;
+
+    template <typename Fn> void forEachVoice(Fn&& fn) {
+        for (auto* voice : voices) {
+            if (auto* synthVoice = dynamic_cast<SimpleSynthVoice*>(voice)) {
+                fn(*synthVoice);
+            }
+        }
+    }
+
+  protected:
+    juce::SynthesiserVoice* findFreeVoice(juce::SynthesiserSound* soundToPlay, int midiChannel,
+                                          int midiNoteNumber,
+                                          bool stealIfNoneAvailable) const override;
+    juce::SynthesiserVoice* findVoiceToSteal(juce::SynthesiserSound* soundToPlay,
+                                             int midiChannel, int midiNoteNumber) const override;
+
+  private:
+    std::atomic<int> polyphony{8};
 };
 
 //==============================================================================
@@ -67,7 +179,11 @@ class SimpleSynthVoice : public juce::SynthesiserVoice {
  * - Sine or noise waveform
  * - ADSR envelope
  * - Level control
+ * - Configurable polyphony (1 to 32 voices, 8 by default) with voice stealing
  * - Transport sync support (via external MIDI triggering)
+ *
+ * An instance with no sounding voices and no incoming MIDI skips rendering entirely, so
+ * idle instances cost next to nothing.
  */
 class SimpleSynthPlugin : public te::Plugin {
   public:
@@ -117,8 +233,17 @@ class SimpleSynthPlugin : public te::Plugin {
 
     void restorePluginStateFromValueTree(const juce::ValueTree&) override;
 
+    /**
+     * @brief Voices available to new notes (undoable, saved with the plugin)
+     */
+    void setPolyphony(int numVoices);
+    int getPolyphony() const {
+        return polyphonyValue.get();
+    }
+
     //==============================================================================
     // Parameters
+    juce::CachedValue<int> polyphonyValue;
     juce::CachedValue<float> waveformValue, levelValue;
     juce::CachedValue<float> attackValue, decayValue, sustainValue, releaseValue;
 
@@ -127,9 +252,13 @@ class SimpleSynthPlugin : public te::Plugin {
 
   private:
     //==============================================================================
-    juce::Synthesiser synthesiser;
+    SimpleSynthesiser synthesiser;
     double sampleRate = 44100.0;
-    int numVoices = 8;  // Polyphonic
+
+    // Last values pushed to the voices, so unchanged parameters cost nothing per block
+    float lastAttack = -1.0f, lastDecay = -1.0f, lastSustain = -1.0f, lastRelease = -1.0f;
+    float lastLevel = -1.0f;
+    int lastWaveform = -1;
 
     void updateVoiceParameters();
 
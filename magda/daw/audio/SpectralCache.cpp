@@ -0,0 +1,329 @@
+#include "SpectralCache.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include "AudioReaderCache.hpp"
+#include "AudioThumbnailManager.hpp"
+
+namespace magda {
+
+namespace {
+constexpr int kAnalysisBlockSize = 65536;
+}  // namespace
+
+// =============================================================================
+// AnalysisJob
+// =============================================================================
+
+/**
+ * @brief Analyses an audio file on a pool thread, handing over tiles as they finish
+ */
+class SpectralCache::AnalysisJob : public juce::ThreadPoolJob {
+  public:
+    AnalysisJob(juce::AudioFormatManager& formatManager, const juce::String& audioFilePath,
+                juce::int64 peakHash, std::shared_ptr<std::atomic<bool>> alive)
+        : juce::ThreadPoolJob("Analyse spectrum"),
+          formatManager_(formatManager),
+          audioFilePath_(audioFilePath),
+          peakHash_(peakHash),
+          alive_(std::move(alive)) {}
+
+    JobStatus runJob() override {
+        std::unique_ptr<juce::AudioFormatReader> reader(
+            formatManager_.createReaderFor(juce::File(audioFilePath_)));
+        if (reader == nullptr || reader->numChannels == 0) {
+            post({}, true);
+            return jobHasFinished;
+        }
+
+        const int numChannels = static_cast<int>(reader->numChannels);
+        Spectrogram spectrogram;  // The whole of it, to save
+        spectrogram.setFormat(reader->sampleRate, reader->lengthInSamples);
+        SpectralAnalyser analyser;
+        analyser.begin(numChannels, reader->sampleRate);
+
+        juce::AudioBuffer<float> buffer(numChannels, kAnalysisBlockSize);
+        std::vector<std::shared_ptr<const Spectrogram::Tile>> batch;
+        auto lastPostMs = juce::Time::getMillisecondCounter();
+        for (juce::int64 pos = 0; pos < reader->lengthInSamples; pos += kAnalysisBlockSize) {
+            if (shouldExit())
+                return jobHasFinished;
+
+            const auto count = static_cast<int>(
+                std::min<juce::int64>(kAnalysisBlockSize, reader->lengthInSamples - pos));
+            reader->read(&buffer, 0, count, pos, true, true);
+            analyser.addSamples(buffer.getArrayOfReadPointers(), count);
+            take(analyser, spectrogram, batch);
+
+            const auto nowMs = juce::Time::getMillisecondCounter();
+            if (!batch.empty() && nowMs - lastPostMs >= NOTIFY_INTERVAL_MS) {
+                post(std::exchange(batch, {}), false);
+                lastPostMs = nowMs;
+            }
+        }
+        analyser.finish();
+        take(analyser, spectrogram, batch);
+
+        saveSpectralFile(getSpectralFile(peakHash_), spectrogram);
+        post(std::move(batch), true);
+        return jobHasFinished;
+    }
+
+  private:
+    static void take(SpectralAnalyser& analyser, Spectrogram& spectrogram,
+                     std::vector<std::shared_ptr<const Spectrogram::Tile>>& batch) {
+        for (auto& tile : analyser.takeTiles()) {
+            spectrogram.addTile(tile);
+            batch.push_back(std::move(tile));
+        }
+    }
+
+    void post(std::vector<std::shared_ptr<const Spectrogram::Tile>> tiles, bool finished) {
+        auto alive = alive_;
+        auto path = audioFilePath_;
+        auto hash = peakHash_;
+        juce::MessageManager::callAsync(
+            [alive, path, hash, tiles = std::move(tiles), finished]() mutable {
+                if (alive->load()) {
+                    SpectralCache::getInstance().tilesReady(path, hash, std::move(tiles),
+                                                            finished);
+                }
+            });
+    }
+
+    juce::AudioFormatManager& formatManager_;
+    juce::String audioFilePath_;
+    juce::int64 peakHash_;
+    std::shared_ptr<std::atomic<bool>> alive_;
+};
+
+// =============================================================================
+// SpectralCache
+// =============================================================================
+
+SpectralCache::SpectralCache() {
+    formatManager_.registerBasicFormats();
+
+    // One thread: analysis is CPU-bound and never urgent
+    analysisPool_ = std::make_unique<juce::ThreadPool>(1);
+}
+
+SpectralCache& SpectralCache::getInstance() {
+    static SpectralCache instance;
+    return instance;
+}
+
+juce::File SpectralCache::getSpectralFile(juce::int64 peakHash) {
+    return AudioThumbnailManager::getPeakCacheDirectory().getChildFile(
+        juce::String::toHexString(peakHash) + ".spectra");
+}
+
+bool SpectralCache::loadSpectralFile(const juce::File& file, Spectrogram& spectrogram) {
+    if (!file.existsAsFile()) {
+        return false;
+    }
+
+    juce::MemoryBlock data;
+    if (!file.loadFileAsData(data) || !spectrogram.deserialise(data.getData(), data.getSize())) {
+        file.deleteFile();  // Corrupt or from an incompatible version
+        return false;
+    }
+
+    // Touch so pruning keeps recently used files
+    file.setLastModificationTime(juce::Time::getCurrentTime());
+    return true;
+}
+
+void SpectralCache::saveSpectralFile(const juce::File& file, const Spectrogram& spectrogram) {
+    std::vector<char> data;
+    spectrogram.serialise(data);
+    auto directory = file.getParentDirectory();
+    if (data.empty() || (!directory.isDirectory() && !directory.createDirectory())) {
+        return;
+    }
+
+    // Write to a temporary file first so a crash never leaves a truncated file
+    juce::TemporaryFile temp(file);
+    if (temp.getFile().replaceWithData(data.data(), data.size())) {
+        temp.overwriteTargetFileWithTemporary();
+    }
+}
+
+SpectralCache::Source* SpectralCache::getSource(const juce::String& audioFilePath) {
+    auto it = sources_.find(audioFilePath);
+    if (it != sources_.end()) {
+        it->second->lastUsed = ++useClock_;
+        return it->second.get();
+    }
+
+    if (!analysisPool_) {
+        return nullptr;  // Shut down
+    }
+
+    juce::File audioFile(audioFilePath);
+    auto* reader = audioFile.existsAsFile() ? AudioReaderCache::getInstance().getReader(audioFile)
+                                            : nullptr;
+    if (reader == nullptr || reader->sampleRate <= 0.0) {
+        return nullptr;
+    }
+
+    auto source = std::make_unique<Source>();
+    source->peakHash = AudioThumbnailManager::getPeakHash(audioFile);
+    source->lastUsed = ++useClock_;
+
+    // A spectral file from an earlier session draws immediately
+    if (!loadSpectralFile(getSpectralFile(source->peakHash), source->spectrogram) ||
+        source->spectrogram.getLengthInSamples() != reader->lengthInSamples) {
+        source->spectrogram.setFormat(reader->sampleRate, reader->lengthInSamples);
+        source->analysing = true;
+        analysisPool_->addJob(
+            new AnalysisJob(formatManager_, audioFilePath, source->peakHash, alive_), true);
+    }
+
+    auto* sourcePtr = source.get();
+    sources_[audioFilePath] = std::move(source);
+    evictOldest();
+    return sourcePtr;
+}
+
+void SpectralCache::evictOldest() {
+    while (static_cast<int>(sources_.size()) > MAX_RESIDENT) {
+        // Least recently drawn, but never one still being analysed
+        auto victim = sources_.end();
+        for (auto it = sources_.begin(); it != sources_.end(); ++it) {
+            if (it->second->analysing || it->second->lastUsed == useClock_)
+                continue;
+            if (victim == sources_.end() || it->second->lastUsed < victim->second->lastUsed)
+                victim = it;
+        }
+        if (victim == sources_.end()) {
+            return;
+        }
+        sources_.erase(victim);
+    }
+}
+
+void SpectralCache::tilesReady(const juce::String& audioFilePath, juce::int64 peakHash,
+                               std::vector<std::shared_ptr<const Spectrogram::Tile>> tiles,
+                               bool finished) {
+    auto it = sources_.find(audioFilePath);
+    if (it == sources_.end() || it->second->peakHash != peakHash) {
+        return;  // Cleared, or the file changed since
+    }
+
+    auto& source = *it->second;
+    for (auto& tile : tiles) {
+        source.spectrogram.addTile(std::move(tile));
+    }
+    if (finished) {
+        source.analysing = false;
+        source.failed = !source.spectrogram.isComplete();
+        evictOldest();
+    }
+    spectraChanged_.sendChangeMessage();
+}
+
+const Spectrogram* SpectralCache::getSpectrogram(const juce::String& audioFilePath) {
+    auto* source = getSource(audioFilePath);
+    return source != nullptr && !source->failed ? &source->spectrogram : nullptr;
+}
+
+const juce::Colour* SpectralCache::getPalette(const juce::Colour& colour) {
+    if (!hasPalette_ || colour != paletteColour_) {
+        juce::ColourGradient gradient(juce::Colours::transparentBlack, 0.0f, 0.0f,
+                                      juce::Colours::white, 1.0f, 0.0f, false);
+        gradient.addColour(0.35, colour.withAlpha(0.6f));
+        gradient.addColour(0.7, colour.brighter(0.6f));
+        for (int i = 0; i < 256; ++i) {
+            palette_[i] = gradient.getColourAtPosition(i / 255.0);
+        }
+        paletteColour_ = colour;
+        hasPalette_ = true;
+    }
+    return palette_;
+}
+
+void SpectralCache::drawSpectrogram(juce::Graphics& g, const juce::Rectangle<int>& bounds,
+                                    const juce::String& audioFilePath, double startTime,
+                                    double endTime, const juce::Colour& colour) {
+    if (bounds.getWidth() <= 0 || bounds.getHeight() <= 0)
+        return;
+
+    const auto* spectrogram = getSpectrogram(audioFilePath);
+    if (spectrogram == nullptr || spectrogram->getNumReadyTiles() == 0) {
+        if (spectrogram != nullptr) {
+            g.setColour(colour.withAlpha(0.3f));
+            g.drawText("Analysing...", bounds, juce::Justification::centred);
+        }
+        return;
+    }
+
+    const double sampleRate = spectrogram->getSampleRate();
+    const double totalLength = static_cast<double>(spectrogram->getLengthInSamples()) / sampleRate;
+    startTime = juce::jlimit(0.0, totalLength, startTime);
+    endTime = juce::jlimit(startTime, totalLength, endTime);
+
+    const double startFrame = startTime * sampleRate / Spectrogram::HOP_SIZE;
+    const double framesPerPixel =
+        (endTime - startTime) * sampleRate / Spectrogram::HOP_SIZE / bounds.getWidth();
+    if (framesPerPixel <= 0.0)
+        return;
+
+    // Only the columns inside the clip region
+    const auto visible = g.getClipBounds().getIntersection(bounds);
+    if (visible.isEmpty())
+        return;
+
+    // One pixel per column and band, stretched over the bounds' height
+    const int level = Spectrogram::chooseLevel(framesPerPixel);
+    const auto numFrames = spectrogram->getNumFrames();
+    const auto* palette = getPalette(colour);
+    juce::Image image(juce::Image::ARGB, visible.getWidth(), Spectrogram::NUM_BANDS, true);
+    {
+        juce::Image::BitmapData pixels(image, juce::Image::BitmapData::writeOnly);
+        for (int x = 0; x < visible.getWidth(); ++x) {
+            const double frame = startFrame + (visible.getX() - bounds.getX() + x) * framesPerPixel;
+            if (frame >= static_cast<double>(numFrames))
+                break;
+            const auto levelFrame = static_cast<juce::int64>(frame) >> level;
+            for (int band = 0; band < Spectrogram::NUM_BANDS; ++band) {
+                pixels.setPixelColour(x, Spectrogram::NUM_BANDS - 1 - band,
+                                      palette[spectrogram->getValue(level, levelFrame, band)]);
+            }
+        }
+    }
+
+    const juce::Graphics::ScopedSaveState state(g);
+    g.setImageResamplingQuality(juce::Graphics::mediumResamplingQuality);
+    g.drawImage(image, visible.getX(), bounds.getY(), visible.getWidth(), bounds.getHeight(), 0, 0,
+                image.getWidth(), image.getHeight());
+}
+
+void SpectralCache::addListener(juce::ChangeListener* listener) {
+    spectraChanged_.addChangeListener(listener);
+}
+
+void SpectralCache::removeListener(juce::ChangeListener* listener) {
+    spectraChanged_.removeChangeListener(listener);
+}
+
+void SpectralCache::clearCache() {
+    if (analysisPool_) {
+        analysisPool_->removeAllJobs(true, 2000);
+    }
+    sources_.clear();
+}
+
+void SpectralCache::shutdown() {
+    alive_->store(false);
+    if (analysisPool_) {
+        analysisPool_->removeAllJobs(true, 2000);
+        analysisPool_.reset();
+    }
+    sources_.clear();
+}
+
+}  // namespace magda
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_gui_basics/juce_gui_basics.h>
+
+#include <atomic>
+#include <map>
+#include <memory>
+
+#include "Spectrogram.hpp"
+
+namespace magda {
+
+/**
+ * @brief Background spectral analysis of audio files, for the waveform editor's spectrogram
+ *
+ * The first request for a file starts an analysis job on a low-priority thread, which hands
+ * over each batch of finished tiles as it goes; the editor draws what is ready and fills in
+ * as listeners are notified. The finished spectrogram is written beside the file's peaks,
+ * under the same key (AudioThumbnailManager::getPeakHash), so it is invalidated whenever the
+ * peaks are and a reopened project draws immediately.
+ *
+ * Only the spectrograms of the last few files drawn stay resident. Message thread only.
+ */
+class SpectralCache {
+  public:
+    static constexpr int MAX_RESIDENT = 4;
+    static constexpr int NOTIFY_INTERVAL_MS = 200;  // Between batches of tiles
+
+    static SpectralCache& getInstance();
+
+    /**
+     * @brief The spectrogram of a file so far, starting its analysis if needed
+     * @return Nullptr if the file can't be read; otherwise possibly not yet complete
+     */
+    const Spectrogram* getSpectrogram(const juce::String& audioFilePath);
+
+    /**
+     * @brief Draw the spectrum of [startTime, endTime) of a file, low frequencies at the bottom
+     *
+     * Louder bands are drawn brighter, from transparent through colour to white. Parts still
+     * being analysed are left empty.
+     */
+    void drawSpectrogram(juce::Graphics& g, const juce::Rectangle<int>& bounds,
+                         const juce::String& audioFilePath, double startTime, double endTime,
+                         const juce::Colour& colour);
+
+    /**
+     * @brief Be told (on the message thread) when more of a spectrogram is ready
+     */
+    void addListener(juce::ChangeListener* listener);
+    void removeListener(juce::ChangeListener* listener);
+
+    void clearCache();
+
+    /**
+     * @brief Stop the analysis jobs and release all resources (app shutdown)
+     */
+    void shutdown();
+
+    static juce::File getSpectralFile(juce::int64 peakHash);
+
+  private:
+    SpectralCache();
+    ~SpectralCache() = default;
+
+    struct Source {
+        juce::int64 peakHash = 0;
+        Spectrogram spectrogram;
+        juce::uint64 lastUsed = 0;
+        bool analysing = false;
+        bool failed = false;
+    };
+
+    class AnalysisJob;
+
+    Source* getSource(const juce::String& audioFilePath);
+    void tilesReady(const juce::String& audioFilePath, juce::int64 peakHash,
+                    std::vector<std::shared_ptr<const Spectrogram::Tile>> tiles, bool finished);
+    void evictOldest();
+    const juce::Colour* getPalette(const juce::Colour& colour);
+
+    static bool loadSpectralFile(const juce::File& file, Spectrogram& spectrogram);
+    static void saveSpectralFile(const juce::File& file, const Spectrogram& spectrogram);
+
+    juce::AudioFormatManager formatManager_;
+    std::map<juce::String, std::unique_ptr<Source>> sources_;
+    std::unique_ptr<juce::ThreadPool> analysisPool_;
+    juce::ChangeBroadcaster spectraChanged_;
+    juce::uint64 useClock_ = 0;
+
+    // Validity flag for async callbacks - set to false in shutdown()
+    std::shared_ptr<std::atomic<bool>> alive_ = std::make_shared<std::atomic<bool>>(true);
+
+    // Colour map of the last colour drawn, one entry per value
+    juce::Colour paletteColour_;
+    juce::Colour palette_[256];
+    bool hasPalette_ = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SpectralCache)
+};
+
+}  // namespace magda
@@ -0,0 +1,367 @@
+#include "Spectrogram.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+namespace magda {
+
+namespace {
+constexpr char kMagic[4] = {'M', 'S', 'P', '1'};
+constexpr double kPi = 3.14159265358979323846;
+
+template <typename T>
+void append(std::vector<char>& out, const T& value) {
+    const auto* bytes = reinterpret_cast<const char*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T>
+bool extract(const char*& data, const char* end, T& value) {
+    if (static_cast<size_t>(end - data) < sizeof(T))
+        return false;
+    std::memcpy(&value, data, sizeof(T));
+    data += sizeof(T);
+    return true;
+}
+
+// Analysis parameters a spectral file must match to be loaded
+constexpr int32_t kFormat[] = {Spectrogram::FFT_SIZE, Spectrogram::HOP_SIZE,
+                               Spectrogram::NUM_BANDS, Spectrogram::TILE_FRAMES,
+                               Spectrogram::NUM_TILE_LEVELS};
+
+uint8_t quantise(float magnitude) {
+    const float db = 20.0f * std::log10(std::max(magnitude, 1.0e-9f));
+    const float normalised = std::clamp((db - Spectrogram::MIN_DB) / -Spectrogram::MIN_DB, 0.0f,
+                                        1.0f);
+    return static_cast<uint8_t>(std::lround(normalised * 255.0f));
+}
+}  // namespace
+
+// =============================================================================
+// Tile
+// =============================================================================
+
+void Spectrogram::Tile::buildLevels() {
+    levels.resize(NUM_TILE_LEVELS);
+    for (int level = 1; level < NUM_TILE_LEVELS; ++level) {
+        const auto& finer = levels[static_cast<size_t>(level - 1)];
+        const int finerFrames = getNumFrames(level - 1);
+        auto& coarser = levels[static_cast<size_t>(level)];
+        coarser.assign(static_cast<size_t>(getNumFrames(level)) * NUM_BANDS, 0);
+
+        for (int frame = 0; frame < finerFrames; ++frame) {
+            const auto* from = finer.data() + static_cast<size_t>(frame) * NUM_BANDS;
+            auto* to = coarser.data() + static_cast<size_t>(frame / 2) * NUM_BANDS;
+            for (int band = 0; band < NUM_BANDS; ++band) {
+                to[band] = std::max(to[band], from[band]);
+            }
+        }
+    }
+}
+
+// =============================================================================
+// Spectrogram
+// =============================================================================
+
+void Spectrogram::setFormat(double sampleRate, int64_t lengthInSamples) {
+    sampleRate_ = sampleRate;
+    lengthInSamples_ = std::max<int64_t>(0, lengthInSamples);
+    tiles_.assign(static_cast<size_t>((getNumFrames() + TILE_FRAMES - 1) / TILE_FRAMES), nullptr);
+    numReady_ = 0;
+}
+
+int64_t Spectrogram::getNumFrames() const {
+    return (lengthInSamples_ + HOP_SIZE - 1) / HOP_SIZE;
+}
+
+void Spectrogram::addTile(std::shared_ptr<const Tile> tile) {
+    if (tile == nullptr || tile->index < 0 || tile->index >= getNumTiles())
+        return;
+
+    auto& slot = tiles_[static_cast<size_t>(tile->index)];
+    if (slot == nullptr)
+        ++numReady_;
+    slot = std::move(tile);
+}
+
+const Spectrogram::Tile* Spectrogram::getTile(int index) const {
+    if (index < 0 || index >= getNumTiles())
+        return nullptr;
+    return tiles_[static_cast<size_t>(index)].get();
+}
+
+int Spectrogram::chooseLevel(double framesPerPixel) {
+    if (framesPerPixel < 2.0)
+        return 0;
+    return std::min(NUM_TILE_LEVELS - 1, static_cast<int>(std::floor(std::log2(framesPerPixel))));
+}
+
+uint8_t Spectrogram::getValue(int level, int64_t levelFrame, int band) const {
+    const int framesPerTile = TILE_FRAMES >> level;
+    const auto* tile = getTile(static_cast<int>(levelFrame / framesPerTile));
+    const auto frame = static_cast<int>(levelFrame % framesPerTile);
+    if (tile == nullptr || frame < 0 || frame >= tile->getNumFrames(level))
+        return 0;
+    return tile->getValue(level, frame, band);
+}
+
+float Spectrogram::getBandFrequency(int band, double sampleRate) {
+    const double nyquist = std::max(2.0 * MIN_FREQUENCY, sampleRate * 0.5);
+    return static_cast<float>(
+        MIN_FREQUENCY * std::pow(nyquist / MIN_FREQUENCY, static_cast<double>(band) / NUM_BANDS));
+}
+
+size_t Spectrogram::getMemoryUsage() const {
+    size_t bytes = 0;
+    for (const auto& tile : tiles_) {
+        if (tile == nullptr)
+            continue;
+        for (const auto& level : tile->levels)
+            bytes += level.size();
+    }
+    return bytes;
+}
+
+void Spectrogram::serialise(std::vector<char>& out) const {
+    out.clear();
+    if (!isComplete())
+        return;
+
+    out.insert(out.end(), kMagic, kMagic + sizeof(kMagic));
+    for (const auto value : kFormat)
+        append(out, value);
+    append(out, sampleRate_);
+    append(out, static_cast<int64_t>(lengthInSamples_));
+
+    for (const auto& tile : tiles_) {
+        append(out, static_cast<int32_t>(tile->numFrames));
+        for (const auto& level : tile->levels) {
+            const auto* bytes = reinterpret_cast<const char*>(level.data());
+            out.insert(out.end(), bytes, bytes + level.size());
+        }
+    }
+}
+
+bool Spectrogram::deserialise(const void* data, size_t size) {
+    const auto* pos = static_cast<const char*>(data);
+    const auto* end = pos + size;
+
+    if (size < sizeof(kMagic) || std::memcmp(pos, kMagic, sizeof(kMagic)) != 0)
+        return false;
+    pos += sizeof(kMagic);
+
+    for (const auto expected : kFormat) {
+        int32_t value = 0;
+        if (!extract(pos, end, value) || value != expected)
+            return false;
+    }
+
+    double sampleRate = 0.0;
+    int64_t length = 0;
+    if (!extract(pos, end, sampleRate) || !extract(pos, end, length) || sampleRate <= 0.0 ||
+        length < 0) {
+        return false;
+    }
+
+    // Every tile needs at least its frame count, so a corrupt length can't allocate much
+    const int64_t numTiles = ((length + HOP_SIZE - 1) / HOP_SIZE + TILE_FRAMES - 1) / TILE_FRAMES;
+    if (numTiles > static_cast<int64_t>(end - pos) / static_cast<int64_t>(sizeof(int32_t)))
+        return false;
+
+    Spectrogram loaded;
+    loaded.setFormat(sampleRate, length);
+    int64_t framesLeft = loaded.getNumFrames();
+    for (int index = 0; index < loaded.getNumTiles(); ++index) {
+        auto tile = std::make_shared<Tile>();
+        tile->index = index;
+        int32_t numFrames = 0;
+        if (!extract(pos, end, numFrames) ||
+            numFrames != std::min<int64_t>(TILE_FRAMES, framesLeft)) {
+            return false;
+        }
+        tile->numFrames = numFrames;
+        framesLeft -= numFrames;
+
+        tile->levels.resize(NUM_TILE_LEVELS);
+        for (int level = 0; level < NUM_TILE_LEVELS; ++level) {
+            const auto bytes = static_cast<size_t>(tile->getNumFrames(level)) * NUM_BANDS;
+            if (static_cast<size_t>(end - pos) < bytes)
+                return false;
+            auto& values = tile->levels[static_cast<size_t>(level)];
+            values.resize(bytes);
+            std::memcpy(values.data(), pos, bytes);
+            pos += bytes;
+        }
+        loaded.addTile(std::move(tile));
+    }
+
+    *this = std::move(loaded);
+    return true;
+}
+
+// =============================================================================
+// SpectrumTransform
+// =============================================================================
+
+SpectrumTransform::SpectrumTransform() {
+    constexpr int n = Spectrogram::FFT_SIZE;
+
+    window_.resize(n);
+    double sum = 0.0;
+    for (int i = 0; i < n; ++i) {
+        window_[static_cast<size_t>(i)] =
+            static_cast<float>(0.5 - 0.5 * std::cos(2.0 * kPi * i / static_cast<double>(n)));
+        sum += window_[static_cast<size_t>(i)];
+    }
+    // A full-scale sine reads 0 dB: its peak bin holds amplitude * sum / 2
+    windowGain_ = static_cast<float>(sum * 0.5);
+
+    twiddles_.resize(n / 2);
+    for (int k = 0; k < n / 2; ++k) {
+        const auto angle = static_cast<float>(-2.0 * kPi * k / n);
+        twiddles_[static_cast<size_t>(k)] = std::polar(1.0f, angle);
+    }
+
+    bitReversed_.resize(n);
+    for (uint32_t i = 0; i < static_cast<uint32_t>(n); ++i) {
+        uint32_t reversed = 0;
+        for (int bit = 0; bit < Spectrogram::FFT_ORDER; ++bit) {
+            reversed |= ((i >> bit) & 1u) << (Spectrogram::FFT_ORDER - 1 - bit);
+        }
+        bitReversed_[i] = reversed;
+    }
+    spectrum_.resize(n);
+}
+
+void SpectrumTransform::setSampleRate(double sampleRate) {
+    const double binHz = sampleRate / Spectrogram::FFT_SIZE;
+    constexpr int lastBin = Spectrogram::FFT_SIZE / 2;
+    bandFirstBin_.resize(Spectrogram::NUM_BANDS);
+    bandLastBin_.resize(Spectrogram::NUM_BANDS);
+    for (int band = 0; band < Spectrogram::NUM_BANDS; ++band) {
+        const double low = Spectrogram::getBandFrequency(band, sampleRate);
+        const double high = Spectrogram::getBandFrequency(band + 1, sampleRate);
+        const int first = std::clamp(static_cast<int>(std::floor(low / binHz)), 0, lastBin);
+        const int last =
+            std::clamp(static_cast<int>(std::ceil(high / binHz)) - 1, first, lastBin);
+        bandFirstBin_[static_cast<size_t>(band)] = first;
+        bandLastBin_[static_cast<size_t>(band)] = last;
+    }
+}
+
+void SpectrumTransform::transform(const float* frame, float* bands) {
+    for (size_t i = 0; i < spectrum_.size(); ++i)
+        spectrum_[i] = {frame[i] * window_[i], 0.0f};
+    fft(spectrum_);
+
+    for (int band = 0; band < Spectrogram::NUM_BANDS; ++band) {
+        float loudest = 0.0f;
+        for (int bin = bandFirstBin_[static_cast<size_t>(band)];
+             bin <= bandLastBin_[static_cast<size_t>(band)]; ++bin) {
+            loudest = std::max(loudest, std::abs(spectrum_[static_cast<size_t>(bin)]));
+        }
+        bands[band] = loudest / windowGain_;
+    }
+}
+
+void SpectrumTransform::fft(std::vector<std::complex<float>>& data) const {
+    const auto n = data.size();
+    for (size_t i = 0; i < n; ++i) {
+        if (i < bitReversed_[i])
+            std::swap(data[i], data[bitReversed_[i]]);
+    }
+
+    for (size_t size = 2; size <= n; size *= 2) {
+        const size_t half = size / 2;
+        const size_t stride = n / size;
+        for (size_t start = 0; start < n; start += size) {
+            for (size_t k = 0; k < half; ++k) {
+                const auto odd = data[start + k + half] * twiddles_[k * stride];
+                data[start + k + half] = data[start + k] - odd;
+                data[start + k] += odd;
+            }
+        }
+    }
+}
+
+// =============================================================================
+// SpectralAnalyser
+// =============================================================================
+
+void SpectralAnalyser::begin(int numChannels, double sampleRate) {
+    numChannels_ = std::max(0, numChannels);
+    sampleRate_ = sampleRate;
+    samplesIn_ = 0;
+    framesOut_ = 0;
+    tile_.reset();
+    ready_.clear();
+
+    // Frame 0 is centred on the first sample
+    input_.assign(Spectrogram::FFT_SIZE / 2, 0.0f);
+    transform_.setSampleRate(sampleRate_);
+}
+
+void SpectralAnalyser::addSamples(const float* const* channels, int numSamples) {
+    if (numChannels_ == 0 || numSamples <= 0)
+        return;
+
+    const float scale = 1.0f / static_cast<float>(numChannels_);
+    for (int i = 0; i < numSamples; ++i) {
+        float mono = 0.0f;
+        for (int ch = 0; ch < numChannels_; ++ch)
+            mono += channels[ch][i];
+        input_.push_back(mono * scale);
+
+        if (input_.size() >= static_cast<size_t>(Spectrogram::FFT_SIZE)) {
+            analyseFrame();
+            input_.erase(input_.begin(), input_.begin() + Spectrogram::HOP_SIZE);
+        }
+    }
+    samplesIn_ += numSamples;
+}
+
+void SpectralAnalyser::finish() {
+    // The frames centred on the last samples see silence past the end
+    while (framesOut_ * Spectrogram::HOP_SIZE < samplesIn_) {
+        input_.resize(Spectrogram::FFT_SIZE, 0.0f);
+        analyseFrame();
+        input_.erase(input_.begin(), input_.begin() + Spectrogram::HOP_SIZE);
+    }
+    flushTile();
+}
+
+std::vector<std::shared_ptr<const Spectrogram::Tile>> SpectralAnalyser::takeTiles() {
+    return std::exchange(ready_, {});
+}
+
+void SpectralAnalyser::analyseFrame() {
+    transform_.transform(input_.data(), bands_.data());
+
+    if (tile_ == nullptr) {
+        tile_ = std::make_shared<Spectrogram::Tile>();
+        tile_->index = static_cast<int>(framesOut_ / Spectrogram::TILE_FRAMES);
+        tile_->levels.resize(Spectrogram::NUM_TILE_LEVELS);
+        tile_->levels[0].reserve(static_cast<size_t>(Spectrogram::TILE_FRAMES) *
+                                 Spectrogram::NUM_BANDS);
+    }
+
+    auto& values = tile_->levels[0];
+    for (const float band : bands_)
+        values.push_back(quantise(band));
+
+    ++framesOut_;
+    if (++tile_->numFrames == Spectrogram::TILE_FRAMES)
+        flushTile();
+}
+
+void SpectralAnalyser::flushTile() {
+    if (tile_ == nullptr || tile_->numFrames == 0)
+        return;
+    tile_->buildLevels();
+    ready_.push_back(std::move(tile_));
+    tile_.reset();
+}
+
+}  // namespace magda
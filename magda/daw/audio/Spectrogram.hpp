@@ -0,0 +1,171 @@
+#pragma once
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace magda {
+
+/**
+ * @brief Short-time spectrum of an audio file, in tiles that can arrive one at a time
+ *
+ * Frame f is the spectrum of FFT_SIZE samples (Hann window) centred on sample f * HOP_SIZE,
+ * the channels mixed to mono. Each frame holds NUM_BANDS log-spaced bands from
+ * MIN_FREQUENCY to Nyquist, every band the loudest bin inside it, as 0-255 over MIN_DB..0 dB.
+ *
+ * Frames come in tiles of TILE_FRAMES. Each tile keeps its own coarser levels (every level
+ * the maximum of pairs of the one below), so a view of a whole long file reads one or two
+ * frames per pixel column, just like PeakPyramid. Because tiles are independent, a view can
+ * draw the ones analysed so far while the rest are still being computed.
+ */
+class Spectrogram {
+  public:
+    static constexpr int FFT_ORDER = 11;
+    static constexpr int FFT_SIZE = 1 << FFT_ORDER;
+    static constexpr int HOP_SIZE = FFT_SIZE / 2;
+    static constexpr int NUM_BANDS = 128;
+    static constexpr int TILE_FRAMES = 256;    // Power of two
+    static constexpr int NUM_TILE_LEVELS = 9;  // TILE_FRAMES down to one frame
+    static constexpr float MIN_FREQUENCY = 20.0f;
+    static constexpr float MIN_DB = -96.0f;
+
+    struct Tile {
+        int index = 0;
+        int numFrames = 0;  // TILE_FRAMES except in the last tile
+
+        // levels[level][frame * NUM_BANDS + band]
+        std::vector<std::vector<uint8_t>> levels;
+
+        int getNumFrames(int level) const {
+            return (numFrames + (1 << level) - 1) >> level;
+        }
+        uint8_t getValue(int level, int frame, int band) const {
+            return levels[static_cast<size_t>(level)]
+                         [static_cast<size_t>(frame) * NUM_BANDS + static_cast<size_t>(band)];
+        }
+
+        /** @brief Fill the coarser levels from level 0 */
+        void buildLevels();
+    };
+
+    void setFormat(double sampleRate, int64_t lengthInSamples);
+
+    /**
+     * @brief Add an analysed tile; replaces any tile with the same index
+     */
+    void addTile(std::shared_ptr<const Tile> tile);
+
+    double getSampleRate() const {
+        return sampleRate_;
+    }
+    int64_t getLengthInSamples() const {
+        return lengthInSamples_;
+    }
+    int64_t getNumFrames() const;
+    int getNumTiles() const {
+        return static_cast<int>(tiles_.size());
+    }
+
+    /** @brief The tile, or nullptr if it hasn't been analysed yet */
+    const Tile* getTile(int index) const;
+
+    int getNumReadyTiles() const {
+        return numReady_;
+    }
+    bool isComplete() const {
+        return numReady_ == getNumTiles();
+    }
+
+    /**
+     * @brief Coarsest level with at most framesPerPixel frames per value (0 when zoomed in)
+     */
+    static int chooseLevel(double framesPerPixel);
+
+    /**
+     * @brief A band of frame (levelFrame << level), or 0 if its tile isn't ready
+     */
+    uint8_t getValue(int level, int64_t levelFrame, int band) const;
+
+    /** @brief Lower edge of a band in Hz */
+    static float getBandFrequency(int band, double sampleRate);
+
+    size_t getMemoryUsage() const;
+
+    // =========================================================================
+    // Serialization (native byte order - the data is a local cache)
+    // =========================================================================
+
+    /** @brief Only complete spectrograms are written */
+    void serialise(std::vector<char>& out) const;
+    bool deserialise(const void* data, size_t size);
+
+  private:
+    double sampleRate_ = 0.0;
+    int64_t lengthInSamples_ = 0;
+    std::vector<std::shared_ptr<const Tile>> tiles_;
+    int numReady_ = 0;
+};
+
+/**
+ * @brief One frame's Spectrogram bands: a Hann-windowed FFT_SIZE FFT, folded into NUM_BANDS
+ *
+ * Shared by the file analyser below and the live SpectrumAnalyser on audio taps.
+ */
+class SpectrumTransform {
+  public:
+    SpectrumTransform();
+
+    void setSampleRate(double sampleRate);
+
+    /**
+     * @brief Each band's loudest bin of FFT_SIZE samples, as a gain (a full-scale sine is 1)
+     */
+    void transform(const float* frame, float* bands);
+
+  private:
+    void fft(std::vector<std::complex<float>>& data) const;
+
+    std::vector<float> window_;
+    float windowGain_ = 1.0f;
+    std::vector<std::complex<float>> spectrum_;
+    std::vector<std::complex<float>> twiddles_;
+    std::vector<uint32_t> bitReversed_;
+    std::vector<int> bandFirstBin_;
+    std::vector<int> bandLastBin_;
+};
+
+/**
+ * @brief Computes a Spectrogram's tiles from audio fed in blocks
+ *
+ * begin(), any number of addSamples() blocks, then finish(). Completed tiles are collected
+ * with takeTiles() as they fill, so a background job can hand them over while it runs.
+ */
+class SpectralAnalyser {
+  public:
+    void begin(int numChannels, double sampleRate);
+    void addSamples(const float* const* channels, int numSamples);
+    void finish();
+
+    /** @brief Tiles completed since the last call, in order */
+    std::vector<std::shared_ptr<const Spectrogram::Tile>> takeTiles();
+
+  private:
+    void analyseFrame();
+    void flushTile();
+
+    int numChannels_ = 0;
+    double sampleRate_ = 0.0;
+    int64_t samplesIn_ = 0;
+    int64_t framesOut_ = 0;
+
+    SpectrumTransform transform_;
+    std::vector<float> input_;  // Mono samples from the start of the next frame's window
+    std::vector<float> bands_ = std::vector<float>(Spectrogram::NUM_BANDS);
+
+    std::shared_ptr<Spectrogram::Tile> tile_;  // Being filled
+    std::vector<std::shared_ptr<const Spectrogram::Tile>> ready_;
+};
+
+}  // namespace magda
@@ -0,0 +1,47 @@
+#include "SpectrumAnalyser.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace magda {
+
+SpectrumAnalyser::SpectrumAnalyser() {
+    transform_.setSampleRate(48000.0);
+}
+
+void SpectrumAnalyser::prepare(double sampleRate) {
+    transform_.setSampleRate(sampleRate > 0.0 ? sampleRate : 48000.0);
+    inputPosition_ = 0;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::fill(bands_.begin(), bands_.end(), kFloorDb);
+}
+
+void SpectrumAnalyser::process(const float* left, const float* right, int numSamples) {
+    for (int i = 0; i < numSamples; ++i) {
+        input_[static_cast<size_t>(inputPosition_++)] = 0.5f * (left[i] + right[i]);
+        if (inputPosition_ == Spectrogram::FFT_SIZE) {
+            analyseFrame();
+            // Half overlap: the second half starts the next frame
+            std::copy(input_.begin() + Spectrogram::HOP_SIZE, input_.end(), input_.begin());
+            inputPosition_ = Spectrogram::FFT_SIZE - Spectrogram::HOP_SIZE;
+        }
+    }
+}
+
+void SpectrumAnalyser::analyseFrame() {
+    transform_.transform(input_.data(), gains_.data());
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t band = 0; band < bands_.size(); ++band) {
+        const float db = std::max(kFloorDb, 20.0f * std::log10(std::max(gains_[band], 1.0e-9f)));
+        bands_[band] = std::max(db, bands_[band] - kReleaseDbPerFrame);
+    }
+}
+
+std::vector<float> SpectrumAnalyser::getBands() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return bands_;
+}
+
+}  // namespace magda
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <mutex>
+#include <vector>
+
+#include "AudioTaps.hpp"
+#include "Spectrogram.hpp"
+
+namespace magda {
+
+/**
+ * @brief Live spectrum of a tap, in Spectrogram's bands, for display
+ *
+ * The channels are summed and analysed in frames of Spectrogram::FFT_SIZE with half
+ * overlap, through the same SpectrumTransform as file spectrograms. Each band rises at
+ * once and falls back at kReleaseDbPerFrame, ready to be drawn as it is.
+ *
+ * Analysis thread writes, views read copies with getBands().
+ */
+class SpectrumAnalyser : public AudioTaps::Analyser {
+  public:
+    static constexpr int kNumBands = Spectrogram::NUM_BANDS;
+    static constexpr float kFloorDb = Spectrogram::MIN_DB;
+    static constexpr float kReleaseDbPerFrame = 1.5f;
+
+    SpectrumAnalyser();
+
+    void prepare(double sampleRate) override;
+    void process(const float* left, const float* right, int numSamples) override;
+
+    /**
+     * @brief Each band's level in dBFS, lowest frequency first
+     */
+    std::vector<float> getBands() const;
+
+  private:
+    void analyseFrame();
+
+    // Analysis thread
+    SpectrumTransform transform_;
+    std::vector<float> input_ = std::vector<float>(Spectrogram::FFT_SIZE);
+    int inputPosition_ = 0;
+    std::vector<float> gains_ = std::vector<float>(kNumBands);
+
+    mutable std::mutex mutex_;
+    std::vector<float> bands_ = std::vector<float>(kNumBands, kFloorDb);
+};
+
+}  // namespace magda
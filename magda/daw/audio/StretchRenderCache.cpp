@@ -0,0 +1,328 @@
+#include "StretchRenderCache.hpp"
+
+#include <tracktion_engine/tracktion_engine.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace magda {
+
+namespace te = tracktion;
+
+namespace {
+
+constexpr int kRenderBlockSize = 1024;
+constexpr int kTimerIntervalMs = 100;
+constexpr int kMaxFlushBlocks = 64;
+
+double stretchNow() {
+    return juce::Time::getMillisecondCounterHiRes() * 0.001;
+}
+
+}  // namespace
+
+// =============================================================================
+// RenderJob
+// =============================================================================
+
+/**
+ * @brief Stretches a whole source file on a pool thread and writes it out
+ */
+class StretchRenderCache::RenderJob : public juce::ThreadPoolJob {
+  public:
+    RenderJob(StretchRenderCache& cache, const juce::String& key, const juce::File& source,
+              double stretchFactor, const juce::File& output)
+        : juce::ThreadPoolJob("Render stretch"),
+          cache_(cache),
+          key_(key),
+          source_(source),
+          stretchFactor_(stretchFactor),
+          output_(output),
+          alive_(cache.alive_) {}
+
+    JobStatus runJob() override {
+        const bool succeeded = render();
+        if (!succeeded) {
+            output_.deleteFile();
+        }
+
+        auto* cache = &cache_;
+        auto alive = alive_;
+        auto key = key_;
+        auto output = output_;
+        juce::MessageManager::callAsync([cache, alive, key, output, succeeded]() {
+            if (alive->load()) {
+                cache->renderFinished(key, output, succeeded);
+            } else {
+                output.deleteFile();
+            }
+        });
+        return jobHasFinished;
+    }
+
+  private:
+    StretchRenderCache& cache_;
+    juce::String key_;
+    juce::File source_;
+    double stretchFactor_;
+    juce::File output_;
+    std::shared_ptr<std::atomic<bool>> alive_;
+
+    bool render() {
+        std::unique_ptr<juce::AudioFormatReader> reader(
+            cache_.formatManager_.createReaderFor(source_));
+        if (reader == nullptr || reader->numChannels == 0 || reader->lengthInSamples <= 0) {
+            return false;
+        }
+        const int numChannels = static_cast<int>(reader->numChannels);
+
+        // The Final quality stretcher (as a clip stretching live at Final runs): a render
+        // is made once, off the audio thread, so it can always have the best
+        te::TimeStretcher stretcher;
+        stretcher.initialise(reader->sampleRate, kRenderBlockSize, numChannels,
+                             te::TimeStretcher::defaultMode, {}, false);
+        if (!stretcher.isInitialised() ||
+            !stretcher.setSpeedAndPitch(static_cast<float>(1.0 / stretchFactor_), 0.0f)) {
+            return false;
+        }
+
+        if (!output_.getParentDirectory().createDirectory()) {
+            return false;
+        }
+        auto stream = output_.createOutputStream();
+        if (stream == nullptr) {
+            return false;
+        }
+        juce::WavAudioFormat wav;
+        std::unique_ptr<juce::AudioFormatWriter> writer(
+            wav.createWriterFor(stream.get(), reader->sampleRate,
+                                static_cast<unsigned int>(numChannels), 32, {}, 0));
+        if (writer == nullptr) {
+            return false;
+        }
+        stream.release();  // Owned by the writer now
+
+        // Exactly as long as the stretched source, whatever the stretcher's latency
+        const auto target = static_cast<juce::int64>(
+            std::llround(static_cast<double>(reader->lengthInSamples) * stretchFactor_));
+
+        juce::AudioBuffer<float> input(numChannels,
+                                       std::max(stretcher.getMaxFramesNeeded(), 1));
+        juce::AudioBuffer<float> output(numChannels, kRenderBlockSize);
+        juce::int64 readPos = 0;
+        juce::int64 written = 0;
+
+        auto write = [&](int numSamples) {
+            const auto count =
+                static_cast<int>(std::min<juce::int64>(numSamples, target - written));
+            if (count > 0) {
+                writer->writeFromAudioSampleBuffer(output, 0, count);
+                written += count;
+            }
+        };
+
+        while (written < target && readPos < reader->lengthInSamples) {
+            if (shouldExit()) {
+                return false;
+            }
+
+            const int needed = std::min(stretcher.getFramesNeeded(), input.getNumSamples());
+            const auto count =
+                static_cast<int>(std::min<juce::int64>(needed, reader->lengthInSamples - readPos));
+            input.clear();
+            if (count > 0) {
+                reader->read(&input, 0, count, readPos, true, true);
+                readPos += count;
+            }
+
+            const int produced = stretcher.processData(input.getArrayOfReadPointers(), needed,
+                                                       output.getArrayOfWritePointers());
+            if (needed <= 0 && produced <= 0) {
+                break;  // Stalled: the flush and padding below finish the file
+            }
+            write(produced);
+        }
+
+        for (int i = 0; i < kMaxFlushBlocks && written < target; ++i) {
+            const int produced = stretcher.flush(output.getArrayOfWritePointers());
+            if (produced <= 0) {
+                break;
+            }
+            write(produced);
+        }
+
+        output.clear();
+        while (written < target) {
+            write(kRenderBlockSize);
+        }
+        return writer->flush();
+    }
+};
+
+// =============================================================================
+// StretchRenderCache
+// =============================================================================
+
+StretchRenderCache::StretchRenderCache(std::function<void(ClipId)> onReady)
+    : onReady_(std::move(onReady)),
+      root_(juce::File::getSpecialLocation(juce::File::tempDirectory)
+                .getChildFile("MAGDA Stretch")
+                .getNonexistentChildFile("session", "", false)) {
+    formatManager_.registerBasicFormats();
+
+    // Stretching is CPU bound; leave most cores to playback
+    pool_ =
+        std::make_unique<juce::ThreadPool>(juce::jlimit(1, 2, juce::SystemStats::getNumCpus() / 4));
+}
+
+StretchRenderCache::~StretchRenderCache() {
+    stopTimer();
+    alive_->store(false);
+    pool_->removeAllJobs(true, 2000);
+    pool_.reset();
+    root_.deleteRecursively();
+}
+
+juce::File StretchRenderCache::getRender(ClipId clipId, const juce::File& source,
+                                         double stretchFactor) {
+    if (!needsRender(stretchFactor) || !source.existsAsFile()) {
+        release(clipId);
+        return {};
+    }
+
+    const auto key = getRenderKey(source, stretchFactor);
+    const auto it = clips_.find(clipId);
+    if (it == clips_.end() || it->second.key != key) {
+        release(clipId);
+
+        // Wait for the factor to settle unless another clip already has this render
+        Wanted wanted{key, source, stretchFactor, 0.0};
+        const auto render = renders_.find(key);
+        if (render != renders_.end()) {
+            ++render->second.users;
+        } else {
+            wanted.dueAt = stretchNow() + kSettleSeconds;
+            if (!isTimerRunning()) {
+                startTimer(kTimerIntervalMs);
+            }
+        }
+        clips_[clipId] = std::move(wanted);
+    }
+
+    const auto render = renders_.find(key);
+    if (render == renders_.end() || !render->second.ready) {
+        return {};
+    }
+    return render->second.file;
+}
+
+void StretchRenderCache::release(ClipId clipId) {
+    const auto it = clips_.find(clipId);
+    if (it == clips_.end()) {
+        return;
+    }
+    const bool queued = it->second.dueAt == 0.0;
+    const auto key = it->second.key;
+    clips_.erase(it);
+    if (queued) {
+        dropUser(key);
+    }
+}
+
+int StretchRenderCache::getNumRenders() const {
+    return static_cast<int>(std::count_if(renders_.begin(), renders_.end(),
+                                          [](const auto& entry) { return entry.second.ready; }));
+}
+
+bool StretchRenderCache::needsRender(double stretchFactor) {
+    // Matches the threshold AudioBridge uses to leave the speed ratio alone
+    return stretchFactor > 0.0 && std::abs(1.0 / stretchFactor - 1.0) > 0.001;
+}
+
+juce::String StretchRenderCache::getRenderKey(const juce::File& source, double stretchFactor) {
+    // Factors that differ by less than this are inaudible; rounding lets clips share renders
+    return source.getFullPathName() + "|" +
+           juce::String(source.getLastModificationTime().toMilliseconds()) + "|" +
+           juce::String(source.getSize()) + "|" + juce::String(stretchFactor, 4);
+}
+
+// =============================================================================
+// Rendering
+// =============================================================================
+
+void StretchRenderCache::timerCallback() {
+    const double now = stretchNow();
+    bool waiting = false;
+
+    for (auto& [clipId, wanted] : clips_) {
+        if (wanted.dueAt == 0.0) {
+            continue;
+        }
+        if (wanted.dueAt > now) {
+            waiting = true;
+            continue;
+        }
+
+        wanted.dueAt = 0.0;
+        auto render = renders_.find(wanted.key);
+        if (render == renders_.end()) {
+            startRender(wanted);
+            render = renders_.find(wanted.key);
+        }
+        ++render->second.users;
+        if (render->second.ready) {
+            onReady_(clipId);
+        }
+    }
+
+    if (!waiting) {
+        stopTimer();
+    }
+}
+
+void StretchRenderCache::startRender(const Wanted& wanted) {
+    Render render;
+    render.file = root_.getChildFile("stretch_" + juce::String(nextRenderId_++) + ".wav");
+    pool_->addJob(
+        new RenderJob(*this, wanted.key, wanted.source, wanted.stretchFactor, render.file), true);
+    renders_[wanted.key] = std::move(render);
+}
+
+void StretchRenderCache::renderFinished(const juce::String& key, const juce::File& output,
+                                        bool succeeded) {
+    const auto it = renders_.find(key);
+    if (it == renders_.end() || it->second.file != output) {
+        output.deleteFile();  // Nobody wanted it by the time it finished
+        return;
+    }
+
+    if (!succeeded) {
+        // Left in place so the clips stay live instead of retrying on every sync
+        DBG("StretchRenderCache: couldn't render " << key);
+        it->second.failed = true;
+        return;
+    }
+
+    it->second.ready = true;
+    for (const auto& [clipId, wanted] : clips_) {
+        if (wanted.key == key && wanted.dueAt == 0.0) {
+            onReady_(clipId);
+        }
+    }
+}
+
+void StretchRenderCache::dropUser(const juce::String& key) {
+    const auto it = renders_.find(key);
+    if (it == renders_.end() || --it->second.users > 0) {
+        return;
+    }
+
+    // A render still running finds its entry gone and deletes its own file. A finished one
+    // the engine still has open (on Windows) goes with root_
+    if (it->second.ready) {
+        it->second.file.deleteFile();
+    }
+    renders_.erase(it);
+}
+
+}  // namespace magda
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_events/juce_events.h>
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <unordered_map>
+
+#include "../core/TypeIds.hpp"
+
+namespace magda {
+
+/**
+ * @brief Renders stretched audio sources to disk in the background so they play without a
+ *        real-time time-stretcher
+ *
+ * AudioBridge asks for the render of each stretched clip's source every time it syncs the
+ * clip. A stretch factor that keeps changing (an edge being dragged) only restarts the
+ * settle delay; once it has held for kSettleSeconds, the whole source file is stretched on a
+ * pool thread with the engine's default stretcher and written as 32-bit float. Until the
+ * render is ready, and for a clip whose stretch changes again, the clip stretches in real
+ * time as before. Clips stretching the same file by the same factor share one render.
+ *
+ * Renders live in a temporary directory for this session, removed on destruction. Message
+ * thread only.
+ */
+class StretchRenderCache : private juce::Timer {
+  public:
+    /**
+     * @param onReady Called with each clip whose render has just become available
+     */
+    explicit StretchRenderCache(std::function<void(ClipId)> onReady);
+    ~StretchRenderCache() override;
+
+    /**
+     * @brief The clip's render of source at stretchFactor, queuing it if there isn't one
+     * @return The rendered file, or an invalid File while the clip has to stretch live
+     */
+    juce::File getRender(ClipId clipId, const juce::File& source, double stretchFactor);
+
+    /**
+     * @brief The clip no longer plays a stretched source (deleted, or back to 1.0)
+     */
+    void release(ClipId clipId);
+
+    int getNumRenders() const;
+
+    /**
+     * @brief Whether a source at this factor is stretched at all
+     */
+    static bool needsRender(double stretchFactor);
+
+    /**
+     * @brief Identifies a render: the source as it is on disk, and the factor
+     */
+    static juce::String getRenderKey(const juce::File& source, double stretchFactor);
+
+    // How long a stretch factor holds before it is rendered
+    static constexpr double kSettleSeconds = 0.75;
+
+  private:
+    class RenderJob;
+
+    struct Render {
+        juce::File file;
+        bool ready = false;
+        bool failed = false;
+        int users = 0;
+    };
+
+    struct Wanted {
+        juce::String key;
+        juce::File source;
+        double stretchFactor = 1.0;
+        double dueAt = 0.0;  // Settle deadline, 0 once queued
+    };
+
+    std::function<void(ClipId)> onReady_;
+    juce::AudioFormatManager formatManager_;
+    juce::File root_;
+    int nextRenderId_ = 1;
+    std::map<juce::String, Render> renders_;
+    std::unordered_map<ClipId, Wanted> clips_;
+    std::unique_ptr<juce::ThreadPool> pool_;
+    std::shared_ptr<std::atomic<bool>> alive_ = std::make_shared<std::atomic<bool>>(true);
+
+    void timerCallback() override;
+    void startRender(const Wanted& wanted);
+    void renderFinished(const juce::String& key, const juce::File& output, bool succeeded);
+    void dropUser(const juce::String& key);
+};
+
+}  // namespace magda
@@ -0,0 +1,308 @@
+#include "TempoAnalysis.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+namespace magda {
+
+namespace {
+constexpr char kMagic[4] = {'M', 'T', 'P', '1'};
+constexpr double kPi = 3.14159265358979323846;
+
+constexpr double kSplitFrequency = 200.0;    // Between the low and high bands
+constexpr float kFloorDb = -80.0f;           // Quieter than this counts as silence
+constexpr float kMinRiseDb = 3.0f;           // Smaller rises are never onsets
+constexpr float kRelativeThreshold = 0.1f;   // Above the neighbourhood, as a share of the peak
+constexpr int kPeakRadius = 3;               // Hops an onset must be the highest within
+constexpr int kNeighbourhood = 10;           // Hops either side averaged for the threshold
+constexpr double kPreferredBpm = 120.0;
+constexpr double kPreferenceOctaves = 1.0;   // Width of the preference around it
+constexpr float kMinConfidence = 0.1f;
+constexpr int kMaxPeriodMultiple = 8;        // Furthest multiple of the period refined at
+constexpr double kLoopSnapBeats = 0.25;      // How far from a bar line a loop may end
+constexpr double kLoopSnapTolerance = 0.03;  // Relative tempo difference
+
+template <typename T>
+void append(std::vector<char>& out, const T& value) {
+    const auto* bytes = reinterpret_cast<const char*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T>
+bool extract(const char*& data, const char* end, T& value) {
+    if (static_cast<size_t>(end - data) < sizeof(T))
+        return false;
+    std::memcpy(&value, data, sizeof(T));
+    data += sizeof(T);
+    return true;
+}
+
+float toDb(double energy, int count) {
+    const double power = count > 0 ? energy / count : 0.0;
+    return std::max(kFloorDb, static_cast<float>(10.0 * std::log10(std::max(power, 1.0e-12))));
+}
+}  // namespace
+
+// =============================================================================
+// TempoAnalysis
+// =============================================================================
+
+size_t TempoAnalysis::findOnset(double seconds) const {
+    return static_cast<size_t>(std::lower_bound(onsets.begin(), onsets.end(), seconds) -
+                               onsets.begin());
+}
+
+void TempoAnalysis::serialise(std::vector<char>& out) const {
+    out.clear();
+    out.insert(out.end(), kMagic, kMagic + sizeof(kMagic));
+    append(out, static_cast<int32_t>(TempoAnalyser::HOP_SIZE));
+    append(out, sampleRate);
+    append(out, static_cast<int64_t>(lengthInSamples));
+    append(out, bpm);
+    append(out, confidence);
+    append(out, static_cast<uint32_t>(onsets.size()));
+    for (size_t i = 0; i < onsets.size(); ++i) {
+        append(out, onsets[i]);
+        append(out, i < onsetStrengths.size() ? onsetStrengths[i] : 1.0f);
+    }
+}
+
+bool TempoAnalysis::deserialise(const void* data, size_t size) {
+    const auto* pos = static_cast<const char*>(data);
+    const auto* end = pos + size;
+
+    if (size < sizeof(kMagic) || std::memcmp(pos, kMagic, sizeof(kMagic)) != 0)
+        return false;
+    pos += sizeof(kMagic);
+
+    int32_t hopSize = 0;
+    TempoAnalysis loaded;
+    uint32_t numOnsets = 0;
+    if (!extract(pos, end, hopSize) || hopSize != TempoAnalyser::HOP_SIZE ||
+        !extract(pos, end, loaded.sampleRate) || !extract(pos, end, loaded.lengthInSamples) ||
+        !extract(pos, end, loaded.bpm) || !extract(pos, end, loaded.confidence) ||
+        !extract(pos, end, numOnsets) || loaded.sampleRate <= 0.0 ||
+        loaded.lengthInSamples < 0) {
+        return false;
+    }
+
+    // Checked before allocating, so a corrupt count can't allocate much
+    constexpr size_t onsetBytes = sizeof(double) + sizeof(float);
+    if (static_cast<size_t>(end - pos) != numOnsets * onsetBytes)
+        return false;
+
+    loaded.onsets.resize(numOnsets);
+    loaded.onsetStrengths.resize(numOnsets);
+    for (uint32_t i = 0; i < numOnsets; ++i) {
+        extract(pos, end, loaded.onsets[i]);
+        extract(pos, end, loaded.onsetStrengths[i]);
+    }
+
+    *this = std::move(loaded);
+    return true;
+}
+
+// =============================================================================
+// TempoAnalyser
+// =============================================================================
+
+void TempoAnalyser::begin(int numChannels, double sampleRate) {
+    numChannels_ = std::max(1, numChannels);
+    sampleRate_ = sampleRate;
+    samplesIn_ = 0;
+    lowpassCoefficient_ =
+        static_cast<float>(1.0 - std::exp(-2.0 * kPi * kSplitFrequency / sampleRate));
+    lowpassState_ = 0.0f;
+    lowEnergy_ = 0.0;
+    highEnergy_ = 0.0;
+    hopFill_ = 0;
+    lastLowDb_ = kFloorDb;
+    lastHighDb_ = kFloorDb;
+    flux_.clear();
+}
+
+void TempoAnalyser::addSamples(const float* const* channels, int numSamples) {
+    const float channelGain = 1.0f / static_cast<float>(numChannels_);
+    for (int i = 0; i < numSamples; ++i) {
+        float mono = 0.0f;
+        for (int ch = 0; ch < numChannels_; ++ch) {
+            mono += channels[ch][i];
+        }
+        mono *= channelGain;
+
+        lowpassState_ += lowpassCoefficient_ * (mono - lowpassState_);
+        const float high = mono - lowpassState_;
+        lowEnergy_ += static_cast<double>(lowpassState_) * lowpassState_;
+        highEnergy_ += static_cast<double>(high) * high;
+
+        if (++hopFill_ == HOP_SIZE) {
+            endHop();
+        }
+    }
+    samplesIn_ += numSamples;
+}
+
+void TempoAnalyser::endHop() {
+    // The rise in each band's level, so a hit in either band counts ...
+    const float lowDb = toDb(lowEnergy_, hopFill_);
+    const float highDb = toDb(highEnergy_, hopFill_);
+    flux_.push_back(std::max(0.0f, lowDb - lastLowDb_) + std::max(0.0f, highDb - lastHighDb_));
+
+    // ... and falls don't
+    lastLowDb_ = lowDb;
+    lastHighDb_ = highDb;
+    lowEnergy_ = 0.0;
+    highEnergy_ = 0.0;
+    hopFill_ = 0;
+}
+
+TempoAnalysis TempoAnalyser::finish() {
+    if (hopFill_ > 0) {
+        endHop();
+    }
+
+    TempoAnalysis analysis;
+    analysis.sampleRate = sampleRate_;
+    analysis.lengthInSamples = samplesIn_;
+    if (sampleRate_ > 0.0) {
+        pickOnsets(analysis);
+        estimateTempo(analysis);
+    }
+    flux_.clear();
+    return analysis;
+}
+
+void TempoAnalyser::pickOnsets(TempoAnalysis& analysis) const {
+    const float peak =
+        flux_.empty() ? 0.0f : *std::max_element(flux_.begin(), flux_.end());
+    if (peak < kMinRiseDb)
+        return;
+
+    const int numHops = static_cast<int>(flux_.size());
+    const auto minGap = static_cast<int>(std::ceil(MIN_ONSET_GAP_SECONDS * sampleRate_ / HOP_SIZE));
+    int lastOnset = -minGap;
+    for (int hop = 0; hop < numHops; ++hop) {
+        const float value = flux_[static_cast<size_t>(hop)];
+        if (value < kMinRiseDb || hop - lastOnset < minGap)
+            continue;
+
+        bool highest = true;
+        for (int other = std::max(0, hop - kPeakRadius);
+             highest && other <= std::min(numHops - 1, hop + kPeakRadius); ++other) {
+            // Ties go to the earlier hop
+            const float otherValue = flux_[static_cast<size_t>(other)];
+            highest = other < hop ? otherValue < value : otherValue <= value;
+        }
+        if (!highest)
+            continue;
+
+        const int first = std::max(0, hop - kNeighbourhood);
+        const int last = std::min(numHops - 1, hop + kNeighbourhood);
+        double sum = 0.0;
+        for (int other = first; other <= last; ++other) {
+            sum += flux_[static_cast<size_t>(other)];
+        }
+        const auto mean = static_cast<float>(sum / (last - first + 1));
+        if (value < mean + kRelativeThreshold * peak)
+            continue;
+
+        analysis.onsets.push_back(static_cast<double>(hop) * HOP_SIZE / sampleRate_);
+        analysis.onsetStrengths.push_back(value / peak);
+        lastOnset = hop;
+    }
+}
+
+void TempoAnalyser::estimateTempo(TempoAnalysis& analysis) const {
+    if (static_cast<int>(analysis.onsets.size()) < MIN_ONSETS)
+        return;
+
+    const double hopsPerSecond = sampleRate_ / HOP_SIZE;
+    const int minLag = std::max(1, static_cast<int>(std::floor(60.0 * hopsPerSecond / MAX_BPM)));
+    const int maxLag = static_cast<int>(std::ceil(60.0 * hopsPerSecond / MIN_BPM));
+    const int numHops = static_cast<int>(flux_.size());
+    if (maxLag + 1 >= numHops)
+        return;  // Too short for a beat at the slowest tempo
+
+    double sum = 0.0;
+    for (const auto value : flux_) {
+        sum += value;
+    }
+    const auto mean = static_cast<float>(sum / numHops);
+
+    // Autocorrelation of the onset curve, per overlapping hop so long lags aren't penalised
+    auto correlation = [&](int lag) {
+        double total = 0.0;
+        for (int hop = lag; hop < numHops; ++hop) {
+            total += static_cast<double>(flux_[static_cast<size_t>(hop)] - mean) *
+                     (flux_[static_cast<size_t>(hop - lag)] - mean);
+        }
+        return total / (numHops - lag);
+    };
+    const double energy = correlation(0);
+    if (energy <= 0.0)
+        return;
+
+    // The strongest period, favouring tempos near the preferred one over their multiples
+    int bestLag = 0;
+    double bestScore = 0.0;
+    double bestCorrelation = 0.0;
+    for (int lag = minLag; lag <= maxLag; ++lag) {
+        const double octaves = std::log2(60.0 * hopsPerSecond / lag / kPreferredBpm);
+        const double weight =
+            std::exp(-0.5 * (octaves / kPreferenceOctaves) * (octaves / kPreferenceOctaves));
+        const double r = correlation(lag);
+        if (r * weight > bestScore) {
+            bestScore = r * weight;
+            bestLag = lag;
+            bestCorrelation = r;
+        }
+    }
+    if (bestLag == 0)
+        return;
+
+    const auto confidence = static_cast<float>(std::clamp(bestCorrelation / energy, 0.0, 1.0));
+    if (confidence < kMinConfidence)
+        return;
+
+    // Between hops, from the parabola through the nearest peak and its neighbours
+    auto peakNear = [&](double lag) {
+        int best = static_cast<int>(std::lround(lag));
+        for (const int candidate : {best - 1, best + 1}) {
+            if (correlation(candidate) > correlation(best))
+                best = candidate;
+        }
+        const double before = correlation(best - 1);
+        const double at = correlation(best);
+        const double after = correlation(best + 1);
+        const double curvature = before - 2.0 * at + after;
+        return curvature < 0.0 ? best + std::clamp(0.5 * (before - after) / curvature, -0.5, 0.5)
+                               : static_cast<double>(best);
+    };
+
+    // Refined at multiples of the period, where a hop is a smaller share of it
+    double lag = peakNear(bestLag);
+    for (int multiple = 2; multiple <= kMaxPeriodMultiple; ++multiple) {
+        if (multiple * lag + 2.0 >= numHops / 2.0)
+            break;
+        lag = peakNear(multiple * lag) / multiple;
+    }
+    double bpm = 60.0 * hopsPerSecond / lag;
+
+    // A loop is a whole number of bars long: if it ends close to a bar, that's the exact tempo
+    const double lengthSeconds = analysis.getLengthSeconds();
+    const double beats = lengthSeconds * bpm / 60.0;
+    const double bars = std::round(beats / BEATS_PER_BAR);
+    if (bars >= 1.0 && std::abs(beats - bars * BEATS_PER_BAR) <= kLoopSnapBeats) {
+        const double loopBpm = bars * BEATS_PER_BAR * 60.0 / lengthSeconds;
+        if (std::abs(loopBpm - bpm) <= kLoopSnapTolerance * bpm) {
+            bpm = loopBpm;
+        }
+    }
+
+    analysis.bpm = bpm;
+    analysis.confidence = confidence;
+}
+
+}  // namespace magda
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace magda {
+
+/**
+ * @brief Tempo and transients detected in an audio file
+ *
+ * Onsets are the starts of notes and hits, in seconds from the start of the file, each with
+ * its strength (0-1, relative to the strongest). bpm is the file's steady tempo, or 0 if it
+ * has none worth warping to (too few onsets, or no regular pulse between them).
+ */
+struct TempoAnalysis {
+    double sampleRate = 0.0;
+    int64_t lengthInSamples = 0;
+    double bpm = 0.0;
+    float confidence = 0.0f;  // 0-1: how strongly the onsets repeat at bpm
+    std::vector<double> onsets;
+    std::vector<float> onsetStrengths;
+
+    bool hasTempo() const {
+        return bpm > 0.0;
+    }
+
+    double getLengthSeconds() const {
+        return sampleRate > 0.0 ? static_cast<double>(lengthInSamples) / sampleRate : 0.0;
+    }
+
+    /**
+     * @brief The AudioSource stretch factor that plays the file at projectBpm (1 if no tempo)
+     */
+    double getStretchFactorFor(double projectBpm) const {
+        return hasTempo() && projectBpm > 0.0 ? bpm / projectBpm : 1.0;
+    }
+
+    /**
+     * @brief Index of the first onset at or after seconds (onsets.size() if none)
+     */
+    size_t findOnset(double seconds) const;
+
+    // =========================================================================
+    // Serialization (native byte order - the data is a local cache)
+    // =========================================================================
+
+    void serialise(std::vector<char>& out) const;
+    bool deserialise(const void* data, size_t size);
+};
+
+/**
+ * @brief Detects onsets and tempo in audio fed in blocks
+ *
+ * begin(), any number of addSamples() blocks, then finish(). The channels are mixed to mono
+ * and split at about 200 Hz; an onset is a peak in the summed rise of the two bands' log
+ * energy, HOP_SIZE samples at a time, that stands out from its neighbourhood. The tempo is
+ * the strongest period of that onset curve between MIN_BPM and MAX_BPM, favouring tempos
+ * near 120, then snapped to a whole number of bars if the file is a loop of about that tempo.
+ *
+ * Only the onset curve is kept (one float per hop), so a long file costs little memory.
+ */
+class TempoAnalyser {
+  public:
+    static constexpr int HOP_SIZE = 512;
+    static constexpr double MIN_BPM = 60.0;
+    static constexpr double MAX_BPM = 200.0;
+    static constexpr double MIN_ONSET_GAP_SECONDS = 0.05;
+    static constexpr int MIN_ONSETS = 4;  // Fewer and no tempo is reported
+    static constexpr int BEATS_PER_BAR = 4;
+
+    void begin(int numChannels, double sampleRate);
+    void addSamples(const float* const* channels, int numSamples);
+    TempoAnalysis finish();
+
+  private:
+    void endHop();
+    void pickOnsets(TempoAnalysis& analysis) const;
+    void estimateTempo(TempoAnalysis& analysis) const;
+
+    int numChannels_ = 0;
+    double sampleRate_ = 0.0;
+    int64_t samplesIn_ = 0;
+
+    float lowpassCoefficient_ = 0.0f;
+    float lowpassState_ = 0.0f;
+    double lowEnergy_ = 0.0;  // Of the hop so far
+    double highEnergy_ = 0.0;
+    int hopFill_ = 0;
+    float lastLowDb_ = 0.0f;
+    float lastHighDb_ = 0.0f;
+    std::vector<float> flux_;  // Onset curve, one value per hop
+};
+
+}  // namespace magda
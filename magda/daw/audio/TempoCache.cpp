@@ -0,0 +1,211 @@
+#include "TempoCache.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#include "AudioThumbnailManager.hpp"
+
+namespace magda {
+
+namespace {
+constexpr int kAnalysisBlockSize = 65536;
+}  // namespace
+
+// =============================================================================
+// AnalysisJob
+// =============================================================================
+
+/**
+ * @brief Detects a file's tempo and transients on a pool thread
+ */
+class TempoCache::AnalysisJob : public juce::ThreadPoolJob {
+  public:
+    AnalysisJob(juce::AudioFormatManager& formatManager, const juce::String& audioFilePath,
+                juce::int64 peakHash, std::shared_ptr<std::atomic<bool>> alive)
+        : juce::ThreadPoolJob("Analyse tempo"),
+          formatManager_(formatManager),
+          audioFilePath_(audioFilePath),
+          peakHash_(peakHash),
+          alive_(std::move(alive)) {}
+
+    JobStatus runJob() override {
+        std::shared_ptr<const TempoAnalysis> result;
+        std::unique_ptr<juce::AudioFormatReader> reader(
+            formatManager_.createReaderFor(juce::File(audioFilePath_)));
+        if (reader != nullptr && reader->numChannels > 0 && reader->sampleRate > 0.0) {
+            const int numChannels = static_cast<int>(reader->numChannels);
+            TempoAnalyser analyser;
+            analyser.begin(numChannels, reader->sampleRate);
+
+            juce::AudioBuffer<float> buffer(numChannels, kAnalysisBlockSize);
+            for (juce::int64 pos = 0; pos < reader->lengthInSamples; pos += kAnalysisBlockSize) {
+                if (shouldExit())
+                    return jobHasFinished;
+
+                const auto count = static_cast<int>(
+                    std::min<juce::int64>(kAnalysisBlockSize, reader->lengthInSamples - pos));
+                reader->read(&buffer, 0, count, pos, true, true);
+                analyser.addSamples(buffer.getArrayOfReadPointers(), count);
+            }
+
+            auto analysis = std::make_shared<TempoAnalysis>(analyser.finish());
+            saveTempo(juce::File(audioFilePath_), *analysis);
+            result = std::move(analysis);
+        }
+
+        auto alive = alive_;
+        auto path = audioFilePath_;
+        auto hash = peakHash_;
+        juce::MessageManager::callAsync([alive, path, hash, result]() {
+            if (alive->load()) {
+                TempoCache::getInstance().analysisReady(path, hash, result);
+            }
+        });
+        return jobHasFinished;
+    }
+
+  private:
+    juce::AudioFormatManager& formatManager_;
+    juce::String audioFilePath_;
+    juce::int64 peakHash_;
+    std::shared_ptr<std::atomic<bool>> alive_;
+};
+
+// =============================================================================
+// TempoCache
+// =============================================================================
+
+TempoCache::TempoCache() {
+    formatManager_.registerBasicFormats();
+
+    // One thread: analysis is CPU-bound and never urgent
+    analysisPool_ = std::make_unique<juce::ThreadPool>(1);
+}
+
+TempoCache& TempoCache::getInstance() {
+    static TempoCache instance;
+    return instance;
+}
+
+juce::File TempoCache::getTempoFile(juce::int64 peakHash) {
+    return AudioThumbnailManager::getPeakCacheDirectory().getChildFile(
+        juce::String::toHexString(peakHash) + ".tempo");
+}
+
+bool TempoCache::hasTempo(const juce::File& audioFile) {
+    return getTempoFile(AudioThumbnailManager::getPeakHash(audioFile)).existsAsFile();
+}
+
+std::shared_ptr<const TempoAnalysis> TempoCache::loadTempoFile(const juce::File& file) {
+    if (!file.existsAsFile()) {
+        return nullptr;
+    }
+
+    juce::MemoryBlock data;
+    auto analysis = std::make_shared<TempoAnalysis>();
+    if (!file.loadFileAsData(data) || !analysis->deserialise(data.getData(), data.getSize())) {
+        file.deleteFile();  // Corrupt or from an incompatible version
+        return nullptr;
+    }
+
+    // Touch so pruning keeps recently used files
+    file.setLastModificationTime(juce::Time::getCurrentTime());
+    return analysis;
+}
+
+void TempoCache::saveTempo(const juce::File& audioFile, const TempoAnalysis& analysis) {
+    const auto file = getTempoFile(AudioThumbnailManager::getPeakHash(audioFile));
+    auto directory = file.getParentDirectory();
+    if (!directory.isDirectory() && !directory.createDirectory()) {
+        return;
+    }
+
+    std::vector<char> data;
+    analysis.serialise(data);
+
+    // Write to a temporary file first so a crash never leaves a truncated file
+    juce::TemporaryFile temp(file);
+    if (temp.getFile().replaceWithData(data.data(), data.size())) {
+        temp.overwriteTargetFileWithTemporary();
+    }
+}
+
+std::shared_ptr<const TempoAnalysis> TempoCache::getAnalysis(const juce::String& audioFilePath) {
+    auto it = sources_.find(audioFilePath);
+    if (it != sources_.end()) {
+        return it->second.analysis;
+    }
+
+    juce::File audioFile(audioFilePath);
+    if (!analysisPool_ || !audioFile.existsAsFile()) {
+        return nullptr;  // Shut down, or nothing to analyse
+    }
+
+    Source source;
+    source.peakHash = AudioThumbnailManager::getPeakHash(audioFile);
+
+    // An analysis from the import, or an earlier session, is ready straight away
+    source.analysis = loadTempoFile(getTempoFile(source.peakHash));
+    if (source.analysis == nullptr) {
+        source.analysing = true;
+        analysisPool_->addJob(
+            new AnalysisJob(formatManager_, audioFilePath, source.peakHash, alive_), true);
+    }
+
+    auto analysis = source.analysis;
+    sources_[audioFilePath] = std::move(source);
+    return analysis;
+}
+
+void TempoCache::addAnalysis(const juce::File& audioFile,
+                             std::shared_ptr<const TempoAnalysis> analysis) {
+    if (analysis == nullptr) {
+        return;
+    }
+
+    auto& source = sources_[audioFile.getFullPathName()];
+    source.peakHash = AudioThumbnailManager::getPeakHash(audioFile);
+    source.analysis = std::move(analysis);
+    analysisChanged_.sendChangeMessage();
+}
+
+void TempoCache::analysisReady(const juce::String& audioFilePath, juce::int64 peakHash,
+                               std::shared_ptr<const TempoAnalysis> analysis) {
+    auto it = sources_.find(audioFilePath);
+    if (it == sources_.end() || it->second.peakHash != peakHash) {
+        return;  // Cleared, or the file changed since
+    }
+
+    // A file that couldn't be read stays without an analysis rather than being retried
+    it->second.analysing = false;
+    if (it->second.analysis == nullptr) {
+        it->second.analysis = std::move(analysis);
+    }
+    analysisChanged_.sendChangeMessage();
+}
+
+void TempoCache::addListener(juce::ChangeListener* listener) {
+    analysisChanged_.addChangeListener(listener);
+}
+
+void TempoCache::removeListener(juce::ChangeListener* listener) {
+    analysisChanged_.removeChangeListener(listener);
+}
+
+void TempoCache::clearCache() {
+    if (analysisPool_) {
+        analysisPool_->removeAllJobs(true, 2000);
+    }
+    sources_.clear();
+}
+
+void TempoCache::shutdown() {
+    alive_->store(false);
+    if (analysisPool_) {
+        analysisPool_->removeAllJobs(true, 2000);
+        analysisPool_.reset();
+    }
+    sources_.clear();
+}
+
+}  // namespace magda
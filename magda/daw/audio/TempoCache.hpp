@@ -0,0 +1,87 @@
+#pragma once
+
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_events/juce_events.h>
+
+#include <atomic>
+#include <map>
+#include <memory>
+
+#include "TempoAnalysis.hpp"
+
+namespace magda {
+
+/**
+ * @brief Tempo and transients of audio files, detected in the background and kept on disk
+ *
+ * AudioFileImporter detects them in the same pass that builds a file's peaks and writes them
+ * beside the peaks, under the same key (AudioThumbnailManager::getPeakHash), so they are
+ * ready by the time the file's clip exists. A file that wasn't imported, or whose analysis
+ * was pruned, is analysed on a low-priority thread the first time it is asked for, and
+ * listeners are told once it is ready.
+ *
+ * Analyses are small (a few numbers per onset), so every one asked for stays resident and
+ * later lookups - on a clip drop or a tempo change - are a map lookup. Message thread only,
+ * apart from the static file functions, which the importer calls from its pool threads.
+ */
+class TempoCache {
+  public:
+    static TempoCache& getInstance();
+
+    /**
+     * @brief The analysis of a file, starting it if there is none yet
+     * @return Nullptr while it is being analysed or if the file can't be read
+     */
+    std::shared_ptr<const TempoAnalysis> getAnalysis(const juce::String& audioFilePath);
+
+    /**
+     * @brief Keep an analysis made elsewhere (the importer's) for a file
+     */
+    void addAnalysis(const juce::File& audioFile, std::shared_ptr<const TempoAnalysis> analysis);
+
+    /**
+     * @brief Be told (on the message thread) when an analysis finishes
+     */
+    void addListener(juce::ChangeListener* listener);
+    void removeListener(juce::ChangeListener* listener);
+
+    void clearCache();
+
+    /**
+     * @brief Stop the analysis jobs and release all resources (app shutdown)
+     */
+    void shutdown();
+
+    static bool hasTempo(const juce::File& audioFile);
+    static void saveTempo(const juce::File& audioFile, const TempoAnalysis& analysis);
+    static juce::File getTempoFile(juce::int64 peakHash);
+
+  private:
+    TempoCache();
+    ~TempoCache() = default;
+
+    struct Source {
+        juce::int64 peakHash = 0;
+        std::shared_ptr<const TempoAnalysis> analysis;  // Null until analysed
+        bool analysing = false;
+    };
+
+    class AnalysisJob;
+
+    void analysisReady(const juce::String& audioFilePath, juce::int64 peakHash,
+                       std::shared_ptr<const TempoAnalysis> analysis);
+
+    static std::shared_ptr<const TempoAnalysis> loadTempoFile(const juce::File& file);
+
+    juce::AudioFormatManager formatManager_;
+    std::map<juce::String, Source> sources_;
+    std::unique_ptr<juce::ThreadPool> analysisPool_;
+    juce::ChangeBroadcaster analysisChanged_;
+
+    // Validity flag for async callbacks - set to false in shutdown()
+    std::shared_ptr<std::atomic<bool>> alive_ = std::make_shared<std::atomic<bool>>(true);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TempoCache)
+};
+
+}  // namespace magda
@@ -0,0 +1,116 @@
+#include "TrackMeterPlugin.hpp"
+
+#include <algorithm>
+#include <thread>
+
+#include "../profiling/RealtimeSafety.hpp"
+#include "RenderThreadPolicy.hpp"
+
+namespace magda {
+
+const char* TrackMeterPlugin::xmlTypeName = "magdatrackmeter";
+
+TrackMeterPlugin::TrackMeterPlugin(te::PluginCreationInfo info) : te::LevelMeterPlugin(info) {}
+
+TrackMeterPlugin::~TrackMeterPlugin() {
+    setMeteringTarget(nullptr, INVALID_TRACK_ID);
+}
+
+juce::ValueTree TrackMeterPlugin::create() {
+    juce::ValueTree v(te::IDs::PLUGIN);
+    v.setProperty(te::IDs::type, xmlTypeName, nullptr);
+    return v;
+}
+
+void TrackMeterPlugin::setMeteringTarget(MeteringBuffer* buffer, TrackId trackId,
+                                         SidechainBus* sidechain, AudioTaps* taps) {
+    // Clear the old targets first so a push can't pair them with the new track ID
+    target_.store(nullptr);
+    sidechain_.store(nullptr);
+    taps_.store(nullptr);
+    while (pushing_.load())
+        std::this_thread::yield();
+
+    targetTrackId_.store(trackId);
+    sidechain_.store(sidechain);
+    taps_.store(taps);
+    target_.store(buffer);
+}
+
+void TrackMeterPlugin::initialise(const te::PluginInitialisationInfo& info) {
+    te::LevelMeterPlugin::initialise(info);
+
+    // Graph rebuilds and buffer size changes initialise again at the same rate; the meter
+    // and the sidechain envelope carry on through those rather than dropping to zero
+    if (info.sampleRate == preparedSampleRate_)
+        return;
+    preparedSampleRate_ = info.sampleRate;
+
+    rms_ = RMSAccumulator(std::max(1, static_cast<int>(info.sampleRate / kPushRateHz)));
+    detector_.reset();
+    sampleRate_ = info.sampleRate > 0.0 ? info.sampleRate : 44100.0;
+}
+
+void TrackMeterPlugin::applyToBuffer(const te::PluginRenderContext& fc) {
+    ScopedRealtimeContext realtime;
+
+    // Every track has one of these, so each of the engine's render threads passes through
+    RenderThreadPolicy::getInstance().applyToCurrentThread();
+
+    te::LevelMeterPlugin::applyToBuffer(fc);
+
+    if (fc.destBuffer == nullptr || fc.bufferNumSamples <= 0)
+        return;
+
+    const int numChannels = fc.destBuffer->getNumChannels();
+    if (numChannels == 0)
+        return;
+
+    const bool truePeak = truePeak_.load(std::memory_order_relaxed);
+    if (truePeak != rms_.isTruePeak())
+        rms_.setTruePeak(truePeak);
+
+    // Peak and RMS for every channel in one pass (mono meters the same signal on both sides)
+    const float* channels[kMaxMeteredChannels];
+    const int numMetered = std::min(numChannels, kMaxMeteredChannels);
+    for (int ch = 0; ch < numMetered; ++ch)
+        channels[ch] = fc.destBuffer->getReadPointer(ch, fc.bufferStartSample);
+    rms_.addBlock(channels, numMetered, fc.bufferNumSamples);
+
+    // Announce the push before reading the targets; setMeteringTarget() waits on it
+    pushing_.store(true);
+    const auto trackId = targetTrackId_.load(std::memory_order_relaxed);
+    auto* sidechain = sidechain_.load();
+    const bool listened = sidechain != nullptr && sidechain->isListening(trackId);
+    if (listened) {
+        // Restarted, so an average from before the pause can't fake an onset
+        if (!detectorRunning_)
+            detector_.reset();
+        sidechain->publish(trackId, detector_.process(channels, numMetered, fc.bufferNumSamples,
+                                                      sampleRate_));
+    }
+    detectorRunning_ = listened;
+
+    if (auto* taps = taps_.load())
+        taps->write(trackId, channels, numMetered, fc.bufferNumSamples, sampleRate_);
+
+    if (!rms_.isWindowComplete()) {
+        pushing_.store(false, std::memory_order_release);
+        return;
+    }
+
+    MeterData data;
+    data.peakL = rms_.getPeakL();
+    data.peakR = rms_.getPeakR();
+    data.rmsL = rms_.getRMSL();
+    data.rmsR = rms_.getRMSR();
+    data.clipped = data.peakL > 1.0f || data.peakR > 1.0f;
+
+    rms_.reset();
+
+    if (auto* buffer = target_.load())
+        buffer->pushLevels(trackId, data);
+    pushing_.store(false, std::memory_order_release);
+}
+
+}  // namespace magda
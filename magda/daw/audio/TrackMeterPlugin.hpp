@@ -0,0 +1,92 @@
+#pragma once
+
+#include <tracktion_engine/tracktion_engine.h>
+
+#include <atomic>
+
+#include "../core/TypeIds.hpp"
+#include "AudioTaps.hpp"
+#include "MeteringBuffer.hpp"
+#include "SidechainDetector.hpp"
+
+namespace magda {
+
+namespace te = tracktion;
+
+/**
+ * @brief Track level meter that publishes peak/RMS from the render path
+ *
+ * A LevelMeterPlugin (so Tracktion's own meter clients and getLevelMeterPlugin() keep
+ * working) that also measures each rendered block on the audio thread. Peaks and RMS are
+ * accumulated over a short window and published to the bridge's MeteringBuffer, so the UI
+ * only ever reads lock-free snapshots. While a mod follows the track, each block is also run
+ * through a SidechainDetector and published to the modulator's SidechainBus, and while a view
+taps the track, each block is copied into its AudioTaps rings.
+ *
+ * Threading: setMeteringTarget() on the message thread, applyToBuffer() on the audio thread.
+ */
+class TrackMeterPlugin : public te::LevelMeterPlugin {
+  public:
+    explicit TrackMeterPlugin(te::PluginCreationInfo info);
+    ~TrackMeterPlugin() override;
+
+    static const char* getPluginName() {
+        return "Track Meter";
+    }
+    static const char* xmlTypeName;
+
+    /**
+     * @brief Create the ValueTree for a new instance
+     */
+    static juce::ValueTree create();
+
+    juce::String getPluginType() override {
+        return xmlTypeName;
+    }
+
+    /**
+     * @brief Set where readings go (nullptr to stop publishing)
+     * @param sidechain Where detector readings go while the bus listens to the track
+     * @param taps Where blocks are copied while tapped, with trackId as the tap point
+     *
+     * When detaching, blocks until an in-flight push has finished, so the old buffers can be
+     * destroyed as soon as this returns.
+     */
+    void setMeteringTarget(MeteringBuffer* buffer, TrackId trackId,
+                           SidechainBus* sidechain = nullptr, AudioTaps* taps = nullptr);
+
+    /**
+     * @brief Report inter-sample (4x oversampled) peaks instead of sample peaks
+     *
+     * About 50 extra multiply-adds per sample and channel; intended for the master strip.
+     */
+    void setTruePeakEnabled(bool enabled) {
+        truePeak_.store(enabled, std::memory_order_relaxed);
+    }
+
+    void initialise(const te::PluginInitialisationInfo&) override;
+    void applyToBuffer(const te::PluginRenderContext&) override;
+
+  private:
+    // Readings per second pushed to the MeteringBuffer (UI reads at 30 Hz; the buffer's
+    // peak decay assumes this rate)
+    static constexpr double kPushRateHz = 60.0;
+    // Channels measured per block (buses wider than this are metered on their first ones)
+    static constexpr int kMaxMeteredChannels = 16;
+
+    std::atomic<MeteringBuffer*> target_{nullptr};
+    std::atomic<SidechainBus*> sidechain_{nullptr};
+    std::atomic<AudioTaps*> taps_{nullptr};
+    std::atomic<TrackId> targetTrackId_{INVALID_TRACK_ID};
+    std::atomic<bool> pushing_{false};
+    std::atomic<bool> truePeak_{false};
+
+    // Audio thread only
+    RMSAccumulator rms_;
+    SidechainDetector detector_;
+    bool detectorRunning_ = false;
+    double sampleRate_ = 44100.0;
+    double preparedSampleRate_ = 0.0;  // The rate rms_ and detector_ were set up for
+};
+
+}  // namespace magda
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+#include "../core/TypeIds.hpp"
+
+namespace magda {
+
+/**
+ * @brief Dense per-track slots, looked up by TrackId from any thread without locking
+ *
+ * Track IDs only ever grow, so state indexed by raw ID would need room for every track a
+ * session has ever made. Instead each track is given a dense slot on the message thread and
+ * a two-level directory maps its ID to that slot; freed slots are reused, so storage is
+ * bounded by live tracks. Slots live in fixed-size chunks that are never moved once
+ * published.
+ *
+ * @tparam Slot Per-track state; must be default-constructible and have clear(), which
+ *              must be safe to call while readers may still look at the slot
+ */
+template <typename Slot, int SlotsPerChunk, int MaxChunks>
+class TrackSlotDirectory {
+  public:
+    static constexpr int kIdsPerPage = 256;  // TrackId -> slot directory page size
+    static constexpr int kMaxIdPages = 256;  // Track IDs below 65536
+    static constexpr int kNoSlot = -1;
+
+    TrackSlotDirectory() = default;
+
+    ~TrackSlotDirectory() {
+        for (auto& chunk : chunks_)
+            delete chunk.load(std::memory_order_relaxed);
+        for (auto& page : idPages_)
+            delete[] page.load(std::memory_order_relaxed);
+    }
+
+    TrackSlotDirectory(const TrackSlotDirectory&) = delete;
+    TrackSlotDirectory& operator=(const TrackSlotDirectory&) = delete;
+
+    /**
+     * @brief Give a track a cleared slot, reusing freed ones first (message thread)
+     * @return The slot, or kNoSlot if the track ID or slot count is out of range
+     *
+     * Does nothing if the track already has a slot.
+     */
+    int assign(TrackId trackId) {
+        auto* entry = getOrCreateIdEntry(trackId);
+        if (!entry)
+            return kNoSlot;
+
+        int slot = entry->load(std::memory_order_relaxed);
+        if (slot != kNoSlot)
+            return slot;
+
+        if (!freeSlots_.empty()) {
+            slot = freeSlots_.back();
+            freeSlots_.pop_back();
+        } else {
+            if (nextSlot_ >= SlotsPerChunk * MaxChunks)
+                return kNoSlot;
+
+            slot = nextSlot_++;
+            auto& chunk = chunks_[static_cast<size_t>(slot / SlotsPerChunk)];
+            if (!chunk.load(std::memory_order_relaxed))
+                chunk.store(new Chunk(), std::memory_order_release);
+        }
+
+        getSlot(slot).clear();
+
+        entry->store(slot, std::memory_order_release);
+        return slot;
+    }
+
+    /**
+     * @brief Return a track's slot for reuse (message thread)
+     */
+    void release(TrackId trackId) {
+        auto* entry = findIdEntry(trackId);
+        if (!entry)
+            return;
+
+        int slot = entry->exchange(kNoSlot, std::memory_order_acq_rel);
+        if (slot != kNoSlot)
+            freeSlots_.push_back(slot);
+    }
+
+    /**
+     * @brief A track's slot, or nullptr if it has none (any thread, lock-free)
+     */
+    Slot* find(TrackId trackId) const {
+        auto* entry = findIdEntry(trackId);
+        if (!entry)
+            return nullptr;
+
+        int slot = entry->load(std::memory_order_acquire);
+        return slot == kNoSlot ? nullptr : &getSlot(slot);
+    }
+
+  private:
+    struct Chunk {
+        std::array<Slot, SlotsPerChunk> slots;
+    };
+
+    Slot& getSlot(int slot) const {
+        auto* chunk =
+            chunks_[static_cast<size_t>(slot / SlotsPerChunk)].load(std::memory_order_acquire);
+        return chunk->slots[static_cast<size_t>(slot % SlotsPerChunk)];
+    }
+
+    std::atomic<int>* findIdEntry(TrackId trackId) const {
+        if (trackId < 0 || trackId >= kIdsPerPage * kMaxIdPages)
+            return nullptr;
+
+        auto* entries =
+            idPages_[static_cast<size_t>(trackId / kIdsPerPage)].load(std::memory_order_acquire);
+        return entries ? &entries[trackId % kIdsPerPage] : nullptr;
+    }
+
+    // Directory entry for a track ID, creating its page (message thread only)
+    std::atomic<int>* getOrCreateIdEntry(TrackId trackId) {
+        if (trackId < 0 || trackId >= kIdsPerPage * kMaxIdPages)
+            return nullptr;
+
+        auto& page = idPages_[static_cast<size_t>(trackId / kIdsPerPage)];
+        auto* entries = page.load(std::memory_order_acquire);
+        if (!entries) {
+            entries = new std::atomic<int>[kIdsPerPage];
+            for (int i = 0; i < kIdsPerPage; ++i)
+                entries[i].store(kNoSlot, std::memory_order_relaxed);
+            page.store(entries, std::memory_order_release);
+        }
+        return &entries[trackId % kIdsPerPage];
+    }
+
+    std::array<std::atomic<Chunk*>, MaxChunks> chunks_{};
+    std::array<std::atomic<std::atomic<int>*>, kMaxIdPages> idPages_{};
+
+    // Message thread only
+    std::vector<int> freeSlots_;
+    int nextSlot_ = 0;
+};
+
+}  // namespace magda
@@ -0,0 +1,45 @@
+#include "AutomationCommands.hpp"
+
+#include "AutomationManager.hpp"
+
+namespace magda {
+
+RecordAutomationCommand::RecordAutomationCommand(AutomationLaneId laneId, double startTime,
+                                                 double endTime,
+                                                 std::vector<AutomationPoint> points)
+    : laneId_(laneId), startTime_(startTime), endTime_(endTime), points_(std::move(points)) {}
+
+void RecordAutomationCommand::execute() {
+    auto& manager = AutomationManager::getInstance();
+    const auto* lane = manager.getLane(laneId_);
+    if (!lane)
+        return;
+
+    if (executed_) {
+        manager.setAbsolutePoints(laneId_, after_);
+        return;
+    }
+
+    before_ = lane->absolutePoints;
+    manager.replacePointsInRange(laneId_, startTime_, endTime_, points_);
+    after_ = manager.getLane(laneId_)->absolutePoints;
+
+    // Redo restores after_, so the pass itself is no longer needed
+    points_.clear();
+    points_.shrink_to_fit();
+    executed_ = true;
+}
+
+void RecordAutomationCommand::undo() {
+    if (!executed_)
+        return;
+
+    AutomationManager::getInstance().setAbsolutePoints(laneId_, before_);
+}
+
+size_t RecordAutomationCommand::getSizeInBytes() const {
+    return sizeof(*this) +
+           (points_.capacity() + before_.capacity() + after_.capacity()) * sizeof(AutomationPoint);
+}
+
+}  // namespace magda
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <vector>
+
+#include "AutomationInfo.hpp"
+#include "UndoManager.hpp"
+
+namespace magda {
+
+/**
+ * @brief Command for writing a recorded pass into an absolute automation lane
+ *
+ * Replaces the lane's points between the pass's start and end with the recorded ones.
+ * Undo restores the lane as it was; redo restores it as the first execute left it, so the
+ * recorded points keep their ids.
+ */
+class RecordAutomationCommand : public UndoableCommand {
+  public:
+    RecordAutomationCommand(AutomationLaneId laneId, double startTime, double endTime,
+                            std::vector<AutomationPoint> points);
+
+    void execute() override;
+    void undo() override;
+    juce::String getDescription() const override {
+        return "Record Automation";
+    }
+    size_t getSizeInBytes() const override;
+
+  private:
+    AutomationLaneId laneId_;
+    double startTime_;
+    double endTime_;
+    std::vector<AutomationPoint> points_;
+    std::vector<AutomationPoint> before_;
+    std::vector<AutomationPoint> after_;
+    bool executed_ = false;
+};
+
+}  // namespace magda
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cmath>
+
+namespace magda {
+
+/**
+ * @brief Segment shapes shared by AutomationManager and CompiledAutomation
+ *
+ * Both evaluate the same curves (one on the message thread, one at audio rate), so the
+ * formulas live here once.
+ */
+namespace AutomationInterpolation {
+
+/**
+ * @brief Power curve between two values
+ * @param tension -1 = concave (log-like), 0 = linear, +1 = convex (exp-like)
+ */
+inline double withTension(double t, double v1, double v2, double tension) {
+    if (std::abs(tension) < 0.001) {
+        // Linear interpolation for near-zero tension
+        return v1 + t * (v2 - v1);
+    }
+
+    // tension > 0: convex curve (slow start, fast end) - use t^(1+tension)
+    // tension < 0: concave curve (fast start, slow end) - use t^(1/(1-tension))
+    double curvedT;
+    if (tension > 0) {
+        // Convex: power > 1
+        curvedT = std::pow(t, 1.0 + tension * 2.0);
+    } else {
+        // Concave: power < 1
+        curvedT = 1.0 - std::pow(1.0 - t, 1.0 - tension * 2.0);
+    }
+
+    return v1 + curvedT * (v2 - v1);
+}
+
+/**
+ * @brief Cubic bezier in value between two points
+ * @param control1 First point's value plus its out handle
+ * @param control2 Second point's value plus its in handle
+ */
+inline double bezier(double t, double v1, double control1, double control2, double v2) {
+    double t2 = t * t;
+    double t3 = t2 * t;
+    double mt = 1.0 - t;
+    double mt2 = mt * mt;
+    double mt3 = mt2 * mt;
+
+    return mt3 * v1 + 3.0 * mt2 * t * control1 + 3.0 * mt * t2 * control2 + t3 * v2;
+}
+
+}  // namespace AutomationInterpolation
+
+}  // namespace magda
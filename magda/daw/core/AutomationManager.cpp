@@ -2,7 +2,9 @@
 
 #include <algorithm>
 #include <cmath>
+#include <limits>
 
+#include "AutomationInterpolation.hpp"
 #include "ParameterInfo.hpp"
 #include "ParameterUtils.hpp"
 #include "TrackManager.hpp"
@@ -38,6 +40,16 @@ static double getCurrentTargetValue(const AutomationTarget& target) {
             }
             return 0.5;  // Default to center
         }
+        case AutomationTargetType::DeviceParameter: {
+            auto* device = TrackManager::getInstance().getDeviceInChainByPath(target.devicePath);
+            if (device && target.paramIndex >= 0 &&
+                target.paramIndex < static_cast<int>(device->parameters.size())) {
+                const auto& param = device->parameters[static_cast<size_t>(target.paramIndex)];
+                return static_cast<double>(
+                    ParameterUtils::realToNormalized(param.currentValue, param));
+            }
+            return 0.5;
+        }
         default:
             return 0.5;  // Default for unknown targets
     }
@@ -148,6 +160,7 @@ void AutomationManager::deleteLane(AutomationLaneId laneId) {
     lanes_.erase(std::remove_if(lanes_.begin(), lanes_.end(),
                                 [laneId](const AutomationLaneInfo& l) { return l.id == laneId; }),
                  lanes_.end());
+    playbackCursors_.erase(laneId);
 
     notifyLanesChanged();
 }
@@ -532,27 +545,74 @@ void AutomationManager::setPointTensionInClip(AutomationClipId clipId, Automatio
     }
 }
 
+void AutomationManager::replacePointsInRange(AutomationLaneId laneId, double startTime,
+                                             double endTime,
+                                             const std::vector<AutomationPoint>& points) {
+    auto* lane = getLane(laneId);
+    if (!lane || !lane->isAbsolute())
+        return;
+
+    auto& lanePoints = lane->absolutePoints;
+    lanePoints.erase(std::remove_if(lanePoints.begin(), lanePoints.end(),
+                                    [startTime, endTime](const AutomationPoint& p) {
+                                        return p.time >= startTime && p.time <= endTime;
+                                    }),
+                     lanePoints.end());
+
+    for (auto point : points) {
+        point.id = nextPointId_++;
+        point.time = juce::jmax(0.0, point.time);
+        point.value = juce::jlimit(0.0, 1.0, point.value);
+        lanePoints.push_back(point);
+    }
+    sortPoints(lanePoints);
+    notifyPointsChanged(laneId);
+}
+
+void AutomationManager::setAbsolutePoints(AutomationLaneId laneId,
+                                          std::vector<AutomationPoint> points) {
+    auto* lane = getLane(laneId);
+    if (!lane || !lane->isAbsolute())
+        return;
+
+    lane->absolutePoints = std::move(points);
+    notifyPointsChanged(laneId);
+}
+
 // ============================================================================
 // Value Interpolation
 // ============================================================================
 
+bool AutomationManager::getCurrentTargetValue(const AutomationTarget& target,
+                                              double& value) const {
+    switch (target.type) {
+        case AutomationTargetType::TrackVolume:
+        case AutomationTargetType::TrackPan:
+        case AutomationTargetType::DeviceParameter:
+            value = magda::getCurrentTargetValue(target);
+            return true;
+        case AutomationTargetType::Macro:
+        case AutomationTargetType::ModParameter:
+            break;
+    }
+    return false;
+}
+
 double AutomationManager::getValueAtTime(AutomationLaneId laneId, double time) const {
     const auto* lane = getLane(laneId);
     if (!lane)
         return 0.5;
 
+    auto& cursor = playbackCursors_[laneId];
+
     if (lane->isAbsolute()) {
-        return interpolatePoints(lane->absolutePoints, time);
+        return interpolatePoints(lane->absolutePoints, time, cursor.segment);
     }
 
     // Clip-based: find clip containing time
-    for (auto clipId : lane->clipIds) {
-        const auto* clip = getClip(clipId);
-        if (clip && clip->containsTime(time)) {
-            double localTime = clip->getLocalTime(time);
-            return interpolatePoints(clip->points, localTime);
-        }
-    }
+    const auto* clip = findClipAtTime(*lane, time, cursor);
+    if (clip)
+        return interpolatePoints(clip->points, clip->getLocalTime(time), cursor.segment);
 
     return 0.5;  // Default if no clip at this time
 }
@@ -565,57 +625,113 @@ double AutomationManager::getClipValueAtTime(AutomationClipId clipId, double loc
     return interpolatePoints(clip->points, localTime);
 }
 
-double AutomationManager::interpolateLinear(double t, double v1, double v2) const {
-    return v1 + t * (v2 - v1);
-}
+void AutomationManager::renderValues(AutomationLaneId laneId, double startTime, double endTime,
+                                     float* out, int numSamples) const {
+    if (numSamples <= 0)
+        return;
 
-double AutomationManager::interpolateBezier(double t, const AutomationPoint& p1,
-                                            const AutomationPoint& p2) const {
-    // Cubic bezier interpolation
-    // P0 = (p1.time, p1.value)
-    // P1 = (p1.time + p1.outHandle.time, p1.value + p1.outHandle.value)
-    // P2 = (p2.time + p2.inHandle.time, p2.value + p2.inHandle.value)
-    // P3 = (p2.time, p2.value)
+    const auto* lane = getLane(laneId);
+    if (!lane) {
+        std::fill(out, out + numSamples, 0.5f);
+        return;
+    }
 
-    double t2 = t * t;
-    double t3 = t2 * t;
-    double mt = 1.0 - t;
-    double mt2 = mt * mt;
-    double mt3 = mt2 * mt;
+    // Segment walking assumes time moves forward
+    if (endTime < startTime) {
+        double step = (endTime - startTime) / numSamples;
+        for (int i = 0; i < numSamples; ++i)
+            out[i] = static_cast<float>(getValueAtTime(laneId, startTime + i * step));
+        return;
+    }
 
-    // Calculate control points
-    double cp1Value = p1.value + p1.outHandle.value;
-    double cp2Value = p2.value + p2.inHandle.value;
+    auto& cursor = playbackCursors_[laneId];
+    const double step = (endTime - startTime) / numSamples;
 
-    // Cubic bezier formula for value
-    return mt3 * p1.value + 3.0 * mt2 * t * cp1Value + 3.0 * mt * t2 * cp2Value + t3 * p2.value;
-}
+    if (lane->isAbsolute()) {
+        renderPoints(lane->absolutePoints, startTime, step, out, numSamples, cursor.segment);
+        return;
+    }
+
+    // Clip-based: render one run per clip (and per loop cycle), 0.5 in the gaps
+    int i = 0;
+    while (i < numSamples) {
+        double time = startTime + i * step;
+        const auto* clip = findClipAtTime(*lane, time, cursor);
+
+        double runEnd = std::numeric_limits<double>::max();
+        bool looping = false;
+        if (clip) {
+            runEnd = clip->getEndTime();
+            looping = clip->looping && clip->loopLength > 0.0;
+        } else {
+            for (auto clipId : lane->clipIds) {
+                const auto* other = getClip(clipId);
+                if (other && other->startTime > time)
+                    runEnd = std::min(runEnd, other->startTime);
+            }
+        }
 
-// Tension-based interpolation: power curve between two values
-// tension: -1 = concave (log-like), 0 = linear, +1 = convex (exp-like)
-static double interpolateWithTension(double t, double v1, double v2, double tension) {
-    if (std::abs(tension) < 0.001) {
-        // Linear interpolation for near-zero tension
-        return v1 + t * (v2 - v1);
+        // A looping clip's run also ends where its local time wraps
+        const double localStart = clip ? clip->getLocalTime(time) : 0.0;
+        double localTime = localStart;
+        int runLength = 1;
+        while (i + runLength < numSamples) {
+            double next = startTime + (i + runLength) * step;
+            if (next >= runEnd)
+                break;
+            if (looping) {
+                double nextLocal = clip->getLocalTime(next);
+                if (nextLocal < localTime)
+                    break;
+                localTime = nextLocal;
+            }
+            ++runLength;
+        }
+
+        if (clip) {
+            renderPoints(clip->points, localStart, step, out + i, runLength, cursor.segment);
+        } else {
+            std::fill(out + i, out + i + runLength, 0.5f);
+        }
+        i += runLength;
     }
+}
+
+void AutomationManager::renderClipValues(AutomationClipId clipId, double localStart,
+                                         double localEnd, float* out, int numSamples) const {
+    if (numSamples <= 0)
+        return;
 
-    // Use power curve for tension
-    // tension > 0: convex curve (slow start, fast end) - use t^(1+tension)
-    // tension < 0: concave curve (fast start, slow end) - use t^(1/(1-tension))
-    double curvedT;
-    if (tension > 0) {
-        // Convex: power > 1
-        curvedT = std::pow(t, 1.0 + tension * 2.0);
-    } else {
-        // Concave: power < 1
-        curvedT = 1.0 - std::pow(1.0 - t, 1.0 - tension * 2.0);
+    const auto* clip = getClip(clipId);
+    if (!clip) {
+        std::fill(out, out + numSamples, 0.5f);
+        return;
     }
 
-    return v1 + curvedT * (v2 - v1);
+    size_t segment = 0;
+    renderPoints(clip->points, localStart, (localEnd - localStart) / numSamples, out, numSamples,
+                 segment);
+}
+
+double AutomationManager::interpolateLinear(double t, double v1, double v2) const {
+    return v1 + t * (v2 - v1);
+}
+
+double AutomationManager::interpolateBezier(double t, const AutomationPoint& p1,
+                                            const AutomationPoint& p2) const {
+    // Control points sit at each point's value plus its handle
+    return AutomationInterpolation::bezier(t, p1.value, p1.value + p1.outHandle.value,
+                                           p2.value + p2.inHandle.value, p2.value);
 }
 
 double AutomationManager::interpolatePoints(const std::vector<AutomationPoint>& points,
                                             double time) const {
+    size_t segment = 0;
+    return interpolatePoints(points, time, segment);
+}
+
+double AutomationManager::interpolatePoints(const std::vector<AutomationPoint>& points,
+                                            double time, size_t& segment) const {
     if (points.empty())
         return 0.5;
 
@@ -627,34 +743,170 @@ double AutomationManager::interpolatePoints(const std::vector<AutomationPoint>&
     if (time >= points.back().time)
         return points.back().value;
 
-    // Find surrounding points
-    for (size_t i = 0; i < points.size() - 1; ++i) {
-        const auto& p1 = points[i];
-        const auto& p2 = points[i + 1];
+    segment = findSegment(points, time, segment);
+    return interpolateSegment(points[segment], points[segment + 1], time);
+}
+
+size_t AutomationManager::findSegment(const std::vector<AutomationPoint>& points, double time,
+                                      size_t hint) {
+    // Sequential reads during playback land in the hinted segment or the one after it
+    const size_t lastSegment = points.size() - 2;
+    for (size_t i = hint; i <= std::min(hint + 1, lastSegment); ++i) {
+        if (time >= points[i].time && time < points[i + 1].time)
+            return i;
+    }
+
+    // Otherwise binary search for the first point after time; the segment starts before it
+    auto next = std::upper_bound(
+        points.begin() + 1, points.end() - 1, time,
+        [](double t, const AutomationPoint& point) { return t < point.time; });
+    return static_cast<size_t>(next - points.begin()) - 1;
+}
+
+double AutomationManager::interpolateSegment(const AutomationPoint& p1, const AutomationPoint& p2,
+                                             double time) const {
+    // Normalize t to 0-1 between points
+    double duration = p2.time - p1.time;
+    if (duration <= 0.0)
+        return p1.value;
+
+    double t = (time - p1.time) / duration;
+
+    switch (p1.curveType) {
+        case AutomationCurveType::Linear:
+            // Use tension-based interpolation
+            return AutomationInterpolation::withTension(t, p1.value, p2.value, p1.tension);
+
+        case AutomationCurveType::Bezier:
+            return interpolateBezier(t, p1, p2);
+
+        case AutomationCurveType::Step:
+            return p1.value;  // Hold until next point
+    }
 
-        if (time >= p1.time && time < p2.time) {
-            // Normalize t to 0-1 between points
-            double duration = p2.time - p1.time;
-            if (duration <= 0.0)
-                return p1.value;
+    return 0.5;
+}
 
-            double t = (time - p1.time) / duration;
+void AutomationManager::renderPoints(const std::vector<AutomationPoint>& points,
+                                     double localStart, double step, float* out, int numSamples,
+                                     size_t& segment) const {
+    if (points.empty()) {
+        std::fill(out, out + numSamples, 0.5f);
+        return;
+    }
 
-            switch (p1.curveType) {
-                case AutomationCurveType::Linear:
-                    // Use tension-based interpolation
-                    return interpolateWithTension(t, p1.value, p2.value, p1.tension);
+    const auto& front = points.front();
+    const auto& back = points.back();
 
-                case AutomationCurveType::Bezier:
-                    return interpolateBezier(t, p1, p2);
+    int i = 0;
+    while (i < numSamples) {
+        double time = localStart + i * step;
 
-                case AutomationCurveType::Step:
-                    return p1.value;  // Hold until next point
+        if (time <= front.time) {
+            out[i++] = static_cast<float>(front.value);
+            continue;
+        }
+        if (time >= back.time) {
+            out[i++] = static_cast<float>(back.value);
+            continue;
+        }
+
+        segment = findSegment(points, time, segment);
+        const auto& p1 = points[segment];
+        const auto& p2 = points[segment + 1];
+
+        int count = 1;
+        while (i + count < numSamples) {
+            double next = localStart + (i + count) * step;
+            if (next < p1.time || next >= p2.time)
+                break;
+            ++count;
+        }
+
+        renderSegment(p1, p2, time, step, out + i, count);
+        i += count;
+    }
+}
+
+void AutomationManager::renderSegment(const AutomationPoint& p1, const AutomationPoint& p2,
+                                      double localStart, double step, float* out,
+                                      int numSamples) const {
+    double duration = p2.time - p1.time;
+    if (duration <= 0.0 || p1.curveType == AutomationCurveType::Step) {
+        std::fill(out, out + numSamples, static_cast<float>(p1.value));
+        return;
+    }
+
+    const double t0 = (localStart - p1.time) / duration;
+    const double dt = step / duration;
+
+    switch (p1.curveType) {
+        case AutomationCurveType::Linear:
+            if (std::abs(p1.tension) < 0.001) {
+                const double range = p2.value - p1.value;
+                for (int i = 0; i < numSamples; ++i)
+                    out[i] = static_cast<float>(p1.value + (t0 + i * dt) * range);
+            } else {
+                for (int i = 0; i < numSamples; ++i)
+                    out[i] = static_cast<float>(AutomationInterpolation::withTension(
+                        t0 + i * dt, p1.value, p2.value, p1.tension));
+            }
+            return;
+
+        case AutomationCurveType::Bezier: {
+            // Forward differencing: the cubic's third difference is constant, so each value
+            // costs three additions. Re-seed from the exact curve periodically so rounding
+            // error can't build up over long renders.
+            constexpr int kReseedInterval = 256;
+            for (int start = 0; start < numSamples; start += kReseedInterval) {
+                const double t = t0 + start * dt;
+                const double f0 = interpolateBezier(t, p1, p2);
+                const double f1 = interpolateBezier(t + dt, p1, p2);
+                const double f2 = interpolateBezier(t + 2.0 * dt, p1, p2);
+                const double f3 = interpolateBezier(t + 3.0 * dt, p1, p2);
+
+                double value = f0;
+                double d1 = f1 - f0;
+                double d2 = f2 - 2.0 * f1 + f0;
+                const double d3 = f3 - 3.0 * f2 + 3.0 * f1 - f0;
+
+                const int end = std::min(numSamples, start + kReseedInterval);
+                for (int i = start; i < end; ++i) {
+                    out[i] = static_cast<float>(value);
+                    value += d1;
+                    d1 += d2;
+                    d2 += d3;
+                }
             }
+            return;
         }
+
+        case AutomationCurveType::Step:
+            break;
     }
+}
 
-    return 0.5;
+const AutomationClipInfo* AutomationManager::findClipAtTime(const AutomationLaneInfo& lane,
+                                                           double time,
+                                                           PlaybackCursor& cursor) const {
+    // Clip the cursor is parked on - resolved without searching clips_ while its index holds
+    if (cursor.clipSlot < lane.clipIds.size() && cursor.clipIndex < clips_.size()) {
+        const auto& clip = clips_[cursor.clipIndex];
+        if (clip.id == lane.clipIds[cursor.clipSlot] && clip.containsTime(time))
+            return &clip;
+    }
+
+    for (size_t slot = 0; slot < lane.clipIds.size(); ++slot) {
+        const auto* clip = getClip(lane.clipIds[slot]);
+        if (clip && clip->containsTime(time)) {
+            cursor.clipSlot = slot;
+            cursor.clipIndex = static_cast<size_t>(clip - clips_.data());
+            cursor.segment = 0;
+            return clip;
+        }
+    }
+
+    return nullptr;
 }
 
 // ============================================================================
@@ -700,9 +952,35 @@ void AutomationManager::notifyPointDragPreview(AutomationLaneId laneId, Automati
 void AutomationManager::clearAll() {
     lanes_.clear();
     clips_.clear();
+    playbackCursors_.clear();
+    nextLaneId_ = 1;
+    nextClipId_ = 1;
+    nextPointId_ = 1;
+    notifyLanesChanged();
+}
+
+void AutomationManager::loadAutomation(std::vector<AutomationLaneInfo> lanes,
+                                       std::vector<AutomationClipInfo> clips) {
+    lanes_ = std::move(lanes);
+    clips_ = std::move(clips);
+    playbackCursors_.clear();
+
     nextLaneId_ = 1;
     nextClipId_ = 1;
     nextPointId_ = 1;
+    auto reservePoints = [this](const std::vector<AutomationPoint>& points) {
+        for (const auto& point : points) {
+            nextPointId_ = std::max(nextPointId_, point.id + 1);
+        }
+    };
+    for (const auto& lane : lanes_) {
+        nextLaneId_ = std::max(nextLaneId_, lane.id + 1);
+        reservePoints(lane.absolutePoints);
+    }
+    for (const auto& clip : clips_) {
+        nextClipId_ = std::max(nextClipId_, clip.id + 1);
+        reservePoints(clip.points);
+    }
     notifyLanesChanged();
 }
 
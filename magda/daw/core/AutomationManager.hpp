@@ -139,6 +139,10 @@ class AutomationManager : public TrackManagerListener {
     AutomationClipInfo* getClip(AutomationClipId clipId);
     const AutomationClipInfo* getClip(AutomationClipId clipId) const;
 
+    const std::vector<AutomationClipInfo>& getClips() const {
+        return clips_;
+    }
+
     /**
      * @brief Move a clip to a new position
      */
@@ -230,6 +234,18 @@ class AutomationManager : public TrackManagerListener {
      */
     void setPointTensionInClip(AutomationClipId clipId, AutomationPointId pointId, double tension);
 
+    /**
+     * @brief Replace an absolute lane's points in [startTime, endTime] with recorded ones
+     * @param points Sorted by time; they are given fresh ids
+     */
+    void replacePointsInRange(AutomationLaneId laneId, double startTime, double endTime,
+                              const std::vector<AutomationPoint>& points);
+
+    /**
+     * @brief Replace every point on an absolute lane, ids included (undoing a recording)
+     */
+    void setAbsolutePoints(AutomationLaneId laneId, std::vector<AutomationPoint> points);
+
     // ========================================================================
     // Value Interpolation
     // ========================================================================
@@ -239,6 +255,10 @@ class AutomationManager : public TrackManagerListener {
      * @param laneId Lane to query
      * @param time Time in seconds
      * @return Normalized value 0-1 (0.5 if no points)
+     *
+     * Each lane keeps a cursor on the clip and segment it last evaluated, so sequential
+     * reads during playback are amortised O(1); random access falls back to binary search.
+     * Message thread only (the cursor is updated in place).
      */
     double getValueAtTime(AutomationLaneId laneId, double time) const;
 
@@ -250,6 +270,33 @@ class AutomationManager : public TrackManagerListener {
      */
     double getClipValueAtTime(AutomationClipId clipId, double localTime) const;
 
+    /**
+     * @brief Fill a buffer with lane values for a time range
+     * @param laneId Lane to render
+     * @param startTime Time of the first value in seconds
+     * @param endTime End of the range (exclusive); value i is at
+     *                startTime + i * (endTime - startTime) / numSamples
+     * @param out Destination for numSamples normalized values
+     *
+     * Same values as calling getValueAtTime() per sample, but segments are walked once and
+     * evaluated incrementally. Message thread only (shares the lane's playback cursor).
+     */
+    void renderValues(AutomationLaneId laneId, double startTime, double endTime, float* out,
+                      int numSamples) const;
+
+    /**
+     * @brief Fill a buffer with clip values for a range of local time
+     * @see renderValues
+     */
+    void renderClipValues(AutomationClipId clipId, double localStart, double localEnd,
+                          float* out, int numSamples) const;
+
+    /**
+     * @brief The target's value right now, normalized 0-1
+     * @return False for targets whose value can't be read (macros, mod parameters)
+     */
+    bool getCurrentTargetValue(const AutomationTarget& target, double& value) const;
+
     // ========================================================================
     // Listener Management
     // ========================================================================
@@ -269,6 +316,12 @@ class AutomationManager : public TrackManagerListener {
 
     void clearAll();
 
+    /**
+     * @brief Replace every lane and automation clip (opening a project)
+     */
+    void loadAutomation(std::vector<AutomationLaneInfo> lanes,
+                        std::vector<AutomationClipInfo> clips);
+
     // ========================================================================
     // TrackManagerListener - Updates automation when faders move
     // ========================================================================
@@ -284,6 +337,18 @@ class AutomationManager : public TrackManagerListener {
     std::vector<AutomationClipInfo> clips_;
     juce::ListenerList<AutomationManagerListener> listeners_;
 
+    /**
+     * @brief Where getValueAtTime() last found a value on a lane
+     *
+     * Only a hint: every field is validated before use, so edits never need to reset it.
+     */
+    struct PlaybackCursor {
+        size_t clipSlot = 0;   // Index into the lane's clipIds
+        size_t clipIndex = 0;  // Index into clips_ of that clip
+        size_t segment = 0;    // Index of the first point of the last segment
+    };
+    mutable std::unordered_map<AutomationLaneId, PlaybackCursor> playbackCursors_;
+
     int nextLaneId_ = 1;
     int nextClipId_ = 1;
     int nextPointId_ = 1;
@@ -298,6 +363,18 @@ class AutomationManager : public TrackManagerListener {
     double interpolateLinear(double t, double v1, double v2) const;
     double interpolateBezier(double t, const AutomationPoint& p1, const AutomationPoint& p2) const;
     double interpolatePoints(const std::vector<AutomationPoint>& points, double time) const;
+    double interpolatePoints(const std::vector<AutomationPoint>& points, double time,
+                             size_t& segment) const;
+    double interpolateSegment(const AutomationPoint& p1, const AutomationPoint& p2,
+                              double time) const;
+    static size_t findSegment(const std::vector<AutomationPoint>& points, double time,
+                              size_t hint);
+    const AutomationClipInfo* findClipAtTime(const AutomationLaneInfo& lane, double time,
+                                             PlaybackCursor& cursor) const;
+    void renderPoints(const std::vector<AutomationPoint>& points, double localStart, double step,
+                      float* out, int numSamples, size_t& segment) const;
+    void renderSegment(const AutomationPoint& p1, const AutomationPoint& p2, double localStart,
+                       double step, float* out, int numSamples) const;
 
     // Point management helpers
     AutomationPoint* findPoint(std::vector<AutomationPoint>& points, AutomationPointId pointId);
@@ -0,0 +1,322 @@
+#include "AutomationRecorder.hpp"
+
+#include <cmath>
+
+#include "../engine/AudioEngine.hpp"
+#include "AutomationCommands.hpp"
+#include "AutomationManager.hpp"
+#include "Config.hpp"
+#include "ParameterUtils.hpp"
+
+namespace magda {
+
+// ============================================================================
+// AutomationPointThinner
+// ============================================================================
+
+AutomationPointThinner::AutomationPointThinner(double tolerance) : tolerance_(tolerance) {}
+
+void AutomationPointThinner::reset(double tolerance) {
+    tolerance_ = tolerance;
+    points_.clear();
+    pending_.clear();
+}
+
+void AutomationPointThinner::addSample(double time, double value) {
+    const Sample sample{time, value};
+    if (points_.empty()) {
+        addPoint(sample);
+        return;
+    }
+
+    // The newest pending sample is the furthest the last point's line can reach; if it
+    // can't reach this one too, it becomes a point
+    if (!pending_.empty() && (pending_.size() >= kMaxPendingSamples || missesPending(sample))) {
+        addPoint(pending_.back());
+        pending_.clear();
+    }
+    pending_.push_back(sample);
+}
+
+std::vector<AutomationPoint> AutomationPointThinner::finish() {
+    if (!pending_.empty()) {
+        addPoint(pending_.back());
+        pending_.clear();
+    }
+    return std::move(points_);
+}
+
+bool AutomationPointThinner::missesPending(const Sample& sample) const {
+    const auto& from = points_.back();
+    const double span = sample.time - from.time;
+    for (const auto& pending : pending_) {
+        const double expected =
+            span > 0.0
+                ? from.value + (sample.value - from.value) * (pending.time - from.time) / span
+                : sample.value;
+        if (std::abs(pending.value - expected) > tolerance_) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void AutomationPointThinner::addPoint(const Sample& sample) {
+    AutomationPoint point;
+    point.time = sample.time;
+    point.value = sample.value;
+    points_.push_back(point);
+}
+
+// ============================================================================
+// AutomationRecorder
+// ============================================================================
+
+AutomationRecorder& AutomationRecorder::getInstance() {
+    static AutomationRecorder instance;
+    return instance;
+}
+
+AutomationRecorder::AutomationRecorder() {
+    TrackManager::getInstance().addListener(this);
+}
+
+AutomationRecorder::~AutomationRecorder() {
+    stopTimer();
+    TrackManager::getInstance().removeListener(this);
+}
+
+void AutomationRecorder::setAudioEngine(AudioEngine* audioEngine) {
+    if (audioEngine_ && audioEngine != audioEngine_) {
+        endAllPasses();
+    }
+    audioEngine_ = audioEngine;
+    updateTimer();
+}
+
+void AutomationRecorder::setMode(AutomationRecordMode mode) {
+    if (mode == mode_)
+        return;
+
+    // Passes end with the mode they were recorded in
+    endAllPasses();
+    mode_ = mode;
+    updateTimer();
+}
+
+void AutomationRecorder::beginTouch(AutomationLaneId laneId) {
+    auto& pass = passes_[laneId];
+    pass.held = true;
+    pass.touched = true;
+    pass.lastChangeMs = juce::Time::getMillisecondCounterHiRes();
+}
+
+void AutomationRecorder::endTouch(AutomationLaneId laneId) {
+    auto it = passes_.find(laneId);
+    if (it != passes_.end()) {
+        it->second.held = false;
+        // Released now, not kTouchReleaseMs after the last move
+        it->second.lastChangeMs = -kTouchReleaseMs;
+    }
+}
+
+void AutomationRecorder::valueChanged(AutomationLaneId laneId, double value, double nowMs) {
+    auto& pass = passes_[laneId];
+    pass.value = juce::jlimit(0.0, 1.0, value);
+    pass.hasValue = true;
+    pass.touched = true;
+    pass.lastChangeMs = nowMs;
+}
+
+bool AutomationRecorder::isWriting(AutomationLaneId laneId) const {
+    auto it = passes_.find(laneId);
+    return it != passes_.end() && it->second.writing;
+}
+
+void AutomationRecorder::process(double time, bool playing, double nowMs) {
+    if (!playing || mode_ == AutomationRecordMode::Off) {
+        if (wasPlaying_) {
+            endAllPasses();
+        }
+        wasPlaying_ = false;
+        return;
+    }
+
+    const bool started = !wasPlaying_;
+    const bool jumped = !started && (time < lastTime_ || time - lastTime_ > kMaxStepSeconds);
+
+    auto& manager = AutomationManager::getInstance();
+    std::vector<std::unique_ptr<UndoableCommand>> commands;
+
+    for (const auto& lane : manager.getLanes()) {
+        if (!lane.armed || !lane.isAbsolute()) {
+            continue;
+        }
+
+        auto& pass = passes_[lane.id];
+        if (started) {
+            // A move before play doesn't latch or touch anything
+            pass.touched = pass.held;
+        }
+        if (!pass.hasValue) {
+            if (!manager.getCurrentTargetValue(lane.target, pass.value)) {
+                pass.value = manager.getValueAtTime(lane.id, time);
+            }
+            pass.hasValue = true;
+        }
+
+        if (pass.writing && jumped) {
+            endPass(lane.id, pass, commands);
+        }
+
+        const bool write = wantsToWrite(pass, nowMs);
+        if (write && !pass.writing) {
+            pass.writing = true;
+            pass.startTime = time;
+            pass.thinner.reset(Config::getInstance().getAutomationThinningTolerance());
+        } else if (!write && pass.writing) {
+            endPass(lane.id, pass, commands);
+        }
+
+        if (pass.writing) {
+            pass.thinner.addSample(time, pass.value);
+            pass.lastTime = time;
+        }
+    }
+
+    // Lanes disarmed (or deleted) mid-pass keep what they recorded so far
+    for (auto& [laneId, pass] : passes_) {
+        const auto* lane = manager.getLane(laneId);
+        if (pass.writing && (!lane || !lane->armed)) {
+            endPass(laneId, pass, commands);
+        }
+    }
+
+    commit(std::move(commands));
+    wasPlaying_ = true;
+    lastTime_ = time;
+}
+
+bool AutomationRecorder::wantsToWrite(const Pass& pass, double nowMs) const {
+    switch (mode_) {
+        case AutomationRecordMode::Off:
+            return false;
+        case AutomationRecordMode::Write:
+            return true;
+        case AutomationRecordMode::Latch:
+            return pass.touched;
+        case AutomationRecordMode::Touch:
+            return pass.held || (pass.touched && nowMs - pass.lastChangeMs < kTouchReleaseMs);
+    }
+    return false;
+}
+
+void AutomationRecorder::endPass(AutomationLaneId laneId, Pass& pass,
+                                 std::vector<std::unique_ptr<UndoableCommand>>& commands) {
+    pass.writing = false;
+    pass.touched = pass.held;
+
+    auto points = pass.thinner.finish();
+    if (points.empty() || AutomationManager::getInstance().getLane(laneId) == nullptr) {
+        return;
+    }
+    commands.push_back(std::make_unique<RecordAutomationCommand>(laneId, pass.startTime,
+                                                                 pass.lastTime, std::move(points)));
+}
+
+void AutomationRecorder::endAllPasses() {
+    std::vector<std::unique_ptr<UndoableCommand>> commands;
+    for (auto& [laneId, pass] : passes_) {
+        if (pass.writing) {
+            endPass(laneId, pass, commands);
+        }
+        // Values aren't followed while the mode is off, so the next pass reads them afresh
+        pass.hasValue = pass.hasValue && pass.held;
+    }
+    commit(std::move(commands));
+}
+
+void AutomationRecorder::commit(std::vector<std::unique_ptr<UndoableCommand>> commands) {
+    if (commands.empty())
+        return;
+
+    auto& undoManager = UndoManager::getInstance();
+    if (commands.size() == 1) {
+        undoManager.executeCommand(std::move(commands.front()));
+        return;
+    }
+
+    CompoundOperationScope scope("Record Automation");
+    for (auto& command : commands) {
+        undoManager.executeCommand(std::move(command));
+    }
+}
+
+void AutomationRecorder::timerCallback() {
+    if (audioEngine_) {
+        process(audioEngine_->getCurrentPosition(), audioEngine_->isPlaying(),
+                juce::Time::getMillisecondCounterHiRes());
+    }
+}
+
+void AutomationRecorder::updateTimer() {
+    if (audioEngine_ && mode_ != AutomationRecordMode::Off) {
+        if (!isTimerRunning()) {
+            startTimerHz(kControlRateHz);
+        }
+    } else {
+        stopTimer();
+        wasPlaying_ = false;
+    }
+}
+
+// ============================================================================
+// TrackManagerListener - the changes AudioBridge queues for the audio thread
+// ============================================================================
+
+void AutomationRecorder::trackPropertyChanged(int trackId) {
+    if (mode_ == AutomationRecordMode::Off)
+        return;
+
+    auto& manager = AutomationManager::getInstance();
+    const double nowMs = juce::Time::getMillisecondCounterHiRes();
+    for (const auto& lane : manager.getLanes()) {
+        if (!lane.armed || lane.target.trackId != static_cast<TrackId>(trackId) ||
+            (lane.target.type != AutomationTargetType::TrackVolume &&
+             lane.target.type != AutomationTargetType::TrackPan)) {
+            continue;
+        }
+
+        // Any property change lands here, so only a new value is a move
+        double value = 0.0;
+        auto it = passes_.find(lane.id);
+        if (manager.getCurrentTargetValue(lane.target, value) &&
+            (it == passes_.end() || !it->second.hasValue || it->second.value != value)) {
+            valueChanged(lane.id, value, nowMs);
+        }
+    }
+}
+
+void AutomationRecorder::deviceParameterChanged(DeviceId deviceId, int paramIndex,
+                                                float newValue) {
+    if (mode_ == AutomationRecordMode::Off)
+        return;
+
+    auto& trackManager = TrackManager::getInstance();
+    const double nowMs = juce::Time::getMillisecondCounterHiRes();
+    for (const auto& lane : AutomationManager::getInstance().getLanes()) {
+        if (!lane.armed || lane.target.type != AutomationTargetType::DeviceParameter ||
+            paramIndex < 0 || lane.target.paramIndex != paramIndex) {
+            continue;
+        }
+
+        const auto* device = trackManager.getDeviceInChainByPath(lane.target.devicePath);
+        if (device && device->id == deviceId &&
+            paramIndex < static_cast<int>(device->parameters.size())) {
+            const auto& param = device->parameters[static_cast<size_t>(paramIndex)];
+            valueChanged(lane.id, ParameterUtils::realToNormalized(newValue, param), nowMs);
+        }
+    }
+}
+
+}  // namespace magda
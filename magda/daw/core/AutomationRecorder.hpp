@@ -0,0 +1,159 @@
+#pragma once
+
+#include <juce_events/juce_events.h>
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "AutomationInfo.hpp"
+#include "TrackManager.hpp"
+#include "UndoManager.hpp"
+
+namespace magda {
+
+class AudioEngine;
+
+/**
+ * @brief Online point thinning for a recorded automation pass
+ *
+ * Samples arrive in time order. One becomes a point only once the straight line from the
+ * last point to the newest sample would miss a sample in between by more than the
+ * tolerance, so a held value records as its two ends and a steady sweep as a handful of
+ * points. Work per sample is bounded by kMaxPendingSamples.
+ */
+class AutomationPointThinner {
+  public:
+    static constexpr size_t kMaxPendingSamples = 256;
+
+    /**
+     * @param tolerance Largest error allowed, in normalized value
+     */
+    explicit AutomationPointThinner(double tolerance = 0.005);
+
+    /**
+     * @brief Drop everything and start a new pass
+     */
+    void reset(double tolerance);
+
+    void addSample(double time, double value);
+
+    /**
+     * @brief The pass's points, ending at its last sample; the thinner is left empty
+     */
+    std::vector<AutomationPoint> finish();
+
+    bool isEmpty() const {
+        return points_.empty();
+    }
+
+  private:
+    struct Sample {
+        double time = 0.0;
+        double value = 0.0;
+    };
+
+    bool missesPending(const Sample& sample) const;
+    void addPoint(const Sample& sample);
+
+    double tolerance_;
+    std::vector<AutomationPoint> points_;
+    std::vector<Sample> pending_;  // Samples since the last point
+};
+
+/**
+ * @brief Records parameter moves into armed automation lanes while the transport plays
+ *
+ * Value changes arrive from the same TrackManager notifications that feed AudioBridge's
+ * parameter queue (device parameters, track volume and pan), and are sampled at control
+ * rate rather than per UI event, then thinned on the fly. A pass is committed as one
+ * RecordAutomationCommand when it ends: at stop, on a loop wrap or jump, or (Touch) when
+ * the control is let go. Passes that end together are one undo step.
+ *
+ * Touch knows a control is held from beginTouch()/endTouch() where the control reports
+ * its gesture; any other change holds it for kTouchReleaseMs. Only absolute lanes are
+ * recorded. Message thread only.
+ */
+class AutomationRecorder : public TrackManagerListener, private juce::Timer {
+  public:
+    static constexpr int kControlRateHz = 100;
+    static constexpr double kTouchReleaseMs = 500.0;
+    // A transport step further than this is a locate, which ends the pass
+    static constexpr double kMaxStepSeconds = 1.0;
+
+    static AutomationRecorder& getInstance();
+
+    // Prevent copying
+    AutomationRecorder(const AutomationRecorder&) = delete;
+    AutomationRecorder& operator=(const AutomationRecorder&) = delete;
+
+    /**
+     * @brief The engine whose transport drives recording (nullptr to stop)
+     */
+    void setAudioEngine(AudioEngine* audioEngine);
+
+    void setMode(AutomationRecordMode mode);
+    AutomationRecordMode getMode() const {
+        return mode_;
+    }
+
+    /**
+     * @brief A control bound to the lane's target was grabbed or let go
+     */
+    void beginTouch(AutomationLaneId laneId);
+    void endTouch(AutomationLaneId laneId);
+
+    /**
+     * @brief The lane's target moved to a normalized value
+     */
+    void valueChanged(AutomationLaneId laneId, double value, double nowMs);
+
+    /**
+     * @brief One control-rate step; the timer calls this with the engine's transport
+     */
+    void process(double time, bool playing, double nowMs);
+
+    /**
+     * @brief Whether a pass is being recorded on the lane
+     */
+    bool isWriting(AutomationLaneId laneId) const;
+
+    // TrackManagerListener
+    void tracksChanged() override {}
+    void trackPropertyChanged(int trackId) override;
+    void deviceParameterChanged(DeviceId deviceId, int paramIndex, float newValue) override;
+
+  private:
+    AutomationRecorder();
+    ~AutomationRecorder() override;
+
+    struct Pass {
+        double value = 0.0;  // Latest value of the lane's target
+        bool hasValue = false;
+        bool held = false;     // Between beginTouch() and endTouch()
+        bool touched = false;  // Moved since play started
+        double lastChangeMs = 0.0;
+
+        bool writing = false;
+        double startTime = 0.0;
+        double lastTime = 0.0;
+        AutomationPointThinner thinner;
+    };
+
+    void timerCallback() override;
+    void updateTimer();
+
+    bool wantsToWrite(const Pass& pass, double nowMs) const;
+    void endPass(AutomationLaneId laneId, Pass& pass,
+                 std::vector<std::unique_ptr<UndoableCommand>>& commands);
+    void endAllPasses();
+    static void commit(std::vector<std::unique_ptr<UndoableCommand>> commands);
+
+    AudioEngine* audioEngine_ = nullptr;
+    AutomationRecordMode mode_ = AutomationRecordMode::Off;
+    std::unordered_map<AutomationLaneId, Pass> passes_;
+    bool wasPlaying_ = false;
+    double lastTime_ = 0.0;
+};
+
+}  // namespace magda
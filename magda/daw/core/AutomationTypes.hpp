@@ -32,6 +32,16 @@ enum class AutomationDrawMode {
     Curve    // Draw smooth curves
 };
 
+/**
+ * @brief How armed lanes record while the transport plays
+ */
+enum class AutomationRecordMode {
+    Off,    // Armed lanes only play back
+    Write,  // Overwrite from play until stop, moved or not
+    Touch,  // Overwrite while the control is being moved
+    Latch   // Overwrite from the first move until stop
+};
+
 /**
  * @brief Type of automation target
  */
@@ -88,6 +98,23 @@ inline const char* getDrawModeName(AutomationDrawMode mode) {
     return "Unknown";
 }
 
+/**
+ * @brief Get display name for record mode
+ */
+inline const char* getRecordModeName(AutomationRecordMode mode) {
+    switch (mode) {
+        case AutomationRecordMode::Off:
+            return "Off";
+        case AutomationRecordMode::Write:
+            return "Write";
+        case AutomationRecordMode::Touch:
+            return "Touch";
+        case AutomationRecordMode::Latch:
+            return "Latch";
+    }
+    return "Unknown";
+}
+
 /**
  * @brief Get display name for target type
  */
@@ -0,0 +1,408 @@
+#include "AutosaveManager.hpp"
+
+#include "ProjectManager.hpp"
+
+namespace magda {
+
+namespace {
+
+// FNV-1a, enough to drop a section that encodes the same as the last one journaled
+juce::int64 hashSection(const juce::MemoryBlock& data) {
+    uint64_t value = 14695981039346656037ull;
+    const auto* bytes = static_cast<const uint8_t*>(data.getData());
+    for (size_t i = 0; i < data.getSize(); ++i) {
+        value = (value ^ bytes[i]) * 1099511628211ull;
+    }
+    return static_cast<juce::int64>(value);
+}
+
+ProjectJournal::Record makeRemoval(int type, int key) {
+    ProjectJournal::Record record;
+    record.type = type;
+    record.key = key;
+    record.removed = true;
+    return record;
+}
+
+}  // namespace
+
+AutosaveManager& AutosaveManager::getInstance() {
+    static AutosaveManager instance;
+    return instance;
+}
+
+AutosaveManager::AutosaveManager()
+    : directory_(juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+                     .getChildFile("MAGDA")
+                     .getChildFile("Autosave")),
+      pool_(std::make_unique<juce::ThreadPool>(1)) {}
+
+AutosaveManager::~AutosaveManager() {
+    running_ = false;
+    pool_->removeAllJobs(false, 5000);
+}
+
+bool AutosaveManager::hasRecoveryData() const {
+    return ProjectJournal::hasRecoveryData(directory_);
+}
+
+void AutosaveManager::start() {
+    if (running_) {
+        return;
+    }
+
+    ProjectJournal::deleteGenerationsBefore(directory_, 0);
+    running_ = true;
+    generation_ = 0;
+
+    TrackManager::getInstance().addListener(this);
+    ClipManager::getInstance().addListener(this);
+    AutomationManager::getInstance().addListener(this);
+    UndoManager::getInstance().addListener(this);
+
+    checkpointNeeded_ = true;
+    flush();
+    startTimer(kFlushIntervalMs);
+}
+
+void AutosaveManager::shutdown() {
+    if (!running_) {
+        return;
+    }
+
+    running_ = false;
+    stopTimer();
+    cancelPendingUpdate();
+    TrackManager::getInstance().removeListener(this);
+    ClipManager::getInstance().removeListener(this);
+    AutomationManager::getInstance().removeListener(this);
+    UndoManager::getInstance().removeListener(this);
+
+    // A clean exit leaves nothing to recover
+    pool_->removeAllJobs(false, 5000);
+    writer_.reset();
+    journaledHashes_.clear();
+    ProjectJournal::deleteGenerationsBefore(directory_, 0);
+    clearPendingEdits();
+}
+
+// =============================================================================
+// Change tracking
+// =============================================================================
+
+void AutosaveManager::masterChannelChanged() {
+    masterDirty_ = true;
+}
+
+void AutosaveManager::trackChangesCoalesced(const TrackChangeSet& changes) {
+    if (changes.reset) {
+        checkpointNeeded_ = true;  // Loaded or cleared: cheaper to start over
+        return;
+    }
+
+    for (auto trackId : changes.added) {
+        dirtyTracks_.insert(trackId);
+        removedTracks_.erase(trackId);
+    }
+    for (const auto& [trackId, dirty] : changes.modified) {
+        dirtyTracks_.insert(trackId);
+    }
+    for (auto trackId : changes.removed) {
+        dirtyTracks_.erase(trackId);
+        removedTracks_.insert(trackId);
+    }
+    if (!changes.added.empty() || !changes.removed.empty() || changes.reordered) {
+        trackOrderDirty_ = true;
+    }
+}
+
+void AutosaveManager::clipChangesCoalesced(const ClipChangeSet& changes) {
+    if (changes.reset) {
+        checkpointNeeded_ = true;
+        return;
+    }
+
+    const auto& clipManager = ClipManager::getInstance();
+    auto markClip = [this, &clipManager](ClipId clipId) {
+        const auto* clip = clipManager.getClip(clipId);
+        if (clip == nullptr) {
+            return;
+        }
+        // A clip moved between tracks leaves the old track's section to rewrite too
+        auto it = clipTracks_.find(clipId);
+        if (it != clipTracks_.end() && it->second != clip->trackId) {
+            dirtyClipTracks_.insert(it->second);
+        }
+        clipTracks_[clipId] = clip->trackId;
+        dirtyClipTracks_.insert(clip->trackId);
+    };
+
+    for (auto clipId : changes.added) {
+        markClip(clipId);
+    }
+    for (const auto& [clipId, dirty] : changes.modified) {
+        markClip(clipId);
+    }
+    for (auto clipId : changes.removed) {
+        if (auto it = clipTracks_.find(clipId); it != clipTracks_.end()) {
+            dirtyClipTracks_.insert(it->second);
+            clipTracks_.erase(it);
+        }
+    }
+}
+
+void AutosaveManager::automationLanesChanged() {
+    allLanesDirty_ = true;
+}
+
+void AutosaveManager::automationLanePropertyChanged(AutomationLaneId laneId) {
+    dirtyLanes_.insert(laneId);
+}
+
+void AutosaveManager::automationClipsChanged(AutomationLaneId laneId) {
+    dirtyLanes_.insert(laneId);
+}
+
+void AutosaveManager::automationPointsChanged(AutomationLaneId laneId) {
+    dirtyLanes_.insert(laneId);
+}
+
+void AutosaveManager::undoStateChanged() {
+    // Posted behind the managers' change sets for the same command
+    triggerAsyncUpdate();
+}
+
+void AutosaveManager::handleAsyncUpdate() {
+    flush();
+}
+
+void AutosaveManager::timerCallback() {
+    const auto sinceCheckpoint = juce::Time::currentTimeMillis() - lastCheckpointMs_;
+    if (journalBytes_.load() > kCheckpointJournalBytes ||
+        (sinceCheckpoint > kCheckpointIntervalMs && editsSinceCheckpoint_)) {
+        checkpointNeeded_ = true;
+    }
+    flush();
+}
+
+// =============================================================================
+// Journaling
+// =============================================================================
+
+void AutosaveManager::flush() {
+    if (!running_) {
+        return;
+    }
+
+    // Into the current journal first, so nothing is lost if the checkpoint fails
+    if (hasPendingEdits() && !checkpointNeeded_) {
+        journalPendingEdits();
+    }
+    if (checkpointNeeded_) {
+        checkpoint();  // Retried on the next flush if a save is running
+    }
+}
+
+bool AutosaveManager::hasPendingEdits() const {
+    return masterDirty_ || trackOrderDirty_ || allLanesDirty_ || !dirtyTracks_.empty() ||
+           !removedTracks_.empty() || !dirtyClipTracks_.empty() || !dirtyLanes_.empty() ||
+           ProjectManager::getInstance().getCurrentFile() != journaledProjectFile_;
+}
+
+void AutosaveManager::journalPendingEdits() {
+    const auto& trackManager = TrackManager::getInstance();
+    const auto& clipManager = ClipManager::getInstance();
+    const auto& automationManager = AutomationManager::getInstance();
+
+    auto delta = std::make_shared<Delta>();
+    auto& model = delta->model;
+
+    for (auto trackId : dirtyTracks_) {
+        if (const auto* track = trackManager.getTrack(trackId)) {
+            model.tracks.push_back(*track);
+        }
+    }
+    for (auto trackId : removedTracks_) {
+        delta->records.push_back(makeRemoval(ProjectFile::kTrackSection, trackId));
+    }
+    if (trackOrderDirty_) {
+        std::vector<TrackId> order;
+        for (const auto& track : trackManager.getTracks()) {
+            order.push_back(track.id);
+        }
+        delta->records.push_back(ProjectJournal::makeTrackOrderRecord(order));
+    }
+    if (masterDirty_) {
+        model.master = trackManager.getMasterChannel();
+        delta->includeMaster = true;
+    }
+
+    if (!dirtyClipTracks_.empty()) {
+        for (const auto& clip : clipManager.getClips()) {
+            if (dirtyClipTracks_.count(clip.trackId) > 0) {
+                model.clips.push_back(clip);
+            }
+        }
+        delta->clipTracks.assign(dirtyClipTracks_.begin(), dirtyClipTracks_.end());
+    }
+
+    // Lanes are few; a structural change rewrites them all and works out the removed ones
+    std::unordered_set<AutomationLaneId> lanes;
+    for (const auto& lane : automationManager.getLanes()) {
+        lanes.insert(lane.id);
+        if (!allLanesDirty_ && dirtyLanes_.count(lane.id) == 0) {
+            continue;
+        }
+        model.automationLanes.push_back(lane);
+        for (auto clipId : lane.clipIds) {
+            if (const auto* clip = automationManager.getClip(clipId)) {
+                model.automationClips.push_back(*clip);
+            }
+        }
+    }
+    for (auto laneId : knownLanes_) {
+        if (lanes.count(laneId) == 0) {
+            delta->records.push_back(makeRemoval(ProjectFile::kLaneSection, laneId));
+        }
+    }
+    knownLanes_ = std::move(lanes);
+
+    const auto& projectFile = ProjectManager::getInstance().getCurrentFile();
+    if (projectFile != journaledProjectFile_) {
+        journaledProjectFile_ = projectFile;
+        delta->records.push_back(ProjectJournal::makeProjectFileRecord(projectFile));
+    }
+
+    clearPendingEdits();
+    editsSinceCheckpoint_ = true;
+    pool_->addJob([this, delta]() { appendDelta(*delta); });
+}
+
+bool AutosaveManager::checkpoint() {
+    const auto generation = generation_ + 1;
+    const auto file = ProjectJournal::getCheckpointFile(directory_, generation);
+    directory_.createDirectory();
+
+    auto onWritten = [this, generation, file](const juce::String& error) {
+        if (!running_) {
+            file.deleteFile();  // Shut down while it was being written
+        } else if (error.isNotEmpty()) {
+            DBG("AutosaveManager: checkpoint failed - " << error);
+            checkpointNeeded_ = true;
+        } else {
+            // Everything older is now covered by this checkpoint and its journal
+            pool_->addJob([directory = directory_, generation]() {
+                ProjectJournal::deleteGenerationsBefore(directory, generation);
+            });
+        }
+    };
+    if (!ProjectManager::getInstance().saveCopyAsync(file, onWritten)) {
+        return false;
+    }
+
+    // Edits from here on go to the new generation's journal
+    generation_ = generation;
+    checkpointNeeded_ = false;
+    editsSinceCheckpoint_ = false;
+    lastCheckpointMs_ = juce::Time::currentTimeMillis();
+    clearPendingEdits();
+    rememberKnownIds();
+
+    journaledProjectFile_ = ProjectManager::getInstance().getCurrentFile();
+    journalBytes_ = 0;
+    pool_->addJob([this, generation, projectFile = journaledProjectFile_]() {
+        startJournal(generation, projectFile);
+    });
+    return true;
+}
+
+void AutosaveManager::clearPendingEdits() {
+    masterDirty_ = false;
+    trackOrderDirty_ = false;
+    allLanesDirty_ = false;
+    dirtyTracks_.clear();
+    removedTracks_.clear();
+    dirtyClipTracks_.clear();
+    dirtyLanes_.clear();
+}
+
+void AutosaveManager::rememberKnownIds() {
+    clipTracks_.clear();
+    for (const auto& clip : ClipManager::getInstance().getClips()) {
+        clipTracks_[clip.id] = clip.trackId;
+    }
+    knownLanes_.clear();
+    for (const auto& lane : AutomationManager::getInstance().getLanes()) {
+        knownLanes_.insert(lane.id);
+    }
+}
+
+// =============================================================================
+// Pool thread
+// =============================================================================
+
+void AutosaveManager::startJournal(juce::int64 generation, const juce::File& projectFile) {
+    juce::String error;
+    writer_ = ProjectJournal::Writer::create(ProjectJournal::getJournalFile(directory_, generation),
+                                             generation, error);
+    journaledHashes_.clear();
+    if (writer_ == nullptr) {
+        DBG("AutosaveManager: " << error);
+        return;
+    }
+    writer_->append({ProjectJournal::makeProjectFileRecord(projectFile)});
+}
+
+void AutosaveManager::appendDelta(const Delta& delta) {
+    if (writer_ == nullptr) {
+        return;
+    }
+
+    std::vector<ProjectJournal::Record> records;
+    auto addSection = [this, &records](int type, int key, const juce::MemoryBlock& data) {
+        const auto hash = hashSection(data);
+        auto [it, inserted] = journaledHashes_.try_emplace({type, key}, hash);
+        if (!inserted && it->second == hash) {
+            return;  // Touched but unchanged (a clip launched, a value set to itself)
+        }
+        it->second = hash;
+        records.push_back({type, key, data, false});
+    };
+
+    std::unordered_set<TrackId> clipTracksWritten;
+    ProjectFile::encodeSections(
+        delta.model, [&](int type, int key, const juce::MemoryBlock& data) {
+            if (type == ProjectFile::kMasterSection && !delta.includeMaster) {
+                return;
+            }
+            if (type == ProjectFile::kClipSection) {
+                clipTracksWritten.insert(key);
+            }
+            addSection(type, key, data);
+        });
+
+    // A track whose last clip went has no section left
+    for (auto trackId : delta.clipTracks) {
+        if (clipTracksWritten.count(trackId) == 0) {
+            journaledHashes_.erase({ProjectFile::kClipSection, trackId});
+            records.push_back(makeRemoval(ProjectFile::kClipSection, trackId));
+        }
+    }
+    for (const auto& record : delta.records) {
+        if (record.removed) {
+            journaledHashes_.erase({record.type, record.key});
+        }
+        records.push_back(record);
+    }
+
+    if (records.empty()) {
+        return;
+    }
+    const auto error = writer_->append(records);
+    if (error.isNotEmpty()) {
+        DBG("AutosaveManager: " << error);
+    }
+    journalBytes_ = writer_->getSize();
+}
+
+}  // namespace magda
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <juce_events/juce_events.h>
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#include "AutomationManager.hpp"
+#include "ClipManager.hpp"
+#include "ProjectJournal.hpp"
+#include "TrackManager.hpp"
+#include "UndoManager.hpp"
+
+namespace magda {
+
+/**
+ * @brief Autosaves the project as a journal of edits over periodic checkpoints
+ *
+ * Edits are tracked from the managers' coalesced change sets and journaled after each
+ * undo step (and every few seconds, for edits that aren't commands): only the tracks,
+ * per-track clip lists and automation lanes that changed are copied on the message
+ * thread, then encoded and appended on a pool thread, skipping any that encode the same
+ * as last time. A checkpoint (a full project written by ProjectManager::saveCopyAsync)
+ * starts a new journal once the current one grows large or old, and after the project is
+ * replaced wholesale.
+ *
+ * Files live in getDirectory() and are deleted on a clean shutdown, so finding any at
+ * startup means the last session crashed (see ProjectManager::recoverAsync).
+ */
+class AutosaveManager : public TrackManagerListener,
+                        public ClipManagerListener,
+                        public AutomationManagerListener,
+                        public UndoManagerListener,
+                        private juce::Timer,
+                        private juce::AsyncUpdater {
+  public:
+    static AutosaveManager& getInstance();
+
+    // Prevent copying
+    AutosaveManager(const AutosaveManager&) = delete;
+    AutosaveManager& operator=(const AutosaveManager&) = delete;
+
+    static constexpr int kFlushIntervalMs = 2000;
+    static constexpr juce::int64 kCheckpointJournalBytes = 8 * 1024 * 1024;
+    static constexpr juce::int64 kCheckpointIntervalMs = 10 * 60 * 1000;
+
+    const juce::File& getDirectory() const {
+        return directory_;
+    }
+
+    /**
+     * @brief Whether the last session left an autosave behind
+     */
+    bool hasRecoveryData() const;
+
+    /**
+     * @brief Start autosaving the current project, discarding any earlier autosave
+     */
+    void start();
+
+    /**
+     * @brief Stop on a clean exit: finish writing, then delete the autosave
+     *
+     * Call before the managers shut down.
+     */
+    void shutdown();
+
+    bool isRunning() const {
+        return running_;
+    }
+
+    /**
+     * @brief Journal the edits made since the last flush now
+     */
+    void flush();
+
+    // TrackManagerListener
+    void tracksChanged() override {}
+    void masterChannelChanged() override;
+    void trackChangesCoalesced(const TrackChangeSet& changes) override;
+
+    // ClipManagerListener
+    void clipsChanged() override {}
+    void clipChangesCoalesced(const ClipChangeSet& changes) override;
+
+    // AutomationManagerListener
+    void automationLanesChanged() override;
+    void automationLanePropertyChanged(AutomationLaneId laneId) override;
+    void automationClipsChanged(AutomationLaneId laneId) override;
+    void automationPointsChanged(AutomationLaneId laneId) override;
+
+    // UndoManagerListener
+    void undoStateChanged() override;
+
+  private:
+    AutosaveManager();
+    ~AutosaveManager() override;
+
+    /**
+     * @brief The sections one flush rewrites, copied from the managers
+     */
+    struct Delta {
+        ProjectModel model;  // Only the edited tracks, clips and lanes
+        bool includeMaster = false;
+        std::vector<TrackId> clipTracks;              // Clip sections rewritten (or emptied)
+        std::vector<ProjectJournal::Record> records;  // Removals, track order, project file
+    };
+
+    void timerCallback() override;
+    void handleAsyncUpdate() override;
+
+    bool hasPendingEdits() const;
+    void journalPendingEdits();
+    bool checkpoint();
+    void clearPendingEdits();
+    void rememberKnownIds();
+
+    // Pool thread only
+    void startJournal(juce::int64 generation, const juce::File& projectFile);
+    void appendDelta(const Delta& delta);
+
+    juce::File directory_;
+    bool running_ = false;
+    juce::int64 generation_ = 0;
+    juce::int64 lastCheckpointMs_ = 0;
+    bool editsSinceCheckpoint_ = false;
+    juce::File journaledProjectFile_;
+
+    // Edits since the last flush
+    bool checkpointNeeded_ = false;
+    bool masterDirty_ = false;
+    bool trackOrderDirty_ = false;
+    bool allLanesDirty_ = false;
+    std::unordered_set<TrackId> dirtyTracks_;
+    std::unordered_set<TrackId> removedTracks_;
+    std::unordered_set<TrackId> dirtyClipTracks_;
+    std::unordered_set<AutomationLaneId> dirtyLanes_;
+
+    // What the journal holds, for telling where removed things were
+    std::unordered_map<ClipId, TrackId> clipTracks_;
+    std::unordered_set<AutomationLaneId> knownLanes_;
+
+    // Pool thread only
+    std::unique_ptr<ProjectJournal::Writer> writer_;
+    std::map<std::pair<int, int>, juce::int64> journaledHashes_;
+
+    std::atomic<juce::int64> journalBytes_{0};
+    std::unique_ptr<juce::ThreadPool> pool_;
+};
+
+}  // namespace magda
@@ -0,0 +1,134 @@
+#include "BatchOperations.hpp"
+
+#include <memory>
+#include <utility>
+
+#include "ClipCommands.hpp"
+#include "ClipManager.hpp"
+#include "MidiNoteCommands.hpp"
+#include "TrackCommands.hpp"
+#include "TrackManager.hpp"
+#include "UndoManager.hpp"
+
+namespace magda {
+
+namespace {
+
+BatchResult failure(const std::string& error) {
+    BatchResult result;
+    result.error = error;
+    return result;
+}
+
+BatchResult success(int id) {
+    BatchResult result;
+    result.success = true;
+    result.id = id;
+    return result;
+}
+
+BatchResult apply(const BatchOperation& operation, int id) {
+    auto& trackManager = TrackManager::getInstance();
+    auto& clipManager = ClipManager::getInstance();
+    auto& undoManager = UndoManager::getInstance();
+
+    switch (operation.type) {
+        case BatchOperation::Type::CreateTrack: {
+            auto command = std::make_unique<CreateTrackCommand>(
+                operation.trackType, juce::String(operation.name));
+            auto* created = command.get();
+            undoManager.executeCommand(std::move(command));
+            if (created->getCreatedTrackId() == INVALID_TRACK_ID) {
+                return failure("Track could not be created");
+            }
+            return success(created->getCreatedTrackId());
+        }
+
+        case BatchOperation::Type::AddMidiClip: {
+            if (!trackManager.getTrack(id)) {
+                return failure("No track " + std::to_string(id));
+            }
+            if (operation.length <= 0.0) {
+                return failure("Clip length must be positive");
+            }
+            auto command = std::make_unique<CreateClipCommand>(
+                ClipType::MIDI, id, operation.startTime, operation.length);
+            auto* created = command.get();
+            undoManager.executeCommand(std::move(command));
+            if (created->getCreatedClipId() == INVALID_CLIP_ID) {
+                return failure("Clip could not be created on track " + std::to_string(id));
+            }
+            return success(created->getCreatedClipId());
+        }
+
+        case BatchOperation::Type::AddNotes: {
+            const auto* clip = clipManager.getClip(id);
+            if (!clip || clip->type != ClipType::MIDI) {
+                return failure("No MIDI clip " + std::to_string(id));
+            }
+            if (!operation.notes.empty()) {
+                undoManager.executeCommand(
+                    std::make_unique<AddMidiNotesCommand>(id, operation.notes));
+            }
+            return success(id);
+        }
+
+        case BatchOperation::Type::SetParameter: {
+            const auto* device = trackManager.findDevice(id);
+            if (!device) {
+                return failure("No device " + std::to_string(id));
+            }
+            if (operation.paramIndex < 0 ||
+                operation.paramIndex >= static_cast<int>(device->parameters.size())) {
+                return failure("Device " + std::to_string(id) + " has no parameter " +
+                               std::to_string(operation.paramIndex));
+            }
+            trackManager.setDeviceParameterValue(trackManager.findDevicePath(id),
+                                                 operation.paramIndex, operation.value);
+            return success(id);
+        }
+
+        case BatchOperation::Type::SetTrackVolume:
+        case BatchOperation::Type::SetTrackPan:
+            if (!trackManager.getTrack(id)) {
+                return failure("No track " + std::to_string(id));
+            }
+            if (operation.type == BatchOperation::Type::SetTrackVolume) {
+                trackManager.setTrackVolume(id, operation.value);
+            } else {
+                trackManager.setTrackPan(id, operation.value);
+            }
+            return success(id);
+    }
+
+    return failure("Unknown operation");
+}
+
+}  // namespace
+
+std::vector<BatchResult> applyBatch(const std::vector<BatchOperation>& operations,
+                                    const juce::String& description) {
+    std::vector<BatchResult> results;
+    results.reserve(operations.size());
+
+    CompoundOperationScope scope(description);
+    for (const auto& operation : operations) {
+        int id = operation.id;
+        if (operation.idFrom >= 0) {
+            const auto from = static_cast<size_t>(operation.idFrom);
+            if (from >= results.size()) {
+                results.push_back(failure("idFrom must name an earlier operation"));
+                continue;
+            }
+            if (!results[from].success) {
+                results.push_back(failure("Operation " + std::to_string(from) + " failed"));
+                continue;
+            }
+            id = results[from].id;
+        }
+        results.push_back(apply(operation, id));
+    }
+    return results;
+}
+
+}  // namespace magda
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "ClipInfo.hpp"
+#include "TrackTypes.hpp"
+#include "TypeIds.hpp"
+
+namespace magda {
+
+/**
+ * @brief One step of a batch edit, addressed by integer model ids
+ *
+ * Which fields are read depends on type. To act on something created earlier in the same
+ * batch, set idFrom to that operation's index instead of setting id.
+ */
+struct BatchOperation {
+    enum class Type {
+        CreateTrack,     // trackType, name -> the new TrackId
+        AddMidiClip,     // id (TrackId), startTime, length in seconds -> the new ClipId
+        AddNotes,        // id (ClipId of a MIDI clip), notes
+        SetParameter,    // id (DeviceId), paramIndex, value in real units (see ParameterInfo)
+        SetTrackVolume,  // id (TrackId), value as linear gain
+        SetTrackPan,     // id (TrackId), value from -1 (left) to 1 (right)
+    };
+
+    Type type = Type::CreateTrack;
+    int id = -1;
+    int idFrom = -1;  // >= 0: use the result id of this earlier operation
+
+    TrackType trackType = TrackType::Audio;
+    std::string name;
+    double startTime = 0.0;
+    double length = 0.0;
+    std::vector<MidiNote> notes;
+    int paramIndex = -1;
+    float value = 0.0f;
+};
+
+/**
+ * @brief Outcome of one BatchOperation, at the same index as the operation
+ */
+struct BatchResult {
+    bool success = false;
+    int id = -1;  // Created or edited TrackId / ClipId / DeviceId
+    std::string error;
+};
+
+/**
+ * @brief Apply operations in order as one undo step
+ *
+ * Creations and note edits run as undoable commands inside one CompoundOperationScope, so
+ * the batch undoes in one step and AudioBridge syncs the engine once, after the scope
+ * closes, instead of per call. Parameter, volume and pan changes are applied directly, as
+ * the UI's controls do, and aren't part of the undo step. A failed operation doesn't stop
+ * the batch; operations that take their id from it fail too. Message thread only.
+ *
+ * @return One result per operation
+ */
+std::vector<BatchResult> applyBatch(const std::vector<BatchOperation>& operations,
+                                    const juce::String& description = "Batch Edit");
+
+}  // namespace magda
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <unordered_map>
+#include <unordered_set>
+
+namespace magda {
+
+/**
+ * @brief Ids added, removed or modified since the last delivery, with what changed on each
+ *
+ * Managers record into a ChangeSet as edits happen and hand it to listeners once per
+ * message-loop tick, so a burst of edits (a project load, a multi-track fader move) reaches
+ * each listener as one set. Recording is net: an id added and removed in the same tick is
+ * not reported at all, and an id that was added is not also reported as modified. Flags is
+ * an enum class bit mask with None and All and an operator|.
+ */
+template <typename Id, typename Flags> struct ChangeSet {
+    std::unordered_set<Id> added;
+    std::unordered_set<Id> removed;
+    std::unordered_map<Id, Flags> modified;
+    bool reordered = false;  // Existing ids changed order
+    bool reset = false;      // Edited wholesale: refresh everything, the ids above are partial
+
+    void markAdded(Id id) {
+        if (removed.erase(id) > 0) {
+            // Removed and restored in one tick: listeners still have it, but it may differ
+            modified[id] = Flags::All;
+            return;
+        }
+        added.insert(id);
+        modified.erase(id);
+    }
+
+    void markRemoved(Id id) {
+        modified.erase(id);
+        if (added.erase(id) == 0) {
+            removed.insert(id);
+        }
+    }
+
+    void markModified(Id id, Flags flags) {
+        if (added.count(id) > 0) {
+            return;  // Listeners build added ids from scratch
+        }
+        auto it = modified.find(id);
+        if (it != modified.end()) {
+            it->second = it->second | flags;
+        } else {
+            modified.emplace(id, flags);
+        }
+    }
+
+    void markReset() {
+        clear();
+        reset = true;
+    }
+
+    /**
+     * @brief What changed on a modified id (None if it wasn't modified)
+     */
+    Flags flagsFor(Id id) const {
+        auto it = modified.find(id);
+        return it != modified.end() ? it->second : Flags::None;
+    }
+
+    bool empty() const {
+        return added.empty() && removed.empty() && modified.empty() && !reordered && !reset;
+    }
+
+    void clear() {
+        added.clear();
+        removed.clear();
+        modified.clear();
+        reordered = false;
+        reset = false;
+    }
+};
+
+}  // namespace magda
@@ -2,6 +2,8 @@
 
 #include <iostream>
 
+#include "ProjectFile.hpp"
+
 namespace magda {
 
 // ============================================================================
@@ -231,7 +233,8 @@ void DeleteClipCommand::execute() {
 }
 
 void DeleteClipCommand::undo() {
-    if (!executed_) {
+    // No id if the state couldn't be paged back in
+    if (!executed_ || storedClip_.id == INVALID_CLIP_ID) {
         return;
     }
 
@@ -240,23 +243,39 @@ void DeleteClipCommand::undo() {
     std::cout << "📝 UNDO: Restored clip " << clipId_ << std::endl;
 }
 
+bool DeleteClipCommand::spillState(juce::OutputStream& out) {
+    if (!executed_) {
+        return false;
+    }
+    ProjectFile::writeClip(out, storedClip_);
+    storedClip_ = ClipInfo();
+    return true;
+}
+
+void DeleteClipCommand::restoreState(juce::InputStream& in) {
+    storedClip_ = ProjectFile::readClip(in);
+}
+
 // ============================================================================
 // CreateClipCommand
 // ============================================================================
 
 CreateClipCommand::CreateClipCommand(ClipType type, TrackId trackId, double startTime,
-                                     double length, const juce::String& audioFilePath)
+                                     double length, const juce::String& audioFilePath,
+                                     double sourceOffset)
     : type_(type),
       trackId_(trackId),
       startTime_(startTime),
       length_(length),
-      audioFilePath_(audioFilePath) {}
+      audioFilePath_(audioFilePath),
+      sourceOffset_(sourceOffset) {}
 
 void CreateClipCommand::execute() {
     auto& clipManager = ClipManager::getInstance();
 
     if (type_ == ClipType::Audio) {
-        createdClipId_ = clipManager.createAudioClip(trackId_, startTime_, length_, audioFilePath_);
+        createdClipId_ = clipManager.createAudioClip(trackId_, startTime_, length_,
+                                                     audioFilePath_, sourceOffset_);
     } else {
         createdClipId_ = clipManager.createMidiClip(trackId_, startTime_, length_);
     }
@@ -301,4 +320,67 @@ void DuplicateClipCommand::undo() {
     ClipManager::getInstance().deleteClip(duplicatedClipId_);
 }
 
+// ============================================================================
+// RecordMidiTakeCommand
+// ============================================================================
+
+RecordMidiTakeCommand::RecordMidiTakeCommand(const ClipInfo& recordedClip)
+    : clip_(recordedClip) {}
+
+void RecordMidiTakeCommand::execute() {
+    // Already in the ClipManager the first time
+    if (executed_) {
+        ClipManager::getInstance().restoreClip(clip_);
+    }
+    executed_ = true;
+}
+
+void RecordMidiTakeCommand::undo() {
+    if (!executed_ || clip_.id == INVALID_CLIP_ID) {
+        return;
+    }
+
+    ClipManager::getInstance().deleteClip(clip_.id);
+}
+
+bool RecordMidiTakeCommand::spillState(juce::OutputStream& out) {
+    ProjectFile::writeClip(out, clip_);
+    clip_ = ClipInfo();
+    return true;
+}
+
+void RecordMidiTakeCommand::restoreState(juce::InputStream& in) {
+    clip_ = ProjectFile::readClip(in);
+}
+
+// ============================================================================
+// ReplaceAudioSourcesCommand
+// ============================================================================
+
+ReplaceAudioSourcesCommand::ReplaceAudioSourcesCommand(ClipId clipId, AudioSourceList sources,
+                                                       juce::String description)
+    : clipId_(clipId), newSources_(std::move(sources)), description_(std::move(description)) {}
+
+void ReplaceAudioSourcesCommand::execute() {
+    auto& clipManager = ClipManager::getInstance();
+    const auto* clip = clipManager.getClip(clipId_);
+    if (!clip) {
+        return;
+    }
+
+    if (!executed_) {
+        oldSources_ = clip->audioSources;
+    }
+    clipManager.setAudioSources(clipId_, newSources_);
+    executed_ = true;
+}
+
+void ReplaceAudioSourcesCommand::undo() {
+    if (!executed_) {
+        return;
+    }
+
+    ClipManager::getInstance().setAudioSources(clipId_, oldSources_);
+}
+
 }  // namespace magda
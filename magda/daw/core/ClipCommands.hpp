@@ -120,6 +120,12 @@ class DeleteClipCommand : public UndoableCommand {
     juce::String getDescription() const override {
         return "Delete Clip";
     }
+    size_t getSizeInBytes() const override {
+        return sizeof(*this) + storedClip_.midiNotes.size() * sizeof(MidiNote) +
+               storedClip_.audioSources.size() * sizeof(AudioSource);
+    }
+    bool spillState(juce::OutputStream& out) override;
+    void restoreState(juce::InputStream& in) override;
 
   private:
     ClipId clipId_;
@@ -135,7 +141,7 @@ class DeleteClipCommand : public UndoableCommand {
 class CreateClipCommand : public UndoableCommand {
   public:
     CreateClipCommand(ClipType type, TrackId trackId, double startTime, double length,
-                      const juce::String& audioFilePath = {});
+                      const juce::String& audioFilePath = {}, double sourceOffset = 0.0);
 
     void execute() override;
     void undo() override;
@@ -153,6 +159,7 @@ class CreateClipCommand : public UndoableCommand {
     double startTime_;
     double length_;
     juce::String audioFilePath_;
+    double sourceOffset_;
     ClipId createdClipId_ = INVALID_CLIP_ID;
     bool executed_ = false;
 };
@@ -183,4 +190,54 @@ class DuplicateClipCommand : public UndoableCommand {
     bool executed_ = false;
 };
 
+/**
+ * @brief The undo step for a recorded MIDI take
+ *
+ * The take's clip was created and filled while recording, so the first execute() only
+ * records it; undo deletes the clip and redo restores it as it was when recording ended.
+ */
+class RecordMidiTakeCommand : public UndoableCommand {
+  public:
+    explicit RecordMidiTakeCommand(const ClipInfo& recordedClip);
+
+    void execute() override;
+    void undo() override;
+    juce::String getDescription() const override {
+        return "Record MIDI";
+    }
+    size_t getSizeInBytes() const override {
+        return sizeof(*this) + clip_.midiNotes.size() * sizeof(MidiNote);
+    }
+    bool spillState(juce::OutputStream& out) override;
+    void restoreState(juce::InputStream& in) override;
+
+  private:
+    ClipInfo clip_;
+    bool executed_ = false;
+};
+
+/**
+ * @brief Switches an audio clip to a processed render of itself (see ClipProcessor)
+ *
+ * The clip's previous sources are taken on the first execute and restored on undo; their
+ * files are untouched either way.
+ */
+class ReplaceAudioSourcesCommand : public UndoableCommand {
+  public:
+    ReplaceAudioSourcesCommand(ClipId clipId, AudioSourceList sources, juce::String description);
+
+    void execute() override;
+    void undo() override;
+    juce::String getDescription() const override {
+        return description_;
+    }
+
+  private:
+    ClipId clipId_;
+    AudioSourceList newSources_;
+    AudioSourceList oldSources_;
+    juce::String description_;
+    bool executed_ = false;
+};
+
 }  // namespace magda
@@ -6,19 +6,38 @@
 #include <vector>
 
 #include "ClipTypes.hpp"
+#include "CowVector.hpp"
+#include "MidiNoteList.hpp"
 #include "TrackTypes.hpp"
 #include "TypeIds.hpp"
 
 namespace magda {
 
 /**
- * @brief MIDI note data for MIDI clips
+ * @brief Gain shape of a fade
  */
-struct MidiNote {
-    int noteNumber = 60;       // MIDI note number (0-127)
-    int velocity = 100;        // Note velocity (0-127)
-    double startBeat = 0.0;    // Start position in beats within clip
-    double lengthBeats = 1.0;  // Duration in beats
+enum class FadeCurve {
+    Linear,
+    EqualPower,  // sin/cos: overlapping fades in and out keep constant power
+    SCurve,      // Eases in and out
+};
+
+/**
+ * @brief A fade at one edge of an audio source
+ *
+ * tension bends the curve: positive rises early, negative late, 0 leaves it as it is.
+ */
+struct AudioFade {
+    double length = 0.0;  // Seconds, 0 for none
+    FadeCurve curve = FadeCurve::EqualPower;
+    float tension = 0.0f;  // -1 to 1
+
+    bool operator==(const AudioFade& other) const {
+        return length == other.length && curve == other.curve && tension == other.tension;
+    }
+    bool operator!=(const AudioFade& other) const {
+        return !(*this == other);
+    }
 };
 
 /**
@@ -34,10 +53,21 @@ struct AudioSource {
     double offset = 0.0;         // File start offset for trimming (seconds)
     double length = 0.0;         // Visible/playable duration (seconds)
     double stretchFactor = 1.0;  // Time stretch factor (future use)
+    AudioFade fadeIn;            // Rising from where the source starts playing
+    AudioFade fadeOut;           // Falling to where it stops
 };
 
+/**
+ * @brief A clip's sources, shared by its copies until one of them is edited
+ */
+using AudioSourceList = CowVector<AudioSource>;
+
 /**
  * @brief Clip data structure containing all clip properties
+ *
+ * The payload (audioSources, midiNotes) is copy-on-write, so copying a clip - the
+ * clipboard, a duplicate, an undo command's before-image - shares it until either copy
+ * edits it.
  */
 struct ClipInfo {
     ClipId id = INVALID_CLIP_ID;
@@ -55,15 +85,17 @@ struct ClipInfo {
     double internalLoopLength = 4.0;  // In beats
 
     // Audio-specific properties
-    std::vector<AudioSource> audioSources;
+    AudioSourceList audioSources;
 
     // MIDI-specific properties
-    std::vector<MidiNote> midiNotes;
+    MidiNoteList midiNotes;  // Sorted by start beat
 
     // Session view properties
     int sceneIndex = -1;     // -1 = not in session view (arrangement only)
     bool isPlaying = false;  // Currently playing in session
     bool isQueued = false;   // Queued to start
+    FollowAction followAction = FollowAction::None;
+    double followActionBeats = 16.0;  // Playing time before the follow action
 
     // Helpers
     double getEndTime() const {
@@ -0,0 +1,72 @@
+#include "ClipIntervalIndex.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace magda {
+
+void ClipIntervalIndex::build(std::vector<Interval> intervals) {
+    intervals_ = std::move(intervals);
+    std::stable_sort(intervals_.begin(), intervals_.end(),
+                     [](const Interval& a, const Interval& b) { return a.start < b.start; });
+
+    maxEnd_.assign(intervals_.empty() ? 0 : intervals_.size() * 4, 0.0);
+    if (!intervals_.empty()) {
+        buildNode(1, 0, intervals_.size());
+    }
+}
+
+void ClipIntervalIndex::clear() {
+    intervals_.clear();
+    maxEnd_.clear();
+}
+
+void ClipIntervalIndex::buildNode(size_t node, size_t lo, size_t hi) {
+    if (hi - lo == 1) {
+        maxEnd_[node] = intervals_[lo].end;
+        return;
+    }
+
+    const size_t mid = lo + (hi - lo) / 2;
+    buildNode(node * 2, lo, mid);
+    buildNode(node * 2 + 1, mid, hi);
+    maxEnd_[node] = std::max(maxEnd_[node * 2], maxEnd_[node * 2 + 1]);
+}
+
+void ClipIntervalIndex::query(double startTime, double endTime,
+                              std::vector<Interval>& out) const {
+    if (intervals_.empty() || endTime <= startTime) {
+        return;
+    }
+
+    // Only intervals starting before the end of the query can overlap it
+    auto startsBefore = [](const Interval& interval, double time) {
+        return interval.start < time;
+    };
+    const auto limit = static_cast<size_t>(
+        std::lower_bound(intervals_.begin(), intervals_.end(), endTime, startsBefore) -
+        intervals_.begin());
+
+    if (limit > 0) {
+        queryNode(1, 0, intervals_.size(), limit, startTime, out);
+    }
+}
+
+void ClipIntervalIndex::queryNode(size_t node, size_t lo, size_t hi, size_t limit,
+                                  double startTime, std::vector<Interval>& out) const {
+    // Nothing in this run starts early enough or ends late enough
+    if (lo >= limit || maxEnd_[node] <= startTime) {
+        return;
+    }
+
+    if (hi - lo == 1) {
+        out.push_back(intervals_[lo]);
+        return;
+    }
+
+    const size_t mid = lo + (hi - lo) / 2;
+    queryNode(node * 2, lo, mid, limit, startTime, out);
+    queryNode(node * 2 + 1, mid, hi, limit, startTime, out);
+}
+
+}  // namespace magda
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "ClipTypes.hpp"
+
+namespace magda {
+
+/**
+ * @brief Range index over the clips of one track
+ *
+ * Intervals are kept sorted by start time with an implicit segment tree of the largest end
+ * time over each run, so a query only descends into runs that can overlap it: O(log n + k)
+ * for k results instead of a scan over every clip on the track.
+ *
+ * Built in one pass from (id, start, end) triples; rebuild it when the track's clips change.
+ */
+class ClipIntervalIndex {
+  public:
+    struct Interval {
+        ClipId id = INVALID_CLIP_ID;
+        double start = 0.0;
+        double end = 0.0;
+    };
+
+    /**
+     * @brief Replace the contents (any order)
+     */
+    void build(std::vector<Interval> intervals);
+    void clear();
+
+    size_t size() const {
+        return intervals_.size();
+    }
+    bool empty() const {
+        return intervals_.empty();
+    }
+
+    /**
+     * @brief Intervals overlapping [startTime, endTime), in start order
+     *
+     * Results are appended to out.
+     */
+    void query(double startTime, double endTime, std::vector<Interval>& out) const;
+
+    /**
+     * @brief All intervals, sorted by start time
+     */
+    const std::vector<Interval>& getIntervals() const {
+        return intervals_;
+    }
+
+    size_t getSizeInBytes() const {
+        return intervals_.capacity() * sizeof(Interval) + maxEnd_.capacity() * sizeof(double);
+    }
+
+  private:
+    void buildNode(size_t node, size_t lo, size_t hi);
+    void queryNode(size_t node, size_t lo, size_t hi, size_t limit, double startTime,
+                   std::vector<Interval>& out) const;
+
+    std::vector<Interval> intervals_;
+    std::vector<double> maxEnd_;  // Segment tree over intervals_, root at 1
+};
+
+}  // namespace magda
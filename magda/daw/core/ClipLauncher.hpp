@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "ClipTypes.hpp"
+#include "TypeIds.hpp"
+
+namespace magda {
+
+/**
+ * @brief A session clip launch or stop waiting for its quantised beat
+ */
+struct ClipLaunchRequest {
+    enum class Action : uint8_t { Launch, Stop };
+
+    Action action = Action::Launch;
+    ClipId clipId = INVALID_CLIP_ID;
+    TrackId trackId = INVALID_TRACK_ID;
+    double quantiseBeats = 1.0;  // 0 = at the next block
+
+    // A follow-up (a follow action, or the next scene of a chain) isn't quantised: it fires
+    // afterBeats of playing time after afterClipId was launched
+    ClipId afterClipId = INVALID_CLIP_ID;
+    double afterBeats = 0.0;
+
+    bool isFollowUp() const {
+        return afterClipId != INVALID_CLIP_ID;
+    }
+};
+
+/**
+ * @brief Where ClipManager sends session launches to be timed (the audio engine)
+ *
+ * Requests handed over together, such as a scene, fire in the same sample. The launcher
+ * reports each one back through ClipManager::clipLaunchFired() / clipStopFired().
+ * Follow-ups fire on the launcher's own clock, so the launcher must time them without
+ * waiting on the message thread.
+ */
+class ClipLauncher {
+  public:
+    virtual ~ClipLauncher() = default;
+
+    /**
+     * @return False if the requests couldn't be queued (ClipManager then applies them now)
+     */
+    virtual bool scheduleClipLaunches(const std::vector<ClipLaunchRequest>& requests) = 0;
+};
+
+}  // namespace magda
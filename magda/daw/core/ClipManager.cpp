@@ -1,11 +1,60 @@
 #include "ClipManager.hpp"
 
 #include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <limits>
 
+#include "../profiling/MemoryEstimates.hpp"
 #include "TrackManager.hpp"
 
 namespace magda {
 
+namespace {
+
+ClipGeometry geometryOf(const ClipInfo& clip) {
+    return {clip.id,         clip.trackId, clip.startTime, clip.getEndTime(),
+            clip.sceneIndex, clip.type,    clip.isPlaying, clip.isQueued};
+}
+
+// The slot a follow action moves to among the occupied ones (ascending), or -1 for none
+int pickFollowSlot(const std::vector<int>& occupied, int current, FollowAction action,
+                   juce::Random& random) {
+    if (occupied.empty()) {
+        return -1;
+    }
+    switch (action) {
+        case FollowAction::Again:
+            return current;
+        case FollowAction::Next: {
+            auto it = std::upper_bound(occupied.begin(), occupied.end(), current);
+            return it != occupied.end() ? *it : occupied.front();
+        }
+        case FollowAction::Previous: {
+            auto it = std::lower_bound(occupied.begin(), occupied.end(), current);
+            return it != occupied.begin() ? *std::prev(it) : occupied.back();
+        }
+        case FollowAction::First:
+            return occupied.front();
+        case FollowAction::Random: {
+            std::vector<int> others;
+            std::copy_if(occupied.begin(), occupied.end(), std::back_inserter(others),
+                         [current](int slot) { return slot != current; });
+            if (others.empty()) {
+                return current;
+            }
+            return others[static_cast<size_t>(random.nextInt(static_cast<int>(others.size())))];
+        }
+        case FollowAction::None:
+        case FollowAction::Stop:
+            break;
+    }
+    return -1;
+}
+
+}  // namespace
+
 ClipManager& ClipManager::getInstance() {
     static ClipManager instance;
     return instance;
@@ -16,7 +65,7 @@ ClipManager& ClipManager::getInstance() {
 // ============================================================================
 
 ClipId ClipManager::createAudioClip(TrackId trackId, double startTime, double length,
-                                    const juce::String& audioFilePath) {
+                                    const juce::String& audioFilePath, double sourceOffset) {
     ClipInfo clip;
     clip.id = nextClipId_++;
     clip.trackId = trackId;
@@ -25,9 +74,11 @@ ClipId ClipManager::createAudioClip(TrackId trackId, double startTime, double le
     clip.colour = ClipInfo::getDefaultColor(static_cast<int>(clips_.size()));
     clip.startTime = startTime;
     clip.length = length;
-    clip.audioSources.push_back(AudioSource{audioFilePath, 0.0, 0.0, length});
+    clip.audioSources.push_back(AudioSource{audioFilePath, 0.0, sourceOffset, length});
 
     clips_.push_back(clip);
+    indexAddedClip();
+    markClipAdded(clip.id);
     notifyClipsChanged();
 
     DBG("Created audio clip: " << clip.name << " (id=" << clip.id << ", track=" << trackId << ")");
@@ -45,6 +96,8 @@ ClipId ClipManager::createMidiClip(TrackId trackId, double startTime, double len
     clip.length = length;
 
     clips_.push_back(clip);
+    indexAddedClip();
+    markClipAdded(clip.id);
     notifyClipsChanged();
 
     DBG("Created MIDI clip: " << clip.name << " (id=" << clip.id << ", track=" << trackId << ")");
@@ -52,34 +105,43 @@ ClipId ClipManager::createMidiClip(TrackId trackId, double startTime, double len
 }
 
 void ClipManager::deleteClip(ClipId clipId) {
-    auto it = std::find_if(clips_.begin(), clips_.end(),
-                           [clipId](const ClipInfo& c) { return c.id == clipId; });
+    auto slotIt = clipSlots_.find(clipId);
+    if (slotIt == clipSlots_.end()) {
+        return;
+    }
 
-    if (it != clips_.end()) {
-        DBG("Deleted clip: " << it->name << " (id=" << clipId << ")");
+    const size_t position = slotIt->second.position;
+    DBG("Deleted clip: " << clips_[position].name << " (id=" << clipId << ")");
 
-        // Clear selection if this was selected
-        if (selectedClipId_ == clipId) {
-            selectedClipId_ = INVALID_CLIP_ID;
-            notifyClipSelectionChanged(INVALID_CLIP_ID);
-        }
+    // Clear selection if this was selected
+    if (selectedClipId_ == clipId) {
+        selectedClipId_ = INVALID_CLIP_ID;
+        notifyClipSelectionChanged(INVALID_CLIP_ID);
+    }
+
+    unindexClip(clipId);
+    markClipRemoved(clipId);
+    clips_.erase(clips_.begin() + static_cast<std::ptrdiff_t>(position));
+    geometry_.erase(geometry_.begin() + static_cast<std::ptrdiff_t>(position));
 
-        clips_.erase(it);
-        notifyClipsChanged();
+    // Clips after the erased one moved down a slot
+    for (size_t i = position; i < clips_.size(); ++i) {
+        clipSlots_[clips_[i].id].position = i;
     }
+
+    notifyClipsChanged();
 }
 
 void ClipManager::restoreClip(const ClipInfo& clipInfo) {
     // Check if a clip with this ID already exists
-    auto it = std::find_if(clips_.begin(), clips_.end(),
-                           [&clipInfo](const ClipInfo& c) { return c.id == clipInfo.id; });
-
-    if (it != clips_.end()) {
+    if (clipSlots_.count(clipInfo.id) > 0) {
         DBG("Warning: Clip with id=" << clipInfo.id << " already exists, skipping restore");
         return;
     }
 
     clips_.push_back(clipInfo);
+    indexAddedClip();
+    markClipAdded(clipInfo.id);
 
     // Ensure nextClipId_ is beyond any restored clip IDs
     if (clipInfo.id >= nextClipId_) {
@@ -91,6 +153,10 @@ void ClipManager::restoreClip(const ClipInfo& clipInfo) {
 }
 
 void ClipManager::forceNotifyClipsChanged() {
+    // Callers edited clips directly, possibly several of them
+    rebuildClipIndex();
+    pendingChanges_.markReset();
+    scheduleChangeDelivery();
     notifyClipsChanged();
 }
 
@@ -99,20 +165,20 @@ void ClipManager::forceNotifyClipPropertyChanged(ClipId clipId) {
 }
 
 ClipId ClipManager::duplicateClip(ClipId clipId) {
-    auto it = std::find_if(clips_.begin(), clips_.end(),
-                           [clipId](const ClipInfo& c) { return c.id == clipId; });
-
-    if (it == clips_.end()) {
+    const auto* original = getClip(clipId);
+    if (!original) {
         return INVALID_CLIP_ID;
     }
 
-    ClipInfo newClip = *it;
+    ClipInfo newClip = *original;
     newClip.id = nextClipId_++;
-    newClip.name = it->name + " Copy";
+    newClip.name = original->name + " Copy";
     // Offset the duplicate slightly to the right
-    newClip.startTime = it->startTime + it->length;
+    newClip.startTime = original->startTime + original->length;
 
     clips_.push_back(newClip);
+    indexAddedClip();
+    markClipAdded(newClip.id);
     notifyClipsChanged();
 
     DBG("Duplicated clip: " << newClip.name << " (id=" << newClip.id << ")");
@@ -120,16 +186,14 @@ ClipId ClipManager::duplicateClip(ClipId clipId) {
 }
 
 ClipId ClipManager::duplicateClipAt(ClipId clipId, double startTime, TrackId trackId) {
-    auto it = std::find_if(clips_.begin(), clips_.end(),
-                           [clipId](const ClipInfo& c) { return c.id == clipId; });
-
-    if (it == clips_.end()) {
+    const auto* original = getClip(clipId);
+    if (!original) {
         return INVALID_CLIP_ID;
     }
 
-    ClipInfo newClip = *it;
+    ClipInfo newClip = *original;
     newClip.id = nextClipId_++;
-    newClip.name = it->name + " Copy";
+    newClip.name = original->name + " Copy";
     newClip.startTime = startTime;
 
     // Use specified track or keep same track
@@ -138,6 +202,8 @@ ClipId ClipManager::duplicateClipAt(ClipId clipId, double startTime, TrackId tra
     }
 
     clips_.push_back(newClip);
+    indexAddedClip();
+    markClipAdded(newClip.id);
     notifyClipsChanged();
 
     DBG("Duplicated clip at " << startTime << ": " << newClip.name << " (id=" << newClip.id << ")");
@@ -153,7 +219,7 @@ void ClipManager::moveClip(ClipId clipId, double newStartTime, double /*tempo*/)
         ClipOperations::moveContainer(*clip, newStartTime);
         // Notes maintain their relative position within the clip (startBeat unchanged)
         // so they move with the clip on the timeline
-        notifyClipPropertyChanged(clipId);
+        notifyClipPropertyChanged(clipId, ClipDirty::Position);
     }
 }
 
@@ -161,6 +227,8 @@ void ClipManager::moveClipToTrack(ClipId clipId, TrackId newTrackId) {
     if (auto* clip = getClip(clipId)) {
         if (clip->trackId != newTrackId) {
             clip->trackId = newTrackId;
+            reindexClip(clipId);
+            markClipModified(clipId, ClipDirty::Track);
             notifyClipsChanged();  // Track assignment change affects layout
         }
     }
@@ -173,7 +241,7 @@ void ClipManager::resizeClip(ClipId clipId, double newLength, bool fromStart, do
         } else {
             ClipOperations::resizeContainerFromRight(*clip, newLength);
         }
-        notifyClipPropertyChanged(clipId);
+        notifyClipPropertyChanged(clipId, ClipDirty::Position);
     }
 }
 
@@ -212,7 +280,11 @@ ClipId ClipManager::splitClip(ClipId clipId, double splitTime) {
         clip->audioSources[0].length = leftLength;
     }
 
-    clips_.push_back(rightClip);
+    reindexClip(clipId);
+    markClipModified(clipId, ClipDirty::Position | ClipDirty::Appearance | ClipDirty::Content);
+    clips_.push_back(rightClip);  // Invalidates clip
+    indexAddedClip();
+    markClipAdded(rightClip.id);
     notifyClipsChanged();
 
     DBG("Split clip " << clipId << " at " << splitTime << " -> new clip " << rightClip.id);
@@ -223,7 +295,7 @@ void ClipManager::trimClip(ClipId clipId, double newStartTime, double newLength)
     if (auto* clip = getClip(clipId)) {
         clip->startTime = newStartTime;
         clip->length = newLength;
-        notifyClipPropertyChanged(clipId);
+        notifyClipPropertyChanged(clipId, ClipDirty::Position);
     }
 }
 
@@ -234,28 +306,28 @@ void ClipManager::trimClip(ClipId clipId, double newStartTime, double newLength)
 void ClipManager::setClipName(ClipId clipId, const juce::String& name) {
     if (auto* clip = getClip(clipId)) {
         clip->name = name;
-        notifyClipPropertyChanged(clipId);
+        notifyClipPropertyChanged(clipId, ClipDirty::Appearance);
     }
 }
 
 void ClipManager::setClipColour(ClipId clipId, juce::Colour colour) {
     if (auto* clip = getClip(clipId)) {
         clip->colour = colour;
-        notifyClipPropertyChanged(clipId);
+        notifyClipPropertyChanged(clipId, ClipDirty::Appearance);
     }
 }
 
 void ClipManager::setClipLoopEnabled(ClipId clipId, bool enabled) {
     if (auto* clip = getClip(clipId)) {
         clip->internalLoopEnabled = enabled;
-        notifyClipPropertyChanged(clipId);
+        notifyClipPropertyChanged(clipId, ClipDirty::Loop);
     }
 }
 
 void ClipManager::setClipLoopLength(ClipId clipId, double lengthBeats) {
     if (auto* clip = getClip(clipId)) {
         clip->internalLoopLength = juce::jmax(0.25, lengthBeats);
-        notifyClipPropertyChanged(clipId);
+        notifyClipPropertyChanged(clipId, ClipDirty::Loop);
     }
 }
 
@@ -264,7 +336,7 @@ void ClipManager::setAudioSourcePosition(ClipId clipId, int sourceIndex, double
         if (clip->type == ClipType::Audio && sourceIndex >= 0 &&
             sourceIndex < static_cast<int>(clip->audioSources.size())) {
             clip->audioSources[sourceIndex].position = juce::jmax(0.0, position);
-            notifyClipPropertyChanged(clipId);
+            notifyClipPropertyChanged(clipId, ClipDirty::Content);
         }
     }
 }
@@ -275,7 +347,16 @@ void ClipManager::setAudioSourceLength(ClipId clipId, int sourceIndex, double le
             sourceIndex < static_cast<int>(clip->audioSources.size())) {
             clip->audioSources[sourceIndex].length =
                 juce::jmax(ClipOperations::MIN_SOURCE_LENGTH, length);
-            notifyClipPropertyChanged(clipId);
+            notifyClipPropertyChanged(clipId, ClipDirty::Content);
+        }
+    }
+}
+
+void ClipManager::setAudioSources(ClipId clipId, const AudioSourceList& sources) {
+    if (auto* clip = getClip(clipId)) {
+        if (clip->type == ClipType::Audio) {
+            clip->audioSources = sources;
+            notifyClipPropertyChanged(clipId, ClipDirty::Content);
         }
     }
 }
@@ -288,7 +369,25 @@ void ClipManager::setAudioSourceStretchFactor(ClipId clipId, int sourceIndex,
             clip->audioSources[sourceIndex].stretchFactor =
                 juce::jlimit(ClipOperations::MIN_STRETCH_FACTOR, ClipOperations::MAX_STRETCH_FACTOR,
                              stretchFactor);
-            notifyClipPropertyChanged(clipId);
+            notifyClipPropertyChanged(clipId, ClipDirty::Content);
+        }
+    }
+}
+
+void ClipManager::setAudioSourceFades(ClipId clipId, int sourceIndex, const AudioFade& fadeIn,
+                                      const AudioFade& fadeOut) {
+    if (auto* clip = getClip(clipId)) {
+        if (clip->type == ClipType::Audio && sourceIndex >= 0 &&
+            sourceIndex < static_cast<int>(clip->audioSources.size())) {
+            auto& source = clip->audioSources[sourceIndex];
+            auto clamped = [&source](AudioFade fade) {
+                fade.length = juce::jlimit(0.0, source.length, fade.length);
+                fade.tension = juce::jlimit(-1.0f, 1.0f, fade.tension);
+                return fade;
+            };
+            source.fadeIn = clamped(fadeIn);
+            source.fadeOut = clamped(fadeOut);
+            notifyClipPropertyChanged(clipId, ClipDirty::Content);
         }
     }
 }
@@ -304,7 +403,7 @@ void ClipManager::trimAudioSourceLeft(ClipId clipId, int sourceIndex, double tri
             sourceIndex < static_cast<int>(clip->audioSources.size())) {
             ClipOperations::trimSourceFromLeft(clip->audioSources[sourceIndex], trimAmount,
                                                fileDuration);
-            notifyClipPropertyChanged(clipId);
+            notifyClipPropertyChanged(clipId, ClipDirty::Content);
         }
     }
 }
@@ -316,7 +415,7 @@ void ClipManager::trimAudioSourceRight(ClipId clipId, int sourceIndex, double tr
             sourceIndex < static_cast<int>(clip->audioSources.size())) {
             ClipOperations::trimSourceFromRight(clip->audioSources[sourceIndex], trimAmount,
                                                 fileDuration);
-            notifyClipPropertyChanged(clipId);
+            notifyClipPropertyChanged(clipId, ClipDirty::Content);
         }
     }
 }
@@ -330,7 +429,7 @@ void ClipManager::stretchAudioSourceLeft(ClipId clipId, int sourceIndex, double
             ClipOperations::stretchSourceFromLeft(clip->audioSources[sourceIndex], newLength,
                                                   oldLength, originalPosition,
                                                   originalStretchFactor);
-            notifyClipPropertyChanged(clipId);
+            notifyClipPropertyChanged(clipId, ClipDirty::Content);
         }
     }
 }
@@ -342,7 +441,7 @@ void ClipManager::stretchAudioSourceRight(ClipId clipId, int sourceIndex, double
             sourceIndex < static_cast<int>(clip->audioSources.size())) {
             ClipOperations::stretchSourceFromRight(clip->audioSources[sourceIndex], newLength,
                                                    oldLength, originalStretchFactor, clip->length);
-            notifyClipPropertyChanged(clipId);
+            notifyClipPropertyChanged(clipId, ClipDirty::Content);
         }
     }
 }
@@ -352,26 +451,34 @@ void ClipManager::moveAudioSource(ClipId clipId, int sourceIndex, double newPosi
         if (clip->type == ClipType::Audio && sourceIndex >= 0 &&
             sourceIndex < static_cast<int>(clip->audioSources.size())) {
             ClipOperations::moveSource(clip->audioSources[sourceIndex], newPosition, clip->length);
-            notifyClipPropertyChanged(clipId);
+            notifyClipPropertyChanged(clipId, ClipDirty::Content);
         }
     }
 }
 
-void ClipManager::addMidiNote(ClipId clipId, const MidiNote& note) {
+MidiNoteId ClipManager::addMidiNote(ClipId clipId, const MidiNote& note) {
     if (auto* clip = getClip(clipId)) {
         if (clip->type == ClipType::MIDI) {
-            clip->midiNotes.push_back(note);
-            notifyClipPropertyChanged(clipId);
+            MidiNoteId noteId = clip->midiNotes.add(note);
+            notifyClipPropertyChanged(clipId, ClipDirty::Content);
+            return noteId;
         }
     }
+    return INVALID_MIDI_NOTE_ID;
 }
 
-void ClipManager::removeMidiNote(ClipId clipId, int noteIndex) {
+void ClipManager::updateMidiNote(ClipId clipId, const MidiNote& note) {
     if (auto* clip = getClip(clipId)) {
-        if (clip->type == ClipType::MIDI && noteIndex >= 0 &&
-            noteIndex < static_cast<int>(clip->midiNotes.size())) {
-            clip->midiNotes.erase(clip->midiNotes.begin() + noteIndex);
-            notifyClipPropertyChanged(clipId);
+        if (clip->type == ClipType::MIDI && clip->midiNotes.update(note)) {
+            notifyClipPropertyChanged(clipId, ClipDirty::Content);
+        }
+    }
+}
+
+void ClipManager::removeMidiNote(ClipId clipId, MidiNoteId noteId) {
+    if (auto* clip = getClip(clipId)) {
+        if (clip->type == ClipType::MIDI && clip->midiNotes.remove(noteId)) {
+            notifyClipPropertyChanged(clipId, ClipDirty::Content);
         }
     }
 }
@@ -380,7 +487,35 @@ void ClipManager::clearMidiNotes(ClipId clipId) {
     if (auto* clip = getClip(clipId)) {
         if (clip->type == ClipType::MIDI) {
             clip->midiNotes.clear();
-            notifyClipPropertyChanged(clipId);
+            notifyClipPropertyChanged(clipId, ClipDirty::Content);
+        }
+    }
+}
+
+std::vector<MidiNoteId> ClipManager::addMidiNotes(ClipId clipId,
+                                                  const std::vector<MidiNote>& notes) {
+    std::vector<MidiNoteId> ids;
+    if (auto* clip = getClip(clipId)) {
+        if (clip->type == ClipType::MIDI && !notes.empty()) {
+            ids = clip->midiNotes.add(notes);
+            notifyClipPropertyChanged(clipId, ClipDirty::Content);
+        }
+    }
+    return ids;
+}
+
+void ClipManager::updateMidiNotes(ClipId clipId, const std::vector<MidiNote>& notes) {
+    if (auto* clip = getClip(clipId)) {
+        if (clip->type == ClipType::MIDI && clip->midiNotes.update(notes) > 0) {
+            notifyClipPropertyChanged(clipId, ClipDirty::Content);
+        }
+    }
+}
+
+void ClipManager::removeMidiNotes(ClipId clipId, const std::vector<MidiNoteId>& noteIds) {
+    if (auto* clip = getClip(clipId)) {
+        if (clip->type == ClipType::MIDI && clip->midiNotes.remove(noteIds) > 0) {
+            notifyClipPropertyChanged(clipId, ClipDirty::Content);
         }
     }
 }
@@ -390,49 +525,63 @@ void ClipManager::clearMidiNotes(ClipId clipId) {
 // ============================================================================
 
 ClipInfo* ClipManager::getClip(ClipId clipId) {
-    auto it = std::find_if(clips_.begin(), clips_.end(),
-                           [clipId](const ClipInfo& c) { return c.id == clipId; });
-    return (it != clips_.end()) ? &(*it) : nullptr;
+    auto it = clipSlots_.find(clipId);
+    return it != clipSlots_.end() ? &clips_[it->second.position] : nullptr;
 }
 
 const ClipInfo* ClipManager::getClip(ClipId clipId) const {
-    auto it = std::find_if(clips_.begin(), clips_.end(),
-                           [clipId](const ClipInfo& c) { return c.id == clipId; });
-    return (it != clips_.end()) ? &(*it) : nullptr;
+    auto it = clipSlots_.find(clipId);
+    return it != clipSlots_.end() ? &clips_[it->second.position] : nullptr;
+}
+
+const ClipIntervalIndex& ClipManager::getTrackClipIndex(TrackId trackId) const {
+    static const ClipIntervalIndex emptyIndex;
+
+    auto it = trackClips_.find(trackId);
+    if (it == trackClips_.end()) {
+        return emptyIndex;
+    }
+
+    auto& track = it->second;
+    if (track.dirty) {
+        std::vector<ClipIntervalIndex::Interval> intervals;
+        intervals.reserve(track.clipIds.size());
+        for (ClipId clipId : track.clipIds) {
+            const auto& row = geometry_[clipSlots_.at(clipId).position];
+            intervals.push_back({clipId, row.startTime, row.endTime});
+        }
+        track.index.build(std::move(intervals));
+        track.dirty = false;
+    }
+    return track.index;
 }
 
 std::vector<ClipId> ClipManager::getClipsOnTrack(TrackId trackId) const {
+    // The index keeps them sorted by start time
     std::vector<ClipId> result;
-    for (const auto& clip : clips_) {
-        if (clip.trackId == trackId) {
-            result.push_back(clip.id);
-        }
+    for (const auto& interval : getTrackClipIndex(trackId).getIntervals()) {
+        result.push_back(interval.id);
     }
-    // Sort by start time
-    std::sort(result.begin(), result.end(), [this](ClipId a, ClipId b) {
-        const auto* clipA = getClip(a);
-        const auto* clipB = getClip(b);
-        return clipA && clipB && clipA->startTime < clipB->startTime;
-    });
     return result;
 }
 
 ClipId ClipManager::getClipAtPosition(TrackId trackId, double time) const {
-    for (const auto& clip : clips_) {
-        if (clip.trackId == trackId && clip.containsTime(time)) {
-            return clip.id;
-        }
-    }
-    return INVALID_CLIP_ID;
+    // Clips contain [start, end), i.e. they overlap the smallest range starting at time
+    std::vector<ClipIntervalIndex::Interval> hits;
+    getTrackClipIndex(trackId).query(
+        time, std::nextafter(time, std::numeric_limits<double>::infinity()), hits);
+    return hits.empty() ? INVALID_CLIP_ID : hits.front().id;
 }
 
 std::vector<ClipId> ClipManager::getClipsInRange(TrackId trackId, double startTime,
                                                  double endTime) const {
+    std::vector<ClipIntervalIndex::Interval> hits;
+    getTrackClipIndex(trackId).query(startTime, endTime, hits);
+
     std::vector<ClipId> result;
-    for (const auto& clip : clips_) {
-        if (clip.trackId == trackId && clip.overlaps(startTime, endTime)) {
-            result.push_back(clip.id);
-        }
+    result.reserve(hits.size());
+    for (const auto& interval : hits) {
+        result.push_back(interval.id);
     }
     return result;
 }
@@ -460,56 +609,330 @@ void ClipManager::clearClipSelection() {
 // ============================================================================
 
 ClipId ClipManager::getClipInSlot(TrackId trackId, int sceneIndex) const {
-    for (const auto& clip : clips_) {
-        if (clip.trackId == trackId && clip.sceneIndex == sceneIndex) {
-            return clip.id;
-        }
+    auto it = trackClips_.find(trackId);
+    if (it == trackClips_.end() || sceneIndex < 0 ||
+        sceneIndex >= static_cast<int>(it->second.sceneSlots.size())) {
+        return INVALID_CLIP_ID;
     }
-    return INVALID_CLIP_ID;
+    return it->second.sceneSlots[static_cast<size_t>(sceneIndex)];
 }
 
 void ClipManager::setClipSceneIndex(ClipId clipId, int sceneIndex) {
     if (auto* clip = getClip(clipId)) {
         clip->sceneIndex = sceneIndex;
-        notifyClipPropertyChanged(clipId);
+        notifyClipPropertyChanged(clipId, ClipDirty::Session);
     }
 }
 
 void ClipManager::triggerClip(ClipId clipId) {
-    if (auto* clip = getClip(clipId)) {
-        // Stop other clips on same track
-        for (auto& otherClip : clips_) {
-            if (otherClip.trackId == clip->trackId && otherClip.id != clipId) {
-                if (otherClip.isPlaying || otherClip.isQueued) {
-                    otherClip.isPlaying = false;
-                    otherClip.isQueued = false;
-                    notifyClipPlaybackStateChanged(otherClip.id);
-                }
+    launchClips({clipId});
+}
+
+void ClipManager::stopClip(ClipId clipId) {
+    stopClips({clipId});
+}
+
+void ClipManager::stopAllClips() {
+    // Follow-ups are timed from the clips being stopped, so the launcher calls them off too
+    followUps_.clear();
+    sceneChain_ = {};
+
+    std::vector<ClipId> active;
+    for (const auto& row : geometry_) {
+        if (row.isPlaying || row.isQueued) {
+            active.push_back(row.id);
+        }
+    }
+    stopClips(active);
+}
+
+void ClipManager::launchClips(const std::vector<ClipId>& clipIds) {
+    std::vector<ClipLaunchRequest> requests;
+    for (const auto clipId : clipIds) {
+        auto* clip = getClip(clipId);
+        if (!clip) {
+            continue;
+        }
+
+        // One launch waits per track: the latest replaces any other queued there
+        for (size_t i = 0; i < geometry_.size(); ++i) {
+            const auto& row = geometry_[i];
+            if (row.trackId == clip->trackId && row.id != clipId && row.isQueued) {
+                clips_[i].isQueued = false;
+                notifyClipPlaybackStateChanged(row.id);
             }
         }
 
         clip->isQueued = true;
-        clip->isPlaying = true;  // For now, immediate trigger
         notifyClipPlaybackStateChanged(clipId);
+        requests.push_back({ClipLaunchRequest::Action::Launch, clipId, clip->trackId,
+                            launchQuantiseBeats_});
     }
+
+    // After every launch, so none replaces a follow-up of another on its track
+    const size_t numLaunches = requests.size();
+    for (size_t i = 0; i < numLaunches; ++i) {
+        if (const auto* clip = getClip(requests[i].clipId)) {
+            appendClipFollowUp(*clip, requests);
+        }
+    }
+    submitLaunches(requests);
 }
 
-void ClipManager::stopClip(ClipId clipId) {
+void ClipManager::launchScene(int sceneIndex, const std::vector<TrackId>& trackIds) {
+    std::vector<ClipId> clipIds;
+    for (const auto trackId : trackIds) {
+        const auto clipId = getClipInSlot(trackId, sceneIndex);
+        if (clipId != INVALID_CLIP_ID) {
+            clipIds.push_back(clipId);
+        }
+    }
+
+    sceneChain_ = {};
+    if (clipIds.empty()) {
+        return;
+    }
+    launchClips(clipIds);
+
+    // Its first clip's launch times the chain's first step
+    if (getSceneFollowAction(sceneIndex) != FollowAction::None) {
+        sceneChain_.trackIds = trackIds;
+        submitSceneFollowUps(sceneIndex, clipIds.front());
+    }
+}
+
+void ClipManager::stopClips(const std::vector<ClipId>& clipIds) {
+    std::vector<ClipLaunchRequest> requests;
+    for (const auto clipId : clipIds) {
+        auto* clip = getClip(clipId);
+        if (!clip || (!clip->isPlaying && !clip->isQueued)) {
+            continue;
+        }
+
+        // A launch still waiting is simply called off; a playing clip stops on the beat
+        if (clip->isQueued) {
+            clip->isQueued = false;
+            notifyClipPlaybackStateChanged(clipId);
+        }
+        requests.push_back(
+            {ClipLaunchRequest::Action::Stop, clipId, clip->trackId, launchQuantiseBeats_});
+    }
+    submitLaunches(requests);
+}
+
+void ClipManager::submitLaunches(const std::vector<ClipLaunchRequest>& requests) {
+    if (requests.empty()) {
+        return;
+    }
+    if (clipLauncher_ != nullptr && clipLauncher_->scheduleClipLaunches(requests)) {
+        for (const auto& request : requests) {
+            if (!request.isFollowUp()) {
+                continue;
+            }
+            // The launcher keeps one follow-up per track, the latest
+            std::erase_if(followUps_, [&request](const ClipLaunchRequest& followUp) {
+                return followUp.trackId == request.trackId;
+            });
+            followUps_.push_back(request);
+        }
+        return;
+    }
+
+    for (const auto& request : requests) {
+        if (request.isFollowUp()) {
+            continue;  // Nothing times them without a launcher
+        }
+        if (request.action == ClipLaunchRequest::Action::Launch) {
+            clipLaunchFired(request.clipId);
+        } else {
+            clipStopFired(request.clipId);
+        }
+    }
+}
+
+void ClipManager::clipLaunchFired(ClipId clipId) {
+    auto* clip = getClip(clipId);
+    const bool followed = takeFollowUp(clipId, ClipLaunchRequest::Action::Launch);
+    if (!clip || (!clip->isQueued && !followed)) {
+        return;  // Stopped, or replaced by a later launch, while it waited
+    }
+
+    // The clip it replaces stops in the same sample
+    for (size_t i = 0; i < geometry_.size(); ++i) {
+        const auto& row = geometry_[i];
+        if (row.trackId == clip->trackId && row.id != clipId && row.isPlaying) {
+            clips_[i].isPlaying = false;
+            notifyClipPlaybackStateChanged(row.id);
+        }
+    }
+
+    clip->isQueued = false;
+    clip->isPlaying = true;
+    notifyClipPlaybackStateChanged(clipId);
+
+    // A follow-up launch: the step after it is worked out now, well before it's due
+    if (!followed) {
+        return;
+    }
+    if (clipId == sceneChain_.anchor) {
+        submitSceneFollowUps(sceneChain_.sceneIndex, clipId);
+        return;
+    }
+    const auto* launched = getClip(clipId);
+    const bool chained =
+        sceneChain_.anchor != INVALID_CLIP_ID && launched != nullptr &&
+        std::find(sceneChain_.trackIds.begin(), sceneChain_.trackIds.end(),
+                  launched->trackId) != sceneChain_.trackIds.end();
+    if (launched != nullptr && !chained) {
+        std::vector<ClipLaunchRequest> requests;
+        appendClipFollowUp(*launched, requests);
+        submitLaunches(requests);
+    }
+}
+
+void ClipManager::clipStopFired(ClipId clipId) {
+    auto* clip = getClip(clipId);
+    takeFollowUp(clipId, ClipLaunchRequest::Action::Stop);
+    if (!clip || !clip->isPlaying || clip->isQueued) {
+        return;  // Already stopped, or launched again while the stop waited
+    }
+
+    clip->isPlaying = false;
+    notifyClipPlaybackStateChanged(clipId);
+}
+
+void ClipManager::setClipFollowAction(ClipId clipId, FollowAction action, double afterBeats) {
     if (auto* clip = getClip(clipId)) {
-        clip->isPlaying = false;
-        clip->isQueued = false;
-        notifyClipPlaybackStateChanged(clipId);
+        clip->followAction = action;
+        clip->followActionBeats = std::max(0.0, afterBeats);
+        notifyClipPropertyChanged(clipId, ClipDirty::Session);
     }
 }
 
-void ClipManager::stopAllClips() {
-    for (auto& clip : clips_) {
-        if (clip.isPlaying || clip.isQueued) {
-            clip.isPlaying = false;
-            clip.isQueued = false;
-            notifyClipPlaybackStateChanged(clip.id);
+void ClipManager::setSceneFollowAction(int sceneIndex, FollowAction action, double afterBeats) {
+    if (sceneIndex < 0) {
+        return;
+    }
+    if (static_cast<size_t>(sceneIndex) >= sceneFollows_.size()) {
+        sceneFollows_.resize(static_cast<size_t>(sceneIndex) + 1);
+    }
+    sceneFollows_[static_cast<size_t>(sceneIndex)] = {action, std::max(0.0, afterBeats)};
+}
+
+FollowAction ClipManager::getSceneFollowAction(int sceneIndex) const {
+    if (sceneIndex < 0 || static_cast<size_t>(sceneIndex) >= sceneFollows_.size()) {
+        return FollowAction::None;
+    }
+    return sceneFollows_[static_cast<size_t>(sceneIndex)].action;
+}
+
+void ClipManager::appendClipFollowUp(const ClipInfo& clip,
+                                     std::vector<ClipLaunchRequest>& requests) {
+    if (clip.followAction == FollowAction::None || clip.followActionBeats <= 0.0 ||
+        clip.sceneIndex < 0) {
+        return;
+    }
+
+    ClipLaunchRequest followUp{ClipLaunchRequest::Action::Launch, clip.id, clip.trackId, 0.0,
+                               clip.id, clip.followActionBeats};
+    if (clip.followAction == FollowAction::Stop) {
+        followUp.action = ClipLaunchRequest::Action::Stop;
+    } else {
+        auto it = trackClips_.find(clip.trackId);
+        if (it == trackClips_.end()) {
+            return;
+        }
+        const auto& slots = it->second.sceneSlots;
+        std::vector<int> occupied;
+        for (size_t i = 0; i < slots.size(); ++i) {
+            if (slots[i] != INVALID_CLIP_ID) {
+                occupied.push_back(static_cast<int>(i));
+            }
+        }
+        const int target =
+            pickFollowSlot(occupied, clip.sceneIndex, clip.followAction, followRandom_);
+        if (target < 0) {
+            return;
+        }
+        followUp.clipId = slots[static_cast<size_t>(target)];
+    }
+    requests.push_back(followUp);
+}
+
+void ClipManager::submitSceneFollowUps(int sceneIndex, ClipId anchor) {
+    SceneFollow follow;
+    if (sceneIndex >= 0 && static_cast<size_t>(sceneIndex) < sceneFollows_.size()) {
+        follow = sceneFollows_[static_cast<size_t>(sceneIndex)];
+    }
+    sceneChain_.sceneIndex = -1;
+    sceneChain_.anchor = INVALID_CLIP_ID;
+    if (follow.action == FollowAction::None || follow.afterBeats <= 0.0) {
+        return;
+    }
+
+    std::vector<ClipLaunchRequest> requests;
+    auto addStep = [&](ClipLaunchRequest::Action action, int slot) {
+        for (const auto trackId : sceneChain_.trackIds) {
+            const auto clipId = getClipInSlot(trackId, slot);
+            if (clipId != INVALID_CLIP_ID) {
+                requests.push_back({action, clipId, trackId, 0.0, anchor, follow.afterBeats});
+            }
+        }
+    };
+
+    if (follow.action == FollowAction::Stop) {
+        addStep(ClipLaunchRequest::Action::Stop, sceneIndex);
+        submitLaunches(requests);
+        return;
+    }
+
+    // The scenes holding a clip on any of the chain's tracks
+    std::vector<int> occupied;
+    for (const auto trackId : sceneChain_.trackIds) {
+        auto it = trackClips_.find(trackId);
+        if (it == trackClips_.end()) {
+            continue;
         }
+        for (size_t i = 0; i < it->second.sceneSlots.size(); ++i) {
+            if (it->second.sceneSlots[i] != INVALID_CLIP_ID) {
+                occupied.push_back(static_cast<int>(i));
+            }
+        }
+    }
+    std::sort(occupied.begin(), occupied.end());
+    occupied.erase(std::unique(occupied.begin(), occupied.end()), occupied.end());
+
+    const int target = pickFollowSlot(occupied, sceneIndex, follow.action, followRandom_);
+    if (target < 0) {
+        return;
     }
+    addStep(ClipLaunchRequest::Action::Launch, target);
+    if (requests.empty()) {
+        return;
+    }
+
+    // The next scene's first clip times the step after it
+    sceneChain_.sceneIndex = target;
+    sceneChain_.anchor = requests.front().clipId;
+    submitLaunches(requests);
+}
+
+bool ClipManager::takeFollowUp(ClipId clipId, ClipLaunchRequest::Action action) {
+    auto it = std::find_if(followUps_.begin(), followUps_.end(),
+                           [clipId, action](const ClipLaunchRequest& followUp) {
+                               return followUp.clipId == clipId && followUp.action == action;
+                           });
+    if (it == followUps_.end()) {
+        return false;
+    }
+    followUps_.erase(it);
+    return true;
+}
+
+void ClipManager::resetFollowActions() {
+    followUps_.clear();
+    sceneChain_ = {};
+    sceneFollows_.clear();
 }
 
 // ============================================================================
@@ -530,10 +953,42 @@ void ClipManager::removeListener(ClipManagerListener* listener) {
 // Project Management
 // ============================================================================
 
+size_t ClipManager::getSizeInBytes() const {
+    size_t bytes = memory::vectorBytes(clips_) + memory::vectorBytes(geometry_) +
+                   memory::hashContainerBytes(clipSlots_) + memory::hashContainerBytes(trackClips_);
+    for (const auto& clip : clips_) {
+        bytes += memory::vectorBytes(clip.audioSources.read()) + clip.midiNotes.getSizeInBytes();
+    }
+    for (const auto& [trackId, track] : trackClips_) {
+        bytes += memory::vectorBytes(track.clipIds) + memory::vectorBytes(track.sceneSlots) +
+                 track.index.getSizeInBytes();
+    }
+    return bytes;
+}
+
 void ClipManager::clearAllClips() {
     clips_.clear();
+    rebuildClipIndex();
+    resetFollowActions();
+    pendingChanges_.markReset();
+    scheduleChangeDelivery();
+    selectedClipId_ = INVALID_CLIP_ID;
+    nextClipId_ = 1;
+    notifyClipsChanged();
+}
+
+void ClipManager::loadClips(std::vector<ClipInfo> clips) {
+    clips_ = std::move(clips);
+    rebuildClipIndex();
+    resetFollowActions();
+    pendingChanges_.markReset();
+    scheduleChangeDelivery();
     selectedClipId_ = INVALID_CLIP_ID;
+
     nextClipId_ = 1;
+    for (const auto& clip : clips_) {
+        nextClipId_ = std::max(nextClipId_, clip.id + 1);
+    }
     notifyClipsChanged();
 }
 
@@ -574,6 +1029,130 @@ void ClipManager::createTestClips() {
 // Private Helpers
 // ============================================================================
 
+void ClipManager::rebuildClipIndex() {
+    clipSlots_.clear();
+    trackClips_.clear();
+    geometry_.clear();
+    geometry_.reserve(clips_.size());
+
+    for (size_t i = 0; i < clips_.size(); ++i) {
+        const auto& clip = clips_[i];
+        clipSlots_[clip.id] = {i};
+        geometry_.push_back(geometryOf(clip));
+
+        auto& track = trackClips_[clip.trackId];
+        track.clipIds.push_back(clip.id);
+        track.dirty = true;
+        fillSceneSlot(track, clip.sceneIndex, clip.id);
+    }
+}
+
+void ClipManager::indexAddedClip() {
+    const auto& clip = clips_.back();
+    clipSlots_[clip.id] = {clips_.size() - 1};
+    geometry_.push_back(geometryOf(clip));
+
+    auto& track = trackClips_[clip.trackId];
+    track.clipIds.push_back(clip.id);
+    track.dirty = true;
+    fillSceneSlot(track, clip.sceneIndex, clip.id);
+}
+
+void ClipManager::unindexClip(ClipId clipId) {
+    auto slotIt = clipSlots_.find(clipId);
+    if (slotIt == clipSlots_.end()) {
+        return;
+    }
+
+    const auto& row = geometry_[slotIt->second.position];
+    auto& track = trackClips_[row.trackId];
+    track.clipIds.erase(std::remove(track.clipIds.begin(), track.clipIds.end(), clipId),
+                        track.clipIds.end());
+    track.dirty = true;
+    vacateSceneSlot(track, row.sceneIndex, clipId);
+
+    clipSlots_.erase(slotIt);
+}
+
+void ClipManager::fillSceneSlot(TrackClips& track, int sceneIndex, ClipId clipId) {
+    if (sceneIndex < 0) {
+        return;
+    }
+    const auto slot = static_cast<size_t>(sceneIndex);
+    if (slot >= track.sceneSlots.size()) {
+        track.sceneSlots.resize(slot + 1, INVALID_CLIP_ID);
+    }
+    // The clip earliest in storage holds the slot, as it did when lookups scanned the clips
+    auto& holder = track.sceneSlots[slot];
+    if (holder == INVALID_CLIP_ID ||
+        clipSlots_.at(clipId).position < clipSlots_.at(holder).position) {
+        holder = clipId;
+    }
+}
+
+void ClipManager::vacateSceneSlot(TrackClips& track, int sceneIndex, ClipId clipId) {
+    if (sceneIndex < 0 || sceneIndex >= static_cast<int>(track.sceneSlots.size()) ||
+        track.sceneSlots[static_cast<size_t>(sceneIndex)] != clipId) {
+        return;
+    }
+
+    // Another of the track's clips may have been waiting for the slot (in storage order)
+    auto& slot = track.sceneSlots[static_cast<size_t>(sceneIndex)];
+    slot = INVALID_CLIP_ID;
+    for (const auto otherId : track.clipIds) {
+        auto otherIt = clipSlots_.find(otherId);
+        if (otherId == clipId || otherIt == clipSlots_.end()) {
+            continue;
+        }
+        if (geometry_[otherIt->second.position].sceneIndex == sceneIndex &&
+            (slot == INVALID_CLIP_ID ||
+             otherIt->second.position < clipSlots_.at(slot).position)) {
+            slot = otherId;
+        }
+    }
+
+    // Trailing empty slots aren't kept
+    while (!track.sceneSlots.empty() && track.sceneSlots.back() == INVALID_CLIP_ID) {
+        track.sceneSlots.pop_back();
+    }
+}
+
+void ClipManager::reindexClip(ClipId clipId) {
+    auto slotIt = clipSlots_.find(clipId);
+    if (slotIt == clipSlots_.end()) {
+        return;
+    }
+
+    const size_t position = slotIt->second.position;
+    auto& row = geometry_[position];
+    const auto updated = geometryOf(clips_[position]);
+
+    // Moved to another track: file it under the new one
+    if (updated.trackId != row.trackId) {
+        auto& oldTrack = trackClips_[row.trackId];
+        oldTrack.clipIds.erase(
+            std::remove(oldTrack.clipIds.begin(), oldTrack.clipIds.end(), clipId),
+            oldTrack.clipIds.end());
+        oldTrack.dirty = true;
+        vacateSceneSlot(oldTrack, row.sceneIndex, clipId);
+
+        auto& newTrack = trackClips_[updated.trackId];
+        newTrack.clipIds.push_back(clipId);
+        newTrack.dirty = true;
+        fillSceneSlot(newTrack, updated.sceneIndex, clipId);
+    } else if (updated.sceneIndex != row.sceneIndex) {
+        auto& track = trackClips_[updated.trackId];
+        vacateSceneSlot(track, row.sceneIndex, clipId);
+        fillSceneSlot(track, updated.sceneIndex, clipId);
+    }
+
+    // Only a change of extent invalidates the track's index (not name, colour, notes...)
+    if (updated.startTime != row.startTime || updated.endTime != row.endTime) {
+        trackClips_[updated.trackId].dirty = true;
+    }
+    row = updated;
+}
+
 void ClipManager::notifyClipsChanged() {
     // Make a copy because listeners may be removed during iteration
     // (e.g., ClipComponent destroyed when TrackContentPanel rebuilds)
@@ -585,7 +1164,11 @@ void ClipManager::notifyClipsChanged() {
     }
 }
 
-void ClipManager::notifyClipPropertyChanged(ClipId clipId) {
+void ClipManager::notifyClipPropertyChanged(ClipId clipId, ClipDirty dirty) {
+    // Every edit path ends here, including direct edits through getClip()
+    reindexClip(clipId);
+    markClipModified(clipId, dirty);
+
     auto listenersCopy = listeners_;
     for (auto* listener : listenersCopy) {
         if (std::find(listeners_.begin(), listeners_.end(), listener) != listeners_.end()) {
@@ -604,6 +1187,9 @@ void ClipManager::notifyClipSelectionChanged(ClipId clipId) {
 }
 
 void ClipManager::notifyClipPlaybackStateChanged(ClipId clipId) {
+    reindexClip(clipId);
+    markClipModified(clipId, ClipDirty::Session);
+
     auto listenersCopy = listeners_;
     for (auto* listener : listenersCopy) {
         if (std::find(listeners_.begin(), listeners_.end(), listener) != listeners_.end()) {
@@ -622,10 +1208,63 @@ void ClipManager::notifyClipDragPreview(ClipId clipId, double previewStartTime,
     }
 }
 
+void ClipManager::notifyClipAudiblePreview(const ClipInfo& preview) {
+    auto listenersCopy = listeners_;
+    for (auto* listener : listenersCopy) {
+        if (std::find(listeners_.begin(), listeners_.end(), listener) != listeners_.end()) {
+            listener->clipAudiblePreview(preview);
+        }
+    }
+}
+
+void ClipManager::flushPendingChanges() {
+    changeDeliveryPending_ = false;
+    if (pendingChanges_.empty()) {
+        return;
+    }
+
+    // Listeners may edit clips in response; those land in the next set
+    const ClipChangeSet changes = std::move(pendingChanges_);
+    pendingChanges_.clear();
+
+    auto listenersCopy = listeners_;
+    for (auto* listener : listenersCopy) {
+        if (std::find(listeners_.begin(), listeners_.end(), listener) != listeners_.end()) {
+            listener->clipChangesCoalesced(changes);
+        }
+    }
+}
+
+void ClipManager::scheduleChangeDelivery() {
+    if (changeDeliveryPending_) {
+        return;
+    }
+
+    // Without a message loop (tests, shutdown) nothing is posted and flushPendingChanges()
+    // delivers instead
+    changeDeliveryPending_ =
+        juce::MessageManager::callAsync([] { getInstance().flushPendingChanges(); });
+}
+
+void ClipManager::markClipAdded(ClipId clipId) {
+    pendingChanges_.markAdded(clipId);
+    scheduleChangeDelivery();
+}
+
+void ClipManager::markClipRemoved(ClipId clipId) {
+    pendingChanges_.markRemoved(clipId);
+    scheduleChangeDelivery();
+}
+
+void ClipManager::markClipModified(ClipId clipId, ClipDirty dirty) {
+    pendingChanges_.markModified(clipId, dirty);
+    scheduleChangeDelivery();
+}
+
 juce::String ClipManager::generateClipName(ClipType type) const {
     int count = 1;
-    for (const auto& clip : clips_) {
-        if (clip.type == type) {
+    for (const auto& row : geometry_) {
+        if (row.type == type) {
             count++;
         }
     }
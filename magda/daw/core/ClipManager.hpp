@@ -1,15 +1,70 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
+#include "ChangeSet.hpp"
 #include "ClipInfo.hpp"
+#include "ClipIntervalIndex.hpp"
+#include "ClipLauncher.hpp"
 #include "ClipOperations.hpp"
 #include "ClipTypes.hpp"
 #include "TrackTypes.hpp"
 
 namespace magda {
 
+/**
+ * @brief What changed on a clip, for ClipChangeSet
+ */
+enum class ClipDirty : uint32_t {
+    None = 0,
+    Position = 1 << 0,    // Start or length
+    Track = 1 << 1,       // Moved to another track
+    Content = 1 << 2,     // MIDI notes or audio sources
+    Appearance = 1 << 3,  // Name, colour
+    Loop = 1 << 4,
+    Session = 1 << 5,  // Scene slot, playback state
+    All = 0xFFFFFFFF
+};
+
+inline ClipDirty operator|(ClipDirty a, ClipDirty b) {
+    return static_cast<ClipDirty>(static_cast<uint32_t>(a) | static_cast<uint32_t>(b));
+}
+
+inline bool hasFlag(ClipDirty flags, ClipDirty flag) {
+    return (static_cast<uint32_t>(flags) & static_cast<uint32_t>(flag)) != 0;
+}
+
+using ClipChangeSet = ChangeSet<ClipId, ClipDirty>;
+
+/**
+ * @brief The fields of a clip that scans and hit tests read, without its payload
+ *
+ * A few dozen bytes per clip, against a ClipInfo's name, colour, audio sources and notes, so
+ * a pass over every clip stays within a few cache lines per hundred clips. Row i of
+ * ClipManager::getClipGeometry() describes getClips()[i], which holds the payload.
+ */
+struct ClipGeometry {
+    ClipId id = INVALID_CLIP_ID;
+    TrackId trackId = INVALID_TRACK_ID;
+    double startTime = 0.0;
+    double endTime = 0.0;
+    int sceneIndex = -1;
+    ClipType type = ClipType::MIDI;
+    bool isPlaying = false;
+    bool isQueued = false;
+
+    bool containsTime(double time) const {
+        return time >= startTime && time < endTime;
+    }
+
+    bool overlaps(double start, double end) const {
+        return startTime < end && endTime > start;
+    }
+};
+
 /**
  * @brief Listener interface for clip changes
  */
@@ -39,12 +94,33 @@ class ClipManagerListener {
     virtual void clipDragPreview(ClipId clipId, double previewStartTime, double previewLength) {
         juce::ignoreUnused(clipId, previewStartTime, previewLength);
     }
+
+    // Called at a low rate during a drag that changes how a clip sounds (a stretch), with the
+    // clip as it would be if dropped now. The model is unchanged until the drag commits.
+    virtual void clipAudiblePreview(const ClipInfo& preview) {
+        juce::ignoreUnused(preview);
+    }
+
+    // Called once per message-loop tick with every clip change since the last call.
+    // The callbacks above fire synchronously per edit; this lets a listener update only
+    // the affected clips, and only once for a burst of edits.
+    virtual void clipChangesCoalesced(const ClipChangeSet& changes) {
+        juce::ignoreUnused(changes);
+    }
 };
 
 /**
  * @brief Singleton manager for all clips in the project
  *
  * Provides CRUD operations for clips and notifies listeners of changes.
+ *
+ * Clips are stored in one vector with an id -> position map, so getClip() is O(1). Each
+ * track also has a ClipIntervalIndex over its clips for the range and position queries,
+ * which then cost O(log n + k) instead of a scan of the whole project. A track's index is
+ * rebuilt lazily on its next query after one of its clips is added, removed, moved or
+ * resized; callers that edit a clip through getClip() must follow up with
+ * forceNotifyClipPropertyChanged() (or forceNotifyClipsChanged()) as they already do for
+ * the UI, which is where the index picks the change up.
  */
 class ClipManager {
   public:
@@ -60,6 +136,9 @@ class ClipManager {
      */
     void shutdown() {
         clips_.clear();  // Clear JUCE objects before JUCE cleanup
+        rebuildClipIndex();
+        pendingChanges_.clear();
+        resetFollowActions();
     }
 
     // ========================================================================
@@ -68,9 +147,10 @@ class ClipManager {
 
     /**
      * @brief Create an audio clip from a file
+     * @param sourceOffset Seconds into the file the clip starts playing from
      */
     ClipId createAudioClip(TrackId trackId, double startTime, double length,
-                           const juce::String& audioFilePath);
+                           const juce::String& audioFilePath, double sourceOffset = 0.0);
 
     /**
      * @brief Create an empty MIDI clip
@@ -98,6 +178,11 @@ class ClipManager {
      */
     void forceNotifyClipPropertyChanged(ClipId clipId);
 
+    /**
+     * @brief Deliver recorded changes to clipChangesCoalesced() now rather than next tick
+     */
+    void flushPendingChanges();
+
     /**
      * @brief Duplicate a clip (places copy right after original)
      * @return The ID of the new clip
@@ -162,6 +247,11 @@ class ClipManager {
     void setAudioSourceLength(ClipId clipId, int sourceIndex, double length);
     /** @brief Set the time-stretch factor of an audio source (1.0 = original speed) */
     void setAudioSourceStretchFactor(ClipId clipId, int sourceIndex, double stretchFactor);
+    /** @brief Set the fades at an audio source's edges (each at most the source's length) */
+    void setAudioSourceFades(ClipId clipId, int sourceIndex, const AudioFade& fadeIn,
+                             const AudioFade& fadeOut);
+    /** @brief Replace all of an audio clip's sources in one change */
+    void setAudioSources(ClipId clipId, const AudioSourceList& sources);
 
     // ========================================================================
     // Content-Level Operations (Editor Operations)
@@ -220,11 +310,18 @@ class ClipManager {
      */
     void moveAudioSource(ClipId clipId, int sourceIndex, double newPosition);
 
-    // MIDI-specific
-    void addMidiNote(ClipId clipId, const MidiNote& note);
-    void removeMidiNote(ClipId clipId, int noteIndex);
+    // MIDI-specific (notes are addressed by id; see MidiNoteList)
+    MidiNoteId addMidiNote(ClipId clipId, const MidiNote& note);
+    void updateMidiNote(ClipId clipId, const MidiNote& note);
+    void removeMidiNote(ClipId clipId, MidiNoteId noteId);
     void clearMidiNotes(ClipId clipId);
 
+    // Bulk note edits: one pass over the clip's notes and one change notification.
+    // addMidiNotes() returns the notes' ids in order (empty if clipId isn't a MIDI clip)
+    std::vector<MidiNoteId> addMidiNotes(ClipId clipId, const std::vector<MidiNote>& notes);
+    void updateMidiNotes(ClipId clipId, const std::vector<MidiNote>& notes);
+    void removeMidiNotes(ClipId clipId, const std::vector<MidiNoteId>& noteIds);
+
     // ========================================================================
     // Access
     // ========================================================================
@@ -233,25 +330,47 @@ class ClipManager {
         return clips_;
     }
 
+    /**
+     * @brief Every clip's geometry, row for row with getClips()
+     *
+     * Rows are refreshed by each change notification, like the track indexes, so an edit
+     * made directly through getClip() shows here once it is notified.
+     */
+    const std::vector<ClipGeometry>& getClipGeometry() const {
+        return geometry_;
+    }
+
     ClipInfo* getClip(ClipId clipId);
     const ClipInfo* getClip(ClipId clipId) const;
 
     /**
-     * @brief Get all clips on a specific track
+     * @brief Get all clips on a specific track, sorted by start time
      */
     std::vector<ClipId> getClipsOnTrack(TrackId trackId) const;
 
     /**
      * @brief Get clip at a specific position on a track
-     * @return INVALID_CLIP_ID if no clip at position
+     * @return The overlapping clip that starts first, or INVALID_CLIP_ID if none
      */
     ClipId getClipAtPosition(TrackId trackId, double time) const;
 
     /**
-     * @brief Get clips that overlap with a time range on a track
+     * @brief Get clips that overlap with a time range on a track, sorted by start time
      */
     std::vector<ClipId> getClipsInRange(TrackId trackId, double startTime, double endTime) const;
 
+    /**
+     * @brief The interval index over a track's clips (empty for a track without clips)
+     */
+    const ClipIntervalIndex& getTrackClipIndex(TrackId trackId) const;
+
+    /**
+     * @brief Approximate heap footprint of the clip model
+     *
+     * Clips with their notes and audio sources, plus the id and per-track range indexes.
+     */
+    size_t getSizeInBytes() const;
+
     // ========================================================================
     // Selection
     // ========================================================================
@@ -267,7 +386,9 @@ class ClipManager {
     // ========================================================================
 
     /**
-     * @brief Get clip in a specific slot (track + scene)
+     * @brief Get clip in a specific slot (track + scene), in constant time
+     *
+     * If several clips share a slot, the one that took it first.
      */
     ClipId getClipInSlot(TrackId trackId, int sceneIndex) const;
 
@@ -278,11 +399,71 @@ class ClipManager {
 
     /**
      * @brief Trigger/stop clip playback (session mode)
+     *
+     * With a ClipLauncher attached, launches and stops wait for the next multiple of the
+     * launch quantisation: a launched clip shows as queued until then, and the clip it
+     * replaces on the track plays on until the same sample. Without one they apply at once.
      */
     void triggerClip(ClipId clipId);
     void stopClip(ClipId clipId);
     void stopAllClips();
 
+    /**
+     * @brief Launch clips together, e.g. a scene: they start in the same sample
+     */
+    void launchClips(const std::vector<ClipId>& clipIds);
+    void stopClips(const std::vector<ClipId>& clipIds);
+
+    /**
+     * @brief Beats launches and stops are quantised to (0 = as soon as possible)
+     */
+    void setLaunchQuantise(double beats) {
+        launchQuantiseBeats_ = beats > 0.0 ? beats : 0.0;
+    }
+    double getLaunchQuantise() const {
+        return launchQuantiseBeats_;
+    }
+
+    /**
+     * @brief Attach the engine that times launches (non-owning; nullptr to detach)
+     */
+    void setClipLauncher(ClipLauncher* launcher) {
+        clipLauncher_ = launcher;
+    }
+
+    /**
+     * @brief A queued launch or stop reached its beat (message thread, from the launcher)
+     *
+     * Ignored if the request was cancelled or replaced in the meantime.
+     */
+    void clipLaunchFired(ClipId clipId);
+    void clipStopFired(ClipId clipId);
+
+    /**
+     * @brief Launch the clips of a scene on the given tracks, in the same sample
+     *
+     * If the scene has a follow action the scenes chain from here: each step is worked out
+     * as the previous one starts and handed to the launcher to fire on the exact beat.
+     */
+    void launchScene(int sceneIndex, const std::vector<TrackId>& trackIds);
+
+    /**
+     * @brief What a clip does after playing for afterBeats
+     *
+     * A clip's follow-up is worked out when it's launched and timed by the launcher from
+     * that launch, so it lands on the beat without the message thread. It needs a
+     * ClipLauncher: without one there is no clock to follow.
+     */
+    void setClipFollowAction(ClipId clipId, FollowAction action, double afterBeats);
+
+    /**
+     * @brief What a scene launched with launchScene() does after playing for afterBeats
+     *
+     * Takes precedence over the follow actions of its clips. Stop stops the scene's clips.
+     */
+    void setSceneFollowAction(int sceneIndex, FollowAction action, double afterBeats);
+    FollowAction getSceneFollowAction(int sceneIndex) const;
+
     // ========================================================================
     // Listener Management
     // ========================================================================
@@ -295,12 +476,22 @@ class ClipManager {
      */
     void notifyClipDragPreview(ClipId clipId, double previewStartTime, double previewLength);
 
+    /**
+     * @brief Let the engine play a dragged clip as previewed, without changing the model
+     */
+    void notifyClipAudiblePreview(const ClipInfo& preview);
+
     // ========================================================================
     // Project Management
     // ========================================================================
 
     void clearAllClips();
 
+    /**
+     * @brief Replace every clip (opening a project), with one reset for listeners
+     */
+    void loadClips(std::vector<ClipInfo> clips);
+
     /**
      * @brief Create random test clips for development
      */
@@ -311,13 +502,77 @@ class ClipManager {
     ~ClipManager() = default;
 
     std::vector<ClipInfo> clips_;
+    std::vector<ClipGeometry> geometry_;  // Parallel to clips_; what the indexes last saw
     std::vector<ClipManagerListener*> listeners_;
+
+    // ========================================================================
+    // Index
+    // ========================================================================
+
+    // Where a clip is stored
+    struct ClipSlot {
+        size_t position = 0;  // Index into clips_ and geometry_
+    };
+
+    struct TrackClips {
+        std::vector<ClipId> clipIds;
+        ClipIntervalIndex index;
+        bool dirty = false;
+        std::vector<ClipId> sceneSlots;  // By scene index; kept current, never lazy
+    };
+
+    std::unordered_map<ClipId, ClipSlot> clipSlots_;
+    mutable std::unordered_map<TrackId, TrackClips> trackClips_;  // Rebuilt lazily in queries
+
+    void rebuildClipIndex();
+    void indexAddedClip();  // The clip just pushed onto clips_
+    void unindexClip(ClipId clipId);
+    void reindexClip(ClipId clipId);
+    void fillSceneSlot(TrackClips& track, int sceneIndex, ClipId clipId);
+    void vacateSceneSlot(TrackClips& track, int sceneIndex, ClipId clipId);
     int nextClipId_ = 1;
     ClipId selectedClipId_ = INVALID_CLIP_ID;
 
+    // Session launching
+    ClipLauncher* clipLauncher_ = nullptr;
+    double launchQuantiseBeats_ = 1.0;
+    void submitLaunches(const std::vector<ClipLaunchRequest>& requests);
+
+    // Follow actions: the follow-ups handed to the launcher and not yet fired (one per
+    // track), and the scene chain whose next step waits for its anchor clip to launch
+    struct SceneFollow {
+        FollowAction action = FollowAction::None;
+        double afterBeats = 0.0;
+    };
+
+    struct SceneChain {
+        int sceneIndex = -1;  // The scene the anchor's launch starts
+        std::vector<TrackId> trackIds;
+        ClipId anchor = INVALID_CLIP_ID;
+    };
+
+    std::vector<SceneFollow> sceneFollows_;  // By scene index
+    std::vector<ClipLaunchRequest> followUps_;
+    SceneChain sceneChain_;
+    juce::Random followRandom_;
+
+    void appendClipFollowUp(const ClipInfo& clip, std::vector<ClipLaunchRequest>& requests);
+    void submitSceneFollowUps(int sceneIndex, ClipId anchor);
+    bool takeFollowUp(ClipId clipId, ClipLaunchRequest::Action action);
+    void resetFollowActions();
+
+    // Changes recorded for the next clipChangesCoalesced() delivery
+    ClipChangeSet pendingChanges_;
+    bool changeDeliveryPending_ = false;
+
+    void scheduleChangeDelivery();
+    void markClipAdded(ClipId clipId);
+    void markClipRemoved(ClipId clipId);
+    void markClipModified(ClipId clipId, ClipDirty dirty);
+
     // Notification helpers
     void notifyClipsChanged();
-    void notifyClipPropertyChanged(ClipId clipId);
+    void notifyClipPropertyChanged(ClipId clipId, ClipDirty dirty = ClipDirty::All);
     void notifyClipSelectionChanged(ClipId clipId);
     void notifyClipPlaybackStateChanged(ClipId clipId);
 
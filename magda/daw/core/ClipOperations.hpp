@@ -272,6 +272,25 @@ class ClipOperations {
                                newLength);
     }
 
+    /**
+     * @brief Stretch clip so audio at fileBpm plays in time at projectBpm
+     * Keeps the start; the length scales with the stretch factor (see stretchClipFromRight).
+     * @param clip Clip to stretch
+     * @param fileBpm Tempo of the clip's audio file (e.g. from TempoCache)
+     * @param projectBpm Tempo to play it at
+     */
+    static inline void stretchClipToTempo(ClipInfo& clip, double fileBpm, double projectBpm) {
+        if (clip.type != ClipType::Audio || clip.audioSources.empty() || fileBpm <= 0.0 ||
+            projectBpm <= 0.0) {
+            return;
+        }
+
+        double currentStretchFactor = clip.audioSources[0].stretchFactor;
+        double targetStretchFactor =
+            juce::jlimit(MIN_STRETCH_FACTOR, MAX_STRETCH_FACTOR, fileBpm / projectBpm);
+        stretchClipFromRight(clip, clip.length * targetStretchFactor / currentStretchFactor);
+    }
+
   private:
     ClipOperations() = delete;  // Static class, no instances
 };
@@ -16,6 +16,19 @@ enum class ClipType {
     MIDI    // MIDI note data
 };
 
+/**
+ * @brief What a session clip (or a chained scene) does once it has played for a while
+ */
+enum class FollowAction {
+    None,
+    Stop,      // Stop playing
+    Again,     // Launch itself again
+    Next,      // The next slot on the track that holds a clip (wrapping round)
+    Previous,  // The previous one (wrapping round)
+    First,     // The first one
+    Random     // Any other one
+};
+
 /**
  * @brief Get display name for clip type
  */
@@ -0,0 +1,149 @@
+#include "CompiledAutomation.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "AutomationInterpolation.hpp"
+#include "AutomationManager.hpp"
+
+namespace magda {
+
+size_t CompiledAutomation::addLane(const AutomationManager& manager,
+                                   const AutomationLaneInfo& lane) {
+    laneIds_.push_back(lane.id);
+
+    if (lane.isAbsolute()) {
+        addRegion(-kUnbounded, kUnbounded, 0.0, 0.0, lane.absolutePoints);
+    } else {
+        std::vector<const AutomationClipInfo*> clips;
+        for (auto clipId : lane.clipIds) {
+            if (const auto* clip = manager.getClip(clipId)) {
+                clips.push_back(clip);
+            }
+        }
+        std::stable_sort(clips.begin(), clips.end(), [](const auto* a, const auto* b) {
+            return a->startTime < b->startTime;
+        });
+
+        for (const auto* clip : clips) {
+            addRegion(clip->startTime, clip->getEndTime(), clip->startTime,
+                      clip->looping ? clip->loopLength : 0.0, clip->points);
+        }
+    }
+
+    regionBegin_.push_back(static_cast<uint32_t>(regionStart_.size()));
+    return laneIds_.size() - 1;
+}
+
+void CompiledAutomation::addRegion(double start, double end, double offset, double loopLength,
+                                   const std::vector<AutomationPoint>& points) {
+    regionStart_.push_back(start);
+    regionEnd_.push_back(end);
+    regionOffset_.push_back(offset);
+    regionLoop_.push_back(std::max(0.0, loopLength));
+
+    for (const auto& point : points) {
+        times_.push_back(point.time);
+        values_.push_back(point.value);
+        curveTypes_.push_back(point.curveType);
+        tensions_.push_back(point.tension);
+        inControls_.push_back(point.value + point.inHandle.value);
+        outControls_.push_back(point.value + point.outHandle.value);
+    }
+    pointBegin_.push_back(static_cast<uint32_t>(times_.size()));
+}
+
+bool CompiledAutomation::evaluate(size_t lane, double time, Cursor& cursor,
+                                  double& value) const {
+    const uint32_t first = regionBegin_[lane];
+    const uint32_t last = regionBegin_[lane + 1];
+    if (first == last) {
+        return false;
+    }
+
+    // Playback reads land in the region the cursor is on, or the next one
+    auto contains = [this, time](uint32_t region) {
+        return time >= regionStart_[region] && time < regionEnd_[region];
+    };
+    uint32_t region = first + cursor.region;
+    if (region >= last || !contains(region)) {
+        if (region + 1 < last && contains(region + 1)) {
+            ++region;
+        } else {
+            // The last region starting at or before time is the only one that can hold it
+            auto next = std::upper_bound(regionStart_.begin() + first,
+                                         regionStart_.begin() + last, time);
+            if (next == regionStart_.begin() + first) {
+                return false;
+            }
+            region = static_cast<uint32_t>(next - regionStart_.begin()) - 1;
+            if (!contains(region)) {
+                return false;
+            }
+        }
+        cursor.region = region - first;
+        cursor.segment = 0;
+    }
+
+    double localTime = time - regionOffset_[region];
+    if (regionLoop_[region] > 0.0) {
+        localTime = std::fmod(localTime, regionLoop_[region]);
+        if (localTime < 0.0) {
+            localTime += regionLoop_[region];
+        }
+    }
+
+    value = evaluatePoints(pointBegin_[region], pointBegin_[region + 1], localTime,
+                           cursor.segment);
+    return true;
+}
+
+double CompiledAutomation::evaluatePoints(uint32_t begin, uint32_t end, double time,
+                                          uint32_t& segment) const {
+    if (begin == end) {
+        return 0.5;
+    }
+    if (time <= times_[begin]) {
+        return values_[begin];
+    }
+    if (time >= times_[end - 1]) {
+        return values_[end - 1];
+    }
+
+    // Sequential reads land in the hinted segment or the one after it
+    const uint32_t lastSegment = end - 2;
+    for (uint32_t i = begin + segment; i <= std::min(begin + segment + 1, lastSegment); ++i) {
+        if (time >= times_[i] && time < times_[i + 1]) {
+            segment = i - begin;
+            return evaluateSegment(i, time);
+        }
+    }
+
+    // Otherwise binary search for the first point after time; the segment starts before it
+    auto next = std::upper_bound(times_.begin() + begin + 1, times_.begin() + end - 1, time);
+    const auto index = static_cast<uint32_t>(next - times_.begin()) - 1;
+    segment = index - begin;
+    return evaluateSegment(index, time);
+}
+
+double CompiledAutomation::evaluateSegment(uint32_t index, double time) const {
+    const double duration = times_[index + 1] - times_[index];
+    if (duration <= 0.0) {
+        return values_[index];
+    }
+
+    const double t = (time - times_[index]) / duration;
+    switch (curveTypes_[index]) {
+        case AutomationCurveType::Linear:
+            return AutomationInterpolation::withTension(t, values_[index], values_[index + 1],
+                                                        tensions_[index]);
+        case AutomationCurveType::Bezier:
+            return AutomationInterpolation::bezier(t, values_[index], outControls_[index],
+                                                   inControls_[index + 1], values_[index + 1]);
+        case AutomationCurveType::Step:
+            return values_[index];
+    }
+    return 0.5;
+}
+
+}  // namespace magda
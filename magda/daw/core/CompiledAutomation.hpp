@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "AutomationInfo.hpp"
+
+namespace magda {
+
+class AutomationManager;
+
+/**
+ * @brief Automation lanes flattened into immutable arrays for reading at audio rate
+ *
+ * Each lane is a run of regions: one unbounded region for an absolute lane, one per clip
+ * (sorted by start) for a clip-based lane. A region maps timeline time to its points' local
+ * time, wrapping for looping clips. Points are stored structure-of-arrays with each
+ * segment's bezier controls baked in, so a read touches no AutomationPoint or model lookup:
+ * one cursor check and one segment evaluation.
+ *
+ * Values match AutomationManager::getValueAtTime(), except between the clips of a
+ * clip-based lane, where evaluate() reports no value instead of 0.5. Built on the message
+ * thread; once built it is read-only, so any thread may evaluate it with its own Cursor.
+ */
+class CompiledAutomation {
+  public:
+    /**
+     * @brief Where the last read of a lane landed, so sequential reads don't search
+     */
+    struct Cursor {
+        uint32_t region = 0;   // Relative to the lane's first region
+        uint32_t segment = 0;  // Relative to the region's first point
+    };
+
+    /**
+     * @brief Append a lane's current curve data
+     * @return The lane's index
+     */
+    size_t addLane(const AutomationManager& manager, const AutomationLaneInfo& lane);
+
+    size_t getNumLanes() const {
+        return laneIds_.size();
+    }
+
+    AutomationLaneId getLaneId(size_t lane) const {
+        return laneIds_[lane];
+    }
+
+    size_t getNumPoints() const {
+        return times_.size();
+    }
+
+    /**
+     * @brief A lane's normalised value at a timeline time
+     * @return false where the lane has no value (between the clips of a clip-based lane)
+     *
+     * Lock-free and allocation-free.
+     */
+    bool evaluate(size_t lane, double time, Cursor& cursor, double& value) const;
+
+  private:
+    void addRegion(double start, double end, double offset, double loopLength,
+                   const std::vector<AutomationPoint>& points);
+    double evaluatePoints(uint32_t begin, uint32_t end, double time, uint32_t& segment) const;
+    double evaluateSegment(uint32_t index, double time) const;
+
+    static constexpr double kUnbounded = std::numeric_limits<double>::max();
+
+    std::vector<AutomationLaneId> laneIds_;
+    std::vector<uint32_t> regionBegin_{0};  // CSR by lane
+
+    // Regions
+    std::vector<double> regionStart_;  // Timeline span [start, end)
+    std::vector<double> regionEnd_;
+    std::vector<double> regionOffset_;  // Timeline time of local time 0
+    std::vector<double> regionLoop_;    // Local loop length, 0 if not looping
+    std::vector<uint32_t> pointBegin_{0};  // CSR by region
+
+    // Points, in local time order
+    std::vector<double> times_;
+    std::vector<double> values_;
+    std::vector<AutomationCurveType> curveTypes_;  // Shape of the segment after the point
+    std::vector<double> tensions_;
+    std::vector<double> inControls_;   // value + inHandle.value
+    std::vector<double> outControls_;  // value + outHandle.value
+};
+
+}  // namespace magda
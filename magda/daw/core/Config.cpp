@@ -1,10 +1,19 @@
 #include "Config.hpp"
 
+#include <juce_core/juce_core.h>
+
 #include <fstream>
 #include <iostream>
+#include <type_traits>
+
+#include "StartupCache.hpp"
 
 namespace magda {
 
+namespace {
+const char* const kCacheSection = "Config";
+}  // namespace
+
 Config& Config::getInstance() {
     static Config instance;
     return instance;
@@ -27,17 +36,89 @@ void Config::saveToFile(const std::string& filename) {
     file << "zoomInSensitivityShift=" << zoomInSensitivityShift << std::endl;
     file << "zoomOutSensitivityShift=" << zoomOutSensitivityShift << std::endl;
     file << "scrollbarOnLeft=" << (scrollbarOnLeft ? 1 : 0) << std::endl;
+    file << "gpuRendering=" << (gpuRendering ? 1 : 0) << std::endl;
     file << "preferredAudioDevice=" << preferredAudioDevice << std::endl;
     file << "preferredInputDevice=" << preferredInputDevice << std::endl;
     file << "preferredOutputDevice=" << preferredOutputDevice << std::endl;
     file << "preferredInputChannels=" << preferredInputChannels << std::endl;
     file << "preferredOutputChannels=" << preferredOutputChannels << std::endl;
+    file << "waveformCacheSizeMB=" << waveformCacheSizeMB << std::endl;
+    file << "renderThreadCount=" << renderThreadCount << std::endl;
+    file << "renderThreadPinning=" << (renderThreadPinning ? 1 : 0) << std::endl;
+    file << "renderThreadPerformanceCores=" << (renderThreadPerformanceCores ? 1 : 0)
+         << std::endl;
+    file << "chainSuspendTailSeconds=" << chainSuspendTailSeconds << std::endl;
+    file << "liveLatencyPolicy=" << liveLatencyPolicy << std::endl;
+    file << "livePreRender=" << (livePreRender ? 1 : 0) << std::endl;
+    file << "automationThinningTolerance=" << automationThinningTolerance << std::endl;
+    file << "metricsPort=" << metricsPort << std::endl;
+    file << "metricsRemoteAccess=" << (metricsRemoteAccess ? 1 : 0) << std::endl;
 
     file.close();
     std::cout << "Config saved to: " << filename << std::endl;
 }
 
+template <typename Visitor> void Config::forEachSetting(Visitor&& visit) {
+    visit(defaultTimelineLength);
+    visit(defaultZoomViewDuration);
+    visit(minZoomLevel);
+    visit(maxZoomLevel);
+    visit(zoomInSensitivity);
+    visit(zoomOutSensitivity);
+    visit(zoomInSensitivityShift);
+    visit(zoomOutSensitivityShift);
+    visit(transportShowBothFormats);
+    visit(transportDefaultBarsBeats);
+    visit(showLeftPanel);
+    visit(showRightPanel);
+    visit(showBottomPanel);
+    visit(scrollbarOnLeft);
+    visit(gpuRendering);
+    visit(preferredAudioDevice);
+    visit(preferredInputDevice);
+    visit(preferredOutputDevice);
+    visit(preferredInputChannels);
+    visit(preferredOutputChannels);
+    visit(waveformCacheSizeMB);
+    visit(renderThreadCount);
+    visit(renderThreadPinning);
+    visit(renderThreadPerformanceCores);
+    visit(chainSuspendTailSeconds);
+    visit(liveLatencyPolicy);
+    visit(livePreRender);
+    visit(automationThinningTolerance);
+    visit(metricsPort);
+    visit(metricsRemoteAccess);
+}
+
 void Config::loadFromFile(const std::string& filename) {
+    const auto source =
+        juce::File::getCurrentWorkingDirectory().getChildFile(juce::String(filename));
+    auto& cache = StartupCache::getInstance();
+
+    // The settings as they were decoded the last time this file was parsed
+    if (const auto section = cache.find(kCacheSection, source); section.isValid()) {
+        juce::MemoryInputStream in(section.data, section.size, false);
+        Config decoded = *this;
+        decoded.forEachSetting([&in](auto& field) {
+            using Field = std::decay_t<decltype(field)>;
+            if constexpr (std::is_same_v<Field, double>) {
+                field = in.readDouble();
+            } else if constexpr (std::is_same_v<Field, bool>) {
+                field = in.readBool();
+            } else if constexpr (std::is_same_v<Field, int>) {
+                field = in.readInt();
+            } else {
+                field = in.readString().toStdString();
+            }
+        });
+        if (in.getPosition() == static_cast<juce::int64>(section.size)) {
+            *this = decoded;
+            std::cout << "Config loaded from the startup cache: " << filename << std::endl;
+            return;
+        }
+    }
+
     std::ifstream file(filename);
     if (!file.is_open()) {
         std::cout << "Config file not found, using defaults: " << filename << std::endl;
@@ -58,6 +139,21 @@ void Config::loadFromFile(const std::string& filename) {
 
     file.close();
     std::cout << "Config loaded from: " << filename << std::endl;
+
+    juce::MemoryOutputStream out;
+    forEachSetting([&out](auto& field) {
+        using Field = std::decay_t<decltype(field)>;
+        if constexpr (std::is_same_v<Field, double>) {
+            out.writeDouble(field);
+        } else if constexpr (std::is_same_v<Field, bool>) {
+            out.writeBool(field);
+        } else if constexpr (std::is_same_v<Field, int>) {
+            out.writeInt(field);
+        } else {
+            out.writeString(juce::String(field));
+        }
+    });
+    cache.store(kCacheSection, source, out.getData(), out.getDataSize());
 }
 
 void Config::parseConfigLine(const std::string& key, const std::string& value) {
@@ -98,10 +194,32 @@ void Config::parseConfigLine(const std::string& key, const std::string& value) {
             zoomOutSensitivityShift = numValue;
         } else if (key == "scrollbarOnLeft") {
             scrollbarOnLeft = (numValue != 0);
+        } else if (key == "gpuRendering") {
+            gpuRendering = (numValue != 0);
         } else if (key == "preferredInputChannels") {
             preferredInputChannels = static_cast<int>(numValue);
         } else if (key == "preferredOutputChannels") {
             preferredOutputChannels = static_cast<int>(numValue);
+        } else if (key == "waveformCacheSizeMB") {
+            waveformCacheSizeMB = static_cast<int>(numValue);
+        } else if (key == "renderThreadCount") {
+            renderThreadCount = static_cast<int>(numValue);
+        } else if (key == "renderThreadPinning") {
+            renderThreadPinning = (numValue != 0);
+        } else if (key == "renderThreadPerformanceCores") {
+            renderThreadPerformanceCores = (numValue != 0);
+        } else if (key == "chainSuspendTailSeconds") {
+            chainSuspendTailSeconds = numValue;
+        } else if (key == "liveLatencyPolicy") {
+            liveLatencyPolicy = static_cast<int>(numValue);
+        } else if (key == "livePreRender") {
+            livePreRender = (numValue != 0);
+        } else if (key == "automationThinningTolerance") {
+            automationThinningTolerance = numValue;
+        } else if (key == "metricsPort") {
+            metricsPort = static_cast<int>(numValue);
+        } else if (key == "metricsRemoteAccess") {
+            metricsRemoteAccess = (numValue != 0);
         }
         // Skip unknown keys silently
     } catch (const std::exception& e) {
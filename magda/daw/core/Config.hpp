@@ -117,6 +117,14 @@ class Config {
         scrollbarOnLeft = onLeft;
     }
 
+    // Rendering Configuration
+    bool getGpuRendering() const {
+        return gpuRendering;
+    }
+    void setGpuRendering(bool enabled) {
+        gpuRendering = enabled;
+    }
+
     // Audio Device Configuration
     std::string getPreferredAudioDevice() const {
         return preferredAudioDevice;
@@ -153,8 +161,90 @@ class Config {
         preferredOutputChannels = channels;
     }
 
+    // Waveform Cache Configuration
+    int getWaveformCacheSizeMB() const {
+        return waveformCacheSizeMB;
+    }
+    void setWaveformCacheSizeMB(int megabytes) {
+        waveformCacheSizeMB = megabytes;
+    }
+
+    // Render Thread Configuration
+    int getRenderThreadCount() const {
+        return renderThreadCount;
+    }
+    void setRenderThreadCount(int count) {
+        renderThreadCount = count;
+    }
+    bool getRenderThreadPinning() const {
+        return renderThreadPinning;
+    }
+    void setRenderThreadPinning(bool pin) {
+        renderThreadPinning = pin;
+    }
+    bool getRenderThreadPerformanceCores() const {
+        return renderThreadPerformanceCores;
+    }
+    void setRenderThreadPerformanceCores(bool performance) {
+        renderThreadPerformanceCores = performance;
+    }
+
+    // Idle Chain Configuration
+    double getChainSuspendTailSeconds() const {
+        return chainSuspendTailSeconds;
+    }
+    void setChainSuspendTailSeconds(double seconds) {
+        chainSuspendTailSeconds = seconds;
+    }
+
+    // Live Latency Configuration (a LatencyPlanner::Policy: 0 compensate, 1 bypass latent
+    // plugins, 2 constrain compensation to the profile's target)
+    int getLiveLatencyPolicy() const {
+        return liveLatencyPolicy;
+    }
+    void setLiveLatencyPolicy(int policy) {
+        liveLatencyPolicy = policy;
+    }
+    // Render idle tracks ahead in Live mode (see TrackPreRenderer)
+    bool getLivePreRender() const {
+        return livePreRender;
+    }
+    void setLivePreRender(bool preRender) {
+        livePreRender = preRender;
+    }
+
+    // Automation Recording Configuration (largest error, in normalized value, that point
+    // thinning may leave in a recorded pass)
+    double getAutomationThinningTolerance() const {
+        return automationThinningTolerance;
+    }
+    void setAutomationThinningTolerance(double tolerance) {
+        automationThinningTolerance = tolerance;
+    }
+
+    // Metrics Endpoint Configuration (Prometheus text over HTTP; see MetricsExporter)
+    int getMetricsPort() const {
+        return metricsPort;
+    }
+    void setMetricsPort(int port) {
+        metricsPort = port;
+    }
+    bool getMetricsRemoteAccess() const {
+        return metricsRemoteAccess;
+    }
+    void setMetricsRemoteAccess(bool remote) {
+        metricsRemoteAccess = remote;
+    }
+
     // Save/Load Configuration (for future use)
     void saveToFile(const std::string& filename);
+
+    /**
+     * @brief Load settings from a key=value file
+     *
+     * The parsed settings are kept in the StartupCache, so until the file changes later
+     * starts read them back in binary instead of parsing it.
+     */
     void loadFromFile(const std::string& filename);
 
   private:
@@ -163,6 +253,9 @@ class Config {
     // Helper to parse a single config line
     void parseConfigLine(const std::string& key, const std::string& value);
 
+    // Calls visit(field) on every setting, in one fixed order (the startup cache layout)
+    template <typename Visitor> void forEachSetting(Visitor&& visit);
+
     // Timeline settings
     double defaultTimelineLength = 300.0;   // 5 minutes in seconds
     double defaultZoomViewDuration = 60.0;  // Show 1 minute by default
@@ -189,12 +282,37 @@ class Config {
     // Layout settings
     bool scrollbarOnLeft = false;  // Scrollbar on right by default
 
+    // Rendering settings
+    bool gpuRendering = false;  // Paint the UI through OpenGL (builds with MAGDA_ENABLE_OPENGL)
+
     // Audio device settings
     std::string preferredAudioDevice = "";   // Preferred audio interface (empty = system default)
     std::string preferredInputDevice = "";   // Preferred input device (empty = system default)
     std::string preferredOutputDevice = "";  // Preferred output device (empty = system default)
     int preferredInputChannels = 0;   // Preferred input channel count (0 = use device default)
     int preferredOutputChannels = 0;  // Preferred output channel count (0 = use device default)
+
+    // Waveform cache settings
+    int waveformCacheSizeMB = 256;  // Peak data kept in memory before unused waveforms are evicted
+
+    // Render thread settings
+    int renderThreadCount = 0;                 // Engine render threads (0 = half the cores)
+    bool renderThreadPinning = false;          // Pin each render thread to its own core
+    bool renderThreadPerformanceCores = true;  // Keep render threads off efficiency cores
+
+    // Idle chain settings
+    double chainSuspendTailSeconds = 2.0;  // Silence before idle devices stop (0 = never)
+
+    // Live latency settings
+    int liveLatencyPolicy = 2;  // Constrain compensation to the Live profile's target
+    bool livePreRender = false;  // Freeze tracks that needn't render live, quietly
+
+    // Automation recording settings
+    double automationThinningTolerance = 0.005;  // Half a percent of the parameter's range
+
+    // Metrics endpoint settings
+    int metricsPort = 0;               // Serve /metrics on this port (0 = off)
+    bool metricsRemoteAccess = false;  // Accept scrapes from other machines, not just this one
 };
 
 }  // namespace magda
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <memory>
+#include <utility>
+
+namespace magda {
+
+/**
+ * @brief Copy-on-write handle for a node of the device chain tree
+ *
+ * Copies share the node. The first mutable access through a handle whose node is shared
+ * clones it - shallowly, so a cloned rack still shares its chains' elements. Copying a track's
+ * chain is therefore a few refcount increments, and editing one device copies only the nodes
+ * on the path from that device up to the element held by the track.
+ *
+ * A mutable reference is only good until the element is next copied: writing through a
+ * reference taken before a snapshot would change the snapshot too. Edits and snapshots happen
+ * on the message thread; a finished snapshot can be read from any thread.
+ */
+template <typename T>
+class CowPtr {
+  public:
+    CowPtr() : node_(std::make_shared<T>()) {}
+    explicit CowPtr(T value) : node_(std::make_shared<T>(std::move(value))) {}
+
+    const T& read() const {
+        return *node_;
+    }
+
+    T& write() {
+        if (node_.use_count() > 1) {
+            node_ = std::make_shared<T>(*node_);
+        }
+        return *node_;
+    }
+
+    /**
+     * @brief True if both handles refer to the same node (no copy has happened since)
+     */
+    bool sharesNodeWith(const CowPtr& other) const {
+        return node_ == other.node_;
+    }
+
+  private:
+    std::shared_ptr<T> node_;
+};
+
+}  // namespace magda
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace magda {
+
+/**
+ * @brief A vector whose copies share one array until one of them is changed
+ *
+ * Reads go straight to the shared array; the first mutable access through a handle whose
+ * array is shared (non-const operator[], begin(), push_back()...) clones it. Copying a clip
+ * for the clipboard, a duplicate or an undo command therefore copies a pointer rather than
+ * the clip's payload. An empty vector holds nothing at all.
+ *
+ * As with CowPtr, a mutable reference is only good until the vector is next copied, and
+ * edits and copies happen on the message thread; a copy can then be read from any thread.
+ * Converts to const std::vector<T>& for code that takes one.
+ */
+template <typename T>
+class CowVector {
+  public:
+    using value_type = T;
+    using iterator = typename std::vector<T>::iterator;
+    using const_iterator = typename std::vector<T>::const_iterator;
+
+    CowVector() = default;
+    CowVector(std::vector<T> items) {
+        assign(std::move(items));
+    }
+    CowVector(std::initializer_list<T> items) : CowVector(std::vector<T>(items)) {}
+
+    CowVector& operator=(std::vector<T> items) {
+        assign(std::move(items));
+        return *this;
+    }
+
+    const std::vector<T>& read() const {
+        static const std::vector<T> empty;
+        return items_ != nullptr ? *items_ : empty;
+    }
+
+    std::vector<T>& write() {
+        if (items_ == nullptr) {
+            items_ = std::make_shared<std::vector<T>>();
+        } else if (items_.use_count() > 1) {
+            items_ = std::make_shared<std::vector<T>>(*items_);
+        }
+        return *items_;
+    }
+
+    operator const std::vector<T>&() const {
+        return read();
+    }
+
+    size_t size() const {
+        return read().size();
+    }
+    bool empty() const {
+        return read().empty();
+    }
+
+    const T& operator[](size_t index) const {
+        return read()[index];
+    }
+    T& operator[](size_t index) {
+        return write()[index];
+    }
+    const T& front() const {
+        return read().front();
+    }
+    T& front() {
+        return write().front();
+    }
+
+    const_iterator begin() const {
+        return read().begin();
+    }
+    const_iterator end() const {
+        return read().end();
+    }
+    iterator begin() {
+        return write().begin();
+    }
+    iterator end() {
+        return write().end();
+    }
+
+    void push_back(T item) {
+        write().push_back(std::move(item));
+    }
+    void clear() {
+        items_.reset();
+    }
+
+    /**
+     * @brief True if both vectors use the same array (neither changed since one was copied)
+     */
+    bool sharesStorageWith(const CowVector& other) const {
+        return items_ != nullptr && items_ == other.items_;
+    }
+
+  private:
+    void assign(std::vector<T> items) {
+        items_ = items.empty() ? nullptr : std::make_shared<std::vector<T>>(std::move(items));
+    }
+
+    std::shared_ptr<std::vector<T>> items_;
+};
+
+}  // namespace magda
@@ -2,9 +2,14 @@
 
 #include <juce_core/juce_core.h>
 
+#include <array>
+#include <memory>
+#include <vector>
+
 #include "MacroInfo.hpp"
 #include "ModInfo.hpp"
 #include "ParameterInfo.hpp"
+#include "ParameterList.hpp"
 #include "TypeIds.hpp"
 
 namespace magda {
@@ -14,6 +19,36 @@ namespace magda {
  */
 enum class PluginFormat { VST3, AU, VST, Internal };
 
+/**
+ * @brief A device's whole state at one moment, cached so it can be brought back quickly
+ *
+ * Holds both the full plugin state and the parameter values it had, so recalling it can
+ * set just the parameters that differ when nothing else in the state changed, and only
+ * load the full state (which can take a sampler hundreds of ms) when it did.
+ */
+struct DeviceStateSnapshot {
+    juce::MemoryBlock state;             // Full plugin state, as the engine saves it
+    std::vector<float> parameterValues;  // Real values, in DeviceInfo::parameters order
+
+    /**
+     * @brief Set params to the snapshot's values
+     * @return How many changed, or -1 (nothing set) if the parameter lists don't match
+     */
+    int applyParameters(ParameterList& params) const {
+        if (params.size() != parameterValues.size()) {
+            return -1;
+        }
+        int changed = 0;
+        for (size_t i = 0; i < params.size(); ++i) {
+            if (params.getValue(i) != parameterValues[i]) {
+                params.setValue(i, parameterValues[i]);
+                ++changed;
+            }
+        }
+        return changed;
+    }
+};
+
 /**
  * @brief Device/plugin information stored on a track
  */
@@ -29,16 +64,18 @@ struct DeviceInfo {
     juce::String uniqueId;          // PluginDescription::createIdentifierString()
     juce::String fileOrIdentifier;  // Path to plugin file or AU identifier
 
-    bool bypassed = false;  // Device bypass state
-    bool expanded = true;   // UI expanded state
+    bool bypassed = false;   // Device bypass state
+    int oversampling = 1;    // Offline renders run at this multiple of the rate (1, 2 or 4)
+    bool sandboxed = false;  // External plugin runs in a separate process (SandboxHost)
+    bool expanded = true;    // UI expanded state
 
     // UI panel visibility states
     bool modPanelOpen = false;    // Modulator panel visible
     bool gainPanelOpen = false;   // Gain panel visible
     bool paramPanelOpen = false;  // Parameter panel visible
 
-    // Device parameters (populated by DeviceProcessor)
-    std::vector<ParameterInfo> parameters;
+    // Device parameters (populated by DeviceProcessor; sparse for external plugins)
+    ParameterList parameters;
 
     // User-selected visible parameters (indices into plugin parameter list)
     // If empty, show first N parameters; otherwise show these specific indices
@@ -55,6 +92,11 @@ struct DeviceInfo {
     // Modulators for device-level modulation
     ModArray mods = createDefaultMods();
 
+    // A/B state slots (see TrackManager::switchDeviceStateSlot); shared on copy, not saved
+    static constexpr int kNumStateSlots = 2;
+    std::array<std::shared_ptr<const DeviceStateSnapshot>, kNumStateSlots> stateSlots;
+    int activeStateSlot = 0;
+
     // UI state
     int currentParameterPage = 0;  // Current parameter page (for multi-page param display)
 
@@ -33,11 +33,56 @@ struct MacroTarget {
 };
 
 /**
- * @brief A single macro link with per-link amount
+ * @brief How a macro link responds across the knob's travel
+ */
+enum class MacroCurve {
+    Linear,
+    Exponential,  // Slow start, fast finish (x^2)
+    Logarithmic,  // Fast start, slow finish
+    SCurve        // Eased at both ends
+};
+
+/**
+ * @brief Where a macro value falls in a link's range, shaped by its curve (0 to 1)
+ *
+ * Below rangeStart is 0 and past rangeEnd is 1; a range that runs backwards inverts the
+ * link. Inline and allocation-free: the audio thread evaluates links with it too.
+ */
+inline float shapeMacroValue(float value, float rangeStart, float rangeEnd, MacroCurve curve) {
+    const float span = rangeEnd - rangeStart;
+    float x = span != 0.0f ? (value - rangeStart) / span : (value >= rangeStart ? 1.0f : 0.0f);
+    x = x < 0.0f ? 0.0f : (x > 1.0f ? 1.0f : x);
+    switch (curve) {
+        case MacroCurve::Exponential:
+            return x * x;
+        case MacroCurve::Logarithmic:
+            return 1.0f - (1.0f - x) * (1.0f - x);
+        case MacroCurve::SCurve:
+            return x * x * (3.0f - 2.0f * x);
+        case MacroCurve::Linear:
+            break;
+    }
+    return x;
+}
+
+/**
+ * @brief A single macro link with per-link amount, range and curve
  */
 struct MacroLink {
     MacroTarget target;
     float amount = 0.5f;  // Per-link amount (0.0 to 1.0)
+
+    // The part of the knob's travel the link moves over, and its shape across it
+    float rangeStart = 0.0f;
+    float rangeEnd = 1.0f;
+    MacroCurve curve = MacroCurve::Linear;
+
+    /**
+     * @brief What the link adds to its parameter (normalised) at a macro value
+     */
+    float getContribution(float macroValue) const {
+        return amount * shapeMacroValue(macroValue, rangeStart, rangeEnd, curve);
+    }
 };
 
 /**
@@ -1,9 +1,62 @@
 #include "MidiNoteCommands.hpp"
 
-#include <algorithm>
+#include <unordered_map>
+#include <utility>
 
 namespace magda {
 
+namespace {
+
+// The note if clipId is a MIDI clip containing it (valid until the clip's notes change)
+const MidiNote* findMidiNote(ClipId clipId, MidiNoteId noteId) {
+    const auto* clip = ClipManager::getInstance().getClip(clipId);
+    if (!clip || clip->type != ClipType::MIDI) {
+        return nullptr;
+    }
+    return clip->midiNotes.find(noteId);
+}
+
+bool sameNote(const MidiNote& a, const MidiNote& b) {
+    return a.noteNumber == b.noteNumber && a.velocity == b.velocity &&
+           a.startBeat == b.startBeat && a.lengthBeats == b.lengthBeats;
+}
+
+std::vector<MidiNoteId> idsOf(const std::vector<MidiNote>& notes) {
+    std::vector<MidiNoteId> ids;
+    ids.reserve(notes.size());
+    for (const auto& note : notes) {
+        ids.push_back(note.id);
+    }
+    return ids;
+}
+
+// Notes with their ids, for spilling a command's state (see UndoableCommand::spillState)
+void writeNotes(juce::OutputStream& out, std::vector<MidiNote>& notes) {
+    out.writeInt(static_cast<int>(notes.size()));
+    for (const auto& note : notes) {
+        out.writeInt(note.id);
+        out.writeInt(note.noteNumber);
+        out.writeInt(note.velocity);
+        out.writeDouble(note.startBeat);
+        out.writeDouble(note.lengthBeats);
+    }
+    std::vector<MidiNote>().swap(notes);
+}
+
+std::vector<MidiNote> readNotes(juce::InputStream& in) {
+    std::vector<MidiNote> notes(static_cast<size_t>(juce::jmax(0, in.readInt())));
+    for (auto& note : notes) {
+        note.id = in.readInt();
+        note.noteNumber = in.readInt();
+        note.velocity = in.readInt();
+        note.startBeat = in.readDouble();
+        note.lengthBeats = in.readDouble();
+    }
+    return notes;
+}
+
+}  // namespace
+
 // ============================================================================
 // AddMidiNoteCommand
 // ============================================================================
@@ -25,12 +78,9 @@ void AddMidiNoteCommand::execute() {
         return;
     }
 
-    // Add note via ClipManager API
-    clipManager.addMidiNote(clipId_, note_);
-
-    // The note was added at the end, so its index is size - 1
-    insertedIndex_ = clip->midiNotes.size() - 1;
-    executed_ = true;
+    // Add note via ClipManager API; redo passes the id back so later commands still match
+    note_.id = clipManager.addMidiNote(clipId_, note_);
+    executed_ = note_.id != INVALID_MIDI_NOTE_ID;
 }
 
 void AddMidiNoteCommand::undo() {
@@ -39,39 +89,77 @@ void AddMidiNoteCommand::undo() {
     }
 
     auto& clipManager = ClipManager::getInstance();
-    clipManager.removeMidiNote(clipId_, static_cast<int>(insertedIndex_));
+    clipManager.removeMidiNote(clipId_, note_.id);
+}
+
+// ============================================================================
+// AddMidiNotesCommand
+// ============================================================================
+
+AddMidiNotesCommand::AddMidiNotesCommand(ClipId clipId, std::vector<MidiNote> notes)
+    : clipId_(clipId), notes_(std::move(notes)), numNotes_(notes_.size()) {}
+
+void AddMidiNotesCommand::execute() {
+    const auto ids = ClipManager::getInstance().addMidiNotes(clipId_, notes_);
+    if (ids.size() != notes_.size()) {
+        return;
+    }
+
+    for (size_t i = 0; i < ids.size(); ++i) {
+        notes_[i].id = ids[i];
+    }
+    executed_ = true;
+}
+
+void AddMidiNotesCommand::undo() {
+    if (!executed_) {
+        return;
+    }
+
+    ClipManager::getInstance().removeMidiNotes(clipId_, idsOf(notes_));
+}
+
+std::vector<MidiNoteId> AddMidiNotesCommand::getAddedNoteIds() const {
+    return executed_ ? idsOf(notes_) : std::vector<MidiNoteId>{};
+}
+
+bool AddMidiNotesCommand::spillState(juce::OutputStream& out) {
+    if (notes_.empty()) {
+        return false;
+    }
+    writeNotes(out, notes_);
+    return true;
+}
+
+void AddMidiNotesCommand::restoreState(juce::InputStream& in) {
+    notes_ = readNotes(in);
 }
 
 // ============================================================================
 // MoveMidiNoteCommand
 // ============================================================================
 
-MoveMidiNoteCommand::MoveMidiNoteCommand(ClipId clipId, size_t noteIndex, double newStartBeat,
+MoveMidiNoteCommand::MoveMidiNoteCommand(ClipId clipId, MidiNoteId noteId, double newStartBeat,
                                          int newNoteNumber)
-    : clipId_(clipId),
-      noteIndex_(noteIndex),
-      newStartBeat_(newStartBeat),
-      newNoteNumber_(newNoteNumber) {
+    : clipId_(clipId), noteId_(noteId), newStartBeat_(newStartBeat), newNoteNumber_(newNoteNumber) {
     // Capture old values
-    const auto* clip = ClipManager::getInstance().getClip(clipId_);
-    if (clip && noteIndex_ < clip->midiNotes.size()) {
-        oldStartBeat_ = clip->midiNotes[noteIndex_].startBeat;
-        oldNoteNumber_ = clip->midiNotes[noteIndex_].noteNumber;
+    if (const auto* note = findMidiNote(clipId_, noteId_)) {
+        oldStartBeat_ = note->startBeat;
+        oldNoteNumber_ = note->noteNumber;
     }
 }
 
 void MoveMidiNoteCommand::execute() {
-    auto& clipManager = ClipManager::getInstance();
-    auto* clip = clipManager.getClip(clipId_);
-
-    if (!clip || clip->type != ClipType::MIDI || noteIndex_ >= clip->midiNotes.size()) {
+    const auto* note = findMidiNote(clipId_, noteId_);
+    if (!note) {
         return;
     }
 
-    clip->midiNotes[noteIndex_].startBeat = newStartBeat_;
-    clip->midiNotes[noteIndex_].noteNumber = newNoteNumber_;
+    MidiNote moved = *note;
+    moved.startBeat = newStartBeat_;
+    moved.noteNumber = newNoteNumber_;
 
-    clipManager.forceNotifyClipPropertyChanged(clipId_);
+    ClipManager::getInstance().updateMidiNote(clipId_, moved);
     executed_ = true;
 }
 
@@ -80,22 +168,21 @@ void MoveMidiNoteCommand::undo() {
         return;
     }
 
-    auto& clipManager = ClipManager::getInstance();
-    auto* clip = clipManager.getClip(clipId_);
-
-    if (!clip || clip->type != ClipType::MIDI || noteIndex_ >= clip->midiNotes.size()) {
+    const auto* note = findMidiNote(clipId_, noteId_);
+    if (!note) {
         return;
     }
 
-    clip->midiNotes[noteIndex_].startBeat = oldStartBeat_;
-    clip->midiNotes[noteIndex_].noteNumber = oldNoteNumber_;
+    MidiNote restored = *note;
+    restored.startBeat = oldStartBeat_;
+    restored.noteNumber = oldNoteNumber_;
 
-    clipManager.forceNotifyClipPropertyChanged(clipId_);
+    ClipManager::getInstance().updateMidiNote(clipId_, restored);
 }
 
 bool MoveMidiNoteCommand::canMergeWith(const UndoableCommand* other) const {
     auto* otherMove = dynamic_cast<const MoveMidiNoteCommand*>(other);
-    return otherMove && otherMove->clipId_ == clipId_ && otherMove->noteIndex_ == noteIndex_;
+    return otherMove && otherMove->clipId_ == clipId_ && otherMove->noteId_ == noteId_;
 }
 
 void MoveMidiNoteCommand::mergeWith(const UndoableCommand* other) {
@@ -110,26 +197,25 @@ void MoveMidiNoteCommand::mergeWith(const UndoableCommand* other) {
 // ResizeMidiNoteCommand
 // ============================================================================
 
-ResizeMidiNoteCommand::ResizeMidiNoteCommand(ClipId clipId, size_t noteIndex, double newLengthBeats)
-    : clipId_(clipId), noteIndex_(noteIndex), newLengthBeats_(newLengthBeats) {
+ResizeMidiNoteCommand::ResizeMidiNoteCommand(ClipId clipId, MidiNoteId noteId,
+                                             double newLengthBeats)
+    : clipId_(clipId), noteId_(noteId), newLengthBeats_(newLengthBeats) {
     // Capture old value
-    const auto* clip = ClipManager::getInstance().getClip(clipId_);
-    if (clip && noteIndex_ < clip->midiNotes.size()) {
-        oldLengthBeats_ = clip->midiNotes[noteIndex_].lengthBeats;
+    if (const auto* note = findMidiNote(clipId_, noteId_)) {
+        oldLengthBeats_ = note->lengthBeats;
     }
 }
 
 void ResizeMidiNoteCommand::execute() {
-    auto& clipManager = ClipManager::getInstance();
-    auto* clip = clipManager.getClip(clipId_);
-
-    if (!clip || clip->type != ClipType::MIDI || noteIndex_ >= clip->midiNotes.size()) {
+    const auto* note = findMidiNote(clipId_, noteId_);
+    if (!note) {
         return;
     }
 
-    clip->midiNotes[noteIndex_].lengthBeats = newLengthBeats_;
+    MidiNote resized = *note;
+    resized.lengthBeats = newLengthBeats_;
 
-    clipManager.forceNotifyClipPropertyChanged(clipId_);
+    ClipManager::getInstance().updateMidiNote(clipId_, resized);
     executed_ = true;
 }
 
@@ -138,21 +224,20 @@ void ResizeMidiNoteCommand::undo() {
         return;
     }
 
-    auto& clipManager = ClipManager::getInstance();
-    auto* clip = clipManager.getClip(clipId_);
-
-    if (!clip || clip->type != ClipType::MIDI || noteIndex_ >= clip->midiNotes.size()) {
+    const auto* note = findMidiNote(clipId_, noteId_);
+    if (!note) {
         return;
     }
 
-    clip->midiNotes[noteIndex_].lengthBeats = oldLengthBeats_;
+    MidiNote restored = *note;
+    restored.lengthBeats = oldLengthBeats_;
 
-    clipManager.forceNotifyClipPropertyChanged(clipId_);
+    ClipManager::getInstance().updateMidiNote(clipId_, restored);
 }
 
 bool ResizeMidiNoteCommand::canMergeWith(const UndoableCommand* other) const {
     auto* otherResize = dynamic_cast<const ResizeMidiNoteCommand*>(other);
-    return otherResize && otherResize->clipId_ == clipId_ && otherResize->noteIndex_ == noteIndex_;
+    return otherResize && otherResize->clipId_ == clipId_ && otherResize->noteId_ == noteId_;
 }
 
 void ResizeMidiNoteCommand::mergeWith(const UndoableCommand* other) {
@@ -166,66 +251,52 @@ void ResizeMidiNoteCommand::mergeWith(const UndoableCommand* other) {
 // DeleteMidiNoteCommand
 // ============================================================================
 
-DeleteMidiNoteCommand::DeleteMidiNoteCommand(ClipId clipId, size_t noteIndex)
-    : clipId_(clipId), noteIndex_(noteIndex) {
-    // Capture note data for undo
-    const auto* clip = ClipManager::getInstance().getClip(clipId_);
-    if (clip && noteIndex_ < clip->midiNotes.size()) {
-        deletedNote_ = clip->midiNotes[noteIndex_];
+DeleteMidiNoteCommand::DeleteMidiNoteCommand(ClipId clipId, MidiNoteId noteId)
+    : clipId_(clipId), noteId_(noteId) {
+    // Capture note data (including its id) for undo
+    if (const auto* note = findMidiNote(clipId_, noteId_)) {
+        deletedNote_ = *note;
     }
 }
 
 void DeleteMidiNoteCommand::execute() {
     auto& clipManager = ClipManager::getInstance();
-    clipManager.removeMidiNote(clipId_, static_cast<int>(noteIndex_));
+    clipManager.removeMidiNote(clipId_, noteId_);
     executed_ = true;
 }
 
 void DeleteMidiNoteCommand::undo() {
-    if (!executed_) {
-        return;
-    }
-
-    auto& clipManager = ClipManager::getInstance();
-    auto* clip = clipManager.getClip(clipId_);
-
-    if (!clip || clip->type != ClipType::MIDI) {
+    if (!executed_ || deletedNote_.id == INVALID_MIDI_NOTE_ID) {
         return;
     }
 
-    // Re-insert at original position (or at end if index is now out of range)
-    size_t insertPos = std::min(noteIndex_, clip->midiNotes.size());
-    clip->midiNotes.insert(clip->midiNotes.begin() + static_cast<std::ptrdiff_t>(insertPos),
-                           deletedNote_);
-
-    clipManager.forceNotifyClipPropertyChanged(clipId_);
+    // Re-adding with the original id lands it back in start order under the same identity
+    ClipManager::getInstance().addMidiNote(clipId_, deletedNote_);
 }
 
 // ============================================================================
 // SetMidiNoteVelocityCommand
 // ============================================================================
 
-SetMidiNoteVelocityCommand::SetMidiNoteVelocityCommand(ClipId clipId, size_t noteIndex,
+SetMidiNoteVelocityCommand::SetMidiNoteVelocityCommand(ClipId clipId, MidiNoteId noteId,
                                                        int newVelocity)
-    : clipId_(clipId), noteIndex_(noteIndex), newVelocity_(newVelocity) {
+    : clipId_(clipId), noteId_(noteId), newVelocity_(newVelocity) {
     // Capture old value
-    const auto* clip = ClipManager::getInstance().getClip(clipId_);
-    if (clip && noteIndex_ < clip->midiNotes.size()) {
-        oldVelocity_ = clip->midiNotes[noteIndex_].velocity;
+    if (const auto* note = findMidiNote(clipId_, noteId_)) {
+        oldVelocity_ = note->velocity;
     }
 }
 
 void SetMidiNoteVelocityCommand::execute() {
-    auto& clipManager = ClipManager::getInstance();
-    auto* clip = clipManager.getClip(clipId_);
-
-    if (!clip || clip->type != ClipType::MIDI || noteIndex_ >= clip->midiNotes.size()) {
+    const auto* note = findMidiNote(clipId_, noteId_);
+    if (!note) {
         return;
     }
 
-    clip->midiNotes[noteIndex_].velocity = newVelocity_;
+    MidiNote changed = *note;
+    changed.velocity = newVelocity_;
 
-    clipManager.forceNotifyClipPropertyChanged(clipId_);
+    ClipManager::getInstance().updateMidiNote(clipId_, changed);
     executed_ = true;
 }
 
@@ -234,22 +305,20 @@ void SetMidiNoteVelocityCommand::undo() {
         return;
     }
 
-    auto& clipManager = ClipManager::getInstance();
-    auto* clip = clipManager.getClip(clipId_);
-
-    if (!clip || clip->type != ClipType::MIDI || noteIndex_ >= clip->midiNotes.size()) {
+    const auto* note = findMidiNote(clipId_, noteId_);
+    if (!note) {
         return;
     }
 
-    clip->midiNotes[noteIndex_].velocity = oldVelocity_;
+    MidiNote restored = *note;
+    restored.velocity = oldVelocity_;
 
-    clipManager.forceNotifyClipPropertyChanged(clipId_);
+    ClipManager::getInstance().updateMidiNote(clipId_, restored);
 }
 
 bool SetMidiNoteVelocityCommand::canMergeWith(const UndoableCommand* other) const {
     auto* otherVelocity = dynamic_cast<const SetMidiNoteVelocityCommand*>(other);
-    return otherVelocity && otherVelocity->clipId_ == clipId_ &&
-           otherVelocity->noteIndex_ == noteIndex_;
+    return otherVelocity && otherVelocity->clipId_ == clipId_ && otherVelocity->noteId_ == noteId_;
 }
 
 void SetMidiNoteVelocityCommand::mergeWith(const UndoableCommand* other) {
@@ -259,4 +328,136 @@ void SetMidiNoteVelocityCommand::mergeWith(const UndoableCommand* other) {
     }
 }
 
+// ============================================================================
+// EditMidiNotesCommand
+// ============================================================================
+
+EditMidiNotesCommand::EditMidiNotesCommand(ClipId clipId, const std::vector<MidiNoteId>& noteIds,
+                                           const Transform& transform,
+                                           const juce::String& description)
+    : clipId_(clipId), description_(description) {
+    // Capture the delta now; the transform itself is not kept
+    for (MidiNoteId noteId : noteIds) {
+        const auto* note = findMidiNote(clipId_, noteId);
+        if (!note) {
+            continue;
+        }
+
+        MidiNote edited = *note;
+        transform(edited);
+        edited.id = note->id;
+        edited.noteNumber = juce::jlimit(0, 127, edited.noteNumber);
+        edited.velocity = juce::jlimit(1, 127, edited.velocity);
+        edited.startBeat = juce::jmax(0.0, edited.startBeat);
+
+        if (!sameNote(*note, edited)) {
+            before_.push_back(*note);
+            after_.push_back(edited);
+        }
+    }
+}
+
+void EditMidiNotesCommand::execute() {
+    if (after_.empty()) {
+        return;
+    }
+
+    ClipManager::getInstance().updateMidiNotes(clipId_, after_);
+    executed_ = true;
+}
+
+void EditMidiNotesCommand::undo() {
+    if (!executed_) {
+        return;
+    }
+
+    ClipManager::getInstance().updateMidiNotes(clipId_, before_);
+}
+
+bool EditMidiNotesCommand::canMergeWith(const UndoableCommand* other) const {
+    auto* otherEdit = dynamic_cast<const EditMidiNotesCommand*>(other);
+    return otherEdit && otherEdit->clipId_ == clipId_ && otherEdit->description_ == description_;
+}
+
+void EditMidiNotesCommand::mergeWith(const UndoableCommand* other) {
+    auto* otherEdit = dynamic_cast<const EditMidiNotesCommand*>(other);
+    if (!otherEdit) {
+        return;
+    }
+
+    // Keep our "before" for notes we already touched, take the other's for new ones
+    std::unordered_map<MidiNoteId, size_t> positions;
+    for (size_t i = 0; i < after_.size(); ++i) {
+        positions[after_[i].id] = i;
+    }
+    for (size_t i = 0; i < otherEdit->after_.size(); ++i) {
+        auto it = positions.find(otherEdit->after_[i].id);
+        if (it != positions.end()) {
+            after_[it->second] = otherEdit->after_[i];
+        } else {
+            before_.push_back(otherEdit->before_[i]);
+            after_.push_back(otherEdit->after_[i]);
+        }
+    }
+}
+
+bool EditMidiNotesCommand::spillState(juce::OutputStream& out) {
+    if (after_.empty()) {
+        return false;
+    }
+    writeNotes(out, before_);
+    writeNotes(out, after_);
+    return true;
+}
+
+void EditMidiNotesCommand::restoreState(juce::InputStream& in) {
+    before_ = readNotes(in);
+    after_ = readNotes(in);
+}
+
+// ============================================================================
+// DeleteMidiNotesCommand
+// ============================================================================
+
+DeleteMidiNotesCommand::DeleteMidiNotesCommand(ClipId clipId,
+                                               const std::vector<MidiNoteId>& noteIds)
+    : clipId_(clipId) {
+    // Capture note data (including ids) for undo
+    for (MidiNoteId noteId : noteIds) {
+        if (const auto* note = findMidiNote(clipId_, noteId)) {
+            deletedNotes_.push_back(*note);
+        }
+    }
+    numNotes_ = deletedNotes_.size();
+}
+
+void DeleteMidiNotesCommand::execute() {
+    if (deletedNotes_.empty()) {
+        return;
+    }
+
+    ClipManager::getInstance().removeMidiNotes(clipId_, idsOf(deletedNotes_));
+    executed_ = true;
+}
+
+void DeleteMidiNotesCommand::undo() {
+    if (!executed_) {
+        return;
+    }
+
+    ClipManager::getInstance().addMidiNotes(clipId_, deletedNotes_);
+}
+
+bool DeleteMidiNotesCommand::spillState(juce::OutputStream& out) {
+    if (deletedNotes_.empty()) {
+        return false;
+    }
+    writeNotes(out, deletedNotes_);
+    return true;
+}
+
+void DeleteMidiNotesCommand::restoreState(juce::InputStream& in) {
+    deletedNotes_ = readNotes(in);
+}
+
 }  // namespace magda
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <functional>
+#include <vector>
+
 #include "ClipInfo.hpp"
 #include "ClipManager.hpp"
 #include "UndoManager.hpp"
@@ -22,8 +25,37 @@ class AddMidiNoteCommand : public UndoableCommand {
 
   private:
     ClipId clipId_;
-    MidiNote note_;
-    size_t insertedIndex_ = 0;
+    MidiNote note_;  // Keeps its id after the first execute, so redo restores the same note
+    bool executed_ = false;
+};
+
+/**
+ * @brief Command for adding many MIDI notes to a clip with one change notification
+ */
+class AddMidiNotesCommand : public UndoableCommand {
+  public:
+    AddMidiNotesCommand(ClipId clipId, std::vector<MidiNote> notes);
+
+    void execute() override;
+    void undo() override;
+    juce::String getDescription() const override {
+        return numNotes_ == 1 ? "Add MIDI Note" : "Add MIDI Notes";
+    }
+    size_t getSizeInBytes() const override {
+        return sizeof(*this) + notes_.size() * sizeof(MidiNote);
+    }
+    bool spillState(juce::OutputStream& out) override;
+    void restoreState(juce::InputStream& in) override;
+
+    /**
+     * @brief Ids of the added notes, in the order given (empty until executed)
+     */
+    std::vector<MidiNoteId> getAddedNoteIds() const;
+
+  private:
+    ClipId clipId_;
+    std::vector<MidiNote> notes_;  // Keep their ids after the first execute, as above
+    size_t numNotes_;              // Also while notes_ is spilled
     bool executed_ = false;
 };
 
@@ -32,7 +64,7 @@ class AddMidiNoteCommand : public UndoableCommand {
  */
 class MoveMidiNoteCommand : public UndoableCommand {
   public:
-    MoveMidiNoteCommand(ClipId clipId, size_t noteIndex, double newStartBeat, int newNoteNumber);
+    MoveMidiNoteCommand(ClipId clipId, MidiNoteId noteId, double newStartBeat, int newNoteNumber);
 
     void execute() override;
     void undo() override;
@@ -45,10 +77,10 @@ class MoveMidiNoteCommand : public UndoableCommand {
 
   private:
     ClipId clipId_;
-    size_t noteIndex_;
-    double oldStartBeat_;
+    MidiNoteId noteId_;
+    double oldStartBeat_ = 0.0;
     double newStartBeat_;
-    int oldNoteNumber_;
+    int oldNoteNumber_ = 60;
     int newNoteNumber_;
     bool executed_ = false;
 };
@@ -58,7 +90,7 @@ class MoveMidiNoteCommand : public UndoableCommand {
  */
 class ResizeMidiNoteCommand : public UndoableCommand {
   public:
-    ResizeMidiNoteCommand(ClipId clipId, size_t noteIndex, double newLengthBeats);
+    ResizeMidiNoteCommand(ClipId clipId, MidiNoteId noteId, double newLengthBeats);
 
     void execute() override;
     void undo() override;
@@ -71,8 +103,8 @@ class ResizeMidiNoteCommand : public UndoableCommand {
 
   private:
     ClipId clipId_;
-    size_t noteIndex_;
-    double oldLengthBeats_;
+    MidiNoteId noteId_;
+    double oldLengthBeats_ = 1.0;
     double newLengthBeats_;
     bool executed_ = false;
 };
@@ -82,7 +114,7 @@ class ResizeMidiNoteCommand : public UndoableCommand {
  */
 class DeleteMidiNoteCommand : public UndoableCommand {
   public:
-    DeleteMidiNoteCommand(ClipId clipId, size_t noteIndex);
+    DeleteMidiNoteCommand(ClipId clipId, MidiNoteId noteId);
 
     void execute() override;
     void undo() override;
@@ -92,7 +124,7 @@ class DeleteMidiNoteCommand : public UndoableCommand {
 
   private:
     ClipId clipId_;
-    size_t noteIndex_;
+    MidiNoteId noteId_;
     MidiNote deletedNote_;
     bool executed_ = false;
 };
@@ -102,7 +134,7 @@ class DeleteMidiNoteCommand : public UndoableCommand {
  */
 class SetMidiNoteVelocityCommand : public UndoableCommand {
   public:
-    SetMidiNoteVelocityCommand(ClipId clipId, size_t noteIndex, int newVelocity);
+    SetMidiNoteVelocityCommand(ClipId clipId, MidiNoteId noteId, int newVelocity);
 
     void execute() override;
     void undo() override;
@@ -115,10 +147,79 @@ class SetMidiNoteVelocityCommand : public UndoableCommand {
 
   private:
     ClipId clipId_;
-    size_t noteIndex_;
-    int oldVelocity_;
+    MidiNoteId noteId_;
+    int oldVelocity_ = 100;
     int newVelocity_;
     bool executed_ = false;
 };
 
+/**
+ * @brief Command applying one edit to many notes of a clip (transpose, quantise, velocity)
+ *
+ * The transform runs once, at construction, and only the notes it actually changed are kept,
+ * before and after, as the undo delta. execute() and undo() each apply the whole batch through
+ * a single ClipManager::updateMidiNotes() call, so editing a thousand selected notes costs one
+ * change notification and one engine resync instead of one per note.
+ */
+class EditMidiNotesCommand : public UndoableCommand {
+  public:
+    using Transform = std::function<void(MidiNote&)>;
+
+    EditMidiNotesCommand(ClipId clipId, const std::vector<MidiNoteId>& noteIds,
+                         const Transform& transform, const juce::String& description);
+
+    void execute() override;
+    void undo() override;
+    juce::String getDescription() const override {
+        return description_;
+    }
+    size_t getSizeInBytes() const override {
+        return sizeof(*this) + (before_.size() + after_.size()) * sizeof(MidiNote);
+    }
+    bool spillState(juce::OutputStream& out) override;
+    void restoreState(juce::InputStream& in) override;
+
+    bool canMergeWith(const UndoableCommand* other) const override;
+    void mergeWith(const UndoableCommand* other) override;
+
+    /**
+     * @brief True if the transform changed no notes (nothing worth an undo step)
+     */
+    bool isEmpty() const {
+        return after_.empty();
+    }
+
+  private:
+    ClipId clipId_;
+    juce::String description_;
+    std::vector<MidiNote> before_;  // Changed notes only, parallel to after_
+    std::vector<MidiNote> after_;
+    bool executed_ = false;
+};
+
+/**
+ * @brief Command for deleting several MIDI notes as one step with one notification
+ */
+class DeleteMidiNotesCommand : public UndoableCommand {
+  public:
+    DeleteMidiNotesCommand(ClipId clipId, const std::vector<MidiNoteId>& noteIds);
+
+    void execute() override;
+    void undo() override;
+    juce::String getDescription() const override {
+        return numNotes_ == 1 ? "Delete MIDI Note" : "Delete MIDI Notes";
+    }
+    size_t getSizeInBytes() const override {
+        return sizeof(*this) + deletedNotes_.size() * sizeof(MidiNote);
+    }
+    bool spillState(juce::OutputStream& out) override;
+    void restoreState(juce::InputStream& in) override;
+
+  private:
+    ClipId clipId_;
+    std::vector<MidiNote> deletedNotes_;  // Keep their ids, so undo restores the same notes
+    size_t numNotes_ = 0;                 // Also while deletedNotes_ is spilled
+    bool executed_ = false;
+};
+
 }  // namespace magda
@@ -0,0 +1,332 @@
+#include "MidiNoteList.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_set>
+
+#include "../profiling/MemoryEstimates.hpp"
+
+namespace magda {
+
+namespace {
+
+bool startsBefore(const MidiNote& a, const MidiNote& b) {
+    if (a.startBeat != b.startBeat) {
+        return a.startBeat < b.startBeat;
+    }
+    return a.noteNumber < b.noteNumber;
+}
+
+}  // namespace
+
+// =============================================================================
+// Storage
+// =============================================================================
+
+MidiNoteList::MidiNoteList(const MidiNoteList& other) {
+    other.ensureIndex();
+    data_ = other.data_;
+}
+
+MidiNoteList& MidiNoteList::operator=(const MidiNoteList& other) {
+    other.ensureIndex();
+    data_ = other.data_;
+    return *this;
+}
+
+const MidiNoteList::Data& MidiNoteList::read() const {
+    static const Data empty;
+    return data_ != nullptr ? *data_ : empty;
+}
+
+MidiNoteList::Data& MidiNoteList::write() {
+    if (data_ == nullptr) {
+        data_ = std::make_shared<Data>();
+    } else if (data_.use_count() > 1) {
+        data_ = std::make_shared<Data>(*data_);
+    }
+    return *data_;
+}
+
+// =============================================================================
+// Edits
+// =============================================================================
+
+MidiNoteId MidiNoteList::add(MidiNote note) {
+    // Ids at or past nextId were never handed out; older ones may be in use
+    const bool idInUse = note.id != INVALID_MIDI_NOTE_ID && note.id < read().nextId &&
+                         find(note.id) != nullptr;
+    auto& data = write();
+    if (note.id == INVALID_MIDI_NOTE_ID || idInUse) {
+        note.id = data.nextId;
+    }
+    data.nextId = std::max(data.nextId, note.id + 1);
+
+    // Equal keys keep insertion order; appending in start order (an import) is O(1)
+    const auto position = static_cast<std::ptrdiff_t>(insertPosition(note));
+    data.notes.insert(data.notes.begin() + position, note);
+    data.indexDirty = true;
+    return note.id;
+}
+
+std::vector<MidiNoteId> MidiNoteList::add(const std::vector<MidiNote>& notes) {
+    std::vector<MidiNoteId> ids;
+    if (notes.empty()) {
+        return ids;
+    }
+
+    auto& data = write();
+    std::unordered_set<MidiNoteId> usedIds;
+    usedIds.reserve(data.notes.size() + notes.size());
+    for (const auto& note : data.notes) {
+        usedIds.insert(note.id);
+    }
+
+    data.notes.reserve(data.notes.size() + notes.size());
+    ids.reserve(notes.size());
+    for (MidiNote note : notes) {
+        if (note.id == INVALID_MIDI_NOTE_ID || usedIds.count(note.id) > 0) {
+            note.id = data.nextId;
+        }
+        data.nextId = std::max(data.nextId, note.id + 1);
+        usedIds.insert(note.id);
+        ids.push_back(note.id);
+        data.notes.push_back(note);
+    }
+
+    // An import arrives in order, after whatever the clip already had
+    if (!std::is_sorted(data.notes.begin(), data.notes.end(), startsBefore)) {
+        std::stable_sort(data.notes.begin(), data.notes.end(), startsBefore);
+    }
+    data.indexDirty = true;
+    return ids;
+}
+
+bool MidiNoteList::update(const MidiNote& note) {
+    const int index = indexOf(note.id);
+    if (index < 0) {
+        return false;
+    }
+
+    auto& data = write();
+    auto it = data.notes.begin() + index;
+    const bool keyChanged =
+        it->startBeat != note.startBeat || it->noteNumber != note.noteNumber;
+    if (!keyChanged) {
+        // Length and velocity don't affect the order, and positions stays valid
+        const double oldLength = it->lengthBeats;
+        *it = note;
+        if (note.lengthBeats != oldLength) {
+            data.indexDirty = true;
+        }
+        return true;
+    }
+
+    data.notes.erase(it);
+    const auto position = static_cast<std::ptrdiff_t>(insertPosition(note));
+    data.notes.insert(data.notes.begin() + position, note);
+    data.indexDirty = true;
+    return true;
+}
+
+size_t MidiNoteList::update(const std::vector<MidiNote>& notes) {
+    // Replace in place first; positions stays valid until the single re-sort below
+    size_t updated = 0;
+    bool keyChanged = false;
+    Data* data = nullptr;  // Written only once a note is found
+    for (const auto& note : notes) {
+        const int index = indexOf(note.id);
+        if (index < 0) {
+            continue;
+        }
+
+        if (data == nullptr) {
+            data = &write();
+        }
+        auto& existing = data->notes[static_cast<size_t>(index)];
+        keyChanged = keyChanged || existing.startBeat != note.startBeat ||
+                     existing.noteNumber != note.noteNumber;
+        existing = note;
+        ++updated;
+    }
+
+    if (updated == 0) {
+        return 0;
+    }
+    if (keyChanged) {
+        std::stable_sort(data->notes.begin(), data->notes.end(), startsBefore);
+    }
+    data->indexDirty = true;
+    return updated;
+}
+
+bool MidiNoteList::remove(MidiNoteId id) {
+    const int index = indexOf(id);
+    if (index < 0) {
+        return false;
+    }
+
+    auto& data = write();
+    data.notes.erase(data.notes.begin() + index);
+    data.indexDirty = true;
+    return true;
+}
+
+size_t MidiNoteList::remove(const std::vector<MidiNoteId>& ids) {
+    if (ids.empty() || empty()) {
+        return 0;
+    }
+
+    const std::unordered_set<MidiNoteId> removed(ids.begin(), ids.end());
+    auto isRemoved = [&removed](const MidiNote& note) { return removed.count(note.id) > 0; };
+    const auto& current = read().notes;
+    if (std::none_of(current.begin(), current.end(), isRemoved)) {
+        return 0;  // Leaves shared storage shared
+    }
+
+    auto& data = write();
+    const size_t before = data.notes.size();
+    data.notes.erase(std::remove_if(data.notes.begin(), data.notes.end(), isRemoved),
+                     data.notes.end());
+    data.indexDirty = true;
+    return before - data.notes.size();
+}
+
+void MidiNoteList::clear() {
+    if (data_ == nullptr) {
+        return;
+    }
+
+    // nextId carries on, so ids handed out before the clear aren't reused
+    const auto nextId = data_->nextId;
+    data_ = std::make_shared<Data>();
+    data_->nextId = nextId;
+}
+
+size_t MidiNoteList::getSizeInBytes() const {
+    const auto& data = read();
+    return memory::vectorBytes(data.notes) + memory::vectorBytes(data.positions) +
+           memory::vectorBytes(data.rows) + memory::vectorBytes(data.bucketStarts) +
+           memory::vectorBytes(data.bucketNotes);
+}
+
+// =============================================================================
+// Queries
+// =============================================================================
+
+const MidiNote* MidiNoteList::find(MidiNoteId id) const {
+    const int index = indexOf(id);
+    return index >= 0 ? &read().notes[static_cast<size_t>(index)] : nullptr;
+}
+
+int MidiNoteList::indexOf(MidiNoteId id) const {
+    ensureIndex();
+    const auto& positions = read().positions;
+    auto it = std::lower_bound(positions.begin(), positions.end(), id,
+                               [](const auto& entry, MidiNoteId key) { return entry.first < key; });
+    return it != positions.end() && it->first == id ? static_cast<int>(it->second) : -1;
+}
+
+void MidiNoteList::getNotesInRange(double startBeat, double endBeat, int lowNote, int highNote,
+                                   std::vector<size_t>& out) const {
+    ensureIndex();
+    const auto& data = read();
+    if (data.notes.empty() || endBeat <= startBeat) {
+        return;
+    }
+
+    lowNote = std::max(lowNote, 0);
+    highNote = std::min(highNote, NUM_PITCHES - 1);
+    const size_t firstResult = out.size();
+
+    for (int pitch = lowNote; pitch <= highNote; ++pitch) {
+        const auto& row = data.rows[static_cast<size_t>(pitch)];
+        if (row.numBuckets == 0) {
+            continue;
+        }
+
+        // A note starting up to maxLength before the range can still reach into it
+        const size_t first = bucketFor(startBeat - row.maxLength);
+        const size_t last = std::min(bucketFor(endBeat), row.numBuckets - 1);
+        if (first > last) {
+            continue;
+        }
+
+        const size_t begin = data.bucketStarts[row.firstBucket + first];
+        const size_t end = data.bucketStarts[row.firstBucket + last + 1];
+        // The row's buckets are adjacent, so first..last is one run of positions
+        for (size_t slot = begin; slot < end; ++slot) {
+            const size_t index = data.bucketNotes[slot];
+            const auto& note = data.notes[index];
+            if (note.startBeat < endBeat && note.startBeat + note.lengthBeats > startBeat) {
+                out.push_back(index);
+            }
+        }
+    }
+
+    // Rows were visited by pitch, so merge them back into start order
+    std::sort(out.begin() + static_cast<std::ptrdiff_t>(firstResult), out.end());
+}
+
+size_t MidiNoteList::insertPosition(const MidiNote& note) const {
+    const auto& notes = read().notes;
+    return static_cast<size_t>(
+        std::upper_bound(notes.begin(), notes.end(), note, startsBefore) - notes.begin());
+}
+
+void MidiNoteList::ensureIndex() const {
+    // Only storage edited since its last copy is dirty, and that storage isn't shared
+    if (data_ == nullptr || !data_->indexDirty) {
+        return;
+    }
+    auto& data = *data_;
+
+    const size_t count = data.notes.size();
+    data.positions.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        data.positions[i] = {data.notes[i].id, i};
+    }
+    std::sort(data.positions.begin(), data.positions.end());
+
+    // Size each row, then lay the rows' buckets end to end
+    auto rowOf = [&data](const MidiNote& note) -> PitchRow& {
+        return data.rows[static_cast<size_t>(std::clamp(note.noteNumber, 0, NUM_PITCHES - 1))];
+    };
+    data.rows.assign(static_cast<size_t>(NUM_PITCHES), PitchRow{});
+    for (const auto& note : data.notes) {
+        auto& row = rowOf(note);
+        row.numBuckets = std::max(row.numBuckets, bucketFor(note.startBeat) + 1);
+        row.maxLength = std::max(row.maxLength, note.lengthBeats);
+    }
+    size_t numBuckets = 0;
+    for (auto& row : data.rows) {
+        row.firstBucket = numBuckets;
+        numBuckets += row.numBuckets;
+    }
+
+    // Count each bucket's notes and turn the counts into end offsets; filling from the back
+    // then leaves each entry at its bucket's start and each bucket in start order
+    data.bucketStarts.assign(numBuckets + 1, 0);
+    for (const auto& note : data.notes) {
+        ++data.bucketStarts[rowOf(note).firstBucket + bucketFor(note.startBeat)];
+    }
+    size_t total = 0;
+    for (auto& start : data.bucketStarts) {
+        total += start;
+        start = total;
+    }
+    data.bucketNotes.resize(count);
+    for (size_t i = count; i-- > 0;) {
+        const auto& note = data.notes[i];
+        const size_t bucket = rowOf(note).firstBucket + bucketFor(note.startBeat);
+        data.bucketNotes[--data.bucketStarts[bucket]] = i;
+    }
+
+    data.indexDirty = false;
+}
+
+size_t MidiNoteList::bucketFor(double beat) {
+    return beat > 0.0 ? static_cast<size_t>(std::floor(beat / BUCKET_BEATS)) : 0;
+}
+
+}  // namespace magda
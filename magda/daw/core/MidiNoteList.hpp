@@ -0,0 +1,188 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "TypeIds.hpp"
+
+namespace magda {
+
+/**
+ * @brief MIDI note data for MIDI clips
+ */
+struct MidiNote {
+    MidiNoteId id = INVALID_MIDI_NOTE_ID;  // Assigned by MidiNoteList, stable within the clip
+    int noteNumber = 60;                   // MIDI note number (0-127)
+    int velocity = 100;                    // Note velocity (0-127)
+    double startBeat = 0.0;                // Start position in beats within clip
+    double lengthBeats = 1.0;              // Duration in beats
+};
+
+/**
+ * @brief A MIDI clip's notes, sorted by start, with stable ids and a range index
+ *
+ * Notes are kept sorted by (startBeat, noteNumber), so iteration is in playback order, and
+ * each note has an id that survives edits, deletes and reordering. Selections and undo
+ * commands hold ids; positions (operator[]) are only valid until the next edit.
+ *
+ * getNotesInRange() goes through a pitch x time bucket index (one row per pitch, one bucket
+ * per BUCKET_BEATS), so painting a visible window or resolving a marquee costs the notes in
+ * that window rather than every note in the clip. The id lookup and the buckets are rebuilt
+ * lazily on the first query after an edit, so bulk edits such as a MIDI import pay for one
+ * rebuild.
+ *
+ * Both indexes are flat: the id lookup is a sorted array, and the buckets of every pitch
+ * share one array of positions with an offset table into it, so a rebuild allocates a handful
+ * of blocks rather than one per note or per bucket.
+ *
+ * The notes and their indexes are shared copy-on-write: copying the list (duplicating a
+ * clip, the clipboard, an undo command's before-image, a snapshot) is a refcount increment,
+ * and the first edit through a copy whose storage is shared clones it. A copy builds the
+ * indexes first, so shared storage is never rebuilt by a query and a copy handed to another
+ * thread stays read-only.
+ */
+class MidiNoteList {
+  public:
+    using const_iterator = std::vector<MidiNote>::const_iterator;
+
+    MidiNoteList() = default;
+    MidiNoteList(const MidiNoteList& other);
+    MidiNoteList& operator=(const MidiNoteList& other);
+    MidiNoteList(MidiNoteList&&) noexcept = default;
+    MidiNoteList& operator=(MidiNoteList&&) noexcept = default;
+
+    size_t size() const {
+        return read().notes.size();
+    }
+    bool empty() const {
+        return read().notes.empty();
+    }
+    const MidiNote& operator[](size_t index) const {
+        return read().notes[index];
+    }
+    const_iterator begin() const {
+        return read().notes.begin();
+    }
+    const_iterator end() const {
+        return read().notes.end();
+    }
+
+    /**
+     * @brief All notes in start order
+     */
+    const std::vector<MidiNote>& getNotes() const {
+        return read().notes;
+    }
+
+    /**
+     * @brief Insert a note in start order
+     * @return The note's id - note.id if set and not in use (undo re-adding a deleted note),
+     *         otherwise a new one
+     */
+    MidiNoteId add(MidiNote note);
+
+    /**
+     * @brief Insert many notes with one re-sort (ids handled as in add())
+     * @return The notes' ids, in the order given
+     */
+    std::vector<MidiNoteId> add(const std::vector<MidiNote>& notes);
+    void push_back(const MidiNote& note) {
+        add(note);
+    }
+
+    /**
+     * @brief Replace the note with note.id, moving it if its start changed
+     * @return false if no note has that id
+     */
+    bool update(const MidiNote& note);
+
+    /**
+     * @brief Replace every note whose id matches, re-sorting once at the end
+     * @return How many notes were found and replaced
+     */
+    size_t update(const std::vector<MidiNote>& notes);
+
+    bool remove(MidiNoteId id);
+
+    /**
+     * @brief Remove every note in ids in a single pass
+     * @return How many notes were removed
+     */
+    size_t remove(const std::vector<MidiNoteId>& ids);
+    void clear();
+
+    /**
+     * @brief Look up a note by id (nullptr if absent); invalidated by the next edit
+     */
+    const MidiNote* find(MidiNoteId id) const;
+
+    /**
+     * @brief Current position of a note, or -1 if absent
+     */
+    int indexOf(MidiNoteId id) const;
+
+    /**
+     * @brief Notes overlapping [startBeat, endBeat) with lowNote <= noteNumber <= highNote
+     *
+     * Positions are appended to out in start order.
+     */
+    void getNotesInRange(double startBeat, double endBeat, int lowNote, int highNote,
+                         std::vector<size_t>& out) const;
+
+    /**
+     * @brief Build the id and range indexes now rather than on the next query
+     *
+     * A list that is then only read can be queried from several threads at once.
+     */
+    void prepareIndex() const {
+        ensureIndex();
+    }
+
+    /**
+     * @brief Approximate heap footprint: the notes plus the id and range indexes
+     *
+     * Storage shared with copies is counted by each of them.
+     */
+    size_t getSizeInBytes() const;
+
+    /**
+     * @brief True if both lists use the same storage (neither edited since one was copied)
+     */
+    bool sharesStorageWith(const MidiNoteList& other) const {
+        return data_ != nullptr && data_ == other.data_;
+    }
+
+    static constexpr double BUCKET_BEATS = 4.0;
+    static constexpr int NUM_PITCHES = 128;
+
+  private:
+    struct PitchRow {
+        size_t firstBucket = 0;  // This row's first slot in bucketStarts
+        size_t numBuckets = 0;   // Buckets up to the row's last note, by floor(start / bucket)
+        double maxLength = 0.0;  // How far back a note overlapping a bucket can start
+    };
+
+    struct Data {
+        std::vector<MidiNote> notes;
+        MidiNoteId nextId = 1;
+
+        // Derived from notes, rebuilt by ensureIndex() after edits
+        std::vector<std::pair<MidiNoteId, size_t>> positions;  // Sorted by id
+        std::vector<PitchRow> rows;
+        std::vector<size_t> bucketStarts;  // Where each bucket's positions begin, + end
+        std::vector<size_t> bucketNotes;   // Positions, bucket by bucket, in start order
+        bool indexDirty = false;
+    };
+
+    const Data& read() const;
+    Data& write();  // Clones shared storage first
+    size_t insertPosition(const MidiNote& note) const;
+    void ensureIndex() const;
+    static size_t bucketFor(double beat);
+
+    std::shared_ptr<Data> data_;  // Null while empty and never edited
+};
+
+}  // namespace magda
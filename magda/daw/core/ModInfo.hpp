@@ -77,8 +77,29 @@ struct CurvePointData {
 enum class LFOTriggerMode {
     Free,       // Continuous, never resets
     Transport,  // Reset on transport start/loop
-    MIDI,       // Reset on MIDI note-on (stubbed)
-    Audio       // Reset on audio transient (stubbed)
+    MIDI,       // Reset on a MIDI note-on matching midiChannel/midiNote
+    Audio       // Reset on an onset in the mod's audio source (see sidechainTrack)
+};
+
+/**
+ * @brief What a follower follows in its audio source
+ */
+enum class FollowerDetector {
+    Peak,  // Block peak: fast, tracks every hit
+    RMS    // Block RMS: smoother, closer to loudness
+};
+
+/**
+ * @brief How often a mod is evaluated
+ *
+ * A Control-rate mod advances every few milliseconds of audio rather than every block,
+ * catching up on the time in between, and is still evaluated on the block of any trigger.
+ * Parameters take a mod's value once per plugin block either way, so Block is the finest.
+ */
+enum class ModResolution {
+    Auto,     // Control for LFOs and random mods slow enough not to step audibly, else Block
+    Control,  // About every AudioModulator::kControlSeconds
+    Block     // Every audio block
 };
 
 /**
@@ -113,6 +134,11 @@ struct ModLink {
     }
 };
 
+/**
+ * @brief What a mod belongs to (device-level or rack-level mods)
+ */
+enum class ModOwner { Device, Rack };
+
 /**
  * @brief A modulator that can be linked to device parameters
  *
@@ -147,10 +173,26 @@ struct ModInfo {
     float loopStart = 0.0f;      // Loop region start phase (0-1)
     float loopEnd = 1.0f;        // Loop region end phase (0-1)
 
-    // Advanced receiver settings (for future MIDI/Audio trigger modes)
+    // Notes that retrigger envelopes and MIDI-triggered LFOs
     int midiChannel = 0;  // 0 = any, 1-16 = specific
     int midiNote = -1;    // -1 = any, 0-127 = specific
 
+    // Envelope stages in seconds (sustain is a level); the follower uses attack/release
+    float attack = 0.01f;
+    float decay = 0.2f;
+    float sustain = 0.7f;
+    float release = 0.3f;
+
+    // Random: steps at rate (or the sync division); 0 holds each step, 1 glides across it
+    float smoothing = 0.0f;
+
+    // Audio that drives followers and Audio triggers: the mod's track's recording input,
+    // or the output of a track (which may be the mod's own)
+    TrackId sidechainTrack = INVALID_TRACK_ID;  // INVALID_TRACK_ID = the track's input
+    FollowerDetector followerDetector = FollowerDetector::Peak;
+
+    ModResolution resolution = ModResolution::Auto;
+
     // Custom curve settings (when waveform == Custom)
     CurvePreset curvePreset = CurvePreset::Triangle;
     std::vector<CurvePointData> curvePoints;  // User-defined curve points
@@ -0,0 +1,33 @@
+#include "ModulationIndex.hpp"
+
+namespace magda {
+
+void ModulationIndex::clear() {
+    entries_.clear();
+}
+
+void ModulationIndex::addMod(TrackId trackId, ModOwner owner, int ownerId, int modIndex,
+                             const ModLink& link) {
+    if (!link.isValid()) {
+        return;
+    }
+    entries_[keyOf(link.target.deviceId, link.target.paramIndex)].mods.push_back(
+        {trackId, owner, ownerId, modIndex, link});
+}
+
+void ModulationIndex::addMacro(TrackId trackId, ModOwner owner, int ownerId, int macroIndex,
+                               const MacroLink& link) {
+    if (!link.target.isValid()) {
+        return;
+    }
+    entries_[keyOf(link.target.deviceId, link.target.paramIndex)].macros.push_back(
+        {trackId, owner, ownerId, macroIndex, link});
+}
+
+const ModulationSources& ModulationIndex::find(DeviceId deviceId, int paramIndex) const {
+    static const ModulationSources none;
+    const auto it = entries_.find(keyOf(deviceId, paramIndex));
+    return it != entries_.end() ? it->second : none;
+}
+
+}  // namespace magda
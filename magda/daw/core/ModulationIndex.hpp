@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "MacroInfo.hpp"
+#include "ModInfo.hpp"
+#include "TypeIds.hpp"
+
+namespace magda {
+
+/**
+ * @brief The mod and macro links that reach one parameter
+ *
+ * Each entry names its source (the track, owner and slot it lives in) and carries a copy
+ * of the link, so the amount and shape can be read without finding the link again.
+ */
+struct ModulationSources {
+    struct Mod {
+        TrackId trackId = INVALID_TRACK_ID;
+        ModOwner owner = ModOwner::Device;
+        int ownerId = -1;
+        int modIndex = -1;
+        ModLink link;
+    };
+
+    struct Macro {
+        TrackId trackId = INVALID_TRACK_ID;
+        ModOwner owner = ModOwner::Device;
+        int ownerId = -1;
+        int macroIndex = -1;
+        MacroLink link;
+    };
+
+    std::vector<Mod> mods;
+    std::vector<Macro> macros;
+
+    bool empty() const {
+        return mods.empty() && macros.empty();
+    }
+};
+
+/**
+ * @brief Reverse index from parameters to the mods and macros linked to them
+ *
+ * Links live on their sources, so asking what moves a parameter otherwise means walking
+ * every mod and macro in reach and searching their links. The index answers it with one
+ * hash lookup on (device, parameter). It is filled in one pass over the links; clear and
+ * refill it when links change.
+ */
+class ModulationIndex {
+  public:
+    void clear();
+
+    void addMod(TrackId trackId, ModOwner owner, int ownerId, int modIndex, const ModLink& link);
+    void addMacro(TrackId trackId, ModOwner owner, int ownerId, int macroIndex,
+                  const MacroLink& link);
+
+    /**
+     * @brief Sources linked to a parameter, in the order they were added
+     *
+     * Returns an empty set when nothing is linked. The reference is valid until the next
+     * change to the index.
+     */
+    const ModulationSources& find(DeviceId deviceId, int paramIndex) const;
+
+    size_t size() const {
+        return entries_.size();
+    }
+
+  private:
+    static uint64_t keyOf(DeviceId deviceId, int paramIndex) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(deviceId)) << 32) |
+               static_cast<uint32_t>(paramIndex);
+    }
+
+    std::unordered_map<uint64_t, ModulationSources> entries_;
+};
+
+}  // namespace magda
@@ -2,6 +2,11 @@
 
 #include <juce_events/juce_events.h>
 
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <functional>
 #include <memory>
 
 #include "ModInfo.hpp"
@@ -13,6 +18,9 @@ namespace magda {
  *
  * Singleton that runs at 60 FPS to update all LFO phase and output values.
  * Updates phase based on rate, then generates waveform output.
+ *
+ * When the audio engine evaluates modulation per block, it installs a value source and
+ * the timer only copies the audio-thread results back into ModInfo for display.
  */
 class ModulatorEngine {
   private:
@@ -72,6 +80,17 @@ class ModulatorEngine {
         timer_.reset();  // Destroy timer early, not during static cleanup
     }
 
+    /**
+     * @brief Install a source of audio-thread mod values
+     *
+     * While set, each timer tick calls the source instead of advancing mods itself. The
+     * source returns false if it has nothing to offer (e.g. no audio device running), in
+     * which case mods are advanced on the message thread as before.
+     */
+    void setValueSource(std::function<bool()> source) {
+        valueSource_ = std::move(source);
+    }
+
     /**
      * @brief Calculate LFO rate in Hz from tempo sync division
      * @param division The sync division (musical note value)
@@ -197,23 +216,34 @@ class ModulatorEngine {
      * @return Output value (0.0 to 1.0)
      */
     static float evaluateCurvePoints(const std::vector<CurvePointData>& points, float phase) {
-        if (points.empty()) {
+        return evaluateCurvePoints(points.data(), points.size(), phase);
+    }
+
+    /**
+     * @brief Evaluate curve points stored contiguously (e.g. in a compiled modulation plan)
+     */
+    static float evaluateCurvePoints(const CurvePointData* points, size_t numPoints,
+                                     float phase) {
+        if (numPoints == 0) {
             return 0.5f;  // Default to center
         }
-        if (points.size() == 1) {
+        if (numPoints == 1) {
             return points[0].value;
         }
 
+        const CurvePointData* first = points;
+        const CurvePointData* last = points + numPoints - 1;
+
         // Find bracketing points (curve loops, so we may wrap around)
         const CurvePointData* p1 = nullptr;
         const CurvePointData* p2 = nullptr;
 
-        for (size_t i = 0; i < points.size(); ++i) {
+        for (size_t i = 0; i < numPoints; ++i) {
             if (points[i].phase > phase) {
                 if (i == 0) {
                     // Before first point - wrap from last point
-                    p1 = &points.back();
-                    p2 = &points[0];
+                    p1 = last;
+                    p2 = first;
                 } else {
                     p1 = &points[i - 1];
                     p2 = &points[i];
@@ -224,8 +254,8 @@ class ModulatorEngine {
 
         // If we didn't find a bracket, we're after the last point - wrap to first
         if (!p1) {
-            p1 = &points.back();
-            p2 = &points.front();
+            p1 = last;
+            p2 = first;
         }
 
         // Calculate interpolation t value
@@ -282,11 +312,379 @@ class ModulatorEngine {
         return generateWaveform(mod.waveform, phase);
     }
 
+    // =========================================================================
+    // Curve tables
+    // =========================================================================
+
+    /**
+     * @brief Resolution of baked Custom curves (a table holds kCurveTableSize + 1 values)
+     */
+    static constexpr int kCurveTableSize = 256;
+
+    /**
+     * @brief Bake a mod's Custom curve (points, or the preset if it has none) into a table
+     * @param table Destination for kCurveTableSize + 1 values; entry k is phase k / size
+     *
+     * Bake once when the curve changes, then evaluate with lookupCurveTable() instead of
+     * scanning points and calling std::pow per sample.
+     */
+    static void bakeCurveTable(const ModInfo& mod, float* table) {
+        for (int k = 0; k <= kCurveTableSize; ++k) {
+            const float phase = static_cast<float>(k) / kCurveTableSize;
+            table[k] = mod.curvePoints.empty()
+                           ? generateCurvePreset(mod.curvePreset, phase)
+                           : evaluateCurvePoints(mod.curvePoints, phase);
+        }
+    }
+
+    /**
+     * @brief Evaluate a baked curve table at phase (0.0 to 1.0), O(1) and branch-free
+     */
+    static float lookupCurveTable(const float* table, float phase) {
+        const float position = phase * kCurveTableSize;
+        const int index = std::clamp(static_cast<int>(position), 0, kCurveTableSize - 1);
+        const float frac = position - static_cast<float>(index);
+        return table[index] + frac * (table[index + 1] - table[index]);
+    }
+
+    // =========================================================================
+    // Batch evaluation
+    // =========================================================================
+
+    /**
+     * @brief Largest difference between the batch functions and their scalar versions
+     *
+     * The batch path uses polynomial sine/exp/log approximations; outputs (0.0 to 1.0) stay
+     * within this bound of generateWaveform()/generateCurvePreset().
+     */
+    static constexpr float kBatchMaxError = 1.0e-4f;
+
+    /**
+     * @brief Evaluate one waveform per lane (N mods, one sample each)
+     * @param waveforms Waveform id per lane (Custom evaluates as triangle, as in
+     *                  generateWaveform - handle curve-based lanes separately)
+     * @param phases Phase per lane (0.0 to 1.0)
+     * @param out Output per lane (0.0 to 1.0)
+     *
+     * Branch-free selects over plain arrays, so the loop auto-vectorises (SSE/NEON).
+     */
+    static void generateWaveformBatch(const LFOWaveform* waveforms, const float* phases,
+                                      float* out, int count) {
+        for (int i = 0; i < count; ++i) {
+            out[i] = selectWaveform(waveforms[i], phases[i]);
+        }
+    }
+
+    /**
+     * @brief Evaluate one waveform over many phases (one mod, M samples)
+     */
+    static void generateWaveformBatch(LFOWaveform waveform, const float* phases, float* out,
+                                      int count) {
+        for (int i = 0; i < count; ++i) {
+            out[i] = selectWaveform(waveform, phases[i]);
+        }
+    }
+
+    /**
+     * @brief Evaluate one curve preset over many phases (one mod, M samples)
+     */
+    static void generateCurvePresetBatch(CurvePreset preset, const float* phases, float* out,
+                                         int count) {
+        // e^3 - 1 and e - 1, the normalisers used by generateCurvePreset
+        constexpr float EXP3_MINUS_1 = 19.0855369232f;
+        constexpr float E_MINUS_1 = 1.71828182846f;
+
+        switch (preset) {
+            case CurvePreset::Triangle:
+                generateWaveformBatch(LFOWaveform::Triangle, phases, out, count);
+                break;
+            case CurvePreset::Sine:
+                generateWaveformBatch(LFOWaveform::Sine, phases, out, count);
+                break;
+            case CurvePreset::RampDown:
+                generateWaveformBatch(LFOWaveform::ReverseSaw, phases, out, count);
+                break;
+            case CurvePreset::SCurve:
+                for (int i = 0; i < count; ++i) {
+                    const float t = phases[i];
+                    out[i] = t * t * (3.0f - 2.0f * t);
+                }
+                break;
+            case CurvePreset::Exponential:
+                for (int i = 0; i < count; ++i) {
+                    out[i] = (fastExp(phases[i] * 3.0f) - 1.0f) / EXP3_MINUS_1;
+                }
+                break;
+            case CurvePreset::Logarithmic:
+                for (int i = 0; i < count; ++i) {
+                    out[i] = fastLog(1.0f + phases[i] * E_MINUS_1);
+                }
+                break;
+            case CurvePreset::RampUp:
+            case CurvePreset::Custom:
+            default:
+                generateWaveformBatch(LFOWaveform::Saw, phases, out, count);
+                break;
+        }
+    }
+
+    /**
+     * @brief (sin(2 * pi * phase) + 1) / 2 for phase in 0..1, error < 5e-6
+     */
+    static float fastSine01(float phase) {
+        // sin(2*pi*p) = -sin(2*pi*t) with t = p - 0.5; fold t into [-0.25, 0.25] so the
+        // polynomial only has to cover [-pi/2, pi/2]
+        float t = phase - 0.5f;
+        t = std::min(t, 0.5f - t);   // (0.25, 0.5]   -> [0, 0.25)
+        t = std::max(t, -0.5f - t);  // [-0.5, -0.25) -> (-0.25, 0]
+        const float x = t * 6.28318530718f;
+        const float x2 = x * x;
+        const float sine =
+            x * (1.0f + x2 * (-1.0f / 6.0f +
+                              x2 * (1.0f / 120.0f +
+                                    x2 * (-1.0f / 5040.0f + x2 * (1.0f / 362880.0f)))));
+        return (1.0f - sine) * 0.5f;
+    }
+
+    /**
+     * @brief e^x for x in 0..3, relative error < 5e-5
+     */
+    static float fastExp(float x) {
+        // exp(x) = exp(x/8)^8, with a 5th order Taylor series on [0, 0.375]
+        const float y = x * 0.125f;
+        float e = 1.0f + y * (1.0f + y * (0.5f + y * (1.0f / 6.0f +
+                                                      y * (1.0f / 24.0f + y * (1.0f / 120.0f)))));
+        e *= e;
+        e *= e;
+        return e * e;
+    }
+
+    /**
+     * @brief ln(y) for y in 1..e, error < 5e-5
+     */
+    static float fastLog(float y) {
+        // ln(y) = 2 * atanh(s) with s = (y - 1) / (y + 1), s in [0, 0.47]
+        const float s = (y - 1.0f) / (y + 1.0f);
+        const float s2 = s * s;
+        return 2.0f * s *
+               (1.0f +
+                s2 * (1.0f / 3.0f + s2 * (1.0f / 5.0f + s2 * (1.0f / 7.0f + s2 * (1.0f / 9.0f)))));
+    }
+
+    /**
+     * @brief Advance an LFO by deltaTime and return its output
+     *
+     * Shared by the message-thread fallback and the audio-thread modulator so both
+     * follow the same trigger, tempo sync and phase rules. Allocation-free.
+     *
+     * @param mod LFO settings (rate, sync, trigger mode, waveform)
+     * @param phase Phase to advance, wraps at 1.0
+     * @param triggered Set to true if the phase was reset this step
+     * @return Output value (0.0 to 1.0)
+     */
+    static float advanceLFO(const ModInfo& mod, float& phase, bool& triggered,
+                            double deltaTime, double bpm, bool transportJustStarted,
+                            bool transportJustLooped) {
+        triggered = shouldTrigger(mod.triggerMode, transportJustStarted, transportJustLooped);
+        if (triggered) {
+            phase = 0.0f;  // Reset to start
+        }
+
+        // Calculate effective rate (Hz or tempo-synced)
+        float effectiveRate = mod.rate;
+        if (mod.tempoSync) {
+            effectiveRate = calculateSyncRateHz(mod.syncDivision, bpm);
+        }
+
+        phase = advancePhase(phase, effectiveRate, deltaTime);
+        // Apply phase offset when generating waveform
+        float effectivePhase = std::fmod(phase + mod.phaseOffset, 1.0f);
+        return generateWaveformForMod(mod, effectivePhase);
+    }
+
+    /**
+     * @brief Whether an LFO with this trigger mode resets its phase this step
+     * @param noteStarted A note matching the mod's MIDI filter started (audio thread only)
+     * @param onset The mod's audio source had an onset (audio thread only)
+     */
+    static bool shouldTrigger(LFOTriggerMode mode, bool transportJustStarted,
+                              bool transportJustLooped, bool noteStarted = false,
+                              bool onset = false) {
+        switch (mode) {
+            case LFOTriggerMode::Free:
+                // Never reset
+                return false;
+            case LFOTriggerMode::Transport:
+                // Reset on transport start or loop
+                return transportJustStarted || transportJustLooped;
+            case LFOTriggerMode::MIDI:
+                return noteStarted;
+            case LFOTriggerMode::Audio:
+                return onset;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Advance a phase by rateHz * deltaTime, wrapping at 1.0
+     */
+    static float advancePhase(float phase, float rateHz, double deltaTime) {
+        phase += static_cast<float>(rateHz * deltaTime);
+        while (phase >= 1.0f) {
+            phase -= 1.0f;
+        }
+        return phase;
+    }
+
+    // =========================================================================
+    // Envelope, Random and Follower
+    // =========================================================================
+
+    enum class EnvelopeStage : uint8_t { Idle, Attack, Decay, Sustain, Release };
+
+    /**
+     * @brief Advance a linear ADSR envelope by deltaTime and return its level
+     *
+     * A trigger restarts the attack from the current level, so retriggering never clicks
+     * back to zero. Releasing the gate moves any stage but Idle to Release. Stages shorter
+     * than the step are passed through within it.
+     *
+     * @param trigger A note started this step
+     * @param gate A note is held
+     * @param attack, decay, release Stage times in seconds (0 jumps straight through)
+     * @param sustain Level held while the gate is (0.0 to 1.0)
+     */
+    static float advanceEnvelope(EnvelopeStage& stage, float& level, bool trigger, bool gate,
+                                 float attack, float decay, float sustain, float release,
+                                 double deltaTime) {
+        sustain = std::clamp(sustain, 0.0f, 1.0f);
+        if (trigger) {
+            stage = EnvelopeStage::Attack;
+        } else if (!gate && stage != EnvelopeStage::Idle) {
+            stage = EnvelopeStage::Release;
+        }
+
+        auto remaining = static_cast<float>(deltaTime);
+        while (remaining > 0.0f) {
+            switch (stage) {
+                case EnvelopeStage::Idle:
+                    level = 0.0f;
+                    return level;
+                case EnvelopeStage::Attack: {
+                    const float needed = (1.0f - level) * attack;
+                    if (attack > 0.0f && needed > remaining) {
+                        level += remaining / attack;
+                        return level;
+                    }
+                    remaining -= std::max(0.0f, needed);
+                    level = 1.0f;
+                    stage = EnvelopeStage::Decay;
+                    break;
+                }
+                case EnvelopeStage::Decay: {
+                    // Full scale to sustain takes the decay time
+                    const float rate = decay > 0.0f ? (1.0f - sustain) / decay : 0.0f;
+                    const float needed = rate > 0.0f ? (level - sustain) / rate : 0.0f;
+                    if (needed > remaining) {
+                        level -= rate * remaining;
+                        return level;
+                    }
+                    remaining -= std::max(0.0f, needed);
+                    level = sustain;
+                    stage = EnvelopeStage::Sustain;
+                    break;
+                }
+                case EnvelopeStage::Sustain:
+                    level = sustain;
+                    return level;
+                case EnvelopeStage::Release: {
+                    // Full scale to zero takes the release time
+                    const float needed = level * release;
+                    if (release > 0.0f && needed > remaining) {
+                        level -= remaining / release;
+                        return level;
+                    }
+                    level = 0.0f;
+                    stage = EnvelopeStage::Idle;
+                    return level;
+                }
+            }
+        }
+        return level;
+    }
+
+    /**
+     * @brief Move a follower's level towards peak with separate attack and release times
+     * @param attack, release Time constants in seconds (0 follows immediately)
+     */
+    static float followLevel(float level, float peak, float attack, float release,
+                             double deltaTime) {
+        const float time = peak > level ? attack : release;
+        if (time <= 0.0f) {
+            return peak;
+        }
+        const auto coefficient =
+            1.0f - static_cast<float>(std::exp(-deltaTime / static_cast<double>(time)));
+        return level + (peak - level) * coefficient;
+    }
+
+    /**
+     * @brief Next value of a xorshift generator, as 0.0 to 1.0 (allocation- and lock-free)
+     * @param state Generator state; must not be 0
+     */
+    static float nextRandom(uint32_t& state) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return static_cast<float>(state >> 8) / static_cast<float>(1u << 24);
+    }
+
+    /**
+     * @brief Output of a smoothed sample-and-hold step
+     * @param from Output when the step began
+     * @param to The step's random value
+     * @param phase Position in the step (0.0 to 1.0)
+     * @param smoothing Fraction of the step spent gliding from `from` to `to`
+     */
+    static float smoothRandom(float from, float to, float phase, float smoothing) {
+        if (smoothing <= 0.0f || phase >= smoothing) {
+            return to;
+        }
+        const float t = phase / smoothing;
+        return from + (to - from) * t * t * (3.0f - 2.0f * t);
+    }
+
   private:
     ModulatorEngine() = default;
 
+    // Per-lane waveform for the batch loops. Every shape is computed up front and the
+    // result picked with integer bit masks: a plain ?: select lets the compiler sink the
+    // float maths into branches, which (with strict FP semantics) stops vectorisation.
+    static float selectWaveform(LFOWaveform waveform, float phase) {
+        const float sine = fastSine01(phase);
+        const float triangle = 1.0f - std::abs(2.0f * phase - 1.0f);
+        const float square = phase < 0.5f ? 1.0f : 0.0f;
+        const float reverseSaw = 1.0f - phase;
+
+        const auto id = static_cast<uint32_t>(waveform);
+        auto pick = [id](LFOWaveform shape, float value) {
+            const uint32_t mask = 0u - static_cast<uint32_t>(id == static_cast<uint32_t>(shape));
+            return std::bit_cast<uint32_t>(value) & mask;
+        };
+
+        return std::bit_cast<float>(
+            pick(LFOWaveform::Sine, sine) | pick(LFOWaveform::Triangle, triangle) |
+            pick(LFOWaveform::Square, square) | pick(LFOWaveform::Saw, phase) |
+            pick(LFOWaveform::ReverseSaw, reverseSaw) | pick(LFOWaveform::Custom, triangle));
+    }
+
     // Timer callback handler
     void onTimerCallback() {
+        // Audio thread is driving modulation - just pull its values for display
+        if (valueSource_ && valueSource_()) {
+            return;
+        }
+
         // Calculate delta time (approximately 1/60 second at 60 FPS)
         double deltaTime = timer_ ? timer_->getTimerInterval() / 1000.0 : 0.0;
 
@@ -298,6 +696,9 @@ class ModulatorEngine {
 
     // Timer instance - using composition instead of inheritance to allow early destruction
     std::unique_ptr<UpdateTimer> timer_;
+
+    // Audio-thread value read-back (see setValueSource)
+    std::function<bool()> valueSource_;
 };
 
 }  // namespace magda
@@ -0,0 +1,225 @@
+#include "ParameterConversion.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace magda {
+
+namespace {
+
+// Fader-style dB scale: 0.75 = 0dB (unity)
+constexpr float kUnityPos = 0.75f;
+constexpr float kUnityDb = 0.0f;
+
+float clampUnit(float value) {
+    return std::clamp(value, 0.0f, 1.0f);
+}
+
+// One conversion over an array, with the scale already chosen so the loop body is branch-light
+template <typename Fn> void convertEach(const float* in, float* out, int numValues, Fn fn) {
+    for (int i = 0; i < numValues; ++i) {
+        out[i] = fn(in[i]);
+    }
+}
+
+}  // namespace
+
+ParameterConversion::ParameterConversion(const ParameterInfo& info)
+    : scale_(info.scale),
+      minValue_(info.minValue),
+      maxValue_(info.maxValue),
+      range_(info.maxValue - info.minValue),
+      skew_(info.skewFactor),
+      lastChoice_(static_cast<float>(info.choices.size()) - 1.0f) {
+    switch (info.scale) {
+        case ParameterScale::Logarithmic:
+            // A zero or negative minimum has no log scale: treat it as linear
+            if (minValue_ > 0.0f) {
+                curve_ = Curve::Logarithmic;
+                logRatio_ = std::log(maxValue_ / minValue_);
+            }
+            break;
+        case ParameterScale::Exponential:
+            curve_ = Curve::Exponential;
+            break;
+        case ParameterScale::Discrete:
+            curve_ = Curve::Discrete;
+            break;
+        case ParameterScale::Boolean:
+            curve_ = Curve::Boolean;
+            break;
+        case ParameterScale::FaderDB:
+            curve_ = Curve::FaderDB;
+            break;
+        default:
+            break;
+    }
+}
+
+// =============================================================================
+// Normalised -> real
+// =============================================================================
+
+float ParameterConversion::curveToReal(float normalized) const {
+    switch (curve_) {
+        case Curve::Logarithmic:
+            // min * (max/min)^normalized
+            return minValue_ * std::exp(normalized * logRatio_);
+
+        case Curve::Exponential:
+            return std::pow(normalized, skew_) * range_ + minValue_;
+
+        case Curve::Discrete:
+            return lastChoice_ < 0.0f ? 0.0f : std::round(normalized * lastChoice_);
+
+        case Curve::Boolean:
+            return normalized >= 0.5f ? 1.0f : 0.0f;
+
+        case Curve::FaderDB:
+            if (normalized <= 0.0f)
+                return minValue_;
+            if (normalized >= 1.0f)
+                return maxValue_;
+            if (normalized < kUnityPos) {
+                // Below unity: 0..0.75 maps to minValue..0dB
+                return minValue_ + (normalized / kUnityPos) * (kUnityDb - minValue_);
+            }
+            // Above unity: 0.75..1.0 maps to 0dB..maxValue
+            return kUnityDb + ((normalized - kUnityPos) / (1.0f - kUnityPos)) *
+                                  (maxValue_ - kUnityDb);
+
+        case Curve::Linear:
+        default:
+            return minValue_ + normalized * range_;
+    }
+}
+
+float ParameterConversion::tableToReal(float normalized) const {
+    const float position = normalized * tableScale_;
+    const auto last = static_cast<int>(table_.size()) - 2;
+    const int index = std::min(static_cast<int>(position), last);
+    const float fraction = position - static_cast<float>(index);
+    const float a = table_[static_cast<size_t>(index)];
+    const float b = table_[static_cast<size_t>(index) + 1];
+    return a + fraction * (b - a);
+}
+
+float ParameterConversion::toReal(float normalized) const {
+    normalized = clampUnit(normalized);
+    return hasTable() ? tableToReal(normalized) : curveToReal(normalized);
+}
+
+void ParameterConversion::toReal(const float* normalized, float* real, int numValues) const {
+    if (hasTable()) {
+        convertEach(normalized, real, numValues,
+                    [this](float value) { return tableToReal(clampUnit(value)); });
+        return;
+    }
+
+    const float minValue = minValue_;
+    const float range = range_;
+    switch (curve_) {
+        case Curve::Linear:
+            convertEach(normalized, real, numValues, [minValue, range](float value) {
+                return minValue + clampUnit(value) * range;
+            });
+            break;
+
+        case Curve::Logarithmic: {
+            const float logRatio = logRatio_;
+            convertEach(normalized, real, numValues, [minValue, logRatio](float value) {
+                return minValue * std::exp(clampUnit(value) * logRatio);
+            });
+            break;
+        }
+
+        case Curve::Exponential: {
+            const float skew = skew_;
+            convertEach(normalized, real, numValues, [minValue, range, skew](float value) {
+                return std::pow(clampUnit(value), skew) * range + minValue;
+            });
+            break;
+        }
+
+        default:
+            convertEach(normalized, real, numValues,
+                        [this](float value) { return curveToReal(clampUnit(value)); });
+            break;
+    }
+}
+
+void ParameterConversion::buildTable(int size) {
+    table_.clear();
+    tableScale_ = 0.0f;
+    if (size < 1 || (curve_ != Curve::Logarithmic && curve_ != Curve::Exponential)) {
+        return;
+    }
+
+    table_.resize(static_cast<size_t>(size) + 1);
+    for (int i = 0; i <= size; ++i) {
+        table_[static_cast<size_t>(i)] =
+            curveToReal(static_cast<float>(i) / static_cast<float>(size));
+    }
+    tableScale_ = static_cast<float>(size);
+}
+
+// =============================================================================
+// Real -> normalised
+// =============================================================================
+
+float ParameterConversion::toNormalized(float real) const {
+    switch (curve_) {
+        case Curve::Logarithmic:
+            if (real <= 0.0f) {
+                return range_ == 0.0f ? 0.0f : clampUnit((real - minValue_) / range_);
+            }
+            // Inverse of exponential: log(real/min) / log(max/min)
+            return logRatio_ == 0.0f ? 0.0f : clampUnit(std::log(real / minValue_) / logRatio_);
+
+        case Curve::Exponential:
+            if (range_ == 0.0f || skew_ == 0.0f)
+                return 0.0f;
+            return clampUnit(std::pow((real - minValue_) / range_, 1.0f / skew_));
+
+        case Curve::Discrete: {
+            if (lastChoice_ <= 0.0f)
+                return 0.0f;
+            const float index = std::clamp(std::round(real), 0.0f, lastChoice_);
+            return index / lastChoice_;
+        }
+
+        case Curve::Boolean:
+            return real >= 0.5f ? 1.0f : 0.0f;
+
+        case Curve::FaderDB:
+            if (real <= minValue_)
+                return 0.0f;
+            if (real >= maxValue_)
+                return 1.0f;
+            if (real < kUnityDb) {
+                // Below unity: minValue..0dB maps to 0..0.75
+                return kUnityPos * (real - minValue_) / (kUnityDb - minValue_);
+            }
+            // Above unity: 0dB..maxValue maps to 0.75..1.0
+            return kUnityPos + (1.0f - kUnityPos) * (real - kUnityDb) / (maxValue_ - kUnityDb);
+
+        case Curve::Linear:
+        default:
+            return range_ == 0.0f ? 0.0f : clampUnit((real - minValue_) / range_);
+    }
+}
+
+void ParameterConversion::toNormalized(const float* real, float* normalized,
+                                       int numValues) const {
+    if (curve_ == Curve::Linear && range_ != 0.0f) {
+        const float minValue = minValue_;
+        const float range = range_;
+        convertEach(real, normalized, numValues, [minValue, range](float value) {
+            return clampUnit((value - minValue) / range);
+        });
+        return;
+    }
+    convertEach(real, normalized, numValues, [this](float value) { return toNormalized(value); });
+}
+
+}  // namespace magda
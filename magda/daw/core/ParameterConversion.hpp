@@ -0,0 +1,75 @@
+#pragma once
+
+#include <vector>
+
+#include "ParameterInfo.hpp"
+
+namespace magda {
+
+/**
+ * @brief A parameter's normalised <-> real conversion, compiled from its ParameterInfo
+ *
+ * Everything the conversion needs is worked out once: the range, the log ratio of a
+ * logarithmic scale, the reciprocal of a skew, the last choice index. Converting a value is
+ * then a few multiplies plus at most one exp, log or pow, and the array forms hoist the
+ * scale out of the loop so whole buffers (automation blocks, curve displays) convert in one
+ * tight pass the compiler can vectorise.
+ *
+ * buildTable() adds an optional lookup table for the normalised -> real direction of
+ * logarithmic and exponential scales, read with linear interpolation: no transcendental
+ * call per value, a few parts per million from exact. Other scales have nothing to gain
+ * and ignore it.
+ *
+ * Results match ParameterUtils::normalizedToReal()/realToNormalized(), which use it.
+ * Plain values with no strings, so it can be copied into realtime plans.
+ */
+class ParameterConversion {
+  public:
+    static constexpr int kDefaultTableSize = 1024;
+
+    ParameterConversion() = default;
+    explicit ParameterConversion(const ParameterInfo& info);
+
+    float toReal(float normalized) const;
+    float toNormalized(float real) const;
+
+    /**
+     * @brief Convert numValues values; in and out may be the same array
+     */
+    void toReal(const float* normalized, float* real, int numValues) const;
+    void toNormalized(const float* real, float* normalized, int numValues) const;
+
+    /**
+     * @brief Tabulate normalised -> real in size steps (no-op for scales without a curve)
+     */
+    void buildTable(int size = kDefaultTableSize);
+
+    bool hasTable() const {
+        return !table_.empty();
+    }
+
+    ParameterScale getScale() const {
+        return scale_;
+    }
+
+  private:
+    // Scales as converted: logarithmic with a non-positive minimum falls back to linear
+    enum class Curve { Linear, Logarithmic, Exponential, Discrete, Boolean, FaderDB };
+
+    float curveToReal(float normalized) const;
+    float tableToReal(float normalized) const;
+
+    ParameterScale scale_ = ParameterScale::Linear;
+    Curve curve_ = Curve::Linear;
+    float minValue_ = 0.0f;
+    float maxValue_ = 1.0f;
+    float range_ = 1.0f;
+    float logRatio_ = 0.0f;  // ln(max / min)
+    float skew_ = 1.0f;
+    float lastChoice_ = -1.0f;  // choices.size() - 1, or -1 with no choices
+
+    std::vector<float> table_;  // Real values at size + 1 even steps, empty when not built
+    float tableScale_ = 0.0f;   // The table size, as a float
+};
+
+}  // namespace magda
@@ -0,0 +1,66 @@
+#include "ParameterList.hpp"
+
+#include <utility>
+
+namespace magda {
+
+ParameterList::ParameterList(std::shared_ptr<const Metadata> metadata, std::vector<float> values)
+    : metadata_(std::move(metadata)), values_(std::move(values)) {
+    values_.resize(metadata_ != nullptr ? metadata_->size() : 0, 0.0f);
+}
+
+void ParameterList::clear() {
+    metadata_.reset();
+    values_.clear();
+    entries_.clear();
+}
+
+void ParameterList::push_back(ParameterInfo info) {
+    const size_t index = values_.size();
+    values_.push_back(info.currentValue);
+    entries_.insert_or_assign(index, std::move(info));
+}
+
+float ParameterList::getValue(size_t index) const {
+    auto it = entries_.find(index);
+    return it != entries_.end() ? it->second.currentValue : values_[index];
+}
+
+void ParameterList::setValue(size_t index, float value) {
+    values_[index] = value;
+    auto it = entries_.find(index);
+    if (it != entries_.end()) {
+        it->second.currentValue = value;
+    }
+}
+
+ParameterInfo ParameterList::unmaterialised(size_t index) const {
+    ParameterInfo info;
+    if (metadata_ != nullptr && index < metadata_->size()) {
+        info = (*metadata_)[index];
+    }
+    info.paramIndex = static_cast<int>(index);
+    info.currentValue = values_[index];
+    return info;
+}
+
+ParameterInfo ParameterList::operator[](size_t index) const {
+    auto it = entries_.find(index);
+    return it != entries_.end() ? it->second : unmaterialised(index);
+}
+
+ParameterInfo& ParameterList::operator[](size_t index) {
+    auto it = entries_.find(index);
+    if (it == entries_.end()) {
+        it = entries_.emplace(index, unmaterialised(index)).first;
+    }
+    return it->second;
+}
+
+size_t ParameterList::estimateHeapBytes() const {
+    // A map node is about the entry plus three pointers and a colour
+    return values_.capacity() * sizeof(float) +
+           entries_.size() * (sizeof(std::pair<const size_t, ParameterInfo>) + 4 * sizeof(void*));
+}
+
+}  // namespace magda
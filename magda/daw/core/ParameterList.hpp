@@ -0,0 +1,128 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "ParameterInfo.hpp"
+
+namespace magda {
+
+/**
+ * @brief A device's parameters, holding full ParameterInfo only where it's been looked at
+ *
+ * A plugin's names, ranges and labels are the same for every instance of it, so a device
+ * keeps its own current values (a float per parameter) and shares the metadata of its
+ * plugin type (see PluginParameterCache). A parameter is materialised - copied into an
+ * entry of its own - the first time it's accessed mutably, which is what the visible page,
+ * and linked or automated parameters, do; the rest stay a value.
+ *
+ * The interface follows std::vector so DeviceInfo::parameters reads as it always did, with
+ * one difference: const access returns a copy, so reading never materialises and a list
+ * shared with another thread (a save, a snapshot) is never written by a read. Lists built
+ * with push_back hold every entry, as internal devices and opened projects do.
+ */
+class ParameterList {
+  public:
+    using Metadata = std::vector<ParameterInfo>;
+
+    ParameterList() = default;
+
+    /**
+     * @brief Sparse form: shared metadata plus this device's values (one per entry of it)
+     */
+    ParameterList(std::shared_ptr<const Metadata> metadata, std::vector<float> values);
+
+    size_t size() const {
+        return values_.size();
+    }
+
+    bool empty() const {
+        return values_.empty();
+    }
+
+    void clear();
+    void reserve(size_t count) {
+        values_.reserve(count);
+    }
+    void push_back(ParameterInfo info);
+
+    /**
+     * @brief A parameter's current value, without materialising it
+     */
+    float getValue(size_t index) const;
+    void setValue(size_t index, float value);
+
+    /**
+     * @brief A copy of a parameter, with its current value (never materialises)
+     */
+    ParameterInfo operator[](size_t index) const;
+
+    /**
+     * @brief A parameter to modify in place, materialising it if needed
+     */
+    ParameterInfo& operator[](size_t index);
+
+    bool isMaterialised(size_t index) const {
+        return entries_.count(index) != 0;
+    }
+
+    size_t getNumMaterialised() const {
+        return entries_.size();
+    }
+
+    /**
+     * @brief Approximate heap footprint, not counting the shared metadata
+     */
+    size_t estimateHeapBytes() const;
+
+    /**
+     * @brief Iterates copies, like const operator[]
+     */
+    class const_iterator {
+      public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = ParameterInfo;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = ParameterInfo;
+
+        const_iterator(const ParameterList& list, size_t index) : list_(&list), index_(index) {}
+
+        ParameterInfo operator*() const {
+            return (*list_)[index_];
+        }
+        const_iterator& operator++() {
+            ++index_;
+            return *this;
+        }
+        bool operator==(const const_iterator& other) const {
+            return index_ == other.index_;
+        }
+        bool operator!=(const const_iterator& other) const {
+            return index_ != other.index_;
+        }
+
+      private:
+        const ParameterList* list_;
+        size_t index_;
+    };
+
+    const_iterator begin() const {
+        return {*this, 0};
+    }
+    const_iterator end() const {
+        return {*this, size()};
+    }
+
+  private:
+    ParameterInfo unmaterialised(size_t index) const;
+
+    std::shared_ptr<const Metadata> metadata_;  // Null for a list built with push_back
+    std::vector<float> values_;                 // Stale for materialised parameters
+    std::map<size_t, ParameterInfo> entries_;   // Materialised, holding their own value
+};
+
+}  // namespace magda
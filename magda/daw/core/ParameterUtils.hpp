@@ -20,6 +20,9 @@ namespace ParameterUtils {
  * Example:
  *   auto cutoff = ParameterPresets::frequency(0, "Cutoff");
  *   float realHz = normalizedToReal(0.5f, cutoff);  // ~632 Hz (geometric mean)
+ *
+ * Compiles a ParameterConversion for the one value; to convert many values of one
+ * parameter, keep a ParameterConversion and use it directly.
  */
 float normalizedToReal(float normalized, const ParameterInfo& info);
 
@@ -0,0 +1,201 @@
+#include "PluginSearchIndex.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+namespace magda {
+
+namespace {
+
+bool isWordChar(unsigned char c) {
+    // Bytes of multi-byte UTF-8 sequences count as word characters
+    return c >= 0x80 || (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z');
+}
+
+bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+}  // namespace
+
+std::string PluginSearchIndex::normalise(std::string_view text) {
+    std::string result(text);
+    for (auto& c : result) {
+        if (c >= 'A' && c <= 'Z') {
+            c = static_cast<char>(c - 'A' + 'a');
+        }
+    }
+    return result;
+}
+
+std::vector<std::string> PluginSearchIndex::splitTerms(const std::string& query) {
+    std::vector<std::string> terms;
+    size_t i = 0;
+    while (i < query.size()) {
+        while (i < query.size() && isSpace(query[i]))
+            ++i;
+        size_t start = i;
+        while (i < query.size() && !isSpace(query[i]))
+            ++i;
+        if (i > start) {
+            terms.emplace_back(query, start, i - start);
+        }
+    }
+    return terms;
+}
+
+uint32_t PluginSearchIndex::trigramKey(const char* text) {
+    return (static_cast<uint32_t>(static_cast<unsigned char>(text[0])) << 16) |
+           (static_cast<uint32_t>(static_cast<unsigned char>(text[1])) << 8) |
+           static_cast<uint32_t>(static_cast<unsigned char>(text[2]));
+}
+
+void PluginSearchIndex::clear() {
+    texts_.clear();
+    nameLengths_.clear();
+    tokens_.clear();
+    trigrams_.clear();
+}
+
+void PluginSearchIndex::build(const std::vector<Entry>& entries) {
+    clear();
+    texts_.reserve(entries.size());
+    nameLengths_.reserve(entries.size());
+
+    for (uint32_t id = 0; id < static_cast<uint32_t>(entries.size()); ++id) {
+        const auto& entry = entries[id];
+        auto text = normalise(entry.name) + '\n' + normalise(entry.manufacturer) + '\n' +
+                    normalise(entry.category) + '\n' + normalise(entry.format);
+
+        // Word tokens for short-term prefix search
+        size_t i = 0;
+        while (i < text.size()) {
+            while (i < text.size() && !isWordChar(static_cast<unsigned char>(text[i])))
+                ++i;
+            size_t start = i;
+            while (i < text.size() && isWordChar(static_cast<unsigned char>(text[i])))
+                ++i;
+            if (i > start) {
+                tokens_.emplace_back(text.substr(start, i - start), id);
+            }
+        }
+
+        // Trigrams for substring search; ids arrive in order, so each list stays sorted
+        for (size_t pos = 0; pos + 3 <= text.size(); ++pos) {
+            auto& postings = trigrams_[trigramKey(text.data() + pos)];
+            if (postings.empty() || postings.back() != id) {
+                postings.push_back(id);
+            }
+        }
+
+        nameLengths_.push_back(normalise(entry.name).size());
+        texts_.push_back(std::move(text));
+    }
+
+    std::sort(tokens_.begin(), tokens_.end());
+    tokens_.erase(std::unique(tokens_.begin(), tokens_.end()), tokens_.end());
+}
+
+void PluginSearchIndex::matchTerm(const std::string& term, std::vector<uint32_t>& matches) const {
+    matches.clear();
+
+    if (term.size() < 3) {
+        // Word-prefix match: tokens starting with the term form one contiguous sorted range
+        auto it = std::lower_bound(tokens_.begin(), tokens_.end(),
+                                   std::make_pair(term, static_cast<uint32_t>(0)));
+        for (; it != tokens_.end() && it->first.compare(0, term.size(), term) == 0; ++it) {
+            matches.push_back(it->second);
+        }
+        std::sort(matches.begin(), matches.end());
+        matches.erase(std::unique(matches.begin(), matches.end()), matches.end());
+        return;
+    }
+
+    // Substring match: start from the rarest trigram of the term, then verify
+    const std::vector<uint32_t>* rarest = nullptr;
+    for (size_t pos = 0; pos + 3 <= term.size(); ++pos) {
+        auto it = trigrams_.find(trigramKey(term.data() + pos));
+        if (it == trigrams_.end()) {
+            return;  // Some trigram occurs nowhere
+        }
+        if (!rarest || it->second.size() < rarest->size()) {
+            rarest = &it->second;
+        }
+    }
+
+    for (auto id : *rarest) {
+        if (texts_[id].find(term) != std::string::npos) {
+            matches.push_back(id);
+        }
+    }
+}
+
+int PluginSearchIndex::rank(uint32_t entry, const std::string& query,
+                            const std::string& firstTerm) const {
+    const auto& text = texts_[entry];
+    const size_t nameLength = nameLengths_[entry];
+
+    if (query.size() <= nameLength && text.compare(0, query.size(), query) == 0) {
+        return 0;
+    }
+
+    for (size_t pos = text.find(firstTerm); pos != std::string::npos && pos < nameLength;
+         pos = text.find(firstTerm, pos + 1)) {
+        if (pos == 0 || !isWordChar(static_cast<unsigned char>(text[pos - 1]))) {
+            return 1;
+        }
+    }
+
+    return 2;
+}
+
+std::vector<uint32_t> PluginSearchIndex::search(std::string_view query) const {
+    const auto normalised = normalise(query);
+    const auto terms = splitTerms(normalised);
+
+    std::vector<uint32_t> results;
+    if (terms.empty()) {
+        results.resize(texts_.size());
+        for (uint32_t id = 0; id < static_cast<uint32_t>(results.size()); ++id) {
+            results[id] = id;
+        }
+        return results;
+    }
+
+    std::vector<uint32_t> matches;
+    std::vector<uint32_t> intersected;
+    for (size_t i = 0; i < terms.size(); ++i) {
+        matchTerm(terms[i], matches);
+        if (i == 0) {
+            results.swap(matches);
+        } else {
+            intersected.clear();
+            std::set_intersection(results.begin(), results.end(), matches.begin(),
+                                  matches.end(), std::back_inserter(intersected));
+            results.swap(intersected);
+        }
+        if (results.empty()) {
+            return results;
+        }
+    }
+
+    // Rank once per result rather than in the comparator
+    std::string fullQuery;
+    for (const auto& term : terms) {
+        fullQuery += fullQuery.empty() ? term : " " + term;
+    }
+
+    std::vector<std::pair<int, uint32_t>> ranked;
+    ranked.reserve(results.size());
+    for (auto id : results) {
+        ranked.emplace_back(rank(id, fullQuery, terms.front()), id);
+    }
+    std::sort(ranked.begin(), ranked.end());
+
+    for (size_t i = 0; i < ranked.size(); ++i) {
+        results[i] = ranked[i].second;
+    }
+    return results;
+}
+
+}  // namespace magda
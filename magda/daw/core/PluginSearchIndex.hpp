@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace magda {
+
+/**
+ * @brief Prebuilt search index over the plugin list
+ *
+ * Built once whenever the plugin list changes, so a keystroke in the browser's search box
+ * only touches the posting lists for the typed terms instead of every description.
+ *
+ * A query is split into whitespace-separated terms and an entry must match all of them:
+ * - Terms of three or more characters match anywhere in name, manufacturer, category or
+ *   format (trigram candidates, then a substring check)
+ * - Shorter terms match the start of a word (sorted token prefix range)
+ *
+ * Matching is case-insensitive for ASCII; other UTF-8 text is compared byte for byte.
+ */
+class PluginSearchIndex {
+  public:
+    struct Entry {
+        std::string name;
+        std::string manufacturer;
+        std::string category;  // Category and subcategory, e.g. "Effect EQ"
+        std::string format;
+    };
+
+    /**
+     * @brief Replace the index contents; entry indices are positions in entries
+     */
+    void build(const std::vector<Entry>& entries);
+    void clear();
+
+    size_t size() const {
+        return texts_.size();
+    }
+
+    /**
+     * @brief Indices of the entries matching every term of the query, best match first
+     *
+     * Entries whose name starts with the query come first, then entries with a word in
+     * the name starting with the first term, then the rest; ties keep index order. An
+     * empty query returns every entry in index order.
+     */
+    std::vector<uint32_t> search(std::string_view query) const;
+
+  private:
+    static std::string normalise(std::string_view text);
+    static std::vector<std::string> splitTerms(const std::string& query);
+    static uint32_t trigramKey(const char* text);
+
+    void matchTerm(const std::string& term, std::vector<uint32_t>& matches) const;
+    int rank(uint32_t entry, const std::string& query, const std::string& firstTerm) const;
+
+    // Lowercase "name\nmanufacturer\ncategory\nformat" per entry (name first)
+    std::vector<std::string> texts_;
+    std::vector<size_t> nameLengths_;
+
+    // Word tokens sorted for prefix search, and trigram posting lists (sorted, unique)
+    std::vector<std::pair<std::string, uint32_t>> tokens_;
+    std::unordered_map<uint32_t, std::vector<uint32_t>> trigrams_;
+};
+
+}  // namespace magda
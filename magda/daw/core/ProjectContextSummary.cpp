@@ -0,0 +1,334 @@
+#include "ProjectContextSummary.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace magda {
+
+namespace {
+
+// What a track's line shows; layout, visibility and colour edits don't change it
+const auto kDescribedTrackChanges = TrackDirty::Name | TrackDirty::Mixer | TrackDirty::Routing |
+                                    TrackDirty::Type | TrackDirty::Hierarchy |
+                                    TrackDirty::Devices | TrackDirty::Freeze;
+
+std::string formatNumber(double value, int decimals) {
+    return juce::String(value, decimals).toStdString();
+}
+
+void describeElements(const std::vector<ChainElement>& elements, std::string& out) {
+    for (const auto& element : elements) {
+        if (!out.empty() && out.back() != '[') {
+            out += ", ";
+        }
+        if (isDevice(element)) {
+            const auto& device = getDevice(element);
+            out += device.name.toStdString();
+            if (device.bypassed) {
+                out += " (bypassed)";
+            }
+        } else {
+            const auto& rack = getRack(element);
+            out += rack.name.toStdString() + " [";
+            for (size_t i = 0; i < rack.chains.size(); ++i) {
+                if (i > 0) {
+                    out += " | ";
+                }
+                describeElements(rack.chains[i].elements, out);
+            }
+            out += rack.bypassed ? "] (bypassed)" : "]";
+        }
+    }
+}
+
+template <typename Id> std::vector<Id> sorted(const std::unordered_set<Id>& ids) {
+    std::vector<Id> result(ids.begin(), ids.end());
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+template <typename Id, typename Flags>
+std::vector<Id> sorted(const std::unordered_map<Id, Flags>& ids) {
+    std::vector<Id> result;
+    result.reserve(ids.size());
+    for (const auto& [id, flags] : ids) {
+        result.push_back(id);
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+}  // namespace
+
+ProjectContextSummary::ProjectContextSummary() {
+    TrackManager::getInstance().addListener(this);
+    ClipManager::getInstance().addListener(this);
+}
+
+ProjectContextSummary::~ProjectContextSummary() {
+    TrackManager::getInstance().removeListener(this);
+    ClipManager::getInstance().removeListener(this);
+}
+
+// =============================================================================
+// Lines
+// =============================================================================
+
+std::string ProjectContextSummary::describeTrack(const TrackInfo& track) {
+    std::string line = "Track " + std::to_string(track.id) + " \"" + track.name.toStdString() +
+                       "\" (" + getTrackTypeName(track.type) + ")";
+
+    line += track.volume > 0.0f
+                ? " " + formatNumber(20.0 * std::log10(static_cast<double>(track.volume)), 1) +
+                      " dB"
+                : " -inf dB";
+    if (track.pan != 0.0f) {
+        line += " pan " + formatNumber(track.pan, 2);
+    }
+    if (track.muted) {
+        line += " muted";
+    }
+    if (track.soloed) {
+        line += " soloed";
+    }
+    if (track.recordArmed) {
+        line += " armed";
+    }
+    if (track.isFrozen()) {
+        line += " frozen";
+    }
+    if (track.hasParent()) {
+        line += " in group " + std::to_string(track.parentId);
+    }
+    if (track.audioOutputDevice.isNotEmpty() && track.audioOutputDevice != "master") {
+        line += " to " + track.audioOutputDevice.toStdString();
+    }
+
+    if (!track.chainElements.empty()) {
+        std::string devices;
+        describeElements(track.chainElements, devices);
+        line += "; devices: " + devices;
+    }
+    return line;
+}
+
+std::string ProjectContextSummary::describeClip(const ClipInfo& clip) {
+    std::string line = "Clip " + std::to_string(clip.id) + " \"" + clip.name.toStdString() +
+                       "\" (" + (clip.type == ClipType::Audio ? "audio" : "MIDI") + ") " +
+                       formatNumber(clip.startTime, 2) + "-" + formatNumber(clip.getEndTime(), 2) +
+                       "s";
+
+    if (clip.type == ClipType::MIDI) {
+        line += ", " + std::to_string(clip.midiNotes.size()) + " notes";
+    } else if (!clip.audioSources.empty()) {
+        line += ", " + juce::File(clip.audioSources.front().filePath).getFileName().toStdString();
+        if (clip.audioSources.size() > 1) {
+            line += " +" + std::to_string(clip.audioSources.size() - 1) + " more";
+        }
+    }
+    if (clip.internalLoopEnabled) {
+        line += ", loops every " + formatNumber(clip.internalLoopLength, 2) + " beats";
+    }
+    if (clip.sceneIndex >= 0) {
+        line += ", scene " + std::to_string(clip.sceneIndex);
+    }
+    return line;
+}
+
+const std::string& ProjectContextSummary::trackLine(TrackId trackId) {
+    auto it = trackLines_.find(trackId);
+    if (it == trackLines_.end()) {
+        const auto* track = TrackManager::getInstance().getTrack(trackId);
+        it = trackLines_
+                 .emplace(trackId, track != nullptr ? describeTrack(*track)
+                                                    : "Track " + std::to_string(trackId))
+                 .first;
+    }
+    return it->second;
+}
+
+const std::string& ProjectContextSummary::clipLine(ClipId clipId) {
+    auto it = clipLines_.find(clipId);
+    if (it == clipLines_.end()) {
+        const auto* clip = ClipManager::getInstance().getClip(clipId);
+        it = clipLines_
+                 .emplace(clipId, clip != nullptr ? describeClip(*clip)
+                                                  : "Clip " + std::to_string(clipId))
+                 .first;
+    }
+    return it->second;
+}
+
+const std::string& ProjectContextSummary::getSummary() {
+    if (summaryValid_) {
+        return summary_;
+    }
+
+    // Only lines dropped since the last call are described again
+    const auto& clipManager = ClipManager::getInstance();
+    summary_.clear();
+    for (const auto& track : TrackManager::getInstance().getTracks()) {
+        summary_ += trackLine(track.id);
+        summary_ += '\n';
+        for (const auto clipId : clipManager.getClipsOnTrack(track.id)) {
+            summary_ += "  ";
+            summary_ += clipLine(clipId);
+            summary_ += '\n';
+        }
+    }
+    summaryValid_ = true;
+    return summary_;
+}
+
+// =============================================================================
+// Changes
+// =============================================================================
+
+template <typename Id, typename Flags>
+void ProjectContextSummary::invalidate(std::map<Id, std::string>& lines,
+                                       std::map<Id, std::string>& previousLines,
+                                       const ChangeSet<Id, Flags>& changes, Id id) {
+    auto it = lines.find(id);
+    if (it == lines.end()) {
+        return;
+    }
+    // The first edit since the last takeChanges() keeps the line as it was then, to compare
+    // against or to name a removed id by
+    const bool touched = changes.added.count(id) > 0 || changes.removed.count(id) > 0 ||
+                         changes.modified.count(id) > 0;
+    if (!touched) {
+        previousLines.emplace(id, std::move(it->second));
+    }
+    lines.erase(it);
+}
+
+void ProjectContextSummary::trackChangesCoalesced(const TrackChangeSet& changes) {
+    summaryValid_ = false;
+    if (changes.reset) {
+        trackLines_.clear();
+        clipLines_.clear();
+        previousTrackLines_.clear();
+        previousClipLines_.clear();
+        trackChanges_.markReset();
+        return;
+    }
+
+    for (const auto trackId : changes.removed) {
+        invalidate(trackLines_, previousTrackLines_, trackChanges_, trackId);
+        trackChanges_.markRemoved(trackId);
+    }
+    for (const auto trackId : changes.added) {
+        invalidate(trackLines_, previousTrackLines_, trackChanges_, trackId);
+        trackChanges_.markAdded(trackId);
+    }
+    for (const auto& [trackId, dirty] : changes.modified) {
+        if (hasFlag(dirty, kDescribedTrackChanges)) {
+            invalidate(trackLines_, previousTrackLines_, trackChanges_, trackId);
+            trackChanges_.markModified(trackId, dirty);
+        }
+    }
+    trackChanges_.reordered = trackChanges_.reordered || changes.reordered;
+}
+
+void ProjectContextSummary::devicePropertyChanged(DeviceId deviceId) {
+    // Bypassing shows in the line; parameter values don't
+    const auto trackId = TrackManager::getInstance().findDevicePath(deviceId).trackId;
+    if (trackId != INVALID_TRACK_ID) {
+        summaryValid_ = false;
+        invalidate(trackLines_, previousTrackLines_, trackChanges_, trackId);
+        trackChanges_.markModified(trackId, TrackDirty::Devices);
+    }
+}
+
+void ProjectContextSummary::clipChangesCoalesced(const ClipChangeSet& changes) {
+    summaryValid_ = false;
+    if (changes.reset) {
+        clipLines_.clear();
+        previousClipLines_.clear();
+        clipChanges_.markReset();
+        return;
+    }
+
+    for (const auto clipId : changes.removed) {
+        invalidate(clipLines_, previousClipLines_, clipChanges_, clipId);
+        clipChanges_.markRemoved(clipId);
+    }
+    for (const auto clipId : changes.added) {
+        invalidate(clipLines_, previousClipLines_, clipChanges_, clipId);
+        clipChanges_.markAdded(clipId);
+    }
+    for (const auto& [clipId, dirty] : changes.modified) {
+        invalidate(clipLines_, previousClipLines_, clipChanges_, clipId);
+        clipChanges_.markModified(clipId, dirty);
+    }
+}
+
+std::string ProjectContextSummary::takeChanges() {
+    std::string out;
+    if (trackChanges_.reset || clipChanges_.reset) {
+        out = getSummary();
+    } else {
+        const auto& clipManager = ClipManager::getInstance();
+        auto before = [](const auto& lines, auto id, const std::string& fallback) {
+            auto it = lines.find(id);
+            return it != lines.end() ? it->second : fallback;
+        };
+        auto clipTrack = [&clipManager](ClipId clipId) {
+            const auto* clip = clipManager.getClip(clipId);
+            return clip != nullptr ? ", track " + std::to_string(clip->trackId) : std::string();
+        };
+
+        for (const auto trackId : sorted(trackChanges_.removed)) {
+            out += "- " + before(previousTrackLines_, trackId, "Track " + std::to_string(trackId));
+            out += '\n';
+        }
+        for (const auto trackId : sorted(trackChanges_.added)) {
+            out += "+ " + trackLine(trackId) + '\n';
+        }
+        for (const auto trackId : sorted(trackChanges_.modified)) {
+            // Edited and put back the way it was: nothing to tell
+            const auto& line = trackLine(trackId);
+            if (before(previousTrackLines_, trackId, {}) != line) {
+                out += "~ " + line + '\n';
+            }
+        }
+        if (trackChanges_.reordered) {
+            out += "~ Tracks reordered\n";
+        }
+
+        for (const auto clipId : sorted(clipChanges_.removed)) {
+            out += "- " + before(previousClipLines_, clipId, "Clip " + std::to_string(clipId));
+            out += '\n';
+        }
+        for (const auto clipId : sorted(clipChanges_.added)) {
+            out += "+ " + clipLine(clipId) + clipTrack(clipId) + '\n';
+        }
+        for (const auto& clipId : sorted(clipChanges_.modified)) {
+            const auto& line = clipLine(clipId);
+            if (before(previousClipLines_, clipId, {}) != line ||
+                hasFlag(clipChanges_.flagsFor(clipId), ClipDirty::Track)) {
+                out += "~ " + line + clipTrack(clipId) + '\n';
+            }
+        }
+    }
+
+    trackChanges_.clear();
+    clipChanges_.clear();
+    previousTrackLines_.clear();
+    previousClipLines_.clear();
+    return out;
+}
+
+std::string ProjectContextSummary::takePromptContext() {
+    if (!sentSummary_ || trackChanges_.reset || clipChanges_.reset) {
+        takeChanges();
+        sentSummary_ = true;
+        return "Project:\n" + getSummary();
+    }
+
+    const auto changes = takeChanges();
+    return changes.empty() ? std::string() : "Changes since the last prompt:\n" + changes;
+}
+
+}  // namespace magda
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <map>
+#include <string>
+
+#include "ClipManager.hpp"
+#include "TrackManager.hpp"
+
+namespace magda {
+
+/**
+ * @brief A compact text description of the project for agent prompts, kept up to date as
+ *        the project is edited
+ *
+ * Each track and clip is described by one line, cached by id. The coalesced change sets
+ * from TrackManager and ClipManager drop only the lines of what they name, so after an
+ * edit getSummary() rewrites those lines and joins the rest as they were, rather than
+ * serialising every track, device and clip again. The joined text is cached as well, so
+ * a prompt sent with nothing edited in between costs nothing to describe.
+ *
+ * Edits since the last takeChanges() are also kept, netted out like the change sets
+ * (ChangeSet), so a conversation can be sent the whole project once and then only what
+ * changed (takePromptContext()), which keeps later prompts small however big the project.
+ *
+ * Message thread only.
+ */
+class ProjectContextSummary : private TrackManagerListener, private ClipManagerListener {
+  public:
+    ProjectContextSummary();
+    ~ProjectContextSummary() override;
+
+    /**
+     * @brief The whole project: each track's line, then its clips' lines indented
+     */
+    const std::string& getSummary();
+
+    /**
+     * @brief What was added, removed or edited since the last call, one line each
+     *        ("+", "-" or "~" then the line); empty if nothing was
+     */
+    std::string takeChanges();
+
+    /**
+     * @brief For PromptInterface::setContext(): the whole summary the first time and after
+     *        a wholesale change (a project load), otherwise only the changes since last time
+     */
+    std::string takePromptContext();
+
+    // The line a track or clip is described by
+    static std::string describeTrack(const TrackInfo& track);
+    static std::string describeClip(const ClipInfo& clip);
+
+  private:
+    const std::string& trackLine(TrackId trackId);
+    const std::string& clipLine(ClipId clipId);
+
+    // Drop an id's cached line, before marking it in changes
+    template <typename Id, typename Flags>
+    static void invalidate(std::map<Id, std::string>& lines,
+                           std::map<Id, std::string>& previousLines,
+                           const ChangeSet<Id, Flags>& changes, Id id);
+
+    // TrackManagerListener
+    void tracksChanged() override {}
+    void trackChangesCoalesced(const TrackChangeSet& changes) override;
+    void devicePropertyChanged(DeviceId deviceId) override;
+
+    // ClipManagerListener
+    void clipsChanged() override {}
+    void clipChangesCoalesced(const ClipChangeSet& changes) override;
+
+    std::map<TrackId, std::string> trackLines_;
+    std::map<ClipId, std::string> clipLines_;
+    std::string summary_;
+    bool summaryValid_ = false;
+
+    // Since the last takeChanges()
+    TrackChangeSet trackChanges_;
+    ClipChangeSet clipChanges_;
+    std::map<TrackId, std::string> previousTrackLines_;  // As they were at the last take
+    std::map<ClipId, std::string> previousClipLines_;
+    bool sentSummary_ = false;  // takePromptContext() has sent the whole project
+};
+
+}  // namespace magda
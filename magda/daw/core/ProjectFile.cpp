@@ -0,0 +1,1247 @@
+#include "ProjectFile.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+
+namespace magda {
+
+namespace {
+
+constexpr char kMagic[4] = {'M', 'G', 'D', 'A'};
+constexpr juce::int64 kHeaderSize = 16;      // Magic, version, index offset
+constexpr juce::int64 kIndexEntrySize = 24;  // Type, key, offset, size
+
+constexpr std::array<ViewMode, 4> kViewModes = {ViewMode::Live, ViewMode::Arrange, ViewMode::Mix,
+                                                ViewMode::Master};
+
+// =============================================================================
+// Value helpers
+// =============================================================================
+
+template <typename Enum> int fromEnum(Enum value) {
+    return static_cast<int>(value);
+}
+
+template <typename Enum> Enum toEnum(const juce::var& value, Enum fallback) {
+    return value.isVoid() ? fallback : static_cast<Enum>(static_cast<int>(value));
+}
+
+juce::var fromColour(juce::Colour colour) {
+    return static_cast<juce::int64>(colour.getARGB());
+}
+
+juce::Colour toColour(const juce::var& value) {
+    return juce::Colour(static_cast<juce::uint32>(static_cast<juce::int64>(value)));
+}
+
+juce::var fromInts(const std::vector<int>& values) {
+    juce::Array<juce::var> array;
+    array.ensureStorageAllocated(static_cast<int>(values.size()));
+    for (auto value : values) {
+        array.add(value);
+    }
+    return array;
+}
+
+std::vector<int> toInts(const juce::var& value) {
+    std::vector<int> values;
+    if (const auto* array = value.getArray()) {
+        values.reserve(static_cast<size_t>(array->size()));
+        for (const auto& item : *array) {
+            values.push_back(static_cast<int>(item));
+        }
+    }
+    return values;
+}
+
+template <typename T>
+T get(const juce::ValueTree& tree, const juce::Identifier& name, T fallback) {
+    const auto* value = tree.getPropertyPointer(name);
+    return value != nullptr ? static_cast<T>(*value) : fallback;
+}
+
+juce::String getString(const juce::ValueTree& tree, const juce::Identifier& name) {
+    return tree.getProperty(name).toString();
+}
+
+juce::MemoryBlock encodeTree(const juce::ValueTree& tree) {
+    juce::MemoryOutputStream out;
+    tree.writeToStream(out);
+    return out.getMemoryBlock();
+}
+
+// =============================================================================
+// Parameters, macros and mods
+// =============================================================================
+
+juce::ValueTree encodeParameter(const ParameterInfo& param) {
+    juce::ValueTree tree("Param");
+    tree.setProperty("index", param.paramIndex, nullptr);
+    tree.setProperty("name", param.name, nullptr);
+    tree.setProperty("unit", param.unit, nullptr);
+    tree.setProperty("min", param.minValue, nullptr);
+    tree.setProperty("max", param.maxValue, nullptr);
+    tree.setProperty("default", param.defaultValue, nullptr);
+    tree.setProperty("value", param.currentValue, nullptr);
+    tree.setProperty("scale", fromEnum(param.scale), nullptr);
+    tree.setProperty("skew", param.skewFactor, nullptr);
+    if (!param.choices.empty()) {
+        juce::Array<juce::var> choices;
+        for (const auto& choice : param.choices) {
+            choices.add(choice);
+        }
+        tree.setProperty("choices", choices, nullptr);
+    }
+    tree.setProperty("modulatable", param.modulatable, nullptr);
+    tree.setProperty("bipolar", param.bipolarModulation, nullptr);
+    return tree;
+}
+
+ParameterInfo decodeParameter(const juce::ValueTree& tree) {
+    ParameterInfo param;
+    param.paramIndex = get(tree, "index", -1);
+    param.name = getString(tree, "name");
+    param.unit = getString(tree, "unit");
+    param.minValue = get(tree, "min", 0.0f);
+    param.maxValue = get(tree, "max", 1.0f);
+    param.defaultValue = get(tree, "default", 0.5f);
+    param.currentValue = get(tree, "value", param.defaultValue);
+    param.scale = toEnum(tree.getProperty("scale"), ParameterScale::Linear);
+    param.skewFactor = get(tree, "skew", 1.0f);
+    if (const auto* choices = tree.getProperty("choices").getArray()) {
+        for (const auto& choice : *choices) {
+            param.choices.push_back(choice.toString());
+        }
+    }
+    param.modulatable = get(tree, "modulatable", true);
+    param.bipolarModulation = get(tree, "bipolar", true);
+    return param;
+}
+
+template <typename Link> juce::ValueTree encodeLink(const Link& link) {
+    juce::ValueTree tree("Link");
+    tree.setProperty("device", link.target.deviceId, nullptr);
+    tree.setProperty("param", link.target.paramIndex, nullptr);
+    tree.setProperty("amount", link.amount, nullptr);
+    return tree;
+}
+
+template <typename Link> Link decodeLink(const juce::ValueTree& tree) {
+    Link link;
+    link.target.deviceId = get(tree, "device", INVALID_DEVICE_ID);
+    link.target.paramIndex = get(tree, "param", -1);
+    link.amount = get(tree, "amount", 0.5f);
+    return link;
+}
+
+juce::ValueTree encodeMacro(const MacroInfo& macro) {
+    juce::ValueTree tree("Macro");
+    tree.setProperty("id", macro.id, nullptr);
+    tree.setProperty("name", macro.name, nullptr);
+    tree.setProperty("value", macro.value, nullptr);
+    if (macro.target.isValid()) {
+        tree.setProperty("targetDevice", macro.target.deviceId, nullptr);
+        tree.setProperty("targetParam", macro.target.paramIndex, nullptr);
+    }
+    for (const auto& link : macro.links) {
+        auto child = encodeLink(link);
+        child.setProperty("rangeStart", link.rangeStart, nullptr);
+        child.setProperty("rangeEnd", link.rangeEnd, nullptr);
+        child.setProperty("curve", fromEnum(link.curve), nullptr);
+        tree.appendChild(child, nullptr);
+    }
+    return tree;
+}
+
+MacroInfo decodeMacro(const juce::ValueTree& tree) {
+    MacroInfo macro;
+    macro.id = get(tree, "id", INVALID_MACRO_ID);
+    macro.name = getString(tree, "name");
+    macro.value = get(tree, "value", 0.5f);
+    macro.target.deviceId = get(tree, "targetDevice", INVALID_DEVICE_ID);
+    macro.target.paramIndex = get(tree, "targetParam", -1);
+    for (const auto& child : tree) {
+        auto link = decodeLink<MacroLink>(child);
+        link.rangeStart = get(child, "rangeStart", 0.0f);
+        link.rangeEnd = get(child, "rangeEnd", 1.0f);
+        link.curve = toEnum(child.getProperty("curve"), MacroCurve::Linear);
+        macro.links.push_back(link);
+    }
+    return macro;
+}
+
+juce::ValueTree encodeMod(const ModInfo& mod) {
+    // Phase, output value and the trigger flag are playback state, not saved
+    juce::ValueTree tree("Mod");
+    tree.setProperty("id", mod.id, nullptr);
+    tree.setProperty("name", mod.name, nullptr);
+    tree.setProperty("type", fromEnum(mod.type), nullptr);
+    tree.setProperty("enabled", mod.enabled, nullptr);
+    tree.setProperty("rate", mod.rate, nullptr);
+    tree.setProperty("waveform", fromEnum(mod.waveform), nullptr);
+    tree.setProperty("phaseOffset", mod.phaseOffset, nullptr);
+    tree.setProperty("tempoSync", mod.tempoSync, nullptr);
+    tree.setProperty("syncDivision", fromEnum(mod.syncDivision), nullptr);
+    tree.setProperty("triggerMode", fromEnum(mod.triggerMode), nullptr);
+    tree.setProperty("oneShot", mod.oneShot, nullptr);
+    tree.setProperty("useLoopRegion", mod.useLoopRegion, nullptr);
+    tree.setProperty("loopStart", mod.loopStart, nullptr);
+    tree.setProperty("loopEnd", mod.loopEnd, nullptr);
+    tree.setProperty("midiChannel", mod.midiChannel, nullptr);
+    tree.setProperty("midiNote", mod.midiNote, nullptr);
+    tree.setProperty("attack", mod.attack, nullptr);
+    tree.setProperty("decay", mod.decay, nullptr);
+    tree.setProperty("sustain", mod.sustain, nullptr);
+    tree.setProperty("release", mod.release, nullptr);
+    tree.setProperty("smoothing", mod.smoothing, nullptr);
+    tree.setProperty("sidechainTrack", mod.sidechainTrack, nullptr);
+    tree.setProperty("followerDetector", fromEnum(mod.followerDetector), nullptr);
+    tree.setProperty("resolution", fromEnum(mod.resolution), nullptr);
+    tree.setProperty("curvePreset", fromEnum(mod.curvePreset), nullptr);
+    if (mod.target.isValid()) {
+        tree.setProperty("targetDevice", mod.target.deviceId, nullptr);
+        tree.setProperty("targetParam", mod.target.paramIndex, nullptr);
+        tree.setProperty("amount", mod.amount, nullptr);
+    }
+
+    for (const auto& point : mod.curvePoints) {
+        juce::ValueTree child("CurvePoint");
+        child.setProperty("phase", point.phase, nullptr);
+        child.setProperty("value", point.value, nullptr);
+        child.setProperty("tension", point.tension, nullptr);
+        tree.appendChild(child, nullptr);
+    }
+    for (const auto& link : mod.links) {
+        tree.appendChild(encodeLink(link), nullptr);
+    }
+    return tree;
+}
+
+ModInfo decodeMod(const juce::ValueTree& tree) {
+    ModInfo mod;
+    mod.id = get(tree, "id", INVALID_MOD_ID);
+    mod.name = getString(tree, "name");
+    mod.type = toEnum(tree.getProperty("type"), ModType::LFO);
+    mod.enabled = get(tree, "enabled", true);
+    mod.rate = get(tree, "rate", 1.0f);
+    mod.waveform = toEnum(tree.getProperty("waveform"), LFOWaveform::Sine);
+    mod.phaseOffset = get(tree, "phaseOffset", 0.0f);
+    mod.tempoSync = get(tree, "tempoSync", false);
+    mod.syncDivision = toEnum(tree.getProperty("syncDivision"), SyncDivision::Quarter);
+    mod.triggerMode = toEnum(tree.getProperty("triggerMode"), LFOTriggerMode::Free);
+    mod.oneShot = get(tree, "oneShot", false);
+    mod.useLoopRegion = get(tree, "useLoopRegion", false);
+    mod.loopStart = get(tree, "loopStart", 0.0f);
+    mod.loopEnd = get(tree, "loopEnd", 1.0f);
+    mod.midiChannel = get(tree, "midiChannel", 0);
+    mod.midiNote = get(tree, "midiNote", -1);
+    mod.attack = get(tree, "attack", 0.01f);
+    mod.decay = get(tree, "decay", 0.2f);
+    mod.sustain = get(tree, "sustain", 0.7f);
+    mod.release = get(tree, "release", 0.3f);
+    mod.smoothing = get(tree, "smoothing", 0.0f);
+    mod.sidechainTrack = get(tree, "sidechainTrack", INVALID_TRACK_ID);
+    mod.followerDetector = toEnum(tree.getProperty("followerDetector"), FollowerDetector::Peak);
+    mod.resolution = toEnum(tree.getProperty("resolution"), ModResolution::Auto);
+    mod.curvePreset = toEnum(tree.getProperty("curvePreset"), CurvePreset::Triangle);
+    mod.target.deviceId = get(tree, "targetDevice", INVALID_DEVICE_ID);
+    mod.target.paramIndex = get(tree, "targetParam", -1);
+    mod.amount = get(tree, "amount", 0.5f);
+
+    for (const auto& child : tree) {
+        if (child.hasType("CurvePoint")) {
+            CurvePointData point;
+            point.phase = get(child, "phase", 0.0f);
+            point.value = get(child, "value", 0.5f);
+            point.tension = get(child, "tension", 0.0f);
+            mod.curvePoints.push_back(point);
+        } else if (child.hasType("Link")) {
+            mod.links.push_back(decodeLink<ModLink>(child));
+        }
+    }
+    return mod;
+}
+
+template <typename Array, typename Encode>
+juce::ValueTree encodeArray(const juce::Identifier& type, const Array& items, Encode encode) {
+    juce::ValueTree tree(type);
+    for (const auto& item : items) {
+        tree.appendChild(encode(item), nullptr);
+    }
+    return tree;
+}
+
+template <typename Array, typename Decode>
+void decodeArray(const juce::ValueTree& tree, Array& items, Decode decode) {
+    // A missing child keeps the defaults the struct was constructed with
+    if (!tree.isValid()) {
+        return;
+    }
+    items.clear();
+    items.reserve(static_cast<size_t>(tree.getNumChildren()));
+    for (const auto& child : tree) {
+        items.push_back(decode(child));
+    }
+}
+
+// =============================================================================
+// Devices, racks and chains
+// =============================================================================
+
+juce::ValueTree encodeElement(const ChainElement& element);
+ChainElement decodeElement(const juce::ValueTree& tree);
+
+juce::ValueTree encodeElements(const std::vector<ChainElement>& elements) {
+    return encodeArray("Elements", elements, encodeElement);
+}
+
+void decodeElements(const juce::ValueTree& tree, std::vector<ChainElement>& elements) {
+    elements.clear();
+    for (const auto& child : tree) {
+        if (child.hasType("Device") || child.hasType("Rack")) {
+            elements.push_back(decodeElement(child));
+        }
+    }
+}
+
+juce::ValueTree encodeDevice(const DeviceInfo& device) {
+    juce::ValueTree tree("Device");
+    tree.setProperty("id", device.id, nullptr);
+    tree.setProperty("name", device.name, nullptr);
+    tree.setProperty("pluginId", device.pluginId, nullptr);
+    tree.setProperty("manufacturer", device.manufacturer, nullptr);
+    tree.setProperty("format", fromEnum(device.format), nullptr);
+    tree.setProperty("isInstrument", device.isInstrument, nullptr);
+    tree.setProperty("uniqueId", device.uniqueId, nullptr);
+    tree.setProperty("fileOrIdentifier", device.fileOrIdentifier, nullptr);
+    tree.setProperty("bypassed", device.bypassed, nullptr);
+    tree.setProperty("oversampling", device.oversampling, nullptr);
+    tree.setProperty("sandboxed", device.sandboxed, nullptr);
+    tree.setProperty("expanded", device.expanded, nullptr);
+    tree.setProperty("modPanelOpen", device.modPanelOpen, nullptr);
+    tree.setProperty("gainPanelOpen", device.gainPanelOpen, nullptr);
+    tree.setProperty("paramPanelOpen", device.paramPanelOpen, nullptr);
+    tree.setProperty("visibleParameters", fromInts(device.visibleParameters), nullptr);
+    tree.setProperty("gainParameterIndex", device.gainParameterIndex, nullptr);
+    tree.setProperty("gainValue", device.gainValue, nullptr);
+    tree.setProperty("gainDb", device.gainDb, nullptr);
+    tree.setProperty("parameterPage", device.currentParameterPage, nullptr);
+    tree.appendChild(encodeArray("Parameters", device.parameters, encodeParameter), nullptr);
+    tree.appendChild(encodeArray("Macros", device.macros, encodeMacro), nullptr);
+    tree.appendChild(encodeArray("Mods", device.mods, encodeMod), nullptr);
+    return tree;
+}
+
+DeviceInfo decodeDevice(const juce::ValueTree& tree) {
+    DeviceInfo device;
+    device.id = get(tree, "id", INVALID_DEVICE_ID);
+    device.name = getString(tree, "name");
+    device.pluginId = getString(tree, "pluginId");
+    device.manufacturer = getString(tree, "manufacturer");
+    device.format = toEnum(tree.getProperty("format"), PluginFormat::VST3);
+    device.isInstrument = get(tree, "isInstrument", false);
+    device.uniqueId = getString(tree, "uniqueId");
+    device.fileOrIdentifier = getString(tree, "fileOrIdentifier");
+    device.bypassed = get(tree, "bypassed", false);
+    device.oversampling = get(tree, "oversampling", 1);
+    device.sandboxed = get(tree, "sandboxed", false);
+    device.expanded = get(tree, "expanded", true);
+    device.modPanelOpen = get(tree, "modPanelOpen", false);
+    device.gainPanelOpen = get(tree, "gainPanelOpen", false);
+    device.paramPanelOpen = get(tree, "paramPanelOpen", false);
+    device.visibleParameters = toInts(tree.getProperty("visibleParameters"));
+    device.gainParameterIndex = get(tree, "gainParameterIndex", -1);
+    device.gainValue = get(tree, "gainValue", 1.0f);
+    device.gainDb = get(tree, "gainDb", 0.0f);
+    device.currentParameterPage = get(tree, "parameterPage", 0);
+    decodeArray(tree.getChildWithName("Parameters"), device.parameters, decodeParameter);
+    decodeArray(tree.getChildWithName("Macros"), device.macros, decodeMacro);
+    decodeArray(tree.getChildWithName("Mods"), device.mods, decodeMod);
+    return device;
+}
+
+juce::ValueTree encodeChain(const ChainInfo& chain) {
+    juce::ValueTree tree("Chain");
+    tree.setProperty("id", chain.id, nullptr);
+    tree.setProperty("name", chain.name, nullptr);
+    tree.setProperty("outputIndex", chain.outputIndex, nullptr);
+    tree.setProperty("muted", chain.muted, nullptr);
+    tree.setProperty("solo", chain.solo, nullptr);
+    tree.setProperty("volume", chain.volume, nullptr);
+    tree.setProperty("pan", chain.pan, nullptr);
+    tree.setProperty("expanded", chain.expanded, nullptr);
+    tree.appendChild(encodeElements(chain.elements), nullptr);
+    return tree;
+}
+
+ChainInfo decodeChain(const juce::ValueTree& tree) {
+    ChainInfo chain;
+    chain.id = get(tree, "id", INVALID_CHAIN_ID);
+    chain.name = getString(tree, "name");
+    chain.outputIndex = get(tree, "outputIndex", 0);
+    chain.muted = get(tree, "muted", false);
+    chain.solo = get(tree, "solo", false);
+    chain.volume = get(tree, "volume", 0.0f);
+    chain.pan = get(tree, "pan", 0.0f);
+    chain.expanded = get(tree, "expanded", true);
+    decodeElements(tree.getChildWithName("Elements"), chain.elements);
+    return chain;
+}
+
+juce::ValueTree encodeRack(const RackInfo& rack) {
+    juce::ValueTree tree("Rack");
+    tree.setProperty("id", rack.id, nullptr);
+    tree.setProperty("name", rack.name, nullptr);
+    tree.setProperty("bypassed", rack.bypassed, nullptr);
+    tree.setProperty("expanded", rack.expanded, nullptr);
+    tree.setProperty("volume", rack.volume, nullptr);
+    tree.setProperty("pan", rack.pan, nullptr);
+    tree.appendChild(encodeArray("Chains", rack.chains, encodeChain), nullptr);
+    tree.appendChild(encodeArray("Macros", rack.macros, encodeMacro), nullptr);
+    tree.appendChild(encodeArray("Mods", rack.mods, encodeMod), nullptr);
+    return tree;
+}
+
+RackInfo decodeRack(const juce::ValueTree& tree) {
+    RackInfo rack;
+    rack.id = get(tree, "id", INVALID_RACK_ID);
+    rack.name = getString(tree, "name");
+    rack.bypassed = get(tree, "bypassed", false);
+    rack.expanded = get(tree, "expanded", true);
+    rack.volume = get(tree, "volume", 0.0f);
+    rack.pan = get(tree, "pan", 0.0f);
+    decodeArray(tree.getChildWithName("Chains"), rack.chains, decodeChain);
+    decodeArray(tree.getChildWithName("Macros"), rack.macros, decodeMacro);
+    decodeArray(tree.getChildWithName("Mods"), rack.mods, decodeMod);
+    return rack;
+}
+
+juce::ValueTree encodeElement(const ChainElement& element) {
+    return isDevice(element) ? encodeDevice(getDevice(element)) : encodeRack(getRack(element));
+}
+
+ChainElement decodeElement(const juce::ValueTree& tree) {
+    return tree.hasType("Rack") ? makeRackElement(decodeRack(tree))
+                                : makeDeviceElement(decodeDevice(tree));
+}
+
+// =============================================================================
+// Tracks
+// =============================================================================
+
+juce::ValueTree encodeViewSettings(const TrackViewSettingsMap& settings) {
+    juce::ValueTree tree("Views");
+    for (auto mode : kViewModes) {
+        const auto& view = settings.get(mode);
+        juce::ValueTree child("View");
+        child.setProperty("mode", fromEnum(mode), nullptr);
+        child.setProperty("visible", view.visible, nullptr);
+        child.setProperty("locked", view.locked, nullptr);
+        child.setProperty("collapsed", view.collapsed, nullptr);
+        child.setProperty("height", view.height, nullptr);
+        tree.appendChild(child, nullptr);
+    }
+    return tree;
+}
+
+void decodeViewSettings(const juce::ValueTree& tree, TrackViewSettingsMap& settings) {
+    for (const auto& child : tree) {
+        const auto mode = toEnum(child.getProperty("mode"), ViewMode::Arrange);
+        TrackViewSettings view = settings.get(mode);
+        view.visible = get(child, "visible", view.visible);
+        view.locked = get(child, "locked", view.locked);
+        view.collapsed = get(child, "collapsed", view.collapsed);
+        view.height = get(child, "height", view.height);
+        settings.set(mode, view);
+    }
+}
+
+juce::ValueTree encodeTrack(const TrackInfo& track) {
+    // Freeze is engine state and isn't saved
+    juce::ValueTree tree("Track");
+    tree.setProperty("id", track.id, nullptr);
+    tree.setProperty("type", fromEnum(track.type), nullptr);
+    tree.setProperty("name", track.name, nullptr);
+    tree.setProperty("colour", fromColour(track.colour), nullptr);
+    tree.setProperty("parentId", track.parentId, nullptr);
+    tree.setProperty("childIds", fromInts(track.childIds), nullptr);
+    tree.setProperty("volume", track.volume, nullptr);
+    tree.setProperty("pan", track.pan, nullptr);
+    tree.setProperty("muted", track.muted, nullptr);
+    tree.setProperty("soloed", track.soloed, nullptr);
+    tree.setProperty("recordArmed", track.recordArmed, nullptr);
+    tree.setProperty("directMonitor", track.directMonitor, nullptr);
+    tree.setProperty("midiInput", track.midiInputDevice, nullptr);
+    tree.setProperty("midiOutput", track.midiOutputDevice, nullptr);
+    tree.setProperty("audioInput", track.audioInputDevice, nullptr);
+    tree.setProperty("audioOutput", track.audioOutputDevice, nullptr);
+    for (const auto& send : track.sends) {
+        juce::ValueTree child("Send");
+        child.setProperty("destination", send.destinationId, nullptr);
+        child.setProperty("level", send.level, nullptr);
+        child.setProperty("preFader", send.preFader, nullptr);
+        tree.appendChild(child, nullptr);
+    }
+    tree.appendChild(encodeViewSettings(track.viewSettings), nullptr);
+    tree.appendChild(encodeElements(track.chainElements), nullptr);
+    return tree;
+}
+
+TrackInfo decodeTrack(const juce::ValueTree& tree) {
+    TrackInfo track;
+    track.id = get(tree, "id", INVALID_TRACK_ID);
+    track.type = toEnum(tree.getProperty("type"), TrackType::Audio);
+    track.name = getString(tree, "name");
+    track.colour = toColour(tree.getProperty("colour"));
+    track.parentId = get(tree, "parentId", INVALID_TRACK_ID);
+    track.childIds = toInts(tree.getProperty("childIds"));
+    track.volume = get(tree, "volume", 1.0f);
+    track.pan = get(tree, "pan", 0.0f);
+    track.muted = get(tree, "muted", false);
+    track.soloed = get(tree, "soloed", false);
+    track.recordArmed = get(tree, "recordArmed", false);
+    track.directMonitor = get(tree, "directMonitor", false);
+    track.midiInputDevice = getString(tree, "midiInput");
+    track.midiOutputDevice = getString(tree, "midiOutput");
+    track.audioInputDevice = getString(tree, "audioInput");
+    track.audioOutputDevice = getString(tree, "audioOutput");
+    for (const auto& child : tree) {
+        if (child.hasType("Send")) {
+            SendInfo send;
+            send.destinationId = get(child, "destination", INVALID_TRACK_ID);
+            send.level = get(child, "level", 1.0f);
+            send.preFader = get(child, "preFader", false);
+            track.sends.push_back(send);
+        }
+    }
+    decodeViewSettings(tree.getChildWithName("Views"), track.viewSettings);
+    decodeElements(tree.getChildWithName("Elements"), track.chainElements);
+    return track;
+}
+
+juce::ValueTree encodeMaster(const MasterChannelState& master) {
+    juce::ValueTree tree("Master");
+    tree.setProperty("volume", master.volume, nullptr);
+    tree.setProperty("pan", master.pan, nullptr);
+    tree.setProperty("muted", master.muted, nullptr);
+    tree.setProperty("soloed", master.soloed, nullptr);
+    tree.appendChild(encodeViewSettings(master.viewSettings), nullptr);
+    return tree;
+}
+
+MasterChannelState decodeMaster(const juce::ValueTree& tree) {
+    MasterChannelState master;
+    master.volume = get(tree, "volume", 1.0f);
+    master.pan = get(tree, "pan", 0.0f);
+    master.muted = get(tree, "muted", false);
+    master.soloed = get(tree, "soloed", false);
+    decodeViewSettings(tree.getChildWithName("Views"), master.viewSettings);
+    return master;
+}
+
+// =============================================================================
+// Clips
+// =============================================================================
+
+// Notes and points are packed as binary blobs: a recorded clip can hold tens of thousands.
+// The count is checked against the blob's size before anything is reserved, so a damaged
+// section fails to decode rather than asking for an absurd allocation
+constexpr size_t kCountSize = 4;
+constexpr size_t kNoteRecordSize = 4 + 1 + 1 + 8 + 8;
+constexpr size_t kPointRecordSize = 4 + 8 + 8 + 1 + 2 * (8 + 8 + 1) + 8;
+
+// The record count at the head of a blob, or -1 if the blob can't hold that many
+int readCount(juce::InputStream& in, size_t blobSize, size_t recordSize) {
+    if (blobSize < kCountSize) {
+        return -1;
+    }
+    const int count = in.readInt();
+    return count >= 0 && static_cast<size_t>(count) <= (blobSize - kCountSize) / recordSize
+               ? count
+               : -1;
+}
+
+juce::var encodeNotes(const MidiNoteList& notes) {
+    juce::MemoryOutputStream out;
+    out.writeInt(static_cast<int>(notes.size()));
+    for (const auto& note : notes) {
+        out.writeInt(note.id);
+        out.writeByte(static_cast<char>(note.noteNumber));
+        out.writeByte(static_cast<char>(note.velocity));
+        out.writeDouble(note.startBeat);
+        out.writeDouble(note.lengthBeats);
+    }
+    return out.getMemoryBlock();
+}
+
+bool decodeNotes(const juce::var& value, std::vector<MidiNote>& notes) {
+    const auto* data = value.getBinaryData();
+    if (data == nullptr) {
+        return true;
+    }
+
+    juce::MemoryInputStream in(*data, false);
+    const int count = readCount(in, data->getSize(), kNoteRecordSize);
+    if (count < 0) {
+        return false;
+    }
+    notes.reserve(static_cast<size_t>(count));
+    for (int i = 0; i < count; ++i) {
+        MidiNote note;
+        note.id = in.readInt();
+        note.noteNumber = static_cast<juce::uint8>(in.readByte());
+        note.velocity = static_cast<juce::uint8>(in.readByte());
+        note.startBeat = in.readDouble();
+        note.lengthBeats = in.readDouble();
+        notes.push_back(note);
+    }
+    return true;
+}
+
+// A fade is only written when there is one
+void encodeFade(juce::ValueTree& tree, const juce::String& name, const AudioFade& fade) {
+    if (fade.length > 0.0) {
+        tree.setProperty(name, fade.length, nullptr);
+        tree.setProperty(name + "Curve", fromEnum(fade.curve), nullptr);
+        tree.setProperty(name + "Tension", fade.tension, nullptr);
+    }
+}
+
+AudioFade decodeFade(const juce::ValueTree& tree, const juce::String& name) {
+    AudioFade fade;
+    fade.length = get(tree, name, 0.0);
+    fade.curve = toEnum(tree.getProperty(name + "Curve"), FadeCurve::EqualPower);
+    fade.tension = static_cast<float>(get(tree, name + "Tension", 0.0));
+    return fade;
+}
+
+juce::ValueTree encodeClip(const ClipInfo& clip) {
+    // Session playback state is runtime only
+    juce::ValueTree tree("Clip");
+    tree.setProperty("id", clip.id, nullptr);
+    tree.setProperty("trackId", clip.trackId, nullptr);
+    tree.setProperty("name", clip.name, nullptr);
+    tree.setProperty("colour", fromColour(clip.colour), nullptr);
+    tree.setProperty("type", fromEnum(clip.type), nullptr);
+    tree.setProperty("start", clip.startTime, nullptr);
+    tree.setProperty("length", clip.length, nullptr);
+    tree.setProperty("loop", clip.internalLoopEnabled, nullptr);
+    tree.setProperty("loopLength", clip.internalLoopLength, nullptr);
+    tree.setProperty("scene", clip.sceneIndex, nullptr);
+    if (clip.followAction != FollowAction::None) {
+        tree.setProperty("followAction", fromEnum(clip.followAction), nullptr);
+        tree.setProperty("followBeats", clip.followActionBeats, nullptr);
+    }
+    if (!clip.midiNotes.empty()) {
+        tree.setProperty("notes", encodeNotes(clip.midiNotes), nullptr);
+    }
+    for (const auto& source : clip.audioSources) {
+        juce::ValueTree child("Source");
+        child.setProperty("file", source.filePath, nullptr);
+        child.setProperty("position", source.position, nullptr);
+        child.setProperty("offset", source.offset, nullptr);
+        child.setProperty("length", source.length, nullptr);
+        child.setProperty("stretch", source.stretchFactor, nullptr);
+        encodeFade(child, "fadeIn", source.fadeIn);
+        encodeFade(child, "fadeOut", source.fadeOut);
+        tree.appendChild(child, nullptr);
+    }
+    return tree;
+}
+
+bool decodeClip(const juce::ValueTree& tree, ClipInfo& clip) {
+    clip.id = get(tree, "id", INVALID_CLIP_ID);
+    clip.trackId = get(tree, "trackId", INVALID_TRACK_ID);
+    clip.name = getString(tree, "name");
+    clip.colour = toColour(tree.getProperty("colour"));
+    clip.type = toEnum(tree.getProperty("type"), ClipType::MIDI);
+    clip.startTime = get(tree, "start", 0.0);
+    clip.length = get(tree, "length", 4.0);
+    clip.internalLoopEnabled = get(tree, "loop", false);
+    clip.internalLoopLength = get(tree, "loopLength", 4.0);
+    clip.sceneIndex = get(tree, "scene", -1);
+    clip.followAction = toEnum(tree.getProperty("followAction"), FollowAction::None);
+    clip.followActionBeats = get(tree, "followBeats", 16.0);
+    std::vector<MidiNote> notes;
+    if (!decodeNotes(tree.getProperty("notes"), notes)) {
+        return false;
+    }
+    clip.midiNotes.add(std::move(notes));
+    for (const auto& child : tree) {
+        AudioSource source;
+        source.filePath = getString(child, "file");
+        source.position = get(child, "position", 0.0);
+        source.offset = get(child, "offset", 0.0);
+        source.length = get(child, "length", 0.0);
+        source.stretchFactor = get(child, "stretch", 1.0);
+        source.fadeIn = decodeFade(child, "fadeIn");
+        source.fadeOut = decodeFade(child, "fadeOut");
+        clip.audioSources.push_back(source);
+    }
+    return true;
+}
+
+// =============================================================================
+// Automation
+// =============================================================================
+
+void writeHandle(juce::OutputStream& out, const BezierHandle& handle) {
+    out.writeDouble(handle.time);
+    out.writeDouble(handle.value);
+    out.writeBool(handle.linked);
+}
+
+BezierHandle readHandle(juce::InputStream& in) {
+    BezierHandle handle;
+    handle.time = in.readDouble();
+    handle.value = in.readDouble();
+    handle.linked = in.readBool();
+    return handle;
+}
+
+juce::var encodePoints(const std::vector<AutomationPoint>& points) {
+    juce::MemoryOutputStream out;
+    out.writeInt(static_cast<int>(points.size()));
+    for (const auto& point : points) {
+        out.writeInt(point.id);
+        out.writeDouble(point.time);
+        out.writeDouble(point.value);
+        out.writeByte(static_cast<char>(point.curveType));
+        writeHandle(out, point.inHandle);
+        writeHandle(out, point.outHandle);
+        out.writeDouble(point.tension);
+    }
+    return out.getMemoryBlock();
+}
+
+bool decodePoints(const juce::var& value, std::vector<AutomationPoint>& points) {
+    const auto* data = value.getBinaryData();
+    if (data == nullptr) {
+        return true;
+    }
+
+    juce::MemoryInputStream in(*data, false);
+    const int count = readCount(in, data->getSize(), kPointRecordSize);
+    if (count < 0) {
+        return false;
+    }
+    points.reserve(static_cast<size_t>(count));
+    for (int i = 0; i < count; ++i) {
+        AutomationPoint point;
+        point.id = in.readInt();
+        point.time = in.readDouble();
+        point.value = in.readDouble();
+        point.curveType = static_cast<AutomationCurveType>(in.readByte());
+        point.inHandle = readHandle(in);
+        point.outHandle = readHandle(in);
+        point.tension = in.readDouble();
+        points.push_back(point);
+    }
+    return true;
+}
+
+juce::ValueTree encodePath(const ChainNodePath& path) {
+    juce::ValueTree tree("Path");
+    tree.setProperty("trackId", path.trackId, nullptr);
+    tree.setProperty("topLevelDevice", path.topLevelDeviceId, nullptr);
+    for (const auto& step : path.steps) {
+        juce::ValueTree child("Step");
+        child.setProperty("type", fromEnum(step.type), nullptr);
+        child.setProperty("id", step.id, nullptr);
+        tree.appendChild(child, nullptr);
+    }
+    return tree;
+}
+
+ChainNodePath decodePath(const juce::ValueTree& tree) {
+    ChainNodePath path;
+    path.trackId = get(tree, "trackId", INVALID_TRACK_ID);
+    path.topLevelDeviceId = get(tree, "topLevelDevice", INVALID_DEVICE_ID);
+    for (const auto& child : tree) {
+        path.steps.push_back(
+            {toEnum(child.getProperty("type"), ChainStepType::Device), get(child, "id", -1)});
+    }
+    return path;
+}
+
+juce::ValueTree encodeAutomationClip(const AutomationClipInfo& clip) {
+    juce::ValueTree tree("AutomationClip");
+    tree.setProperty("id", clip.id, nullptr);
+    tree.setProperty("name", clip.name, nullptr);
+    tree.setProperty("colour", fromColour(clip.colour), nullptr);
+    tree.setProperty("start", clip.startTime, nullptr);
+    tree.setProperty("length", clip.length, nullptr);
+    tree.setProperty("looping", clip.looping, nullptr);
+    tree.setProperty("loopLength", clip.loopLength, nullptr);
+    tree.setProperty("points", encodePoints(clip.points), nullptr);
+    return tree;
+}
+
+bool decodeAutomationClip(const juce::ValueTree& tree, AutomationLaneId laneId,
+                          AutomationClipInfo& clip) {
+    clip.id = get(tree, "id", INVALID_AUTOMATION_CLIP_ID);
+    clip.laneId = laneId;
+    clip.name = getString(tree, "name");
+    clip.colour = toColour(tree.getProperty("colour"));
+    clip.startTime = get(tree, "start", 0.0);
+    clip.length = get(tree, "length", 4.0);
+    clip.looping = get(tree, "looping", false);
+    clip.loopLength = get(tree, "loopLength", 4.0);
+    return decodePoints(tree.getProperty("points"), clip.points);
+}
+
+juce::ValueTree encodeLane(const AutomationLaneInfo& lane,
+                           const std::vector<const AutomationClipInfo*>& clips) {
+    juce::ValueTree tree("Lane");
+    tree.setProperty("id", lane.id, nullptr);
+    tree.setProperty("type", fromEnum(lane.type), nullptr);
+    tree.setProperty("name", lane.name, nullptr);
+    tree.setProperty("visible", lane.visible, nullptr);
+    tree.setProperty("expanded", lane.expanded, nullptr);
+    tree.setProperty("armed", lane.armed, nullptr);
+    tree.setProperty("height", lane.height, nullptr);
+    tree.setProperty("points", encodePoints(lane.absolutePoints), nullptr);
+    tree.setProperty("clipIds", fromInts(lane.clipIds), nullptr);
+
+    const auto& target = lane.target;
+    juce::ValueTree targetTree("Target");
+    targetTree.setProperty("type", fromEnum(target.type), nullptr);
+    targetTree.setProperty("trackId", target.trackId, nullptr);
+    targetTree.setProperty("paramIndex", target.paramIndex, nullptr);
+    targetTree.setProperty("macroIndex", target.macroIndex, nullptr);
+    targetTree.setProperty("modId", target.modId, nullptr);
+    targetTree.setProperty("modParamIndex", target.modParamIndex, nullptr);
+    targetTree.appendChild(encodePath(target.devicePath), nullptr);
+    tree.appendChild(targetTree, nullptr);
+
+    for (const auto* clip : clips) {
+        tree.appendChild(encodeAutomationClip(*clip), nullptr);
+    }
+    return tree;
+}
+
+bool decodeLane(const juce::ValueTree& tree, AutomationLaneInfo& lane,
+                std::vector<AutomationClipInfo>& clips) {
+    lane.id = get(tree, "id", INVALID_AUTOMATION_LANE_ID);
+    lane.type = toEnum(tree.getProperty("type"), AutomationLaneType::Absolute);
+    lane.name = getString(tree, "name");
+    lane.visible = get(tree, "visible", true);
+    lane.expanded = get(tree, "expanded", true);
+    lane.armed = get(tree, "armed", false);
+    lane.height = get(tree, "height", 60);
+    if (!decodePoints(tree.getProperty("points"), lane.absolutePoints)) {
+        return false;
+    }
+    lane.clipIds = toInts(tree.getProperty("clipIds"));
+
+    const auto targetTree = tree.getChildWithName("Target");
+    auto& target = lane.target;
+    target.type =
+        toEnum(targetTree.getProperty("type"), AutomationTargetType::DeviceParameter);
+    target.trackId = get(targetTree, "trackId", INVALID_TRACK_ID);
+    target.paramIndex = get(targetTree, "paramIndex", -1);
+    target.macroIndex = get(targetTree, "macroIndex", -1);
+    target.modId = get(targetTree, "modId", INVALID_MOD_ID);
+    target.modParamIndex = get(targetTree, "modParamIndex", -1);
+    target.devicePath = decodePath(targetTree.getChildWithName("Path"));
+
+    for (const auto& child : tree) {
+        if (child.hasType("AutomationClip")) {
+            AutomationClipInfo clip;
+            if (!decodeAutomationClip(child, lane.id, clip)) {
+                return false;
+            }
+            clips.push_back(std::move(clip));
+        }
+    }
+    return true;
+}
+
+// =============================================================================
+// Section helpers
+// =============================================================================
+
+bool decodeSection(int type, const juce::MemoryBlock& data, ProjectModel& model) {
+    const auto tree = juce::ValueTree::readFromData(data.getData(), data.getSize());
+    if (!tree.isValid()) {
+        return false;
+    }
+
+    switch (type) {
+        case ProjectFile::kMasterSection:
+            model.master = decodeMaster(tree);
+            break;
+        case ProjectFile::kTrackSection:
+            model.tracks.push_back(decodeTrack(tree));
+            break;
+        case ProjectFile::kClipSection:
+            for (const auto& child : tree) {
+                ClipInfo clip;
+                if (!decodeClip(child, clip)) {
+                    return false;
+                }
+                model.clips.push_back(std::move(clip));
+            }
+            break;
+        case ProjectFile::kLaneSection: {
+            AutomationLaneInfo lane;
+            if (!decodeLane(tree, lane, model.automationClips)) {
+                return false;
+            }
+            model.automationLanes.push_back(std::move(lane));
+            break;
+        }
+        default:
+            break;  // Written by a later version; skip it
+    }
+    return true;
+}
+
+// FNV-1a, enough to tell whether a save would change anything
+struct ContentHash {
+    uint64_t value = 14695981039346656037ull;
+
+    void add(const void* data, size_t size) {
+        const auto* bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            value = (value ^ bytes[i]) * 1099511628211ull;
+        }
+    }
+
+    void addSection(int type, int key, const juce::MemoryBlock& data) {
+        add(&type, sizeof(type));
+        add(&key, sizeof(key));
+        add(data.getData(), data.getSize());
+    }
+};
+
+}  // namespace
+
+// =============================================================================
+// Clips
+// =============================================================================
+
+void ProjectFile::writeClip(juce::OutputStream& out, const ClipInfo& clip) {
+    encodeClip(clip).writeToStream(out);
+}
+
+ClipInfo ProjectFile::readClip(juce::InputStream& in) {
+    ClipInfo clip;
+    decodeClip(juce::ValueTree::readFromStream(in), clip);  // A damaged clip keeps no notes
+    return clip;
+}
+
+// =============================================================================
+// Sections
+// =============================================================================
+
+void ProjectFile::encodeSections(const ProjectModel& model, const SectionSink& sink) {
+    sink(kMasterSection, 0, encodeTree(encodeMaster(model.master)));
+
+    for (const auto& track : model.tracks) {
+        sink(kTrackSection, track.id, encodeTree(encodeTrack(track)));
+    }
+
+    // Clips grouped per track, in the order the model holds them
+    std::vector<TrackId> clipTracks;
+    std::unordered_map<TrackId, std::vector<const ClipInfo*>> clipsByTrack;
+    for (const auto& clip : model.clips) {
+        auto& clips = clipsByTrack[clip.trackId];
+        if (clips.empty()) {
+            clipTracks.push_back(clip.trackId);
+        }
+        clips.push_back(&clip);
+    }
+    for (auto trackId : clipTracks) {
+        juce::ValueTree tree("Clips");
+        for (const auto* clip : clipsByTrack[trackId]) {
+            tree.appendChild(encodeClip(*clip), nullptr);
+        }
+        sink(kClipSection, trackId, encodeTree(tree));
+    }
+
+    std::unordered_map<AutomationClipId, const AutomationClipInfo*> automationClips;
+    for (const auto& clip : model.automationClips) {
+        automationClips[clip.id] = &clip;
+    }
+    for (const auto& lane : model.automationLanes) {
+        std::vector<const AutomationClipInfo*> clips;
+        for (auto clipId : lane.clipIds) {
+            if (auto it = automationClips.find(clipId); it != automationClips.end()) {
+                clips.push_back(it->second);
+            }
+        }
+        sink(kLaneSection, lane.id, encodeTree(encodeLane(lane, clips)));
+    }
+
+    for (const auto& [deviceId, state] : model.pluginStates) {
+        if (state.tree.isValid()) {
+            sink(kPluginSection, deviceId, encodeTree(state.tree));
+        } else if (!state.bytes.isEmpty()) {
+            sink(kPluginSection, deviceId, state.bytes);
+        }
+    }
+}
+
+juce::String ProjectFile::decodeSections(const std::vector<SectionData>& sections,
+                                         ProjectModel& model) {
+    for (const auto& section : sections) {
+        if (section.type != kPluginSection && !decodeSection(section.type, section.data, model)) {
+            return "Unreadable section";
+        }
+    }
+    return {};
+}
+
+// =============================================================================
+// Writing
+// =============================================================================
+
+juce::String ProjectFile::write(const juce::File& file, const ProjectModel& model,
+                                uint64_t* contentHash) {
+    struct IndexEntry {
+        int type;
+        int key;
+        juce::int64 offset;
+        juce::int64 size;
+    };
+
+    juce::TemporaryFile temp(file);
+    ContentHash hash;
+    {
+        auto out = temp.getFile().createOutputStream();
+        if (out == nullptr || out->failedToOpen()) {
+            return "Couldn't write to " + file.getParentDirectory().getFullPathName();
+        }
+
+        out->write(kMagic, sizeof(kMagic));
+        out->writeInt(kVersion);
+        out->writeInt64(0);  // Index offset, filled in once the sections are down
+
+        std::vector<IndexEntry> index;
+        encodeSections(model, [&](int type, int key, const juce::MemoryBlock& data) {
+            const auto size = static_cast<juce::int64>(data.getSize());
+            index.push_back({type, key, out->getPosition(), size});
+            out->write(data.getData(), data.getSize());
+            hash.addSection(type, key, data);
+        });
+
+        const auto indexOffset = out->getPosition();
+        out->writeInt(static_cast<int>(index.size()));
+        for (const auto& entry : index) {
+            out->writeInt(entry.type);
+            out->writeInt(entry.key);
+            out->writeInt64(entry.offset);
+            out->writeInt64(entry.size);
+        }
+        out->setPosition(sizeof(kMagic) + sizeof(int));
+        out->writeInt64(indexOffset);
+        out->flush();
+
+        if (out->getStatus().failed()) {
+            return "Couldn't write " + file.getFileName() + ": " +
+                   out->getStatus().getErrorMessage();
+        }
+    }
+
+    if (!temp.overwriteTargetFileWithTemporary()) {
+        return "Couldn't replace " + file.getFullPathName();
+    }
+    if (contentHash != nullptr) {
+        *contentHash = hash.value;
+    }
+    return {};
+}
+
+uint64_t ProjectFile::hashModel(const ProjectModel& model) {
+    ContentHash hash;
+    encodeSections(model, [&hash](int type, int key, const juce::MemoryBlock& data) {
+        hash.addSection(type, key, data);
+    });
+    return hash.value;
+}
+
+// =============================================================================
+// Reader
+// =============================================================================
+
+ProjectFile::Reader::Reader(const juce::File& file) : file_(file) {}
+
+ProjectFile::Reader::~Reader() = default;
+
+std::unique_ptr<ProjectFile::Reader> ProjectFile::Reader::open(const juce::File& file,
+                                                               juce::String& error) {
+    if (!file.existsAsFile()) {
+        error = "Can't find " + file.getFullPathName();
+        return nullptr;
+    }
+
+    std::unique_ptr<Reader> reader(new Reader(file));
+    if (!reader->readIndex(error)) {
+        return nullptr;
+    }
+    return reader;
+}
+
+bool ProjectFile::Reader::readIndex(juce::String& error) {
+    stream_ = std::make_unique<juce::FileInputStream>(file_);
+    if (!stream_->openedOk()) {
+        error = "Couldn't open " + file_.getFileName();
+        return false;
+    }
+
+    const auto fileSize = stream_->getTotalLength();
+    char magic[sizeof(kMagic)] = {};
+    if (fileSize < kHeaderSize || stream_->read(magic, sizeof(magic)) != sizeof(magic) ||
+        std::memcmp(magic, kMagic, sizeof(kMagic)) != 0) {
+        error = file_.getFileName() + " isn't a MAGDA project";
+        return false;
+    }
+
+    const int version = stream_->readInt();
+    if (version < 1 || version > kVersion) {
+        error = file_.getFileName() + " was saved by a newer version of MAGDA";
+        return false;
+    }
+
+    const auto indexOffset = stream_->readInt64();
+    if (indexOffset < kHeaderSize || indexOffset > fileSize - 4 ||
+        !stream_->setPosition(indexOffset)) {
+        error = file_.getFileName() + " is damaged (no section index)";
+        return false;
+    }
+
+    const int count = stream_->readInt();
+    if (count < 0 || count > (fileSize - indexOffset - 4) / kIndexEntrySize) {
+        error = file_.getFileName() + " is damaged (bad section index)";
+        return false;
+    }
+
+    sections_.reserve(static_cast<size_t>(count));
+    for (int i = 0; i < count; ++i) {
+        Section section;
+        section.type = stream_->readInt();
+        section.key = stream_->readInt();
+        section.offset = stream_->readInt64();
+        section.size = stream_->readInt64();
+        if (section.offset < kHeaderSize || section.size < 0 ||
+            section.offset + section.size > indexOffset) {
+            error = file_.getFileName() + " is damaged (section out of range)";
+            return false;
+        }
+
+        if (section.type == kPluginSection) {
+            pendingPlugins_[section.key] = section;
+        } else {
+            sections_.push_back(section);
+        }
+    }
+    return true;
+}
+
+juce::MemoryBlock ProjectFile::Reader::readSection(const Section& section) {
+    juce::MemoryBlock data;
+    if (stream_ == nullptr || !stream_->setPosition(section.offset)) {
+        return data;
+    }
+    data.setSize(static_cast<size_t>(section.size));
+    if (stream_->read(data.getData(), data.getSize()) != static_cast<int>(section.size)) {
+        data.reset();
+    }
+    return data;
+}
+
+juce::String ProjectFile::Reader::readModel(ProjectModel& model) {
+    const juce::ScopedLock sl(lock_);
+
+    for (const auto& section : sections_) {
+        if (!decodeSection(section.type, readSection(section), model)) {
+            return file_.getFileName() + " is damaged (unreadable section)";
+        }
+    }
+    return {};
+}
+
+std::vector<ProjectFile::SectionData> ProjectFile::Reader::readModelSections(
+    juce::String& error) {
+    const juce::ScopedLock sl(lock_);
+
+    std::vector<SectionData> sections;
+    sections.reserve(sections_.size());
+    for (const auto& section : sections_) {
+        auto data = readSection(section);
+        if (data.isEmpty() && section.size > 0) {
+            error = file_.getFileName() + " is damaged (unreadable section)";
+            return {};
+        }
+        sections.push_back({section.type, section.key, std::move(data)});
+    }
+    return sections;
+}
+
+std::vector<DeviceId> ProjectFile::Reader::getPendingPluginStates() const {
+    const juce::ScopedLock sl(lock_);
+    std::vector<DeviceId> deviceIds;
+    for (const auto& [deviceId, section] : pendingPlugins_) {
+        deviceIds.push_back(deviceId);
+    }
+    for (const auto& [deviceId, data] : detachedPlugins_) {
+        deviceIds.push_back(deviceId);
+    }
+    return deviceIds;
+}
+
+bool ProjectFile::Reader::hasPluginState(DeviceId deviceId) const {
+    const juce::ScopedLock sl(lock_);
+    return pendingPlugins_.count(deviceId) != 0 || detachedPlugins_.count(deviceId) != 0;
+}
+
+juce::ValueTree ProjectFile::Reader::takePluginState(DeviceId deviceId) {
+    const juce::ScopedLock sl(lock_);
+
+    juce::MemoryBlock data;
+    if (auto it = detachedPlugins_.find(deviceId); it != detachedPlugins_.end()) {
+        data = std::move(it->second);
+        detachedPlugins_.erase(it);
+    } else if (auto pending = pendingPlugins_.find(deviceId); pending != pendingPlugins_.end()) {
+        data = readSection(pending->second);
+        pendingPlugins_.erase(pending);
+    }
+
+    if (data.isEmpty()) {
+        return {};
+    }
+    return juce::ValueTree::readFromData(data.getData(), data.getSize());
+}
+
+std::map<DeviceId, PluginStateData> ProjectFile::Reader::copyPendingPluginStates(
+    const std::vector<DeviceId>& deviceIds) {
+    const juce::ScopedLock sl(lock_);
+
+    std::map<DeviceId, PluginStateData> states;
+    for (auto deviceId : deviceIds) {
+        if (auto it = detachedPlugins_.find(deviceId); it != detachedPlugins_.end()) {
+            states[deviceId].bytes = it->second;
+            continue;
+        }
+        if (auto it = pendingPlugins_.find(deviceId); it != pendingPlugins_.end()) {
+            states[deviceId].bytes = readSection(it->second);
+        }
+    }
+    return states;
+}
+
+void ProjectFile::Reader::detachFromFile() {
+    const juce::ScopedLock sl(lock_);
+    for (const auto& [deviceId, section] : pendingPlugins_) {
+        detachedPlugins_[deviceId] = readSection(section);
+    }
+    pendingPlugins_.clear();
+    stream_.reset();
+}
+
+}  // namespace magda
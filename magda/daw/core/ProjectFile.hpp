@@ -0,0 +1,205 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <juce_data_structures/juce_data_structures.h>
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "AutomationInfo.hpp"
+#include "ClipInfo.hpp"
+#include "TrackInfo.hpp"
+#include "TrackManager.hpp"
+
+namespace magda {
+
+/**
+ * @brief A plugin's saved state: a live copy taken from the engine, or raw bytes from a file
+ */
+struct PluginStateData {
+    juce::ValueTree tree;     // Copy of the plugin's state, encoded when written
+    juce::MemoryBlock bytes;  // Already encoded (a state that was never instantiated)
+
+    bool isEmpty() const {
+        return !tree.isValid() && bytes.isEmpty();
+    }
+};
+
+/**
+ * @brief Everything a project file holds
+ *
+ * Copying one is cheap: the track chains are copy-on-write (see ChainElement), which is
+ * what lets a save take its snapshot on the message thread and encode it elsewhere.
+ */
+struct ProjectModel {
+    std::vector<TrackInfo> tracks;
+    MasterChannelState master;
+    std::vector<ClipInfo> clips;
+    std::vector<AutomationLaneInfo> automationLanes;
+    std::vector<AutomationClipInfo> automationClips;
+    std::map<DeviceId, PluginStateData> pluginStates;
+};
+
+/**
+ * @brief The binary project format
+ *
+ * A file is a header, a run of sections and an index of them at the end:
+ *
+ *   "MGDA" | version (int32) | index offset (int64) | sections... | index
+ *   index:  count (int32), then per section: type (int32), key (int32),
+ *           offset (int64), size (int64)
+ *
+ * Each track, each track's clips, each automation lane and each plugin state is its own
+ * section, so a reader can stream the model section by section and leave the plugin
+ * states, usually most of the file, on disk until a plugin asks for one. Model sections
+ * are binary juce::ValueTrees with named properties, so fields can be added without a
+ * version bump; plugin states are stored as the engine's own state trees.
+ *
+ * Files are written to a temporary sibling and moved over the target once complete, so
+ * a failed or interrupted save never leaves a partial project behind.
+ */
+class ProjectFile {
+  public:
+    static constexpr int kVersion = 1;
+    static constexpr const char* kFileExtension = ".magda";
+
+    // Section types, as four-character codes
+    static constexpr int kMasterSection = 0x5453'4d4d;  // "MMST"
+    static constexpr int kTrackSection = 0x4b41'5254;   // "TRAK"
+    static constexpr int kClipSection = 0x5350'4c43;    // "CLPS"
+    static constexpr int kLaneSection = 0x4f54'5541;    // "AUTO"
+    static constexpr int kPluginSection = 0x4755'4c50;  // "PLUG"
+
+    /**
+     * @brief One encoded section, as stored in a project file or a journal
+     */
+    struct SectionData {
+        int type = 0;
+        int key = 0;
+        juce::MemoryBlock data;
+    };
+
+    using SectionSink = std::function<void(int type, int key, const juce::MemoryBlock& data)>;
+
+    /**
+     * @brief Encode a model's sections in file order, one at a time
+     *
+     * The sink sees each section as it is encoded, so a writer never holds more than one.
+     */
+    static void encodeSections(const ProjectModel& model, const SectionSink& sink);
+
+    /**
+     * @brief Decode model sections into model, in order (plugin states are skipped)
+     * @return An error message, empty on success
+     */
+    static juce::String decodeSections(const std::vector<SectionData>& sections,
+                                       ProjectModel& model);
+
+    /**
+     * @brief Write a project, replacing the file only once it is complete
+     * @param contentHash Set to a hash of everything written, for detecting unchanged saves
+     * @return An error message, empty on success
+     */
+    static juce::String write(const juce::File& file, const ProjectModel& model,
+                              uint64_t* contentHash = nullptr);
+
+    /**
+     * @brief Hash of the content write() would produce for this model
+     */
+    static uint64_t hashModel(const ProjectModel& model);
+
+    /**
+     * @brief One clip in the file's encoding, for keeping a clip outside the model
+     */
+    static void writeClip(juce::OutputStream& out, const ClipInfo& clip);
+    static ClipInfo readClip(juce::InputStream& in);
+
+    /**
+     * @brief An open project file
+     *
+     * readModel() decodes everything but the plugin states; those stay in the file and
+     * are read one at a time by takePluginState(). Thread safe, so a save on a pool
+     * thread can carry over states that are still waiting while the message thread takes
+     * others.
+     */
+    class Reader {
+      public:
+        /**
+         * @return nullptr with error set if the file is missing or not a project
+         */
+        static std::unique_ptr<Reader> open(const juce::File& file, juce::String& error);
+
+        ~Reader();
+
+        const juce::File& getFile() const {
+            return file_;
+        }
+
+        /**
+         * @brief Decode the model sections, in file order
+         * @return An error message, empty on success
+         */
+        juce::String readModel(ProjectModel& model);
+
+        /**
+         * @brief The model sections still encoded, in file order, for replaying edits onto
+         * @return Empty with error set if one can't be read
+         */
+        std::vector<SectionData> readModelSections(juce::String& error);
+
+        /**
+         * @brief Devices whose saved state hasn't been taken yet
+         */
+        std::vector<DeviceId> getPendingPluginStates() const;
+
+        bool hasPluginState(DeviceId deviceId) const;
+
+        /**
+         * @brief Read a device's saved state and forget it
+         * @return An invalid tree if there is none (or it has been taken)
+         */
+        juce::ValueTree takePluginState(DeviceId deviceId);
+
+        /**
+         * @brief Encoded copies of the states not taken yet, for the given devices
+         */
+        std::map<DeviceId, PluginStateData> copyPendingPluginStates(
+            const std::vector<DeviceId>& deviceIds);
+
+        /**
+         * @brief Read every pending state into memory and close the file
+         *
+         * Lets a save replace the file this reader came from.
+         */
+        void detachFromFile();
+
+      private:
+        struct Section {
+            int type = 0;
+            int key = 0;
+            juce::int64 offset = 0;
+            juce::int64 size = 0;
+        };
+
+        explicit Reader(const juce::File& file);
+        bool readIndex(juce::String& error);
+        juce::MemoryBlock readSection(const Section& section);
+
+        juce::File file_;
+        std::unique_ptr<juce::FileInputStream> stream_;
+        std::vector<Section> sections_;
+        std::map<DeviceId, Section> pendingPlugins_;
+        std::map<DeviceId, juce::MemoryBlock> detachedPlugins_;
+        mutable juce::CriticalSection lock_;
+
+        JUCE_DECLARE_NON_COPYABLE(Reader)
+    };
+
+  private:
+    ProjectFile() = delete;
+};
+
+}  // namespace magda
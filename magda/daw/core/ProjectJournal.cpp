@@ -0,0 +1,331 @@
+#include "ProjectJournal.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
+#include <map>
+#include <unordered_map>
+
+namespace magda {
+
+namespace {
+
+constexpr char kMagic[4] = {'M', 'G', 'D', 'J'};
+constexpr juce::int64 kHeaderSize = 16;  // Magic, version, generation
+constexpr const char* kFilePrefix = "autosave-";
+constexpr const char* kJournalExtension = ".journal";
+
+// FNV-1a over a batch, to spot one the crash cut short
+juce::int64 checksum(const void* data, size_t size) {
+    uint64_t value = 14695981039346656037ull;
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        value = (value ^ bytes[i]) * 1099511628211ull;
+    }
+    return static_cast<juce::int64>(value);
+}
+
+/**
+ * @brief Generation number from an autosave file's name, -1 if it isn't one
+ */
+juce::int64 generationOf(const juce::File& file) {
+    const auto name = file.getFileNameWithoutExtension();
+    if (!name.startsWith(kFilePrefix)) {
+        return -1;
+    }
+    const auto number = name.substring(juce::String(kFilePrefix).length());
+    return number.containsOnly("0123456789") && number.isNotEmpty() ? number.getLargeIntValue()
+                                                                    : -1;
+}
+
+/**
+ * @brief Autosave files in directory by generation, for one extension
+ */
+std::map<juce::int64, juce::File> findGenerations(const juce::File& directory,
+                                                  const juce::String& extension) {
+    std::map<juce::int64, juce::File> files;
+    for (const auto& file : directory.findChildFiles(juce::File::findFiles, false,
+                                                     kFilePrefix + juce::String("*") + extension)) {
+        if (const auto generation = generationOf(file); generation >= 0) {
+            files[generation] = file;
+        }
+    }
+    return files;
+}
+
+void readBatches(juce::MemoryInputStream& in, std::vector<ProjectJournal::Record>& records) {
+    while (in.getNumBytesRemaining() >= 4) {
+        const auto start = in.getPosition();
+        const int count = in.readInt();
+        if (count < 0) {
+            return;
+        }
+
+        std::vector<ProjectJournal::Record> batch;
+        batch.reserve(static_cast<size_t>(std::min(count, 1024)));
+        for (int i = 0; i < count; ++i) {
+            if (in.getNumBytesRemaining() < 16) {
+                return;
+            }
+            ProjectJournal::Record record;
+            record.type = in.readInt();
+            record.key = in.readInt();
+            const auto size = in.readInt64();
+            if (size < -1 || size > in.getNumBytesRemaining()) {
+                return;
+            }
+            record.removed = size < 0;
+            if (size > 0) {
+                record.data.setSize(static_cast<size_t>(size));
+                in.read(record.data.getData(), static_cast<int>(size));
+            }
+            batch.push_back(std::move(record));
+        }
+
+        const auto end = in.getPosition();
+        if (in.getNumBytesRemaining() < 8) {
+            return;
+        }
+        const auto* data = static_cast<const char*>(in.getData()) + start;
+        if (in.readInt64() != checksum(data, static_cast<size_t>(end - start))) {
+            return;
+        }
+
+        for (auto& record : batch) {
+            records.push_back(std::move(record));
+        }
+    }
+}
+
+void applyTrackOrder(const juce::MemoryBlock& data,
+                     std::vector<ProjectFile::SectionData>& sections) {
+    juce::MemoryInputStream in(data, false);
+    std::unordered_map<int, size_t> rank;
+    while (in.getNumBytesRemaining() >= 4) {
+        rank.emplace(in.readInt(), rank.size());
+    }
+
+    std::vector<size_t> slots;
+    std::vector<ProjectFile::SectionData> tracks;
+    for (size_t i = 0; i < sections.size(); ++i) {
+        if (sections[i].type == ProjectFile::kTrackSection) {
+            slots.push_back(i);
+            tracks.push_back(std::move(sections[i]));
+        }
+    }
+
+    // Tracks missing from the order keep their place after the ordered ones
+    auto rankOf = [&rank](int trackId) {
+        auto it = rank.find(trackId);
+        return it != rank.end() ? it->second : rank.size();
+    };
+    std::stable_sort(tracks.begin(), tracks.end(), [&rankOf](const auto& a, const auto& b) {
+        return rankOf(a.key) < rankOf(b.key);
+    });
+    for (size_t i = 0; i < slots.size(); ++i) {
+        sections[slots[i]] = std::move(tracks[i]);
+    }
+}
+
+}  // namespace
+
+// =============================================================================
+// Records
+// =============================================================================
+
+ProjectJournal::Record ProjectJournal::makeTrackOrderRecord(const std::vector<TrackId>& trackIds) {
+    juce::MemoryOutputStream out;
+    for (auto trackId : trackIds) {
+        out.writeInt(trackId);
+    }
+    return {kTrackOrderRecord, 0, out.getMemoryBlock(), false};
+}
+
+ProjectJournal::Record ProjectJournal::makeProjectFileRecord(const juce::File& projectFile) {
+    juce::MemoryOutputStream out;
+    out << projectFile.getFullPathName();
+    return {kProjectFileRecord, 0, out.getMemoryBlock(), false};
+}
+
+// =============================================================================
+// Writer
+// =============================================================================
+
+ProjectJournal::Writer::Writer(const juce::File& file,
+                               std::unique_ptr<juce::FileOutputStream> stream)
+    : file_(file), stream_(std::move(stream)) {}
+
+std::unique_ptr<ProjectJournal::Writer> ProjectJournal::Writer::create(const juce::File& file,
+                                                                       juce::int64 generation,
+                                                                       juce::String& error) {
+    file.getParentDirectory().createDirectory();
+    file.deleteFile();
+
+    auto stream = file.createOutputStream();
+    if (stream == nullptr || stream->failedToOpen()) {
+        error = "Couldn't create " + file.getFullPathName();
+        return nullptr;
+    }
+
+    stream->write(kMagic, sizeof(kMagic));
+    stream->writeInt(kVersion);
+    stream->writeInt64(generation);
+    stream->flush();
+    if (stream->getStatus().failed()) {
+        error = "Couldn't write " + file.getFileName() + ": " +
+                stream->getStatus().getErrorMessage();
+        return nullptr;
+    }
+    return std::unique_ptr<Writer>(new Writer(file, std::move(stream)));
+}
+
+juce::String ProjectJournal::Writer::append(const std::vector<Record>& records) {
+    juce::MemoryOutputStream batch;
+    batch.writeInt(static_cast<int>(records.size()));
+    for (const auto& record : records) {
+        batch.writeInt(record.type);
+        batch.writeInt(record.key);
+        batch.writeInt64(record.removed ? -1 : static_cast<juce::int64>(record.data.getSize()));
+        if (!record.removed) {
+            batch.write(record.data.getData(), record.data.getSize());
+        }
+    }
+
+    stream_->write(batch.getData(), batch.getDataSize());
+    stream_->writeInt64(checksum(batch.getData(), batch.getDataSize()));
+    stream_->flush();
+    if (stream_->getStatus().failed()) {
+        return "Couldn't write " + file_.getFileName() + ": " +
+               stream_->getStatus().getErrorMessage();
+    }
+    return {};
+}
+
+juce::int64 ProjectJournal::Writer::getSize() const {
+    return stream_->getPosition();
+}
+
+// =============================================================================
+// Reading and replay
+// =============================================================================
+
+bool ProjectJournal::read(const juce::File& file, juce::int64& generation,
+                          std::vector<Record>& records) {
+    juce::MemoryBlock data;
+    if (!file.loadFileAsData(data) || static_cast<juce::int64>(data.getSize()) < kHeaderSize ||
+        std::memcmp(data.getData(), kMagic, sizeof(kMagic)) != 0) {
+        return false;
+    }
+
+    juce::MemoryInputStream in(data, false);
+    in.skipNextBytes(sizeof(kMagic));
+    const int version = in.readInt();
+    if (version < 1 || version > kVersion) {
+        return false;
+    }
+    generation = in.readInt64();
+    readBatches(in, records);
+    return true;
+}
+
+void ProjectJournal::replay(const std::vector<Record>& records,
+                            std::vector<ProjectFile::SectionData>& sections,
+                            juce::File& projectFile) {
+    for (const auto& record : records) {
+        if (record.type == kProjectFileRecord) {
+            const auto path = record.data.toString();
+            projectFile = juce::File::isAbsolutePath(path) ? juce::File(path) : juce::File();
+            continue;
+        }
+        if (record.type == kTrackOrderRecord) {
+            applyTrackOrder(record.data, sections);
+            continue;
+        }
+
+        auto it = std::find_if(sections.begin(), sections.end(), [&record](const auto& section) {
+            return section.type == record.type && section.key == record.key;
+        });
+        if (record.removed) {
+            if (it != sections.end()) {
+                sections.erase(it);
+            }
+        } else if (it != sections.end()) {
+            it->data = record.data;
+        } else {
+            sections.push_back({record.type, record.key, record.data});
+        }
+    }
+}
+
+// =============================================================================
+// Autosave directory
+// =============================================================================
+
+juce::File ProjectJournal::getCheckpointFile(const juce::File& directory,
+                                             juce::int64 generation) {
+    return directory.getChildFile(kFilePrefix + juce::String(generation) +
+                                  ProjectFile::kFileExtension);
+}
+
+juce::File ProjectJournal::getJournalFile(const juce::File& directory, juce::int64 generation) {
+    return directory.getChildFile(kFilePrefix + juce::String(generation) + kJournalExtension);
+}
+
+bool ProjectJournal::hasRecoveryData(const juce::File& directory) {
+    return !findGenerations(directory, ProjectFile::kFileExtension).empty();
+}
+
+void ProjectJournal::deleteGenerationsBefore(const juce::File& directory,
+                                             juce::int64 generation) {
+    for (const auto* extension : {ProjectFile::kFileExtension, kJournalExtension}) {
+        for (const auto& [fileGeneration, file] : findGenerations(directory, extension)) {
+            if (generation <= 0 || fileGeneration < generation) {
+                file.deleteFile();
+            }
+        }
+    }
+}
+
+juce::String ProjectJournal::recover(const juce::File& directory, ProjectModel& model,
+                                     std::shared_ptr<ProjectFile::Reader>& reader,
+                                     juce::File& projectFile) {
+    const auto checkpoints = findGenerations(directory, ProjectFile::kFileExtension);
+
+    // The newest checkpoint that reads back; a later one may have died mid-write
+    juce::int64 base = -1;
+    std::vector<ProjectFile::SectionData> sections;
+    for (auto it = checkpoints.rbegin(); it != checkpoints.rend() && base < 0; ++it) {
+        juce::String error;
+        std::shared_ptr<ProjectFile::Reader> candidate = ProjectFile::Reader::open(it->second,
+                                                                                   error);
+        if (candidate == nullptr) {
+            continue;
+        }
+        sections = candidate->readModelSections(error);
+        if (error.isEmpty()) {
+            base = it->first;
+            reader = std::move(candidate);
+        }
+    }
+    if (base < 0) {
+        return "There is no readable autosave to recover";
+    }
+
+    projectFile = juce::File();
+    for (const auto& [generation, file] : findGenerations(directory, kJournalExtension)) {
+        juce::int64 journalGeneration = 0;
+        std::vector<Record> records;
+        if (generation >= base && read(file, journalGeneration, records) &&
+            journalGeneration == generation) {
+            replay(records, sections, projectFile);
+        }
+    }
+
+    reader->detachFromFile();
+    if (ProjectFile::decodeSections(sections, model).isNotEmpty()) {
+        return "The autosave is damaged";
+    }
+    return {};
+}
+
+}  // namespace magda
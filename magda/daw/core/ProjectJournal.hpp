@@ -0,0 +1,133 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+#include <memory>
+#include <vector>
+
+#include "ProjectFile.hpp"
+
+namespace magda {
+
+/**
+ * @brief An append-only log of edited project sections, replayed onto a checkpoint
+ *
+ * Autosave writes a full project now and then (a checkpoint, generation N) and in between
+ * appends only the sections each edit touched to journal N, so an autosave costs what the
+ * edit changed rather than what the project holds. Recovery takes the newest readable
+ * checkpoint and replays its journal, and any later ones, over it.
+ *
+ *   "MGDJ" | version (int32) | generation (int64) | batches...
+ *   batch:  count (int32), then per record: type (int32), key (int32),
+ *           size (int64, -1 for a removed section), data; then a checksum (int64)
+ *
+ * Records use ProjectFile's section types and keys, plus the two below. A batch is one
+ * flush; one cut short by a crash fails its checksum and it and everything after it are
+ * ignored. Plugin states are not journaled: a recovered project has them as of the last
+ * checkpoint.
+ */
+class ProjectJournal {
+  public:
+    static constexpr int kVersion = 1;
+
+    // Record types beyond ProjectFile's sections
+    static constexpr int kTrackOrderRecord = 0x5244'524f;   // "ORDR": track ids, int32 each
+    static constexpr int kProjectFileRecord = 0x4854'4150;  // "PATH": the project's file
+
+    struct Record {
+        int type = 0;
+        int key = 0;
+        juce::MemoryBlock data;
+        bool removed = false;
+    };
+
+    static Record makeTrackOrderRecord(const std::vector<TrackId>& trackIds);
+    static Record makeProjectFileRecord(const juce::File& projectFile);
+
+    /**
+     * @brief Appends batches to a journal, creating it with its header
+     *
+     * Not thread safe; autosave uses one from a single pool thread.
+     */
+    class Writer {
+      public:
+        /**
+         * @return nullptr with error set if the file can't be created
+         */
+        static std::unique_ptr<Writer> create(const juce::File& file, juce::int64 generation,
+                                              juce::String& error);
+
+        /**
+         * @brief Append records as one batch and flush it to disk
+         * @return An error message, empty on success
+         */
+        juce::String append(const std::vector<Record>& records);
+
+        juce::int64 getSize() const;
+
+        const juce::File& getFile() const {
+            return file_;
+        }
+
+      private:
+        Writer(const juce::File& file, std::unique_ptr<juce::FileOutputStream> stream);
+
+        juce::File file_;
+        std::unique_ptr<juce::FileOutputStream> stream_;
+
+        JUCE_DECLARE_NON_COPYABLE(Writer)
+    };
+
+    /**
+     * @brief Read a journal's complete batches, in order
+     * @return false if the file is missing or not a journal; an empty one is fine
+     */
+    static bool read(const juce::File& file, juce::int64& generation,
+                     std::vector<Record>& records);
+
+    /**
+     * @brief Apply records to a checkpoint's sections
+     *
+     * A section is replaced where it is and new ones go at the end; a track order record
+     * puts the track sections back in order. A project file record sets projectFile.
+     */
+    static void replay(const std::vector<Record>& records,
+                       std::vector<ProjectFile::SectionData>& sections,
+                       juce::File& projectFile);
+
+    // =========================================================================
+    // Autosave directory
+    // =========================================================================
+
+    static juce::File getCheckpointFile(const juce::File& directory, juce::int64 generation);
+    static juce::File getJournalFile(const juce::File& directory, juce::int64 generation);
+
+    /**
+     * @brief Whether directory holds anything to recover
+     */
+    static bool hasRecoveryData(const juce::File& directory);
+
+    /**
+     * @brief Delete the checkpoints and journals older than generation (all if 0)
+     */
+    static void deleteGenerationsBefore(const juce::File& directory, juce::int64 generation);
+
+    /**
+     * @brief Rebuild the autosaved project
+     *
+     * Replays every journal from the newest readable checkpoint onwards. The reader holds
+     * the checkpoint's plugin states, already read into memory so the directory can be
+     * cleared.
+     *
+     * @param projectFile Set to the file the project was saved as, invalid if never saved
+     * @return An error message, empty on success
+     */
+    static juce::String recover(const juce::File& directory, ProjectModel& model,
+                                std::shared_ptr<ProjectFile::Reader>& reader,
+                                juce::File& projectFile);
+
+  private:
+    ProjectJournal() = delete;
+};
+
+}  // namespace magda
@@ -0,0 +1,439 @@
+#include "ProjectManager.hpp"
+
+#include "../profiling/LoadProfiler.hpp"
+#include "AutomationManager.hpp"
+#include "ClipManager.hpp"
+#include "ProjectJournal.hpp"
+#include "SelectionManager.hpp"
+#include "TrackManager.hpp"
+#include "UndoManager.hpp"
+
+namespace magda {
+
+namespace {
+
+void collectDeviceIds(const std::vector<ChainElement>& elements, std::vector<DeviceId>& ids) {
+    for (const auto& element : elements) {
+        if (isDevice(element)) {
+            ids.push_back(getDevice(element).id);
+            continue;
+        }
+        for (const auto& chain : getRack(element).chains) {
+            collectDeviceIds(chain.elements, ids);
+        }
+    }
+}
+
+}  // namespace
+
+// =============================================================================
+// Jobs
+// =============================================================================
+
+/**
+ * @brief Encodes and writes a snapshot, carrying over plugin states still in the old file
+ */
+class ProjectManager::SaveJob : public juce::ThreadPoolJob {
+  public:
+    SaveJob(ProjectManager& manager, const juce::File& file, ProjectModel model,
+            std::shared_ptr<ProjectFile::Reader> pendingPlugins,
+            std::vector<DeviceId> pendingDevices, const juce::File& savedFile, uint64_t savedHash,
+            bool isCopy, Callback onDone)
+        : juce::ThreadPoolJob("Save project"),
+          manager_(manager),
+          file_(file),
+          model_(std::move(model)),
+          pendingPlugins_(std::move(pendingPlugins)),
+          pendingDevices_(std::move(pendingDevices)),
+          savedFile_(savedFile),
+          savedHash_(savedHash),
+          isCopy_(isCopy),
+          onDone_(std::move(onDone)),
+          alive_(manager.alive_) {}
+
+    JobStatus runJob() override {
+        if (pendingPlugins_ != nullptr && !pendingDevices_.empty()) {
+            model_.pluginStates.merge(pendingPlugins_->copyPendingPluginStates(pendingDevices_));
+        }
+
+        juce::String error;
+        const auto hash = ProjectFile::hashModel(model_);
+        if (file_ != savedFile_ || hash != savedHash_ || !file_.existsAsFile()) {
+            // The reader can't keep the file open while it is being replaced
+            if (pendingPlugins_ != nullptr && pendingPlugins_->getFile() == file_) {
+                pendingPlugins_->detachFromFile();
+            }
+            error = ProjectFile::write(file_, model_);
+        }
+
+        auto* manager = &manager_;
+        auto alive = alive_;
+        auto file = file_;
+        auto isCopy = isCopy_;
+        auto onDone = onDone_;
+        juce::MessageManager::callAsync([manager, alive, file, hash, isCopy, error, onDone]() {
+            if (alive->load()) {
+                manager->saveFinished(file, hash, isCopy, error, onDone);
+            }
+        });
+        return jobHasFinished;
+    }
+
+  private:
+    ProjectManager& manager_;
+    juce::File file_;
+    ProjectModel model_;
+    std::shared_ptr<ProjectFile::Reader> pendingPlugins_;
+    std::vector<DeviceId> pendingDevices_;
+    juce::File savedFile_;
+    uint64_t savedHash_;
+    bool isCopy_;
+    Callback onDone_;
+    std::shared_ptr<std::atomic<bool>> alive_;
+};
+
+/**
+ * @brief Reads and decodes a project's model, leaving its plugin states in the file
+ *
+ * A preload hands the result to preloadFinished() to hold instead of opening it.
+ */
+class ProjectManager::OpenJob : public juce::ThreadPoolJob {
+  public:
+    OpenJob(ProjectManager& manager, const juce::File& file, bool preload, Callback onDone)
+        : juce::ThreadPoolJob(preload ? "Preload project" : "Open project"),
+          manager_(manager),
+          file_(file),
+          preload_(preload),
+          onDone_(std::move(onDone)),
+          alive_(manager.alive_) {}
+
+    JobStatus runJob() override {
+        juce::String error;
+        std::shared_ptr<ProjectFile::Reader> reader;
+        auto model = std::make_shared<ProjectModel>();
+        {
+            LoadProfiler::ScopedPhase phase("Read project");
+            reader = ProjectFile::Reader::open(file_, error);
+            if (reader != nullptr) {
+                error = reader->readModel(*model);
+            }
+        }
+
+        auto* manager = &manager_;
+        auto alive = alive_;
+        auto file = file_;
+        auto preload = preload_;
+        auto onDone = onDone_;
+        juce::MessageManager::callAsync(
+            [manager, alive, file, preload, model, reader, error, onDone]() {
+                if (!alive->load()) {
+                    return;
+                }
+                auto decoded = std::make_unique<ProjectModel>(std::move(*model));
+                if (preload) {
+                    manager->preloadFinished(file, std::move(decoded), reader, error, onDone);
+                } else {
+                    manager->openFinished(file, std::move(decoded), reader, error, onDone);
+                }
+            });
+        return jobHasFinished;
+    }
+
+  private:
+    ProjectManager& manager_;
+    juce::File file_;
+    bool preload_;
+    Callback onDone_;
+    std::shared_ptr<std::atomic<bool>> alive_;
+};
+
+/**
+ * @brief Rebuilds an autosaved project from its checkpoint and journals
+ */
+class ProjectManager::RecoverJob : public juce::ThreadPoolJob {
+  public:
+    RecoverJob(ProjectManager& manager, const juce::File& directory, Callback onDone)
+        : juce::ThreadPoolJob("Recover project"),
+          manager_(manager),
+          directory_(directory),
+          onDone_(std::move(onDone)),
+          alive_(manager.alive_) {}
+
+    JobStatus runJob() override {
+        auto model = std::make_shared<ProjectModel>();
+        std::shared_ptr<ProjectFile::Reader> reader;
+        juce::File projectFile;
+        juce::String error;
+        {
+            LoadProfiler::ScopedPhase phase("Read autosave");
+            error = ProjectJournal::recover(directory_, *model, reader, projectFile);
+        }
+
+        auto* manager = &manager_;
+        auto alive = alive_;
+        auto onDone = onDone_;
+        juce::MessageManager::callAsync(
+            [manager, alive, projectFile, model, reader, error, onDone]() {
+                if (alive->load()) {
+                    manager->openFinished(projectFile,
+                                          std::make_unique<ProjectModel>(std::move(*model)),
+                                          reader, error, onDone);
+                }
+            });
+        return jobHasFinished;
+    }
+
+  private:
+    ProjectManager& manager_;
+    juce::File directory_;
+    Callback onDone_;
+    std::shared_ptr<std::atomic<bool>> alive_;
+};
+
+// =============================================================================
+// ProjectManager
+// =============================================================================
+
+ProjectManager& ProjectManager::getInstance() {
+    static ProjectManager instance;
+    return instance;
+}
+
+ProjectManager::ProjectManager() : pool_(std::make_unique<juce::ThreadPool>(1)) {}
+
+ProjectManager::~ProjectManager() {
+    alive_->store(false);
+    pool_->removeAllJobs(false, 10000);  // Let a running save finish writing
+    pool_.reset();
+}
+
+void ProjectManager::saveAsync(const juce::File& file, Callback onDone) {
+    if (busy_) {
+        queuedSave_ = std::make_unique<QueuedSave>(QueuedSave{file, std::move(onDone)});
+        return;
+    }
+
+    busy_ = true;
+    std::vector<DeviceId> pendingDevices;
+    auto model = captureModel(pendingDevices);
+    pool_->addJob(new SaveJob(*this, file, std::move(model), pendingPlugins_,
+                              std::move(pendingDevices), savedFile_, savedHash_, false,
+                              std::move(onDone)),
+                  true);
+}
+
+bool ProjectManager::saveCopyAsync(const juce::File& file, Callback onDone) {
+    if (busy_) {
+        return false;
+    }
+
+    busy_ = true;
+    std::vector<DeviceId> pendingDevices;
+    auto model = captureModel(pendingDevices);
+    pool_->addJob(new SaveJob(*this, file, std::move(model), pendingPlugins_,
+                              std::move(pendingDevices), juce::File(), 0, true,
+                              std::move(onDone)),
+                  true);
+    return true;
+}
+
+void ProjectManager::openAsync(const juce::File& file, Callback onDone) {
+    if (busy_) {
+        if (onDone) {
+            onDone("Wait for the current save to finish");
+        }
+        return;
+    }
+
+    busy_ = true;
+    LoadProfiler::getInstance().begin("Open " + file.getFileName());
+    pool_->addJob(new OpenJob(*this, file, false, std::move(onDone)), true);
+}
+
+void ProjectManager::preloadAsync(const juce::File& file, Callback onDone) {
+    if (busy_) {
+        if (onDone) {
+            onDone("Wait for the current save to finish");
+        }
+        return;
+    }
+
+    busy_ = true;
+    preloaded_.reset();
+    pool_->addJob(new OpenJob(*this, file, true, std::move(onDone)), true);
+}
+
+juce::String ProjectManager::openPreloaded() {
+    if (preloaded_ == nullptr) {
+        return "No project is preloaded";
+    }
+    if (busy_) {
+        return "Wait for the current save to finish";
+    }
+
+    auto preloaded = std::move(preloaded_);
+    juce::String error;
+    LoadProfiler::getInstance().begin("Switch to " + preloaded->file.getFileName());
+    openFinished(preloaded->file, std::move(preloaded->model), std::move(preloaded->reader), {},
+                 [&error](const juce::String& e) { error = e; });
+    return error;
+}
+
+void ProjectManager::recoverAsync(const juce::File& autosaveDirectory, Callback onDone) {
+    if (busy_) {
+        if (onDone) {
+            onDone("Wait for the current save to finish");
+        }
+        return;
+    }
+
+    busy_ = true;
+    LoadProfiler::getInstance().begin("Recover autosave");
+    pool_->addJob(new RecoverJob(*this, autosaveDirectory, std::move(onDone)), true);
+}
+
+juce::ValueTree ProjectManager::takePluginState(DeviceId deviceId) {
+    if (pendingPlugins_ == nullptr) {
+        return {};
+    }
+
+    auto state = pendingPlugins_->takePluginState(deviceId);
+    if (pendingPlugins_->getPendingPluginStates().empty()) {
+        pendingPlugins_.reset();
+    }
+    return state;
+}
+
+juce::File ProjectManager::getMediaFolder(const juce::String& kind) const {
+    if (currentFile_ != juce::File()) {
+        return currentFile_.getSiblingFile(currentFile_.getFileNameWithoutExtension() + " " +
+                                           kind);
+    }
+    return juce::File::getSpecialLocation(juce::File::userMusicDirectory)
+        .getChildFile("MAGDA")
+        .getChildFile(kind);
+}
+
+int ProjectManager::getNumPendingPluginStates() const {
+    return pendingPlugins_ != nullptr
+               ? static_cast<int>(pendingPlugins_->getPendingPluginStates().size())
+               : 0;
+}
+
+ProjectModel ProjectManager::captureModel(std::vector<DeviceId>& pendingDevices) const {
+    const auto& trackManager = TrackManager::getInstance();
+    const auto& automationManager = AutomationManager::getInstance();
+
+    ProjectModel model;
+    model.tracks = trackManager.getTracks();
+    model.master = trackManager.getMasterChannel();
+    model.clips = ClipManager::getInstance().getClips();
+    model.automationLanes = automationManager.getLanes();
+    model.automationClips = automationManager.getClips();
+
+    std::vector<DeviceId> deviceIds;
+    for (const auto& track : model.tracks) {
+        collectDeviceIds(track.chainElements, deviceIds);
+    }
+
+    // Live plugins are asked now; states the engine hasn't taken yet come from the file
+    for (auto deviceId : deviceIds) {
+        if (pendingPlugins_ != nullptr && pendingPlugins_->hasPluginState(deviceId)) {
+            pendingDevices.push_back(deviceId);
+            continue;
+        }
+        if (pluginStateProvider_) {
+            auto state = pluginStateProvider_(deviceId);
+            if (state.isValid()) {
+                model.pluginStates[deviceId].tree = std::move(state);
+            }
+        }
+    }
+    return model;
+}
+
+void ProjectManager::saveFinished(const juce::File& file, uint64_t hash, bool isCopy,
+                                  const juce::String& error, const Callback& onDone) {
+    busy_ = false;
+    if (error.isEmpty() && !isCopy) {
+        currentFile_ = file;
+        savedFile_ = file;
+        savedHash_ = hash;
+    } else if (error.isNotEmpty()) {
+        DBG("ProjectManager: save failed - " << error);
+    }
+
+    if (onDone) {
+        onDone(error);
+    }
+    runQueuedSave();
+}
+
+void ProjectManager::openFinished(const juce::File& file, std::unique_ptr<ProjectModel> model,
+                                  std::shared_ptr<ProjectFile::Reader> reader,
+                                  const juce::String& error, const Callback& onDone) {
+    busy_ = false;
+    if (error.isNotEmpty()) {
+        DBG("ProjectManager: open failed - " << error);
+        LoadProfiler::getInstance().finish();
+        if (onDone) {
+            onDone(error);
+        }
+        runQueuedSave();
+        return;
+    }
+
+    // In place before the tracks arrive, so the engine finds the states as it loads plugins
+    pendingPlugins_ = reader->getPendingPluginStates().empty() ? nullptr : std::move(reader);
+
+    {
+        // Includes the engine sync the new tracks trigger; queued plugins load after it
+        LoadProfiler::ScopedPhase phase("Apply project");
+        SelectionManager::getInstance().clearSelection();
+        UndoManager::getInstance().clearHistory();
+        ClipManager::getInstance().clearAllClips();
+        AutomationManager::getInstance().clearAll();
+
+        TrackManager::getInstance().loadTracks(std::move(model->tracks), model->master);
+        ClipManager::getInstance().loadClips(std::move(model->clips));
+        AutomationManager::getInstance().loadAutomation(std::move(model->automationLanes),
+                                                        std::move(model->automationClips));
+    }
+    LoadProfiler::getInstance().finish();
+
+    // Nothing written since opening: the first save always writes
+    currentFile_ = file;
+    savedFile_ = juce::File();
+    savedHash_ = 0;
+
+    if (onDone) {
+        onDone({});
+    }
+    runQueuedSave();
+}
+
+void ProjectManager::preloadFinished(const juce::File& file, std::unique_ptr<ProjectModel> model,
+                                     std::shared_ptr<ProjectFile::Reader> reader,
+                                     const juce::String& error, const Callback& onDone) {
+    busy_ = false;
+    if (error.isEmpty()) {
+        preloaded_ = std::make_unique<Preloaded>(
+            Preloaded{file, std::move(model), std::move(reader)});
+    } else {
+        DBG("ProjectManager: preload failed - " << error);
+    }
+
+    if (onDone) {
+        onDone(error);
+    }
+    runQueuedSave();
+}
+
+void ProjectManager::runQueuedSave() {
+    if (queuedSave_ != nullptr) {
+        auto queued = std::move(queuedSave_);
+        saveAsync(queued->file, std::move(queued->onDone));
+    }
+}
+
+}  // namespace magda
@@ -0,0 +1,187 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <juce_events/juce_events.h>
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+#include "ProjectFile.hpp"
+
+namespace magda {
+
+/**
+ * @brief Saves and opens projects without blocking the message thread
+ *
+ * A save takes a snapshot of the track, clip and automation managers on the message
+ * thread (chains are shared copy-on-write, so this is cheap) along with a copy of each
+ * instantiated plugin's state, then encodes and writes it on a pool thread. A save that
+ * would write exactly what the last one did is skipped.
+ *
+ * Opening reads and decodes the model on the pool thread and hands it to the managers in
+ * one go. Plugin states stay in the file: the engine takes each one when it instantiates
+ * that device, so a project is playable while its plugins are still loading. States not
+ * taken yet are carried into the next save.
+ *
+ * A project can also be preloaded: read and decoded while the current one keeps playing,
+ * then applied by openPreloaded() when it's wanted, so the change itself costs only the
+ * managers' reload.
+ *
+ * Message thread only, apart from its own pool thread.
+ */
+class ProjectManager {
+  public:
+    static ProjectManager& getInstance();
+
+    // Prevent copying
+    ProjectManager(const ProjectManager&) = delete;
+    ProjectManager& operator=(const ProjectManager&) = delete;
+
+    /**
+     * @brief Called with an empty string on success, otherwise the error to show
+     */
+    using Callback = std::function<void(const juce::String& error)>;
+
+    /**
+     * @brief Returns a copy of an instantiated plugin's state, invalid if it has none
+     */
+    using PluginStateProvider = std::function<juce::ValueTree(DeviceId)>;
+
+    /**
+     * @brief Set by the audio engine so saves include plugin state
+     */
+    void setPluginStateProvider(PluginStateProvider provider) {
+        pluginStateProvider_ = std::move(provider);
+    }
+
+    /**
+     * @brief Save the current project; a save while one is running follows it
+     */
+    void saveAsync(const juce::File& file, Callback onDone = nullptr);
+
+    /**
+     * @brief Write the current project to file without making it the project's file
+     *
+     * Used for autosave checkpoints, so always writes.
+     * @return false, doing nothing, if a save or open is running
+     */
+    bool saveCopyAsync(const juce::File& file, Callback onDone = nullptr);
+
+    /**
+     * @brief Replace the current project with the one in file
+     */
+    void openAsync(const juce::File& file, Callback onDone = nullptr);
+
+    /**
+     * @brief Replace the current project with the one autosaved in directory
+     *
+     * The recovered project takes the file it had been saved as, if any, but is unsaved.
+     */
+    void recoverAsync(const juce::File& autosaveDirectory, Callback onDone = nullptr);
+
+    /**
+     * @brief Read and decode the project in file without opening it
+     *
+     * Replaces any project preloaded earlier. The current project is untouched.
+     */
+    void preloadAsync(const juce::File& file, Callback onDone = nullptr);
+
+    /**
+     * @brief Replace the current project with the preloaded one, synchronously
+     * @return Empty on success, otherwise the error (nothing preloaded, or busy)
+     */
+    juce::String openPreloaded();
+
+    void discardPreloaded() {
+        preloaded_.reset();
+    }
+
+    bool hasPreloadedProject() const {
+        return preloaded_ != nullptr;
+    }
+
+    /**
+     * @brief The preloaded project's model, nullptr if none (for warming what it uses)
+     */
+    const ProjectModel* getPreloadedModel() const {
+        return preloaded_ != nullptr ? preloaded_->model.get() : nullptr;
+    }
+
+    juce::File getPreloadedFile() const {
+        return preloaded_ != nullptr ? preloaded_->file : juce::File();
+    }
+
+    bool isBusy() const {
+        return busy_;
+    }
+
+    /**
+     * @brief The file last saved or opened, invalid for an unsaved project
+     */
+    const juce::File& getCurrentFile() const {
+        return currentFile_;
+    }
+
+    /**
+     * @brief Folder for media the project creates, e.g. "Recordings" or "Imported Audio"
+     *
+     * Next to the project file ("<project> Recordings"), or under the user's music folder
+     * while the project is unsaved. Not created here.
+     */
+    juce::File getMediaFolder(const juce::String& kind) const;
+
+    /**
+     * @brief The opened project's saved state for a device, handed over once
+     *
+     * Called by the engine as it instantiates each device.
+     */
+    juce::ValueTree takePluginState(DeviceId deviceId);
+
+    int getNumPendingPluginStates() const;
+
+  private:
+    ProjectManager();
+    ~ProjectManager();
+
+    class SaveJob;
+    class OpenJob;
+    class RecoverJob;
+
+    struct QueuedSave {
+        juce::File file;
+        Callback onDone;
+    };
+
+    struct Preloaded {
+        juce::File file;
+        std::unique_ptr<ProjectModel> model;
+        std::shared_ptr<ProjectFile::Reader> reader;
+    };
+
+    ProjectModel captureModel(std::vector<DeviceId>& pendingDevices) const;
+    void saveFinished(const juce::File& file, uint64_t hash, bool isCopy,
+                      const juce::String& error, const Callback& onDone);
+    void openFinished(const juce::File& file, std::unique_ptr<ProjectModel> model,
+                      std::shared_ptr<ProjectFile::Reader> reader, const juce::String& error,
+                      const Callback& onDone);
+    void preloadFinished(const juce::File& file, std::unique_ptr<ProjectModel> model,
+                         std::shared_ptr<ProjectFile::Reader> reader, const juce::String& error,
+                         const Callback& onDone);
+    void runQueuedSave();
+
+    PluginStateProvider pluginStateProvider_;
+    std::shared_ptr<ProjectFile::Reader> pendingPlugins_;  // From the last open
+    juce::File currentFile_;
+    juce::File savedFile_;
+    uint64_t savedHash_ = 0;  // Content of savedFile_, as far as we wrote it
+    bool busy_ = false;
+    std::unique_ptr<QueuedSave> queuedSave_;
+    std::unique_ptr<Preloaded> preloaded_;
+
+    std::unique_ptr<juce::ThreadPool> pool_;
+    std::shared_ptr<std::atomic<bool>> alive_ = std::make_shared<std::atomic<bool>>(true);
+};
+
+}  // namespace magda
@@ -0,0 +1,209 @@
+#include "ProjectSnapshot.hpp"
+
+#include <algorithm>
+
+namespace magda {
+
+// =============================================================================
+// ProjectSnapshot
+// =============================================================================
+
+std::vector<TrackId> ProjectSnapshot::getTrackIds() const {
+    std::vector<TrackId> ids;
+    ids.reserve(tracks.size());
+    for (const auto& track : tracks) {
+        ids.push_back(track.id);
+    }
+    return ids;
+}
+
+const TrackInfo* ProjectSnapshot::findTrack(TrackId trackId) const {
+    auto it = trackPositions_.find(trackId);
+    return it != trackPositions_.end() ? &tracks[it->second] : nullptr;
+}
+
+const ClipInfo* ProjectSnapshot::findClip(ClipId clipId) const {
+    auto it = clipPositions_.find(clipId);
+    return it != clipPositions_.end() ? clips[it->second].get() : nullptr;
+}
+
+std::vector<const ClipInfo*> ProjectSnapshot::getClipsOnTrack(TrackId trackId) const {
+    std::vector<const ClipInfo*> result;
+    for (const auto& clip : clips) {
+        if (clip->trackId == trackId) {
+            result.push_back(clip.get());
+        }
+    }
+    std::stable_sort(result.begin(), result.end(), [](const ClipInfo* a, const ClipInfo* b) {
+        return a->startTime < b->startTime;
+    });
+    return result;
+}
+
+// =============================================================================
+// ProjectSnapshotPublisher
+// =============================================================================
+
+ProjectSnapshotPublisher& ProjectSnapshotPublisher::getInstance() {
+    static ProjectSnapshotPublisher instance;
+    return instance;
+}
+
+ProjectSnapshotPublisher::ProjectSnapshotPublisher()
+    : latest_(std::make_shared<const ProjectSnapshot>()) {}
+
+ProjectSnapshotPublisher::~ProjectSnapshotPublisher() {
+    shutdown();
+}
+
+void ProjectSnapshotPublisher::start() {
+    if (running_) {
+        return;
+    }
+
+    running_ = true;
+    TrackManager::getInstance().addListener(this);
+    ClipManager::getInstance().addListener(this);
+
+    tracksDirty_ = true;
+    clipsReset_ = true;
+    publish();
+}
+
+void ProjectSnapshotPublisher::shutdown() {
+    if (!running_) {
+        return;
+    }
+
+    running_ = false;
+    cancelPendingUpdate();
+    TrackManager::getInstance().removeListener(this);
+    ClipManager::getInstance().removeListener(this);
+    dirtyClips_.clear();
+
+    std::lock_guard<std::mutex> lock(latestLock_);
+    latest_ = std::make_shared<const ProjectSnapshot>();
+}
+
+std::shared_ptr<const ProjectSnapshot> ProjectSnapshotPublisher::getLatest() const {
+    std::lock_guard<std::mutex> lock(latestLock_);
+    return latest_;
+}
+
+std::shared_ptr<const ProjectSnapshot> ProjectSnapshotPublisher::publishNow() {
+    if (running_) {
+        cancelPendingUpdate();
+        publish();
+    }
+    return getLatest();
+}
+
+// =============================================================================
+// Change tracking
+// =============================================================================
+
+void ProjectSnapshotPublisher::markTracksDirty() {
+    tracksDirty_ = true;
+    triggerAsyncUpdate();
+}
+
+void ProjectSnapshotPublisher::tracksChanged() {
+    markTracksDirty();
+}
+
+void ProjectSnapshotPublisher::trackPropertyChanged(int) {
+    markTracksDirty();
+}
+
+void ProjectSnapshotPublisher::masterChannelChanged() {
+    markTracksDirty();
+}
+
+void ProjectSnapshotPublisher::trackDevicesChanged(TrackId) {
+    markTracksDirty();
+}
+
+void ProjectSnapshotPublisher::devicePropertyChanged(DeviceId) {
+    markTracksDirty();
+}
+
+void ProjectSnapshotPublisher::deviceParameterChanged(DeviceId, int, float) {
+    markTracksDirty();
+}
+
+void ProjectSnapshotPublisher::clipsChanged() {
+    clipsReset_ = true;
+    dirtyClips_.clear();
+    triggerAsyncUpdate();
+}
+
+void ProjectSnapshotPublisher::clipPropertyChanged(ClipId clipId) {
+    if (!clipsReset_) {
+        dirtyClips_.insert(clipId);
+    }
+    triggerAsyncUpdate();
+}
+
+void ProjectSnapshotPublisher::clipPlaybackStateChanged(ClipId clipId) {
+    clipPropertyChanged(clipId);
+}
+
+void ProjectSnapshotPublisher::handleAsyncUpdate() {
+    publish();
+}
+
+// =============================================================================
+// Publishing
+// =============================================================================
+
+void ProjectSnapshotPublisher::publish() {
+    const auto previous = getLatest();
+    if (!tracksDirty_ && !clipsReset_ && dirtyClips_.empty()) {
+        return;
+    }
+
+    auto snapshot = std::make_shared<ProjectSnapshot>();
+    snapshot->version = previous->version + 1;
+
+    if (tracksDirty_) {
+        const auto& trackManager = TrackManager::getInstance();
+        snapshot->tracks = trackManager.getTracks();
+        snapshot->master = trackManager.getMasterChannel();
+        for (size_t i = 0; i < snapshot->tracks.size(); ++i) {
+            snapshot->trackPositions_[snapshot->tracks[i].id] = i;
+        }
+    } else {
+        snapshot->tracks = previous->tracks;
+        snapshot->master = previous->master;
+        snapshot->trackPositions_ = previous->trackPositions_;
+    }
+
+    const auto& clips = ClipManager::getInstance().getClips();
+    snapshot->clips.reserve(clips.size());
+    for (const auto& clip : clips) {
+        std::shared_ptr<const ClipInfo> shared;
+        if (!clipsReset_ && dirtyClips_.count(clip.id) == 0) {
+            auto it = previous->clipPositions_.find(clip.id);
+            if (it != previous->clipPositions_.end()) {
+                shared = previous->clips[it->second];
+            }
+        }
+        if (!shared) {
+            auto copy = std::make_shared<ClipInfo>(clip);
+            // Build the note index here, so readers on other threads only ever read it
+            copy->midiNotes.prepareIndex();
+            shared = std::move(copy);
+        }
+        snapshot->clipPositions_[clip.id] = snapshot->clips.size();
+        snapshot->clips.push_back(std::move(shared));
+    }
+
+    tracksDirty_ = false;
+    clipsReset_ = false;
+    dirtyClips_.clear();
+
+    std::lock_guard<std::mutex> lock(latestLock_);
+    latest_ = std::move(snapshot);
+}
+
+}  // namespace magda
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <juce_events/juce_events.h>
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "ClipManager.hpp"
+#include "TrackManager.hpp"
+
+namespace magda {
+
+/**
+ * @brief An immutable copy of the project's tracks and clips, readable from any thread
+ *
+ * Tracks are copied whole (their device trees are shared with the model through CowPtr, so
+ * that costs a few refcounts per track); clips are held through shared pointers, so a clip
+ * that hasn't changed since the last snapshot is the same object in both. Nothing in a
+ * snapshot changes after it is published.
+ */
+struct ProjectSnapshot {
+    uint64_t version = 0;                                // Increases with every publish
+    std::vector<TrackInfo> tracks;                       // In track order
+    std::vector<std::shared_ptr<const ClipInfo>> clips;  // Arrangement and session
+    MasterChannelState master;
+
+    std::vector<TrackId> getTrackIds() const;
+    const TrackInfo* findTrack(TrackId trackId) const;
+    const ClipInfo* findClip(ClipId clipId) const;
+
+    /**
+     * @brief Clips on a track, by start time
+     */
+    std::vector<const ClipInfo*> getClipsOnTrack(TrackId trackId) const;
+
+  private:
+    friend class ProjectSnapshotPublisher;
+
+    std::unordered_map<TrackId, size_t> trackPositions_;
+    std::unordered_map<ClipId, size_t> clipPositions_;
+};
+
+/**
+ * @brief Keeps a ProjectSnapshot of the live model for readers off the message thread
+ *
+ * Agents querying TrackManager and ClipManager directly have to be on the message thread,
+ * so a large query stalls the UI. Instead they take getLatest(), which is a refcount under
+ * a short lock, and walk it on their own thread for as long as they like.
+ *
+ * Edits mark what changed and a new snapshot is published once per message-loop turn:
+ * every track is re-copied, but only the clips that were edited are; a structural change
+ * to the clip list copies them all. Call publishNow() on the message thread to read the
+ * result of an edit just made.
+ */
+class ProjectSnapshotPublisher : public TrackManagerListener,
+                                 public ClipManagerListener,
+                                 private juce::AsyncUpdater {
+  public:
+    static ProjectSnapshotPublisher& getInstance();
+
+    // Prevent copying
+    ProjectSnapshotPublisher(const ProjectSnapshotPublisher&) = delete;
+    ProjectSnapshotPublisher& operator=(const ProjectSnapshotPublisher&) = delete;
+
+    /**
+     * @brief Start following the model, publishing a first snapshot (message thread)
+     */
+    void start();
+
+    /**
+     * @brief Stop following the model and drop the latest snapshot; call before the
+     *        managers shut down
+     */
+    void shutdown();
+
+    bool isRunning() const {
+        return running_;
+    }
+
+    /**
+     * @brief The latest snapshot (never null; empty until start()). Safe from any thread.
+     */
+    std::shared_ptr<const ProjectSnapshot> getLatest() const;
+
+    /**
+     * @brief Publish any pending edits now instead of on the next message-loop turn
+     */
+    std::shared_ptr<const ProjectSnapshot> publishNow();
+
+    // TrackManagerListener
+    void tracksChanged() override;
+    void trackPropertyChanged(int trackId) override;
+    void masterChannelChanged() override;
+    void trackDevicesChanged(TrackId trackId) override;
+    void devicePropertyChanged(DeviceId deviceId) override;
+    void deviceParameterChanged(DeviceId deviceId, int paramIndex, float newValue) override;
+
+    // ClipManagerListener
+    void clipsChanged() override;
+    void clipPropertyChanged(ClipId clipId) override;
+    void clipPlaybackStateChanged(ClipId clipId) override;
+
+  private:
+    ProjectSnapshotPublisher();
+    ~ProjectSnapshotPublisher() override;
+
+    void handleAsyncUpdate() override;
+    void markTracksDirty();
+    void publish();
+
+    mutable std::mutex latestLock_;
+    std::shared_ptr<const ProjectSnapshot> latest_;
+
+    bool running_ = false;
+    bool tracksDirty_ = false;
+    bool clipsReset_ = false;               // Clip list changed: copy every clip
+    std::unordered_set<ClipId> dirtyClips_;  // Otherwise just these
+};
+
+}  // namespace magda
@@ -2,10 +2,12 @@
 
 #include <juce_core/juce_core.h>
 
+#include <algorithm>
 #include <memory>
 #include <variant>
 #include <vector>
 
+#include "CowPtr.hpp"
 #include "DeviceInfo.hpp"
 #include "MacroInfo.hpp"
 #include "ModInfo.hpp"
@@ -19,37 +21,37 @@ struct RackInfo;
 /**
  * @brief A chain element can be either a device or a nested rack
  *
- * Uses unique_ptr for RackInfo to handle the recursive structure
- * (RackInfo contains ChainInfo which contains ChainElement which can be RackInfo)
+ * Both are held through CowPtr, which also handles the recursive structure
+ * (RackInfo contains ChainInfo which contains ChainElement which can be RackInfo).
+ * Copying a chain shares every node; the const accessors below only read, while
+ * the non-const ones unshare the node first, so use the const versions (or the
+ * *WithId helpers) when just searching.
  */
-using ChainElement = std::variant<DeviceInfo, std::unique_ptr<RackInfo>>;
-
-// Forward declare deep copy function (defined after RackInfo)
-ChainElement deepCopyElement(const ChainElement& element);
+using ChainElement = std::variant<CowPtr<DeviceInfo>, CowPtr<RackInfo>>;
 
 // Helper functions for working with ChainElement
 inline bool isDevice(const ChainElement& element) {
-    return std::holds_alternative<DeviceInfo>(element);
+    return std::holds_alternative<CowPtr<DeviceInfo>>(element);
 }
 
 inline bool isRack(const ChainElement& element) {
-    return std::holds_alternative<std::unique_ptr<RackInfo>>(element);
+    return std::holds_alternative<CowPtr<RackInfo>>(element);
 }
 
 inline DeviceInfo& getDevice(ChainElement& element) {
-    return std::get<DeviceInfo>(element);
+    return std::get<CowPtr<DeviceInfo>>(element).write();
 }
 
 inline const DeviceInfo& getDevice(const ChainElement& element) {
-    return std::get<DeviceInfo>(element);
+    return std::get<CowPtr<DeviceInfo>>(element).read();
 }
 
 inline RackInfo& getRack(ChainElement& element) {
-    return *std::get<std::unique_ptr<RackInfo>>(element);
+    return std::get<CowPtr<RackInfo>>(element).write();
 }
 
 inline const RackInfo& getRack(const ChainElement& element) {
-    return *std::get<std::unique_ptr<RackInfo>>(element);
+    return std::get<CowPtr<RackInfo>>(element).read();
 }
 
 /**
@@ -62,7 +64,7 @@ inline const RackInfo& getRack(const ChainElement& element) {
 struct ChainInfo {
     ChainId id = INVALID_CHAIN_ID;
     juce::String name;                   // e.g., "Chain 1"
-    std::vector<ChainElement> elements;  // Ordered sequence of devices/racks
+    std::vector<ChainElement> elements;  // Ordered sequence of devices/racks (shared on copy)
     int outputIndex = 0;                 // Output routing (0 = main, 1-N = aux)
     bool muted = false;
     bool solo = false;
@@ -72,49 +74,6 @@ struct ChainInfo {
     // UI state
     bool expanded = true;
 
-    // Default constructor
-    ChainInfo() = default;
-
-    // Move operations (default is fine)
-    ChainInfo(ChainInfo&&) = default;
-    ChainInfo& operator=(ChainInfo&&) = default;
-
-    // Copy constructor - deep copies elements
-    ChainInfo(const ChainInfo& other)
-        : id(other.id),
-          name(other.name),
-          outputIndex(other.outputIndex),
-          muted(other.muted),
-          solo(other.solo),
-          volume(other.volume),
-          pan(other.pan),
-          expanded(other.expanded) {
-        elements.reserve(other.elements.size());
-        for (const auto& element : other.elements) {
-            elements.push_back(deepCopyElement(element));
-        }
-    }
-
-    // Copy assignment - deep copies elements
-    ChainInfo& operator=(const ChainInfo& other) {
-        if (this != &other) {
-            id = other.id;
-            name = other.name;
-            outputIndex = other.outputIndex;
-            muted = other.muted;
-            solo = other.solo;
-            volume = other.volume;
-            pan = other.pan;
-            expanded = other.expanded;
-            elements.clear();
-            elements.reserve(other.elements.size());
-            for (const auto& element : other.elements) {
-                elements.push_back(deepCopyElement(element));
-            }
-        }
-        return *this;
-    }
-
     // Convenience methods for backward compatibility
     std::vector<DeviceInfo*> getDevices() {
         std::vector<DeviceInfo*> devices;
@@ -159,61 +118,96 @@ struct RackInfo {
 
     // Modulators for rack-wide modulation
     ModArray mods = createDefaultMods();
+};
+
+// Id checks that never unshare the element (defined after RackInfo is complete)
+inline bool isDeviceWithId(const ChainElement& element, DeviceId deviceId) {
+    return isDevice(element) && getDevice(element).id == deviceId;
+}
 
-    // Default constructor
-    RackInfo() = default;
-
-    // Move operations (default is fine)
-    RackInfo(RackInfo&&) = default;
-    RackInfo& operator=(RackInfo&&) = default;
-
-    // Copy constructor
-    RackInfo(const RackInfo& other)
-        : id(other.id),
-          name(other.name),
-          chains(other.chains),  // ChainInfo has its own deep copy
-          bypassed(other.bypassed),
-          expanded(other.expanded),
-          volume(other.volume),
-          pan(other.pan),
-          macros(other.macros),
-          mods(other.mods) {}
-
-    // Copy assignment
-    RackInfo& operator=(const RackInfo& other) {
-        if (this != &other) {
-            id = other.id;
-            name = other.name;
-            chains = other.chains;  // ChainInfo has its own deep copy
-            bypassed = other.bypassed;
-            expanded = other.expanded;
-            volume = other.volume;
-            pan = other.pan;
-            macros = other.macros;
-            mods = other.mods;
+inline bool isRackWithId(const ChainElement& element, RackId rackId) {
+    return isRack(element) && getRack(element).id == rackId;
+}
+
+// The most oversampling any device in the elements asks for, in racks too (at least 1)
+inline int getMaxOversampling(const std::vector<ChainElement>& elements) {
+    int factor = 1;
+    for (const auto& element : elements) {
+        if (isDevice(element)) {
+            factor = std::max(factor, getDevice(element).oversampling);
+        } else {
+            for (const auto& chain : getRack(element).chains) {
+                factor = std::max(factor, getMaxOversampling(chain.elements));
+            }
         }
-        return *this;
     }
-};
+    return factor;
+}
 
-// Implementation of deep copy for ChainElement (must be after RackInfo is complete)
-inline ChainElement deepCopyElement(const ChainElement& element) {
-    if (isDevice(element)) {
-        return getDevice(element);  // DeviceInfo is copyable
-    } else {
-        // Deep copy the nested rack
-        return std::make_unique<RackInfo>(getRack(element));
+// Whether every device in the elements, in racks too, is one of MAGDA's own (no external
+// plugin), so a render of them is deterministic down to the bit
+inline bool usesOnlyBuiltInDevices(const std::vector<ChainElement>& elements) {
+    for (const auto& element : elements) {
+        if (isDevice(element)) {
+            if (getDevice(element).format != PluginFormat::Internal) {
+                return false;
+            }
+        } else {
+            for (const auto& chain : getRack(element).chains) {
+                if (!usesOnlyBuiltInDevices(chain.elements)) {
+                    return false;
+                }
+            }
+        }
     }
+    return true;
 }
 
 // Factory function to create a ChainElement from a RackInfo
 inline ChainElement makeRackElement(RackInfo rack) {
-    return std::make_unique<RackInfo>(std::move(rack));
+    return CowPtr<RackInfo>(std::move(rack));
 }
 
 // Factory function to create a ChainElement from a DeviceInfo
 inline ChainElement makeDeviceElement(DeviceInfo device) {
-    return device;
+    return CowPtr<DeviceInfo>(std::move(device));
+}
+
+// Heap footprint of a mod or macro bank, links included
+template <typename Array> size_t estimateModulationBytes(const Array& slots) {
+    size_t bytes = slots.capacity() * sizeof(typename Array::value_type);
+    for (const auto& slot : slots) {
+        bytes += slot.links.capacity() * sizeof(slot.links[0]);
+    }
+    return bytes;
+}
+
+/**
+ * @brief Approximate heap footprint of a device chain, nested racks included
+ *
+ * Counts each device with its parameters, mods and macros, and each rack with its
+ * chains. Chains share nodes on copy (see ChainElement), so a copy held for undo reports
+ * the full size even while it still shares storage with the live chain.
+ */
+inline size_t estimateChainBytes(const std::vector<ChainElement>& elements) {
+    size_t bytes = elements.capacity() * sizeof(ChainElement);
+    for (const auto& element : elements) {
+        if (isDevice(element)) {
+            const auto& device = getDevice(element);
+            bytes += sizeof(DeviceInfo) + device.parameters.estimateHeapBytes() +
+                     device.visibleParameters.capacity() * sizeof(int) +
+                     estimateModulationBytes(device.mods) +
+                     estimateModulationBytes(device.macros);
+        } else {
+            const auto& rack = getRack(element);
+            bytes += sizeof(RackInfo) + rack.chains.capacity() * sizeof(ChainInfo) +
+                     estimateModulationBytes(rack.mods) + estimateModulationBytes(rack.macros);
+            for (const auto& chain : rack.chains) {
+                bytes += estimateChainBytes(chain.elements);
+            }
+        }
+    }
+    return bytes;
 }
 
 }  // namespace magda
@@ -1,12 +1,46 @@
 #include "SelectionManager.hpp"
 
 #include <algorithm>
+#include <iterator>
+#include <utility>
 
 #include "ClipManager.hpp"
 #include "TrackManager.hpp"
 
 namespace magda {
 
+namespace {
+
+// Kinds of notification held back by a batch, announced in this order when it ends
+enum PendingNotification : uint32_t {
+    kTypeChanged = 1u << 0,
+    kTrack = 1u << 1,
+    kClip = 1u << 2,
+    kMultiClip = 1u << 3,
+    kTimeRange = 1u << 4,
+    kNote = 1u << 5,
+    kDevice = 1u << 6,
+    kChainNode = 1u << 7,
+    kMod = 1u << 8,
+    kMacro = 1u << 9,
+    kModsPanel = 1u << 10,
+    kMacrosPanel = 1u << 11,
+    kParam = 1u << 12,
+    kAutomationLane = 1u << 13,
+    kAutomationClip = 1u << 14,
+    kAutomationPoint = 1u << 15,
+};
+
+// Ids in a but not in b, both sorted
+template <typename Id> std::vector<Id> sortedDifference(const std::vector<Id>& a,
+                                                        const std::vector<Id>& b) {
+    std::vector<Id> result;
+    std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(result));
+    return result;
+}
+
+}  // namespace
+
 SelectionManager& SelectionManager::getInstance() {
     static SelectionManager instance;
     return instance;
@@ -21,6 +55,7 @@ SelectionManager::SelectionManager() {
 // ============================================================================
 
 void SelectionManager::selectTrack(TrackId trackId) {
+    const ScopedBatch batch(*this);
     bool typeChanged = selectionType_ != SelectionType::Track;
     bool trackChanged = selectedTrackId_ != trackId;
 
@@ -50,6 +85,7 @@ void SelectionManager::selectTrack(TrackId trackId) {
 // ============================================================================
 
 void SelectionManager::selectClip(ClipId clipId) {
+    const ScopedBatch batch(*this);
     bool typeChanged = selectionType_ != SelectionType::Clip;
     bool clipChanged = selectedClipId_ != clipId;
 
@@ -88,6 +124,7 @@ void SelectionManager::selectClip(ClipId clipId) {
 // ============================================================================
 
 void SelectionManager::selectClips(const std::unordered_set<ClipId>& clipIds) {
+    const ScopedBatch batch(*this);
     if (clipIds.empty()) {
         clearSelection();
         return;
@@ -120,6 +157,7 @@ void SelectionManager::selectClips(const std::unordered_set<ClipId>& clipIds) {
 }
 
 void SelectionManager::addClipToSelection(ClipId clipId) {
+    const ScopedBatch batch(*this);
     if (clipId == INVALID_CLIP_ID) {
         return;
     }
@@ -156,7 +194,32 @@ void SelectionManager::addClipToSelection(ClipId clipId) {
     }
 }
 
+void SelectionManager::addClipsToSelection(const std::unordered_set<ClipId>& clipIds) {
+    const ScopedBatch batch(*this);
+
+    std::unordered_set<ClipId> combined;
+    if (selectionType_ == SelectionType::Clip || selectionType_ == SelectionType::MultiClip) {
+        combined = selectedClipIds_;
+    }
+    for (ClipId clipId : clipIds) {
+        if (clipId != INVALID_CLIP_ID) {
+            combined.insert(clipId);
+        }
+    }
+    if (combined.empty()) {
+        return;
+    }
+
+    // One clip becomes the anchor as with addClipToSelection(); several keep the old one
+    const ClipId savedAnchor = anchorClipId_;
+    selectClips(combined);
+    if (combined.size() > 1) {
+        anchorClipId_ = savedAnchor;
+    }
+}
+
 void SelectionManager::removeClipFromSelection(ClipId clipId) {
+    const ScopedBatch batch(*this);
     selectedClipIds_.erase(clipId);
 
     if (selectedClipIds_.empty()) {
@@ -171,6 +234,7 @@ void SelectionManager::removeClipFromSelection(ClipId clipId) {
 }
 
 void SelectionManager::toggleClipSelection(ClipId clipId) {
+    const ScopedBatch batch(*this);
     if (isClipSelected(clipId)) {
         removeClipFromSelection(clipId);
     } else {
@@ -179,6 +243,7 @@ void SelectionManager::toggleClipSelection(ClipId clipId) {
 }
 
 void SelectionManager::extendSelectionTo(ClipId targetClipId) {
+    const ScopedBatch batch(*this);
     if (targetClipId == INVALID_CLIP_ID) {
         return;
     }
@@ -208,17 +273,14 @@ void SelectionManager::extendSelectionTo(ClipId targetClipId) {
 
     // Find all clips in this region
     std::unordered_set<ClipId> clipsInRange;
-    const auto& allClips = ClipManager::getInstance().getClips();
-
-    for (const auto& clip : allClips) {
+    for (const auto& clip : ClipManager::getInstance().getClipGeometry()) {
         // Check if clip's track is in range
         if (clip.trackId < minTrackId || clip.trackId > maxTrackId) {
             continue;
         }
 
         // Check if clip overlaps with time range
-        double clipEnd = clip.startTime + clip.length;
-        if (clip.startTime < maxTime && clipEnd > minTime) {
+        if (clip.overlaps(minTime, maxTime)) {
             clipsInRange.insert(clip.id);
         }
     }
@@ -245,6 +307,7 @@ bool SelectionManager::isClipSelected(ClipId clipId) const {
 
 void SelectionManager::selectTimeRange(double startTime, double endTime,
                                        const std::vector<TrackId>& trackIds) {
+    const ScopedBatch batch(*this);
     bool typeChanged = selectionType_ != SelectionType::TimeRange;
 
     // Clear other selection types
@@ -270,7 +333,8 @@ void SelectionManager::selectTimeRange(double startTime, double endTime,
 // Note Selection
 // ============================================================================
 
-void SelectionManager::selectNote(ClipId clipId, size_t noteIndex) {
+void SelectionManager::selectNote(ClipId clipId, MidiNoteId noteId) {
+    const ScopedBatch batch(*this);
     bool typeChanged = selectionType_ != SelectionType::Note;
 
     // Clear other selection types (but keep clip selection for UI purposes)
@@ -281,8 +345,8 @@ void SelectionManager::selectNote(ClipId clipId, size_t noteIndex) {
 
     selectionType_ = SelectionType::Note;
     noteSelection_.clipId = clipId;
-    noteSelection_.noteIndices.clear();
-    noteSelection_.noteIndices.push_back(noteIndex);
+    noteSelection_.noteIds.clear();
+    noteSelection_.noteIds.push_back(noteId);
 
     // Clear track selection but DON'T clear clip selection
     // (the note is still within that clip, and we want the piano roll to stay visible)
@@ -294,14 +358,15 @@ void SelectionManager::selectNote(ClipId clipId, size_t noteIndex) {
     notifyNoteSelectionChanged(noteSelection_);
 }
 
-void SelectionManager::selectNotes(ClipId clipId, const std::vector<size_t>& noteIndices) {
-    if (noteIndices.empty()) {
+void SelectionManager::selectNotes(ClipId clipId, const std::vector<MidiNoteId>& noteIds) {
+    const ScopedBatch batch(*this);
+    if (noteIds.empty()) {
         clearSelection();
         return;
     }
 
-    if (noteIndices.size() == 1) {
-        selectNote(clipId, noteIndices[0]);
+    if (noteIds.size() == 1) {
+        selectNote(clipId, noteIds[0]);
         return;
     }
 
@@ -315,7 +380,11 @@ void SelectionManager::selectNotes(ClipId clipId, const std::vector<size_t>& not
 
     selectionType_ = SelectionType::Note;
     noteSelection_.clipId = clipId;
-    noteSelection_.noteIndices = noteIndices;
+    noteSelection_.noteIds = noteIds;
+    std::sort(noteSelection_.noteIds.begin(), noteSelection_.noteIds.end());
+    noteSelection_.noteIds.erase(
+        std::unique(noteSelection_.noteIds.begin(), noteSelection_.noteIds.end()),
+        noteSelection_.noteIds.end());
 
     // Clear track selection but DON'T clear clip selection
     TrackManager::getInstance().setSelectedTrack(INVALID_TRACK_ID);
@@ -326,37 +395,39 @@ void SelectionManager::selectNotes(ClipId clipId, const std::vector<size_t>& not
     notifyNoteSelectionChanged(noteSelection_);
 }
 
-void SelectionManager::addNoteToSelection(ClipId clipId, size_t noteIndex) {
+void SelectionManager::addNoteToSelection(ClipId clipId, MidiNoteId noteId) {
+    const ScopedBatch batch(*this);
     // If selecting a note from a different clip, start fresh
     if (noteSelection_.clipId != clipId) {
-        selectNote(clipId, noteIndex);
+        selectNote(clipId, noteId);
         return;
     }
 
     // Check if already selected
-    auto it =
-        std::find(noteSelection_.noteIndices.begin(), noteSelection_.noteIndices.end(), noteIndex);
-    if (it != noteSelection_.noteIndices.end()) {
+    auto it = std::lower_bound(noteSelection_.noteIds.begin(), noteSelection_.noteIds.end(),
+                               noteId);
+    if (it != noteSelection_.noteIds.end() && *it == noteId) {
         return;  // Already selected
     }
 
     // Ensure we're in note selection mode
     if (selectionType_ != SelectionType::Note) {
-        selectNote(clipId, noteIndex);
+        selectNote(clipId, noteId);
         return;
     }
 
-    noteSelection_.noteIndices.push_back(noteIndex);
+    noteSelection_.noteIds.insert(it, noteId);
     notifyNoteSelectionChanged(noteSelection_);
 }
 
-void SelectionManager::removeNoteFromSelection(size_t noteIndex) {
-    auto it =
-        std::find(noteSelection_.noteIndices.begin(), noteSelection_.noteIndices.end(), noteIndex);
-    if (it != noteSelection_.noteIndices.end()) {
-        noteSelection_.noteIndices.erase(it);
+void SelectionManager::removeNoteFromSelection(MidiNoteId noteId) {
+    const ScopedBatch batch(*this);
+    auto it = std::lower_bound(noteSelection_.noteIds.begin(), noteSelection_.noteIds.end(),
+                               noteId);
+    if (it != noteSelection_.noteIds.end() && *it == noteId) {
+        noteSelection_.noteIds.erase(it);
 
-        if (noteSelection_.noteIndices.empty()) {
+        if (noteSelection_.noteIds.empty()) {
             clearSelection();
         } else {
             notifyNoteSelectionChanged(noteSelection_);
@@ -364,20 +435,20 @@ void SelectionManager::removeNoteFromSelection(size_t noteIndex) {
     }
 }
 
-void SelectionManager::toggleNoteSelection(ClipId clipId, size_t noteIndex) {
-    if (isNoteSelected(clipId, noteIndex)) {
-        removeNoteFromSelection(noteIndex);
+void SelectionManager::toggleNoteSelection(ClipId clipId, MidiNoteId noteId) {
+    const ScopedBatch batch(*this);
+    if (isNoteSelected(clipId, noteId)) {
+        removeNoteFromSelection(noteId);
     } else {
-        addNoteToSelection(clipId, noteIndex);
+        addNoteToSelection(clipId, noteId);
     }
 }
 
-bool SelectionManager::isNoteSelected(ClipId clipId, size_t noteIndex) const {
+bool SelectionManager::isNoteSelected(ClipId clipId, MidiNoteId noteId) const {
     if (selectionType_ != SelectionType::Note || noteSelection_.clipId != clipId) {
         return false;
     }
-    return std::find(noteSelection_.noteIndices.begin(), noteSelection_.noteIndices.end(),
-                     noteIndex) != noteSelection_.noteIndices.end();
+    return noteSelection_.contains(noteId);
 }
 
 // ============================================================================
@@ -391,6 +462,7 @@ void SelectionManager::selectDevice(TrackId trackId, DeviceId deviceId) {
 
 void SelectionManager::selectDevice(TrackId trackId, RackId rackId, ChainId chainId,
                                     DeviceId deviceId) {
+    const ScopedBatch batch(*this);
     bool typeChanged = selectionType_ != SelectionType::Device;
     bool deviceChanged = deviceSelection_.trackId != trackId || deviceSelection_.rackId != rackId ||
                          deviceSelection_.chainId != chainId ||
@@ -421,6 +493,7 @@ void SelectionManager::selectDevice(TrackId trackId, RackId rackId, ChainId chai
 }
 
 void SelectionManager::clearDeviceSelection() {
+    const ScopedBatch batch(*this);
     if (selectionType_ != SelectionType::Device) {
         return;
     }
@@ -445,6 +518,7 @@ void SelectionManager::clearDeviceSelection() {
 // ============================================================================
 
 void SelectionManager::clearSelection() {
+    const ScopedBatch batch(*this);
     if (selectionType_ == SelectionType::None) {
         return;
     }
@@ -488,11 +562,134 @@ void SelectionManager::removeListener(SelectionManagerListener* listener) {
     listeners_.erase(std::remove(listeners_.begin(), listeners_.end(), listener), listeners_.end());
 }
 
+// ============================================================================
+// Notification Batching
+// ============================================================================
+
+void SelectionManager::beginBatch() {
+    if (batchDepth_++ == 0) {
+        batchStartType_ = selectionType_;
+    }
+}
+
+void SelectionManager::endBatch() {
+    if (--batchDepth_ > 0) {
+        return;
+    }
+
+    // Listeners may change the selection from here on; those changes batch on their own
+    const uint32_t pending = std::exchange(pendingNotifications_, 0u);
+    if ((pending & kTypeChanged) && selectionType_ != batchStartType_)
+        notifySelectionTypeChanged(selectionType_);
+    if (pending & kTrack)
+        notifyTrackSelectionChanged(selectedTrackId_);
+    if (pending & kClip)
+        notifyClipSelectionChanged(selectedClipId_);
+    if (pending & kMultiClip)
+        notifyMultiClipSelectionChanged(selectedClipIds_);
+    if (pending & kTimeRange)
+        notifyTimeRangeSelectionChanged(timeRangeSelection_);
+    if (pending & kNote)
+        notifyNoteSelectionChanged(noteSelection_);
+    if (pending & kDevice)
+        notifyDeviceSelectionChanged(deviceSelection_);
+    if (pending & kChainNode)
+        notifyChainNodeSelectionChanged(selectedChainNode_);
+    if (pending & kMod)
+        notifyModSelectionChanged(modSelection_);
+    if (pending & kMacro)
+        notifyMacroSelectionChanged(macroSelection_);
+    if (pending & kModsPanel)
+        notifyModsPanelSelectionChanged(modsPanelSelection_);
+    if (pending & kMacrosPanel)
+        notifyMacrosPanelSelectionChanged(macrosPanelSelection_);
+    if (pending & kParam)
+        notifyParamSelectionChanged(paramSelection_);
+    if (pending & kAutomationLane)
+        notifyAutomationLaneSelectionChanged(automationLaneSelection_);
+    if (pending & kAutomationClip)
+        notifyAutomationClipSelectionChanged(automationClipSelection_);
+    if (pending & kAutomationPoint)
+        notifyAutomationPointSelectionChanged(automationPointSelection_);
+
+    if (pending != 0) {
+        notifySelectionDeltas();
+    }
+}
+
+bool SelectionManager::deferNotification(uint32_t notification) {
+    if (batchDepth_ == 0) {
+        return false;
+    }
+    pendingNotifications_ |= notification;
+    return true;
+}
+
+void SelectionManager::notifySelectionDeltas() {
+    // Clips: single and multi-clip selections both keep selectedClipIds_ filled
+    static const std::unordered_set<ClipId> noClips;
+    const bool clipsSelected =
+        selectionType_ == SelectionType::Clip || selectionType_ == SelectionType::MultiClip;
+    const auto& clips = clipsSelected ? selectedClipIds_ : noClips;
+
+    ClipSelectionDelta clipDelta;
+    for (ClipId clipId : clips) {
+        if (notifiedClipIds_.find(clipId) == notifiedClipIds_.end()) {
+            clipDelta.added.push_back(clipId);
+        }
+    }
+    for (ClipId clipId : notifiedClipIds_) {
+        if (clips.find(clipId) == clips.end()) {
+            clipDelta.removed.push_back(clipId);
+        }
+    }
+
+    // Notes are compared per clip, on the sorted id lists
+    const auto current = selectionType_ == SelectionType::Note ? noteSelection_ : NoteSelection{};
+    std::vector<NoteSelectionDelta> noteDeltas;
+    if (current.clipId == notifiedNotes_.clipId) {
+        NoteSelectionDelta delta;
+        delta.clipId = current.clipId;
+        delta.added = sortedDifference(current.noteIds, notifiedNotes_.noteIds);
+        delta.removed = sortedDifference(notifiedNotes_.noteIds, current.noteIds);
+        noteDeltas.push_back(std::move(delta));
+    } else {
+        noteDeltas.push_back({notifiedNotes_.clipId, {}, notifiedNotes_.noteIds});
+        noteDeltas.push_back({current.clipId, current.noteIds, {}});
+    }
+
+    if (!clipDelta.empty()) {
+        notifiedClipIds_ = clips;
+        std::sort(clipDelta.added.begin(), clipDelta.added.end());
+        std::sort(clipDelta.removed.begin(), clipDelta.removed.end());
+    }
+    notifiedNotes_ = current;
+
+    if (!clipDelta.empty()) {
+        for (auto* listener : listeners_) {
+            if (listener != nullptr)
+                listener->clipSelectionDeltaChanged(clipDelta);
+        }
+    }
+    for (const auto& delta : noteDeltas) {
+        if (delta.empty()) {
+            continue;
+        }
+        for (auto* listener : listeners_) {
+            if (listener != nullptr)
+                listener->noteSelectionDeltaChanged(delta);
+        }
+    }
+}
+
 // ============================================================================
 // Private Notification Helpers
 // ============================================================================
 
 void SelectionManager::notifySelectionTypeChanged(SelectionType type) {
+    if (deferNotification(kTypeChanged)) {
+        return;
+    }
     for (auto* listener : listeners_) {
         if (listener != nullptr)
             listener->selectionTypeChanged(type);
@@ -500,6 +697,9 @@ void SelectionManager::notifySelectionTypeChanged(SelectionType type) {
 }
 
 void SelectionManager::notifyTrackSelectionChanged(TrackId trackId) {
+    if (deferNotification(kTrack)) {
+        return;
+    }
     for (auto* listener : listeners_) {
         if (listener != nullptr)
             listener->trackSelectionChanged(trackId);
@@ -507,6 +707,9 @@ void SelectionManager::notifyTrackSelectionChanged(TrackId trackId) {
 }
 
 void SelectionManager::notifyClipSelectionChanged(ClipId clipId) {
+    if (deferNotification(kClip)) {
+        return;
+    }
     for (auto* listener : listeners_) {
         if (listener != nullptr)
             listener->clipSelectionChanged(clipId);
@@ -514,6 +717,9 @@ void SelectionManager::notifyClipSelectionChanged(ClipId clipId) {
 }
 
 void SelectionManager::notifyMultiClipSelectionChanged(const std::unordered_set<ClipId>& clipIds) {
+    if (deferNotification(kMultiClip)) {
+        return;
+    }
     for (auto* listener : listeners_) {
         if (listener != nullptr)
             listener->multiClipSelectionChanged(clipIds);
@@ -521,6 +727,9 @@ void SelectionManager::notifyMultiClipSelectionChanged(const std::unordered_set<
 }
 
 void SelectionManager::notifyTimeRangeSelectionChanged(const TimeRangeSelection& selection) {
+    if (deferNotification(kTimeRange)) {
+        return;
+    }
     for (auto* listener : listeners_) {
         if (listener != nullptr)
             listener->timeRangeSelectionChanged(selection);
@@ -528,6 +737,9 @@ void SelectionManager::notifyTimeRangeSelectionChanged(const TimeRangeSelection&
 }
 
 void SelectionManager::notifyNoteSelectionChanged(const NoteSelection& selection) {
+    if (deferNotification(kNote)) {
+        return;
+    }
     for (auto* listener : listeners_) {
         if (listener != nullptr)
             listener->noteSelectionChanged(selection);
@@ -535,6 +747,9 @@ void SelectionManager::notifyNoteSelectionChanged(const NoteSelection& selection
 }
 
 void SelectionManager::notifyDeviceSelectionChanged(const DeviceSelection& selection) {
+    if (deferNotification(kDevice)) {
+        return;
+    }
     for (auto* listener : listeners_) {
         if (listener != nullptr)
             listener->deviceSelectionChanged(selection);
@@ -546,6 +761,7 @@ void SelectionManager::notifyDeviceSelectionChanged(const DeviceSelection& selec
 // ============================================================================
 
 void SelectionManager::selectChainNode(const ChainNodePath& path) {
+    const ScopedBatch batch(*this);
     bool typeChanged = selectionType_ != SelectionType::ChainNode;
     bool pathChanged = selectedChainNode_ != path;
 
@@ -575,6 +791,7 @@ void SelectionManager::selectChainNode(const ChainNodePath& path) {
 }
 
 void SelectionManager::clearChainNodeSelection() {
+    const ScopedBatch batch(*this);
     if (selectionType_ != SelectionType::ChainNode) {
         return;
     }
@@ -594,6 +811,9 @@ void SelectionManager::clearChainNodeSelection() {
 }
 
 void SelectionManager::notifyChainNodeSelectionChanged(const ChainNodePath& path) {
+    if (deferNotification(kChainNode)) {
+        return;
+    }
     for (auto* listener : listeners_) {
         if (listener != nullptr) {
             listener->chainNodeSelectionChanged(path);
@@ -613,6 +833,7 @@ void SelectionManager::notifyChainNodeReselected(const ChainNodePath& path) {
 // ============================================================================
 
 void SelectionManager::selectMod(const ChainNodePath& parentPath, int modIndex) {
+    const ScopedBatch batch(*this);
     bool typeChanged = selectionType_ != SelectionType::Mod;
     bool selectionChanged =
         modSelection_.parentPath != parentPath || modSelection_.modIndex != modIndex;
@@ -647,6 +868,7 @@ void SelectionManager::selectMod(const ChainNodePath& parentPath, int modIndex)
 }
 
 void SelectionManager::clearModSelection() {
+    const ScopedBatch batch(*this);
     if (selectionType_ != SelectionType::Mod) {
         return;
     }
@@ -666,6 +888,9 @@ void SelectionManager::clearModSelection() {
 }
 
 void SelectionManager::notifyModSelectionChanged(const ModSelection& selection) {
+    if (deferNotification(kMod)) {
+        return;
+    }
     for (auto* listener : listeners_) {
         if (listener != nullptr)
             listener->modSelectionChanged(selection);
@@ -677,6 +902,7 @@ void SelectionManager::notifyModSelectionChanged(const ModSelection& selection)
 // ============================================================================
 
 void SelectionManager::selectMacro(const ChainNodePath& parentPath, int macroIndex) {
+    const ScopedBatch batch(*this);
     bool typeChanged = selectionType_ != SelectionType::Macro;
     bool selectionChanged =
         macroSelection_.parentPath != parentPath || macroSelection_.macroIndex != macroIndex;
@@ -711,6 +937,7 @@ void SelectionManager::selectMacro(const ChainNodePath& parentPath, int macroInd
 }
 
 void SelectionManager::clearMacroSelection() {
+    const ScopedBatch batch(*this);
     if (selectionType_ != SelectionType::Macro) {
         return;
     }
@@ -730,6 +957,9 @@ void SelectionManager::clearMacroSelection() {
 }
 
 void SelectionManager::notifyMacroSelectionChanged(const MacroSelection& selection) {
+    if (deferNotification(kMacro)) {
+        return;
+    }
     for (auto* listener : listeners_) {
         if (listener != nullptr)
             listener->macroSelectionChanged(selection);
@@ -741,6 +971,7 @@ void SelectionManager::notifyMacroSelectionChanged(const MacroSelection& selecti
 // ============================================================================
 
 void SelectionManager::selectParam(const ChainNodePath& devicePath, int paramIndex) {
+    const ScopedBatch batch(*this);
     DBG("SelectionManager::selectParam called: paramIndex=" + juce::String(paramIndex));
 
     bool typeChanged = selectionType_ != SelectionType::Param;
@@ -781,6 +1012,7 @@ void SelectionManager::selectParam(const ChainNodePath& devicePath, int paramInd
 }
 
 void SelectionManager::clearParamSelection() {
+    const ScopedBatch batch(*this);
     if (selectionType_ != SelectionType::Param) {
         return;
     }
@@ -800,6 +1032,9 @@ void SelectionManager::clearParamSelection() {
 }
 
 void SelectionManager::notifyParamSelectionChanged(const ParamSelection& selection) {
+    if (deferNotification(kParam)) {
+        return;
+    }
     for (auto* listener : listeners_) {
         if (listener != nullptr)
             listener->paramSelectionChanged(selection);
@@ -811,6 +1046,7 @@ void SelectionManager::notifyParamSelectionChanged(const ParamSelection& selecti
 // ============================================================================
 
 void SelectionManager::selectModsPanel(const ChainNodePath& parentPath) {
+    const ScopedBatch batch(*this);
     bool typeChanged = selectionType_ != SelectionType::ModsPanel;
     bool selectionChanged = modsPanelSelection_.parentPath != parentPath;
 
@@ -843,6 +1079,7 @@ void SelectionManager::selectModsPanel(const ChainNodePath& parentPath) {
 }
 
 void SelectionManager::clearModsPanelSelection() {
+    const ScopedBatch batch(*this);
     if (selectionType_ != SelectionType::ModsPanel) {
         return;
     }
@@ -862,6 +1099,9 @@ void SelectionManager::clearModsPanelSelection() {
 }
 
 void SelectionManager::notifyModsPanelSelectionChanged(const ModsPanelSelection& selection) {
+    if (deferNotification(kModsPanel)) {
+        return;
+    }
     for (auto* listener : listeners_) {
         if (listener != nullptr)
             listener->modsPanelSelectionChanged(selection);
@@ -873,6 +1113,7 @@ void SelectionManager::notifyModsPanelSelectionChanged(const ModsPanelSelection&
 // ============================================================================
 
 void SelectionManager::selectMacrosPanel(const ChainNodePath& parentPath) {
+    const ScopedBatch batch(*this);
     bool typeChanged = selectionType_ != SelectionType::MacrosPanel;
     bool selectionChanged = macrosPanelSelection_.parentPath != parentPath;
 
@@ -905,6 +1146,7 @@ void SelectionManager::selectMacrosPanel(const ChainNodePath& parentPath) {
 }
 
 void SelectionManager::clearMacrosPanelSelection() {
+    const ScopedBatch batch(*this);
     if (selectionType_ != SelectionType::MacrosPanel) {
         return;
     }
@@ -924,6 +1166,9 @@ void SelectionManager::clearMacrosPanelSelection() {
 }
 
 void SelectionManager::notifyMacrosPanelSelectionChanged(const MacrosPanelSelection& selection) {
+    if (deferNotification(kMacrosPanel)) {
+        return;
+    }
     for (auto* listener : listeners_) {
         if (listener != nullptr)
             listener->macrosPanelSelectionChanged(selection);
@@ -935,6 +1180,7 @@ void SelectionManager::notifyMacrosPanelSelectionChanged(const MacrosPanelSelect
 // ============================================================================
 
 void SelectionManager::selectAutomationLane(AutomationLaneId laneId) {
+    const ScopedBatch batch(*this);
     bool typeChanged = selectionType_ != SelectionType::AutomationLane;
     bool selectionChanged = automationLaneSelection_.laneId != laneId;
 
@@ -970,6 +1216,7 @@ void SelectionManager::selectAutomationLane(AutomationLaneId laneId) {
 }
 
 void SelectionManager::clearAutomationLaneSelection() {
+    const ScopedBatch batch(*this);
     if (selectionType_ != SelectionType::AutomationLane) {
         return;
     }
@@ -990,6 +1237,9 @@ void SelectionManager::clearAutomationLaneSelection() {
 
 void SelectionManager::notifyAutomationLaneSelectionChanged(
     const AutomationLaneSelection& selection) {
+    if (deferNotification(kAutomationLane)) {
+        return;
+    }
     for (auto* listener : listeners_) {
         if (listener != nullptr)
             listener->automationLaneSelectionChanged(selection);
@@ -1001,6 +1251,7 @@ void SelectionManager::notifyAutomationLaneSelectionChanged(
 // ============================================================================
 
 void SelectionManager::selectAutomationClip(AutomationClipId clipId, AutomationLaneId laneId) {
+    const ScopedBatch batch(*this);
     bool typeChanged = selectionType_ != SelectionType::AutomationClip;
     bool selectionChanged =
         automationClipSelection_.clipId != clipId || automationClipSelection_.laneId != laneId;
@@ -1038,6 +1289,7 @@ void SelectionManager::selectAutomationClip(AutomationClipId clipId, AutomationL
 }
 
 void SelectionManager::clearAutomationClipSelection() {
+    const ScopedBatch batch(*this);
     if (selectionType_ != SelectionType::AutomationClip) {
         return;
     }
@@ -1058,6 +1310,9 @@ void SelectionManager::clearAutomationClipSelection() {
 
 void SelectionManager::notifyAutomationClipSelectionChanged(
     const AutomationClipSelection& selection) {
+    if (deferNotification(kAutomationClip)) {
+        return;
+    }
     for (auto* listener : listeners_) {
         if (listener != nullptr)
             listener->automationClipSelectionChanged(selection);
@@ -1070,6 +1325,7 @@ void SelectionManager::notifyAutomationClipSelectionChanged(
 
 void SelectionManager::selectAutomationPoint(AutomationLaneId laneId, AutomationPointId pointId,
                                              AutomationClipId clipId) {
+    const ScopedBatch batch(*this);
     bool typeChanged = selectionType_ != SelectionType::AutomationPoint;
 
     // Clear other selection types (but keep track selection for context)
@@ -1105,6 +1361,7 @@ void SelectionManager::selectAutomationPoint(AutomationLaneId laneId, Automation
 void SelectionManager::selectAutomationPoints(AutomationLaneId laneId,
                                               const std::vector<AutomationPointId>& pointIds,
                                               AutomationClipId clipId) {
+    const ScopedBatch batch(*this);
     if (pointIds.empty()) {
         clearAutomationPointSelection();
         return;
@@ -1149,6 +1406,7 @@ void SelectionManager::selectAutomationPoints(AutomationLaneId laneId,
 void SelectionManager::addAutomationPointToSelection(AutomationLaneId laneId,
                                                      AutomationPointId pointId,
                                                      AutomationClipId clipId) {
+    const ScopedBatch batch(*this);
     // If selecting a point from a different lane/clip, start fresh
     if (automationPointSelection_.laneId != laneId || automationPointSelection_.clipId != clipId) {
         selectAutomationPoint(laneId, pointId, clipId);
@@ -1173,6 +1431,7 @@ void SelectionManager::addAutomationPointToSelection(AutomationLaneId laneId,
 }
 
 void SelectionManager::removeAutomationPointFromSelection(AutomationPointId pointId) {
+    const ScopedBatch batch(*this);
     auto it = std::find(automationPointSelection_.pointIds.begin(),
                         automationPointSelection_.pointIds.end(), pointId);
     if (it != automationPointSelection_.pointIds.end()) {
@@ -1189,6 +1448,7 @@ void SelectionManager::removeAutomationPointFromSelection(AutomationPointId poin
 void SelectionManager::toggleAutomationPointSelection(AutomationLaneId laneId,
                                                       AutomationPointId pointId,
                                                       AutomationClipId clipId) {
+    const ScopedBatch batch(*this);
     if (isAutomationPointSelected(pointId)) {
         removeAutomationPointFromSelection(pointId);
     } else {
@@ -1197,6 +1457,7 @@ void SelectionManager::toggleAutomationPointSelection(AutomationLaneId laneId,
 }
 
 void SelectionManager::clearAutomationPointSelection() {
+    const ScopedBatch batch(*this);
     if (selectionType_ != SelectionType::AutomationPoint) {
         return;
     }
@@ -1226,6 +1487,9 @@ bool SelectionManager::isAutomationPointSelected(AutomationPointId pointId) cons
 
 void SelectionManager::notifyAutomationPointSelectionChanged(
     const AutomationPointSelection& selection) {
+    if (deferNotification(kAutomationPoint)) {
+        return;
+    }
     for (auto* listener : listeners_) {
         if (listener != nullptr)
             listener->automationPointSelectionChanged(selection);
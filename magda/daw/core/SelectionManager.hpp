@@ -1,5 +1,7 @@
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
 #include <unordered_set>
 #include <vector>
 
@@ -67,6 +69,14 @@ namespace magda {
 // Register in constructor: SelectionManager::getInstance().addListener(this);
 // Unregister in destructor: SelectionManager::getInstance().removeListener(this);
 //
+// ## Coalescing
+//
+// Each select*/clear* call announces its changes once, when it returns, with the
+// final state, however many steps it took internally. A SelectionManager::ScopedBatch
+// stretches that over several calls (a marquee committing thousands of clips, say).
+// After the full-state callbacks, clip and note listeners also get just what was
+// added and removed (ClipSelectionDelta, NoteSelectionDelta).
+//
 // ============================================================================
 
 /**
@@ -293,18 +303,49 @@ struct ChainNodePath {
  */
 struct NoteSelection {
     ClipId clipId = INVALID_CLIP_ID;
-    std::vector<size_t> noteIndices;  // Indices into clip's midiNotes vector
+    std::vector<MidiNoteId> noteIds;  // Ids in the clip's MidiNoteList, sorted, no repeats
 
     bool isValid() const {
-        return clipId != INVALID_CLIP_ID && !noteIndices.empty();
+        return clipId != INVALID_CLIP_ID && !noteIds.empty();
     }
 
     bool isSingleNote() const {
-        return noteIndices.size() == 1;
+        return noteIds.size() == 1;
     }
 
     size_t getCount() const {
-        return noteIndices.size();
+        return noteIds.size();
+    }
+
+    bool contains(MidiNoteId noteId) const {
+        return std::binary_search(noteIds.begin(), noteIds.end(), noteId);
+    }
+};
+
+/**
+ * @brief The clips a selection change added and removed, each list sorted
+ *
+ * Selecting one clip or several counts alike: it's the set of selected clips that changes.
+ */
+struct ClipSelectionDelta {
+    std::vector<ClipId> added;
+    std::vector<ClipId> removed;
+
+    bool empty() const {
+        return added.empty() && removed.empty();
+    }
+};
+
+/**
+ * @brief The notes of one clip a selection change added and removed, each list sorted
+ */
+struct NoteSelectionDelta {
+    ClipId clipId = INVALID_CLIP_ID;
+    std::vector<MidiNoteId> added;
+    std::vector<MidiNoteId> removed;
+
+    bool empty() const {
+        return added.empty() && removed.empty();
     }
 };
 
@@ -545,6 +586,11 @@ class SelectionManagerListener {
         [[maybe_unused]] const AutomationClipSelection& selection) {}
     virtual void automationPointSelectionChanged(
         [[maybe_unused]] const AutomationPointSelection& selection) {}
+
+    // What changed, after the callbacks above. Notes moving to another clip come as a
+    // removal from the old clip, then an addition to the new one
+    virtual void clipSelectionDeltaChanged([[maybe_unused]] const ClipSelectionDelta& delta) {}
+    virtual void noteSelectionDeltaChanged([[maybe_unused]] const NoteSelectionDelta& delta) {}
 };
 
 /**
@@ -561,6 +607,28 @@ class SelectionManager {
     SelectionManager(const SelectionManager&) = delete;
     SelectionManager& operator=(const SelectionManager&) = delete;
 
+    /**
+     * @brief Hold back notifications until the outermost batch ends
+     *
+     * Then each kind of change that happened is announced once with the final state
+     * (selectionTypeChanged only if the type ended up different), followed by the deltas.
+     */
+    class ScopedBatch {
+      public:
+        explicit ScopedBatch(SelectionManager& manager) : manager_(manager) {
+            manager_.beginBatch();
+        }
+        ~ScopedBatch() {
+            manager_.endBatch();
+        }
+
+        ScopedBatch(const ScopedBatch&) = delete;
+        ScopedBatch& operator=(const ScopedBatch&) = delete;
+
+      private:
+        SelectionManager& manager_;
+    };
+
     // ========================================================================
     // Selection State
     // ========================================================================
@@ -618,6 +686,11 @@ class SelectionManager {
      */
     void addClipToSelection(ClipId clipId);
 
+    /**
+     * @brief Add several clips to the current selection in one change
+     */
+    void addClipsToSelection(const std::unordered_set<ClipId>& clipIds);
+
     /**
      * @brief Remove a clip from the current selection
      */
@@ -690,27 +763,27 @@ class SelectionManager {
     /**
      * @brief Select a single MIDI note (clears other selection types)
      */
-    void selectNote(ClipId clipId, size_t noteIndex);
+    void selectNote(ClipId clipId, MidiNoteId noteId);
 
     /**
      * @brief Select multiple MIDI notes in the same clip
      */
-    void selectNotes(ClipId clipId, const std::vector<size_t>& noteIndices);
+    void selectNotes(ClipId clipId, const std::vector<MidiNoteId>& noteIds);
 
     /**
      * @brief Add a note to the current selection
      */
-    void addNoteToSelection(ClipId clipId, size_t noteIndex);
+    void addNoteToSelection(ClipId clipId, MidiNoteId noteId);
 
     /**
      * @brief Remove a note from the current selection
      */
-    void removeNoteFromSelection(size_t noteIndex);
+    void removeNoteFromSelection(MidiNoteId noteId);
 
     /**
      * @brief Toggle a note's selection state
      */
-    void toggleNoteSelection(ClipId clipId, size_t noteIndex);
+    void toggleNoteSelection(ClipId clipId, MidiNoteId noteId);
 
     /**
      * @brief Get the current note selection
@@ -722,7 +795,7 @@ class SelectionManager {
     /**
      * @brief Check if a specific note is selected
      */
-    bool isNoteSelected(ClipId clipId, size_t noteIndex) const;
+    bool isNoteSelected(ClipId clipId, MidiNoteId noteId) const;
 
     /**
      * @brief Check if there's a valid note selection
@@ -1105,6 +1178,19 @@ class SelectionManager {
 
     std::vector<SelectionManagerListener*> listeners_;
 
+    // Coalescing: notify* calls inside a batch only set their bit in pendingNotifications_
+    int batchDepth_ = 0;
+    uint32_t pendingNotifications_ = 0;
+    SelectionType batchStartType_ = SelectionType::None;
+    // What listeners were last told, to work out deltas from
+    std::unordered_set<ClipId> notifiedClipIds_;
+    NoteSelection notifiedNotes_;
+
+    void beginBatch();
+    void endBatch();
+    bool deferNotification(uint32_t notification);
+    void notifySelectionDeltas();
+
     void notifySelectionTypeChanged(SelectionType type);
     void notifyTrackSelectionChanged(TrackId trackId);
     void notifyClipSelectionChanged(ClipId clipId);
@@ -0,0 +1,191 @@
+#include "StartupCache.hpp"
+
+#include <cstring>
+#include <utility>
+#include <vector>
+
+namespace magda {
+
+namespace {
+
+constexpr size_t kAlignment = 8;  // Each section's data starts on an 8-byte boundary
+
+void writeStamp(juce::MemoryOutputStream& out, juce::int64 modified, juce::int64 size) {
+    out.writeInt64(modified);
+    out.writeInt64(size);
+}
+
+void pad(juce::MemoryOutputStream& out) {
+    while (out.getDataSize() % kAlignment != 0) {
+        out.writeByte(0);
+    }
+}
+
+}  // namespace
+
+StartupCache& StartupCache::getInstance() {
+    static StartupCache instance(
+        juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+            .getChildFile("MAGDA")
+            .getChildFile("StartupCache.bin"));
+    return instance;
+}
+
+StartupCache::StartupCache(const juce::File& file) : file_(file) {
+    open();
+}
+
+StartupCache::Stamp StartupCache::stampOf(const juce::File& file) {
+    if (!file.existsAsFile()) {
+        return {};
+    }
+    return {file.getLastModificationTime().toMilliseconds(), file.getSize()};
+}
+
+StartupCache::Stamp StartupCache::buildStamp() {
+    return stampOf(juce::File::getSpecialLocation(juce::File::currentExecutableFile));
+}
+
+void StartupCache::open() {
+    sections_.clear();
+    mapped_.reset();
+    if (!file_.existsAsFile()) {
+        return;
+    }
+
+    mapped_ = std::make_unique<juce::MemoryMappedFile>(file_, juce::MemoryMappedFile::readOnly);
+    const auto* base = static_cast<const char*>(mapped_->getData());
+    const auto total = mapped_->getSize();
+    if (base == nullptr || total == 0) {
+        mapped_.reset();
+        return;
+    }
+
+    juce::MemoryInputStream in(base, total, false);
+    auto remaining = [&in] { return static_cast<size_t>(in.getNumBytesRemaining()); };
+
+    // Header: magic, format version, build stamp, number of sections
+    const auto build = buildStamp();
+    if (remaining() < 28 || static_cast<juce::uint32>(in.readInt()) != kMagic ||
+        static_cast<juce::uint32>(in.readInt()) != kFormatVersion) {
+        mapped_.reset();
+        return;
+    }
+    Stamp stored;
+    stored.modified = in.readInt64();
+    stored.size = in.readInt64();
+    const auto numSections = static_cast<juce::uint32>(in.readInt());
+    if (stored != build) {
+        mapped_.reset();
+        return;
+    }
+
+    // A section: name, source path, source stamp, data size, then the data, aligned
+    std::map<juce::String, Entry> sections;
+    auto readText = [&](juce::String& text) {
+        if (remaining() < 4) {
+            return false;
+        }
+        const auto length = static_cast<juce::uint32>(in.readInt());
+        if (length > remaining()) {
+            return false;
+        }
+        const auto* start = base + in.getPosition();
+        text = juce::String::fromUTF8(start, static_cast<int>(length));
+        in.skipNextBytes(length);
+        return true;
+    };
+    for (juce::uint32 i = 0; i < numSections; ++i) {
+        juce::String name;
+        Entry entry;
+        if (!readText(name) || !readText(entry.source) || remaining() < 24) {
+            return;  // Truncated: nothing is trusted
+        }
+        entry.stamp.modified = in.readInt64();
+        entry.stamp.size = in.readInt64();
+        const auto size = static_cast<juce::uint64>(in.readInt64());
+
+        const auto start = (static_cast<size_t>(in.getPosition()) + kAlignment - 1) /
+                           kAlignment * kAlignment;
+        if (start > total || size > total - start) {
+            return;
+        }
+        entry.section = {base + start, static_cast<size_t>(size)};
+        in.setPosition(static_cast<juce::int64>(start + size));
+        sections[name] = entry;
+    }
+    sections_ = std::move(sections);
+}
+
+StartupCache::Section StartupCache::find(const juce::String& name,
+                                         const juce::File& source) const {
+    auto it = sections_.find(name);
+    if (it == sections_.end() || it->second.source != source.getFullPathName() ||
+        it->second.stamp != stampOf(source)) {
+        return {};
+    }
+    return it->second.section;
+}
+
+bool StartupCache::store(const juce::String& name, const juce::File& source, const void* data,
+                         size_t size) {
+    const auto stamp = stampOf(source);
+    if (stamp.size < 0) {
+        return false;
+    }
+
+    // Every other section whose source is unchanged, then this one
+    std::vector<std::pair<juce::String, Entry>> kept;
+    for (const auto& [otherName, entry] : sections_) {
+        if (otherName != name && entry.stamp == stampOf(juce::File(entry.source))) {
+            kept.emplace_back(otherName, entry);
+        }
+    }
+    Entry added;
+    added.source = source.getFullPathName();
+    added.stamp = stamp;
+    added.section = {data, size};
+    kept.emplace_back(name, added);
+
+    juce::MemoryOutputStream out;
+    const auto build = buildStamp();
+    out.writeInt(static_cast<int>(kMagic));
+    out.writeInt(static_cast<int>(kFormatVersion));
+    writeStamp(out, build.modified, build.size);
+    out.writeInt(static_cast<int>(kept.size()));
+    auto writeText = [&out](const juce::String& text) {
+        const auto utf8 = text.toRawUTF8();
+        const auto length = std::strlen(utf8);
+        out.writeInt(static_cast<int>(length));
+        out.write(utf8, length);
+    };
+    for (const auto& [sectionName, entry] : kept) {
+        writeText(sectionName);
+        writeText(entry.source);
+        writeStamp(out, entry.stamp.modified, entry.stamp.size);
+        out.writeInt64(static_cast<juce::int64>(entry.section.size));
+        pad(out);
+        out.write(entry.section.data, entry.section.size);
+    }
+
+    // The old mapping goes before the file is replaced under it
+    mapped_.reset();
+    sections_.clear();
+
+    bool written = false;
+    if (file_.getParentDirectory().createDirectory().wasOk()) {
+        juce::TemporaryFile temp(file_);
+        written = temp.getFile().replaceWithData(out.getData(), out.getDataSize()) &&
+                  temp.overwriteTargetFileWithTemporary();
+    }
+    open();
+    return written;
+}
+
+void StartupCache::clear() {
+    mapped_.reset();
+    sections_.clear();
+    file_.deleteFile();
+}
+
+}  // namespace magda
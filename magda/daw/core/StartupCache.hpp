@@ -0,0 +1,105 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+#include <map>
+#include <memory>
+
+namespace magda {
+
+/**
+ * @brief One binary file of what startup would otherwise parse from text, mapped on open
+ *
+ * Each named section holds the decoded form of one source file (the settings, the plugin
+ * list), stamped with that file's modification time and size when it was stored. A section
+ * is only handed out while its source still has that stamp, so editing, rescanning or
+ * deleting the source quietly falls back to parsing it, which then stores a fresh section.
+ *
+ * The whole cache is also stamped with kFormatVersion and the running executable's
+ * modification time: a new build, whose decoded layouts may differ, starts from nothing.
+ * The file is opened with juce::MemoryMappedFile and sections are read in place, so a
+ * section costs the pages it touches. A file that is unreadable or doesn't check out is
+ * treated as empty.
+ *
+ * The cache lives beside the plugin list in the app data directory. Message thread only.
+ */
+class StartupCache {
+  public:
+    static constexpr juce::uint32 kMagic = 0x4d534331;  // "MSC1"
+    static constexpr juce::uint32 kFormatVersion = 1;
+
+    /**
+     * @brief A stored section's bytes, read in place from the mapping
+     *
+     * Only good until the next store() on the same cache.
+     */
+    struct Section {
+        const void* data = nullptr;
+        size_t size = 0;
+
+        bool isValid() const {
+            return data != nullptr;
+        }
+    };
+
+    static StartupCache& getInstance();
+
+    /**
+     * @brief A cache kept in file (which needn't exist yet)
+     */
+    explicit StartupCache(const juce::File& file);
+
+    /**
+     * @brief The section stored under name if source hasn't changed since, else invalid
+     */
+    Section find(const juce::String& name, const juce::File& source) const;
+
+    /**
+     * @brief Store data under name, stamped with source as it is now
+     *
+     * Rewrites the file with every other section that is still current, then maps it again.
+     * @return false if source doesn't exist or the file couldn't be written
+     */
+    bool store(const juce::String& name, const juce::File& source, const void* data,
+               size_t size);
+
+    /**
+     * @brief Remove the file (the next start parses everything)
+     */
+    void clear();
+
+    int getNumSections() const {
+        return static_cast<int>(sections_.size());
+    }
+
+    const juce::File& getFile() const {
+        return file_;
+    }
+
+  private:
+    struct Stamp {
+        juce::int64 modified = 0;
+        juce::int64 size = -1;
+
+        bool operator==(const Stamp& other) const = default;
+    };
+
+    struct Entry {
+        juce::String source;  // Full path
+        Stamp stamp;
+        Section section;
+    };
+
+    static Stamp stampOf(const juce::File& file);
+    static Stamp buildStamp();
+
+    void open();
+
+    juce::File file_;
+    std::unique_ptr<juce::MemoryMappedFile> mapped_;
+    std::map<juce::String, Entry> sections_;
+
+    JUCE_DECLARE_NON_COPYABLE(StartupCache)
+};
+
+}  // namespace magda
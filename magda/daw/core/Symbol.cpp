@@ -0,0 +1,118 @@
+#include "Symbol.hpp"
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace magda {
+
+namespace {
+
+/**
+ * @brief The strings behind every Symbol, in fixed-size chunks that never move
+ *
+ * A chunk is published (with its strings constructed) before any id inside it is handed
+ * out, so getString() reads without the lock; the map from text to id is only touched
+ * under it.
+ */
+class SymbolTable {
+  public:
+    static constexpr uint32_t kChunkBits = 10;
+    static constexpr uint32_t kChunkSize = 1u << kChunkBits;
+    static constexpr uint32_t kMaxChunks = 4096;  // About four million symbols
+
+    static SymbolTable& getInstance() {
+        static SymbolTable instance;
+        return instance;
+    }
+
+    uint32_t intern(const juce::String& text) {
+        if (text.isEmpty()) {
+            return 0;
+        }
+
+        const std::lock_guard<std::mutex> lock(mutex_);
+        if (const auto it = ids_.find(text); it != ids_.end()) {
+            return it->second;
+        }
+
+        const uint32_t id = size_.load(std::memory_order_relaxed);
+        const uint32_t chunk = id >> kChunkBits;
+        if (chunk >= kMaxChunks) {
+            jassertfalse;  // Something is interning unbounded data
+            return 0;
+        }
+        if (chunks_[chunk].load(std::memory_order_relaxed) == nullptr) {
+            ownedChunks_[chunk] = std::make_unique<juce::String[]>(kChunkSize);
+            chunks_[chunk].store(ownedChunks_[chunk].get(), std::memory_order_release);
+        }
+
+        auto& stored = chunks_[chunk].load(std::memory_order_relaxed)[id & (kChunkSize - 1)];
+        stored = text;
+        ids_.emplace(stored, id);
+        size_.store(id + 1, std::memory_order_release);
+        return id;
+    }
+
+    std::optional<uint32_t> find(const juce::String& text) const {
+        if (text.isEmpty()) {
+            return 0u;
+        }
+        const std::lock_guard<std::mutex> lock(mutex_);
+        if (const auto it = ids_.find(text); it != ids_.end()) {
+            return it->second;
+        }
+        return std::nullopt;
+    }
+
+    const juce::String& getString(uint32_t id) const {
+        const auto* chunk = chunks_[id >> kChunkBits].load(std::memory_order_acquire);
+        jassert(chunk != nullptr && id < size_.load(std::memory_order_acquire));
+        return chunk[id & (kChunkSize - 1)];
+    }
+
+    int getSize() const {
+        return static_cast<int>(size_.load(std::memory_order_acquire));
+    }
+
+  private:
+    SymbolTable() {
+        // Id 0 is the empty string, so a default Symbol needs no lookup
+        ownedChunks_[0] = std::make_unique<juce::String[]>(kChunkSize);
+        chunks_[0].store(ownedChunks_[0].get(), std::memory_order_release);
+        size_.store(1, std::memory_order_release);
+    }
+
+    mutable std::mutex mutex_;
+    std::unordered_map<juce::String, uint32_t> ids_;
+    std::array<std::unique_ptr<juce::String[]>, kMaxChunks> ownedChunks_;
+    std::array<std::atomic<juce::String*>, kMaxChunks> chunks_{};
+    std::atomic<uint32_t> size_{0};
+};
+
+}  // namespace
+
+// =============================================================================
+// Symbol
+// =============================================================================
+
+Symbol::Symbol(const juce::String& text) : id_(SymbolTable::getInstance().intern(text)) {}
+
+std::optional<Symbol> Symbol::find(const juce::String& text) {
+    if (const auto id = SymbolTable::getInstance().find(text)) {
+        return Symbol(*id);
+    }
+    return std::nullopt;
+}
+
+const juce::String& Symbol::getString() const {
+    return SymbolTable::getInstance().getString(id_);
+}
+
+int Symbol::getNumSymbols() {
+    return SymbolTable::getInstance().getSize();
+}
+
+}  // namespace magda
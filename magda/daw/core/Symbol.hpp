@@ -0,0 +1,90 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+
+namespace magda {
+
+/**
+ * @brief An interned string: a small integer handle into one process-wide table
+ *
+ * Keys that are looked up on every paint or sample (audio file paths, profiling
+ * categories, plugin parameter names) were juce::Strings, so each lookup hashed or
+ * compared the whole text - and file paths in one project share a long prefix. Interning
+ * the text once makes equality, hashing and ordering integer operations, and every Symbol
+ * of the same text shares one stored copy: thousands of plugin instances naming their
+ * parameters hold the names once.
+ *
+ * Constructing a Symbol from text looks it up (or adds it) under a lock, so hold on to the
+ * Symbol rather than the text on hot paths. Reading the text back is lock-free and safe
+ * from any thread. Entries are never removed, so intern bounded sets only: paths the
+ * session touches, names of loaded plugins - not per-sample or per-edit data.
+ *
+ * Unlike juce::Identifier, which pools its text too, a Symbol can be empty and hashes and
+ * orders as an integer, so it keys an unordered_map directly. Ordering is by interning
+ * order, not alphabetical.
+ */
+class Symbol {
+  public:
+    /**
+     * @brief The empty string
+     */
+    Symbol() = default;
+
+    /**
+     * @brief The symbol for text, interning it on first use
+     */
+    explicit Symbol(const juce::String& text);
+    explicit Symbol(const char* text) : Symbol(juce::String(text)) {}
+
+    /**
+     * @brief The symbol for text if it has been interned; never adds it
+     *
+     * For lookups keyed by arbitrary input: text that was never interned can't be a key.
+     */
+    static std::optional<Symbol> find(const juce::String& text);
+
+    /**
+     * @brief The interned text; the reference stays valid for the life of the process
+     */
+    const juce::String& getString() const;
+
+    uint32_t getId() const {
+        return id_;
+    }
+
+    bool isEmpty() const {
+        return id_ == 0;
+    }
+
+    bool operator==(const Symbol& other) const {
+        return id_ == other.id_;
+    }
+    bool operator!=(const Symbol& other) const {
+        return id_ != other.id_;
+    }
+    bool operator<(const Symbol& other) const {
+        return id_ < other.id_;
+    }
+
+    /**
+     * @brief How many distinct strings have been interned (the empty string included)
+     */
+    static int getNumSymbols();
+
+  private:
+    explicit Symbol(uint32_t id) : id_(id) {}
+
+    uint32_t id_ = 0;
+};
+
+}  // namespace magda
+
+template <> struct std::hash<magda::Symbol> {
+    size_t operator()(const magda::Symbol& symbol) const noexcept {
+        return std::hash<uint32_t>()(symbol.getId());
+    }
+};
@@ -0,0 +1,199 @@
+#include "TempoMap.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace magda {
+
+namespace {
+
+double clampBpm(double bpm) {
+    return std::clamp(bpm, TempoMap::kMinBpm, TempoMap::kMaxBpm);
+}
+
+}  // namespace
+
+TempoMap::TempoMap(double bpm, int numerator, int denominator)
+    : numerator_(std::max(1, numerator)), denominator_(std::max(1, denominator)) {
+    changes_.push_back({0.0, clampBpm(bpm)});
+    rebuildSegments();
+}
+
+TempoMap& TempoMap::getInstance() {
+    static TempoMap instance;
+    return instance;
+}
+
+// =============================================================================
+// Editing
+// =============================================================================
+
+void TempoMap::setTempo(double bpm) {
+    setTempoChanges({{0.0, bpm}});
+}
+
+void TempoMap::setTempoChanges(std::vector<TempoChange> changes) {
+    if (changes.empty()) {
+        changes.push_back({});
+    }
+
+    std::stable_sort(changes.begin(), changes.end(),
+                     [](const auto& a, const auto& b) { return a.beat < b.beat; });
+    changes.front().beat = 0.0;
+    for (auto& change : changes) {
+        change.bpm = clampBpm(change.bpm);
+    }
+
+    // A later change at the same beat wins
+    std::vector<TempoChange> merged;
+    merged.reserve(changes.size());
+    for (const auto& change : changes) {
+        if (!merged.empty() && merged.back().beat == change.beat) {
+            merged.back() = change;
+        } else {
+            merged.push_back(change);
+        }
+    }
+
+    const bool same = std::equal(
+        merged.begin(), merged.end(), changes_.begin(), changes_.end(),
+        [](const auto& a, const auto& b) { return a.beat == b.beat && a.bpm == b.bpm; });
+    if (same) {
+        return;
+    }
+
+    changes_ = std::move(merged);
+    rebuildSegments();
+    ++version_;
+}
+
+void TempoMap::setTimeSignature(int numerator, int denominator) {
+    numerator = std::max(1, numerator);
+    denominator = std::max(1, denominator);
+    if (numerator == numerator_ && denominator == denominator_) {
+        return;
+    }
+
+    numerator_ = numerator;
+    denominator_ = denominator;
+    ++version_;
+}
+
+void TempoMap::rebuildSegments() {
+    segments_.clear();
+    segments_.reserve(changes_.size());
+
+    double seconds = 0.0;
+    for (size_t i = 0; i < changes_.size(); ++i) {
+        Segment segment;
+        segment.startBeat = changes_[i].beat;
+        segment.secondsPerBeat = 60.0 / changes_[i].bpm;
+        if (i > 0) {
+            const auto& previous = segments_.back();
+            seconds += (segment.startBeat - previous.startBeat) * previous.secondsPerBeat;
+        }
+        segment.startSeconds = seconds;
+        segments_.push_back(segment);
+    }
+}
+
+// =============================================================================
+// Conversions
+// =============================================================================
+
+size_t TempoMap::segmentForBeat(double beat) const {
+    auto it = std::upper_bound(segments_.begin() + 1, segments_.end(), beat,
+                               [](double b, const Segment& s) { return b < s.startBeat; });
+    return static_cast<size_t>(it - segments_.begin()) - 1;
+}
+
+size_t TempoMap::segmentForTime(double seconds) const {
+    auto it = std::upper_bound(segments_.begin() + 1, segments_.end(), seconds,
+                               [](double t, const Segment& s) { return t < s.startSeconds; });
+    return static_cast<size_t>(it - segments_.begin()) - 1;
+}
+
+double TempoMap::getBpmAtBeat(double beat) const {
+    return changes_[segmentForBeat(beat)].bpm;
+}
+
+double TempoMap::getBpmAtTime(double seconds) const {
+    return changes_[segmentForTime(seconds)].bpm;
+}
+
+double TempoMap::beatsToSeconds(double beats) const {
+    const auto& segment = segments_[segmentForBeat(beats)];
+    return segment.startSeconds + (beats - segment.startBeat) * segment.secondsPerBeat;
+}
+
+double TempoMap::secondsToBeats(double seconds) const {
+    const auto& segment = segments_[segmentForTime(seconds)];
+    return segment.startBeat + (seconds - segment.startSeconds) / segment.secondsPerBeat;
+}
+
+void TempoMap::beatsToSeconds(const double* beats, double* seconds, size_t count) const {
+    size_t index = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const double beat = beats[i];
+        // Ascending input only ever moves forward a segment or two; anything else searches
+        if (beat < segments_[index].startBeat) {
+            index = segmentForBeat(beat);
+        }
+        while (index + 1 < segments_.size() && segments_[index + 1].startBeat <= beat) {
+            ++index;
+        }
+        const auto& segment = segments_[index];
+        seconds[i] = segment.startSeconds + (beat - segment.startBeat) * segment.secondsPerBeat;
+    }
+}
+
+void TempoMap::secondsToBeats(const double* seconds, double* beats, size_t count) const {
+    size_t index = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const double time = seconds[i];
+        if (time < segments_[index].startSeconds) {
+            index = segmentForTime(time);
+        }
+        while (index + 1 < segments_.size() && segments_[index + 1].startSeconds <= time) {
+            ++index;
+        }
+        const auto& segment = segments_[index];
+        beats[i] = segment.startBeat + (time - segment.startSeconds) / segment.secondsPerBeat;
+    }
+}
+
+void TempoMap::notesToSeconds(const std::vector<MidiNote>& notes, double originBeat,
+                              std::vector<TimeRange>& out) const {
+    out.resize(notes.size());
+
+    // Starts are ascending (MidiNoteList order); ends are close enough to it
+    std::vector<double> beats(notes.size());
+    std::vector<double> times(notes.size());
+    for (size_t i = 0; i < notes.size(); ++i) {
+        beats[i] = originBeat + notes[i].startBeat;
+    }
+    beatsToSeconds(beats.data(), times.data(), beats.size());
+    for (size_t i = 0; i < notes.size(); ++i) {
+        out[i].start = times[i];
+        beats[i] += notes[i].lengthBeats;
+    }
+    beatsToSeconds(beats.data(), times.data(), beats.size());
+    for (size_t i = 0; i < notes.size(); ++i) {
+        out[i].end = times[i];
+    }
+}
+
+TempoMap::BarBeat TempoMap::toBarBeat(double seconds) const {
+    const double beats = std::max(0.0, secondsToBeats(seconds));
+    const double beatsPerBar = getBeatsPerBar();
+
+    BarBeat result;
+    result.bar = static_cast<int>(beats / beatsPerBar) + 1;
+    const double beatInBar = beats - (result.bar - 1) * beatsPerBar;
+    result.beat = std::min(numerator_, static_cast<int>(beatInBar) + 1);
+    const double fraction = beatInBar - std::floor(beatInBar);
+    result.sixteenth = std::min(4, static_cast<int>(fraction * 4) + 1);
+    return result;
+}
+
+}  // namespace magda
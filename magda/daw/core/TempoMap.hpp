@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "MidiNoteList.hpp"
+
+namespace magda {
+
+/**
+ * @brief Piecewise-constant tempo over the project, with beat <-> seconds conversions
+ *
+ * The tempo is a list of changes, each holding from its beat until the next. Every point
+ * conversion is a binary search over the changes; the batch versions walk sorted input
+ * alongside them, so converting a clip's notes costs the notes plus the changes they
+ * span. Bars assume one time signature for the whole project.
+ *
+ * The version goes up whenever the map actually changes, so a cache of pixel positions
+ * or grid lines computed from it can stay valid until getVersion() moves on.
+ */
+class TempoMap {
+  public:
+    struct TempoChange {
+        double beat = 0.0;  // Where this tempo starts
+        double bpm = 120.0;
+    };
+
+    struct BarBeat {
+        int bar = 1;        // 1-based
+        int beat = 1;       // 1-based, within the bar
+        int sixteenth = 1;  // 1-4, within the beat
+    };
+
+    struct TimeRange {
+        double start = 0.0;
+        double end = 0.0;
+    };
+
+    static constexpr double kMinBpm = 20.0;
+    static constexpr double kMaxBpm = 999.0;
+
+    explicit TempoMap(double bpm = 120.0, int numerator = 4, int denominator = 4);
+
+    /**
+     * @brief The project's map (message thread); TimelineController keeps it matched to
+     *        the transport's tempo and time signature
+     */
+    static TempoMap& getInstance();
+
+    /**
+     * @brief One tempo from the start of the project
+     */
+    void setTempo(double bpm);
+
+    /**
+     * @brief Replace the map; unsorted changes are sorted, and the first one is moved to
+     *        beat 0 if it starts later
+     */
+    void setTempoChanges(std::vector<TempoChange> changes);
+
+    void setTimeSignature(int numerator, int denominator);
+
+    const std::vector<TempoChange>& getTempoChanges() const {
+        return changes_;
+    }
+    int getTimeSignatureNumerator() const {
+        return numerator_;
+    }
+    int getTimeSignatureDenominator() const {
+        return denominator_;
+    }
+    uint64_t getVersion() const {
+        return version_;
+    }
+
+    double getBpmAtBeat(double beat) const;
+    double getBpmAtTime(double seconds) const;
+
+    double beatsToSeconds(double beats) const;
+    double secondsToBeats(double seconds) const;
+
+    /**
+     * @brief Convert count values at once; fastest when the input is ascending
+     *
+     * in and out may be the same array.
+     */
+    void beatsToSeconds(const double* beats, double* seconds, size_t count) const;
+    void secondsToBeats(const double* seconds, double* beats, size_t count) const;
+
+    /**
+     * @brief Seconds spanned by each note of a clip, in the notes' order
+     * @param originBeat Timeline beat of the clip start (note beats are relative to it)
+     */
+    void notesToSeconds(const std::vector<MidiNote>& notes, double originBeat,
+                        std::vector<TimeRange>& out) const;
+
+    /**
+     * @brief Bar, beat and sixteenth of a time, for display
+     */
+    BarBeat toBarBeat(double seconds) const;
+
+    double getBeatsPerBar() const {
+        return static_cast<double>(numerator_);
+    }
+
+  private:
+    struct Segment {
+        double startBeat = 0.0;
+        double startSeconds = 0.0;
+        double secondsPerBeat = 0.5;
+    };
+
+    size_t segmentForBeat(double beat) const;
+    size_t segmentForTime(double seconds) const;
+    void rebuildSegments();
+
+    std::vector<TempoChange> changes_;
+    std::vector<Segment> segments_;  // One per change, with the seconds it starts at
+    int numerator_ = 4;
+    int denominator_ = 4;
+    uint64_t version_ = 1;
+};
+
+}  // namespace magda
@@ -8,15 +8,16 @@ namespace magda {
 // CreateTrackCommand
 // ============================================================================
 
-CreateTrackCommand::CreateTrackCommand(TrackType type) : type_(type) {}
+CreateTrackCommand::CreateTrackCommand(TrackType type, const juce::String& name)
+    : type_(type), name_(name) {}
 
 void CreateTrackCommand::execute() {
     auto& trackManager = TrackManager::getInstance();
 
     if (type_ == TrackType::Group) {
-        createdTrackId_ = trackManager.createGroupTrack();
+        createdTrackId_ = trackManager.createGroupTrack(name_);
     } else {
-        createdTrackId_ = trackManager.createTrack("", type_);
+        createdTrackId_ = trackManager.createTrack(name_, type_);
     }
 
     executed_ = true;
@@ -74,6 +75,10 @@ void DeleteTrackCommand::execute() {
     std::cout << "📝 UNDO: Deleted track " << trackId_ << std::endl;
 }
 
+size_t DeleteTrackCommand::getSizeInBytes() const {
+    return sizeof(*this) + estimateChainBytes(storedTrack_.chainElements);
+}
+
 void DeleteTrackCommand::undo() {
     if (!executed_) {
         return;
@@ -91,24 +96,7 @@ DuplicateTrackCommand::DuplicateTrackCommand(TrackId sourceTrackId)
     : sourceTrackId_(sourceTrackId) {}
 
 void DuplicateTrackCommand::execute() {
-    auto& trackManager = TrackManager::getInstance();
-
-    // Get the current track count to determine the new track's ID
-    int trackCountBefore = trackManager.getNumTracks();
-
-    trackManager.duplicateTrack(sourceTrackId_);
-
-    // Find the newly created track (it should be the last one added)
-    const auto& tracks = trackManager.getTracks();
-    if (static_cast<int>(tracks.size()) > trackCountBefore) {
-        // Find the track that was just added (the duplicate)
-        for (const auto& track : tracks) {
-            if (track.name.endsWith(" Copy")) {
-                duplicatedTrackId_ = track.id;
-                break;
-            }
-        }
-    }
+    duplicatedTrackId_ = TrackManager::getInstance().duplicateTrack(sourceTrackId_);
 
     executed_ = true;
     std::cout << "📝 UNDO: Duplicated track " << sourceTrackId_ << " -> " << duplicatedTrackId_
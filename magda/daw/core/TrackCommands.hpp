@@ -10,7 +10,8 @@ namespace magda {
  */
 class CreateTrackCommand : public UndoableCommand {
   public:
-    explicit CreateTrackCommand(TrackType type = TrackType::Audio);
+    explicit CreateTrackCommand(TrackType type = TrackType::Audio,
+                                const juce::String& name = "");
 
     void execute() override;
     void undo() override;
@@ -22,6 +23,7 @@ class CreateTrackCommand : public UndoableCommand {
 
   private:
     TrackType type_;
+    juce::String name_;
     TrackId createdTrackId_ = INVALID_TRACK_ID;
     bool executed_ = false;
 };
@@ -38,6 +40,7 @@ class DeleteTrackCommand : public UndoableCommand {
     juce::String getDescription() const override {
         return "Delete Track";
     }
+    size_t getSizeInBytes() const override;
 
   private:
     TrackId trackId_;
@@ -9,6 +9,18 @@
 
 namespace magda {
 
+/**
+ * @brief A send from a track into an aux track
+ *
+ * Sends to a track that is missing or no longer an aux are kept but silent, so undoing
+ * the aux track's deletion reconnects them.
+ */
+struct SendInfo {
+    TrackId destinationId = INVALID_TRACK_ID;  // The Aux track that receives it
+    float level = 1.0f;                        // Send gain (0-2, unity by default like the fader)
+    bool preFader = false;                     // Taken before the track's volume and pan
+};
+
 /**
  * @brief Track data structure containing all track properties
  */
@@ -28,78 +40,25 @@ struct TrackInfo {
     bool muted = false;
     bool soloed = false;
     bool recordArmed = false;
+    bool directMonitor = false;  // Armed input heard straight from the device, dry
+
+    // Freeze (engine state, not saved with the project)
+    FreezeState freezeState = FreezeState::Unfrozen;
 
     // Routing
     juce::String midiInputDevice;    // MIDI input device ID ("all", device ID, or empty for none)
     juce::String midiOutputDevice;   // MIDI output device ID (device ID or empty for none)
     juce::String audioInputDevice;   // Audio input device/channel (device ID or empty for none)
     juce::String audioOutputDevice;  // Audio output routing (default: "master")
+    std::vector<SendInfo> sends;     // Into aux tracks, in order
 
-    // Signal chain - ordered list of nodes (devices or racks) on this track
+    // Signal chain - ordered list of nodes (devices or racks) on this track.
+    // Copying a TrackInfo shares these nodes; an edit unshares only its path (see CowPtr).
     std::vector<ChainElement> chainElements;
 
     // View settings per view mode
     TrackViewSettingsMap viewSettings;
 
-    // Default constructor
-    TrackInfo() = default;
-
-    // Move operations (default is fine)
-    TrackInfo(TrackInfo&&) = default;
-    TrackInfo& operator=(TrackInfo&&) = default;
-
-    // Copy constructor - deep copies chainElements
-    TrackInfo(const TrackInfo& other)
-        : id(other.id),
-          type(other.type),
-          name(other.name),
-          colour(other.colour),
-          parentId(other.parentId),
-          childIds(other.childIds),
-          volume(other.volume),
-          pan(other.pan),
-          muted(other.muted),
-          soloed(other.soloed),
-          recordArmed(other.recordArmed),
-          midiInputDevice(other.midiInputDevice),
-          midiOutputDevice(other.midiOutputDevice),
-          audioInputDevice(other.audioInputDevice),
-          audioOutputDevice(other.audioOutputDevice),
-          viewSettings(other.viewSettings) {
-        chainElements.reserve(other.chainElements.size());
-        for (const auto& element : other.chainElements) {
-            chainElements.push_back(deepCopyElement(element));
-        }
-    }
-
-    // Copy assignment - deep copies chainElements
-    TrackInfo& operator=(const TrackInfo& other) {
-        if (this != &other) {
-            id = other.id;
-            type = other.type;
-            name = other.name;
-            colour = other.colour;
-            parentId = other.parentId;
-            childIds = other.childIds;
-            volume = other.volume;
-            pan = other.pan;
-            muted = other.muted;
-            soloed = other.soloed;
-            recordArmed = other.recordArmed;
-            midiInputDevice = other.midiInputDevice;
-            midiOutputDevice = other.midiOutputDevice;
-            audioInputDevice = other.audioInputDevice;
-            audioOutputDevice = other.audioOutputDevice;
-            viewSettings = other.viewSettings;
-            chainElements.clear();
-            chainElements.reserve(other.chainElements.size());
-            for (const auto& element : other.chainElements) {
-                chainElements.push_back(deepCopyElement(element));
-            }
-        }
-        return *this;
-    }
-
     // Default track colors
     static inline const std::array<juce::uint32, 8> defaultColors = {
         0xFF5588AA,  // Blue
@@ -129,6 +88,9 @@ struct TrackInfo {
     bool isTopLevel() const {
         return parentId == INVALID_TRACK_ID;
     }
+    bool isFrozen() const {
+        return freezeState == FreezeState::Frozen;
+    }
 
     // View settings helpers
     bool isVisibleIn(ViewMode mode) const {
@@ -1,15 +1,143 @@
 #include "TrackManager.hpp"
 
 #include <algorithm>
+#include <type_traits>
+#include <utility>
 
 #include "../audio/AudioBridge.hpp"
 #include "../audio/MidiBridge.hpp"
 #include "../engine/AudioEngine.hpp"
+#include "../profiling/MemoryEstimates.hpp"
 #include "ModulatorEngine.hpp"
 #include "RackInfo.hpp"
 
 namespace magda {
 
+namespace {
+
+// Element reached by walking indices[0, count) from a chain (see NodeLocation), or nullptr
+template <typename Elements>
+auto elementAt(Elements& elements, const std::vector<int>& indices, size_t count)
+    -> std::remove_reference_t<decltype(elements[0])>* {
+    Elements* current = &elements;
+    for (size_t i = 0; i < count; i += 2) {
+        const int index = indices[i];
+        if (index < 0 || index >= static_cast<int>(current->size())) {
+            return nullptr;
+        }
+
+        auto& element = (*current)[static_cast<size_t>(index)];
+        if (i + 1 == count) {
+            return &element;
+        }
+        if (!isRack(element)) {
+            return nullptr;
+        }
+
+        auto& chains = magda::getRack(element).chains;
+        const int chainIndex = indices[i + 1];
+        if (chainIndex < 0 || chainIndex >= static_cast<int>(chains.size())) {
+            return nullptr;
+        }
+        current = &chains[static_cast<size_t>(chainIndex)].elements;
+    }
+    return nullptr;
+}
+
+// Chain at the end of indices (a chain's NodeLocation), or nullptr
+template <typename Elements>
+auto chainAt(Elements& elements, const std::vector<int>& indices)
+    -> decltype(&magda::getRack(elements[0]).chains[0]) {
+    if (indices.size() < 2 || indices.size() % 2 != 0) {
+        return nullptr;
+    }
+
+    auto* element = elementAt(elements, indices, indices.size() - 1);
+    if (!element || !isRack(*element)) {
+        return nullptr;
+    }
+
+    auto& chains = magda::getRack(*element).chains;
+    const int chainIndex = indices.back();
+    if (chainIndex < 0 || chainIndex >= static_cast<int>(chains.size())) {
+        return nullptr;
+    }
+    return &chains[static_cast<size_t>(chainIndex)];
+}
+
+// Raise the next device, rack and chain ids past every node in elements
+void reserveNodeIds(const std::vector<ChainElement>& elements, int& nextDeviceId, int& nextRackId,
+                    int& nextChainId) {
+    for (const auto& element : elements) {
+        if (isDevice(element)) {
+            nextDeviceId = std::max(nextDeviceId, magda::getDevice(element).id + 1);
+            continue;
+        }
+        const auto& rack = magda::getRack(element);
+        nextRackId = std::max(nextRackId, rack.id + 1);
+        for (const auto& chain : rack.chains) {
+            nextChainId = std::max(nextChainId, chain.id + 1);
+            reserveNodeIds(chain.elements, nextDeviceId, nextRackId, nextChainId);
+        }
+    }
+}
+
+// Give every node in elements a fresh id, recording each device's original id -> new id
+void renumberNodes(std::vector<ChainElement>& elements, int& nextDeviceId, int& nextRackId,
+                   int& nextChainId, std::unordered_map<DeviceId, DeviceId>& deviceIds) {
+    for (auto& element : elements) {
+        if (isDevice(element)) {
+            auto& device = magda::getDevice(element);
+            deviceIds[device.id] = nextDeviceId;
+            device.id = nextDeviceId++;
+            continue;
+        }
+        auto& rack = magda::getRack(element);
+        rack.id = nextRackId++;
+        for (auto& chain : rack.chains) {
+            chain.id = nextChainId++;
+            renumberNodes(chain.elements, nextDeviceId, nextRackId, nextChainId, deviceIds);
+        }
+    }
+}
+
+// Point mod and macro links at the renumbered devices; links that leave the tree stay as-is
+template <typename Slots>
+void retargetLinks(Slots& slots, const std::unordered_map<DeviceId, DeviceId>& deviceIds) {
+    auto retarget = [&deviceIds](auto& target) {
+        auto it = deviceIds.find(target.deviceId);
+        if (it != deviceIds.end()) {
+            target.deviceId = it->second;
+        }
+    };
+    for (auto& slot : slots) {
+        retarget(slot.target);
+        for (auto& link : slot.links) {
+            retarget(link.target);
+        }
+    }
+}
+
+void retargetLinks(std::vector<ChainElement>& elements,
+                   const std::unordered_map<DeviceId, DeviceId>& deviceIds) {
+    for (auto& element : elements) {
+        if (isDevice(element)) {
+            auto& device = magda::getDevice(element);
+            retargetLinks(device.mods, deviceIds);
+            retargetLinks(device.macros, deviceIds);
+            continue;
+        }
+        auto& rack = magda::getRack(element);
+        retargetLinks(rack.mods, deviceIds);
+        retargetLinks(rack.macros, deviceIds);
+        for (auto& chain : rack.chains) {
+            retargetLinks(chain.elements, deviceIds);
+        }
+    }
+}
+
+}  // namespace
+
 TrackManager& TrackManager::getInstance() {
     static TrackManager instance;
     return instance;
@@ -39,6 +167,8 @@ TrackId TrackManager::createTrack(const juce::String& name, TrackType type) {
 
     TrackId trackId = track.id;
     tracks_.push_back(track);
+    invalidateTrackIndex();
+    markTrackAdded(trackId);
     notifyTracksChanged();
 
     DBG("Created track: " << track.name << " (id=" << trackId << ", type=" << getTrackTypeName(type)
@@ -70,6 +200,7 @@ void TrackManager::deleteTrack(TrackId trackId) {
         if (auto* parent = getTrack(track->parentId)) {
             auto& children = parent->childIds;
             children.erase(std::remove(children.begin(), children.end(), trackId), children.end());
+            markTrackModified(parent->id, TrackDirty::Hierarchy);
         }
     }
 
@@ -89,6 +220,8 @@ void TrackManager::deleteTrack(TrackId trackId) {
     if (it != tracks_.end()) {
         DBG("Deleted track: " << it->name << " (id=" << trackId << ")");
         tracks_.erase(it);
+        invalidateTrackIndex();
+        markTrackRemoved(trackId);
         notifyTracksChanged();
     }
 }
@@ -104,6 +237,8 @@ void TrackManager::restoreTrack(const TrackInfo& trackInfo) {
     }
 
     tracks_.push_back(trackInfo);
+    invalidateTrackIndex();
+    markTrackAdded(trackInfo.id);
 
     // Ensure nextTrackId_ is beyond any restored track IDs
     if (trackInfo.id >= nextTrackId_) {
@@ -116,6 +251,7 @@ void TrackManager::restoreTrack(const TrackInfo& trackInfo) {
             if (std::find(parent->childIds.begin(), parent->childIds.end(), trackInfo.id) ==
                 parent->childIds.end()) {
                 parent->childIds.push_back(trackInfo.id);
+                markTrackModified(parent->id, TrackDirty::Hierarchy);
             }
         }
     }
@@ -124,7 +260,7 @@ void TrackManager::restoreTrack(const TrackInfo& trackInfo) {
     DBG("Restored track: " << trackInfo.name << " (id=" << trackInfo.id << ")");
 }
 
-void TrackManager::duplicateTrack(TrackId trackId) {
+TrackId TrackManager::duplicateTrack(TrackId trackId) {
     auto it = std::find_if(tracks_.begin(), tracks_.end(),
                            [trackId](const TrackInfo& t) { return t.id == trackId; });
 
@@ -134,20 +270,46 @@ void TrackManager::duplicateTrack(TrackId trackId) {
         newTrack.name = it->name + " Copy";
         newTrack.childIds.clear();  // Don't duplicate children references
 
+        // The copy's devices get their own ids, so the engine gives them their own plugins
+        std::unordered_map<DeviceId, DeviceId> deviceIds;
+        renumberNodes(newTrack.chainElements, nextDeviceId_, nextRackId_, nextChainId_,
+                      deviceIds);
+        retargetLinks(newTrack.chainElements, deviceIds);
+
+        // Their plugins start from the originals' state, read now while the source is intact.
+        // The copy itself appears straight away; its plugins load in the background.
+        if (audioEngine_) {
+            if (auto* audioBridge = audioEngine_->getAudioBridge()) {
+                std::vector<std::pair<DeviceId, DeviceId>> clones;
+                for (const auto& element : std::as_const(*it).chainElements) {
+                    if (isDevice(element)) {
+                        const auto sourceId = magda::getDevice(element).id;
+                        clones.emplace_back(sourceId, deviceIds.at(sourceId));
+                    }
+                }
+                audioBridge->clonePluginStates(clones);
+            }
+        }
+
         // Insert after the original
         auto insertPos = it + 1;
         tracks_.insert(insertPos, newTrack);
+        invalidateTrackIndex();
+        markTrackAdded(newTrack.id);
 
         // If the original had a parent, add the copy to the same parent
         if (newTrack.hasParent()) {
             if (auto* parent = getTrack(newTrack.parentId)) {
                 parent->childIds.push_back(newTrack.id);
+                markTrackModified(parent->id, TrackDirty::Hierarchy);
             }
         }
 
         notifyTracksChanged();
         DBG("Duplicated track: " << newTrack.name << " (id=" << newTrack.id << ")");
+        return newTrack.id;
     }
+    return INVALID_TRACK_ID;
 }
 
 void TrackManager::moveTrack(TrackId trackId, int newIndex) {
@@ -160,6 +322,8 @@ void TrackManager::moveTrack(TrackId trackId, int newIndex) {
         TrackInfo track = tracks_[currentIndex];
         tracks_.erase(tracks_.begin() + currentIndex);
         tracks_.insert(tracks_.begin() + newIndex, track);
+        invalidateTrackIndex();
+        markTracksReordered();
         notifyTracksChanged();
     }
 }
@@ -192,6 +356,9 @@ void TrackManager::addTrackToGroup(TrackId trackId, TrackId groupId) {
     // Add to new parent
     track->parentId = groupId;
     group->childIds.push_back(trackId);
+    invalidateViewIndex();
+    markTrackModified(trackId, TrackDirty::Hierarchy);
+    markTrackModified(groupId, TrackDirty::Hierarchy);
 
     notifyTracksChanged();
     DBG("Added track " << track->name << " to group " << group->name);
@@ -205,9 +372,12 @@ void TrackManager::removeTrackFromGroup(TrackId trackId) {
     if (auto* parent = getTrack(track->parentId)) {
         auto& children = parent->childIds;
         children.erase(std::remove(children.begin(), children.end(), trackId), children.end());
+        markTrackModified(parent->id, TrackDirty::Hierarchy);
     }
 
     track->parentId = INVALID_TRACK_ID;
+    invalidateViewIndex();
+    markTrackModified(trackId, TrackDirty::Hierarchy);
     notifyTracksChanged();
 }
 
@@ -224,30 +394,31 @@ TrackId TrackManager::createTrackInGroup(TrackId groupId, const juce::String& na
     return newId;
 }
 
-std::vector<TrackId> TrackManager::getChildTracks(TrackId groupId) const {
+std::span<const TrackId> TrackManager::getChildTracks(TrackId groupId) const {
     const auto* group = getTrack(groupId);
     if (!group)
         return {};
     return group->childIds;
 }
 
-std::vector<TrackId> TrackManager::getTopLevelTracks() const {
-    std::vector<TrackId> result;
-    for (const auto& track : tracks_) {
-        if (track.isTopLevel()) {
-            result.push_back(track.id);
-        }
-    }
-    return result;
+std::span<const TrackId> TrackManager::getTopLevelTracks() const {
+    ensureViewIndex();
+    return viewIndex_.topLevel;
 }
 
-std::vector<TrackId> TrackManager::getAllDescendants(TrackId trackId) const {
-    std::vector<TrackId> result;
+std::span<const TrackId> TrackManager::getAllDescendants(TrackId trackId) const {
+    ensureViewIndex();
     const auto* track = getTrack(trackId);
     if (!track)
-        return result;
+        return {};
+
+    auto [it, inserted] = viewIndex_.descendants.try_emplace(trackId);
+    if (!inserted) {
+        return it->second;
+    }
 
     // BFS to collect all descendants
+    auto& result = it->second;
     std::vector<TrackId> toProcess = track->childIds;
     while (!toProcess.empty()) {
         TrackId current = toProcess.back();
@@ -263,29 +434,240 @@ std::vector<TrackId> TrackManager::getAllDescendants(TrackId trackId) const {
     return result;
 }
 
+void TrackManager::ensureViewIndex() const {
+    if (!viewIndexDirty_) {
+        return;
+    }
+
+    // Cleared in place, so the vectors keep their capacity across rebuilds
+    for (size_t mode = 0; mode < kNumViewModes; ++mode) {
+        viewIndex_.visible[mode].clear();
+        viewIndex_.visibleTopLevel[mode].clear();
+    }
+    viewIndex_.topLevel.clear();
+    viewIndex_.descendants.clear();
+
+    for (const auto& track : tracks_) {
+        const bool topLevel = track.isTopLevel();
+        if (topLevel) {
+            viewIndex_.topLevel.push_back(track.id);
+        }
+        for (size_t mode = 0; mode < kNumViewModes; ++mode) {
+            if (!track.isVisibleIn(static_cast<ViewMode>(mode))) {
+                continue;
+            }
+            viewIndex_.visible[mode].push_back(track.id);
+            if (topLevel) {
+                viewIndex_.visibleTopLevel[mode].push_back(track.id);
+            }
+        }
+    }
+    viewIndexDirty_ = false;
+}
+
 // ============================================================================
 // Access
 // ============================================================================
 
 TrackInfo* TrackManager::getTrack(TrackId trackId) {
-    auto it = std::find_if(tracks_.begin(), tracks_.end(),
-                           [trackId](const TrackInfo& t) { return t.id == trackId; });
-    return (it != tracks_.end()) ? &(*it) : nullptr;
+    const int index = getTrackIndex(trackId);
+    return index >= 0 ? &tracks_[static_cast<size_t>(index)] : nullptr;
 }
 
 const TrackInfo* TrackManager::getTrack(TrackId trackId) const {
-    auto it = std::find_if(tracks_.begin(), tracks_.end(),
-                           [trackId](const TrackInfo& t) { return t.id == trackId; });
-    return (it != tracks_.end()) ? &(*it) : nullptr;
+    const int index = getTrackIndex(trackId);
+    return index >= 0 ? &tracks_[static_cast<size_t>(index)] : nullptr;
 }
 
 int TrackManager::getTrackIndex(TrackId trackId) const {
+    ensureTrackIndex();
+    auto it = trackPositions_.find(trackId);
+    if (it == trackPositions_.end()) {
+        return -1;
+    }
+
+    if (it->second >= tracks_.size() || tracks_[it->second].id != trackId) {
+        // tracks_ changed without invalidating the index
+        trackIndexDirty_ = true;
+        ensureTrackIndex();
+        it = trackPositions_.find(trackId);
+        return it != trackPositions_.end() ? static_cast<int>(it->second) : -1;
+    }
+    return static_cast<int>(it->second);
+}
+
+DeviceInfo* TrackManager::findDevice(DeviceId deviceId) {
+    const auto* location = locateDevice(deviceId);
+    if (!location) {
+        return nullptr;
+    }
+
+    auto* track = getTrack(location->trackId);
+    auto* element = elementAt(track->chainElements, location->indices, location->indices.size());
+    return &magda::getDevice(*element);
+}
+
+const DeviceInfo* TrackManager::findDevice(DeviceId deviceId) const {
+    const auto* location = locateDevice(deviceId);
+    if (!location) {
+        return nullptr;
+    }
+
+    const auto* track = getTrack(location->trackId);
+    const auto* element =
+        elementAt(track->chainElements, location->indices, location->indices.size());
+    return &magda::getDevice(*element);
+}
+
+const ModulationSources& TrackManager::getModulationSources(DeviceId deviceId,
+                                                           int paramIndex) const {
+    if (modulationIndexDirty_) {
+        modulationIndex_.clear();
+        forEachTrackMod([this](TrackId trackId, ModOwner owner, int ownerId, int modIndex,
+                               const ModInfo& mod) {
+            for (const auto& link : mod.links) {
+                modulationIndex_.addMod(trackId, owner, ownerId, modIndex, link);
+            }
+        });
+        forEachTrackMacro([this](TrackId trackId, ModOwner owner, int ownerId, int macroIndex,
+                                 const MacroInfo& macro) {
+            for (const auto& link : macro.links) {
+                modulationIndex_.addMacro(trackId, owner, ownerId, macroIndex, link);
+            }
+        });
+        modulationIndexDirty_ = false;
+    }
+    return modulationIndex_.find(deviceId, paramIndex);
+}
+
+ChainNodePath TrackManager::findDevicePath(DeviceId deviceId) const {
+    ChainNodePath path;
+    const auto* location = locateDevice(deviceId);
+    if (!location) {
+        return path;
+    }
+
+    path.trackId = location->trackId;
+    const auto& indices = location->indices;
+    if (indices.size() == 1) {
+        path.topLevelDeviceId = deviceId;
+        return path;
+    }
+
+    // Name each rack and chain on the way down by id
+    const auto& elements = getTrack(location->trackId)->chainElements;
+    for (size_t count = 1; count < indices.size(); count += 2) {
+        const auto& rack = magda::getRack(*elementAt(elements, indices, count));
+        path.steps.push_back({ChainStepType::Rack, rack.id});
+        path.steps.push_back(
+            {ChainStepType::Chain, rack.chains[static_cast<size_t>(indices[count])].id});
+    }
+    path.steps.push_back({ChainStepType::Device, deviceId});
+    return path;
+}
+
+void TrackManager::ensureTrackIndex() const {
+    if (!trackIndexDirty_) {
+        return;
+    }
+
+    trackPositions_.clear();
+    trackPositions_.reserve(tracks_.size());
     for (size_t i = 0; i < tracks_.size(); ++i) {
-        if (tracks_[i].id == trackId) {
-            return static_cast<int>(i);
+        trackPositions_.emplace(tracks_[i].id, i);
+    }
+    trackIndexDirty_ = false;
+}
+
+bool TrackManager::ensureNodeIndex() const {
+    if (!nodeIndexDirty_) {
+        return false;
+    }
+
+    deviceLocations_.clear();
+    rackLocations_.clear();
+    chainLocations_.clear();
+
+    NodeLocation location;
+    for (const auto& track : tracks_) {
+        location.trackId = track.id;
+        indexElements(track.chainElements, location);
+    }
+    nodeIndexDirty_ = false;
+    return true;
+}
+
+void TrackManager::indexElements(const std::vector<ChainElement>& elements,
+                                 NodeLocation& location) const {
+    // emplace keeps the first location, so ids shared across tracks (duplicates saved by
+    // older versions) resolve to the first track
+    for (size_t i = 0; i < elements.size(); ++i) {
+        location.indices.push_back(static_cast<int>(i));
+
+        const auto& element = elements[i];
+        if (isDevice(element)) {
+            deviceLocations_.emplace(magda::getDevice(element).id, location);
+        } else if (isRack(element)) {
+            const auto& rack = magda::getRack(element);
+            rackLocations_.emplace(rack.id, location);
+            for (size_t c = 0; c < rack.chains.size(); ++c) {
+                location.indices.push_back(static_cast<int>(c));
+                chainLocations_.emplace(rack.chains[c].id, location);
+                indexElements(rack.chains[c].elements, location);
+                location.indices.pop_back();
+            }
         }
+
+        location.indices.pop_back();
     }
-    return -1;
+}
+
+const TrackManager::NodeLocation* TrackManager::locateNode(const NodeLocations& locations,
+                                                           int id, NodeMatcher matches) const {
+    auto lookUp = [&]() -> const NodeLocation* {
+        auto it = locations.find(id);
+        if (it == locations.end()) {
+            return nullptr;
+        }
+        const auto* track = getTrack(it->second.trackId);
+        return track && matches(*track, it->second, id) ? &it->second : nullptr;
+    };
+
+    const bool rebuilt = ensureNodeIndex();
+    if (const auto* location = lookUp(); location || rebuilt) {
+        return location;
+    }
+
+    // Chains can be edited in place through getTrack(); rescan once before giving up
+    nodeIndexDirty_ = true;
+    ensureNodeIndex();
+    return lookUp();
+}
+
+const TrackManager::NodeLocation* TrackManager::locateDevice(DeviceId deviceId) const {
+    return locateNode(deviceLocations_, deviceId,
+                      [](const TrackInfo& track, const NodeLocation& location, int id) {
+                          const auto* element = elementAt(track.chainElements, location.indices,
+                                                          location.indices.size());
+                          return element && isDeviceWithId(*element, id);
+                      });
+}
+
+const TrackManager::NodeLocation* TrackManager::locateRack(RackId rackId) const {
+    return locateNode(rackLocations_, rackId,
+                      [](const TrackInfo& track, const NodeLocation& location, int id) {
+                          const auto* element = elementAt(track.chainElements, location.indices,
+                                                          location.indices.size());
+                          return element && isRackWithId(*element, id);
+                      });
+}
+
+const TrackManager::NodeLocation* TrackManager::locateChain(ChainId chainId) const {
+    return locateNode(chainLocations_, chainId,
+                      [](const TrackInfo& track, const NodeLocation& location, int id) {
+                          const auto* chain = chainAt(track.chainElements, location.indices);
+                          return chain && chain->id == id;
+                      });
 }
 
 // ============================================================================
@@ -295,14 +677,14 @@ int TrackManager::getTrackIndex(TrackId trackId) const {
 void TrackManager::setTrackName(TrackId trackId, const juce::String& name) {
     if (auto* track = getTrack(trackId)) {
         track->name = name;
-        notifyTrackPropertyChanged(trackId);
+        notifyTrackPropertyChanged(trackId, TrackDirty::Name);
     }
 }
 
 void TrackManager::setTrackColour(TrackId trackId, juce::Colour colour) {
     if (auto* track = getTrack(trackId)) {
         track->colour = colour;
-        notifyTrackPropertyChanged(trackId);
+        notifyTrackPropertyChanged(trackId, TrackDirty::Colour);
     }
 }
 
@@ -310,35 +692,42 @@ void TrackManager::setTrackVolume(TrackId trackId, float volume) {
     if (auto* track = getTrack(trackId)) {
         // Allow up to +6dB gain (10^(6/20) ≈ 2.0)
         track->volume = juce::jlimit(0.0f, 2.0f, volume);
-        notifyTrackPropertyChanged(trackId);
+        notifyTrackPropertyChanged(trackId, TrackDirty::Mixer);
     }
 }
 
 void TrackManager::setTrackPan(TrackId trackId, float pan) {
     if (auto* track = getTrack(trackId)) {
         track->pan = juce::jlimit(-1.0f, 1.0f, pan);
-        notifyTrackPropertyChanged(trackId);
+        notifyTrackPropertyChanged(trackId, TrackDirty::Mixer);
     }
 }
 
 void TrackManager::setTrackMuted(TrackId trackId, bool muted) {
     if (auto* track = getTrack(trackId)) {
         track->muted = muted;
-        notifyTrackPropertyChanged(trackId);
+        notifyTrackPropertyChanged(trackId, TrackDirty::Mixer);
     }
 }
 
 void TrackManager::setTrackSoloed(TrackId trackId, bool soloed) {
     if (auto* track = getTrack(trackId)) {
         track->soloed = soloed;
-        notifyTrackPropertyChanged(trackId);
+        notifyTrackPropertyChanged(trackId, TrackDirty::Mixer);
     }
 }
 
 void TrackManager::setTrackRecordArmed(TrackId trackId, bool armed) {
     if (auto* track = getTrack(trackId)) {
         track->recordArmed = armed;
-        notifyTrackPropertyChanged(trackId);
+        notifyTrackPropertyChanged(trackId, TrackDirty::Mixer);
+    }
+}
+
+void TrackManager::setTrackDirectMonitor(TrackId trackId, bool direct) {
+    if (auto* track = getTrack(trackId)) {
+        track->directMonitor = direct;
+        notifyTrackPropertyChanged(trackId, TrackDirty::Mixer);
     }
 }
 
@@ -350,7 +739,44 @@ void TrackManager::setTrackType(TrackId trackId, TrackType type) {
             return;
         }
         track->type = type;
-        notifyTrackPropertyChanged(trackId);
+        notifyTrackPropertyChanged(trackId, TrackDirty::Type);
+    }
+}
+
+void TrackManager::freezeTrack(TrackId trackId) {
+    auto* track = getTrack(trackId);
+    if (!track || track->isGroup() || track->freezeState != FreezeState::Unfrozen ||
+        !audioEngine_) {
+        return;
+    }
+
+    // Freezing first: the engine may report the outcome before returning
+    track->freezeState = FreezeState::Freezing;
+    notifyTrackPropertyChanged(trackId, TrackDirty::Freeze);
+
+    if (!audioEngine_->freezeTrack(std::to_string(trackId))) {
+        setTrackFreezeState(trackId, FreezeState::Unfrozen);
+    }
+}
+
+void TrackManager::unfreezeTrack(TrackId trackId) {
+    auto* track = getTrack(trackId);
+    if (!track || track->freezeState == FreezeState::Unfrozen) {
+        return;
+    }
+
+    if (audioEngine_) {
+        audioEngine_->unfreezeTrack(std::to_string(trackId));
+    }
+    setTrackFreezeState(trackId, FreezeState::Unfrozen);
+}
+
+void TrackManager::setTrackFreezeState(TrackId trackId, FreezeState state) {
+    if (auto* track = getTrack(trackId)) {
+        if (track->freezeState != state) {
+            track->freezeState = state;
+            notifyTrackPropertyChanged(trackId, TrackDirty::Freeze);
+        }
     }
 }
 
@@ -382,9 +808,7 @@ void TrackManager::previewNote(TrackId trackId, int noteNumber, int velocity, bo
         auto* track = getTrack(trackId);
         if (track) {
             DBG("TrackManager: Found track, forwarding to engine");
-            // Convert TrackId to engine track ID string
-            audioEngine_->previewNoteOnTrack(std::to_string(trackId), noteNumber, velocity,
-                                             isNoteOn);
+            audioEngine_->previewNote(trackId, noteNumber, velocity, isNoteOn);
         } else {
             DBG("TrackManager: WARNING - Track not found!");
         }
@@ -430,7 +854,7 @@ void TrackManager::setTrackMidiInput(TrackId trackId, const juce::String& device
     }
 
     // Notify listeners (inspector, track headers will update)
-    notifyTrackPropertyChanged(trackId);
+    notifyTrackPropertyChanged(trackId, TrackDirty::Routing);
 }
 
 void TrackManager::setTrackMidiOutput(TrackId trackId, const juce::String& deviceId) {
@@ -448,7 +872,7 @@ void TrackManager::setTrackMidiOutput(TrackId trackId, const juce::String& devic
     // TODO: Forward to MidiBridge when MIDI output routing is implemented
 
     // Notify listeners
-    notifyTrackPropertyChanged(trackId);
+    notifyTrackPropertyChanged(trackId, TrackDirty::Routing);
 }
 
 void TrackManager::setTrackAudioInput(TrackId trackId, const juce::String& deviceId) {
@@ -471,7 +895,7 @@ void TrackManager::setTrackAudioInput(TrackId trackId, const juce::String& devic
     }
 
     // Notify listeners
-    notifyTrackPropertyChanged(trackId);
+    notifyTrackPropertyChanged(trackId, TrackDirty::Routing);
 }
 
 void TrackManager::setTrackAudioOutput(TrackId trackId, const juce::String& routing) {
@@ -494,7 +918,54 @@ void TrackManager::setTrackAudioOutput(TrackId trackId, const juce::String& rout
     }
 
     // Notify listeners
-    notifyTrackPropertyChanged(trackId);
+    notifyTrackPropertyChanged(trackId, TrackDirty::Routing);
+}
+
+int TrackManager::addSend(TrackId trackId, TrackId auxTrackId) {
+    auto* track = getTrack(trackId);
+    const auto* aux = getTrack(auxTrackId);
+    if (!track || !aux || aux->type != TrackType::Aux || auxTrackId == trackId) {
+        return -1;
+    }
+    for (const auto& send : track->sends) {
+        if (send.destinationId == auxTrackId) {
+            return -1;
+        }
+    }
+
+    SendInfo send;
+    send.destinationId = auxTrackId;
+    track->sends.push_back(send);
+    notifyTrackPropertyChanged(trackId, TrackDirty::Routing);
+    return static_cast<int>(track->sends.size()) - 1;
+}
+
+void TrackManager::removeSend(TrackId trackId, int sendIndex) {
+    auto* track = getTrack(trackId);
+    if (!track || sendIndex < 0 || sendIndex >= static_cast<int>(track->sends.size())) {
+        return;
+    }
+    track->sends.erase(track->sends.begin() + sendIndex);
+    notifyTrackPropertyChanged(trackId, TrackDirty::Routing);
+}
+
+void TrackManager::setSendLevel(TrackId trackId, int sendIndex, float level) {
+    auto* track = getTrack(trackId);
+    if (!track || sendIndex < 0 || sendIndex >= static_cast<int>(track->sends.size())) {
+        return;
+    }
+    // Same range as the fader
+    track->sends[static_cast<size_t>(sendIndex)].level = juce::jlimit(0.0f, 2.0f, level);
+    notifyTrackPropertyChanged(trackId, TrackDirty::Routing);
+}
+
+void TrackManager::setSendPreFader(TrackId trackId, int sendIndex, bool preFader) {
+    auto* track = getTrack(trackId);
+    if (!track || sendIndex < 0 || sendIndex >= static_cast<int>(track->sends.size())) {
+        return;
+    }
+    track->sends[static_cast<size_t>(sendIndex)].preFader = preFader;
+    notifyTrackPropertyChanged(trackId, TrackDirty::Routing);
 }
 
 // ============================================================================
@@ -571,7 +1042,7 @@ void TrackManager::removeDeviceFromTrack(TrackId trackId, DeviceId deviceId) {
     if (auto* track = getTrack(trackId)) {
         auto& elements = track->chainElements;
         auto it = std::find_if(elements.begin(), elements.end(), [deviceId](const ChainElement& e) {
-            return magda::isDevice(e) && magda::getDevice(e).id == deviceId;
+            return magda::isDeviceWithId(e, deviceId);
         });
         if (it != elements.end()) {
             DBG("Removed device: " << magda::getDevice(*it).name << " (id=" << deviceId
@@ -591,8 +1062,15 @@ void TrackManager::setDeviceBypassed(TrackId trackId, DeviceId deviceId, bool by
 
 DeviceInfo* TrackManager::getDevice(TrackId trackId, DeviceId deviceId) {
     if (auto* track = getTrack(trackId)) {
+        // Older duplicates share ids with their original, so an index hit on another
+        // track falls back to scanning this one
+        const auto* location = locateDevice(deviceId);
+        if (location && location->trackId == trackId && location->indices.size() == 1) {
+            auto& element = track->chainElements[static_cast<size_t>(location->indices[0])];
+            return &magda::getDevice(element);
+        }
         for (auto& element : track->chainElements) {
-            if (magda::isDevice(element) && magda::getDevice(element).id == deviceId) {
+            if (magda::isDeviceWithId(element, deviceId)) {
                 return &magda::getDevice(element);
             }
         }
@@ -629,7 +1107,7 @@ void TrackManager::removeRackFromTrack(TrackId trackId, RackId rackId) {
     if (auto* track = getTrack(trackId)) {
         auto& elements = track->chainElements;
         auto it = std::find_if(elements.begin(), elements.end(), [rackId](const ChainElement& e) {
-            return magda::isRack(e) && magda::getRack(e).id == rackId;
+            return magda::isRackWithId(e, rackId);
         });
         if (it != elements.end()) {
             DBG("Removed rack: " << magda::getRack(*it).name << " (id=" << rackId << ") from track "
@@ -642,8 +1120,13 @@ void TrackManager::removeRackFromTrack(TrackId trackId, RackId rackId) {
 
 RackInfo* TrackManager::getRack(TrackId trackId, RackId rackId) {
     if (auto* track = getTrack(trackId)) {
+        const auto* location = locateRack(rackId);
+        if (location && location->trackId == trackId && location->indices.size() == 1) {
+            auto& element = track->chainElements[static_cast<size_t>(location->indices[0])];
+            return &magda::getRack(element);
+        }
         for (auto& element : track->chainElements) {
-            if (magda::isRack(element) && magda::getRack(element).id == rackId) {
+            if (magda::isRackWithId(element, rackId)) {
                 return &magda::getRack(element);
             }
         }
@@ -653,8 +1136,14 @@ RackInfo* TrackManager::getRack(TrackId trackId, RackId rackId) {
 
 const RackInfo* TrackManager::getRack(TrackId trackId, RackId rackId) const {
     if (const auto* track = getTrack(trackId)) {
+        const auto* location = locateRack(rackId);
+        if (location && location->trackId == trackId && location->indices.size() == 1) {
+            const auto& element =
+                track->chainElements[static_cast<size_t>(location->indices[0])];
+            return &magda::getRack(element);
+        }
         for (const auto& element : track->chainElements) {
-            if (magda::isRack(element) && magda::getRack(element).id == rackId) {
+            if (magda::isRackWithId(element, rackId)) {
                 return &magda::getRack(element);
             }
         }
@@ -695,22 +1184,18 @@ RackInfo* TrackManager::getRackByPath(const ChainNodePath& rackPath) {
                 if (currentChain == nullptr) {
                     // Top-level rack in track's chainElements
                     for (auto& element : track->chainElements) {
-                        if (magda::isRack(element)) {
-                            if (magda::getRack(element).id == step.id) {
-                                currentRack = &magda::getRack(element);
-                                break;
-                            }
+                        if (magda::isRackWithId(element, step.id)) {
+                            currentRack = &magda::getRack(element);
+                            break;
                         }
                     }
                 } else {
                     // Nested rack within a chain
                     for (auto& element : currentChain->elements) {
-                        if (magda::isRack(element)) {
-                            if (magda::getRack(element).id == step.id) {
-                                currentRack = &magda::getRack(element);
-                                currentChain = nullptr;  // Reset chain context
-                                break;
-                            }
+                        if (magda::isRackWithId(element, step.id)) {
+                            currentRack = &magda::getRack(element);
+                            currentChain = nullptr;  // Reset chain context
+                            break;
                         }
                     }
                 }
@@ -807,6 +1292,16 @@ void TrackManager::removeChainByPath(const ChainNodePath& chainPath) {
 }
 
 ChainInfo* TrackManager::getChain(TrackId trackId, RackId rackId, ChainId chainId) {
+    const auto* location = locateChain(chainId);
+    if (location && location->trackId == trackId && location->indices.size() == 2) {
+        if (auto* rack = getRack(trackId, rackId)) {
+            const auto chainIndex = static_cast<size_t>(location->indices[1]);
+            if (chainIndex < rack->chains.size() && rack->chains[chainIndex].id == chainId) {
+                return &rack->chains[chainIndex];
+            }
+        }
+    }
+
     if (auto* rack = getRack(trackId, rackId)) {
         auto& chains = rack->chains;
         auto it = std::find_if(chains.begin(), chains.end(),
@@ -819,6 +1314,16 @@ ChainInfo* TrackManager::getChain(TrackId trackId, RackId rackId, ChainId chainI
 }
 
 const ChainInfo* TrackManager::getChain(TrackId trackId, RackId rackId, ChainId chainId) const {
+    const auto* location = locateChain(chainId);
+    if (location && location->trackId == trackId && location->indices.size() == 2) {
+        if (const auto* rack = getRack(trackId, rackId)) {
+            const auto chainIndex = static_cast<size_t>(location->indices[1]);
+            if (chainIndex < rack->chains.size() && rack->chains[chainIndex].id == chainId) {
+                return &rack->chains[chainIndex];
+            }
+        }
+    }
+
     if (const auto* rack = getRack(trackId, rackId)) {
         const auto& chains = rack->chains;
         auto it = std::find_if(chains.begin(), chains.end(),
@@ -1012,7 +1517,7 @@ void TrackManager::removeDeviceFromChain(TrackId trackId, RackId rackId, ChainId
     if (auto* chain = getChain(trackId, rackId, chainId)) {
         auto& elements = chain->elements;
         auto it = std::find_if(elements.begin(), elements.end(), [deviceId](const ChainElement& e) {
-            return magda::isDevice(e) && magda::getDevice(e).id == deviceId;
+            return magda::isDeviceWithId(e, deviceId);
         });
         if (it != elements.end()) {
             DBG("Removed device: " << magda::getDevice(*it).name << " (id=" << deviceId
@@ -1028,7 +1533,7 @@ void TrackManager::moveDeviceInChain(TrackId trackId, RackId rackId, ChainId cha
     if (auto* chain = getChain(trackId, rackId, chainId)) {
         auto& elements = chain->elements;
         auto it = std::find_if(elements.begin(), elements.end(), [deviceId](const ChainElement& e) {
-            return magda::isDevice(e) && magda::getDevice(e).id == deviceId;
+            return magda::isDeviceWithId(e, deviceId);
         });
         if (it != elements.end()) {
             int currentIndex = static_cast<int>(std::distance(elements.begin(), it));
@@ -1104,7 +1609,7 @@ DeviceInfo* TrackManager::getDeviceInChain(TrackId trackId, RackId rackId, Chain
                                            DeviceId deviceId) {
     if (auto* chain = getChain(trackId, rackId, chainId)) {
         for (auto& element : chain->elements) {
-            if (magda::isDevice(element) && magda::getDevice(element).id == deviceId) {
+            if (magda::isDeviceWithId(element, deviceId)) {
                 return &magda::getDevice(element);
             }
         }
@@ -1160,7 +1665,7 @@ void TrackManager::removeDeviceFromChainByPath(const ChainNodePath& devicePath)
         auto& elements = track->chainElements;
         auto it =
             std::find_if(elements.begin(), elements.end(), [&devicePath](const ChainElement& e) {
-                return magda::isDevice(e) && magda::getDevice(e).id == devicePath.topLevelDeviceId;
+                return magda::isDeviceWithId(e, devicePath.topLevelDeviceId);
             });
         if (it != elements.end()) {
             DBG("Removed top-level device: " << magda::getDevice(*it).name
@@ -1193,7 +1698,7 @@ void TrackManager::removeDeviceFromChainByPath(const ChainNodePath& devicePath)
     if (auto* chain = getChainFromPath(*this, chainPath)) {
         auto& elements = chain->elements;
         auto it = std::find_if(elements.begin(), elements.end(), [deviceId](const ChainElement& e) {
-            return magda::isDevice(e) && magda::getDevice(e).id == deviceId;
+            return magda::isDeviceWithId(e, deviceId);
         });
         if (it != elements.end()) {
             DBG("Removed nested device via path: " << magda::getDevice(*it).name
@@ -1211,8 +1716,7 @@ DeviceInfo* TrackManager::getDeviceInChainByPath(const ChainNodePath& devicePath
         if (!track)
             return nullptr;
         for (auto& element : track->chainElements) {
-            if (magda::isDevice(element) &&
-                magda::getDevice(element).id == devicePath.topLevelDeviceId) {
+            if (magda::isDeviceWithId(element, devicePath.topLevelDeviceId)) {
                 return &magda::getDevice(element);
             }
         }
@@ -1244,7 +1748,7 @@ DeviceInfo* TrackManager::getDeviceInChainByPath(const ChainNodePath& devicePath
         if (!track)
             return nullptr;
         for (auto& element : track->chainElements) {
-            if (magda::isDevice(element) && magda::getDevice(element).id == deviceId) {
+            if (magda::isDeviceWithId(element, deviceId)) {
                 return &magda::getDevice(element);
             }
         }
@@ -1254,7 +1758,7 @@ DeviceInfo* TrackManager::getDeviceInChainByPath(const ChainNodePath& devicePath
     // Otherwise, device is inside a chain
     if (auto* chain = getChainFromPath(*this, chainPath)) {
         for (auto& element : chain->elements) {
-            if (magda::isDevice(element) && magda::getDevice(element).id == deviceId) {
+            if (magda::isDeviceWithId(element, deviceId)) {
                 return &magda::getDevice(element);
             }
         }
@@ -1287,37 +1791,75 @@ void TrackManager::setDeviceLevel(const ChainNodePath& devicePath, float level)
     }
 }
 
-void TrackManager::updateDeviceParameters(DeviceId deviceId,
-                                          const std::vector<ParameterInfo>& params) {
-    // Search all tracks for the device and update its parameters
-    for (auto& track : tracks_) {
-        for (auto& element : track.chainElements) {
-            if (std::holds_alternative<DeviceInfo>(element)) {
-                auto& device = std::get<DeviceInfo>(element);
-                if (device.id == deviceId) {
-                    device.parameters = params;
-                    // Don't notify - this is called during device loading, not user interaction
-                    return;
-                }
-            }
-        }
+void TrackManager::setDeviceOversampling(DeviceId deviceId, int factor) {
+    if (auto* device = findDevice(deviceId)) {
+        device->oversampling = factor >= 4 ? 4 : (factor >= 2 ? 2 : 1);
+        notifyDevicePropertyChanged(device->id);
+    }
+}
+
+void TrackManager::setDeviceSandboxed(DeviceId deviceId, bool sandboxed) {
+    auto* device = findDevice(deviceId);
+    if (device != nullptr && device->format != PluginFormat::Internal &&
+        device->sandboxed != sandboxed) {
+        device->sandboxed = sandboxed;
+        notifyDevicePropertyChanged(device->id);
+    }
+}
+
+void TrackManager::updateDeviceParameters(DeviceId deviceId, const ParameterList& params) {
+    if (auto* device = findDevice(deviceId)) {
+        device->parameters = params;
+        // Don't notify - this is called during device loading, not user interaction
     }
 }
 
 void TrackManager::setDeviceVisibleParameters(DeviceId deviceId,
                                               const std::vector<int>& visibleParams) {
-    // Search all tracks for the device and update visible parameters
-    for (auto& track : tracks_) {
-        for (auto& element : track.chainElements) {
-            if (std::holds_alternative<DeviceInfo>(element)) {
-                auto& device = std::get<DeviceInfo>(element);
-                if (device.id == deviceId) {
-                    device.visibleParameters = visibleParams;
-                    // Don't notify - this is called during device loading, not user interaction
-                    return;
-                }
-            }
-        }
+    if (auto* device = findDevice(deviceId)) {
+        device->visibleParameters = visibleParams;
+        // Don't notify - this is called during device loading, not user interaction
+    }
+}
+
+bool TrackManager::switchDeviceStateSlot(DeviceId deviceId, int slot) {
+    auto* device = findDevice(deviceId);
+    auto* audioBridge = audioEngine_ ? audioEngine_->getAudioBridge() : nullptr;
+    if (!device || !audioBridge || slot < 0 || slot >= DeviceInfo::kNumStateSlots) {
+        return false;
+    }
+    if (slot == device->activeStateSlot) {
+        return true;
+    }
+
+    auto current = audioBridge->captureDeviceState(deviceId);
+    if (!current) {
+        return false;
+    }
+    const auto leaving = static_cast<size_t>(device->activeStateSlot);
+    device->stateSlots[leaving] = current;
+
+    auto& target = device->stateSlots[static_cast<size_t>(slot)];
+    if (!target) {
+        target = current;
+    } else if (audioBridge->restoreDeviceState(deviceId, *target) ==
+               AudioBridge::StateRestore::Failed) {
+        return false;
+    }
+
+    device->activeStateSlot = slot;
+    notifyDevicePropertyChanged(deviceId);
+    return true;
+}
+
+void TrackManager::copyDeviceStateToSlot(DeviceId deviceId, int slot) {
+    auto* device = findDevice(deviceId);
+    auto* audioBridge = audioEngine_ ? audioEngine_->getAudioBridge() : nullptr;
+    if (!device || !audioBridge || slot < 0 || slot >= DeviceInfo::kNumStateSlots) {
+        return;
+    }
+    if (auto current = audioBridge->captureDeviceState(deviceId)) {
+        device->stateSlots[static_cast<size_t>(slot)] = std::move(current);
     }
 }
 
@@ -1325,7 +1867,7 @@ void TrackManager::setDeviceParameterValue(const ChainNodePath& devicePath, int
                                            float value) {
     if (auto* device = getDeviceInChainByPath(devicePath)) {
         if (paramIndex >= 0 && paramIndex < static_cast<int>(device->parameters.size())) {
-            device->parameters[static_cast<size_t>(paramIndex)].currentValue = value;
+            device->parameters.setValue(static_cast<size_t>(paramIndex), value);
             // Use granular notification - only sync this one parameter, not all 543
             notifyDeviceParameterChanged(device->id, paramIndex, value);
         }
@@ -1339,18 +1881,31 @@ void TrackManager::setDeviceParameterValueFromPlugin(const ChainNodePath& device
     // to avoid triggering AudioBridge sync (which would cause a feedback loop).
     //
     // Instead, we notify UI listeners directly about the parameter change.
+    setDeviceParameterValuesFromPlugin(devicePath, {{paramIndex, value}});
+}
 
-    if (auto* device = getDeviceInChainByPath(devicePath)) {
+void TrackManager::setDeviceParameterValuesFromPlugin(
+    const ChainNodePath& devicePath, const std::vector<std::pair<int, float>>& values) {
+    auto* device = getDeviceInChainByPath(devicePath);
+    if (!device) {
+        return;
+    }
+
+    bool changed = false;
+    for (const auto& [paramIndex, value] : values) {
         if (paramIndex >= 0 && paramIndex < static_cast<int>(device->parameters.size())) {
-            device->parameters[static_cast<size_t>(paramIndex)].currentValue = value;
+            device->parameters.setValue(static_cast<size_t>(paramIndex), value);
 
             // Notify listeners about parameter change (for UI updates)
             notifyDeviceParameterChanged(device->id, paramIndex, value);
-
-            // Also notify modulation system for display updates
-            notifyModulationChanged();
+            changed = true;
         }
     }
+
+    // Also notify modulation system for display updates (once: it refreshes every track)
+    if (changed) {
+        notifyModulationChanged();
+    }
 }
 
 RackId TrackManager::addRackToChain(TrackId trackId, RackId parentRackId, ChainId chainId,
@@ -1456,8 +2011,8 @@ void TrackManager::removeRackFromChain(TrackId trackId, RackId parentRackId, Cha
         auto& elements = chain->elements;
         for (auto it = elements.begin(); it != elements.end(); ++it) {
             if (magda::isRack(*it)) {
-                DBG("    checking rack element id=" << magda::getRack(*it).id);
-                if (magda::getRack(*it).id == nestedRackId) {
+                DBG("    checking rack element id=" << magda::getRack(std::as_const(*it)).id);
+                if (magda::isRackWithId(*it, nestedRackId)) {
                     elements.erase(it);
                     notifyTrackDevicesChanged(trackId);
                     DBG("Removed nested rack: " << nestedRackId << " from chain " << chainId);
@@ -1506,8 +2061,8 @@ void TrackManager::removeRackFromChainByPath(const ChainNodePath& rackPath) {
         auto& elements = chain->elements;
         for (auto it = elements.begin(); it != elements.end(); ++it) {
             if (magda::isRack(*it)) {
-                DBG("    checking rack element id=" << magda::getRack(*it).id);
-                if (magda::getRack(*it).id == rackId) {
+                DBG("    checking rack element id=" << magda::getRack(std::as_const(*it)).id);
+                if (magda::isRackWithId(*it, rackId)) {
                     elements.erase(it);
                     notifyTrackDevicesChanged(rackPath.trackId);
                     DBG("Removed nested rack via path: " << rackId);
@@ -1532,6 +2087,7 @@ void TrackManager::setRackMacroValue(const ChainNodePath& rackPath, int macroInd
         }
         rack->macros[macroIndex].value = juce::jlimit(0.0f, 1.0f, value);
         // Don't notify - simple value change doesn't need UI rebuild
+        forwardMacroValue(ModOwner::Rack, rack->id, macroIndex, rack->macros[macroIndex].value);
     }
 }
 
@@ -1574,6 +2130,24 @@ void TrackManager::setRackMacroLinkAmount(const ChainNodePath& rackPath, int mac
             rack->macros[macroIndex].links.push_back(newLink);
         }
         // Don't notify - simple value change doesn't need UI rebuild
+        invalidateModulationIndex();
+    }
+}
+
+void TrackManager::setRackMacroLinkShape(const ChainNodePath& rackPath, int macroIndex,
+                                         MacroTarget target, float rangeStart, float rangeEnd,
+                                         MacroCurve curve) {
+    if (auto* rack = getRackByPath(rackPath)) {
+        if (macroIndex < 0 || macroIndex >= static_cast<int>(rack->macros.size())) {
+            return;
+        }
+        if (auto* link = rack->macros[macroIndex].getLink(target)) {
+            link->rangeStart = juce::jlimit(0.0f, 1.0f, rangeStart);
+            link->rangeEnd = juce::jlimit(0.0f, 1.0f, rangeEnd);
+            link->curve = curve;
+        }
+        // Don't notify - the modulator picks link edits up on its next read-back
+        invalidateModulationIndex();
     }
 }
 
@@ -1636,6 +2210,7 @@ void TrackManager::setRackModLinkAmount(const ChainNodePath& rackPath, int modIn
         if (rack->mods[modIndex].target == target) {
             rack->mods[modIndex].amount = amount;
         }
+        invalidateModulationIndex();
     }
 }
 
@@ -1830,6 +2405,7 @@ void TrackManager::setDeviceModTarget(const ChainNodePath& devicePath, int modIn
         // Also set legacy target for backward compatibility
         device->mods[modIndex].target = target;
         // Don't notify - simple value change doesn't need UI rebuild
+        invalidateModulationIndex();
     }
 }
 
@@ -1844,6 +2420,7 @@ void TrackManager::removeDeviceModLink(const ChainNodePath& devicePath, int modI
         if (device->mods[modIndex].target == target) {
             device->mods[modIndex].target = ModTarget{};
         }
+        invalidateModulationIndex();
     }
 }
 
@@ -1867,6 +2444,7 @@ void TrackManager::setDeviceModLinkAmount(const ChainNodePath& devicePath, int m
         if (device->mods[modIndex].target == target) {
             device->mods[modIndex].amount = amount;
         }
+        invalidateModulationIndex();
     }
 }
 
@@ -2038,8 +2616,7 @@ void TrackManager::removeDeviceModPage(const ChainNodePath& devicePath) {
 
 void TrackManager::updateAllMods(double deltaTime, double bpm, bool transportJustStarted,
                                  bool transportJustLooped) {
-    // Lambda to update a single mod's phase and value
-    auto updateMod = [deltaTime, bpm, transportJustStarted, transportJustLooped](ModInfo& mod) {
+    forEachMod([=](ModOwner, int, int, ModInfo& mod) {
         // Skip disabled mods - set value to 0 so they don't affect modulation
         if (!mod.enabled) {
             mod.value = 0.0f;
@@ -2048,81 +2625,10 @@ void TrackManager::updateAllMods(double deltaTime, double bpm, bool transportJus
         }
 
         if (mod.type == ModType::LFO) {
-            // Check for trigger (phase reset)
-            bool shouldTrigger = false;
-            switch (mod.triggerMode) {
-                case LFOTriggerMode::Free:
-                    // Never reset
-                    break;
-                case LFOTriggerMode::Transport:
-                    // Reset on transport start or loop
-                    if (transportJustStarted || transportJustLooped) {
-                        shouldTrigger = true;
-                    }
-                    break;
-                case LFOTriggerMode::MIDI:
-                    // STUB: Will trigger on MIDI note-on when infrastructure ready
-                    break;
-                case LFOTriggerMode::Audio:
-                    // STUB: Will trigger on audio transient when infrastructure ready
-                    break;
-            }
-
-            if (shouldTrigger) {
-                mod.phase = 0.0f;  // Reset to start
-                mod.triggered = true;
-            } else {
-                mod.triggered = false;
-            }
-
-            // Calculate effective rate (Hz or tempo-synced)
-            float effectiveRate = mod.rate;
-            if (mod.tempoSync) {
-                effectiveRate = ModulatorEngine::calculateSyncRateHz(mod.syncDivision, bpm);
-            }
-
-            // Update phase (wraps at 1.0)
-            mod.phase += static_cast<float>(effectiveRate * deltaTime);
-            while (mod.phase >= 1.0f) {
-                mod.phase -= 1.0f;
-            }
-            // Apply phase offset when generating waveform
-            float effectivePhase = std::fmod(mod.phase + mod.phaseOffset, 1.0f);
-            // Generate waveform output using ModulatorEngine (handles Custom curves too)
-            mod.value = ModulatorEngine::generateWaveformForMod(mod, effectivePhase);
+            mod.value = ModulatorEngine::advanceLFO(mod, mod.phase, mod.triggered, deltaTime, bpm,
+                                                    transportJustStarted, transportJustLooped);
         }
-    };
-
-    // Recursive lambda to update mods in chain elements
-    std::function<void(ChainElement&)> updateElementMods = [&](ChainElement& element) {
-        if (isDevice(element)) {
-            // Update device mods
-            DeviceInfo& device = magda::getDevice(element);
-            for (auto& mod : device.mods) {
-                updateMod(mod);
-            }
-        } else if (isRack(element)) {
-            // Update rack mods
-            RackInfo& rack = magda::getRack(element);
-            for (auto& mod : rack.mods) {
-                updateMod(mod);
-            }
-            // Recursively update mods in nested chains
-            for (auto& chain : rack.chains) {
-                for (auto& chainElement : chain.elements) {
-                    updateElementMods(chainElement);
-                }
-            }
-        }
-    };
-
-    // Update mods in all tracks
-    for (auto& track : tracks_) {
-        // Update mods in all chain elements
-        for (auto& element : track.chainElements) {
-            updateElementMods(element);
-        }
-    }
+    });
 
     // DO NOT call notifyModulationChanged() here - that causes 60 FPS UI rebuilds
     // ParamSlotComponent will read mod.value directly during its paint cycle
@@ -2140,6 +2646,8 @@ void TrackManager::setDeviceMacroValue(const ChainNodePath& devicePath, int macr
         }
         device->macros[macroIndex].value = juce::jlimit(0.0f, 1.0f, value);
         // Don't notify - simple value change doesn't need UI rebuild
+        forwardMacroValue(ModOwner::Device, device->id, macroIndex,
+                          device->macros[macroIndex].value);
     }
 }
 
@@ -2158,6 +2666,7 @@ void TrackManager::setDeviceMacroTarget(const ChainNodePath& devicePath, int mac
             device->macros[macroIndex].links.push_back(newLink);
         }
         // Don't notify - simple value change doesn't need UI rebuild
+        invalidateModulationIndex();
     }
 }
 
@@ -2168,6 +2677,7 @@ void TrackManager::removeDeviceMacroLink(const ChainNodePath& devicePath, int ma
             return;
         }
         device->macros[macroIndex].removeLink(target);
+        invalidateModulationIndex();
     }
 }
 
@@ -2187,6 +2697,32 @@ void TrackManager::setDeviceMacroLinkAmount(const ChainNodePath& devicePath, int
             newLink.amount = amount;
             device->macros[macroIndex].links.push_back(newLink);
         }
+        invalidateModulationIndex();
+    }
+}
+
+void TrackManager::setDeviceMacroLinkShape(const ChainNodePath& devicePath, int macroIndex,
+                                           MacroTarget target, float rangeStart, float rangeEnd,
+                                           MacroCurve curve) {
+    if (auto* device = getDeviceInChainByPath(devicePath)) {
+        if (macroIndex < 0 || macroIndex >= static_cast<int>(device->macros.size())) {
+            return;
+        }
+        if (auto* link = device->macros[macroIndex].getLink(target)) {
+            link->rangeStart = juce::jlimit(0.0f, 1.0f, rangeStart);
+            link->rangeEnd = juce::jlimit(0.0f, 1.0f, rangeEnd);
+            link->curve = curve;
+        }
+        invalidateModulationIndex();
+    }
+}
+
+void TrackManager::forwardMacroValue(ModOwner owner, int ownerId, int macroIndex, float value) {
+    // One value for the audio thread, which fans it out to every linked parameter
+    if (audioEngine_) {
+        if (auto* audioBridge = audioEngine_->getAudioBridge()) {
+            audioBridge->setMacroValue(owner, ownerId, macroIndex, value);
+        }
     }
 }
 
@@ -2231,7 +2767,7 @@ TrackManager::ResolvedPath TrackManager::resolvePath(const ChainNodePath& path)
     // Handle top-level device (legacy)
     if (path.topLevelDeviceId != INVALID_DEVICE_ID) {
         for (const auto& element : track->chainElements) {
-            if (magda::isDevice(element) && magda::getDevice(element).id == path.topLevelDeviceId) {
+            if (magda::isDeviceWithId(element, path.topLevelDeviceId)) {
                 result.valid = true;
                 result.device = &magda::getDevice(element);
                 result.displayPath = result.device->name;
@@ -2254,7 +2790,7 @@ TrackManager::ResolvedPath TrackManager::resolvePath(const ChainNodePath& path)
                 if (currentChain == nullptr) {
                     // Top-level rack in track's chainElements
                     for (const auto& element : track->chainElements) {
-                        if (magda::isRack(element) && magda::getRack(element).id == step.id) {
+                        if (magda::isRackWithId(element, step.id)) {
                             currentRack = &magda::getRack(element);
                             pathNames.add(currentRack->name);
                             break;
@@ -2263,7 +2799,7 @@ TrackManager::ResolvedPath TrackManager::resolvePath(const ChainNodePath& path)
                 } else {
                     // Nested rack within a chain
                     for (const auto& element : currentChain->elements) {
-                        if (magda::isRack(element) && magda::getRack(element).id == step.id) {
+                        if (magda::isRackWithId(element, step.id)) {
                             currentRack = &magda::getRack(element);
                             currentChain = nullptr;  // Reset chain context
                             pathNames.add(currentRack->name);
@@ -2288,7 +2824,7 @@ TrackManager::ResolvedPath TrackManager::resolvePath(const ChainNodePath& path)
             case ChainStepType::Device: {
                 if (currentChain != nullptr) {
                     for (const auto& element : currentChain->elements) {
-                        if (magda::isDevice(element) && magda::getDevice(element).id == step.id) {
+                        if (magda::isDeviceWithId(element, step.id)) {
                             result.device = &magda::getDevice(element);
                             pathNames.add(result.device->name);
                             break;
@@ -2318,6 +2854,8 @@ TrackManager::ResolvedPath TrackManager::resolvePath(const ChainNodePath& path)
 void TrackManager::setTrackVisible(TrackId trackId, ViewMode mode, bool visible) {
     if (auto* track = getTrack(trackId)) {
         track->viewSettings.setVisible(mode, visible);
+        invalidateViewIndex();
+        markTrackModified(trackId, TrackDirty::Visibility);
         // Use tracksChanged since visibility affects which tracks are displayed
         notifyTracksChanged();
     }
@@ -2326,13 +2864,14 @@ void TrackManager::setTrackVisible(TrackId trackId, ViewMode mode, bool visible)
 void TrackManager::setTrackLocked(TrackId trackId, ViewMode mode, bool locked) {
     if (auto* track = getTrack(trackId)) {
         track->viewSettings.setLocked(mode, locked);
-        notifyTrackPropertyChanged(trackId);
+        notifyTrackPropertyChanged(trackId, TrackDirty::Layout);
     }
 }
 
 void TrackManager::setTrackCollapsed(TrackId trackId, ViewMode mode, bool collapsed) {
     if (auto* track = getTrack(trackId)) {
         track->viewSettings.setCollapsed(mode, collapsed);
+        markTrackModified(trackId, TrackDirty::Layout);
         // Use tracksChanged since collapsing affects which child tracks are displayed
         notifyTracksChanged();
     }
@@ -2341,7 +2880,7 @@ void TrackManager::setTrackCollapsed(TrackId trackId, ViewMode mode, bool collap
 void TrackManager::setTrackHeight(TrackId trackId, ViewMode mode, int height) {
     if (auto* track = getTrack(trackId)) {
         track->viewSettings.setHeight(mode, juce::jmax(20, height));
-        notifyTrackPropertyChanged(trackId);
+        notifyTrackPropertyChanged(trackId, TrackDirty::Layout);
     }
 }
 
@@ -2349,24 +2888,14 @@ void TrackManager::setTrackHeight(TrackId trackId, ViewMode mode, int height) {
 // Query Tracks by View
 // ============================================================================
 
-std::vector<TrackId> TrackManager::getVisibleTracks(ViewMode mode) const {
-    std::vector<TrackId> result;
-    for (const auto& track : tracks_) {
-        if (track.isVisibleIn(mode)) {
-            result.push_back(track.id);
-        }
-    }
-    return result;
+std::span<const TrackId> TrackManager::getVisibleTracks(ViewMode mode) const {
+    ensureViewIndex();
+    return viewIndex_.visible[static_cast<size_t>(mode)];
 }
 
-std::vector<TrackId> TrackManager::getVisibleTopLevelTracks(ViewMode mode) const {
-    std::vector<TrackId> result;
-    for (const auto& track : tracks_) {
-        if (track.isTopLevel() && track.isVisibleIn(mode)) {
-            result.push_back(track.id);
-        }
-    }
-    return result;
+std::span<const TrackId> TrackManager::getVisibleTopLevelTracks(ViewMode mode) const {
+    ensureViewIndex();
+    return viewIndex_.visibleTopLevel[static_cast<size_t>(mode)];
 }
 
 // ============================================================================
@@ -2435,6 +2964,55 @@ void TrackManager::removeListener(TrackManagerListener* listener) {
     listeners_.erase(std::remove(listeners_.begin(), listeners_.end(), listener), listeners_.end());
 }
 
+void TrackManager::flushPendingChanges() {
+    changeDeliveryPending_ = false;
+    if (pendingChanges_.empty()) {
+        return;
+    }
+
+    // Listeners may edit tracks in response; those land in the next set
+    const TrackChangeSet changes = std::move(pendingChanges_);
+    pendingChanges_.clear();
+
+    auto listenersCopy = listeners_;
+    for (auto* listener : listenersCopy) {
+        if (std::find(listeners_.begin(), listeners_.end(), listener) != listeners_.end()) {
+            listener->trackChangesCoalesced(changes);
+        }
+    }
+}
+
+void TrackManager::scheduleChangeDelivery() {
+    if (changeDeliveryPending_) {
+        return;
+    }
+
+    // Without a message loop (tests, shutdown) nothing is posted and flushPendingChanges()
+    // delivers instead
+    changeDeliveryPending_ =
+        juce::MessageManager::callAsync([] { getInstance().flushPendingChanges(); });
+}
+
+void TrackManager::markTrackAdded(TrackId trackId) {
+    pendingChanges_.markAdded(trackId);
+    scheduleChangeDelivery();
+}
+
+void TrackManager::markTrackRemoved(TrackId trackId) {
+    pendingChanges_.markRemoved(trackId);
+    scheduleChangeDelivery();
+}
+
+void TrackManager::markTrackModified(TrackId trackId, TrackDirty dirty) {
+    pendingChanges_.markModified(trackId, dirty);
+    scheduleChangeDelivery();
+}
+
+void TrackManager::markTracksReordered() {
+    pendingChanges_.reordered = true;
+    scheduleChangeDelivery();
+}
+
 // ============================================================================
 // Initialization
 // ============================================================================
@@ -2446,10 +3024,47 @@ void TrackManager::createDefaultTracks(int count) {
     }
 }
 
+size_t TrackManager::getSizeInBytes() const {
+    size_t bytes = memory::vectorBytes(tracks_) + memory::hashContainerBytes(trackPositions_);
+    for (const auto& track : tracks_) {
+        bytes += memory::vectorBytes(track.childIds) + estimateChainBytes(track.chainElements);
+    }
+    for (const auto* locations : {&deviceLocations_, &rackLocations_, &chainLocations_}) {
+        bytes += memory::hashContainerBytes(*locations);
+        for (const auto& [id, location] : *locations) {
+            bytes += memory::vectorBytes(location.indices);
+        }
+    }
+    return bytes;
+}
+
 void TrackManager::clearAllTracks() {
     tracks_.clear();
+    invalidateTrackIndex();
+    pendingChanges_.markReset();
+    scheduleChangeDelivery();
+    nextTrackId_ = 1;
+    notifyTracksChanged();
+}
+
+void TrackManager::loadTracks(std::vector<TrackInfo> tracks, const MasterChannelState& master) {
+    tracks_ = std::move(tracks);
+    masterChannel_ = master;
+    invalidateTrackIndex();
+
     nextTrackId_ = 1;
+    nextDeviceId_ = 1;
+    nextRackId_ = 1;
+    nextChainId_ = 1;
+    for (const auto& track : tracks_) {
+        nextTrackId_ = std::max(nextTrackId_, track.id + 1);
+        reserveNodeIds(track.chainElements, nextDeviceId_, nextRackId_, nextChainId_);
+    }
+
+    pendingChanges_.markReset();
+    scheduleChangeDelivery();
     notifyTracksChanged();
+    notifyMasterChannelChanged();
 }
 
 // ============================================================================
@@ -2457,12 +3072,15 @@ void TrackManager::clearAllTracks() {
 // ============================================================================
 
 void TrackManager::notifyTracksChanged() {
+    nodeIndexDirty_ = true;
+    modulationIndexDirty_ = true;
     for (auto* listener : listeners_) {
         listener->tracksChanged();
     }
 }
 
-void TrackManager::notifyTrackPropertyChanged(int trackId) {
+void TrackManager::notifyTrackPropertyChanged(int trackId, TrackDirty dirty) {
+    markTrackModified(trackId, dirty);
     for (auto* listener : listeners_) {
         listener->trackPropertyChanged(trackId);
     }
@@ -2481,6 +3099,9 @@ void TrackManager::notifyTrackSelectionChanged(TrackId trackId) {
 }
 
 void TrackManager::notifyTrackDevicesChanged(TrackId trackId) {
+    nodeIndexDirty_ = true;
+    modulationIndexDirty_ = true;
+    markTrackModified(trackId, TrackDirty::Devices);
     for (auto* listener : listeners_) {
         listener->trackDevicesChanged(trackId);
     }
@@ -1,8 +1,14 @@
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <memory>
+#include <span>
+#include <unordered_map>
 #include <vector>
 
+#include "ChangeSet.hpp"
+#include "ModulationIndex.hpp"
 #include "SelectionManager.hpp"
 #include "TrackInfo.hpp"
 #include "TrackTypes.hpp"
@@ -28,6 +34,34 @@ struct MasterChannelState {
     }
 };
 
+/**
+ * @brief What changed on a track, for TrackChangeSet
+ */
+enum class TrackDirty : uint32_t {
+    None = 0,
+    Name = 1 << 0,
+    Colour = 1 << 1,
+    Mixer = 1 << 2,       // Volume, pan, mute, solo, record arm
+    Routing = 1 << 3,     // MIDI and audio inputs/outputs
+    Type = 1 << 4,
+    Visibility = 1 << 5,  // Shown or hidden in a view mode
+    Layout = 1 << 6,      // Collapsed, locked, height
+    Hierarchy = 1 << 7,   // Group membership
+    Devices = 1 << 8,     // Signal chain contents
+    Freeze = 1 << 9,      // Freeze state
+    All = 0xFFFFFFFF
+};
+
+inline TrackDirty operator|(TrackDirty a, TrackDirty b) {
+    return static_cast<TrackDirty>(static_cast<uint32_t>(a) | static_cast<uint32_t>(b));
+}
+
+inline bool hasFlag(TrackDirty flags, TrackDirty flag) {
+    return (static_cast<uint32_t>(flags) & static_cast<uint32_t>(flag)) != 0;
+}
+
+using TrackChangeSet = ChangeSet<TrackId, TrackDirty>;
+
 /**
  * @brief Listener interface for track changes
  */
@@ -65,6 +99,13 @@ class TrackManagerListener {
     virtual void deviceParameterChanged(DeviceId deviceId, int paramIndex, float newValue) {
         juce::ignoreUnused(deviceId, paramIndex, newValue);
     }
+
+    // Called once per message-loop tick with every track change since the last call.
+    // The callbacks above fire synchronously per edit; this lets a listener update only
+    // the affected rows, and only once for a burst of edits.
+    virtual void trackChangesCoalesced(const TrackChangeSet& changes) {
+        juce::ignoreUnused(changes);
+    }
 };
 
 /**
@@ -92,6 +133,8 @@ class TrackManager {
      */
     void shutdown() {
         tracks_.clear();  // Clear JUCE::String objects before JUCE cleanup
+        invalidateTrackIndex();
+        pendingChanges_.clear();
         listeners_.clear();
         audioEngine_ = nullptr;
     }
@@ -108,7 +151,7 @@ class TrackManager {
     TrackId createTrack(const juce::String& name = "", TrackType type = TrackType::Audio);
     TrackId createGroupTrack(const juce::String& name = "");
     void deleteTrack(TrackId trackId);
-    void duplicateTrack(TrackId trackId);
+    TrackId duplicateTrack(TrackId trackId);  // Returns the copy, or INVALID_TRACK_ID
     void restoreTrack(const TrackInfo& trackInfo);  // Used by undo system
     void moveTrack(TrackId trackId, int newIndex);
 
@@ -117,9 +160,21 @@ class TrackManager {
     void removeTrackFromGroup(TrackId trackId);
     TrackId createTrackInGroup(TrackId groupId, const juce::String& name = "",
                                TrackType type = TrackType::Audio);
-    std::vector<TrackId> getChildTracks(TrackId groupId) const;
-    std::vector<TrackId> getTopLevelTracks() const;
-    std::vector<TrackId> getAllDescendants(TrackId trackId) const;
+
+    // Hierarchy and view queries are served from caches, so the spans they return stay
+    // valid only until the next change to the track list, the hierarchy or visibility
+    std::span<const TrackId> getChildTracks(TrackId groupId) const;
+    std::span<const TrackId> getTopLevelTracks() const;
+    std::span<const TrackId> getAllDescendants(TrackId trackId) const;
+
+    /**
+     * @brief Bumped by every change to the track list, the hierarchy or visibility
+     *
+     * Lets views skip rebuilding their track layout when nothing structural changed.
+     */
+    uint64_t getStructureVersion() const {
+        return structureVersion_;
+    }
 
     /**
      * @brief Preview a MIDI note on a track (for keyboard audition)
@@ -141,6 +196,26 @@ class TrackManager {
         return static_cast<int>(tracks_.size());
     }
 
+    /**
+     * @brief Approximate heap footprint of the track model
+     *
+     * Tracks with their device trees (devices, racks, mods, macros), plus the id lookups.
+     */
+    size_t getSizeInBytes() const;
+
+    /**
+     * @brief Look up a device at any depth on any track (first match in track order)
+     */
+    DeviceInfo* findDevice(DeviceId deviceId);
+    const DeviceInfo* findDevice(DeviceId deviceId) const;
+
+    /**
+     * @brief Path to a device found as in findDevice(), or an invalid path if there is none
+     *
+     * Top-level devices use the legacy topLevelDeviceId form.
+     */
+    ChainNodePath findDevicePath(DeviceId deviceId) const;
+
     // Track property setters (notify listeners)
     void setTrackName(TrackId trackId, const juce::String& name);
     void setTrackColour(TrackId trackId, juce::Colour colour);
@@ -149,14 +224,51 @@ class TrackManager {
     void setTrackMuted(TrackId trackId, bool muted);
     void setTrackSoloed(TrackId trackId, bool soloed);
     void setTrackRecordArmed(TrackId trackId, bool armed);
+
+    /**
+     * @brief Hear an armed audio track's input straight from the device, bypassing its chain
+     *
+     * The input goes to the output in the device callback with only the track's fader,
+     * pan and mute, so it isn't delayed by plugin latency compensation.
+     */
+    void setTrackDirectMonitor(TrackId trackId, bool direct);
     void setTrackType(TrackId trackId, TrackType type);
 
+    /**
+     * @brief Render the track's chain to audio in the background, then play that instead
+     *
+     * The track is Freezing until the render finishes, then Frozen: its clips and plugins
+     * are suspended (plugin state is kept) and the render plays through the fader. Needs
+     * an audio engine; does nothing for groups or tracks that aren't Unfrozen.
+     */
+    void freezeTrack(TrackId trackId);
+
+    /**
+     * @brief Back to live playback (also cancels a freeze in progress)
+     */
+    void unfreezeTrack(TrackId trackId);
+
+    /**
+     * @brief Record the engine's freeze state (called by the engine when a render ends)
+     */
+    void setTrackFreezeState(TrackId trackId, FreezeState state);
+
     // Track routing setters (notify listeners and forward to bridges)
     void setTrackMidiInput(TrackId trackId, const juce::String& deviceId);
     void setTrackMidiOutput(TrackId trackId, const juce::String& deviceId);
     void setTrackAudioInput(TrackId trackId, const juce::String& deviceId);
     void setTrackAudioOutput(TrackId trackId, const juce::String& routing);
 
+    /**
+     * @brief Send a track into an aux track (at unity, post-fader)
+     * @return The new send's index, or -1 if auxTrackId isn't another track's Aux or the
+     *         track already sends to it
+     */
+    int addSend(TrackId trackId, TrackId auxTrackId);
+    void removeSend(TrackId trackId, int sendIndex);
+    void setSendLevel(TrackId trackId, int sendIndex, float level);
+    void setSendPreFader(TrackId trackId, int sendIndex, bool preFader);
+
     // View settings
     void setTrackVisible(TrackId trackId, ViewMode mode, bool visible);
     void setTrackLocked(TrackId trackId, ViewMode mode, bool locked);
@@ -220,11 +332,30 @@ class TrackManager {
     // Device parameter setters (notify listeners for audio sync)
     void setDeviceGainDb(const ChainNodePath& devicePath, float gainDb);
     void setDeviceLevel(const ChainNodePath& devicePath, float level);  // 0-1 linear
+    // Offline renders of the device's track run at this multiple of the rate (1, 2 or 4)
+    void setDeviceOversampling(DeviceId deviceId, int factor);
+    // Run an external plugin device in a separate host process, or back in the DAW's
+    void setDeviceSandboxed(DeviceId deviceId, bool sandboxed);
 
     // Update device parameters (called by AudioBridge when processor is created)
-    void updateDeviceParameters(DeviceId deviceId, const std::vector<ParameterInfo>& params);
+    void updateDeviceParameters(DeviceId deviceId, const ParameterList& params);
     void setDeviceVisibleParameters(DeviceId deviceId, const std::vector<int>& visibleParams);
 
+    /**
+     * @brief Switch a device to another A/B state slot
+     *
+     * The device's current state is kept in the slot it leaves. Switching to an empty slot
+     * starts it as a copy of the current state; otherwise the slot's state is recalled,
+     * which only sets the parameters that differ when nothing else in it changed.
+     * @return False if there is no engine, or the device has no plugin (yet)
+     */
+    bool switchDeviceStateSlot(DeviceId deviceId, int slot);
+
+    /**
+     * @brief Store the device's current state in a slot (e.g. copy A to B)
+     */
+    void copyDeviceStateToSlot(DeviceId deviceId, int slot);
+
     // Set a specific device parameter value
     void setDeviceParameterValue(const ChainNodePath& devicePath, int paramIndex, float value);
 
@@ -239,6 +370,13 @@ class TrackManager {
     void setDeviceParameterValueFromPlugin(const ChainNodePath& devicePath, int paramIndex,
                                            float value);
 
+    /**
+     * @brief Several values from the plugin at once: listeners hear each parameter, but the
+     *        modulation display refresh happens once for the whole batch
+     */
+    void setDeviceParameterValuesFromPlugin(const ChainNodePath& devicePath,
+                                            const std::vector<std::pair<int, float>>& values);
+
     // Nested rack management within chains
     RackId addRackToChain(TrackId trackId, RackId parentRackId, ChainId chainId,
                           const juce::String& name = "Rack");
@@ -252,6 +390,8 @@ class TrackManager {
     void setRackMacroTarget(const ChainNodePath& rackPath, int macroIndex, MacroTarget target);
     void setRackMacroLinkAmount(const ChainNodePath& rackPath, int macroIndex, MacroTarget target,
                                 float amount);
+    void setRackMacroLinkShape(const ChainNodePath& rackPath, int macroIndex, MacroTarget target,
+                               float rangeStart, float rangeEnd, MacroCurve curve);
     void setRackMacroName(const ChainNodePath& rackPath, int macroIndex, const juce::String& name);
     void addRackMacroPage(const ChainNodePath& rackPath);
     void removeRackMacroPage(const ChainNodePath& rackPath);
@@ -307,12 +447,79 @@ class TrackManager {
     void updateAllMods(double deltaTime, double bpm = 120.0, bool transportJustStarted = false,
                        bool transportJustLooped = false);
 
+    /**
+     * @brief Visit every device and rack mod on every track
+     *
+     * Order is depth-first through each track's chain: a device's mods, or a rack's mods
+     * followed by everything in its chains. The order is stable while the chain layout is.
+     * fn is called as fn(ModOwner owner, int ownerId, int modIndex, ModInfo& mod).
+     */
+    template <typename Fn> void forEachMod(Fn&& fn) {
+        for (auto& track : tracks_) {
+            for (auto& element : track.chainElements) {
+                visitElementMods(element, fn);
+            }
+        }
+    }
+
+    template <typename Fn> void forEachMod(Fn&& fn) const {
+        for (const auto& track : tracks_) {
+            for (const auto& element : track.chainElements) {
+                visitElementMods(element, fn);
+            }
+        }
+    }
+
+    /**
+     * @brief forEachMod, in the same order, also passing the track each mod is on
+     */
+    template <typename Fn> void forEachTrackMod(Fn&& fn) const {
+        for (const auto& track : tracks_) {
+            auto visit = [&fn, &track](ModOwner owner, int ownerId, int modIndex,
+                                       const ModInfo& info) {
+                fn(track.id, owner, ownerId, modIndex, info);
+            };
+            for (const auto& element : track.chainElements) {
+                visitElementMods(element, visit);
+            }
+        }
+    }
+
+    /**
+     * @brief Visit every macro on every track, racks before their chains, as forEachTrackMod
+     *
+     * fn is called as fn(TrackId trackId, ModOwner owner, int ownerId, int macroIndex,
+     * const MacroInfo& macro).
+     */
+    template <typename Fn> void forEachTrackMacro(Fn&& fn) const {
+        for (const auto& track : tracks_) {
+            auto visit = [&fn, &track](ModOwner owner, int ownerId, int macroIndex,
+                                       const MacroInfo& macro) {
+                fn(track.id, owner, ownerId, macroIndex, macro);
+            };
+            for (const auto& element : track.chainElements) {
+                visitElementMacros(element, visit);
+            }
+        }
+    }
+
+    /**
+     * @brief Every mod and macro link that targets a device parameter
+     *
+     * Answered from a reverse index, rebuilt on the first call after links or the device
+     * layout change through TrackManager. The reference is valid until the next edit.
+     */
+    const ModulationSources& getModulationSources(DeviceId deviceId, int paramIndex) const;
+
     // Macro management for devices (path-based for nested device support)
     void setDeviceMacroValue(const ChainNodePath& devicePath, int macroIndex, float value);
     void setDeviceMacroTarget(const ChainNodePath& devicePath, int macroIndex, MacroTarget target);
     void removeDeviceMacroLink(const ChainNodePath& devicePath, int macroIndex, MacroTarget target);
     void setDeviceMacroLinkAmount(const ChainNodePath& devicePath, int macroIndex,
                                   MacroTarget target, float amount);
+    void setDeviceMacroLinkShape(const ChainNodePath& devicePath, int macroIndex,
+                                 MacroTarget target, float rangeStart, float rangeEnd,
+                                 MacroCurve curve);
     void setDeviceMacroName(const ChainNodePath& devicePath, int macroIndex,
                             const juce::String& name);
     void addDeviceMacroPage(const ChainNodePath& devicePath);
@@ -349,9 +556,9 @@ class TrackManager {
      */
     ResolvedPath resolvePath(const ChainNodePath& path) const;
 
-    // Query tracks by view
-    std::vector<TrackId> getVisibleTracks(ViewMode mode) const;
-    std::vector<TrackId> getVisibleTopLevelTracks(ViewMode mode) const;
+    // Query tracks by view, in track order (cached, see getChildTracks)
+    std::span<const TrackId> getVisibleTracks(ViewMode mode) const;
+    std::span<const TrackId> getVisibleTopLevelTracks(ViewMode mode) const;
 
     // Track selection
     void setSelectedTrack(TrackId trackId);
@@ -390,6 +597,11 @@ class TrackManager {
     void addListener(TrackManagerListener* listener);
     void removeListener(TrackManagerListener* listener);
 
+    /**
+     * @brief Deliver recorded changes to trackChangesCoalesced() now rather than next tick
+     */
+    void flushPendingChanges();
+
     // Modulation management
     void notifyModulationChanged();  // Called when mod values change (for UI refresh)
 
@@ -397,6 +609,14 @@ class TrackManager {
     void createDefaultTracks(int count = 8);
     void clearAllTracks();
 
+    /**
+     * @brief Replace every track and the master channel (opening a project)
+     *
+     * Listeners get one reset rather than a change per track, and new ids start beyond
+     * the loaded ones.
+     */
+    void loadTracks(std::vector<TrackInfo> tracks, const MasterChannelState& master);
+
   private:
     TrackManager();
     ~TrackManager() = default;
@@ -414,8 +634,129 @@ class TrackManager {
     RackId selectedChainRackId_ = INVALID_RACK_ID;
     ChainId selectedChainId_ = INVALID_CHAIN_ID;
 
+    /**
+     * @brief Where a device, rack or chain sits in its track's chain
+     *
+     * indices starts with an index into chainElements, followed by (chain index, element
+     * index) pairs for each rack on the way down. A chain's location ends with its chain index.
+     */
+    struct NodeLocation {
+        TrackId trackId = INVALID_TRACK_ID;
+        std::vector<int> indices;
+    };
+    using NodeLocations = std::unordered_map<int, NodeLocation>;
+
+    // Id lookups derived from tracks_, rebuilt lazily after edits. Every hit is checked
+    // against the data it points at, so an entry left stale by an edit is never returned.
+    mutable std::unordered_map<TrackId, size_t> trackPositions_;
+    mutable NodeLocations deviceLocations_;
+    mutable NodeLocations rackLocations_;
+    mutable NodeLocations chainLocations_;
+    mutable bool trackIndexDirty_ = true;
+    mutable bool nodeIndexDirty_ = true;
+
+    void invalidateTrackIndex() {
+        trackIndexDirty_ = true;
+        nodeIndexDirty_ = true;
+        modulationIndexDirty_ = true;
+        invalidateViewIndex();
+    }
+
+    // Parameter -> linked sources, from forEachTrackMod/forEachTrackMacro. Link setters
+    // don't notify, so each one marks it dirty itself.
+    mutable ModulationIndex modulationIndex_;
+    mutable bool modulationIndexDirty_ = true;
+
+    void invalidateModulationIndex() {
+        modulationIndexDirty_ = true;
+    }
+
+    // Track orderings per view and descendant lists, derived from tracks_ and rebuilt
+    // lazily after structural edits
+    static constexpr size_t kNumViewModes = static_cast<size_t>(ViewMode::Master) + 1;
+    struct ViewIndex {
+        std::array<std::vector<TrackId>, kNumViewModes> visible;
+        std::array<std::vector<TrackId>, kNumViewModes> visibleTopLevel;
+        std::vector<TrackId> topLevel;
+        std::unordered_map<TrackId, std::vector<TrackId>> descendants;  // Filled on demand
+    };
+    mutable ViewIndex viewIndex_;
+    mutable bool viewIndexDirty_ = true;
+    uint64_t structureVersion_ = 0;
+
+    void invalidateViewIndex() {
+        viewIndexDirty_ = true;
+        ++structureVersion_;
+    }
+    void ensureViewIndex() const;
+    void ensureTrackIndex() const;
+    bool ensureNodeIndex() const;
+    void indexElements(const std::vector<ChainElement>& elements, NodeLocation& location) const;
+
+    // Verified location of a node, rescanning once if the index missed since the last rebuild.
+    // matches(track, location, id) checks that the node at location still has that id.
+    using NodeMatcher = bool (*)(const TrackInfo&, const NodeLocation&, int);
+    const NodeLocation* locateNode(const NodeLocations& locations, int id,
+                                   NodeMatcher matches) const;
+    const NodeLocation* locateDevice(DeviceId deviceId) const;
+    const NodeLocation* locateRack(RackId rackId) const;
+    const NodeLocation* locateChain(ChainId chainId) const;
+
+    // Recursive helper for forEachMod (Element is ChainElement or const ChainElement)
+    template <typename Element, typename Fn>
+    static void visitElementMods(Element& element, Fn& fn) {
+        if (isDevice(element)) {
+            auto& device = magda::getDevice(element);
+            for (size_t i = 0; i < device.mods.size(); ++i) {
+                fn(ModOwner::Device, device.id, static_cast<int>(i), device.mods[i]);
+            }
+        } else if (isRack(element)) {
+            auto& rack = magda::getRack(element);
+            for (size_t i = 0; i < rack.mods.size(); ++i) {
+                fn(ModOwner::Rack, rack.id, static_cast<int>(i), rack.mods[i]);
+            }
+            for (auto& chain : rack.chains) {
+                for (auto& chainElement : chain.elements) {
+                    visitElementMods(chainElement, fn);
+                }
+            }
+        }
+    }
+
+    template <typename Element, typename Fn>
+    static void visitElementMacros(Element& element, Fn& fn) {
+        if (isDevice(element)) {
+            auto& device = magda::getDevice(element);
+            for (size_t i = 0; i < device.macros.size(); ++i) {
+                fn(ModOwner::Device, device.id, static_cast<int>(i), device.macros[i]);
+            }
+        } else if (isRack(element)) {
+            auto& rack = magda::getRack(element);
+            for (size_t i = 0; i < rack.macros.size(); ++i) {
+                fn(ModOwner::Rack, rack.id, static_cast<int>(i), rack.macros[i]);
+            }
+            for (auto& chain : rack.chains) {
+                for (auto& chainElement : chain.elements) {
+                    visitElementMacros(chainElement, fn);
+                }
+            }
+        }
+    }
+
+    // Changes recorded for the next trackChangesCoalesced() delivery
+    TrackChangeSet pendingChanges_;
+    bool changeDeliveryPending_ = false;
+
+    void scheduleChangeDelivery();
+    void markTrackAdded(TrackId trackId);
+    void markTrackRemoved(TrackId trackId);
+    void markTrackModified(TrackId trackId, TrackDirty dirty);
+    void markTracksReordered();
+
+    void forwardMacroValue(ModOwner owner, int ownerId, int macroIndex, float value);
+
     void notifyTracksChanged();
-    void notifyTrackPropertyChanged(int trackId);
+    void notifyTrackPropertyChanged(int trackId, TrackDirty dirty = TrackDirty::All);
     void notifyMasterChannelChanged();
     void notifyTrackSelectionChanged(TrackId trackId);
     void notifyTrackDevicesChanged(TrackId trackId);
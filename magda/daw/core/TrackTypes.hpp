@@ -35,6 +35,15 @@ inline const char* getTrackTypeName(TrackType type) {
     return "Unknown";
 }
 
+/**
+ * @brief Freeze state: a frozen track plays a render of itself with its plugins suspended
+ */
+enum class FreezeState {
+    Unfrozen,
+    Freezing,  // Render in progress; the track still plays live
+    Frozen
+};
+
 /**
  * @brief Check if track type can have children
  */
@@ -32,17 +32,29 @@ void UndoManager::executeCommand(std::unique_ptr<UndoableCommand> command) {
         return;
     }
 
-    // Check if we can merge with the previous command
-    if (!undoStack_.empty() && undoStack_.back()->canMergeWith(command.get())) {
-        undoStack_.back()->mergeWith(command.get());
-    } else {
-        // Add to undo stack
-        undoStack_.push_back(std::move(command));
+    // Clear redo stack (new action invalidates redo history)
+    clearRedoStack();
+
+    // Merge into the previous command if it is the same gesture on the same target
+    const double now = juce::Time::getMillisecondCounterHiRes();
+    const bool sameGesture = lastGesture_ == gesture_ &&
+                             (gestureDepth_ > 0 || now - lastCommandMs_ < mergeWindowMs_);
+    lastGesture_ = gesture_;
+    lastCommandMs_ = now;
+
+    if (sameGesture && !undoStack_.empty() && undoStack_.back()->canMergeWith(command.get())) {
+        auto& previous = undoStack_.back();
+        historyBytes_ -= previous->getSizeInBytes();
+        previous->mergeWith(command.get());
+        historyBytes_ += previous->getSizeInBytes();
         trimUndoStack();
+        return;  // Same step, same undo state: nothing for listeners to update
     }
 
-    // Clear redo stack (new action invalidates redo history)
-    redoStack_.clear();
+    // Add to undo stack
+    historyBytes_ += command->getSizeInBytes();
+    undoStack_.push_back(std::move(command));
+    trimUndoStack();
 
     notifyListeners();
 
@@ -57,11 +69,15 @@ bool UndoManager::undo() {
     // Pop from undo stack
     auto command = std::move(undoStack_.back());
     undoStack_.pop_back();
+    breakMerge();
+    pageIn(*command);
 
     std::cout << "📝 UNDO: Undoing '" << command->getDescription() << "'" << std::endl;
 
-    // Undo the command
+    // Undo the command (what it holds on to can change, e.g. state captured on undo)
+    historyBytes_ -= command->getSizeInBytes();
     command->undo();
+    historyBytes_ += command->getSizeInBytes();
 
     // Push to redo stack
     redoStack_.push_back(std::move(command));
@@ -79,11 +95,14 @@ bool UndoManager::redo() {
     // Pop from redo stack
     auto command = std::move(redoStack_.back());
     redoStack_.pop_back();
+    breakMerge();
 
     std::cout << "📝 UNDO: Redoing '" << command->getDescription() << "'" << std::endl;
 
     // Re-execute the command
+    historyBytes_ -= command->getSizeInBytes();
     command->execute();
+    historyBytes_ += command->getSizeInBytes();
 
     // Push to undo stack
     undoStack_.push_back(std::move(command));
@@ -108,10 +127,16 @@ juce::String UndoManager::getRedoDescription() const {
 }
 
 void UndoManager::clearHistory() {
+    for (const auto& command : undoStack_) {
+        forget(*command);
+    }
     undoStack_.clear();
-    redoStack_.clear();
+    clearRedoStack();
+    historyBytes_ = 0;
     compoundCommands_.clear();
     compoundDepth_ = 0;
+    gestureDepth_ = 0;
+    breakMerge();
     notifyListeners();
 }
 
@@ -134,11 +159,14 @@ void UndoManager::endCompoundOperation() {
         // Create compound command and add to undo stack
         auto compound =
             std::make_unique<CompoundCommand>(compoundDescription_, std::move(compoundCommands_));
-        undoStack_.push_back(std::move(compound));
-        trimUndoStack();
 
         // Clear redo stack
-        redoStack_.clear();
+        clearRedoStack();
+
+        historyBytes_ += compound->getSizeInBytes();
+        undoStack_.push_back(std::move(compound));
+        breakMerge();
+        trimUndoStack();
 
         compoundCommands_.clear();
         notifyListeners();
@@ -148,6 +176,18 @@ void UndoManager::endCompoundOperation() {
     }
 }
 
+void UndoManager::beginGesture() {
+    if (gestureDepth_++ == 0) {
+        breakMerge();
+    }
+}
+
+void UndoManager::endGesture() {
+    if (gestureDepth_ > 0 && --gestureDepth_ == 0) {
+        breakMerge();
+    }
+}
+
 void UndoManager::addListener(UndoManagerListener* listener) {
     if (listener && std::find(listeners_.begin(), listeners_.end(), listener) == listeners_.end()) {
         listeners_.push_back(listener);
@@ -165,11 +205,86 @@ void UndoManager::notifyListeners() {
 }
 
 void UndoManager::trimUndoStack() {
-    while (undoStack_.size() > maxUndoSteps_) {
+    spillOldSteps();
+
+    auto overBudget = [this]() {
+        return maxUndoBytes_ > 0 && historyBytes_ > maxUndoBytes_ && undoStack_.size() > 1;
+    };
+
+    while (!undoStack_.empty() && (undoStack_.size() > maxUndoSteps_ || overBudget())) {
+        forget(*undoStack_.front());
         undoStack_.pop_front();
     }
 }
 
+void UndoManager::clearRedoStack() {
+    for (const auto& command : redoStack_) {
+        forget(*command);
+    }
+    redoStack_.clear();
+}
+
+void UndoManager::spillOldSteps() {
+    if (maxResidentBytes_ == 0) {
+        return;
+    }
+
+    // Oldest first, leaving the newest one (undone next, and it may still merge)
+    for (size_t i = 0; i + 1 < undoStack_.size() && historyBytes_ > maxResidentBytes_; ++i) {
+        auto& command = *undoStack_[i];
+        if (spilled_.count(&command) > 0) {
+            continue;
+        }
+
+        const size_t before = command.getSizeInBytes();
+        juce::MemoryOutputStream out;
+        if (!command.spillState(out)) {
+            continue;
+        }
+
+        const auto record = spillFile_.write(out.getData(), out.getDataSize());
+        if (!record.isValid()) {
+            // Nowhere to put it: keep it in memory and stop trying for now
+            juce::MemoryInputStream in(out.getData(), out.getDataSize(), false);
+            command.restoreState(in);
+            return;
+        }
+        historyBytes_ = historyBytes_ - before + command.getSizeInBytes();
+        spilled_.emplace(&command, record);
+    }
+}
+
+void UndoManager::pageIn(UndoableCommand& command) {
+    auto it = spilled_.find(&command);
+    if (it == spilled_.end()) {
+        return;
+    }
+
+    juce::MemoryBlock data;
+    const bool read = spillFile_.read(it->second, data);
+    spillFile_.release(it->second);
+    spilled_.erase(it);
+    if (!read) {
+        std::cout << "📝 UNDO: Could not read back '" << command.getDescription() << "'"
+                  << std::endl;
+        return;
+    }
+
+    historyBytes_ -= command.getSizeInBytes();
+    juce::MemoryInputStream in(data, false);
+    command.restoreState(in);
+    historyBytes_ += command.getSizeInBytes();
+}
+
+void UndoManager::forget(const UndoableCommand& command) {
+    historyBytes_ -= command.getSizeInBytes();
+    auto it = spilled_.find(&command);
+    if (it != spilled_.end()) {
+        spillFile_.release(it->second);
+        spilled_.erase(it);
+    }
+}
+
 // ============================================================================
 // CompoundCommand Implementation
 // ============================================================================
@@ -185,6 +300,42 @@ void CompoundCommand::execute() {
     }
 }
 
+size_t CompoundCommand::getSizeInBytes() const {
+    size_t bytes = DEFAULT_COMMAND_BYTES;
+    for (const auto& cmd : commands_) {
+        bytes += cmd->getSizeInBytes();
+    }
+    return bytes;
+}
+
+bool CompoundCommand::spillState(juce::OutputStream& out) {
+    // Each command's bytes are framed, so restoreState() hands every one exactly its own
+    bool spilled = false;
+    for (auto& cmd : commands_) {
+        juce::MemoryOutputStream state;
+        const bool commandSpilled = cmd->spillState(state);
+        out.writeBool(commandSpilled);
+        if (commandSpilled) {
+            out.writeInt64(static_cast<juce::int64>(state.getDataSize()));
+            out.write(state.getData(), state.getDataSize());
+            spilled = true;
+        }
+    }
+    return spilled;
+}
+
+void CompoundCommand::restoreState(juce::InputStream& in) {
+    for (auto& cmd : commands_) {
+        if (!in.readBool()) {
+            continue;
+        }
+        juce::MemoryBlock state;
+        in.readIntoMemoryBlock(state, static_cast<juce::ssize_t>(in.readInt64()));
+        juce::MemoryInputStream stateIn(state, false);
+        cmd->restoreState(stateIn);
+    }
+}
+
 void CompoundCommand::undo() {
     // Undo all commands in reverse order
     for (auto it = commands_.rbegin(); it != commands_.rend(); ++it) {
@@ -2,10 +2,14 @@
 
 #include <juce_core/juce_core.h>
 
+#include <cstdint>
 #include <deque>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
+#include "UndoSpillFile.hpp"
+
 namespace magda {
 
 /**
@@ -39,7 +43,8 @@ class UndoableCommand {
     /**
      * Check if this command can be merged with another command.
      * Used for coalescing rapid repeated operations (e.g., multiple small moves).
-     * Default: no merging.
+     * Only asked about a command of the same gesture (see UndoManager::beginGesture),
+     * so this only has to check the target. Default: no merging.
      */
     virtual bool canMergeWith(const UndoableCommand* /*other*/) const {
         return false;
@@ -50,6 +55,33 @@ class UndoableCommand {
      * Only called if canMergeWith returned true.
      */
     virtual void mergeWith(const UndoableCommand* /*other*/) {}
+
+    /**
+     * Approximate memory this command keeps alive for undo/redo, in bytes.
+     * Commands holding captured state (deleted clips, tracks, note batches)
+     * override this so UndoManager can enforce its memory budget.
+     * Default: a small fixed cost for parameter-only commands.
+     */
+    virtual size_t getSizeInBytes() const {
+        return DEFAULT_COMMAND_BYTES;
+    }
+
+    /**
+     * Write the state captured for undo/redo to out and release it, keeping only what
+     * getDescription() needs. UndoManager does this to old steps once the history passes
+     * its resident budget, and hands the same bytes to restoreState() before undoing one.
+     * Default: false, the command stays in memory.
+     */
+    virtual bool spillState(juce::OutputStream& /*out*/) {
+        return false;
+    }
+
+    /**
+     * Take back the state spillState() wrote.
+     */
+    virtual void restoreState(juce::InputStream& /*in*/) {}
+
+    static constexpr size_t DEFAULT_COMMAND_BYTES = 64;
 };
 
 /**
@@ -75,6 +107,18 @@ class UndoManagerListener {
  *   UndoManager::getInstance().executeCommand(std::move(cmd));
  *
  * The command is executed immediately and added to the undo stack.
+ *
+ * A continuous gesture (a drag, repeated nudges) collapses into one undo step: a command
+ * merges into the previous one when canMergeWith() accepts it and both belong to the same
+ * gesture. Between beginGesture() and endGesture() every command is; outside one, commands
+ * less than the merge window apart are. Undo, redo and the gesture bounds all start a new
+ * gesture, so separate edits of the same target stay separate steps. A merge leaves the
+ * undo state as it was, so listeners aren't notified for it.
+ *
+ * Once the history holds more than the resident budget, the oldest undo steps that can
+ * (see UndoableCommand::spillState) move their captured state to an UndoSpillFile and are
+ * paged back in when undone, so a long session keeps its depth without keeping it all in
+ * memory. The newest step always stays resident.
  */
 class UndoManager {
   public:
@@ -149,6 +193,33 @@ class UndoManager {
         return compoundDepth_ > 0;
     }
 
+    /**
+     * Begin a continuous gesture (e.g. on mouse-down of a drag that commits as it goes).
+     * Mergeable commands until endGesture() collapse into one undo step. Nests.
+     */
+    void beginGesture();
+
+    /**
+     * End a continuous gesture; the next command starts a new undo step.
+     */
+    void endGesture();
+
+    bool isInGesture() const {
+        return gestureDepth_ > 0;
+    }
+
+    /**
+     * Outside an explicit gesture, how close in time commands must be to merge
+     * (0 = only within explicit gestures).
+     */
+    void setMergeWindowMs(double windowMs) {
+        mergeWindowMs_ = windowMs;
+    }
+
+    double getMergeWindowMs() const {
+        return mergeWindowMs_;
+    }
+
     /**
      * Set maximum number of undo steps to keep.
      */
@@ -164,6 +235,51 @@ class UndoManager {
         return maxUndoSteps_;
     }
 
+    /**
+     * Set the memory budget for undo/redo history (0 = unlimited).
+     * The oldest undo steps are dropped once the history's getSizeInBytes()
+     * total exceeds it; the most recent step is always kept.
+     */
+    void setMaxUndoBytes(size_t maxBytes) {
+        maxUndoBytes_ = maxBytes;
+        trimUndoStack();
+    }
+
+    size_t getMaxUndoBytes() const {
+        return maxUndoBytes_;
+    }
+
+    /**
+     * Set how much history stays in memory before old steps are spilled to disk
+     * (0 = never spill). Steps that can't spill count against setMaxUndoBytes() as before.
+     */
+    void setMaxResidentBytes(size_t maxBytes) {
+        maxResidentBytes_ = maxBytes;
+        trimUndoStack();
+    }
+
+    size_t getMaxResidentBytes() const {
+        return maxResidentBytes_;
+    }
+
+    /**
+     * Approximate memory held by the undo and redo stacks (spilled state excluded).
+     */
+    size_t getHistorySizeInBytes() const {
+        return historyBytes_;
+    }
+
+    /**
+     * Bytes of history waiting in the spill file.
+     */
+    size_t getSpilledBytes() const {
+        return static_cast<size_t>(spillFile_.getLiveBytes());
+    }
+
+    size_t getNumSpilledSteps() const {
+        return spilled_.size();
+    }
+
     // Listener management
     void addListener(UndoManagerListener* listener);
     void removeListener(UndoManagerListener* listener);
@@ -175,6 +291,18 @@ class UndoManager {
     void notifyListeners();
     void trimUndoStack();
 
+    // Spill the oldest resident undo steps until the history is back under budget
+    void spillOldSteps();
+    // Bring a spilled command's state back before it is undone
+    void pageIn(UndoableCommand& command);
+    // A command leaving the history: drop its spilled state and its share of the total
+    void forget(const UndoableCommand& command);
+
+    // Start a new gesture: nothing executed from here on merges into the current top
+    void breakMerge() {
+        ++gesture_;
+    }
+
     std::deque<std::unique_ptr<UndoableCommand>> undoStack_;
     std::deque<std::unique_ptr<UndoableCommand>> redoStack_;
 
@@ -183,7 +311,23 @@ class UndoManager {
     juce::String compoundDescription_;
     std::vector<std::unique_ptr<UndoableCommand>> compoundCommands_;
 
+    // Merge state: the top of the undo stack was recorded in lastGesture_ at lastCommandMs_
+    int gestureDepth_ = 0;
+    uint64_t gesture_ = 0;
+    uint64_t lastGesture_ = 0;
+    double lastCommandMs_ = 0.0;
+    double mergeWindowMs_ = 500.0;
+
     size_t maxUndoSteps_ = 100;
+    size_t maxUndoBytes_ = 64 * 1024 * 1024;
+    size_t maxResidentBytes_ = 16 * 1024 * 1024;
+    size_t historyBytes_ = 0;  // Sum of getSizeInBytes() over both stacks
+
+    // Undo steps whose state is in the spill file, and where
+    UndoSpillFile spillFile_;
+    std::unordered_map<const UndoableCommand*, UndoSpillFile::Record> spilled_;
+
+    void clearRedoStack();
 
     std::vector<UndoManagerListener*> listeners_;
 };
@@ -201,6 +345,9 @@ class CompoundCommand : public UndoableCommand {
     juce::String getDescription() const override {
         return description_;
     }
+    size_t getSizeInBytes() const override;
+    bool spillState(juce::OutputStream& out) override;
+    void restoreState(juce::InputStream& in) override;
 
   private:
     juce::String description_;
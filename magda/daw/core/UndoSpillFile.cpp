@@ -0,0 +1,91 @@
+#include "UndoSpillFile.hpp"
+
+#include <cstring>
+
+namespace magda {
+
+UndoSpillFile::~UndoSpillFile() {
+    out_.reset();
+    if (file_ != juce::File()) {
+        file_.deleteFile();
+    }
+}
+
+bool UndoSpillFile::open() {
+    if (out_ != nullptr) {
+        return true;
+    }
+    if (file_ == juce::File()) {
+        file_ = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                    .getNonexistentChildFile("magda_undo", ".spill", false);
+    }
+
+    // Starts empty: nothing earlier is live, or the file wouldn't have been closed
+    out_ = file_.createOutputStream();
+    if (out_ == nullptr || !out_->setPosition(0) || out_->truncate().failed()) {
+        out_.reset();
+        return false;
+    }
+    end_ = 0;
+    return true;
+}
+
+UndoSpillFile::Record UndoSpillFile::write(const void* data, size_t size) {
+    if (size == 0 || !open()) {
+        return {};
+    }
+
+    Record record;
+    record.offset = end_;
+    record.size = static_cast<juce::int64>(size);
+
+    // Flushed so the mapping sees it
+    if (!out_->write(data, size)) {
+        out_->setPosition(end_);
+        return {};
+    }
+    out_->flush();
+
+    end_ += record.size;
+    liveBytes_ += record.size;
+    ++liveRecords_;
+    return record;
+}
+
+bool UndoSpillFile::read(const Record& record, juce::MemoryBlock& data) const {
+    if (!record.isValid() || record.offset + record.size > end_) {
+        return false;
+    }
+
+    // The mapping starts on a page boundary at or before the record
+    juce::MemoryMappedFile mapped(
+        file_, juce::Range<juce::int64>(record.offset, record.offset + record.size),
+        juce::MemoryMappedFile::readOnly);
+    const auto* base = static_cast<const char*>(mapped.getData());
+    const auto range = mapped.getRange();
+    if (base == nullptr || range.getStart() > record.offset ||
+        range.getEnd() < record.offset + record.size) {
+        return false;
+    }
+
+    data.setSize(static_cast<size_t>(record.size));
+    std::memcpy(data.getData(), base + (record.offset - range.getStart()), data.getSize());
+    return true;
+}
+
+void UndoSpillFile::release(const Record& record) {
+    if (!record.isValid() || liveRecords_ == 0) {
+        return;
+    }
+
+    liveBytes_ -= record.size;
+    if (--liveRecords_ == 0) {
+        // Nothing left to read: start over from an empty file
+        out_.reset();
+        liveBytes_ = 0;
+        end_ = 0;
+        file_.replaceWithData(nullptr, 0);
+    }
+}
+
+}  // namespace magda
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+namespace magda {
+
+/**
+ * @brief Append-only scratch file holding the captured state of old undo steps
+ *
+ * UndoManager writes a step's state here once the history passes its resident budget and
+ * reads it back if the user undoes that far. Records are appended and never rewritten;
+ * reading one maps just its pages (juce::MemoryMappedFile), so paging a step back in
+ * costs that step's size however large the file has grown. Released records are only
+ * counted, and the file is cut back to nothing once none are live.
+ *
+ * The file is created in the temporary directory on the first write and deleted with the
+ * object. Message thread only.
+ */
+class UndoSpillFile {
+  public:
+    struct Record {
+        juce::int64 offset = -1;
+        juce::int64 size = 0;
+
+        bool isValid() const {
+            return offset >= 0;
+        }
+    };
+
+    UndoSpillFile() = default;
+    ~UndoSpillFile();
+
+    /**
+     * @return Where the data went, or an invalid record if it couldn't be written
+     */
+    Record write(const void* data, size_t size);
+
+    /**
+     * @brief Read a record back into data
+     */
+    bool read(const Record& record, juce::MemoryBlock& data) const;
+
+    /**
+     * @brief The record won't be read again
+     */
+    void release(const Record& record);
+
+    // Bytes in records not released yet
+    juce::int64 getLiveBytes() const {
+        return liveBytes_;
+    }
+
+    // Bytes the file takes on disk, released records included
+    juce::int64 getFileBytes() const {
+        return end_;
+    }
+
+  private:
+    bool open();
+
+    juce::File file_;
+    std::unique_ptr<juce::FileOutputStream> out_;
+    juce::int64 end_ = 0;
+    juce::int64 liveBytes_ = 0;
+    int liveRecords_ = 0;
+
+    JUCE_DECLARE_NON_COPYABLE(UndoSpillFile)
+};
+
+}  // namespace magda
@@ -13,6 +13,15 @@ namespace magda {
  */
 enum class ViewMode { Live, Arrange, Mix, Master };
 
+/**
+ * @brief How much CPU the engine spends on quality
+ *
+ * Draft is for editing and tracking in real time: clips stretch with the cheaper stretcher.
+ * Final stretches with the best one the build has. Offline renders always run at Final,
+ * oversampled as far as their devices ask (DeviceInfo::oversampling).
+ */
+enum class RenderQuality { Draft, Final };
+
 /**
  * @brief Audio engine optimization profile for each view mode
  *
@@ -23,21 +32,22 @@ struct AudioEngineProfile {
     int latencyMs;        // Target latency in milliseconds
     bool lowLatencyMode;  // Prioritize responsiveness over quality
     bool multiThreaded;   // Use multiple processing threads
+    RenderQuality quality = RenderQuality::Draft;  // While playing live
 
     static AudioEngineProfile getLiveProfile() {
-        return {128, 3, true, false};
+        return {128, 3, true, false, RenderQuality::Draft};
     }
 
     static AudioEngineProfile getArrangeProfile() {
-        return {512, 12, false, true};
+        return {512, 12, false, true, RenderQuality::Draft};
     }
 
     static AudioEngineProfile getMixProfile() {
-        return {1024, 23, false, true};
+        return {1024, 23, false, true, RenderQuality::Final};
     }
 
     static AudioEngineProfile getMasterProfile() {
-        return {2048, 46, false, true};
+        return {2048, 46, false, true, RenderQuality::Final};
     }
 
     static AudioEngineProfile getProfileForMode(ViewMode mode) {
@@ -2,6 +2,7 @@
 
 #include <string>
 
+#include "../core/TypeIds.hpp"
 #include "../ui/state/TransportStateListener.hpp"
 
 namespace juce {
@@ -51,12 +52,39 @@ class AudioEngine : public AudioEngineListener {
     virtual void setMetronomeEnabled(bool enabled) = 0;
     virtual bool isMetronomeEnabled() const = 0;
 
+    /**
+     * @brief Bars the metronome counts in before record() starts the transport (0 for none)
+     */
+    virtual void setCountInBars(int /*bars*/) {}
+    virtual int getCountInBars() const {
+        return 0;
+    }
+
     // ===== Trigger State (for transport-synced devices) =====
     virtual void updateTriggerState() = 0;
 
     // ===== Device Management =====
     virtual juce::AudioDeviceManager* getDeviceManager() = 0;
 
+    /**
+     * @brief Re-read the render thread settings from Config and apply them
+     */
+    virtual void applyRenderThreadSettings() {}
+
+    // ===== Track Freeze =====
+    /**
+     * @brief Start rendering a track for freezing; the engine reports the outcome through
+     *        TrackManager::setTrackFreezeState()
+     * @return False if the track can't be frozen (nothing is started)
+     */
+    virtual bool freezeTrack(const std::string& track_id) {
+        (void)track_id;
+        return false;
+    }
+    virtual void unfreezeTrack(const std::string& track_id) {
+        (void)track_id;
+    }
+
     // ===== Audio Management =====
     virtual class AudioBridge* getAudioBridge() = 0;
     virtual const class AudioBridge* getAudioBridge() const = 0;
@@ -65,6 +93,15 @@ class AudioEngine : public AudioEngineListener {
     virtual class MidiBridge* getMidiBridge() = 0;
     virtual const class MidiBridge* getMidiBridge() const = 0;
 
+    // ===== Playhead =====
+    /**
+     * @brief The audio thread's position and heard time, for drawing the playhead per
+     *        display frame; null if the engine doesn't publish one
+     */
+    virtual const class PlayheadClock* getPlayheadClock() const {
+        return nullptr;
+    }
+
     // ===== MIDI Preview =====
     /**
      * @brief Preview a MIDI note on a track (for keyboard audition)
@@ -75,6 +112,16 @@ class AudioEngine : public AudioEngineListener {
      */
     virtual void previewNoteOnTrack(const std::string& track_id, int noteNumber, int velocity,
                                     bool isNoteOn) = 0;
+
+    /**
+     * @brief Preview a MIDI note on a track without parsing an ID or taking locks
+     *
+     * Safe from any thread; the note plays in the next audio block, offset by when this
+     * was called, so fast auditioning keeps its timing.
+     */
+    virtual void previewNote(TrackId trackId, int noteNumber, int velocity, bool isNoteOn) {
+        previewNoteOnTrack(std::to_string(trackId), noteNumber, velocity, isNoteOn);
+    }
 };
 
 }  // namespace magda
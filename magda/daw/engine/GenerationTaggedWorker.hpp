@@ -0,0 +1,109 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <juce_events/juce_events.h>
+
+#include <atomic>
+#include <memory>
+
+namespace magda {
+
+/**
+ * @brief A child process whose IPC callbacks reach its owner on the message thread
+ *
+ * JUCE delivers IPC callbacks on a background thread. They are posted to the message thread
+ * tagged with the worker's index and launch generation, and dropped once the owner clears
+ * its validFlag_; the owner compares the generation with getGeneration() so messages from a
+ * process that has since been killed or replaced are ignored.
+ *
+ * Owner provides a std::shared_ptr<std::atomic<bool>> validFlag_ and
+ * handleWorkerMessage(int workerIndex, int generation, const juce::MemoryBlock&) and
+ * handleWorkerLost(int workerIndex, int generation), and befriends this class if they are
+ * private. Owners add their per-worker state by deriving.
+ */
+template <typename Owner>
+class GenerationTaggedWorker : private juce::ChildProcessCoordinator {
+  public:
+    explicit GenerationTaggedWorker(Owner& owner, int index = 0) : owner_(owner), index_(index) {}
+
+    /**
+     * @brief Start the process under a new generation
+     * @param timeoutMs How long the process may go without answering a ping, 0 for no limit
+     * @param streamFlags juce::ChildProcess flags for the output to capture
+     */
+    bool launch(const juce::File& executable, const juce::String& workerId, int generation,
+                int timeoutMs,
+                int streamFlags = juce::ChildProcess::wantStdOut | juce::ChildProcess::wantStdErr) {
+        generation_.store(generation);
+        return launchWorkerProcess(executable, workerId, timeoutMs, streamFlags);
+    }
+
+    // Stop the process; late callbacks from it are ignored from here on
+    void kill() {
+        generation_.store(-1);
+        killWorkerProcess();
+    }
+
+    void send(const juce::MemoryBlock& message) {
+        sendMessageToWorker(message);
+    }
+
+    int getIndex() const {
+        return index_;
+    }
+
+    /**
+     * @brief The generation the process was launched with, or -1 once killed
+     */
+    int getGeneration() const {
+        return generation_.load();
+    }
+
+  protected:
+    /**
+     * @brief Take a message on the IPC thread instead of posting it
+     * @return true if handled
+     */
+    virtual bool handleOnIpcThread(const juce::MemoryBlock& /*message*/) {
+        return false;
+    }
+
+    Owner& getOwner() const {
+        return owner_;
+    }
+
+  private:
+    void handleMessageFromWorker(const juce::MemoryBlock& message) override {
+        if (handleOnIpcThread(message)) {
+            return;
+        }
+
+        auto validFlag = owner_.validFlag_;
+        auto* owner = &owner_;
+        const int index = index_;
+        const int generation = generation_.load();
+        juce::MessageManager::callAsync([validFlag, owner, index, generation, message]() {
+            if (validFlag->load()) {
+                owner->handleWorkerMessage(index, generation, message);
+            }
+        });
+    }
+
+    void handleConnectionLost() override {
+        auto validFlag = owner_.validFlag_;
+        auto* owner = &owner_;
+        const int index = index_;
+        const int generation = generation_.load();
+        juce::MessageManager::callAsync([validFlag, owner, index, generation]() {
+            if (validFlag->load()) {
+                owner->handleWorkerLost(index, generation);
+            }
+        });
+    }
+
+    Owner& owner_;
+    const int index_;
+    std::atomic<int> generation_{-1};
+};
+
+}  // namespace magda
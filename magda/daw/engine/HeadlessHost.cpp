@@ -0,0 +1,169 @@
+#include "HeadlessHost.hpp"
+
+#include "../audio/AudioBridge.hpp"
+#include "../core/ClipManager.hpp"
+#include "../core/ProjectManager.hpp"
+#include "../core/TrackManager.hpp"
+#include "TracktionEngineWrapper.hpp"
+
+namespace magda {
+
+HeadlessHost::HeadlessHost() = default;
+
+HeadlessHost::~HeadlessHost() {
+    *alive_ = false;
+    shutdown();
+}
+
+bool HeadlessHost::initialize() {
+    if (engine_ != nullptr) {
+        return true;
+    }
+
+    auto engine = std::make_unique<TracktionEngineWrapper>(TracktionEngineWrapper::Mode::Headless);
+    if (!engine->initialize() || engine->getAudioBridge() == nullptr) {
+        return false;
+    }
+    engine_ = std::move(engine);
+    return true;
+}
+
+void HeadlessHost::shutdown() {
+    stopTimer();
+    opening_ = false;
+    onReady_ = nullptr;
+    renders_.clear();
+
+    if (engine_ != nullptr) {
+        engine_->shutdown();
+        engine_.reset();
+    }
+}
+
+void HeadlessHost::openProject(const juce::File& file, Callback onReady) {
+    if (engine_ == nullptr || opening_ || onReady_ != nullptr) {
+        if (onReady) {
+            onReady(engine_ == nullptr ? "The engine isn't running"
+                                       : "Wait for the current project to open");
+        }
+        return;
+    }
+
+    opening_ = true;
+    ProjectManager::getInstance().openAsync(
+        file, [this, alive = alive_, onReady = std::move(onReady)](const juce::String& error) {
+            if (!*alive) {
+                return;
+            }
+            opening_ = false;
+            if (error.isNotEmpty()) {
+                if (onReady) {
+                    onReady(error);
+                }
+                return;
+            }
+
+            if (engine_ == nullptr) {
+                if (onReady) {
+                    onReady("The engine was shut down");
+                }
+                return;
+            }
+
+            // The tracks are in the model; the engine picks them up on the next flush
+            onReady_ = onReady ? onReady : [](const juce::String&) {};
+            updateTimer();
+        });
+}
+
+std::string HeadlessHost::render(const RenderInterface::RenderRequest& request,
+                                 RenderCallback onDone) {
+    if (engine_ == nullptr) {
+        return {};
+    }
+
+    flushModel();
+    const auto jobId = engine_->startRender(request);
+    if (jobId.empty()) {
+        return jobId;
+    }
+
+    renders_[jobId] = onDone ? std::move(onDone)
+                             : [](const std::string&, RenderInterface::RenderStatus) {};
+    updateTimer();
+    return jobId;
+}
+
+TransportInterface* HeadlessHost::getTransport() {
+    return engine_.get();
+}
+
+TrackInterface* HeadlessHost::getTracks() {
+    return engine_.get();
+}
+
+ClipInterface* HeadlessHost::getClips() {
+    return engine_.get();
+}
+
+MixerInterface* HeadlessHost::getMixer() {
+    return engine_.get();
+}
+
+RenderInterface* HeadlessHost::getRenderer() {
+    return engine_.get();
+}
+
+void HeadlessHost::timerCallback() {
+    if (engine_ == nullptr) {
+        stopTimer();
+        return;
+    }
+
+    // Plugins are loaded in slices on the message thread; the project is ready once the
+    // sync has queued them all and the queue has drained
+    if (onReady_ != nullptr) {
+        flushModel();
+        if (engine_->getAudioBridge()->getNumPendingPluginLoads() == 0) {
+            auto onReady = std::move(onReady_);
+            onReady_ = nullptr;
+            onReady({});
+        }
+    }
+
+    // Copied: a callback may start another render or shut the host down
+    auto renders = renders_;
+    for (const auto& [jobId, onDone] : renders) {
+        if (engine_ == nullptr) {
+            return;
+        }
+        const auto status = engine_->getRenderStatus(jobId);
+        if (status == RenderInterface::RenderStatus::Queued ||
+            status == RenderInterface::RenderStatus::Rendering) {
+            continue;
+        }
+        renders_.erase(jobId);
+        onDone(jobId, status);
+    }
+
+    updateTimer();
+}
+
+void HeadlessHost::updateTimer() {
+    if (engine_ != nullptr && (onReady_ != nullptr || !renders_.empty())) {
+        if (!isTimerRunning()) {
+            startTimer(kPollIntervalMs);
+        }
+    } else {
+        stopTimer();
+    }
+}
+
+void HeadlessHost::flushModel() {
+    // Coalesced model notifications, then the engine sync they mark as pending
+    TrackManager::getInstance().flushPendingChanges();
+    ClipManager::getInstance().flushPendingChanges();
+    engine_->getAudioBridge()->flushPendingSync();
+}
+
+}  // namespace magda
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <juce_events/juce_events.h>
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+
+#include "../interfaces/clip_interface.hpp"
+#include "../interfaces/mixer_interface.hpp"
+#include "../interfaces/render_interface.hpp"
+#include "../interfaces/track_interface.hpp"
+#include "../interfaces/transport_interface.hpp"
+
+namespace magda {
+
+class TracktionEngineWrapper;
+
+/**
+ * @brief Runs projects with no UI: a headless engine, the model singletons and the interfaces
+ *
+ * Boots TracktionEngineWrapper in Mode::Headless (saved plugin list, no audio or MIDI
+ * device, no plugin windows), opens projects through ProjectManager and reports them ready
+ * once the engine has every plugin they use, then hands out the Track, Clip, Mixer,
+ * Transport and Render interfaces for batch work. Nothing here touches a Component.
+ *
+ * The host needs a running message loop - ProjectManager, AudioBridge's plugin loading and
+ * OfflineRenderer all call back on it - but runs none itself; magda_headless provides one.
+ *
+ * Message thread only.
+ */
+class HeadlessHost : private juce::Timer {
+  public:
+    /**
+     * @brief Called with an empty string on success, otherwise the error
+     */
+    using Callback = std::function<void(const juce::String& error)>;
+
+    /**
+     * @brief Called once a render job has stopped, with its final status
+     */
+    using RenderCallback =
+        std::function<void(const std::string& jobId, RenderInterface::RenderStatus status)>;
+
+    HeadlessHost();
+    ~HeadlessHost() override;
+
+    HeadlessHost(const HeadlessHost&) = delete;
+    HeadlessHost& operator=(const HeadlessHost&) = delete;
+
+    bool initialize();
+
+    /**
+     * @brief Cancel renders and release the engine (the model singletons stay as they are)
+     */
+    void shutdown();
+
+    bool isInitialized() const {
+        return engine_ != nullptr;
+    }
+
+    /**
+     * @brief Replace the current project with the one in file
+     * @param onReady Called once the project is in the engine with its plugins loaded
+     */
+    void openProject(const juce::File& file, Callback onReady);
+
+    /**
+     * @brief Queue a render of the current project
+     * @param onDone Called when the job has finished, failed or been cancelled
+     * @return The job id - see RenderInterface::startRender()
+     */
+    std::string render(const RenderInterface::RenderRequest& request, RenderCallback onDone);
+
+    // Null until initialize() succeeds
+    TracktionEngineWrapper* getEngine() {
+        return engine_.get();
+    }
+    TransportInterface* getTransport();
+    TrackInterface* getTracks();
+    ClipInterface* getClips();
+    MixerInterface* getMixer();
+    RenderInterface* getRenderer();
+
+    static constexpr int kPollIntervalMs = 20;
+
+  private:
+    void timerCallback() override;
+    void updateTimer();
+    void flushModel();
+
+    std::unique_ptr<TracktionEngineWrapper> engine_;
+
+    bool opening_ = false;   // ProjectManager is reading the file
+    Callback onReady_;       // Set from the file being read until its plugins have loaded
+    std::map<std::string, RenderCallback> renders_;  // Jobs still to report, by id
+
+    // Cleared on destruction so an open finishing later is dropped
+    std::shared_ptr<bool> alive_ = std::make_shared<bool>(true);
+};
+
+}  // namespace magda
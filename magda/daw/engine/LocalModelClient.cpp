@@ -0,0 +1,354 @@
+#include "LocalModelClient.hpp"
+
+#include <iostream>
+
+#include "../audio/RenderThreadPolicy.hpp"
+
+namespace magda {
+
+// =============================================================================
+// LocalModelClient
+// =============================================================================
+
+LocalModelClient::LocalModelClient(const Settings& settings) : settings_(settings) {
+    // Installed (and copied into the macOS bundle) beside the app
+    const auto executable = juce::File::getSpecialLocation(juce::File::currentExecutableFile);
+#if JUCE_WINDOWS
+    workerExecutable_ = executable.getSiblingFile("magda_model_worker.exe");
+#else
+    workerExecutable_ = executable.getSiblingFile("magda_model_worker");
+#endif
+}
+
+LocalModelClient::~LocalModelClient() {
+    validFlag_->store(false);
+    stop();
+}
+
+bool LocalModelClient::start() {
+    if (running_) {
+        return true;
+    }
+    if (!settings_.model.existsAsFile()) {
+        lastError_ = "No model at " + settings_.model.getFullPathName();
+        return false;
+    }
+    if (!workerExecutable_.existsAsFile()) {
+        lastError_ = "No model worker at " + workerExecutable_.getFullPathName();
+        return false;
+    }
+
+    if (worker_ == nullptr) {
+        worker_ = std::make_unique<Worker>(*this);
+    }
+    // Pings are answered on the worker's IPC thread, so a long generation doesn't miss one
+    if (!worker_->launch(workerExecutable_, LocalModelIPC::WORKER_ID, nextGeneration_++, 10000)) {
+        lastError_ = "Failed to launch the model worker";
+        std::cerr << "[LocalModel] " << lastError_ << std::endl;
+        return false;
+    }
+    running_ = true;
+    ready_ = false;
+
+    // Generate only where rendering doesn't run
+    const auto coreMask = RenderThreadPolicy::getInstance().getSettings().backgroundCoreMask(
+        juce::SystemStats::getNumCpus());
+    const int numThreads = settings_.numThreads > 0
+                               ? settings_.numThreads
+                               : juce::jmax(1, juce::countNumberOfBits(coreMask));
+
+    juce::MemoryBlock msg;
+    juce::MemoryOutputStream stream(msg, false);
+    stream.writeString(LocalModelIPC::MSG_LOAD);
+    stream.writeString(settings_.model.getFullPathName());
+    stream.writeString(settings_.generator);
+    stream.writeInt(numThreads);
+    stream.writeInt(static_cast<int>(coreMask));
+    worker_->send(msg);
+
+    std::cout << "[LocalModel] Loading " << settings_.model.getFileName() << " on "
+              << numThreads << " threads" << std::endl;
+    return true;
+}
+
+void LocalModelClient::stop() {
+    queue_.clear();
+    active_.reset();
+    ready_ = false;
+    if (worker_ != nullptr && running_) {
+        juce::MemoryBlock quitMsg;
+        juce::MemoryOutputStream quitStream(quitMsg, false);
+        quitStream.writeString(LocalModelIPC::MSG_QUIT);
+        worker_->send(quitMsg);
+    }
+    running_ = false;
+    worker_.reset();  // Terminates the process if QUIT didn't
+}
+
+std::string LocalModelClient::composePrompt(const std::string& prompt,
+                                            const std::string& context) {
+    if (context.empty()) {
+        return prompt;
+    }
+    return "Current DAW state:\n" + context + "\n\n" + prompt;
+}
+
+std::string LocalModelClient::contextFor(const std::string& context) const {
+    return context.empty() ? context_ : context;
+}
+
+LocalModelClient::RequestId LocalModelClient::submit(
+    const std::string& prompt, const std::string& context,
+    std::function<void(const std::string&)> onChunk,
+    std::function<void(const std::string&)> onComplete) {
+    const auto id = nextRequestId_++;
+    Request request;
+    request.id = id;
+    request.prompt = composePrompt(prompt, contextFor(context));
+    request.onChunk = std::move(onChunk);
+    request.onComplete = std::move(onComplete);
+    queue_.push_back(std::move(request));
+
+    if (!running_ && !start()) {
+        failAll(lastError_);
+        return 0;
+    }
+    dispatchNext();
+    return id;
+}
+
+bool LocalModelClient::cancel(RequestId id) {
+    for (auto it = queue_.begin(); it != queue_.end(); ++it) {
+        if (it->id == id) {
+            queue_.erase(it);
+            return true;
+        }
+    }
+
+    if (active_ == nullptr || active_->id != id || active_->cancelled) {
+        return false;
+    }
+
+    // Stays active until the worker confirms, so the next prompt doesn't overlap it
+    active_->cancelled = true;
+    juce::MemoryBlock msg;
+    juce::MemoryOutputStream stream(msg, false);
+    stream.writeString(LocalModelIPC::MSG_CANCEL);
+    stream.writeInt64(id);
+    worker_->send(msg);
+    return true;
+}
+
+void LocalModelClient::dispatchNext() {
+    if (!ready_ || active_ != nullptr || queue_.empty()) {
+        return;
+    }
+
+    active_ = std::make_unique<Request>(std::move(queue_.front()));
+    queue_.pop_front();
+    active_->response.clear();
+
+    juce::MemoryBlock msg;
+    juce::MemoryOutputStream stream(msg, false);
+    stream.writeString(LocalModelIPC::MSG_PROMPT);
+    stream.writeInt64(active_->id);
+    stream.writeString(juce::String::fromUTF8(active_->prompt.c_str()));
+    stream.writeInt(settings_.maxTokens);
+    stream.writeDouble(settings_.temperature);
+    worker_->send(msg);
+}
+
+void LocalModelClient::finishActive() {
+    auto request = std::move(active_);
+    if (request != nullptr && !request->cancelled && request->onComplete) {
+        request->onComplete(request->response);
+    }
+    dispatchNext();
+}
+
+void LocalModelClient::failAll(const juce::String& error) {
+    lastError_ = error;
+    std::cerr << "[LocalModel] " << error << std::endl;
+
+    // Completed with what they have, so callers waiting on them don't hang
+    std::deque<Request> failed;
+    failed.swap(queue_);
+    if (active_ != nullptr) {
+        failed.push_front(std::move(*active_));
+        active_.reset();
+    }
+    for (auto& request : failed) {
+        if (!request.cancelled && request.onComplete) {
+            request.onComplete(request.response);
+        }
+    }
+}
+
+void LocalModelClient::handleWorkerMessage(int /*workerIndex*/, int generation,
+                                           const juce::MemoryBlock& message) {
+    if (worker_ == nullptr || worker_->getGeneration() != generation) {
+        return;  // From a process that has since been killed or replaced
+    }
+
+    juce::MemoryInputStream stream(message, false);
+    const juce::String msgType = stream.readString();
+
+    if (msgType == LocalModelIPC::MSG_READY) {
+        ready_ = true;
+        std::cout << "[LocalModel] Model ready" << std::endl;
+        dispatchNext();
+        return;
+    }
+
+    const auto id = stream.readInt64();
+    if (msgType == LocalModelIPC::MSG_ERROR && id == 0) {
+        // The model itself can't be used; relaunching would fail the same way
+        const auto error = stream.readString();
+        worker_->kill();
+        running_ = false;
+        ready_ = false;
+        failAll(error);
+        return;
+    }
+    if (active_ == nullptr || active_->id != id) {
+        return;
+    }
+
+    if (msgType == LocalModelIPC::MSG_CHUNK) {
+        const auto text = stream.readString().toStdString();
+        active_->response += text;
+        if (!active_->cancelled && active_->onChunk) {
+            active_->onChunk(text);
+        }
+    } else if (msgType == LocalModelIPC::MSG_DONE) {
+        finishActive();
+    } else if (msgType == LocalModelIPC::MSG_ERROR) {
+        lastError_ = stream.readString();
+        std::cerr << "[LocalModel] Request " << id << ": " << lastError_ << std::endl;
+        finishActive();
+    }
+}
+
+void LocalModelClient::handleWorkerLost(int /*workerIndex*/, int generation) {
+    if (worker_ == nullptr || worker_->getGeneration() != generation) {
+        return;  // Already handled or replaced
+    }
+
+    std::cout << "[LocalModel] Connection to the model worker lost" << std::endl;
+    worker_->kill();
+    running_ = false;
+    ready_ = false;
+
+    // The running request gets one more try on a fresh worker
+    if (active_ != nullptr) {
+        auto request = std::move(active_);
+        if (request->cancelled) {
+            // Nothing to retry
+        } else if (++request->attempts >= MAX_ATTEMPTS) {
+            if (request->onComplete) {
+                request->onComplete(request->response);
+            }
+        } else {
+            queue_.push_front(std::move(*request));
+        }
+    }
+
+    if (!queue_.empty()) {
+        relaunchLater();
+    }
+}
+
+void LocalModelClient::relaunchLater() {
+    auto validFlag = validFlag_;
+
+    // Give the crashed process time to fully terminate
+    juce::Timer::callAfterDelay(RECOVERY_DELAY_MS, [this, validFlag]() {
+        if (!validFlag->load() || running_ || queue_.empty()) {
+            return;
+        }
+        if (!start()) {
+            failAll(lastError_);
+        }
+    });
+}
+
+// =============================================================================
+// PromptInterface
+// =============================================================================
+
+std::string LocalModelClient::sendPrompt(const std::string& prompt, const std::string& context) {
+    auto* messageManager = juce::MessageManager::getInstanceWithoutCreating();
+    if (messageManager == nullptr || messageManager->isThisTheMessageThread()) {
+        jassertfalse;  // Would wait on the thread that delivers the reply
+        return {};
+    }
+
+    // Filled on the message thread; shared so a late reply after a timeout is harmless
+    struct Reply {
+        juce::WaitableEvent done;
+        std::string response;
+    };
+    auto reply = std::make_shared<Reply>();
+    auto id = std::make_shared<std::atomic<RequestId>>(0);
+    auto validFlag = validFlag_;
+
+    juce::MessageManager::callAsync([this, validFlag, reply, id, prompt, context]() {
+        if (!validFlag->load()) {
+            reply->done.signal();
+            return;
+        }
+        const auto requestId = submit(prompt, context, nullptr, [reply](const auto& response) {
+            reply->response = response;
+            reply->done.signal();
+        });
+        id->store(requestId);
+    });
+
+    if (!reply->done.wait(SYNC_TIMEOUT_MS)) {
+        juce::MessageManager::callAsync([this, validFlag, id]() {
+            if (validFlag->load()) {
+                cancel(id->load());
+            }
+        });
+        return {};
+    }
+    return reply->response;
+}
+
+void LocalModelClient::sendPromptAsync(const std::string& prompt,
+                                       std::function<void(const std::string&)> callback,
+                                       const std::string& context) {
+    submit(prompt, context, nullptr, std::move(callback));
+}
+
+void LocalModelClient::sendPromptStreaming(const std::string& prompt,
+                                           std::function<void(const std::string&)> onChunk,
+                                           std::function<void(const std::string&)> onComplete,
+                                           const std::string& context) {
+    submit(prompt, context, std::move(onChunk), std::move(onComplete));
+}
+
+std::string LocalModelClient::generateMusicalSuggestion(const std::string& style,
+                                                        const std::string& current_progression) {
+    std::string prompt = "Suggest chords or a melody in the style of " + style + ".";
+    if (!current_progression.empty()) {
+        prompt += " Continue from: " + current_progression;
+    }
+    return sendPrompt(prompt);
+}
+
+std::string LocalModelClient::interpretCommand(const std::string& natural_language) {
+    return sendPrompt("Convert this request into DAW commands, one per line:\n" +
+                      natural_language);
+}
+
+std::string LocalModelClient::getHelp(const std::string& topic) {
+    return sendPrompt(topic.empty() ? "List the DAW commands you can run."
+                                    : "Explain the DAW commands for: " + topic);
+}
+
+void LocalModelClient::setContext(const std::string& context_info) {
+    context_ = context_info;
+}
+
+}  // namespace magda
@@ -0,0 +1,193 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <juce_events/juce_events.h>
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "../interfaces/prompt_interface.hpp"
+#include "GenerationTaggedWorker.hpp"
+
+namespace magda {
+
+/**
+ * @brief IPC message types between the local model client and its worker
+ */
+namespace LocalModelIPC {
+constexpr const char* WORKER_ID = "magda-model-worker";
+constexpr const char* MSG_LOAD = "LOAD";    // Model, generator, threads, core mask
+constexpr const char* MSG_READY = "REDY";   // Model mapped and warm
+constexpr const char* MSG_PROMPT = "PRMT";  // Request id, prompt, max tokens, temperature
+constexpr const char* MSG_CHUNK = "CHNK";   // Request id, text
+constexpr const char* MSG_DONE = "DONE";    // Request id, cancelled
+constexpr const char* MSG_CANCEL = "CNCL";  // Request id
+constexpr const char* MSG_ERROR = "ERR";    // Request id (0 for the model itself), message
+constexpr const char* MSG_QUIT = "QUIT";
+}  // namespace LocalModelIPC
+
+/**
+ * @brief PromptInterface backed by a local model running in a persistent worker process
+ *
+ * Inference never runs in the DAW process. start() launches one magda_model_worker
+ * (through JUCE's ChildProcessCoordinator, like the plugin scanners), which memory-maps the
+ * model, touches every page so it is resident, and keeps the mapping for its lifetime, so
+ * each request starts from a warm page cache instead of reloading gigabytes from disk.
+ * The worker lowers its own priority and generates on the cores rendering doesn't use
+ * (RenderThreadSettings::backgroundCoreMask), so it never competes with the audio threads.
+ *
+ * Requests are queued here and sent one at a time; text streams back as the model writes
+ * it. A queued request can be cancelled before it starts, and a running one is stopped in
+ * the worker; either way its callbacks aren't called. If the worker dies it is relaunched
+ * and the request it was running is retried once.
+ *
+ * Generation is done by a llama.cpp command-line generator that the worker runs against
+ * the mapped model under its priority and affinity; see docs/local_llm_poc_summary.md.
+ *
+ * Message thread only, apart from sendPrompt(), which blocks its caller and so must not be
+ * called on the message thread.
+ */
+class LocalModelClient : public PromptInterface {
+  public:
+    struct Settings {
+        juce::File model;                      // .gguf
+        juce::String generator = "llama-cli";  // Path, or a name found on PATH
+        int maxTokens = 256;
+        double temperature = 0.2;
+        int numThreads = 0;  // 0 = one per background core
+    };
+
+    using RequestId = juce::int64;
+
+    explicit LocalModelClient(const Settings& settings);
+    ~LocalModelClient() override;
+
+    /**
+     * @brief The magda_model_worker to launch (default: beside the running executable)
+     */
+    void setWorkerExecutable(const juce::File& executable) {
+        workerExecutable_ = executable;
+    }
+
+    /**
+     * @brief Launch the worker and load the model, ahead of the first request
+     * @return false if the worker couldn't be launched
+     */
+    bool start();
+
+    /**
+     * @brief Stop the worker; queued and running requests are dropped without callbacks
+     */
+    void stop();
+
+    /**
+     * @brief The model is loaded and warm
+     */
+    bool isReady() const {
+        return ready_;
+    }
+
+    /**
+     * @brief Why the model last failed to load or generate
+     */
+    const juce::String& getLastError() const {
+        return lastError_;
+    }
+
+    /**
+     * @brief Queue a prompt, starting the worker if it isn't running
+     * @return The request's id, or 0 if the worker couldn't start (onComplete has been
+     *         called with nothing)
+     * @param onChunk Called with each new piece of the response, in order
+     * @param onComplete Called once with the full response (what there is, on an error)
+     */
+    RequestId submit(const std::string& prompt, const std::string& context,
+                     std::function<void(const std::string&)> onChunk,
+                     std::function<void(const std::string&)> onComplete);
+
+    /**
+     * @brief Drop a queued request or stop a running one; its callbacks aren't called
+     * @return false if the request has already finished
+     */
+    bool cancel(RequestId id);
+
+    /**
+     * @brief Requests waiting behind the running one
+     */
+    size_t getNumQueued() const {
+        return queue_.size();
+    }
+
+    /**
+     * @brief The text sent to the model: the DAW context, if any, then the prompt
+     */
+    static std::string composePrompt(const std::string& prompt, const std::string& context);
+
+    // PromptInterface
+    std::string sendPrompt(const std::string& prompt, const std::string& context = "") override;
+    void sendPromptAsync(const std::string& prompt,
+                         std::function<void(const std::string&)> callback,
+                         const std::string& context = "") override;
+    void sendPromptStreaming(const std::string& prompt,
+                             std::function<void(const std::string&)> onChunk,
+                             std::function<void(const std::string&)> onComplete,
+                             const std::string& context = "") override;
+    std::string generateMusicalSuggestion(const std::string& style,
+                                          const std::string& current_progression = "") override;
+    std::string interpretCommand(const std::string& natural_language) override;
+    std::string getHelp(const std::string& topic = "") override;
+    void setContext(const std::string& context_info) override;
+
+    static constexpr int SYNC_TIMEOUT_MS = 120000;  // sendPrompt() gives up after this
+
+  private:
+    struct Request {
+        RequestId id = 0;
+        std::string prompt;
+        std::function<void(const std::string&)> onChunk;
+        std::function<void(const std::string&)> onComplete;
+        std::string response;
+        int attempts = 0;
+        bool cancelled = false;
+    };
+
+    // The magda_model_worker child process
+    using Worker = GenerationTaggedWorker<LocalModelClient>;
+    friend Worker;
+
+    // Worker events (message thread)
+    void handleWorkerMessage(int workerIndex, int generation, const juce::MemoryBlock& message);
+    void handleWorkerLost(int workerIndex, int generation);
+
+    void dispatchNext();
+    void finishActive();
+    void failAll(const juce::String& error);
+    void relaunchLater();
+    std::string contextFor(const std::string& context) const;
+
+    Settings settings_;
+    juce::File workerExecutable_;
+    std::unique_ptr<Worker> worker_;
+    int nextGeneration_ = 0;
+    bool running_ = false;  // Launched; cleared when it stops or is lost
+    bool ready_ = false;
+    juce::String lastError_;
+
+    std::deque<Request> queue_;
+    std::unique_ptr<Request> active_;
+    RequestId nextRequestId_ = 1;
+    std::string context_;  // setContext(), used when a request brings none
+
+    static constexpr int MAX_ATTEMPTS = 2;  // Per request
+    static constexpr int RECOVERY_DELAY_MS = 1000;
+
+    // Validity flag for async callbacks - set to false in destructor
+    std::shared_ptr<std::atomic<bool>> validFlag_ = std::make_shared<std::atomic<bool>>(true);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LocalModelClient)
+};
+
+}  // namespace magda
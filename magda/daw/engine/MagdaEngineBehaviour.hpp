@@ -0,0 +1,36 @@
+#pragma once
+
+#include <tracktion_engine/tracktion_engine.h>
+
+#include <atomic>
+
+#include "../audio/RenderThreadPolicy.hpp"
+
+namespace magda {
+
+/**
+ * @brief Engine-wide settings MAGDA changes at runtime
+ *
+ * Tracktion asks its EngineBehaviour how many threads to render with when it builds the
+ * playback graph, so a new count takes effect the next time the graph is reallocated.
+ * RenderThreadPolicy handles where those threads run.
+ */
+class MagdaEngineBehaviour : public tracktion::EngineBehaviour {
+  public:
+    MagdaEngineBehaviour() = default;
+    ~MagdaEngineBehaviour() override = default;
+
+    int getNumberOfCPUsToUseForAudio() override {
+        return numAudioThreads_.load(std::memory_order_relaxed);
+    }
+
+    void setNumberOfCPUsToUseForAudio(int numThreads) {
+        numAudioThreads_.store(juce::jmax(1, numThreads), std::memory_order_relaxed);
+    }
+
+  private:
+    std::atomic<int> numAudioThreads_{
+        RenderThreadSettings().resolveNumThreads(juce::SystemStats::getNumCpus())};
+};
+
+}  // namespace magda
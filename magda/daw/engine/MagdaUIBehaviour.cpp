@@ -15,7 +15,7 @@ std::unique_ptr<juce::Component> MagdaUIBehaviour::createPluginWindow(
     DBG("MagdaUIBehaviour::createPluginWindow - creating window for: " << plugin.getName());
 
     // Create the window
-    auto window = std::make_unique<PluginEditorWindow>(plugin, state);
+    auto window = std::make_unique<PluginEditorWindow>(plugin, state, *this);
 
     // Window might fail to create if plugin has no editor
     if (window->getContentComponent() == nullptr) {
@@ -32,13 +32,15 @@ std::unique_ptr<juce::Component> MagdaUIBehaviour::createPluginWindow(
 // =============================================================================
 
 PluginEditorWindow::PluginEditorWindow(tracktion::Plugin& plugin,
-                                       tracktion::PluginWindowState& state)
+                                       tracktion::PluginWindowState& state,
+                                       MagdaUIBehaviour& behaviour)
     : DocumentWindow(plugin.getName(),
                      juce::LookAndFeel::getDefaultLookAndFeel().findColour(
                          juce::ResizableWindow::backgroundColourId),
                      DocumentWindow::minimiseButton | DocumentWindow::closeButton),
       plugin_(plugin),
-      state_(state) {
+      state_(state),
+      behaviour_(behaviour) {
     // IMPORTANT: Do NOT use native title bar!
     // With native title bar, macOS controls the close button behavior and may
     // try to close the window after closeButtonPressed() returns, conflicting
@@ -103,6 +105,7 @@ PluginEditorWindow::PluginEditorWindow(tracktion::Plugin& plugin,
 }
 
 PluginEditorWindow::~PluginEditorWindow() {
+    notifyStateChanged(false);
     clearContentComponent();
 }
 
@@ -123,7 +126,31 @@ void PluginEditorWindow::closeButtonPressed() {
 }
 
 void PluginEditorWindow::moved() {
-    // Save window position for next time
+    saveBounds();
+}
+
+void PluginEditorWindow::resized() {
+    DocumentWindow::resized();
+    saveBounds();
+}
+
+void PluginEditorWindow::visibilityChanged() {
+    DocumentWindow::visibilityChanged();
+    notifyStateChanged(isVisible());
+}
+
+void PluginEditorWindow::notifyStateChanged(bool isShowing) {
+    if (isShowing == notifiedShowing_) {
+        return;
+    }
+    notifiedShowing_ = isShowing;
+    if (behaviour_.onWindowStateChanged) {
+        behaviour_.onWindowStateChanged(plugin_, isShowing);
+    }
+}
+
+void PluginEditorWindow::saveBounds() {
+    // Save window position and size for next time
     if (state_.lastWindowBounds.has_value()) {
         state_.lastWindowBounds = getBounds();
     }
@@ -2,6 +2,8 @@
 
 #include <tracktion_engine/tracktion_engine.h>
 
+#include <functional>
+
 namespace tracktion {
 inline namespace engine {
 class Plugin;
@@ -29,6 +31,15 @@ class MagdaUIBehaviour : public tracktion::UIBehaviour {
      */
     std::unique_ptr<juce::Component> createPluginWindow(
         tracktion::PluginWindowState& state) override;
+
+    /**
+     * @brief Called on the message thread as a plugin window is shown, hidden or deleted
+     *
+     * Fires from inside the window's own calls, including its constructor, before
+     * Tracktion has taken ownership of it - so use isShowing rather than asking the
+     * plugin's window state.
+     */
+    std::function<void(tracktion::Plugin& plugin, bool isShowing)> onWindowStateChanged;
 };
 
 /**
@@ -40,15 +51,23 @@ class MagdaUIBehaviour : public tracktion::UIBehaviour {
  */
 class PluginEditorWindow final : public juce::DocumentWindow {
   public:
-    PluginEditorWindow(tracktion::Plugin& plugin, tracktion::PluginWindowState& state);
+    PluginEditorWindow(tracktion::Plugin& plugin, tracktion::PluginWindowState& state,
+                       MagdaUIBehaviour& behaviour);
     ~PluginEditorWindow() override;
 
     void closeButtonPressed() override;
     void moved() override;
+    void resized() override;
+    void visibilityChanged() override;
 
   private:
+    void notifyStateChanged(bool isShowing);
+    void saveBounds();
+
     tracktion::Plugin& plugin_;
     tracktion::PluginWindowState& state_;
+    MagdaUIBehaviour& behaviour_;
+    bool notifiedShowing_ = false;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PluginEditorWindow)
 };
@@ -0,0 +1,530 @@
+#include "OfflineRenderer.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+#include "../audio/AudioBridge.hpp"
+#include "../audio/Decimator.hpp"
+#include "../core/TrackManager.hpp"
+#include "MagdaEngineBehaviour.hpp"
+
+namespace magda {
+
+namespace {
+
+// An oversampled render brought down by factor into dest, at the requested bit depth
+bool decimateRender(const juce::File& source, const juce::File& dest, int factor, int bitDepth,
+                    const std::atomic<bool>& cancelled) {
+    juce::WavAudioFormat wav;
+    std::unique_ptr<juce::AudioFormatReader> reader(
+        wav.createReaderFor(source.createInputStream().release(), true));
+    if (reader == nullptr || reader->numChannels == 0) {
+        return false;
+    }
+    const int numChannels = static_cast<int>(reader->numChannels);
+
+    auto stream = dest.createOutputStream();
+    if (stream == nullptr) {
+        return false;
+    }
+    std::unique_ptr<juce::AudioFormatWriter> writer(
+        wav.createWriterFor(stream.get(), reader->sampleRate / factor,
+                            static_cast<unsigned int>(numChannels), bitDepth, {}, 0));
+    if (writer == nullptr) {
+        return false;
+    }
+    stream.release();  // Owned by the writer now
+
+    std::vector<Decimator> decimators(static_cast<size_t>(numChannels), Decimator(factor));
+    constexpr int kBlockSize = 4096;
+    juce::AudioBuffer<float> input(numChannels, kBlockSize);
+    juce::AudioBuffer<float> output(numChannels, kBlockSize / factor + 1);
+
+    // The filter's delay is dropped from the start and flushed out with silence at the end,
+    // so the file lines up with (and is as long as) a render at the requested rate
+    const int latency = decimators.front().getLatency();
+    int toSkip = latency;
+    const auto length = reader->lengthInSamples;
+    const auto total = length + static_cast<juce::int64>(latency) * factor;
+    for (juce::int64 position = 0; position < total; position += kBlockSize) {
+        if (cancelled) {
+            return false;
+        }
+        const int numInput = static_cast<int>(std::min<juce::int64>(kBlockSize, total - position));
+        input.clear();
+        if (position < length) {
+            const auto numRead = std::min<juce::int64>(numInput, length - position);
+            reader->read(&input, 0, static_cast<int>(numRead), position, true, true);
+        }
+
+        int numOutput = 0;
+        for (int channel = 0; channel < numChannels; ++channel) {
+            numOutput = decimators[static_cast<size_t>(channel)].process(
+                input.getReadPointer(channel), numInput, output.getWritePointer(channel));
+        }
+        const int skipped = std::min(toSkip, numOutput);
+        toSkip -= skipped;
+        if (numOutput > skipped &&
+            !writer->writeFromAudioSampleBuffer(output, skipped, numOutput - skipped)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+// =============================================================================
+// Job
+// =============================================================================
+
+/**
+ * One queued render: its outputs (one Renderer::Parameters per file, built on the message
+ * thread) and a thread that runs them in turn. Tracktion's RenderTask does the work;
+ * calling runJob() on it directly renders as fast as the graph can be processed.
+ */
+class OfflineRenderer::Job : private juce::Thread {
+  public:
+    Job(std::string id, std::vector<Output> outputs, FinishedCallback onFinished)
+        : juce::Thread("Offline Render"),
+          id_(std::move(id)),
+          outputs_(std::move(outputs)),
+          onFinished_(std::move(onFinished)) {}
+
+    ~Job() override {
+        cancel();
+        waitForThreadToExit(-1);
+    }
+
+    const std::string& getId() const {
+        return id_;
+    }
+
+    const FinishedCallback& getFinishedCallback() const {
+        return onFinished_;
+    }
+
+    void start(std::function<void()> onDone) {
+        onDone_ = std::move(onDone);
+        status_ = RenderStatus::Rendering;
+        startThread();
+    }
+
+    void fail(const juce::String& error) {
+        const juce::ScopedLock lock(lock_);
+        error_ = error;
+        status_ = RenderStatus::Failed;
+    }
+
+    void cancel() {
+        cancelled_ = true;
+        if (status_ == RenderStatus::Queued) {
+            status_ = RenderStatus::Cancelled;
+        }
+
+        const juce::ScopedLock lock(lock_);
+        if (currentTask_ != nullptr) {
+            currentTask_->signalJobShouldExit();
+        }
+    }
+
+    RenderStatus getStatus() const {
+        return status_;
+    }
+
+    double getProgress() const {
+        if (status_ == RenderStatus::Finished) {
+            return 1.0;
+        }
+        if (outputs_.empty()) {
+            return 0.0;
+        }
+        return (outputsDone_.load() + double(taskProgress_.load())) / double(outputs_.size());
+    }
+
+    std::vector<std::string> getRenderedFiles() const {
+        const juce::ScopedLock lock(lock_);
+        return files_;
+    }
+
+    std::string getError() const {
+        const juce::ScopedLock lock(lock_);
+        return error_.toStdString();
+    }
+
+  private:
+    void run() override {
+        bool ok = true;
+        for (auto& output : outputs_) {
+            if (cancelled_) {
+                break;
+            }
+
+            auto& params = output.params;
+            output.destFile.getParentDirectory().createDirectory();
+            output.destFile.deleteFile();
+            params.destFile.deleteFile();  // The temporary file when oversampled
+            taskProgress_ = 0.0f;
+
+            auto task = std::make_unique<te::Renderer::RenderTask>("Offline Render", params,
+                                                                   &taskProgress_, nullptr);
+            {
+                const juce::ScopedLock lock(lock_);
+                currentTask_ = task.get();
+            }
+            if (cancelled_) {
+                task->signalJobShouldExit();  // Cancelled before the task was published
+            }
+
+            while (task->runJob() == juce::ThreadPoolJob::jobNeedsRunningAgain) {
+            }
+
+            {
+                const juce::ScopedLock lock(lock_);
+                currentTask_ = nullptr;
+            }
+            task.reset();  // Flushes and closes the writer
+
+            if (cancelled_) {
+                params.destFile.deleteFile();  // Partial
+                break;
+            }
+            if (!params.destFile.existsAsFile()) {
+                const juce::ScopedLock lock(lock_);
+                error_ = "Couldn't render " + output.destFile.getFullPathName();
+                ok = false;
+                break;
+            }
+
+            if (output.oversampling > 1) {
+                const bool decimated =
+                    decimateRender(params.destFile, output.destFile, output.oversampling,
+                                   output.bitDepth, cancelled_);
+                params.destFile.deleteFile();
+                if (cancelled_) {
+                    output.destFile.deleteFile();
+                    break;
+                }
+                if (!decimated) {
+                    output.destFile.deleteFile();
+                    const juce::ScopedLock lock(lock_);
+                    error_ = "Couldn't resample " + output.destFile.getFullPathName();
+                    ok = false;
+                    break;
+                }
+            }
+
+            {
+                const juce::ScopedLock lock(lock_);
+                files_.push_back(output.destFile.getFullPathName().toStdString());
+            }
+            ++outputsDone_;
+            taskProgress_ = 0.0f;
+        }
+
+        status_ = cancelled_ ? RenderStatus::Cancelled
+                             : (ok ? RenderStatus::Finished : RenderStatus::Failed);
+        juce::MessageManager::callAsync(onDone_);
+    }
+
+    const std::string id_;
+    std::vector<Output> outputs_;
+    FinishedCallback onFinished_;
+    std::function<void()> onDone_;
+
+    std::atomic<RenderStatus> status_{RenderStatus::Queued};
+    std::atomic<bool> cancelled_{false};
+    std::atomic<float> taskProgress_{0.0f};
+    std::atomic<int> outputsDone_{0};
+
+    juce::CriticalSection lock_;  // Guards the fields below
+    te::Renderer::RenderTask* currentTask_ = nullptr;
+    std::vector<std::string> files_;
+    juce::String error_;
+};
+
+// =============================================================================
+// OfflineRenderer
+// =============================================================================
+
+OfflineRenderer::OfflineRenderer(te::Edit& edit, AudioBridge* bridge,
+                                 MagdaEngineBehaviour* behaviour)
+    : edit_(edit), bridge_(bridge), behaviour_(behaviour) {}
+
+OfflineRenderer::~OfflineRenderer() {
+    *alive_ = false;
+    cancelAll();
+    jobs_.clear();  // Joins the running job's thread
+
+    if (behaviour_ != nullptr && running_ != nullptr) {
+        behaviour_->setNumberOfCPUsToUseForAudio(liveThreadCount_);
+    }
+    if (bridge_ != nullptr && renderStatus_ != nullptr) {
+        bridge_->setRenderQuality(liveQuality_);
+        bridge_->setChainSuspensionPaused(false);
+    }
+    running_ = nullptr;
+    renderStatus_.reset();
+}
+
+std::string OfflineRenderer::startRender(const RenderRequest& request,
+                                         FinishedCallback onFinished) {
+    const auto id = "render_" + std::to_string(nextJobId_++);
+
+    juce::String error;
+    auto outputs = buildOutputs(request, error);
+    auto job = std::make_unique<Job>(id, std::move(outputs), std::move(onFinished));
+    auto* jobPtr = job.get();
+    jobs_[id] = std::move(job);
+
+    if (error.isNotEmpty()) {
+        jobPtr->fail(error);
+        return id;
+    }
+
+    queue_.push_back(jobPtr);
+    startNextJob();
+    return id;
+}
+
+OfflineRenderer::RenderStatus OfflineRenderer::getStatus(const std::string& jobId) const {
+    const auto* job = findJob(jobId);
+    return job ? job->getStatus() : RenderStatus::Unknown;
+}
+
+double OfflineRenderer::getProgress(const std::string& jobId) const {
+    const auto* job = findJob(jobId);
+    return job ? job->getProgress() : 0.0;
+}
+
+void OfflineRenderer::cancel(const std::string& jobId) {
+    if (auto* job = findJob(jobId)) {
+        job->cancel();
+        queue_.erase(std::remove(queue_.begin(), queue_.end(), job), queue_.end());
+    }
+}
+
+void OfflineRenderer::cancelAll() {
+    queue_.clear();
+    for (auto& [id, job] : jobs_) {
+        job->cancel();
+    }
+}
+
+std::vector<std::string> OfflineRenderer::getRenderedFiles(const std::string& jobId) const {
+    const auto* job = findJob(jobId);
+    return job ? job->getRenderedFiles() : std::vector<std::string>();
+}
+
+std::string OfflineRenderer::getError(const std::string& jobId) const {
+    const auto* job = findJob(jobId);
+    return job ? job->getError() : std::string();
+}
+
+juce::String OfflineRenderer::makeStemFileName(int index, const juce::String& trackName) {
+    auto name = juce::File::createLegalFileName(trackName.trim());
+    if (name.isEmpty()) {
+        name = "Track";
+    }
+    return juce::String(index).paddedLeft('0', 2) + " " + name + ".wav";
+}
+
+OfflineRenderer::Job* OfflineRenderer::findJob(const std::string& jobId) const {
+    const auto it = jobs_.find(jobId);
+    return it != jobs_.end() ? it->second.get() : nullptr;
+}
+
+// =============================================================================
+// Outputs
+// =============================================================================
+
+std::vector<OfflineRenderer::Output> OfflineRenderer::buildOutputs(const RenderRequest& request,
+                                                                   juce::String& error) const {
+    std::vector<Output> outputs;
+
+    if (request.output_path.empty()) {
+        error = "No output path";
+        return outputs;
+    }
+
+    const double start = juce::jmax(0.0, request.start_seconds);
+    const double end =
+        request.end_seconds < 0.0 ? edit_.getLength().inSeconds() : request.end_seconds;
+    if (end <= start) {
+        error = "Empty render range";
+        return outputs;
+    }
+
+    // Tracks by MAGDA id; stems of "all tracks" mean every track the bridge has synced
+    struct RenderTrack {
+        TrackId id;
+        juce::String name;
+        te::AudioTrack* audioTrack;
+    };
+    std::vector<RenderTrack> tracks;
+    if (!request.track_ids.empty() || request.stems) {
+        std::vector<TrackId> ids;
+        if (request.track_ids.empty()) {
+            for (const auto& track : TrackManager::getInstance().getTracks()) {
+                ids.push_back(track.id);
+            }
+        }
+        for (const auto& trackId : request.track_ids) {
+            try {
+                ids.push_back(std::stoi(trackId));
+            } catch (const std::exception&) {
+                error = "Invalid track id '" + juce::String(trackId) + "'";
+                return outputs;
+            }
+        }
+
+        if (bridge_ == nullptr) {
+            error = "Tracks can't be resolved without the audio bridge";
+            return outputs;
+        }
+
+        for (auto id : ids) {
+            auto* audioTrack = bridge_->getAudioTrack(id);
+            if (audioTrack != nullptr) {
+                const auto* info = TrackManager::getInstance().getTrack(id);
+                tracks.push_back({id, info ? info->name : audioTrack->getName(), audioTrack});
+            } else if (!request.track_ids.empty()) {
+                error = "Track " + juce::String(id) + " isn't in the engine";
+                return outputs;
+            }
+        }
+        if (tracks.empty()) {
+            error = "No tracks to render";
+            return outputs;
+        }
+    }
+
+    // As far as the most demanding device on the file's tracks asks for
+    auto getOversampling = [](const std::vector<TrackId>& trackIds) {
+        int factor = 1;
+        for (auto trackId : trackIds) {
+            if (const auto* info = TrackManager::getInstance().getTrack(trackId)) {
+                factor = std::max(factor, getMaxOversampling(info->chainElements));
+            }
+        }
+        return factor;
+    };
+
+    auto makeOutput = [&](const juce::File& file, const juce::Array<te::Track*>& toRender,
+                          bool throughMaster, int oversampling) {
+        te::Renderer::Parameters params(edit_);
+        params.destFile = oversampling > 1 ? file.withFileExtension("oversampled.wav") : file;
+        params.audioFormat = edit_.engine.getAudioFileFormatManager().getWavFormat();
+        params.time = {te::TimePosition::fromSeconds(start), te::TimePosition::fromSeconds(end)};
+        params.tracksToDo = te::toBitSet(toRender);
+        params.usePlugins = true;
+        params.useMasterPlugins = throughMaster;
+        params.realTimeRender = false;
+        params.sampleRateForAudio = request.sample_rate * oversampling;
+        params.blockSizeForAudio = 512 * oversampling;
+        params.bitDepth = oversampling > 1 ? 32 : request.bit_depth;
+        params.shouldNormalise = request.normalise;
+        return Output{params, file, oversampling, request.bit_depth};
+    };
+
+    const juce::File outputPath(request.output_path);
+    if (request.stems) {
+        // Stems are the tracks on their own, without the master chain
+        int index = 1;
+        for (const auto& track : tracks) {
+            juce::Array<te::Track*> single;
+            single.add(track.audioTrack);
+            outputs.push_back(makeOutput(
+                outputPath.getChildFile(makeStemFileName(index++, track.name)), single, false,
+                getOversampling({track.id})));
+        }
+    } else {
+        juce::Array<te::Track*> toRender;
+        std::vector<TrackId> trackIds;
+        if (tracks.empty()) {
+            toRender = te::getAllTracks(edit_);
+            for (const auto& track : TrackManager::getInstance().getTracks()) {
+                trackIds.push_back(track.id);
+            }
+        } else {
+            for (const auto& track : tracks) {
+                toRender.add(track.audioTrack);
+                trackIds.push_back(track.id);
+            }
+        }
+        const auto file = outputPath.hasFileExtension("wav") ? outputPath
+                                                             : outputPath.withFileExtension("wav");
+        outputs.push_back(makeOutput(file, toRender, true, getOversampling(trackIds)));
+    }
+    return outputs;
+}
+
+// =============================================================================
+// Scheduling
+// =============================================================================
+
+void OfflineRenderer::startNextJob() {
+    if (running_ != nullptr || queue_.empty()) {
+        return;
+    }
+
+    running_ = queue_.front();
+    queue_.pop_front();
+
+    // The render reads the Edit, so it must see every pending model change and every
+    // device processing
+    if (bridge_ != nullptr) {
+        bridge_->flushPendingSync();
+        bridge_->setChainSuspensionPaused(true);
+    }
+
+    // Give the render the plugins and every CPU; the live graph comes back afterwards
+    if (renderStatus_ == nullptr) {
+        edit_.getTransport().stop(false, false);
+        renderStatus_ = std::make_unique<te::Edit::ScopedRenderStatus>(edit_, true);
+        if (behaviour_ != nullptr) {
+            liveThreadCount_ = behaviour_->getNumberOfCPUsToUseForAudio();
+            behaviour_->setNumberOfCPUsToUseForAudio(juce::SystemStats::getNumCpus());
+        }
+        if (bridge_ != nullptr) {
+            liveQuality_ = bridge_->getRenderQuality();
+            bridge_->setRenderQuality(RenderQuality::Final);
+        }
+    }
+
+    auto* job = running_;
+    running_->start([this, alive = alive_, job] {
+        if (*alive) {
+            jobFinished(*job);
+        }
+    });
+}
+
+void OfflineRenderer::jobFinished(Job& job) {
+    if (running_ != &job) {
+        return;
+    }
+    running_ = nullptr;
+
+    if (queue_.empty()) {
+        // Restore the live thread count before the graph is rebuilt for playback
+        if (behaviour_ != nullptr) {
+            behaviour_->setNumberOfCPUsToUseForAudio(liveThreadCount_);
+        }
+        if (bridge_ != nullptr) {
+            bridge_->setRenderQuality(liveQuality_);
+        }
+        renderStatus_.reset();
+        if (bridge_ != nullptr) {
+            bridge_->setChainSuspensionPaused(false);
+        }
+    }
+
+    // Copied: the callback may queue another render
+    if (const auto onFinished = job.getFinishedCallback()) {
+        onFinished(job.getId());
+    }
+    startNextJob();
+}
+
+}  // namespace magda
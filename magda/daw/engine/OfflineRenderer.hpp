@@ -0,0 +1,115 @@
+#pragma once
+
+#include <tracktion_engine/tracktion_engine.h>
+
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../core/ViewModeState.hpp"
+#include "../interfaces/render_interface.hpp"
+
+namespace magda {
+
+namespace te = tracktion;
+
+class AudioBridge;
+class MagdaEngineBehaviour;
+
+/**
+ * @brief Queue of offline bounce jobs for one Edit
+ *
+ * Each job renders a mix or per-track stems to WAV through Tracktion's Renderer on a
+ * background thread, which runs as fast as the CPU allows. While a job runs:
+ * - the transport is stopped and the playback graph released (Edit::ScopedRenderStatus),
+ *   so the render has the plugins to itself;
+ * - the engine renders on every CPU, and the live thread count is restored afterwards;
+ * - the bridge runs at Final quality, and the live quality is restored afterwards.
+ *
+ * A file whose tracks have a device asking for oversampling (DeviceInfo::oversampling) is
+ * rendered at the largest such multiple of the requested rate, to a temporary file next to
+ * it, and brought down to the requested rate through a Decimator.
+ *
+ * Jobs run one at a time, in the order they were queued. Message thread only, apart from
+ * the job threads themselves.
+ */
+class OfflineRenderer {
+  public:
+    using RenderRequest = RenderInterface::RenderRequest;
+    using RenderStatus = RenderInterface::RenderStatus;
+
+    /**
+     * @param bridge Flushed before each job so the render sees the latest model (optional)
+     * @param behaviour Thread count to raise while rendering (optional)
+     */
+    OfflineRenderer(te::Edit& edit, AudioBridge* bridge, MagdaEngineBehaviour* behaviour);
+
+    /**
+     * @brief Cancels every job and waits for the running one to stop
+     */
+    ~OfflineRenderer();
+
+    using FinishedCallback = std::function<void(const std::string& jobId)>;
+
+    /**
+     * @param onFinished Called on the message thread when the job ends after starting
+     *        (finished, cancelled or failed), once the playback graph is back. Not called
+     *        for a request rejected up front: check getStatus() for Failed.
+     */
+    std::string startRender(const RenderRequest& request, FinishedCallback onFinished = {});
+    RenderStatus getStatus(const std::string& jobId) const;
+    double getProgress(const std::string& jobId) const;
+    void cancel(const std::string& jobId);
+    void cancelAll();
+    std::vector<std::string> getRenderedFiles(const std::string& jobId) const;
+    std::string getError(const std::string& jobId) const;
+
+    /**
+     * @brief True while a job is rendering (the playback graph is released)
+     */
+    bool isRendering() const {
+        return running_ != nullptr;
+    }
+
+    /**
+     * @brief "03 Bass.wav": the track's 1-based position, then its name made file-safe
+     */
+    static juce::String makeStemFileName(int index, const juce::String& trackName);
+
+  private:
+    class Job;
+
+    // One file of a job; when oversampled, params renders to a temporary file
+    struct Output {
+        te::Renderer::Parameters params;
+        juce::File destFile;
+        int oversampling = 1;
+        int bitDepth = 24;
+    };
+
+    te::Edit& edit_;
+    AudioBridge* bridge_;
+    MagdaEngineBehaviour* behaviour_;
+
+    std::map<std::string, std::unique_ptr<Job>> jobs_;
+    std::deque<Job*> queue_;
+    Job* running_ = nullptr;
+    int nextJobId_ = 1;
+
+    // Held while a job runs
+    std::unique_ptr<te::Edit::ScopedRenderStatus> renderStatus_;
+    int liveThreadCount_ = 0;
+    RenderQuality liveQuality_ = RenderQuality::Draft;
+
+    std::shared_ptr<bool> alive_ = std::make_shared<bool>(true);  // For job callbacks
+
+    Job* findJob(const std::string& jobId) const;
+    std::vector<Output> buildOutputs(const RenderRequest& request, juce::String& error) const;
+    void startNextJob();
+    void jobFinished(Job& job);
+};
+
+}  // namespace magda
@@ -13,6 +13,10 @@ class TimelineController;
  * This class periodically polls the AudioEngine for the current
  * playback position and dispatches SetPlaybackPositionEvent to the
  * TimelineController, which then notifies all listeners.
+ *
+ * The arrangement playhead doesn't wait for these ticks: it extrapolates the
+ * engine's PlayheadClock every display frame. The polled position is for
+ * readouts and views that are fine at this rate.
  */
 class PlaybackPositionTimer : private juce::Timer {
   public:
@@ -1,9 +1,32 @@
 #include "PluginScanCoordinator.hpp"
 
+#include <algorithm>
 #include <iostream>
+#include <set>
 
 namespace magda {
 
+// =============================================================================
+// Worker
+// =============================================================================
+
+class PluginScanCoordinator::Worker : public GenerationTaggedWorker<PluginScanCoordinator> {
+  public:
+    using GenerationTaggedWorker::GenerationTaggedWorker;
+
+    // Message-thread state, owned by the coordinator
+    bool hasJob = false;
+    ScanJob job;
+    juce::int64 jobStartTime = 0;
+    int consecutiveFailures = 0;
+    bool recovering = false;
+    bool retired = false;
+};
+
+// =============================================================================
+// PluginScanCoordinator
+// =============================================================================
+
 PluginScanCoordinator::PluginScanCoordinator() {
     loadBlacklist();
 }
@@ -14,15 +37,13 @@ PluginScanCoordinator::~PluginScanCoordinator() {
 
     // Ensure we don't process any callbacks during destruction
     isScanning_ = false;
-    isRecovering_ = false;
     recoverySequence_++;
 
     // Stop timer first
     stopTimer();
 
-    // Give the worker process a moment to terminate gracefully
-    // Don't call killWorkerProcess() if we already finished - it may cause thread issues
-    // The ChildProcessCoordinator base class destructor will handle cleanup
+    // Worker destructors (ChildProcessCoordinator) terminate any remaining processes
+    workers_.clear();
 }
 
 juce::File PluginScanCoordinator::getScannerExecutable() const {
@@ -58,7 +79,7 @@ juce::File PluginScanCoordinator::getScannerExecutable() const {
     return {};
 }
 
-bool PluginScanCoordinator::launchScannerProcess() {
+bool PluginScanCoordinator::launchWorker(Worker& worker) {
     auto scannerExe = getScannerExecutable();
 
     if (!scannerExe.existsAsFile()) {
@@ -66,28 +87,30 @@ bool PluginScanCoordinator::launchScannerProcess() {
         return false;
     }
 
-    std::cout << "[ScanCoordinator] Launching scanner: " << scannerExe.getFullPathName()
-              << std::endl;
-
-    // Launch the scanner process
-    // The ChildProcessCoordinator::launchWorkerProcess takes:
-    // - File: the executable to launch
-    // - String: a unique ID for this type of worker
-    // - int: timeout in milliseconds (0 = no timeout)
-    // - int: pipe timeout in milliseconds
-    // Use 10 second timeout to avoid blocking the message thread indefinitely
-    if (!launchWorkerProcess(scannerExe, "magda-plugin-scanner", 10000, 5000)) {
-        std::cerr << "[ScanCoordinator] Failed to launch scanner process" << std::endl;
+    // 10 second ping timeout, so a hung scanner doesn't block the message thread indefinitely;
+    // its output isn't captured
+    if (!worker.launch(scannerExe, "magda-plugin-scanner", nextGeneration_++, 10000, 0)) {
+        std::cerr << "[ScanCoordinator] Failed to launch scanner process " << worker.getIndex()
+                  << std::endl;
         return false;
     }
 
-    std::cout << "[ScanCoordinator] Scanner process launched successfully" << std::endl;
+    std::cout << "[ScanCoordinator] Scanner process " << worker.getIndex()
+              << " launched: " << scannerExe.getFullPathName() << std::endl;
     return true;
 }
 
+int PluginScanCoordinator::chooseWorkerCount() const {
+    // Leave a core for the UI; scanning is mostly I/O and plugin init, not raw compute
+    int count = maxWorkers_ > 0 ? maxWorkers_ : juce::SystemStats::getNumCpus() - 1;
+    count = juce::jlimit(1, MAX_WORKERS, count);
+    return std::min(count, static_cast<int>(pendingJobs_.size()));
+}
+
 void PluginScanCoordinator::startScan(juce::AudioPluginFormatManager& formatManager,
                                       const ProgressCallback& progressCallback,
-                                      const CompletionCallback& completionCallback) {
+                                      const CompletionCallback& completionCallback,
+                                      const PluginScanState* previousState) {
     if (isScanning_) {
         std::cout << "[ScanCoordinator] Scan already in progress" << std::endl;
         return;
@@ -98,145 +121,164 @@ void PluginScanCoordinator::startScan(juce::AudioPluginFormatManager& formatMana
     completionCallback_ = completionCallback;
     foundPlugins_.clear();
     failedPlugins_.clear();
-    currentFormatIndex_ = 0;
-    formatsToScan_.clear();
-    isRecovering_ = false;
-    consecutiveFailures_ = 0;
+    pendingJobs_.clear();
+    workers_.clear();
+    scanState_.clear();
+    rescannedFiles_.clear();
+    removedFiles_.clear();
+    completedJobs_ = 0;
     recoverySequence_++;  // Invalidate any stale recovery callbacks
-    currentPluginBeingScanned_.clear();
 
-    // Collect formats to scan
+    // Enumerate the plugin files of every scannable format into one work queue. Only paths
+    // are listed here - nothing is loaded in this process.
+    juce::StringArray formatNames;
+    std::set<juce::String> presentFiles;
+    int skipped = 0;
+    int unchanged = 0;
     for (int i = 0; i < formatManager.getNumFormats(); ++i) {
         auto* format = formatManager.getFormat(i);
-        if (format) {
-            juce::String formatName = format->getName();
-            // Only scan VST3 and AudioUnit
-            if (formatName.containsIgnoreCase("VST3") ||
-                formatName.containsIgnoreCase("AudioUnit")) {
-                formatsToScan_.add(formatName);
+        if (!format) {
+            continue;
+        }
+
+        juce::String formatName = format->getName();
+        // Only scan VST3 and AudioUnit
+        if (!formatName.containsIgnoreCase("VST3") && !formatName.containsIgnoreCase("AudioUnit")) {
+            continue;
+        }
+
+        formatNames.add(formatName);
+        auto files = format->searchPathsForPlugins(format->getDefaultLocationsToSearch(), true);
+        for (const auto& file : files) {
+            presentFiles.insert(file);
+            const auto* previous = previousState ? previousState->find(file) : nullptr;
+
+            if (blacklistedPlugins_.contains(file)) {
+                // Not scanned, but still on disk - keep whatever the list had for it
+                if (previous) {
+                    scanState_.set(file, *previous);
+                }
+                skipped++;
+                continue;
+            }
+
+            auto stamp = PluginScanState::stampFor(formatName, file);
+            if (previous && *previous == stamp) {
+                scanState_.set(file, stamp);
+                unchanged++;
+                continue;
             }
+
+            pendingJobs_.push_back({formatName, file, stamp});
         }
     }
 
-    if (formatsToScan_.isEmpty()) {
-        std::cout << "[ScanCoordinator] No scannable formats found" << std::endl;
+    if (previousState) {
+        for (const auto& file : previousState->getFiles()) {
+            if (presentFiles.count(file) == 0) {
+                removedFiles_.add(file);
+            }
+        }
+    }
+
+    totalJobs_ = static_cast<int>(pendingJobs_.size());
+
+    if (pendingJobs_.empty()) {
+        std::cout << "[ScanCoordinator] No new or changed plugin files (" << unchanged
+                  << " unchanged, " << removedFiles_.size() << " removed)" << std::endl;
         if (completionCallback) {
             completionCallback(true, foundPlugins_, failedPlugins_);
         }
         return;
     }
 
-    std::cout << "[ScanCoordinator] Starting scan for formats: "
-              << formatsToScan_.joinIntoString(", ") << std::endl;
-
     isScanning_ = true;
 
-    // Launch the scanner process
-    if (!launchScannerProcess()) {
+    const int numWorkers = chooseWorkerCount();
+    std::cout << "[ScanCoordinator] Scanning " << totalJobs_ << " files ("
+              << formatNames.joinIntoString(", ") << ", " << unchanged << " unchanged, "
+              << skipped << " blacklisted) with " << numWorkers << " scanner processes"
+              << std::endl;
+
+    // Launch the pool and hand every worker its first file
+    for (int i = 0; i < numWorkers; ++i) {
+        workers_.push_back(std::make_unique<Worker>(*this, i));
+        auto& worker = *workers_.back();
+        if (launchWorker(worker)) {
+            dispatchNextJob(worker);
+        } else {
+            worker.retired = true;
+        }
+    }
+
+    if (std::all_of(workers_.begin(), workers_.end(),
+                    [](const auto& worker) { return worker->retired; })) {
         std::cerr << "[ScanCoordinator] Failed to launch scanner" << std::endl;
         finishScan(false);
         return;
     }
 
-    // Start scanning the first format
-    scanNextFormat();
-
     // Start timeout timer
-    lastProgressTime_ = juce::Time::currentTimeMillis();
     startTimer(1000);  // Check every second
 }
 
-void PluginScanCoordinator::scanNextFormat() {
-    if (currentFormatIndex_ >= formatsToScan_.size()) {
-        std::cout << "[ScanCoordinator] All formats scanned" << std::endl;
-        finishScan(true);
+void PluginScanCoordinator::dispatchNextJob(Worker& worker) {
+    if (!isScanning_ || worker.retired) {
         return;
     }
 
-    // Clear current plugin state (but NOT consecutiveFailures - that tracks across retries)
-    currentPluginBeingScanned_.clear();
-
-    juce::String formatName = formatsToScan_[currentFormatIndex_];
-    std::cout << "[ScanCoordinator] Scanning format: " << formatName << std::endl;
-
-    // Find the format
-    juce::AudioPluginFormat* format = nullptr;
-    for (int i = 0; i < formatManager_->getNumFormats(); ++i) {
-        if (formatManager_->getFormat(i)->getName() == formatName) {
-            format = formatManager_->getFormat(i);
-            break;
-        }
-    }
-
-    if (!format) {
-        std::cerr << "[ScanCoordinator] Format not found: " << formatName << std::endl;
-        currentFormatIndex_++;
-        scanNextFormat();
+    if (pendingJobs_.empty()) {
+        finishIfIdle();
         return;
     }
 
-    // Get search paths
-    auto searchPath = format->getDefaultLocationsToSearch();
-    juce::String searchPathStr;
-    for (int i = 0; i < searchPath.getNumPaths(); ++i) {
-        if (i > 0)
-            searchPathStr += ";";
-        searchPathStr += searchPath[i].getFullPathName();
-    }
-
-    // Send scan command to worker
-    sendScanCommand(formatName, searchPathStr, blacklistedPlugins_);
-}
-
-void PluginScanCoordinator::sendScanCommand(const juce::String& formatName,
-                                            const juce::String& searchPath,
-                                            const juce::StringArray& blacklist) {
-    // Clear current plugin state before sending new command
-    currentPluginBeingScanned_.clear();
+    worker.job = pendingJobs_.front();
+    pendingJobs_.pop_front();
+    worker.hasJob = true;
+    worker.jobStartTime = juce::Time::currentTimeMillis();
 
     juce::MemoryBlock msg;
     juce::MemoryOutputStream stream(msg, false);
+    stream.writeString(ScannerIPC::MSG_SCAN_FILE);
+    stream.writeString(worker.job.formatName);
+    stream.writeString(worker.job.fileOrIdentifier);
+    worker.send(msg);
+
+    reportProgress(worker.job.fileOrIdentifier);
+}
 
-    stream.writeString(ScannerIPC::MSG_SCAN_FORMAT);
-    stream.writeString(formatName);
-    stream.writeString(searchPath);
-    stream.writeInt(blacklist.size());
-    for (const auto& plugin : blacklist) {
-        stream.writeString(plugin);
+void PluginScanCoordinator::completeJob(Worker& worker) {
+    if (!worker.hasJob) {
+        return;
     }
 
-    std::cout << "[ScanCoordinator] Sending scan command for format: " << formatName << " with "
-              << blacklist.size() << " blacklisted plugins" << std::endl;
+    rescannedFiles_.add(worker.job.fileOrIdentifier);
+    worker.hasJob = false;
+    completedJobs_++;
+}
 
-    sendMessageToWorker(msg);
-    lastProgressTime_ = juce::Time::currentTimeMillis();
+void PluginScanCoordinator::reportProgress(const juce::String& currentPlugin) {
+    if (progressCallback_ && totalJobs_ > 0) {
+        progressCallback_(static_cast<float>(completedJobs_) / static_cast<float>(totalJobs_),
+                          currentPlugin);
+    }
 }
 
-void PluginScanCoordinator::handleMessageFromWorker(const juce::MemoryBlock& message) {
+void PluginScanCoordinator::handleWorkerMessage(int workerIndex, int generation,
+                                                const juce::MemoryBlock& message) {
+    if (!isScanning_ || workerIndex < 0 || workerIndex >= static_cast<int>(workers_.size())) {
+        return;
+    }
+
+    auto& worker = *workers_[static_cast<size_t>(workerIndex)];
+    if (worker.getGeneration() != generation) {
+        return;  // From a process that has since been killed or replaced
+    }
+
     juce::MemoryInputStream stream(message, false);
     juce::String msgType = stream.readString();
 
-    if (msgType == ScannerIPC::MSG_PROGRESS) {
-        float progress = stream.readFloat();
-        lastProgressTime_ = juce::Time::currentTimeMillis();
-        consecutiveFailures_ = 0;  // Scanner is making progress
-
-        if (progressCallback_) {
-            // Calculate overall progress including format index
-            float overallProgress = (currentFormatIndex_ + progress) / formatsToScan_.size();
-            progressCallback_(overallProgress, currentPluginBeingScanned_);
-        }
-    } else if (msgType == ScannerIPC::MSG_CURRENT_FILE) {
-        currentPluginBeingScanned_ = stream.readString();
-        lastProgressTime_ = juce::Time::currentTimeMillis();
-        consecutiveFailures_ = 0;  // Scanner is making progress
-        std::cout << "[ScanCoordinator] Scanning: " << currentPluginBeingScanned_ << std::endl;
-
-        if (progressCallback_) {
-            float overallProgress = static_cast<float>(currentFormatIndex_) / formatsToScan_.size();
-            progressCallback_(overallProgress, currentPluginBeingScanned_);
-        }
-    } else if (msgType == ScannerIPC::MSG_PLUGIN_FOUND) {
+    if (msgType == ScannerIPC::MSG_PLUGIN_FOUND) {
         juce::PluginDescription desc;
         desc.name = stream.readString();
         desc.pluginFormatName = stream.readString();
@@ -248,7 +290,6 @@ void PluginScanCoordinator::handleMessageFromWorker(const juce::MemoryBlock& mes
         desc.category = stream.readString();
 
         foundPlugins_.add(desc);
-        consecutiveFailures_ = 0;  // Successfully found a plugin, reset failure count
         std::cout << "[ScanCoordinator] Found: " << desc.name << " (" << desc.pluginFormatName
                   << ")" << std::endl;
     } else if (msgType == ScannerIPC::MSG_ERROR) {
@@ -263,204 +304,166 @@ void PluginScanCoordinator::handleMessageFromWorker(const juce::MemoryBlock& mes
             std::cerr << "[ScanCoordinator] Error: " << error << std::endl;
         }
     } else if (msgType == ScannerIPC::MSG_SCAN_COMPLETE) {
-        std::cout << "[ScanCoordinator] Format scan complete" << std::endl;
-        currentFormatIndex_++;
-        scanNextFormat();
+        worker.consecutiveFailures = 0;  // Scanner is making progress
+        if (worker.hasJob) {
+            scanState_.set(worker.job.fileOrIdentifier, worker.job.stamp);
+        }
+        completeJob(worker);
+        dispatchNextJob(worker);
     }
 }
 
-void PluginScanCoordinator::handleConnectionLost() {
-    std::cout << "[ScanCoordinator] Connection to scanner lost" << std::endl;
-
-    if (!isScanning_) {
-        std::cout << "[ScanCoordinator] Not scanning, ignoring connection lost" << std::endl;
+void PluginScanCoordinator::handleWorkerLost(int workerIndex, int generation) {
+    if (!isScanning_ || workerIndex < 0 || workerIndex >= static_cast<int>(workers_.size())) {
         return;
     }
 
-    // Prevent multiple simultaneous recovery attempts
-    if (isRecovering_) {
-        std::cout << "[ScanCoordinator] Already recovering, ignoring duplicate connection lost"
-                  << std::endl;
-        return;
+    auto& worker = *workers_[static_cast<size_t>(workerIndex)];
+    if (worker.getGeneration() != generation) {
+        return;  // Already handled (killed on timeout) or replaced
     }
 
-    isRecovering_ = true;
-
-    // Try to read the dead man's pedal file to identify the crashing plugin
-    // JUCE's PluginDirectoryScanner writes the current plugin path to this file
-    if (currentPluginBeingScanned_.isEmpty() && currentFormatIndex_ < formatsToScan_.size()) {
-        juce::String formatName = formatsToScan_[currentFormatIndex_];
-        juce::File deadMansPedal =
-            juce::File::getSpecialLocation(juce::File::tempDirectory)
-                .getChildFile("magda_scanner_current_" + formatName + ".txt");
-
-        if (deadMansPedal.existsAsFile()) {
-            // The file may be written in wide char format (UTF-16), try to read it
-            juce::String content = deadMansPedal.loadFileAsString();
-            if (content.isEmpty()) {
-                // Try reading as raw data and converting from UTF-16
-                juce::MemoryBlock data;
-                if (deadMansPedal.loadFileAsData(data) && data.getSize() > 0) {
-                    // Check for UTF-16 BOM or null bytes indicating wide chars
-                    const char* rawData = static_cast<const char*>(data.getData());
-                    bool isWideChar = false;
-                    for (size_t i = 1; i < data.getSize() && i < 20; i += 2) {
-                        if (rawData[i] == 0) {
-                            isWideChar = true;
-                            break;
-                        }
-                    }
-
-                    if (isWideChar) {
-                        // Convert from UTF-16LE
-                        content = juce::String(juce::CharPointer_UTF16(
-                            reinterpret_cast<const juce::CharPointer_UTF16::CharType*>(rawData)));
-                    }
-                }
-            }
-
-            content = content.trim();
-            if (content.isNotEmpty()) {
-                std::cout << "[ScanCoordinator] Dead man's pedal indicates crashing plugin: "
-                          << content << std::endl;
-                currentPluginBeingScanned_ = content;
-
-                // Clear the dead man's pedal file to prevent re-reading stale data
-                deadMansPedal.deleteFile();
-            }
-        }
-    }
+    std::cout << "[ScanCoordinator] Connection to scanner " << workerIndex << " lost"
+              << std::endl;
+    recoverWorker(worker, "Scanner crashed, restarting...");
+}
 
-    // The scanner crashed - blacklist the current plugin ONLY if we have a valid one
-    // (i.e., we were in the middle of scanning a specific plugin)
-    if (currentPluginBeingScanned_.isNotEmpty()) {
-        std::cout << "[ScanCoordinator] Blacklisting crashed plugin: " << currentPluginBeingScanned_
-                  << std::endl;
-        blacklistPlugin(currentPluginBeingScanned_);
-        failedPlugins_.add(currentPluginBeingScanned_);
-        currentPluginBeingScanned_.clear();
-        consecutiveFailures_ = 0;  // Reset if we actually found a crashing plugin
+void PluginScanCoordinator::recoverWorker(Worker& worker, const juce::String& reason) {
+    worker.kill();
+
+    // The process died (or hung) on a specific file: blacklist it and let the worker go on
+    if (worker.hasJob) {
+        const auto& plugin = worker.job.fileOrIdentifier;
+        std::cout << "[ScanCoordinator] Blacklisting crashed plugin: " << plugin << std::endl;
+        blacklistPlugin(plugin);
+        failedPlugins_.add(plugin);
+        completeJob(worker);
+        worker.consecutiveFailures = 0;  // Reset if we actually found a crashing plugin
     } else {
-        // No plugin was being scanned - the scanner crashed during initialization
-        // or between plugins. Increment failure counter.
-        consecutiveFailures_++;
-        std::cout << "[ScanCoordinator] Scanner crashed without identifying plugin (failure "
-                  << consecutiveFailures_ << "/" << MAX_CONSECUTIVE_FAILURES << ")" << std::endl;
-    }
-
-    // Check if we've had too many consecutive failures without identifying a plugin
-    if (consecutiveFailures_ >= MAX_CONSECUTIVE_FAILURES) {
-        std::cout << "[ScanCoordinator] Too many consecutive failures, moving to next format"
+        // No file was in flight - the scanner crashed during initialization
+        worker.consecutiveFailures++;
+        std::cout << "[ScanCoordinator] Scanner " << worker.getIndex()
+                  << " crashed without identifying plugin (failure "
+                  << worker.consecutiveFailures << "/" << MAX_CONSECUTIVE_FAILURES << ")"
                   << std::endl;
-        consecutiveFailures_ = 0;
-        currentFormatIndex_++;
+    }
 
-        if (currentFormatIndex_ >= formatsToScan_.size()) {
-            std::cout << "[ScanCoordinator] No more formats to scan, finishing" << std::endl;
-            isRecovering_ = false;
-            finishScan(foundPlugins_.size() > 0);
-            return;
-        }
+    if (worker.consecutiveFailures >= MAX_CONSECUTIVE_FAILURES) {
+        std::cout << "[ScanCoordinator] Too many consecutive failures, retiring scanner "
+                  << worker.getIndex() << std::endl;
+        worker.retired = true;
+        finishIfIdle();
+        return;
     }
 
-    // Report the crash to the progress callback
-    if (progressCallback_) {
-        progressCallback_(static_cast<float>(currentFormatIndex_) / formatsToScan_.size(),
-                          "Scanner crashed, restarting...");
+    if (pendingJobs_.empty()) {
+        finishIfIdle();
+        return;
     }
 
+    reportProgress(reason);
+
     // Capture current sequence to detect if scan was aborted/restarted during delay
     int currentSequence = recoverySequence_;
 
     // Capture validity flag to safely check if object still exists
     auto validFlag = validFlag_;
+    const int index = worker.getIndex();
+    worker.recovering = true;
 
     // Use a delayed callback to give the crashed process time to fully terminate
-    juce::Timer::callAfterDelay(RECOVERY_DELAY_MS, [this, currentSequence, validFlag]() {
+    juce::Timer::callAfterDelay(RECOVERY_DELAY_MS, [this, currentSequence, validFlag, index]() {
         // Check if this object was destroyed
         if (!validFlag->load()) {
             return;
         }
 
         // Check if this callback is stale (scan was aborted or restarted)
-        if (currentSequence != recoverySequence_) {
+        if (currentSequence != recoverySequence_ || !isScanning_) {
             std::cout << "[ScanCoordinator] Stale recovery callback ignored" << std::endl;
             return;
         }
 
-        isRecovering_ = false;
+        auto& recovering = *workers_[static_cast<size_t>(index)];
+        recovering.recovering = false;
 
-        if (!isScanning_) {
-            std::cout << "[ScanCoordinator] Scan was aborted, not relaunching" << std::endl;
-            return;
-        }
-
-        if (launchScannerProcess()) {
-            std::cout << "[ScanCoordinator] Relaunched scanner, continuing scan" << std::endl;
-            lastProgressTime_ = juce::Time::currentTimeMillis();
-            scanNextFormat();
-        } else {
-            std::cout << "[ScanCoordinator] Failed to relaunch scanner, trying next format"
+        if (launchWorker(recovering)) {
+            std::cout << "[ScanCoordinator] Relaunched scanner " << index << ", continuing scan"
                       << std::endl;
-            currentFormatIndex_++;
-            if (currentFormatIndex_ < formatsToScan_.size() && launchScannerProcess()) {
-                lastProgressTime_ = juce::Time::currentTimeMillis();
-                scanNextFormat();
-            } else {
-                std::cout << "[ScanCoordinator] Cannot continue, finishing scan" << std::endl;
-                finishScan(foundPlugins_.size() > 0);
-            }
+            dispatchNextJob(recovering);
+        } else {
+            recoverWorker(recovering, "Scanner failed to relaunch, retrying...");
         }
     });
 }
 
+void PluginScanCoordinator::finishIfIdle() {
+    if (!isScanning_) {
+        return;
+    }
+
+    bool anyActive = false;
+    bool anyAvailable = false;
+    for (const auto& worker : workers_) {
+        anyActive = anyActive || worker->hasJob || worker->recovering;
+        anyAvailable = anyAvailable || !worker->retired;
+    }
+
+    if (anyActive) {
+        return;
+    }
+
+    if (pendingJobs_.empty()) {
+        std::cout << "[ScanCoordinator] All files scanned" << std::endl;
+        finishScan(true);
+    } else if (!anyAvailable) {
+        std::cout << "[ScanCoordinator] No scanners left, finishing with " << pendingJobs_.size()
+                  << " files unscanned" << std::endl;
+        finishScan(foundPlugins_.size() > 0);
+    }
+}
+
 void PluginScanCoordinator::timerCallback() {
     if (!isScanning_) {
         stopTimer();
         return;
     }
 
-    // Check for timeout
-    juce::int64 elapsed = juce::Time::currentTimeMillis() - lastProgressTime_;
-    if (elapsed > PLUGIN_TIMEOUT_MS) {
-        std::cout << "[ScanCoordinator] Plugin scan timeout on: " << currentPluginBeingScanned_
-                  << std::endl;
+    // Check each worker's file for a timeout (the others keep going)
+    const auto now = juce::Time::currentTimeMillis();
+    for (auto& worker : workers_) {
+        if (worker->hasJob && now - worker->jobStartTime > PLUGIN_TIMEOUT_MS) {
+            std::cout << "[ScanCoordinator] Plugin scan timeout on: "
+                      << worker->job.fileOrIdentifier << std::endl;
+            recoverWorker(*worker, "Plugin scan timed out, restarting...");
 
-        // Blacklist the stuck plugin
-        if (currentPluginBeingScanned_.isNotEmpty()) {
-            blacklistPlugin(currentPluginBeingScanned_);
-            failedPlugins_.add(currentPluginBeingScanned_);
+            if (!isScanning_) {
+                return;
+            }
         }
-
-        // Kill the scanner - this will trigger handleConnectionLost which will restart
-        killWorkerProcess();
-        currentPluginBeingScanned_.clear();
-
-        // handleConnectionLost will be called and will handle the restart
     }
 }
 
 void PluginScanCoordinator::abortScan() {
-    // Set isScanning_ to false BEFORE killing the worker process
-    // to prevent handleConnectionLost from trying to recover
+    // Set isScanning_ to false BEFORE killing the workers
+    // to prevent connection-lost callbacks from trying to recover
     isScanning_ = false;
-    isRecovering_ = false;
     recoverySequence_++;  // Invalidate any pending recovery callbacks
 
     stopTimer();
-    killWorkerProcess();
+    for (auto& worker : workers_) {
+        worker->kill();
+    }
 
-    consecutiveFailures_ = 0;
-    currentPluginBeingScanned_.clear();
+    pendingJobs_.clear();
 }
 
 void PluginScanCoordinator::finishScan(bool success) {
     std::cout << "[ScanCoordinator] finishScan called, success=" << success << std::endl;
 
     // IMPORTANT: Set isScanning_ to false BEFORE any cleanup
-    // This ensures handleConnectionLost() will be ignored
+    // This ensures connection-lost callbacks will be ignored
     isScanning_ = false;
-    isRecovering_ = false;
 
     // Invalidate callbacks to prevent any pending ones from interfering
     recoverySequence_++;
@@ -468,16 +471,18 @@ void PluginScanCoordinator::finishScan(bool success) {
     // Stop timer
     stopTimer();
 
-    // Send QUIT message to scanner so it exits gracefully
+    // Send QUIT message to every live scanner so it exits gracefully
     // This is better than killWorkerProcess() which can cause thread cleanup issues
     juce::MemoryBlock quitMsg;
     juce::MemoryOutputStream quitStream(quitMsg, false);
     quitStream.writeString(ScannerIPC::MSG_QUIT);
-    sendMessageToWorker(quitMsg);
+    for (auto& worker : workers_) {
+        if (worker->getGeneration() >= 0) {
+            worker->send(quitMsg);
+        }
+    }
 
-    // Clear remaining state
-    consecutiveFailures_ = 0;
-    currentPluginBeingScanned_.clear();
+    pendingJobs_.clear();
 
     std::cout << "[ScanCoordinator] Scan finished. Found " << foundPlugins_.size() << " plugins, "
               << failedPlugins_.size() << " failed." << std::endl;
@@ -4,7 +4,13 @@
 #include <juce_core/juce_core.h>
 #include <juce_events/juce_events.h>
 
+#include <deque>
 #include <functional>
+#include <memory>
+#include <vector>
+
+#include "GenerationTaggedWorker.hpp"
+#include "PluginScanState.hpp"
 
 namespace magda {
 
@@ -12,23 +18,23 @@ namespace magda {
  * @brief IPC message types for plugin scanner communication
  */
 namespace ScannerIPC {
-constexpr const char* MSG_SCAN_FORMAT = "SCAN";
-constexpr const char* MSG_PROGRESS = "PROG";
-constexpr const char* MSG_PLUGIN_FOUND = "PLUG";
-constexpr const char* MSG_SCAN_COMPLETE = "DONE";
+constexpr const char* MSG_SCAN_FILE = "SCNF";      // Format name, plugin file or identifier
+constexpr const char* MSG_PLUGIN_FOUND = "PLUG";   // One description found in the file
+constexpr const char* MSG_SCAN_COMPLETE = "DONE";  // Current file finished
 constexpr const char* MSG_ERROR = "ERR";
-constexpr const char* MSG_CURRENT_FILE = "FILE";
 constexpr const char* MSG_QUIT = "QUIT";
 }  // namespace ScannerIPC
 
 /**
  * @brief Coordinates out-of-process plugin scanning
  *
- * Uses JUCE's ChildProcessCoordinator to launch the magda_plugin_scanner
- * executable and communicate with it via IPC. If the scanner crashes on
- * a problematic plugin, only the subprocess dies - the main app continues.
+ * Plugin files are enumerated up front into a shared work queue, and a pool of
+ * magda_plugin_scanner child processes (launched through JUCE's ChildProcessCoordinator)
+ * each pull one file at a time from it. If a scanner crashes or hangs on a problematic
+ * plugin, only that process dies: the file it was on is blacklisted, the worker is
+ * relaunched and the other workers carry on.
  */
-class PluginScanCoordinator : private juce::ChildProcessCoordinator, private juce::Timer {
+class PluginScanCoordinator : private juce::Timer {
   public:
     PluginScanCoordinator();
     ~PluginScanCoordinator() override;
@@ -55,10 +61,23 @@ class PluginScanCoordinator : private juce::ChildProcessCoordinator, private juc
      * @param formatManager The format manager with registered formats
      * @param progressCallback Called with progress updates (on message thread)
      * @param completionCallback Called when scan completes (on message thread)
+     * @param previousState Files covered by the existing plugin list; unchanged ones are
+     *                      skipped. nullptr scans everything.
+     *
+     * The completion callback only reports plugins from files that were actually scanned;
+     * see getRescannedFiles() and getRemovedFiles() for how to merge them into a list.
      */
     void startScan(juce::AudioPluginFormatManager& formatManager,
                    const ProgressCallback& progressCallback,
-                   const CompletionCallback& completionCallback);
+                   const CompletionCallback& completionCallback,
+                   const PluginScanState* previousState = nullptr);
+
+    /**
+     * @brief Limit the number of scanner processes (0 = choose from the CPU count)
+     */
+    void setMaxWorkers(int maxWorkers) {
+        maxWorkers_ = maxWorkers;
+    }
 
     /**
      * @brief Abort the current scan
@@ -79,6 +98,27 @@ class PluginScanCoordinator : private juce::ChildProcessCoordinator, private juc
         return foundPlugins_;
     }
 
+    /**
+     * @brief Files covered by the plugin list after the last scan (unchanged + rescanned)
+     */
+    const PluginScanState& getScanState() const {
+        return scanState_;
+    }
+
+    /**
+     * @brief Files re-probed by the last scan; their previous plugin entries are stale
+     */
+    const juce::StringArray& getRescannedFiles() const {
+        return rescannedFiles_;
+    }
+
+    /**
+     * @brief Files in the previous state that no longer exist
+     */
+    const juce::StringArray& getRemovedFiles() const {
+        return removedFiles_;
+    }
+
     /**
      * @brief Get list of plugins that failed during scanning
      */
@@ -95,19 +135,37 @@ class PluginScanCoordinator : private juce::ChildProcessCoordinator, private juc
     void blacklistPlugin(const juce::String& pluginPath);
 
   private:
-    // ChildProcessCoordinator overrides
-    void handleMessageFromWorker(const juce::MemoryBlock& message) override;
-    void handleConnectionLost() override;
+    /**
+     * @brief One plugin file waiting to be scanned
+     */
+    struct ScanJob {
+        juce::String formatName;
+        juce::String fileOrIdentifier;
+        PluginFileStamp stamp;
+    };
+
+    /**
+     * @brief One scanner child process and the job it is working on
+     */
+    class Worker;
+    friend class GenerationTaggedWorker<PluginScanCoordinator>;
+
+    // Worker events (message thread)
+    void handleWorkerMessage(int workerIndex, int generation, const juce::MemoryBlock& message);
+    void handleWorkerLost(int workerIndex, int generation);
 
     // Timer for timeout handling
     void timerCallback() override;
 
     // Internal scanning methods
-    bool launchScannerProcess();
-    void scanNextFormat();
-    void sendScanCommand(const juce::String& formatName, const juce::String& searchPath,
-                         const juce::StringArray& blacklist);
+    bool launchWorker(Worker& worker);
+    void dispatchNextJob(Worker& worker);
+    void completeJob(Worker& worker);
+    void recoverWorker(Worker& worker, const juce::String& reason);
+    void finishIfIdle();
+    void reportProgress(const juce::String& currentPlugin);
     void finishScan(bool success);
+    int chooseWorkerCount() const;
 
     // Find the scanner executable
     juce::File getScannerExecutable() const;
@@ -124,22 +182,28 @@ class PluginScanCoordinator : private juce::ChildProcessCoordinator, private juc
     CompletionCallback completionCallback_;
 
     // Scanning state
-    int currentFormatIndex_ = 0;
-    juce::String currentPluginBeingScanned_;
-    juce::StringArray formatsToScan_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::deque<ScanJob> pendingJobs_;
+    int totalJobs_ = 0;
+    int completedJobs_ = 0;
+    int maxWorkers_ = 0;
+    int nextGeneration_ = 0;
+    static constexpr int MAX_WORKERS = 8;
 
     // Results
     juce::Array<juce::PluginDescription> foundPlugins_;
     juce::StringArray failedPlugins_;
     juce::StringArray blacklistedPlugins_;
 
+    // Incremental scan state
+    PluginScanState scanState_;
+    juce::StringArray rescannedFiles_;
+    juce::StringArray removedFiles_;
+
     // Timeout tracking
     static constexpr int PLUGIN_TIMEOUT_MS = 30000;  // 30 seconds per plugin
-    juce::int64 lastProgressTime_ = 0;
 
-    // Recovery state to prevent multiple simultaneous recovery attempts
-    bool isRecovering_ = false;
-    int consecutiveFailures_ = 0;
+    // Recovery state (per worker: consecutive failures retire a worker)
     int recoverySequence_ = 0;  // Incremented each scan, used to invalidate stale callbacks
     static constexpr int MAX_CONSECUTIVE_FAILURES =
         3;  // Reduced - fail faster to avoid system strain
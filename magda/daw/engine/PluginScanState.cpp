@@ -0,0 +1,111 @@
+#include "PluginScanState.hpp"
+
+#include <algorithm>
+
+namespace magda {
+
+namespace {
+const juce::Identifier kStateTag("PLUGINFILES");
+const juce::Identifier kFileTag("FILE");
+const juce::Identifier kPathAttr("path");
+const juce::Identifier kFormatAttr("format");
+const juce::Identifier kModifiedAttr("modified");
+const juce::Identifier kSizeAttr("size");
+}  // namespace
+
+PluginFileStamp PluginScanState::stampFor(const juce::String& formatName,
+                                          const juce::String& fileOrIdentifier) {
+    PluginFileStamp stamp;
+    stamp.formatName = formatName;
+
+    if (!juce::File::isAbsolutePath(fileOrIdentifier)) {
+        return stamp;  // A component identifier, not a path
+    }
+
+    juce::File file(fileOrIdentifier);
+    if (!file.exists()) {
+        return stamp;
+    }
+
+    stamp.modificationTime = file.getLastModificationTime().toMilliseconds();
+
+    if (!file.isDirectory()) {
+        stamp.size = file.getSize();
+        return stamp;
+    }
+
+    // A bundle: an update can replace the binary without touching the bundle directory
+    for (const auto& entry :
+         juce::RangedDirectoryIterator(file, true, "*", juce::File::findFiles)) {
+        stamp.size += entry.getFileSize();
+        stamp.modificationTime =
+            std::max(stamp.modificationTime, entry.getModificationTime().toMilliseconds());
+    }
+
+    return stamp;
+}
+
+bool PluginScanState::isUnchanged(const juce::String& fileOrIdentifier,
+                                  const PluginFileStamp& stamp) const {
+    const auto* previous = find(fileOrIdentifier);
+    return previous != nullptr && *previous == stamp;
+}
+
+const PluginFileStamp* PluginScanState::find(const juce::String& fileOrIdentifier) const {
+    auto it = files_.find(fileOrIdentifier);
+    return it != files_.end() ? &it->second : nullptr;
+}
+
+void PluginScanState::set(const juce::String& fileOrIdentifier, const PluginFileStamp& stamp) {
+    files_[fileOrIdentifier] = stamp;
+}
+
+void PluginScanState::remove(const juce::String& fileOrIdentifier) {
+    files_.erase(fileOrIdentifier);
+}
+
+void PluginScanState::clear() {
+    files_.clear();
+}
+
+juce::StringArray PluginScanState::getFiles() const {
+    juce::StringArray files;
+    for (const auto& [path, stamp] : files_) {
+        files.add(path);
+    }
+    return files;
+}
+
+std::unique_ptr<juce::XmlElement> PluginScanState::createXml() const {
+    auto xml = std::make_unique<juce::XmlElement>(kStateTag);
+    for (const auto& [path, stamp] : files_) {
+        auto* file = xml->createNewChildElement(kFileTag);
+        file->setAttribute(kPathAttr, path);
+        file->setAttribute(kFormatAttr, stamp.formatName);
+        file->setAttribute(kModifiedAttr, juce::String(stamp.modificationTime));
+        file->setAttribute(kSizeAttr, juce::String(stamp.size));
+    }
+    return xml;
+}
+
+void PluginScanState::restoreFromXml(const juce::XmlElement& xml) {
+    files_.clear();
+    if (!xml.hasTagName(kStateTag)) {
+        return;
+    }
+
+    for (auto* file : xml.getChildWithTagNameIterator(kFileTag)) {
+        auto path = file->getStringAttribute(kPathAttr);
+        if (path.isEmpty()) {
+            continue;
+        }
+
+        PluginFileStamp stamp;
+        stamp.formatName = file->getStringAttribute(kFormatAttr);
+        stamp.modificationTime = file->getStringAttribute(kModifiedAttr).getLargeIntValue();
+        stamp.size = file->getStringAttribute(kSizeAttr).getLargeIntValue();
+        files_[path] = stamp;
+    }
+}
+
+}  // namespace magda
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+#include <map>
+#include <memory>
+
+namespace magda {
+
+/**
+ * @brief What a plugin file looked like when it was last scanned
+ *
+ * A rescan compares this against the file on disk and only re-probes the file if it
+ * differs. Identifiers that are not files (AudioUnit component IDs) carry no time or size
+ * and always compare equal; use Clear & rescan to pick up updated components.
+ */
+struct PluginFileStamp {
+    juce::String formatName;
+    juce::int64 modificationTime = 0;  // Milliseconds since epoch (newest file in a bundle)
+    juce::int64 size = 0;              // Bytes (all files in a bundle)
+
+    bool operator==(const PluginFileStamp& other) const {
+        return formatName == other.formatName && modificationTime == other.modificationTime &&
+               size == other.size;
+    }
+    bool operator!=(const PluginFileStamp& other) const {
+        return !(*this == other);
+    }
+};
+
+/**
+ * @brief The set of plugin files covered by the saved plugin list, keyed by path
+ *
+ * Saved alongside the KnownPluginList (see TracktionEngineWrapper::savePluginList) so the
+ * next scan can skip every bundle that has not changed since.
+ */
+class PluginScanState {
+  public:
+    /**
+     * @brief Stamp a plugin file or identifier as it currently is on disk
+     */
+    static PluginFileStamp stampFor(const juce::String& formatName,
+                                    const juce::String& fileOrIdentifier);
+
+    /**
+     * @brief True if the file was scanned before and its stamp still matches
+     */
+    bool isUnchanged(const juce::String& fileOrIdentifier, const PluginFileStamp& stamp) const;
+
+    const PluginFileStamp* find(const juce::String& fileOrIdentifier) const;
+    void set(const juce::String& fileOrIdentifier, const PluginFileStamp& stamp);
+    void remove(const juce::String& fileOrIdentifier);
+    void clear();
+
+    int size() const {
+        return static_cast<int>(files_.size());
+    }
+
+    /**
+     * @brief All files in the state, in path order
+     */
+    juce::StringArray getFiles() const;
+
+    // Serialization
+    std::unique_ptr<juce::XmlElement> createXml() const;
+    void restoreFromXml(const juce::XmlElement& xml);
+
+  private:
+    std::map<juce::String, PluginFileStamp> files_;
+};
+
+}  // namespace magda
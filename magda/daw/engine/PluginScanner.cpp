@@ -2,6 +2,8 @@
 
 #include <iostream>
 
+#include "../profiling/PerformanceProfiler.hpp"
+
 namespace magda {
 
 PluginScanner::PluginScanner() : juce::Thread("Plugin Scanner") {
@@ -35,6 +37,9 @@ void PluginScanner::abortScan() {
 }
 
 void PluginScanner::run() {
+    TraceRecorder::getInstance().setCurrentThreadName("Plugin Scanner");
+    MAGDA_MONITOR_SCOPE("PluginScan");
+
     std::cout << "Plugin scan started on background thread" << std::endl;
 
     if (!formatManager_) {
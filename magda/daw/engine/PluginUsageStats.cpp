@@ -0,0 +1,82 @@
+#include "PluginUsageStats.hpp"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace magda {
+
+namespace {
+const juce::Identifier kUsageTag("PLUGINUSAGE");
+const juce::Identifier kPluginTag("PLUGIN");
+const juce::Identifier kIdAttr("id");
+const juce::Identifier kCountAttr("count");
+}  // namespace
+
+void PluginUsageStats::recordUse(const juce::String& identifier) {
+    if (identifier.isNotEmpty()) {
+        ++counts_[identifier];
+    }
+}
+
+int PluginUsageStats::getCount(const juce::String& identifier) const {
+    auto it = counts_.find(identifier);
+    return it != counts_.end() ? it->second : 0;
+}
+
+juce::StringArray PluginUsageStats::getMostUsed(int maxResults, int minUses) const {
+    std::vector<std::pair<juce::String, int>> used;
+    for (const auto& [identifier, count] : counts_) {
+        if (count >= minUses) {
+            used.emplace_back(identifier, count);
+        }
+    }
+
+    // Stable, so equal counts stay in identifier order
+    std::stable_sort(used.begin(), used.end(),
+                     [](const auto& a, const auto& b) { return a.second > b.second; });
+
+    juce::StringArray identifiers;
+    for (const auto& [identifier, count] : used) {
+        if (identifiers.size() >= maxResults) {
+            break;
+        }
+        identifiers.add(identifier);
+    }
+    return identifiers;
+}
+
+void PluginUsageStats::remove(const juce::String& identifier) {
+    counts_.erase(identifier);
+}
+
+void PluginUsageStats::clear() {
+    counts_.clear();
+}
+
+std::unique_ptr<juce::XmlElement> PluginUsageStats::createXml() const {
+    auto xml = std::make_unique<juce::XmlElement>(kUsageTag);
+    for (const auto& [identifier, count] : counts_) {
+        auto* plugin = xml->createNewChildElement(kPluginTag);
+        plugin->setAttribute(kIdAttr, identifier);
+        plugin->setAttribute(kCountAttr, count);
+    }
+    return xml;
+}
+
+void PluginUsageStats::restoreFromXml(const juce::XmlElement& xml) {
+    counts_.clear();
+    if (!xml.hasTagName(kUsageTag)) {
+        return;
+    }
+
+    for (auto* plugin : xml.getChildWithTagNameIterator(kPluginTag)) {
+        auto identifier = plugin->getStringAttribute(kIdAttr);
+        const int count = plugin->getIntAttribute(kCountAttr);
+        if (identifier.isNotEmpty() && count > 0) {
+            counts_[identifier] = count;
+        }
+    }
+}
+
+}  // namespace magda
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+#include <map>
+#include <memory>
+
+namespace magda {
+
+/**
+ * @brief How often each plugin has been inserted, keyed by its identifier string
+ *
+ * The identifier is juce::PluginDescription::createIdentifierString(), which KnownPluginList
+ * can turn back into a description. Saved alongside the KnownPluginList (see
+ * TracktionEngineWrapper::savePluginList) so the most-used plugins can be kept warm from
+ * the start of the next session (see PluginInstancePool).
+ */
+class PluginUsageStats {
+  public:
+    void recordUse(const juce::String& identifier);
+    int getCount(const juce::String& identifier) const;
+
+    /**
+     * @brief Identifiers used at least minUses times, most used first (ties in id order)
+     */
+    juce::StringArray getMostUsed(int maxResults, int minUses = 1) const;
+
+    void remove(const juce::String& identifier);
+    void clear();
+
+    int size() const {
+        return static_cast<int>(counts_.size());
+    }
+
+    // Serialization
+    std::unique_ptr<juce::XmlElement> createXml() const;
+    void restoreFromXml(const juce::XmlElement& xml);
+
+  private:
+    std::map<juce::String, int> counts_;
+};
+
+}  // namespace magda
@@ -2,12 +2,17 @@
 
 #include <iostream>
 
+#include "MagdaUIBehaviour.hpp"
+
 namespace magda {
 
 PluginWindowManager::PluginWindowManager(te::Engine& engine, te::Edit& edit)
     : engine_(engine), edit_(edit) {
-    // Start timer at 10Hz to detect hidden windows
-    startTimerHz(10);
+    if (auto* ui = dynamic_cast<MagdaUIBehaviour*>(&engine_.getUIBehaviour())) {
+        ui->onWindowStateChanged = [this](te::Plugin& plugin, bool isShowing) {
+            windowStateChanged(plugin, isShowing);
+        };
+    }
     DBG("PluginWindowManager initialized");
 }
 
@@ -17,11 +22,11 @@ PluginWindowManager::~PluginWindowManager() {
     // Set shutdown flag FIRST
     isShuttingDown_.store(true, std::memory_order_release);
 
-    // Stop timer immediately
-    stopTimer();
-
-    // Close all remaining windows
+    // Close all remaining windows, then stop listening for them
     closeAllWindows();
+    if (auto* ui = dynamic_cast<MagdaUIBehaviour*>(&engine_.getUIBehaviour())) {
+        ui->onWindowStateChanged = nullptr;
+    }
 
     DBG("PluginWindowManager destroyed");
 }
@@ -46,22 +51,20 @@ void PluginWindowManager::showPluginWindow(DeviceId deviceId, const te::Plugin::
 
     if (auto* extPlugin = dynamic_cast<te::ExternalPlugin*>(plugin.get())) {
         if (extPlugin->windowState) {
-            DBG("  -> Calling showWindowExplicitly() for: " << extPlugin->getName());
-            extPlugin->windowState->showWindowExplicitly();
-
-            bool showing = extPlugin->windowState->isWindowShowing();
-            DBG("  -> After showWindowExplicitly, isWindowShowing=" << (showing ? "true"
-                                                                                : "false"));
-
-            // Track this window
+            // Tracked first: the new window reports itself shown while it is being built
             {
                 juce::ScopedLock lock(windowLock_);
-                trackedWindows_[deviceId] = {plugin, showing};
+                auto& info = trackedWindows_[deviceId];
+                if (info.plugin != plugin) {
+                    info = {plugin, false};
+                }
             }
 
-            if (onWindowStateChanged) {
-                onWindowStateChanged(deviceId, showing);
-            }
+            DBG("  -> Calling showWindowExplicitly() for: " << extPlugin->getName());
+            extPlugin->windowState->showWindowExplicitly();
+
+            // Covers a window that was already open, or one that failed to appear
+            setWindowOpen(deviceId, extPlugin->windowState->isWindowShowing());
         } else {
             DBG("  -> Plugin has no windowState: " << extPlugin->getName());
         }
@@ -87,18 +90,8 @@ void PluginWindowManager::hidePluginWindow(DeviceId deviceId, const te::Plugin::
             // This is safe now that we use JUCE's title bar (not native macOS).
             extPlugin->windowState->closeWindowExplicitly();
 
-            // Update tracking
-            {
-                juce::ScopedLock lock(windowLock_);
-                auto it = trackedWindows_.find(deviceId);
-                if (it != trackedWindows_.end()) {
-                    it->second.wasOpen = false;
-                }
-            }
-
-            if (onWindowStateChanged) {
-                onWindowStateChanged(deviceId, false);
-            }
+            // The window reports its own deletion; this only covers one already gone
+            setWindowOpen(deviceId, false);
         }
     }
 }
@@ -196,49 +189,42 @@ void PluginWindowManager::closeWindowsForDevice(DeviceId deviceId) {
 }
 
 // =============================================================================
-// Timer Callback
+// Window Events
 // =============================================================================
 
-void PluginWindowManager::timerCallback() {
+void PluginWindowManager::windowStateChanged(te::Plugin& plugin, bool isShowing) {
     if (isShuttingDown_.load(std::memory_order_acquire)) {
         return;
     }
 
-    // Track window state changes and notify listeners
-    // Close handling is now done directly in PluginEditorWindow::closeButtonPressed()
-    // via state_.closeWindowExplicitly() since we use JUCE's title bar (not native).
-    std::vector<std::pair<DeviceId, bool>> stateChanges;
-
+    // Closing with the X button and Tracktion deleting the window arrive here too
+    DeviceId deviceId = INVALID_DEVICE_ID;
     {
         juce::ScopedLock lock(windowLock_);
-        for (auto& [deviceId, info] : trackedWindows_) {
-            if (!info.plugin) {
-                continue;
-            }
-
-            auto* extPlugin = dynamic_cast<te::ExternalPlugin*>(info.plugin.get());
-            if (!extPlugin || !extPlugin->windowState) {
-                continue;
-            }
-
-            // Track window state changes
-            bool currentlyShowing = extPlugin->windowState->isWindowShowing();
-            if (!info.wasOpen && currentlyShowing) {
-                info.wasOpen = true;
-                stateChanges.push_back({deviceId, true});
-            } else if (info.wasOpen && !currentlyShowing) {
-                // Window was closed (via closeButtonPressed or other means)
-                info.wasOpen = false;
-                stateChanges.push_back({deviceId, false});
+        for (const auto& [id, info] : trackedWindows_) {
+            if (info.plugin.get() == &plugin) {
+                deviceId = id;
+                break;
             }
         }
     }
+    if (deviceId != INVALID_DEVICE_ID) {
+        setWindowOpen(deviceId, isShowing);
+    }
+}
 
-    // Notify about state changes
-    for (const auto& [deviceId, isOpen] : stateChanges) {
-        if (onWindowStateChanged) {
-            onWindowStateChanged(deviceId, isOpen);
+void PluginWindowManager::setWindowOpen(DeviceId deviceId, bool isOpen) {
+    {
+        juce::ScopedLock lock(windowLock_);
+        auto it = trackedWindows_.find(deviceId);
+        if (it == trackedWindows_.end() || it->second.wasOpen == isOpen) {
+            return;
         }
+        it->second.wasOpen = isOpen;
+    }
+
+    if (onWindowStateChanged) {
+        onWindowStateChanged(deviceId, isOpen);
     }
 }
 
@@ -16,7 +16,7 @@ namespace te = tracktion;
  *
  * Key responsibilities:
  * - Owns window state tracking independently from AudioBridge
- * - Handles window close events safely (from timer, not from window's own event handler)
+ * - Handles window close events safely (deferred, not from window's own event handler)
  * - Must be destroyed BEFORE AudioBridge in shutdown sequence
  *
  * The problem this solves:
@@ -26,14 +26,17 @@ namespace te = tracktion;
  * during its own callback.
  *
  * Solution:
- * - Window's closeButtonPressed() just calls setVisible(false)
- * - This timer detects hidden windows and closes them from OUTSIDE the window
+ * - Window's closeButtonPressed() defers closeWindowExplicitly() until it has returned
  * - On shutdown, closeAllWindows() is called BEFORE AudioBridge is destroyed
+ *
+ * Window state is event driven: PluginEditorWindow reports being shown, hidden and
+ * deleted through MagdaUIBehaviour::onWindowStateChanged, however that came about, so
+ * nothing polls the windows.
  */
-class PluginWindowManager : public juce::Timer {
+class PluginWindowManager {
   public:
     PluginWindowManager(te::Engine& engine, te::Edit& edit);
-    ~PluginWindowManager() override;
+    ~PluginWindowManager();
 
     // =========================================================================
     // Window Control
@@ -95,7 +98,12 @@ class PluginWindowManager : public juce::Timer {
     std::function<void(DeviceId, bool)> onWindowStateChanged;
 
   private:
-    void timerCallback() override;
+    void windowStateChanged(te::Plugin& plugin, bool isShowing);
+
+    /**
+     * @brief Record a tracked window's state, notifying if it changed
+     */
+    void setWindowOpen(DeviceId deviceId, bool isOpen);
 
     te::Engine& engine_;
     te::Edit& edit_;
@@ -108,7 +116,7 @@ class PluginWindowManager : public juce::Timer {
     std::unordered_map<DeviceId, WindowInfo> trackedWindows_;
     mutable juce::CriticalSection windowLock_;
 
-    // Shutdown flag to prevent timer operations during cleanup
+    // Shutdown flag to ignore window events during cleanup
     std::atomic<bool> isShuttingDown_{false};
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PluginWindowManager)
@@ -0,0 +1,309 @@
+#include "ProjectSwitcher.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "../audio/AudioBridge.hpp"
+#include "../audio/AudioReaderCache.hpp"
+#include "../audio/AudioThumbnailManager.hpp"
+#include "../core/ProjectManager.hpp"
+#include "TracktionEngineWrapper.hpp"
+
+namespace magda {
+
+namespace {
+
+double nowMs() {
+    return juce::Time::getMillisecondCounterHiRes();
+}
+
+}  // namespace
+
+ProjectSwitcher::ProjectSwitcher(TracktionEngineWrapper& engine) : engine_(engine) {}
+
+ProjectSwitcher::~ProjectSwitcher() {
+    alive_->store(false);
+    stopTimer();
+
+    // Never leave the master faded down
+    if (isSwitching()) {
+        if (auto* bridge = engine_.getAudioBridge()) {
+            bridge->setMasterFade(1.0f);
+        }
+    }
+}
+
+// =============================================================================
+// Preloading
+// =============================================================================
+
+void ProjectSwitcher::preload(const juce::File& file, Callback onReady) {
+    if (isSwitching()) {
+        if (onReady) {
+            onReady("A project switch is under way");
+        }
+        return;
+    }
+
+    cancel();
+    state_ = State::Reading;
+    onReady_ = std::move(onReady);
+
+    auto alive = alive_;
+    ProjectManager::getInstance().preloadAsync(file, [this, alive](const juce::String& error) {
+        if (alive->load()) {
+            preloadRead(error);
+        }
+    });
+}
+
+void ProjectSwitcher::preloadRead(const juce::String& error) {
+    auto& projectManager = ProjectManager::getInstance();
+    if (state_ != State::Reading) {
+        projectManager.discardPreloaded();  // Cancelled while it was read
+        return;
+    }
+
+    const auto* model = projectManager.getPreloadedModel();
+    if (error.isNotEmpty() || model == nullptr) {
+        state_ = State::Idle;
+        if (auto onReady = std::move(onReady_)) {
+            onReady(error.isNotEmpty() ? error : juce::String("The project could not be read"));
+        }
+        return;
+    }
+
+    audioFiles_.clear();
+    for (const auto& clip : model->clips) {
+        for (const auto& source : clip.audioSources) {
+            if (source.filePath.isNotEmpty()) {
+                audioFiles_.addIfNotAlreadyThere(source.filePath);
+            }
+        }
+    }
+
+    if (auto* bridge = engine_.getAudioBridge()) {
+        bridge->preloadPlugins(model->tracks);
+    }
+
+    state_ = State::Warming;
+    startTimer(kTickMs);
+}
+
+void ProjectSwitcher::warmAudioFiles(double deadlineMs) {
+    auto* engine = engine_.getEngine();
+    while (!audioFiles_.isEmpty() && nowMs() < deadlineMs) {
+        const auto path = audioFiles_[audioFiles_.size() - 1];
+        audioFiles_.remove(audioFiles_.size() - 1);
+
+        const juce::File file(path);
+        if (!file.existsAsFile()) {
+            continue;  // Reported as missing when the project opens
+        }
+
+        // The engine's file info, the UI's reader and the peaks, so neither playback nor the
+        // first paint of the new project goes to disk for them
+        if (engine != nullptr) {
+            tracktion::AudioFile(*engine, file).getInfo();
+        }
+        AudioReaderCache::getInstance().getReader(file);
+        AudioThumbnailManager::getInstance().getPeakPyramid(path);
+    }
+}
+
+void ProjectSwitcher::cancel() {
+    if (isSwitching()) {
+        return;
+    }
+
+    stopTimer();
+    state_ = State::Idle;
+    onReady_ = nullptr;
+    audioFiles_.clear();
+
+    ProjectManager::getInstance().discardPreloaded();
+    if (auto* bridge = engine_.getAudioBridge()) {
+        bridge->getPluginPool().releaseReserved();
+    }
+}
+
+juce::File ProjectSwitcher::getPreloadedFile() const {
+    return ProjectManager::getInstance().getPreloadedFile();
+}
+
+// =============================================================================
+// Switching
+// =============================================================================
+
+double ProjectSwitcher::secondsToNextBar(double positionSeconds, double bpm, int numerator,
+                                         int denominator) {
+    if (bpm <= 0.0 || numerator <= 0 || denominator <= 0) {
+        return 0.0;
+    }
+
+    const double barSeconds = numerator * (4.0 / denominator) * 60.0 / bpm;
+    const double intoBar = std::fmod(std::max(0.0, positionSeconds), barSeconds);
+    const double remaining = barSeconds - intoBar;
+    return intoBar < 1.0e-6 || remaining < 1.0e-6 ? 0.0 : remaining;
+}
+
+void ProjectSwitcher::switchToPreloaded(const Options& options, Callback onDone) {
+    juce::String error;
+    if (isSwitching()) {
+        error = "A project switch is already under way";
+    } else if (!ProjectManager::getInstance().hasPreloadedProject()) {
+        error = "No project is preloaded";
+    }
+    if (error.isNotEmpty()) {
+        if (onDone) {
+            onDone(error);
+        }
+        return;
+    }
+
+    // Switching while still warming just finds some files cold
+    audioFiles_.clear();
+    onReady_ = nullptr;
+
+    options_ = options;
+    onDone_ = std::move(onDone);
+    switchError_ = {};
+
+    const double now = nowMs();
+    switchAtMs_ = now;
+    if (options.at == SwitchPoint::NextBar && engine_.isPlaying()) {
+        int numerator = 4, denominator = 4;
+        engine_.getTimeSignature(numerator, denominator);
+        const double bpm = engine_.getTempo();
+
+        // The fade out ends on the bar line; a bar too close to fade into is skipped
+        const double toBarMs =
+            secondsToNextBar(engine_.getCurrentPosition(), bpm, numerator, denominator) * 1000.0;
+        const double barMs = bpm > 0.0 && numerator > 0 && denominator > 0
+                                 ? numerator * (4.0 / denominator) * 60000.0 / bpm
+                                 : 0.0;
+        switchAtMs_ = now + toBarMs - options.fadeMs;
+        while (barMs > 0.0 && switchAtMs_ < now) {
+            switchAtMs_ += barMs;
+        }
+    }
+
+    state_ = State::WaitingForSwitch;
+    startTimer(kTickMs);
+}
+
+void ProjectSwitcher::timerCallback() {
+    const double fadeMs = options_.fadeMs;
+    auto* bridge = engine_.getAudioBridge();
+
+    switch (state_) {
+        case State::Warming: {
+            warmAudioFiles(nowMs() + kWarmSliceMs);
+            const bool pluginsReady =
+                bridge == nullptr || bridge->getPluginPool().isReservationComplete();
+            if (audioFiles_.isEmpty() && pluginsReady) {
+                stopTimer();
+                state_ = State::Ready;
+                if (auto onReady = std::move(onReady_)) {
+                    onReady({});
+                }
+            }
+            break;
+        }
+
+        case State::WaitingForSwitch:
+            if (nowMs() >= switchAtMs_) {
+                startFadeOut();
+            }
+            break;
+
+        case State::FadingOut: {
+            const double progress = fadeMs > 0.0 ? elapsedMs() / fadeMs : 1.0;
+            if (progress >= 1.0) {
+                if (bridge != nullptr) {
+                    bridge->setMasterFade(0.0f);
+                }
+                swap();
+            } else if (bridge != nullptr) {
+                bridge->setMasterFade(static_cast<float>(1.0 - progress));
+            }
+            break;
+        }
+
+        case State::WaitingForPlugins:
+            if (bridge == nullptr || bridge->getNumPendingPluginLoads() == 0 ||
+                elapsedMs() >= kMaxPluginWaitMs) {
+                startFadeIn();
+            }
+            break;
+
+        case State::FadingIn: {
+            const double progress = fadeMs > 0.0 ? elapsedMs() / fadeMs : 1.0;
+            if (bridge != nullptr) {
+                bridge->setMasterFade(static_cast<float>(std::min(1.0, progress)));
+            }
+            if (progress >= 1.0) {
+                finishSwitch(switchError_);
+            }
+            break;
+        }
+
+        case State::Idle:
+        case State::Reading:
+        case State::Ready:
+            stopTimer();
+            break;
+    }
+}
+
+void ProjectSwitcher::startFadeOut() {
+    state_ = State::FadingOut;
+    phaseStartMs_ = nowMs();
+    timerCallback();  // A zero-length fade swaps straight away
+}
+
+void ProjectSwitcher::swap() {
+    const bool wasPlaying = engine_.isPlaying();
+    const double position = engine_.getCurrentPosition();
+
+    switchError_ = ProjectManager::getInstance().openPreloaded();
+    if (switchError_.isNotEmpty()) {
+        startFadeIn();  // Still the old project: bring it back
+        return;
+    }
+
+    engine_.locate(options_.restartFromTop ? 0.0 : position);
+    if (wasPlaying && !engine_.isPlaying()) {
+        engine_.play();
+    }
+
+    state_ = State::WaitingForPlugins;
+    phaseStartMs_ = nowMs();
+}
+
+void ProjectSwitcher::startFadeIn() {
+    // Instances the new project didn't take go back; a failed switch keeps them for a retry
+    if (switchError_.isEmpty()) {
+        if (auto* bridge = engine_.getAudioBridge()) {
+            bridge->getPluginPool().releaseReserved();
+        }
+    }
+
+    state_ = State::FadingIn;
+    phaseStartMs_ = nowMs();
+}
+
+void ProjectSwitcher::finishSwitch(const juce::String& error) {
+    stopTimer();
+    state_ = ProjectManager::getInstance().hasPreloadedProject() ? State::Ready : State::Idle;
+    if (auto onDone = std::move(onDone_)) {
+        onDone(error);
+    }
+}
+
+double ProjectSwitcher::elapsedMs() const {
+    return nowMs() - phaseStartMs_;
+}
+
+}  // namespace magda
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <juce_events/juce_events.h>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+
+namespace magda {
+
+class TracktionEngineWrapper;
+
+/**
+ * @brief Loads the next project while the current one plays, then switches to it
+ *
+ * preload() has ProjectManager read and decode the project on its pool thread, then warms
+ * what the project will need while the current one keeps playing: the audio files its
+ * clips read (opened readers, file info, peaks) and, through the plugin pool, an
+ * initialised instance of each external plugin it uses. None of this touches the current
+ * project.
+ *
+ * switchToPreloaded() changes over at the chosen point, now or at the next bar line. The
+ * engine plays one Edit, so the two projects can't overlap: the master fades out over
+ * fadeMs ending at the switch point, the managers load the preloaded model (the engine
+ * syncs and takes the reserved plugin instances), and the master fades back in once the
+ * new project's plugins have loaded, or after kMaxPluginWaitMs. Transport keeps running
+ * throughout.
+ *
+ * Message thread only.
+ */
+class ProjectSwitcher : private juce::Timer {
+  public:
+    /**
+     * @brief Called with an empty string on success, otherwise the error to show
+     */
+    using Callback = std::function<void(const juce::String& error)>;
+
+    enum class SwitchPoint {
+        Now,
+        NextBar,  // The next bar line while playing; now when stopped
+    };
+
+    struct Options {
+        SwitchPoint at = SwitchPoint::NextBar;
+        double fadeMs = 150.0;       // Each way
+        bool restartFromTop = true;  // Otherwise the new project plays on from the same time
+    };
+
+    static constexpr int kTickMs = 10;
+    static constexpr double kWarmSliceMs = 8.0;  // Audio file warm-up per tick
+    static constexpr double kMaxPluginWaitMs = 1000.0;
+
+    explicit ProjectSwitcher(TracktionEngineWrapper& engine);
+    ~ProjectSwitcher() override;
+
+    /**
+     * @brief Preload the project in file, replacing any preloaded earlier
+     * @param onReady Called once the model is decoded and everything it uses is warm
+     */
+    void preload(const juce::File& file, Callback onReady = nullptr);
+
+    /**
+     * @brief Change to the preloaded project at options.at
+     * @param onDone Called after the fade back in, or with the error if nothing was switched
+     */
+    void switchToPreloaded(const Options& options, Callback onDone = nullptr);
+
+    /**
+     * @brief Drop the preloaded project and its reserved plugin instances
+     *
+     * Ignored while a switch is under way.
+     */
+    void cancel();
+
+    bool isPreloading() const {
+        return state_ == State::Reading || state_ == State::Warming;
+    }
+    bool isReady() const {
+        return state_ == State::Ready;
+    }
+    bool isSwitching() const {
+        return state_ >= State::WaitingForSwitch;
+    }
+
+    /**
+     * @brief The preloaded project's file, invalid if none
+     */
+    juce::File getPreloadedFile() const;
+
+    /**
+     * @brief Seconds from positionSeconds to the next bar line at a constant tempo
+     *
+     * A position on a bar line (within a microsecond) is that bar line: 0.
+     */
+    static double secondsToNextBar(double positionSeconds, double bpm, int numerator,
+                                   int denominator);
+
+  private:
+    enum class State {
+        Idle,
+        Reading,  // ProjectManager decoding the model
+        Warming,  // Opening audio files and making plugin instances
+        Ready,
+        WaitingForSwitch,
+        FadingOut,
+        WaitingForPlugins,
+        FadingIn,
+    };
+
+    void timerCallback() override;
+    void preloadRead(const juce::String& error);
+    void warmAudioFiles(double deadlineMs);
+    void startFadeOut();
+    void swap();
+    void startFadeIn();
+    void finishSwitch(const juce::String& error);
+    double elapsedMs() const;
+
+    TracktionEngineWrapper& engine_;
+    State state_ = State::Idle;
+
+    Callback onReady_;
+    juce::StringArray audioFiles_;  // Still to warm
+
+    Options options_;
+    Callback onDone_;
+    double switchAtMs_ = 0.0;    // When the fade out starts
+    double phaseStartMs_ = 0.0;  // Start of the current fade or wait
+    juce::String switchError_;   // Reported once faded back in
+
+    std::shared_ptr<std::atomic<bool>> alive_ = std::make_shared<std::atomic<bool>>(true);
+
+    JUCE_DECLARE_NON_COPYABLE(ProjectSwitcher)
+};
+
+}  // namespace magda
@@ -0,0 +1,410 @@
+#include "StemRenderCoordinator.hpp"
+
+#include <algorithm>
+#include <iostream>
+
+#include "../core/ClipManager.hpp"
+#include "../core/TrackManager.hpp"
+#include "OfflineRenderer.hpp"
+
+namespace magda {
+
+// =============================================================================
+// Worker
+// =============================================================================
+
+class StemRenderCoordinator::Worker : public GenerationTaggedWorker<StemRenderCoordinator> {
+  public:
+    using GenerationTaggedWorker::GenerationTaggedWorker;
+
+    // Message-thread state, owned by the coordinator
+    bool hasJob = false;
+    RenderJob job;
+    bool recovering = false;
+    bool retired = false;
+};
+
+// =============================================================================
+// StemRenderCoordinator
+// =============================================================================
+
+StemRenderCoordinator::StemRenderCoordinator()
+    : workerExecutable_(juce::File::getSpecialLocation(juce::File::currentExecutableFile)) {}
+
+StemRenderCoordinator::~StemRenderCoordinator() {
+    validFlag_->store(false);
+    if (isRendering_) {
+        abort();
+    }
+    workers_.clear();
+}
+
+std::vector<StemRenderPlan::Track> StemRenderCoordinator::collectTracks(
+    const std::vector<std::string>& trackIds) {
+    auto& trackManager = TrackManager::getInstance();
+    auto& clipManager = ClipManager::getInstance();
+
+    std::vector<TrackId> ids;
+    if (trackIds.empty()) {
+        for (const auto& track : trackManager.getTracks()) {
+            ids.push_back(track.id);
+        }
+    } else {
+        for (const auto& id : trackIds) {
+            ids.push_back(juce::String(id).getIntValue());
+        }
+    }
+
+    std::vector<StemRenderPlan::Track> tracks;
+    tracks.reserve(ids.size());
+    for (const auto id : ids) {
+        const auto* info = trackManager.getTrack(id);
+        if (info == nullptr) {
+            continue;
+        }
+
+        StemRenderPlan::Track track;
+        track.id = id;
+        track.name = info->name;
+        track.root = id;
+        for (const auto* parent = info; parent != nullptr && parent->hasParent();) {
+            track.root = parent->parentId;
+            parent = trackManager.getTrack(parent->parentId);
+        }
+
+        const auto clipIds = clipManager.getClipsOnTrack(id);
+        track.weight = 1.0 + static_cast<double>(clipIds.size() + info->chainElements.size());
+        for (const auto clipId : clipIds) {
+            if (const auto* clip = clipManager.getClip(clipId)) {
+                for (const auto& source : clip->audioSources) {
+                    if (source.filePath.isNotEmpty()) {
+                        track.audioFiles.addIfNotAlreadyThere(source.filePath);
+                    }
+                }
+            }
+        }
+        tracks.push_back(std::move(track));
+    }
+    return tracks;
+}
+
+int StemRenderCoordinator::chooseWorkerCount() const {
+    // Each worker's render already spreads over every core; a few processes in parallel
+    // overlap their serial parts (project load, plugin init, file writes)
+    int count = maxWorkers_ > 0 ? maxWorkers_ : juce::SystemStats::getNumCpus() / 2;
+    return juce::jlimit(1, MAX_WORKERS, count);
+}
+
+void StemRenderCoordinator::start(const juce::File& project,
+                                  const RenderInterface::RenderRequest& request,
+                                  const std::vector<StemRenderPlan::Track>& tracks,
+                                  const ProgressCallback& progressCallback,
+                                  const CompletionCallback& completionCallback) {
+    if (isRendering_) {
+        std::cout << "[StemRender] Render already in progress" << std::endl;
+        return;
+    }
+
+    progressCallback_ = progressCallback;
+    completionCallback_ = completionCallback;
+    project_ = project;
+    outputDirectory_ = juce::File(juce::String(request.output_path));
+    request_ = request;
+    workers_.clear();
+    pendingJobs_.clear();
+    stems_.clear();
+    completedJobs_ = 0;
+    recoverySequence_++;  // Invalidate any stale recovery callbacks
+
+    juce::String error;
+    if (!project.existsAsFile()) {
+        error = "No such project: " + project.getFullPathName();
+    } else if (request.output_path.empty() || !outputDirectory_.createDirectory()) {
+        error = "Can't create the output directory";
+    } else if (!workerExecutable_.existsAsFile()) {
+        error = "No render worker at " + workerExecutable_.getFullPathName();
+    } else if (tracks.empty()) {
+        error = "No tracks to render";
+    }
+    if (error.isNotEmpty()) {
+        if (completionCallback) {
+            completionCallback(false, {}, error);
+        }
+        return;
+    }
+
+    for (auto& partition : StemRenderPlan::partition(tracks, chooseWorkerCount())) {
+        pendingJobs_.push_back({std::move(partition), 0});
+    }
+    totalJobs_ = static_cast<int>(pendingJobs_.size());
+    isRendering_ = true;
+
+    std::cout << "[StemRender] Rendering " << tracks.size() << " stems with " << totalJobs_
+              << " worker processes" << std::endl;
+
+    for (int i = 0; i < totalJobs_; ++i) {
+        workers_.push_back(std::make_unique<Worker>(*this, i));
+        auto& worker = *workers_.back();
+        if (launchWorker(worker)) {
+            dispatchNextJob(worker);
+        } else {
+            worker.retired = true;
+        }
+    }
+
+    if (std::all_of(workers_.begin(), workers_.end(),
+                    [](const auto& worker) { return worker->retired; })) {
+        finish(false, "Failed to launch a render worker");
+    }
+}
+
+bool StemRenderCoordinator::launchWorker(Worker& worker) {
+    // Output isn't captured
+    if (!worker.launch(workerExecutable_, StemRenderIPC::WORKER_ID, nextGeneration_++, 10000, 0)) {
+        std::cerr << "[StemRender] Failed to launch worker " << worker.getIndex() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+juce::File StemRenderCoordinator::getPartDirectory(int workerIndex) const {
+    return outputDirectory_.getChildFile(".magda-part-" + juce::String(workerIndex));
+}
+
+void StemRenderCoordinator::dispatchNextJob(Worker& worker) {
+    if (!isRendering_ || worker.retired) {
+        return;
+    }
+
+    if (pendingJobs_.empty()) {
+        finishIfIdle();
+        return;
+    }
+
+    worker.job = std::move(pendingJobs_.front());
+    pendingJobs_.pop_front();
+    worker.hasJob = true;
+
+    // Rendered privately so a half-written partition never lands beside finished stems
+    const auto directory = getPartDirectory(worker.getIndex());
+    (void)directory.deleteRecursively();
+    (void)directory.createDirectory();
+
+    juce::MemoryBlock msg;
+    juce::MemoryOutputStream stream(msg, false);
+    stream.writeString(StemRenderIPC::MSG_RENDER);
+    stream.writeString(project_.getFullPathName());
+    stream.writeString(directory.getFullPathName());
+    stream.writeDouble(request_.start_seconds);
+    stream.writeDouble(request_.end_seconds);
+    stream.writeDouble(request_.sample_rate);
+    stream.writeInt(request_.bit_depth);
+    stream.writeBool(request_.normalise);
+    stream.writeInt(static_cast<int>(worker.job.partition.trackIds.size()));
+    for (const auto trackId : worker.job.partition.trackIds) {
+        stream.writeInt(trackId);
+    }
+    worker.send(msg);
+}
+
+void StemRenderCoordinator::collectStems(Worker& worker, const juce::StringArray& files) {
+    const auto& partition = worker.job.partition;
+    worker.hasJob = false;
+    if (files.size() != static_cast<int>(partition.trackIds.size())) {
+        finish(false, "A worker rendered " + juce::String(files.size()) + " of " +
+                          juce::String(static_cast<int>(partition.trackIds.size())) + " stems");
+        return;
+    }
+
+    for (int i = 0; i < files.size(); ++i) {
+        const auto number = partition.stemNumbers[static_cast<size_t>(i)];
+        const auto target = outputDirectory_.getChildFile(
+            OfflineRenderer::makeStemFileName(number, partition.trackNames[i]));
+        (void)target.deleteFile();
+        if (!juce::File(files[i]).moveFileTo(target)) {
+            finish(false, "Can't move the stem to " + target.getFullPathName());
+            return;
+        }
+        stems_[number] = target.getFullPathName();
+    }
+    (void)getPartDirectory(worker.getIndex()).deleteRecursively();
+
+    completedJobs_++;
+    if (progressCallback_ && totalJobs_ > 0) {
+        progressCallback_(static_cast<float>(completedJobs_) / static_cast<float>(totalJobs_));
+    }
+    dispatchNextJob(worker);
+}
+
+void StemRenderCoordinator::handleWorkerMessage(int workerIndex, int generation,
+                                                const juce::MemoryBlock& message) {
+    if (!isRendering_ || workerIndex < 0 || workerIndex >= static_cast<int>(workers_.size())) {
+        return;
+    }
+
+    auto& worker = *workers_[static_cast<size_t>(workerIndex)];
+    if (worker.getGeneration() != generation || !worker.hasJob) {
+        return;  // From a process that has since been killed or replaced
+    }
+
+    juce::MemoryInputStream stream(message, false);
+    const juce::String msgType = stream.readString();
+
+    if (msgType == StemRenderIPC::MSG_DONE) {
+        juce::StringArray files;
+        const int count = stream.readInt();
+        for (int i = 0; i < count && !stream.isExhausted(); ++i) {
+            files.add(stream.readString());
+        }
+        collectStems(worker, files);
+    } else if (msgType == StemRenderIPC::MSG_ERROR) {
+        // The project itself failed to render; another process would fail the same way
+        const auto error = stream.readString();
+        std::cerr << "[StemRender] Worker " << workerIndex << ": " << error << std::endl;
+        finish(false, error);
+    }
+}
+
+void StemRenderCoordinator::handleWorkerLost(int workerIndex, int generation) {
+    if (!isRendering_ || workerIndex < 0 || workerIndex >= static_cast<int>(workers_.size())) {
+        return;
+    }
+
+    auto& worker = *workers_[static_cast<size_t>(workerIndex)];
+    if (worker.getGeneration() != generation) {
+        return;  // Already handled or replaced
+    }
+
+    std::cout << "[StemRender] Connection to worker " << workerIndex << " lost" << std::endl;
+    recoverWorker(worker);
+}
+
+void StemRenderCoordinator::recoverWorker(Worker& worker) {
+    worker.kill();
+
+    if (worker.hasJob) {
+        worker.hasJob = false;
+        if (++worker.job.attempts >= MAX_ATTEMPTS) {
+            finish(false, "A render worker crashed twice on the same tracks");
+            return;
+        }
+        pendingJobs_.push_front(std::move(worker.job));
+
+        // A worker that has finished its own partition takes the crashed one over
+        for (auto& idle : workers_) {
+            if (idle.get() != &worker && !idle->retired && !idle->hasJob && !idle->recovering) {
+                dispatchNextJob(*idle);
+                break;
+            }
+        }
+    }
+
+    if (pendingJobs_.empty()) {
+        worker.retired = true;
+        finishIfIdle();
+        return;
+    }
+
+    const int currentSequence = recoverySequence_;
+    auto validFlag = validFlag_;
+    const int index = worker.getIndex();
+    worker.recovering = true;
+
+    // Give the crashed process time to fully terminate
+    juce::Timer::callAfterDelay(RECOVERY_DELAY_MS, [this, currentSequence, validFlag, index]() {
+        if (!validFlag->load() || currentSequence != recoverySequence_ || !isRendering_) {
+            return;
+        }
+
+        auto& recovering = *workers_[static_cast<size_t>(index)];
+        recovering.recovering = false;
+        if (launchWorker(recovering)) {
+            dispatchNextJob(recovering);
+        } else {
+            recovering.retired = true;
+            finishIfIdle();
+        }
+    });
+}
+
+void StemRenderCoordinator::finishIfIdle() {
+    if (!isRendering_) {
+        return;
+    }
+
+    bool anyActive = false;
+    bool anyAvailable = false;
+    for (const auto& worker : workers_) {
+        anyActive = anyActive || worker->hasJob || worker->recovering;
+        anyAvailable = anyAvailable || !worker->retired;
+    }
+
+    if (anyActive) {
+        return;
+    }
+
+    if (pendingJobs_.empty()) {
+        finish(true);
+    } else if (!anyAvailable) {
+        finish(false, "No render workers left");
+    } else {
+        // Idle workers left with work queued (a partition came back from a crash)
+        for (auto& worker : workers_) {
+            if (!worker->retired && !worker->hasJob) {
+                dispatchNextJob(*worker);
+            }
+        }
+    }
+}
+
+void StemRenderCoordinator::abort() {
+    isRendering_ = false;
+    recoverySequence_++;
+
+    for (auto& worker : workers_) {
+        worker->kill();
+    }
+    pendingJobs_.clear();
+    removePartDirectories();
+}
+
+void StemRenderCoordinator::finish(bool success, const juce::String& error) {
+    isRendering_ = false;
+    recoverySequence_++;
+
+    // Idle workers exit on QUIT; any still rendering (after a failure) are stopped
+    juce::MemoryBlock quitMsg;
+    juce::MemoryOutputStream quitStream(quitMsg, false);
+    quitStream.writeString(StemRenderIPC::MSG_QUIT);
+    for (auto& worker : workers_) {
+        if (worker->hasJob) {
+            worker->kill();
+        } else if (worker->getGeneration() >= 0) {
+            worker->send(quitMsg);
+        }
+        worker->hasJob = false;
+    }
+    pendingJobs_.clear();
+    removePartDirectories();
+
+    juce::StringArray files;
+    for (const auto& [number, file] : stems_) {
+        files.add(file);
+    }
+    std::cout << "[StemRender] Finished: " << files.size() << " stems"
+              << (success ? juce::String() : ", failed: " + error) << std::endl;
+
+    auto callback = completionCallback_;
+    completionCallback_ = nullptr;
+    if (callback) {
+        callback(success, files, error);
+    }
+}
+
+void StemRenderCoordinator::removePartDirectories() const {
+    for (const auto& worker : workers_) {
+        (void)getPartDirectory(worker->getIndex()).deleteRecursively();
+    }
+}
+
+}  // namespace magda
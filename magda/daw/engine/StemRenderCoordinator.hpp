@@ -0,0 +1,161 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <juce_events/juce_events.h>
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../interfaces/render_interface.hpp"
+#include "GenerationTaggedWorker.hpp"
+#include "StemRenderPlan.hpp"
+
+namespace magda {
+
+/**
+ * @brief IPC message types between the stem render coordinator and its workers
+ */
+namespace StemRenderIPC {
+constexpr const char* WORKER_ID = "magda-stem-render";
+constexpr const char* MSG_RENDER = "RNDR";  // Project, directory, range, format, track ids
+constexpr const char* MSG_DONE = "DONE";    // Stem files written, in track order
+constexpr const char* MSG_ERROR = "ERR";
+constexpr const char* MSG_QUIT = "QUIT";
+}  // namespace StemRenderIPC
+
+/**
+ * @brief Renders the stems of a saved project across several headless processes
+ *
+ * The tracks are split by StemRenderPlan into one partition per worker, and a pool of
+ * magda_headless processes (launched through JUCE's ChildProcessCoordinator, like the
+ * plugin scanners) each open the project and render their partition's stems into a
+ * private directory under the output directory. As a partition comes back its stems are
+ * moved into the output directory under the names a single-process render gives them.
+ * A worker that crashes has its partition handed to a relaunched process once; a second
+ * crash on it, or a render error, fails the whole render.
+ *
+ * Message thread only.
+ */
+class StemRenderCoordinator {
+  public:
+    StemRenderCoordinator();
+    ~StemRenderCoordinator();
+
+    /**
+     * @param progress 0.0-1.0, by partitions finished
+     */
+    using ProgressCallback = std::function<void(float progress)>;
+
+    /**
+     * @param files The stems written, in track order (on failure, those finished so far)
+     */
+    using CompletionCallback = std::function<void(bool success, const juce::StringArray& files,
+                                                  const juce::String& error)>;
+
+    /**
+     * @brief Start rendering stems of a project file
+     * @param project Saved project every worker opens; it must match the tracks
+     * @param request output_path is the stems directory; range and format as for any render
+     *                (stems and track_ids are taken from tracks)
+     * @param tracks What to render, in stem order - see collectTracks()
+     */
+    void start(const juce::File& project, const RenderInterface::RenderRequest& request,
+               const std::vector<StemRenderPlan::Track>& tracks,
+               const ProgressCallback& progressCallback,
+               const CompletionCallback& completionCallback);
+
+    /**
+     * @brief Stop every worker; the completion callback isn't called
+     */
+    void abort();
+
+    bool isRendering() const {
+        return isRendering_;
+    }
+
+    /**
+     * @brief Limit the number of worker processes (0 = choose from the CPU count)
+     */
+    void setMaxWorkers(int maxWorkers) {
+        maxWorkers_ = maxWorkers;
+    }
+
+    /**
+     * @brief The magda_headless to launch (default: the running executable)
+     */
+    void setWorkerExecutable(const juce::File& executable) {
+        workerExecutable_ = executable;
+    }
+
+    /**
+     * @brief The current project's tracks in the order a single stem render numbers them
+     * @param trackIds Only these, in this order (empty: every track)
+     *
+     * A track's weight is one plus its clips and top-level devices.
+     */
+    static std::vector<StemRenderPlan::Track> collectTracks(
+        const std::vector<std::string>& trackIds = {});
+
+  private:
+    /**
+     * @brief One partition waiting for, or being rendered by, a worker
+     */
+    struct RenderJob {
+        StemRenderPlan::Partition partition;
+        int attempts = 0;
+    };
+
+    /**
+     * @brief One magda_headless child process and the partition it is rendering
+     */
+    class Worker;
+    friend class GenerationTaggedWorker<StemRenderCoordinator>;
+
+    // Worker events (message thread)
+    void handleWorkerMessage(int workerIndex, int generation, const juce::MemoryBlock& message);
+    void handleWorkerLost(int workerIndex, int generation);
+
+    bool launchWorker(Worker& worker);
+    void dispatchNextJob(Worker& worker);
+    void collectStems(Worker& worker, const juce::StringArray& files);
+    void recoverWorker(Worker& worker);
+    void finishIfIdle();
+    void finish(bool success, const juce::String& error = {});
+    void removePartDirectories() const;
+    juce::File getPartDirectory(int workerIndex) const;
+    int chooseWorkerCount() const;
+
+    // State
+    bool isRendering_ = false;
+    ProgressCallback progressCallback_;
+    CompletionCallback completionCallback_;
+    juce::File project_;
+    juce::File outputDirectory_;
+    RenderInterface::RenderRequest request_;
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::deque<RenderJob> pendingJobs_;
+    std::map<int, juce::String> stems_;  // By stem number
+    int totalJobs_ = 0;
+    int completedJobs_ = 0;
+    int maxWorkers_ = 0;
+    int nextGeneration_ = 0;
+    juce::File workerExecutable_;
+    static constexpr int MAX_WORKERS = 8;
+    static constexpr int MAX_ATTEMPTS = 2;  // Per partition
+    static constexpr int RECOVERY_DELAY_MS = 1000;
+
+    int recoverySequence_ = 0;  // Incremented per render, invalidates stale relaunches
+
+    // Validity flag for async callbacks - set to false in destructor
+    std::shared_ptr<std::atomic<bool>> validFlag_ = std::make_shared<std::atomic<bool>>(true);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(StemRenderCoordinator)
+};
+
+}  // namespace magda
@@ -0,0 +1,73 @@
+#include "StemRenderPlan.hpp"
+
+#include <algorithm>
+#include <map>
+#include <numeric>
+
+namespace magda {
+
+std::vector<StemRenderPlan::Partition> StemRenderPlan::partition(const std::vector<Track>& tracks,
+                                                                 int maxPartitions) {
+    struct Group {
+        std::vector<size_t> members;  // Indices into tracks
+        double weight = 0.0;
+    };
+
+    // Group subtrees, in the order their first track appears
+    std::vector<Group> units;
+    std::map<TrackId, size_t> unitByRoot;
+    for (size_t i = 0; i < tracks.size(); ++i) {
+        const auto root = tracks[i].root != INVALID_TRACK_ID ? tracks[i].root : tracks[i].id;
+        const auto [it, added] = unitByRoot.emplace(root, units.size());
+        if (added) {
+            units.emplace_back();
+        }
+        auto& unit = units[it->second];
+        unit.members.push_back(i);
+        unit.weight += std::max(0.0, tracks[i].weight);
+    }
+    if (units.empty()) {
+        return {};
+    }
+
+    // Largest first, each to the lightest partition; ties keep the project order
+    std::vector<size_t> order(units.size());
+    std::iota(order.begin(), order.end(), size_t{0});
+    std::stable_sort(order.begin(), order.end(),
+                     [&](size_t a, size_t b) { return units[a].weight > units[b].weight; });
+
+    const auto count = std::min(units.size(), static_cast<size_t>(std::max(1, maxPartitions)));
+    std::vector<Group> bins(count);
+    const auto lighter = [](const Group& a, const Group& b) { return a.weight < b.weight; };
+    for (const auto unitIndex : order) {
+        auto lightest = std::min_element(bins.begin(), bins.end(), lighter);
+        const auto& unit = units[unitIndex];
+        lightest->members.insert(lightest->members.end(), unit.members.begin(),
+                                 unit.members.end());
+        lightest->weight += unit.weight;
+    }
+
+    std::stable_sort(bins.begin(), bins.end(),
+                     [](const auto& a, const auto& b) { return a.weight > b.weight; });
+
+    std::vector<Partition> partitions;
+    partitions.reserve(bins.size());
+    for (auto& bin : bins) {
+        std::sort(bin.members.begin(), bin.members.end());
+        Partition partition;
+        partition.weight = bin.weight;
+        for (const auto index : bin.members) {
+            const auto& track = tracks[index];
+            partition.trackIds.push_back(track.id);
+            partition.stemNumbers.push_back(static_cast<int>(index) + 1);
+            partition.trackNames.add(track.name);
+            for (const auto& file : track.audioFiles) {
+                partition.audioFiles.addIfNotAlreadyThere(file);
+            }
+        }
+        partitions.push_back(std::move(partition));
+    }
+    return partitions;
+}
+
+}  // namespace magda
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+#include <vector>
+
+#include "../core/TypeIds.hpp"
+
+namespace magda {
+
+/**
+ * @brief Splits a stem render into balanced partitions, one per render worker
+ *
+ * The unit of work is a top-level track together with everything grouped under it, so a
+ * group's tracks - which usually share sources, sends and routing - land on the same
+ * worker. Units are handed out largest first to whichever partition has the least work so
+ * far, which keeps the slowest worker close to the average. Within a partition the tracks
+ * keep the order they were given in, and each remembers its position in the whole render,
+ * so the stems can be given the names a single-process render would have used.
+ */
+class StemRenderPlan {
+  public:
+    /**
+     * @brief One track to render a stem of
+     */
+    struct Track {
+        TrackId id = INVALID_TRACK_ID;
+        TrackId root = INVALID_TRACK_ID;  // Top-level ancestor (the track itself if top-level)
+        juce::String name;
+        double weight = 1.0;           // Relative cost of rendering it
+        juce::StringArray audioFiles;  // Files its clips play
+    };
+
+    /**
+     * @brief The tracks one worker renders
+     */
+    struct Partition {
+        std::vector<TrackId> trackIds;  // In render order
+        std::vector<int> stemNumbers;   // 1-based position of each track in the whole render
+        juce::StringArray trackNames;
+        juce::StringArray audioFiles;  // Every file the tracks play, for shipping to a node
+        double weight = 0.0;
+    };
+
+    /**
+     * @param tracks In render order: stem numbers are positions in this list
+     * @param maxPartitions At most this many partitions are made (at least one)
+     * @return Non-empty partitions, heaviest first; none for no tracks
+     */
+    static std::vector<Partition> partition(const std::vector<Track>& tracks, int maxPartitions);
+};
+
+}  // namespace magda
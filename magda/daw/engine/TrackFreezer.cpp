@@ -0,0 +1,164 @@
+#include "TrackFreezer.hpp"
+
+#include "../audio/AudioBridge.hpp"
+#include "../core/TrackManager.hpp"
+#include "OfflineRenderer.hpp"
+
+namespace magda {
+
+TrackFreezer::TrackFreezer(te::Edit& edit, AudioBridge& bridge, OfflineRenderer& renderer)
+    : edit_(edit),
+      bridge_(bridge),
+      renderer_(renderer),
+      root_(juce::File::getSpecialLocation(juce::File::tempDirectory)
+                .getChildFile("MAGDA Freeze")
+                .getNonexistentChildFile("session", "", false)) {}
+
+TrackFreezer::~TrackFreezer() {
+    *alive_ = false;
+
+    for (auto& [trackId, freeze] : freezes_) {
+        if (freeze.frozen) {
+            bridge_.clearTrackFrozen(trackId);
+        } else {
+            renderer_.cancel(freeze.jobId);
+            restoreAfterRender(trackId, freeze);
+        }
+    }
+    freezes_.clear();
+    root_.deleteRecursively();
+}
+
+bool TrackFreezer::freeze(TrackId trackId, bool reportState) {
+    auto* track = bridge_.getAudioTrack(trackId);
+    if (track == nullptr || freezes_.count(trackId) != 0) {
+        return false;
+    }
+
+    const double length = edit_.getLength().inSeconds();
+    if (length <= 0.0) {
+        return false;
+    }
+
+    Freeze freeze;
+    freeze.reportState = reportState;
+    freeze.directory = root_.getChildFile("track_" + juce::String(trackId) + "_" +
+                                          juce::String(nextRenderId_++));
+
+    RenderInterface::RenderRequest request;
+    request.output_path = freeze.directory.getFullPathName().toStdString();
+    request.start_seconds = 0.0;
+    request.end_seconds = length + kTailSeconds;
+    request.stems = true;
+    request.track_ids = {std::to_string(trackId)};
+    request.bit_depth = 32;
+    if (auto* device = edit_.engine.getDeviceManager().deviceManager.getCurrentAudioDevice()) {
+        request.sample_rate = device->getCurrentSampleRate();
+    }
+
+    // Render before the fader, and regardless of mute: both still apply once frozen
+    if (auto* fader = track->getVolumePlugin(); fader != nullptr && fader->isEnabled()) {
+        freeze.disabledFader = fader;
+        fader->setEnabled(false);
+    }
+    if (track->isMuted(false)) {
+        freeze.unmuted = true;
+        track->setMute(false);
+    }
+
+    freeze.jobId = renderer_.startRender(
+        request, [this, alive = alive_, trackId](const std::string& jobId) {
+            if (*alive) {
+                renderFinished(trackId, jobId);
+            }
+        });
+
+    if (renderer_.getStatus(freeze.jobId) == RenderInterface::RenderStatus::Failed) {
+        DBG("TrackFreezer: can't render track " << trackId << ": "
+                                                << renderer_.getError(freeze.jobId));
+        restoreAfterRender(trackId, freeze);
+        return false;
+    }
+
+    freezes_[trackId] = std::move(freeze);
+    return true;
+}
+
+void TrackFreezer::unfreeze(TrackId trackId) {
+    const auto it = freezes_.find(trackId);
+    if (it == freezes_.end()) {
+        return;
+    }
+
+    auto& freeze = it->second;
+    if (freeze.frozen) {
+        bridge_.clearTrackFrozen(trackId);
+        freeze.directory.deleteRecursively();
+    } else {
+        // The job deletes its partial file; the empty directory goes with root_
+        renderer_.cancel(freeze.jobId);
+        restoreAfterRender(trackId, freeze);
+    }
+    freezes_.erase(it);
+}
+
+bool TrackFreezer::isFreezing(TrackId trackId) const {
+    const auto it = freezes_.find(trackId);
+    return it != freezes_.end() && !it->second.frozen;
+}
+
+bool TrackFreezer::isFrozen(TrackId trackId) const {
+    const auto it = freezes_.find(trackId);
+    return it != freezes_.end() && it->second.frozen;
+}
+
+void TrackFreezer::renderFinished(TrackId trackId, const std::string& jobId) {
+    const auto it = freezes_.find(trackId);
+    if (it == freezes_.end() || it->second.jobId != jobId) {
+        return;  // Unfrozen while rendering
+    }
+
+    auto& freeze = it->second;
+    restoreAfterRender(trackId, freeze);
+
+    const auto files = renderer_.getRenderedFiles(jobId);
+    if (renderer_.getStatus(jobId) == RenderInterface::RenderStatus::Finished &&
+        files.size() == 1) {
+        bridge_.setTrackFrozen(trackId, juce::File(files.front()), 0.0);
+    }
+
+    if (bridge_.isTrackFrozen(trackId)) {
+        freeze.frozen = true;
+        if (freeze.reportState) {
+            TrackManager::getInstance().setTrackFreezeState(trackId, FreezeState::Frozen);
+        }
+    } else {
+        DBG("TrackFreezer: render failed for track " << trackId << ": "
+                                                     << renderer_.getError(jobId));
+        const bool reportState = freeze.reportState;
+        freeze.directory.deleteRecursively();
+        freezes_.erase(it);
+        if (reportState) {
+            TrackManager::getInstance().setTrackFreezeState(trackId, FreezeState::Unfrozen);
+        }
+    }
+}
+
+void TrackFreezer::restoreAfterRender(TrackId trackId, Freeze& freeze) {
+    if (freeze.disabledFader != nullptr) {
+        freeze.disabledFader->setEnabled(true);
+        freeze.disabledFader = nullptr;
+    }
+
+    // From the model, in case the track was unmuted while rendering
+    if (freeze.unmuted) {
+        freeze.unmuted = false;
+        auto* track = bridge_.getAudioTrack(trackId);
+        const auto* info = TrackManager::getInstance().getTrack(trackId);
+        if (track != nullptr && info != nullptr) {
+            track->setMute(info->muted);
+        }
+    }
+}
+
+}  // namespace magda
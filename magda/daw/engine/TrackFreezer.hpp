@@ -0,0 +1,81 @@
+#pragma once
+
+#include <tracktion_engine/tracktion_engine.h>
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include "../core/TypeIds.hpp"
+
+namespace magda {
+
+namespace te = tracktion;
+
+class AudioBridge;
+class OfflineRenderer;
+
+/**
+ * @brief Freezes tracks: renders a track's chain through OfflineRenderer, then has
+ *        AudioBridge play the render in place of the track's clips and plugins
+ *
+ * The render is taken before the fader (VolumeAndPan is disabled while it runs) and
+ * written as 32-bit float, so the fader, pan and mute still apply to the frozen track and
+ * a hot chain can't clip. Renders cover the arrangement plus a tail for reverbs and delays,
+ * and live in a temporary directory that is removed on unfreeze and on destruction.
+ *
+ * Freeze state is reported through TrackManager::setTrackFreezeState(). Message thread only.
+ */
+class TrackFreezer {
+  public:
+    TrackFreezer(te::Edit& edit, AudioBridge& bridge, OfflineRenderer& renderer);
+
+    /**
+     * @brief Unfreezes every track and deletes the renders (destroy before the renderer)
+     */
+    ~TrackFreezer();
+
+    /**
+     * @brief Queue the track's freeze render
+     * @param reportState False for a freeze TrackManager shouldn't show (see TrackPreRenderer)
+     * @return False if the track isn't in the engine, is already frozen or freezing, or the
+     *         arrangement is empty
+     */
+    bool freeze(TrackId trackId, bool reportState = true);
+
+    /**
+     * @brief Back to live playback, cancelling the render if it hasn't finished
+     */
+    void unfreeze(TrackId trackId);
+
+    bool isFreezing(TrackId trackId) const;
+    bool isFrozen(TrackId trackId) const;
+
+    // Rendered past the end of the arrangement so tails aren't cut off
+    static constexpr double kTailSeconds = 2.0;
+
+  private:
+    struct Freeze {
+        std::string jobId;
+        juce::File directory;
+        bool frozen = false;
+        bool reportState = true;
+
+        // Undone when the render ends
+        te::Plugin::Ptr disabledFader;
+        bool unmuted = false;
+    };
+
+    te::Edit& edit_;
+    AudioBridge& bridge_;
+    OfflineRenderer& renderer_;
+    juce::File root_;  // This session's renders
+    int nextRenderId_ = 1;
+    std::map<TrackId, Freeze> freezes_;
+    std::shared_ptr<bool> alive_ = std::make_shared<bool>(true);  // For render callbacks
+
+    void renderFinished(TrackId trackId, const std::string& jobId);
+    void restoreAfterRender(TrackId trackId, Freeze& freeze);
+};
+
+}  // namespace magda
@@ -0,0 +1,274 @@
+#include "TrackPreRenderer.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include "TrackFreezer.hpp"
+
+namespace magda {
+
+namespace {
+
+constexpr int kTimerIntervalMs = 250;
+
+double preRenderNow() {
+    return juce::Time::getMillisecondCounterHiRes() * 0.001;
+}
+
+}  // namespace
+
+TrackPreRenderer::TrackPreRenderer(TrackFreezer& freezer, std::function<bool()> canRender)
+    : freezer_(freezer), canRender_(std::move(canRender)) {
+    TrackManager::getInstance().addListener(this);
+    ClipManager::getInstance().addListener(this);
+}
+
+TrackPreRenderer::~TrackPreRenderer() {
+    stopTimer();
+    ClipManager::getInstance().removeListener(this);
+    TrackManager::getInstance().removeListener(this);
+    setEnabled(false);
+}
+
+void TrackPreRenderer::setEnabled(bool enabled) {
+    if (enabled == enabled_) {
+        return;
+    }
+    enabled_ = enabled;
+
+    if (enabled_) {
+        scheduleAll();
+        startTimer(kTimerIntervalMs);
+    } else {
+        stopTimer();
+        dueAt_.clear();
+        const auto ids = preRendered_;
+        for (const auto trackId : ids) {
+            drop(trackId);
+        }
+    }
+}
+
+void TrackPreRenderer::release(TrackId trackId) {
+    drop(trackId);
+    dueAt_.erase(trackId);
+}
+
+void TrackPreRenderer::invalidateAll() {
+    const auto ids = preRendered_;
+    for (const auto trackId : ids) {
+        invalidate(trackId);
+    }
+    scheduleAll();
+}
+
+void TrackPreRenderer::cancelRenders() {
+    const auto ids = preRendered_;
+    for (const auto trackId : ids) {
+        if (freezer_.isFreezing(trackId)) {
+            invalidate(trackId);
+        }
+    }
+}
+
+bool TrackPreRenderer::isPreRendered(TrackId trackId) const {
+    return preRendered_.count(trackId) != 0 && freezer_.isFrozen(trackId);
+}
+
+int TrackPreRenderer::getNumPreRendered() const {
+    return static_cast<int>(std::count_if(preRendered_.begin(), preRendered_.end(),
+                                          [this](TrackId id) { return freezer_.isFrozen(id); }));
+}
+
+bool TrackPreRenderer::canPreRender(const TrackInfo& track) {
+    // Buses sum other tracks as they play, and MIDI tracks only pass notes on
+    if (track.type != TrackType::Audio && track.type != TrackType::Instrument) {
+        return false;
+    }
+
+    // Has to answer to what is played now, or is frozen (or freezing) by the user
+    if (track.recordArmed || track.audioInputDevice.isNotEmpty() ||
+        track.midiInputDevice.isNotEmpty() || track.freezeState != FreezeState::Unfrozen) {
+        return false;
+    }
+
+    // Clips alone already stream from disk: only a chain has rendering to save
+    if (track.chainElements.empty()) {
+        return false;
+    }
+
+    // Session clips are launched live, which an arrangement render can't know about
+    const auto& clipManager = ClipManager::getInstance();
+    bool hasClips = false;
+    for (const auto clipId : clipManager.getClipsOnTrack(track.id)) {
+        if (const auto* clip = clipManager.getClip(clipId)) {
+            if (clip->sceneIndex >= 0) {
+                return false;
+            }
+            hasClips = true;
+        }
+    }
+    return hasClips;
+}
+
+// =============================================================================
+// Scheduling
+// =============================================================================
+
+void TrackPreRenderer::schedule(TrackId trackId) {
+    dueAt_[trackId] = preRenderNow() + kSettleSeconds;
+}
+
+void TrackPreRenderer::scheduleAll() {
+    for (const auto& track : TrackManager::getInstance().getTracks()) {
+        refresh(track.id);
+    }
+}
+
+void TrackPreRenderer::drop(TrackId trackId) {
+    if (preRendered_.erase(trackId) != 0) {
+        freezer_.unfreeze(trackId);
+    }
+}
+
+void TrackPreRenderer::invalidate(TrackId trackId) {
+    drop(trackId);
+    if (enabled_) {
+        schedule(trackId);
+    }
+}
+
+void TrackPreRenderer::refresh(TrackId trackId) {
+    if (!enabled_) {
+        return;
+    }
+
+    const auto* track = TrackManager::getInstance().getTrack(trackId);
+    if (track == nullptr || !canPreRender(*track)) {
+        release(trackId);
+    } else if (preRendered_.count(trackId) == 0 && dueAt_.count(trackId) == 0) {
+        schedule(trackId);
+    }
+}
+
+// =============================================================================
+// Edits
+// =============================================================================
+
+void TrackPreRenderer::trackChangesCoalesced(const TrackChangeSet& changes) {
+    if (!enabled_) {
+        return;
+    }
+    if (changes.reset) {
+        invalidateAll();
+        return;
+    }
+
+    for (const auto trackId : changes.removed) {
+        release(trackId);
+    }
+    for (const auto trackId : changes.added) {
+        refresh(trackId);
+    }
+
+    // Fader, pan and mute apply after the render; arming only changes eligibility
+    const auto rendered = TrackDirty::Routing | TrackDirty::Type | TrackDirty::Devices;
+    for (const auto& [trackId, dirty] : changes.modified) {
+        if (hasFlag(dirty, rendered)) {
+            invalidate(trackId);
+        }
+        refresh(trackId);
+    }
+}
+
+void TrackPreRenderer::devicePropertyChanged(DeviceId deviceId) {
+    if (!enabled_) {
+        return;
+    }
+    const auto trackId = TrackManager::getInstance().findDevicePath(deviceId).trackId;
+    if (preRendered_.count(trackId) != 0) {
+        invalidate(trackId);
+    }
+}
+
+void TrackPreRenderer::deviceParameterChanged(DeviceId deviceId, int paramIndex,
+                                              float newValue) {
+    juce::ignoreUnused(paramIndex, newValue);
+    devicePropertyChanged(deviceId);
+}
+
+void TrackPreRenderer::clipChangesCoalesced(const ClipChangeSet& changes) {
+    if (!enabled_) {
+        return;
+    }
+
+    // A removed clip, or one moved off its track, no longer says which track it was on
+    bool invalidateEverything = changes.reset || !changes.removed.empty();
+
+    std::vector<TrackId> tracks;
+    const auto& clipManager = ClipManager::getInstance();
+    for (const auto clipId : changes.added) {
+        if (const auto* clip = clipManager.getClip(clipId)) {
+            tracks.push_back(clip->trackId);
+        }
+    }
+    for (const auto& [clipId, dirty] : changes.modified) {
+        if (dirty == ClipDirty::Appearance) {
+            continue;
+        }
+        invalidateEverything = invalidateEverything || hasFlag(dirty, ClipDirty::Track);
+        if (const auto* clip = clipManager.getClip(clipId)) {
+            tracks.push_back(clip->trackId);
+        }
+    }
+
+    if (invalidateEverything) {
+        invalidateAll();
+        return;
+    }
+    for (const auto trackId : tracks) {
+        invalidate(trackId);
+        refresh(trackId);
+    }
+}
+
+// =============================================================================
+// Rendering
+// =============================================================================
+
+void TrackPreRenderer::timerCallback() {
+    // A failed render leaves the freezer: the track stays live until it is next edited
+    for (auto it = preRendered_.begin(); it != preRendered_.end();) {
+        if (!freezer_.isFreezing(*it) && !freezer_.isFrozen(*it)) {
+            it = preRendered_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    const double now = preRenderNow();
+    if (canRender_ && !canRender_()) {
+        // Start counting the settle time again once the transport stops
+        for (auto& [trackId, due] : dueAt_) {
+            due = std::max(due, now + kSettleSeconds);
+        }
+        return;
+    }
+
+    for (auto it = dueAt_.begin(); it != dueAt_.end();) {
+        if (it->second > now) {
+            ++it;
+            continue;
+        }
+
+        const auto trackId = it->first;
+        it = dueAt_.erase(it);
+
+        const auto* track = TrackManager::getInstance().getTrack(trackId);
+        if (track != nullptr && canPreRender(*track) && freezer_.freeze(trackId, false)) {
+            preRendered_.insert(trackId);
+        }
+    }
+}
+
+}  // namespace magda
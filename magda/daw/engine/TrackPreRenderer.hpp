@@ -0,0 +1,112 @@
+#pragma once
+
+#include <juce_events/juce_events.h>
+
+#include <functional>
+#include <map>
+#include <set>
+
+#include "../core/ClipManager.hpp"
+#include "../core/TrackManager.hpp"
+
+namespace magda {
+
+class TrackFreezer;
+
+/**
+ * @brief Renders ahead the tracks that don't have to answer live, while Live mode is on
+ *
+ * A track that isn't armed, takes no input and plays only arrangement clips sounds the
+ * same on every pass, so it gains nothing from rendering in the device's small blocks.
+ * While enabled, each such track is frozen quietly through TrackFreezer: the chain renders
+ * on the offline renderer's thread in large blocks, and the track then plays the render,
+ * which the engine streams from disk through its read-ahead cache. Only armed, monitored,
+ * session and bus tracks keep rendering block by block.
+ *
+ * Any edit to a pre-rendered track, its devices or its clips, and any tempo change, drops
+ * the render at once so the edit is heard, and the track is rendered again once edits have
+ * settled. Offline renders stop the transport, so they are only started while it is
+ * stopped, and play() cancels any still running (see cancelRenders()).
+ *
+ * Pre-renders aren't shown as frozen, and a user freeze takes over from one. Message thread
+ * only.
+ */
+class TrackPreRenderer : private TrackManagerListener,
+                         private ClipManagerListener,
+                         private juce::Timer {
+  public:
+    /**
+     * @param canRender True while a render may start (the transport is stopped)
+     */
+    TrackPreRenderer(TrackFreezer& freezer, std::function<bool()> canRender);
+
+    /**
+     * @brief Drops every pre-render (destroy before the freezer)
+     */
+    ~TrackPreRenderer() override;
+
+    /**
+     * @brief Start pre-rendering eligible tracks, or put every track back to live rendering
+     */
+    void setEnabled(bool enabled);
+    bool isEnabled() const {
+        return enabled_;
+    }
+
+    /**
+     * @brief Back to live rendering for good, e.g. before the user freezes the track
+     */
+    void release(TrackId trackId);
+
+    /**
+     * @brief Drop every pre-render and render them again once edits settle
+     */
+    void invalidateAll();
+
+    /**
+     * @brief Cancel renders that haven't finished; they are queued again later
+     */
+    void cancelRenders();
+
+    /**
+     * @brief True once the track plays its pre-render
+     */
+    bool isPreRendered(TrackId trackId) const;
+    int getNumPreRendered() const;
+
+    /**
+     * @brief Whether a track renders the same on every pass, so can be rendered ahead
+     */
+    static bool canPreRender(const TrackInfo& track);
+
+    // Quiet time after the last edit (and after the transport stops) before rendering
+    static constexpr double kSettleSeconds = 2.0;
+
+  private:
+    TrackFreezer& freezer_;
+    std::function<bool()> canRender_;
+    bool enabled_ = false;
+
+    std::set<TrackId> preRendered_;    // Rendering, or playing the render
+    std::map<TrackId, double> dueAt_;  // Waiting to render, in seconds (hi-res counter)
+
+    void schedule(TrackId trackId);
+    void scheduleAll();
+    void drop(TrackId trackId);
+    void invalidate(TrackId trackId);
+    void refresh(TrackId trackId);
+
+    // TrackManagerListener
+    void tracksChanged() override {}
+    void trackChangesCoalesced(const TrackChangeSet& changes) override;
+    void devicePropertyChanged(DeviceId deviceId) override;
+    void deviceParameterChanged(DeviceId deviceId, int paramIndex, float newValue) override;
+
+    // ClipManagerListener
+    void clipsChanged() override {}
+    void clipChangesCoalesced(const ClipChangeSet& changes) override;
+
+    void timerCallback() override;
+};
+
+}  // namespace magda
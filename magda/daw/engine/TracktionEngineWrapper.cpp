@@ -1,19 +1,124 @@
 #include "TracktionEngineWrapper.hpp"
 
+#include <algorithm>
+#include <cstdlib>
 #include <iostream>
+#include <optional>
+#include <set>
+#include <utility>
 
 #include "../audio/AudioBridge.hpp"
+#include "../audio/AudioEngineOptimizer.hpp"
+#include "../audio/DeviceTimingProbePlugin.hpp"
 #include "../audio/MidiBridge.hpp"
+#include "../audio/MidiTakeRecorder.hpp"
+#include "../audio/NotePreviewPlugin.hpp"
+#include "../audio/RenderThreadPolicy.hpp"
+#include "../audio/SandboxedPlugin.hpp"
+#include "../audio/TrackMeterPlugin.hpp"
 #include "../core/Config.hpp"
 #include "../core/DeviceInfo.hpp"
+#include "../core/ProjectManager.hpp"
+#include "../core/StartupCache.hpp"
 #include "../core/TrackManager.hpp"
+#include "../profiling/LoadProfiler.hpp"
+#include "MagdaEngineBehaviour.hpp"
 #include "MagdaUIBehaviour.hpp"
+#include "OfflineRenderer.hpp"
 #include "PluginScanCoordinator.hpp"
 #include "PluginWindowManager.hpp"
+#include "TrackFreezer.hpp"
+#include "TrackPreRenderer.hpp"
 
 namespace magda {
 
-TracktionEngineWrapper::TracktionEngineWrapper() = default;
+namespace {
+// Samples per file the engine's AudioFileCache keeps mapped (about a minute at 48 kHz)
+constexpr juce::int64 AUDIO_FILE_CACHE_SAMPLES = 48000 * 60;
+
+const char* const PLUGIN_LIST_CACHE_SECTION = "PluginList";
+
+// The known plugin list as the startup cache keeps it: the blacklist, then each description
+void writePluginList(juce::MemoryOutputStream& out, const juce::KnownPluginList& list) {
+    const auto blacklist = list.getBlacklistedFiles();
+    out.writeInt(blacklist.size());
+    for (const auto& file : blacklist) {
+        out.writeString(file);
+    }
+
+    const auto types = list.getTypes();
+    out.writeInt(types.size());
+    for (const auto& type : types) {
+        for (const auto* text : {&type.name, &type.descriptiveName, &type.pluginFormatName,
+                                 &type.category, &type.manufacturerName, &type.version,
+                                 &type.fileOrIdentifier}) {
+            out.writeString(*text);
+        }
+        out.writeInt64(type.lastFileModTime.toMilliseconds());
+        out.writeInt64(type.lastInfoUpdateTime.toMilliseconds());
+        out.writeInt(type.deprecatedUid);
+        out.writeInt(type.uniqueId);
+        out.writeInt(type.numInputChannels);
+        out.writeInt(type.numOutputChannels);
+        out.writeBool(type.isInstrument);
+        out.writeBool(type.hasSharedContainer);
+        out.writeBool(type.hasARAExtension);
+    }
+}
+
+// Replaces list with what writePluginList() wrote; leaves it alone unless all of it reads
+bool readPluginList(const StartupCache::Section& section, juce::KnownPluginList& list) {
+    juce::MemoryInputStream in(section.data, section.size, false);
+    auto count = [&in] {
+        const int n = in.readInt();
+        return n >= 0 && n <= in.getNumBytesRemaining() ? n : -1;
+    };
+
+    juce::StringArray blacklist;
+    const int numBlacklisted = count();
+    for (int i = 0; i < numBlacklisted; ++i) {
+        blacklist.add(in.readString());
+    }
+
+    juce::Array<juce::PluginDescription> types;
+    const int numTypes = count();
+    for (int i = 0; i < numTypes; ++i) {
+        juce::PluginDescription type;
+        for (auto* text : {&type.name, &type.descriptiveName, &type.pluginFormatName,
+                           &type.category, &type.manufacturerName, &type.version,
+                           &type.fileOrIdentifier}) {
+            *text = in.readString();
+        }
+        type.lastFileModTime = juce::Time(in.readInt64());
+        type.lastInfoUpdateTime = juce::Time(in.readInt64());
+        type.deprecatedUid = in.readInt();
+        type.uniqueId = in.readInt();
+        type.numInputChannels = in.readInt();
+        type.numOutputChannels = in.readInt();
+        type.isInstrument = in.readBool();
+        type.hasSharedContainer = in.readBool();
+        type.hasARAExtension = in.readBool();
+        types.add(type);
+    }
+
+    if (numBlacklisted < 0 || numTypes < 0 ||
+        in.getPosition() != static_cast<juce::int64>(section.size)) {
+        return false;
+    }
+
+    list.clear();
+    list.clearBlacklistedFiles();
+    for (const auto& type : types) {
+        list.addType(type);
+    }
+    for (const auto& file : blacklist) {
+        list.addToBlacklist(file);
+    }
+    return true;
+}
+}  // namespace
+
+TracktionEngineWrapper::TracktionEngineWrapper(Mode mode) : mode_(mode) {}
 
 TracktionEngineWrapper::~TracktionEngineWrapper() {
     shutdown();
@@ -21,13 +126,40 @@ TracktionEngineWrapper::~TracktionEngineWrapper() {
 
 bool TracktionEngineWrapper::initialize() {
     try {
+        // Startup phases, one after the next (see LoadProfiler)
+        std::optional<LoadProfiler::ScopedPhase> phase;
+        phase.emplace("Engine construction");
+
         // Initialize Tracktion Engine with custom UIBehaviour for plugin windows
-        auto uiBehaviour = std::make_unique<MagdaUIBehaviour>();
-        engine_ = std::make_unique<tracktion::Engine>("MAGDA", std::move(uiBehaviour), nullptr);
+        // A headless engine has no windows to open plugin editors in
+        auto uiBehaviour = mode_ == Mode::Interactive
+                               ? std::make_unique<MagdaUIBehaviour>()
+                               : std::make_unique<tracktion::UIBehaviour>();
+        auto engineBehaviour = std::make_unique<MagdaEngineBehaviour>();
+        engineBehaviour_ = engineBehaviour.get();
+        engine_ = std::make_unique<tracktion::Engine>("MAGDA", std::move(uiBehaviour),
+                                                      std::move(engineBehaviour));
 
         // Register ToneGeneratorPlugin (not registered by default)
         engine_->getPluginManager().createBuiltInType<tracktion::ToneGeneratorPlugin>();
 
+        // Track level meter that publishes levels from the audio thread
+        engine_->getPluginManager().createBuiltInType<TrackMeterPlugin>();
+
+        // Times devices while per-device CPU measurement is on (see AudioBridge)
+        engine_->getPluginManager().createBuiltInType<DeviceTimingProbePlugin>();
+
+        // Plays auditioned notes at the head of each track (see AudioBridge::previewNote)
+        engine_->getPluginManager().createBuiltInType<NotePreviewPlugin>();
+
+        // Stands in for plugins run in a separate process (see SandboxHost)
+        engine_->getPluginManager().createBuiltInType<SandboxedPlugin>();
+
+        // Clip playback reads through the AudioFileCache, which memory-maps uncompressed
+        // files in windows of this many samples. A wide window means scrubbing and jumping
+        // around a clip rarely has to remap
+        engine_->getAudioFileManager().cache.setCacheSizeSamples(AUDIO_FILE_CACHE_SAMPLES);
+
         // Register external plugin formats (VST3, AU)
         auto& pluginManager = engine_->getPluginManager();
         auto& formatManager = pluginManager.pluginFormatManager;
@@ -38,6 +170,7 @@ bool TracktionEngineWrapper::initialize() {
         std::cout << "Enabled out-of-process plugin scanning" << std::endl;
 
         // Load saved plugin list from persistent storage
+        phase.emplace("Plugin list");
         loadPluginList();
 
         // Note: Tracktion Engine automatically registers plugin formats (VST3, AU, etc.)
@@ -52,146 +185,17 @@ bool TracktionEngineWrapper::initialize() {
             }
         }
 
-        // Initialize the DeviceManager FIRST - this creates MIDI device wrappers
-        // Parameters: default number of input channels, default number of output channels
-        auto& dm = engine_->getDeviceManager();
-
-        // Get JUCE's AudioDeviceManager to access device list
-        auto& juceDeviceManager = dm.deviceManager;
-
-        // Log available audio device types (CoreAudio on macOS)
-        DBG("Available audio device types:");
-        for (auto* type : juceDeviceManager.getAvailableDeviceTypes()) {
-            DBG("  - " << type->getTypeName());
-
-            // Log devices for each type
-            type->scanForDevices();
-            auto inputNames = type->getDeviceNames(true);    // inputs
-            auto outputNames = type->getDeviceNames(false);  // outputs
-
-            DBG("    Input devices:");
-            for (const auto& name : inputNames) {
-                DBG("      - " << name);
-            }
-            DBG("    Output devices:");
-            for (const auto& name : outputNames) {
-                DBG("      - " << name);
-            }
-        }
-
-        // Get user's preferred audio device settings from Config
-        auto& config = magda::Config::getInstance();
-        std::string preferredInputDevice = config.getPreferredInputDevice();
-        std::string preferredOutputDevice = config.getPreferredOutputDevice();
-        int preferredInputs = config.getPreferredInputChannels();
-        int preferredOutputs = config.getPreferredOutputChannels();
-
-        // Initialize DeviceManager with preferred channel counts
-        // If preference is 0, use system defaults (0, 2)
-        int inputChannels = (preferredInputs > 0) ? preferredInputs : 0;
-        int outputChannels = (preferredOutputs > 0) ? preferredOutputs : 2;
-        dm.initialise(inputChannels, outputChannels);
-        DBG("DeviceManager initialized with " << inputChannels << " input / " << outputChannels
-                                              << " output channels");
-
-        // Try to select preferred audio devices if specified
-        if (!preferredInputDevice.empty() || !preferredOutputDevice.empty()) {
-            auto& deviceTypes = juceDeviceManager.getAvailableDeviceTypes();
-            if (!deviceTypes.isEmpty()) {
-                auto* deviceType = deviceTypes[0];  // Use first available type (CoreAudio on macOS)
-                deviceType->scanForDevices();
-
-                auto outputDevices = deviceType->getDeviceNames(false);  // outputs
-                auto inputDevices = deviceType->getDeviceNames(true);    // inputs
-
-                juce::AudioDeviceManager::AudioDeviceSetup setup;
-                juceDeviceManager.getAudioDeviceSetup(setup);
-
-                // Set input device if specified
-                if (!preferredInputDevice.empty() && inputDevices.contains(preferredInputDevice)) {
-                    setup.inputDeviceName = preferredInputDevice;
-                    DBG("Found preferred input device: " << preferredInputDevice);
-                }
-
-                // Set output device if specified
-                if (!preferredOutputDevice.empty() &&
-                    outputDevices.contains(preferredOutputDevice)) {
-                    setup.outputDeviceName = preferredOutputDevice;
-                    DBG("Found preferred output device: " << preferredOutputDevice);
-                }
-
-                // Enable channels based on preference
-                // Only override channel configuration if user specified a preference (> 0)
-                // Otherwise, keep the existing channel setup (device defaults)
-                if (preferredInputs > 0) {
-                    setup.inputChannels.clear();
-                    for (int i = 0; i < preferredInputs; ++i) {
-                        setup.inputChannels.setBit(i, true);
-                    }
-                }
-
-                if (preferredOutputs > 0) {
-                    setup.outputChannels.clear();
-                    for (int i = 0; i < preferredOutputs; ++i) {
-                        setup.outputChannels.setBit(i, true);
-                    }
-                }
-
-                // Try to set the devices
-                auto result = juceDeviceManager.setAudioDeviceSetup(setup, true);
-                if (result.isEmpty()) {
-                    DBG("Successfully selected preferred devices - Input: "
-                        << setup.inputDeviceName << " (" << preferredInputs << " ch), Output: "
-                        << setup.outputDeviceName << " (" << preferredOutputs << " ch)");
-                } else {
-                    DBG("Failed to select preferred devices: " << result);
-                }
-            }
-        }
-
-        // Log currently selected device
-        if (auto* currentDevice = juceDeviceManager.getCurrentAudioDevice()) {
-            DBG("Current audio device: " + currentDevice->getName());
-            DBG("  Type: " + currentDevice->getTypeName());
-            DBG("  Sample rate: " + juce::String(currentDevice->getCurrentSampleRate()));
-            DBG("  Buffer size: " + juce::String(currentDevice->getCurrentBufferSizeSamples()));
-            DBG("  Input channels: " + juce::String(currentDevice->getInputChannelNames().size()));
-            DBG("  Output channels: " +
-                juce::String(currentDevice->getOutputChannelNames().size()));
-        } else {
-            DBG("WARNING: No audio device selected!");
-        }
-
-        // Enable MIDI devices at JUCE level - this must be done so TE picks them up
-        auto midiInputs = juce::MidiInput::getAvailableDevices();
-        DBG("JUCE MIDI inputs available: " << midiInputs.size());
-        for (const auto& midiInput : midiInputs) {
-            if (!juceDeviceManager.isMidiInputDeviceEnabled(midiInput.identifier)) {
-                juceDeviceManager.setMidiInputDeviceEnabled(midiInput.identifier, true);
-                DBG("Enabled JUCE MIDI input: " << midiInput.name);
-            }
-        }
-
-        // Listen for device manager changes BEFORE triggering rescan
-        // This ensures we catch the notification when MIDI devices are created
-        dm.addChangeListener(this);
-
-        // Trigger a rescan so TE picks up the newly enabled MIDI devices
-        // Note: The rescan is asynchronous (uses a timer). MIDI devices will be
-        // created later and we'll be notified via changeListenerCallback.
-        dm.rescanMidiDeviceList();
-        DBG("MIDI device rescan triggered (async, listener registered)");
-        for (auto& midiInput : dm.getMidiInDevices()) {
-            if (midiInput && !midiInput->isEnabled()) {
-                midiInput->setEnabled(true);
-                DBG("Enabled TE MIDI input device: " << midiInput->getName());
-            }
+        // Render nodes have no sound card or MIDI ports; a headless engine opens neither
+        phase.reset();
+        if (mode_ == Mode::Interactive) {
+            openDevices();
         }
 
         // Note: Audio inputs are now enabled by default (changed from previous behavior)
         // Users can configure them via Audio Settings dialog
 
         // Create a temporary Edit (project) so transport methods work
+        phase.emplace("Edit");
         auto editFile = juce::File::getSpecialLocation(juce::File::tempDirectory)
                             .getChildFile("magda_temp.tracktionedit");
 
@@ -217,34 +221,77 @@ bool TracktionEngineWrapper::initialize() {
 
             // Ensure the playback context is created and graph is allocated
             // This is needed for MIDI routing to work even before pressing play
-            currentEdit_->getTransport().ensureContextAllocated();
-            if (auto* ctx = currentEdit_->getCurrentPlaybackContext()) {
-                DBG("Playback context allocated for live MIDI monitoring");
-                DBG("  Total inputs in context: " << ctx->getAllInputs().size());
-            } else {
-                DBG("WARNING: ensureContextAllocated() called but context is still null!");
+            if (mode_ == Mode::Interactive) {
+                currentEdit_->getTransport().ensureContextAllocated();
+                if (auto* ctx = currentEdit_->getCurrentPlaybackContext()) {
+                    DBG("Playback context allocated for live MIDI monitoring");
+                    DBG("  Total inputs in context: " << ctx->getAllInputs().size());
+                } else {
+                    DBG("WARNING: ensureContextAllocated() called but context is still null!");
+                }
             }
 
             // Create AudioBridge for TrackManager-to-Tracktion synchronization
+            phase.emplace("Engine sync");
             audioBridge_ = std::make_unique<AudioBridge>(*engine_, *currentEdit_);
             audioBridge_->syncAll();
-
-            // Create PluginWindowManager for safe window lifecycle
-            // Must be created AFTER AudioBridge, destroyed BEFORE AudioBridge
-            pluginWindowManager_ = std::make_unique<PluginWindowManager>(*engine_, *currentEdit_);
-
-            // Tell AudioBridge about the window manager and engine wrapper for delegation
-            audioBridge_->setPluginWindowManager(pluginWindowManager_.get());
+            phase.reset();
             audioBridge_->setEngineWrapper(this);
 
-            // Enable all MIDI input devices (redundant now but keeps the API consistent)
-            audioBridge_->enableAllMidiInputDevices();
+            // Live playback only: with no device there is no callback, no plugin window to
+            // show, no MIDI port to route and no view mode to follow
+            if (mode_ == Mode::Interactive) {
+                // Per-block hook for parameter changes and modulation (runs alongside
+                // Tracktion)
+                engine_->getDeviceManager().deviceManager.addAudioCallback(audioBridge_.get());
+
+                // Create PluginWindowManager for safe window lifecycle
+                // Must be created AFTER AudioBridge, destroyed BEFORE AudioBridge
+                pluginWindowManager_ =
+                    std::make_unique<PluginWindowManager>(*engine_, *currentEdit_);
+                audioBridge_->setPluginWindowManager(pluginWindowManager_.get());
+
+                // Enable all MIDI input devices (redundant now but keeps the API consistent)
+                audioBridge_->enableAllMidiInputDevices();
+
+                // Count insertions and keep the most-used plugins instantiated in advance
+                audioBridge_->onExternalPluginLoaded =
+                    [this](const juce::PluginDescription& description) {
+                        pluginUsage_.recordUse(description.createIdentifierString());
+                        updateWarmPlugins();
+                    };
+                updateWarmPlugins();
+
+                // Recording starts once the bridge has clicked the count-in
+                audioBridge_->onCountInFinished = [this] {
+                    if (countingIn_) {
+                        countingIn_ = false;
+                        startRecording();
+                    }
+                };
+
+                // Create MidiBridge for MIDI device management
+                midiBridge_ = std::make_unique<MidiBridge>(*engine_);
 
-            // Create MidiBridge for MIDI device management
-            midiBridge_ = std::make_unique<MidiBridge>(*engine_);
+                // Connect MidiBridge to AudioBridge for MIDI activity monitoring
+                midiBridge_->setAudioBridge(audioBridge_.get());
+                midiTakeRecorder_ = std::make_unique<MidiTakeRecorder>(*midiBridge_);
 
-            // Connect MidiBridge to AudioBridge for MIDI activity monitoring
-            midiBridge_->setAudioBridge(audioBridge_.get());
+                // Apply each view mode's audio profile from here on (the device keeps the
+                // user's settings until the first mode switch)
+                audioEngineOptimizer_ = std::make_unique<AudioEngineOptimizer>(*this);
+            }
+            applyRenderThreadSettings();
+
+            offlineRenderer_ = std::make_unique<OfflineRenderer>(
+                *currentEdit_, audioBridge_.get(), engineBehaviour_);
+            trackFreezer_ =
+                std::make_unique<TrackFreezer>(*currentEdit_, *audioBridge_, *offlineRenderer_);
+            if (mode_ == Mode::Interactive) {
+                trackPreRenderer_ = std::make_unique<TrackPreRenderer>(
+                    *trackFreezer_, [this] { return !isPlaying() && !isRecording(); });
+                updatePreRendering();
+            }
 
             // Note: Change listener was already registered earlier (before MIDI rescan)
 
@@ -268,9 +315,159 @@ bool TracktionEngineWrapper::initialize() {
     }
 }
 
+void TracktionEngineWrapper::openDevices() {
+    std::optional<LoadProfiler::ScopedPhase> phase;
+    // Initialize the DeviceManager FIRST - this creates MIDI device wrappers
+    phase.emplace("Audio devices");
+    // Parameters: default number of input channels, default number of output channels
+    auto& dm = engine_->getDeviceManager();
+
+    // Get JUCE's AudioDeviceManager to access device list
+    auto& juceDeviceManager = dm.deviceManager;
+
+    // Log available audio device types (CoreAudio on macOS)
+    DBG("Available audio device types:");
+    for (auto* type : juceDeviceManager.getAvailableDeviceTypes()) {
+        DBG("  - " << type->getTypeName());
+
+        // Log devices for each type
+        type->scanForDevices();
+        auto inputNames = type->getDeviceNames(true);    // inputs
+        auto outputNames = type->getDeviceNames(false);  // outputs
+
+        DBG("    Input devices:");
+        for (const auto& name : inputNames) {
+            DBG("      - " << name);
+        }
+        DBG("    Output devices:");
+        for (const auto& name : outputNames) {
+            DBG("      - " << name);
+        }
+    }
+
+    // Get user's preferred audio device settings from Config
+    auto& config = magda::Config::getInstance();
+    std::string preferredInputDevice = config.getPreferredInputDevice();
+    std::string preferredOutputDevice = config.getPreferredOutputDevice();
+    int preferredInputs = config.getPreferredInputChannels();
+    int preferredOutputs = config.getPreferredOutputChannels();
+
+    // Initialize DeviceManager with preferred channel counts
+    // If preference is 0, use system defaults (0, 2)
+    int inputChannels = (preferredInputs > 0) ? preferredInputs : 0;
+    int outputChannels = (preferredOutputs > 0) ? preferredOutputs : 2;
+    dm.initialise(inputChannels, outputChannels);
+    DBG("DeviceManager initialized with " << inputChannels << " input / " << outputChannels
+                                          << " output channels");
+
+    // Try to select preferred audio devices if specified
+    if (!preferredInputDevice.empty() || !preferredOutputDevice.empty()) {
+        auto& deviceTypes = juceDeviceManager.getAvailableDeviceTypes();
+        if (!deviceTypes.isEmpty()) {
+            auto* deviceType = deviceTypes[0];  // Use first available type (CoreAudio on macOS)
+            deviceType->scanForDevices();
+
+            auto outputDevices = deviceType->getDeviceNames(false);  // outputs
+            auto inputDevices = deviceType->getDeviceNames(true);    // inputs
+
+            juce::AudioDeviceManager::AudioDeviceSetup setup;
+            juceDeviceManager.getAudioDeviceSetup(setup);
+
+            // Set input device if specified
+            if (!preferredInputDevice.empty() && inputDevices.contains(preferredInputDevice)) {
+                setup.inputDeviceName = preferredInputDevice;
+                DBG("Found preferred input device: " << preferredInputDevice);
+            }
+
+            // Set output device if specified
+            if (!preferredOutputDevice.empty() &&
+                outputDevices.contains(preferredOutputDevice)) {
+                setup.outputDeviceName = preferredOutputDevice;
+                DBG("Found preferred output device: " << preferredOutputDevice);
+            }
+
+            // Enable channels based on preference
+            // Only override channel configuration if user specified a preference (> 0)
+            // Otherwise, keep the existing channel setup (device defaults)
+            if (preferredInputs > 0) {
+                setup.inputChannels.clear();
+                for (int i = 0; i < preferredInputs; ++i) {
+                    setup.inputChannels.setBit(i, true);
+                }
+            }
+
+            if (preferredOutputs > 0) {
+                setup.outputChannels.clear();
+                for (int i = 0; i < preferredOutputs; ++i) {
+                    setup.outputChannels.setBit(i, true);
+                }
+            }
+
+            // Try to set the devices
+            auto result = juceDeviceManager.setAudioDeviceSetup(setup, true);
+            if (result.isEmpty()) {
+                DBG("Successfully selected preferred devices - Input: "
+                    << setup.inputDeviceName << " (" << preferredInputs << " ch), Output: "
+                    << setup.outputDeviceName << " (" << preferredOutputs << " ch)");
+            } else {
+                DBG("Failed to select preferred devices: " << result);
+            }
+        }
+    }
+
+    // Log currently selected device
+    if (auto* currentDevice = juceDeviceManager.getCurrentAudioDevice()) {
+        DBG("Current audio device: " + currentDevice->getName());
+        DBG("  Type: " + currentDevice->getTypeName());
+        DBG("  Sample rate: " + juce::String(currentDevice->getCurrentSampleRate()));
+        DBG("  Buffer size: " + juce::String(currentDevice->getCurrentBufferSizeSamples()));
+        DBG("  Input channels: " + juce::String(currentDevice->getInputChannelNames().size()));
+        DBG("  Output channels: " +
+            juce::String(currentDevice->getOutputChannelNames().size()));
+    } else {
+        DBG("WARNING: No audio device selected!");
+    }
+
+    // Enable MIDI devices at JUCE level - this must be done so TE picks them up
+    phase.emplace("MIDI devices");
+    auto midiInputs = juce::MidiInput::getAvailableDevices();
+    DBG("JUCE MIDI inputs available: " << midiInputs.size());
+    for (const auto& midiInput : midiInputs) {
+        if (!juceDeviceManager.isMidiInputDeviceEnabled(midiInput.identifier)) {
+            juceDeviceManager.setMidiInputDeviceEnabled(midiInput.identifier, true);
+            DBG("Enabled JUCE MIDI input: " << midiInput.name);
+        }
+    }
+
+    // Listen for device manager changes BEFORE triggering rescan
+    // This ensures we catch the notification when MIDI devices are created
+    dm.addChangeListener(this);
+
+    // Trigger a rescan so TE picks up the newly enabled MIDI devices
+    // Note: The rescan is asynchronous (uses a timer). MIDI devices will be
+    // created later and we'll be notified via changeListenerCallback.
+    dm.rescanMidiDeviceList();
+    DBG("MIDI device rescan triggered (async, listener registered)");
+    for (auto& midiInput : dm.getMidiInDevices()) {
+        if (midiInput && !midiInput->isEnabled()) {
+            midiInput->setEnabled(true);
+            DBG("Enabled TE MIDI input device: " << midiInput->getName());
+        }
+    }
+}
+
 void TracktionEngineWrapper::shutdown() {
     std::cout << "TracktionEngineWrapper::shutdown - starting..." << std::endl;
 
+    // Cancel offline renders and wait for them: they read the Edit and the bridge
+    trackPreRenderer_.reset();
+    trackFreezer_.reset();
+    offlineRenderer_.reset();
+
+    // Stop following view modes before the engine goes away
+    audioEngineOptimizer_.reset();
+    pendingAudioProfile_.reset();
+
     // Release test tone plugin first (before Edit is destroyed)
     testTonePlugin_.reset();
 
@@ -287,10 +484,15 @@ void TracktionEngineWrapper::shutdown() {
         pluginWindowManager_.reset();
     }
 
+    savePluginUsage();
+
     // Destroy bridges (they reference Edit and/or Engine)
     if (audioBridge_) {
+        // Blocks until any in-flight callback has returned
+        engine_->getDeviceManager().deviceManager.removeAudioCallback(audioBridge_.get());
         audioBridge_.reset();
     }
+    midiTakeRecorder_.reset();
     if (midiBridge_) {
         midiBridge_.reset();
     }
@@ -320,6 +522,7 @@ void TracktionEngineWrapper::shutdown() {
         dm.closeDevices();
 
         std::cout << "Destroying Tracktion Engine..." << std::endl;
+        engineBehaviour_ = nullptr;
         engine_.reset();
     }
 
@@ -348,18 +551,10 @@ double TracktionEngineWrapper::getGlobalLatencySeconds() const {
         return 0.0;
     }
 
-    // Tracktion Engine calculates PDC automatically and stores max latency
-    // The easiest approach is to iterate all tracks and find max plugin latency
+    // Tracktion Engine delays every track to line up with the most latent chain
     double maxLatency = 0.0;
-
-    for (auto* track : currentEdit_->getTrackList()) {
-        if (auto* audioTrack = dynamic_cast<tracktion::AudioTrack*>(track)) {
-            // Check all plugins on this track
-            for (auto* plugin : audioTrack->pluginList) {
-                // Use base Plugin class method (works for all plugin types)
-                maxLatency = std::max(maxLatency, plugin->getLatencySeconds());
-            }
-        }
+    for (const auto& track : getTrackLatencies()) {
+        maxLatency = std::max(maxLatency, track.seconds);
     }
 
     // Add device latency
@@ -368,6 +563,315 @@ double TracktionEngineWrapper::getGlobalLatencySeconds() const {
     return maxLatency;
 }
 
+std::vector<TracktionEngineWrapper::TrackLatency> TracktionEngineWrapper::getTrackLatencies()
+    const {
+    std::vector<TrackLatency> latencies;
+    if (!currentEdit_ || !audioBridge_) {
+        return latencies;
+    }
+
+    for (const auto& info : TrackManager::getInstance().getTracks()) {
+        auto* track = audioBridge_->getAudioTrack(info.id);
+        if (track == nullptr) {
+            continue;
+        }
+
+        TrackLatency latency;
+        latency.trackId = info.id;
+        latency.name = info.name;
+
+        // The whole plugin list counts; only devices are listed
+        for (auto* plugin : track->pluginList) {
+            if (!latencyBypassed_.contains(plugin->itemID)) {
+                latency.seconds += getPluginLatency(*plugin);
+            }
+        }
+        for (const auto& element : info.chainElements) {
+            if (!isDevice(element)) {
+                continue;
+            }
+            const auto& device = getDevice(element);
+            if (auto plugin = audioBridge_->getPlugin(device.id)) {
+                latency.devices.push_back({device.id, device.name, getPluginLatency(*plugin),
+                                           latencyBypassed_.contains(plugin->itemID)});
+            }
+        }
+
+        latencies.push_back(std::move(latency));
+    }
+    return latencies;
+}
+
+// =============================================================================
+// Audio Profiles
+// =============================================================================
+
+void TracktionEngineWrapper::applyAudioProfile(const AudioEngineProfile& profile) {
+    pendingAudioProfile_ = profile;
+    if (!isPlaying() && !isRecording()) {
+        applyPendingAudioProfile();
+    } else {
+        DBG("Audio profile deferred until the transport stops");
+    }
+}
+
+void TracktionEngineWrapper::applyPendingAudioProfile() {
+    if (!pendingAudioProfile_ || !engine_ || !currentEdit_) {
+        return;
+    }
+    // An offline render has the graph and runs at Final; the profile waits for it to end
+    if (offlineRenderer_ && offlineRenderer_->isRendering()) {
+        return;
+    }
+    const auto profile = *std::exchange(pendingAudioProfile_, std::nullopt);
+
+    // The device first, so the latency plan below sees its new buffer
+    const bool deviceRestarted = setDeviceBufferSize(profile.bufferSize);
+
+    // Render threads and plugin delay compensation both take effect on a graph rebuild
+    multiThreaded_ = profile.multiThreaded;
+    updateRenderThreadCount();
+
+    // Low latency bypasses plugins that report latency instead of delaying everything else
+    // to line up with them (all of them, or just enough to meet the target)
+    lowLatencyMode_ = profile.lowLatencyMode;
+    latencyTargetMs_ = profile.latencyMs;
+    updateLatencyPlan();
+    updatePreRendering();
+
+    // Draft or Final stretching for clips that stretch live (offline renders use Final)
+    if (audioBridge_) {
+        audioBridge_->setRenderQuality(profile.quality);
+    }
+
+    // A device restart already has Tracktion reallocate every playback context (once this
+    // returns to the message loop), which picks up the new threads and plan, so the graph
+    // is only rebuilt once
+    if (deviceRestarted) {
+        graphRebuildPending_ = false;
+    }
+    rebuildGraphIfStopped();
+
+    DBG("Audio profile applied, round trip " << getRoundTripLatencyMs() << " ms");
+}
+
+bool TracktionEngineWrapper::setDeviceBufferSize(int bufferSize) {
+    auto& juceDeviceManager = engine_->getDeviceManager().deviceManager;
+    auto* device = juceDeviceManager.getCurrentAudioDevice();
+    if (!device) {
+        return false;
+    }
+
+    // The closest size the device offers; nothing to do if it's the one it runs at
+    const int current = device->getCurrentBufferSizeSamples();
+    int nearest = current;
+    for (int size : device->getAvailableBufferSizes()) {
+        if (std::abs(size - bufferSize) < std::abs(nearest - bufferSize)) {
+            nearest = size;
+        }
+    }
+    if (nearest == current) {
+        return false;
+    }
+
+    // Only the buffer size differs from the running setup, so the same device object is
+    // stopped and reopened (no rescan or channel change), and the bridge and plugins
+    // keep everything that depends on the unchanged sample rate
+    juce::AudioDeviceManager::AudioDeviceSetup setup;
+    juceDeviceManager.getAudioDeviceSetup(setup);
+    setup.bufferSize = nearest;
+    auto result = juceDeviceManager.setAudioDeviceSetup(setup, true);
+    if (result.isNotEmpty()) {
+        DBG("Failed to set buffer size " << nearest << ": " << result);
+        return false;
+    }
+    return true;
+}
+
+void TracktionEngineWrapper::applyRenderThreadSettings() {
+    auto& config = Config::getInstance();
+    RenderThreadSettings settings;
+    settings.numThreads = config.getRenderThreadCount();
+    settings.pinToCores = config.getRenderThreadPinning();
+    settings.performanceCores = config.getRenderThreadPerformanceCores();
+
+    // Affinity and scheduling are picked up by each render thread on its next block
+    RenderThreadPolicy::getInstance().setSettings(settings);
+
+    // Loaded with the render settings, so they follow the config file the same way
+    if (audioBridge_) {
+        audioBridge_->setChainSuspendTailSeconds(config.getChainSuspendTailSeconds());
+    }
+    liveLatencyPolicy_ = static_cast<LatencyPlanner::Policy>(
+        juce::jlimit(0, 2, config.getLiveLatencyPolicy()));
+    updateLatencyPlan();
+    livePreRender_ = config.getLivePreRender();
+    updatePreRendering();
+
+    updateRenderThreadCount();
+    rebuildGraphIfStopped();
+}
+
+bool TracktionEngineWrapper::freezeTrack(const std::string& track_id) {
+    if (!trackFreezer_) {
+        return false;
+    }
+    try {
+        // The user's freeze takes over from a pre-render
+        const auto trackId = std::stoi(track_id);
+        if (trackPreRenderer_) {
+            trackPreRenderer_->release(trackId);
+        }
+        return trackFreezer_->freeze(trackId);
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+void TracktionEngineWrapper::unfreezeTrack(const std::string& track_id) {
+    if (!trackFreezer_) {
+        return;
+    }
+    try {
+        trackFreezer_->unfreeze(std::stoi(track_id));
+    } catch (const std::exception&) {
+    }
+}
+
+void TracktionEngineWrapper::updatePreRendering() {
+    if (trackPreRenderer_) {
+        trackPreRenderer_->setEnabled(lowLatencyMode_ && livePreRender_);
+    }
+}
+
+void TracktionEngineWrapper::updateRenderThreadCount() {
+    if (!engineBehaviour_) {
+        return;
+    }
+
+    const int numThreads =
+        multiThreaded_ ? RenderThreadPolicy::getInstance().getSettings().resolveNumThreads(
+                             juce::SystemStats::getNumCpus())
+                       : 1;
+    if (numThreads != engineBehaviour_->getNumberOfCPUsToUseForAudio()) {
+        engineBehaviour_->setNumberOfCPUsToUseForAudio(numThreads);
+        graphRebuildPending_ = true;
+    }
+}
+
+void TracktionEngineWrapper::rebuildGraphIfStopped() {
+    if (graphRebuildPending_ && currentEdit_ && !isPlaying() && !isRecording()) {
+        graphRebuildPending_ = false;
+        currentEdit_->restartPlayback();
+    }
+}
+
+double TracktionEngineWrapper::getDeviceLatencySeconds() const {
+    if (!engine_) {
+        return 0.0;
+    }
+
+    auto* device = engine_->getDeviceManager().deviceManager.getCurrentAudioDevice();
+    if (!device || device->getCurrentSampleRate() <= 0.0) {
+        return 0.0;
+    }
+
+    // Device latencies include the buffer; count it twice if the driver reports neither
+    int deviceSamples = device->getInputLatencyInSamples() + device->getOutputLatencyInSamples();
+    if (deviceSamples <= 0) {
+        deviceSamples = 2 * device->getCurrentBufferSizeSamples();
+    }
+    return deviceSamples / device->getCurrentSampleRate();
+}
+
+double TracktionEngineWrapper::getRoundTripLatencyMs() const {
+    const double deviceSeconds = getDeviceLatencySeconds();
+    if (deviceSeconds <= 0.0) {
+        return 0.0;
+    }
+
+    return deviceSeconds * 1000.0 + getDirectMonitorSavingMs();
+}
+
+double TracktionEngineWrapper::getDirectMonitorSavingMs() const {
+    // Compensated plugin latency (bypassed plugins excluded)
+    double pluginSeconds = 0.0;
+    for (const auto& track : getTrackLatencies()) {
+        pluginSeconds = std::max(pluginSeconds, track.seconds);
+    }
+    return pluginSeconds * 1000.0;
+}
+
+double TracktionEngineWrapper::getPluginLatency(tracktion::Plugin& plugin) const {
+    const double seconds = plugin.getLatencySeconds();
+    if (seconds <= 0.0 && latencyBypassed_.contains(plugin.itemID)) {
+        const auto it = latencyWhenPlanned_.find(plugin.itemID.getRawID());
+        if (it != latencyWhenPlanned_.end()) {
+            return it->second;
+        }
+    }
+    return seconds;
+}
+
+void TracktionEngineWrapper::setLiveLatencyPolicy(LatencyPlanner::Policy policy) {
+    liveLatencyPolicy_ = policy;
+    Config::getInstance().setLiveLatencyPolicy(static_cast<int>(policy));
+    updateLatencyPlan();
+    rebuildGraphIfStopped();
+}
+
+void TracktionEngineWrapper::updateLatencyPlan() {
+    lastLatencyPlanMs_ = juce::Time::getMillisecondCounter();
+    if (!currentEdit_) {
+        return;
+    }
+
+    // Every track's plugins in chain order, with what each reports
+    std::vector<LatencyPlanner::Track> tracks;
+    std::vector<std::vector<tracktion::EditItemID>> ids;
+    for (auto* track : tracktion::getAudioTracks(*currentEdit_)) {
+        auto& planned = tracks.emplace_back();
+        auto& trackIds = ids.emplace_back();
+        for (auto* plugin : track->pluginList) {
+            planned.pluginSeconds.push_back(getPluginLatency(*plugin));
+            trackIds.push_back(plugin->itemID);
+        }
+    }
+
+    const auto policy = lowLatencyMode_ ? liveLatencyPolicy_ : LatencyPlanner::Policy::Compensate;
+    const auto budget =
+        LatencyPlanner::pluginBudgetSeconds(latencyTargetMs_, getDeviceLatencySeconds());
+    const auto plan = LatencyPlanner::plan(tracks, policy, budget);
+
+    juce::Array<tracktion::EditItemID> bypassed;
+    for (size_t t = 0; t < tracks.size(); ++t) {
+        for (size_t p = 0; p < ids[t].size(); ++p) {
+            if (plan.bypass[t][p]) {
+                bypassed.add(ids[t][p]);
+            }
+        }
+    }
+
+    if (bypassed == latencyBypassed_) {
+        return;
+    }
+
+    std::map<juce::uint64, double> latencies;
+    for (size_t t = 0; t < tracks.size(); ++t) {
+        for (size_t p = 0; p < ids[t].size(); ++p) {
+            if (plan.bypass[t][p]) {
+                latencies[ids[t][p].getRawID()] = tracks[t].pluginSeconds[p];
+            }
+        }
+    }
+    latencyWhenPlanned_ = std::move(latencies);
+    latencyBypassed_ = bypassed;
+    currentEdit_->setLowLatencyMonitoring(!bypassed.isEmpty(), bypassed);
+    graphRebuildPending_ = true;
+    DBG("Latency plan: " << plan.bypassedCount << " plugin(s) bypassed, "
+                         << plan.compensatedSeconds * 1000.0 << " ms compensated");
+}
+
 // =============================================================================
 // Change Listener
 // =============================================================================
@@ -485,6 +989,65 @@ CommandResponse TracktionEngineWrapper::processCommand(const Command& command) {
             auto response = CommandResponse(CommandResponse::Status::Success, "Track created");
             response.setData(responseData);
             return response;
+        } else if (type == "render") {
+            RenderRequest request;
+            request.output_path = command.getParameter<std::string>("output");
+            if (command.hasParameter("start"))
+                request.start_seconds = command.getParameter<double>("start");
+            if (command.hasParameter("end"))
+                request.end_seconds = command.getParameter<double>("end");
+            if (command.hasParameter("stems"))
+                request.stems = command.getParameter<bool>("stems");
+            if (command.hasParameter("tracks")) {
+                for (double id : command.getParameter<std::vector<double>>("tracks"))
+                    request.track_ids.push_back(std::to_string(static_cast<int>(id)));
+            }
+            if (command.hasParameter("sampleRate"))
+                request.sample_rate = command.getParameter<double>("sampleRate");
+            if (command.hasParameter("bitDepth"))
+                request.bit_depth = command.getParameter<int>("bitDepth");
+            if (command.hasParameter("normalise"))
+                request.normalise = command.getParameter<bool>("normalise");
+
+            const auto jobId = startRender(request);
+            if (jobId.empty()) {
+                return CommandResponse(CommandResponse::Status::Error, "No project to render");
+            }
+
+            juce::DynamicObject::Ptr obj = new juce::DynamicObject();
+            obj->setProperty("jobId", juce::String(jobId));
+
+            const bool failed = getRenderStatus(jobId) == RenderStatus::Failed;
+            auto response = CommandResponse(
+                failed ? CommandResponse::Status::Error : CommandResponse::Status::Success,
+                failed ? getRenderError(jobId) : "Render queued");
+            response.setData(juce::var(obj.get()));
+            return response;
+        } else if (type == "renderStatus") {
+            const auto jobId = command.getParameter<std::string>("jobId");
+            const auto status = getRenderStatus(jobId);
+            if (status == RenderStatus::Unknown) {
+                return CommandResponse(CommandResponse::Status::Error, "Unknown render job");
+            }
+
+            static const char* const statusNames[] = {"queued",   "rendering", "finished",
+                                                      "cancelled", "failed",   "unknown"};
+            juce::DynamicObject::Ptr obj = new juce::DynamicObject();
+            obj->setProperty("jobId", juce::String(jobId));
+            obj->setProperty("status", statusNames[static_cast<int>(status)]);
+            obj->setProperty("progress", getRenderProgress(jobId));
+            juce::Array<juce::var> files;
+            for (const auto& file : getRenderedFiles(jobId))
+                files.add(juce::String(file));
+            obj->setProperty("files", files);
+            obj->setProperty("error", juce::String(getRenderError(jobId)));
+
+            auto response = CommandResponse(CommandResponse::Status::Success, "Render status");
+            response.setData(juce::var(obj.get()));
+            return response;
+        } else if (type == "cancelRender") {
+            cancelRender(command.getParameter<std::string>("jobId"));
+            return CommandResponse(CommandResponse::Status::Success, "Render cancelled");
         } else {
             return CommandResponse(CommandResponse::Status::Error, "Unknown command");
         }
@@ -502,6 +1065,24 @@ void TracktionEngineWrapper::play() {
         return;
     }
 
+    // Pre-renders give way to playback: those still running are queued again at the stop
+    if (trackPreRenderer_) {
+        trackPreRenderer_->cancelRenders();
+    }
+
+    // The playback graph is released while an offline render runs
+    if (offlineRenderer_ && offlineRenderer_->isRendering()) {
+        std::cout << "Playback blocked - offline render in progress" << std::endl;
+        return;
+    }
+
+    // Engine edits from the current gesture may still be waiting for the next tick, and
+    // idle chains must be running before the first block plays
+    if (audioBridge_) {
+        audioBridge_->flushPendingSync();
+        audioBridge_->wakeAllChains();
+    }
+
     if (currentEdit_) {
         auto& transport = currentEdit_->getTransport();
 
@@ -527,16 +1108,31 @@ void TracktionEngineWrapper::play() {
             }
         }
 
+        if (audioBridge_) {
+            audioBridge_->transportStarting(getCurrentPosition());
+        }
         transport.play(false);
         std::cout << "Playback started" << std::endl;
     }
 }
 
 void TracktionEngineWrapper::stop() {
+    if (countingIn_) {
+        countingIn_ = false;
+        audioBridge_->cancelCountIn();
+    }
     if (currentEdit_) {
         currentEdit_->getTransport().stop(false, false);
         std::cout << "Playback stopped" << std::endl;
     }
+    if (audioBridge_ && audioBridge_->isRecordingToDisk()) {
+        const int takes = audioBridge_->stopRecording();
+        std::cout << "Recording stopped: " << takes << " take(s)" << std::endl;
+    }
+    if (midiTakeRecorder_ && midiTakeRecorder_->isRecording()) {
+        const int takes = midiTakeRecorder_->stop(getCurrentPosition());
+        std::cout << "MIDI recording stopped: " << takes << " take(s)" << std::endl;
+    }
 }
 
 void TracktionEngineWrapper::pause() {
@@ -550,13 +1146,46 @@ void TracktionEngineWrapper::record() {
         return;
     }
 
+    // Engine edits from the current gesture may still be waiting for the next tick
+    if (audioBridge_) {
+        audioBridge_->flushPendingSync();
+        audioBridge_->wakeAllChains();
+    }
+
+    if (countingIn_) {
+        return;
+    }
+    if (currentEdit_ && audioBridge_ && countInBars_ > 0 && !isPlaying() &&
+        audioBridge_->startCountIn(countInBars_ * beatsPerBar_)) {
+        countingIn_ = true;
+        std::cout << "Counting in " << countInBars_ << " bar(s)" << std::endl;
+        return;
+    }
+    startRecording();
+}
+
+void TracktionEngineWrapper::startRecording() {
     if (currentEdit_) {
+        // Armed inputs stream to disk through the bridge; the transport only runs
+        const auto folder = ProjectManager::getInstance().getMediaFolder("Recordings");
+        if (audioBridge_ && !audioBridge_->startRecording(folder)) {
+            std::cout << "No armed tracks with an audio input to record" << std::endl;
+        }
+        // Armed MIDI inputs are captured into clips, lock-free from the MIDI threads
+        if (midiTakeRecorder_) {
+            midiTakeRecorder_->start(getCurrentPosition());
+        }
         currentEdit_->getTransport().record(false);
         std::cout << "Recording started" << std::endl;
     }
 }
 
 void TracktionEngineWrapper::locate(double position_seconds) {
+    // The new position may be inside a clip the lookahead hasn't seen
+    if (audioBridge_) {
+        audioBridge_->wakeAllChains();
+        audioBridge_->transportSeeked(position_seconds);
+    }
     if (currentEdit_) {
         currentEdit_->getTransport().setPosition(
             tracktion::TimePosition::fromSeconds(position_seconds));
@@ -564,6 +1193,10 @@ void TracktionEngineWrapper::locate(double position_seconds) {
 }
 
 void TracktionEngineWrapper::locateMusical(int bar, int beat, int tick) {
+    if (audioBridge_) {
+        audioBridge_->wakeAllChains();
+    }
+
     // Convert musical position to time
     if (currentEdit_) {
         auto& tempoSequence = currentEdit_->tempoSequence;
@@ -616,6 +1249,16 @@ void TracktionEngineWrapper::setTempo(double bpm) {
             if (tempo) {
                 tempo->setBpm(bpm);
                 std::cout << "Set tempo: " << bpm << " BPM" << std::endl;
+
+                // Tempo-synced mods follow from the next block, not the next UI tick
+                if (audioBridge_) {
+                    audioBridge_->setTempo(bpm);
+                }
+
+                // Clips and synced devices render differently at the new tempo
+                if (trackPreRenderer_) {
+                    trackPreRenderer_->invalidateAll();
+                }
             }
         }
     }
@@ -630,6 +1273,11 @@ double TracktionEngineWrapper::getTempo() const {
 }
 
 void TracktionEngineWrapper::setTimeSignature(int numerator, int denominator) {
+    // The click accents the first beat of each bar, and counts in whole bars
+    beatsPerBar_ = juce::jmax(1, numerator);
+    if (audioBridge_) {
+        audioBridge_->setMetronomeBeatsPerBar(beatsPerBar_);
+    }
     if (currentEdit_) {
         // Time signature handling in Tracktion Engine - simplified for now
         std::cout << "Set time signature: " << numerator << "/" << denominator << std::endl;
@@ -702,25 +1350,49 @@ void TracktionEngineWrapper::updateTriggerState() {
     wasPlaying_ = currentlyPlaying;
     lastPosition_ = currentPosition;
 
-    // Update AudioBridge with transport state for trigger sync
+    // Devices come and go and report new latencies; keep the low latency plan current
+    if (lowLatencyMode_ &&
+        juce::Time::getMillisecondCounter() - lastLatencyPlanMs_ >= kLatencyPlanIntervalMs) {
+        updateLatencyPlan();
+    }
+
+    // Profiles and graph rebuilds held back during playback are applied once it stops
+    if (!currentlyPlaying && !isRecording()) {
+        if (pendingAudioProfile_) {
+            applyPendingAudioProfile();
+        } else {
+            rebuildGraphIfStopped();
+        }
+    }
+
+    // The audio thread finds starts and loop wraps itself; it needs the play state and tempo
     if (audioBridge_) {
-        audioBridge_->updateTransportState(currentlyPlaying, justStarted_, justLooped_);
+        audioBridge_->updateTransportState(currentlyPlaying, getTempo());
     }
 }
 
 // Metronome/click track methods
 void TracktionEngineWrapper::setMetronomeEnabled(bool enabled) {
-    if (currentEdit_) {
-        currentEdit_->clickTrackEnabled = enabled;
+    // The bridge clicks on the audio thread; Tracktion's click track stays off
+    if (audioBridge_) {
+        audioBridge_->setMetronomeEnabled(enabled);
         std::cout << "Metronome " << (enabled ? "enabled" : "disabled") << std::endl;
     }
+    if (currentEdit_) {
+        currentEdit_->clickTrackEnabled = false;
+    }
 }
 
 bool TracktionEngineWrapper::isMetronomeEnabled() const {
-    if (currentEdit_) {
-        return currentEdit_->clickTrackEnabled;
-    }
-    return false;
+    return audioBridge_ && audioBridge_->isMetronomeEnabled();
+}
+
+void TracktionEngineWrapper::setCountInBars(int bars) {
+    countInBars_ = juce::jmax(0, bars);
+}
+
+int TracktionEngineWrapper::getCountInBars() const {
+    return countInBars_;
 }
 
 juce::AudioDeviceManager* TracktionEngineWrapper::getDeviceManager() {
@@ -895,15 +1567,6 @@ bool TracktionEngineWrapper::trackExists(const std::string& track_id) const {
 
 void TracktionEngineWrapper::previewNoteOnTrack(const std::string& track_id, int noteNumber,
                                                 int velocity, bool isNoteOn) {
-    DBG("TracktionEngineWrapper::previewNoteOnTrack - Track="
-        << track_id << ", Note=" << noteNumber << ", Velocity=" << velocity
-        << ", On=" << (isNoteOn ? "YES" : "NO"));
-
-    if (!audioBridge_) {
-        DBG("TracktionEngineWrapper: WARNING - No AudioBridge!");
-        return;
-    }
-
     // Convert string track ID to integer (MAGDA TrackId) with validation
     int magdaTrackId = 0;
     try {
@@ -913,39 +1576,19 @@ void TracktionEngineWrapper::previewNoteOnTrack(const std::string& track_id, int
             << track_id << "' passed to previewNoteOnTrack: " << e.what());
         return;
     }
-    DBG("TracktionEngineWrapper: Looking up MAGDA track ID: " << magdaTrackId);
 
-    // Use AudioBridge to get the Tracktion AudioTrack
-    auto* audioTrack = audioBridge_->getAudioTrack(magdaTrackId);
-    if (!audioTrack) {
-        DBG("TracktionEngineWrapper: WARNING - Track not found in AudioBridge!");
-        return;
-    }
-
-    DBG("TracktionEngineWrapper: Track found, injecting MIDI");
-
-    // Ensure MIDI input device is in monitoring mode (always audible)
-    auto& midiInput = audioTrack->getMidiInputDevice();
-    auto currentMode = midiInput.getMonitorMode();
-    DBG("TracktionEngineWrapper: Current monitor mode: " << (int)currentMode);
+    previewNote(magdaTrackId, noteNumber, velocity, isNoteOn);
+}
 
-    if (currentMode != tracktion::InputDevice::MonitorMode::on) {
-        DBG("TracktionEngineWrapper: Enabling monitor mode");
-        midiInput.setMonitorMode(tracktion::InputDevice::MonitorMode::on);
+void TracktionEngineWrapper::previewNote(TrackId trackId, int noteNumber, int velocity,
+                                         bool isNoteOn) {
+    if (audioBridge_) {
+        audioBridge_->previewNote(trackId, noteNumber, velocity, isNoteOn);
     }
+}
 
-    // Create MIDI message
-    juce::MidiMessage message =
-        isNoteOn ? juce::MidiMessage::noteOn(1, noteNumber, (juce::uint8)velocity)
-                 : juce::MidiMessage::noteOff(1, noteNumber, (juce::uint8)velocity);
-
-    DBG("TracktionEngineWrapper: MIDI message created - " << message.getDescription());
-
-    // Inject MIDI through DeviceManager (simulates physical MIDI keyboard input)
-    // This ensures the message goes through the normal MIDI routing graph
-    DBG("TracktionEngineWrapper: Injecting MIDI through DeviceManager");
-    engine_->getDeviceManager().injectMIDIMessageToDefaultDevice(message);
-    DBG("TracktionEngineWrapper: MIDI message injected successfully");
+const PlayheadClock* TracktionEngineWrapper::getPlayheadClock() const {
+    return audioBridge_ ? &audioBridge_->getPlayheadClock() : nullptr;
 }
 
 // ClipInterface implementation
@@ -1393,6 +2036,42 @@ std::vector<std::string> TracktionEngineWrapper::getTrackEffects(
     return {};
 }
 
+// RenderInterface implementation - delegates to OfflineRenderer
+std::string TracktionEngineWrapper::startRender(const RenderRequest& request) {
+    return offlineRenderer_ ? offlineRenderer_->startRender(request) : std::string();
+}
+
+RenderInterface::RenderStatus TracktionEngineWrapper::getRenderStatus(
+    const std::string& job_id) const {
+    return offlineRenderer_ ? offlineRenderer_->getStatus(job_id) : RenderStatus::Unknown;
+}
+
+double TracktionEngineWrapper::getRenderProgress(const std::string& job_id) const {
+    return offlineRenderer_ ? offlineRenderer_->getProgress(job_id) : 0.0;
+}
+
+void TracktionEngineWrapper::cancelRender(const std::string& job_id) {
+    if (offlineRenderer_) {
+        offlineRenderer_->cancel(job_id);
+    }
+}
+
+std::vector<std::string> TracktionEngineWrapper::getRenderedFiles(
+    const std::string& job_id) const {
+    return offlineRenderer_ ? offlineRenderer_->getRenderedFiles(job_id)
+                            : std::vector<std::string>();
+}
+
+std::string TracktionEngineWrapper::getRenderError(const std::string& job_id) const {
+    return offlineRenderer_ ? offlineRenderer_->getError(job_id) : std::string();
+}
+
+// BatchInterface implementation - edits the model, which AudioBridge syncs to the engine
+std::vector<BatchResult> TracktionEngineWrapper::applyBatch(
+    const std::vector<BatchOperation>& operations) {
+    return magda::applyBatch(operations);
+}
+
 // Helper methods
 tracktion::Track* TracktionEngineWrapper::findTrackById(const std::string& track_id) const {
     auto it = trackMap_.find(track_id);
@@ -1449,7 +2128,8 @@ void TracktionEngineWrapper::startPluginScan(
         pluginScanCoordinator_ = std::make_unique<PluginScanCoordinator>();
     }
 
-    // Start scanning using the out-of-process coordinator
+    // Start scanning using the out-of-process coordinator. Only bundles that changed
+    // since the saved list are re-probed.
     pluginScanCoordinator_->startScan(
         formatManager,
         // Progress callback
@@ -1461,7 +2141,23 @@ void TracktionEngineWrapper::startPluginScan(
         // Completion callback
         [this, &knownPlugins](bool success, const juce::Array<juce::PluginDescription>& plugins,
                               const juce::StringArray& failedPlugins) {
-            // Add found plugins to KnownPluginList
+            // Drop entries from bundles that were re-probed or deleted, then add what the
+            // scan found
+            std::set<juce::String> staleFiles;
+            for (const auto& file : pluginScanCoordinator_->getRescannedFiles()) {
+                staleFiles.insert(file);
+            }
+            for (const auto& file : pluginScanCoordinator_->getRemovedFiles()) {
+                staleFiles.insert(file);
+            }
+            if (!staleFiles.empty()) {
+                for (const auto& type : knownPlugins.getTypes()) {
+                    if (staleFiles.count(type.fileOrIdentifier) > 0) {
+                        knownPlugins.removeType(type);
+                    }
+                }
+            }
+
             for (const auto& desc : plugins) {
                 knownPlugins.addType(desc);
             }
@@ -1478,6 +2174,7 @@ void TracktionEngineWrapper::startPluginScan(
             }
 
             // Save the updated plugin list to persistent storage
+            pluginScanState_ = pluginScanCoordinator_->getScanState();
             savePluginList();
 
             isScanning_ = false;
@@ -1485,7 +2182,8 @@ void TracktionEngineWrapper::startPluginScan(
             if (onPluginScanComplete) {
                 onPluginScanComplete(success, numPlugins, failedPlugins);
             }
-        });
+        },
+        &pluginScanState_);
 }
 
 void TracktionEngineWrapper::abortPluginScan() {
@@ -1532,6 +2230,43 @@ juce::File TracktionEngineWrapper::getPluginListFile() const {
     return appDataDir.getChildFile("PluginList.xml");
 }
 
+juce::File TracktionEngineWrapper::getPluginScanStateFile() const {
+    return getPluginListFile().getSiblingFile("PluginScanState.xml");
+}
+
+juce::File TracktionEngineWrapper::getPluginUsageFile() const {
+    return getPluginListFile().getSiblingFile("PluginUsage.xml");
+}
+
+void TracktionEngineWrapper::savePluginUsage() {
+    if (auto xml = pluginUsage_.createXml()) {
+        if (!xml->writeTo(getPluginUsageFile())) {
+            std::cerr << "Failed to write plugin usage to: "
+                      << getPluginUsageFile().getFullPathName() << std::endl;
+        }
+    }
+}
+
+void TracktionEngineWrapper::updateWarmPlugins() {
+    if (!engine_ || !audioBridge_) {
+        return;
+    }
+
+    // Only plugins still in the known list; a removed plugin's count stays for a rescan
+    auto& knownPlugins = engine_->getPluginManager().knownPluginList;
+    juce::Array<juce::PluginDescription> warm;
+    for (const auto& identifier : pluginUsage_.getMostUsed(
+             PluginInstancePool::MAX_PLUGINS * 2, PluginInstancePool::MIN_USES)) {
+        if (auto description = knownPlugins.getTypeForIdentifierString(identifier)) {
+            warm.add(*description);
+        }
+        if (warm.size() == PluginInstancePool::MAX_PLUGINS) {
+            break;
+        }
+    }
+    audioBridge_->getPluginPool().setWarmPlugins(warm);
+}
+
 void TracktionEngineWrapper::savePluginList() {
     if (!engine_) {
         std::cerr << "Cannot save plugin list: engine not initialized" << std::endl;
@@ -1551,6 +2286,18 @@ void TracktionEngineWrapper::savePluginList() {
                       << std::endl;
         }
     }
+
+    // Save which bundles the list covers so the next scan can skip unchanged ones
+    auto scanStateFile = getPluginScanStateFile();
+    if (auto xml = pluginScanState_.createXml()) {
+        if (!xml->writeTo(scanStateFile)) {
+            std::cerr << "Failed to write plugin scan state to: "
+                      << scanStateFile.getFullPathName() << std::endl;
+        }
+    }
+
+    savePluginUsage();
+    updateWarmPlugins();  // The scan may have added or removed warm plugins
 }
 
 void TracktionEngineWrapper::loadPluginList() {
@@ -1563,20 +2310,50 @@ void TracktionEngineWrapper::loadPluginList() {
     auto pluginListFile = getPluginListFile();
 
     if (pluginListFile.existsAsFile()) {
-        if (auto xml = juce::XmlDocument::parse(pluginListFile)) {
+        // Decoded in binary from the startup cache while the XML is the one it was made from
+        auto& cache = StartupCache::getInstance();
+        const auto cached = cache.find(PLUGIN_LIST_CACHE_SECTION, pluginListFile);
+        if (cached.isValid() && readPluginList(cached, knownPlugins)) {
+            std::cout << "Loaded plugin list (" << knownPlugins.getNumTypes()
+                      << " plugins) from the startup cache" << std::endl;
+        } else if (auto xml = juce::XmlDocument::parse(pluginListFile)) {
             knownPlugins.recreateFromXml(*xml);
             std::cout << "Loaded plugin list (" << knownPlugins.getNumTypes()
                       << " plugins) from: " << pluginListFile.getFullPathName() << std::endl;
+
+            juce::MemoryOutputStream out;
+            writePluginList(out, knownPlugins);
+            cache.store(PLUGIN_LIST_CACHE_SECTION, pluginListFile, out.getData(),
+                        out.getDataSize());
         } else {
             std::cerr << "Failed to parse plugin list from: " << pluginListFile.getFullPathName()
                       << std::endl;
             knownPlugins.clear();
         }
+
+        // Without a matching list the state would hide bundles from the next scan
+        pluginScanState_.clear();
+        auto scanStateFile = getPluginScanStateFile();
+        if (knownPlugins.getNumTypes() > 0 && scanStateFile.existsAsFile()) {
+            if (auto xml = juce::XmlDocument::parse(scanStateFile)) {
+                pluginScanState_.restoreFromXml(*xml);
+            }
+        }
     } else {
         std::cout << "No saved plugin list found at: " << pluginListFile.getFullPathName()
                   << std::endl;
         std::cout << "Plugins will need to be scanned manually via the Plugin Browser" << std::endl;
         knownPlugins.clear();
+        pluginScanState_.clear();
+    }
+
+    // Usage counts survive a cleared list, so a rescan warms the same plugins again
+    pluginUsage_.clear();
+    auto usageFile = getPluginUsageFile();
+    if (usageFile.existsAsFile()) {
+        if (auto xml = juce::XmlDocument::parse(usageFile)) {
+            pluginUsage_.restoreFromXml(*xml);
+        }
     }
 }
 
@@ -1589,13 +2366,15 @@ void TracktionEngineWrapper::clearPluginList() {
     // Clear in-memory list
     auto& knownPlugins = engine_->getPluginManager().knownPluginList;
     knownPlugins.clear();
+    pluginScanState_.clear();
 
-    // Delete the saved file
+    // Delete the saved files
     auto pluginListFile = getPluginListFile();
     if (pluginListFile.existsAsFile()) {
         pluginListFile.deleteFile();
         std::cout << "Deleted plugin list file: " << pluginListFile.getFullPathName() << std::endl;
     }
+    getPluginScanStateFile().deleteFile();
 
     std::cout << "Plugin list cleared. Use 'Scan' to rediscover plugins." << std::endl;
 }
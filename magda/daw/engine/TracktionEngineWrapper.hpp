@@ -3,21 +3,37 @@
 #include <tracktion_engine/tracktion_engine.h>
 
 #include <functional>
+#include <map>
+#include <optional>
 
 #include "../command.hpp"
+#include "../audio/LatencyPlanner.hpp"
+#include "../core/TypeIds.hpp"
+#include "../core/ViewModeState.hpp"
+#include "../interfaces/batch_interface.hpp"
 #include "../interfaces/clip_interface.hpp"
 #include "../interfaces/mixer_interface.hpp"
+#include "../interfaces/render_interface.hpp"
 #include "../interfaces/track_interface.hpp"
 #include "../interfaces/transport_interface.hpp"
 #include "AudioEngine.hpp"
+#include "PluginScanState.hpp"
+#include "PluginUsageStats.hpp"
 
 namespace magda {
 
 // Forward declarations
 class AudioBridge;
+class AudioEngineOptimizer;
+class MagdaEngineBehaviour;
 class MidiBridge;
+class MidiTakeRecorder;
+class OfflineRenderer;
 class PluginScanCoordinator;
 class PluginWindowManager;
+class PlayheadClock;
+class TrackFreezer;
+class TrackPreRenderer;
 
 /**
  * @brief Tracktion Engine implementation of AudioEngine
@@ -28,17 +44,32 @@ class PluginWindowManager;
  * Inherits from AudioEngine (which includes AudioEngineListener) so it can:
  * - Be used as a generic audio engine
  * - Receive state change notifications from TimelineController
+ *
+ * A headless engine (Mode::Headless) opens no audio or MIDI device and shows no plugin
+ * windows: the model, AudioBridge sync, plugin list and offline renderer all work as usual,
+ * but nothing plays in real time. That is what render nodes and batch tools run.
  */
 class TracktionEngineWrapper : public AudioEngine,
                                public TransportInterface,
                                public TrackInterface,
                                public ClipInterface,
                                public MixerInterface,
+                               public RenderInterface,
+                               public BatchInterface,
                                private juce::ChangeListener {
   public:
-    TracktionEngineWrapper();
+    enum class Mode {
+        Interactive,  // Audio and MIDI devices, live playback, plugin windows
+        Headless      // No devices or windows; offline rendering only
+    };
+
+    explicit TracktionEngineWrapper(Mode mode = Mode::Interactive);
     ~TracktionEngineWrapper();
 
+    bool isHeadless() const {
+        return mode_ == Mode::Headless;
+    }
+
     // Initialize the engine
     bool initialize() override;
     void shutdown() override;
@@ -73,9 +104,14 @@ class TracktionEngineWrapper : public AudioEngine,
     // Metronome/click track control
     void setMetronomeEnabled(bool enabled) override;
     bool isMetronomeEnabled() const override;
+    void setCountInBars(int bars) override;
+    int getCountInBars() const override;
 
     // Device management
     juce::AudioDeviceManager* getDeviceManager() override;
+    void applyRenderThreadSettings() override;
+    bool freezeTrack(const std::string& track_id) override;
+    void unfreezeTrack(const std::string& track_id) override;
 
     // AudioEngineListener implementation (receives state changes from UI)
     void onTransportPlay(double position) override;
@@ -113,6 +149,7 @@ class TracktionEngineWrapper : public AudioEngine,
      */
     void previewNoteOnTrack(const std::string& track_id, int noteNumber, int velocity,
                             bool isNoteOn) override;
+    void previewNote(TrackId trackId, int noteNumber, int velocity, bool isNoteOn) override;
 
     // ClipInterface implementation - fixed method signatures
     std::string addMidiClip(const std::string& track_id, double start_time, double length,
@@ -149,6 +186,17 @@ class TracktionEngineWrapper : public AudioEngine,
     std::vector<std::string> getAvailableEffects() const override;
     std::vector<std::string> getTrackEffects(const std::string& track_id) const override;
 
+    // RenderInterface implementation
+    std::string startRender(const RenderRequest& request) override;
+    RenderStatus getRenderStatus(const std::string& job_id) const override;
+    double getRenderProgress(const std::string& job_id) const override;
+    void cancelRender(const std::string& job_id) override;
+    std::vector<std::string> getRenderedFiles(const std::string& job_id) const override;
+    std::string getRenderError(const std::string& job_id) const override;
+
+    // BatchInterface implementation
+    std::vector<BatchResult> applyBatch(const std::vector<BatchOperation>& operations) override;
+
     // =========================================================================
     // Audio Bridge Access
     // =========================================================================
@@ -175,6 +223,8 @@ class TracktionEngineWrapper : public AudioEngine,
         return midiBridge_.get();
     }
 
+    const PlayheadClock* getPlayheadClock() const override;
+
     /**
      * @brief Get the PluginWindowManager for safe plugin window lifecycle management
      * @return Pointer to PluginWindowManager, or nullptr if not initialized
@@ -232,9 +282,12 @@ class TracktionEngineWrapper : public AudioEngine,
      * @brief Start scanning for VST3/AU plugins on the system
      * @param progressCallback Called with (progress 0-1, current plugin name) during scan
      *
-     * NOTE: Plugin scanning happens in-process. If a plugin crashes during scanning,
-     * it will crash the application. The "dead man's pedal" file tracks which plugin
-     * was being scanned, so it will be skipped on the next scan attempt.
+     * Scanning is incremental: only bundles that are new or whose modification time or
+     * size changed since the saved plugin list are re-probed, and plugins from deleted
+     * bundles are dropped. Use clearPluginList() first to force a full rescan.
+     *
+     * Plugins are scanned out-of-process; one that crashes the scanner is blacklisted
+     * and skipped on later scans.
      *
      * Crash files are stored in: ~/Library/Application Support/MAGDA/
      * Call clearPluginScanCrashFiles() to retry scanning problematic plugins.
@@ -293,6 +346,16 @@ class TracktionEngineWrapper : public AudioEngine,
      */
     juce::File getPluginListFile() const;
 
+    /**
+     * @brief Get the file path of the per-bundle scan state saved next to the plugin list
+     */
+    juce::File getPluginScanStateFile() const;
+
+    /**
+     * @brief Get the file path of the plugin usage counts saved next to the plugin list
+     */
+    juce::File getPluginUsageFile() const;
+
     // =========================================================================
     // PDC (Plugin Delay Compensation) Query
     // =========================================================================
@@ -306,11 +369,88 @@ class TracktionEngineWrapper : public AudioEngine,
 
     /**
      * @brief Get the maximum latency across all tracks in the playback graph
-     * This is the total PDC that Tracktion Engine compensates for
+     * This is the total PDC that Tracktion Engine compensates for (plugins bypassed for
+     * latency excluded), plus the output device latency
      * @return Maximum latency in seconds
      */
     double getGlobalLatencySeconds() const;
 
+    struct DeviceLatency {
+        DeviceId deviceId = INVALID_DEVICE_ID;
+        juce::String name;
+        double seconds = 0.0;   // Reported by the plugin
+        bool bypassed = false;  // Taken out to meet the Live latency target
+    };
+
+    struct TrackLatency {
+        TrackId trackId = INVALID_TRACK_ID;
+        juce::String name;
+        double seconds = 0.0;  // The track's chain after bypassing: what PDC lines up to
+        std::vector<DeviceLatency> devices;
+    };
+
+    /**
+     * @brief Per-track latency, device by device (tracks in TrackManager order)
+     */
+    std::vector<TrackLatency> getTrackLatencies() const;
+
+    // =========================================================================
+    // Audio Profiles
+    // =========================================================================
+
+    /**
+     * @brief Apply a view mode's engine profile: device buffer size, render thread count,
+     *        whether latent plugins are bypassed (low latency) or compensated, and whether
+     *        clips stretch at Draft or Final quality
+     *
+     * In a low latency profile the live latency policy decides which latent plugins are
+     * bypassed. Under Constrain, just enough of them to keep compensation within what the
+     * profile's latencyMs leaves after the device's own latency. The plan is kept up to
+     * date as devices and their latencies change. With Config's livePreRender on, tracks
+     * that needn't render live are also rendered ahead (see TrackPreRenderer).
+     *
+     * Reopening the device or rebuilding the graph glitches, so while the transport is
+     * running the profile is held and applied at the next stop, as it is while an offline
+     * render runs. A newer profile replaces a held one.
+     */
+    void applyAudioProfile(const AudioEngineProfile& profile);
+
+    /**
+     * @brief True while a profile is waiting for the transport to stop
+     */
+    bool hasPendingAudioProfile() const {
+        return pendingAudioProfile_.has_value();
+    }
+
+    /**
+     * @brief Input-to-output latency actually achieved: device input and output latency
+     *        plus the compensated plugin latency
+     * @return Milliseconds, or 0 if no device is open
+     */
+    double getRoundTripLatencyMs() const;
+
+    /**
+     * @brief How much sooner a directly monitored input is heard than through the graph:
+     *        the compensated plugin latency it skips
+     */
+    double getDirectMonitorSavingMs() const;
+
+    /**
+     * @brief How a low latency profile deals with latent plugins (Constrain by default;
+     *        saved in Config)
+     */
+    void setLiveLatencyPolicy(LatencyPlanner::Policy policy);
+    LatencyPlanner::Policy getLiveLatencyPolicy() const {
+        return liveLatencyPolicy_;
+    }
+
+    /**
+     * @brief Plugins currently bypassed to meet the latency target
+     */
+    int getLatencyBypassedCount() const {
+        return latencyBypassed_.size();
+    }
+
     /**
      * @brief Callback when plugin scan completes
      * Called with (success, number of plugins found, failed plugins)
@@ -320,6 +460,15 @@ class TracktionEngineWrapper : public AudioEngine,
   private:
     // juce::ChangeListener implementation
     void changeListenerCallback(juce::ChangeBroadcaster* source) override;
+
+    // Open the preferred audio device and enable MIDI inputs (interactive mode only)
+    void openDevices();
+
+    // Keep the most-used known plugins warm in the bridge's PluginInstancePool
+    void updateWarmPlugins();
+    void savePluginUsage();
+
+    const Mode mode_;
     // Tracktion Engine components
     std::unique_ptr<tracktion::Engine> engine_;
     std::unique_ptr<tracktion::Edit> currentEdit_;
@@ -330,9 +479,32 @@ class TracktionEngineWrapper : public AudioEngine,
     // MIDI bridge for MIDI device management and routing
     std::unique_ptr<MidiBridge> midiBridge_;
 
+    // Armed tracks' MIDI input into clips while recording (destroyed before midiBridge_)
+    std::unique_ptr<MidiTakeRecorder> midiTakeRecorder_;
+
     // Plugin window manager for safe window lifecycle
     std::unique_ptr<PluginWindowManager> pluginWindowManager_;
 
+    // Offline bounce jobs (created after, destroyed before, the bridge and Edit)
+    std::unique_ptr<OfflineRenderer> offlineRenderer_;
+    std::unique_ptr<TrackFreezer> trackFreezer_;  // Renders through offlineRenderer_
+    std::unique_ptr<TrackPreRenderer> trackPreRenderer_;  // Quiet freezes in Live mode
+
+    // View mode audio profiles (the behaviour is owned by engine_)
+    MagdaEngineBehaviour* engineBehaviour_ = nullptr;
+    std::unique_ptr<AudioEngineOptimizer> audioEngineOptimizer_;
+    std::optional<AudioEngineProfile> pendingAudioProfile_;
+    bool lowLatencyMode_ = false;
+    double latencyTargetMs_ = 0.0;  // Round trip the current profile aims for
+    LatencyPlanner::Policy liveLatencyPolicy_ = LatencyPlanner::Policy::Constrain;
+    juce::Array<tracktion::EditItemID> latencyBypassed_;  // Handed to setLowLatencyMonitoring
+    std::map<juce::uint64, double> latencyWhenPlanned_;  // By raw EditItemID
+    juce::uint32 lastLatencyPlanMs_ = 0;
+    static constexpr juce::uint32 kLatencyPlanIntervalMs = 500;
+    bool livePreRender_ = false;  // From Config; only while lowLatencyMode_
+    bool multiThreaded_ = true;
+    bool graphRebuildPending_ = false;  // Thread count or PDC changed during playback
+
     // Test tone generator (for Phase 1 testing)
     tracktion::Plugin::Ptr testTonePlugin_;
 
@@ -342,10 +514,30 @@ class TracktionEngineWrapper : public AudioEngine,
     bool justStarted_ = false;   // True for one frame after play starts
     bool justLooped_ = false;    // True for one frame after loop
 
+    // Count-in before recording, clicked by the bridge while the transport is stopped
+    int beatsPerBar_ = 4;
+    int countInBars_ = 0;
+    bool countingIn_ = false;  // record() is waiting for the count-in to end
+    void startRecording();
+
     // Device change tracking
     int lastKnownDeviceCount_ = 0;
 
     // Helper methods
+    void applyPendingAudioProfile();
+    // Reopen the device at the supported size nearest bufferSize; true if it restarted
+    bool setDeviceBufferSize(int bufferSize);
+    void updateRenderThreadCount();
+    void updatePreRendering();
+    void rebuildGraphIfStopped();
+
+    // Re-plan which plugins low latency mode bypasses (graph rebuild only if it changed)
+    void updateLatencyPlan();
+    // Device input plus output latency
+    double getDeviceLatencySeconds() const;
+    // A plugin's latency, as last reported before it was bypassed for latency (a bypassed
+    // plugin may stop reporting it, which would bring it straight back)
+    double getPluginLatency(tracktion::Plugin& plugin) const;
     tracktion::Track* findTrackById(const std::string& track_id) const;
     tracktion::Clip* findClipById(const std::string& clip_id) const;
     std::string generateTrackId();
@@ -368,6 +560,8 @@ class TracktionEngineWrapper : public AudioEngine,
     bool isScanning_ = false;
     std::function<void(float, const juce::String&)> scanProgressCallback_;
     std::unique_ptr<PluginScanCoordinator> pluginScanCoordinator_;
+    PluginScanState pluginScanState_;  // Bundles covered by the known plugin list
+    PluginUsageStats pluginUsage_;     // Insertions per plugin, for the warm pool
 };
 
 }  // namespace magda
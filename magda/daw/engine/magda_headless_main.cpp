@@ -0,0 +1,377 @@
+/**
+ * @file magda_headless_main.cpp
+ * @brief Headless host: opens a project with no UI and renders it, for render nodes
+ *
+ * Boots the engine headless (see HeadlessHost: the saved plugin list, no audio or MIDI
+ * device, no windows), opens the project, waits for its plugins and then either lists its
+ * tracks or renders it through the RenderInterface - a mix to one WAV, or one stem per
+ * track into a directory - and exits.
+ *
+ * With --workers, stems are rendered by a StemRenderCoordinator across that many
+ * magda_headless processes (0 = chosen from the CPU count); this executable is also the
+ * worker it launches, recognised by the coordinator's pipe argument.
+ *
+ * Exit codes: 0 on success, 1 if the render failed or was cancelled, 2 for bad arguments
+ * or a project or engine that couldn't be opened.
+ *
+ * Usage:
+ *   magda_headless PROJECT --list
+ *   magda_headless PROJECT --render=FILE_OR_DIR [--stems [--workers=N]] [--start=S]
+ *                  [--end=S] [--tracks=ID,ID] [--sample-rate=44100] [--bit-depth=24]
+ *                  [--normalise]
+ */
+
+#include <juce_events/juce_events.h>
+
+#include <algorithm>
+#include <iostream>
+
+#include "../audio/AudioReaderCache.hpp"
+#include "../core/ClipManager.hpp"
+#include "../core/ModulatorEngine.hpp"
+#include "../core/TrackManager.hpp"
+#include "HeadlessHost.hpp"
+#include "StemRenderCoordinator.hpp"
+
+namespace {
+
+constexpr int kExitRenderFailed = 1;
+constexpr int kExitError = 2;
+
+using RenderStatus = magda::RenderInterface::RenderStatus;
+
+void printUsage() {
+    std::cout << "Usage: magda_headless PROJECT --list\n"
+                 "       magda_headless PROJECT --render=FILE_OR_DIR [--stems [--workers=N]]\n"
+                 "                      [--start=S] [--end=S] [--tracks=ID,ID]\n"
+                 "                      [--sample-rate=44100] [--bit-depth=24] [--normalise]\n";
+}
+
+magda::RenderInterface::RenderRequest parseRenderRequest(const juce::ArgumentList& args) {
+    magda::RenderInterface::RenderRequest request;
+    request.output_path = args.getFileForOption("--render").getFullPathName().toStdString();
+    request.stems = args.containsOption("--stems");
+    request.normalise = args.containsOption("--normalise");
+
+    if (const auto start = args.getValueForOption("--start"); start.isNotEmpty()) {
+        request.start_seconds = std::max(0.0, start.getDoubleValue());
+    }
+    if (const auto end = args.getValueForOption("--end"); end.isNotEmpty()) {
+        request.end_seconds = end.getDoubleValue();
+    }
+    if (const auto rate = args.getValueForOption("--sample-rate"); rate.isNotEmpty()) {
+        request.sample_rate = rate.getDoubleValue();
+    }
+    if (const auto bits = args.getValueForOption("--bit-depth"); bits.isNotEmpty()) {
+        request.bit_depth = bits.getIntValue();
+    }
+    for (const auto& id :
+         juce::StringArray::fromTokens(args.getValueForOption("--tracks"), ",", "")) {
+        if (id.trim().isNotEmpty()) {
+            request.track_ids.push_back(id.trim().toStdString());
+        }
+    }
+    return request;
+}
+
+void listProject(magda::HeadlessHost& host) {
+    auto& tracks = *host.getTracks();
+    auto& clips = *host.getClips();
+    for (const auto& id : tracks.getAllTrackIds()) {
+        std::cout << id << "\t" << tracks.getTrackName(id) << "\t"
+                  << clips.getTrackClips(id).size() << " clips" << std::endl;
+    }
+}
+
+const char* statusName(RenderStatus status) {
+    switch (status) {
+        case RenderStatus::Finished:
+            return "finished";
+        case RenderStatus::Cancelled:
+            return "cancelled";
+        case RenderStatus::Failed:
+            return "failed";
+        default:
+            return "unknown";
+    }
+}
+
+juce::String describeFailure(magda::RenderInterface& renderer, const std::string& jobId,
+                             RenderStatus status) {
+    auto error = juce::String("render ") + statusName(status);
+    if (const auto reason = renderer.getRenderError(jobId); !reason.empty()) {
+        error << ": " << juce::String(reason);
+    }
+    return error;
+}
+
+void shutdownModel() {
+    // Release JUCE objects held by the singletons while JUCE is still alive
+    magda::ModulatorEngine::getInstance().shutdown();
+    magda::TrackManager::getInstance().shutdown();
+    magda::ClipManager::getInstance().shutdown();
+    magda::AudioReaderCache::getInstance().shutdown();
+}
+
+/**
+ * @brief Runs one command line's work on the message loop, then stops the loop
+ */
+class HeadlessRun {
+  public:
+    HeadlessRun(magda::HeadlessHost& host, const juce::ArgumentList& args)
+        : host_(host), args_(args) {}
+
+    int getExitCode() const {
+        return exitCode_;
+    }
+
+    void start() {
+        project_ = args_.arguments[0].resolveAsFile();
+        if (!project_.existsAsFile()) {
+            finish(kExitError, "no such project: " + project_.getFullPathName());
+            return;
+        }
+
+        host_.openProject(project_, [this](const juce::String& error) {
+            if (error.isNotEmpty()) {
+                finish(kExitError, "can't open the project: " + error);
+            } else if (args_.containsOption("--list")) {
+                listProject(host_);
+                finish(0);
+            } else {
+                render();
+            }
+        });
+    }
+
+  private:
+    void render() {
+        const auto request = parseRenderRequest(args_);
+        if (request.stems && args_.containsOption("--workers")) {
+            renderWithWorkers(request);
+            return;
+        }
+
+        auto onDone = [this](const std::string& id, RenderStatus status) {
+            auto& renderer = *host_.getRenderer();
+            for (const auto& file : renderer.getRenderedFiles(id)) {
+                std::cout << "Wrote " << file << std::endl;
+            }
+            if (status == RenderStatus::Finished) {
+                finish(0);
+            } else {
+                finish(kExitRenderFailed, describeFailure(renderer, id, status));
+            }
+        };
+        if (host_.render(request, onDone).empty()) {
+            finish(kExitError, "no project to render");
+        }
+    }
+
+    void renderWithWorkers(const magda::RenderInterface::RenderRequest& request) {
+        auto onProgress = [](float progress) {
+            std::cout << "Stems " << juce::roundToInt(progress * 100.0f) << "%" << std::endl;
+        };
+        auto onDone = [this](bool success, const juce::StringArray& files,
+                             const juce::String& error) {
+            for (const auto& file : files) {
+                std::cout << "Wrote " << file << std::endl;
+            }
+            finish(success ? 0 : kExitRenderFailed, success ? juce::String() : error);
+        };
+        coordinator_.setMaxWorkers(args_.getValueForOption("--workers").getIntValue());
+        coordinator_.start(project_, request,
+                           magda::StemRenderCoordinator::collectTracks(request.track_ids),
+                           onProgress, onDone);
+    }
+
+    void finish(int exitCode, const juce::String& error = {}) {
+        if (error.isNotEmpty()) {
+            std::cerr << "magda_headless: " << error << std::endl;
+        }
+        exitCode_ = exitCode;
+        juce::MessageManager::getInstance()->stopDispatchLoop();
+    }
+
+    magda::HeadlessHost& host_;
+    const juce::ArgumentList& args_;
+    juce::File project_;
+    magda::StemRenderCoordinator coordinator_;
+    int exitCode_ = 0;
+};
+
+/**
+ * @brief The worker side of a StemRenderCoordinator: renders the partitions it is sent
+ *
+ * Each MSG_RENDER names the project, which is opened on first use and kept open for any
+ * later partition, and the tracks to render into a directory; the reply is MSG_DONE with
+ * the stems in track order, or MSG_ERROR. IPC arrives on JUCE's connection thread and is
+ * handled on the message thread.
+ */
+class StemRenderWorker : public juce::ChildProcessWorker {
+  public:
+    explicit StemRenderWorker(magda::HeadlessHost& host) : host_(host) {}
+
+    ~StemRenderWorker() override {
+        *alive_ = false;
+    }
+
+    void handleMessageFromCoordinator(const juce::MemoryBlock& message) override {
+        juce::MessageManager::callAsync([this, alive = alive_, message] {
+            if (*alive) {
+                handleMessage(message);
+            }
+        });
+    }
+
+    void handleConnectionLost() override {
+        juce::MessageManager::callAsync(
+            [] { juce::MessageManager::getInstance()->stopDispatchLoop(); });
+    }
+
+  private:
+    void handleMessage(const juce::MemoryBlock& message) {
+        juce::MemoryInputStream stream(message, false);
+        const juce::String msgType = stream.readString();
+
+        if (msgType == magda::StemRenderIPC::MSG_QUIT) {
+            juce::MessageManager::getInstance()->stopDispatchLoop();
+            return;
+        }
+        if (msgType != magda::StemRenderIPC::MSG_RENDER) {
+            return;
+        }
+
+        const juce::File project(stream.readString());
+        magda::RenderInterface::RenderRequest request;
+        request.output_path = stream.readString().toStdString();
+        request.stems = true;
+        request.start_seconds = stream.readDouble();
+        request.end_seconds = stream.readDouble();
+        request.sample_rate = stream.readDouble();
+        request.bit_depth = stream.readInt();
+        request.normalise = stream.readBool();
+        const int numTracks = stream.readInt();
+        for (int i = 0; i < numTracks && !stream.isExhausted(); ++i) {
+            request.track_ids.push_back(std::to_string(stream.readInt()));
+        }
+
+        if (!host_.isInitialized()) {
+            sendError("failed to initialize the audio engine");
+        } else if (project == openProject_) {
+            render(request);
+        } else {
+            host_.openProject(project, [this, project, request](const juce::String& error) {
+                if (error.isNotEmpty()) {
+                    sendError("can't open the project: " + error);
+                    return;
+                }
+                openProject_ = project;
+                render(request);
+            });
+        }
+    }
+
+    void render(const magda::RenderInterface::RenderRequest& request) {
+        auto onDone = [this](const std::string& id, RenderStatus status) {
+            auto& renderer = *host_.getRenderer();
+            if (status != RenderStatus::Finished) {
+                sendError(describeFailure(renderer, id, status));
+                return;
+            }
+            const auto files = renderer.getRenderedFiles(id);
+            juce::MemoryBlock msg;
+            juce::MemoryOutputStream stream(msg, false);
+            stream.writeString(magda::StemRenderIPC::MSG_DONE);
+            stream.writeInt(static_cast<int>(files.size()));
+            for (const auto& file : files) {
+                stream.writeString(juce::String(file));
+            }
+            sendMessageToCoordinator(msg);
+        };
+        if (host_.render(request, onDone).empty()) {
+            sendError("no project to render");
+        }
+    }
+
+    void sendError(const juce::String& error) {
+        juce::MemoryBlock msg;
+        juce::MemoryOutputStream stream(msg, false);
+        stream.writeString(magda::StemRenderIPC::MSG_ERROR);
+        stream.writeString(error);
+        sendMessageToCoordinator(msg);
+    }
+
+    magda::HeadlessHost& host_;
+    juce::File openProject_;
+    std::shared_ptr<bool> alive_ = std::make_shared<bool>(true);
+};
+
+bool isStemRenderWorker(const juce::ArgumentList& args) {
+    const auto pipeOption = "--" + juce::String(magda::StemRenderIPC::WORKER_ID) + ":";
+    return std::any_of(args.arguments.begin(), args.arguments.end(),
+                       [&](const auto& arg) { return arg.text.startsWith(pipeOption); });
+}
+
+int runStemRenderWorker(const juce::ArgumentList& args) {
+    juce::ScopedJuceInitialiser_GUI juceInit;
+
+    juce::StringArray commandLine;
+    for (const auto& arg : args.arguments) {
+        commandLine.add(arg.text);
+    }
+
+    int exitCode = kExitError;
+    {
+        // A host that fails to start still connects, so the coordinator hears why
+        magda::HeadlessHost host;
+        if (!host.initialize()) {
+            std::cerr << "magda_headless: failed to initialize the audio engine" << std::endl;
+        }
+        StemRenderWorker worker(host);
+        if (worker.initialiseFromCommandLine(commandLine.joinIntoString(" "),
+                                             magda::StemRenderIPC::WORKER_ID)) {
+            juce::MessageManager::getInstance()->runDispatchLoop();
+            exitCode = 0;
+        }
+        host.shutdown();
+    }
+
+    shutdownModel();
+    return exitCode;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    juce::ArgumentList args(argc, argv);
+    if (isStemRenderWorker(args)) {
+        return runStemRenderWorker(args);
+    }
+    if (args.containsOption("--help|-h") || args.size() == 0 ||
+        args.arguments[0].isOption() ||
+        (!args.containsOption("--list") && !args.containsOption("--render"))) {
+        printUsage();
+        return args.containsOption("--help|-h") ? 0 : kExitError;
+    }
+
+    // The engine, ProjectManager and AudioBridge call back on a message thread; this is it
+    juce::ScopedJuceInitialiser_GUI juceInit;
+
+    int exitCode = kExitError;
+    {
+        magda::HeadlessHost host;
+        if (!host.initialize()) {
+            std::cerr << "magda_headless: failed to initialize the audio engine" << std::endl;
+        } else {
+            HeadlessRun run(host, args);
+            juce::MessageManager::callAsync([&run] { run.start(); });
+            juce::MessageManager::getInstance()->runDispatchLoop();
+            exitCode = run.getExitCode();
+        }
+        host.shutdown();
+    }
+
+    shutdownModel();
+    return exitCode;
+}
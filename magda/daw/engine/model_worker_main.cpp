@@ -0,0 +1,364 @@
+/**
+ * @file model_worker_main.cpp
+ * @brief Out-of-process local model worker
+ *
+ * Launched by LocalModelClient and kept running between prompts. It maps the model once,
+ * touches its pages so they stay in the page cache, and generates on a background-priority
+ * thread pinned to the cores the audio engine leaves free. Each prompt is run by the
+ * llama.cpp command-line generator, which maps the same file and so starts from resident
+ * pages; it inherits the thread's affinity and the process's priority. If generation
+ * crashes or hangs, only this process is affected.
+ */
+
+#include <juce_core/juce_core.h>
+#include <juce_events/juce_events.h>
+
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <mutex>
+
+#include "LocalModelClient.hpp"
+
+namespace {
+
+/**
+ * @brief Bytes of data that end on a whole UTF-8 character
+ *
+ * Output is read in fixed-size pieces, which can split a multi-byte character; the tail
+ * is carried into the next piece so every chunk sent is valid text.
+ */
+int completeUtf8Length(const char* data, int size) {
+    int start = size;
+    for (int i = 0; i < 4 && start > 0; ++i) {
+        const auto byte = static_cast<unsigned char>(data[start - 1]);
+        if ((byte & 0xc0) != 0x80) {
+            // A lead byte (or ASCII): complete if its sequence fits in what we have
+            const int needed = byte >= 0xf0 ? 4 : byte >= 0xe0 ? 3 : byte >= 0xc0 ? 2 : 1;
+            return size - (start - 1) >= needed ? size : start - 1;
+        }
+        --start;
+    }
+    return size;  // Not UTF-8 after all; send it as it is
+}
+
+/**
+ * @brief Holds the model and runs prompts, one at a time, off the IPC thread
+ */
+class GenerationThread : public juce::Thread {
+  public:
+    struct Job {
+        juce::int64 id = 0;
+        juce::String prompt;
+        int maxTokens = 256;
+        double temperature = 0.2;
+    };
+
+    using Send = std::function<void(const juce::MemoryBlock&)>;
+
+    GenerationThread(const juce::File& model, const juce::String& generator, int numThreads,
+                     juce::uint32 coreMask, Send send)
+        : juce::Thread("Model generation"),
+          model_(model),
+          generator_(generator),
+          numThreads_(numThreads),
+          coreMask_(coreMask),
+          send_(std::move(send)) {}
+
+    ~GenerationThread() override {
+        signalThreadShouldExit();
+        {
+            const std::lock_guard<std::mutex> lock(mutex_);
+            jobs_.clear();
+            if (process_ != nullptr) {
+                cancelled_ = true;
+                process_->kill();
+            }
+        }
+        wake_.signal();
+        stopThread(5000);
+    }
+
+    void enqueue(const Job& job) {
+        {
+            const std::lock_guard<std::mutex> lock(mutex_);
+            jobs_.push_back(job);
+        }
+        wake_.signal();
+    }
+
+    // Drops the job if it hasn't started, or kills its generator if it has
+    void cancel(juce::int64 id) {
+        const std::lock_guard<std::mutex> lock(mutex_);
+        for (auto it = jobs_.begin(); it != jobs_.end(); ++it) {
+            if (it->id == id) {
+                jobs_.erase(it);
+                sendDone(id, true);
+                return;
+            }
+        }
+        if (current_ == id && process_ != nullptr) {
+            cancelled_ = true;
+            process_->kill();
+        }
+    }
+
+    void run() override {
+        if (coreMask_ != 0) {
+            juce::Thread::setCurrentThreadAffinityMask(coreMask_);
+        }
+        if (!warm()) {
+            sendError(0, "Can't map the model: " + model_.getFullPathName());
+            return;
+        }
+        juce::MemoryBlock ready;
+        juce::MemoryOutputStream(ready, false).writeString(magda::LocalModelIPC::MSG_READY);
+        send_(ready);
+
+        while (!threadShouldExit()) {
+            Job job;
+            {
+                const std::lock_guard<std::mutex> lock(mutex_);
+                if (!jobs_.empty()) {
+                    job = jobs_.front();
+                    jobs_.pop_front();
+                    current_ = job.id;
+                    cancelled_ = false;
+                }
+            }
+            if (job.id == 0) {
+                wake_.wait(-1);
+                continue;
+            }
+            generate(job);
+        }
+    }
+
+  private:
+    // Map the model and fault in every page, so generation doesn't wait on the disk
+    bool warm() {
+        mapped_ = std::make_unique<juce::MemoryMappedFile>(model_,
+                                                           juce::MemoryMappedFile::readOnly);
+        const auto* data = static_cast<const volatile char*>(mapped_->getData());
+        if (data == nullptr) {
+            return false;
+        }
+        char sum = 0;
+        for (size_t offset = 0; offset < mapped_->getSize() && !threadShouldExit();
+             offset += kPageBytes) {
+            sum = static_cast<char>(sum + data[offset]);
+        }
+        juce::ignoreUnused(sum);
+        return true;
+    }
+
+    void generate(const Job& job) {
+        juce::StringArray args{generator_,
+                               "--model",
+                               model_.getFullPathName(),
+                               "-p",
+                               job.prompt,
+                               "--no-conversation",
+                               "--no-display-prompt",
+                               "--no-warmup",
+                               "--n-predict",
+                               juce::String(job.maxTokens),
+                               "--temp",
+                               juce::String(job.temperature),
+                               "--threads",
+                               juce::String(numThreads_)};
+
+        juce::ChildProcess process;
+        if (!process.start(args, juce::ChildProcess::wantStdOut)) {
+            finishJob(job.id, "Can't run " + generator_);
+            return;
+        }
+        {
+            const std::lock_guard<std::mutex> lock(mutex_);
+            process_ = &process;
+            if (cancelled_) {
+                process.kill();  // Cancelled while starting
+            }
+        }
+
+        char buffer[kReadBytes];
+        int pending = 0;
+        bool produced = false;
+        for (;;) {
+            const int read = process.readProcessOutput(buffer + pending, kReadBytes - pending);
+            if (read <= 0) {
+                break;
+            }
+            const int size = pending + read;
+            const int complete = completeUtf8Length(buffer, size);
+            if (complete > 0) {
+                sendChunk(job.id, juce::String::fromUTF8(buffer, complete));
+                produced = true;
+            }
+            pending = size - complete;
+            std::memmove(buffer, buffer + complete, static_cast<size_t>(pending));
+        }
+        process.waitForProcessToFinish(1000);
+
+        {
+            const std::lock_guard<std::mutex> lock(mutex_);
+            process_ = nullptr;
+        }
+        const bool failed = !produced && process.getExitCode() != 0;
+        finishJob(job.id, failed ? "The generator exited with " +
+                                       juce::String(static_cast<int>(process.getExitCode()))
+                                 : juce::String());
+    }
+
+    void finishJob(juce::int64 id, const juce::String& error) {
+        const std::lock_guard<std::mutex> lock(mutex_);
+        if (cancelled_) {
+            sendDone(id, true);
+        } else if (error.isNotEmpty()) {
+            sendError(id, error);
+        } else {
+            sendDone(id, false);
+        }
+        current_ = 0;
+    }
+
+    void sendChunk(juce::int64 id, const juce::String& text) {
+        juce::MemoryBlock msg;
+        juce::MemoryOutputStream stream(msg, false);
+        stream.writeString(magda::LocalModelIPC::MSG_CHUNK);
+        stream.writeInt64(id);
+        stream.writeString(text);
+        send_(msg);
+    }
+
+    void sendDone(juce::int64 id, bool cancelled) {
+        juce::MemoryBlock msg;
+        juce::MemoryOutputStream stream(msg, false);
+        stream.writeString(magda::LocalModelIPC::MSG_DONE);
+        stream.writeInt64(id);
+        stream.writeBool(cancelled);
+        send_(msg);
+    }
+
+    void sendError(juce::int64 id, const juce::String& error) {
+        juce::MemoryBlock msg;
+        juce::MemoryOutputStream stream(msg, false);
+        stream.writeString(magda::LocalModelIPC::MSG_ERROR);
+        stream.writeInt64(id);
+        stream.writeString(error);
+        send_(msg);
+    }
+
+    static constexpr size_t kPageBytes = 4096;
+    static constexpr int kReadBytes = 1024;
+
+    const juce::File model_;
+    const juce::String generator_;
+    const int numThreads_;
+    const juce::uint32 coreMask_;
+    const Send send_;
+    std::unique_ptr<juce::MemoryMappedFile> mapped_;  // Kept for the worker's lifetime
+
+    std::mutex mutex_;
+    std::deque<Job> jobs_;
+    juce::int64 current_ = 0;  // Running job, 0 if none
+    juce::ChildProcess* process_ = nullptr;
+    bool cancelled_ = false;
+    juce::WaitableEvent wake_;
+};
+
+class ModelWorker : public juce::ChildProcessWorker {
+  public:
+    void handleMessageFromCoordinator(const juce::MemoryBlock& message) override {
+        juce::MemoryInputStream stream(message, false);
+        const juce::String msgType = stream.readString();
+
+        if (msgType == magda::LocalModelIPC::MSG_QUIT) {
+            juce::JUCEApplicationBase::quit();
+        } else if (msgType == magda::LocalModelIPC::MSG_LOAD) {
+            const juce::File model(stream.readString());
+            const auto generator = stream.readString();
+            const int numThreads = stream.readInt();
+            const auto coreMask = static_cast<juce::uint32>(stream.readInt());
+            load(model, generator, numThreads, coreMask);
+        } else if (msgType == magda::LocalModelIPC::MSG_PROMPT && generation_ != nullptr) {
+            GenerationThread::Job job;
+            job.id = stream.readInt64();
+            job.prompt = stream.readString();
+            job.maxTokens = stream.readInt();
+            job.temperature = stream.readDouble();
+            generation_->enqueue(job);
+        } else if (msgType == magda::LocalModelIPC::MSG_CANCEL && generation_ != nullptr) {
+            generation_->cancel(stream.readInt64());
+        }
+    }
+
+    void handleConnectionLost() override {
+        juce::JUCEApplicationBase::quit();
+    }
+
+  private:
+    void load(const juce::File& model, const juce::String& generator, int numThreads,
+              juce::uint32 coreMask) {
+        if (generation_ != nullptr) {
+            return;  // One model per worker
+        }
+
+        // Below the DAW, and everything its background threads inherit
+        juce::Process::setPriority(juce::Process::LowPriority);
+
+        generation_ = std::make_unique<GenerationThread>(
+            model, generator, numThreads, coreMask,
+            [this](const juce::MemoryBlock& msg) { sendMessageToCoordinator(msg); });
+        generation_->startThread(juce::Thread::Priority::background);
+        std::cout << "[ModelWorker] Loading " << model.getFullPathName() << std::endl;
+    }
+
+    std::unique_ptr<GenerationThread> generation_;
+};
+
+}  // namespace
+
+class ModelWorkerApplication : public juce::JUCEApplicationBase {
+  public:
+    const juce::String getApplicationName() override {
+        return "MAGDA Model Worker";
+    }
+    const juce::String getApplicationVersion() override {
+        return "1.0.0";
+    }
+    bool moreThanOneInstanceAllowed() override {
+        return true;
+    }
+
+    void initialise(const juce::String& commandLine) override {
+        worker_ = std::make_unique<ModelWorker>();
+        if (!worker_->initialiseFromCommandLine(commandLine, magda::LocalModelIPC::WORKER_ID)) {
+            std::cerr << "[ModelWorker] Must be launched by MAGDA" << std::endl;
+            setApplicationReturnValue(1);
+            quit();
+        }
+    }
+
+    void shutdown() override {
+        worker_.reset();
+    }
+
+    void systemRequestedQuit() override {
+        quit();
+    }
+
+    void anotherInstanceStarted(const juce::String&) override {}
+    void suspended() override {}
+    void resumed() override {}
+    void unhandledException(const std::exception*, const juce::String&, int) override {
+        std::cerr << "[ModelWorker] Unhandled exception - exiting" << std::endl;
+    }
+
+  private:
+    std::unique_ptr<ModelWorker> worker_;
+};
+
+//==============================================================================
+START_JUCE_APPLICATION(ModelWorkerApplication)
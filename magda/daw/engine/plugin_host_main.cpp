@@ -0,0 +1,364 @@
+/**
+ * @file plugin_host_main.cpp
+ * @brief Out-of-process plugin host
+ *
+ * Launched by SandboxHost for plugins run in the sandbox. Plugins are loaded into numbered
+ * slots on this process's message thread; blocks arrive through the shared SandboxTransport
+ * region and are run on a real-time thread directly on the shared channels, every slot the
+ * request lists in turn, so a batch of plugins costs one round trip. A plugin that crashes
+ * or hangs takes down only this process.
+ */
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <juce_core/juce_core.h>
+#include <juce_events/juce_events.h>
+
+#include <array>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <mutex>
+
+#include "../audio/SandboxHost.hpp"
+
+namespace {
+
+using magda::SandboxTransport;
+
+/**
+ * @brief The loaded plugins, and the thread that runs blocks through them
+ */
+class RenderThread : public juce::Thread {
+  public:
+    using Plugins =
+        std::array<std::unique_ptr<juce::AudioPluginInstance>, SandboxTransport::kMaxSlots>;
+
+    RenderThread() : juce::Thread("Sandbox render") {
+        midi_.ensureSize(sizeof(SandboxTransport::MidiEvent) * SandboxTransport::kMaxMidiEvents);
+    }
+
+    ~RenderThread() override {
+        stopThread(2000);
+    }
+
+    bool open(const juce::File& regionFile) {
+        region_ = std::make_unique<juce::MemoryMappedFile>(
+            regionFile, juce::MemoryMappedFile::readWrite, false);
+        if (region_->getData() == nullptr ||
+            region_->getSize() < SandboxTransport::getRegionBytes()) {
+            return false;
+        }
+        transport_ = std::make_unique<SandboxTransport>(region_->getData());
+        if (!transport_->isValid()) {
+            return false;
+        }
+
+        // Answer whatever an earlier host of this region left unanswered
+        lastSeen_ = transport_->header().request.load(std::memory_order_acquire);
+        transport_->reply(lastSeen_);
+        return startRealtimeThread(juce::Thread::RealtimeOptions{});
+    }
+
+    // Message thread: swap a slot's plugin (nullptr to empty it), waiting out any block
+    void setPlugin(int slot, std::unique_ptr<juce::AudioPluginInstance> plugin) {
+        std::unique_ptr<juce::AudioPluginInstance> old;
+        {
+            const std::lock_guard<std::mutex> lock(mutex_);
+            old = std::move(plugins_[static_cast<size_t>(slot)]);
+            plugins_[static_cast<size_t>(slot)] = std::move(plugin);
+        }
+        if (old != nullptr) {
+            old->releaseResources();
+        }
+    }
+
+    juce::AudioPluginInstance* getPlugin(int slot) {
+        return plugins_[static_cast<size_t>(slot)].get();
+    }
+
+    // Message thread: re-prepare every plugin, with no block running through them
+    void prepare(double sampleRate, int blockSize) {
+        const std::lock_guard<std::mutex> lock(mutex_);
+        sampleRate_ = sampleRate;
+        blockSize_ = blockSize;
+        for (auto& plugin : plugins_) {
+            if (plugin != nullptr) {
+                plugin->releaseResources();
+                plugin->prepareToPlay(sampleRate_, blockSize_);
+            }
+        }
+    }
+
+    double getSampleRate() const {
+        return sampleRate_;
+    }
+    int getBlockSize() const {
+        return blockSize_;
+    }
+
+    void run() override {
+        while (!threadShouldExit()) {
+            if (!transport_->waitForRequest(lastSeen_, std::chrono::milliseconds(100))) {
+                continue;
+            }
+            const auto start = juce::Time::getHighResolutionTicks();
+            {
+                const std::lock_guard<std::mutex> lock(mutex_);
+                process();
+            }
+            transport_->header().hostBusyNs = static_cast<int64_t>(
+                juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() -
+                                                         start) *
+                1.0e9);
+            transport_->reply(lastSeen_);
+        }
+    }
+
+  private:
+    void process() {
+        auto& h = transport_->header();
+        const int numFrames = juce::jlimit(0, SandboxTransport::kMaxFrames, h.numFrames);
+        const int numChannels = juce::jlimit(0, SandboxTransport::kMaxChannels, h.numChannels);
+        if (numFrames == 0) {
+            h.numMidiOut = 0;
+            return;
+        }
+
+        midi_.clear();
+        const auto* midiIn = transport_->getMidiIn();
+        for (int i = 0; i < juce::jmin(h.numMidiIn, SandboxTransport::kMaxMidiEvents); ++i) {
+            midi_.addEvent(midiIn[i].data, midiIn[i].size, midiIn[i].frame);
+        }
+
+        float* channels[SandboxTransport::kMaxChannels];
+        for (int ch = 0; ch < SandboxTransport::kMaxChannels; ++ch) {
+            channels[ch] = transport_->getChannel(ch);
+        }
+
+        for (int i = 0; i < juce::jlimit(0, SandboxTransport::kMaxSlots, h.numSlots); ++i) {
+            const int slot = h.slots[i];
+            if (slot < 0 || slot >= SandboxTransport::kMaxSlots) {
+                continue;
+            }
+            auto* plugin = plugins_[static_cast<size_t>(slot)].get();
+            if (plugin == nullptr) {
+                continue;  // Still loading, or failed to: dry
+            }
+
+            // Channels beyond the track's are scratch the plugin may need
+            const int wanted = juce::jmax(plugin->getTotalNumInputChannels(),
+                                          plugin->getTotalNumOutputChannels());
+            const int used = juce::jlimit(numChannels, SandboxTransport::kMaxChannels, wanted);
+            for (int ch = numChannels; ch < used; ++ch) {
+                juce::FloatVectorOperations::clear(channels[ch], numFrames);
+            }
+            juce::AudioBuffer<float> buffer(channels, used, numFrames);
+            plugin->processBlock(buffer, midi_);
+        }
+
+        int numOut = 0;
+        auto* midiOut = transport_->getMidiOut();
+        for (const auto metadata : midi_) {
+            if (metadata.numBytes > 3 || numOut == SandboxTransport::kMaxMidiEvents) {
+                continue;
+            }
+            auto& event = midiOut[numOut++];
+            event.frame = metadata.samplePosition;
+            event.size = static_cast<uint8_t>(metadata.numBytes);
+            std::memcpy(event.data, metadata.data, static_cast<size_t>(metadata.numBytes));
+        }
+        h.numMidiOut = numOut;
+    }
+
+    std::unique_ptr<juce::MemoryMappedFile> region_;
+    std::unique_ptr<SandboxTransport> transport_;
+    uint32_t lastSeen_ = 0;
+
+    std::mutex mutex_;  // Held while a block runs; swaps and prepares wait for it
+    Plugins plugins_;
+    juce::MidiBuffer midi_;
+    double sampleRate_ = 44100.0;
+    int blockSize_ = 512;
+};
+
+class PluginHostWorker : public juce::ChildProcessWorker {
+  public:
+    PluginHostWorker() {
+#if JUCE_PLUGINHOST_VST3
+        formatManager_.addFormat(std::make_unique<juce::VST3PluginFormat>());
+#endif
+#if JUCE_PLUGINHOST_AU && JUCE_MAC
+        formatManager_.addFormat(std::make_unique<juce::AudioUnitPluginFormat>());
+#endif
+    }
+
+    ~PluginHostWorker() override {
+        render_.stopThread(2000);
+        for (int slot = 0; slot < SandboxTransport::kMaxSlots; ++slot) {
+            render_.setPlugin(slot, nullptr);
+        }
+    }
+
+    // IPC thread: plugins are created and called on the message thread
+    void handleMessageFromCoordinator(const juce::MemoryBlock& message) override {
+        juce::MessageManager::callAsync([this, message]() { handleMessage(message); });
+    }
+
+    void handleConnectionLost() override {
+        juce::JUCEApplicationBase::quit();
+    }
+
+  private:
+    void handleMessage(const juce::MemoryBlock& message) {
+        juce::MemoryInputStream stream(message, false);
+        const juce::String msgType = stream.readString();
+
+        if (msgType == magda::SandboxIPC::MSG_QUIT) {
+            juce::JUCEApplicationBase::quit();
+        } else if (msgType == magda::SandboxIPC::MSG_OPEN) {
+            const juce::File regionFile(stream.readString());
+            if (!render_.open(regionFile)) {
+                std::cerr << "[PluginHost] Can't open " << regionFile.getFullPathName()
+                          << std::endl;
+                juce::JUCEApplicationBase::quit();
+            }
+        } else if (msgType == magda::SandboxIPC::MSG_PREPARE) {
+            const double sampleRate = stream.readDouble();
+            const int blockSize = stream.readInt();
+            render_.prepare(sampleRate, blockSize);
+        } else if (msgType == magda::SandboxIPC::MSG_LOAD) {
+            const int slot = stream.readInt();
+            const auto descriptionXml = stream.readString();
+            const auto state = readBlock(stream);
+            const double sampleRate = stream.readDouble();
+            const int blockSize = stream.readInt();
+            if (isSlot(slot)) {
+                load(slot, descriptionXml, state, sampleRate, blockSize);
+            }
+        } else if (msgType == magda::SandboxIPC::MSG_REMOVE) {
+            const int slot = stream.readInt();
+            if (isSlot(slot)) {
+                render_.setPlugin(slot, nullptr);
+            }
+        } else if (msgType == magda::SandboxIPC::MSG_SET_STATE) {
+            const int slot = stream.readInt();
+            const auto state = readBlock(stream);
+            if (isSlot(slot) && render_.getPlugin(slot) != nullptr && state.getSize() > 0) {
+                render_.getPlugin(slot)->setStateInformation(state.getData(),
+                                                             static_cast<int>(state.getSize()));
+            }
+        } else if (msgType == magda::SandboxIPC::MSG_GET_STATE) {
+            const int slot = stream.readInt();
+            const auto requestId = stream.readInt64();
+            juce::MemoryBlock state;
+            if (isSlot(slot) && render_.getPlugin(slot) != nullptr) {
+                render_.getPlugin(slot)->getStateInformation(state);
+            }
+            juce::MemoryBlock reply;
+            juce::MemoryOutputStream out(reply, false);
+            out.writeString(magda::SandboxIPC::MSG_STATE);
+            out.writeInt64(requestId);
+            out.write(state.getData(), state.getSize());
+            sendMessageToCoordinator(reply);
+        }
+    }
+
+    void load(int slot, const juce::String& descriptionXml, const juce::MemoryBlock& state,
+              double sampleRate, int blockSize) {
+        juce::PluginDescription description;
+        juce::String error;
+        std::unique_ptr<juce::AudioPluginInstance> plugin;
+        if (auto xml = juce::parseXML(descriptionXml); xml != nullptr &&
+                                                         description.loadFromXml(*xml)) {
+            plugin = formatManager_.createPluginInstance(description, sampleRate, blockSize,
+                                                        error);
+        } else {
+            error = "Bad plugin description";
+        }
+
+        if (plugin != nullptr) {
+            if (state.getSize() > 0) {
+                plugin->setStateInformation(state.getData(), static_cast<int>(state.getSize()));
+            }
+            plugin->enableAllBuses();
+            plugin->prepareToPlay(render_.getSampleRate(), render_.getBlockSize());
+        }
+
+        juce::MemoryBlock reply;
+        juce::MemoryOutputStream out(reply, false);
+        out.writeString(magda::SandboxIPC::MSG_LOADED);
+        out.writeInt(slot);
+        out.writeBool(plugin != nullptr);
+        out.writeInt(plugin != nullptr ? plugin->getLatencySamples() : 0);
+        out.writeDouble(plugin != nullptr ? plugin->getTailLengthSeconds() : 0.0);
+        out.writeString(plugin != nullptr
+                            ? juce::String()
+                            : "Plugin failed to load in the sandbox: " + description.name +
+                                  (error.isNotEmpty() ? " (" + error + ")" : juce::String()));
+        std::cout << "[PluginHost] Slot " << slot << ": " << description.name
+                  << (plugin != nullptr ? " loaded" : " failed") << std::endl;
+        render_.setPlugin(slot, std::move(plugin));
+        sendMessageToCoordinator(reply);
+    }
+
+    static juce::MemoryBlock readBlock(juce::MemoryInputStream& stream) {
+        juce::MemoryBlock block;
+        const int size = stream.readInt();
+        if (size > 0) {
+            stream.readIntoMemoryBlock(block, size);
+        }
+        return block;
+    }
+
+    static bool isSlot(int slot) {
+        return slot >= 0 && slot < SandboxTransport::kMaxSlots;
+    }
+
+    juce::AudioPluginFormatManager formatManager_;
+    RenderThread render_;
+};
+
+}  // namespace
+
+class PluginHostApplication : public juce::JUCEApplicationBase {
+  public:
+    const juce::String getApplicationName() override {
+        return "MAGDA Plugin Host";
+    }
+    const juce::String getApplicationVersion() override {
+        return "1.0.0";
+    }
+    bool moreThanOneInstanceAllowed() override {
+        return true;
+    }
+
+    void initialise(const juce::String& commandLine) override {
+        worker_ = std::make_unique<PluginHostWorker>();
+        if (!worker_->initialiseFromCommandLine(commandLine, magda::SandboxIPC::WORKER_ID)) {
+            std::cerr << "[PluginHost] Must be launched by MAGDA" << std::endl;
+            setApplicationReturnValue(1);
+            quit();
+        }
+    }
+
+    void shutdown() override {
+        worker_.reset();
+    }
+
+    void systemRequestedQuit() override {
+        quit();
+    }
+
+    void anotherInstanceStarted(const juce::String&) override {}
+    void suspended() override {}
+    void resumed() override {}
+    void unhandledException(const std::exception*, const juce::String&, int) override {
+        std::cerr << "[PluginHost] Unhandled exception - exiting" << std::endl;
+    }
+
+  private:
+    std::unique_ptr<PluginHostWorker> worker_;
+};
+
+//==============================================================================
+START_JUCE_APPLICATION(PluginHostApplication)
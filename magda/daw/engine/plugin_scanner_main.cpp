@@ -18,8 +18,9 @@
 static std::ofstream g_logFile;
 
 static void initLog() {
-    // Use /tmp for immediate accessibility - always writable
-    g_logFile.open("/tmp/magda_scanner_debug.log", std::ios::out | std::ios::trunc);
+    // Use /tmp for immediate accessibility - always writable. Several scanners run at once,
+    // so append rather than truncate.
+    g_logFile.open("/tmp/magda_scanner_debug.log", std::ios::out | std::ios::app);
 }
 
 static void log(const std::string& msg) {
@@ -32,12 +33,10 @@ static void log(const std::string& msg) {
 }
 
 namespace ScannerIPC {
-constexpr const char* MSG_SCAN_FORMAT = "SCAN";
-constexpr const char* MSG_PROGRESS = "PROG";
+constexpr const char* MSG_SCAN_FILE = "SCNF";
 constexpr const char* MSG_PLUGIN_FOUND = "PLUG";
 constexpr const char* MSG_SCAN_COMPLETE = "DONE";
 constexpr const char* MSG_ERROR = "ERR";
-constexpr const char* MSG_CURRENT_FILE = "FILE";
 constexpr const char* MSG_QUIT = "QUIT";
 }  // namespace ScannerIPC
 
@@ -71,25 +70,11 @@ class PluginScannerWorker : public juce::ChildProcessWorker {
                 log("[Scanner] Received QUIT message, exiting gracefully");
                 juce::JUCEApplicationBase::quit();
                 return;
-            } else if (msgType == ScannerIPC::MSG_SCAN_FORMAT) {
+            } else if (msgType == ScannerIPC::MSG_SCAN_FILE) {
                 juce::String formatName = stream.readString();
-                juce::String searchPathStr = stream.readString();
+                juce::String fileOrIdentifier = stream.readString();
 
-                // Read blacklist
-                int blacklistSize = stream.readInt();
-                juce::StringArray blacklist;
-                for (int i = 0; i < blacklistSize; ++i) {
-                    blacklist.add(stream.readString());
-                }
-
-                log("[Scanner] Scanning format: " + formatName.toStdString());
-                log("[Scanner] Search path length: " + std::to_string(searchPathStr.length()));
-                log("[Scanner] Blacklist size: " + std::to_string(blacklistSize));
-                log("[Scanner] Calling scanFormat...");
-
-                scanFormat(formatName, searchPathStr, blacklist);
-
-                log("[Scanner] scanFormat returned, waiting for next message...");
+                scanFile(formatName, fileOrIdentifier);
             }
         } catch (const std::exception& e) {
             log(std::string("[Scanner] EXCEPTION: ") + e.what());
@@ -111,20 +96,13 @@ class PluginScannerWorker : public juce::ChildProcessWorker {
     juce::AudioPluginFormatManager formatManager_;
     juce::KnownPluginList knownList_;
 
-    void scanFormat(const juce::String& formatName, const juce::String& searchPathStr,
-                    const juce::StringArray& blacklist) {
+    // Scan a single plugin file. The coordinator hands out one file at a time, so if this
+    // crashes it knows exactly which file to blacklist.
+    void scanFile(const juce::String& formatName, const juce::String& fileOrIdentifier) {
         try {
-            log("[Scanner] scanFormat() started for: " + formatName.toStdString());
-
-            // Find the format
-            log("[Scanner] Looking for format in " +
-                std::to_string(formatManager_.getNumFormats()) + " registered formats");
-
             juce::AudioPluginFormat* format = nullptr;
             for (int i = 0; i < formatManager_.getNumFormats(); ++i) {
                 auto* fmt = formatManager_.getFormat(i);
-                log("[Scanner] Checking format " + std::to_string(i) + ": " +
-                    (fmt ? fmt->getName().toStdString() : "null"));
                 if (fmt && fmt->getName() == formatName) {
                     format = fmt;
                     break;
@@ -138,111 +116,33 @@ class PluginScannerWorker : public juce::ChildProcessWorker {
                 return;
             }
 
-            log("[Scanner] Using format: " + format->getName().toStdString());
-
-            juce::FileSearchPath searchPath(searchPathStr);
-            log("[Scanner] Search path has " + std::to_string(searchPath.getNumPaths()) +
-                " directories");
-
-            for (int i = 0; i < searchPath.getNumPaths(); ++i) {
-                log("[Scanner]   Path " + std::to_string(i) + ": " +
-                    searchPath[i].getFullPathName().toStdString());
-            }
-
-            log("[Scanner] Creating dead mans pedal file...");
-
-            // Use a dead mans pedal file to track current plugin
-            juce::File deadMansPedal =
-                juce::File::getSpecialLocation(juce::File::tempDirectory)
-                    .getChildFile("magda_scanner_current_" + formatName + ".txt");
-
-            log("[Scanner] Dead mans pedal: " + deadMansPedal.getFullPathName().toStdString());
+            log("[Scanner] Scanning: " + fileOrIdentifier.toStdString());
 
+            juce::OwnedArray<juce::PluginDescription> found;
             knownList_.clear();
-            log("[Scanner] Cleared known list, about to create PluginDirectoryScanner...");
-
-            juce::PluginDirectoryScanner scanner(knownList_, *format, searchPath, true,
-                                                 deadMansPedal, false);
-
-            log("[Scanner] PluginDirectoryScanner created successfully!");
-            juce::String nextPlugin;
-            int scanned = 0;
-            int skipped = 0;
-
-            while (scanner.getNextPluginFileThatWillBeScanned().isNotEmpty()) {
-                juce::String fileToScan = scanner.getNextPluginFileThatWillBeScanned();
-
-                // Check blacklist BEFORE scanning
-                if (blacklist.contains(fileToScan)) {
-                    log("[Scanner] Skipping blacklisted: " + fileToScan.toStdString());
-                    scanner.skipNextFile();
-                    skipped++;
-                    continue;
-                }
+            knownList_.scanAndAddFile(fileOrIdentifier, false, found, *format);
 
-                // Report current file BEFORE scanning (this gets sent to coordinator before
-                // potential crash)
-                sendCurrentFile(fileToScan);
-                log("[Scanner] Scanning: " + fileToScan.toStdString());
-
-                // Now actually scan the file
-                if (!scanner.scanNextFile(true, nextPlugin)) {
-                    break;  // No more files
-                }
-
-                // Report progress
-                sendProgress(scanner.getProgress());
-                scanned++;
+            for (const auto* desc : found) {
+                sendPluginFound(*desc);
             }
 
-            log("[Scanner] Scanned " + std::to_string(scanned) + " plugins, skipped " +
-                std::to_string(skipped));
-
-            // Send all found plugins
-            auto types = knownList_.getTypes();
-            log("[Scanner] Found " + std::to_string(types.size()) + " valid plugins");
-
-            for (const auto& desc : types) {
-                sendPluginFound(desc);
+            if (found.isEmpty()) {
+                log("[Scanner] Failed: " + fileOrIdentifier.toStdString());
+                sendError(fileOrIdentifier, "Failed to scan");
             }
 
-            // Report failed files
-            auto failed = scanner.getFailedFiles();
-            for (const auto& failedFile : failed) {
-                log("[Scanner] Failed: " + failedFile.toStdString());
-                sendError(failedFile, "Failed to scan");
-            }
-
-            log("[Scanner] Sending DONE message");
             sendComplete();
-            log("[Scanner] DONE message sent, returning from scanFormat");
         } catch (const std::exception& e) {
-            log(std::string("[Scanner] scanFormat EXCEPTION: ") + e.what());
-            sendError("", juce::String("Exception: ") + e.what());
+            log(std::string("[Scanner] scanFile EXCEPTION: ") + e.what());
+            sendError(fileOrIdentifier, juce::String("Exception: ") + e.what());
             sendComplete();
         } catch (...) {
-            log("[Scanner] scanFormat UNKNOWN EXCEPTION");
-            sendError("", "Unknown exception");
+            log("[Scanner] scanFile UNKNOWN EXCEPTION");
+            sendError(fileOrIdentifier, "Unknown exception");
             sendComplete();
         }
     }
 
-    void sendProgress(float progress) {
-        juce::MemoryBlock msg;
-        juce::MemoryOutputStream stream(msg, false);
-        stream.writeString(ScannerIPC::MSG_PROGRESS);
-        stream.writeFloat(progress);
-        sendMessageToCoordinator(msg);
-    }
-
-    void sendCurrentFile(const juce::String& file) {
-        juce::MemoryBlock msg;
-        juce::MemoryOutputStream stream(msg, false);
-        stream.writeString(ScannerIPC::MSG_CURRENT_FILE);
-        stream.writeString(file);
-        sendMessageToCoordinator(msg);
-    }
-
     void sendPluginFound(const juce::PluginDescription& desc) {
         juce::MemoryBlock msg;
         juce::MemoryOutputStream stream(msg, false);
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <vector>
+
+#include "../core/BatchOperations.hpp"
+
+namespace magda {
+
+/**
+ * @brief Interface for applying many edits in one call
+ *
+ * The string-ID interfaces resolve every ID on every call, and each call syncs the engine
+ * on its own. An agent building an arrangement can instead send the whole thing as one
+ * batch of typed operations on integer model ids (see BatchOperation): it is applied as
+ * one undo step with one engine sync, and the results come back together.
+ */
+class BatchInterface {
+  public:
+    virtual ~BatchInterface() = default;
+
+    /**
+     * @brief Apply operations in order
+     * @return One result per operation, at the same index
+     */
+    virtual std::vector<BatchResult> applyBatch(const std::vector<BatchOperation>& operations) = 0;
+};
+
+}  // namespace magda
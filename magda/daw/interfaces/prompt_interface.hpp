@@ -2,6 +2,7 @@
 
 #include <functional>
 #include <string>
+#include <utility>
 
 /**
  * @brief Interface for interacting with language models and AI assistants
@@ -32,6 +33,37 @@ class PromptInterface {
                                  std::function<void(const std::string&)> callback,
                                  const std::string& context = "") = 0;
 
+    /**
+     * @brief Send a prompt and receive the response as it is generated
+     *
+     * onChunk gets each piece of text as the model produces it, so a long generation can
+     * be shown or applied progressively (see PromptLineSplitter for command-per-line
+     * output); onComplete then gets the whole response. Implementations that cannot
+     * stream fall back to this default, which delivers the response as one chunk.
+     *
+     * @param prompt The text prompt to send
+     * @param onChunk Called with each new piece of the response, in order
+     * @param onComplete Called once with the full response after the last chunk
+     * @param context Optional context about current DAW state
+     */
+    virtual void sendPromptStreaming(const std::string& prompt,
+                                     std::function<void(const std::string&)> onChunk,
+                                     std::function<void(const std::string&)> onComplete,
+                                     const std::string& context = "") {
+        sendPromptAsync(
+            prompt,
+            [onChunk = std::move(onChunk),
+             onComplete = std::move(onComplete)](const std::string& response) {
+                if (onChunk) {
+                    onChunk(response);
+                }
+                if (onComplete) {
+                    onComplete(response);
+                }
+            },
+            context);
+    }
+
     /**
      * @brief Generate musical suggestions based on current state
      * @param style Musical style or genre
@@ -61,3 +93,51 @@ class PromptInterface {
      */
     virtual void setContext(const std::string& context_info) = 0;
 };
+
+/**
+ * @brief Reassembles streamed chunks into whole lines
+ *
+ * Chunks split wherever the model's tokens fall, mid-word or mid-command. Feeding them
+ * through a splitter hands on each line once it is complete, so a response written as one
+ * command (or one JSON object) per line can be applied command by command as it streams.
+ */
+class PromptLineSplitter {
+  public:
+    explicit PromptLineSplitter(std::function<void(const std::string&)> onLine)
+        : onLine_(std::move(onLine)) {}
+
+    /**
+     * @brief Add a chunk, emitting every line it completes
+     */
+    void append(const std::string& chunk) {
+        size_t start = 0;
+        for (size_t newline = chunk.find('\n'); newline != std::string::npos;
+             newline = chunk.find('\n', start)) {
+            pending_.append(chunk, start, newline - start);
+            emit();
+            start = newline + 1;
+        }
+        pending_.append(chunk, start, std::string::npos);
+    }
+
+    /**
+     * @brief Emit whatever follows the last newline, at the end of the stream
+     */
+    void finish() {
+        emit();
+    }
+
+  private:
+    void emit() {
+        if (!pending_.empty() && pending_.back() == '\r') {
+            pending_.pop_back();
+        }
+        if (!pending_.empty() && onLine_) {
+            onLine_(pending_);
+        }
+        pending_.clear();
+    }
+
+    std::function<void(const std::string&)> onLine_;
+    std::string pending_;
+};
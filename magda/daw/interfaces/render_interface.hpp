@@ -0,0 +1,74 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+/**
+ * @brief Interface for offline (faster than real time) rendering to disk
+ *
+ * Renders are jobs: startRender() queues one and returns its id, and the caller polls its
+ * status and progress. Jobs run one at a time in the order they were started, on a
+ * background thread with every CPU rendering, so a batch of stem exports can be queued
+ * and left unattended.
+ */
+class RenderInterface {
+  public:
+    virtual ~RenderInterface() = default;
+
+    enum class RenderStatus {
+        Queued,     // Waiting for an earlier job
+        Rendering,  // In progress
+        Finished,   // Every file written
+        Cancelled,  // Stopped by cancelRender(); files finished before that are kept
+        Failed,     // See getRenderError()
+        Unknown     // No job with that id
+    };
+
+    /**
+     * @brief What to render
+     *
+     * To render the selection, pass the time selection as the range and the selected
+     * tracks as track_ids.
+     */
+    struct RenderRequest {
+        std::string output_path;             // WAV file for a mix, directory for stems
+        double start_seconds = 0.0;          // Range start
+        double end_seconds = -1.0;           // Range end (< 0: end of the arrangement)
+        bool stems = false;                  // One file per track instead of one mix
+        std::vector<std::string> track_ids;  // Tracks to render (empty: all)
+        double sample_rate = 44100.0;
+        int bit_depth = 24;
+        bool normalise = false;
+    };
+
+    /**
+     * @brief Queue a render
+     * @return The job id. A request that can't be rendered still gets an id, with status
+     *         Failed and the reason in getRenderError(); "" only if there is no project.
+     */
+    virtual std::string startRender(const RenderRequest& request) = 0;
+
+    virtual RenderStatus getRenderStatus(const std::string& job_id) const = 0;
+
+    /**
+     * @brief Progress from 0 to 1 across all of the job's files
+     */
+    virtual double getRenderProgress(const std::string& job_id) const = 0;
+
+    /**
+     * @brief Stop a job, or drop it from the queue if it hasn't started
+     *
+     * The file being written is deleted; files already finished are kept.
+     */
+    virtual void cancelRender(const std::string& job_id) = 0;
+
+    /**
+     * @brief Files the job has finished writing so far
+     */
+    virtual std::vector<std::string> getRenderedFiles(const std::string& job_id) const = 0;
+
+    /**
+     * @brief Why a job failed ("" unless its status is Failed)
+     */
+    virtual std::string getRenderError(const std::string& job_id) const = 0;
+};
@@ -6,11 +6,22 @@
 #include <iostream>
 #include <memory>
 
+#include "audio/AudioFileImporter.hpp"
+#include "audio/AudioReaderCache.hpp"
 #include "audio/AudioThumbnailManager.hpp"
+#include "audio/ClipProcessor.hpp"
+#include "audio/MidiFileImporter.hpp"
+#include "audio/SpectralCache.hpp"
+#include "audio/TempoCache.hpp"
+#include "core/AutosaveManager.hpp"
 #include "core/ClipManager.hpp"
 #include "core/ModulatorEngine.hpp"
+#include "core/ProjectManager.hpp"
+#include "core/ProjectSnapshot.hpp"
 #include "core/TrackManager.hpp"
 #include "engine/TracktionEngineWrapper.hpp"
+#include "profiling/InteractionReplay.hpp"
+#include "profiling/LoadProfiler.hpp"
 #include "ui/themes/DarkTheme.hpp"
 #include "ui/themes/FontManager.hpp"
 #include "ui/windows/MainWindow.hpp"
@@ -22,6 +33,7 @@ class MagdaDAWApplication : public JUCEApplication {
     std::unique_ptr<magda::TracktionEngineWrapper> daw_engine_;
     std::unique_ptr<magda::MainWindow> mainWindow_;
     std::unique_ptr<juce::LookAndFeel> lookAndFeel_;
+    std::unique_ptr<magda::InteractionReplay> interactionReplay_;
 
   public:
     MagdaDAWApplication() = default;
@@ -40,28 +52,147 @@ class MagdaDAWApplication : public JUCEApplication {
             return;
         }
 
+        // Closed once the window is up and queued plugins have loaded (see LoadProfiler)
+        auto& loadProfiler = magda::LoadProfiler::getInstance();
+        loadProfiler.begin("Startup");
+
         // 1. Initialize fonts
-        magda::FontManager::getInstance().initialize();
+        {
+            magda::LoadProfiler::ScopedPhase phase("Fonts and theme");
+            magda::FontManager::getInstance().initialize();
 
-        // 2. Set up dark theme
-        lookAndFeel_ = std::make_unique<juce::LookAndFeel_V4>();
-        magda::DarkTheme::applyToLookAndFeel(*lookAndFeel_);
-        juce::LookAndFeel::setDefaultLookAndFeel(lookAndFeel_.get());
+            // 2. Set up dark theme
+            lookAndFeel_ = std::make_unique<juce::LookAndFeel_V4>();
+            magda::DarkTheme::applyToLookAndFeel(*lookAndFeel_);
+            juce::LookAndFeel::setDefaultLookAndFeel(lookAndFeel_.get());
+        }
 
         // 3. Initialize audio engine
-        daw_engine_ = std::make_unique<magda::TracktionEngineWrapper>();
-        if (!daw_engine_->initialize()) {
+        bool engineInitialized = false;
+        {
+            magda::LoadProfiler::ScopedPhase phase("Engine");
+            daw_engine_ = std::make_unique<magda::TracktionEngineWrapper>();
+            engineInitialized = daw_engine_->initialize();
+        }
+        if (!engineInitialized) {
             std::cerr << "ERROR: Failed to initialize Tracktion Engine" << std::endl;
+            loadProfiler.finish();
             quit();
             return;
         }
 
         std::cout << "✓ Audio engine initialized" << std::endl;
 
+        // Agents read the project from snapshots rather than the live managers
+        magda::ProjectSnapshotPublisher::getInstance().start();
+
         // 4. Create main window with full UI (pass the audio engine)
-        mainWindow_ = std::make_unique<magda::MainWindow>(daw_engine_.get());
+        {
+            magda::LoadProfiler::ScopedPhase phase("Main window");
+            mainWindow_ = std::make_unique<magda::MainWindow>(daw_engine_.get());
+        }
 
         std::cout << "🎵 MAGDA is ready!" << std::endl;
+        loadProfiler.finish();
+
+        const juce::ArgumentList args(getApplicationName(), commandLine);
+        if (args.getValueForOption("--ui-benchmark").isNotEmpty()) {
+            startInteractionBenchmark(args);
+        }
+    }
+
+    /**
+     * @brief Open a project, replay the interaction script against it, write the report, quit
+     *
+     * Usage: --ui-benchmark=project.magda [--ui-benchmark-script=script.json]
+     *        [--ui-benchmark-output=magda_ui_bench.json] [--ui-benchmark-baseline=file.json]
+     *        [--ui-benchmark-tolerance=0.15]
+     *
+     * The exit code is 1 when a step regresses against the baseline, 2 on an error.
+     */
+    void startInteractionBenchmark(const juce::ArgumentList& args) {
+        auto fail = [this](const juce::String& error) {
+            std::cerr << "UI benchmark: " << error << std::endl;
+            setApplicationReturnValue(2);
+            quit();
+        };
+
+        auto script = magda::InteractionReplay::getDefaultScript();
+        if (args.getValueForOption("--ui-benchmark-script").isNotEmpty()) {
+            const auto file = args.getFileForOption("--ui-benchmark-script");
+            const auto parsed = magda::InteractionReplay::parseScript(file.loadFileAsString());
+            if (!parsed) {
+                fail("can't read script " + file.getFullPathName());
+                return;
+            }
+            script = *parsed;
+        }
+
+        const auto output = args.getValueForOption("--ui-benchmark-output").isNotEmpty()
+                                ? args.getFileForOption("--ui-benchmark-output")
+                                : juce::File::getCurrentWorkingDirectory().getChildFile(
+                                      "magda_ui_bench.json");
+        const auto baseline = args.getValueForOption("--ui-benchmark-baseline").isNotEmpty()
+                                  ? args.getFileForOption("--ui-benchmark-baseline")
+                                  : juce::File();
+        const auto toleranceText = args.getValueForOption("--ui-benchmark-tolerance");
+        const double tolerance = toleranceText.isNotEmpty() ? toleranceText.getDoubleValue()
+                                                            : 0.15;
+
+        const auto project = args.getFileForOption("--ui-benchmark");
+        magda::ProjectManager::getInstance().openAsync(
+            project, [this, fail, script, output, baseline, tolerance](const juce::String& error) {
+                if (error.isNotEmpty()) {
+                    fail(error);
+                    return;
+                }
+                // Let the views lay out and the project's plugins load before the first frame
+                juce::Timer::callAfterDelay(2000, [this, script, output, baseline, tolerance] {
+                    if (mainWindow_ == nullptr) {
+                        return;
+                    }
+                    interactionReplay_ = std::make_unique<magda::InteractionReplay>(
+                        *mainWindow_->getContentComponent());
+                    interactionReplay_->start(script, [this, output, baseline, tolerance](
+                                                          const auto& results) {
+                        finishInteractionBenchmark(results, output, baseline, tolerance);
+                    });
+                });
+            });
+    }
+
+    void finishInteractionBenchmark(const magda::InteractionReplay::Results& results,
+                                    const juce::File& output, const juce::File& baseline,
+                                    double tolerance) {
+        std::cout << results.totals.toFormattedString() << std::endl;
+        std::cout << results.framesRun << " frames replayed";
+        if (results.missingTargets > 0) {
+            std::cout << " (" << results.missingTargets << " with nothing to act on)";
+        }
+        std::cout << std::endl;
+
+        int exitCode = 0;
+        if (!output.replaceWithText(results.report.toJSON())) {
+            std::cerr << "UI benchmark: can't write " << output.getFullPathName() << std::endl;
+            exitCode = 2;
+        } else if (baseline != juce::File()) {
+            const auto stored = magda::BenchmarkReport::fromJSON(baseline.loadFileAsString());
+            if (!stored) {
+                std::cerr << "UI benchmark: can't read baseline " << baseline.getFullPathName()
+                          << std::endl;
+                exitCode = 2;
+            } else {
+                for (const auto& r : results.report.findRegressions(*stored, tolerance)) {
+                    std::cout << "REGRESSION " << r.phase << ": " << juce::String(r.baselineMs, 3)
+                              << " ms -> " << juce::String(r.currentMs, 3) << " ms" << std::endl;
+                    exitCode = 1;
+                }
+            }
+        }
+        std::cout << "Results written to " << output.getFullPathName() << std::endl;
+
+        setApplicationReturnValue(exitCode);
+        quit();
     }
 
     void shutdown() override {
@@ -70,6 +201,11 @@ class MagdaDAWApplication : public JUCEApplication {
 
         // Shutdown all singletons BEFORE JUCE cleanup to prevent static cleanup issues
         // This clears all JUCE objects (Strings, Colours, etc.) while JUCE is still alive
+        std::cout << "[0] Autosave shutdown..." << std::endl;
+        std::cout.flush();
+        magda::AutosaveManager::getInstance().shutdown();  // Clean exit: nothing to recover
+        magda::ProjectSnapshotPublisher::getInstance().shutdown();  // Release snapshot copies
+
         std::cout << "[1] ModulatorEngine shutdown..." << std::endl;
         std::cout.flush();
         magda::ModulatorEngine::getInstance().shutdown();  // Destroy timer
@@ -84,7 +220,15 @@ class MagdaDAWApplication : public JUCEApplication {
 
         std::cout << "[3b] AudioThumbnailManager shutdown..." << std::endl;
         std::cout.flush();
+        magda::AudioFileImporter::getInstance().shutdown();      // Cancel imports
+        magda::ClipProcessor::getInstance().shutdown();          // Cancel clip renders
+        magda::MidiFileImporter::getInstance().shutdown();       // Cancel MIDI imports
         magda::AudioThumbnailManager::getInstance().shutdown();  // Clear thumbnails
+        magda::SpectralCache::getInstance().shutdown();          // Stop spectral analysis
+        magda::TempoCache::getInstance().shutdown();             // Stop tempo analysis
+        magda::AudioReaderCache::getInstance().shutdown();       // Close mapped audio files
+
+        interactionReplay_.reset();  // Drives the window, so goes first
 
         // Clear default LookAndFeel BEFORE destroying windows
         // This ensures components switch away from our custom L&F before we delete them
@@ -0,0 +1,242 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+#include <algorithm>
+#include <map>
+#include <numeric>
+#include <optional>
+#include <vector>
+
+namespace magda {
+
+/**
+ * @brief Timings of a headless benchmark run, serialisable as JSON for regression tracking
+ *
+ * Each phase (sync, render, undo, ...) collects one sample per iteration. The report keeps
+ * the raw samples and summarises them; baselines are compared on the median, which is far
+ * less sensitive to a single descheduled iteration than the mean.
+ *
+ * JSON layout:
+ *   { "schema": 1, "timestamp": "...", "config": { "tracks": 64, ... },
+ *     "phases": { "sync": { "iterations": 5, "minMs": .., "medianMs": .., ... }, ... },
+ *     "memory": { "Clips & notes": 1048576, ... } }
+ *
+ * Memory figures are per-subsystem byte estimates (MemoryAccounting); they're reported
+ * alongside the timings but not compared against the baseline.
+ */
+class BenchmarkReport {
+  public:
+    static constexpr int kSchemaVersion = 1;
+
+    struct PhaseStats {
+        int iterations = 0;
+        double minMs = 0.0;
+        double medianMs = 0.0;
+        double meanMs = 0.0;
+        double maxMs = 0.0;
+    };
+
+    struct Regression {
+        juce::String phase;
+        double baselineMs = 0.0;
+        double currentMs = 0.0;
+
+        double getRatio() const {
+            return baselineMs > 0.0 ? currentMs / baselineMs : 0.0;
+        }
+    };
+
+    // =========================================================================
+    // Recording
+    // =========================================================================
+
+    void setConfig(const juce::String& key, const juce::var& value) {
+        config_.set(key, value);
+    }
+
+    const juce::NamedValueSet& getConfig() const {
+        return config_;
+    }
+
+    void addSample(const juce::String& phase, double milliseconds) {
+        samples_[phase].push_back(milliseconds);
+        stats_.erase(phase);
+    }
+
+    bool hasPhase(const juce::String& phase) const {
+        return samples_.count(phase) > 0 || stats_.count(phase) > 0;
+    }
+
+    std::vector<juce::String> getPhaseNames() const {
+        std::vector<juce::String> names;
+        for (const auto& [name, stats] : getAllStats()) {
+            names.push_back(name);
+        }
+        return names;
+    }
+
+    std::optional<PhaseStats> getStats(const juce::String& phase) const {
+        const auto all = getAllStats();
+        const auto it = all.find(phase);
+        if (it == all.end()) {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+
+    /**
+     * @brief Record a subsystem's memory; repeated calls keep the largest figure
+     */
+    void setMemory(const juce::String& subsystem, size_t bytes) {
+        auto& stored = memory_[subsystem];
+        stored = std::max(stored, bytes);
+    }
+
+    const std::map<juce::String, size_t>& getMemory() const {
+        return memory_;
+    }
+
+    static PhaseStats summarise(std::vector<double> samples) {
+        PhaseStats stats;
+        if (samples.empty()) {
+            return stats;
+        }
+
+        std::sort(samples.begin(), samples.end());
+        const size_t n = samples.size();
+        stats.iterations = static_cast<int>(n);
+        stats.minMs = samples.front();
+        stats.maxMs = samples.back();
+        stats.medianMs =
+            (n % 2 == 1) ? samples[n / 2] : 0.5 * (samples[n / 2 - 1] + samples[n / 2]);
+        stats.meanMs = std::accumulate(samples.begin(), samples.end(), 0.0) / double(n);
+        return stats;
+    }
+
+    // =========================================================================
+    // JSON
+    // =========================================================================
+
+    juce::var toVar() const {
+        auto* root = new juce::DynamicObject();
+        root->setProperty("schema", kSchemaVersion);
+        root->setProperty("timestamp", juce::Time::getCurrentTime().toISO8601(true));
+
+        auto* config = new juce::DynamicObject();
+        for (const auto& entry : config_) {
+            config->setProperty(entry.name, entry.value);
+        }
+        root->setProperty("config", juce::var(config));
+
+        auto* phases = new juce::DynamicObject();
+        for (const auto& [name, stats] : getAllStats()) {
+            auto* phase = new juce::DynamicObject();
+            phase->setProperty("iterations", stats.iterations);
+            phase->setProperty("minMs", stats.minMs);
+            phase->setProperty("medianMs", stats.medianMs);
+            phase->setProperty("meanMs", stats.meanMs);
+            phase->setProperty("maxMs", stats.maxMs);
+            phases->setProperty(name, juce::var(phase));
+        }
+        root->setProperty("phases", juce::var(phases));
+
+        auto* memory = new juce::DynamicObject();
+        for (const auto& [subsystem, bytes] : memory_) {
+            memory->setProperty(subsystem, static_cast<juce::int64>(bytes));
+        }
+        root->setProperty("memory", juce::var(memory));
+
+        return juce::var(root);
+    }
+
+    juce::String toJSON() const {
+        return juce::JSON::toString(toVar());
+    }
+
+    /**
+     * @brief Parse a report written by toJSON(); only the summaries survive the round trip
+     * @return The report, or nullopt if the text isn't a report of this schema
+     */
+    static std::optional<BenchmarkReport> fromJSON(const juce::String& json) {
+        const auto root = juce::JSON::parse(json);
+        if (!root.isObject() || static_cast<int>(root["schema"]) != kSchemaVersion) {
+            return std::nullopt;
+        }
+
+        BenchmarkReport report;
+        if (auto* config = root["config"].getDynamicObject()) {
+            report.config_ = config->getProperties();
+        }
+
+        if (auto* phases = root["phases"].getDynamicObject()) {
+            for (const auto& entry : phases->getProperties()) {
+                const auto& phase = entry.value;
+                PhaseStats stats;
+                stats.iterations = phase["iterations"];
+                stats.minMs = phase["minMs"];
+                stats.medianMs = phase["medianMs"];
+                stats.meanMs = phase["meanMs"];
+                stats.maxMs = phase["maxMs"];
+                report.stats_[entry.name.toString()] = stats;
+            }
+        }
+
+        if (auto* memory = root["memory"].getDynamicObject()) {
+            for (const auto& entry : memory->getProperties()) {
+                const auto bytes = std::max<juce::int64>(0, entry.value);
+                report.memory_[entry.name.toString()] = static_cast<size_t>(bytes);
+            }
+        }
+        return report;
+    }
+
+    // =========================================================================
+    // Baseline comparison
+    // =========================================================================
+
+    /**
+     * @brief Phases whose median got slower than the baseline by more than the tolerance
+     *
+     * @param tolerance Allowed slowdown as a fraction (0.15 = 15%)
+     * @param minDeltaMs Ignore differences below this, so sub-millisecond phases don't
+     *                   flag on timer noise
+     *
+     * Phases missing from either report are skipped: adding a phase isn't a regression.
+     */
+    std::vector<Regression> findRegressions(const BenchmarkReport& baseline, double tolerance,
+                                            double minDeltaMs = 0.05) const {
+        std::vector<Regression> regressions;
+        const auto baselineStats = baseline.getAllStats();
+
+        for (const auto& [name, stats] : getAllStats()) {
+            const auto it = baselineStats.find(name);
+            if (it == baselineStats.end()) {
+                continue;
+            }
+
+            const double before = it->second.medianMs;
+            const double now = stats.medianMs;
+            if (now > before * (1.0 + tolerance) && now - before > minDeltaMs) {
+                regressions.push_back({name, before, now});
+            }
+        }
+        return regressions;
+    }
+
+  private:
+    juce::NamedValueSet config_;
+    std::map<juce::String, std::vector<double>> samples_;
+    std::map<juce::String, PhaseStats> stats_;  // Loaded from JSON (no raw samples)
+    std::map<juce::String, size_t> memory_;     // Peak bytes per subsystem
+
+    std::map<juce::String, PhaseStats> getAllStats() const {
+        auto all = stats_;
+        for (const auto& [name, samples] : samples_) {
+            all[name] = summarise(samples);
+        }
+        return all;
+    }
+};
+
+}  // namespace magda
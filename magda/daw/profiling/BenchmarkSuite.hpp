@@ -4,8 +4,12 @@
 #include <tracktion_engine/tracktion_engine.h>
 
 #include <functional>
+#include <vector>
 
+#include "MemoryAccounting.hpp"
 #include "PerformanceProfiler.hpp"
+#include "StallWatchdog.hpp"
+#include "UIFrameProfiler.hpp"
 
 namespace magda {
 
@@ -31,9 +35,14 @@ class BenchmarkSuite {
         double cpuUsagePercent = 0.0;   // CPU usage %
 
         // UI Performance
-        double uiFrameTimeAvg = 0.0;  // milliseconds
-        double uiFrameTimeMax = 0.0;  // milliseconds
-        int droppedFrames = 0;        // frames > 16.67ms (60 FPS target)
+        double uiFrameTimeAvg = 0.0;       // milliseconds
+        double uiFrameTimeMax = 0.0;       // milliseconds
+        int droppedFrames = 0;             // frames > 16.67ms (60 FPS target)
+        double uiMessageLatencyAvg = 0.0;  // milliseconds (post to delivery)
+        double uiMessageLatencyMax = 0.0;  // milliseconds
+        juce::String slowestView;          // view blamed for the most dropped frames
+        int uiStalls = 0;                  // message loop stuck past the watchdog threshold
+        double uiStallMaxMs = 0.0;         // milliseconds
 
         // Plugin Performance
         double pluginScanTimeAvg = 0.0;  // milliseconds per plugin
@@ -41,11 +50,14 @@ class BenchmarkSuite {
         int pluginLoadFailures = 0;
 
         // Memory
-        size_t peakMemoryMB = 0;     // peak memory usage
-        size_t currentMemoryMB = 0;  // current memory usage
+        size_t peakMemoryMB = 0;     // peak process memory usage
+        size_t currentMemoryMB = 0;  // current process memory usage
+        std::vector<MemoryAccounting::Usage> subsystemMemory;  // estimated heap per subsystem
 
         // MIDI
-        double midiLatencyAvg = 0.0;  // milliseconds (input to processing)
+        double midiLatencyAvg = 0.0;  // milliseconds (input to rendered output)
+        double midiLatencyP50 = 0.0;  // milliseconds
+        double midiLatencyP99 = 0.0;  // milliseconds
 
         juce::String toFormattedString() const {
             juce::String s;
@@ -60,7 +72,17 @@ class BenchmarkSuite {
             s << "UI Rendering:\n";
             s << "  Avg frame time: " << juce::String(uiFrameTimeAvg, 2) << " ms\n";
             s << "  Max frame time: " << juce::String(uiFrameTimeMax, 2) << " ms\n";
-            s << "  Dropped frames: " << droppedFrames << "\n\n";
+            s << "  Dropped frames: " << droppedFrames << "\n";
+            if (slowestView.isNotEmpty()) {
+                s << "  Slowest view: " << slowestView << "\n";
+            }
+            s << "  Message latency: " << juce::String(uiMessageLatencyAvg, 2) << " ms avg, "
+              << juce::String(uiMessageLatencyMax, 2) << " ms max\n";
+            s << "  Stalls: " << uiStalls;
+            if (uiStalls > 0) {
+                s << " (longest " << juce::String(uiStallMaxMs, 0) << " ms)";
+            }
+            s << "\n\n";
 
             s << "Plugin Performance:\n";
             s << "  Avg scan time: " << juce::String(pluginScanTimeAvg, 2) << " ms\n";
@@ -69,10 +91,19 @@ class BenchmarkSuite {
 
             s << "Memory:\n";
             s << "  Current: " << currentMemoryMB << " MB\n";
-            s << "  Peak: " << peakMemoryMB << " MB\n\n";
+            s << "  Peak: " << peakMemoryMB << " MB\n";
+            for (const auto& usage : subsystemMemory) {
+                s << "  " << usage.subsystem << ": "
+                  << MemoryAccounting::formatBytes(usage.bytes) << "\n";
+            }
+            s << "  Accounted total: "
+              << MemoryAccounting::formatBytes(MemoryAccounting::getTotalBytes(subsystemMemory))
+              << "\n\n";
 
             s << "MIDI:\n";
             s << "  Avg latency: " << juce::String(midiLatencyAvg, 2) << " ms\n";
+            s << "  p50 latency: " << juce::String(midiLatencyP50, 2) << " ms\n";
+            s << "  p99 latency: " << juce::String(midiLatencyP99, 2) << " ms\n";
 
             return s;
         }
@@ -95,10 +126,6 @@ class BenchmarkSuite {
         // Collect stats from PerformanceMonitor
         results = collectMonitorStats();
 
-        // Run specific benchmarks
-        results.currentMemoryMB = getCurrentMemoryUsageMB();
-        results.peakMemoryMB = getPeakMemoryUsageMB();
-
         DBG("[BENCHMARK] Benchmark complete");
         DBG(results.toFormattedString());
 
@@ -110,6 +137,8 @@ class BenchmarkSuite {
      */
     void startContinuousMonitoring() {
         PerformanceMonitor::getInstance().resetAll();
+        UIFrameProfiler::getInstance().reset();
+        StallWatchdog::getInstance().resetStats();
         DBG("[BENCHMARK] Continuous monitoring started");
     }
 
@@ -119,6 +148,8 @@ class BenchmarkSuite {
     BenchmarkResults stopContinuousMonitoring() {
         auto results = collectMonitorStats();
         PerformanceMonitor::getInstance().resetAll();
+        UIFrameProfiler::getInstance().reset();
+        StallWatchdog::getInstance().resetStats();
         DBG("[BENCHMARK] Continuous monitoring stopped");
         return results;
     }
@@ -131,15 +162,19 @@ class BenchmarkSuite {
             "Timestamp,AudioCallbackAvg,AudioCallbackMax,AudioOverruns,CPUUsage,"
             "UIFrameAvg,UIFrameMax,DroppedFrames,"
             "PluginScanAvg,PluginLoadAvg,PluginFailures,"
-            "CurrentMemMB,PeakMemMB,MIDILatency\n";
+            "CurrentMemMB,PeakMemMB,MIDILatency,MIDILatencyP50,MIDILatencyP99,AccountedMemKB,"
+            "UIStalls,UIStallMaxMs\n";
 
         juce::String csvLine = juce::String::formatted(
-            "%s,%.3f,%.3f,%d,%.1f,%.2f,%.2f,%d,%.2f,%.2f,%d,%zu,%zu,%.2f\n",
+            "%s,%.3f,%.3f,%d,%.1f,%.2f,%.2f,%d,%.2f,%.2f,%d,%zu,%zu,%.2f,%.2f,%.2f,%zu,%d,%.1f\n",
             juce::Time::getCurrentTime().toString(true, true).toRawUTF8(), results.audioCallbackAvg,
             results.audioCallbackMax, results.audioCallbackOverruns, results.cpuUsagePercent,
             results.uiFrameTimeAvg, results.uiFrameTimeMax, results.droppedFrames,
             results.pluginScanTimeAvg, results.pluginLoadTimeAvg, results.pluginLoadFailures,
-            results.currentMemoryMB, results.peakMemoryMB, results.midiLatencyAvg);
+            results.currentMemoryMB, results.peakMemoryMB, results.midiLatencyAvg,
+            results.midiLatencyP50, results.midiLatencyP99,
+            MemoryAccounting::getTotalBytes(results.subsystemMemory) / 1024, results.uiStalls,
+            results.uiStallMaxMs);
 
         // Append to CSV file
         if (!outputFile.existsAsFile()) {
@@ -160,13 +195,25 @@ class BenchmarkSuite {
         auto audioStats = monitor.getStats("AudioCallback");
         results.audioCallbackAvg = audioStats.average();
         results.audioCallbackMax = audioStats.max;
-
-        // UI frame stats
-        auto uiStats = monitor.getStats("UIFrame");
-        results.uiFrameTimeAvg = uiStats.average();
-        results.uiFrameTimeMax = uiStats.max;
-        // Count frames > 16.67ms (60 FPS)
-        results.droppedFrames = 0;  // Would need to track this separately
+        results.audioCallbackOverruns =
+            static_cast<int>(monitor.getCounter("AudioCallbackOverruns"));
+        results.cpuUsagePercent = monitor.getStats("AudioCPU").average();
+
+        // UI frame stats (measured whether or not the monitor is enabled)
+        const auto& frameProfiler = UIFrameProfiler::getInstance();
+        const auto frames = frameProfiler.getFrameStats();
+        results.uiFrameTimeAvg = frames.getAverageMs();
+        results.uiFrameTimeMax = frames.maxMs;
+        results.droppedFrames = static_cast<int>(frames.droppedFrames);
+        results.uiMessageLatencyAvg = frames.getAverageLatencyMs();
+        results.uiMessageLatencyMax = frames.latencyMaxMs;
+        const auto worst = frameProfiler.getWorstOffenders(1);
+        if (!worst.empty() && worst.front().slowFrames > 0) {
+            results.slowestView = worst.front().name;
+        }
+        const auto& watchdog = StallWatchdog::getInstance();
+        results.uiStalls = watchdog.getStallCount();
+        results.uiStallMaxMs = watchdog.getLongestStallMs();
 
         // Plugin stats
         auto pluginScanStats = monitor.getStats("PluginScan");
@@ -175,9 +222,16 @@ class BenchmarkSuite {
         auto pluginLoadStats = monitor.getStats("PluginLoad");
         results.pluginLoadTimeAvg = pluginLoadStats.average();
 
-        // MIDI stats
-        auto midiStats = monitor.getStats("MIDIProcessing");
+        // MIDI stats (recorded by AudioBridge for each note-on it sees rendered)
+        auto midiStats = monitor.getStats("MIDIInputLatency");
         results.midiLatencyAvg = midiStats.average();
+        results.midiLatencyP50 = midiStats.percentile(0.5);
+        results.midiLatencyP99 = midiStats.percentile(0.99);
+
+        // Memory: process totals from the OS, plus each subsystem's own estimate
+        results.currentMemoryMB = getCurrentMemoryUsageMB();
+        results.peakMemoryMB = getPeakMemoryUsageMB();
+        results.subsystemMemory = MemoryAccounting::getInstance().collect();
 
         return results;
     }
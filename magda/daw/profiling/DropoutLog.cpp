@@ -0,0 +1,153 @@
+#include "DropoutLog.hpp"
+
+#include <algorithm>
+
+namespace magda {
+
+namespace {
+
+juce::String describeEvent(const DropoutLog::Event& event) {
+    const auto time = juce::Time(event.wallTimeMs);
+    juce::String text = time.formatted("%Y-%m-%d %H:%M:%S.") +
+                        juce::String(time.getMilliseconds()).paddedLeft('0', 3) + "  ";
+
+    if (event.deviceXruns > 0) {
+        text << "Device xrun";
+        if (event.deviceXruns > 1) {
+            text << " x" << event.deviceXruns;
+        }
+    } else if (event.callbackMs > event.budgetMs) {
+        text << "Overrun";
+    } else {
+        text << "Late callback (" << juce::String(event.intervalMs, 2) << " ms after the last)";
+    }
+
+    text << ": callback " << juce::String(event.callbackMs, 2) << " ms of "
+         << juce::String(event.budgetMs, 2) << " ms";
+    if (event.stage != nullptr && *event.stage != 0) {
+        text << " (" << event.stage << ")";
+    }
+    text << ", " << event.numSamples << " samples at " << juce::roundToInt(event.sampleRate)
+         << " Hz, " << (event.playing ? "playing" : "stopped") << " at "
+         << juce::String(event.positionSeconds, 3) << " s";
+    if (event.bpm > 0.0) {
+        text << " (beat " << juce::String(event.positionSeconds * event.bpm / 60.0, 2) << ")";
+    }
+    return text;
+}
+
+}  // namespace
+
+DropoutLog::DropoutLog() : logFile_(getDefaultLogFile()) {}
+
+DropoutLog& DropoutLog::getInstance() {
+    static DropoutLog instance;
+    return instance;
+}
+
+juce::File DropoutLog::getDefaultLogFile() {
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+        .getChildFile("MAGDA")
+        .getChildFile("Logs")
+        .getChildFile("dropouts.log");
+}
+
+void DropoutLog::setLogFile(const juce::File& file) {
+    logFile_ = file;
+}
+
+int DropoutLog::collect(const HotspotSource& hotspotsFor) {
+    std::vector<Record> fresh;
+    size_t read = readIndex_.load(std::memory_order_relaxed);
+    while (read != writeIndex_.load(std::memory_order_acquire)) {
+        Record record;
+        record.event = ring_[read];
+        fresh.push_back(std::move(record));
+        read = (read + 1) & (kRingSize - 1);
+        readIndex_.store(read, std::memory_order_release);
+    }
+    if (fresh.empty()) {
+        return 0;
+    }
+
+    // Every event since the last collect happened inside the window the device peaks cover
+    auto hotspots = hotspotsFor ? hotspotsFor() : std::vector<Hotspot>();
+    if (hotspots.size() > kMaxHotspots) {
+        hotspots.resize(kMaxHotspots);
+    }
+
+    juce::String text;
+    for (auto& record : fresh) {
+        record.hotspots = hotspots;
+        text << formatRecord(record);
+    }
+    DBG("DropoutLog: " << text.trimEnd());
+    if (logFile_ != juce::File()) {
+        (void)logFile_.getParentDirectory().createDirectory();
+        (void)logFile_.appendText(text);
+    }
+
+    const auto count = static_cast<int>(fresh.size());
+    totalCount_.fetch_add(count, std::memory_order_relaxed);
+    const juce::ScopedLock lock(lock_);
+    for (auto& record : fresh) {
+        records_.push_back(std::move(record));
+    }
+    if (records_.size() > kMaxRecords) {
+        const auto excess = static_cast<std::ptrdiff_t>(records_.size() - kMaxRecords);
+        records_.erase(records_.begin(), records_.begin() + excess);
+    }
+    return count;
+}
+
+std::vector<DropoutLog::Record> DropoutLog::getRecords() const {
+    const juce::ScopedLock lock(lock_);
+    return records_;
+}
+
+void DropoutLog::clear() {
+    const juce::ScopedLock lock(lock_);
+    records_.clear();
+    totalCount_.store(0, std::memory_order_relaxed);
+}
+
+juce::String DropoutLog::formatRecord(const Record& record) {
+    juce::String text = describeEvent(record.event) + "\n";
+    for (const auto& hotspot : record.hotspots) {
+        text << "    " << hotspot.device;
+        if (hotspot.track.isNotEmpty()) {
+            text << " on " << hotspot.track;
+        }
+        text << ": " << juce::String(hotspot.blockMs, 2) << " ms\n";
+    }
+    return text;
+}
+
+juce::String DropoutLog::generateSummary(size_t maxRecords) const {
+    const auto records = getRecords();
+    juce::String text;
+    text << getTotalCount() << (getTotalCount() == 1 ? " dropout" : " dropouts");
+    if (const auto dropped = getDroppedCount(); dropped > 0) {
+        text << " (" << juce::String(static_cast<juce::int64>(dropped)) << " lost)";
+    }
+    if (records.empty()) {
+        return text;
+    }
+
+    text << ", newest first:";
+    const size_t shown = std::min(maxRecords, records.size());
+    for (size_t i = 0; i < shown; ++i) {
+        text << "\n" << formatRecord(records[records.size() - 1 - i]).trimEnd();
+    }
+    return text;
+}
+
+juce::String DropoutLog::generateReport() const {
+    juce::String text;
+    for (const auto& record : getRecords()) {
+        text << formatRecord(record);
+    }
+    return text;
+}
+
+}  // namespace magda
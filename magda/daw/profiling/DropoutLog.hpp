@@ -0,0 +1,155 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace magda {
+
+/**
+ * @brief Keeps every audio dropout with what the engine was doing at the time
+ *
+ * The audio callback push()es an Event for each block that overran its budget, arrived
+ * late or came with device-reported xruns: when, the buffer, how long the callback took,
+ * the stage it blames and the transport position. push() is wait-free (an SPSC ring that
+ * counts what it has to drop), so every dropout is kept whether or not profiling is on.
+ *
+ * On the message thread collect() turns the events into Records, adding the devices with
+ * the longest blocks since the last collect (from DeviceCpuMeter, so only while device CPU
+ * measurement is on), appends them to the log file and keeps the last kMaxRecords for
+ * DebugDialog.
+ */
+class DropoutLog {
+  public:
+    struct Event {
+        int64_t wallTimeMs = 0;  // juce::Time::currentTimeMillis()
+        int numSamples = 0;
+        double sampleRate = 0.0;
+        float callbackMs = 0.0f;       // MAGDA's callback
+        float budgetMs = 0.0f;         // Buffer duration
+        float intervalMs = 0.0f;       // Since the previous callback started
+        const char* stage = "";        // AudioCallbackTiming::getStageName() of the slowest
+        int deviceXruns = 0;           // Reported by the device since the last block
+        double positionSeconds = 0.0;  // Transport position at the block's start
+        double bpm = 0.0;
+        bool playing = false;
+    };
+
+    struct Hotspot {
+        juce::String device;
+        juce::String track;
+        double blockMs = 0.0;  // The device's longest block around the dropout
+    };
+
+    struct Record {
+        Event event;
+        std::vector<Hotspot> hotspots;  // Slowest first; empty without device measurement
+    };
+
+    using HotspotSource = std::function<std::vector<Hotspot>()>;
+
+    static constexpr size_t kRingSize = 64;  // Power of 2; dropouts come far apart
+    static constexpr size_t kMaxRecords = 128;
+    static constexpr size_t kMaxHotspots = 3;
+
+    static DropoutLog& getInstance();
+
+    // =========================================================================
+    // Audio thread
+    // =========================================================================
+
+    void push(const Event& event) {
+        const size_t write = writeIndex_.load(std::memory_order_relaxed);
+        const size_t next = (write + 1) & (kRingSize - 1);
+        if (next == readIndex_.load(std::memory_order_acquire)) {
+            droppedCount_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        ring_[write] = event;
+        writeIndex_.store(next, std::memory_order_release);
+    }
+
+    // =========================================================================
+    // Message thread
+    // =========================================================================
+
+    /**
+     * @brief Record the events pushed since the last call
+     * @param hotspotsFor Asked once, only if there are events
+     * @return How many were recorded
+     */
+    int collect(const HotspotSource& hotspotsFor);
+
+    /**
+     * @brief Where records are appended (default: getDefaultLogFile(); none to keep them
+     *        in memory only)
+     */
+    void setLogFile(const juce::File& file);
+
+    /**
+     * @brief Logs/dropouts.log in the MAGDA application data folder
+     */
+    static juce::File getDefaultLogFile();
+
+    // =========================================================================
+    // Any thread
+    // =========================================================================
+
+    /**
+     * @brief The last kMaxRecords dropouts, oldest first
+     */
+    std::vector<Record> getRecords() const;
+
+    /**
+     * @brief Dropouts recorded since startup or clear(), including ones no longer kept
+     */
+    int getTotalCount() const {
+        return totalCount_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Events lost to a full ring (the message thread wasn't collecting)
+     */
+    uint64_t getDroppedCount() const {
+        return droppedCount_.load(std::memory_order_relaxed);
+    }
+
+    void clear();
+
+    /**
+     * @brief One line for the dropout, then one per hotspot
+     */
+    static juce::String formatRecord(const Record& record);
+
+    /**
+     * @brief The newest records first, for DebugDialog
+     */
+    juce::String generateSummary(size_t maxRecords) const;
+
+    /**
+     * @brief Every kept record, oldest first
+     */
+    juce::String generateReport() const;
+
+  private:
+    DropoutLog();
+
+    std::array<Event, kRingSize> ring_{};
+    alignas(64) std::atomic<size_t> writeIndex_{0};
+    alignas(64) std::atomic<size_t> readIndex_{0};
+    std::atomic<uint64_t> droppedCount_{0};
+
+    juce::File logFile_;  // Message thread
+
+    mutable juce::CriticalSection lock_;
+    std::vector<Record> records_;  // Guarded by lock_
+    std::atomic<int> totalCount_{0};
+};
+
+}  // namespace magda
@@ -0,0 +1,447 @@
+#include "InteractionReplay.hpp"
+
+#include <cmath>
+#include <utility>
+
+#include "../core/TrackManager.hpp"
+#include "../core/ViewModeController.hpp"
+#include "../ui/components/clips/ClipComponent.hpp"
+#include "../ui/components/timeline/TimelineComponent.hpp"
+#include "../ui/views/MainView.hpp"
+
+namespace magda {
+
+// =============================================================================
+// Scripts
+// =============================================================================
+
+namespace {
+
+constexpr InteractionReplay::Action kActions[] = {
+    InteractionReplay::Action::Scroll, InteractionReplay::Action::Zoom,
+    InteractionReplay::Action::Drag,   InteractionReplay::Action::Mixer,
+    InteractionReplay::Action::Macro,  InteractionReplay::Action::Idle,
+};
+
+// 0 -> 1 -> 0 over [0, 1)
+double triangle(double phase) {
+    const double t = phase - std::floor(phase);
+    return t < 0.5 ? 2.0 * t : 2.0 - 2.0 * t;
+}
+
+}  // namespace
+
+const char* InteractionReplay::getActionName(Action action) {
+    switch (action) {
+        case Action::Scroll:
+            return "scroll";
+        case Action::Zoom:
+            return "zoom";
+        case Action::Drag:
+            return "drag";
+        case Action::Mixer:
+            return "mixer";
+        case Action::Macro:
+            return "macro";
+        case Action::Idle:
+            return "idle";
+    }
+    return "idle";
+}
+
+std::optional<InteractionReplay::Action> InteractionReplay::findAction(const juce::String& name) {
+    for (auto action : kActions) {
+        if (name.equalsIgnoreCase(getActionName(action))) {
+            return action;
+        }
+    }
+    return std::nullopt;
+}
+
+double InteractionReplay::getDefaultAmount(Action action) {
+    switch (action) {
+        case Action::Scroll:
+            return 0.2;  // 10 px per frame through the ruler's scroll speed
+        case Action::Zoom:
+            return 1.04;
+        case Action::Drag:
+            return 50.0;
+        case Action::Macro:
+            return 2.0;
+        case Action::Mixer:
+        case Action::Idle:
+            return 1.0;
+    }
+    return 1.0;
+}
+
+juce::String InteractionReplay::Step::getPhaseName() const {
+    return name.isNotEmpty() ? name : juce::String(getActionName(action));
+}
+
+InteractionReplay::Script InteractionReplay::getDefaultScript() {
+    auto step = [](Action action, int frames) {
+        return Step{action, {}, frames, getDefaultAmount(action)};
+    };
+    return {
+        step(Action::Scroll, 240), step(Action::Zoom, 180), step(Action::Drag, 10),
+        step(Action::Mixer, 120),  step(Action::Macro, 120),
+    };
+}
+
+std::optional<InteractionReplay::Script> InteractionReplay::parseScript(const juce::String& json) {
+    const auto root = juce::JSON::parse(json);
+    const auto* steps = root.getArray();
+    if (steps == nullptr) {
+        return std::nullopt;
+    }
+
+    Script script;
+    for (const auto& entry : *steps) {
+        if (!entry.isObject()) {
+            return std::nullopt;
+        }
+        const auto action = findAction(entry["action"].toString());
+        if (!action) {
+            return std::nullopt;
+        }
+
+        Step step;
+        step.action = *action;
+        step.name = entry["name"].toString();
+        step.frames = entry.hasProperty("frames") ? juce::jmax(1, int(entry["frames"])) : 60;
+        step.amount = entry.hasProperty("amount") ? double(entry["amount"])
+                                                  : getDefaultAmount(*action);
+        script.push_back(step);
+    }
+    return script;
+}
+
+juce::String InteractionReplay::toJSON(const Script& script) {
+    juce::Array<juce::var> steps;
+    for (const auto& step : script) {
+        auto* object = new juce::DynamicObject();
+        object->setProperty("action", getActionName(step.action));
+        if (step.name.isNotEmpty()) {
+            object->setProperty("name", step.name);
+        }
+        object->setProperty("frames", step.frames);
+        object->setProperty("amount", step.amount);
+        steps.add(juce::var(object));
+    }
+    return juce::JSON::toString(juce::var(steps));
+}
+
+// =============================================================================
+// Running
+// =============================================================================
+
+InteractionReplay::InteractionReplay(juce::Component& root) : root_(root) {}
+
+InteractionReplay::~InteractionReplay() {
+    validFlag_->store(false);
+    stopTimer();
+}
+
+void InteractionReplay::start(Script script, std::function<void(const Results&)> onFinished) {
+    cancel();
+    script_ = std::move(script);
+    onFinished_ = std::move(onFinished);
+    results_ = {};
+    stepIndex_ = 0;
+    stepFrame_ = 0;
+
+    results_.report.setConfig("steps", static_cast<int>(script_.size()));
+    results_.report.setConfig("frameIntervalMs", FRAME_INTERVAL_MS);
+    results_.report.setConfig("width", root_.getWidth());
+    results_.report.setConfig("height", root_.getHeight());
+    results_.report.setConfig("cpu", juce::SystemStats::getCpuModel());
+    results_.report.setConfig("os", juce::SystemStats::getOperatingSystemName());
+
+    // Starts from clean profiler, monitor and watchdog statistics
+    suite_.startContinuousMonitoring();
+    if (script_.empty()) {
+        finish();
+        return;
+    }
+    startTimer(FRAME_INTERVAL_MS);
+}
+
+void InteractionReplay::cancel() {
+    stopTimer();
+    validFlag_->store(false);
+    validFlag_ = std::make_shared<std::atomic<bool>>(true);
+    framePending_ = false;
+    onFinished_ = nullptr;
+}
+
+void InteractionReplay::timerCallback() {
+    if (framePending_) {
+        return;  // Still queued: the loop is stalled and the frame's latency will say so
+    }
+
+    framePending_ = true;
+    const double postedMs = juce::Time::getMillisecondCounterHiRes();
+    juce::MessageManager::callAsync([this, valid = validFlag_, postedMs] {
+        if (valid->load()) {
+            runFrame(postedMs);
+        }
+    });
+}
+
+void InteractionReplay::runFrame(double postedMs) {
+    framePending_ = false;
+    if (stepIndex_ >= script_.size()) {
+        return;
+    }
+
+    const auto& step = script_[stepIndex_];
+    const auto phase = step.getPhaseName();
+
+    const double latencyMs = juce::Time::getMillisecondCounterHiRes() - postedMs;
+    UIFrameProfiler::getInstance().recordMessageLatency(latencyMs);
+    results_.report.addSample(phase + ".latency", latencyMs);
+    results_.report.addSample("replay.latency", latencyMs);
+
+    applyStep(step, stepFrame_);
+
+    const double frameStartMs = juce::Time::getMillisecondCounterHiRes();
+    flushFrame();
+    const double frameMs = juce::Time::getMillisecondCounterHiRes() - frameStartMs;
+    results_.report.addSample(phase + ".frame", frameMs);
+    results_.report.addSample("replay.frame", frameMs);
+    ++results_.framesRun;
+
+    if (++stepFrame_ >= getStepFrames(step)) {
+        stepFrame_ = 0;
+        if (++stepIndex_ >= script_.size()) {
+            finish();
+        }
+    }
+}
+
+void InteractionReplay::applyStep(const Step& step, int frame) {
+    bool found = true;
+    switch (step.action) {
+        case Action::Scroll:
+            found = scroll(step, frame);
+            break;
+        case Action::Zoom:
+            found = zoom(step, frame);
+            break;
+        case Action::Drag:
+            found = drag(step, frame);
+            break;
+        case Action::Mixer:
+            found = showMixer(step, frame);
+            break;
+        case Action::Macro:
+            found = sweepMacro(step, frame);
+            break;
+        case Action::Idle:
+            break;
+    }
+    if (!found) {
+        ++results_.missingTargets;
+    }
+}
+
+void InteractionReplay::flushFrame() {
+    frameProfile_.begin();
+    if (auto* peer = root_.getPeer()) {
+        peer->performAnyPendingRepaintsNow();
+    }
+    frameProfile_.end();
+}
+
+void InteractionReplay::finish() {
+    stopTimer();
+    results_.totals = suite_.stopContinuousMonitoring();
+
+    auto& report = results_.report;
+    report.setConfig("framesRun", results_.framesRun);
+    report.setConfig("missingTargets", results_.missingTargets);
+    report.setConfig("droppedFrames", results_.totals.droppedFrames);
+    report.setConfig("slowestView", results_.totals.slowestView);
+    report.setConfig("uiStalls", results_.totals.uiStalls);
+    for (const auto& usage : results_.totals.subsystemMemory) {
+        report.setMemory(usage.subsystem, usage.bytes);
+    }
+
+    if (auto onFinished = std::exchange(onFinished_, nullptr)) {
+        onFinished(results_);
+    }
+}
+
+int InteractionReplay::getStepFrames(const Step& step) const {
+    if (step.action == Action::Drag) {
+        return juce::jmax(1, juce::roundToInt(step.amount)) * juce::jmax(2, step.frames);
+    }
+    return juce::jmax(1, step.frames);
+}
+
+// =============================================================================
+// Component tree
+// =============================================================================
+
+template <typename ComponentType> ComponentType* InteractionReplay::findComponent() const {
+    const auto found = findComponents<ComponentType>();
+    return found.empty() ? nullptr : found.front();
+}
+
+template <typename ComponentType>
+std::vector<ComponentType*> InteractionReplay::findComponents() const {
+    std::vector<ComponentType*> found;
+    std::function<void(juce::Component&)> visit = [&](juce::Component& component) {
+        if (!component.isShowing()) {
+            return;
+        }
+        if (auto* match = dynamic_cast<ComponentType*>(&component)) {
+            found.push_back(match);
+        }
+        for (auto* child : component.getChildren()) {
+            visit(*child);
+        }
+    };
+    visit(root_);
+    return found;
+}
+
+juce::MouseEvent InteractionReplay::makeMouseEvent(juce::Component& target,
+                                                  juce::Point<float> position,
+                                                  juce::Point<float> downPosition,
+                                                  bool dragged) const {
+    const auto now = juce::Time::getCurrentTime();
+    return juce::MouseEvent(juce::Desktop::getInstance().getMainMouseSource(), position,
+                            juce::ModifierKeys(juce::ModifierKeys::leftButtonModifier),
+                            juce::MouseInputSource::defaultPressure,
+                            juce::MouseInputSource::defaultOrientation,
+                            juce::MouseInputSource::defaultRotation,
+                            juce::MouseInputSource::defaultTiltX,
+                            juce::MouseInputSource::defaultTiltY, &target, &target, now,
+                            downPosition, now, 1, dragged);
+}
+
+// =============================================================================
+// Actions
+// =============================================================================
+
+bool InteractionReplay::scroll(const Step& step, int frame) {
+    auto* timeline = findComponent<TimelineComponent>();
+    if (timeline == nullptr) {
+        return false;
+    }
+
+    // The ruler scrolls right for a negative delta; come back over the second half
+    const float delta = static_cast<float>(step.amount) * (frame < step.frames / 2 ? -1.0f : 1.0f);
+    const auto centre = timeline->getLocalBounds().getCentre().toFloat();
+    const auto event = makeMouseEvent(*timeline, centre, centre, false);
+    timeline->mouseWheelMove(event, juce::MouseWheelDetails{delta, 0.0f, false, true, false});
+    return true;
+}
+
+bool InteractionReplay::zoom(const Step& step, int frame) {
+    auto* mainView = findComponent<MainView>();
+    if (mainView == nullptr || step.amount <= 0.0) {
+        return false;
+    }
+
+    const double factor = frame < step.frames / 2 ? step.amount : 1.0 / step.amount;
+    mainView->setHorizontalZoom(mainView->getHorizontalZoom() * factor);
+    return true;
+}
+
+bool InteractionReplay::drag(const Step& step, int frame) {
+    const int framesPerClip = juce::jmax(2, step.frames);
+    const int clipIndex = frame / framesPerClip;
+    const int clipFrame = frame % framesPerClip;
+
+    // The clips showing when the step starts, dragged in turn
+    if (frame == 0) {
+        dragClips_.clear();
+        for (auto* clip : findComponents<ClipComponent>()) {
+            dragClips_.push_back(clip->getClipId());
+        }
+    }
+
+    if (clipFrame == 0) {
+        dragTarget_ = nullptr;
+        if (clipIndex < static_cast<int>(dragClips_.size())) {
+            for (auto* clip : findComponents<ClipComponent>()) {
+                if (clip->getClipId() == dragClips_[static_cast<size_t>(clipIndex)]) {
+                    dragTarget_ = clip;
+                    break;
+                }
+            }
+        }
+    }
+
+    // Rebuilt or scrolled away since it was picked
+    auto* clip = dragTarget_.getComponent();
+    auto* parent = clip != nullptr ? clip->getParentComponent() : nullptr;
+    if (parent == nullptr) {
+        return false;
+    }
+
+    if (clipFrame == 0) {
+        dragDownPosition_ = clip->getBounds().getCentre().toFloat();
+    }
+    const auto position =
+        dragDownPosition_.translated(float(clipFrame * DRAG_PIXELS_PER_FRAME), 0.0f);
+
+    // Handlers read positions relative to the clip, which moves as it's dragged
+    const auto event = makeMouseEvent(*clip, clip->getLocalPoint(parent, position),
+                                      clip->getLocalPoint(parent, dragDownPosition_),
+                                      clipFrame > 0);
+    if (clipFrame == 0) {
+        clip->mouseDown(event);
+    } else {
+        clip->mouseDrag(event);
+        if (clipFrame == framesPerClip - 1) {
+            clip->mouseUp(event);
+        }
+    }
+    return true;
+}
+
+bool InteractionReplay::showMixer(const Step& step, int frame) {
+    auto& views = ViewModeController::getInstance();
+    if (frame == 0) {
+        previousViewMode_ = views.getViewMode();
+        views.setViewMode(ViewMode::Mix);
+    }
+    if (frame == step.frames - 1 && previousViewMode_) {
+        views.setViewMode(*previousViewMode_);
+        previousViewMode_.reset();
+    }
+    return true;
+}
+
+bool InteractionReplay::sweepMacro(const Step& step, int frame) {
+    auto& tm = TrackManager::getInstance();
+
+    if (frame == 0) {
+        macroDevice_ = INVALID_DEVICE_ID;
+        tm.forEachTrackMacro(
+            [this](TrackId, ModOwner owner, int ownerId, int macroIndex, const MacroInfo& macro) {
+                if (macroDevice_ == INVALID_DEVICE_ID && owner == ModOwner::Device &&
+                    macroIndex == 0) {
+                    macroDevice_ = ownerId;
+                    macroStartValue_ = macro.value;
+                }
+            });
+    }
+
+    const auto path = macroDevice_ != INVALID_DEVICE_ID ? tm.findDevicePath(macroDevice_)
+                                                        : ChainNodePath();
+    if (!path.isValid()) {
+        return false;
+    }
+
+    const bool last = frame == step.frames - 1;
+    const double phase = step.amount * frame / double(juce::jmax(1, step.frames));
+    tm.setDeviceMacroValue(path, 0, last ? macroStartValue_ : float(triangle(phase)));
+    return true;
+}
+
+}  // namespace magda
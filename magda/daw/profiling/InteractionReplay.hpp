@@ -0,0 +1,156 @@
+#pragma once
+
+#include <juce_gui_basics/juce_gui_basics.h>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "../core/ClipTypes.hpp"
+#include "../core/TypeIds.hpp"
+#include "../core/ViewModeState.hpp"
+#include "BenchmarkReport.hpp"
+#include "BenchmarkSuite.hpp"
+#include "UIFrameProfiler.hpp"
+
+namespace magda {
+
+/**
+ * @brief Replays a script of synthetic interactions against the live UI and times each frame
+ *
+ * Frame-time regressions in scrolling, zooming, dragging and the mixer only show up by
+ * feel; this turns them into numbers that can be compared between builds. A script is a
+ * list of steps, each running for a number of frames at the display rate:
+ *
+ *   scroll   wheel events on the timeline ruler, right then back (amount: wheel delta)
+ *   zoom     horizontal zoom in then back out (amount: factor per frame)
+ *   drag     drag clips one after another by their middle (amount: how many clips; frames
+ *            are per clip, a few pixels each)
+ *   mixer    switch to the mixer, stay for the frames, switch back
+ *   macro    sweep the first device macro up and back down (amount: sweeps)
+ *   idle     nothing, for the views' own timers and meters
+ *
+ * Scroll and drag go through the components' own mouse handlers and zoom through MainView,
+ * found by walking the window's component tree, so the replay breaks if the app stops
+ * handling the gesture. Macros have no visible knob unless a device panel is open, so the
+ * sweep goes through TrackManager and reaches the UI through its listeners.
+ *
+ * Each frame is posted to the message loop and its delivery delay recorded as message
+ * latency; the step's change is then made and the window's pending repaints are flushed
+ * synchronously under one UIFrameProfiler span, so the frame covers every view it dirtied.
+ * Per-step frame and latency samples go into a BenchmarkReport ("<step>.frame",
+ * "<step>.latency", plus "replay.frame" and "replay.latency" over the whole script) and
+ * the run's UI totals into BenchmarkSuite::BenchmarkResults.
+ *
+ * With GPU rendering on, the window paints on the GL thread and frames aren't timed.
+ *
+ * Message thread only.
+ */
+class InteractionReplay : private juce::Timer {
+  public:
+    enum class Action { Scroll, Zoom, Drag, Mixer, Macro, Idle };
+
+    struct Step {
+        Action action = Action::Idle;
+        juce::String name;  // Phase name in the report; the action's name when empty
+        int frames = 60;
+        double amount = 1.0;  // See the actions above; getDefaultAmount() if not given
+
+        juce::String getPhaseName() const;
+    };
+
+    using Script = std::vector<Step>;
+
+    /**
+     * @brief Scroll, zoom, drag 50 clips, open the mixer and sweep a macro
+     */
+    static Script getDefaultScript();
+
+    /**
+     * @brief Parse a script: a JSON array of { "action", "name", "frames", "amount" }
+     * @return The script, or nullopt if the text isn't one (or names an unknown action)
+     */
+    static std::optional<Script> parseScript(const juce::String& json);
+    static juce::String toJSON(const Script& script);
+
+    static const char* getActionName(Action action);
+    static std::optional<Action> findAction(const juce::String& name);
+    static double getDefaultAmount(Action action);
+
+    struct Results {
+        BenchmarkReport report;
+        BenchmarkSuite::BenchmarkResults totals;
+        int framesRun = 0;
+        int missingTargets = 0;  // Frames whose target wasn't found (no clips, no macro...)
+    };
+
+    /**
+     * @param root The window's content component, searched for the views to drive
+     */
+    explicit InteractionReplay(juce::Component& root);
+    ~InteractionReplay() override;
+
+    /**
+     * @brief Run the script; onFinished is called on the message thread when it's done
+     */
+    void start(Script script, std::function<void(const Results&)> onFinished);
+    void cancel();
+
+    bool isRunning() const {
+        return isTimerRunning() || framePending_;
+    }
+
+    static constexpr int FRAME_INTERVAL_MS = 16;  // 60 Hz, the profiler's default budget
+
+  private:
+    void timerCallback() override;
+    void runFrame(double postedMs);
+    void applyStep(const Step& step, int frame);
+    void flushFrame();
+    void finish();
+
+    // Step actions (frame counts from 0 within the step)
+    bool scroll(const Step& step, int frame);
+    bool zoom(const Step& step, int frame);
+    bool drag(const Step& step, int frame);
+    bool showMixer(const Step& step, int frame);
+    bool sweepMacro(const Step& step, int frame);
+
+    int getStepFrames(const Step& step) const;
+
+    template <typename ComponentType> ComponentType* findComponent() const;
+    template <typename ComponentType> std::vector<ComponentType*> findComponents() const;
+
+    juce::MouseEvent makeMouseEvent(juce::Component& target, juce::Point<float> position,
+                                    juce::Point<float> downPosition, bool dragged) const;
+
+    juce::Component& root_;
+    Script script_;
+    std::function<void(const Results&)> onFinished_;
+    Results results_;
+    BenchmarkSuite suite_;
+    UIFrameProfiler::Source frameProfile_{"InteractionReplay"};
+
+    size_t stepIndex_ = 0;
+    int stepFrame_ = 0;
+    bool framePending_ = false;
+
+    // Per-step state, reset when a step starts
+    std::vector<ClipId> dragClips_;
+    juce::Component::SafePointer<juce::Component> dragTarget_;
+    juce::Point<float> dragDownPosition_;  // In the clip's parent
+    std::optional<ViewMode> previousViewMode_;
+    DeviceId macroDevice_ = INVALID_DEVICE_ID;
+    float macroStartValue_ = 0.0f;
+
+    static constexpr int DRAG_PIXELS_PER_FRAME = 3;
+
+    // Validity flag for async callbacks - set to false in destructor
+    std::shared_ptr<std::atomic<bool>> validFlag_ = std::make_shared<std::atomic<bool>>(true);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(InteractionReplay)
+};
+
+}  // namespace magda
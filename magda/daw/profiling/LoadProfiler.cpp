@@ -0,0 +1,240 @@
+#include "LoadProfiler.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <map>
+
+namespace magda {
+
+namespace {
+
+double nowMs() {
+    return juce::Time::getMillisecondCounterHiRes();
+}
+
+juce::String formatMs(double milliseconds) {
+    return juce::String(milliseconds, 1) + " ms";
+}
+
+/**
+ * @brief Items grouped by category, each group slowest first
+ */
+std::map<juce::String, std::vector<LoadProfiler::Item>> itemsByCategory(
+    const LoadProfiler::Timeline& timeline) {
+    std::map<juce::String, std::vector<LoadProfiler::Item>> groups;
+    for (const auto& item : timeline.items) {
+        groups[item.category].push_back(item);
+    }
+    for (auto& [category, items] : groups) {
+        std::stable_sort(items.begin(), items.end(), [](const auto& a, const auto& b) {
+            return a.durationMs > b.durationMs;
+        });
+    }
+    return groups;
+}
+
+}  // namespace
+
+// =============================================================================
+// ScopedPhase
+// =============================================================================
+
+LoadProfiler::ScopedPhase::ScopedPhase(const juce::String& name)
+    : monitor_(ProfilingCounters::getInstance().registerCounter(("Load." + name).toStdString())),
+      index_(LoadProfiler::getInstance().beginPhase(name, nowMs())) {}
+
+LoadProfiler::ScopedPhase::~ScopedPhase() {
+    LoadProfiler::getInstance().endPhase(index_, nowMs());
+}
+
+// =============================================================================
+// LoadProfiler
+// =============================================================================
+
+LoadProfiler& LoadProfiler::getInstance() {
+    static LoadProfiler instance;
+    return instance;
+}
+
+void LoadProfiler::begin(const juce::String& name) {
+    begin(name, nowMs());
+}
+
+void LoadProfiler::begin(const juce::String& name, double now) {
+    const juce::ScopedLock lock(lock_);
+    timeline_ = {};
+    timeline_.name = name;
+    startMs_ = now;
+    running_ = true;
+    finishRequested_ = false;
+    openPhases_.clear();
+}
+
+int LoadProfiler::beginPhase(const juce::String& name, double now) {
+    const juce::ScopedLock lock(lock_);
+    if (!running_) {
+        return -1;
+    }
+
+    Phase phase;
+    phase.name = name;
+    phase.depth = static_cast<int>(openPhases_.size());
+    phase.startMs = now - startMs_;
+    timeline_.phases.push_back(phase);
+
+    const auto index = static_cast<int>(timeline_.phases.size() - 1);
+    openPhases_.push_back(index);
+    return index;
+}
+
+void LoadProfiler::endPhase(int index, double now) {
+    juce::String category;
+    double durationMs = 0.0;
+    {
+        const juce::ScopedLock lock(lock_);
+        if (!running_ || index < 0 || index >= static_cast<int>(timeline_.phases.size())) {
+            return;
+        }
+
+        auto& phase = timeline_.phases[static_cast<size_t>(index)];
+        phase.durationMs = now - startMs_ - phase.startMs;
+        phase.finished = true;
+        openPhases_.erase(std::remove(openPhases_.begin(), openPhases_.end(), index),
+                          openPhases_.end());
+        category = "Load." + phase.name;
+        durationMs = phase.durationMs;
+    }
+    PerformanceMonitor::getInstance().addSample(category, durationMs);
+}
+
+void LoadProfiler::recordItem(const juce::String& category, const juce::String& name,
+                              double startMs, double durationMs, bool succeeded) {
+    const juce::ScopedLock lock(lock_);
+    if (!running_) {
+        return;
+    }
+    timeline_.items.push_back({category, name, startMs - startMs_, durationMs, succeeded});
+}
+
+void LoadProfiler::setItemsPending(bool pending) {
+    setItemsPending(pending, nowMs());
+}
+
+void LoadProfiler::setItemsPending(bool pending, double now) {
+    const juce::ScopedLock lock(lock_);
+    itemsPending_ = pending;
+    if (!pending && running_ && finishRequested_) {
+        complete(now);
+    }
+}
+
+void LoadProfiler::finish() {
+    finish(nowMs());
+}
+
+void LoadProfiler::finish(double now) {
+    const juce::ScopedLock lock(lock_);
+    if (!running_) {
+        return;
+    }
+    finishRequested_ = true;
+    if (!itemsPending_) {
+        complete(now);
+    }
+}
+
+void LoadProfiler::complete(double now) {
+    timeline_.totalMs = now - startMs_;
+    timeline_.finished = true;
+    running_ = false;
+    finishRequested_ = false;
+    openPhases_.clear();
+
+    std::cout << formatReport(timeline_) << std::flush;
+}
+
+bool LoadProfiler::isRunning() const {
+    const juce::ScopedLock lock(lock_);
+    return running_;
+}
+
+LoadProfiler::Timeline LoadProfiler::getTimeline() const {
+    const juce::ScopedLock lock(lock_);
+    auto timeline = timeline_;
+    if (running_) {
+        timeline.totalMs = nowMs() - startMs_;
+    }
+    return timeline;
+}
+
+juce::String LoadProfiler::generateReport() const {
+    return formatReport(getTimeline());
+}
+
+juce::String LoadProfiler::generateSummary(size_t maxPhases, size_t maxItems) const {
+    const auto timeline = getTimeline();
+    if (timeline.name.isEmpty()) {
+        return "No load recorded";
+    }
+
+    juce::String summary;
+    summary << timeline.name << ": " << formatMs(timeline.totalMs)
+            << (timeline.finished ? "" : " (loading)") << "\n";
+
+    // Only top-level phases, or nested time would be counted twice
+    auto phases = timeline.phases;
+    phases.erase(std::remove_if(phases.begin(), phases.end(),
+                                [](const auto& phase) { return phase.depth > 0; }),
+                 phases.end());
+    std::stable_sort(phases.begin(), phases.end(),
+                     [](const auto& a, const auto& b) { return a.durationMs > b.durationMs; });
+    for (size_t i = 0; i < std::min(maxPhases, phases.size()); ++i) {
+        summary << "  " << phases[i].name << ": " << formatMs(phases[i].durationMs) << "\n";
+    }
+
+    for (const auto& [category, items] : itemsByCategory(timeline)) {
+        for (size_t i = 0; i < std::min(maxItems, items.size()); ++i) {
+            summary << "  " << category << " " << items[i].name << ": "
+                    << formatMs(items[i].durationMs) << (items[i].succeeded ? "" : " (failed)")
+                    << "\n";
+        }
+    }
+    return summary.trimEnd();
+}
+
+juce::String LoadProfiler::formatReport(const Timeline& timeline) {
+    juce::String report;
+    report << "=== Load: " << timeline.name << " (" << formatMs(timeline.totalMs)
+           << (timeline.finished ? "" : ", still loading") << ") ===\n";
+
+    for (const auto& phase : timeline.phases) {
+        report << juce::String(phase.startMs, 1).paddedLeft(' ', 9) << " ms  "
+               << (phase.finished ? juce::String(phase.durationMs, 1) : juce::String("..."))
+                      .paddedLeft(' ', 9)
+               << " ms  " << juce::String::repeatedString("  ", phase.depth) << phase.name
+               << "\n";
+    }
+
+    for (const auto& [category, items] : itemsByCategory(timeline)) {
+        double totalMs = 0.0;
+        int failed = 0;
+        for (const auto& item : items) {
+            totalMs += item.durationMs;
+            failed += item.succeeded ? 0 : 1;
+        }
+
+        report << category << ": " << static_cast<int>(items.size()) << " in "
+               << formatMs(totalMs);
+        if (failed > 0) {
+            report << ", " << failed << " failed";
+        }
+        report << "\n";
+        for (const auto& item : items) {
+            report << juce::String(item.durationMs, 1).paddedLeft(' ', 9) << " ms  " << item.name
+                   << (item.succeeded ? "" : "  [failed]") << "\n";
+        }
+    }
+    return report;
+}
+
+}  // namespace magda
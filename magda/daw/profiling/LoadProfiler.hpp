@@ -0,0 +1,138 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+#include <vector>
+
+#include "PerformanceProfiler.hpp"
+
+namespace magda {
+
+/**
+ * @brief Wall-time breakdown of app startup and project opening, by phase
+ *
+ * A load is a timeline started with begin() and closed with finish(). Inside it, the code
+ * doing the work opens ScopedPhases (plugin list, audio devices, engine sync, main window,
+ * reading and applying a project); phases nest, so a slow one shows what inside it was
+ * slow. Work that happens item by item (plugin instantiation, waveform thumbnails) is
+ * recorded per item, so the report can name the plugin that took four seconds.
+ *
+ * Plugins load time-sliced after the window is up, so finish() waits for AudioBridge to
+ * report its queue drained before closing the timeline; the total is then what the user
+ * actually waited. A finished load is written to stdout and stays readable (DebugDialog
+ * shows it) until the next begin().
+ *
+ * Phases are also "Load.<name>" counters, so they land in the trace while TraceRecorder
+ * is recording, and samples in PerformanceMonitor. Phases nest in the order they open, so
+ * a load opens them from one thread at a time (a project is read on the pool while the
+ * message thread waits for it); items may be recorded from any thread, and only count
+ * while a load is open.
+ */
+class LoadProfiler {
+  public:
+    struct Phase {
+        juce::String name;
+        int depth = 0;         // Phases open around this one
+        double startMs = 0.0;  // Since the load began
+        double durationMs = 0.0;
+        bool finished = false;
+    };
+
+    struct Item {
+        juce::String category;  // "Plugin", "Thumbnail"
+        juce::String name;
+        double startMs = 0.0;   // Since the load began
+        double durationMs = 0.0;
+        bool succeeded = true;
+    };
+
+    struct Timeline {
+        juce::String name;
+        double totalMs = 0.0;
+        bool finished = false;
+        std::vector<Phase> phases;  // In the order they started
+        std::vector<Item> items;
+    };
+
+    /**
+     * @brief Times a phase of the current load for as long as it is in scope
+     */
+    class ScopedPhase {
+      public:
+        explicit ScopedPhase(const juce::String& name);
+        ~ScopedPhase();
+
+        ScopedPhase(const ScopedPhase&) = delete;
+        ScopedPhase& operator=(const ScopedPhase&) = delete;
+
+      private:
+        MonitoredProfiler monitor_;
+        int index_;
+    };
+
+    static LoadProfiler& getInstance();
+
+    /**
+     * @brief Start a new load timeline, replacing the last one
+     */
+    void begin(const juce::String& name);
+    void begin(const juce::String& name, double nowMs);
+
+    /**
+     * @return The phase's index, -1 if no load is running
+     */
+    int beginPhase(const juce::String& name, double nowMs);
+    void endPhase(int index, double nowMs);
+
+    /**
+     * @brief Record one item's load; ignored outside a load
+     * @param startMs Absolute, from juce::Time::getMillisecondCounterHiRes()
+     */
+    void recordItem(const juce::String& category, const juce::String& name, double startMs,
+                    double durationMs, bool succeeded);
+
+    /**
+     * @brief Whether items are still queued to load, holding finish() back
+     */
+    void setItemsPending(bool pending);
+    void setItemsPending(bool pending, double nowMs);
+
+    /**
+     * @brief Close the load once nothing is pending, and log its report
+     */
+    void finish();
+    void finish(double nowMs);
+
+    bool isRunning() const;
+
+    /**
+     * @brief The load in progress, or the last one to finish
+     */
+    Timeline getTimeline() const;
+
+    /**
+     * @brief Every phase with its start and duration, then items slowest first
+     */
+    juce::String generateReport() const;
+
+    /**
+     * @brief A few lines for DebugDialog: the total and the slowest phases and items
+     */
+    juce::String generateSummary(size_t maxPhases, size_t maxItems) const;
+
+  private:
+    LoadProfiler() = default;
+
+    void complete(double nowMs);
+    static juce::String formatReport(const Timeline& timeline);
+
+    mutable juce::CriticalSection lock_;
+    Timeline timeline_;
+    double startMs_ = 0.0;
+    bool running_ = false;
+    bool finishRequested_ = false;
+    bool itemsPending_ = false;
+    std::vector<int> openPhases_;
+};
+
+}  // namespace magda
@@ -0,0 +1,64 @@
+#include "MemoryAccounting.hpp"
+
+#include <algorithm>
+
+#include "../audio/AudioThumbnailManager.hpp"
+#include "../core/ClipManager.hpp"
+#include "../core/TrackManager.hpp"
+#include "../core/UndoManager.hpp"
+
+namespace magda {
+
+MemoryAccounting& MemoryAccounting::getInstance() {
+    static MemoryAccounting instance;
+    return instance;
+}
+
+Subscription MemoryAccounting::addSource(const juce::String& name,
+                                         std::function<size_t()> measure) {
+    const int id = nextSourceId_++;
+    sources_.push_back({id, name, std::move(measure)});
+
+    return Subscription([this, id] {
+        sources_.erase(std::remove_if(sources_.begin(), sources_.end(),
+                                      [id](const Source& source) { return source.id == id; }),
+                       sources_.end());
+    });
+}
+
+std::vector<MemoryAccounting::Usage> MemoryAccounting::collect() const {
+    std::vector<Usage> usage;
+    usage.push_back({"Tracks & devices", TrackManager::getInstance().getSizeInBytes()});
+    usage.push_back({"Clips & notes", ClipManager::getInstance().getSizeInBytes()});
+    usage.push_back({"Undo history", UndoManager::getInstance().getHistorySizeInBytes()});
+    const auto thumbnails = AudioThumbnailManager::getInstance().getCacheStats();
+    usage.push_back({"Waveform thumbnails", thumbnails.residentBytes});
+
+    for (const auto& source : sources_) {
+        usage.push_back({source.name, source.measure()});
+    }
+    return usage;
+}
+
+size_t MemoryAccounting::getTotalBytes(const std::vector<Usage>& usage) {
+    size_t total = 0;
+    for (const auto& entry : usage) {
+        total += entry.bytes;
+    }
+    return total;
+}
+
+juce::String MemoryAccounting::formatBytes(size_t bytes) {
+    constexpr double kKB = 1024.0;
+    constexpr double kMB = 1024.0 * 1024.0;
+
+    if (bytes < 1024) {
+        return juce::String(static_cast<juce::int64>(bytes)) + " B";
+    }
+    if (static_cast<double>(bytes) < kMB) {
+        return juce::String(static_cast<double>(bytes) / kKB, 1) + " KB";
+    }
+    return juce::String(static_cast<double>(bytes) / kMB, 1) + " MB";
+}
+
+}  // namespace magda
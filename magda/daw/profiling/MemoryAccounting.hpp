@@ -0,0 +1,64 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+#include <functional>
+#include <vector>
+
+#include "../core/Subscription.hpp"
+
+namespace magda {
+
+/**
+ * @brief Per-subsystem memory accounting
+ *
+ * Process-wide numbers can't say whether thumbnails, undo history or the model is what's
+ * growing, so each subsystem reports an estimate of its own heap footprint. The model
+ * managers, undo history and thumbnail cache are always measured; subsystems with a
+ * shorter life (the AudioBridge) register a source for as long as they exist.
+ *
+ * Estimates count container capacity and per-node overhead, not allocator metadata, so
+ * they're for comparing subsystems and spotting growth rather than matching the OS figure.
+ * Message thread only.
+ */
+class MemoryAccounting {
+  public:
+    struct Usage {
+        juce::String subsystem;
+        size_t bytes = 0;
+    };
+
+    static MemoryAccounting& getInstance();
+
+    /**
+     * @brief Measure a subsystem on every collect() until the subscription is dropped
+     */
+    [[nodiscard]] Subscription addSource(const juce::String& name,
+                                         std::function<size_t()> measure);
+
+    /**
+     * @brief Measure every subsystem: built-in ones first, then registered sources
+     */
+    std::vector<Usage> collect() const;
+
+    static size_t getTotalBytes(const std::vector<Usage>& usage);
+
+    /**
+     * @brief "812 B", "14.2 KB", "3.1 MB"
+     */
+    static juce::String formatBytes(size_t bytes);
+
+  private:
+    MemoryAccounting() = default;
+
+    struct Source {
+        int id = 0;
+        juce::String name;
+        std::function<size_t()> measure;
+    };
+
+    std::vector<Source> sources_;
+    int nextSourceId_ = 1;
+};
+
+}  // namespace magda
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace magda::memory {
+
+/**
+ * @brief Heap bytes reserved by a vector (capacity, not size: that's what's allocated)
+ */
+template <typename T, typename Alloc> size_t vectorBytes(const std::vector<T, Alloc>& v) {
+    return v.capacity() * sizeof(T);
+}
+
+/**
+ * @brief Approximate heap bytes of an unordered map or set
+ *
+ * Each element lives in its own node next to a link pointer and (libstdc++) a cached hash,
+ * and the bucket array holds one pointer per bucket. Close enough to compare subsystems;
+ * not an allocator-exact figure.
+ */
+template <typename HashContainer> size_t hashContainerBytes(const HashContainer& c) {
+    return c.size() * (sizeof(typename HashContainer::value_type) + 2 * sizeof(void*)) +
+           c.bucket_count() * sizeof(void*);
+}
+
+}  // namespace magda::memory
@@ -0,0 +1,297 @@
+#include "MetricsExporter.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+#include "DropoutLog.hpp"
+#include "MemoryAccounting.hpp"
+#include "StallWatchdog.hpp"
+#include "UIFrameProfiler.hpp"
+
+namespace magda {
+
+// =============================================================================
+// MetricsWriter
+// =============================================================================
+
+void MetricsWriter::gauge(const char* name, const char* help, double value,
+                          const Labels& labels) {
+    beginMetric(name, help, "gauge");
+    writeSample(juce::String("magda_") + name, labels, value);
+}
+
+void MetricsWriter::counter(const char* name, const char* help, double value,
+                            const Labels& labels) {
+    beginMetric(name, help, "counter");
+    writeSample(juce::String("magda_") + name, labels, value);
+}
+
+void MetricsWriter::summary(const char* name, const char* help,
+                            const ProfilingCounters::Snapshot& snapshot, const Labels& labels) {
+    beginMetric(name, help, "summary");
+    const juce::String base = juce::String("magda_") + name;
+    for (const double quantile : {0.5, 0.9, 0.99}) {
+        auto withQuantile = labels;
+        withQuantile.emplace_back("quantile", formatValue(quantile));
+        writeSample(base, withQuantile, snapshot.histogram.percentileNanos(quantile) * 1.0e-9);
+    }
+    writeSample(base + "_sum", labels, static_cast<double>(snapshot.sumNanos) * 1.0e-9);
+    writeSample(base + "_count", labels, static_cast<double>(snapshot.count));
+}
+
+juce::String MetricsWriter::formatValue(double value) {
+    if (std::isnan(value)) {
+        return "NaN";
+    }
+    if (std::isinf(value)) {
+        return value > 0.0 ? "+Inf" : "-Inf";
+    }
+    if (value == std::floor(value) && std::abs(value) < 1.0e15) {
+        return juce::String(static_cast<juce::int64>(value));
+    }
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.9g", value);
+    return buffer;
+}
+
+juce::String MetricsWriter::escapeLabelValue(const juce::String& value) {
+    return value.replace("\\", "\\\\").replace("\"", "\\\"").replace("\n", "\\n");
+}
+
+void MetricsWriter::beginMetric(const char* name, const char* help, const char* type) {
+    if (metric_ == name) {
+        return;
+    }
+    metric_ = name;
+    text_ << "# HELP magda_" << name << " " << help << "\n";
+    text_ << "# TYPE magda_" << name << " " << type << "\n";
+}
+
+void MetricsWriter::writeSample(const juce::String& name, const Labels& labels, double value) {
+    text_ << name;
+    if (!labels.empty()) {
+        text_ << "{";
+        for (size_t i = 0; i < labels.size(); ++i) {
+            text_ << (i > 0 ? "," : "") << labels[i].first << "=\""
+                  << escapeLabelValue(labels[i].second) << "\"";
+        }
+        text_ << "}";
+    }
+    text_ << " " << formatValue(value) << "\n";
+}
+
+// =============================================================================
+// Server
+// =============================================================================
+
+class MetricsExporter::Server : public juce::Thread {
+  public:
+    static constexpr int kMaxRequestBytes = 8192;
+    static constexpr int kRequestTimeoutMs = 2000;
+
+    explicit Server(MetricsExporter& owner) : juce::Thread("Metrics Server"), owner_(owner) {}
+
+    ~Server() override {
+        signalThreadShouldExit();
+        listener_.close();  // Wakes the thread from waitForNextConnection()
+        stopThread(kRequestTimeoutMs + 1000);
+    }
+
+    bool listen(int port, bool localOnly) {
+        return listener_.createListener(port, localOnly ? "127.0.0.1" : juce::String());
+    }
+
+  private:
+    void run() override {
+        while (!threadShouldExit()) {
+            std::unique_ptr<juce::StreamingSocket> client(listener_.waitForNextConnection());
+            if (client == nullptr) {
+                if (!threadShouldExit()) {
+                    juce::Thread::sleep(100);
+                }
+                continue;
+            }
+            serve(*client);
+        }
+    }
+
+    void serve(juce::StreamingSocket& client) {
+        // The request line and headers; the body of a GET is empty
+        juce::MemoryBlock request;
+        char buffer[1024];
+        while (request.getSize() < kMaxRequestBytes && !threadShouldExit()) {
+            if (client.waitUntilReady(true, kRequestTimeoutMs) != 1) {
+                return;
+            }
+            const int read = client.read(buffer, sizeof(buffer), false);
+            if (read <= 0) {
+                return;
+            }
+            request.append(buffer, static_cast<size_t>(read));
+            if (request.toString().contains("\r\n\r\n")) {
+                break;
+            }
+        }
+
+        const auto response = respond(request.toString(), owner_.getPage());
+        const auto* data = response.toRawUTF8();
+        const auto size = static_cast<int>(response.getNumBytesAsUTF8());
+        for (int written = 0; written < size && !threadShouldExit();) {
+            const int sent = client.write(data + written, size - written);
+            if (sent <= 0) {
+                return;
+            }
+            written += sent;
+        }
+    }
+
+    MetricsExporter& owner_;
+    juce::StreamingSocket listener_;
+};
+
+// =============================================================================
+// MetricsExporter
+// =============================================================================
+
+MetricsExporter& MetricsExporter::getInstance() {
+    static MetricsExporter instance;
+    return instance;
+}
+
+MetricsExporter::~MetricsExporter() {
+    stop();
+}
+
+bool MetricsExporter::start(int port, bool localOnly) {
+    if (isRunning()) {
+        return true;
+    }
+
+    auto server = std::make_unique<Server>(*this);
+    if (!server->listen(port, localOnly)) {
+        DBG("MetricsExporter: couldn't listen on port " << port);
+        return false;
+    }
+
+    auto& counters = ProfilingCounters::getInstance();
+    countersWereEnabled_ = counters.isEnabled();
+    counters.setEnabled(true);
+
+    timerCallback();  // A first page before the first scrape
+    server_ = std::move(server);
+    server_->startThread(juce::Thread::Priority::low);
+    startTimer(kRefreshMs);
+    DBG("MetricsExporter: serving http://" << (localOnly ? "127.0.0.1" : "0.0.0.0") << ":"
+                                           << port << "/metrics");
+    return true;
+}
+
+void MetricsExporter::stop() {
+    if (!isRunning()) {
+        return;
+    }
+
+    stopTimer();
+    server_.reset();
+    ProfilingCounters::getInstance().setEnabled(countersWereEnabled_);
+}
+
+Subscription MetricsExporter::addSource(std::function<void(MetricsWriter&)> write) {
+    const int id = nextSourceId_++;
+    sources_.push_back({id, std::move(write)});
+
+    return Subscription([this, id] {
+        sources_.erase(std::remove_if(sources_.begin(), sources_.end(),
+                                      [id](const Source& source) { return source.id == id; }),
+                       sources_.end());
+    });
+}
+
+juce::String MetricsExporter::collect() const {
+    MetricsWriter writer;
+
+    auto& counters = ProfilingCounters::getInstance();
+    for (ProfilingCounters::Id id = 0; id < counters.getNumCounters(); ++id) {
+        writer.summary("scope_duration_seconds",
+                       "Time spent in each profiled scope since the counters were last reset",
+                       counters.snapshot(id), {{"scope", juce::String(counters.getName(id))}});
+    }
+
+    for (const auto& usage : MemoryAccounting::getInstance().collect()) {
+        writer.gauge("memory_bytes", "Estimated heap footprint by subsystem",
+                     static_cast<double>(usage.bytes), {{"subsystem", usage.subsystem}});
+    }
+
+    const auto& dropouts = DropoutLog::getInstance();
+    writer.counter("audio_dropouts_total",
+                   "Audio callbacks that overran, arrived late or came with device xruns",
+                   dropouts.getTotalCount());
+    writer.counter("audio_dropouts_lost_total", "Dropouts not recorded because the log was full",
+                   static_cast<double>(dropouts.getDroppedCount()));
+
+    const auto& watchdog = StallWatchdog::getInstance();
+    writer.counter("ui_stalls_total", "Message loop stalls past the watchdog threshold",
+                   watchdog.getStallCount());
+    writer.gauge("ui_stall_longest_seconds", "Longest message loop stall",
+                 watchdog.getLongestStallMs() * 0.001);
+
+    const auto frames = UIFrameProfiler::getInstance().getFrameStats();
+    writer.counter("ui_frames_total", "UI frames painted", static_cast<double>(frames.frames));
+    writer.counter("ui_dropped_frames_total", "UI frames over the 60 FPS budget",
+                   static_cast<double>(frames.droppedFrames));
+
+    for (const auto& source : sources_) {
+        source.write(writer);
+    }
+    return writer.getText();
+}
+
+juce::String MetricsExporter::getPage() const {
+    const juce::ScopedLock lock(pageLock_);
+    return page_;
+}
+
+void MetricsExporter::timerCallback() {
+    auto page = collect();
+    const juce::ScopedLock lock(pageLock_);
+    page_ = std::move(page);
+}
+
+juce::String MetricsExporter::respond(const juce::String& request, const juce::String& page) {
+    const auto requestLine = request.upToFirstOccurrenceOf("\r\n", false, false);
+    const auto method = requestLine.upToFirstOccurrenceOf(" ", false, false);
+    const auto target = requestLine.fromFirstOccurrenceOf(" ", false, false)
+                            .upToFirstOccurrenceOf(" ", false, false)
+                            .upToFirstOccurrenceOf("?", false, false);
+
+    juce::String status = "200 OK";
+    juce::String contentType = "text/plain; version=0.0.4; charset=utf-8";
+    juce::String body;
+    if (method != "GET" && method != "HEAD") {
+        status = "405 Method Not Allowed";
+        contentType = "text/plain; charset=utf-8";
+        body = "Only GET is supported\n";
+    } else if (target == "/metrics") {
+        body = page;
+    } else if (target == "/") {
+        contentType = "text/plain; charset=utf-8";
+        body = "MAGDA metrics are at /metrics\n";
+    } else {
+        status = "404 Not Found";
+        contentType = "text/plain; charset=utf-8";
+        body = "Not found\n";
+    }
+
+    juce::String response;
+    response << "HTTP/1.1 " << status << "\r\n";
+    response << "Content-Type: " << contentType << "\r\n";
+    response << "Content-Length: " << static_cast<int>(body.getNumBytesAsUTF8()) << "\r\n";
+    response << "Connection: close\r\n\r\n";
+    if (method != "HEAD") {
+        response << body;
+    }
+    return response;
+}
+
+}  // namespace magda
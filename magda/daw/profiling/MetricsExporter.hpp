@@ -0,0 +1,127 @@
+#pragma once
+
+#include <juce_events/juce_events.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../core/Subscription.hpp"
+#include "ProfilingCounters.hpp"
+
+namespace magda {
+
+/**
+ * @brief Builds a page of metrics in the Prometheus text format
+ *
+ * Names get the "magda_" prefix. The samples of one metric must be written one after
+ * another, as the format wants each metric's HELP and TYPE lines once, ahead of them.
+ */
+class MetricsWriter {
+  public:
+    using Labels = std::vector<std::pair<juce::String, juce::String>>;
+
+    void gauge(const char* name, const char* help, double value, const Labels& labels = {});
+    void counter(const char* name, const char* help, double value, const Labels& labels = {});
+
+    /**
+     * @brief A duration counter as a summary in seconds: quantiles, sum and count
+     */
+    void summary(const char* name, const char* help, const ProfilingCounters::Snapshot& snapshot,
+                 const Labels& labels = {});
+
+    const juce::String& getText() const {
+        return text_;
+    }
+
+    /**
+     * @brief A sample value: integers exactly, everything else to nine significant digits
+     */
+    static juce::String formatValue(double value);
+
+    static juce::String escapeLabelValue(const juce::String& value);
+
+  private:
+    void beginMetric(const char* name, const char* help, const char* type);
+    void writeSample(const juce::String& name, const Labels& labels, double value);
+
+    juce::String text_;
+    std::string metric_;  // The metric whose samples are being written
+};
+
+/**
+ * @brief Serves live performance metrics over HTTP for Prometheus to scrape
+ *
+ * Off unless started (MainWindow starts it when Config's metricsPort is set). Once a
+ * second the message thread reads every source into a page: the profiling counters as
+ * duration summaries (the audio callback among them), memory per subsystem, dropouts and
+ * UI stalls, plus what registered sources add (AudioBridge: CPU load, xruns, disk stream
+ * buffers, plugin counts). Everything is read from counters the audio thread already
+ * keeps, so nothing is asked of it. A server thread answers GET /metrics with the last
+ * page, so a slow scrape never holds up the message thread.
+ *
+ * The profiling counters are switched on while the exporter runs; they cost a few
+ * uncontended atomic adds per scope. start(), stop() and addSource() on the message thread.
+ */
+class MetricsExporter : private juce::Timer {
+  public:
+    static constexpr int kRefreshMs = 1000;
+
+    static MetricsExporter& getInstance();
+
+    /**
+     * @param localOnly Accept connections from this machine only
+     * @return False if the port couldn't be opened
+     */
+    bool start(int port, bool localOnly = true);
+    void stop();
+
+    bool isRunning() const {
+        return server_ != nullptr;
+    }
+
+    /**
+     * @brief Add to every page until the subscription is dropped
+     */
+    [[nodiscard]] Subscription addSource(std::function<void(MetricsWriter&)> write);
+
+    /**
+     * @brief Build a page now (message thread)
+     */
+    juce::String collect() const;
+
+    /**
+     * @brief The last page built, from any thread
+     */
+    juce::String getPage() const;
+
+    /**
+     * @brief The HTTP response to a request for the given page
+     */
+    static juce::String respond(const juce::String& request, const juce::String& page);
+
+  private:
+    MetricsExporter() = default;
+    ~MetricsExporter() override;
+
+    class Server;
+
+    void timerCallback() override;
+
+    struct Source {
+        int id = 0;
+        std::function<void(MetricsWriter&)> write;
+    };
+
+    std::vector<Source> sources_;
+    int nextSourceId_ = 0;
+    std::unique_ptr<Server> server_;
+    bool countersWereEnabled_ = false;
+
+    mutable juce::CriticalSection pageLock_;
+    juce::String page_;  // Guarded by pageLock_
+};
+
+}  // namespace magda
@@ -2,12 +2,19 @@
 
 #include <tracktion_engine/tracktion_engine.h>
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <cstddef>
 #include <limits>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#include "../core/Symbol.hpp"
+#include "ProfilingCounters.hpp"
+#include "TraceRecorder.hpp"
+
 namespace magda {
 
 /**
@@ -95,33 +102,63 @@ struct PerformanceStats {
     double max = 0.0;
     double sum = 0.0;
     int count = 0;
+    LatencyHistogram histogram;  // For percentiles, at 1e-6 ms resolution
 
     void addSample(double value) {
         min = std::min(min, value);
         max = std::max(max, value);
         sum += value;
         count++;
+        histogram.addNanos(static_cast<uint64_t>(std::max(0.0, value) * 1.0e6));
+    }
+
+    /**
+     * @brief Fold in a registered counter's snapshot (durations in ms)
+     */
+    void merge(const ProfilingCounters::Snapshot& snapshot) {
+        if (snapshot.count == 0)
+            return;
+
+        min = std::min(min, static_cast<double>(snapshot.minNanos) * 1.0e-6);
+        max = std::max(max, static_cast<double>(snapshot.maxNanos) * 1.0e-6);
+        sum += static_cast<double>(snapshot.sumNanos) * 1.0e-6;
+        count += static_cast<int>(snapshot.count);
+        histogram.merge(snapshot.histogram);
     }
 
     double average() const {
         return count > 0 ? sum / count : 0.0;
     }
 
+    /**
+     * @brief Value below which the given fraction of samples fall (0 if none)
+     * @param fraction 0.5 for the median, 0.99 for p99
+     */
+    double percentile(double fraction) const {
+        return histogram.percentileNanos(fraction) * 1.0e-6;
+    }
+
     void reset() {
         min = std::numeric_limits<double>::max();
         max = 0.0;
         sum = 0.0;
         count = 0;
+        histogram.clear();
     }
 
     juce::String toString() const {
-        return juce::String::formatted("avg: %.2f ms, min: %.2f ms, max: %.2f ms, samples: %d",
-                                       average(), min, max, count);
+        return juce::String::formatted(
+            "avg: %.2f ms, p50: %.2f ms, p99: %.2f ms, min: %.2f ms, max: %.2f ms, samples: %d",
+            average(), percentile(0.5), percentile(0.99), min, max, count);
     }
 };
 
 /**
  * @brief Central performance statistics collector
+ *
+ * Categories and counters are keyed by Symbol; callers that record often (per paint, per
+ * plugin load) intern their category once and pass the Symbol, so recording a sample
+ * hashes an integer under the lock instead of the category's text.
  */
 class PerformanceMonitor {
   public:
@@ -135,20 +172,21 @@ class PerformanceMonitor {
      * @param enabled true to enable profiling, false to disable
      */
     void setEnabled(bool enabled) {
-        enabled_ = enabled;
+        enabled_.store(enabled, std::memory_order_relaxed);
+        ProfilingCounters::getInstance().setEnabled(enabled);
     }
 
     /**
      * @brief Check if profiling is currently enabled
      */
     bool isEnabled() const {
-        return enabled_;
+        return enabled_.load(std::memory_order_relaxed);
     }
 
     /**
      * @brief Add a timing sample for a named operation
      */
-    void addSample(const juce::String& category, double milliseconds) {
+    void addSample(Symbol category, double milliseconds) {
         if (!enabled_)
             return;
 
@@ -156,37 +194,103 @@ class PerformanceMonitor {
         stats_[category].addSample(milliseconds);
     }
 
+    void addSample(const juce::String& category, double milliseconds) {
+        if (enabled_)
+            addSample(Symbol(category), milliseconds);
+    }
+
     /**
-     * @brief Get statistics for a category
+     * @brief Record the current value of a named event counter (e.g. dropped items)
+     *
+     * Counters are absolute totals owned by the caller; the monitor just keeps the
+     * latest value for reporting.
      */
-    PerformanceStats getStats(const juce::String& category) const {
+    void setCounter(Symbol name, juce::int64 value) {
+        if (!enabled_)
+            return;
+
+        const juce::ScopedLock lock(statsLock_);
+        counters_[name] = value;
+    }
+
+    void setCounter(const juce::String& name, juce::int64 value) {
+        if (enabled_)
+            setCounter(Symbol(name), value);
+    }
+
+    /**
+     * @brief Get the last recorded value of a counter (0 if never set)
+     */
+    juce::int64 getCounter(const juce::String& name) const {
+        const auto symbol = Symbol::find(name);
+        if (!symbol)
+            return 0;
+
         const juce::ScopedLock lock(statsLock_);
-        auto it = stats_.find(category);
-        return it != stats_.end() ? it->second : PerformanceStats{};
+        auto it = counters_.find(*symbol);
+        return it != counters_.end() ? it->second : 0;
+    }
+
+    /**
+     * @brief Get statistics for a category (addSample() samples and the registered
+     *        ProfilingCounters counter of the same name, merged)
+     */
+    PerformanceStats getStats(const juce::String& category) const {
+        PerformanceStats result;
+        if (const auto symbol = Symbol::find(category)) {
+            const juce::ScopedLock lock(statsLock_);
+            auto it = stats_.find(*symbol);
+            if (it != stats_.end())
+                result = it->second;
+        }
+
+        auto& counters = ProfilingCounters::getInstance();
+        result.merge(counters.snapshot(counters.findCounter(category.toStdString())));
+        return result;
     }
 
     /**
      * @brief Get all collected statistics
      */
     std::unordered_map<juce::String, PerformanceStats> getAllStats() const {
-        const juce::ScopedLock lock(statsLock_);
-        return stats_;
+        std::unordered_map<juce::String, PerformanceStats> all;
+        {
+            const juce::ScopedLock lock(statsLock_);
+            for (const auto& [category, stats] : stats_)
+                all.emplace(category.getString(), stats);
+        }
+
+        auto& counters = ProfilingCounters::getInstance();
+        for (int id = 0; id < counters.getNumCounters(); ++id) {
+            auto snapshot = counters.snapshot(id);
+            if (snapshot.count > 0)
+                all[juce::String(counters.getName(id))].merge(snapshot);
+        }
+        return all;
     }
 
     /**
      * @brief Reset statistics for a category
      */
     void reset(const juce::String& category) {
-        const juce::ScopedLock lock(statsLock_);
-        stats_[category].reset();
+        {
+            const juce::ScopedLock lock(statsLock_);
+            stats_[Symbol(category)].reset();
+        }
+        auto& counters = ProfilingCounters::getInstance();
+        counters.reset(counters.findCounter(category.toStdString()));
     }
 
     /**
      * @brief Reset all statistics
      */
     void resetAll() {
-        const juce::ScopedLock lock(statsLock_);
-        stats_.clear();
+        {
+            const juce::ScopedLock lock(statsLock_);
+            stats_.clear();
+            counters_.clear();
+        }
+        ProfilingCounters::getInstance().resetAll();
     }
 
     /**
@@ -196,21 +300,30 @@ class PerformanceMonitor {
     void shutdown() {
         const juce::ScopedLock lock(statsLock_);
         stats_.clear();
-        enabled_ = false;
+        counters_.clear();
+        setEnabled(false);
     }
 
     /**
      * @brief Generate a performance report
      */
     juce::String generateReport() const {
+        const auto allStats = getAllStats();
         const juce::ScopedLock lock(statsLock_);
         juce::String report;
         report << "=== Performance Report ===\n\n";
 
-        for (const auto& [category, stats] : stats_) {
+        for (const auto& [category, stats] : allStats) {
             report << category << ": " << stats.toString() << "\n";
         }
 
+        if (!counters_.empty()) {
+            report << "\n";
+            for (const auto& [name, value] : counters_) {
+                report << name.getString() << ": " << juce::String(value) << "\n";
+            }
+        }
+
         return report;
     }
 
@@ -218,35 +331,53 @@ class PerformanceMonitor {
     PerformanceMonitor() = default;
 
     mutable juce::CriticalSection statsLock_;
-    std::unordered_map<juce::String, PerformanceStats> stats_;
-    bool enabled_ = false;  // Profiling disabled by default, enable with setEnabled(true)
+    std::unordered_map<Symbol, PerformanceStats> stats_;
+    std::unordered_map<Symbol, juce::int64> counters_;
+    std::atomic<bool> enabled_{false};  // Disabled by default, enable with setEnabled(true)
 };
 
 /**
  * @brief RAII profiler that reports to PerformanceMonitor
+ *
+ * Records into a registered ProfilingCounters counter: no lock, string hash or allocation
+ * per scope, so it is safe on the audio thread. Register the id once (MAGDA_MONITOR_SCOPE
+ * does it in a function-local static). While TraceRecorder is recording, the scope is also
+ * added to the trace timeline.
  */
-class MonitoredProfiler {
+class MonitoredProfiler : public ScopedCounterTimer {
   public:
-    explicit MonitoredProfiler(const juce::String& category) : category_(category), timer_() {}
+    explicit MonitoredProfiler(ProfilingCounters::Id id) : ScopedCounterTimer(id) {}
 
     ~MonitoredProfiler() {
-        double elapsed = timer_.elapsedMilliseconds();
-        PerformanceMonitor::getInstance().addSample(category_, elapsed);
+        auto& trace = TraceRecorder::getInstance();
+        if (trace.isRecording()) {
+            trace.record(getId(), getStart(), std::chrono::steady_clock::now());
+        }
     }
 
-  private:
-    juce::String category_;
-    HighResTimer timer_;
+    MonitoredProfiler(const MonitoredProfiler&) = delete;
+    MonitoredProfiler& operator=(const MonitoredProfiler&) = delete;
 };
 
 // =========================================================================
 // Macros for Convenience
 // =========================================================================
 
+#define MAGDA_PROFILING_CONCAT_INNER(a, b) a##b
+#define MAGDA_PROFILING_CONCAT(a, b) MAGDA_PROFILING_CONCAT_INNER(a, b)
+
+// Active in every build (records only while the monitor is enabled). The first pass through
+// a scope registers its counter, which locks; on the audio thread register the id up front
+// and construct a MonitoredProfiler with it instead.
+#define MAGDA_MONITOR_SCOPE(category)                                                              \
+    static const ::magda::ProfilingCounters::Id MAGDA_PROFILING_CONCAT(_monitorId_, __LINE__) =    \
+        ::magda::ProfilingCounters::getInstance().registerCounter(category);                       \
+    ::magda::MonitoredProfiler MAGDA_PROFILING_CONCAT(_monitor_, __LINE__)(                        \
+        MAGDA_PROFILING_CONCAT(_monitorId_, __LINE__))
+
 #if JUCE_DEBUG
     #define MAGDA_PROFILE_SCOPE(name) ScopedProfiler _profiler_##__LINE__(name)
     #define MAGDA_PROFILE_FUNCTION() ScopedProfiler _profiler_##__LINE__(__FUNCTION__)
-    #define MAGDA_MONITOR_SCOPE(category) MonitoredProfiler _monitor_##__LINE__(category)
 #else
     #define MAGDA_PROFILE_SCOPE(name)                                                              \
         do {                                                                                       \
@@ -254,9 +385,6 @@ class MonitoredProfiler {
     #define MAGDA_PROFILE_FUNCTION()                                                               \
         do {                                                                                       \
         } while (false)
-    #define MAGDA_MONITOR_SCOPE(category)                                                          \
-        do {                                                                                       \
-        } while (false)
 #endif
 
 }  // namespace magda
@@ -0,0 +1,375 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace magda {
+
+/**
+ * @brief Log-linear histogram of durations in nanoseconds (HDR-style)
+ *
+ * Values below 16 ns are counted exactly; above that each power of two is split into 16
+ * buckets, so a percentile is reported within ~6% of the true value up to about 18 minutes,
+ * in a fixed 592 buckets.
+ */
+class LatencyHistogram {
+  public:
+    static constexpr int kSubBucketBits = 4;
+    static constexpr uint64_t kSubBuckets = 1u << kSubBucketBits;
+    static constexpr int kMaxShift = 36;  // Values up to 2^40 ns
+    static constexpr size_t kNumBuckets = kSubBuckets * (kMaxShift + 1);
+
+    static size_t bucketFor(uint64_t nanos) {
+        if (nanos < kSubBuckets) {
+            return static_cast<size_t>(nanos);
+        }
+        const int msb = std::bit_width(nanos) - 1;
+        const int shift = std::min(msb - kSubBucketBits, kMaxShift - 1);
+        const uint64_t sub = std::min((nanos >> shift) - kSubBuckets, kSubBuckets - 1);
+        return static_cast<size_t>(kSubBuckets * static_cast<uint64_t>(shift + 1) + sub);
+    }
+
+    // Middle of a bucket's range, used when reporting percentiles
+    static double valueOf(size_t bucket) {
+        if (bucket < kSubBuckets) {
+            return static_cast<double>(bucket);
+        }
+        const auto shift = static_cast<int>(bucket / kSubBuckets) - 1;
+        const auto low = static_cast<double>((kSubBuckets + bucket % kSubBuckets) << shift);
+        return low + static_cast<double>(uint64_t{1} << shift) * 0.5;
+    }
+
+    void addNanos(uint64_t nanos, uint64_t times = 1) {
+        counts_[bucketFor(nanos)] += times;
+        total_ += times;
+    }
+
+    void addToBucket(size_t bucket, uint64_t times) {
+        counts_[bucket] += times;
+        total_ += times;
+    }
+
+    void merge(const LatencyHistogram& other) {
+        for (size_t i = 0; i < kNumBuckets; ++i) {
+            counts_[i] += other.counts_[i];
+        }
+        total_ += other.total_;
+    }
+
+    /**
+     * @brief Value below which the given fraction of samples fall (0 if empty)
+     * @param fraction 0.5 for the median, 0.99 for p99
+     */
+    double percentileNanos(double fraction) const {
+        if (total_ == 0) {
+            return 0.0;
+        }
+        const auto rank = static_cast<uint64_t>(std::clamp(fraction, 0.0, 1.0) *
+                                                static_cast<double>(total_ - 1));
+        uint64_t seen = 0;
+        for (size_t i = 0; i < kNumBuckets; ++i) {
+            seen += counts_[i];
+            if (seen > rank) {
+                return valueOf(i);
+            }
+        }
+        return valueOf(kNumBuckets - 1);
+    }
+
+    uint64_t getTotal() const {
+        return total_;
+    }
+
+    void clear() {
+        counts_.fill(0);
+        total_ = 0;
+    }
+
+  private:
+    std::array<uint64_t, kNumBuckets> counts_{};
+    uint64_t total_ = 0;
+};
+
+/**
+ * @brief Registered timing counters that any thread, the audio thread included, can record
+ *        into without locking or allocating
+ *
+ * A counter is registered once by name (MAGDA_MONITOR_SCOPE does this on first use) and
+ * then recorded by id. Each counter is split into per-thread shards of relaxed atomics, so
+ * threads don't contend and a record is a handful of uncontended atomic adds. Readers merge
+ * the shards into a Snapshot; PerformanceMonitor reports them alongside its own stats.
+ */
+class ProfilingCounters {
+  public:
+    using Id = int;
+    static constexpr Id kInvalidId = -1;
+    static constexpr int kMaxCounters = 64;
+    static constexpr size_t kShards = 4;  // Threads beyond this share shards
+
+    struct Snapshot {
+        uint64_t count = 0;
+        uint64_t sumNanos = 0;
+        uint64_t minNanos = 0;
+        uint64_t maxNanos = 0;
+        LatencyHistogram histogram;
+    };
+
+    static ProfilingCounters& getInstance() {
+        static ProfilingCounters instance;
+        return instance;
+    }
+
+    /**
+     * @brief Id for a counter name, registering it the first time (locks; not for RT use)
+     * @return kInvalidId if kMaxCounters are already registered
+     */
+    Id registerCounter(const std::string& name) {
+        std::lock_guard<std::mutex> lock(registrationMutex_);
+        const int count = numCounters_.load(std::memory_order_relaxed);
+        for (int i = 0; i < count; ++i) {
+            if (counters_[static_cast<size_t>(i)]->name == name) {
+                return i;
+            }
+        }
+        if (count >= kMaxCounters) {
+            return kInvalidId;
+        }
+
+        counters_[static_cast<size_t>(count)] = std::make_unique<Counter>(name);
+        numCounters_.store(count + 1, std::memory_order_release);
+        return count;
+    }
+
+    /**
+     * @brief Id of an already registered counter, or kInvalidId
+     */
+    Id findCounter(const std::string& name) const {
+        const int count = numCounters_.load(std::memory_order_acquire);
+        for (int i = 0; i < count; ++i) {
+            if (counters_[static_cast<size_t>(i)]->name == name) {
+                return i;
+            }
+        }
+        return kInvalidId;
+    }
+
+    /**
+     * @brief Record one duration (any thread, lock-free, no allocation)
+     */
+    void record(Id id, uint64_t nanos) {
+        if (id < 0 || !isEnabled()) {
+            return;
+        }
+
+        auto& shard = counters_[static_cast<size_t>(id)]->shards[currentShard()];
+        shard.count.fetch_add(1, std::memory_order_relaxed);
+        shard.sumNanos.fetch_add(nanos, std::memory_order_relaxed);
+        auto& bucket = shard.buckets[LatencyHistogram::bucketFor(nanos)];
+        bucket.fetch_add(1, std::memory_order_relaxed);
+
+        // One writer per shard in practice, so these rarely loop
+        auto max = shard.maxNanos.load(std::memory_order_relaxed);
+        while (nanos > max &&
+               !shard.maxNanos.compare_exchange_weak(max, nanos, std::memory_order_relaxed)) {
+        }
+        auto min = shard.minNanos.load(std::memory_order_relaxed);
+        while (nanos < min &&
+               !shard.minNanos.compare_exchange_weak(min, nanos, std::memory_order_relaxed)) {
+        }
+    }
+
+    /**
+     * @brief Merge a counter's shards (approximate while writers are active)
+     */
+    Snapshot snapshot(Id id) const {
+        Snapshot result;
+        if (id < 0 || id >= numCounters_.load(std::memory_order_acquire)) {
+            return result;
+        }
+
+        uint64_t min = std::numeric_limits<uint64_t>::max();
+        for (const auto& shard : counters_[static_cast<size_t>(id)]->shards) {
+            result.count += shard.count.load(std::memory_order_relaxed);
+            result.sumNanos += shard.sumNanos.load(std::memory_order_relaxed);
+            result.maxNanos =
+                std::max(result.maxNanos, shard.maxNanos.load(std::memory_order_relaxed));
+            min = std::min(min, shard.minNanos.load(std::memory_order_relaxed));
+            for (size_t i = 0; i < LatencyHistogram::kNumBuckets; ++i) {
+                if (auto n = shard.buckets[i].load(std::memory_order_relaxed)) {
+                    result.histogram.addToBucket(i, n);
+                }
+            }
+        }
+        result.minNanos = result.count > 0 ? min : 0;
+        return result;
+    }
+
+    int getNumCounters() const {
+        return numCounters_.load(std::memory_order_acquire);
+    }
+
+    std::string getName(Id id) const {
+        return id >= 0 && id < getNumCounters() ? counters_[static_cast<size_t>(id)]->name
+                                                : std::string();
+    }
+
+    void reset(Id id) {
+        if (id >= 0 && id < getNumCounters()) {
+            for (auto& shard : counters_[static_cast<size_t>(id)]->shards) {
+                shard.clear();
+            }
+        }
+    }
+
+    void resetAll() {
+        for (Id id = 0; id < getNumCounters(); ++id) {
+            reset(id);
+        }
+    }
+
+    void setEnabled(bool enabled) {
+        enabled_.store(enabled, std::memory_order_relaxed);
+    }
+
+    bool isEnabled() const {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+  private:
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> count{0};
+        std::atomic<uint64_t> sumNanos{0};
+        std::atomic<uint64_t> minNanos{std::numeric_limits<uint64_t>::max()};
+        std::atomic<uint64_t> maxNanos{0};
+        std::array<std::atomic<uint64_t>, LatencyHistogram::kNumBuckets> buckets{};
+
+        void clear() {
+            count.store(0, std::memory_order_relaxed);
+            sumNanos.store(0, std::memory_order_relaxed);
+            minNanos.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+            maxNanos.store(0, std::memory_order_relaxed);
+            for (auto& bucket : buckets) {
+                bucket.store(0, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    struct Counter {
+        explicit Counter(std::string counterName) : name(std::move(counterName)) {}
+        std::string name;
+        std::array<Shard, kShards> shards;
+    };
+
+    ProfilingCounters() = default;
+
+    size_t currentShard() {
+        thread_local const size_t shard =
+            nextShard_.fetch_add(1, std::memory_order_relaxed) % kShards;
+        return shard;
+    }
+
+    std::array<std::unique_ptr<Counter>, kMaxCounters> counters_;
+    std::atomic<int> numCounters_{0};
+    std::atomic<size_t> nextShard_{0};
+    std::atomic<bool> enabled_{false};
+    std::mutex registrationMutex_;
+};
+
+/**
+ * @brief The counter scopes open on one thread, readable from any other
+ *
+ * ScopedCounterTimer pushes its counter on entry and pops it on exit, so a watchdog can
+ * tell which scope a stuck thread is in. Wait-free. Scopes nested deeper than kMaxDepth
+ * are counted but not named. Another thread's read can be a scope behind, which is fine
+ * for asking where a thread has been stuck for half a second.
+ */
+class ActiveScopes {
+  public:
+    static constexpr int kMaxDepth = 32;
+
+    static ActiveScopes& forCurrentThread() {
+        thread_local ActiveScopes scopes;
+        return scopes;
+    }
+
+    void push(ProfilingCounters::Id id) {
+        const int depth = depth_.load(std::memory_order_relaxed);
+        if (depth < kMaxDepth) {
+            ids_[static_cast<size_t>(depth)].store(id, std::memory_order_relaxed);
+        }
+        depth_.store(depth + 1, std::memory_order_release);
+    }
+
+    void pop() {
+        const int depth = depth_.load(std::memory_order_relaxed);
+        if (depth > 0) {
+            depth_.store(depth - 1, std::memory_order_release);
+        }
+    }
+
+    /**
+     * @brief The open scopes, outermost first
+     */
+    std::vector<ProfilingCounters::Id> snapshot() const {
+        const int depth = std::min(depth_.load(std::memory_order_acquire), kMaxDepth);
+        std::vector<ProfilingCounters::Id> ids;
+        ids.reserve(static_cast<size_t>(depth));
+        for (int i = 0; i < depth; ++i) {
+            ids.push_back(ids_[static_cast<size_t>(i)].load(std::memory_order_relaxed));
+        }
+        return ids;
+    }
+
+  private:
+    std::array<std::atomic<ProfilingCounters::Id>, kMaxDepth> ids_{};
+    std::atomic<int> depth_{0};
+};
+
+/**
+ * @brief RAII timer that records its scope's duration into a registered counter
+ *
+ * The counter is also this thread's active scope (see ActiveScopes) until it closes.
+ */
+class ScopedCounterTimer {
+  public:
+    explicit ScopedCounterTimer(ProfilingCounters::Id id)
+        : id_(id), start_(std::chrono::steady_clock::now()) {
+        ActiveScopes::forCurrentThread().push(id_);
+    }
+
+    ~ScopedCounterTimer() {
+        ActiveScopes::forCurrentThread().pop();
+        const auto elapsed = std::chrono::steady_clock::now() - start_;
+        ProfilingCounters::getInstance().record(
+            id_, static_cast<uint64_t>(
+                     std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+    }
+
+    ScopedCounterTimer(const ScopedCounterTimer&) = delete;
+    ScopedCounterTimer& operator=(const ScopedCounterTimer&) = delete;
+
+  protected:
+    ProfilingCounters::Id getId() const {
+        return id_;
+    }
+
+    std::chrono::steady_clock::time_point getStart() const {
+        return start_;
+    }
+
+  private:
+    ProfilingCounters::Id id_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+}  // namespace magda
@@ -0,0 +1,228 @@
+#include "RealtimeSafety.hpp"
+
+#if defined(MAGDA_REALTIME_CHECKS)
+
+#include <juce_core/juce_core.h>
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <mutex>
+#include <new>
+#include <string>
+#include <unordered_set>
+
+#if MAGDA_HAS_RTSAN
+// RealtimeSanitizer's runtime interface
+extern "C" {
+void __rtsan_realtime_enter();
+void __rtsan_realtime_exit();
+void __rtsan_disable();
+void __rtsan_enable();
+}
+#elif defined(__linux__)
+#include <dlfcn.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+namespace magda {
+
+namespace {
+
+thread_local int contextDepth = 0;
+thread_local int suspendDepth = 0;
+
+std::atomic<int> violationCount{0};
+std::atomic<bool> haltOnViolation{std::getenv("MAGDA_REALTIME_HALT") != nullptr &&
+                                  std::atoi(std::getenv("MAGDA_REALTIME_HALT")) != 0};
+
+}  // namespace
+
+void RealtimeSafety::enterContext() {
+    ++contextDepth;
+#if MAGDA_HAS_RTSAN
+    __rtsan_realtime_enter();
+#endif
+}
+
+void RealtimeSafety::exitContext() {
+#if MAGDA_HAS_RTSAN
+    __rtsan_realtime_exit();
+#endif
+    --contextDepth;
+}
+
+void RealtimeSafety::suspend() {
+    ++suspendDepth;
+#if MAGDA_HAS_RTSAN
+    __rtsan_disable();
+#endif
+}
+
+void RealtimeSafety::resume() {
+#if MAGDA_HAS_RTSAN
+    __rtsan_enable();
+#endif
+    --suspendDepth;
+}
+
+bool RealtimeSafety::isRealtimeContext() {
+    return contextDepth > 0 && suspendDepth == 0;
+}
+
+void RealtimeSafety::reportViolation(const char* what) {
+    if (!isRealtimeContext()) {
+        return;
+    }
+
+    // Reporting allocates and locks; none of that is the audio code's doing
+    ScopedRealtimeSuspension suspension;
+    violationCount.fetch_add(1, std::memory_order_relaxed);
+
+    const auto trace = juce::SystemStats::getStackBacktrace();
+    const bool halt = haltOnViolation.load(std::memory_order_relaxed);
+    {
+        static std::mutex seenLock;
+        static std::unordered_set<size_t> seen;
+        std::lock_guard<std::mutex> lock(seenLock);
+        if (!seen.insert(std::hash<std::string>{}(trace.toStdString())).second && !halt) {
+            return;
+        }
+    }
+
+    std::fprintf(stderr, "[RealtimeSafety] %s in a real-time context\n%s\n", what,
+                 trace.toRawUTF8());
+    std::fflush(stderr);
+    if (halt) {
+        std::abort();
+    }
+}
+
+int RealtimeSafety::getViolationCount() {
+    return violationCount.load(std::memory_order_relaxed);
+}
+
+void RealtimeSafety::setHaltOnViolation(bool halt) {
+    haltOnViolation.store(halt, std::memory_order_relaxed);
+}
+
+}  // namespace magda
+
+#if !MAGDA_HAS_RTSAN
+
+// =============================================================================
+// Built-in hooks (RealtimeSanitizer intercepts all of these itself)
+// =============================================================================
+
+void* operator new(std::size_t size) {
+    magda::RealtimeSafety::reportViolation("operator new");
+    if (void* memory = std::malloc(size > 0 ? size : 1)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    magda::RealtimeSafety::reportViolation("operator new[]");
+    if (void* memory = std::malloc(size > 0 ? size : 1)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    magda::RealtimeSafety::reportViolation("operator new");
+    return std::malloc(size > 0 ? size : 1);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    magda::RealtimeSafety::reportViolation("operator new[]");
+    return std::malloc(size > 0 ? size : 1);
+}
+
+void operator delete(void* memory) noexcept {
+    if (memory != nullptr) {
+        magda::RealtimeSafety::reportViolation("operator delete");
+    }
+    std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept {
+    if (memory != nullptr) {
+        magda::RealtimeSafety::reportViolation("operator delete[]");
+    }
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    ::operator delete(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept {
+    ::operator delete[](memory);
+}
+
+void operator delete(void* memory, const std::nothrow_t&) noexcept {
+    ::operator delete(memory);
+}
+
+void operator delete[](void* memory, const std::nothrow_t&) noexcept {
+    ::operator delete[](memory);
+}
+
+#if defined(__linux__)
+
+// Definitions in the executable take precedence over libc's; each forwards to the next one
+namespace {
+
+template <typename Function> Function nextDefinition(const char* name) {
+    return reinterpret_cast<Function>(dlsym(RTLD_NEXT, name));
+}
+
+}  // namespace
+
+extern "C" {
+
+int pthread_mutex_lock(pthread_mutex_t* mutex) {
+    static const auto next = nextDefinition<int (*)(pthread_mutex_t*)>("pthread_mutex_lock");
+    magda::RealtimeSafety::reportViolation("pthread_mutex_lock");
+    return next(mutex);
+}
+
+int pthread_rwlock_rdlock(pthread_rwlock_t* lock) {
+    static const auto next =
+        nextDefinition<int (*)(pthread_rwlock_t*)>("pthread_rwlock_rdlock");
+    magda::RealtimeSafety::reportViolation("pthread_rwlock_rdlock");
+    return next(lock);
+}
+
+int pthread_rwlock_wrlock(pthread_rwlock_t* lock) {
+    static const auto next =
+        nextDefinition<int (*)(pthread_rwlock_t*)>("pthread_rwlock_wrlock");
+    magda::RealtimeSafety::reportViolation("pthread_rwlock_wrlock");
+    return next(lock);
+}
+
+int nanosleep(const struct timespec* duration, struct timespec* remaining) {
+    static const auto next =
+        nextDefinition<int (*)(const struct timespec*, struct timespec*)>("nanosleep");
+    magda::RealtimeSafety::reportViolation("nanosleep");
+    return next(duration, remaining);
+}
+
+int usleep(useconds_t microseconds) {
+    static const auto next = nextDefinition<int (*)(useconds_t)>("usleep");
+    magda::RealtimeSafety::reportViolation("usleep");
+    return next(microseconds);
+}
+
+}  // extern "C"
+
+#endif  // __linux__
+
+#endif  // !MAGDA_HAS_RTSAN
+
+#endif  // MAGDA_REALTIME_CHECKS
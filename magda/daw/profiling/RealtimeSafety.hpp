@@ -0,0 +1,119 @@
+#pragma once
+
+// RealtimeSanitizer (clang -fsanitize=realtime) is on when the build enables it
+#if defined(__has_feature)
+#if __has_feature(realtime_sanitizer)
+#define MAGDA_HAS_RTSAN 1
+#endif
+#endif
+#ifndef MAGDA_HAS_RTSAN
+#define MAGDA_HAS_RTSAN 0
+#endif
+
+namespace magda {
+
+/**
+ * @brief Flags allocation, locking and blocking calls made on the audio thread
+ *
+ * Off unless the build defines MAGDA_REALTIME_CHECKS (cmake -DMAGDA_REALTIME_SANITIZER=ON);
+ * otherwise everything here is an empty inline. Code between a ScopedRealtimeContext's
+ * construction and destruction - the audio callback and MAGDA's plugins - is a real-time
+ * context, and anything in it that can wait on another thread or the OS is reported to
+ * stderr with a stack trace:
+ * - With RealtimeSanitizer (Clang 20+), the contexts enter its real-time state, and it
+ *   intercepts malloc and free, pthread locks and blocking system calls itself.
+ * - Otherwise the built-in hooks replace operator new and delete and, on Linux, interpose
+ *   pthread_mutex_lock, the pthread rwlocks, nanosleep and usleep. Each distinct stack
+ *   trace is reported once.
+ *
+ * Set MAGDA_REALTIME_HALT=1 to abort on the first report, for CI. RealtimeSanitizer halts by
+ * default; RTSAN_OPTIONS=halt_on_error=false lets it carry on.
+ */
+class RealtimeSafety {
+  public:
+    enum class Mode { Off, BuiltIn, Sanitizer };
+
+    static constexpr Mode getMode() {
+#if !defined(MAGDA_REALTIME_CHECKS)
+        return Mode::Off;
+#elif MAGDA_HAS_RTSAN
+        return Mode::Sanitizer;
+#else
+        return Mode::BuiltIn;
+#endif
+    }
+
+#if defined(MAGDA_REALTIME_CHECKS)
+    static void enterContext();
+    static void exitContext();
+    static void suspend();
+    static void resume();
+
+    /**
+     * @brief True inside a context and outside any suspension, on this thread
+     */
+    static bool isRealtimeContext();
+
+    /**
+     * @brief Report a call that isn't real-time safe, if this thread is in a context
+     * @param what The call, e.g. "operator new"
+     */
+    static void reportViolation(const char* what);
+
+    /**
+     * @brief Violations reported by the built-in hooks, repeats included
+     */
+    static int getViolationCount();
+
+    static void setHaltOnViolation(bool halt);
+#else
+    static void enterContext() {}
+    static void exitContext() {}
+    static void suspend() {}
+    static void resume() {}
+    static bool isRealtimeContext() {
+        return false;
+    }
+    static void reportViolation(const char*) {}
+    static int getViolationCount() {
+        return 0;
+    }
+    static void setHaltOnViolation(bool) {}
+#endif
+};
+
+/**
+ * @brief Marks the current scope as real-time (contexts nest)
+ */
+class ScopedRealtimeContext {
+  public:
+    ScopedRealtimeContext() {
+        RealtimeSafety::enterContext();
+    }
+    ~ScopedRealtimeContext() {
+        RealtimeSafety::exitContext();
+    }
+
+    ScopedRealtimeContext(const ScopedRealtimeContext&) = delete;
+    ScopedRealtimeContext& operator=(const ScopedRealtimeContext&) = delete;
+};
+
+/**
+ * @brief Lifts the checks inside a real-time context, for a call known to be acceptable
+ *
+ * Each use is an exception someone has decided to live with; say why next to it.
+ */
+class ScopedRealtimeSuspension {
+  public:
+    ScopedRealtimeSuspension() {
+        RealtimeSafety::suspend();
+    }
+    ~ScopedRealtimeSuspension() {
+        RealtimeSafety::resume();
+    }
+
+    ScopedRealtimeSuspension(const ScopedRealtimeSuspension&) = delete;
+    ScopedRealtimeSuspension& operator=(const ScopedRealtimeSuspension&) = delete;
+};
+
+}  // namespace magda
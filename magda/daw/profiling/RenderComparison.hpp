@@ -0,0 +1,76 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace magda {
+
+/**
+ * @brief How a render differs from its golden copy
+ *
+ * Renders of MAGDA's own devices are deterministic and are held to the bit: any
+ * optimisation of the render path (parallel racks, SIMD mixing, silence suspension,
+ * stretch caching) that changes a single sample fails. External plugins may legitimately
+ * vary between runs or builds (denormal handling, internal oversampling, random seeds),
+ * so those renders pass within a tolerance on the largest sample difference.
+ *
+ * Samples are compared by their bits, so a render that flips 0.0 to -0.0 isn't bit-exact
+ * even though it measures no difference.
+ */
+struct RenderComparison {
+    bool sameShape = false;  // Same channel count and length
+    bool bitExact = false;
+    float maxAbsDiff = 0.0f;
+    juce::int64 firstDifference = -1;  // Sample index, -1 when bit-exact
+
+    double getMaxDiffDb() const {
+        return juce::Decibels::gainToDecibels(static_cast<double>(maxAbsDiff), -200.0);
+    }
+
+    bool passes(bool requireBitExact, double toleranceDb) const {
+        if (!sameShape) {
+            return false;
+        }
+        return requireBitExact ? bitExact : getMaxDiffDb() <= toleranceDb;
+    }
+
+    static RenderComparison compare(const juce::AudioBuffer<float>& golden,
+                                    const juce::AudioBuffer<float>& rendered) {
+        RenderComparison result;
+        result.sameShape = golden.getNumChannels() == rendered.getNumChannels() &&
+                           golden.getNumSamples() == rendered.getNumSamples();
+        if (!result.sameShape) {
+            return result;
+        }
+
+        result.bitExact = true;
+        const int numSamples = golden.getNumSamples();
+        for (int ch = 0; ch < golden.getNumChannels(); ++ch) {
+            const float* a = golden.getReadPointer(ch);
+            const float* b = rendered.getReadPointer(ch);
+            if (std::memcmp(a, b, sizeof(float) * static_cast<size_t>(numSamples)) == 0) {
+                continue;
+            }
+
+            result.bitExact = false;
+            for (int i = 0; i < numSamples; ++i) {
+                if (std::memcmp(a + i, b + i, sizeof(float)) != 0) {
+                    if (result.firstDifference < 0 || i < result.firstDifference) {
+                        result.firstDifference = i;
+                    }
+                    const float diff = std::abs(a[i] - b[i]);
+                    // NaN on either side is as different as it gets
+                    result.maxAbsDiff = std::isnan(diff) ? std::numeric_limits<float>::max()
+                                                         : std::max(result.maxAbsDiff, diff);
+                }
+            }
+        }
+        return result;
+    }
+};
+
+}  // namespace magda
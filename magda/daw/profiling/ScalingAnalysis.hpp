@@ -0,0 +1,230 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace magda {
+
+/**
+ * @brief How a metric grows with project size, checked against the complexity it should have
+ *
+ * A scalability run measures each metric (sync time, memory, selection...) on projects of
+ * increasing size. The growth exponent is the least-squares slope of log(value) against
+ * log(size): 1 for linear, 2 for quadratic. The target class is fitted the same way over
+ * the same sizes, so n log n is held to its own effective exponent on that range (a little
+ * over 1) rather than to a fixed number, and a metric passes while its exponent stays
+ * within the slack of its target's. Small enough slack catches a quadratic path hiding
+ * behind a linear one long before the sizes users hit.
+ *
+ * Values below the floor are raised to it before fitting, so a metric that is near zero at
+ * every size reads as constant instead of as timer noise.
+ *
+ * JSON layout:
+ *   { "schema": 1, "slack": 0.3,
+ *     "metrics": { "sync.full": { "target": "linear", "exponent": 1.04, "allowed": 1.3,
+ *                                 "pass": true, "points": [[125, 3.2], [250, 6.1], ...] } } }
+ */
+class ScalingAnalysis {
+  public:
+    static constexpr int kSchemaVersion = 1;
+
+    enum class Complexity { Constant, Logarithmic, Linear, Linearithmic, Quadratic };
+
+    struct Point {
+        double size = 0.0;
+        double value = 0.0;
+    };
+
+    struct Verdict {
+        juce::String metric;
+        Complexity target = Complexity::Linear;
+        double exponent = 0.0;  // Measured
+        double allowed = 0.0;   // The target's exponent over the same sizes, plus the slack
+        bool pass = true;
+    };
+
+    explicit ScalingAnalysis(double slack = 0.3, double floor = 1.0e-3)
+        : slack_(slack), floor_(floor) {}
+
+    // =========================================================================
+    // Recording
+    // =========================================================================
+
+    void setTarget(const juce::String& metric, Complexity target) {
+        metrics_[metric].target = target;
+    }
+
+    void addPoint(const juce::String& metric, double size, double value) {
+        metrics_[metric].points.push_back({size, value});
+    }
+
+    std::vector<juce::String> getMetricNames() const {
+        std::vector<juce::String> names;
+        for (const auto& [name, metric] : metrics_) {
+            names.push_back(name);
+        }
+        return names;
+    }
+
+    // =========================================================================
+    // Analysis
+    // =========================================================================
+
+    /**
+     * @brief Least-squares slope of log(value) against log(size); 0 with fewer than two sizes
+     */
+    static double fitExponent(const std::vector<Point>& points, double floor = 1.0e-3) {
+        std::vector<std::pair<double, double>> logs;
+        for (const auto& p : points) {
+            if (p.size > 0.0) {
+                logs.emplace_back(std::log(p.size), std::log(std::max(p.value, floor)));
+            }
+        }
+        if (logs.size() < 2) {
+            return 0.0;
+        }
+
+        double meanX = 0.0, meanY = 0.0;
+        for (const auto& [x, y] : logs) {
+            meanX += x;
+            meanY += y;
+        }
+        meanX /= double(logs.size());
+        meanY /= double(logs.size());
+
+        double covariance = 0.0, variance = 0.0;
+        for (const auto& [x, y] : logs) {
+            covariance += (x - meanX) * (y - meanY);
+            variance += (x - meanX) * (x - meanX);
+        }
+        return variance > 0.0 ? covariance / variance : 0.0;
+    }
+
+    /**
+     * @brief The exponent a metric of exactly this complexity would show over these sizes
+     */
+    static double getTargetExponent(Complexity target, const std::vector<Point>& points) {
+        std::vector<Point> ideal;
+        for (const auto& p : points) {
+            ideal.push_back({p.size, evaluate(target, p.size)});
+        }
+        return fitExponent(ideal, 0.0);
+    }
+
+    static double evaluate(Complexity target, double n) {
+        // Offset so log n stays positive down to a size of one
+        const double logN = std::log(n + 1.0) + 1.0;
+        switch (target) {
+            case Complexity::Constant:
+                return 1.0;
+            case Complexity::Logarithmic:
+                return logN;
+            case Complexity::Linear:
+                return n;
+            case Complexity::Linearithmic:
+                return n * logN;
+            case Complexity::Quadratic:
+                return n * n;
+        }
+        return n;
+    }
+
+    static const char* getComplexityName(Complexity target) {
+        switch (target) {
+            case Complexity::Constant:
+                return "constant";
+            case Complexity::Logarithmic:
+                return "logarithmic";
+            case Complexity::Linear:
+                return "linear";
+            case Complexity::Linearithmic:
+                return "linearithmic";
+            case Complexity::Quadratic:
+                return "quadratic";
+        }
+        return "linear";
+    }
+
+    Verdict getVerdict(const juce::String& metric) const {
+        Verdict verdict;
+        verdict.metric = metric;
+        const auto it = metrics_.find(metric);
+        if (it == metrics_.end()) {
+            return verdict;
+        }
+
+        const auto& m = it->second;
+        verdict.target = m.target;
+        verdict.exponent = fitExponent(m.points, floor_);
+        verdict.allowed = getTargetExponent(m.target, m.points) + slack_;
+        verdict.pass = verdict.exponent <= verdict.allowed;
+        return verdict;
+    }
+
+    std::vector<Verdict> getVerdicts() const {
+        std::vector<Verdict> verdicts;
+        for (const auto& [name, metric] : metrics_) {
+            verdicts.push_back(getVerdict(name));
+        }
+        return verdicts;
+    }
+
+    std::vector<Verdict> getFailures() const {
+        auto verdicts = getVerdicts();
+        verdicts.erase(std::remove_if(verdicts.begin(), verdicts.end(),
+                                      [](const Verdict& v) { return v.pass; }),
+                       verdicts.end());
+        return verdicts;
+    }
+
+    // =========================================================================
+    // JSON
+    // =========================================================================
+
+    juce::var toVar() const {
+        auto* root = new juce::DynamicObject();
+        root->setProperty("schema", kSchemaVersion);
+        root->setProperty("timestamp", juce::Time::getCurrentTime().toISO8601(true));
+        root->setProperty("slack", slack_);
+
+        auto* metrics = new juce::DynamicObject();
+        for (const auto& [name, metric] : metrics_) {
+            const auto verdict = getVerdict(name);
+            auto* entry = new juce::DynamicObject();
+            entry->setProperty("target", getComplexityName(verdict.target));
+            entry->setProperty("exponent", verdict.exponent);
+            entry->setProperty("allowed", verdict.allowed);
+            entry->setProperty("pass", verdict.pass);
+
+            juce::Array<juce::var> points;
+            for (const auto& p : metric.points) {
+                points.add(juce::Array<juce::var>{p.size, p.value});
+            }
+            entry->setProperty("points", points);
+            metrics->setProperty(name, juce::var(entry));
+        }
+        root->setProperty("metrics", juce::var(metrics));
+        return juce::var(root);
+    }
+
+    juce::String toJSON() const {
+        return juce::JSON::toString(toVar());
+    }
+
+  private:
+    struct Metric {
+        Complexity target = Complexity::Linear;
+        std::vector<Point> points;
+    };
+
+    double slack_;
+    double floor_;
+    std::map<juce::String, Metric> metrics_;
+};
+
+}  // namespace magda
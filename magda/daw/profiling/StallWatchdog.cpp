@@ -0,0 +1,258 @@
+#include "StallWatchdog.hpp"
+
+#include <juce_events/juce_events.h>
+
+#include <iostream>
+
+#if JUCE_LINUX || JUCE_MAC
+#include <execinfo.h>
+#include <pthread.h>
+#include <signal.h>
+#define MAGDA_STALL_STACKS 1
+#else
+#define MAGDA_STALL_STACKS 0
+#endif
+
+namespace magda {
+
+// =============================================================================
+// Stack capture
+// =============================================================================
+
+namespace {
+
+#if MAGDA_STALL_STACKS
+// The message thread takes its own backtrace in a signal handler; backtrace() only reads
+// the stack once it has been called before (the first call may load the unwinder)
+constexpr int kCaptureSignal = SIGUSR2;
+constexpr int kMaxFrames = 64;
+constexpr int kHandlerFrames = 2;  // The handler and the signal trampoline
+
+void* capturedFrames[kMaxFrames];
+std::atomic<int> capturedCount{-1};
+pthread_t watchedThread;
+struct sigaction previousAction;
+
+void handleCaptureSignal(int) {
+    capturedCount.store(backtrace(capturedFrames, kMaxFrames), std::memory_order_release);
+}
+
+void installStackCapture() {
+    void* warmUp[1];
+    (void)backtrace(warmUp, 1);
+
+    watchedThread = pthread_self();
+    struct sigaction action {};
+    action.sa_handler = handleCaptureSignal;
+    action.sa_flags = SA_RESTART;  // Whatever the thread is blocked in carries on
+    sigemptyset(&action.sa_mask);
+    sigaction(kCaptureSignal, &action, &previousAction);
+}
+
+void removeStackCapture() {
+    sigaction(kCaptureSignal, &previousAction, nullptr);
+}
+
+juce::String captureWatchedStack() {
+    capturedCount.store(-1, std::memory_order_relaxed);
+    if (pthread_kill(watchedThread, kCaptureSignal) != 0) {
+        return {};
+    }
+    for (int waited = 0; waited < 100 && capturedCount.load(std::memory_order_acquire) < 0;
+         ++waited) {
+        juce::Thread::sleep(1);
+    }
+
+    const int count = capturedCount.load(std::memory_order_acquire);
+    if (count <= kHandlerFrames) {
+        return {};
+    }
+
+    juce::String stack;
+    if (char** symbols = backtrace_symbols(capturedFrames, count)) {
+        for (int i = kHandlerFrames; i < count; ++i) {
+            stack << "    " << symbols[i] << "\n";
+        }
+        free(symbols);
+    }
+    return stack;
+}
+#else
+void installStackCapture() {}
+void removeStackCapture() {}
+juce::String captureWatchedStack() {
+    return {};
+}
+#endif
+
+juce::String timestamp(const juce::Time& time) {
+    return time.formatted("%Y-%m-%d %H:%M:%S.") +
+           juce::String(time.getMilliseconds()).paddedLeft('0', 3);
+}
+
+}  // namespace
+
+// =============================================================================
+// Heartbeat and watchdog thread
+// =============================================================================
+
+class StallWatchdog::Heartbeat : private juce::Timer {
+  public:
+    explicit Heartbeat(StallDetector& detector) : detector_(detector) {
+        detector_.beat(juce::Time::getMillisecondCounterHiRes());
+        startTimer(kHeartbeatMs);
+    }
+
+    ~Heartbeat() override {
+        stopTimer();
+    }
+
+  private:
+    void timerCallback() override {
+        detector_.beat(juce::Time::getMillisecondCounterHiRes());
+    }
+
+    StallDetector& detector_;
+};
+
+class StallWatchdog::WatchThread : public juce::Thread {
+  public:
+    WatchThread(StallWatchdog& owner, StallDetector& detector)
+        : juce::Thread("Stall Watchdog"), owner_(owner), detector_(detector) {}
+
+    ~WatchThread() override {
+        stopThread(1000);
+    }
+
+  private:
+    void run() override {
+        while (!threadShouldExit()) {
+            wait(kHeartbeatMs);
+            switch (detector_.poll(juce::Time::getMillisecondCounterHiRes())) {
+                case StallDetector::Event::Started:
+                    owner_.handleStallStarted();
+                    break;
+                case StallDetector::Event::Ended:
+                    owner_.handleStallEnded(detector_.getLastStallMs());
+                    break;
+                case StallDetector::Event::None:
+                    break;
+            }
+        }
+    }
+
+    StallWatchdog& owner_;
+    StallDetector& detector_;
+};
+
+// =============================================================================
+// StallWatchdog
+// =============================================================================
+
+StallWatchdog::StallWatchdog() : logFile_(getDefaultLogFile()) {}
+
+StallWatchdog::~StallWatchdog() {
+    stop();
+}
+
+StallWatchdog& StallWatchdog::getInstance() {
+    static StallWatchdog instance;
+    return instance;
+}
+
+juce::File StallWatchdog::getDefaultLogFile() {
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+        .getChildFile("MAGDA")
+        .getChildFile("Logs")
+        .getChildFile("stalls.log");
+}
+
+void StallWatchdog::start(double thresholdMs) {
+    if (isRunning()) {
+        return;
+    }
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    messageThreadScopes_ = &ActiveScopes::forCurrentThread();
+    installStackCapture();
+    detector_ = std::make_unique<StallDetector>(thresholdMs, static_cast<double>(kHeartbeatMs));
+    heartbeat_ = std::make_unique<Heartbeat>(*detector_);
+    thread_ = std::make_unique<WatchThread>(*this, *detector_);
+    thread_->startThread(juce::Thread::Priority::low);
+}
+
+void StallWatchdog::stop() {
+    if (!isRunning()) {
+        return;
+    }
+
+    thread_.reset();
+    heartbeat_.reset();
+    detector_.reset();
+    removeStackCapture();
+    messageThreadScopes_ = nullptr;
+}
+
+std::vector<StallWatchdog::Stall> StallWatchdog::getRecentStalls() const {
+    const juce::ScopedLock lock(lock_);
+    return recentStalls_;
+}
+
+void StallWatchdog::resetStats() {
+    const juce::ScopedLock lock(lock_);
+    recentStalls_.clear();
+    stallCount_.store(0, std::memory_order_relaxed);
+    longestStallMs_.store(0.0, std::memory_order_relaxed);
+}
+
+void StallWatchdog::handleStallStarted() {
+    Stall stall;
+    stall.time = juce::Time::getCurrentTime();
+    stall.stack = captureWatchedStack();
+    auto& counters = ProfilingCounters::getInstance();
+    for (const auto id : messageThreadScopes_->snapshot()) {
+        const auto name = counters.getName(id);
+        stall.scopes.add(name.empty() ? juce::String("(unregistered)") : juce::String(name));
+    }
+
+    juce::String text;
+    text << "[" << timestamp(stall.time) << "] Message thread stalled for over "
+         << juce::roundToInt(detector_->getThresholdMs()) << " ms\n";
+    text << "  Scopes: "
+         << (stall.scopes.isEmpty() ? juce::String("(none)") : stall.scopes.joinIntoString(" > "))
+         << "\n";
+    if (stall.stack.isNotEmpty()) {
+        text << "  Stack:\n" << stall.stack;
+    }
+    log(text);
+
+    stallCount_.fetch_add(1, std::memory_order_relaxed);
+    const juce::ScopedLock lock(lock_);
+    recentStalls_.push_back(std::move(stall));
+    if (recentStalls_.size() > kMaxRecentStalls) {
+        recentStalls_.erase(recentStalls_.begin());
+    }
+}
+
+void StallWatchdog::handleStallEnded(double durationMs) {
+    log("[" + timestamp(juce::Time::getCurrentTime()) + "] Message thread recovered after " +
+        juce::String(juce::roundToInt(durationMs)) + " ms\n");
+
+    if (durationMs > longestStallMs_.load(std::memory_order_relaxed)) {
+        longestStallMs_.store(durationMs, std::memory_order_relaxed);
+    }
+    const juce::ScopedLock lock(lock_);
+    if (!recentStalls_.empty()) {
+        recentStalls_.back().durationMs = durationMs;
+    }
+}
+
+void StallWatchdog::log(const juce::String& text) const {
+    std::cerr << "[StallWatchdog] " << text << std::flush;
+    if (logFile_ != juce::File()) {
+        (void)logFile_.getParentDirectory().createDirectory();
+        (void)logFile_.appendText(text);
+    }
+}
+
+}  // namespace magda
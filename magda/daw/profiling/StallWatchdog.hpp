@@ -0,0 +1,185 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "ProfilingCounters.hpp"
+
+namespace magda {
+
+/**
+ * @brief Turns heartbeats into stall start and end events
+ *
+ * A stall starts once no beat has come for the threshold past the expected interval, and
+ * ends with the next beat; its length is that beat's gap less the interval. Times are in
+ * milliseconds on any one clock. beat() is called on the watched thread and poll() on the
+ * watching one.
+ */
+class StallDetector {
+  public:
+    enum class Event { None, Started, Ended };
+
+    StallDetector(double thresholdMs, double intervalMs)
+        : thresholdMs_(thresholdMs), intervalMs_(intervalMs) {}
+
+    void beat(double nowMs) {
+        if (beats_.load(std::memory_order_relaxed) > 0) {
+            const double gap = nowMs - lastBeatMs_.load(std::memory_order_relaxed);
+            if (gap > maxGapMs_.load(std::memory_order_relaxed)) {
+                maxGapMs_.store(gap, std::memory_order_relaxed);
+            }
+        }
+        lastBeatMs_.store(nowMs, std::memory_order_relaxed);
+        beats_.fetch_add(1, std::memory_order_release);
+    }
+
+    Event poll(double nowMs) {
+        const auto beats = beats_.load(std::memory_order_acquire);
+        if (beats == 0) {
+            return Event::None;  // Not started yet
+        }
+
+        if (!stalled_) {
+            maxGapMs_.store(0.0, std::memory_order_relaxed);
+            if (nowMs - lastBeatMs_.load(std::memory_order_relaxed) <
+                thresholdMs_ + intervalMs_) {
+                return Event::None;
+            }
+            stalled_ = true;
+            beatsAtStall_ = beats;
+            return Event::Started;
+        }
+
+        if (beats == beatsAtStall_) {
+            return Event::None;
+        }
+        stalled_ = false;
+        lastStallMs_ = std::max(0.0, maxGapMs_.exchange(0.0, std::memory_order_relaxed) -
+                                         intervalMs_);
+        return Event::Ended;
+    }
+
+    bool isStalled() const {
+        return stalled_;
+    }
+
+    /**
+     * @brief The length of the stall that last Ended
+     */
+    double getLastStallMs() const {
+        return lastStallMs_;
+    }
+
+    double getThresholdMs() const {
+        return thresholdMs_;
+    }
+
+  private:
+    const double thresholdMs_;
+    const double intervalMs_;
+
+    // Written by beat()
+    std::atomic<double> lastBeatMs_{0.0};
+    std::atomic<double> maxGapMs_{0.0};  // Longest gap since the poller last cleared it
+    std::atomic<uint64_t> beats_{0};
+
+    // poll() only
+    bool stalled_ = false;
+    uint64_t beatsAtStall_ = 0;
+    double lastStallMs_ = 0.0;
+};
+
+/**
+ * @brief Watches the message loop for stalls and records where it was stuck
+ *
+ * A heartbeat timer on the message thread beats a StallDetector every kHeartbeatMs, and a
+ * watchdog thread polls it. Once the loop has been stuck for the threshold, the watchdog
+ * captures the message thread's stack (on Linux and macOS a signal makes the thread take
+ * its own backtrace) and its open profiling scopes (ActiveScopes), and logs them with a
+ * timestamp to stderr and the log file; the stall's full length is logged when the loop
+ * recovers. A hang that never recovers is still in the log. Counts go to BenchmarkResults.
+ *
+ * start(), stop() and setLogFile() on the message thread; the results from any thread.
+ */
+class StallWatchdog {
+  public:
+    struct Stall {
+        juce::Time time;           // When it was detected
+        double durationMs = 0.0;   // 0 while it lasts
+        juce::StringArray scopes;  // Open profiling scopes, outermost first
+        juce::String stack;        // Message thread backtrace (empty where unsupported)
+    };
+
+    static constexpr double kDefaultThresholdMs = 500.0;
+    static constexpr int kHeartbeatMs = 50;
+    static constexpr size_t kMaxRecentStalls = 16;
+
+    static StallWatchdog& getInstance();
+
+    /**
+     * @brief Start watching (stop it before JUCE shuts down)
+     */
+    void start(double thresholdMs = kDefaultThresholdMs);
+    void stop();
+
+    bool isRunning() const {
+        return detector_ != nullptr;
+    }
+
+    /**
+     * @brief Where stalls are appended (default: getDefaultLogFile(); none for stderr only)
+     */
+    void setLogFile(const juce::File& file) {
+        logFile_ = file;
+    }
+
+    /**
+     * @brief Logs/stalls.log in the MAGDA application data folder
+     */
+    static juce::File getDefaultLogFile();
+
+    int getStallCount() const {
+        return stallCount_.load(std::memory_order_relaxed);
+    }
+
+    double getLongestStallMs() const {
+        return longestStallMs_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief The last kMaxRecentStalls stalls, oldest first
+     */
+    std::vector<Stall> getRecentStalls() const;
+
+    void resetStats();
+
+  private:
+    StallWatchdog();
+    ~StallWatchdog();
+
+    class Heartbeat;
+    class WatchThread;
+
+    // Watchdog thread
+    void handleStallStarted();
+    void handleStallEnded(double durationMs);
+    void log(const juce::String& text) const;
+
+    std::unique_ptr<StallDetector> detector_;
+    std::unique_ptr<Heartbeat> heartbeat_;
+    std::unique_ptr<WatchThread> thread_;
+    ActiveScopes* messageThreadScopes_ = nullptr;
+    juce::File logFile_;
+
+    mutable juce::CriticalSection lock_;
+    std::vector<Stall> recentStalls_;  // Guarded by lock_
+    std::atomic<int> stallCount_{0};
+    std::atomic<double> longestStallMs_{0.0};
+};
+
+}  // namespace magda
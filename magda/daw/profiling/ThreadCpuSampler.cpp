@@ -0,0 +1,169 @@
+#include "ThreadCpuSampler.hpp"
+
+#include <algorithm>
+#include <map>
+
+#if JUCE_LINUX
+#include <unistd.h>
+#elif JUCE_MAC
+#include <mach/mach.h>
+#elif JUCE_WINDOWS
+#include <windows.h>
+#include <tlhelp32.h>
+#endif
+
+namespace magda {
+
+// =============================================================================
+// Sampling
+// =============================================================================
+
+#if JUCE_LINUX
+
+std::vector<ThreadCpuSampler::ThreadTime> ThreadCpuSampler::sample() {
+    std::vector<ThreadTime> threads;
+    const double ticksPerSecond = static_cast<double>(sysconf(_SC_CLK_TCK));
+
+    for (const auto& entry : juce::RangedDirectoryIterator(juce::File("/proc/self/task"), false,
+                                                           "*", juce::File::findDirectories)) {
+        const auto dir = entry.getFile();
+        const auto stat = dir.getChildFile("stat").loadFileAsString();
+
+        // The name field is parenthesised and may contain spaces; utime and stime are the
+        // 12th and 13th fields after it
+        const int nameEnd = stat.lastIndexOfChar(')');
+        if (nameEnd < 0) {
+            continue;
+        }
+        juce::StringArray fields;
+        fields.addTokens(stat.substring(nameEnd + 1), " ", "");
+        fields.removeEmptyStrings();
+        if (fields.size() < 13) {
+            continue;
+        }
+
+        ThreadTime thread;
+        thread.id = dir.getFileName().getLargeIntValue();
+        thread.name = dir.getChildFile("comm").loadFileAsString().trim();
+        thread.cpuSeconds =
+            static_cast<double>(fields[11].getLargeIntValue() + fields[12].getLargeIntValue()) /
+            ticksPerSecond;
+        threads.push_back(thread);
+    }
+    return threads;
+}
+
+#elif JUCE_MAC
+
+std::vector<ThreadCpuSampler::ThreadTime> ThreadCpuSampler::sample() {
+    std::vector<ThreadTime> threads;
+    thread_act_array_t list = nullptr;
+    mach_msg_type_number_t count = 0;
+    if (task_threads(mach_task_self(), &list, &count) != KERN_SUCCESS) {
+        return threads;
+    }
+
+    for (mach_msg_type_number_t i = 0; i < count; ++i) {
+        thread_extended_info_data_t info;
+        mach_msg_type_number_t infoCount = THREAD_EXTENDED_INFO_COUNT;
+        if (thread_info(list[i], THREAD_EXTENDED_INFO, reinterpret_cast<thread_info_t>(&info),
+                        &infoCount) == KERN_SUCCESS) {
+            thread_identifier_info_data_t identifier;
+            mach_msg_type_number_t identifierCount = THREAD_IDENTIFIER_INFO_COUNT;
+            ThreadTime thread;
+            thread.id = thread_info(list[i], THREAD_IDENTIFIER_INFO,
+                                    reinterpret_cast<thread_info_t>(&identifier),
+                                    &identifierCount) == KERN_SUCCESS
+                            ? static_cast<juce::int64>(identifier.thread_id)
+                            : static_cast<juce::int64>(list[i]);
+            thread.name = juce::String(info.pth_name);
+            thread.cpuSeconds =
+                static_cast<double>(info.pth_user_time + info.pth_system_time) / 1.0e9;
+            threads.push_back(thread);
+        }
+        mach_port_deallocate(mach_task_self(), list[i]);
+    }
+    vm_deallocate(mach_task_self(), reinterpret_cast<vm_address_t>(list),
+                  sizeof(thread_act_t) * count);
+    return threads;
+}
+
+#elif JUCE_WINDOWS
+
+std::vector<ThreadCpuSampler::ThreadTime> ThreadCpuSampler::sample() {
+    std::vector<ThreadTime> threads;
+    HANDLE snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPTHREAD, 0);
+    if (snapshot == INVALID_HANDLE_VALUE) {
+        return threads;
+    }
+
+    const DWORD processId = GetCurrentProcessId();
+    THREADENTRY32 entry;
+    entry.dwSize = sizeof(entry);
+    for (BOOL more = Thread32First(snapshot, &entry); more; more = Thread32Next(snapshot, &entry)) {
+        if (entry.th32OwnerProcessID != processId) {
+            continue;
+        }
+        HANDLE handle = OpenThread(THREAD_QUERY_LIMITED_INFORMATION, FALSE, entry.th32ThreadID);
+        if (handle == nullptr) {
+            continue;
+        }
+        FILETIME created, exited, kernel, user;
+        if (GetThreadTimes(handle, &created, &exited, &kernel, &user)) {
+            auto toSeconds = [](const FILETIME& t) {
+                const auto ticks = (static_cast<juce::uint64>(t.dwHighDateTime) << 32) |
+                                   t.dwLowDateTime;
+                return static_cast<double>(ticks) / 1.0e7;  // 100 ns units
+            };
+            ThreadTime thread;
+            thread.id = static_cast<juce::int64>(entry.th32ThreadID);
+            thread.cpuSeconds = toSeconds(kernel) + toSeconds(user);
+            threads.push_back(thread);
+        }
+        CloseHandle(handle);
+    }
+    CloseHandle(snapshot);
+    return threads;
+}
+
+#else
+
+std::vector<ThreadCpuSampler::ThreadTime> ThreadCpuSampler::sample() {
+    return {};
+}
+
+#endif
+
+// =============================================================================
+// Utilisation
+// =============================================================================
+
+std::vector<ThreadCpuSampler::Utilisation> ThreadCpuSampler::utilisation(
+    const std::vector<ThreadTime>& before, const std::vector<ThreadTime>& after,
+    double wallSeconds, double minFraction) {
+    std::vector<Utilisation> result;
+    if (wallSeconds <= 0.0) {
+        return result;
+    }
+
+    std::map<juce::int64, double> startTimes;
+    for (const auto& thread : before) {
+        startTimes[thread.id] = thread.cpuSeconds;
+    }
+
+    for (const auto& thread : after) {
+        const auto it = startTimes.find(thread.id);
+        const double used = thread.cpuSeconds - (it != startTimes.end() ? it->second : 0.0);
+        const double fraction = std::max(0.0, used) / wallSeconds;
+        if (fraction >= minFraction) {
+            result.push_back({thread.id, thread.name, fraction});
+        }
+    }
+
+    std::stable_sort(result.begin(), result.end(), [](const Utilisation& a, const Utilisation& b) {
+        return a.fraction > b.fraction;
+    });
+    return result;
+}
+
+}  // namespace magda
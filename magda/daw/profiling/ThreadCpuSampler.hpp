@@ -0,0 +1,49 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+#include <vector>
+
+namespace magda {
+
+/**
+ * @brief CPU time of each of this process's threads, for per-thread utilisation
+ *
+ * Sample before and after a piece of work; utilisation() is then each thread's CPU time
+ * over the wall time in between, so a render thread busy the whole way reads 1.0 and the
+ * sum across threads is the cores the work kept busy. Read from the OS (/proc on Linux,
+ * Mach thread info on macOS, thread times on Windows), so it covers threads MAGDA didn't
+ * create, such as the engine's render pool, without instrumenting them. Unsupported
+ * platforms sample nothing.
+ */
+class ThreadCpuSampler {
+  public:
+    struct ThreadTime {
+        juce::int64 id = 0;
+        juce::String name;
+        double cpuSeconds = 0.0;  // User and system
+    };
+
+    struct Utilisation {
+        juce::int64 id = 0;
+        juce::String name;
+        double fraction = 0.0;  // Of the wall time
+    };
+
+    /**
+     * @brief Every thread of this process and the CPU time it has used so far
+     */
+    static std::vector<ThreadTime> sample();
+
+    /**
+     * @brief Threads that used at least minFraction of the wall time, busiest first
+     *
+     * A thread that started after the first sample counts from zero; one that ended
+     * before the second isn't reported.
+     */
+    static std::vector<Utilisation> utilisation(const std::vector<ThreadTime>& before,
+                                                const std::vector<ThreadTime>& after,
+                                                double wallSeconds, double minFraction = 0.01);
+};
+
+}  // namespace magda
@@ -0,0 +1,217 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "ProfilingCounters.hpp"
+
+namespace magda {
+
+/**
+ * @brief Opt-in timeline of profiling scopes, exportable as Chrome trace JSON
+ *
+ * While recording, every MonitoredProfiler scope (MAGDA_MONITOR_SCOPE) also lands here as
+ * a complete event with its thread, so a hitch can be traced to the paint, sync or timer
+ * callback that caused it. Each thread writes to its own fixed ring, claimed on its first
+ * event, so recording never locks or allocates, on the audio thread included. Older
+ * events are overwritten once a thread's ring is full.
+ *
+ * The JSON opens in chrome://tracing and in the Perfetto UI (ui.perfetto.dev).
+ */
+class TraceRecorder {
+  public:
+    static constexpr size_t kMaxThreads = 16;        // Later threads aren't traced
+    static constexpr size_t kEventsPerThread = 8192;  // Power of 2
+
+    struct Event {
+        ProfilingCounters::Id counter = ProfilingCounters::kInvalidId;
+        uint64_t startNanos = 0;  // Since the recorder's epoch
+        uint64_t durationNanos = 0;
+    };
+
+    static TraceRecorder& getInstance() {
+        static TraceRecorder instance;
+        return instance;
+    }
+
+    // =========================================================================
+    // Control (message thread)
+    // =========================================================================
+
+    /**
+     * @brief Clear previous events and start recording
+     */
+    void start() {
+        if (isRecording()) {
+            return;
+        }
+        for (size_t i = 0; i < kMaxThreads; ++i) {
+            threads_[i].writeIndex.store(0, std::memory_order_relaxed);
+        }
+        recording_.store(true, std::memory_order_release);
+    }
+
+    void stop() {
+        recording_.store(false, std::memory_order_release);
+    }
+
+    bool isRecording() const {
+        return recording_.load(std::memory_order_relaxed);
+    }
+
+    // =========================================================================
+    // Recording (any thread, lock-free)
+    // =========================================================================
+
+    /**
+     * @brief Label the calling thread in exported traces (name must outlive the recorder)
+     */
+    void setCurrentThreadName(const char* name) {
+        if (auto* thread = currentThread()) {
+            thread->name.store(name, std::memory_order_relaxed);
+        }
+    }
+
+    void record(ProfilingCounters::Id counter, std::chrono::steady_clock::time_point start,
+                std::chrono::steady_clock::time_point end) {
+        if (!isRecording() || counter < 0) {
+            return;
+        }
+        auto* thread = currentThread();
+        if (!thread) {
+            return;
+        }
+
+        const auto index = thread->writeIndex.load(std::memory_order_relaxed);
+        auto& event = thread->events[index & (kEventsPerThread - 1)];
+        event.counter = counter;
+        event.startNanos = toNanos(start - epoch_);
+        event.durationNanos = toNanos(end - start);
+        thread->writeIndex.store(index + 1, std::memory_order_release);
+    }
+
+    // =========================================================================
+    // Export (message thread)
+    // =========================================================================
+
+    /**
+     * @brief Chrome trace-event JSON of everything recorded since start()
+     *
+     * Safe while recording; events being written during the export may be skipped.
+     */
+    std::string exportChromeTrace() const {
+        auto& counters = ProfilingCounters::getInstance();
+        std::ostringstream out;
+        out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+        bool first = true;
+        auto separator = [&out, &first]() {
+            if (!first) {
+                out << ",";
+            }
+            first = false;
+        };
+
+        const auto numThreads = std::min(nextThread_.load(std::memory_order_acquire), kMaxThreads);
+        for (size_t tid = 0; tid < numThreads; ++tid) {
+            const auto& thread = threads_[tid];
+            if (const char* name = thread.name.load(std::memory_order_relaxed)) {
+                separator();
+                out << R"({"ph":"M","name":"thread_name","pid":1,"tid":)" << tid
+                    << R"(,"args":{"name":")" << escape(name) << "\"}}";
+            }
+
+            const auto end = thread.writeIndex.load(std::memory_order_acquire);
+            const auto begin = end > kEventsPerThread ? end - kEventsPerThread : 0;
+            for (auto i = begin; i < end; ++i) {
+                const auto& event = thread.events[i & (kEventsPerThread - 1)];
+                separator();
+                out << R"({"ph":"X","pid":1,"tid":)" << tid << R"(,"name":")"
+                    << escape(counters.getName(event.counter)) << R"(","ts":)"
+                    << static_cast<double>(event.startNanos) * 1.0e-3 << R"(,"dur":)"
+                    << static_cast<double>(event.durationNanos) * 1.0e-3 << "}";
+            }
+        }
+
+        out << "]}";
+        return out.str();
+    }
+
+    /**
+     * @brief Events recorded on one traced thread, oldest first (for tests and tools)
+     */
+    std::vector<Event> getEvents(size_t tid) const {
+        std::vector<Event> events;
+        if (tid >= kMaxThreads) {
+            return events;
+        }
+        const auto& thread = threads_[tid];
+        const auto end = thread.writeIndex.load(std::memory_order_acquire);
+        const auto begin = end > kEventsPerThread ? end - kEventsPerThread : 0;
+        for (auto i = begin; i < end; ++i) {
+            events.push_back(thread.events[i & (kEventsPerThread - 1)]);
+        }
+        return events;
+    }
+
+    /**
+     * @brief Trace slot of the calling thread, claiming one if needed (kMaxThreads if none)
+     */
+    size_t getCurrentThreadIndex() {
+        currentThread();
+        return threadIndex();
+    }
+
+  private:
+    struct ThreadEvents {
+        std::atomic<uint64_t> writeIndex{0};
+        std::atomic<const char*> name{nullptr};
+        std::array<Event, kEventsPerThread> events{};
+    };
+
+    TraceRecorder() : threads_(std::make_unique<ThreadEvents[]>(kMaxThreads)) {}
+
+    size_t& threadIndex() {
+        thread_local size_t index = kMaxThreads + 1;  // Unclaimed
+        return index;
+    }
+
+    ThreadEvents* currentThread() {
+        auto& index = threadIndex();
+        if (index == kMaxThreads + 1) {
+            index = std::min(nextThread_.fetch_add(1, std::memory_order_acq_rel), kMaxThreads);
+        }
+        return index < kMaxThreads ? &threads_[index] : nullptr;
+    }
+
+    static uint64_t toNanos(std::chrono::steady_clock::duration duration) {
+        return static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+    }
+
+    static std::string escape(const std::string& text) {
+        std::string escaped;
+        for (char c : text) {
+            if (c == '"' || c == '\\') {
+                escaped += '\\';
+            }
+            escaped += c;
+        }
+        return escaped;
+    }
+
+    std::unique_ptr<ThreadEvents[]> threads_;
+    std::atomic<size_t> nextThread_{0};
+    std::atomic<bool> recording_{false};
+    const std::chrono::steady_clock::time_point epoch_ = std::chrono::steady_clock::now();
+};
+
+}  // namespace magda
@@ -0,0 +1,192 @@
+#include "UIFrameProfiler.hpp"
+
+#include <juce_events/juce_events.h>
+
+#include <algorithm>
+
+#include "PerformanceProfiler.hpp"
+
+namespace magda {
+
+// =============================================================================
+// LatencyProbe
+// =============================================================================
+
+/**
+ * Posts one message at a time and times how long the loop takes to deliver it. The timer
+ * itself isn't on the measured path: only the wait in the message queue is.
+ */
+class UIFrameProfiler::LatencyProbe : private juce::Timer {
+  public:
+    explicit LatencyProbe(int intervalMs) {
+        startTimer(intervalMs);
+    }
+
+    ~LatencyProbe() override {
+        stopTimer();
+        *alive_ = false;
+    }
+
+  private:
+    void timerCallback() override {
+        if (pending_) {
+            return;  // Still queued: the loop is stalled and the reply will say by how much
+        }
+
+        pending_ = true;
+        const double postedMs = juce::Time::getMillisecondCounterHiRes();
+        juce::MessageManager::callAsync([this, alive = alive_, postedMs] {
+            if (!*alive) {
+                return;
+            }
+            pending_ = false;
+            UIFrameProfiler::getInstance().recordMessageLatency(
+                juce::Time::getMillisecondCounterHiRes() - postedMs);
+        });
+    }
+
+    std::shared_ptr<bool> alive_ = std::make_shared<bool>(true);
+    bool pending_ = false;
+};
+
+// =============================================================================
+// UIFrameProfiler
+// =============================================================================
+
+UIFrameProfiler::UIFrameProfiler() = default;
+UIFrameProfiler::~UIFrameProfiler() = default;
+
+UIFrameProfiler& UIFrameProfiler::getInstance() {
+    static UIFrameProfiler instance;
+    return instance;
+}
+
+UIFrameProfiler::SourceId UIFrameProfiler::registerSource(const juce::String& name) {
+    for (size_t i = 0; i < sources_.size(); ++i) {
+        if (sources_[i].name == name) {
+            return static_cast<SourceId>(i);
+        }
+    }
+
+    SourceStats stats;
+    stats.name = name;
+    sources_.push_back(stats);
+    monitorCategories_.push_back(Symbol("UIPaint." + name));
+    frameSelfMs_.push_back(0.0);
+    return static_cast<SourceId>(sources_.size() - 1);
+}
+
+void UIFrameProfiler::beginPaint(SourceId id) {
+    beginPaint(id, juce::Time::getMillisecondCounterHiRes());
+}
+
+void UIFrameProfiler::endPaint(SourceId id) {
+    endPaint(id, juce::Time::getMillisecondCounterHiRes());
+}
+
+void UIFrameProfiler::beginPaint(SourceId id, double nowMs) {
+    if (id < 0 || id >= static_cast<SourceId>(sources_.size())) {
+        return;
+    }
+    openSpans_.push_back({id, nowMs, 0.0});
+}
+
+void UIFrameProfiler::endPaint(SourceId id, double nowMs) {
+    // paint() can be skipped while paintOverChildren() still runs: an end with no matching
+    // begin is ignored, and spans left open inside this one are dropped with it
+    const auto it = std::find_if(openSpans_.rbegin(), openSpans_.rend(),
+                                 [id](const OpenSpan& span) { return span.id == id; });
+    if (it == openSpans_.rend()) {
+        return;
+    }
+
+    const OpenSpan span = *it;
+    openSpans_.erase(std::next(it).base(), openSpans_.end());
+
+    const double inclusiveMs = std::max(0.0, nowMs - span.startMs);
+    auto& stats = sources_[static_cast<size_t>(id)];
+    ++stats.paints;
+    stats.totalMs += inclusiveMs;
+    stats.maxMs = std::max(stats.maxMs, inclusiveMs);
+    stats.lastMs = inclusiveMs;
+    frameSelfMs_[static_cast<size_t>(id)] += std::max(0.0, inclusiveMs - span.childMs);
+    PerformanceMonitor::getInstance().addSample(monitorCategories_[static_cast<size_t>(id)],
+                                                inclusiveMs);
+
+    if (openSpans_.empty()) {
+        finishFrame(inclusiveMs);
+    } else {
+        openSpans_.back().childMs += inclusiveMs;
+    }
+}
+
+void UIFrameProfiler::finishFrame(double frameMs) {
+    ++frameStats_.frames;
+    frameStats_.totalMs += frameMs;
+    frameStats_.maxMs = std::max(frameStats_.maxMs, frameMs);
+    frameStats_.lastMs = frameMs;
+
+    if (frameMs > budgetMs_) {
+        ++frameStats_.droppedFrames;
+        const auto culprit = std::max_element(frameSelfMs_.begin(), frameSelfMs_.end());
+        ++sources_[static_cast<size_t>(culprit - frameSelfMs_.begin())].slowFrames;
+    }
+    std::fill(frameSelfMs_.begin(), frameSelfMs_.end(), 0.0);
+
+    static const Symbol frameCategory("UIFrame");
+    static const Symbol droppedCounter("UIDroppedFrames");
+    auto& monitor = PerformanceMonitor::getInstance();
+    monitor.addSample(frameCategory, frameMs);
+    monitor.setCounter(droppedCounter, frameStats_.droppedFrames);
+}
+
+void UIFrameProfiler::recordMessageLatency(double milliseconds) {
+    ++frameStats_.latencySamples;
+    frameStats_.latencyTotalMs += milliseconds;
+    frameStats_.latencyMaxMs = std::max(frameStats_.latencyMaxMs, milliseconds);
+    frameStats_.latencyLastMs = milliseconds;
+    static const Symbol latencyCategory("UIMessageLatency");
+    PerformanceMonitor::getInstance().addSample(latencyCategory, milliseconds);
+}
+
+std::vector<UIFrameProfiler::SourceStats> UIFrameProfiler::getWorstOffenders(
+    size_t maxCount) const {
+    std::vector<SourceStats> worst;
+    for (const auto& stats : sources_) {
+        if (stats.paints > 0) {
+            worst.push_back(stats);
+        }
+    }
+
+    std::sort(worst.begin(), worst.end(), [](const SourceStats& a, const SourceStats& b) {
+        if (a.slowFrames != b.slowFrames) {
+            return a.slowFrames > b.slowFrames;
+        }
+        return a.maxMs > b.maxMs;
+    });
+    if (worst.size() > maxCount) {
+        worst.resize(maxCount);
+    }
+    return worst;
+}
+
+void UIFrameProfiler::reset() {
+    for (auto& stats : sources_) {
+        const auto name = stats.name;
+        stats = SourceStats();
+        stats.name = name;
+    }
+    std::fill(frameSelfMs_.begin(), frameSelfMs_.end(), 0.0);
+    openSpans_.clear();
+    frameStats_ = FrameStats();
+}
+
+void UIFrameProfiler::startMessageLatencyProbe(int intervalMs) {
+    probe_ = std::make_unique<LatencyProbe>(intervalMs);
+}
+
+void UIFrameProfiler::stopMessageLatencyProbe() {
+    probe_.reset();
+}
+
+}  // namespace magda
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+#include <memory>
+#include <vector>
+
+#include "../core/Symbol.hpp"
+
+namespace magda {
+
+/**
+ * @brief Paint-pass timing for the top-level views, with slow frames attributed to a view
+ *
+ * Instrumented views (MainView, TrackContentPanel, MixerView, PianoRollContent) open a span
+ * in paint() and close it in paintOverChildren(), so a span covers the view and everything
+ * painted inside it. Spans nest; the outermost one is a frame. A frame longer than the
+ * budget counts as dropped and is blamed on the view with the most self time in it (its
+ * span minus the instrumented views inside), which is the view that actually blew the
+ * budget rather than the container around it.
+ *
+ * JUCE skips paint() for a view whose own area is fully covered by opaque children; the
+ * views inside it then open their own frames, so nothing is lost but the container.
+ *
+ * A probe posts a message every few hundred ms and times its delivery: the message-loop
+ * latency, which catches stalls that aren't paints (timers, model callbacks).
+ *
+ * Frame times, paint times ("UIPaint.<view>") and message latency are also forwarded to
+ * PerformanceMonitor for BenchmarkSuite. Message thread only.
+ */
+class UIFrameProfiler {
+  public:
+    using SourceId = int;
+
+    struct SourceStats {
+        juce::String name;
+        juce::int64 paints = 0;
+        juce::int64 slowFrames = 0;  // Dropped frames blamed on this view
+        double totalMs = 0.0;
+        double maxMs = 0.0;
+        double lastMs = 0.0;
+
+        double getAverageMs() const {
+            return paints > 0 ? totalMs / double(paints) : 0.0;
+        }
+    };
+
+    struct FrameStats {
+        juce::int64 frames = 0;
+        juce::int64 droppedFrames = 0;
+        double totalMs = 0.0;
+        double maxMs = 0.0;
+        double lastMs = 0.0;
+
+        juce::int64 latencySamples = 0;
+        double latencyTotalMs = 0.0;
+        double latencyMaxMs = 0.0;
+        double latencyLastMs = 0.0;
+
+        double getAverageMs() const {
+            return frames > 0 ? totalMs / double(frames) : 0.0;
+        }
+        double getAverageLatencyMs() const {
+            return latencySamples > 0 ? latencyTotalMs / double(latencySamples) : 0.0;
+        }
+    };
+
+    /**
+     * @brief A view's handle: construct as a member, begin() in paint(), end() in
+     *        paintOverChildren()
+     */
+    class Source {
+      public:
+        explicit Source(const juce::String& name)
+            : id_(UIFrameProfiler::getInstance().registerSource(name)) {}
+
+        void begin() const {
+            UIFrameProfiler::getInstance().beginPaint(id_);
+        }
+        void end() const {
+            UIFrameProfiler::getInstance().endPaint(id_);
+        }
+
+      private:
+        SourceId id_;
+    };
+
+    static UIFrameProfiler& getInstance();
+
+    /**
+     * @brief Register a view by name (registering a name again returns the same id, so
+     *        every instance of a view shares one entry)
+     */
+    SourceId registerSource(const juce::String& name);
+
+    void beginPaint(SourceId id);
+    void endPaint(SourceId id);
+    void beginPaint(SourceId id, double nowMs);
+    void endPaint(SourceId id, double nowMs);
+
+    void recordMessageLatency(double milliseconds);
+
+    /**
+     * @brief Frames longer than this are dropped (default: one 60 Hz frame)
+     */
+    void setFrameBudgetMs(double budgetMs) {
+        budgetMs_ = budgetMs;
+    }
+    double getFrameBudgetMs() const {
+        return budgetMs_;
+    }
+
+    FrameStats getFrameStats() const {
+        return frameStats_;
+    }
+    std::vector<SourceStats> getSourceStats() const {
+        return sources_;
+    }
+
+    /**
+     * @brief Views with the most dropped frames, then the slowest single paint
+     */
+    std::vector<SourceStats> getWorstOffenders(size_t maxCount) const;
+
+    /**
+     * @brief Clear all statistics (registered views are kept)
+     */
+    void reset();
+
+    /**
+     * @brief Start or stop the message-loop latency probe (stop it before JUCE shuts down)
+     */
+    void startMessageLatencyProbe(int intervalMs = 250);
+    void stopMessageLatencyProbe();
+
+  private:
+    UIFrameProfiler();
+    ~UIFrameProfiler();
+
+    struct OpenSpan {
+        SourceId id = 0;
+        double startMs = 0.0;
+        double childMs = 0.0;  // Inclusive time of instrumented views inside this one
+    };
+
+    class LatencyProbe;
+
+    std::vector<SourceStats> sources_;
+    std::vector<Symbol> monitorCategories_;  // "UIPaint.<name>", interned once
+    std::vector<OpenSpan> openSpans_;
+    std::vector<double> frameSelfMs_;  // Per source, for the frame being painted
+    FrameStats frameStats_;
+    double budgetMs_ = 1000.0 / 60.0;
+    std::unique_ptr<LatencyProbe> probe_;
+
+    void finishFrame(double frameMs);
+};
+
+}  // namespace magda
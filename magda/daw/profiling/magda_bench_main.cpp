@@ -0,0 +1,1086 @@
+/**
+ * @file magda_bench_main.cpp
+ * @brief Headless benchmark: synthetic projects timed through the real model and engine
+ *
+ * Builds a synthetic project (N tracks, M MIDI clips per track, nested racks K deep, dense
+ * volume/pan automation) through TrackManager, ClipManager and AutomationManager, then times
+ * the operations that make the app feel slow on big projects:
+ *
+ *   build             model construction with the engine detached
+ *   sync.full         first reconcile of the whole model into the Edit (project load)
+ *   sync.incremental  moving every clip and nudging every track, then one flush
+ *   query             range/position lookups, lane lookups and device path resolution
+ *   undo.execute      every clip moved through the UndoManager
+ *   undo.undo         undoing all of those moves
+ *   undo.redo         redoing them
+ *   render            offline render of the Edit to a WAV file
+ *
+ * Each iteration gets a fresh engine and project, so iterations don't warm each other up.
+ * After the undo phases (model, Edit and undo history all populated) each subsystem's
+ * estimated memory (MemoryAccounting) is recorded; the report keeps the peak per subsystem.
+ * Results are written as JSON (see BenchmarkReport) and can be compared against a stored
+ * baseline; the exit code is non-zero when a phase regresses beyond the tolerance.
+ *
+ * With --scaling the same project is built at increasing track counts instead (1000 tracks
+ * of 100 clips at the top) and each metric's growth is checked against the complexity it
+ * should have (see ScalingAnalysis): build, full and incremental sync, accounted memory,
+ * startup (engine, model, sync and the arrange view's first paint), selecting every clip
+ * and repainting the arrange view. The exit code is non-zero when a metric grows faster.
+ *
+ * With --render-check, reference projects (a .magda file or a directory of them) are opened
+ * through HeadlessHost and rendered offline instead: the mix is timed for its realtime
+ * factor and per-thread CPU utilisation, and the mix and stems are compared with golden
+ * renders - bit-exact where only MAGDA's own devices are involved, within --tolerance-db
+ * otherwise. --update-golden writes the renders as the new goldens. The exit code is
+ * non-zero when a render no longer matches.
+ *
+ * Usage:
+ *   magda_bench [--tracks=32] [--clips=16] [--rack-depth=2] [--points=256] [--notes=32]
+ *               [--iterations=5] [--render-seconds=10] [--no-render]
+ *               [--output=magda_bench.json] [--baseline=file.json] [--tolerance=0.15]
+ *   magda_bench --scaling [--sizes=125,250,500,1000] [--clips=100] [--slack=0.3]
+ *               [--output=magda_scaling.json]
+ *   magda_bench --render-check=DIR_OR_PROJECT --golden=DIR [--update-golden]
+ *               [--iterations=3] [--tolerance-db=-80] [--output=magda_render.json]
+ *               [--baseline=file.json] [--tolerance=0.15]
+ */
+
+#include <juce_audio_devices/juce_audio_devices.h>
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_events/juce_events.h>
+#include <tracktion_engine/tracktion_engine.h>
+
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "../audio/AudioBridge.hpp"
+#include "../audio/AudioReaderCache.hpp"
+#include "../core/AutomationManager.hpp"
+#include "../core/ClipCommands.hpp"
+#include "../core/ClipManager.hpp"
+#include "../core/ModulatorEngine.hpp"
+#include "../core/RackInfo.hpp"
+#include "../core/SelectionManager.hpp"
+#include "../core/TrackManager.hpp"
+#include "../core/UndoManager.hpp"
+#include "../engine/HeadlessHost.hpp"
+#include "../engine/TracktionEngineWrapper.hpp"
+#include "../ui/themes/FontManager.hpp"
+#include "../ui/views/MainView.hpp"
+#include "BenchmarkReport.hpp"
+#include "MemoryAccounting.hpp"
+#include "RenderComparison.hpp"
+#include "ScalingAnalysis.hpp"
+#include "ThreadCpuSampler.hpp"
+
+namespace te = tracktion;
+
+namespace {
+
+constexpr int kExitRegression = 1;
+constexpr int kExitError = 2;
+
+constexpr double kClipLengthSeconds = 4.0;  // Two bars at 120 BPM
+constexpr double kTempo = 120.0;
+
+struct BenchConfig {
+    int tracks = 32;
+    int clipsPerTrack = 16;
+    int rackDepth = 2;
+    int automationPoints = 256;  // Per lane (volume and pan on every track)
+    int notesPerClip = 32;
+    int iterations = 5;
+    double renderSeconds = 10.0;
+    bool render = true;
+
+    double getProjectLength() const {
+        return clipsPerTrack * kClipLengthSeconds;
+    }
+};
+
+double timeMs(const std::function<void()>& fn) {
+    const double start = juce::Time::getMillisecondCounterHiRes();
+    fn();
+    return juce::Time::getMillisecondCounterHiRes() - start;
+}
+
+// =============================================================================
+// Synthetic project
+// =============================================================================
+
+struct SyntheticProject {
+    std::vector<magda::TrackId> tracks;
+    std::vector<magda::ClipId> clips;
+    std::vector<magda::DeviceId> devices;
+};
+
+magda::DeviceInfo makeInternalDevice(const juce::String& name, const juce::String& pluginId,
+                                     bool isInstrument) {
+    magda::DeviceInfo device;
+    device.name = name;
+    device.pluginId = pluginId;
+    device.manufacturer = "MAGDA";
+    device.format = magda::PluginFormat::Internal;
+    device.isInstrument = isInstrument;
+    return device;
+}
+
+/**
+ * @brief Build a rack on the track nested depth racks deep, with an EQ in every chain
+ */
+void buildNestedRacks(magda::TrackId trackId, int depth, SyntheticProject& project) {
+    if (depth <= 0) {
+        return;
+    }
+
+    auto& tm = magda::TrackManager::getInstance();
+    const auto eq = makeInternalDevice("EQ", "eq", false);
+
+    auto rackPath = magda::ChainNodePath::rack(trackId, tm.addRackToTrack(trackId, "Bench Rack"));
+    for (int level = 0; level < depth; ++level) {
+        const auto chainPath = rackPath.withChain(tm.addChainToRack(rackPath));
+        project.devices.push_back(tm.addDeviceToChainByPath(chainPath, eq));
+
+        if (level + 1 < depth) {
+            rackPath = chainPath.withRack(tm.addRackToChainByPath(chainPath, "Nested Rack"));
+        }
+    }
+}
+
+void buildAutomationLane(magda::TrackId trackId, magda::AutomationTargetType type,
+                         const BenchConfig& config) {
+    auto& am = magda::AutomationManager::getInstance();
+
+    magda::AutomationTarget target;
+    target.type = type;
+    target.trackId = trackId;
+    const auto laneId = am.createLane(target, magda::AutomationLaneType::Absolute);
+
+    const double step = config.getProjectLength() / std::max(1, config.automationPoints);
+    for (int i = 0; i < config.automationPoints; ++i) {
+        // A slow sine keeps values in range and every segment distinct
+        const double value = 0.5 + 0.4 * std::sin(i * 0.1);
+        am.addPoint(laneId, i * step, value);
+    }
+}
+
+SyntheticProject buildProject(const BenchConfig& config) {
+    auto& tm = magda::TrackManager::getInstance();
+    auto& cm = magda::ClipManager::getInstance();
+
+    SyntheticProject project;
+    const auto synth = makeInternalDevice("4OSC", "4osc", true);
+
+    for (int t = 0; t < config.tracks; ++t) {
+        const auto trackId = tm.createTrack("Bench " + juce::String(t + 1),
+                                            magda::TrackType::Instrument);
+        project.tracks.push_back(trackId);
+        project.devices.push_back(tm.addDeviceToTrack(trackId, synth));
+        buildNestedRacks(trackId, config.rackDepth, project);
+
+        for (int c = 0; c < config.clipsPerTrack; ++c) {
+            const auto clipId = cm.createMidiClip(trackId, c * kClipLengthSeconds,
+                                                  kClipLengthSeconds);
+            project.clips.push_back(clipId);
+
+            // Eight beats per clip, notes spread evenly across them
+            std::vector<magda::MidiNote> notes(static_cast<size_t>(config.notesPerClip));
+            const double spacing = 8.0 / std::max(1, config.notesPerClip);
+            for (int n = 0; n < config.notesPerClip; ++n) {
+                auto& note = notes[static_cast<size_t>(n)];
+                note.noteNumber = 48 + (n * 7 + t) % 24;
+                note.velocity = 64 + n % 48;
+                note.startBeat = n * spacing;
+                note.lengthBeats = spacing * 0.9;
+            }
+            cm.addMidiNotes(clipId, notes);
+        }
+
+        buildAutomationLane(trackId, magda::AutomationTargetType::TrackVolume, config);
+        buildAutomationLane(trackId, magda::AutomationTargetType::TrackPan, config);
+    }
+
+    return project;
+}
+
+void clearModel() {
+    magda::UndoManager::getInstance().clearHistory();
+    magda::AutomationManager::getInstance().clearAll();
+    magda::ClipManager::getInstance().clearAllClips();
+    magda::TrackManager::getInstance().clearAllTracks();
+    magda::TrackManager::getInstance().flushPendingChanges();
+    magda::ClipManager::getInstance().flushPendingChanges();
+}
+
+/**
+ * @brief Deliver coalesced model changes and apply everything pending to the engine
+ */
+void flushSync(magda::AudioBridge& bridge) {
+    magda::TrackManager::getInstance().flushPendingChanges();
+    magda::ClipManager::getInstance().flushPendingChanges();
+    bridge.flushPendingSync();
+}
+
+// =============================================================================
+// Phases
+// =============================================================================
+
+size_t runQueries(const SyntheticProject& project, const BenchConfig& config) {
+    auto& tm = magda::TrackManager::getInstance();
+    auto& cm = magda::ClipManager::getInstance();
+    auto& am = magda::AutomationManager::getInstance();
+
+    // Counted so the lookups can't be optimised away, and reported as a sanity check
+    size_t hits = 0;
+    const double length = config.getProjectLength();
+
+    for (auto trackId : project.tracks) {
+        hits += cm.getClipsOnTrack(trackId).size();
+        hits += am.getLanesForTrack(trackId).size();
+
+        for (double t = 0.0; t < length; t += 0.5) {
+            hits += cm.getClipsInRange(trackId, t, t + kClipLengthSeconds).size();
+            if (cm.getClipAtPosition(trackId, t + 0.25) != magda::INVALID_CLIP_ID) {
+                ++hits;
+            }
+        }
+
+        if (tm.getTrack(trackId) != nullptr) {
+            ++hits;
+        }
+    }
+
+    for (auto deviceId : project.devices) {
+        if (tm.findDevicePath(deviceId).isValid()) {
+            ++hits;
+        }
+    }
+
+    return hits;
+}
+
+void runUndoPhases(const SyntheticProject& project, magda::AudioBridge& bridge,
+                   magda::BenchmarkReport& report) {
+    auto& undo = magda::UndoManager::getInstance();
+    auto& cm = magda::ClipManager::getInstance();
+
+    undo.clearHistory();
+    undo.setMaxUndoSteps(project.clips.size() + 1);
+    undo.setMaxUndoBytes(0);
+
+    report.addSample("undo.execute", timeMs([&] {
+                         for (auto clipId : project.clips) {
+                             const auto* clip = cm.getClip(clipId);
+                             const double start = clip ? clip->startTime : 0.0;
+                             undo.executeCommand(
+                                 std::make_unique<magda::MoveClipCommand>(clipId, start + 0.5));
+                         }
+                         flushSync(bridge);
+                     }));
+
+    report.addSample("undo.undo", timeMs([&] {
+                         while (undo.undo()) {
+                         }
+                         flushSync(bridge);
+                     }));
+
+    report.addSample("undo.redo", timeMs([&] {
+                         while (undo.redo()) {
+                         }
+                         flushSync(bridge);
+                     }));
+}
+
+bool renderEdit(te::Edit& edit, const BenchConfig& config) {
+    auto& engine = edit.engine;
+    const auto file = juce::File::createTempFile(".wav");
+
+    te::Renderer::Parameters params(edit);
+    params.destFile = file;
+    params.audioFormat = engine.getAudioFileFormatManager().getWavFormat();
+    params.time = {te::TimePosition(), te::TimePosition::fromSeconds(config.renderSeconds)};
+    params.tracksToDo = te::toBitSet(te::getAllTracks(edit));
+    params.usePlugins = true;
+    params.sampleRateForAudio = 44100.0;
+    params.blockSizeForAudio = 512;
+
+    const auto rendered = te::Renderer::renderToFile("MAGDA Benchmark", params);
+    const bool ok = rendered.existsAsFile();
+    file.deleteFile();
+    return ok;
+}
+
+bool runIteration(const BenchConfig& config, magda::BenchmarkReport& report) {
+    clearModel();
+
+    auto engine = std::make_unique<magda::TracktionEngineWrapper>();
+    if (!engine->initialize() || engine->getAudioBridge() == nullptr) {
+        std::cerr << "magda_bench: failed to initialize the audio engine" << std::endl;
+        return false;
+    }
+
+    auto& bridge = *engine->getAudioBridge();
+    auto& tm = magda::TrackManager::getInstance();
+    auto& cm = magda::ClipManager::getInstance();
+    engine->setTempo(kTempo);
+
+    // Build the model alone: detached, the bridge would reconcile after every track
+    tm.removeListener(&bridge);
+    cm.removeListener(&bridge);
+
+    SyntheticProject project;
+    report.addSample("build", timeMs([&] { project = buildProject(config); }));
+
+    tm.flushPendingChanges();
+    cm.flushPendingChanges();
+    tm.addListener(&bridge);
+    cm.addListener(&bridge);
+
+    report.addSample("sync.full", timeMs([&] {
+                         bridge.tracksChanged();
+                         bridge.clipsChanged();
+                         flushSync(bridge);
+                     }));
+
+    report.addSample("sync.incremental", timeMs([&] {
+                         for (auto clipId : project.clips) {
+                             if (const auto* clip = cm.getClip(clipId)) {
+                                 cm.moveClip(clipId, clip->startTime + 0.25, kTempo);
+                             }
+                         }
+                         for (auto trackId : project.tracks) {
+                             tm.setTrackVolume(trackId, 0.8f);
+                         }
+                         flushSync(bridge);
+                     }));
+
+    size_t hits = 0;
+    report.addSample("query", timeMs([&] { hits = runQueries(project, config); }));
+    report.setConfig("queryHits", static_cast<juce::int64>(hits));
+
+    runUndoPhases(project, bridge, report);
+
+    for (const auto& usage : magda::MemoryAccounting::getInstance().collect()) {
+        report.setMemory(usage.subsystem, usage.bytes);
+    }
+
+    bool ok = true;
+    if (config.render) {
+        if (auto* edit = engine->getEdit()) {
+            report.addSample("render", timeMs([&] { ok = renderEdit(*edit, config); }));
+        }
+        if (!ok) {
+            std::cerr << "magda_bench: offline render failed" << std::endl;
+        }
+    }
+
+    engine->shutdown();
+    engine.reset();
+    clearModel();
+    return ok;
+}
+
+// =============================================================================
+// Command line
+// =============================================================================
+
+void printUsage() {
+    std::cout << "Usage: magda_bench [--tracks=N] [--clips=M] [--rack-depth=K] [--points=P]\n"
+                 "                   [--notes=N] [--iterations=I] [--render-seconds=S]\n"
+                 "                   [--no-render] [--output=FILE] [--baseline=FILE]\n"
+                 "                   [--tolerance=0.15]\n"
+                 "       magda_bench --scaling [--sizes=125,250,500,1000] [--clips=100]\n"
+                 "                   [--slack=0.3] [--output=FILE]\n"
+                 "       magda_bench --render-check=DIR_OR_PROJECT --golden=DIR\n"
+                 "                   [--update-golden] [--iterations=3] [--tolerance-db=-80]\n"
+                 "                   [--output=FILE] [--baseline=FILE] [--tolerance=0.15]\n";
+}
+
+int intOption(const juce::ArgumentList& args, const juce::String& option, int fallback) {
+    const auto value = args.getValueForOption(option);
+    return value.isEmpty() ? fallback : std::max(0, value.getIntValue());
+}
+
+double doubleOption(const juce::ArgumentList& args, const juce::String& option,
+                    double fallback) {
+    const auto value = args.getValueForOption(option);
+    return value.isEmpty() ? fallback : std::max(0.0, value.getDoubleValue());
+}
+
+void recordConfig(const BenchConfig& config, magda::BenchmarkReport& report) {
+    report.setConfig("tracks", config.tracks);
+    report.setConfig("clipsPerTrack", config.clipsPerTrack);
+    report.setConfig("rackDepth", config.rackDepth);
+    report.setConfig("automationPoints", config.automationPoints);
+    report.setConfig("notesPerClip", config.notesPerClip);
+    report.setConfig("iterations", config.iterations);
+    report.setConfig("renderSeconds", config.render ? config.renderSeconds : 0.0);
+    report.setConfig("cpu", juce::SystemStats::getCpuModel());
+    report.setConfig("os", juce::SystemStats::getOperatingSystemName());
+}
+
+int compareWithBaseline(const magda::BenchmarkReport& report, const juce::File& baselineFile,
+                        double tolerance) {
+    const auto baseline = magda::BenchmarkReport::fromJSON(baselineFile.loadFileAsString());
+    if (!baseline) {
+        std::cerr << "magda_bench: can't read baseline " << baselineFile.getFullPathName()
+                  << std::endl;
+        return kExitError;
+    }
+
+    // Timings only compare on the same workload
+    for (const char* key : {"tracks", "clipsPerTrack", "rackDepth", "automationPoints",
+                            "notesPerClip", "renderSeconds"}) {
+        if (report.getConfig()[key] != baseline->getConfig()[key]) {
+            std::cerr << "magda_bench: warning: baseline " << key << " is "
+                      << baseline->getConfig()[key].toString() << ", this run used "
+                      << report.getConfig()[key].toString() << std::endl;
+        }
+    }
+
+    const auto regressions = report.findRegressions(*baseline, tolerance);
+    for (const auto& r : regressions) {
+        std::cout << "REGRESSION " << r.phase << ": " << juce::String(r.baselineMs, 3)
+                  << " ms -> " << juce::String(r.currentMs, 3) << " ms (x"
+                  << juce::String(r.getRatio(), 2) << ")" << std::endl;
+    }
+
+    if (regressions.empty()) {
+        std::cout << "No regressions against " << baselineFile.getFileName() << " (tolerance "
+                  << juce::String(tolerance * 100.0, 0) << "%)" << std::endl;
+        return 0;
+    }
+    return kExitRegression;
+}
+
+// =============================================================================
+// Scalability
+// =============================================================================
+
+constexpr int kViewWidth = 1920;
+constexpr int kViewHeight = 1080;
+
+void setScalingTargets(magda::ScalingAnalysis& analysis) {
+    using Complexity = magda::ScalingAnalysis::Complexity;
+    analysis.setTarget("build", Complexity::Linear);
+    analysis.setTarget("sync.full", Complexity::Linear);
+    analysis.setTarget("sync.incremental", Complexity::Linear);
+    analysis.setTarget("memory", Complexity::Linear);
+    analysis.setTarget("startup", Complexity::Linearithmic);
+    analysis.setTarget("selection", Complexity::Linear);
+    // Should follow the visible area, not the project; the ceiling is what stops it from
+    // getting worse while the panels still visit every track
+    analysis.setTarget("repaint", Complexity::Linear);
+}
+
+double paintMs(juce::Component& view) {
+    juce::Image image(juce::Image::ARGB, view.getWidth(), view.getHeight(), true);
+    juce::Graphics g(image);
+    return timeMs([&] { view.paintEntireComponent(g, false); });
+}
+
+/**
+ * @brief Measure one project size on a fresh engine
+ */
+bool runScalingSize(const BenchConfig& config, magda::ScalingAnalysis& analysis) {
+    clearModel();
+    const double size = config.tracks;
+    const double startupStart = juce::Time::getMillisecondCounterHiRes();
+
+    auto engine = std::make_unique<magda::TracktionEngineWrapper>();
+    if (!engine->initialize() || engine->getAudioBridge() == nullptr) {
+        std::cerr << "magda_bench: failed to initialize the audio engine" << std::endl;
+        return false;
+    }
+
+    auto& bridge = *engine->getAudioBridge();
+    auto& tm = magda::TrackManager::getInstance();
+    auto& cm = magda::ClipManager::getInstance();
+    engine->setTempo(kTempo);
+
+    tm.removeListener(&bridge);
+    cm.removeListener(&bridge);
+    SyntheticProject project;
+    analysis.addPoint("build", size, timeMs([&] { project = buildProject(config); }));
+    tm.flushPendingChanges();
+    cm.flushPendingChanges();
+    tm.addListener(&bridge);
+    cm.addListener(&bridge);
+
+    analysis.addPoint("sync.full", size, timeMs([&] {
+                          bridge.tracksChanged();
+                          bridge.clipsChanged();
+                          flushSync(bridge);
+                      }));
+
+    // Built once the project is in, as opening a project would; from here on the view
+    // reacts to each change too, as it does in the app
+    auto view = std::make_unique<magda::MainView>();
+    view->setBounds(0, 0, kViewWidth, kViewHeight);
+    paintMs(*view);
+    analysis.addPoint("startup", size, juce::Time::getMillisecondCounterHiRes() - startupStart);
+    analysis.addPoint("repaint", size, paintMs(*view));
+
+    analysis.addPoint("sync.incremental", size, timeMs([&] {
+                          for (auto clipId : project.clips) {
+                              if (const auto* clip = cm.getClip(clipId)) {
+                                  cm.moveClip(clipId, clip->startTime + 0.25, kTempo);
+                              }
+                          }
+                          for (auto trackId : project.tracks) {
+                              tm.setTrackVolume(trackId, 0.8f);
+                          }
+                          flushSync(bridge);
+                      }));
+
+    auto& selection = magda::SelectionManager::getInstance();
+    const std::unordered_set<magda::ClipId> allClips(project.clips.begin(), project.clips.end());
+    analysis.addPoint("selection", size, timeMs([&] {
+                          selection.selectClips(allClips);
+                          selection.selectTimeRange(0.0, config.getProjectLength(),
+                                                    project.tracks);
+                          selection.clearSelection();
+                      }));
+
+    // In kilobytes, so the floor never clips a real figure
+    analysis.addPoint(
+        "memory", size,
+        magda::MemoryAccounting::getTotalBytes(magda::MemoryAccounting::getInstance().collect()) /
+            1024.0);
+
+    view.reset();
+    engine->shutdown();
+    engine.reset();
+    clearModel();
+    return true;
+}
+
+int runScaling(const juce::ArgumentList& args, BenchConfig config,
+               const juce::File& outputFile) {
+    std::vector<int> sizes;
+    for (const auto& token :
+         juce::StringArray::fromTokens(args.getValueForOption("--sizes"), ",", "")) {
+        if (token.getIntValue() > 0) {
+            sizes.push_back(token.getIntValue());
+        }
+    }
+    if (sizes.empty()) {
+        sizes = {125, 250, 500, 1000};
+    }
+    if (args.getValueForOption("--clips").isEmpty()) {
+        config.clipsPerTrack = 100;
+    }
+    // Kept light so the largest size (100k clips by default) fits in memory
+    config.notesPerClip = std::min(config.notesPerClip, 4);
+    config.automationPoints = std::min(config.automationPoints, 32);
+    config.rackDepth = std::min(config.rackDepth, 1);
+
+    magda::FontManager::getInstance().initialize();
+    magda::ScalingAnalysis analysis(doubleOption(args, "--slack", 0.3));
+    setScalingTargets(analysis);
+
+    int exitCode = 0;
+    for (auto tracks : sizes) {
+        config.tracks = tracks;
+        std::cout << "magda_bench: " << tracks << " tracks, " << tracks * config.clipsPerTrack
+                  << " clips" << std::endl;
+        if (!runScalingSize(config, analysis)) {
+            exitCode = kExitError;
+            break;
+        }
+    }
+    magda::FontManager::getInstance().shutdown();
+    if (exitCode != 0) {
+        return exitCode;
+    }
+
+    if (!outputFile.replaceWithText(analysis.toJSON())) {
+        std::cerr << "magda_bench: can't write " << outputFile.getFullPathName() << std::endl;
+        return kExitError;
+    }
+
+    std::cout << "\nMetric              target        exponent   allowed\n";
+    for (const auto& verdict : analysis.getVerdicts()) {
+        std::cout << verdict.metric.paddedRight(' ', 18)
+                  << juce::String(magda::ScalingAnalysis::getComplexityName(verdict.target))
+                         .paddedRight(' ', 14)
+                  << juce::String(verdict.exponent, 2).paddedLeft(' ', 8)
+                  << juce::String(verdict.allowed, 2).paddedLeft(' ', 10)
+                  << (verdict.pass ? "" : "  GROWS TOO FAST") << "\n";
+    }
+    std::cout << "\nResults written to " << outputFile.getFullPathName() << std::endl;
+    return analysis.getFailures().empty() ? 0 : kExitRegression;
+}
+
+// =============================================================================
+// Render check
+// =============================================================================
+
+using RenderStatus = magda::RenderInterface::RenderStatus;
+
+struct RenderCheckConfig {
+    std::vector<juce::File> projects;
+    juce::File goldenDir;
+    int iterations = 3;
+    double toleranceDb = -80.0;  // Largest sample difference allowed off the built-in path
+    bool updateGolden = false;
+};
+
+std::vector<juce::File> findProjects(const juce::File& fileOrDir) {
+    if (!fileOrDir.isDirectory()) {
+        return {fileOrDir};
+    }
+    auto found = fileOrDir.findChildFiles(juce::File::findFiles, false, "*.magda");
+    found.sort();
+    return {found.begin(), found.end()};
+}
+
+bool readAudio(const juce::File& file, juce::AudioBuffer<float>& buffer) {
+    juce::AudioFormatManager formats;
+    formats.registerBasicFormats();
+    std::unique_ptr<juce::AudioFormatReader> reader(formats.createReaderFor(file));
+    if (reader == nullptr || reader->lengthInSamples > std::numeric_limits<int>::max()) {
+        return false;
+    }
+    buffer.setSize(static_cast<int>(reader->numChannels),
+                   static_cast<int>(reader->lengthInSamples));
+    return reader->read(&buffer, 0, buffer.getNumSamples(), 0, true, true);
+}
+
+/**
+ * @brief Renders each reference project and checks the output against its golden copy
+ *
+ * Per project: the mix is rendered --iterations times for the realtime factor (edit length
+ * over wall time) and the per-thread utilisation, then the stems once. Each file is then
+ * compared with golden/<project>/ - bit-exact when only MAGDA's own devices are on its
+ * tracks, within the tolerance otherwise - or, with --update-golden, copied there instead.
+ * Renders are 32-bit float so the comparison sees every bit the engine produced.
+ *
+ * Wall time is measured to HeadlessHost reporting the job done, which it polls for, so
+ * each render reads up to one poll interval long; keep reference projects long enough
+ * for that not to matter.
+ *
+ * Runs on the message loop and stops it when done.
+ */
+class RenderCheckRun {
+  public:
+    RenderCheckRun(magda::HeadlessHost& host, RenderCheckConfig config)
+        : host_(host), config_(std::move(config)) {
+        report_.setConfig("iterations", config_.iterations);
+        report_.setConfig("toleranceDb", config_.toleranceDb);
+        report_.setConfig("cpu", juce::SystemStats::getCpuModel());
+        report_.setConfig("os", juce::SystemStats::getOperatingSystemName());
+    }
+
+    ~RenderCheckRun() {
+        workDir_.deleteRecursively();
+    }
+
+    void start() {
+        workDir_ = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                       .getNonexistentChildFile("magda_render_check", "", false);
+        if (!workDir_.createDirectory()) {
+            finish(kExitError, "can't create " + workDir_.getFullPathName());
+            return;
+        }
+        openNext();
+    }
+
+    int getExitCode() const {
+        return exitCode_;
+    }
+
+    const magda::BenchmarkReport& getReport() const {
+        return report_;
+    }
+
+    /**
+     * @brief The report plus, per project, its realtime factor, busiest threads and files
+     */
+    juce::var toVar() const {
+        auto result = report_.toVar();
+        result.getDynamicObject()->setProperty("renders", renders_);
+        return result;
+    }
+
+  private:
+    struct FileCheck {
+        juce::String name;  // Relative to the project's golden directory
+        bool exact = false;
+    };
+
+    void openNext() {
+        if (projectIndex_ >= config_.projects.size()) {
+            finish(exitCode_);
+            return;
+        }
+
+        const auto& file = config_.projects[projectIndex_];
+        std::cout << "magda_bench: " << file.getFileName() << std::endl;
+        host_.openProject(file, [this](const juce::String& error) {
+            if (error.isNotEmpty()) {
+                finish(kExitError, "can't open " +
+                                       config_.projects[projectIndex_].getFileName() + ": " +
+                                       error);
+                return;
+            }
+            beginProject();
+        });
+    }
+
+    void beginProject() {
+        project_ = config_.projects[projectIndex_].getFileNameWithoutExtension();
+        outputDir_ = workDir_.getChildFile(project_);
+        outputDir_.getChildFile("stems").createDirectory();
+        iteration_ = 0;
+        renderWallSeconds_ = 0.0;
+        threadSeconds_.clear();
+        threadNames_.clear();
+
+        // The stems OfflineRenderer writes for "all tracks", in its order
+        stemsExact_.clear();
+        allExact_ = true;
+        auto* bridge = host_.getEngine()->getAudioBridge();
+        for (const auto& track : magda::TrackManager::getInstance().getTracks()) {
+            if (bridge != nullptr && bridge->getAudioTrack(track.id) != nullptr) {
+                const bool exact = magda::usesOnlyBuiltInDevices(track.chainElements);
+                stemsExact_.push_back(exact);
+                allExact_ = allExact_ && exact;
+            }
+        }
+        renderMix();
+    }
+
+    magda::RenderInterface::RenderRequest makeRequest(const juce::File& output,
+                                                      bool stems) const {
+        magda::RenderInterface::RenderRequest request;
+        request.output_path = output.getFullPathName().toStdString();
+        request.stems = stems;
+        request.bit_depth = 32;
+        return request;
+    }
+
+    void renderMix() {
+        const auto before = magda::ThreadCpuSampler::sample();
+        const double startMs = juce::Time::getMillisecondCounterHiRes();
+        auto onDone = [this, before, startMs](const std::string& id, RenderStatus status) {
+            const double wallMs = juce::Time::getMillisecondCounterHiRes() - startMs;
+            if (status != RenderStatus::Finished) {
+                finish(kExitError, "mix render failed: " +
+                                       juce::String(host_.getRenderer()->getRenderError(id)));
+                return;
+            }
+
+            report_.addSample("render." + project_, wallMs);
+            renderWallSeconds_ += wallMs / 1000.0;
+            for (const auto& thread : magda::ThreadCpuSampler::utilisation(
+                     before, magda::ThreadCpuSampler::sample(), wallMs / 1000.0, 0.0)) {
+                threadSeconds_[thread.id] += thread.fraction * wallMs / 1000.0;
+                threadNames_[thread.id] = thread.name;
+            }
+
+            if (++iteration_ < config_.iterations) {
+                renderMix();
+            } else {
+                renderStems();
+            }
+        };
+        if (host_.render(makeRequest(outputDir_.getChildFile("mix.wav"), false), onDone)
+                .empty()) {
+            finish(kExitError, "no project to render");
+        }
+    }
+
+    void renderStems() {
+        auto onDone = [this](const std::string& id, RenderStatus status) {
+            if (status != RenderStatus::Finished) {
+                finish(kExitError, "stem render failed: " +
+                                       juce::String(host_.getRenderer()->getRenderError(id)));
+                return;
+            }
+
+            std::vector<FileCheck> files{{"mix.wav", allExact_}};
+            const auto stems = host_.getRenderer()->getRenderedFiles(id);
+            for (size_t i = 0; i < stems.size(); ++i) {
+                files.push_back({"stems/" + juce::File(stems[i]).getFileName(),
+                                 i < stemsExact_.size() && stemsExact_[i]});
+            }
+            checkProject(files);
+            ++projectIndex_;
+            openNext();
+        };
+        if (host_.render(makeRequest(outputDir_.getChildFile("stems"), true), onDone).empty()) {
+            finish(kExitError, "no project to render");
+        }
+    }
+
+    void checkProject(const std::vector<FileCheck>& files) {
+        const double length = host_.getEngine()->getEdit()->getLength().inSeconds();
+        const auto stats = report_.getStats("render." + project_);
+        const double realtimeFactor =
+            stats && stats->medianMs > 0.0 ? length / (stats->medianMs / 1000.0) : 0.0;
+        std::cout << "  " << juce::String(length, 1) << " s rendered at "
+                  << juce::String(realtimeFactor, 1) << "x realtime" << std::endl;
+
+        auto* entry = new juce::DynamicObject();
+        entry->setProperty("project", project_);
+        entry->setProperty("lengthSeconds", length);
+        entry->setProperty("realtimeFactor", realtimeFactor);
+
+        // Busiest first, over every timed render of the project
+        std::vector<std::pair<double, juce::int64>> busiest;
+        for (const auto& [id, seconds] : threadSeconds_) {
+            if (renderWallSeconds_ > 0.0 && seconds / renderWallSeconds_ >= 0.01) {
+                busiest.emplace_back(seconds / renderWallSeconds_, id);
+            }
+        }
+        std::sort(busiest.rbegin(), busiest.rend());
+        juce::Array<juce::var> threads;
+        for (const auto& [fraction, id] : busiest) {
+            auto* thread = new juce::DynamicObject();
+            thread->setProperty("name", threadNames_[id]);
+            thread->setProperty("utilisation", fraction);
+            threads.add(juce::var(thread));
+            std::cout << "    " << threadNames_[id].paddedRight(' ', 20)
+                      << juce::String(fraction * 100.0, 0).paddedLeft(' ', 4) << "%"
+                      << std::endl;
+        }
+        entry->setProperty("threads", threads);
+
+        const auto goldenDir = config_.goldenDir.getChildFile(project_);
+        juce::Array<juce::var> results;
+        for (const auto& file : files) {
+            results.add(checkFile(file, outputDir_.getChildFile(file.name),
+                                  goldenDir.getChildFile(file.name)));
+        }
+        entry->setProperty("files", results);
+        renders_.add(juce::var(entry));
+    }
+
+    juce::var checkFile(const FileCheck& file, const juce::File& rendered,
+                        const juce::File& golden) {
+        auto* result = new juce::DynamicObject();
+        result->setProperty("file", file.name);
+        result->setProperty("exact", file.exact);
+
+        if (config_.updateGolden) {
+            golden.getParentDirectory().createDirectory();
+            const bool copied = rendered.copyFileTo(golden);
+            std::cout << "  " << (copied ? "updated " : "CAN'T WRITE ") << file.name
+                      << std::endl;
+            if (!copied) {
+                exitCode_ = kExitError;
+            }
+            result->setProperty("updated", copied);
+            return juce::var(result);
+        }
+
+        juce::AudioBuffer<float> goldenAudio, renderedAudio;
+        if (!readAudio(golden, goldenAudio) || !readAudio(rendered, renderedAudio)) {
+            std::cout << "  NO GOLDEN " << file.name << std::endl;
+            exitCode_ = kExitError;
+            result->setProperty("pass", false);
+            return juce::var(result);
+        }
+
+        const auto comparison = magda::RenderComparison::compare(goldenAudio, renderedAudio);
+        const bool pass = comparison.passes(file.exact, config_.toleranceDb);
+        if (!pass && exitCode_ == 0) {
+            exitCode_ = kExitRegression;
+        }
+        result->setProperty("pass", pass);
+        result->setProperty("bitExact", comparison.bitExact);
+        result->setProperty("maxDiffDb", comparison.getMaxDiffDb());
+        result->setProperty("firstDifference", comparison.firstDifference);
+
+        std::cout << "  " << (pass ? "ok       " : "MISMATCH ") << file.name;
+        if (!comparison.sameShape) {
+            std::cout << " (length or channels differ)";
+        } else if (!comparison.bitExact) {
+            std::cout << " (max diff " << juce::String(comparison.getMaxDiffDb(), 1)
+                      << " dB from sample " << comparison.firstDifference
+                      << (file.exact ? ", must be bit-exact" : "") << ")";
+        }
+        std::cout << std::endl;
+        return juce::var(result);
+    }
+
+    void finish(int exitCode, const juce::String& error = {}) {
+        if (error.isNotEmpty()) {
+            std::cerr << "magda_bench: " << error << std::endl;
+        }
+        exitCode_ = exitCode;
+        juce::MessageManager::getInstance()->stopDispatchLoop();
+    }
+
+    magda::HeadlessHost& host_;
+    const RenderCheckConfig config_;
+    magda::BenchmarkReport report_;
+    juce::Array<juce::var> renders_;
+    juce::File workDir_;
+    int exitCode_ = 0;
+
+    // Current project
+    size_t projectIndex_ = 0;
+    juce::String project_;
+    juce::File outputDir_;
+    int iteration_ = 0;
+    std::vector<bool> stemsExact_;
+    bool allExact_ = true;
+    double renderWallSeconds_ = 0.0;
+    std::map<juce::int64, double> threadSeconds_;  // CPU seconds over the timed renders
+    std::map<juce::int64, juce::String> threadNames_;
+};
+
+int runRenderCheck(const juce::ArgumentList& args, const juce::File& outputFile,
+                   double tolerance) {
+    RenderCheckConfig config;
+    config.projects = findProjects(args.getFileForOption("--render-check"));
+    config.goldenDir = args.getFileForOption("--golden");
+    config.iterations = std::max(1, intOption(args, "--iterations", config.iterations));
+    config.updateGolden = args.containsOption("--update-golden");
+    if (const auto db = args.getValueForOption("--tolerance-db"); db.isNotEmpty()) {
+        config.toleranceDb = db.getDoubleValue();
+    }
+
+    if (config.projects.empty() || !config.projects.front().existsAsFile()) {
+        std::cerr << "magda_bench: no projects in "
+                  << args.getFileForOption("--render-check").getFullPathName() << std::endl;
+        return kExitError;
+    }
+    if (!args.containsOption("--golden")) {
+        std::cerr << "magda_bench: --render-check needs --golden=DIR" << std::endl;
+        return kExitError;
+    }
+
+    int exitCode = kExitError;
+    {
+        magda::HeadlessHost host;
+        if (!host.initialize()) {
+            std::cerr << "magda_bench: failed to initialize the audio engine" << std::endl;
+        } else {
+            RenderCheckRun run(host, config);
+            juce::MessageManager::callAsync([&run] { run.start(); });
+            juce::MessageManager::getInstance()->runDispatchLoop();
+            exitCode = run.getExitCode();
+
+            if (exitCode != kExitError) {
+                if (!outputFile.replaceWithText(juce::JSON::toString(run.toVar()))) {
+                    std::cerr << "magda_bench: can't write " << outputFile.getFullPathName()
+                              << std::endl;
+                    exitCode = kExitError;
+                } else {
+                    std::cout << "\nResults written to " << outputFile.getFullPathName()
+                              << std::endl;
+                    if (exitCode == 0 && args.containsOption("--baseline")) {
+                        exitCode = compareWithBaseline(
+                            run.getReport(), args.getFileForOption("--baseline"), tolerance);
+                    }
+                }
+            }
+        }
+        host.shutdown();
+    }
+    return exitCode;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    juce::ArgumentList args(argc, argv);
+    if (args.containsOption("--help|-h")) {
+        printUsage();
+        return 0;
+    }
+
+    BenchConfig config;
+    config.tracks = intOption(args, "--tracks", config.tracks);
+    config.clipsPerTrack = intOption(args, "--clips", config.clipsPerTrack);
+    config.rackDepth = intOption(args, "--rack-depth", config.rackDepth);
+    config.automationPoints = intOption(args, "--points", config.automationPoints);
+    config.notesPerClip = intOption(args, "--notes", config.notesPerClip);
+    config.iterations = std::max(1, intOption(args, "--iterations", config.iterations));
+    config.renderSeconds = doubleOption(args, "--render-seconds", config.renderSeconds);
+    config.render = !args.containsOption("--no-render") && config.renderSeconds > 0.0;
+    const double tolerance = doubleOption(args, "--tolerance", 0.15);
+
+    const bool scaling = args.containsOption("--scaling");
+    const bool renderCheck = args.containsOption("--render-check");
+    const auto outputFile =
+        args.containsOption("--output")
+            ? args.getFileForOption("--output")
+            : juce::File::getCurrentWorkingDirectory().getChildFile(
+                  scaling ? "magda_scaling.json"
+                          : (renderCheck ? "magda_render.json" : "magda_bench.json"));
+
+    // The engine, AudioBridge and managers expect a message thread; this is it
+    juce::ScopedJuceInitialiser_GUI juceInit;
+
+    if (renderCheck) {
+        const int exitCode = runRenderCheck(args, outputFile, tolerance);
+        magda::ModulatorEngine::getInstance().shutdown();
+        magda::TrackManager::getInstance().shutdown();
+        magda::ClipManager::getInstance().shutdown();
+        magda::AudioReaderCache::getInstance().shutdown();
+        return exitCode;
+    }
+
+    if (scaling) {
+        const int exitCode = runScaling(args, config, outputFile);
+        magda::TrackManager::getInstance().shutdown();
+        magda::ClipManager::getInstance().shutdown();
+        return exitCode;
+    }
+
+    magda::BenchmarkReport report;
+    recordConfig(config, report);
+
+    int exitCode = 0;
+    for (int i = 0; i < config.iterations; ++i) {
+        std::cout << "magda_bench: iteration " << (i + 1) << "/" << config.iterations
+                  << std::endl;
+        if (!runIteration(config, report)) {
+            exitCode = kExitError;
+            break;
+        }
+    }
+
+    if (exitCode == 0) {
+        if (!outputFile.replaceWithText(report.toJSON())) {
+            std::cerr << "magda_bench: can't write " << outputFile.getFullPathName()
+                      << std::endl;
+            exitCode = kExitError;
+        } else {
+            std::cout << "\nPhase               median ms      min ms      max ms\n";
+            for (const auto& name : report.getPhaseNames()) {
+                const auto stats = *report.getStats(name);
+                std::cout << name.paddedRight(' ', 18) << juce::String(stats.medianMs, 3)
+                                                              .paddedLeft(' ', 11)
+                          << juce::String(stats.minMs, 3).paddedLeft(' ', 12)
+                          << juce::String(stats.maxMs, 3).paddedLeft(' ', 12) << "\n";
+            }
+            std::cout << "\nSubsystem memory (peak)\n";
+            for (const auto& [subsystem, bytes] : report.getMemory()) {
+                std::cout << subsystem.paddedRight(' ', 22)
+                          << magda::MemoryAccounting::formatBytes(bytes).paddedLeft(' ', 12)
+                          << "\n";
+            }
+            std::cout << "\nResults written to " << outputFile.getFullPathName() << std::endl;
+
+            if (args.containsOption("--baseline")) {
+                exitCode = compareWithBaseline(report, args.getFileForOption("--baseline"),
+                                               tolerance);
+            }
+        }
+    }
+
+    // Release JUCE objects held by the singletons while JUCE is still alive
+    magda::TrackManager::getInstance().shutdown();
+    magda::ClipManager::getInstance().shutdown();
+    return exitCode;
+}
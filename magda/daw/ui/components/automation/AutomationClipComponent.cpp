@@ -1,5 +1,7 @@
 #include "AutomationClipComponent.hpp"
 
+#include <vector>
+
 #include "AutomationLaneComponent.hpp"
 
 namespace magda {
@@ -79,20 +81,24 @@ void AutomationClipComponent::paintMiniCurve(juce::Graphics& g, juce::Rectangle<
     if (!clip || clip->points.empty())
         return;
 
-    juce::Path curvePath;
-    bool pathStarted = false;
+    const int width = bounds.getWidth();
+    if (width <= 0 || clip->length <= 0.0)
+        return;
 
-    for (const auto& point : clip->points) {
-        // Map point to bounds
-        float x = bounds.getX() + static_cast<float>(point.time / clip->length) * bounds.getWidth();
-        float y = bounds.getBottom() - static_cast<float>(point.value) * bounds.getHeight();
+    // One value per pixel, so tension and bezier segments draw as curves
+    std::vector<float> values(static_cast<size_t>(width));
+    AutomationManager::getInstance().renderClipValues(clipId_, 0.0, clip->length, values.data(),
+                                                      width);
 
-        if (!pathStarted) {
+    juce::Path curvePath;
+    for (int i = 0; i < width; ++i) {
+        float x = static_cast<float>(bounds.getX() + i);
+        float y = bounds.getBottom() - values[static_cast<size_t>(i)] * bounds.getHeight();
+
+        if (i == 0)
             curvePath.startNewSubPath(x, y);
-            pathStarted = true;
-        } else {
+        else
             curvePath.lineTo(x, y);
-        }
     }
 
     // Draw curve
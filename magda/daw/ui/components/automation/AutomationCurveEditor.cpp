@@ -254,14 +254,11 @@ void AutomationCurveEditor::syncSelectionState() {
                           selection.laneId == laneId_ &&
                           (clipId_ == INVALID_AUTOMATION_CLIP_ID || selection.clipId == clipId_);
 
-    for (auto& pc : pointComponents_) {
-        bool isSelected = false;
-        if (isOurSelection) {
-            isSelected = std::find(selection.pointIds.begin(), selection.pointIds.end(),
-                                   pc->getPointId()) != selection.pointIds.end();
-        }
-        pc->setSelected(isSelected);
+    std::vector<uint32_t> selectedIds;
+    if (isOurSelection) {
+        selectedIds.assign(selection.pointIds.begin(), selection.pointIds.end());
     }
+    setSelectedPoints(selectedIds);
 
     repaint();
 }
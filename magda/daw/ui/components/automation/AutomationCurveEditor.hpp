@@ -55,7 +55,11 @@ class AutomationCurveEditor : public CurveEditorBase,
 
     // Coordinate conversion
     void setPixelsPerSecond(double pps) {
-        pixelsPerSecond_ = pps;
+        if (pixelsPerSecond_ != pps) {
+            pixelsPerSecond_ = pps;
+            updatePointPositions();
+            repaint();
+        }
     }
     double getPixelsPerSecond() const {
         return pixelsPerSecond_;
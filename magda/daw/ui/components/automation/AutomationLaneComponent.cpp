@@ -3,6 +3,7 @@
 #include <cmath>
 #include <vector>
 
+#include "../../../core/AutomationRecorder.hpp"
 #include "../../../core/ParameterUtils.hpp"
 
 namespace magda {
@@ -298,15 +299,36 @@ void AutomationLaneComponent::showContextMenu() {
     // Hide Lane option
     menu.addItem(1, "Hide Lane");
 
+    // Recording: arming is per lane, the mode applies to every armed lane
+    const auto* lane = getLaneInfo();
+    menu.addSeparator();
+    menu.addItem(2, "Arm for Recording", lane && lane->isAbsolute(), lane && lane->armed);
+
+    constexpr int kRecordModeItemBase = 10;
+    const auto currentMode = AutomationRecorder::getInstance().getMode();
+    juce::PopupMenu modeMenu;
+    for (auto mode : {AutomationRecordMode::Off, AutomationRecordMode::Write,
+                      AutomationRecordMode::Touch, AutomationRecordMode::Latch}) {
+        modeMenu.addItem(kRecordModeItemBase + static_cast<int>(mode), getRecordModeName(mode),
+                         true, mode == currentMode);
+    }
+    menu.addSubMenu("Record Mode", modeMenu);
+
     // Show menu
     auto options = juce::PopupMenu::Options().withTargetComponent(this);
 
     auto laneId = laneId_;  // Capture for lambda
-    menu.showMenuAsync(options, [laneId](int result) {
+    const bool armed = lane && lane->armed;
+    menu.showMenuAsync(options, [laneId, armed](int result) {
         if (result == 1) {
             // Defer to avoid destroying component during callback
             juce::MessageManager::callAsync(
                 [laneId]() { AutomationManager::getInstance().setLaneVisible(laneId, false); });
+        } else if (result == 2) {
+            AutomationManager::getInstance().setLaneArmed(laneId, !armed);
+        } else if (result >= kRecordModeItemBase) {
+            AutomationRecorder::getInstance().setMode(
+                static_cast<AutomationRecordMode>(result - kRecordModeItemBase));
         }
     });
 }
@@ -350,31 +350,58 @@ DeviceSlotComponent::DeviceSlotComponent(const magda::DeviceInfo& device) : devi
         createCustomUI();
     }
 
-    // Start timer to sync UI button state with actual window state (10 FPS)
-    startTimer(100);
+    // Follow the bridge's status events for this device instead of polling
+    auto* audioEngine = magda::TrackManager::getInstance().getAudioEngine();
+    if (auto* bridge = audioEngine ? audioEngine->getAudioBridge() : nullptr) {
+        statusSubscription_ = bridge->subscribeToEvents(
+            magda::AudioEvent::Type::DeviceStatusChanged, [this](const magda::AudioEvent& event) {
+                if (event.data1 == magda::INVALID_DEVICE_ID || event.data1 == device_.id) {
+                    refreshStatus();
+                }
+            });
+    }
+    refreshStatus();
 }
 
 DeviceSlotComponent::~DeviceSlotComponent() {
     magda::TrackManager::getInstance().removeListener(this);
-    stopTimer();
 }
 
-void DeviceSlotComponent::timerCallback() {
-    // Update UI button state to match actual plugin window state
-    if (uiButton_) {
-        auto* audioEngine = magda::TrackManager::getInstance().getAudioEngine();
-        if (audioEngine) {
-            if (auto* bridge = audioEngine->getAudioBridge()) {
-                bool isOpen = bridge->isPluginWindowOpen(device_.id);
-                bool currentState = uiButton_->getToggleState();
-
-                // Only update if state changed to avoid unnecessary repaints
-                if (isOpen != currentState) {
-                    uiButton_->setToggleState(isOpen, juce::dontSendNotification);
-                    uiButton_->setActive(isOpen);
-                }
+void DeviceSlotComponent::refreshStatus() {
+    auto* audioEngine = magda::TrackManager::getInstance().getAudioEngine();
+    auto* bridge = audioEngine ? audioEngine->getAudioBridge() : nullptr;
+
+    // Show a placeholder until the plugin is instantiated, then pick up its parameters
+    const bool loading = bridge && bridge->isDeviceLoading(device_.id);
+    if (loading != loading_) {
+        loading_ = loading;
+        if (!loading_) {
+            if (auto* device =
+                    magda::TrackManager::getInstance().getDeviceInChainByPath(nodePath_)) {
+                updateFromDevice(*device);
             }
         }
+        repaint();
+    }
+
+    // Update UI button state to match actual plugin window state
+    if (uiButton_ && bridge) {
+        bool isOpen = bridge->isPluginWindowOpen(device_.id);
+        bool currentState = uiButton_->getToggleState();
+
+        // Only update if state changed to avoid unnecessary repaints
+        if (isOpen != currentState) {
+            uiButton_->setToggleState(isOpen, juce::dontSendNotification);
+            uiButton_->setActive(isOpen);
+        }
+    }
+
+    // CPU overlay while device measurement is on
+    if (bridge && bridge->isDeviceCpuMeasurementEnabled()) {
+        const auto reading = bridge->getDeviceCpuReading(device_.id);
+        setCpuUsage(reading.load, reading.measured);
+    } else {
+        clearCpuUsage();
     }
 }
 
@@ -557,6 +584,12 @@ void DeviceSlotComponent::paintContent(juce::Graphics& g, juce::Rectangle<int> c
     g.setFont(FontManager::getInstance().getUIFont(9.0f));
     juce::String headerText = device_.manufacturer + " / " + device_.name;
     g.drawText(headerText, headerArea.reduced(2, 0), juce::Justification::centredLeft);
+
+    if (loading_) {
+        g.setColour(DarkTheme::getSecondaryTextColour().withAlpha(0.7f));
+        g.setFont(FontManager::getInstance().getUIFont(11.0f));
+        g.drawText("Loading...", contentArea, juce::Justification::centred);
+    }
 }
 
 void DeviceSlotComponent::resizedContent(juce::Rectangle<int> contentArea) {
@@ -1103,12 +1136,74 @@ void DeviceSlotComponent::mouseDown(const juce::MouseEvent& e) {
                 uiButton_->setActive(isOpen);
             }
         }
+    } else if (e.mods.isPopupMenu()) {
+        showDeviceMenu();
     } else {
         // Pass to base class for normal click handling
         NodeComponent::mouseDown(e);
     }
 }
 
+void DeviceSlotComponent::showDeviceMenu() {
+    // A/B comparison: switch between the device's state slots, or copy the current state
+    const auto deviceId = device_.id;
+    const char* const names[] = {"A", "B"};
+    static_assert(std::size(names) == magda::DeviceInfo::kNumStateSlots);
+
+    juce::PopupMenu menu;
+    juce::Component::SafePointer<DeviceSlotComponent> safe(this);
+    for (int slot = 0; slot < magda::DeviceInfo::kNumStateSlots; ++slot) {
+        menu.addItem(juce::String("State ") + names[slot], true, device_.activeStateSlot == slot,
+                     [safe, deviceId, slot] {
+                         auto& tm = magda::TrackManager::getInstance();
+                         if (tm.switchDeviceStateSlot(deviceId, slot) && safe != nullptr) {
+                             if (const auto* device = tm.findDevice(deviceId)) {
+                                 safe->updateFromDevice(*device);
+                             }
+                         }
+                     });
+    }
+    menu.addSeparator();
+    for (int slot = 0; slot < magda::DeviceInfo::kNumStateSlots; ++slot) {
+        if (slot != device_.activeStateSlot) {
+            menu.addItem(juce::String("Copy to ") + names[slot], [deviceId, slot] {
+                magda::TrackManager::getInstance().copyDeviceStateToSlot(deviceId, slot);
+            });
+        }
+    }
+
+    // How far renders of this device's track are oversampled (live playback isn't)
+    menu.addSeparator();
+    juce::PopupMenu oversampling;
+    for (int factor : {1, 2, 4}) {
+        oversampling.addItem(factor == 1 ? juce::String("Off") : juce::String(factor) + "x", true,
+                             device_.oversampling == factor, [safe, deviceId, factor] {
+                                 auto& tm = magda::TrackManager::getInstance();
+                                 tm.setDeviceOversampling(deviceId, factor);
+                                 const auto* device = tm.findDevice(deviceId);
+                                 if (device != nullptr && safe != nullptr) {
+                                     safe->device_.oversampling = device->oversampling;
+                                 }
+                             });
+    }
+    menu.addSubMenu("Render Oversampling", oversampling);
+
+    // A plugin that crashes in its own process leaves the DAW running
+    if (device_.format != magda::PluginFormat::Internal) {
+        menu.addItem("Run in Separate Process", true, device_.sandboxed, [safe, deviceId] {
+            auto& tm = magda::TrackManager::getInstance();
+            const auto* device = tm.findDevice(deviceId);
+            if (device != nullptr) {
+                tm.setDeviceSandboxed(deviceId, !device->sandboxed);
+                if (safe != nullptr) {
+                    safe->device_.sandboxed = device->sandboxed;
+                }
+            }
+        });
+    }
+    menu.showMenuAsync(juce::PopupMenu::Options());
+}
+
 // =============================================================================
 // Custom UI for Internal Devices
 // =============================================================================
@@ -6,6 +6,7 @@
 #include "ParamSlotComponent.hpp"
 #include "ToneGeneratorUI.hpp"
 #include "core/DeviceInfo.hpp"
+#include "core/Subscription.hpp"
 #include "core/TrackManager.hpp"
 #include "ui/components/common/SvgButton.hpp"
 #include "ui/components/common/TextSlider.hpp"
@@ -24,15 +25,17 @@ namespace magda::daw::ui {
  * Listens to TrackManager::deviceParameterChanged() to update UI when parameters
  * change from plugin side (preset loads, automation, native UI edits).
  *
+ * Plugin load state, editor window state and the CPU overlay follow the AudioBridge's
+ * DeviceStatusChanged events rather than a timer per slot; the slot reads its device's
+ * status only when the event names it (or several devices) and repaints only what changed.
+ *
  * Layout:
  *   [Header: mod, macro, name, gain, ui, on, delete]
  *   [Content header: manufacturer / device name]
  *   [Pagination: < Page 1/4 >]
  *   [Params: 4 or 8 columns × 4 rows (dynamic based on param count)]
  */
-class DeviceSlotComponent : public NodeComponent,
-                            public juce::Timer,
-                            public magda::TrackManagerListener {
+class DeviceSlotComponent : public NodeComponent, public magda::TrackManagerListener {
   public:
     static constexpr int BASE_SLOT_WIDTH = 400;  // Maximum width (8 columns)
     static constexpr int NUM_PARAMS_PER_PAGE = 32;
@@ -124,9 +127,6 @@ class DeviceSlotComponent : public NodeComponent,
     // Mouse handling
     void mouseDown(const juce::MouseEvent& e) override;
 
-    // Timer callback (from juce::Timer) - for UI button state polling
-    void timerCallback() override;
-
     // TrackManagerListener - only implement parameter change notification
     void tracksChanged() override {}
     void deviceParameterChanged(magda::DeviceId deviceId, int paramIndex, float newValue) override;
@@ -141,6 +141,13 @@ class DeviceSlotComponent : public NodeComponent,
     std::unique_ptr<magda::SvgButton> uiButton_;
     std::unique_ptr<magda::SvgButton> onButton_;
 
+    // Plugin still being instantiated by the AudioBridge (shows a placeholder)
+    bool loading_ = false;
+
+    // UI button, plugin load state and CPU overlay, refreshed on DeviceStatusChanged
+    magda::Subscription statusSubscription_;
+    void refreshStatus();
+
     // Pagination
     int currentPage_ = 0;
     int totalPages_ = 1;
@@ -154,6 +161,7 @@ class DeviceSlotComponent : public NodeComponent,
     // Custom UI for internal devices
     std::unique_ptr<ToneGeneratorUI> toneGeneratorUI_;
 
+    void showDeviceMenu();
     void updatePageControls();
     void updateParamModulation();  // Update mod/macro pointers for params
     void updateParameterSlots();   // Reload parameter data for current page
@@ -12,13 +12,15 @@ LFOCurveEditor::LFOCurveEditor() {
     // Parent component should expand bounds by this amount
     setPadding(4);
 
+    // The phase indicator animates on its own layer, over a cached image of the curve
+    setBufferedToImage(true);
+    phaseOverlay_.setCurveColour(curveColour_);
+    addAndMakeVisible(phaseOverlay_);
+
     rebuildPointComponents();
-    startTimer(33);  // 30 FPS animation for phase indicator
 }
 
-LFOCurveEditor::~LFOCurveEditor() {
-    stopTimer();
-}
+LFOCurveEditor::~LFOCurveEditor() = default;
 
 void LFOCurveEditor::syncFromModInfo() {
     if (!modInfo_)
@@ -33,19 +35,14 @@ void LFOCurveEditor::syncFromModInfo() {
     }
 
     // Update point component positions
-    for (size_t i = 0; i < pointComponents_.size() && i < points_.size(); ++i) {
-        pointComponents_[i]->updateFromPoint(points_[i]);
-        int px = xToPixel(points_[i].x);
-        int py = yToPixel(points_[i].y);
-        pointComponents_[i]->setCentrePosition(px, py);
-    }
-
+    updatePointPositions();
     updateTensionHandlePositions();
     repaint();
 }
 
 void LFOCurveEditor::setModInfo(ModInfo* mod) {
     modInfo_ = mod;
+    phaseOverlay_.setModInfo(mod);
 
     // Load curve points from ModInfo
     points_.clear();
@@ -103,6 +100,17 @@ void LFOCurveEditor::setModInfo(ModInfo* mod) {
     repaint();
 }
 
+void LFOCurveEditor::setCurveColour(juce::Colour colour) {
+    CurveEditorBase::setCurveColour(colour);
+    phaseOverlay_.setCurveColour(colour);
+}
+
+void LFOCurveEditor::resized() {
+    CurveEditorBase::resized();
+    phaseOverlay_.setBounds(getLocalBounds());
+    phaseOverlay_.setContentArea(getContentBounds());
+}
+
 double LFOCurveEditor::getPixelsPerX() const {
     // X is phase 0-1, so pixels per X = content width
     auto content = getContentBounds();
@@ -227,9 +235,7 @@ void LFOCurveEditor::onPointSelected(uint32_t pointId) {
     selectedPointId_ = pointId;
 
     // Update selection state on point components
-    for (auto& pc : pointComponents_) {
-        pc->setSelected(pc->getPointId() == pointId);
-    }
+    setSelectedPoints({pointId});
 
     repaint();
 }
@@ -303,83 +309,12 @@ void LFOCurveEditor::onTensionDragPreview(uint32_t pointId, double tension) {
 
 bool LFOCurveEditor::keyPressed(const juce::KeyPress& key) {
     if (key == juce::KeyPress('c') || key == juce::KeyPress('C')) {
-        showCrosshair_ = !showCrosshair_;
-        repaint();
+        setShowCrosshair(!getShowCrosshair());
         return true;
     }
     return CurveEditorBase::keyPressed(key);
 }
 
-void LFOCurveEditor::timerCallback() {
-    if (!modInfo_)
-        return;
-
-    // Only repaint if phase/value changed (and only the indicator region)
-    float newPhase = modInfo_->phase;
-    float newValue = modInfo_->value;
-
-    if (std::abs(newPhase - lastPhase_) > 0.001f || std::abs(newValue - lastValue_) > 0.001f) {
-        // Repaint old indicator region
-        repaint(getIndicatorBounds());
-
-        // Update and repaint new region
-        lastPhase_ = newPhase;
-        lastValue_ = newValue;
-        repaint(getIndicatorBounds());
-    }
-}
-
-juce::Rectangle<int> LFOCurveEditor::getIndicatorBounds() const {
-    auto content = getContentBounds();
-    int x = content.getX() + static_cast<int>(lastPhase_ * content.getWidth());
-    int y = content.getY() + static_cast<int>((1.0f - lastValue_) * content.getHeight());
-
-    // Return a small region around the indicator dot
-    constexpr int margin = 8;
-    return juce::Rectangle<int>(x - margin, y - margin, margin * 2, margin * 2);
-}
-
-void LFOCurveEditor::paint(juce::Graphics& g) {
-    // Let base class paint background, grid, curve
-    CurveEditorBase::paint(g);
-
-    // Paint phase indicator on top
-    paintPhaseIndicator(g);
-}
-
-void LFOCurveEditor::paintPhaseIndicator(juce::Graphics& g) {
-    if (!modInfo_)
-        return;
-
-    auto content = getContentBounds();
-    float phase = modInfo_->phase;
-    float value = modInfo_->value;
-
-    int x = content.getX() + static_cast<int>(phase * content.getWidth());
-    int y = content.getY() + static_cast<int>((1.0f - value) * content.getHeight());
-
-    // Draw crosshair lines (toggle with 'C' key)
-    if (showCrosshair_) {
-        g.setColour(curveColour_.withAlpha(0.4f));
-        g.drawVerticalLine(x, static_cast<float>(content.getY()),
-                           static_cast<float>(content.getBottom()));
-        g.drawHorizontalLine(y, static_cast<float>(content.getX()),
-                             static_cast<float>(content.getRight()));
-    }
-
-    // Draw indicator dot
-    constexpr float dotSize = 5.0f;
-    constexpr float dotRadius = dotSize / 2.0f;
-    g.setColour(curveColour_);
-    g.fillEllipse(static_cast<float>(x) - dotRadius, static_cast<float>(y) - dotRadius, dotSize,
-                  dotSize);
-
-    // Draw white outline
-    g.setColour(juce::Colours::white);
-    g.drawEllipse(static_cast<float>(x) - dotRadius, static_cast<float>(y) - dotRadius, dotSize,
-                  dotSize, 1.0f);
-}
-
 void LFOCurveEditor::paintGrid(juce::Graphics& g) {
     auto bounds = getLocalBounds();
     float width = static_cast<float>(bounds.getWidth());
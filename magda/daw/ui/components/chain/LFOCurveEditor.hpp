@@ -6,6 +6,7 @@
 #include <memory>
 #include <vector>
 
+#include "LFOPhaseOverlay.hpp"
 #include "core/ModInfo.hpp"
 #include "ui/components/common/curve/CurveEditorBase.hpp"
 
@@ -20,9 +21,12 @@ namespace magda {
  * - Integration with ModInfo for waveform storage
  * - Animated phase indicator showing current LFO position
  *
+ * The phase indicator is drawn by an LFOPhaseOverlay child, and the editor is buffered to
+ * an image, so the animation repaints only the overlay and never re-renders the curve.
+ *
  * Used in the modulator editor panel for custom LFO shapes.
  */
-class LFOCurveEditor : public CurveEditorBase, private juce::Timer {
+class LFOCurveEditor : public CurveEditorBase {
   public:
     LFOCurveEditor();
     ~LFOCurveEditor() override;
@@ -55,12 +59,15 @@ class LFOCurveEditor : public CurveEditorBase, private juce::Timer {
     // Callback during drag for real-time preview sync
     std::function<void()> onDragPreview;
 
+    void setCurveColour(juce::Colour colour) override;
+    void resized() override;
+
     // Phase indicator crosshair toggle
     void setShowCrosshair(bool show) {
-        showCrosshair_ = show;
+        phaseOverlay_.setShowCrosshair(show);
     }
     bool getShowCrosshair() const {
-        return showCrosshair_;
+        return phaseOverlay_.getShowCrosshair();
     }
 
     // Grid settings
@@ -125,17 +132,13 @@ class LFOCurveEditor : public CurveEditorBase, private juce::Timer {
     void onTensionDragPreview(uint32_t pointId, double tension) override;
 
     void paintGrid(juce::Graphics& g) override;
-    void paint(juce::Graphics& g) override;
 
     // Handle C key for crosshair toggle
     bool keyPressed(const juce::KeyPress& key) override;
 
   private:
-    void timerCallback() override;
-    void paintPhaseIndicator(juce::Graphics& g);
-    juce::Rectangle<int> getIndicatorBounds() const;
-
     ModInfo* modInfo_ = nullptr;
+    LFOPhaseOverlay phaseOverlay_;
 
     // Local curve points for custom waveform
     mutable std::vector<CurvePoint> points_;
@@ -144,11 +147,6 @@ class LFOCurveEditor : public CurveEditorBase, private juce::Timer {
     // Selected point (local selection, not using SelectionManager)
     uint32_t selectedPointId_ = INVALID_CURVE_POINT_ID;
 
-    // Phase indicator state
-    bool showCrosshair_ = false;
-    float lastPhase_ = 0.0f;
-    float lastValue_ = 0.0f;
-
     // Grid settings
     int gridDivisionsX_ = 4;  // Vertical lines (phase divisions)
     int gridDivisionsY_ = 4;  // Horizontal lines (value divisions)
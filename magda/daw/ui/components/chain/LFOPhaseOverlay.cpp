@@ -4,161 +4,115 @@
 
 namespace magda {
 
+namespace {
+
+constexpr float kDotSize = 5.0f;
+// Around the dot, enough for its outline and antialiasing
+constexpr int kDotMargin = 8;
+
+}  // namespace
+
 LFOPhaseOverlay::LFOPhaseOverlay() {
     setInterceptsMouseClicks(false, false);  // Click-through to editor components
-    setOpaque(true);                         // Opaque to prevent flickering
-    startTimer(33);                          // 30 FPS animation
+    setOpaque(false);
 }
 
-LFOPhaseOverlay::~LFOPhaseOverlay() {
-    stopTimer();
-}
-
-void LFOPhaseOverlay::timerCallback() {
-    repaint();
-}
+LFOPhaseOverlay::~LFOPhaseOverlay() = default;
 
 bool LFOPhaseOverlay::hitTest(int /*x*/, int /*y*/) {
     return false;  // Always click-through
 }
 
-void LFOPhaseOverlay::paint(juce::Graphics& g) {
-    // Background (opaque)
-    g.fillAll(juce::Colour(0xFF1A1A1A));
+void LFOPhaseOverlay::setModInfo(const ModInfo* mod) {
+    repaintIndicator();
+    modInfo_ = mod;
+    frameClient_.setActive(modInfo_ != nullptr);  // 30 FPS animation
+    if (modInfo_) {
+        phase_ = modInfo_->phase;
+        value_ = modInfo_->value;
+    }
+    repaintIndicator();
+}
 
-    if (!modInfo_ || getWidth() <= 0 || getHeight() <= 0)
+void LFOPhaseOverlay::setShowCrosshair(bool show) {
+    if (show == showCrosshair_)
         return;
 
-    paintGrid(g);
-    paintCurve(g);
-    paintPhaseIndicator(g);
+    // Repaint while shown, so turning it off clears the lines
+    if (showCrosshair_)
+        repaintIndicator();
+    showCrosshair_ = show;
+    repaintIndicator();
 }
 
-void LFOPhaseOverlay::paintGrid(juce::Graphics& g) {
-    auto bounds = getLocalBounds();
+void LFOPhaseOverlay::setContentArea(juce::Rectangle<int> area) {
+    if (area == contentArea_)
+        return;
 
-    // Horizontal center line (0.5 value)
-    g.setColour(juce::Colour(0x20FFFFFF));
-    int centerY = bounds.getHeight() / 2;
-    g.drawHorizontalLine(centerY, 0.0f, static_cast<float>(bounds.getWidth()));
+    contentArea_ = area;
+    repaint();
+}
 
-    // Quarter lines (0.25, 0.75 value)
-    g.setColour(juce::Colour(0x10FFFFFF));
-    g.drawHorizontalLine(bounds.getHeight() / 4, 0.0f, static_cast<float>(bounds.getWidth()));
-    g.drawHorizontalLine(bounds.getHeight() * 3 / 4, 0.0f, static_cast<float>(bounds.getWidth()));
+void LFOPhaseOverlay::update() {
+    if (!modInfo_)
+        return;
 
-    // Vertical quarter lines (phase 0.25, 0.5, 0.75)
-    for (int i = 1; i < 4; ++i) {
-        int x = bounds.getWidth() * i / 4;
-        g.drawVerticalLine(x, 0.0f, static_cast<float>(bounds.getHeight()));
+    // Only repaint if phase/value changed, and only where the indicator was and is now
+    const float newPhase = modInfo_->phase;
+    const float newValue = modInfo_->value;
+    if (std::abs(newPhase - phase_) > 0.001f || std::abs(newValue - value_) > 0.001f) {
+        repaintIndicator();
+        phase_ = newPhase;
+        value_ = newValue;
+        repaintIndicator();
     }
+}
 
-    // Phase 0.5 line (center) slightly brighter
-    g.setColour(juce::Colour(0x20FFFFFF));
-    g.drawVerticalLine(bounds.getWidth() / 2, 0.0f, static_cast<float>(bounds.getHeight()));
+juce::Point<int> LFOPhaseOverlay::getIndicatorPosition() const {
+    return {contentArea_.getX() + static_cast<int>(phase_ * contentArea_.getWidth()),
+            contentArea_.getY() + static_cast<int>((1.0f - value_) * contentArea_.getHeight())};
 }
 
-void LFOPhaseOverlay::paintCurve(juce::Graphics& g) {
-    const auto* mod = modInfo_;
-    if (!mod)
+void LFOPhaseOverlay::repaintIndicator() {
+    if (!modInfo_)
         return;
 
-    if (mod->curvePoints.empty())
-        return;
+    const auto position = getIndicatorPosition();
+    repaint(juce::Rectangle<int>(position.x - kDotMargin, position.y - kDotMargin,
+                                 kDotMargin * 2, kDotMargin * 2));
 
-    const auto bounds = getLocalBounds();
-    const float width = static_cast<float>(bounds.getWidth());
-    const float height = static_cast<float>(bounds.getHeight());
-
-    juce::Path curvePath;
-    const auto& points = mod->curvePoints;
-
-    // Start at first point
-    float startX = points[0].phase * width;
-    float startY = (1.0f - points[0].value) * height;
-    curvePath.startNewSubPath(startX, startY);
-
-    // Draw segments between points
-    for (size_t i = 1; i < points.size(); ++i) {
-        const auto& p1 = points[i - 1];
-        const auto& p2 = points[i];
-
-        float x1 = p1.phase * width;
-        float y1 = (1.0f - p1.value) * height;
-        float x2 = p2.phase * width;
-        float y2 = (1.0f - p2.value) * height;
-
-        double tension = static_cast<double>(p1.tension);
-
-        if (std::abs(tension) < 0.001) {
-            // Pure linear
-            curvePath.lineTo(x2, y2);
-        } else {
-            // Tension-based curve
-            constexpr int NUM_SEGMENTS = 16;
-            for (int seg = 1; seg <= NUM_SEGMENTS; ++seg) {
-                double t = static_cast<double>(seg) / NUM_SEGMENTS;
-                double curvedT = applyTension(t, tension);
-
-                float segX = x1 + static_cast<float>(t) * (x2 - x1);
-                float segY = y1 + static_cast<float>(curvedT) * (y2 - y1);
-                curvePath.lineTo(segX, segY);
-            }
-        }
+    if (showCrosshair_) {
+        repaint(position.x - 1, contentArea_.getY(), 3, contentArea_.getHeight());
+        repaint(contentArea_.getX(), position.y - 1, contentArea_.getWidth(), 3);
     }
-
-    // Draw the curve
-    g.setColour(curveColour_);
-    g.strokePath(curvePath, juce::PathStrokeType(2.0f));
-
-    // Fill under curve
-    juce::Path fillPath = curvePath;
-    fillPath.lineTo(width, height);
-    fillPath.lineTo(0.0f, height);
-    fillPath.closeSubPath();
-    g.setColour(curveColour_.withAlpha(0.13f));
-    g.fillPath(fillPath);
 }
 
-void LFOPhaseOverlay::paintPhaseIndicator(juce::Graphics& g) {
-    const auto* mod = modInfo_;
-    if (!mod)
+void LFOPhaseOverlay::paint(juce::Graphics& g) {
+    if (!modInfo_ || contentArea_.isEmpty())
         return;
 
-    auto bounds = getLocalBounds();
-
-    float phase = mod->phase;
-    float value = mod->value;
-
-    int x = static_cast<int>(phase * bounds.getWidth());
-    int y = static_cast<int>((1.0f - value) * bounds.getHeight());
+    // Drawn where it was last repainted for, so the areas repainted stay in step
+    const auto position = getIndicatorPosition();
+    const float x = static_cast<float>(position.x);
+    const float y = static_cast<float>(position.y);
 
     // Draw crosshair lines (toggle with 'C' key)
     if (showCrosshair_) {
         g.setColour(curveColour_.withAlpha(0.4f));
-        g.drawVerticalLine(x, 0.0f, static_cast<float>(bounds.getHeight()));
-        g.drawHorizontalLine(y, 0.0f, static_cast<float>(bounds.getWidth()));
+        g.drawVerticalLine(position.x, static_cast<float>(contentArea_.getY()),
+                           static_cast<float>(contentArea_.getBottom()));
+        g.drawHorizontalLine(position.y, static_cast<float>(contentArea_.getX()),
+                             static_cast<float>(contentArea_.getRight()));
     }
 
     // Draw indicator dot
-    constexpr float dotSize = 5.0f;
-    constexpr float dotRadius = dotSize / 2.0f;
+    constexpr float dotRadius = kDotSize / 2.0f;
     g.setColour(curveColour_);
-    g.fillEllipse(static_cast<float>(x) - dotRadius, static_cast<float>(y) - dotRadius, dotSize,
-                  dotSize);
+    g.fillEllipse(x - dotRadius, y - dotRadius, kDotSize, kDotSize);
 
     // Draw white outline
     g.setColour(juce::Colours::white);
-    g.drawEllipse(static_cast<float>(x) - dotRadius, static_cast<float>(y) - dotRadius, dotSize,
-                  dotSize, 1.0f);
-}
-
-double LFOPhaseOverlay::applyTension(double t, double tension) const {
-    if (tension > 0) {
-        return std::pow(t, 1.0 + tension * 2.0);
-    } else {
-        return 1.0 - std::pow(1.0 - t, 1.0 - tension * 2.0);
-    }
+    g.drawEllipse(x - dotRadius, y - dotRadius, kDotSize, kDotSize, 1.0f);
 }
 
 }  // namespace magda
@@ -3,56 +3,59 @@
 #include <juce_gui_basics/juce_gui_basics.h>
 
 #include "core/ModInfo.hpp"
+#include "ui/utils/FrameScheduler.hpp"
 
 namespace magda {
 
 /**
- * @brief Opaque overlay that renders curve and animated phase indicator
+ * @brief Transparent overlay that draws the animated LFO phase indicator
  *
- * Renders the full curve visualization including:
- * - Background and grid
- * - Curve from ModInfo::curvePoints
- * - Animated phase indicator
+ * Sits over an LFOCurveEditor and draws only the indicator dot (and the crosshair, when
+ * shown) at the modulator's current phase and value. It animates on its own frame client
+ * and repaints just the strips the indicator left and entered, so with the editor buffered
+ * to an image the curve underneath is composited from that image rather than re-rendered
+ * every frame.
  *
- * Being opaque prevents flickering from transparent overlay repaints.
- * Click-through allows interaction with editor components on top.
+ * Click-through, so the editor and its handles get all mouse input.
  */
-class LFOPhaseOverlay : public juce::Component, private juce::Timer {
+class LFOPhaseOverlay : public juce::Component {
   public:
     LFOPhaseOverlay();
     ~LFOPhaseOverlay() override;
 
-    void setModInfo(const ModInfo* mod) {
-        modInfo_ = mod;
-    }
+    void setModInfo(const ModInfo* mod);
 
     void setCurveColour(juce::Colour colour) {
         curveColour_ = colour;
+        repaintIndicator();
     }
 
-    void setShowCrosshair(bool show) {
-        showCrosshair_ = show;
-    }
+    void setShowCrosshair(bool show);
     bool getShowCrosshair() const {
         return showCrosshair_;
     }
 
+    // The area phase 0-1 and value 0-1 map onto, in this component's coordinates
+    void setContentArea(juce::Rectangle<int> area);
+
     void paint(juce::Graphics& g) override;
     bool hitTest(int x, int y) override;
 
   private:
-    void timerCallback() override;
-
-    void paintGrid(juce::Graphics& g);
-    void paintCurve(juce::Graphics& g);
-    void paintPhaseIndicator(juce::Graphics& g);
-
-    // Apply tension curve interpolation
-    double applyTension(double t, double tension) const;
+    void update();
+    void repaintIndicator();
+    juce::Point<int> getIndicatorPosition() const;
 
     const ModInfo* modInfo_ = nullptr;
+    juce::Rectangle<int> contentArea_;
     juce::Colour curveColour_{0xFF6688CC};
     bool showCrosshair_ = false;
+
+    // Where the indicator was last drawn
+    float phase_ = 0.0f;
+    float value_ = 0.0f;
+
+    FrameScheduler::Client frameClient_{*this, 30.0, [this]() { update(); }};
 };
 
 }  // namespace magda
@@ -10,24 +10,18 @@
 #include "core/SelectionManager.hpp"
 #include "ui/components/common/SvgButton.hpp"
 #include "ui/components/common/TextSlider.hpp"
+#include "ui/utils/FrameScheduler.hpp"
 
 namespace magda::daw::ui {
 
 /**
  * @brief Mini waveform display for mod knob
  */
-class MiniWaveformDisplay : public juce::Component, private juce::Timer {
+class MiniWaveformDisplay : public juce::Component {
   public:
-    MiniWaveformDisplay() {
-        startTimer(33);  // 30 FPS animation
-    }
-
-    ~MiniWaveformDisplay() {
-        stopTimer();
-    }
-
     void setModInfo(const magda::ModInfo* mod) {
         mod_ = mod;
+        frameClient_.setActive(mod_ != nullptr);  // 30 FPS animation
         DBG("MiniWaveformDisplay::setModInfo - mod_ ptr: " +
             juce::String::toHexString((juce::int64)mod_));
         repaint();
@@ -82,11 +76,8 @@ class MiniWaveformDisplay : public juce::Component, private juce::Timer {
     }
 
   private:
-    void timerCallback() override {
-        repaint();
-    }
-
     const magda::ModInfo* mod_ = nullptr;
+    magda::FrameScheduler::Client frameClient_{*this, 30.0, [this]() { repaint(); }};
 };
 
 /**
@@ -12,8 +12,6 @@ ModulatorEditorPanel::ModulatorEditorPanel() {
     // Intercept mouse clicks to prevent propagation to parent
     setInterceptsMouseClicks(true, true);
 
-    startTimer(33);  // 30 FPS for waveform animation
-
     // Name label at top
     nameLabel_.setFont(FontManager::getInstance().getUIFontBold(10.0f));
     nameLabel_.setColour(juce::Label::textColourId, DarkTheme::getTextColour());
@@ -295,15 +293,14 @@ ModulatorEditorPanel::ModulatorEditorPanel() {
     addAndMakeVisible(advancedButton_.get());
 }
 
-ModulatorEditorPanel::~ModulatorEditorPanel() {
-    stopTimer();
-}
+ModulatorEditorPanel::~ModulatorEditorPanel() = default;
 
 void ModulatorEditorPanel::setModInfo(const magda::ModInfo& mod, const magda::ModInfo* liveMod) {
     currentMod_ = mod;
     liveModPtr_ = liveMod;
     // Use live mod pointer if available (for animation), otherwise use local copy
     waveformDisplay_.setModInfo(liveMod ? liveMod : &currentMod_);
+    frameClient_.setActive(true);  // 30 FPS for the trigger indicator
     updateFromMod();
 }
 
@@ -506,9 +503,4 @@ void ModulatorEditorPanel::mouseUp(const juce::MouseEvent& /*e*/) {
     // Consume mouse events to prevent propagation to parent
 }
 
-void ModulatorEditorPanel::timerCallback() {
-    // Repaint for trigger indicator animation
-    repaint();
-}
-
 }  // namespace magda::daw::ui
@@ -11,24 +11,18 @@
 #include "ui/components/chain/LFOCurveEditorWindow.hpp"
 #include "ui/components/common/SvgButton.hpp"
 #include "ui/components/common/TextSlider.hpp"
+#include "ui/utils/FrameScheduler.hpp"
 
 namespace magda::daw::ui {
 
 /**
  * @brief Animated waveform display component
  */
-class WaveformDisplay : public juce::Component, private juce::Timer {
+class WaveformDisplay : public juce::Component {
   public:
-    WaveformDisplay() {
-        startTimer(33);  // 30 FPS animation
-    }
-
-    ~WaveformDisplay() override {
-        stopTimer();
-    }
-
     void setModInfo(const magda::ModInfo* mod) {
         mod_ = mod;
+        frameClient_.setActive(mod_ != nullptr);
         repaint();
     }
 
@@ -105,11 +99,8 @@ class WaveformDisplay : public juce::Component, private juce::Timer {
     }
 
   private:
-    void timerCallback() override {
-        repaint();
-    }
-
     const magda::ModInfo* mod_ = nullptr;
+    magda::FrameScheduler::Client frameClient_{*this, 30.0, [this]() { repaint(); }};
 };
 
 /**
@@ -130,7 +121,7 @@ class WaveformDisplay : public juce::Component, private juce::Timer {
  * |   Param Name     |
  * +------------------+
  */
-class ModulatorEditorPanel : public juce::Component, private juce::Timer {
+class ModulatorEditorPanel : public juce::Component {
   public:
     ModulatorEditorPanel();
     ~ModulatorEditorPanel() override;
@@ -182,7 +173,9 @@ class ModulatorEditorPanel : public juce::Component, private juce::Timer {
     std::unique_ptr<magda::SvgButton> advancedButton_;
 
     void updateFromMod();
-    void timerCallback() override;
+
+    // Repaints the trigger indicator while a mod is shown
+    magda::FrameScheduler::Client frameClient_{*this, 30.0, [this]() { repaint(); }};
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ModulatorEditorPanel)
 };
@@ -285,6 +285,29 @@ void NodeComponent::paint(juce::Graphics& g) {
     }
 }
 
+void NodeComponent::paintOverChildren(juce::Graphics& g) {
+    if (!cpuUsageVisible_) {
+        return;
+    }
+
+    // Bottom-right corner of the main node area (or the foot of the collapsed strip)
+    auto bounds = getLocalBounds();
+    bounds.removeFromLeft(getLeftPanelsWidth());
+    bounds.removeFromRight(getRightPanelsWidth());
+    auto badge = bounds.reduced(3).removeFromBottom(12);
+    if (!collapsed_) {
+        badge = badge.removeFromRight(38);
+    }
+
+    const auto text = cpuUsageMeasured_ ? formatCpuLoad(cpuLoad_) : juce::String("-");
+    g.setColour(DarkTheme::getColour(DarkTheme::BACKGROUND).withAlpha(0.8f));
+    g.fillRoundedRectangle(badge.toFloat(), 2.0f);
+    g.setColour(cpuUsageMeasured_ ? getCpuLoadColour(cpuLoad_)
+                                  : DarkTheme::getSecondaryTextColour());
+    g.setFont(FontManager::getInstance().getUIFont(9.0f));
+    g.drawText(text, badge, juce::Justification::centred);
+}
+
 void NodeComponent::resized() {
     auto bounds = getLocalBounds();
 
@@ -546,6 +569,40 @@ void NodeComponent::resizedHeaderExtra(juce::Rectangle<int>& /*headerArea*/) {
     // Default: nothing - subclasses override to add extra header buttons
 }
 
+void NodeComponent::setCpuUsage(double load, bool measured) {
+    // Skip the repaint when the badge would read the same
+    const bool changed = !cpuUsageVisible_ || measured != cpuUsageMeasured_ ||
+                         (measured && formatCpuLoad(load) != formatCpuLoad(cpuLoad_));
+    cpuUsageVisible_ = true;
+    cpuUsageMeasured_ = measured;
+    cpuLoad_ = load;
+    if (changed) {
+        repaint();
+    }
+}
+
+void NodeComponent::clearCpuUsage() {
+    if (cpuUsageVisible_) {
+        cpuUsageVisible_ = false;
+        repaint();
+    }
+}
+
+juce::String NodeComponent::formatCpuLoad(double load) {
+    return juce::String(load * 100.0, 1) + "%";
+}
+
+juce::Colour NodeComponent::getCpuLoadColour(double load) {
+    // A quarter of the block's budget in one device leaves little room for the rest
+    if (load >= 0.25) {
+        return DarkTheme::getColour(DarkTheme::STATUS_DANGER);
+    }
+    if (load >= 0.1) {
+        return DarkTheme::getColour(DarkTheme::STATUS_WARNING);
+    }
+    return DarkTheme::getSecondaryTextColour();
+}
+
 int NodeComponent::getLeftPanelsWidth() const {
     int width = 0;
     if (modPanelVisible_)
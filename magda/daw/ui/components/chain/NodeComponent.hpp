@@ -49,6 +49,7 @@ class NodeComponent : public juce::Component, public magda::SelectionManagerList
     void paramSelectionChanged(const magda::ParamSelection& selection) override;
 
     void paint(juce::Graphics& g) override;
+    void paintOverChildren(juce::Graphics& g) override;
     void resized() override;
 
     // Header accessors
@@ -74,6 +75,16 @@ class NodeComponent : public juce::Component, public magda::SelectionManagerList
         return selected_;
     }
 
+    // CPU overlay: load as a share of real time, drawn over the node's bottom-right corner
+    // (hidden until set; unmeasured nodes show a dash)
+    void setCpuUsage(double load, bool measured);
+    void clearCpuUsage();
+    bool isCpuUsageVisible() const {
+        return cpuUsageVisible_;
+    }
+    static juce::String formatCpuLoad(double load);
+    static juce::Colour getCpuLoadColour(double load);
+
     // Collapse (show header only)
     void setCollapsed(bool collapsed);
     bool isCollapsed() const {
@@ -305,6 +316,11 @@ class NodeComponent : public juce::Component, public magda::SelectionManagerList
     // Param panel controls (4 knobs in 2x2 grid)
     std::vector<std::unique_ptr<juce::Slider>> paramKnobs_;
 
+    // CPU overlay
+    bool cpuUsageVisible_ = false;
+    bool cpuUsageMeasured_ = false;
+    double cpuLoad_ = 0.0;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(NodeComponent)
 };
 
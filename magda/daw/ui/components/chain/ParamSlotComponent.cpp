@@ -1,6 +1,7 @@
 #include "ParamSlotComponent.hpp"
 
 #include "core/LinkModeManager.hpp"
+#include "core/TrackManager.hpp"
 #include "ui/themes/DarkTheme.hpp"
 #include "ui/themes/FontManager.hpp"
 
@@ -135,9 +136,6 @@ ParamSlotComponent::ParamSlotComponent(int paramIndex) : paramIndex_(paramIndex)
 }
 
 ParamSlotComponent::~ParamSlotComponent() {
-    // Stop modulation animation timer
-    stopTimer();
-
     // Clean up tooltip if it's on desktop
     if (amountLabel_.isOnDesktop()) {
         amountLabel_.removeFromDesktop();
@@ -919,7 +917,6 @@ void ParamSlotComponent::paintModulationIndicators(juce::Graphics& g) {
     int leftX = 0;
 
     // Bar heights (thickness)
-    const int movementBarHeight = 5;  // Thicker bar for movement (normal mode)
     const int amountBarHeight = 3;    // Thinner bar for amount (link mode)
 
     // ========================================================================
@@ -1024,94 +1021,18 @@ void ParamSlotComponent::paintModulationIndicators(juce::Graphics& g) {
         }
     }
 
-    // MACRO MOVEMENT LINE: Shows current macro modulation (only when NOT in link mode)
-    // In link mode, the amount line already shows what we need
-    if (!activeMacro_.isValid()) {
-        float totalMacroModulation = 0.0f;
-        magda::MacroTarget macroTarget{deviceId_, paramIndex_};
-
-        // Check device-level macros
-        if (availableMacros_ && deviceId_ != magda::INVALID_DEVICE_ID) {
-            for (size_t i = 0; i < availableMacros_->size(); ++i) {
-                const auto& macro = (*availableMacros_)[i];
-                if (const auto* link = macro.getLink(macroTarget)) {
-                    totalMacroModulation += macro.value * link->amount;
-                }
-            }
-        }
-
-        // Check rack-level macros
-        if (availableRackMacros_ && deviceId_ != magda::INVALID_DEVICE_ID) {
-            for (size_t i = 0; i < availableRackMacros_->size(); ++i) {
-                const auto& macro = (*availableRackMacros_)[i];
-                if (const auto* link = macro.getLink(macroTarget)) {
-                    totalMacroModulation += macro.value * link->amount;
-                }
-            }
-        }
-
-        // Draw MACRO movement line (purple) at TOP if any macro modulation exists
-        if (totalMacroModulation > 0.0f) {
-            int y = sliderBounds.getY() + 2;
-
-            // Get current parameter value (0.0 to 1.0)
-            float currentParamValue = static_cast<float>(valueSlider_.getValue());
-
-            // Bar starts from current param value and extends by modulation amount
-            int startX = leftX + static_cast<int>(maxWidth * currentParamValue);
-            int barWidth = juce::jmax(1, static_cast<int>(maxWidth * totalMacroModulation));
-
-            // Slightly dimmer purple for movement display
-            g.setColour(DarkTheme::getColour(DarkTheme::ACCENT_PURPLE).withAlpha(0.6f));
-            g.fillRoundedRectangle(static_cast<float>(startX), static_cast<float>(y),
-                                   static_cast<float>(barWidth),
-                                   static_cast<float>(movementBarHeight), 1.0f);
-        }
-    }
-
-    // MOD MOVEMENT LINE: Shows current LFO output (animated)
-    // Calculate TOTAL mod modulation output (sum of all linked mods)
-    float totalModModulation = 0.0f;
-    magda::ModTarget modTarget{deviceId_, paramIndex_};
-
-    // Check device-level mods
-    if (availableMods_ && deviceId_ != magda::INVALID_DEVICE_ID) {
-        for (size_t i = 0; i < availableMods_->size(); ++i) {
-            const auto& mod = (*availableMods_)[i];
-            if (const auto* link = mod.getLink(modTarget)) {
-                // mod.value is continuously updated by ModulatorEngine (0.0 to 1.0)
-                // link->amount is the modulation depth for this parameter (0.0 to 1.0)
-                totalModModulation += mod.value * link->amount;
-            }
-        }
-    }
-
-    // Check rack-level mods
-    if (availableRackMods_ && deviceId_ != magda::INVALID_DEVICE_ID) {
-        for (size_t i = 0; i < availableRackMods_->size(); ++i) {
-            const auto& mod = (*availableRackMods_)[i];
-            if (const auto* link = mod.getLink(modTarget)) {
-                totalModModulation += mod.value * link->amount;
-            }
-        }
+    // MACRO MOVEMENT LINE (purple, top) and MOD MOVEMENT LINE (orange, bottom, animated LFO
+    // output). Slightly dimmer than the link-mode amount lines
+    paintedMacroBar_ = getMacroMovementBarBounds();
+    if (!paintedMacroBar_.isEmpty()) {
+        g.setColour(DarkTheme::getColour(DarkTheme::ACCENT_PURPLE).withAlpha(0.6f));
+        g.fillRoundedRectangle(paintedMacroBar_.toFloat(), 1.0f);
     }
 
-    // Draw MOD movement line (orange) at BOTTOM if any mod modulation exists
-    if (totalModModulation > 0.0f) {
-        int y = sliderBounds.getBottom() - 6;
-
-        // Get current parameter value (0.0 to 1.0)
-        float currentParamValue = static_cast<float>(valueSlider_.getValue());
-
-        // Bar starts from current param value and extends by modulation amount (unipolar mode)
-        int startX = leftX + static_cast<int>(maxWidth * currentParamValue);
-        int barWidth = juce::jmax(1, static_cast<int>(maxWidth * totalModModulation));
-
-        // Slightly dimmer orange for movement display (thicker at bottom)
+    paintedModBar_ = getModMovementBarBounds();
+    if (!paintedModBar_.isEmpty()) {
         g.setColour(DarkTheme::getColour(DarkTheme::ACCENT_ORANGE).withAlpha(0.6f));
-        g.fillRoundedRectangle(static_cast<float>(startX), static_cast<float>(y),
-                               static_cast<float>(barWidth), static_cast<float>(movementBarHeight),
-                               1.0f);
+        g.fillRoundedRectangle(paintedModBar_.toFloat(), 1.0f);
     }
 
     // Update timer state (start if there are mod links, stop if none)
@@ -1427,68 +1348,145 @@ bool ParamSlotComponent::isInScopeOf(const magda::ChainNodePath& parentPath) con
     return false;
 }
 
-void ParamSlotComponent::timerCallback() {
-    // Repaint to update animated LFO modulation bars
-    repaint();
-}
-
 bool ParamSlotComponent::hasActiveModLinks() const {
     if (deviceId_ == magda::INVALID_DEVICE_ID) {
         return false;
     }
+    const auto& trackManager = magda::TrackManager::getInstance();
+    return !trackManager.getModulationSources(deviceId_, paramIndex_).empty();
+}
 
-    magda::ModTarget modTarget{deviceId_, paramIndex_};
+// =============================================================================
+// Modulation movement display
+// =============================================================================
 
-    // Check device-level mods
-    if (availableMods_) {
-        for (const auto& mod : *availableMods_) {
-            if (mod.getLink(modTarget) != nullptr) {
-                return true;  // Found at least one mod link
-            }
+namespace {
+
+// Current state of a linked source, looked up by id so any rack the device sits in counts
+const magda::ModInfo* findSourceMod(const magda::ModulationSources::Mod& source) {
+    const auto& trackManager = magda::TrackManager::getInstance();
+    const magda::ModArray* mods = nullptr;
+    if (source.owner == magda::ModOwner::Device) {
+        if (const auto* device = trackManager.findDevice(source.ownerId)) {
+            mods = &device->mods;
         }
+    } else if (const auto* rack = trackManager.getRack(source.trackId, source.ownerId)) {
+        mods = &rack->mods;
     }
+    if (!mods || source.modIndex < 0 || source.modIndex >= static_cast<int>(mods->size())) {
+        return nullptr;
+    }
+    return &(*mods)[static_cast<size_t>(source.modIndex)];
+}
 
-    // Check rack-level mods
-    if (availableRackMods_) {
-        for (const auto& mod : *availableRackMods_) {
-            if (mod.getLink(modTarget) != nullptr) {
-                return true;  // Found at least one rack mod link
-            }
+const magda::MacroInfo* findSourceMacro(const magda::ModulationSources::Macro& source) {
+    const auto& trackManager = magda::TrackManager::getInstance();
+    const magda::MacroArray* macros = nullptr;
+    if (source.owner == magda::ModOwner::Device) {
+        if (const auto* device = trackManager.findDevice(source.ownerId)) {
+            macros = &device->macros;
         }
+    } else if (const auto* rack = trackManager.getRack(source.trackId, source.ownerId)) {
+        macros = &rack->macros;
+    }
+    if (!macros || source.macroIndex < 0 ||
+        source.macroIndex >= static_cast<int>(macros->size())) {
+        return nullptr;
     }
+    return &(*macros)[static_cast<size_t>(source.macroIndex)];
+}
 
-    // Check device-level macros
-    magda::MacroTarget macroTarget{deviceId_, paramIndex_};
-    if (availableMacros_) {
-        for (const auto& macro : *availableMacros_) {
-            if (macro.getLink(macroTarget) != nullptr) {
-                return true;  // Found at least one macro link
-            }
+}  // namespace
+
+float ParamSlotComponent::getMacroMovement() const {
+    // In link mode, the amount line already shows what we need
+    if (activeMacro_.isValid() || deviceId_ == magda::INVALID_DEVICE_ID) {
+        return 0.0f;
+    }
+
+    float total = 0.0f;
+    const auto& sources =
+        magda::TrackManager::getInstance().getModulationSources(deviceId_, paramIndex_);
+    for (const auto& source : sources.macros) {
+        if (const auto* macro = findSourceMacro(source)) {
+            total += source.link.getContribution(macro->value);
         }
     }
+    return total;
+}
 
-    // Check rack-level macros
-    if (availableRackMacros_) {
-        for (const auto& macro : *availableRackMacros_) {
-            if (macro.getLink(macroTarget) != nullptr) {
-                return true;  // Found at least one rack macro link
-            }
+float ParamSlotComponent::getModMovement() const {
+    if (deviceId_ == magda::INVALID_DEVICE_ID) {
+        return 0.0f;
+    }
+
+    // mod.value is continuously updated by ModulatorEngine (0.0 to 1.0), link.amount is the
+    // modulation depth for this parameter. Device-level and rack-level mods add up
+    float total = 0.0f;
+    const auto& sources =
+        magda::TrackManager::getInstance().getModulationSources(deviceId_, paramIndex_);
+    for (const auto& source : sources.mods) {
+        if (const auto* mod = findSourceMod(source)) {
+            total += mod->value * source.link.amount;
         }
     }
+    return total;
+}
 
-    return false;
+juce::Rectangle<int> ParamSlotComponent::getMovementBarBounds(float amount, int y) const {
+    if (amount <= 0.0f) {
+        return {};
+    }
+
+    // Full cell width is 100%; the bar starts at the current param value (unipolar mode)
+    const int maxWidth = getWidth();
+    const float currentParamValue = static_cast<float>(valueSlider_.getValue());
+    const int startX = static_cast<int>(maxWidth * currentParamValue);
+    const int barWidth = juce::jmax(1, static_cast<int>(maxWidth * amount));
+    return {startX, y, barWidth, 5};  // Thicker than the link-mode amount lines
 }
 
-void ParamSlotComponent::updateModTimerState() {
-    if (hasActiveModLinks()) {
-        // Start timer at 30 FPS to animate modulation bars
-        if (!isTimerRunning()) {
-            startTimer(33);  // ~30 FPS
+juce::Rectangle<int> ParamSlotComponent::getMacroMovementBarBounds() const {
+    const auto sliderBounds = valueSlider_.getBounds();
+    if (sliderBounds.isEmpty()) {
+        return {};
+    }
+    return getMovementBarBounds(getMacroMovement(), sliderBounds.getY() + 2);
+}
+
+juce::Rectangle<int> ParamSlotComponent::getModMovementBarBounds() const {
+    const auto sliderBounds = valueSlider_.getBounds();
+    if (sliderBounds.isEmpty()) {
+        return {};
+    }
+    return getMovementBarBounds(getModMovement(), sliderBounds.getBottom() - 6);
+}
+
+void ParamSlotComponent::refreshModulationDisplay() {
+    // Both bars go into one dirty rect covering where they were and where they are now, so
+    // a slot whose modulation holds still (or has moved less than a pixel) isn't repainted
+    juce::Rectangle<int> dirty;
+    auto addIfMoved = [&dirty](const juce::Rectangle<int>& painted,
+                               const juce::Rectangle<int>& current) {
+        if (painted != current) {
+            for (const auto& bar : {painted, current}) {
+                if (!bar.isEmpty()) {
+                    dirty = dirty.isEmpty() ? bar : dirty.getUnion(bar);
+                }
+            }
         }
-    } else {
-        // No active links, stop the timer to save CPU
-        stopTimer();
+    };
+    addIfMoved(paintedMacroBar_, getMacroMovementBarBounds());
+    addIfMoved(paintedModBar_, getModMovementBarBounds());
+
+    if (!dirty.isEmpty()) {
+        repaint(dirty.expanded(1));  // Margin for the anti-aliased corners
     }
 }
 
+void ParamSlotComponent::updateModTimerState() {
+    // Repaint at ~30 FPS to animate modulation bars; idle without links to save CPU
+    frameClient_.setActive(hasActiveModLinks());
+}
+
 }  // namespace magda::daw::ui
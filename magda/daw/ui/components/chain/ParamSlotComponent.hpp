@@ -9,6 +9,7 @@
 #include "core/SelectionManager.hpp"
 #include "core/TypeIds.hpp"
 #include "ui/components/common/TextSlider.hpp"
+#include "ui/utils/FrameScheduler.hpp"
 
 namespace magda::daw::ui {
 
@@ -23,8 +24,7 @@ namespace magda::daw::ui {
  */
 class ParamSlotComponent : public juce::Component,
                            public juce::DragAndDropTarget,
-                           public magda::LinkModeManagerListener,
-                           private juce::Timer {
+                           public magda::LinkModeManagerListener {
   public:
     ParamSlotComponent(int paramIndex);
     ~ParamSlotComponent() override;
@@ -128,14 +128,25 @@ class ParamSlotComponent : public juce::Component,
     void modLinkModeChanged(bool active, const magda::ModSelection& selection) override;
     void macroLinkModeChanged(bool active, const magda::MacroSelection& selection) override;
 
-    // Timer callback for animating LFO modulation bars
-    void timerCallback() override;
-
     // Check if this param has any active mod links
     bool hasActiveModLinks() const;
 
-    // Update timer state based on whether there are active mod links
+    // Animate the modulation bars only while there are active mod links
     void updateModTimerState();
+    magda::FrameScheduler::Client frameClient_{*this, 30.0,
+                                               [this]() { refreshModulationDisplay(); }};
+
+    // Per-frame check: repaints just the bars, and only when they moved on screen
+    void refreshModulationDisplay();
+    float getMacroMovement() const;
+    float getModMovement() const;
+    juce::Rectangle<int> getMovementBarBounds(float amount, int y) const;
+    juce::Rectangle<int> getMacroMovementBarBounds() const;
+    juce::Rectangle<int> getModMovementBarBounds() const;
+
+    // Movement bars as last painted, empty when not drawn
+    juce::Rectangle<int> paintedMacroBar_;
+    juce::Rectangle<int> paintedModBar_;
 
     int paramIndex_;
     magda::DeviceId deviceId_ = magda::INVALID_DEVICE_ID;
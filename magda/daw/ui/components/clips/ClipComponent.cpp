@@ -1,5 +1,7 @@
 #include "ClipComponent.hpp"
 
+#include <optional>
+
 #include "../../themes/DarkTheme.hpp"
 #include "../../themes/FontManager.hpp"
 #include "../tracks/TrackContentPanel.hpp"
@@ -14,13 +16,60 @@ ClipComponent::ClipComponent(ClipId clipId, TrackContentPanel* parent)
 
     // Register as ClipManager listener
     ClipManager::getInstance().addListener(this);
+    AudioThumbnailManager::getInstance().addListener(this);
 
     // Check if this clip is currently selected
     isSelected_ = ClipManager::getInstance().getSelectedClip() == clipId_;
 }
 
 ClipComponent::~ClipComponent() {
+    setRetainedWaveform({});
     ClipManager::getInstance().removeListener(this);
+    AudioThumbnailManager::getInstance().removeListener(this);
+}
+
+void ClipComponent::setClipId(ClipId clipId) {
+    if (clipId == clipId_) {
+        return;
+    }
+
+    clipId_ = clipId;
+    setRetainedWaveform({});
+    contentCache_.invalidate();
+
+    // Reset per-clip interaction state
+    dragMode_ = DragMode::None;
+    isDragging_ = false;
+    isDuplicating_ = false;
+    hoverLeftEdge_ = false;
+    hoverRightEdge_ = false;
+    isMarqueeHighlighted_ = false;
+    isSelected_ = ClipManager::getInstance().getSelectedClip() == clipId_ ||
+                  SelectionManager::getInstance().isClipSelected(clipId_);
+    repaint();
+}
+
+void ClipComponent::visibilityChanged() {
+    // Hidden clips let their peaks be evicted; paint retains them again when shown
+    if (!isVisible()) {
+        setRetainedWaveform({});
+        contentCache_.invalidate();
+    }
+}
+
+void ClipComponent::setRetainedWaveform(Symbol audioFilePath) {
+    if (audioFilePath == retainedWaveformPath_) {
+        return;
+    }
+
+    auto& thumbnailManager = AudioThumbnailManager::getInstance();
+    if (!retainedWaveformPath_.isEmpty()) {
+        thumbnailManager.releaseWaveform(retainedWaveformPath_);
+    }
+    retainedWaveformPath_ = audioFilePath;
+    if (!retainedWaveformPath_.isEmpty()) {
+        thumbnailManager.retainWaveform(retainedWaveformPath_);
+    }
 }
 
 void ClipComponent::paint(juce::Graphics& g) {
@@ -31,15 +80,28 @@ void ClipComponent::paint(juce::Graphics& g) {
 
     auto bounds = getLocalBounds();
 
-    // Draw based on clip type
-    if (clip->type == ClipType::Audio) {
-        paintAudioClip(g, *clip, bounds);
-    } else {
-        paintMidiClip(g, *clip, bounds);
+    // A stretch drag draws the clip as it would be dropped; the model changes on mouseUp
+    std::optional<ClipInfo> stretchPreview;
+    const bool isStretching =
+        dragMode_ == DragMode::StretchLeft || dragMode_ == DragMode::StretchRight;
+    if (isDragging_ && isStretching) {
+        stretchPreview = getStretchPreview(*clip);
+        clip = &*stretchPreview;
     }
 
-    // Draw header (name, loop indicator)
-    paintClipHeader(g, *clip, bounds);
+    // Body and header come from the tile cache; selection and hover state draw on top
+    contentCache_.paint(g, bounds, [this, clip, bounds](juce::Graphics& tileGraphics) {
+        // Draw based on clip type
+        if (clip->type == ClipType::Audio) {
+            paintAudioClip(tileGraphics, *clip, bounds);
+        } else {
+            setRetainedWaveform({});
+            paintMidiClip(tileGraphics, *clip, bounds);
+        }
+
+        // Draw header (name, loop indicator)
+        paintClipHeader(tileGraphics, *clip, bounds);
+    });
 
     // Draw resize handles if selected
     if (isSelected_) {
@@ -72,6 +134,8 @@ void ClipComponent::paintAudioClip(juce::Graphics& g, const ClipInfo& clip,
     if (!clip.audioSources.empty() && clip.audioSources[0].filePath.isNotEmpty()) {
         const auto& source = clip.audioSources[0];
         auto& thumbnailManager = AudioThumbnailManager::getInstance();
+        const Symbol filePath(source.filePath);  // Looked up once for both calls
+        setRetainedWaveform(filePath);
 
         // Calculate visible region and file times directly in time domain
         // to avoid integer rounding errors from pixel→time→pixel conversions.
@@ -119,11 +183,13 @@ void ClipComponent::paintAudioClip(juce::Graphics& g, const ClipInfo& clip,
                 double fileEnd =
                     source.offset + (visibleEnd - adjustedSourcePosition) / source.stretchFactor;
 
-                thumbnailManager.drawWaveform(g, drawRect, source.filePath, fileStart, fileEnd,
+                thumbnailManager.drawWaveform(g, drawRect, filePath, fileStart, fileEnd,
                                               clip.colour.brighter(0.2f));
             }
         }
     } else {
+        setRetainedWaveform({});
+
         // Fallback: draw placeholder if no audio source
         g.setColour(clip.colour.brighter(0.2f).withAlpha(0.3f));
         g.drawText("No Audio", waveformArea, juce::Justification::centred);
@@ -368,6 +434,7 @@ void ClipComponent::mouseDown(const juce::MouseEvent& e) {
         if (e.mods.isShiftDown() && clip->type == ClipType::Audio && !clip->audioSources.empty()) {
             dragMode_ = DragMode::StretchLeft;
             dragStartStretchFactor_ = clip->audioSources[0].stretchFactor;
+            previewStretchFactor_ = dragStartStretchFactor_;
         } else {
             dragMode_ = DragMode::ResizeLeft;
         }
@@ -375,6 +442,7 @@ void ClipComponent::mouseDown(const juce::MouseEvent& e) {
         if (e.mods.isShiftDown() && clip->type == ClipType::Audio && !clip->audioSources.empty()) {
             dragMode_ = DragMode::StretchRight;
             dragStartStretchFactor_ = clip->audioSources[0].stretchFactor;
+            previewStretchFactor_ = dragStartStretchFactor_;
         } else {
             dragMode_ = DragMode::ResizeRight;
         }
@@ -548,22 +616,14 @@ void ClipComponent::mouseDrag(const juce::MouseEvent& e) {
             finalLength = dragStartLength_ * (newStretchFactor / dragStartStretchFactor_);
 
             previewLength_ = finalLength;
+            previewStretchFactor_ = newStretchFactor;
 
             int newX = parentPanel_->timeToPixel(dragStartTime_);
             int newWidth = static_cast<int>(finalLength * pixelsPerSecond);
             setBounds(newX, getY(), juce::jmax(10, newWidth), getHeight());
 
-            // Throttled live update to audio engine
-            if (stretchThrottle_.check()) {
-                auto& cm = ClipManager::getInstance();
-                if (auto* mutableClip = cm.getClip(clipId_)) {
-                    mutableClip->length = finalLength;
-                    if (!mutableClip->audioSources.empty()) {
-                        mutableClip->audioSources[0].length = finalLength;
-                        mutableClip->audioSources[0].stretchFactor = newStretchFactor;
-                    }
-                    cm.forceNotifyClipPropertyChanged(clipId_);
-                }
+            if (stretchAuditionThrottle_.check()) {
+                ClipManager::getInstance().notifyClipAudiblePreview(getStretchPreview(*clip));
             }
             break;
         }
@@ -594,24 +654,14 @@ void ClipComponent::mouseDrag(const juce::MouseEvent& e) {
 
             previewStartTime_ = finalStartTime;
             previewLength_ = finalLength;
+            previewStretchFactor_ = newStretchFactor;
 
             int newX = parentPanel_->timeToPixel(finalStartTime);
             int newWidth = static_cast<int>(finalLength * pixelsPerSecond);
             setBounds(newX, getY(), juce::jmax(10, newWidth), getHeight());
 
-            // Throttled live update to audio engine
-            if (stretchThrottle_.check()) {
-                auto& cm = ClipManager::getInstance();
-                if (auto* mutableClip = cm.getClip(clipId_)) {
-                    mutableClip->startTime = finalStartTime;
-                    mutableClip->length = finalLength;
-                    if (!mutableClip->audioSources.empty()) {
-                        mutableClip->audioSources[0].position = 0.0;
-                        mutableClip->audioSources[0].length = finalLength;
-                        mutableClip->audioSources[0].stretchFactor = newStretchFactor;
-                    }
-                    cm.forceNotifyClipPropertyChanged(clipId_);
-                }
+            if (stretchAuditionThrottle_.check()) {
+                ClipManager::getInstance().notifyClipAudiblePreview(getStretchPreview(*clip));
             }
             break;
         }
@@ -620,6 +670,11 @@ void ClipComponent::mouseDrag(const juce::MouseEvent& e) {
             break;
     }
 
+    // Resize and stretch previews redraw the body; a move only changes the bounds' position
+    if (dragMode_ != DragMode::Move) {
+        contentCache_.invalidate();
+    }
+
     // Emit real-time preview event via ClipManager (for global listeners like PianoRoll)
     ClipManager::getInstance().notifyClipDragPreview(clipId_, previewStartTime_, previewLength_);
 
@@ -649,6 +704,7 @@ void ClipComponent::mouseUp(const juce::MouseEvent& e) {
         dragMode_ = DragMode::None;
         isDragging_ = false;
         isCommitting_ = true;
+        contentCache_.invalidate();
 
         // Now apply snapping and commit to ClipManager
         switch (savedDragMode) {
@@ -742,7 +798,7 @@ void ClipComponent::mouseUp(const juce::MouseEvent& e) {
             }
 
             case DragMode::StretchRight: {
-                stretchThrottle_.reset();
+                stretchAuditionThrottle_.reset();
 
                 double finalLength = previewLength_;
 
@@ -757,7 +813,7 @@ void ClipComponent::mouseUp(const juce::MouseEvent& e) {
                 newStretchFactor = juce::jlimit(0.25, 4.0, newStretchFactor);
                 finalLength = dragStartLength_ * (newStretchFactor / dragStartStretchFactor_);
 
-                // Apply directly (clip state may have been modified by throttled updates)
+                // The drag only previewed; this is its one change to the model
                 auto& cm = ClipManager::getInstance();
                 if (auto* clip = cm.getClip(clipId_)) {
                     clip->length = finalLength;
@@ -771,7 +827,7 @@ void ClipComponent::mouseUp(const juce::MouseEvent& e) {
             }
 
             case DragMode::StretchLeft: {
-                stretchThrottle_.reset();
+                stretchAuditionThrottle_.reset();
 
                 double endTime = dragStartTime_ + dragStartLength_;
                 double finalStartTime = previewStartTime_;
@@ -789,7 +845,7 @@ void ClipComponent::mouseUp(const juce::MouseEvent& e) {
                 finalLength = dragStartLength_ * (newStretchFactor / dragStartStretchFactor_);
                 finalStartTime = endTime - finalLength;
 
-                // Apply directly (clip state may have been modified by throttled updates)
+                // The drag only previewed; this is its one change to the model
                 auto& cm = ClipManager::getInstance();
                 if (auto* clip = cm.getClip(clipId_)) {
                     clip->startTime = finalStartTime;
@@ -814,6 +870,21 @@ void ClipComponent::mouseUp(const juce::MouseEvent& e) {
     }
 }
 
+ClipInfo ClipComponent::getStretchPreview(const ClipInfo& clip) const {
+    auto preview = clip;
+    preview.startTime = previewStartTime_;
+    preview.length = previewLength_;
+    if (!preview.audioSources.empty()) {
+        auto& source = preview.audioSources[0];
+        if (dragMode_ == DragMode::StretchLeft) {
+            source.position = 0.0;
+        }
+        source.length = previewLength_;
+        source.stretchFactor = previewStretchFactor_;
+    }
+    return preview;
+}
+
 void ClipComponent::mouseMove(const juce::MouseEvent& e) {
     bool wasHoverLeft = hoverLeftEdge_;
     bool wasHoverRight = hoverRightEdge_;
@@ -847,29 +918,26 @@ void ClipComponent::mouseDoubleClick(const juce::MouseEvent& /*e*/) {
 // ============================================================================
 
 void ClipComponent::clipsChanged() {
+    // Edits to this clip arrive through clipChangesCoalesced(), once per tick; other clips
+    // being added or removed doesn't change how this one draws
+}
+
+void ClipComponent::clipChangesCoalesced(const ClipChangeSet& changes) {
     // Ignore updates while dragging to prevent flicker
     if (isDragging_) {
         return;
     }
 
-    // Clip may have been deleted
-    const auto* clip = getClipInfo();
-    if (!clip) {
-        // This clip was deleted - parent should remove this component
+    if (!changes.reset && changes.modified.count(clipId_) == 0) {
         return;
     }
-    repaint();
-}
 
-void ClipComponent::clipPropertyChanged(ClipId clipId) {
-    // Ignore updates while dragging to prevent flicker
-    if (isDragging_) {
+    // Clip may have been deleted - parent should remove this component
+    if (!getClipInfo()) {
         return;
     }
-
-    if (clipId == clipId_) {
-        repaint();
-    }
+    contentCache_.invalidate();
+    repaint();
 }
 
 void ClipComponent::clipSelectionChanged(ClipId clipId) {
@@ -887,6 +955,14 @@ void ClipComponent::clipSelectionChanged(ClipId clipId) {
     }
 }
 
+void ClipComponent::changeListenerCallback(juce::ChangeBroadcaster*) {
+    const auto* clip = getClipInfo();
+    if (clip && clip->type == ClipType::Audio) {
+        contentCache_.invalidate();
+        repaint();
+    }
+}
+
 // ============================================================================
 // Selection
 // ============================================================================
@@ -905,6 +981,13 @@ void ClipComponent::setMarqueeHighlighted(bool highlighted) {
     }
 }
 
+void ClipComponent::setZoomPreview(bool preview) {
+    contentCache_.setScaledPreviewAllowed(preview);
+    if (!preview) {
+        repaint();
+    }
+}
+
 bool ClipComponent::isPartOfMultiSelection() const {
     auto& selectionManager = SelectionManager::getInstance();
     return selectionManager.getSelectedClipCount() > 1 && selectionManager.isClipSelected(clipId_);
@@ -2,9 +2,11 @@
 
 #include <juce_gui_basics/juce_gui_basics.h>
 
+#include "../common/TileImageCache.hpp"
 #include "core/ClipInfo.hpp"
 #include "core/ClipManager.hpp"
 #include "core/ClipTypes.hpp"
+#include "core/Symbol.hpp"
 #include "utils/DragThrottle.hpp"
 
 namespace magda {
@@ -21,7 +23,9 @@ class TrackContentPanel;
  * - Resize handles (left/right edges)
  * - Selection
  */
-class ClipComponent : public juce::Component, public ClipManagerListener {
+class ClipComponent : public juce::Component,
+                      public ClipManagerListener,
+                      private juce::ChangeListener {
   public:
     explicit ClipComponent(ClipId clipId, TrackContentPanel* parent);
     ~ClipComponent() override;
@@ -30,10 +34,16 @@ class ClipComponent : public juce::Component, public ClipManagerListener {
         return clipId_;
     }
 
+    /**
+     * @brief Show a different clip (components are recycled as the view scrolls)
+     */
+    void setClipId(ClipId clipId);
+
     // Component overrides
     void paint(juce::Graphics& g) override;
     void resized() override;
     bool hitTest(int x, int y) override;
+    void visibilityChanged() override;
 
     // Mouse handling
     void mouseDown(const juce::MouseEvent& e) override;
@@ -45,8 +55,8 @@ class ClipComponent : public juce::Component, public ClipManagerListener {
 
     // ClipManagerListener
     void clipsChanged() override;
-    void clipPropertyChanged(ClipId clipId) override;
     void clipSelectionChanged(ClipId clipId) override;
+    void clipChangesCoalesced(const ClipChangeSet& changes) override;
 
     // Selection state
     bool isSelected() const {
@@ -60,6 +70,13 @@ class ClipComponent : public juce::Component, public ClipManagerListener {
     }
     void setMarqueeHighlighted(bool highlighted);
 
+    /**
+     * @brief While a zoom gesture runs, stretch the cached content instead of redrawing it
+     *
+     * Turning it off repaints at the real size.
+     */
+    void setZoomPreview(bool preview);
+
     // Check if this clip is part of a multi-selection
     bool isPartOfMultiSelection() const;
 
@@ -67,6 +84,9 @@ class ClipComponent : public juce::Component, public ClipManagerListener {
     bool isCurrentlyDragging() const {
         return isDragging_;
     }
+    bool isCommittingDrag() const {
+        return isCommitting_;
+    }
 
     // Callbacks
     std::function<void(ClipId, double)> onClipMoved;          // clipId, newStartTime
@@ -82,6 +102,16 @@ class ClipComponent : public juce::Component, public ClipManagerListener {
         onClipDragPreview;  // clipId, previewStartTime, previewLength
 
   private:
+    // Repaint audio clips once their waveform thumbnail has finished building
+    void changeListenerCallback(juce::ChangeBroadcaster* source) override;
+
+    // Cached body and header; invalidated on model, waveform and drag-preview changes
+    TileImageCache contentCache_;
+
+    // Keep the displayed file's peaks resident in AudioThumbnailManager (empty = none)
+    void setRetainedWaveform(Symbol audioFilePath);
+    Symbol retainedWaveformPath_;
+
     ClipId clipId_;
     TrackContentPanel* parentPanel_;
     bool isSelected_ = false;
@@ -104,9 +134,12 @@ class ClipComponent : public juce::Component, public ClipManagerListener {
     bool isDragging_ = false;
     bool isCommitting_ = false;  // True during mouseUp commit phase
 
-    // Stretch state
+    // Stretch state: the model is untouched until mouseUp; the engine hears the stretch at
+    // a low rate so it can be auditioned while dragging
     double dragStartStretchFactor_ = 1.0;
-    DragThrottle stretchThrottle_{50};
+    double previewStretchFactor_ = 1.0;
+    DragThrottle stretchAuditionThrottle_{100};
+    ClipInfo getStretchPreview(const ClipInfo& clip) const;
 
     // Alt+drag duplicate state
     bool isDuplicating_ = false;
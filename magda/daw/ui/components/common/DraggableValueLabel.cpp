@@ -4,14 +4,20 @@
 
 #include "../../themes/DarkTheme.hpp"
 #include "../../themes/FontManager.hpp"
+#include "TextLayoutCache.hpp"
 
 namespace magda {
 
 DraggableValueLabel::DraggableValueLabel(Format format) : format_(format) {
     setMouseCursor(juce::MouseCursor::UpDownResizeCursor);
+    displayText_ = formatValue(value_);
 }
 
 DraggableValueLabel::~DraggableValueLabel() {
+    // A drag cut short still ends, so whoever grouped it isn't left waiting
+    if (isDragging_ && onDragEnd) {
+        onDragEnd();
+    }
     if (editor_) {
         editor_ = nullptr;
     }
@@ -22,20 +28,41 @@ void DraggableValueLabel::setRange(double min, double max, double defaultValue)
     maxValue_ = max;
     defaultValue_ = juce::jlimit(min, max, defaultValue);
     value_ = juce::jlimit(minValue_, maxValue_, value_);
-    repaint();
+    refreshDisplay();
 }
 
 void DraggableValueLabel::setValue(double newValue, juce::NotificationType notification) {
     newValue = juce::jlimit(minValue_, maxValue_, newValue);
     if (std::abs(newValue - value_) > 0.0001) {
         value_ = newValue;
-        repaint();
+        refreshDisplay();
         if (notification != juce::dontSendNotification && onValueChange) {
             onValueChange();
         }
     }
 }
 
+void DraggableValueLabel::refreshDisplay() {
+    auto text = formatValue(value_);
+    const int fill = getFillPixels();
+    if (text != displayText_ || fill != displayedFill_) {
+        displayText_ = std::move(text);
+        displayedFill_ = fill;
+        repaint();
+    }
+}
+
+int DraggableValueLabel::getFillPixels() const {
+    // Pan fills from the centre, by the value's sign; everything else from the left
+    double proportion = value_;
+    if (format_ != Format::Pan) {
+        proportion = maxValue_ > minValue_
+                         ? juce::jlimit(0.0, 1.0, (value_ - minValue_) / (maxValue_ - minValue_))
+                         : 0.0;
+    }
+    return juce::roundToInt(proportion * getWidth());
+}
+
 juce::String DraggableValueLabel::formatValue(double val) const {
     switch (format_) {
         case Format::Decibels: {
@@ -242,10 +269,15 @@ void DraggableValueLabel::paint(juce::Graphics& g) {
     if (!isEditing_) {
         g.setColour(DarkTheme::getColour(DarkTheme::TEXT_PRIMARY));
         g.setFont(FontManager::getInstance().getUIFont(10.0f));
-        g.drawText(formatValue(value_), bounds.reduced(2, 0), juce::Justification::centred, false);
+        TextLayoutCache::getInstance().drawText(g, displayText_, bounds.reduced(2, 0),
+                                                juce::Justification::centred);
     }
 }
 
+void DraggableValueLabel::resized() {
+    displayedFill_ = getFillPixels();
+}
+
 void DraggableValueLabel::mouseDown(const juce::MouseEvent& e) {
     if (isEditing_) {
         return;
@@ -254,6 +286,9 @@ void DraggableValueLabel::mouseDown(const juce::MouseEvent& e) {
     isDragging_ = true;
     dragStartValue_ = value_;
     dragStartY_ = e.y;
+    if (onDragStart) {
+        onDragStart();
+    }
     repaint();
 }
 
@@ -276,7 +311,11 @@ void DraggableValueLabel::mouseDrag(const juce::MouseEvent& e) {
 }
 
 void DraggableValueLabel::mouseUp(const juce::MouseEvent& /*e*/) {
+    const bool wasDragging = isDragging_;
     isDragging_ = false;
+    if (wasDragging && onDragEnd) {
+        onDragEnd();
+    }
     repaint();
 }
 
@@ -48,7 +48,7 @@ class DraggableValueLabel : public juce::Component {
     // Format
     void setFormat(Format format) {
         format_ = format;
-        repaint();
+        refreshDisplay();
     }
     Format getFormat() const {
         return format_;
@@ -57,20 +57,25 @@ class DraggableValueLabel : public juce::Component {
     // Suffix for Raw format
     void setSuffix(const juce::String& suffix) {
         suffix_ = suffix;
-        repaint();
+        refreshDisplay();
     }
 
     // Decimal places for display
     void setDecimalPlaces(int places) {
         decimalPlaces_ = places;
-        repaint();
+        refreshDisplay();
     }
 
     // Callback when value changes
     std::function<void()> onValueChange;
 
+    // Called around a mouse drag, e.g. to group its value changes into one undo step
+    std::function<void()> onDragStart;
+    std::function<void()> onDragEnd;
+
     // Component overrides
     void paint(juce::Graphics& g) override;
+    void resized() override;
     void mouseDown(const juce::MouseEvent& e) override;
     void mouseDrag(const juce::MouseEvent& e) override;
     void mouseUp(const juce::MouseEvent& e) override;
@@ -96,7 +101,13 @@ class DraggableValueLabel : public juce::Component {
     bool isEditing_ = false;
     std::unique_ptr<juce::TextEditor> editor_;
 
+    // What paint() shows; a value change that leaves both alone doesn't repaint
+    juce::String displayText_;
+    int displayedFill_ = 0;
+
     juce::String formatValue(double val) const;
+    int getFillPixels() const;
+    void refreshDisplay();
     double parseValue(const juce::String& text) const;
     void startEditing();
     void finishEditing();
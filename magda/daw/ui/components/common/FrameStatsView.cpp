@@ -0,0 +1,70 @@
+#include "FrameStatsView.hpp"
+
+#include "../../themes/DarkTheme.hpp"
+#include "../../themes/FontManager.hpp"
+#include "profiling/UIFrameProfiler.hpp"
+
+namespace magda {
+
+FrameStatsView::FrameStatsView() {
+    setInterceptsMouseClicks(false, false);
+    refresh();
+    startTimer(500);
+}
+
+FrameStatsView::~FrameStatsView() {
+    stopTimer();
+}
+
+void FrameStatsView::paint(juce::Graphics& g) {
+    g.setFont(FontManager::getInstance().getUIFont(11.0f));
+
+    int y = 0;
+    for (int i = 0; i < lines_.size(); ++i) {
+        // Header lines in the primary colour, per-view lines dimmed
+        const bool isDetail = lines_[i].startsWith("  ");
+        g.setColour(DarkTheme::getColour(isDetail ? DarkTheme::TEXT_SECONDARY
+                                                  : DarkTheme::TEXT_PRIMARY));
+        g.drawText(lines_[i], 0, y, getWidth(), kLineHeight, juce::Justification::centredLeft,
+                   true);
+        y += kLineHeight;
+    }
+}
+
+int FrameStatsView::getPreferredHeight() const {
+    // Three summary lines, the offenders heading and up to kMaxOffenders views
+    return (4 + kMaxOffenders) * kLineHeight;
+}
+
+void FrameStatsView::timerCallback() {
+    if (isShowing()) {
+        refresh();
+        repaint();
+    }
+}
+
+void FrameStatsView::refresh() {
+    const auto& profiler = UIFrameProfiler::getInstance();
+    const auto frames = profiler.getFrameStats();
+    const double droppedPercent =
+        frames.frames > 0 ? 100.0 * double(frames.droppedFrames) / double(frames.frames) : 0.0;
+
+    lines_.clearQuick();
+    lines_.add("UI frames: " + juce::String(frames.frames) + ", dropped " +
+               juce::String(frames.droppedFrames) + " (" + juce::String(droppedPercent, 1) +
+               "%)");
+    lines_.add("Frame avg " + juce::String(frames.getAverageMs(), 2) + " ms, max " +
+               juce::String(frames.maxMs, 1) + " ms (budget " +
+               juce::String(profiler.getFrameBudgetMs(), 1) + ")");
+    lines_.add("Message latency avg " + juce::String(frames.getAverageLatencyMs(), 2) +
+               " ms, max " + juce::String(frames.latencyMaxMs, 1) + " ms");
+
+    lines_.add("Slowest views:");
+    for (const auto& view : profiler.getWorstOffenders(kMaxOffenders)) {
+        lines_.add("  " + view.name + ": " + juce::String(view.slowFrames) + " slow, max " +
+                   juce::String(view.maxMs, 1) + " ms, avg " +
+                   juce::String(view.getAverageMs(), 2) + " ms");
+    }
+}
+
+}  // namespace magda
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <juce_gui_basics/juce_gui_basics.h>
+
+namespace magda {
+
+/**
+ * Live readout of UIFrameProfiler: frame times, dropped frames, message-loop latency and
+ * the views that dropped the most frames. Refreshes twice a second while showing.
+ */
+class FrameStatsView : public juce::Component, private juce::Timer {
+  public:
+    FrameStatsView();
+    ~FrameStatsView() override;
+
+    void paint(juce::Graphics& g) override;
+
+    // Height that fits every line at the current font
+    int getPreferredHeight() const;
+
+  private:
+    static constexpr int kMaxOffenders = 3;
+    static constexpr int kLineHeight = 14;
+
+    juce::StringArray lines_;
+
+    void timerCallback() override;
+    void refresh();
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FrameStatsView)
+};
+
+}  // namespace magda
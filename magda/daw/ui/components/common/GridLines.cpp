@@ -0,0 +1,123 @@
+#include "GridLines.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace magda {
+
+const std::vector<GridLines::Line>& GridLines::get(const Key& key, const TempoMap* tempo) {
+    const uint64_t tempoVersion = tempo ? tempo->getVersion() : 0;
+    if (valid_ && key == key_ && tempoVersion == tempoVersion_) {
+        return lines_;
+    }
+
+    key_ = key;
+    tempoVersion_ = tempoVersion;
+    valid_ = true;
+    ++computeCount_;
+    lines_.clear();
+
+    if (key_.interval <= 0.0 || key_.pixelsPerUnit <= 0.0 || key_.right < key_.left) {
+        return lines_;
+    }
+    if (key_.spacing == Spacing::Seconds && key_.axis == Axis::Seconds) {
+        computeSecondsLines();
+    } else {
+        computeBeatLines(tempo);
+    }
+    return lines_;
+}
+
+std::pair<size_t, size_t> GridLines::findVisible(int left, int right) const {
+    auto begin = std::lower_bound(lines_.begin(), lines_.end(), left,
+                                  [](const Line& line, int x) { return line.x < x; });
+    auto end = std::upper_bound(begin, lines_.end(), right,
+                                [](int x, const Line& line) { return x < line.x; });
+    return {static_cast<size_t>(begin - lines_.begin()), static_cast<size_t>(end - lines_.begin())};
+}
+
+int GridLines::toX(double position) const {
+    return static_cast<int>(position * key_.pixelsPerUnit) + key_.originX;
+}
+
+void GridLines::computeBeatLines(const TempoMap* tempo) {
+    const bool throughTempo = key_.axis == Axis::Seconds && tempo != nullptr;
+
+    // Axis range behind the columns; x truncates, so the last column reaches to right + 1
+    const double first = std::max(0.0, (key_.left - key_.originX) / key_.pixelsPerUnit);
+    const double last =
+        std::min(key_.length, (key_.right + 1 - key_.originX) / key_.pixelsPerUnit);
+    if (last < first) {
+        return;
+    }
+    const double firstBeat = throughTempo ? tempo->secondsToBeats(first) : first;
+    const double lastBeat = throughTempo ? tempo->secondsToBeats(last) : last;
+
+    const auto firstLine = static_cast<int64_t>(std::floor(firstBeat / key_.interval));
+    const auto lastLine = static_cast<int64_t>(std::floor(lastBeat / key_.interval + 1e-9));
+    if (lastLine < firstLine) {
+        return;
+    }
+
+    std::vector<double> beats;
+    beats.reserve(static_cast<size_t>(lastLine - firstLine + 1));
+    for (auto line = firstLine; line <= lastLine; ++line) {
+        beats.push_back(static_cast<double>(line) * key_.interval);
+    }
+    std::vector<double> positions = beats;
+    if (throughTempo) {
+        tempo->beatsToSeconds(positions.data(), positions.data(), positions.size());
+    }
+
+    const int beatsPerBar = std::max(1, key_.beatsPerBar);
+    lines_.reserve(beats.size());
+    for (size_t i = 0; i < beats.size(); ++i) {
+        const double position = positions[i];
+        const int x = toX(position);
+        if (position < 0.0 || position > key_.length || x < key_.left || x > key_.right) {
+            continue;
+        }
+
+        Line line{position, x, Level::Minor, 0};
+        const double whole = std::round(beats[i]);
+        if (std::abs(beats[i] - whole) < 1e-6) {
+            const auto beat = static_cast<int64_t>(whole);
+            if (beat % beatsPerBar == 0) {
+                line.level = Level::Major;
+                line.bar = static_cast<int>(beat / beatsPerBar) + 1;
+            } else {
+                line.level = Level::Beat;
+            }
+        }
+        lines_.push_back(line);
+    }
+}
+
+void GridLines::computeSecondsLines() {
+    const double first = std::max(0.0, (key_.left - key_.originX) / key_.pixelsPerUnit);
+    const double last =
+        std::min(key_.length, (key_.right + 1 - key_.originX) / key_.pixelsPerUnit);
+    if (last < first) {
+        return;
+    }
+
+    // Major lines by index, so 0.1 steps don't drift off the whole seconds
+    const int64_t majorEvery =
+        key_.majorInterval > 0.0
+            ? std::max<int64_t>(1, std::llround(key_.majorInterval / key_.interval))
+            : 0;
+
+    const auto firstLine = static_cast<int64_t>(std::floor(first / key_.interval));
+    const auto lastLine = static_cast<int64_t>(std::floor(last / key_.interval + 1e-9));
+    for (auto index = firstLine; index <= lastLine; ++index) {
+        const double position = static_cast<double>(index) * key_.interval;
+        const int x = toX(position);
+        if (position > key_.length || x < key_.left || x > key_.right) {
+            continue;
+        }
+        const bool major = majorEvery > 0 && index % majorEvery == 0;
+        lines_.push_back({position, x, major ? Level::Major : Level::Minor, 0});
+    }
+}
+
+}  // namespace magda
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "../../../core/TempoMap.hpp"
+
+namespace magda {
+
+/**
+ * @brief The vertical lines a timeline view draws, computed once per view state
+ *
+ * TimeRuler, GridOverlayComponent and PianoRollGridComponent describe what they show as a
+ * Key (spacing, zoom, scroll, visible columns, length) and paint from the array get()
+ * returns. The array is rebuilt only when the key or the tempo map's version changes, so
+ * a repaint for the playhead or a hover walks a few dozen precomputed lines instead of
+ * stepping through bars and beats with fmod.
+ *
+ * Each view owns its GridLines and keeps passing the same TempoMap; the cache does not
+ * notice being handed a different map at the same version.
+ */
+class GridLines {
+  public:
+    enum class Level {
+        Major,  // Bar lines, or whole units in a seconds grid
+        Beat,
+        Minor,  // Subdivisions
+    };
+
+    /**
+     * @brief What one pixel column stands for
+     */
+    enum class Axis {
+        Seconds,  // Arrangement views: beats are placed through the tempo map
+        Beats,    // Piano roll: x is a beat position directly
+    };
+
+    /**
+     * @brief What the interval counts in
+     */
+    enum class Spacing {
+        Beats,
+        Seconds,  // Only on a Seconds axis
+    };
+
+    struct Line {
+        double position = 0.0;  // On the axis: seconds or beats
+        int x = 0;
+        Level level = Level::Minor;
+        int bar = 0;  // 1-based, for Major lines of a beat grid; 0 otherwise
+    };
+
+    struct Key {
+        Axis axis = Axis::Seconds;
+        Spacing spacing = Spacing::Beats;
+        double interval = 1.0;       // Between lines, in the spacing's unit
+        double majorInterval = 0.0;  // Seconds spacing: multiples of it are Major
+        int beatsPerBar = 4;
+        double pixelsPerUnit = 1.0;  // Per second or per beat, matching the axis
+        int originX = 0;             // x of position zero: left padding minus scroll
+        int left = 0;                // Columns to fill, inclusive
+        int right = 0;
+        double length = 0.0;  // Last position on the axis that gets a line
+
+        bool operator==(const Key&) const = default;
+    };
+
+    /**
+     * @brief The lines for key, ascending in x, recomputed only if something changed
+     * @param tempo Places beat lines on a Seconds axis; may be null on a Beats axis
+     */
+    const std::vector<Line>& get(const Key& key, const TempoMap* tempo);
+
+    /**
+     * @brief Indices [begin, end) of the lines with x in [left, right]
+     */
+    std::pair<size_t, size_t> findVisible(int left, int right) const;
+
+    void invalidate() {
+        valid_ = false;
+    }
+
+    /**
+     * @brief How many times the lines were rebuilt, for tests and profiling
+     */
+    uint64_t getComputeCount() const {
+        return computeCount_;
+    }
+
+  private:
+    void computeBeatLines(const TempoMap* tempo);
+    void computeSecondsLines();
+    int toX(double position) const;
+
+    Key key_;
+    uint64_t tempoVersion_ = 0;
+    bool valid_ = false;
+    uint64_t computeCount_ = 0;
+    std::vector<Line> lines_;
+};
+
+}  // namespace magda
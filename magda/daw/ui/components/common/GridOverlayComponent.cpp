@@ -9,21 +9,21 @@ GridOverlayComponent::GridOverlayComponent() {
     setInterceptsMouseClicks(false, false);
 }
 
-GridOverlayComponent::~GridOverlayComponent() {
-    if (timelineController) {
-        timelineController->removeListener(this);
-    }
-}
+GridOverlayComponent::~GridOverlayComponent() = default;
 
 void GridOverlayComponent::setController(TimelineController* controller) {
-    if (timelineController) {
-        timelineController->removeListener(this);
-    }
-
+    timelineSubscriptions.clear();
     timelineController = controller;
 
     if (timelineController) {
-        timelineController->addListener(this);
+        // Scrolling is set by the owner through setScrollOffset(); playhead ticks don't
+        // change the grid
+        using Flags = TimelineController::ChangeFlags;
+        timelineSubscriptions.push_back(timelineController->subscribe(
+            Flags::Timeline | Flags::Display | Flags::Tempo,
+            [this](const TimelineState& state) { timelineStateChanged(state); }));
+        timelineSubscriptions.push_back(timelineController->subscribe(
+            Flags::Zoom, [this](const TimelineState& state) { zoomStateChanged(state); }));
 
         // Sync initial state
         const auto& state = timelineController->getState();
@@ -33,6 +33,7 @@ void GridOverlayComponent::setController(TimelineController* controller) {
         tempoBPM = state.tempo.bpm;
         timeSignatureNumerator = state.tempo.timeSignatureNumerator;
         timeSignatureDenominator = state.tempo.timeSignatureDenominator;
+        syncTempoMap();
 
         repaint();
     }
@@ -62,6 +63,7 @@ void GridOverlayComponent::setTimeDisplayMode(TimeDisplayMode mode) {
 void GridOverlayComponent::setTempo(double bpm) {
     if (tempoBPM != bpm) {
         tempoBPM = bpm;
+        syncTempoMap();
         repaint();
     }
 }
@@ -70,11 +72,12 @@ void GridOverlayComponent::setTimeSignature(int numerator, int denominator) {
     if (timeSignatureNumerator != numerator || timeSignatureDenominator != denominator) {
         timeSignatureNumerator = numerator;
         timeSignatureDenominator = denominator;
+        syncTempoMap();
         repaint();
     }
 }
 
-// ===== TimelineStateListener Implementation =====
+// ===== Timeline State Handlers =====
 
 void GridOverlayComponent::timelineStateChanged(const TimelineState& state) {
     timelineLength = state.timelineLength;
@@ -82,6 +85,7 @@ void GridOverlayComponent::timelineStateChanged(const TimelineState& state) {
     tempoBPM = state.tempo.bpm;
     timeSignatureNumerator = state.tempo.timeSignatureNumerator;
     timeSignatureDenominator = state.tempo.timeSignatureDenominator;
+    syncTempoMap();
     repaint();
 }
 
@@ -90,6 +94,12 @@ void GridOverlayComponent::zoomStateChanged(const TimelineState& state) {
     repaint();
 }
 
+void GridOverlayComponent::syncTempoMap() {
+    // Leaves the version alone when nothing changed, so the cached lines stay valid
+    tempoMap.setTempo(tempoBPM);
+    tempoMap.setTimeSignature(timeSignatureNumerator, timeSignatureDenominator);
+}
+
 // ===== Paint =====
 
 void GridOverlayComponent::paint(juce::Graphics& g) {
@@ -106,6 +116,17 @@ void GridOverlayComponent::drawTimeGrid(juce::Graphics& g, juce::Rectangle<int>
     }
 }
 
+GridLines::Key GridOverlayComponent::makeKey(juce::Rectangle<int> area) const {
+    GridLines::Key key;
+    key.beatsPerBar = timeSignatureNumerator;
+    key.pixelsPerUnit = currentZoom;
+    key.originX = leftPadding - scrollOffset;
+    key.left = area.getX();
+    key.right = area.getRight();
+    key.length = timelineLength;
+    return key;
+}
+
 void GridOverlayComponent::drawSecondsGrid(juce::Graphics& g, juce::Rectangle<int> area) {
     auto& layout = LayoutConfig::getInstance();
     const int minPixelSpacing = layout.minGridPixelSpacing;
@@ -125,32 +146,32 @@ void GridOverlayComponent::drawSecondsGrid(juce::Graphics& g, juce::Rectangle<in
         }
     }
 
-    for (double time = 0.0; time <= timelineLength; time += gridInterval) {
-        int x = static_cast<int>(time * currentZoom) + leftPadding - scrollOffset;
-        if (x >= area.getX() && x <= area.getRight()) {
-            // Determine line brightness based on time hierarchy
-            bool isMajor = false;
-            if (gridInterval >= 1.0) {
-                isMajor = true;
-            } else if (gridInterval >= 0.1) {
-                isMajor = std::fmod(time, 1.0) < 0.0001;
-            } else if (gridInterval >= 0.01) {
-                isMajor = std::fmod(time, 0.1) < 0.0001;
-            } else if (gridInterval >= 0.001) {
-                isMajor = std::fmod(time, 0.01) < 0.0001;
-            } else {
-                isMajor = std::fmod(time, 0.001) < 0.00001;
-            }
+    // Line brightness follows the time hierarchy: whole seconds, then tenths, and so on
+    auto key = makeKey(area);
+    key.spacing = GridLines::Spacing::Seconds;
+    key.interval = gridInterval;
+    if (gridInterval >= 1.0) {
+        key.majorInterval = gridInterval;
+    } else if (gridInterval >= 0.1) {
+        key.majorInterval = 1.0;
+    } else if (gridInterval >= 0.01) {
+        key.majorInterval = 0.1;
+    } else if (gridInterval >= 0.001) {
+        key.majorInterval = 0.01;
+    } else {
+        key.majorInterval = 0.001;
+    }
 
-            if (isMajor) {
-                g.setColour(DarkTheme::getColour(DarkTheme::GRID_LINE).brighter(0.3f));
-                g.drawLine(static_cast<float>(x), static_cast<float>(area.getY()),
-                           static_cast<float>(x), static_cast<float>(area.getBottom()), 1.0f);
-            } else {
-                g.setColour(DarkTheme::getColour(DarkTheme::GRID_LINE).brighter(0.1f));
-                g.drawLine(static_cast<float>(x), static_cast<float>(area.getY()),
-                           static_cast<float>(x), static_cast<float>(area.getBottom()), 0.5f);
-            }
+    const auto top = static_cast<float>(area.getY());
+    const auto bottom = static_cast<float>(area.getBottom());
+    for (const auto& line : gridLines.get(key, &tempoMap)) {
+        const auto x = static_cast<float>(line.x);
+        if (line.level == GridLines::Level::Major) {
+            g.setColour(DarkTheme::getColour(DarkTheme::GRID_LINE).brighter(0.3f));
+            g.drawLine(x, top, x, bottom, 1.0f);
+        } else {
+            g.setColour(DarkTheme::getColour(DarkTheme::GRID_LINE).brighter(0.1f));
+            g.drawLine(x, top, x, bottom, 0.5f);
         }
     }
 }
@@ -192,30 +213,23 @@ void GridOverlayComponent::drawBarsBeatsGrid(juce::Graphics& g, juce::Rectangle<
         }
     }
 
-    double markerIntervalSeconds = secondsPerBeat * markerIntervalBeats;
-
-    // Draw grid lines
-    for (double time = 0.0; time <= timelineLength; time += markerIntervalSeconds) {
-        int x = static_cast<int>(time * currentZoom) + leftPadding - scrollOffset;
-        if (x >= area.getX() && x <= area.getRight()) {
-            // Determine line style based on musical position
-            double totalBeats = time / secondsPerBeat;
-            bool isBarLine = std::fmod(totalBeats, timeSignatureNumerator) < 0.001;
-            bool isBeatLine = std::fmod(totalBeats, 1.0) < 0.001;
-
-            if (isBarLine) {
-                g.setColour(DarkTheme::getColour(DarkTheme::GRID_LINE).brighter(0.4f));
-                g.drawLine(static_cast<float>(x), static_cast<float>(area.getY()),
-                           static_cast<float>(x), static_cast<float>(area.getBottom()), 1.5f);
-            } else if (isBeatLine) {
-                g.setColour(DarkTheme::getColour(DarkTheme::GRID_LINE).brighter(0.2f));
-                g.drawLine(static_cast<float>(x), static_cast<float>(area.getY()),
-                           static_cast<float>(x), static_cast<float>(area.getBottom()), 1.0f);
-            } else {
-                g.setColour(DarkTheme::getColour(DarkTheme::GRID_LINE).brighter(0.05f));
-                g.drawLine(static_cast<float>(x), static_cast<float>(area.getY()),
-                           static_cast<float>(x), static_cast<float>(area.getBottom()), 0.5f);
-            }
+    auto key = makeKey(area);
+    key.interval = markerIntervalBeats;
+
+    // Line style follows the musical position
+    const auto top = static_cast<float>(area.getY());
+    const auto bottom = static_cast<float>(area.getBottom());
+    for (const auto& line : gridLines.get(key, &tempoMap)) {
+        const auto x = static_cast<float>(line.x);
+        if (line.level == GridLines::Level::Major) {
+            g.setColour(DarkTheme::getColour(DarkTheme::GRID_LINE).brighter(0.4f));
+            g.drawLine(x, top, x, bottom, 1.5f);
+        } else if (line.level == GridLines::Level::Beat) {
+            g.setColour(DarkTheme::getColour(DarkTheme::GRID_LINE).brighter(0.2f));
+            g.drawLine(x, top, x, bottom, 1.0f);
+        } else {
+            g.setColour(DarkTheme::getColour(DarkTheme::GRID_LINE).brighter(0.05f));
+            g.drawLine(x, top, x, bottom, 0.5f);
         }
     }
 }
@@ -234,12 +248,14 @@ void GridOverlayComponent::drawBeatOverlay(juce::Graphics& g, juce::Rectangle<in
 
     // Only draw beat grid if it's not too dense
     if (beatPixelSpacing >= 10) {
-        for (double beat = 0.0; beat <= timelineLength; beat += beatInterval) {
-            int x = static_cast<int>(beat * currentZoom) + leftPadding - scrollOffset;
-            if (x >= area.getX() && x <= area.getRight()) {
-                g.drawLine(static_cast<float>(x), static_cast<float>(area.getY()),
-                           static_cast<float>(x), static_cast<float>(area.getBottom()), 0.5f);
-            }
+        auto key = makeKey(area);
+        key.interval = 1.0;
+
+        const auto top = static_cast<float>(area.getY());
+        const auto bottom = static_cast<float>(area.getBottom());
+        for (const auto& line : beatLines.get(key, &tempoMap)) {
+            const auto x = static_cast<float>(line.x);
+            g.drawLine(x, top, x, bottom, 0.5f);
         }
     }
 }
@@ -2,8 +2,11 @@
 
 #include <juce_gui_basics/juce_gui_basics.h>
 
+#include <vector>
+
 #include "../../layout/LayoutConfig.hpp"
 #include "../../state/TimelineController.hpp"
+#include "GridLines.hpp"
 
 namespace magda {
 
@@ -20,7 +23,7 @@ namespace magda {
  * - Display mode (seconds vs bars/beats)
  * - Tempo and time signature
  */
-class GridOverlayComponent : public juce::Component, public TimelineStateListener {
+class GridOverlayComponent : public juce::Component {
   public:
     GridOverlayComponent();
     ~GridOverlayComponent() override;
@@ -60,13 +63,14 @@ class GridOverlayComponent : public juce::Component, public TimelineStateListene
         return scrollOffset;
     }
 
-    // TimelineStateListener implementation
-    void timelineStateChanged(const TimelineState& state) override;
-    void zoomStateChanged(const TimelineState& state) override;
+    // Timeline state handlers, subscribed per change in setController()
+    void timelineStateChanged(const TimelineState& state);
+    void zoomStateChanged(const TimelineState& state);
 
   private:
     // Controller reference (not owned)
     TimelineController* timelineController = nullptr;
+    std::vector<Subscription> timelineSubscriptions;
 
     // Cached state
     double currentZoom = 1.0;
@@ -78,11 +82,18 @@ class GridOverlayComponent : public juce::Component, public TimelineStateListene
     int leftPadding = LayoutConfig::TIMELINE_LEFT_PADDING;  // Default to match timeline
     int scrollOffset = 0;  // Horizontal scroll offset for viewport-relative drawing
 
+    // Lines are rebuilt only when zoom, scroll, size or tempo change
+    TempoMap tempoMap;
+    GridLines gridLines;
+    GridLines beatLines;  // Seconds mode's beat overlay
+
     // Grid drawing methods
     void drawTimeGrid(juce::Graphics& g, juce::Rectangle<int> area);
     void drawSecondsGrid(juce::Graphics& g, juce::Rectangle<int> area);
     void drawBarsBeatsGrid(juce::Graphics& g, juce::Rectangle<int> area);
     void drawBeatOverlay(juce::Graphics& g, juce::Rectangle<int> area);
+    GridLines::Key makeKey(juce::Rectangle<int> area) const;
+    void syncTempoMap();
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(GridOverlayComponent)
 };
@@ -0,0 +1,97 @@
+#include "IconAtlas.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <string_view>
+
+namespace magda {
+
+IconAtlas& IconAtlas::getInstance() {
+    static IconAtlas instance;
+    return instance;
+}
+
+size_t IconAtlas::hashSvg(const char* svgData, size_t svgDataSize) {
+    if (svgData == nullptr) {
+        return 0;
+    }
+    return std::hash<std::string_view>{}(std::string_view(svgData, svgDataSize));
+}
+
+size_t IconAtlas::KeyHash::operator()(const Key& key) const {
+    size_t hash = key.iconId;
+    const auto combine = [&hash](size_t value) {
+        hash ^= value + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+    };
+    combine(static_cast<size_t>(key.pixelWidth));
+    combine(static_cast<size_t>(key.pixelHeight));
+    combine(std::hash<float>{}(key.scale));
+    combine(key.from);
+    combine(key.to);
+    return hash;
+}
+
+void IconAtlas::drawWithin(juce::Graphics& g, size_t iconId, const juce::Drawable& icon,
+                           juce::Rectangle<float> area, float opacity, juce::Colour from,
+                           juce::Colour to) {
+    if (area.isEmpty()) {
+        return;
+    }
+
+    Key key;
+    key.iconId = iconId;
+    key.scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    key.pixelWidth = static_cast<int>(std::ceil(area.getWidth() * key.scale));
+    key.pixelHeight = static_cast<int>(std::ceil(area.getHeight() * key.scale));
+    key.from = from.getARGB();
+    key.to = to.getARGB();
+
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+        if (entries_.size() >= MAX_ENTRIES) {
+            evictOldest();
+        }
+        it = entries_.emplace(key, Entry{render(icon, key, area), 0}).first;
+    }
+    it->second.lastUsed = ++useClock_;
+
+    const juce::Graphics::ScopedSaveState state(g);
+    g.setOpacity(opacity);
+    g.drawImageTransformed(it->second.image, juce::AffineTransform::scale(1.0f / key.scale)
+                                                 .translated(area.getX(), area.getY()));
+}
+
+void IconAtlas::clear() {
+    entries_.clear();
+}
+
+juce::Image IconAtlas::render(const juce::Drawable& icon, const Key& key,
+                              juce::Rectangle<float> area) {
+    juce::Image image(juce::Image::ARGB, std::max(1, key.pixelWidth),
+                      std::max(1, key.pixelHeight), true);
+    juce::Graphics imageGraphics(image);
+    imageGraphics.addTransform(juce::AffineTransform::scale(key.scale));
+
+    const auto bounds = area.withZeroOrigin();
+    if (key.from == key.to) {
+        icon.drawWithin(imageGraphics, bounds, juce::RectanglePlacement::centred, 1.0f);
+    } else {
+        auto recoloured = icon.createCopy();
+        recoloured->replaceColour(juce::Colour(key.from), juce::Colour(key.to));
+        recoloured->drawWithin(imageGraphics, bounds, juce::RectanglePlacement::centred, 1.0f);
+    }
+    return image;
+}
+
+void IconAtlas::evictOldest() {
+    auto oldest = std::min_element(entries_.begin(), entries_.end(),
+                                   [](const auto& a, const auto& b) {
+                                       return a.second.lastUsed < b.second.lastUsed;
+                                   });
+    if (oldest != entries_.end()) {
+        entries_.erase(oldest);
+    }
+}
+
+}  // namespace magda
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <juce_gui_basics/juce_gui_basics.h>
+
+#include <cstddef>
+#include <unordered_map>
+
+namespace magda {
+
+/**
+ * @brief Rasterised icons, drawn once per size, display scale and colour and blitted after
+ *
+ * Rendering an SVG's paths is far dearer than drawing an image, and a mixer or a row of track
+ * headers repaints dozens of the same few icons. Each distinct rendering is kept as an image at
+ * the context's physical pixel scale, so icons stay sharp on HiDPI displays and a move to a
+ * display with another scale just renders new ones. The least recently drawn are dropped past
+ * MAX_ENTRIES.
+ *
+ * Icons are identified by the hash of their SVG source (hashSvg), so buttons showing the same
+ * icon share images. Colours are part of the key; call clear() if a theme changes the SVGs
+ * themselves. Message thread only.
+ */
+class IconAtlas {
+  public:
+    static constexpr size_t MAX_ENTRIES = 512;
+
+    static IconAtlas& getInstance();
+
+    static size_t hashSvg(const char* svgData, size_t svgDataSize);
+
+    /**
+     * @brief Draw icon centred within area, its colour from replaced by to
+     *
+     * @param iconId hashSvg() of the SVG icon was created from
+     * @param from Colour to replace; transparent draws the icon's own colours
+     */
+    void drawWithin(juce::Graphics& g, size_t iconId, const juce::Drawable& icon,
+                    juce::Rectangle<float> area, float opacity = 1.0f,
+                    juce::Colour from = juce::Colours::transparentBlack,
+                    juce::Colour to = juce::Colours::transparentBlack);
+
+    void clear();
+
+    size_t getNumEntries() const {
+        return entries_.size();
+    }
+
+  private:
+    IconAtlas() = default;
+
+    struct Key {
+        size_t iconId = 0;
+        int pixelWidth = 0;
+        int pixelHeight = 0;
+        float scale = 1.0f;
+        juce::uint32 from = 0;
+        juce::uint32 to = 0;
+
+        bool operator==(const Key& other) const = default;
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const;
+    };
+
+    struct Entry {
+        juce::Image image;
+        juce::uint64 lastUsed = 0;
+    };
+
+    juce::Image render(const juce::Drawable& icon, const Key& key, juce::Rectangle<float> area);
+    void evictOldest();
+
+    std::unordered_map<Key, Entry, KeyHash> entries_;
+    juce::uint64 useClock_ = 0;
+};
+
+}  // namespace magda
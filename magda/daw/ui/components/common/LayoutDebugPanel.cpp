@@ -22,7 +22,9 @@ LayoutDebugPanel::LayoutDebugPanel() {
     addSlider("Track Height", &layout.defaultTrackHeight, 40, 200);
     addSlider("Header Width", &layout.defaultTrackHeaderWidth, 100, 400);
 
-    setSize(220, static_cast<int>(rows.size()) * 50 + 30);
+    addAndMakeVisible(frameStats_);
+
+    setSize(300, static_cast<int>(rows.size()) * 50 + 30 + frameStats_.getPreferredHeight() + 10);
 }
 
 void LayoutDebugPanel::paint(juce::Graphics& g) {
@@ -52,6 +54,8 @@ void LayoutDebugPanel::resized() {
         row.slider->setBounds(margin, y + labelHeight + 2, getWidth() - margin * 2, sliderHeight);
         y += rowHeight;
     }
+
+    frameStats_.setBounds(margin, y, getWidth() - margin * 2, frameStats_.getPreferredHeight());
 }
 
 void LayoutDebugPanel::addSlider(const juce::String& name, int* valuePtr, int min, int max) {
@@ -2,11 +2,13 @@
 
 #include <juce_gui_basics/juce_gui_basics.h>
 
+#include "FrameStatsView.hpp"
+
 namespace magda {
 
 /**
- * Debug panel for adjusting LayoutConfig values in real-time.
- * Press F11 to toggle visibility.
+ * Debug panel for adjusting LayoutConfig values in real-time, with live UI frame stats
+ * below the sliders. Press F11 to toggle visibility.
  */
 class LayoutDebugPanel : public juce::Component {
   public:
@@ -27,6 +29,7 @@ class LayoutDebugPanel : public juce::Component {
     };
 
     std::vector<SliderRow> rows;
+    FrameStatsView frameStats_;
 
     void addSlider(const juce::String& name, int* valuePtr, int min, int max);
     void updateFromConfig();
@@ -29,9 +29,19 @@ MixerDebugPanel::MixerDebugPanel() {
     addIntSlider("Tick→Fader Gap", &metrics.tickToFaderGap, -5, 10);
     addIntSlider("Tick→Label Gap", &metrics.tickToLabelGap, -5, 10);
 
+    // Frame stats and idle chains after the sliders
+    contentComponent_->addAndMakeVisible(frameStats_);
+    chainStats_.setColour(juce::Label::textColourId,
+                          DarkTheme::getColour(DarkTheme::TEXT_PRIMARY));
+    chainStats_.setFont(FontManager::getInstance().getUIFont(11.0f));
+    chainStats_.setJustificationType(juce::Justification::topLeft);
+    chainStats_.setBorderSize({});
+    contentComponent_->addAndMakeVisible(chainStats_);
+
     // Calculate content height
-    contentHeight_ = static_cast<int>(rows.size()) * 50 + 10;
-    contentComponent_->setSize(220, contentHeight_);
+    contentHeight_ = static_cast<int>(rows.size()) * 50 + frameStats_.getPreferredHeight() +
+                     chainStatsHeight_ + 10;
+    contentComponent_->setSize(280, contentHeight_);
 
     // Create viewport
     viewport_ = std::make_unique<juce::Viewport>();
@@ -41,10 +51,37 @@ MixerDebugPanel::MixerDebugPanel() {
     addAndMakeVisible(*viewport_);
 
     // Set initial size (show all content + title bar)
-    setSize(240, contentHeight_ + 38);
+    setSize(300, contentHeight_ + 38);
 
     // Ensure we receive mouse events
     setInterceptsMouseClicks(true, true);
+
+    startTimer(500);
+}
+
+MixerDebugPanel::~MixerDebugPanel() {
+    stopTimer();
+}
+
+void MixerDebugPanel::timerCallback() {
+    if (isShowing()) {
+        refreshChainStats();
+    }
+}
+
+void MixerDebugPanel::refreshChainStats() {
+    if (!chainStatsSource) {
+        chainStats_.setText({}, juce::dontSendNotification);
+        return;
+    }
+
+    const auto stats = chainStatsSource();
+    chainStats_.setText("Idle chains: " + juce::String(stats.suspendedChains) + "/" +
+                            juce::String(stats.chains) + " suspended (" +
+                            juce::String(stats.suspendedDevices) + "/" +
+                            juce::String(stats.devices) + " devices)\nCPU saved: " +
+                            juce::String(stats.getSavedPercent(), 1) + "% of device time",
+                        juce::dontSendNotification);
 }
 
 void MixerDebugPanel::paint(juce::Graphics& g) {
@@ -92,6 +129,12 @@ void MixerDebugPanel::resized() {
         y += rowHeight;
     }
 
+    frameStats_.setBounds(sliderMargin, y, contentComponent_->getWidth() - sliderMargin * 2,
+                          frameStats_.getPreferredHeight());
+    y += frameStats_.getPreferredHeight();
+    chainStats_.setBounds(sliderMargin, y, contentComponent_->getWidth() - sliderMargin * 2,
+                          chainStatsHeight_);
+
     // Update content component size
     contentComponent_->setSize(
         viewport_->getWidth() - (viewport_->isVerticalScrollBarShown() ? 8 : 0), contentHeight_);
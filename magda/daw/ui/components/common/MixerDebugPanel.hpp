@@ -2,17 +2,20 @@
 
 #include <juce_gui_basics/juce_gui_basics.h>
 
+#include "FrameStatsView.hpp"
+#include "audio/ChainSilenceGate.hpp"
+
 namespace magda {
 
 /**
- * Debug panel for adjusting MixerMetrics values in real-time.
- * Press F12 to toggle visibility.
- * Drag the top edge to resize.
+ * Debug panel for adjusting MixerMetrics values in real-time, with live UI frame stats
+ * and idle chain suspension ("CPU saved") after the sliders. Press F12 to toggle
+ * visibility. Drag the top edge to resize.
  */
-class MixerDebugPanel : public juce::Component {
+class MixerDebugPanel : public juce::Component, private juce::Timer {
   public:
     MixerDebugPanel();
-    ~MixerDebugPanel() override = default;
+    ~MixerDebugPanel() override;
 
     void paint(juce::Graphics& g) override;
     void resized() override;
@@ -29,6 +32,9 @@ class MixerDebugPanel : public juce::Component {
     // Callback when any value changes
     std::function<void()> onMetricsChanged;
 
+    // Where the idle chain line reads from (usually the AudioBridge); hidden if unset
+    std::function<ChainSilenceGate::Stats()> chainStatsSource;
+
   private:
     struct SliderRow {
         std::unique_ptr<juce::Label> label;
@@ -39,6 +45,9 @@ class MixerDebugPanel : public juce::Component {
     };
 
     std::vector<SliderRow> rows;
+    FrameStatsView frameStats_;
+    juce::Label chainStats_;
+    static constexpr int chainStatsHeight_ = 32;
 
     // Viewport for scrollable content
     std::unique_ptr<juce::Viewport> viewport_;
@@ -56,6 +65,9 @@ class MixerDebugPanel : public juce::Component {
     int dragStartHeight_ = 0;
     int contentHeight_ = 0;
 
+    void timerCallback() override;
+    void refreshChainStats();
+
     bool isInResizeZone(const juce::Point<int>& pos) const;
     bool isInDragZone(const juce::Point<int>& pos) const;
 
@@ -2,12 +2,15 @@
 
 #include <juce_graphics/juce_graphics.h>
 
+#include "IconAtlas.hpp"
+
 namespace magda {
 
 SvgButton::SvgButton(const juce::String& buttonName, const char* svgData, size_t svgDataSize)
     : juce::Button(buttonName), dualIconMode(false) {
     // Load SVG from binary data using RAII wrapper
     svgIcon = magda::ManagedDrawable::create(svgData, svgDataSize);
+    svgIconId = IconAtlas::hashSvg(svgData, svgDataSize);
 
     if (!svgIcon) {
         DBG("Failed to create drawable from SVG for button: " + buttonName);
@@ -24,6 +27,8 @@ SvgButton::SvgButton(const juce::String& buttonName, const char* offSvgData, siz
     // Load SVGs using RAII wrapper
     svgIconOff = magda::ManagedDrawable::create(offSvgData, offSvgDataSize);
     svgIconOn = magda::ManagedDrawable::create(onSvgData, onSvgDataSize);
+    svgIconOffId = IconAtlas::hashSvg(offSvgData, offSvgDataSize);
+    svgIconOnId = IconAtlas::hashSvg(onSvgData, onSvgDataSize);
 
     // Set button properties
     setWantsKeyboardFocus(false);
@@ -37,6 +42,7 @@ SvgButton::~SvgButton() {
 void SvgButton::updateSvgData(const char* svgData, size_t svgDataSize) {
     // Load new SVG using RAII wrapper
     svgIcon = magda::ManagedDrawable::create(svgData, svgDataSize);
+    svgIconId = IconAtlas::hashSvg(svgData, svgDataSize);
 
     if (!svgIcon) {
         DBG("Failed to create drawable from SVG for button: " + getName());
@@ -49,7 +55,8 @@ void SvgButton::paintButton(juce::Graphics& g, bool shouldDrawButtonAsHighlighte
                             bool shouldDrawButtonAsDown) {
     if (dualIconMode) {
         // Dual-icon mode: use pre-baked off/on images
-        auto* iconToDraw = (active || shouldDrawButtonAsDown) ? svgIconOn.get() : svgIconOff.get();
+        const bool on = active || shouldDrawButtonAsDown;
+        auto* iconToDraw = on ? svgIconOn.get() : svgIconOff.get();
 
         if (!iconToDraw) {
             return;
@@ -64,7 +71,8 @@ void SvgButton::paintButton(juce::Graphics& g, bool shouldDrawButtonAsHighlighte
             opacity = 0.85f;
         }
 
-        iconToDraw->drawWithin(g, bounds, juce::RectanglePlacement::centred, opacity);
+        IconAtlas::getInstance().drawWithin(g, on ? svgIconOnId : svgIconOffId, *iconToDraw,
+                                            bounds, opacity);
         return;
     }
 
@@ -110,20 +118,11 @@ void SvgButton::paintButton(juce::Graphics& g, bool shouldDrawButtonAsHighlighte
     // Calculate icon bounds (centered with some padding)
     auto bounds = getLocalBounds().reduced(4);
 
-    // Create a copy of the drawable and replace colors
-    auto iconCopy = svgIcon->createCopy();
-
-    // Replace the original SVG color with our desired color
-    if (hasOriginalColor) {
-        iconCopy->replaceColour(originalColor, iconColor);
-    } else {
-        // Fallback: try common fill colors
-        iconCopy->replaceColour(juce::Colours::black, iconColor);
-        iconCopy->replaceColour(juce::Colour(0xFF000000), iconColor);
-    }
-
-    // Draw the icon
-    iconCopy->drawWithin(g, bounds.toFloat(), juce::RectanglePlacement::centred, 1.0f);
+    // Draw the icon from the atlas, the original SVG color replaced with our desired color
+    // (fallback: the common black fill)
+    const auto fromColor = hasOriginalColor ? originalColor : juce::Colours::black;
+    IconAtlas::getInstance().drawWithin(g, svgIconId, *svgIcon, bounds.toFloat(), 1.0f, fromColor,
+                                        iconColor);
 }
 
 }  // namespace magda
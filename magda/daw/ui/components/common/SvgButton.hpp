@@ -70,6 +70,11 @@ class SvgButton : public juce::Button {
     magda::ManagedDrawable svgIconOff;
     magda::ManagedDrawable svgIconOn;
 
+    // IconAtlas ids of the icons (their rasterised images are shared between buttons)
+    size_t svgIconId = 0;
+    size_t svgIconOffId = 0;
+    size_t svgIconOnId = 0;
+
     bool dualIconMode = false;
 
     // Colors for different states (single-icon mode only)
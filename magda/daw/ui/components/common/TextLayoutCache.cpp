@@ -0,0 +1,72 @@
+#include "TextLayoutCache.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <string_view>
+
+namespace magda {
+
+TextLayoutCache& TextLayoutCache::getInstance() {
+    static TextLayoutCache instance;
+    return instance;
+}
+
+void TextLayoutCache::drawText(juce::Graphics& g, const char* text, juce::Rectangle<float> area,
+                               juce::Justification justification) {
+    if (text == nullptr || *text == 0 || area.isEmpty()) {
+        return;
+    }
+
+    // Where drawText would justify the glyphs, as an offset from where they were laid out
+    const auto& entry = find(text, g.getCurrentFont());
+    const auto placed = justification.appliedToRectangle(entry.bounds, area);
+    entry.glyphs.draw(g, juce::AffineTransform::translation(placed.getX() - entry.bounds.getX(),
+                                                            placed.getY() - entry.bounds.getY()));
+}
+
+void TextLayoutCache::clear() {
+    entries_.clear();
+}
+
+const TextLayoutCache::Entry& TextLayoutCache::find(const char* text, const juce::Font& font) {
+    size_t hash = std::hash<std::string_view>{}(std::string_view(text, std::strlen(text)));
+    const auto combine = [&hash](size_t value) {
+        hash ^= value + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+    };
+    combine(static_cast<size_t>(font.getTypefaceName().hashCode64()));
+    combine(std::hash<float>{}(font.getHeight()));
+    combine(static_cast<size_t>(font.getStyleFlags()));
+
+    auto [first, last] = entries_.equal_range(hash);
+    for (auto it = first; it != last; ++it) {
+        if (it->second.font == font && it->second.text == juce::StringRef(text)) {
+            it->second.lastUsed = ++useClock_;
+            return it->second;
+        }
+    }
+
+    if (entries_.size() >= MAX_ENTRIES) {
+        evictOldest();
+    }
+
+    Entry entry;
+    entry.text = juce::String::fromUTF8(text);
+    entry.font = font;
+    entry.glyphs.addLineOfText(font, entry.text, 0.0f, 0.0f);
+    entry.bounds = entry.glyphs.getBoundingBox(0, -1, true);
+    entry.lastUsed = ++useClock_;
+    return entries_.emplace(hash, std::move(entry))->second;
+}
+
+void TextLayoutCache::evictOldest() {
+    auto oldest = std::min_element(entries_.begin(), entries_.end(),
+                                   [](const auto& a, const auto& b) {
+                                       return a.second.lastUsed < b.second.lastUsed;
+                                   });
+    if (oldest != entries_.end()) {
+        entries_.erase(oldest);
+    }
+}
+
+}  // namespace magda
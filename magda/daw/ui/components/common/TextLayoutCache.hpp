@@ -0,0 +1,70 @@
+#pragma once
+
+#include <juce_gui_basics/juce_gui_basics.h>
+
+#include <cstddef>
+#include <unordered_map>
+
+namespace magda {
+
+/**
+ * @brief Laid-out glyphs for short labels, arranged once per string and font and reused
+ *
+ * Graphics::drawText lays the string out into glyphs on every call, which for rulers and
+ * value labels repainting many times a second is most of their paint time. Each distinct
+ * (string, font) keeps its GlyphArrangement and bounding box, and drawing only moves it
+ * into place. Glyph positions are in logical units, so a display's scale doesn't change
+ * the layout and isn't part of the key. Lookups take a plain char string so callers can
+ * format numbers into a stack buffer rather than a juce::String; the least recently drawn
+ * entries are dropped past MAX_ENTRIES.
+ *
+ * Text isn't curtailed to the area like drawText does, so it suits labels that fit.
+ * Message thread only.
+ */
+class TextLayoutCache {
+  public:
+    static constexpr size_t MAX_ENTRIES = 1024;
+
+    static TextLayoutCache& getInstance();
+
+    /**
+     * @brief Draw a single line of UTF-8 text in the context's font and colour
+     */
+    void drawText(juce::Graphics& g, const char* text, juce::Rectangle<float> area,
+                  juce::Justification justification);
+
+    void drawText(juce::Graphics& g, const juce::String& text, juce::Rectangle<float> area,
+                  juce::Justification justification) {
+        drawText(g, text.toRawUTF8(), area, justification);
+    }
+
+    void drawText(juce::Graphics& g, const char* text, juce::Rectangle<int> area,
+                  juce::Justification justification) {
+        drawText(g, text, area.toFloat(), justification);
+    }
+
+    void clear();
+
+    size_t getNumEntries() const {
+        return entries_.size();
+    }
+
+  private:
+    TextLayoutCache() = default;
+
+    struct Entry {
+        juce::String text;
+        juce::Font font;
+        juce::GlyphArrangement glyphs;
+        juce::Rectangle<float> bounds;  // Of the glyphs, laid out from the origin
+        juce::uint64 lastUsed = 0;
+    };
+
+    const Entry& find(const char* text, const juce::Font& font);
+    void evictOldest();
+
+    std::unordered_multimap<size_t, Entry> entries_;  // By hash of text and font
+    juce::uint64 useClock_ = 0;
+};
+
+}  // namespace magda
@@ -4,6 +4,7 @@
 
 #include <functional>
 
+#include "TextLayoutCache.hpp"
 #include "ui/themes/DarkTheme.hpp"
 #include "ui/themes/FontManager.hpp"
 
@@ -13,14 +14,20 @@ namespace magda::daw::ui {
  * @brief A text-based slider that displays value as editable text
  *
  * Click to edit, drag to change value. Supports dB and pan formatting.
+ *
+ * The label only draws the background and hosts the editor; the value is drawn over it
+ * from TextLayoutCache, and a value change repaints only if the text it shows changes.
  */
 class TextSlider : public juce::Component, public juce::Label::Listener {
   public:
     enum class Format { Decimal, Decibels, Pan };
 
     TextSlider(Format format = Format::Decimal) : format_(format) {
-        label_.setFont(FontManager::getInstance().getUIFont(12.0f));
-        label_.setColour(juce::Label::textColourId, DarkTheme::getTextColour());
+        font_ = FontManager::getInstance().getUIFont(12.0f);
+        textColour_ = DarkTheme::getTextColour();
+        label_.setFont(font_);
+        label_.setColour(juce::Label::textColourId, juce::Colours::transparentBlack);
+        label_.setColour(juce::Label::textWhenEditingColourId, textColour_);
         label_.setColour(juce::Label::backgroundColourId, DarkTheme::getColour(DarkTheme::SURFACE));
         label_.setColour(juce::Label::outlineColourId, DarkTheme::getColour(DarkTheme::BORDER));
         label_.setColour(juce::Label::outlineWhenEditingColourId,
@@ -71,11 +78,15 @@ class TextSlider : public juce::Component, public juce::Label::Listener {
     }
 
     void setFont(const juce::Font& font) {
+        font_ = font;
         label_.setFont(font);
+        repaint();
     }
 
     void setTextColour(const juce::Colour& colour) {
-        label_.setColour(juce::Label::textColourId, colour);
+        textColour_ = colour;
+        label_.setColour(juce::Label::textWhenEditingColourId, colour);
+        repaint();
     }
 
     void setBackgroundColour(const juce::Colour& colour) {
@@ -129,6 +140,17 @@ class TextSlider : public juce::Component, public juce::Label::Listener {
         label_.setBounds(getLocalBounds());
     }
 
+    void paintOverChildren(juce::Graphics& g) override {
+        if (label_.isBeingEdited()) {
+            return;
+        }
+        g.setColour(textColour_);
+        g.setFont(font_);
+        TextLayoutCache::getInstance().drawText(
+            g, displayText_, label_.getBorderSize().subtractedFrom(getLocalBounds()).toFloat(),
+            label_.getJustificationType());
+    }
+
     void mouseDown(const juce::MouseEvent& e) override {
         if (!label_.isBeingEdited() && e.mods.isLeftButtonDown()) {
             dragStartValue_ = value_;
@@ -206,7 +228,7 @@ class TextSlider : public juce::Component, public juce::Label::Listener {
             if (e.mods.isPopupMenu()) {
                 if (rightClickEditsText_) {
                     // Right-click to edit text directly
-                    label_.showEditor();
+                    showEditor();
                 } else if (onRightClicked) {
                     // Right-click callback (for context menus, etc.)
                     onRightClicked();
@@ -221,7 +243,7 @@ class TextSlider : public juce::Component, public juce::Label::Listener {
 
     void mouseDoubleClick(const juce::MouseEvent&) override {
         // Double-click to edit value
-        label_.showEditor();
+        showEditor();
     }
 
     // Label::Listener
@@ -253,6 +275,9 @@ class TextSlider : public juce::Component, public juce::Label::Listener {
 
   private:
     juce::Label label_;
+    juce::String displayText_;  // Drawn over the label while it isn't being edited
+    juce::Font font_;
+    juce::Colour textColour_;
     Format format_;
     double value_ = 0.0;
     double minValue_ = 0.0;
@@ -273,16 +298,29 @@ class TextSlider : public juce::Component, public juce::Label::Listener {
     std::function<double(const juce::String&)>
         valueParser_;  // Custom value parsing (string → normalized)
 
+    // The editor starts from the text on show; the label keeps none otherwise
+    void showEditor() {
+        label_.setText(displayText_, juce::dontSendNotification);
+        label_.showEditor();
+    }
+
+    void setDisplayText(const juce::String& text) {
+        if (text != displayText_) {
+            displayText_ = text;
+            repaint();
+        }
+    }
+
     void updateLabel() {
         // Show empty text instead of value when disabled/empty
         if (showEmptyText_) {
-            label_.setText(emptyText_, juce::dontSendNotification);
+            setDisplayText(emptyText_);
             return;
         }
 
         // Use custom formatter if provided
         if (valueFormatter_) {
-            label_.setText(valueFormatter_(value_), juce::dontSendNotification);
+            setDisplayText(valueFormatter_(value_));
             return;
         }
 
@@ -313,7 +351,7 @@ class TextSlider : public juce::Component, public juce::Label::Listener {
                 break;
         }
 
-        label_.setText(text, juce::dontSendNotification);
+        setDisplayText(text);
     }
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TextSlider)
@@ -0,0 +1,131 @@
+#include "TileImageCache.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace magda {
+
+void TileImageCache::paint(juce::Graphics& g, juce::Rectangle<int> bounds,
+                           const PaintFunction& paintContent) {
+    if (bounds.isEmpty()) {
+        return;
+    }
+
+    const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    if (bounds != bounds_ && scaledPreviewAllowed_ && paintScaledPreview(g, bounds, scale)) {
+        return;
+    }
+    if (bounds != bounds_ || scale != scale_) {
+        invalidate();
+        bounds_ = bounds;
+        scale_ = scale;
+    }
+
+    const auto visible = g.getClipBounds().getIntersection(bounds);
+    if (visible.isEmpty()) {
+        return;
+    }
+
+    const int first = (visible.getX() - bounds.getX()) / TILE_WIDTH;
+    const int last = (visible.getRight() - 1 - bounds.getX()) / TILE_WIDTH;
+
+    for (int index = first; index <= last; ++index) {
+        const auto& image = getTile(index, paintContent);
+        const auto tileX = static_cast<float>(bounds.getX() + index * TILE_WIDTH);
+        g.drawImageTransformed(image, juce::AffineTransform::scale(1.0f / scale_).translated(
+                                          tileX, static_cast<float>(bounds.getY())));
+    }
+
+    // Drop the least recently drawn tiles; the ones just drawn are the newest
+    while (tiles_.size() > static_cast<size_t>(MAX_TILES)) {
+        auto oldest = std::min_element(
+            tiles_.begin(), tiles_.end(),
+            [](const Tile& a, const Tile& b) { return a.lastUsed < b.lastUsed; });
+        tiles_.erase(oldest);
+    }
+}
+
+bool TileImageCache::paintScaledPreview(juce::Graphics& g, juce::Rectangle<int> bounds,
+                                        float scale) {
+    if (tiles_.empty() || scale != scale_ || bounds.getY() != bounds_.getY() ||
+        bounds.getHeight() != bounds_.getHeight() || bounds_.getWidth() <= 0) {
+        return false;
+    }
+
+    const double stretch =
+        static_cast<double>(bounds.getWidth()) / static_cast<double>(bounds_.getWidth());
+    if (stretch > MAX_PREVIEW_STRETCH || stretch < 1.0 / MAX_PREVIEW_STRETCH) {
+        return false;
+    }
+
+    const auto visible = g.getClipBounds().getIntersection(bounds);
+    if (visible.isEmpty()) {
+        return true;
+    }
+
+    // The tiles covering the visible part, in the rendered width; any missing means a
+    // real render, since paintContent only draws at the current size
+    const auto toRendered = [&](int x) {
+        return static_cast<int>((x - bounds.getX()) / stretch);
+    };
+    const int first = juce::jmax(0, toRendered(visible.getX()) / TILE_WIDTH);
+    const int last = juce::jmin((bounds_.getWidth() - 1) / TILE_WIDTH,
+                                toRendered(visible.getRight() - 1) / TILE_WIDTH);
+    for (int index = first; index <= last; ++index) {
+        const bool cached = std::any_of(tiles_.begin(), tiles_.end(),
+                                        [index](const Tile& tile) { return tile.index == index; });
+        if (!cached) {
+            return false;
+        }
+    }
+
+    juce::Graphics::ScopedSaveState saveState(g);
+    g.setImageResamplingQuality(juce::Graphics::lowResamplingQuality);
+    for (auto& tile : tiles_) {
+        if (tile.index < first || tile.index > last) {
+            continue;
+        }
+        tile.lastUsed = ++useClock_;
+        const auto tileX = static_cast<float>(bounds.getX() + tile.index * TILE_WIDTH * stretch);
+        g.drawImageTransformed(tile.image,
+                               juce::AffineTransform::scale(static_cast<float>(stretch) / scale_,
+                                                            1.0f / scale_)
+                                   .translated(tileX, static_cast<float>(bounds.getY())));
+    }
+    return true;
+}
+
+void TileImageCache::invalidate() {
+    tiles_.clear();
+}
+
+const juce::Image& TileImageCache::getTile(int index, const PaintFunction& paintContent) {
+    auto it = std::find_if(tiles_.begin(), tiles_.end(),
+                           [index](const Tile& tile) { return tile.index == index; });
+    if (it != tiles_.end()) {
+        it->lastUsed = ++useClock_;
+        return it->image;
+    }
+
+    const int tileX = bounds_.getX() + index * TILE_WIDTH;
+    const int width = std::min(TILE_WIDTH, bounds_.getRight() - tileX);
+    const int pixelWidth = static_cast<int>(std::ceil(width * scale_));
+    const int pixelHeight = static_cast<int>(std::ceil(bounds_.getHeight() * scale_));
+
+    Tile tile;
+    tile.index = index;
+    tile.lastUsed = ++useClock_;
+    tile.image = juce::Image(juce::Image::ARGB, std::max(1, pixelWidth), std::max(1, pixelHeight),
+                             true);
+    {
+        juce::Graphics tileGraphics(tile.image);
+        tileGraphics.addTransform(juce::AffineTransform::scale(scale_));
+        tileGraphics.setOrigin(-tileX, -bounds_.getY());
+        paintContent(tileGraphics);
+    }
+
+    tiles_.push_back(std::move(tile));
+    return tiles_.back().image;
+}
+
+}  // namespace magda
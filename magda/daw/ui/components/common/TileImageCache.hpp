@@ -0,0 +1,72 @@
+#pragma once
+
+#include <juce_gui_basics/juce_gui_basics.h>
+
+#include <functional>
+#include <vector>
+
+namespace magda {
+
+/**
+ * @brief Offscreen image cache for a component's static content, in fixed-width tiles
+ *
+ * paint() blits the tiles covering the graphics context's clip region and renders any that
+ * are missing with the supplied callback, so repaints caused by overlays (selection, hover,
+ * cursors drawn by a parent) composite cached bitmaps instead of redrawing the content.
+ * Tiles are rendered at the context's physical pixel scale to stay sharp on HiDPI displays.
+ *
+ * A long clip at high zoom can be hundreds of thousands of pixels wide, so only tiles that
+ * were actually drawn exist, and the least recently drawn are dropped past MAX_TILES.
+ *
+ * The owner calls invalidate() when the content changes; a change of bounds or display
+ * scale invalidates automatically. While scaled previews are allowed (during a zoom
+ * gesture), a change of width alone stretches the tiles already rendered instead, as long
+ * as they cover what's visible and are within MAX_PREVIEW_STRETCH of the new width; the
+ * next paint after previews are turned off renders at the real size.
+ */
+class TileImageCache {
+  public:
+    using PaintFunction = std::function<void(juce::Graphics&)>;
+
+    /**
+     * @brief Draw the cached content of bounds, rendering missing tiles with paintContent
+     *
+     * paintContent draws in the same coordinates as g and may be called once per tile.
+     */
+    void paint(juce::Graphics& g, juce::Rectangle<int> bounds, const PaintFunction& paintContent);
+
+    void invalidate();
+
+    /**
+     * @brief Let a width change stretch the existing tiles rather than re-render them
+     */
+    void setScaledPreviewAllowed(bool allowed) {
+        scaledPreviewAllowed_ = allowed;
+    }
+
+    int getNumTiles() const {
+        return static_cast<int>(tiles_.size());
+    }
+
+    static constexpr int TILE_WIDTH = 512;
+    static constexpr int MAX_TILES = 16;
+    static constexpr double MAX_PREVIEW_STRETCH = 2.0;
+
+  private:
+    struct Tile {
+        int index = 0;
+        juce::Image image;
+        juce::uint64 lastUsed = 0;
+    };
+
+    const juce::Image& getTile(int index, const PaintFunction& paintContent);
+    bool paintScaledPreview(juce::Graphics& g, juce::Rectangle<int> bounds, float scale);
+
+    std::vector<Tile> tiles_;
+    juce::Rectangle<int> bounds_;  // Bounds the tiles were rendered for
+    float scale_ = 1.0f;
+    juce::uint64 useClock_ = 0;
+    bool scaledPreviewAllowed_ = false;
+};
+
+}  // namespace magda
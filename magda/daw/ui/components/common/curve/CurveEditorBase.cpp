@@ -1,10 +1,30 @@
 #include "CurveEditorBase.hpp"
 
 #include <algorithm>
-#include <map>
+
+#include "CurveGeometry.hpp"
 
 namespace magda {
 
+namespace {
+
+// How far along a segment's rise a tensioned curve is at t (0-1)
+double applyTension(double t, double tension) {
+    if (std::abs(tension) <= 0.001) {
+        return t;
+    }
+    if (tension > 0) {
+        return std::pow(t, 1.0 + tension * 2.0);
+    }
+    return 1.0 - std::pow(1.0 - t, 1.0 - tension * 2.0);
+}
+
+// Segments at least this wide are sampled when simplified, so their shape survives
+constexpr double kMinSampledSegmentPixels = 4.0;
+constexpr int kSegmentSamples = 16;
+
+}  // namespace
+
 CurveEditorBase::CurveEditorBase() {
     setName("CurveEditorBase");
 }
@@ -48,99 +68,24 @@ void CurveEditorBase::paintCurve(juce::Graphics& g) {
         return;
 
     // Clear stale preview state if the preview point no longer exists
-    if (previewPointId_ != INVALID_CURVE_POINT_ID) {
-        bool found = false;
-        for (const auto& p : points) {
-            if (p.id == previewPointId_) {
-                found = true;
-                break;
-            }
-        }
-        if (!found) {
-            previewPointId_ = INVALID_CURVE_POINT_ID;
-        }
+    if (previewPointId_ != INVALID_CURVE_POINT_ID && indexOfPoint(previewPointId_) < 0) {
+        previewPointId_ = INVALID_CURVE_POINT_ID;
     }
-    if (tensionPreviewPointId_ != INVALID_CURVE_POINT_ID) {
-        bool found = false;
-        for (const auto& p : points) {
-            if (p.id == tensionPreviewPointId_) {
-                found = true;
-                break;
-            }
-        }
-        if (!found) {
-            tensionPreviewPointId_ = INVALID_CURVE_POINT_ID;
-        }
-    }
-
-    // Create path for curve
-    juce::Path curvePath;
-    bool pathStarted = false;
-
-    // Handle edge behavior based on loop mode
-    if (shouldLoop()) {
-        // For looping (LFO): Edge points are pinned at x=0 and x=1
-        // Just start at the first point - no extra wrap segment needed
-        if (!points.empty()) {
-            auto [firstX, firstY] = getEffectivePosition(points.front());
-            int firstPixelX = xToPixel(firstX);
-            int firstPixelY = yToPixel(firstY);
-            curvePath.startNewSubPath(static_cast<float>(firstPixelX),
-                                      static_cast<float>(firstPixelY));
-            pathStarted = true;
-        }
-    } else {
-        // For non-looping (automation): Extend from left edge at first point's value
-        if (!points.empty()) {
-            auto [firstX, firstY] = getEffectivePosition(points.front());
-            int firstPixelX = xToPixel(firstX);
-            int firstPixelY = yToPixel(firstY);
-
-            if (firstPixelX > 0) {
-                curvePath.startNewSubPath(0.0f, static_cast<float>(firstPixelY));
-                curvePath.lineTo(static_cast<float>(firstPixelX), static_cast<float>(firstPixelY));
-                pathStarted = true;
-            }
-        }
+    if (tensionPreviewPointId_ != INVALID_CURVE_POINT_ID &&
+        indexOfPoint(tensionPreviewPointId_) < 0) {
+        tensionPreviewPointId_ = INVALID_CURVE_POINT_ID;
     }
 
-    // Draw between points
-    for (size_t i = 0; i < points.size(); ++i) {
-        const auto& p = points[i];
-        auto [x, y] = getEffectivePosition(p);
-        int pixelX = xToPixel(x);
-        int pixelY = yToPixel(y);
-
-        if (!pathStarted) {
-            curvePath.startNewSubPath(static_cast<float>(pixelX), static_cast<float>(pixelY));
-            pathStarted = true;
-        } else if (i > 0) {
-            const auto& prevP = points[i - 1];
-
-            // Get effective tension (use preview if dragging this segment)
-            double effectiveTension = prevP.tension;
-            if (tensionPreviewPointId_ != INVALID_CURVE_POINT_ID &&
-                prevP.id == tensionPreviewPointId_) {
-                effectiveTension = tensionPreviewValue_;
-            }
-
-            renderCurveSegment(curvePath, prevP, p, effectiveTension);
-        }
-    }
+    // Only the points in the repainted area, plus a neighbour each side for the segments
+    // that cross into it
+    const auto clip = g.getClipBounds();
+    const auto [begin, end] = getVisibleRange(points, clip);
 
-    // Handle edge behavior at the end
-    if (shouldLoop()) {
-        // For looping (LFO): Edge points are pinned at x=0 and x=1
-        // The curve ends at the last point - no extra segment needed
+    juce::Path curvePath;
+    if (shouldSimplify(points)) {
+        buildSimplifiedPath(curvePath, points, begin, end, clip);
     } else {
-        // For non-looping: Extend to right edge at last point's value
-        if (!points.empty()) {
-            auto [lastX, lastY] = getEffectivePosition(points.back());
-            juce::ignoreUnused(lastX);
-            int lastPixelY = yToPixel(lastY);
-            int width = getWidth();
-            curvePath.lineTo(static_cast<float>(width), static_cast<float>(lastPixelY));
-        }
+        buildCurvePath(curvePath, points, begin, end);
     }
 
     // Draw the curve
@@ -156,6 +101,252 @@ void CurveEditorBase::paintCurve(juce::Graphics& g) {
     fillPath.closeSubPath();
     g.setColour(curveColour_.withAlpha(0.13f));
     g.fillPath(fillPath);
+
+    paintPoints(g, points, begin, end);
+}
+
+std::pair<size_t, size_t> CurveEditorBase::getVisibleRange(const std::vector<CurvePoint>& points,
+                                                           juce::Rectangle<int> clip) const {
+    const int margin = CurvePointComponent::HIT_SIZE;
+    auto [begin, end] = CurveGeometry::findRange(points, pixelToX(clip.getX() - margin),
+                                                 pixelToX(clip.getRight() + margin));
+    if (begin > 0) {
+        --begin;
+    }
+    return {begin, std::min(end + 1, points.size())};
+}
+
+bool CurveEditorBase::shouldSimplify(const std::vector<CurvePoint>& points) const {
+    if (shouldLoop() || points.size() < 3) {
+        return false;
+    }
+    const double spanPixels = (points.back().x - points.front().x) * getPixelsPerX();
+    return static_cast<double>(points.size() - 1) > spanPixels / kSimplifyMinPixelsPerPoint;
+}
+
+void CurveEditorBase::buildCurvePath(juce::Path& path, const std::vector<CurvePoint>& points,
+                                     size_t begin, size_t end) {
+    auto [firstX, firstY] = getEffectivePosition(points[begin]);
+    const int firstPixelX = xToPixel(firstX);
+    const int firstPixelY = yToPixel(firstY);
+
+    // For non-looping (automation): Extend from left edge at first point's value.
+    // For looping (LFO): Edge points are pinned at x=0 and x=1, so start at the first point
+    if (!shouldLoop() && begin == 0 && firstPixelX > 0) {
+        path.startNewSubPath(0.0f, static_cast<float>(firstPixelY));
+        path.lineTo(static_cast<float>(firstPixelX), static_cast<float>(firstPixelY));
+    } else {
+        path.startNewSubPath(static_cast<float>(firstPixelX), static_cast<float>(firstPixelY));
+    }
+
+    // Draw between points
+    for (size_t i = begin + 1; i < end; ++i) {
+        const auto& prevP = points[i - 1];
+        renderCurveSegment(path, prevP, points[i], getEffectiveTension(prevP));
+    }
+
+    // For non-looping: Extend to right edge at last point's value
+    if (!shouldLoop() && end == points.size()) {
+        auto [lastX, lastY] = getEffectivePosition(points.back());
+        juce::ignoreUnused(lastX);
+        path.lineTo(static_cast<float>(getWidth()), static_cast<float>(yToPixel(lastY)));
+    }
+}
+
+void CurveEditorBase::buildSimplifiedPath(juce::Path& path, const std::vector<CurvePoint>& points,
+                                          size_t begin, size_t end, juce::Rectangle<int> clip) {
+    std::vector<juce::Point<double>> previewCurve;
+    const std::vector<juce::Point<double>>* curve = &simplifiedCurve_;
+    size_t first = 0;
+    size_t last = 0;
+    bool startsCurve = false;
+    bool endsCurve = false;
+
+    if (previewPointId_ != INVALID_CURVE_POINT_ID ||
+        tensionPreviewPointId_ != INVALID_CURVE_POINT_ID) {
+        // Mid-drag: simplify just what's on screen, with the dragged values
+        previewCurve = simplify(buildPolyline(points, begin, end));
+        curve = &previewCurve;
+        last = previewCurve.size();
+        startsCurve = begin == 0;
+        endsCurve = end == points.size();
+    } else {
+        // Otherwise the whole curve is simplified once per zoom and scrolling reuses it
+        if (simplifiedVersion_ != pointsVersion_ || simplifiedPixelsPerX_ != getPixelsPerX() ||
+            simplifiedPixelsPerY_ != getPixelsPerY()) {
+            simplifiedCurve_ = simplify(buildPolyline(points, 0, points.size()));
+            simplifiedVersion_ = pointsVersion_;
+            simplifiedPixelsPerX_ = getPixelsPerX();
+            simplifiedPixelsPerY_ = getPixelsPerY();
+        }
+
+        const double minX = pixelToX(clip.getX());
+        const double maxX = pixelToX(clip.getRight());
+        first = static_cast<size_t>(
+            std::lower_bound(simplifiedCurve_.begin(), simplifiedCurve_.end(), minX,
+                             [](const auto& v, double x) { return v.x < x; }) -
+            simplifiedCurve_.begin());
+        last = static_cast<size_t>(
+            std::upper_bound(simplifiedCurve_.begin(), simplifiedCurve_.end(), maxX,
+                             [](double x, const auto& v) { return x < v.x; }) -
+            simplifiedCurve_.begin());
+        first = first > 0 ? first - 1 : 0;
+        last = std::min(last + 1, simplifiedCurve_.size());
+        startsCurve = first == 0;
+        endsCurve = last == simplifiedCurve_.size();
+    }
+
+    if (first >= last) {
+        return;
+    }
+
+    const auto& vertices = *curve;
+    const float firstPixelX = static_cast<float>(xToPixel(vertices[first].x));
+    const float firstPixelY = static_cast<float>(yToPixel(vertices[first].y));
+    if (startsCurve && firstPixelX > 0.0f) {
+        path.startNewSubPath(0.0f, firstPixelY);
+        path.lineTo(firstPixelX, firstPixelY);
+    } else {
+        path.startNewSubPath(firstPixelX, firstPixelY);
+    }
+    for (size_t i = first + 1; i < last; ++i) {
+        path.lineTo(static_cast<float>(xToPixel(vertices[i].x)),
+                    static_cast<float>(yToPixel(vertices[i].y)));
+    }
+    if (endsCurve) {
+        path.lineTo(static_cast<float>(getWidth()),
+                    static_cast<float>(yToPixel(vertices[last - 1].y)));
+    }
+}
+
+std::vector<juce::Point<double>> CurveEditorBase::buildPolyline(
+    const std::vector<CurvePoint>& points, size_t begin, size_t end) const {
+    std::vector<juce::Point<double>> vertices;
+    vertices.reserve(end - begin);
+
+    for (size_t i = begin; i < end; ++i) {
+        auto [x2, y2] = getEffectivePosition(points[i]);
+        if (i == begin) {
+            vertices.push_back({x2, y2});
+            continue;
+        }
+
+        const auto& p1 = points[i - 1];
+        auto [x1, y1] = getEffectivePosition(p1);
+        const bool sampled = (x2 - x1) * getPixelsPerX() >= kMinSampledSegmentPixels;
+
+        switch (p1.curveType) {
+            case CurveType::Step:
+                vertices.push_back({x2, y1});
+                break;
+
+            case CurveType::Linear: {
+                const double tension = getEffectiveTension(p1);
+                if (sampled && std::abs(tension) > 0.001) {
+                    for (int seg = 1; seg < kSegmentSamples; ++seg) {
+                        const double t = static_cast<double>(seg) / kSegmentSamples;
+                        vertices.push_back(
+                            {x1 + t * (x2 - x1), y1 + applyTension(t, tension) * (y2 - y1)});
+                    }
+                }
+                break;
+            }
+
+            case CurveType::Bezier:
+                if (sampled) {
+                    const juce::Point<double> c1{x1 + p1.outHandle.x, y1 + p1.outHandle.y};
+                    const juce::Point<double> c2{x2 + points[i].inHandle.x,
+                                                 y2 + points[i].inHandle.y};
+                    for (int seg = 1; seg < kSegmentSamples; ++seg) {
+                        const double t = static_cast<double>(seg) / kSegmentSamples;
+                        const double u = 1.0 - t;
+                        const double a = u * u * u;
+                        const double b = 3.0 * u * u * t;
+                        const double c = 3.0 * u * t * t;
+                        const double d = t * t * t;
+                        vertices.push_back({a * x1 + b * c1.x + c * c2.x + d * x2,
+                                            a * y1 + b * c1.y + c * c2.y + d * y2});
+                    }
+                }
+                break;
+        }
+        vertices.push_back({x2, y2});
+    }
+    return vertices;
+}
+
+std::vector<juce::Point<double>> CurveEditorBase::simplify(
+    std::vector<juce::Point<double>> vertices) const {
+    if (vertices.size() <= 2) {
+        return vertices;
+    }
+
+    // Tolerance is in pixels, so measure in pixels (relative to the first vertex, which keeps
+    // float precision on long timelines)
+    const auto origin = vertices.front();
+    const double pixelsPerX = getPixelsPerX();
+    const double pixelsPerY = getPixelsPerY();
+    std::vector<juce::Point<float>> projected;
+    projected.reserve(vertices.size());
+    for (const auto& v : vertices) {
+        projected.push_back({static_cast<float>((v.x - origin.x) * pixelsPerX),
+                             static_cast<float>((origin.y - v.y) * pixelsPerY)});
+    }
+
+    std::vector<juce::Point<double>> kept;
+    for (auto index : CurveGeometry::simplifyPolyline(projected, kSimplifyTolerancePixels)) {
+        kept.push_back(vertices[index]);
+    }
+    return kept;
+}
+
+void CurveEditorBase::paintPoints(juce::Graphics& g, const std::vector<CurvePoint>& points,
+                                  size_t begin, size_t end) {
+    // Packed too close the dots are a smear, so only selected and hovered ones are drawn
+    bool showDots = true;
+    if (end - begin >= 2) {
+        const double spanPixels = (points[end - 1].x - points[begin].x) * getPixelsPerX();
+        showDots = spanPixels >= kMinDotSpacingPixels * static_cast<double>(end - begin - 1);
+    }
+
+    for (size_t i = begin; i < end; ++i) {
+        const auto& point = points[i];
+        const bool selected = isPointSelected(point.id);
+        const bool hovered = point.id == hoveredPointId_;
+        if (!showDots && !selected && !hovered) {
+            continue;
+        }
+
+        // Selected points with a component draw themselves
+        if (selected && std::any_of(pointComponents_.begin(), pointComponents_.end(),
+                                    [&point](const auto& pc) {
+                                        return pc->getPointId() == point.id && pc->isVisible();
+                                    })) {
+            continue;
+        }
+
+        auto [x, y] = getEffectivePosition(point);
+        const float size = static_cast<float>(selected ? CurvePointComponent::POINT_SIZE_SELECTED
+                                                       : CurvePointComponent::POINT_SIZE);
+        const auto dot = juce::Rectangle<float>(size, size).withCentre(
+            {static_cast<float>(xToPixel(x)), static_cast<float>(yToPixel(y))});
+
+        // Same look as CurvePointComponent
+        g.setColour(selected  ? juce::Colour(0xFFFFFFFF)
+                    : hovered ? juce::Colour(0xFFCCCCCC)
+                              : juce::Colour(0xFFAAAAAA));
+        g.fillEllipse(dot);
+        g.setColour(juce::Colour(0xFF333333));
+        g.drawEllipse(dot, 1.5f);
+    }
+}
+
+double CurveEditorBase::getEffectiveTension(const CurvePoint& p) const {
+    // Use preview tension if dragging this segment
+    if (tensionPreviewPointId_ != INVALID_CURVE_POINT_ID && p.id == tensionPreviewPointId_) {
+        return tensionPreviewValue_;
+    }
+    return p.tension;
 }
 
 void CurveEditorBase::renderCurveSegment(juce::Path& path, const CurvePoint& p1,
@@ -167,15 +358,6 @@ void CurveEditorBase::renderCurveSegment(juce::Path& path, const CurvePoint& p1,
     int pixelX2 = xToPixel(x2);
     int pixelY2 = yToPixel(y2);
 
-    // DEBUG: Check if path current position matches p1
-    auto currentPos = path.getCurrentPosition();
-    if (std::abs(currentPos.x - pixelX1) > 2 || std::abs(currentPos.y - pixelY1) > 2) {
-        DBG("!!! PATH MISMATCH !!! pathPos=(" + juce::String(currentPos.x) + "," +
-            juce::String(currentPos.y) + ")" + " p1Pixel=(" + juce::String(pixelX1) + "," +
-            juce::String(pixelY1) + ")" + " p1=(" + juce::String(x1) + "," + juce::String(y1) +
-            ")");
-    }
-
     switch (p1.curveType) {
         case CurveType::Linear: {
             if (std::abs(effectiveTension) < 0.001) {
@@ -183,25 +365,10 @@ void CurveEditorBase::renderCurveSegment(juce::Path& path, const CurvePoint& p1,
                 path.lineTo(static_cast<float>(pixelX2), static_cast<float>(pixelY2));
             } else {
                 // Tension-based curve - draw as series of line segments
-                const int NUM_SEGMENTS = 16;
-                for (int seg = 1; seg <= NUM_SEGMENTS; ++seg) {
-                    double t = static_cast<double>(seg) / NUM_SEGMENTS;
-
-                    // Apply tension curve (tension can be -3 to +3 with Shift)
-                    double curvedT;
-                    if (effectiveTension > 0) {
-                        curvedT = std::pow(t, 1.0 + effectiveTension * 2.0);
-                    } else {
-                        curvedT = 1.0 - std::pow(1.0 - t, 1.0 - effectiveTension * 2.0);
-                    }
-
-                    double segY = y1 + curvedT * (y2 - y1);
-                    double segX = x1 + t * (x2 - x1);
-
-                    float segPixelX = static_cast<float>(xToPixel(segX));
-                    float segPixelY = static_cast<float>(yToPixel(segY));
-
-                    path.lineTo(segPixelX, segPixelY);
+                for (const auto& vertex : getSegmentSamples(p1.id, x1, y1, x2, y2,
+                                                            effectiveTension)) {
+                    path.lineTo(static_cast<float>(xToPixel(vertex.x)),
+                                static_cast<float>(yToPixel(vertex.y)));
                 }
             }
             break;
@@ -227,6 +394,29 @@ void CurveEditorBase::renderCurveSegment(juce::Path& path, const CurvePoint& p1,
     }
 }
 
+const std::vector<juce::Point<double>>& CurveEditorBase::getSegmentSamples(
+    uint32_t startId, double x1, double y1, double x2, double y2, double tension) {
+    auto& samples = segmentSamples_[startId];
+    if (!samples.vertices.empty() && samples.x1 == x1 && samples.y1 == y1 && samples.x2 == x2 &&
+        samples.y2 == y2 && samples.tension == tension) {
+        return samples.vertices;
+    }
+
+    samples.x1 = x1;
+    samples.y1 = y1;
+    samples.x2 = x2;
+    samples.y2 = y2;
+    samples.tension = tension;
+    samples.vertices.clear();
+    samples.vertices.reserve(kSegmentSamples);
+    for (int seg = 1; seg <= kSegmentSamples; ++seg) {
+        const double t = static_cast<double>(seg) / kSegmentSamples;
+        // Apply tension curve (tension can be -3 to +3 with Shift)
+        samples.vertices.push_back({x1 + t * (x2 - x1), y1 + applyTension(t, tension) * (y2 - y1)});
+    }
+    return samples.vertices;
+}
+
 void CurveEditorBase::paintDrawingPreview(juce::Graphics& g) {
     if (drawMode_ == CurveDrawMode::Pencil && !drawingPath_.empty()) {
         g.setColour(juce::Colour(0xAAFFFFFF));
@@ -244,8 +434,50 @@ void CurveEditorBase::paintDrawingPreview(juce::Graphics& g) {
     }
 }
 
+// =============================================================================
+// Mouse
+// =============================================================================
+
+uint32_t CurveEditorBase::findPointAt(juce::Point<int> position) const {
+    const auto& points = getPoints();
+    if (points.empty()) {
+        return INVALID_CURVE_POINT_ID;
+    }
+
+    // Candidates by x from the sorted points, then the nearest within reach
+    const int reach = CurvePointComponent::HIT_SIZE / 2;
+    const auto [begin, end] = CurveGeometry::findRange(points, pixelToX(position.x - reach),
+                                                       pixelToX(position.x + reach));
+
+    uint32_t nearest = INVALID_CURVE_POINT_ID;
+    int nearestDistanceSquared = reach * reach;
+    for (size_t i = begin; i < end; ++i) {
+        auto [x, y] = getEffectivePosition(points[i]);
+        const int dx = xToPixel(x) - position.x;
+        const int dy = yToPixel(y) - position.y;
+        const int distanceSquared = dx * dx + dy * dy;
+        if (distanceSquared <= nearestDistanceSquared) {
+            nearestDistanceSquared = distanceSquared;
+            nearest = points[i].id;
+        }
+    }
+    return nearest;
+}
+
 void CurveEditorBase::mouseDown(const juce::MouseEvent& e) {
     if (e.mods.isLeftButtonDown()) {
+        // Points take the click in any mode, as their components used to
+        const auto pointId = findPointAt(e.getPosition());
+        if (pointId != INVALID_CURVE_POINT_ID) {
+            const int index = indexOfPoint(pointId);
+            dragPointId_ = pointId;
+            dragStartPos_ = e.getPosition();
+            dragStartX_ = getPoints()[static_cast<size_t>(index)].x;
+            dragStartY_ = getPoints()[static_cast<size_t>(index)].y;
+            onPointSelected(pointId);
+            return;
+        }
+
         switch (drawMode_) {
             case CurveDrawMode::Select:
                 // Click on empty area - subclass handles deselection
@@ -273,6 +505,12 @@ void CurveEditorBase::mouseDown(const juce::MouseEvent& e) {
 }
 
 void CurveEditorBase::mouseDrag(const juce::MouseEvent& e) {
+    if (dragPointId_ != INVALID_CURVE_POINT_ID) {
+        auto [newX, newY] = dragPosition(e);
+        previewPointDrag(dragPointId_, newX, newY);
+        return;
+    }
+
     if (!isDrawing_)
         return;
 
@@ -285,6 +523,16 @@ void CurveEditorBase::mouseDrag(const juce::MouseEvent& e) {
 }
 
 void CurveEditorBase::mouseUp(const juce::MouseEvent& e) {
+    if (dragPointId_ != INVALID_CURVE_POINT_ID) {
+        const auto pointId = dragPointId_;
+        dragPointId_ = INVALID_CURVE_POINT_ID;
+        if (e.mouseWasDraggedSinceMouseDown()) {
+            auto [newX, newY] = dragPosition(e);
+            commitPointDrag(pointId, newX, newY);
+        }
+        return;
+    }
+
     if (isDrawing_) {
         isDrawing_ = false;
 
@@ -319,6 +567,13 @@ void CurveEditorBase::mouseUp(const juce::MouseEvent& e) {
 }
 
 void CurveEditorBase::mouseDoubleClick(const juce::MouseEvent& e) {
+    // Double-click a point to delete it
+    const auto pointId = findPointAt(e.getPosition());
+    if (pointId != INVALID_CURVE_POINT_ID) {
+        onPointDeleted(pointId);
+        return;
+    }
+
     // Double-click to add a point
     double x = pixelToX(e.x);
     double y = pixelToY(e.y);
@@ -334,6 +589,38 @@ void CurveEditorBase::mouseDoubleClick(const juce::MouseEvent& e) {
     onPointAdded(x, y, curveType);
 }
 
+void CurveEditorBase::mouseMove(const juce::MouseEvent& e) {
+    const auto pointId = findPointAt(e.getPosition());
+    if (pointId != hoveredPointId_) {
+        repaintPoint(hoveredPointId_);
+        hoveredPointId_ = pointId;
+        repaintPoint(hoveredPointId_);
+    }
+}
+
+void CurveEditorBase::mouseExit(const juce::MouseEvent& e) {
+    juce::ignoreUnused(e);
+    repaintPoint(hoveredPointId_);
+    hoveredPointId_ = INVALID_CURVE_POINT_ID;
+}
+
+std::pair<double, double> CurveEditorBase::dragPosition(const juce::MouseEvent& e) const {
+    const auto delta = e.getPosition() - dragStartPos_;
+    double newX = dragStartX_ + delta.x / getPixelsPerX();
+    double newY = dragStartY_ - delta.y / getPixelsPerY();  // Y is inverted
+    return {juce::jmax(0.0, newX), juce::jlimit(0.0, 1.0, newY)};
+}
+
+void CurveEditorBase::repaintPoint(uint32_t pointId) {
+    const int index = indexOfPoint(pointId);
+    if (index < 0) {
+        return;
+    }
+    auto [x, y] = getEffectivePosition(getPoints()[static_cast<size_t>(index)]);
+    repaint(juce::Rectangle<int>(CurvePointComponent::HIT_SIZE, CurvePointComponent::HIT_SIZE)
+                .withCentre({xToPixel(x), yToPixel(y)}));
+}
+
 bool CurveEditorBase::keyPressed(const juce::KeyPress& key) {
     if (key == juce::KeyPress::deleteKey || key == juce::KeyPress::backspaceKey) {
         // Subclass should handle deletion of selected points
@@ -361,235 +648,262 @@ std::pair<double, double> CurveEditorBase::getEffectivePosition(const CurvePoint
     return {p.x, p.y};
 }
 
-void CurveEditorBase::rebuildPointComponents() {
-    // Clear preview state when structure changes
-    previewPointId_ = INVALID_CURVE_POINT_ID;
-    tensionPreviewPointId_ = INVALID_CURVE_POINT_ID;
-
-    pointComponents_.clear();
-    handleComponents_.clear();
-    tensionHandles_.clear();
+int CurveEditorBase::indexOfPoint(uint32_t pointId) const {
+    if (pointId == INVALID_CURVE_POINT_ID) {
+        return -1;
+    }
 
     const auto& points = getPoints();
-    for (const auto& point : points) {
-        auto pc = std::make_unique<CurvePointComponent>(point.id, this);
-        pc->updateFromPoint(point);
+    auto it = pointIndex_.find(pointId);
+    if (it != pointIndex_.end() && it->second < points.size() &&
+        points[it->second].id == pointId) {
+        return static_cast<int>(it->second);
+    }
 
-        // Set callbacks
-        pc->onPointSelected = [this](uint32_t pointId) { onPointSelected(pointId); };
-
-        pc->onPointMoved = [this](uint32_t pointId, double newX, double newY) {
-            // Clear preview state - drag is complete
-            previewPointId_ = INVALID_CURVE_POINT_ID;
-
-            // Allow subclass to constrain position (e.g., pin edge points)
-            constrainPointPosition(pointId, newX, newY);
-            onPointMoved(pointId, newX, newY);
-        };
-
-        pc->onPointDragPreview = [this](uint32_t pointId, double newX, double newY) {
-            // Allow subclass to constrain position (e.g., pin edge points)
-            constrainPointPosition(pointId, newX, newY);
-
-            // Update preview state directly
-            previewPointId_ = pointId;
-            previewX_ = newX;
-            previewY_ = newY;
-
-            // Update the point component position
-            for (auto& ptComp : pointComponents_) {
-                if (ptComp->getPointId() == pointId) {
-                    int px = xToPixel(newX);
-                    int py = yToPixel(newY);
-                    ptComp->setCentrePosition(px, py);
-                    break;
-                }
-            }
+    // Points changed without a rebuild (an in-place sync): fall back to a scan
+    for (size_t i = 0; i < points.size(); ++i) {
+        if (points[i].id == pointId) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
 
-            // Update tension handle positions that depend on this point
-            updateTensionHandlePositions();
+// =============================================================================
+// Point drags
+// =============================================================================
 
-            // Notify subclass for fluid preview updates
-            onPointDragPreview(pointId, newX, newY);
+void CurveEditorBase::previewPointDrag(uint32_t pointId, double newX, double newY) {
+    // Allow subclass to constrain position (e.g., pin edge points)
+    constrainPointPosition(pointId, newX, newY);
 
-            repaint();
-        };
+    // Update preview state directly
+    repaintPoint(pointId);
+    previewPointId_ = pointId;
+    previewX_ = newX;
+    previewY_ = newY;
 
-        pc->onPointDeleted = [this](uint32_t pointId) { onPointDeleted(pointId); };
+    // Update the point component position, if the point has one
+    for (auto& ptComp : pointComponents_) {
+        if (ptComp->getPointId() == pointId) {
+            ptComp->setCentrePosition(xToPixel(newX), yToPixel(newY));
+            break;
+        }
+    }
 
-        pc->onHandlesChanged = [this](uint32_t pointId, const CurveHandleData& inHandle,
-                                      const CurveHandleData& outHandle) {
-            onHandlesChanged(pointId, inHandle, outHandle);
-        };
+    // Update tension handle positions that depend on this point
+    updateTensionHandlePositions();
 
-        addAndMakeVisible(pc.get());
-        pointComponents_.push_back(std::move(pc));
-    }
+    // Notify subclass for fluid preview updates
+    onPointDragPreview(pointId, newX, newY);
 
-    // Create tension handles for each curve segment (between consecutive points)
-    // Only for Linear curve type - Bezier uses handles, Step has no curve
-    for (size_t i = 0; i < points.size(); ++i) {
-        const auto& point = points[i];
+    repaint();
+}
 
-        // Only create tension handle if this isn't the last point
-        // and the curve type is Linear
-        if (i < points.size() - 1 && point.curveType == CurveType::Linear) {
-            auto th = std::make_unique<CurveTensionHandle>(point.id);
-            th->setTension(point.tension);
-
-            // Set slope direction so drag feels intuitive
-            const auto& nextPoint = points[i + 1];
-            th->setSlopeGoesDown(nextPoint.y < point.y);
-
-            th->onTensionChanged = [this](uint32_t pointId, double tension) {
-                // Clear preview state
-                tensionPreviewPointId_ = INVALID_CURVE_POINT_ID;
-                onTensionChanged(pointId, tension);
-            };
-
-            th->onTensionDragPreview = [this](uint32_t pointId, double tension) {
-                // Store preview state
-                tensionPreviewPointId_ = pointId;
-                tensionPreviewValue_ = tension;
-
-                // Update the tension handle position to follow the curve
-                const auto& pts = getPoints();
-                for (size_t j = 0; j < pts.size() - 1; ++j) {
-                    if (pts[j].id == pointId) {
-                        const auto& pt1 = pts[j];
-                        const auto& pt2 = pts[j + 1];
-
-                        double midX = (pt1.x + pt2.x) / 2.0;
-                        double midY = (pt1.y + pt2.y) / 2.0;
-
-                        // Apply tension to get actual curve position at midpoint
-                        if (std::abs(tension) > 0.001) {
-                            double t = 0.5;
-                            double curvedT;
-                            if (tension > 0) {
-                                curvedT = std::pow(t, 1.0 + tension * 2.0);
-                            } else {
-                                curvedT = 1.0 - std::pow(1.0 - t, 1.0 - tension * 2.0);
-                            }
-                            midY = pt1.y + curvedT * (pt2.y - pt1.y);
-                        }
-
-                        // Update handle position
-                        for (auto& handle : tensionHandles_) {
-                            if (handle->getPointId() == pointId) {
-                                int px = xToPixel(midX);
-                                int py = yToPixel(midY);
-                                handle->setCentrePosition(px, py);
-                                break;
-                            }
-                        }
-                        break;
-                    }
-                }
+void CurveEditorBase::commitPointDrag(uint32_t pointId, double newX, double newY) {
+    // Clear preview state - drag is complete
+    previewPointId_ = INVALID_CURVE_POINT_ID;
 
-                // Notify subclass for fluid preview updates
-                onTensionDragPreview(pointId, tension);
+    // Allow subclass to constrain position (e.g., pin edge points)
+    constrainPointPosition(pointId, newX, newY);
+    onPointMoved(pointId, newX, newY);
+}
 
-                repaint();
-            };
+// =============================================================================
+// Selected point handles
+// =============================================================================
 
-            addAndMakeVisible(th.get());
-            tensionHandles_.push_back(std::move(th));
-        }
+void CurveEditorBase::setSelectedPoints(const std::vector<uint32_t>& pointIds) {
+    std::unordered_set<uint32_t> selected(pointIds.begin(), pointIds.end());
+    if (selected == selectedPointIds_) {
+        return;
     }
 
+    selectedPointIds_ = std::move(selected);
+    rebuildHandleComponents();
     updatePointPositions();
-    syncSelectionState();
+    repaint();
 }
 
-void CurveEditorBase::updatePointPositions() {
-    const auto& points = getPoints();
+void CurveEditorBase::rebuildPointComponents() {
+    // Clear preview state when structure changes
+    previewPointId_ = INVALID_CURVE_POINT_ID;
+    tensionPreviewPointId_ = INVALID_CURVE_POINT_ID;
 
-    for (size_t i = 0; i < pointComponents_.size() && i < points.size(); ++i) {
-        const auto& point = points[i];
-        int px = xToPixel(point.x);
-        int py = yToPixel(point.y);
+    const auto& points = getPoints();
+    pointIndex_.clear();
+    pointIndex_.reserve(points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+        pointIndex_[points[i].id] = i;
+    }
+    ++pointsVersion_;
 
-        pointComponents_[i]->setCentrePosition(px, py);
-        pointComponents_[i]->updateFromPoint(point);
+    // Samples of segments whose start point is gone
+    for (auto it = segmentSamples_.begin(); it != segmentSamples_.end();) {
+        it = pointIndex_.count(it->first) != 0 ? std::next(it) : segmentSamples_.erase(it);
     }
 
-    // Position tension handles at the midpoint of each curve segment
-    size_t tensionIdx = 0;
-    for (size_t i = 0; i < points.size() - 1 && tensionIdx < tensionHandles_.size(); ++i) {
-        const auto& p1 = points[i];
-        const auto& p2 = points[i + 1];
-
-        // Only position for Linear curves
-        if (p1.curveType == CurveType::Linear) {
-            double midX = (p1.x + p2.x) / 2.0;
-            double midY = (p1.y + p2.y) / 2.0;
-
-            // Apply tension to get the actual curve position at midpoint
-            if (std::abs(p1.tension) > 0.001) {
-                double t = 0.5;
-                double curvedT;
-                if (p1.tension > 0) {
-                    curvedT = std::pow(t, 1.0 + p1.tension * 2.0);
-                } else {
-                    curvedT = 1.0 - std::pow(1.0 - t, 1.0 - p1.tension * 2.0);
-                }
-                midY = p1.y + curvedT * (p2.y - p1.y);
-            }
+    syncSelectionState();
+    rebuildHandleComponents();
+    updatePointPositions();
+    repaint();
+}
 
-            int px = xToPixel(midX);
-            int py = yToPixel(midY);
+void CurveEditorBase::rebuildHandleComponents() {
+    tensionHandles_.clear();
 
-            tensionHandles_[tensionIdx]->setCentrePosition(px, py);
-            tensionHandles_[tensionIdx]->setTension(p1.tension);
-            ++tensionIdx;
+    const auto& points = getPoints();
+    const bool handlesForSelection = selectedPointIds_.size() <= kMaxHandlePoints;
+
+    // Keep the components of points still selected. One under the mouse is kept (hidden)
+    // even when its point isn't, as it may be calling back into us from its mouseDown
+    std::unordered_set<uint32_t> hasComponent;
+    pointComponents_.erase(
+        std::remove_if(pointComponents_.begin(), pointComponents_.end(),
+                       [&](const auto& pc) {
+                           const auto id = pc->getPointId();
+                           if (handlesForSelection && isPointSelected(id) &&
+                               indexOfPoint(id) >= 0 && hasComponent.insert(id).second) {
+                               return false;
+                           }
+                           if (pc->isMouseButtonDown()) {
+                               pc->setVisible(false);
+                               return false;
+                           }
+                           return true;
+                       }),
+        pointComponents_.end());
+
+    if (handlesForSelection) {
+        for (const auto& point : points) {
+            if (isPointSelected(point.id) && hasComponent.count(point.id) == 0) {
+                addPointComponent(point);
+            }
+        }
+    }
+
+    // Tension handles for each Linear segment (Bezier uses handles, Step has no curve): on a
+    // short curve all of them, otherwise those touching a selected point
+    const bool allSegments = points.size() <= kAllTensionHandlesMaxPoints;
+    if (!allSegments && (!handlesForSelection || selectedPointIds_.empty())) {
+        return;
+    }
+    for (size_t i = 0; i + 1 < points.size(); ++i) {
+        const auto& point = points[i];
+        if (point.curveType == CurveType::Linear &&
+            (allSegments || isPointSelected(point.id) || isPointSelected(points[i + 1].id))) {
+            addTensionHandle(point, points[i + 1]);
         }
     }
 }
 
-void CurveEditorBase::updateTensionHandlePositions() {
+void CurveEditorBase::addPointComponent(const CurvePoint& point) {
+    auto pc = std::make_unique<CurvePointComponent>(point.id, this);
+    pc->updateFromPoint(point);
+
+    // Set callbacks
+    pc->onPointSelected = [this](uint32_t pointId) { onPointSelected(pointId); };
+
+    pc->onPointMoved = [this](uint32_t pointId, double newX, double newY) {
+        commitPointDrag(pointId, newX, newY);
+    };
+
+    pc->onPointDragPreview = [this](uint32_t pointId, double newX, double newY) {
+        previewPointDrag(pointId, newX, newY);
+    };
+
+    pc->onPointDeleted = [this](uint32_t pointId) { onPointDeleted(pointId); };
+
+    pc->onHandlesChanged = [this](uint32_t pointId, const CurveHandleData& inHandle,
+                                  const CurveHandleData& outHandle) {
+        onHandlesChanged(pointId, inHandle, outHandle);
+    };
+
+    addAndMakeVisible(pc.get());
+    pc->setSelected(true);
+    pointComponents_.push_back(std::move(pc));
+}
+
+void CurveEditorBase::addTensionHandle(const CurvePoint& point, const CurvePoint& next) {
+    auto th = std::make_unique<CurveTensionHandle>(point.id);
+    th->setTension(point.tension);
+
+    // Set slope direction so drag feels intuitive
+    th->setSlopeGoesDown(next.y < point.y);
+
+    th->onTensionChanged = [this](uint32_t pointId, double tension) {
+        // Clear preview state
+        tensionPreviewPointId_ = INVALID_CURVE_POINT_ID;
+        onTensionChanged(pointId, tension);
+    };
+
+    auto* handle = th.get();
+    th->onTensionDragPreview = [this, handle](uint32_t pointId, double tension) {
+        // Store preview state
+        tensionPreviewPointId_ = pointId;
+        tensionPreviewValue_ = tension;
+
+        // Update the tension handle position to follow the curve
+        positionTensionHandle(*handle, true);
+
+        // Notify subclass for fluid preview updates
+        onTensionDragPreview(pointId, tension);
+
+        repaint();
+    };
+
+    addAndMakeVisible(th.get());
+    tensionHandles_.push_back(std::move(th));
+}
+
+void CurveEditorBase::positionTensionHandle(CurveTensionHandle& handle, bool usePreview) {
     const auto& points = getPoints();
-    if (points.size() < 2)
+    const int index = indexOfPoint(handle.getPointId());
+    if (index < 0 || static_cast<size_t>(index) + 1 >= points.size()) {
         return;
+    }
 
-    size_t tensionIdx = 0;
-    for (size_t i = 0; i < points.size() - 1 && tensionIdx < tensionHandles_.size(); ++i) {
-        const auto& p1 = points[i];
-        const auto& p2 = points[i + 1];
+    const auto& p1 = points[static_cast<size_t>(index)];
+    const auto& p2 = points[static_cast<size_t>(index) + 1];
+    auto [x1, y1] = usePreview ? getEffectivePosition(p1) : std::make_pair(p1.x, p1.y);
+    auto [x2, y2] = usePreview ? getEffectivePosition(p2) : std::make_pair(p2.x, p2.y);
+    const double tension = usePreview ? getEffectiveTension(p1) : p1.tension;
 
-        if (p1.curveType == CurveType::Linear) {
-            auto [x1, y1] = getEffectivePosition(p1);
-            auto [x2, y2] = getEffectivePosition(p2);
+    // Apply tension to get actual curve position at midpoint
+    const double midX = (x1 + x2) / 2.0;
+    const double midY = y1 + applyTension(0.5, tension) * (y2 - y1);
+    handle.setCentrePosition(xToPixel(midX), yToPixel(midY));
 
-            double midX = (x1 + x2) / 2.0;
-            double midY = (y1 + y2) / 2.0;
+    if (usePreview) {
+        // Update slope direction in case points were moved
+        handle.setSlopeGoesDown(y2 < y1);
+    } else {
+        handle.setTension(p1.tension);
+    }
+}
 
-            // Apply tension to get actual curve position at midpoint
-            double tension = p1.tension;
-            if (tensionPreviewPointId_ != INVALID_CURVE_POINT_ID &&
-                p1.id == tensionPreviewPointId_) {
-                tension = tensionPreviewValue_;
-            }
+void CurveEditorBase::updatePointPositions() {
+    const auto& points = getPoints();
 
-            if (std::abs(tension) > 0.001) {
-                double t = 0.5;
-                double curvedT;
-                if (tension > 0) {
-                    curvedT = std::pow(t, 1.0 + tension * 2.0);
-                } else {
-                    curvedT = 1.0 - std::pow(1.0 - t, 1.0 - tension * 2.0);
-                }
-                midY = y1 + curvedT * (y2 - y1);
-            }
+    for (auto& pc : pointComponents_) {
+        const int index = indexOfPoint(pc->getPointId());
+        if (index < 0) {
+            continue;
+        }
+        const auto& point = points[static_cast<size_t>(index)];
+        pc->setCentrePosition(xToPixel(point.x), yToPixel(point.y));
+        pc->updateFromPoint(point);
+    }
 
-            int px = xToPixel(midX);
-            int py = yToPixel(midY);
+    // Position tension handles at the midpoint of each curve segment
+    for (auto& handle : tensionHandles_) {
+        positionTensionHandle(*handle, false);
+    }
+}
 
-            tensionHandles_[tensionIdx]->setCentrePosition(px, py);
-            // Update slope direction in case points were moved
-            tensionHandles_[tensionIdx]->setSlopeGoesDown(y2 < y1);
-            ++tensionIdx;
-        }
+void CurveEditorBase::updateTensionHandlePositions() {
+    for (auto& handle : tensionHandles_) {
+        positionTensionHandle(*handle, true);
     }
 }
 
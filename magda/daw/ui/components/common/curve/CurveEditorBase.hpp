@@ -3,8 +3,11 @@
 #include <juce_gui_basics/juce_gui_basics.h>
 
 #include <cmath>
+#include <cstdint>
 #include <functional>
 #include <memory>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "CurveBezierHandle.hpp"
@@ -20,10 +23,22 @@ namespace magda {
  * Provides common functionality for rendering and editing curves with:
  * - Linear, bezier, and step interpolation
  * - Tension-based curve shaping
- * - Point and handle component management
+ * - Points drawn and hit-tested straight from the data
  * - Drawing tools (select, pencil, line, curve)
  * - Preview state during drag operations
  *
+ * A recorded controller pass can leave thousands of points in a lane, so points aren't
+ * components: they are painted from getPoints() and found under the mouse by binary search
+ * on x (points are sorted by x). Only selected points get a CurvePointComponent, for their
+ * bezier handles, and tension handles exist only next to selected points (or on every
+ * segment of a short curve). Where points are packed closer than a couple of pixels, the
+ * curve is drawn through a Douglas-Peucker simplification made for the current zoom.
+ *
+ * Otherwise the path is built per visible segment. A tensioned segment's samples are kept
+ * in model units, keyed by the segment's start point and checked against its end values,
+ * so a drag or a tension preview re-samples only the segments either side of the edited
+ * point and every other segment is just mapped to pixels.
+ *
  * Subclasses implement:
  * - Data source access (getPoints, mutation callbacks)
  * - Coordinate conversion (x/y to pixel and back)
@@ -43,6 +58,8 @@ class CurveEditorBase : public juce::Component {
     void mouseDrag(const juce::MouseEvent& e) override;
     void mouseUp(const juce::MouseEvent& e) override;
     void mouseDoubleClick(const juce::MouseEvent& e) override;
+    void mouseMove(const juce::MouseEvent& e) override;
+    void mouseExit(const juce::MouseEvent& e) override;
     bool keyPressed(const juce::KeyPress& key) override;
 
     // Configuration
@@ -53,7 +70,7 @@ class CurveEditorBase : public juce::Component {
         return drawMode_;
     }
 
-    void setCurveColour(juce::Colour colour) {
+    virtual void setCurveColour(juce::Colour colour) {
         curveColour_ = colour;
     }
     juce::Colour getCurveColour() const {
@@ -96,14 +113,27 @@ class CurveEditorBase : public juce::Component {
     // Snapping
     std::function<double(double)> snapXToGrid;
 
+    /**
+     * @brief The point drawn under a pixel position, INVALID_CURVE_POINT_ID if none
+     */
+    uint32_t findPointAt(juce::Point<int> position) const;
+
+    // Selected points beyond this many are drawn highlighted but get no handle components
+    static constexpr size_t kMaxHandlePoints = 64;
+    // Curves this short keep a tension handle on every segment, selected or not
+    static constexpr size_t kAllTensionHandlesMaxPoints = 32;
+    // Denser than this, the curve is drawn simplified and unselected dots are left out
+    static constexpr double kSimplifyMinPixelsPerPoint = 2.0;
+    static constexpr double kMinDotSpacingPixels = 4.0;
+    static constexpr float kSimplifyTolerancePixels = 0.5f;
+
   protected:
     CurveDrawMode drawMode_ = CurveDrawMode::Select;
     juce::Colour curveColour_{0xFF6688CC};  // Default curve color
     int padding_ = 5;                       // Content area padding (>= half of point size)
 
-    // Components
+    // Components, for selected points only (see class docs)
     std::vector<std::unique_ptr<CurvePointComponent>> pointComponents_;
-    std::vector<std::unique_ptr<CurveBezierHandle>> handleComponents_;
     std::vector<std::unique_ptr<CurveTensionHandle>> tensionHandles_;
 
     // Drawing state
@@ -120,11 +150,22 @@ class CurveEditorBase : public juce::Component {
     uint32_t tensionPreviewPointId_ = INVALID_CURVE_POINT_ID;
     double tensionPreviewValue_ = 0.0;
 
-    // Rebuild components from data
+    // Call after the points change: rebuilds the lookups and the selected points' handles
     virtual void rebuildPointComponents();
     virtual void updatePointPositions();
     void updateTensionHandlePositions();
 
+    // Selection, as far as drawing and handles go (the subclass owns the real selection)
+    void setSelectedPoints(const std::vector<uint32_t>& pointIds);
+    bool isPointSelected(uint32_t pointId) const {
+        return selectedPointIds_.count(pointId) != 0;
+    }
+
+    /**
+     * @brief Index of a point in getPoints(), -1 if it's gone
+     */
+    int indexOfPoint(uint32_t pointId) const;
+
     // Drawing
     virtual void paintCurve(juce::Graphics& g);
     virtual void paintGrid(juce::Graphics& g);
@@ -162,9 +203,62 @@ class CurveEditorBase : public juce::Component {
     virtual void syncSelectionState() {}
 
   private:
-    // Curve rendering helper
+    std::unordered_set<uint32_t> selectedPointIds_;
+    uint32_t hoveredPointId_ = INVALID_CURVE_POINT_ID;
+
+    // Point drag started on a point without a component
+    uint32_t dragPointId_ = INVALID_CURVE_POINT_ID;
+    juce::Point<int> dragStartPos_;
+    double dragStartX_ = 0.0;
+    double dragStartY_ = 0.0;
+
+    // Point id -> index, rebuilt with the components
+    std::unordered_map<uint32_t, size_t> pointIndex_;
+
+    // Whole-curve simplification for the zoom it was made at (model units)
+    std::vector<juce::Point<double>> simplifiedCurve_;
+    uint64_t pointsVersion_ = 0;
+    uint64_t simplifiedVersion_ = UINT64_MAX;
+    double simplifiedPixelsPerX_ = 0.0;
+    double simplifiedPixelsPerY_ = 0.0;
+
+    // A tensioned segment's samples, for the ends and tension they were taken with
+    struct SegmentSamples {
+        double x1 = 0.0, y1 = 0.0, x2 = 0.0, y2 = 0.0, tension = 0.0;
+        std::vector<juce::Point<double>> vertices;  // After the start, up to the end
+    };
+    // Start point id -> samples; pruned to the current points when they're rebuilt
+    std::unordered_map<uint32_t, SegmentSamples> segmentSamples_;
+
+    void rebuildHandleComponents();
+    void addPointComponent(const CurvePoint& point);
+    void addTensionHandle(const CurvePoint& point, const CurvePoint& next);
+    void positionTensionHandle(CurveTensionHandle& handle, bool usePreview);
+
+    void previewPointDrag(uint32_t pointId, double newX, double newY);
+    void commitPointDrag(uint32_t pointId, double newX, double newY);
+    std::pair<double, double> dragPosition(const juce::MouseEvent& e) const;
+    void repaintPoint(uint32_t pointId);
+
+    // Curve rendering helpers
+    std::pair<size_t, size_t> getVisibleRange(const std::vector<CurvePoint>& points,
+                                              juce::Rectangle<int> clip) const;
+    bool shouldSimplify(const std::vector<CurvePoint>& points) const;
+    void buildCurvePath(juce::Path& path, const std::vector<CurvePoint>& points, size_t begin,
+                        size_t end);
+    void buildSimplifiedPath(juce::Path& path, const std::vector<CurvePoint>& points,
+                             size_t begin, size_t end, juce::Rectangle<int> clip);
+    std::vector<juce::Point<double>> buildPolyline(const std::vector<CurvePoint>& points,
+                                                   size_t begin, size_t end) const;
+    std::vector<juce::Point<double>> simplify(std::vector<juce::Point<double>> vertices) const;
+    void paintPoints(juce::Graphics& g, const std::vector<CurvePoint>& points, size_t begin,
+                     size_t end);
+    double getEffectiveTension(const CurvePoint& p) const;
     void renderCurveSegment(juce::Path& path, const CurvePoint& p1, const CurvePoint& p2,
                             double effectiveTension);
+    const std::vector<juce::Point<double>>& getSegmentSamples(uint32_t startId, double x1,
+                                                              double y1, double x2, double y2,
+                                                              double tension);
 };
 
 }  // namespace magda
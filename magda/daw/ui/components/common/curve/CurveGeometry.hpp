@@ -0,0 +1,107 @@
+#pragma once
+
+#include <juce_graphics/juce_graphics.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "CurveTypes.hpp"
+
+namespace magda {
+
+/**
+ * @brief Lookups and simplification over a curve's points, which are sorted by x
+ *
+ * Kept free of components so curve editors can draw and hit-test thousands of points from
+ * the data alone.
+ */
+namespace CurveGeometry {
+
+/**
+ * @brief Indices [begin, end) of the points with x in [minX, maxX]
+ */
+inline std::pair<size_t, size_t> findRange(const std::vector<CurvePoint>& points, double minX,
+                                           double maxX) {
+    auto begin = std::lower_bound(points.begin(), points.end(), minX,
+                                  [](const CurvePoint& p, double x) { return p.x < x; });
+    auto end = std::upper_bound(begin, points.end(), maxX,
+                                [](double x, const CurvePoint& p) { return x < p.x; });
+    return {static_cast<size_t>(begin - points.begin()), static_cast<size_t>(end - points.begin())};
+}
+
+/**
+ * @brief Douglas–Peucker: the vertices to keep so no dropped one strays more than tolerance
+ *        from the line drawn instead
+ *
+ * Iterative, so a recorded pass of 100k points can't overflow the stack. The first and last
+ * vertices are always kept.
+ *
+ * @return Indices into vertices, ascending
+ */
+inline std::vector<size_t> simplifyPolyline(const std::vector<juce::Point<float>>& vertices,
+                                            float tolerance) {
+    const auto count = vertices.size();
+    if (count <= 2) {
+        std::vector<size_t> all(count);
+        for (size_t i = 0; i < count; ++i) {
+            all[i] = i;
+        }
+        return all;
+    }
+
+    std::vector<bool> keep(count, false);
+    keep.front() = true;
+    keep.back() = true;
+
+    const float toleranceSquared = tolerance * tolerance;
+    std::vector<std::pair<size_t, size_t>> spans{{0, count - 1}};
+    while (!spans.empty()) {
+        const auto [first, last] = spans.back();
+        spans.pop_back();
+
+        const auto a = vertices[first];
+        const auto ab = vertices[last] - a;
+        const float lengthSquared = ab.x * ab.x + ab.y * ab.y;
+
+        float worst = toleranceSquared;
+        size_t worstIndex = 0;
+        for (size_t i = first + 1; i < last; ++i) {
+            const auto ap = vertices[i] - a;
+            float distanceSquared;
+            if (lengthSquared <= 0.0f) {
+                distanceSquared = ap.x * ap.x + ap.y * ap.y;
+            } else {
+                const float cross = ab.x * ap.y - ab.y * ap.x;
+                distanceSquared = cross * cross / lengthSquared;
+            }
+            if (distanceSquared > worst) {
+                worst = distanceSquared;
+                worstIndex = i;
+            }
+        }
+
+        if (worstIndex != 0) {
+            keep[worstIndex] = true;
+            if (worstIndex - first > 1) {
+                spans.push_back({first, worstIndex});
+            }
+            if (last - worstIndex > 1) {
+                spans.push_back({worstIndex, last});
+            }
+        }
+    }
+
+    std::vector<size_t> kept;
+    for (size_t i = 0; i < count; ++i) {
+        if (keep[i]) {
+            kept.push_back(i);
+        }
+    }
+    return kept;
+}
+
+}  // namespace CurveGeometry
+
+}  // namespace magda
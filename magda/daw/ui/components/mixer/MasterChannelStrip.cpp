@@ -6,6 +6,8 @@
 #include "../../themes/FontManager.hpp"
 #include "../../themes/MixerMetrics.hpp"
 #include "BinaryData.h"
+#include "audio/AudioBridge.hpp"
+#include "engine/AudioEngine.hpp"
 
 namespace magda {
 
@@ -51,8 +53,56 @@ float meterPosToDb(float pos) {
     float normalized = std::pow(pos, 1.0f / METER_CURVE_EXPONENT);
     return MIN_DB + normalized * (MAX_DB - MIN_DB);
 }
+
+// Analysis section layout
+constexpr int ANALYSIS_BUTTON_HEIGHT = 18;
+constexpr int SPECTRUM_HEIGHT = 64;
+constexpr int LOUDNESS_LABEL_HEIGHT = 48;
+constexpr float SPECTRUM_FLOOR_DB = -84.0f;
+
+juce::String formatLufs(float lufs) {
+    return lufs <= LoudnessAnalyser::kSilenceLufs ? juce::String("-inf") : juce::String(lufs, 1);
+}
 }  // namespace
 
+// Spectrum of the master tap; paint() only draws the bands the analyser has computed
+class MasterChannelStrip::SpectrumDisplay : public juce::Component {
+  public:
+    void setBands(std::vector<float> bands) {
+        bands_ = std::move(bands);
+        repaint();
+    }
+
+    void paint(juce::Graphics& g) override {
+        auto bounds = getLocalBounds().toFloat();
+        g.setColour(DarkTheme::getColour(DarkTheme::SURFACE));
+        g.fillRoundedRectangle(bounds, 2.0f);
+        if (bands_.empty())
+            return;
+
+        const float bandWidth = bounds.getWidth() / static_cast<float>(bands_.size());
+        juce::Path path;
+        path.startNewSubPath(bounds.getX(), bounds.getBottom());
+        for (size_t i = 0; i < bands_.size(); ++i) {
+            const float level =
+                juce::jlimit(0.0f, 1.0f, (bands_[i] - SPECTRUM_FLOOR_DB) / -SPECTRUM_FLOOR_DB);
+            const float x = bounds.getX() + (static_cast<float>(i) + 0.5f) * bandWidth;
+            path.lineTo(x, bounds.getBottom() - level * bounds.getHeight());
+        }
+        path.lineTo(bounds.getRight(), bounds.getBottom());
+        path.closeSubPath();
+
+        const auto colour = DarkTheme::getColour(DarkTheme::ACCENT_BLUE);
+        g.setColour(colour.withAlpha(0.35f));
+        g.fillPath(path);
+        g.setColour(colour);
+        g.strokePath(path, juce::PathStrokeType(1.0f));
+    }
+
+  private:
+    std::vector<float> bands_;
+};
+
 // Stereo level meter component (L/R bars)
 class MasterChannelStrip::LevelMeter : public juce::Component {
   public:
@@ -146,6 +196,7 @@ MasterChannelStrip::MasterChannelStrip(Orientation orientation) : orientation_(o
 }
 
 MasterChannelStrip::~MasterChannelStrip() {
+    setAnalysisVisible(false);
     TrackManager::getInstance().removeListener(this);
     // Clear look and feel before destruction
     if (volumeSlider) {
@@ -245,6 +296,28 @@ void MasterChannelStrip::setupControls() {
         TrackManager::getInstance().setMasterMuted(speakerButton->getToggleState());
     };
     addAndMakeVisible(*speakerButton);
+
+    // Analysis section toggle, and what it shows while open
+    analysisButton_ = std::make_unique<juce::TextButton>("Analysis");
+    analysisButton_->setClickingTogglesState(true);
+    analysisButton_->setColour(juce::TextButton::buttonColourId,
+                               DarkTheme::getColour(DarkTheme::SURFACE));
+    analysisButton_->setColour(juce::TextButton::buttonOnColourId,
+                               DarkTheme::getColour(DarkTheme::ACCENT_BLUE));
+    analysisButton_->onClick = [this]() {
+        setAnalysisVisible(analysisButton_->getToggleState());
+    };
+    addAndMakeVisible(*analysisButton_);
+
+    spectrumDisplay_ = std::make_unique<SpectrumDisplay>();
+    addChildComponent(*spectrumDisplay_);
+
+    loudnessLabel_ = std::make_unique<juce::Label>();
+    loudnessLabel_->setJustificationType(juce::Justification::centredLeft);
+    loudnessLabel_->setColour(juce::Label::textColourId,
+                              DarkTheme::getColour(DarkTheme::TEXT_SECONDARY));
+    loudnessLabel_->setFont(FontManager::getInstance().getUIFont(9.0f));
+    addChildComponent(*loudnessLabel_);
 }
 
 void MasterChannelStrip::paint(juce::Graphics& g) {
@@ -276,6 +349,15 @@ void MasterChannelStrip::resized() {
         titleLabel->setBounds(bounds.removeFromTop(24));
         bounds.removeFromTop(4);
 
+        // Analysis toggle at the bottom, with the section above it while open
+        analysisButton_->setBounds(bounds.removeFromBottom(ANALYSIS_BUTTON_HEIGHT));
+        if (analysisVisible_) {
+            bounds.removeFromBottom(2);
+            loudnessLabel_->setBounds(bounds.removeFromBottom(LOUDNESS_LABEL_HEIGHT));
+            spectrumDisplay_->setBounds(bounds.removeFromBottom(SPECTRUM_HEIGHT));
+        }
+        bounds.removeFromBottom(4);
+
         // Mute button
         auto muteArea = bounds.removeFromTop(28);
         speakerButton->setBounds(muteArea.withSizeKeepingCentre(24, 24));
@@ -372,6 +454,7 @@ void MasterChannelStrip::resized() {
                                           layoutArea.getHeight());
     } else {
         // Horizontal layout (for Arrange view - at bottom of track content)
+        analysisButton_->setBounds(juce::Rectangle<int>());  // Vertical only
         titleLabel->setBounds(bounds.removeFromLeft(60));
         bounds.removeFromLeft(8);
 
@@ -489,6 +572,54 @@ void MasterChannelStrip::setShowVuMeter(bool show) {
     }
 }
 
+void MasterChannelStrip::setAnalysisVisible(bool visible) {
+    if (orientation_ != Orientation::Vertical)
+        visible = false;
+    if (analysisVisible_ == visible)
+        return;
+    analysisVisible_ = visible;
+
+    if (visible) {
+        // Fresh analysers, so the integrated reading starts when the section opens
+        auto* engine = TrackManager::getInstance().getAudioEngine();
+        if (auto* bridge = engine ? engine->getAudioBridge() : nullptr) {
+            spectrum_ = std::make_shared<SpectrumAnalyser>();
+            loudness_ = std::make_shared<LoudnessAnalyser>();
+            auto& taps = bridge->getAudioTaps();
+            spectrumTap_ = taps.addTap(AudioTaps::kMasterPoint, spectrum_);
+            loudnessTap_ = taps.addTap(AudioTaps::kMasterPoint, loudness_);
+        }
+        startTimerHz(30);
+    } else {
+        stopTimer();
+        spectrumTap_.reset();
+        loudnessTap_.reset();
+        spectrum_.reset();
+        loudness_.reset();
+    }
+
+    analysisButton_->setToggleState(visible, juce::dontSendNotification);
+    spectrumDisplay_->setVisible(visible);
+    loudnessLabel_->setVisible(visible);
+    resized();
+    repaint();
+}
+
+void MasterChannelStrip::timerCallback() {
+    if (spectrum_)
+        spectrumDisplay_->setBands(spectrum_->getBands());
+    if (loudness_) {
+        const float truePeak = loudness_->getTruePeakDb();
+        loudnessLabel_->setText(
+            "M " + formatLufs(loudness_->getMomentaryLufs()) + "  S " +
+                formatLufs(loudness_->getShortTermLufs()) + "\nI " +
+                formatLufs(loudness_->getIntegratedLufs()) + " LUFS\nTP " +
+                (truePeak <= MIN_DB ? juce::String("-inf") : juce::String(truePeak, 1)) +
+                " dBTP",
+            juce::dontSendNotification);
+    }
+}
+
 void MasterChannelStrip::drawDbLabels(juce::Graphics& g) {
     if (labelArea_.isEmpty() || !volumeSlider)
         return;
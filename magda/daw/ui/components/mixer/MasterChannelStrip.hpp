@@ -5,6 +5,9 @@
 #include <memory>
 
 #include "../../themes/MixerLookAndFeel.hpp"
+#include "audio/LoudnessAnalyser.hpp"
+#include "audio/SpectrumAnalyser.hpp"
+#include "core/Subscription.hpp"
 #include "core/TrackManager.hpp"
 
 namespace magda {
@@ -14,8 +17,14 @@ namespace magda {
  *
  * Can be added to any view to display and control the master channel.
  * Syncs with TrackManager's master channel state.
+ *
+ * The vertical strip can expand an analysis section: a spectrum, loudness (momentary,
+ * short-term, integrated) and true peak, measured from a tap on the master output on the
+ * audio taps' thread. The tap only exists while the section is open.
  */
-class MasterChannelStrip : public juce::Component, public TrackManagerListener {
+class MasterChannelStrip : public juce::Component,
+                           public TrackManagerListener,
+                           private juce::Timer {
   public:
     // Orientation options
     enum class Orientation { Vertical, Horizontal };
@@ -37,6 +46,12 @@ class MasterChannelStrip : public juce::Component, public TrackManagerListener {
     // Show/hide VU meter (peak meter is always visible)
     void setShowVuMeter(bool show);
 
+    // Open/close the analysis section (vertical orientation only)
+    void setAnalysisVisible(bool visible);
+    bool isAnalysisVisible() const {
+        return analysisVisible_;
+    }
+
   private:
     Orientation orientation_;
 
@@ -56,6 +71,17 @@ class MasterChannelStrip : public juce::Component, public TrackManagerListener {
     float vuPeakValue_ = 0.0f;
     bool showVuMeter_ = true;
 
+    // Analysis section, fed by master taps while open
+    class SpectrumDisplay;
+    std::unique_ptr<juce::TextButton> analysisButton_;
+    std::unique_ptr<SpectrumDisplay> spectrumDisplay_;
+    std::unique_ptr<juce::Label> loudnessLabel_;
+    std::shared_ptr<SpectrumAnalyser> spectrum_;
+    std::shared_ptr<LoudnessAnalyser> loudness_;
+    Subscription spectrumTap_;
+    Subscription loudnessTap_;
+    bool analysisVisible_ = false;
+
     // Custom look and feel for faders
     MixerLookAndFeel mixerLookAndFeel_;
 
@@ -71,6 +97,7 @@ class MasterChannelStrip : public juce::Component, public TrackManagerListener {
     void setupControls();
     void updateFromMasterState();
     void drawDbLabels(juce::Graphics& g);
+    void timerCallback() override;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MasterChannelStrip)
 };
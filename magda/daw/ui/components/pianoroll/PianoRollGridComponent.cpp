@@ -1,5 +1,7 @@
 #include "PianoRollGridComponent.hpp"
 
+#include <cmath>
+
 #include "../../state/TimelineController.hpp"
 #include "../../themes/DarkTheme.hpp"
 #include "core/ClipManager.hpp"
@@ -11,9 +13,7 @@ PianoRollGridComponent::PianoRollGridComponent() {
     setWantsKeyboardFocus(true);
 }
 
-PianoRollGridComponent::~PianoRollGridComponent() {
-    clearNoteComponents();
-}
+PianoRollGridComponent::~PianoRollGridComponent() = default;
 
 void PianoRollGridComponent::paint(juce::Graphics& g) {
     auto bounds = getLocalBounds();
@@ -43,27 +43,14 @@ void PianoRollGridComponent::paint(juce::Graphics& g) {
         }
     }
 
+    // Notes are drawn above the grid and markers, the playhead above everything
+    paintNotes(g, g.getClipBounds());
+
     // Draw playhead line if playing
-    if (playheadPosition_ >= 0.0) {
-        // Convert seconds to beats
-        // Get tempo from TimelineController
-        double tempo = 120.0;  // Default
-        if (auto* controller = TimelineController::getCurrent()) {
-            tempo = controller->getState().tempo.bpm;
-        }
-        double secondsPerBeat = 60.0 / tempo;
-        double playheadBeats = playheadPosition_ / secondsPerBeat;
-
-        // In absolute mode, playhead is at absolute position
-        // In relative mode, need to offset by clip start
-        double displayBeat = relativeMode_ ? (playheadBeats - clipStartBeats_) : playheadBeats;
-
-        int playheadX = beatToPixel(displayBeat);
-        if (playheadX >= 0 && playheadX <= bounds.getRight()) {
-            // Draw playhead line (red)
-            g.setColour(juce::Colour(0xFFFF4444));
-            g.fillRect(playheadX - 1, 0, 2, bounds.getHeight());
-        }
+    auto playheadBounds = getPlayheadBounds();
+    if (!playheadBounds.isEmpty()) {
+        g.setColour(juce::Colour(0xFFFF4444));
+        g.fillRect(playheadBounds);
     }
 }
 
@@ -116,22 +103,34 @@ void PianoRollGridComponent::paintGrid(juce::Graphics& g, juce::Rectangle<int> a
 
 void PianoRollGridComponent::paintBeatLines(juce::Graphics& g, juce::Rectangle<int> area,
                                             double lengthBeats) {
-    double gridResolution = getGridResolutionBeats();
-
-    for (double beat = 0; beat <= lengthBeats; beat += gridResolution) {
-        int x = beatToPixel(beat);
-        if (x < area.getX() || x > area.getRight()) {
-            continue;
-        }
-
-        // Determine line style based on beat position
-        bool isBar = (static_cast<int>(beat) % 4 == 0) && (beat == std::floor(beat));
-        bool isBeat = (beat == std::floor(beat));
+    // With snapping off, still draw beat lines
+    const double gridResolution =
+        gridResolution_ == GridResolution::Off ? 1.0 : getGridResolutionBeats();
+
+    // Lines cover the whole grid and only change with zoom, resolution or size; paint walks
+    // the ones inside the repainted region
+    GridLines::Key key;
+    key.axis = GridLines::Axis::Beats;
+    key.interval = gridResolution;
+    key.pixelsPerUnit = pixelsPerBeat_;
+    key.originX = leftPadding_;
+    key.left = area.getX();
+    key.right = area.getRight();
+    key.length = lengthBeats;
+    const auto& lines = beatLines_.get(key, nullptr);
+
+    auto visible = g.getClipBounds().getIntersection(area);
+    if (visible.isEmpty()) {
+        return;
+    }
+    const auto [begin, end] = beatLines_.findVisible(visible.getX(), visible.getRight());
 
-        if (isBar) {
+    for (auto i = begin; i < end; ++i) {
+        const auto& line = lines[i];
+        if (line.level == GridLines::Level::Major) {
             // Bar lines - brightest
             g.setColour(juce::Colour(0xFF707070));
-        } else if (isBeat) {
+        } else if (line.level == GridLines::Level::Beat) {
             // Beat lines - medium
             g.setColour(juce::Colour(0xFF585858));
         } else {
@@ -139,27 +138,205 @@ void PianoRollGridComponent::paintBeatLines(juce::Graphics& g, juce::Rectangle<i
             g.setColour(juce::Colour(0xFF454545));
         }
 
-        g.drawVerticalLine(x, static_cast<float>(area.getY()),
+        g.drawVerticalLine(line.x, static_cast<float>(area.getY()),
                            static_cast<float>(area.getBottom()));
     }
 }
 
 void PianoRollGridComponent::resized() {
-    updateNoteComponentBounds();
+    // Notes are laid out at paint time
 }
 
 void PianoRollGridComponent::mouseDown(const juce::MouseEvent& e) {
-    // Click on empty space - deselect all notes
-    if (!e.mods.isCommandDown() && !e.mods.isShiftDown()) {
-        for (auto& noteComp : noteComponents_) {
-            noteComp->setSelected(false);
+    drag_ = NoteDrag{};
+    const MidiNoteId noteId = getNoteAt(e.getPosition());
+
+    if (noteId == INVALID_MIDI_NOTE_ID) {
+        // Click on empty space - deselect all notes
+        if (!e.mods.isCommandDown() && !e.mods.isShiftDown()) {
+            repaintNote(selectedNoteId_);
+            selectedNoteId_ = INVALID_MIDI_NOTE_ID;
+        }
+        return;
+    }
+
+    const MidiNoteId previousSelection = selectedNoteId_;
+
+    // Cmd+click toggles the note's selection without starting a drag
+    if (e.mods.isCommandDown()) {
+        selectedNoteId_ = previousSelection == noteId ? INVALID_MIDI_NOTE_ID : noteId;
+        repaintNote(previousSelection);
+        repaintNote(noteId);
+        if (selectedNoteId_ != INVALID_MIDI_NOTE_ID && onNoteSelected) {
+            onNoteSelected(clipId_, noteId);
+        }
+        return;
+    }
+
+    // Single click - select this note
+    selectedNoteId_ = noteId;
+    repaintNote(previousSelection);
+    repaintNote(noteId);
+    if (onNoteSelected && clipId_ != INVALID_CLIP_ID) {
+        onNoteSelected(clipId_, noteId);
+    }
+
+    // Selection callbacks may have changed the clip
+    const auto* clip = ClipManager::getInstance().getClip(clipId_);
+    const auto* note = clip ? clip->midiNotes.find(noteId) : nullptr;
+    if (!note) {
+        return;
+    }
+
+    // Store drag start info
+    drag_.noteId = noteId;
+    drag_.startPos = e.getPosition();
+    drag_.startBeat = note->startBeat;
+    drag_.startLength = note->lengthBeats;
+    drag_.startNoteNumber = note->noteNumber;
+    drag_.previewStartBeat = note->startBeat;
+    drag_.previewLengthBeats = note->lengthBeats;
+    drag_.previewNoteNumber = note->noteNumber;
+
+    // Determine drag mode based on click position
+    auto bounds = getNoteBounds(*note);
+    if (e.x < bounds.getX() + RESIZE_HANDLE_WIDTH) {
+        drag_.mode = DragMode::ResizeLeft;
+    } else if (e.x > bounds.getRight() - RESIZE_HANDLE_WIDTH) {
+        drag_.mode = DragMode::ResizeRight;
+    } else {
+        drag_.mode = DragMode::Move;
+    }
+}
+
+void PianoRollGridComponent::mouseDrag(const juce::MouseEvent& e) {
+    if (drag_.mode == DragMode::None || pixelsPerBeat_ <= 0 || noteHeight_ <= 0) {
+        return;
+    }
+
+    const auto oldBounds = getDisplayedNoteBounds(drag_.noteId);
+    drag_.isDragging = true;
+
+    int deltaX = e.x - drag_.startPos.x;
+    int deltaY = e.y - drag_.startPos.y;
+
+    double deltaBeat = deltaX / pixelsPerBeat_;
+    int deltaNote = -deltaY / noteHeight_;  // Negative because Y increases downward
+    const double minLength = 1.0 / 16.0;    // 1/16th note minimum
+
+    switch (drag_.mode) {
+        case DragMode::Move: {
+            double rawStartBeat = juce::jmax(0.0, drag_.startBeat + deltaBeat);
+            drag_.previewStartBeat = snapBeatToGrid(rawStartBeat);
+            drag_.previewNoteNumber = juce::jlimit(0, 127, drag_.startNoteNumber + deltaNote);
+
+            // Notify listeners of drag preview
+            if (onNoteDragging && clipId_ != INVALID_CLIP_ID) {
+                onNoteDragging(clipId_, drag_.noteId, drag_.previewStartBeat, true);
+            }
+            break;
+        }
+
+        case DragMode::ResizeLeft: {
+            double rawStartBeat = snapBeatToGrid(juce::jmax(0.0, drag_.startBeat + deltaBeat));
+            double endBeat = drag_.startBeat + drag_.startLength;
+
+            // Ensure minimum length
+            drag_.previewStartBeat = juce::jmin(rawStartBeat, endBeat - minLength);
+            drag_.previewLengthBeats = endBeat - drag_.previewStartBeat;
+            break;
+        }
+
+        case DragMode::ResizeRight: {
+            double rawEndBeat = snapBeatToGrid(drag_.startBeat + drag_.startLength + deltaBeat);
+            drag_.previewLengthBeats = juce::jmax(minLength, rawEndBeat - drag_.startBeat);
+            break;
+        }
+
+        default:
+            break;
+    }
+
+    repaint(oldBounds.getUnion(getDisplayedNoteBounds(drag_.noteId)).expanded(2));
+}
+
+void PianoRollGridComponent::mouseUp(const juce::MouseEvent& e) {
+    if (drag_.noteId == INVALID_MIDI_NOTE_ID) {
+        return;
+    }
+
+    // Take the drag state first: the callbacks below run commands that notify listeners
+    const NoteDrag drag = drag_;
+    const auto previewBounds = getDisplayedNoteBounds(drag.noteId);
+    drag_ = NoteDrag{};
+
+    if (drag.isDragging && clipId_ != INVALID_CLIP_ID) {
+        // Commit the change via callback
+        switch (drag.mode) {
+            case DragMode::Move:
+                if (onNoteMoved) {
+                    onNoteMoved(clipId_, drag.noteId, drag.previewStartBeat,
+                                drag.previewNoteNumber);
+                }
+                break;
+
+            case DragMode::ResizeLeft:
+                // Resizing from left changes both start and length
+                if (onNoteMoved) {
+                    onNoteMoved(clipId_, drag.noteId, drag.previewStartBeat,
+                                drag.startNoteNumber);
+                }
+                if (onNoteResized) {
+                    onNoteResized(clipId_, drag.noteId, drag.previewLengthBeats);
+                }
+                break;
+
+            case DragMode::ResizeRight:
+                if (onNoteResized) {
+                    onNoteResized(clipId_, drag.noteId, drag.previewLengthBeats);
+                }
+                break;
+
+            default:
+                break;
         }
-        selectedNoteIndex_ = -1;
     }
+
+    // Notify that drag has ended
+    if (onNoteDragging && clipId_ != INVALID_CLIP_ID) {
+        onNoteDragging(clipId_, drag.noteId, drag.previewStartBeat, false);
+    }
+
+    repaint(previewBounds.expanded(2));
+    repaintNote(drag.noteId);
+    updateHover(e.getPosition());
+}
+
+void PianoRollGridComponent::mouseMove(const juce::MouseEvent& e) {
+    updateHover(e.getPosition());
+}
+
+void PianoRollGridComponent::mouseExit(const juce::MouseEvent& /*e*/) {
+    repaintNote(hoveredNoteId_);
+    hoveredNoteId_ = INVALID_MIDI_NOTE_ID;
+    hoverLeftEdge_ = false;
+    hoverRightEdge_ = false;
+    updateNoteCursor();
 }
 
 void PianoRollGridComponent::mouseDoubleClick(const juce::MouseEvent& e) {
-    // Double-click to add a new note
+    // Double-click a note to delete it
+    const MidiNoteId noteId = getNoteAt(e.getPosition());
+    if (noteId != INVALID_MIDI_NOTE_ID) {
+        drag_ = NoteDrag{};
+        if (onNoteDeleted && clipId_ != INVALID_CLIP_ID) {
+            onNoteDeleted(clipId_, noteId);
+            selectedNoteId_ = INVALID_MIDI_NOTE_ID;
+        }
+        return;
+    }
+
+    // Double-click empty space to add a new note
     double beat = pixelToBeat(e.x);
     int noteNumber = yToNoteNumber(e.y);
 
@@ -186,9 +363,10 @@ void PianoRollGridComponent::mouseDoubleClick(const juce::MouseEvent& e) {
 bool PianoRollGridComponent::keyPressed(const juce::KeyPress& key) {
     // Delete key removes selected note
     if (key == juce::KeyPress::deleteKey || key == juce::KeyPress::backspaceKey) {
-        if (selectedNoteIndex_ >= 0 && onNoteDeleted && clipId_ != INVALID_CLIP_ID) {
-            onNoteDeleted(clipId_, static_cast<size_t>(selectedNoteIndex_));
-            selectedNoteIndex_ = -1;
+        if (selectedNoteId_ != INVALID_MIDI_NOTE_ID && onNoteDeleted &&
+            clipId_ != INVALID_CLIP_ID) {
+            onNoteDeleted(clipId_, selectedNoteId_);
+            selectedNoteId_ = INVALID_MIDI_NOTE_ID;
             return true;
         }
     }
@@ -199,6 +377,11 @@ bool PianoRollGridComponent::keyPressed(const juce::KeyPress& key) {
 void PianoRollGridComponent::setClip(ClipId clipId) {
     if (clipId_ != clipId) {
         clipId_ = clipId;
+
+        // Note ids are per clip
+        selectedNoteId_ = INVALID_MIDI_NOTE_ID;
+        hoveredNoteId_ = INVALID_MIDI_NOTE_ID;
+        drag_ = NoteDrag{};
         refreshNotes();
     }
 }
@@ -206,7 +389,6 @@ void PianoRollGridComponent::setClip(ClipId clipId) {
 void PianoRollGridComponent::setPixelsPerBeat(double ppb) {
     if (pixelsPerBeat_ != ppb) {
         pixelsPerBeat_ = ppb;
-        updateNoteComponentBounds();
         repaint();
     }
 }
@@ -214,7 +396,6 @@ void PianoRollGridComponent::setPixelsPerBeat(double ppb) {
 void PianoRollGridComponent::setNoteHeight(int height) {
     if (noteHeight_ != height) {
         noteHeight_ = height;
-        updateNoteComponentBounds();
         repaint();
     }
 }
@@ -235,7 +416,6 @@ double PianoRollGridComponent::pixelToBeat(int x) const {
 void PianoRollGridComponent::setLeftPadding(int padding) {
     if (leftPadding_ != padding) {
         leftPadding_ = padding;
-        updateNoteComponentBounds();
         repaint();
     }
 }
@@ -243,7 +423,6 @@ void PianoRollGridComponent::setLeftPadding(int padding) {
 void PianoRollGridComponent::setClipStartBeats(double startBeats) {
     if (clipStartBeats_ != startBeats) {
         clipStartBeats_ = startBeats;
-        updateNoteComponentBounds();
         repaint();
     }
 }
@@ -258,7 +437,6 @@ void PianoRollGridComponent::setClipLengthBeats(double lengthBeats) {
 void PianoRollGridComponent::setRelativeMode(bool relative) {
     if (relativeMode_ != relative) {
         relativeMode_ = relative;
-        updateNoteComponentBounds();
         repaint();
     }
 }
@@ -279,32 +457,35 @@ int PianoRollGridComponent::yToNoteNumber(int y) const {
     return juce::jlimit(MIN_NOTE, MAX_NOTE, note);
 }
 
-void PianoRollGridComponent::updateNotePosition(NoteComponent* note, double beat, int noteNumber,
-                                                double length) {
-    if (!note)
-        return;
-
+juce::Rectangle<int> PianoRollGridComponent::getNoteBounds(double beat, int noteNumber,
+                                                          double length) const {
     // In ABS mode, offset by clip start position for display
     double displayBeat = relativeMode_ ? beat : (clipStartBeats_ + beat);
 
     int x = beatToPixel(displayBeat);
     int y = noteNumberToY(noteNumber);
-    int width = juce::jmax(8, static_cast<int>(length * pixelsPerBeat_));
+    int width = juce::jmax(MIN_NOTE_WIDTH, static_cast<int>(length * pixelsPerBeat_));
     int height = noteHeight_ - 2;  // Small gap between notes
 
-    note->setBounds(x, y + 1, width, height);
+    return {x, y + 1, width, height};
 }
 
 void PianoRollGridComponent::refreshNotes() {
-    clearNoteComponents();
-
-    if (clipId_ == INVALID_CLIP_ID) {
-        repaint();
-        return;
+    // Drop interaction state for notes that no longer exist
+    const auto* clip = ClipManager::getInstance().getClip(clipId_);
+    auto exists = [clip](MidiNoteId noteId) {
+        return clip && clip->type == ClipType::MIDI && clip->midiNotes.find(noteId) != nullptr;
+    };
+    if (!exists(selectedNoteId_)) {
+        selectedNoteId_ = INVALID_MIDI_NOTE_ID;
+    }
+    if (!exists(hoveredNoteId_)) {
+        hoveredNoteId_ = INVALID_MIDI_NOTE_ID;
+    }
+    if (!exists(drag_.noteId)) {
+        drag_ = NoteDrag{};
     }
 
-    createNoteComponents();
-    updateNoteComponentBounds();
     repaint();
 }
 
@@ -334,92 +515,174 @@ double PianoRollGridComponent::getGridResolutionBeats() const {
     return 0.25;  // Default to 1/16
 }
 
-void PianoRollGridComponent::createNoteComponents() {
+void PianoRollGridComponent::paintNotes(juce::Graphics& g, juce::Rectangle<int> area) {
     const auto* clip = ClipManager::getInstance().getClip(clipId_);
-    if (!clip || clip->type != ClipType::MIDI) {
+    if (!clip || clip->type != ClipType::MIDI || area.isEmpty()) {
         return;
     }
 
-    juce::Colour noteColour = clip->colour;
-
-    for (size_t i = 0; i < clip->midiNotes.size(); i++) {
-        auto noteComp = std::make_unique<NoteComponent>(i, this);
+    // The clip-relative beats and pitches covered by area (notes are at least
+    // MIN_NOTE_WIDTH wide, so look that far to the left)
+    const double offset = relativeMode_ ? 0.0 : clipStartBeats_;
+    const double startBeat = pixelToBeat(area.getX() - MIN_NOTE_WIDTH) - offset;
+    const double endBeat = pixelToBeat(area.getRight() + 1) - offset;
+    const int highNote = yToNoteNumber(area.getY());
+    const int lowNote = yToNoteNumber(area.getBottom());
+
+    std::vector<size_t> visibleNotes;
+    clip->midiNotes.getNotesInRange(startBeat, endBeat, lowNote, highNote, visibleNotes);
+
+    // Every unselected note shares one style, so batch them into a few paths
+    juce::Path bodies, velocityBars, borders;
+    for (size_t index : visibleNotes) {
+        const auto& note = clip->midiNotes[index];
+        if (note.id == selectedNoteId_ || note.id == drag_.noteId) {
+            continue;  // Drawn on top below
+        }
 
-        // Set up callbacks
-        noteComp->onNoteSelected = [this](size_t index) {
-            // Deselect other notes
-            for (auto& nc : noteComponents_) {
-                if (nc->getNoteIndex() != index) {
-                    nc->setSelected(false);
-                }
-            }
-            selectedNoteIndex_ = static_cast<int>(index);
+        auto bounds = getNoteBounds(note).toFloat();
+        bodies.addRoundedRectangle(bounds, CORNER_RADIUS);
+        borders.addRoundedRectangle(bounds.reduced(0.5f), CORNER_RADIUS);
 
-            if (onNoteSelected && clipId_ != INVALID_CLIP_ID) {
-                onNoteSelected(clipId_, index);
-            }
-        };
+        // Velocity indicator on the left side
+        float velocityHeight = (bounds.getHeight() - 4.0f) * (note.velocity / 127.0f);
+        velocityBars.addRectangle(bounds.getX() + 2.0f,
+                                  bounds.getBottom() - velocityHeight - 2.0f, 3.0f, velocityHeight);
+    }
 
-        noteComp->onNoteMoved = [this](size_t index, double newBeat, int newNoteNumber) {
-            if (onNoteMoved && clipId_ != INVALID_CLIP_ID) {
-                onNoteMoved(clipId_, index, newBeat, newNoteNumber);
-            }
-        };
+    const auto colour = clip->colour;
+    g.setColour(colour);
+    g.fillPath(bodies);
+    g.setColour(colour.brighter(0.5f));
+    g.fillPath(velocityBars);
+    g.setColour(colour.brighter(0.4f));
+    g.strokePath(borders, juce::PathStrokeType(1.0f));
+
+    // The selected note (at its preview position while dragged)
+    const MidiNoteId highlighted =
+        drag_.noteId != INVALID_MIDI_NOTE_ID ? drag_.noteId : selectedNoteId_;
+    const auto* note = clip->midiNotes.find(highlighted);
+    if (!note) {
+        return;
+    }
 
-        noteComp->onNoteResized = [this](size_t index, double newLength, bool fromStart) {
-            (void)fromStart;  // Length change is already computed
-            if (onNoteResized && clipId_ != INVALID_CLIP_ID) {
-                onNoteResized(clipId_, index, newLength);
-            }
-        };
+    auto bounds = getDisplayedNoteBounds(highlighted).toFloat();
+    const bool selected = highlighted == selectedNoteId_;
 
-        noteComp->onNoteDeleted = [this](size_t index) {
-            if (onNoteDeleted && clipId_ != INVALID_CLIP_ID) {
-                onNoteDeleted(clipId_, index);
-                selectedNoteIndex_ = -1;
-            }
-        };
+    g.setColour(selected ? colour.brighter(0.3f) : colour);
+    g.fillRoundedRectangle(bounds, CORNER_RADIUS);
 
-        noteComp->onNoteDragging = [this](size_t index, double previewBeat, bool isDragging) {
-            if (onNoteDragging && clipId_ != INVALID_CLIP_ID) {
-                onNoteDragging(clipId_, index, previewBeat, isDragging);
-            }
-        };
+    float velocityHeight = (bounds.getHeight() - 4.0f) * (note->velocity / 127.0f);
+    g.setColour(colour.brighter(0.5f));
+    g.fillRect(bounds.getX() + 2.0f, bounds.getBottom() - velocityHeight - 2.0f, 3.0f,
+               velocityHeight);
 
-        noteComp->snapBeatToGrid = [this](double beat) { return snapBeatToGrid(beat); };
+    g.setColour(selected ? juce::Colours::white : colour.brighter(0.4f));
+    g.drawRoundedRectangle(bounds.reduced(0.5f), CORNER_RADIUS, selected ? 2.0f : 1.0f);
 
-        noteComp->updateFromNote(clip->midiNotes[i], noteColour);
-        addAndMakeVisible(noteComp.get());
-        noteComponents_.push_back(std::move(noteComp));
+    // Resize handle highlights
+    if (selected && highlighted == hoveredNoteId_) {
+        g.setColour(juce::Colours::white.withAlpha(0.4f));
+        const auto handleWidth = static_cast<float>(RESIZE_HANDLE_WIDTH);
+        if (hoverLeftEdge_) {
+            g.fillRect(bounds.withWidth(handleWidth));
+        }
+        if (hoverRightEdge_) {
+            g.fillRect(bounds.withLeft(bounds.getRight() - handleWidth));
+        }
     }
 }
 
-void PianoRollGridComponent::clearNoteComponents() {
-    for (auto& noteComp : noteComponents_) {
-        removeChildComponent(noteComp.get());
+MidiNoteId PianoRollGridComponent::getNoteAt(juce::Point<int> position) const {
+    const auto* clip = ClipManager::getInstance().getClip(clipId_);
+    if (!clip || clip->type != ClipType::MIDI || pixelsPerBeat_ <= 0) {
+        return INVALID_MIDI_NOTE_ID;
+    }
+
+    const double offset = relativeMode_ ? 0.0 : clipStartBeats_;
+    const double beat = pixelToBeat(position.x) - offset;
+    const int noteNumber = yToNoteNumber(position.y);
+
+    std::vector<size_t> candidates;
+    clip->midiNotes.getNotesInRange(beat - MIN_NOTE_WIDTH / pixelsPerBeat_,
+                                    beat + 1.0 / pixelsPerBeat_, noteNumber, noteNumber,
+                                    candidates);
+
+    // Later notes are drawn on top, so prefer them
+    for (auto it = candidates.rbegin(); it != candidates.rend(); ++it) {
+        const auto& note = clip->midiNotes[*it];
+        if (getNoteBounds(note).contains(position)) {
+            return note.id;
+        }
+    }
+    return INVALID_MIDI_NOTE_ID;
+}
+
+juce::Rectangle<int> PianoRollGridComponent::getNoteBounds(const MidiNote& note) const {
+    return getNoteBounds(note.startBeat, note.noteNumber, note.lengthBeats);
+}
+
+juce::Rectangle<int> PianoRollGridComponent::getDisplayedNoteBounds(MidiNoteId noteId) const {
+    // A dragged note is shown at its preview position
+    if (noteId == drag_.noteId && drag_.isDragging) {
+        switch (drag_.mode) {
+            case DragMode::Move:
+                return getNoteBounds(drag_.previewStartBeat, drag_.previewNoteNumber,
+                                     drag_.startLength);
+            case DragMode::ResizeLeft:
+                return getNoteBounds(drag_.previewStartBeat, drag_.startNoteNumber,
+                                     drag_.previewLengthBeats);
+            case DragMode::ResizeRight:
+                return getNoteBounds(drag_.startBeat, drag_.startNoteNumber,
+                                     drag_.previewLengthBeats);
+            default:
+                break;
+        }
     }
-    noteComponents_.clear();
-    selectedNoteIndex_ = -1;
-}
 
-void PianoRollGridComponent::updateNoteComponentBounds() {
     const auto* clip = ClipManager::getInstance().getClip(clipId_);
-    if (!clip || clip->type != ClipType::MIDI) {
-        return;
+    const auto* note = clip ? clip->midiNotes.find(noteId) : nullptr;
+    return note ? getNoteBounds(*note) : juce::Rectangle<int>();
+}
+
+void PianoRollGridComponent::repaintNote(MidiNoteId noteId) {
+    auto bounds = getDisplayedNoteBounds(noteId);
+    if (!bounds.isEmpty()) {
+        repaint(bounds.expanded(2));  // Selected borders are drawn 2px wide
     }
+}
 
-    for (size_t i = 0; i < noteComponents_.size() && i < clip->midiNotes.size(); i++) {
-        const auto& note = clip->midiNotes[i];
+void PianoRollGridComponent::updateHover(juce::Point<int> position) {
+    const MidiNoteId noteId = getNoteAt(position);
+
+    // Resize handles only apply to the selected note
+    bool leftEdge = false;
+    bool rightEdge = false;
+    if (noteId != INVALID_MIDI_NOTE_ID && noteId == selectedNoteId_) {
+        auto bounds = getDisplayedNoteBounds(noteId);
+        leftEdge = position.x < bounds.getX() + RESIZE_HANDLE_WIDTH;
+        rightEdge = !leftEdge && position.x > bounds.getRight() - RESIZE_HANDLE_WIDTH;
+    }
 
-        // In absolute mode, offset notes by clip start position
-        double displayBeat = relativeMode_ ? note.startBeat : (clipStartBeats_ + note.startBeat);
-        int x = beatToPixel(displayBeat);
-        int y = noteNumberToY(note.noteNumber);
-        int width = juce::jmax(8, static_cast<int>(note.lengthBeats * pixelsPerBeat_));
-        int height = noteHeight_ - 2;
+    if (noteId != hoveredNoteId_ || leftEdge != hoverLeftEdge_ || rightEdge != hoverRightEdge_) {
+        repaintNote(hoveredNoteId_);
+        hoveredNoteId_ = noteId;
+        hoverLeftEdge_ = leftEdge;
+        hoverRightEdge_ = rightEdge;
+        repaintNote(hoveredNoteId_);
+        updateNoteCursor();
+    }
+}
 
-        noteComponents_[i]->setBounds(x, y + 1, width, height);
-        noteComponents_[i]->updateFromNote(note, clip->colour);
+void PianoRollGridComponent::updateNoteCursor() {
+    const bool overSelected =
+        hoveredNoteId_ != INVALID_MIDI_NOTE_ID && hoveredNoteId_ == selectedNoteId_;
+    if (overSelected && (hoverLeftEdge_ || hoverRightEdge_)) {
+        setMouseCursor(juce::MouseCursor::LeftRightResizeCursor);
+    } else if (overSelected) {
+        setMouseCursor(juce::MouseCursor::DraggingHandCursor);
+    } else {
+        setMouseCursor(juce::MouseCursor::NormalCursor);
     }
 }
 
@@ -435,9 +698,36 @@ juce::Colour PianoRollGridComponent::getClipColour() const {
 
 void PianoRollGridComponent::setPlayheadPosition(double positionSeconds) {
     if (playheadPosition_ != positionSeconds) {
+        // Only the strips under the old and new line need redrawing
+        repaint(getPlayheadBounds());
         playheadPosition_ = positionSeconds;
-        repaint();
+        repaint(getPlayheadBounds());
+    }
+}
+
+juce::Rectangle<int> PianoRollGridComponent::getPlayheadBounds() const {
+    if (playheadPosition_ < 0.0) {
+        return {};
+    }
+
+    // Convert seconds to beats
+    // Get tempo from TimelineController
+    double tempo = 120.0;  // Default
+    if (auto* controller = TimelineController::getCurrent()) {
+        tempo = controller->getState().tempo.bpm;
+    }
+    double secondsPerBeat = 60.0 / tempo;
+    double playheadBeats = playheadPosition_ / secondsPerBeat;
+
+    // In absolute mode, playhead is at absolute position
+    // In relative mode, need to offset by clip start
+    double displayBeat = relativeMode_ ? (playheadBeats - clipStartBeats_) : playheadBeats;
+
+    int playheadX = beatToPixel(displayBeat);
+    if (playheadX < 0 || playheadX > getWidth()) {
+        return {};
     }
+    return {playheadX - 1, 0, 2, getHeight()};
 }
 
 }  // namespace magda
@@ -2,10 +2,10 @@
 
 #include <juce_gui_basics/juce_gui_basics.h>
 
-#include <memory>
+#include <functional>
 #include <vector>
 
-#include "NoteComponent.hpp"
+#include "../common/GridLines.hpp"
 #include "core/ClipInfo.hpp"
 #include "core/ClipTypes.hpp"
 
@@ -16,10 +16,14 @@ namespace magda {
  *
  * Handles:
  * - Grid background rendering (beat lines, note rows)
- * - Note component management (create, update, delete)
+ * - Note rendering and editing (select, move, resize, delete) without per-note components
  * - Double-click to add notes
  * - Grid snap settings
  * - Coordinate conversion (beat <-> pixel, noteNumber <-> y)
+ *
+ * Notes are drawn straight from the clip's MidiNoteList: only the notes inside the repainted
+ * region are fetched (via its pitch x time index), and notes sharing a style are batched
+ * into one path, so a dense clip costs what is on screen rather than every note.
  */
 class PianoRollGridComponent : public juce::Component {
   public:
@@ -32,6 +36,10 @@ class PianoRollGridComponent : public juce::Component {
 
     // Mouse handling
     void mouseDown(const juce::MouseEvent& e) override;
+    void mouseDrag(const juce::MouseEvent& e) override;
+    void mouseUp(const juce::MouseEvent& e) override;
+    void mouseMove(const juce::MouseEvent& e) override;
+    void mouseExit(const juce::MouseEvent& e) override;
     void mouseDoubleClick(const juce::MouseEvent& e) override;
 
     // Keyboard handling
@@ -111,24 +119,24 @@ class PianoRollGridComponent : public juce::Component {
     int noteNumberToY(int noteNumber) const;
     int yToNoteNumber(int y) const;
 
-    // Called by NoteComponent to update visual position during drag
-    void updateNotePosition(NoteComponent* note, double beat, int noteNumber, double length);
+    // Bounds of a note (clip-relative beat) in grid coordinates
+    juce::Rectangle<int> getNoteBounds(double beat, int noteNumber, double length) const;
 
-    // Refresh note components from clip data
+    // Repaint after the clip's notes changed
     void refreshNotes();
 
     // Callbacks for parent to handle undo/redo
     std::function<void(ClipId, double, int, int)>
         onNoteAdded;  // clipId, beat, noteNumber, velocity
-    std::function<void(ClipId, size_t, double, int)>
-        onNoteMoved;  // clipId, index, newBeat, newNoteNumber
-    std::function<void(ClipId, size_t, double)> onNoteResized;  // clipId, index, newLength
-    std::function<void(ClipId, size_t)> onNoteDeleted;          // clipId, index
-    std::function<void(ClipId, size_t)> onNoteSelected;         // clipId, index
+    std::function<void(ClipId, MidiNoteId, double, int)>
+        onNoteMoved;  // clipId, noteId, newBeat, newNoteNumber
+    std::function<void(ClipId, MidiNoteId, double)> onNoteResized;  // clipId, noteId, newLength
+    std::function<void(ClipId, MidiNoteId)> onNoteDeleted;          // clipId, noteId
+    std::function<void(ClipId, MidiNoteId)> onNoteSelected;         // clipId, noteId
 
     // Callback for drag preview (for syncing velocity lane position)
-    std::function<void(ClipId, size_t, double, bool)>
-        onNoteDragging;  // clipId, index, previewBeat, isDragging
+    std::function<void(ClipId, MidiNoteId, double, bool)>
+        onNoteDragging;  // clipId, noteId, previewBeat, isDragging
 
   private:
     ClipId clipId_ = INVALID_CLIP_ID;
@@ -154,18 +162,45 @@ class PianoRollGridComponent : public juce::Component {
     double timelineLengthBeats_ = 64.0;  // Full timeline length (in beats) for drawing grid
     bool relativeMode_ = true;  // true = notes at beat 0, false = notes at absolute position
 
+    // Beat lines for the current zoom, resolution and size
+    GridLines beatLines_;
+
     // Playhead position (in seconds)
     double playheadPosition_ = -1.0;  // -1 = not playing, hide playhead
 
-    // Note components
-    std::vector<std::unique_ptr<NoteComponent>> noteComponents_;
+    // Currently selected note
+    MidiNoteId selectedNoteId_ = INVALID_MIDI_NOTE_ID;
+
+    // Note under the mouse, and whether it is over a resize handle
+    MidiNoteId hoveredNoteId_ = INVALID_MIDI_NOTE_ID;
+    bool hoverLeftEdge_ = false;
+    bool hoverRightEdge_ = false;
+
+    // Interaction state for the note being dragged
+    enum class DragMode { None, Move, ResizeLeft, ResizeRight };
+    struct NoteDrag {
+        MidiNoteId noteId = INVALID_MIDI_NOTE_ID;
+        DragMode mode = DragMode::None;
+        juce::Point<int> startPos;
+        double startBeat = 0.0;
+        double startLength = 0.0;
+        int startNoteNumber = 60;
+        double previewStartBeat = 0.0;
+        double previewLengthBeats = 0.0;
+        int previewNoteNumber = 60;
+        bool isDragging = false;
+    };
+    NoteDrag drag_;
 
-    // Currently selected note index (or -1 for none)
-    int selectedNoteIndex_ = -1;
+    // Visual constants
+    static constexpr int RESIZE_HANDLE_WIDTH = 6;
+    static constexpr float CORNER_RADIUS = 2.0f;
+    static constexpr int MIN_NOTE_WIDTH = 8;
 
     // Painting helpers
     void paintGrid(juce::Graphics& g, juce::Rectangle<int> area);
     void paintBeatLines(juce::Graphics& g, juce::Rectangle<int> area, double lengthBeats);
+    void paintNotes(juce::Graphics& g, juce::Rectangle<int> area);
 
     // Grid snap helper
     double snapBeatToGrid(double beat) const;
@@ -173,10 +208,16 @@ class PianoRollGridComponent : public juce::Component {
     // Get note resolution in beats
     double getGridResolutionBeats() const;
 
-    // Note management
-    void createNoteComponents();
-    void clearNoteComponents();
-    void updateNoteComponentBounds();
+    // Note hit testing and drawing positions
+    MidiNoteId getNoteAt(juce::Point<int> position) const;
+    juce::Rectangle<int> getNoteBounds(const MidiNote& note) const;
+    juce::Rectangle<int> getDisplayedNoteBounds(MidiNoteId noteId) const;
+    void repaintNote(MidiNoteId noteId);
+    void updateHover(juce::Point<int> position);
+    void updateNoteCursor();
+
+    // Playhead strip, for repainting just the line while playing
+    juce::Rectangle<int> getPlayheadBounds() const;
 
     // Helpers
     bool isBlackKey(int noteNumber) const;
@@ -1,5 +1,10 @@
 #include "VelocityLaneComponent.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
 #include "../../themes/DarkTheme.hpp"
 #include "core/ClipInfo.hpp"
 #include "core/ClipManager.hpp"
@@ -57,12 +62,12 @@ void VelocityLaneComponent::refreshNotes() {
     repaint();
 }
 
-void VelocityLaneComponent::setNotePreviewPosition(size_t noteIndex, double previewBeat,
+void VelocityLaneComponent::setNotePreviewPosition(MidiNoteId noteId, double previewBeat,
                                                    bool isDragging) {
     if (isDragging) {
-        notePreviewPositions_[noteIndex] = previewBeat;
+        notePreviewPositions_[noteId] = previewBeat;
     } else {
-        notePreviewPositions_.erase(noteIndex);
+        notePreviewPositions_.erase(noteId);
     }
     repaint();
 }
@@ -93,28 +98,29 @@ int VelocityLaneComponent::yToVelocity(int y) const {
     return juce::jlimit(0, 127, velocity);
 }
 
-size_t VelocityLaneComponent::findNoteAtX(int x) const {
+MidiNoteId VelocityLaneComponent::findNoteAtX(int x) const {
     const auto* clip = ClipManager::getInstance().getClip(clipId_);
     if (!clip || clip->type != ClipType::MIDI) {
-        return SIZE_MAX;
+        return INVALID_MIDI_NOTE_ID;
     }
 
-    double clickBeat = pixelToBeat(x);
-
-    // Search for a note that contains this beat
-    for (size_t i = 0; i < clip->midiNotes.size(); ++i) {
-        const auto& note = clip->midiNotes[i];
+    // In absolute mode, notes are offset by clip start
+    double clickBeat = pixelToBeat(x) - (relativeMode_ ? 0.0 : clipStartBeats_);
 
-        // In absolute mode, offset by clip start
-        double noteStart = relativeMode_ ? note.startBeat : (clipStartBeats_ + note.startBeat);
-        double noteEnd = noteStart + note.lengthBeats;
+    // The earliest-starting note that contains this beat, at any pitch
+    std::vector<size_t> hits;
+    clip->midiNotes.getNotesInRange(clickBeat,
+                                    std::nextafter(clickBeat, std::numeric_limits<double>::max()),
+                                    0, MidiNoteList::NUM_PITCHES - 1, hits);
+    return hits.empty() ? INVALID_MIDI_NOTE_ID : clip->midiNotes[hits.front()].id;
+}
 
-        if (clickBeat >= noteStart && clickBeat < noteEnd) {
-            return i;
-        }
-    }
+double VelocityLaneComponent::getVisibleStartBeat() const {
+    return pixelToBeat(0) - (relativeMode_ ? 0.0 : clipStartBeats_);
+}
 
-    return SIZE_MAX;
+double VelocityLaneComponent::getVisibleEndBeat() const {
+    return pixelToBeat(getWidth()) - (relativeMode_ ? 0.0 : clipStartBeats_);
 }
 
 juce::Colour VelocityLaneComponent::getClipColour() const {
@@ -148,13 +154,27 @@ void VelocityLaneComponent::paint(juce::Graphics& g) {
     juce::Colour noteColour = clip->colour;
     int minBarWidth = 4;
 
+    // Only notes in view (bars are at least minBarWidth wide), plus any dragged into view
+    std::vector<size_t> visibleNotes;
+    clip->midiNotes.getNotesInRange(getVisibleStartBeat() - minBarWidth / pixelsPerBeat_,
+                                    getVisibleEndBeat(), 0, MidiNoteList::NUM_PITCHES - 1,
+                                    visibleNotes);
+    for (const auto& preview : notePreviewPositions_) {
+        int index = clip->midiNotes.indexOf(preview.first);
+        if (index >= 0) {
+            visibleNotes.push_back(static_cast<size_t>(index));
+        }
+    }
+    std::sort(visibleNotes.begin(), visibleNotes.end());
+    visibleNotes.erase(std::unique(visibleNotes.begin(), visibleNotes.end()), visibleNotes.end());
+
     // Draw velocity bars for each note
-    for (size_t i = 0; i < clip->midiNotes.size(); ++i) {
+    for (size_t i : visibleNotes) {
         const auto& note = clip->midiNotes[i];
 
         // Calculate x position - use preview position if available
         double noteStart = note.startBeat;
-        auto previewIt = notePreviewPositions_.find(i);
+        auto previewIt = notePreviewPositions_.find(note.id);
         if (previewIt != notePreviewPositions_.end()) {
             noteStart = previewIt->second;
         }
@@ -171,7 +191,7 @@ void VelocityLaneComponent::paint(juce::Graphics& g) {
 
         // Use drag velocity if this is the note being dragged
         int velocity = note.velocity;
-        if (isDragging_ && i == draggingNoteIndex_) {
+        if (isDragging_ && note.id == draggingNoteId_) {
             velocity = currentDragVelocity_;
         }
 
@@ -191,7 +211,7 @@ void VelocityLaneComponent::paint(juce::Graphics& g) {
         g.drawRect(barBounds, 1);
 
         // Highlight if being dragged
-        if (isDragging_ && i == draggingNoteIndex_) {
+        if (isDragging_ && note.id == draggingNoteId_) {
             g.setColour(juce::Colours::white.withAlpha(0.3f));
             g.fillRect(barBounds);
         }
@@ -203,13 +223,14 @@ void VelocityLaneComponent::paint(juce::Graphics& g) {
 }
 
 void VelocityLaneComponent::mouseDown(const juce::MouseEvent& e) {
-    size_t noteIndex = findNoteAtX(e.x);
+    MidiNoteId noteId = findNoteAtX(e.x);
 
-    if (noteIndex != SIZE_MAX) {
+    if (noteId != INVALID_MIDI_NOTE_ID) {
         const auto* clip = ClipManager::getInstance().getClip(clipId_);
-        if (clip && noteIndex < clip->midiNotes.size()) {
-            draggingNoteIndex_ = noteIndex;
-            dragStartVelocity_ = clip->midiNotes[noteIndex].velocity;
+        const auto* note = clip ? clip->midiNotes.find(noteId) : nullptr;
+        if (note) {
+            draggingNoteId_ = noteId;
+            dragStartVelocity_ = note->velocity;
             currentDragVelocity_ = yToVelocity(e.y);
             isDragging_ = true;
             repaint();
@@ -218,7 +239,7 @@ void VelocityLaneComponent::mouseDown(const juce::MouseEvent& e) {
 }
 
 void VelocityLaneComponent::mouseDrag(const juce::MouseEvent& e) {
-    if (isDragging_ && draggingNoteIndex_ != SIZE_MAX) {
+    if (isDragging_ && draggingNoteId_ != INVALID_MIDI_NOTE_ID) {
         int newVelocity = yToVelocity(e.y);
         if (newVelocity != currentDragVelocity_) {
             currentDragVelocity_ = newVelocity;
@@ -228,15 +249,15 @@ void VelocityLaneComponent::mouseDrag(const juce::MouseEvent& e) {
 }
 
 void VelocityLaneComponent::mouseUp(const juce::MouseEvent& e) {
-    if (isDragging_ && draggingNoteIndex_ != SIZE_MAX) {
+    if (isDragging_ && draggingNoteId_ != INVALID_MIDI_NOTE_ID) {
         int finalVelocity = yToVelocity(e.y);
 
         // Only commit if velocity actually changed
         if (finalVelocity != dragStartVelocity_ && onVelocityChanged) {
-            onVelocityChanged(clipId_, draggingNoteIndex_, finalVelocity);
+            onVelocityChanged(clipId_, draggingNoteId_, finalVelocity);
         }
 
-        draggingNoteIndex_ = SIZE_MAX;
+        draggingNoteId_ = INVALID_MIDI_NOTE_ID;
         isDragging_ = false;
         repaint();
     }
@@ -6,6 +6,7 @@
 #include <unordered_map>
 
 #include "core/ClipTypes.hpp"
+#include "core/TypeIds.hpp"
 
 namespace magda {
 
@@ -39,10 +40,10 @@ class VelocityLaneComponent : public juce::Component {
     void refreshNotes();
 
     // Set preview position for a note during drag (for syncing with grid)
-    void setNotePreviewPosition(size_t noteIndex, double previewBeat, bool isDragging);
+    void setNotePreviewPosition(MidiNoteId noteId, double previewBeat, bool isDragging);
 
     // Callback for velocity changes
-    std::function<void(ClipId, size_t noteIndex, int newVelocity)> onVelocityChanged;
+    std::function<void(ClipId, MidiNoteId noteId, int newVelocity)> onVelocityChanged;
 
     // Component overrides
     void paint(juce::Graphics& g) override;
@@ -59,13 +60,13 @@ class VelocityLaneComponent : public juce::Component {
     double clipStartBeats_ = 0.0;
 
     // Drag state
-    size_t draggingNoteIndex_ = SIZE_MAX;
+    MidiNoteId draggingNoteId_ = INVALID_MIDI_NOTE_ID;
     int dragStartVelocity_ = 0;
     int currentDragVelocity_ = 0;
     bool isDragging_ = false;
 
     // Preview positions for notes being dragged in the grid
-    std::unordered_map<size_t, double> notePreviewPositions_;
+    std::unordered_map<MidiNoteId, double> notePreviewPositions_;
 
     // Coordinate conversion
     int beatToPixel(double beat) const;
@@ -74,7 +75,11 @@ class VelocityLaneComponent : public juce::Component {
     int yToVelocity(int y) const;
 
     // Find note at given x coordinate
-    size_t findNoteAtX(int x) const;
+    MidiNoteId findNoteAtX(int x) const;
+
+    // Note range shown at the current scroll position, in clip-relative beats
+    double getVisibleStartBeat() const;
+    double getVisibleEndBeat() const;
 
     // Get clip color
     juce::Colour getClipColour() const;
@@ -1,7 +1,10 @@
 #include "TimeRuler.hpp"
 
+#include <algorithm>
 #include <cmath>
+#include <cstdio>
 
+#include "../common/TextLayoutCache.hpp"
 #include "DarkTheme.hpp"
 #include "LayoutConfig.hpp"
 
@@ -12,7 +15,7 @@ TimeRuler::TimeRuler() {
 }
 
 TimeRuler::~TimeRuler() {
-    stopTimer();
+    setLinkedViewport(nullptr);
 }
 
 void TimeRuler::paint(juce::Graphics& g) {
@@ -62,12 +65,14 @@ void TimeRuler::setScrollOffset(int offsetPixels) {
 
 void TimeRuler::setTempo(double bpm) {
     tempo = bpm;
+    tempoMap.setTempo(bpm);
     repaint();
 }
 
 void TimeRuler::setTimeSignature(int numerator, int denominator) {
     timeSigNumerator = numerator;
     timeSigDenominator = denominator;
+    tempoMap.setTimeSignature(numerator, denominator);
     repaint();
 }
 
@@ -87,9 +92,31 @@ void TimeRuler::setClipLength(double lengthSeconds) {
 }
 
 void TimeRuler::setPlayheadPosition(double positionSeconds) {
-    if (playheadPosition != positionSeconds) {
-        playheadPosition = positionSeconds;
-        repaint();
+    if (playheadPosition == positionSeconds) {
+        return;
+    }
+
+    // Only bars/beats mode draws the playhead, and only its old and new strips change
+    const int oldX = getPlayheadX();
+    playheadPosition = positionSeconds;
+    const int newX = getPlayheadX();
+    if (displayMode == DisplayMode::BarsBeats && oldX != newX) {
+        repaintPlayheadStrip(oldX);
+        repaintPlayheadStrip(newX);
+    }
+}
+
+int TimeRuler::getPlayheadX() const {
+    if (playheadPosition < 0.0) {
+        return -1;
+    }
+    // In relative mode, playhead is relative to timeOffset
+    return timeToPixel(relativeMode ? (playheadPosition - timeOffset) : playheadPosition);
+}
+
+void TimeRuler::repaintPlayheadStrip(int x) {
+    if (x >= 0 && x <= getWidth()) {
+        repaint(x - 1, 0, 2, getHeight());
     }
 }
 
@@ -99,24 +126,20 @@ void TimeRuler::setLeftPadding(int padding) {
 }
 
 void TimeRuler::setLinkedViewport(juce::Viewport* viewport) {
-    linkedViewport = viewport;
     if (linkedViewport) {
-        // Start timer for real-time scroll sync (60fps)
-        startTimerHz(60);
-        lastViewportX = linkedViewport->getViewPositionX();
-    } else {
-        stopTimer();
+        linkedViewport->getHorizontalScrollBar().removeListener(this);
     }
-}
 
-void TimeRuler::timerCallback() {
+    // Follow the viewport's scrollbar rather than polling its position every frame
+    linkedViewport = viewport;
     if (linkedViewport) {
-        int currentX = linkedViewport->getViewPositionX();
-        if (currentX != lastViewportX) {
-            lastViewportX = currentX;
-            repaint();
-        }
+        linkedViewport->getHorizontalScrollBar().addListener(this);
     }
+    repaint();
+}
+
+void TimeRuler::scrollBarMoved(juce::ScrollBar* /*scrollBar*/, double /*newRangeStart*/) {
+    repaint();
 }
 
 int TimeRuler::getPreferredHeight() const {
@@ -205,47 +228,52 @@ void TimeRuler::mouseWheelMove(const juce::MouseEvent& /*event*/,
     }
 }
 
+GridLines::Key TimeRuler::makeGridKey() const {
+    GridLines::Key key;
+    key.beatsPerBar = timeSigNumerator;
+    key.pixelsPerUnit = zoom;
+    key.originX = leftPadding - getCurrentScrollOffset();
+    key.left = 0;
+    key.right = getWidth();
+    key.length = timelineLength;
+    return key;
+}
+
 void TimeRuler::drawSecondsMode(juce::Graphics& g) {
     const int height = getHeight();
-    const int width = getWidth();
 
     // Calculate marker interval based on zoom
     double interval = calculateMarkerInterval();
 
-    // Find first visible time
-    double startTime = pixelToTime(0);
-    startTime = std::floor(startTime / interval) * interval;
-    if (startTime < 0)
-        startTime = 0;
+    // Major markers every 5 intervals, and never further apart than a second
+    auto key = makeGridKey();
+    key.spacing = GridLines::Spacing::Seconds;
+    key.interval = interval;
+    key.majorInterval = interval >= 1.0 ? interval : std::min(interval * 5, 1.0);
 
     // Draw markers
     g.setFont(11.0f);
+    auto& textLayouts = TextLayoutCache::getInstance();
+    char label[32];
+    const int labelHeight = height - TICK_HEIGHT_MAJOR - LABEL_MARGIN * 2;
 
-    for (double time = startTime; time <= timelineLength; time += interval) {
-        int x = timeToPixel(time);
-
-        if (x < 0)
-            continue;
-        if (x > width)
-            break;
-
-        // Determine if this is a major marker (every 5 intervals or at round numbers)
-        bool isMajor = std::fmod(time, interval * 5) < 0.001 || std::fmod(time, 1.0) < 0.001;
-
+    for (const auto& line : gridLines.get(key, &tempoMap)) {
+        bool isMajor = line.level == GridLines::Level::Major;
         int tickHeight = isMajor ? TICK_HEIGHT_MAJOR : TICK_HEIGHT_MINOR;
 
         // Draw tick
         g.setColour(
             DarkTheme::getColour(isMajor ? DarkTheme::TEXT_SECONDARY : DarkTheme::TEXT_DIM));
-        g.drawVerticalLine(x, static_cast<float>(height - tickHeight), static_cast<float>(height));
+        g.drawVerticalLine(line.x, static_cast<float>(height - tickHeight),
+                           static_cast<float>(height));
 
         // Draw label for major ticks
         if (isMajor) {
             g.setColour(DarkTheme::getColour(DarkTheme::TEXT_SECONDARY));
-            juce::String label = formatTimeLabel(time, interval);
-            g.drawText(label, x - 30, LABEL_MARGIN, 60,
-                       height - TICK_HEIGHT_MAJOR - LABEL_MARGIN * 2, juce::Justification::centred,
-                       false);
+            formatTimeLabel(line.position, interval, label, sizeof(label));
+            textLayouts.drawText(g, label,
+                                 juce::Rectangle<int>(line.x - 30, LABEL_MARGIN, 60, labelHeight),
+                                 juce::Justification::centred);
         }
     }
 }
@@ -254,62 +282,39 @@ void TimeRuler::drawBarsBeatsMode(juce::Graphics& g) {
     const int height = getHeight();
     const int width = getWidth();
 
-    // Calculate seconds per beat and per bar
-    double secondsPerBeat = 60.0 / tempo;
-    double secondsPerBar = secondsPerBeat * timeSigNumerator;
-
     // Determine what to show based on zoom level
     // At low zoom, show only bars; at high zoom, show beats too
-    double pixelsPerBar = secondsPerBar * zoom;
+    double pixelsPerBar = 60.0 / tempo * timeSigNumerator * zoom;
     bool showBeats = pixelsPerBar > 60;  // Only show beats if bars are wide enough
 
     // In ABS mode: bar numbers are absolute (1, 2, 3...), grid starts at project time 0
     // In REL mode: bar numbers relative to clip (1, 2, 3...), grid starts at clip time 0
     // No barOffset needed since grid coordinate system matches display
-
-    // Find first visible bar
-    double startTime = pixelToTime(0);
-    int startBar = static_cast<int>(std::floor(startTime / secondsPerBar));
-    if (startBar < 1)
-        startBar = 1;
+    auto key = makeGridKey();
+    key.interval = showBeats ? 1.0 : static_cast<double>(timeSigNumerator);
 
     g.setFont(11.0f);
+    auto& textLayouts = TextLayoutCache::getInstance();
+    char label[16];
+    const int labelHeight = height - TICK_HEIGHT_MAJOR - LABEL_MARGIN * 2;
 
     // Draw bar lines and optionally beat lines
-    for (int bar = startBar;; bar++) {
-        double barTime = (bar - 1) * secondsPerBar;
-        int barX = timeToPixel(barTime);
-
-        if (barX > width)
-            break;
-        if (barTime > timelineLength)
-            break;
-
-        if (barX >= 0) {
+    for (const auto& line : gridLines.get(key, &tempoMap)) {
+        if (line.level == GridLines::Level::Major) {
             // Draw bar line (major tick)
             g.setColour(DarkTheme::getColour(DarkTheme::TEXT_SECONDARY));
-            g.drawVerticalLine(barX, static_cast<float>(height - TICK_HEIGHT_MAJOR),
+            g.drawVerticalLine(line.x, static_cast<float>(height - TICK_HEIGHT_MAJOR),
                                static_cast<float>(height));
 
             // Draw bar number (always 1, 2, 3... from the left edge)
-            juce::String label = juce::String(bar);
-            g.drawText(label, barX - 20, LABEL_MARGIN, 40,
-                       height - TICK_HEIGHT_MAJOR - LABEL_MARGIN * 2, juce::Justification::centred,
-                       false);
-        }
-
-        // Draw beat lines within this bar
-        if (showBeats) {
+            std::snprintf(label, sizeof(label), "%d", line.bar);
+            textLayouts.drawText(g, label,
+                                 juce::Rectangle<int>(line.x - 20, LABEL_MARGIN, 40, labelHeight),
+                                 juce::Justification::centred);
+        } else {
             g.setColour(DarkTheme::getColour(DarkTheme::TEXT_DIM));
-            for (int beat = 2; beat <= timeSigNumerator; beat++) {
-                double beatTime = barTime + (beat - 1) * secondsPerBeat;
-                int beatX = timeToPixel(beatTime);
-
-                if (beatX >= 0 && beatX <= width && beatTime <= timelineLength) {
-                    g.drawVerticalLine(beatX, static_cast<float>(height - TICK_HEIGHT_MINOR),
-                                       static_cast<float>(height));
-                }
-            }
+            g.drawVerticalLine(line.x, static_cast<float>(height - TICK_HEIGHT_MINOR),
+                               static_cast<float>(height));
         }
     }
 
@@ -340,10 +345,7 @@ void TimeRuler::drawBarsBeatsMode(juce::Graphics& g) {
 
     // Draw playhead line if playing
     if (playheadPosition >= 0.0) {
-        // In absolute mode, playhead is at absolute position
-        // In relative mode, playhead is relative to timeOffset
-        double displayTime = relativeMode ? (playheadPosition - timeOffset) : playheadPosition;
-        int playheadX = timeToPixel(displayTime);
+        int playheadX = getPlayheadX();
         if (playheadX >= 0 && playheadX <= width) {
             // Draw playhead line (red)
             g.setColour(juce::Colour(0xFFFF4444));
@@ -370,7 +372,7 @@ double TimeRuler::calculateMarkerInterval() const {
     return 600.0;  // 10 minutes
 }
 
-juce::String TimeRuler::formatTimeLabel(double time, double interval) const {
+void TimeRuler::formatTimeLabel(double time, double interval, char* out, size_t size) const {
     int totalSeconds = static_cast<int>(time);
     int minutes = totalSeconds / 60;
     int seconds = totalSeconds % 60;
@@ -379,18 +381,20 @@ juce::String TimeRuler::formatTimeLabel(double time, double interval) const {
         // Show milliseconds
         int ms = static_cast<int>((time - totalSeconds) * 1000);
         if (minutes > 0) {
-            return juce::String::formatted("%d:%02d.%03d", minutes, seconds, ms);
+            std::snprintf(out, size, "%d:%02d.%03d", minutes, seconds, ms);
+        } else {
+            std::snprintf(out, size, "%d.%03d", seconds, ms);
         }
-        return juce::String::formatted("%d.%03d", seconds, ms);
     } else if (interval < 60.0) {
         // Show seconds
         if (minutes > 0) {
-            return juce::String::formatted("%d:%02d", minutes, seconds);
+            std::snprintf(out, size, "%d:%02d", minutes, seconds);
+        } else {
+            std::snprintf(out, size, "%ds", seconds);
         }
-        return juce::String::formatted("%ds", seconds);
     } else {
         // Show minutes
-        return juce::String::formatted("%d:%02d", minutes, seconds);
+        std::snprintf(out, size, "%d:%02d", minutes, seconds);
     }
 }
 
@@ -405,16 +409,17 @@ juce::String TimeRuler::formatBarsBeatsLabel(double time) const {
     return juce::String::formatted("%d.%d", bar, beat);
 }
 
-double TimeRuler::pixelToTime(int pixel) const {
+int TimeRuler::getCurrentScrollOffset() const {
     // Use linked viewport's position for real-time scroll sync
-    int currentScrollOffset = linkedViewport ? linkedViewport->getViewPositionX() : scrollOffset;
-    return (pixel + currentScrollOffset - leftPadding) / zoom;
+    return linkedViewport ? linkedViewport->getViewPositionX() : scrollOffset;
+}
+
+double TimeRuler::pixelToTime(int pixel) const {
+    return (pixel + getCurrentScrollOffset() - leftPadding) / zoom;
 }
 
 int TimeRuler::timeToPixel(double time) const {
-    // Use linked viewport's position for real-time scroll sync
-    int currentScrollOffset = linkedViewport ? linkedViewport->getViewPositionX() : scrollOffset;
-    return static_cast<int>(time * zoom) - currentScrollOffset + leftPadding;
+    return static_cast<int>(time * zoom) - getCurrentScrollOffset() + leftPadding;
 }
 
 }  // namespace magda
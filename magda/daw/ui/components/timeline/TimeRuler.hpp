@@ -4,13 +4,15 @@
 
 #include <functional>
 
+#include "../common/GridLines.hpp"
+
 namespace magda {
 
 /**
  * Time ruler component displaying time markers and labels.
  * Supports both time-based (seconds) and musical (bars/beats) display modes.
  */
-class TimeRuler : public juce::Component, private juce::Timer {
+class TimeRuler : public juce::Component, private juce::ScrollBar::Listener {
   public:
     enum class DisplayMode { Seconds, BarsBeats };
 
@@ -93,6 +95,8 @@ class TimeRuler : public juce::Component, private juce::Timer {
     double tempo = 120.0;  // BPM
     int timeSigNumerator = 4;
     int timeSigDenominator = 4;
+    TempoMap tempoMap;    // Matches tempo and the time signature
+    GridLines gridLines;  // Ticks for the current zoom and scroll, rebuilt when they change
 
     // Offset and relative mode (for piano roll)
     double timeOffset = 0.0;    // seconds - absolute position of content start
@@ -102,7 +106,7 @@ class TimeRuler : public juce::Component, private juce::Timer {
 
     // Layout
     int leftPadding = 18;  // Configurable padding (default 18 for main timeline)
-    juce::Viewport* linkedViewport = nullptr;  // For real-time scroll sync
+    juce::Component::SafePointer<juce::Viewport> linkedViewport;  // For real-time scroll sync
     static constexpr int TICK_HEIGHT_MAJOR = 12;
     static constexpr int TICK_HEIGHT_MINOR = 6;
     static constexpr int LABEL_MARGIN = 4;
@@ -110,17 +114,21 @@ class TimeRuler : public juce::Component, private juce::Timer {
     // Drawing helpers
     void drawSecondsMode(juce::Graphics& g);
     void drawBarsBeatsMode(juce::Graphics& g);
+    int getPlayheadX() const;  // -1 when not playing
+    void repaintPlayheadStrip(int x);
     double calculateMarkerInterval() const;
-    juce::String formatTimeLabel(double time, double interval) const;
+    // Into a caller's buffer, so labels drawn every frame don't allocate
+    void formatTimeLabel(double time, double interval, char* out, size_t size) const;
     juce::String formatBarsBeatsLabel(double time) const;
+    GridLines::Key makeGridKey() const;
 
     // Coordinate conversion
+    int getCurrentScrollOffset() const;
     double pixelToTime(int pixel) const;
     int timeToPixel(double time) const;
 
-    // Timer callback for real-time scroll sync
-    void timerCallback() override;
-    int lastViewportX = 0;  // Track last position to detect changes
+    // Repaints as the linked viewport scrolls (its scrollbars move even when hidden)
+    void scrollBarMoved(juce::ScrollBar* scrollBar, double newRangeStart) override;
 
     // Drag state (zoom or scroll)
     enum class DragMode { None, Zooming, Scrolling };
@@ -7,6 +7,7 @@
 #include "../../themes/DarkTheme.hpp"
 #include "../../themes/FontManager.hpp"
 #include "Config.hpp"
+#include "TempoMap.hpp"
 
 namespace magda {
 
@@ -23,24 +24,26 @@ TimelineComponent::TimelineComponent() {
     arrangementLocked = true;
 }
 
-TimelineComponent::~TimelineComponent() {
-    // Unregister from controller if we have one
-    if (timelineController) {
-        timelineController->removeListener(this);
-    }
-}
+TimelineComponent::~TimelineComponent() = default;
 
 void TimelineComponent::setController(TimelineController* controller) {
-    // Unregister from old controller
-    if (timelineController) {
-        timelineController->removeListener(this);
-    }
-
+    // Unsubscribe from the old controller
+    timelineSubscriptions.clear();
     timelineController = controller;
 
-    // Register with new controller
+    // Subscribe to the parts of the state the ruler draws (MainView moves its playhead)
     if (timelineController) {
-        timelineController->addListener(this);
+        using Flags = TimelineController::ChangeFlags;
+        timelineSubscriptions.push_back(timelineController->subscribe(
+            Flags::Timeline | Flags::Display | Flags::Tempo | Flags::Sections,
+            [this](const TimelineState& state) { timelineStateChanged(state); }));
+        timelineSubscriptions.push_back(timelineController->subscribe(
+            Flags::Zoom, [this](const TimelineState& state) { zoomStateChanged(state); }));
+        timelineSubscriptions.push_back(timelineController->subscribe(
+            Flags::Loop, [this](const TimelineState& state) { loopStateChanged(state); }));
+        timelineSubscriptions.push_back(timelineController->subscribe(
+            Flags::Selection,
+            [this](const TimelineState& state) { selectionStateChanged(state); }));
 
         // Sync initial state
         const auto& state = timelineController->getState();
@@ -74,7 +77,7 @@ void TimelineComponent::setController(TimelineController* controller) {
     }
 }
 
-// ===== TimelineStateListener Implementation =====
+// ===== Timeline State Handlers =====
 
 void TimelineComponent::timelineStateChanged(const TimelineState& state) {
     // General state change - sync all cached values
@@ -241,18 +244,10 @@ juce::String TimelineComponent::formatTimePosition(double timeInSeconds) const {
             return juce::String(minutes) + ":" + juce::String(seconds).paddedLeft('0', 2);
         }
     } else {
-        // Format as bar.beat.subdivision (1-indexed)
-        double beatsPerSecond = tempoBPM / 60.0;
-        double totalBeats = timeInSeconds * beatsPerSecond;
-
-        int bar = static_cast<int>(totalBeats / timeSignatureNumerator) + 1;
-        int beatInBar = static_cast<int>(std::fmod(totalBeats, timeSignatureNumerator)) + 1;
-
-        // Subdivision (16th notes within the beat)
-        double beatFraction = std::fmod(totalBeats, 1.0);
-        int subdivision = static_cast<int>(beatFraction * 4) + 1;  // 1-4 for 16th notes
-
-        return juce::String(bar) + "." + juce::String(beatInBar) + "." + juce::String(subdivision);
+        // Format as bar.beat.subdivision (1-indexed, subdivision in 16ths)
+        const auto position = TempoMap::getInstance().toBarBeat(timeInSeconds);
+        return juce::String(position.bar) + "." + juce::String(position.beat) + "." +
+               juce::String(position.sixteenth);
     }
 }
 
@@ -15,7 +15,7 @@ class TimelineController;
 
 // TimeDisplayMode and ArrangementSection are now defined in TimelineState.hpp
 
-class TimelineComponent : public juce::Component, public TimelineStateListener {
+class TimelineComponent : public juce::Component {
   public:
     TimelineComponent();
     ~TimelineComponent() override;
@@ -23,11 +23,11 @@ class TimelineComponent : public juce::Component, public TimelineStateListener {
     void paint(juce::Graphics& g) override;
     void resized() override;
 
-    // TimelineStateListener implementation
-    void timelineStateChanged(const TimelineState& state) override;
-    void zoomStateChanged(const TimelineState& state) override;
-    void loopStateChanged(const TimelineState& state) override;
-    void selectionStateChanged(const TimelineState& state) override;
+    // Timeline state handlers, subscribed per change in setController()
+    void timelineStateChanged(const TimelineState& state);
+    void zoomStateChanged(const TimelineState& state);
+    void loopStateChanged(const TimelineState& state);
+    void selectionStateChanged(const TimelineState& state);
 
     // Set the controller reference (called by MainView after construction)
     void setController(TimelineController* controller);
@@ -134,6 +134,7 @@ class TimelineComponent : public juce::Component, public TimelineStateListener {
   private:
     // Controller reference (not owned)
     TimelineController* timelineController = nullptr;
+    std::vector<Subscription> timelineSubscriptions;
 
     // Layout constants - use shared constant from LayoutConfig
     static constexpr int LEFT_PADDING = LayoutConfig::TIMELINE_LEFT_PADDING;
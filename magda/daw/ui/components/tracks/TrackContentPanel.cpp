@@ -2,6 +2,7 @@
 
 #include <juce_audio_formats/juce_audio_formats.h>
 
+#include <algorithm>
 #include <functional>
 
 #include "../../panels/state/PanelController.hpp"
@@ -11,7 +12,12 @@
 #include "../automation/AutomationLaneComponent.hpp"
 #include "../clips/ClipComponent.hpp"
 #include "Config.hpp"
+#include "audio/AudioFileImporter.hpp"
+#include "audio/MidiFileImporter.hpp"
+#include "audio/TempoCache.hpp"
+#include "core/BatchOperations.hpp"
 #include "core/ClipCommands.hpp"
+#include "core/ProjectManager.hpp"
 #include "core/SelectionManager.hpp"
 #include "core/UndoManager.hpp"
 
@@ -32,6 +38,7 @@ TrackContentPanel::TrackContentPanel() {
 
     // Register as ClipManager listener
     ClipManager::getInstance().addListener(this);
+    zoomSettleTimer_.onSettled = [this]() { endZoomPreview(); };
 
     // Register as ViewModeController listener
     ViewModeController::getInstance().addListener(this);
@@ -62,11 +69,6 @@ TrackContentPanel::~TrackContentPanel() {
 
     // Unregister from AutomationManager
     AutomationManager::getInstance().removeListener(this);
-
-    // Unregister from controller if we have one
-    if (timelineController) {
-        timelineController->removeListener(this);
-    }
 }
 
 void TrackContentPanel::viewModeChanged(ViewMode mode, const AudioEngineProfile& /*profile*/) {
@@ -115,16 +117,19 @@ void TrackContentPanel::tracksChanged() {
 }
 
 void TrackContentPanel::setController(TimelineController* controller) {
-    // Unregister from old controller
-    if (timelineController) {
-        timelineController->removeListener(this);
-    }
-
+    // Unsubscribe from the old controller
+    timelineSubscriptions_.clear();
     timelineController = controller;
 
-    // Register with new controller
+    // Scrolling moves the panel inside its viewport and playhead ticks are drawn by
+    // MainView, so neither relays the panel out
     if (timelineController) {
-        timelineController->addListener(this);
+        using Flags = TimelineController::ChangeFlags;
+        timelineSubscriptions_.push_back(timelineController->subscribe(
+            Flags::Timeline | Flags::Display | Flags::Tempo | Flags::Selection,
+            [this](const TimelineState& state) { timelineStateChanged(state); }));
+        timelineSubscriptions_.push_back(timelineController->subscribe(
+            Flags::Zoom, [this](const TimelineState& state) { zoomStateChanged(state); }));
 
         // Sync initial state
         const auto& state = timelineController->getState();
@@ -139,7 +144,7 @@ void TrackContentPanel::setController(TimelineController* controller) {
     }
 }
 
-// ===== TimelineStateListener Implementation =====
+// ===== Timeline State Handlers =====
 
 void TrackContentPanel::timelineStateChanged(const TimelineState& state) {
     // General state change - sync cached values
@@ -167,12 +172,16 @@ void TrackContentPanel::timelineStateChanged(const TimelineState& state) {
 }
 
 void TrackContentPanel::zoomStateChanged(const TimelineState& state) {
+    if (state.zoom.horizontalZoom != currentZoom) {
+        beginZoomPreview();
+    }
     currentZoom = state.zoom.horizontalZoom;
     resized();
     repaint();
 }
 
 void TrackContentPanel::paint(juce::Graphics& g) {
+    paintProfile_.begin();
     g.fillAll(DarkTheme::getColour(DarkTheme::TRACK_BACKGROUND));
 
     // Grid is now drawn by GridOverlayComponent in MainView
@@ -208,6 +217,8 @@ void TrackContentPanel::paintOverChildren(juce::Graphics& g) {
         g.drawLine(static_cast<float>(dropX), static_cast<float>(trackY), static_cast<float>(dropX),
                    static_cast<float>(trackY + trackHeight), 2.0f);
     }
+
+    paintProfile_.end();
 }
 
 void TrackContentPanel::resized() {
@@ -216,6 +227,13 @@ void TrackContentPanel::resized() {
     int contentHeight = getTotalTracksHeight();
 
     setSize(juce::jmax(contentWidth, getWidth()), juce::jmax(contentHeight, getHeight()));
+
+    // Zoom, track heights and viewport size all change which clips are in range
+    updateVisibleClipComponents();
+}
+
+void TrackContentPanel::moved() {
+    updateVisibleClipComponents();
 }
 
 void TrackContentPanel::addTrack() {
@@ -279,15 +297,41 @@ int TrackContentPanel::getTrackHeight(int trackIndex) const {
 }
 
 void TrackContentPanel::setZoom(double zoom) {
-    currentZoom = juce::jmax(0.1, zoom);
-    updateClipComponentPositions();
+    const double newZoom = juce::jmax(0.1, zoom);
+    if (newZoom != currentZoom) {
+        beginZoomPreview();
+    }
+    currentZoom = newZoom;
+    updateVisibleClipComponents();
     resized();
     repaint();
 }
 
+void TrackContentPanel::beginZoomPreview() {
+    if (!zoomPreviewActive_) {
+        zoomPreviewActive_ = true;
+        for (auto& clipComp : clipComponents_) {
+            clipComp->setZoomPreview(true);
+        }
+    }
+    // Restarted by every step, so it fires once the gesture has been still for a moment
+    zoomSettleTimer_.startTimer(ZOOM_SETTLE_MS);
+}
+
+void TrackContentPanel::endZoomPreview() {
+    zoomSettleTimer_.stopTimer();
+    if (!zoomPreviewActive_) {
+        return;
+    }
+    zoomPreviewActive_ = false;
+    for (auto& clipComp : clipComponents_) {
+        clipComp->setZoomPreview(false);
+    }
+}
+
 void TrackContentPanel::setVerticalZoom(double zoom) {
     verticalZoom = juce::jlimit(0.5, 3.0, zoom);
-    updateClipComponentPositions();
+    updateVisibleClipComponents();
     resized();
     repaint();
 }
@@ -343,6 +387,21 @@ void TrackContentPanel::paintTrackLane(juce::Graphics& g, const TrackLane& lane,
     g.drawRect(area, 1);
 }
 
+juce::Rectangle<int> TrackContentPanel::getEditCursorBounds() const {
+    if (!timelineController || selectedTrackIndex < 0) {
+        return {};
+    }
+
+    double editCursorPos = timelineController->getState().editCursorPosition;
+    if (editCursorPos < 0 || editCursorPos > timelineLength) {
+        return {};
+    }
+
+    // Line plus its glow (see paintEditCursor)
+    auto trackArea = getTrackLaneArea(selectedTrackIndex);
+    return trackArea.withX(timeToPixel(editCursorPos) - 3).withWidth(6);
+}
+
 void TrackContentPanel::paintEditCursor(juce::Graphics& g) {
     if (!timelineController || selectedTrackIndex < 0) {
         return;
@@ -780,9 +839,10 @@ void TrackContentPanel::mouseDoubleClick(const juce::MouseEvent& event) {
 }
 
 void TrackContentPanel::timerCallback() {
-    // Toggle edit cursor blink state
+    // Toggle edit cursor blink state; only its strip needs redrawing, clips underneath
+    // composite from their tile caches
     editCursorBlinkVisible_ = !editCursorBlinkVisible_;
-    repaint();
+    repaint(getEditCursorBounds());
 }
 
 void TrackContentPanel::mouseMove(const juce::MouseEvent& event) {
@@ -842,25 +902,16 @@ void TrackContentPanel::clipsChanged() {
     rebuildClipComponents();
 }
 
-void TrackContentPanel::clipPropertyChanged(ClipId clipId) {
-    // Find the clip component and update its position/size
+void TrackContentPanel::clipPropertyChanged(ClipId /*clipId*/) {
     // Skip if any clip is being dragged to prevent flicker
-    for (auto& clipComp : clipComponents_) {
-        if (clipComp->getClipId() == clipId) {
-            // Check if any clip is currently being dragged
-            bool anyDragging = false;
-            for (const auto& cc : clipComponents_) {
-                if (cc->isCurrentlyDragging()) {
-                    anyDragging = true;
-                    break;
-                }
-            }
-            if (!anyDragging) {
-                updateClipComponentPositions();
-            }
-            break;
+    for (const auto& clipComp : clipComponents_) {
+        if (clipComp->isCurrentlyDragging()) {
+            return;
         }
     }
+
+    // The clip may have moved into or out of view
+    updateVisibleClipComponents();
 }
 
 void TrackContentPanel::clipSelectionChanged(ClipId /*clipId*/) {
@@ -873,83 +924,188 @@ void TrackContentPanel::clipSelectionChanged(ClipId /*clipId*/) {
 // ============================================================================
 
 void TrackContentPanel::rebuildClipComponents() {
-    // Remove all existing clip components
-    clipComponents_.clear();
+    updateVisibleClipComponents();
+}
+
+std::unique_ptr<ClipComponent> TrackContentPanel::createClipComponent(ClipId clipId) {
+    if (!spareClipComponents_.empty()) {
+        auto clipComp = std::move(spareClipComponents_.back());
+        spareClipComponents_.pop_back();
+        clipComp->setClipId(clipId);
+        clipComp->snapTimeToGrid = snapTimeToGrid;
+        return clipComp;
+    }
 
-    // Get all clips
-    const auto& clips = ClipManager::getInstance().getClips();
+    auto clipComp = std::make_unique<ClipComponent>(clipId, this);
 
-    // Create a component for each clip that belongs to a visible track
-    for (const auto& clip : clips) {
-        // Check if clip's track is visible
-        auto it = std::find(visibleTrackIds_.begin(), visibleTrackIds_.end(), clip.trackId);
-        if (it == visibleTrackIds_.end()) {
-            continue;  // Track not visible
+    // Set up callbacks - all clip operations go through the undo system
+    clipComp->onClipMoved = [](ClipId id, double newStartTime) {
+        auto cmd = std::make_unique<MoveClipCommand>(id, newStartTime);
+        UndoManager::getInstance().executeCommand(std::move(cmd));
+    };
+
+    clipComp->onClipMovedToTrack = [](ClipId id, TrackId newTrackId) {
+        auto cmd = std::make_unique<MoveClipToTrackCommand>(id, newTrackId);
+        UndoManager::getInstance().executeCommand(std::move(cmd));
+    };
+
+    clipComp->onClipResized = [](ClipId id, double newLength, bool fromStart) {
+        auto cmd = std::make_unique<ResizeClipCommand>(id, newLength, fromStart);
+        UndoManager::getInstance().executeCommand(std::move(cmd));
+    };
+
+    clipComp->onClipSelected = [](ClipId id) {
+        SelectionManager::getInstance().selectClip(id);
+    };
+
+    clipComp->onClipDoubleClicked = [](ClipId id) {
+        // Toggle the appropriate editor in the bottom panel
+        const auto* clip = ClipManager::getInstance().getClip(id);
+        if (!clip)
+            return;
+
+        ClipManager::getInstance().setSelectedClip(id);
+
+        auto& panelController = daw::ui::PanelController::getInstance();
+
+        // Toggle: if bottom panel is already open, collapse it; otherwise expand
+        bool isCollapsed = panelController.getPanelState(daw::ui::PanelLocation::Bottom).collapsed;
+        if (isCollapsed) {
+            panelController.setCollapsed(daw::ui::PanelLocation::Bottom, false);
+
+            // Switch to the appropriate editor based on clip type
+            if (clip->type == ClipType::MIDI) {
+                panelController.setActiveTabByType(daw::ui::PanelLocation::Bottom,
+                                                   daw::ui::PanelContentType::PianoRoll);
+            } else {
+                panelController.setActiveTabByType(daw::ui::PanelLocation::Bottom,
+                                                   daw::ui::PanelContentType::WaveformEditor);
+            }
+        } else {
+            panelController.setCollapsed(daw::ui::PanelLocation::Bottom, true);
         }
+    };
 
-        auto clipComp = std::make_unique<ClipComponent>(clip.id, this);
+    clipComp->onClipSplit = [](ClipId id, double splitTime) {
+        auto cmd = std::make_unique<SplitClipCommand>(id, splitTime);
+        UndoManager::getInstance().executeCommand(std::move(cmd));
 
-        // Set up callbacks - all clip operations go through the undo system
-        clipComp->onClipMoved = [](ClipId id, double newStartTime) {
-            auto cmd = std::make_unique<MoveClipCommand>(id, newStartTime);
-            UndoManager::getInstance().executeCommand(std::move(cmd));
-        };
+        // Get the created clip ID for selection (we need to look it up)
+        // The split command stores the created ID, but we don't have access to it here
+        // For now, the selection will be handled by the command or we need to refactor
+    };
 
-        clipComp->onClipMovedToTrack = [](ClipId id, TrackId newTrackId) {
-            auto cmd = std::make_unique<MoveClipToTrackCommand>(id, newTrackId);
-            UndoManager::getInstance().executeCommand(std::move(cmd));
-        };
+    // Wire up grid snapping
+    clipComp->snapTimeToGrid = snapTimeToGrid;
 
-        clipComp->onClipResized = [](ClipId id, double newLength, bool fromStart) {
-            auto cmd = std::make_unique<ResizeClipCommand>(id, newLength, fromStart);
-            UndoManager::getInstance().executeCommand(std::move(cmd));
-        };
+    return clipComp;
+}
 
-        clipComp->onClipSelected = [](ClipId id) {
-            SelectionManager::getInstance().selectClip(id);
-        };
+juce::Rectangle<int> TrackContentPanel::getVisibleContentArea() const {
+    if (auto* viewport = findParentComponentOfClass<juce::Viewport>()) {
+        return viewport->getViewArea();
+    }
+    return getLocalBounds();
+}
 
-        clipComp->onClipDoubleClicked = [](ClipId id) {
-            // Toggle the appropriate editor in the bottom panel
-            const auto* clip = ClipManager::getInstance().getClip(id);
-            if (!clip)
-                return;
+juce::Rectangle<int> TrackContentPanel::getClipBounds(double startTime, double length,
+                                                      int trackIndex) const {
+    return getClipBounds(startTime, length, getTrackLaneArea(trackIndex));
+}
 
-            ClipManager::getInstance().setSelectedClip(id);
+juce::Rectangle<int> TrackContentPanel::getClipBounds(double startTime, double length,
+                                                      juce::Rectangle<int> trackArea) const {
+    // Calculate clip bounds
+    int clipX = timeToPixel(startTime);
+    int clipWidth = static_cast<int>(length * currentZoom);
 
-            auto& panelController = daw::ui::PanelController::getInstance();
+    // Inset from track edges
+    int clipY = trackArea.getY() + 2;
+    int clipHeight = trackArea.getHeight() - 4;
 
-            // Toggle: if bottom panel is already open, collapse it; otherwise expand
-            bool isCollapsed =
-                panelController.getPanelState(daw::ui::PanelLocation::Bottom).collapsed;
-            if (isCollapsed) {
-                panelController.setCollapsed(daw::ui::PanelLocation::Bottom, false);
+    return {clipX, clipY, juce::jmax(10, clipWidth), clipHeight};
+}
 
-                // Switch to the appropriate editor based on clip type
-                if (clip->type == ClipType::MIDI) {
-                    panelController.setActiveTabByType(daw::ui::PanelLocation::Bottom,
-                                                       daw::ui::PanelContentType::PianoRoll);
-                } else {
-                    panelController.setActiveTabByType(daw::ui::PanelLocation::Bottom,
-                                                       daw::ui::PanelContentType::WaveformEditor);
-                }
-            } else {
-                panelController.setCollapsed(daw::ui::PanelLocation::Bottom, true);
+std::vector<ClipId> TrackContentPanel::getClipsInArea(const juce::Rectangle<int>& area) const {
+    std::vector<ClipId> result;
+    if (area.isEmpty() || currentZoom <= 0.0) {
+        return result;
+    }
+
+    // Clips are drawn at least 10px wide, so look a little before the area's start
+    const double startTime = pixelToTime(area.getX()) - 10.0 / currentZoom;
+    const double endTime = pixelToTime(area.getRight()) + 1.0 / currentZoom;
+
+    const auto& clipManager = ClipManager::getInstance();
+    std::vector<ClipIntervalIndex::Interval> candidates;
+
+    // One walk down the lanes (rather than a getTrackLaneArea per lane and clip, each of
+    // which sums the lanes above it), stopping below the area
+    const size_t numLanes = juce::jmin(visibleTrackIds_.size(), trackLanes.size());
+    int laneY = 0;
+    for (size_t i = 0; i < numLanes && laneY < area.getBottom(); ++i) {
+        const int trackIndex = static_cast<int>(i);
+        const juce::Rectangle<int> laneArea(
+            0, laneY, getWidth(), static_cast<int>(trackLanes[i]->height * verticalZoom));
+        laneY += getTrackTotalHeight(trackIndex);
+        if (!laneArea.intersects(area)) {
+            continue;
+        }
+
+        candidates.clear();
+        clipManager.getTrackClipIndex(visibleTrackIds_[i]).query(startTime, endTime, candidates);
+        for (const auto& interval : candidates) {
+            auto bounds = getClipBounds(interval.start, interval.end - interval.start, laneArea);
+            if (bounds.intersects(area)) {
+                result.push_back(interval.id);
             }
-        };
+        }
+    }
+    return result;
+}
 
-        clipComp->onClipSplit = [](ClipId id, double splitTime) {
-            auto cmd = std::make_unique<SplitClipCommand>(id, splitTime);
-            UndoManager::getInstance().executeCommand(std::move(cmd));
+void TrackContentPanel::updateVisibleClipComponents() {
+    // A multi-clip drag moves the existing components; keep the set stable until it ends
+    if (isMovingMultipleClips_) {
+        updateClipComponentPositions();
+        return;
+    }
+
+    auto area = getVisibleContentArea().expanded(CLIP_VIRTUALISATION_MARGIN,
+                                                 CLIP_VIRTUALISATION_MARGIN);
+    auto wanted = getClipsInArea(area);
+    std::unordered_set<ClipId> wantedIds(wanted.begin(), wanted.end());
+
+    // Release components that left the range; a clip being dragged (or committing its drag,
+    // which is what triggers this) keeps its component
+    std::unordered_set<ClipId> presentIds;
+    for (auto it = clipComponents_.begin(); it != clipComponents_.end();) {
+        auto& clipComp = *it;
+        const ClipId clipId = clipComp->getClipId();
+        if (wantedIds.count(clipId) > 0 || clipComp->isCurrentlyDragging() ||
+            clipComp->isCommittingDrag()) {
+            presentIds.insert(clipId);
+            ++it;
+            continue;
+        }
 
-            // Get the created clip ID for selection (we need to look it up)
-            // The split command stores the created ID, but we don't have access to it here
-            // For now, the selection will be handled by the command or we need to refactor
-        };
+        clipComp->setVisible(false);
+        removeChildComponent(clipComp.get());
+        if (spareClipComponents_.size() < MAX_SPARE_CLIP_COMPONENTS) {
+            spareClipComponents_.push_back(std::move(clipComp));
+        }
+        it = clipComponents_.erase(it);
+    }
 
-        // Wire up grid snapping
-        clipComp->snapTimeToGrid = snapTimeToGrid;
+    // Create (or recycle) components for clips that came into range
+    for (ClipId clipId : wanted) {
+        if (presentIds.count(clipId) > 0) {
+            continue;
+        }
 
+        auto clipComp = createClipComponent(clipId);
+        clipComp->setMarqueeHighlighted(marqueePreviewClips_.count(clipId) > 0);
+        clipComp->setZoomPreview(zoomPreviewActive_);
         addAndMakeVisible(clipComp.get());
         clipComponents_.push_back(std::move(clipComp));
     }
@@ -977,17 +1133,7 @@ void TrackContentPanel::updateClipComponentPositions() {
         }
 
         int trackIndex = static_cast<int>(std::distance(visibleTrackIds_.begin(), it));
-        auto trackArea = getTrackLaneArea(trackIndex);
-
-        // Calculate clip bounds
-        int clipX = timeToPixel(clip->startTime);
-        int clipWidth = static_cast<int>(clip->length * currentZoom);
-
-        // Inset from track edges
-        int clipY = trackArea.getY() + 2;
-        int clipHeight = trackArea.getHeight() - 4;
-
-        clipComp->setBounds(clipX, clipY, juce::jmax(10, clipWidth), clipHeight);
+        clipComp->setBounds(getClipBounds(clip->startTime, clip->length, trackIndex));
         clipComp->setVisible(true);
     }
 }
@@ -1070,11 +1216,14 @@ void TrackContentPanel::updateMarqueeSelection(const juce::Point<int>& currentPo
     int x2 = juce::jmax(marqueeStartPoint_.x, currentPoint.x);
     int y2 = juce::jmax(marqueeStartPoint_.y, currentPoint.y);
 
+    auto previousRect = marqueeRect_;
     marqueeRect_ = juce::Rectangle<int>(x1, y1, x2 - x1, y2 - y1);
 
     // Update highlighted clips
     updateMarqueeHighlights();
-    repaint();
+
+    // Redraw only where the rectangle was or now is
+    repaint(previousRect.getUnion(marqueeRect_).expanded(1));
 }
 
 void TrackContentPanel::finishMarqueeSelection(bool addToSelection) {
@@ -1088,10 +1237,8 @@ void TrackContentPanel::finishMarqueeSelection(bool addToSelection) {
     auto clipsInRect = getClipsInRect(marqueeRect_);
 
     if (addToSelection) {
-        // Add to existing selection (Shift key held)
-        for (ClipId clipId : clipsInRect) {
-            SelectionManager::getInstance().addClipToSelection(clipId);
-        }
+        // Add to existing selection (Shift key held), as one change
+        SelectionManager::getInstance().addClipsToSelection(clipsInRect);
     } else {
         // Replace selection
         SelectionManager::getInstance().selectClips(clipsInRect);
@@ -1109,15 +1256,9 @@ void TrackContentPanel::finishMarqueeSelection(bool addToSelection) {
 
 std::unordered_set<ClipId> TrackContentPanel::getClipsInRect(
     const juce::Rectangle<int>& rect) const {
-    std::unordered_set<ClipId> result;
-
-    for (const auto& clipComp : clipComponents_) {
-        if (clipComp->getBounds().intersects(rect)) {
-            result.insert(clipComp->getClipId());
-        }
-    }
-
-    return result;
+    // From the index rather than the components, which only exist near the viewport
+    auto clips = getClipsInArea(rect);
+    return std::unordered_set<ClipId>(clips.begin(), clips.end());
 }
 
 void TrackContentPanel::paintMarqueeRect(juce::Graphics& g) {
@@ -1137,10 +1278,13 @@ void TrackContentPanel::paintMarqueeRect(juce::Graphics& g) {
 void TrackContentPanel::updateMarqueeHighlights() {
     auto clipsInRect = getClipsInRect(marqueeRect_);
 
-    // Update clip components
+    // Only components whose highlight changes since the last drag step
     for (auto& clipComp : clipComponents_) {
-        bool inMarquee = clipsInRect.find(clipComp->getClipId()) != clipsInRect.end();
-        clipComp->setMarqueeHighlighted(inMarquee);
+        const ClipId clipId = clipComp->getClipId();
+        const bool inMarquee = clipsInRect.count(clipId) > 0;
+        if (inMarquee != (marqueePreviewClips_.count(clipId) > 0)) {
+            clipComp->setMarqueeHighlighted(inMarquee);
+        }
     }
 
     marqueePreviewClips_ = clipsInRect;
@@ -1169,14 +1313,9 @@ bool TrackContentPanel::checkIfMarqueeNeeded(const juce::Point<int>& currentPoin
 
     juce::Rectangle<int> dragRect(x1, y1, width, height);
 
-    // Check if any clips are intersected by the drag rectangle
-    for (const auto& clipComp : clipComponents_) {
-        if (clipComp->getBounds().intersects(dragRect)) {
-            return true;  // Marquee selection needed
-        }
-    }
-
-    return false;  // Time selection (no clips crossed)
+    // Marquee selection if any clips are intersected by the drag rectangle, otherwise
+    // time selection
+    return !getClipsInArea(dragRect).empty();
 }
 
 // ============================================================================
@@ -1384,8 +1523,8 @@ void TrackContentPanel::finishMultiClipDrag() {
     multiClipDragInfos_.clear();
     multiClipDuplicateIds_.clear();
 
-    // Refresh positions from ClipManager
-    updateClipComponentPositions();
+    // Refresh positions from ClipManager (the drag may have moved clips into or out of range)
+    updateVisibleClipComponents();
 }
 
 void TrackContentPanel::cancelMultiClipDrag() {
@@ -1422,10 +1561,8 @@ void TrackContentPanel::captureClipsInTimeSelection() {
         return;
     }
 
-    // Get all clips and check if they overlap with the time selection
-    const auto& clips = ClipManager::getInstance().getClips();
-
-    for (const auto& clip : clips) {
+    // Check every clip's geometry for overlap with the time selection
+    for (const auto& clip : ClipManager::getInstance().getClipGeometry()) {
         // Check if clip's track is in the selection
         auto it = std::find(visibleTrackIds_.begin(), visibleTrackIds_.end(), clip.trackId);
         if (it == visibleTrackIds_.end()) {
@@ -1438,8 +1575,7 @@ void TrackContentPanel::captureClipsInTimeSelection() {
         }
 
         // Check if clip overlaps with selection time range
-        double clipEnd = clip.startTime + clip.length;
-        if (clip.startTime < selection.endTime && clipEnd > selection.startTime) {
+        if (clip.overlaps(selection.startTime, selection.endTime)) {
             // Clip overlaps with selection - capture it
             TimeSelectionClipInfo info;
             info.clipId = clip.id;
@@ -1499,7 +1635,7 @@ void TrackContentPanel::commitClipsInTimeSelection(double deltaTime) {
     clipsInTimeSelection_.clear();
 
     // Refresh positions from ClipManager
-    updateClipComponentPositions();
+    updateVisibleClipComponents();
 }
 
 // ============================================================================
@@ -1622,8 +1758,10 @@ bool TrackContentPanel::keyPressed(const juce::KeyPress& key) {
     // Cmd/Ctrl+A: Select all clips
     if (key == juce::KeyPress('a', juce::ModifierKeys::commandModifier, 0)) {
         std::unordered_set<ClipId> allClips;
-        for (const auto& clipComp : clipComponents_) {
-            allClips.insert(clipComp->getClipId());
+        for (auto trackId : visibleTrackIds_) {
+            for (auto clipId : ClipManager::getInstance().getClipsOnTrack(trackId)) {
+                allClips.insert(clipId);
+            }
         }
         selectionManager.selectClips(allClips);
         return true;
@@ -1739,8 +1877,7 @@ bool TrackContentPanel::keyPressed(const juce::KeyPress& key) {
 
         // If no selected clips at cursor, find ANY clip that contains the cursor
         if (clipsToSplit.empty()) {
-            const auto& allClips = ClipManager::getInstance().getClips();
-            for (const auto& clip : allClips) {
+            for (const auto& clip : ClipManager::getInstance().getClipGeometry()) {
                 if (clip.containsTime(splitTime)) {
                     clipsToSplit.push_back(clip.id);
                 }
@@ -2000,11 +2137,10 @@ void TrackContentPanel::updateAutomationLanePositions() {
 // =============================================================================
 
 bool TrackContentPanel::isInterestedInFileDrag(const juce::StringArray& files) {
-    // Accept if any file is an audio file
+    // Accept if any file is an audio or MIDI file
     for (const auto& file : files) {
-        if (file.endsWithIgnoreCase(".wav") || file.endsWithIgnoreCase(".aiff") ||
-            file.endsWithIgnoreCase(".aif") || file.endsWithIgnoreCase(".mp3") ||
-            file.endsWithIgnoreCase(".ogg") || file.endsWithIgnoreCase(".flac")) {
+        if (AudioFileImporter::isSupportedFile(juce::File(file)) ||
+            MidiFileImporter::isSupportedFile(juce::File(file))) {
             return true;
         }
     }
@@ -2037,6 +2173,29 @@ void TrackContentPanel::filesDropped(const juce::StringArray& files, int x, int
     double dropTime = pixelToTime(x);
     int trackIndex = getTrackIndexAtY(y);
 
+    // MIDI files get tracks of their own, wherever they're dropped: each file's tracks and
+    // notes are read in the background and created as one undo step
+    bool droppedMidi = false;
+    for (const auto& filePath : files) {
+        juce::File midiFile(filePath);
+        if (!MidiFileImporter::isSupportedFile(midiFile) || !midiFile.existsAsFile()) {
+            continue;
+        }
+        droppedMidi = true;
+        MidiFileImporter::getInstance().importFile(
+            midiFile, [dropTime, bpm = tempoBPM](const MidiFileImporter::Result& result) {
+                if (result.failed || result.tracks.empty()) {
+                    DBG("TrackContentPanel: No notes imported from "
+                        << result.source.getFullPathName());
+                    return;
+                }
+                applyBatch(MidiFileImporter::makeBatch(result, dropTime, bpm), "Import MIDI");
+            });
+    }
+    if (droppedMidi) {
+        return;
+    }
+
     if (trackIndex < 0 || trackIndex >= static_cast<int>(visibleTrackIds_.size())) {
         DBG("TrackContentPanel: Invalid drop track index");
         return;
@@ -2057,46 +2216,51 @@ void TrackContentPanel::filesDropped(const juce::StringArray& files, int x, int
         return;
     }
 
-    // Import audio files at drop position
-    auto& clipManager = ClipManager::getInstance();
-    double currentTime = dropTime;
-    int importedCount = 0;
-
-    juce::AudioFormatManager formatManager;
-    formatManager.registerBasicFormats();
-
+    juce::Array<juce::File> audioFiles;
     for (const auto& filePath : files) {
-        // Filter audio files only
-        if (!filePath.endsWithIgnoreCase(".wav") && !filePath.endsWithIgnoreCase(".aiff") &&
-            !filePath.endsWithIgnoreCase(".aif") && !filePath.endsWithIgnoreCase(".mp3") &&
-            !filePath.endsWithIgnoreCase(".ogg") && !filePath.endsWithIgnoreCase(".flac")) {
-            continue;
-        }
-
         juce::File audioFile(filePath);
-        if (!audioFile.existsAsFile())
-            continue;
-
-        // Read actual file duration
-        double fileDuration = 4.0;  // fallback if reader fails
-        if (auto reader = std::unique_ptr<juce::AudioFormatReader>(
-                formatManager.createReaderFor(audioFile))) {
-            fileDuration = static_cast<double>(reader->lengthInSamples) / reader->sampleRate;
+        if (AudioFileImporter::isSupportedFile(audioFile) && audioFile.existsAsFile()) {
+            audioFiles.add(audioFile);
         }
+    }
+    if (audioFiles.isEmpty()) {
+        return;
+    }
 
-        // Create clip via command
-        auto cmd = std::make_unique<CreateClipCommand>(ClipType::Audio, targetTrackId, currentTime,
-                                                       fileDuration, filePath.toStdString());
+    // Files are converted to the session rate and their peaks built in the background; the
+    // clips are created together, as one undo step, once every file is ready
+    AudioFileImporter::getInstance().importFiles(
+        audioFiles, ProjectManager::getInstance().getMediaFolder("Imported Audio"),
+        [targetTrackId, dropTime](const std::vector<AudioFileImporter::Result>& results) {
+            if (TrackManager::getInstance().getTrack(targetTrackId) == nullptr) {
+                return;  // Deleted while importing
+            }
 
-        UndoManager::getInstance().executeCommand(std::move(cmd));
+            const auto imported = std::count_if(results.begin(), results.end(),
+                                                [](const auto& result) { return !result.failed; });
+            if (imported == 0) {
+                return;
+            }
 
-        currentTime += fileDuration + 0.5;  // Space clips
-        importedCount++;
-    }
+            auto& undoManager = UndoManager::getInstance();
+            undoManager.beginCompoundOperation("Import Audio");
+            double currentTime = dropTime;
+            for (const auto& result : results) {
+                if (result.failed) {
+                    DBG("TrackContentPanel: Could not import " << result.source.getFullPathName());
+                    continue;
+                }
+                // The import detected the tempo; keep it so matching the clip needs no lookup
+                TempoCache::getInstance().addAnalysis(result.file, result.tempo);
+                undoManager.executeCommand(std::make_unique<CreateClipCommand>(
+                    ClipType::Audio, targetTrackId, currentTime, result.lengthSeconds,
+                    result.file.getFullPathName().toStdString()));
+                currentTime += result.lengthSeconds + 0.5;  // Space clips
+            }
+            undoManager.endCompoundOperation();
 
-    if (importedCount > 0) {
-        DBG("TrackContentPanel: Imported " << importedCount << " audio files");
-    }
+            DBG("TrackContentPanel: Imported " << static_cast<int>(imported) << " audio files");
+        });
 }
 
 }  // namespace magda
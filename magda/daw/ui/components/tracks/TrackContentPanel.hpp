@@ -2,6 +2,7 @@
 
 #include <juce_gui_basics/juce_gui_basics.h>
 
+#include <functional>
 #include <memory>
 #include <set>
 #include <unordered_map>
@@ -15,6 +16,7 @@
 #include "core/ClipTypes.hpp"
 #include "core/TrackManager.hpp"
 #include "core/ViewModeController.hpp"
+#include "profiling/UIFrameProfiler.hpp"
 
 namespace magda {
 
@@ -25,7 +27,6 @@ class AutomationLaneComponent;
 
 class TrackContentPanel : public juce::Component,
                           public juce::FileDragAndDropTarget,
-                          public TimelineStateListener,
                           public TrackManagerListener,
                           public ClipManagerListener,
                           public AutomationManagerListener,
@@ -36,16 +37,22 @@ class TrackContentPanel : public juce::Component,
     static constexpr int MIN_TRACK_HEIGHT = 40;
     static constexpr int MAX_TRACK_HEIGHT = 200;
 
+    // Clip virtualisation: extra pixels around the viewport that keep components alive, and
+    // how many released components are kept for reuse
+    static constexpr int CLIP_VIRTUALISATION_MARGIN = 512;
+    static constexpr int MAX_SPARE_CLIP_COMPONENTS = 64;
+
     TrackContentPanel();
     ~TrackContentPanel() override;
 
     void paint(juce::Graphics& g) override;
     void paintOverChildren(juce::Graphics& g) override;
     void resized() override;
+    void moved() override;  // Viewport scrolled
 
-    // TimelineStateListener implementation
-    void timelineStateChanged(const TimelineState& state) override;
-    void zoomStateChanged(const TimelineState& state) override;
+    // Timeline state handlers, subscribed per change in setController()
+    void timelineStateChanged(const TimelineState& state);
+    void zoomStateChanged(const TimelineState& state);
 
     // TrackManagerListener implementation
     void tracksChanged() override;
@@ -147,6 +154,9 @@ class TrackContentPanel : public juce::Component,
   private:
     // Controller reference (not owned)
     TimelineController* timelineController = nullptr;
+    std::vector<Subscription> timelineSubscriptions_;
+
+    UIFrameProfiler::Source paintProfile_{"TrackContentPanel"};  // paint() to paintOverChildren()
 
     // Layout constants - use shared constant from LayoutConfig
     static constexpr int LEFT_PADDING = LayoutConfig::TIMELINE_LEFT_PADDING;
@@ -177,6 +187,7 @@ class TrackContentPanel : public juce::Component,
     void paintTrackLane(juce::Graphics& g, const TrackLane& lane, juce::Rectangle<int> area,
                         bool isSelected, int trackIndex);
     void paintEditCursor(juce::Graphics& g);
+    juce::Rectangle<int> getEditCursorBounds() const;  // Area the blinking cursor covers
     juce::Rectangle<int> getTrackLaneArea(int trackIndex) const;
 
     // Mouse handling
@@ -225,14 +236,43 @@ class TrackContentPanel : public juce::Component,
     // Timer callback for edit cursor blinking
     void timerCallback() override;
 
+    // Zoom gestures: clips stretch their cached tiles until the zoom has been still for
+    // ZOOM_SETTLE_MS, then render at the zoom it settled on
+    static constexpr int ZOOM_SETTLE_MS = 150;
+    struct ZoomSettleTimer : juce::Timer {
+        std::function<void()> onSettled;
+        void timerCallback() override {
+            stopTimer();
+            if (onSettled) {
+                onSettled();
+            }
+        }
+    };
+    ZoomSettleTimer zoomSettleTimer_;
+    bool zoomPreviewActive_ = false;
+    void beginZoomPreview();
+    void endZoomPreview();
+
     // Helper to check if a position is in a selectable area
     bool isInSelectableArea(int x, int y) const;
     bool isOnExistingSelection(int x, int y) const;
 
     // Clip management
+    //
+    // Components exist only for clips near the viewport (plus any being dragged); the rest
+    // are found through ClipManager's per-track interval index and get a component,
+    // recycled from spareClipComponents_ when possible, once they scroll into range.
     std::vector<std::unique_ptr<ClipComponent>> clipComponents_;
+    std::vector<std::unique_ptr<ClipComponent>> spareClipComponents_;
     void rebuildClipComponents();
+    void updateVisibleClipComponents();
+    std::unique_ptr<ClipComponent> createClipComponent(ClipId clipId);
     void updateClipComponentPositions();
+    juce::Rectangle<int> getVisibleContentArea() const;
+    juce::Rectangle<int> getClipBounds(double startTime, double length, int trackIndex) const;
+    juce::Rectangle<int> getClipBounds(double startTime, double length,
+                                       juce::Rectangle<int> trackArea) const;
+    std::vector<ClipId> getClipsInArea(const juce::Rectangle<int>& area) const;
     void createClipFromTimeSelection();  // Called on double-click with selection
     ClipComponent* getClipComponentAt(int x, int y) const;
 
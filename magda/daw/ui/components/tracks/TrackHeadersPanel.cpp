@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <cmath>
 #include <functional>
+#include <initializer_list>
 
 #include "../../../audio/AudioBridge.hpp"
 #include "../../../audio/MidiBridge.hpp"
@@ -271,7 +272,7 @@ TrackHeadersPanel::TrackHeader::TrackHeader(const juce::String& trackName) : nam
 
     // Meter component (stereo level display)
     meterComponent = std::make_unique<TrackMeter>();
-    // Levels will be set by timerCallback reading from AudioBridge
+    // Levels will be set by updateMeters reading from AudioBridge
 
     // MIDI activity indicator
     midiIndicator = std::make_unique<MidiActivityIndicator>();
@@ -293,27 +294,12 @@ TrackHeadersPanel::TrackHeadersPanel(AudioEngine* audioEngine) : audioEngine_(au
     // Register as AutomationManager listener
     AutomationManager::getInstance().addListener(this);
 
-    // Set up MIDI activity monitoring
-    if (audioEngine_) {
-        auto* midiBridge = audioEngine_->getMidiBridge();
-        if (midiBridge) {
-            midiBridge->onNoteEvent = [this](TrackId trackId, const MidiNoteEvent& event) {
-                // Find the track header and trigger MIDI activity
-                for (auto& header : trackHeaders) {
-                    if (header->trackId == trackId) {
-                        header->midiActivity = 1.0f;  // Full activity on note event
-                        break;
-                    }
-                }
-            };
-        }
-    }
-
     // Build tracks from TrackManager
-    tracksChanged();
+    rebuildTrackHeaders();
 
-    // Start timer for metering updates (30 FPS)
-    startTimerHz(30);
+    // Meters tick until the bridge is up and silent; MIDI devices are polled every 2 s
+    frameClient_.setActive(true);
+    startTimer(2000);
 
     // Refresh MIDI selectors immediately (Tracktion Engine loads devices async)
     refreshMidiSelectors();
@@ -321,60 +307,86 @@ TrackHeadersPanel::TrackHeadersPanel(AudioEngine* audioEngine) : audioEngine_(au
 
 TrackHeadersPanel::~TrackHeadersPanel() {
     stopTimer();
+    noteOnSubscription_.reset();
+    meterActivitySubscription_.reset();
     TrackManager::getInstance().removeListener(this);
     ViewModeController::getInstance().removeListener(this);
     AutomationManager::getInstance().removeListener(this);
 }
 
 void TrackHeadersPanel::timerCallback() {
-    // Get metering data from AudioBridge (30 FPS timer)
+    // Check if MIDI device count has changed (polled every 2 seconds)
     if (!audioEngine_)
         return;
 
+    auto* midiBridge = audioEngine_->getMidiBridge();
+    if (midiBridge) {
+        auto midiInputs = midiBridge->getAvailableMidiInputs();
+        static size_t lastMidiDeviceCount = 0;
+        if (midiInputs.size() != lastMidiDeviceCount) {
+            lastMidiDeviceCount = midiInputs.size();
+            refreshMidiSelectors();
+        }
+    }
+}
+
+void TrackHeadersPanel::updateMeters() {
+    // Get metering data from AudioBridge (30 FPS frame client)
+    if (!audioEngine_) {
+        frameClient_.setActive(false);
+        return;
+    }
+
     auto* teWrapper = dynamic_cast<TracktionEngineWrapper*>(audioEngine_);
-    if (!teWrapper)
+    if (!teWrapper) {
+        frameClient_.setActive(false);
         return;
+    }
 
     auto* bridge = teWrapper->getAudioBridge();
     if (!bridge)
-        return;
+        return;  // Keep ticking until the bridge exists and can wake us
 
     auto& meteringBuffer = bridge->getMeteringBuffer();
 
+    // Note-ons arrive through the bridge's event queue, already on the message thread
+    if (!noteOnSubscription_) {
+        noteOnSubscription_ = bridge->subscribeToEvents(
+            AudioEvent::Type::NoteOn, [this](const AudioEvent& event) {
+                for (auto& header : trackHeaders) {
+                    if (header->trackId == event.trackId) {
+                        header->midiActivity = 1.0f;  // Full activity on note event
+                        frameClient_.setActive(true);
+                        break;
+                    }
+                }
+            });
+    }
+    if (!meterActivitySubscription_) {
+        meterActivitySubscription_ = bridge->subscribeToEvents(
+            AudioEvent::Type::MeterActivity,
+            [this](const AudioEvent&) { frameClient_.setActive(true); });
+    }
+
     // Decay rate for MIDI activity (fade out over time)
     const float midiDecayRate = 0.92f;  // Per frame decay (fast fade)
 
-    // Check for MIDI device changes every 60 frames (2 seconds at 30 FPS)
-    static int midiDeviceCheckCounter = 0;
-    if (++midiDeviceCheckCounter >= 60) {
-        midiDeviceCheckCounter = 0;
-
-        // Check if MIDI device count has changed
-        auto* midiBridge = audioEngine_->getMidiBridge();
-        if (midiBridge) {
-            auto midiInputs = midiBridge->getAvailableMidiInputs();
-            static size_t lastMidiDeviceCount = 0;
-            if (midiInputs.size() != lastMidiDeviceCount) {
-                lastMidiDeviceCount = midiInputs.size();
-                refreshMidiSelectors();
-            }
-        }
-    }
-
-    // Update meters and MIDI activity for all visible tracks
+    // Update meters and MIDI activity for the headers on screen
+    bool animating = false;
     for (auto& header : trackHeaders) {
+        // Off-screen headers have nothing to draw into
+        if (!header->onScreen)
+            continue;
+
         // Update audio meters
         MeterData data;
-        if (meteringBuffer.popLevels(header->trackId, data)) {
+        if (meteringBuffer.readLevels(header->trackId, data)) {
             if (header->meterComponent) {
                 static_cast<TrackMeter*>(header->meterComponent.get())
                     ->setLevels(data.peakL, data.peakR);
             }
-        }
-
-        // Check for MIDI activity from audio thread
-        if (bridge->consumeMidiActivity(header->trackId)) {
-            header->midiActivity = 1.0f;  // Trigger full brightness
+            animating = animating || data.peakL > MeteringBuffer::kSilenceLevel ||
+                        data.peakR > MeteringBuffer::kSilenceLevel;
         }
 
         // Decay MIDI activity indicator
@@ -384,13 +396,18 @@ void TrackHeadersPanel::timerCallback() {
                 static_cast<MidiActivityIndicator*>(header->midiIndicator.get())
                     ->setActivity(header->midiActivity);
             }
+            animating = true;
         }
     }
+
+    // Idle once everything has settled; MeterActivity and note-ons wake the meters again
+    if (!animating)
+        frameClient_.setActive(false);
 }
 
 void TrackHeadersPanel::viewModeChanged(ViewMode mode, const AudioEngineProfile& /*profile*/) {
     currentViewMode_ = mode;
-    tracksChanged();  // Rebuild with new visibility settings
+    rebuildTrackHeaders();  // Reconcile with new visibility settings
 }
 
 void TrackHeadersPanel::populateAudioInputOptions(RoutingSelector* selector) {
@@ -750,18 +767,41 @@ void TrackHeadersPanel::setupMidiCallbacks(TrackHeader& header, TrackId trackId)
 }
 
 void TrackHeadersPanel::tracksChanged() {
-    // Clear existing track headers
+    // Headers are reconciled from trackChangesCoalesced(), once per burst of edits
+}
+
+void TrackHeadersPanel::trackChangesCoalesced(const TrackChangeSet& changes) {
+    // Only a change to which tracks have headers, their order or nesting needs a
+    // reconcile; property edits arrive through trackPropertyChanged()
+    bool needsRebuild =
+        changes.reset || changes.reordered || !changes.added.empty() || !changes.removed.empty();
+    const auto structural =
+        TrackDirty::Visibility | TrackDirty::Layout | TrackDirty::Hierarchy | TrackDirty::Type;
+    for (const auto& [trackId, dirty] : changes.modified) {
+        if (hasFlag(dirty, structural)) {
+            needsRebuild = true;
+            break;
+        }
+    }
+
+    if (needsRebuild) {
+        rebuildTrackHeaders();
+    }
+}
+
+void TrackHeadersPanel::rebuildTrackHeaders() {
+    // Reconcile by track ID: headers for tracks still shown are kept (and reordered), so
+    // adding or removing a track only builds or destroys that track's header
+    const TrackId selectedTrackId =
+        selectedTrackIndex >= 0 && selectedTrackIndex < static_cast<int>(visibleTrackIds_.size())
+            ? visibleTrackIds_[static_cast<size_t>(selectedTrackIndex)]
+            : INVALID_TRACK_ID;
+
+    std::unordered_map<TrackId, std::unique_ptr<TrackHeader>> existing;
+    existing.reserve(trackHeaders.size());
     for (auto& header : trackHeaders) {
-        removeChildComponent(header->nameLabel.get());
-        removeChildComponent(header->muteButton.get());
-        removeChildComponent(header->soloButton.get());
-        removeChildComponent(header->volumeLabel.get());
-        removeChildComponent(header->panLabel.get());
-        removeChildComponent(header->collapseButton.get());
-        removeChildComponent(header->audioInSelector.get());
-        removeChildComponent(header->audioOutSelector.get());
-        removeChildComponent(header->midiInSelector.get());
-        removeChildComponent(header->midiOutSelector.get());
+        const auto trackId = header->trackId;
+        existing.emplace(trackId, std::move(header));
     }
     trackHeaders.clear();
     visibleTrackIds_.clear();
@@ -777,55 +817,24 @@ void TrackHeadersPanel::tracksChanged() {
         if (!track || !track->isVisibleIn(currentViewMode_))
             return;
 
-        visibleTrackIds_.push_back(trackId);
+        std::unique_ptr<TrackHeader> header;
+        if (const auto it = existing.find(trackId); it != existing.end()) {
+            header = std::move(it->second);
+            existing.erase(it);
+        } else {
+            header = createTrackHeader(*track);
+        }
 
-        auto header = std::make_unique<TrackHeader>(track->name);
-        header->trackId = trackId;
         header->depth = depth;
-        header->isGroup = track->isGroup();
-        header->isCollapsed = track->isCollapsedIn(currentViewMode_);
-        header->muted = track->muted;
-        header->solo = track->soloed;
-        header->volume = track->volume;
-        header->pan = track->pan;
 
         // Use height from view settings
         header->height = track->viewSettings.getHeight(currentViewMode_);
+        updateHeaderFromTrack(*header, *track);
 
-        // Set up callbacks with track ID (not index)
-        setupTrackHeaderWithId(*header, trackId);
-
-        // Add components
-        addAndMakeVisible(*header->nameLabel);
-        addAndMakeVisible(*header->muteButton);
-        addAndMakeVisible(*header->soloButton);
-        addAndMakeVisible(*header->recordButton);
-        addAndMakeVisible(*header->automationButton);
-        addAndMakeVisible(*header->volumeLabel);
-        addAndMakeVisible(*header->panLabel);
-        addAndMakeVisible(*header->audioInSelector);
-        addAndMakeVisible(*header->audioOutSelector);
-        addAndMakeVisible(*header->midiInSelector);
-        addAndMakeVisible(*header->midiOutSelector);
-        for (auto& sendLabel : header->sendLabels) {
-            addAndMakeVisible(*sendLabel);
-        }
-        addAndMakeVisible(*header->meterComponent);
-        addAndMakeVisible(*header->midiIndicator);
-
-        // Add collapse button for groups
-        if (header->isGroup) {
-            header->collapseButton->setButtonText(header->isCollapsed ? "▶" : "▼");
-            header->collapseButton->onClick = [this, trackId]() { handleCollapseToggle(trackId); };
-            addAndMakeVisible(*header->collapseButton);
-        }
-
-        // Update UI state
-        header->muteButton->setToggleState(track->muted, juce::dontSendNotification);
-        header->soloButton->setToggleState(track->soloed, juce::dontSendNotification);
-        header->volumeLabel->setValue(gainToDb(track->volume), juce::dontSendNotification);
-        header->panLabel->setValue(track->pan, juce::dontSendNotification);
-
+        if (trackId == selectedTrackId) {
+            selectedTrackIndex = static_cast<int>(trackHeaders.size());
+        }
+        visibleTrackIds_.push_back(trackId);
         trackHeaders.push_back(std::move(header));
 
         // Add children if group is not collapsed
@@ -841,6 +850,10 @@ void TrackHeadersPanel::tracksChanged() {
         addTrackRecursive(trackId, 0);
     }
 
+    // Headers left over belong to removed or hidden tracks; their components leave the
+    // panel as they are destroyed
+    existing.clear();
+
     // Sync automation lane visibility from AutomationManager
     syncAutomationLaneVisibility();
 
@@ -848,6 +861,67 @@ void TrackHeadersPanel::tracksChanged() {
     repaint();
 }
 
+std::unique_ptr<TrackHeadersPanel::TrackHeader> TrackHeadersPanel::createTrackHeader(
+    const TrackInfo& track) {
+    const auto trackId = track.id;
+    auto header = std::make_unique<TrackHeader>(track.name);
+    header->trackId = trackId;
+
+    // Set up callbacks with track ID (not index)
+    setupTrackHeaderWithId(*header, trackId);
+
+    // Add components
+    addAndMakeVisible(*header->nameLabel);
+    addAndMakeVisible(*header->muteButton);
+    addAndMakeVisible(*header->soloButton);
+    addAndMakeVisible(*header->recordButton);
+    addAndMakeVisible(*header->automationButton);
+    addAndMakeVisible(*header->volumeLabel);
+    addAndMakeVisible(*header->panLabel);
+    addAndMakeVisible(*header->audioInSelector);
+    addAndMakeVisible(*header->audioOutSelector);
+    addAndMakeVisible(*header->midiInSelector);
+    addAndMakeVisible(*header->midiOutSelector);
+    for (auto& sendLabel : header->sendLabels) {
+        addAndMakeVisible(*sendLabel);
+    }
+    addAndMakeVisible(*header->meterComponent);
+    addAndMakeVisible(*header->midiIndicator);
+
+    // Collapse button for groups (a kept header's track can become one; layout hides it
+    // otherwise)
+    header->collapseButton->onClick = [this, trackId]() { handleCollapseToggle(trackId); };
+    addChildComponent(*header->collapseButton);
+
+    header->onScreen = true;  // Everything was added visible; layout hides it if off screen
+    return header;
+}
+
+void TrackHeadersPanel::updateHeaderFromTrack(TrackHeader& header, const TrackInfo& track) {
+    header.name = track.name;
+    header.isGroup = track.isGroup();
+    header.isCollapsed = track.isCollapsedIn(currentViewMode_);
+    header.muted = track.muted;
+    header.solo = track.soloed;
+    header.freezeState = track.freezeState;
+    header.volume = track.volume;
+    header.pan = track.pan;
+
+    header.nameLabel->setText(track.name, juce::dontSendNotification);
+    header.nameLabel->setColour(
+        juce::Label::textColourId,
+        DarkTheme::getColour(track.isFrozen() ? DarkTheme::ACCENT_CYAN : DarkTheme::TEXT_PRIMARY));
+    if (header.isGroup) {
+        header.collapseButton->setButtonText(header.isCollapsed ? "▶" : "▼");
+    }
+
+    // Update UI state
+    header.muteButton->setToggleState(track.muted, juce::dontSendNotification);
+    header.soloButton->setToggleState(track.soloed, juce::dontSendNotification);
+    header.volumeLabel->setValue(gainToDb(track.volume), juce::dontSendNotification);
+    header.panLabel->setValue(track.pan, juce::dontSendNotification);
+}
+
 void TrackHeadersPanel::trackPropertyChanged(int trackId) {
     const auto* track = TrackManager::getInstance().getTrack(trackId);
     if (!track)
@@ -864,22 +938,12 @@ void TrackHeadersPanel::trackPropertyChanged(int trackId) {
 
     if (index >= 0 && index < static_cast<int>(trackHeaders.size())) {
         auto& header = *trackHeaders[index];
-        header.name = track->name;
-        header.muted = track->muted;
-        header.solo = track->soloed;
-        header.volume = track->volume;
-        header.pan = track->pan;
 
         // Note: Don't update height here - height should only change via:
-        // 1. tracksChanged() (initial load)
+        // 1. rebuildTrackHeaders() (initial load, structural changes)
         // 2. setTrackHeight() (user resize)
         // Updating height on every property change would reset user's resize
-
-        header.nameLabel->setText(track->name, juce::dontSendNotification);
-        header.muteButton->setToggleState(track->muted, juce::dontSendNotification);
-        header.soloButton->setToggleState(track->soloed, juce::dontSendNotification);
-        header.volumeLabel->setValue(gainToDb(track->volume), juce::dontSendNotification);
-        header.panLabel->setValue(track->pan, juce::dontSendNotification);
+        updateHeaderFromTrack(header, *track);
 
         // Update MIDI routing selector to match track state
         updateMidiRoutingSelectorFromTrack(header, track);
@@ -1356,6 +1420,18 @@ void TrackHeadersPanel::paintTrackHeader(juce::Graphics& g, const TrackHeader& h
         g.setColour(DarkTheme::getColour(DarkTheme::ACCENT_ORANGE).withAlpha(0.7f));
         g.fillRect(bgArea.getX(), bgArea.getY(), 3, bgArea.getHeight());
     }
+
+    // Freeze: cyan tint and strip on the right, faint while the render runs
+    if (header.freezeState != FreezeState::Unfrozen) {
+        const bool frozen = header.freezeState == FreezeState::Frozen;
+        const auto freezeColour = DarkTheme::getColour(DarkTheme::ACCENT_CYAN);
+        if (frozen) {
+            g.setColour(freezeColour.withAlpha(0.08f));
+            g.fillRect(bgArea.reduced(1));
+        }
+        g.setColour(freezeColour.withAlpha(frozen ? 0.8f : 0.35f));
+        g.fillRect(bgArea.getRight() - 3, bgArea.getY(), 3, bgArea.getHeight());
+    }
 }
 
 void TrackHeadersPanel::paintResizeHandle(juce::Graphics& g, juce::Rectangle<int> area) {
@@ -1404,198 +1480,264 @@ bool TrackHeadersPanel::isResizeHandleArea(const juce::Point<int>& point, int& t
     return false;
 }
 
+juce::Rectangle<int> TrackHeadersPanel::getVisibleHeaderArea() const {
+    // Headers a little beyond the viewport stay live so a short scroll shows no gaps
+    if (auto* viewport = findParentComponentOfClass<juce::Viewport>()) {
+        return viewport->getViewArea().expanded(0, OFFSCREEN_MARGIN);
+    }
+    return getLocalBounds();
+}
+
+void TrackHeadersPanel::setHeaderOnScreen(TrackHeader& header, bool onScreen) {
+    header.onScreen = onScreen;
+    if (onScreen) {
+        // The rest is shown (or not) by layoutTrackHeader() for the header's height
+        header.nameLabel->setVisible(true);
+        header.muteButton->setVisible(true);
+        header.soloButton->setVisible(true);
+        return;
+    }
+
+    for (auto* component : std::initializer_list<juce::Component*>{
+             header.nameLabel.get(), header.muteButton.get(), header.soloButton.get(),
+             header.recordButton.get(), header.volumeLabel.get(), header.panLabel.get(),
+             header.collapseButton.get(), header.automationButton.get(),
+             header.audioInSelector.get(), header.audioOutSelector.get(),
+             header.midiInSelector.get(), header.midiOutSelector.get(),
+             header.meterComponent.get(), header.midiIndicator.get()}) {
+        component->setVisible(false);
+    }
+    for (auto& sendLabel : header.sendLabels) {
+        sendLabel->setVisible(false);
+    }
+}
+
 void TrackHeadersPanel::updateTrackHeaderLayout() {
+    // Off-screen headers keep their components hidden and are laid out once they scroll in
+    const auto visibleArea = getVisibleHeaderArea();
     for (size_t i = 0; i < trackHeaders.size(); ++i) {
         auto& header = *trackHeaders[i];
-        auto headerArea = getTrackHeaderArea(static_cast<int>(i));
+        const auto headerArea = getTrackHeaderArea(static_cast<int>(i));
+        const bool onScreen = !headerArea.isEmpty() && headerArea.intersects(visibleArea);
+        if (onScreen != header.onScreen) {
+            setHeaderOnScreen(header, onScreen);
+        }
+        if (onScreen) {
+            layoutTrackHeader(header, headerArea);
+        }
+    }
+}
 
-        if (!headerArea.isEmpty()) {
-            // Dynamic layout based on track height
-            // Large (>80px): name, M R fader pan, S input, meters
-            // Medium (60-80px): name + M R S, fader pan, meters
-            // Small (<60px): name + M S R only, meters
-
-            const int meterWidth = 20;
-            const int midiIndicatorWidth = 12;
-            const int meterPadding = 4;
-            const int trackHeight = headerArea.getHeight();
-
-            // Extract meters area on the right (full height)
-            auto workArea = headerArea.reduced(4);
-            auto meterArea = workArea.removeFromRight(meterWidth);
-            workArea.removeFromRight(2);
-
-            // MIDI indicator to the left of audio meters
-            auto midiArea = workArea.removeFromRight(midiIndicatorWidth);
-            workArea.removeFromRight(meterPadding);
-
-            // Audio meter spans full track height
-            header.meterComponent->setBounds(meterArea);
-            header.meterComponent->setVisible(true);
-
-            // MIDI indicator spans full track height
-            header.midiIndicator->setBounds(midiArea);
-            header.midiIndicator->setVisible(header.midiInEnabled);
-            header.midiIndicator->toFront(false);  // Ensure it's on top
-
-            // Apply indentation based on depth for TCP area
-            int indent = header.depth * INDENT_WIDTH;
-            auto tcpArea = workArea.withTrimmedLeft(indent);
-
-            // Constants
-            const int nameRowHeight = 18;
-            const int rowHeight = 16;
-            const int smallButtonSize = 16;
-            const int spacing = 2;
-
-            // Top row: collapse button (if group) + name label
-            auto topRow = tcpArea.removeFromTop(nameRowHeight);
-
-            if (header.isGroup) {
-                header.collapseButton->setBounds(topRow.removeFromLeft(COLLAPSE_BUTTON_SIZE));
-                topRow.removeFromLeft(2);
-                header.collapseButton->setVisible(true);
-            } else {
-                header.collapseButton->setVisible(false);
+void TrackHeadersPanel::updateOnScreenHeaders() {
+    const auto visibleArea = getVisibleHeaderArea();
+    for (size_t i = 0; i < trackHeaders.size(); ++i) {
+        auto& header = *trackHeaders[i];
+        const auto headerArea = getTrackHeaderArea(static_cast<int>(i));
+        const bool onScreen = !headerArea.isEmpty() && headerArea.intersects(visibleArea);
+        if (onScreen != header.onScreen) {
+            setHeaderOnScreen(header, onScreen);
+            if (onScreen) {
+                layoutTrackHeader(header, headerArea);
             }
+        }
+    }
+}
 
-            header.nameLabel->setBounds(topRow);
-            tcpArea.removeFromTop(3);
-
-            // Helper to hide all routing selectors and sends
-            auto hideAllRouting = [&]() {
-                header.audioInSelector->setVisible(false);
-                header.audioOutSelector->setVisible(false);
-                header.midiInSelector->setVisible(false);
-                header.midiOutSelector->setVisible(false);
-                for (auto& sendLabel : header.sendLabels) {
-                    sendLabel->setVisible(false);
-                }
-            };
-
-            // Label widths for draggable values
-            const int volumeLabelWidth = 42;  // "-60.0" or "+6.0"
-            const int panLabelWidth = 28;     // "L100" or "R100" or "C"
-            const int sendLabelWidth = 28;    // "-inf" or "-12"
-
-            if (trackHeight >= 100) {
-                // LARGE LAYOUT - evenly distributed:
-                // Order: M S R, Audio routing, MIDI routing, Volume/Pan/Sends
-                const int dropdownWidth = 55;
-                const int buttonGap = 2;
-                const int contentRowHeight = rowHeight - 2;
-
-                // Always show routing rows (4 rows total: buttons, audio, MIDI, volume/pan)
-                int numRows = 4;
-
-                // Calculate even spacing between rows
-                int totalContentHeight = numRows * contentRowHeight;
-                int availableSpace = tcpArea.getHeight() - totalContentHeight;
-                int rowGap = numRows > 1 ? std::max(2, availableSpace / (numRows - 1)) : 2;
-
-                // M S R A buttons row (always visible, now on top)
-                auto buttonsRow = tcpArea.removeFromTop(contentRowHeight);
-                header.muteButton->setBounds(buttonsRow.removeFromLeft(smallButtonSize));
-                buttonsRow.removeFromLeft(buttonGap);
-                header.soloButton->setBounds(buttonsRow.removeFromLeft(smallButtonSize));
-                buttonsRow.removeFromLeft(buttonGap);
-                header.recordButton->setBounds(buttonsRow.removeFromLeft(smallButtonSize));
-                header.recordButton->setVisible(true);
-                buttonsRow.removeFromLeft(buttonGap);
-                header.automationButton->setBounds(buttonsRow.removeFromLeft(smallButtonSize));
-                header.automationButton->setVisible(true);
-
-                tcpArea.removeFromTop(rowGap);
-
-                // Audio routing row (always visible)
-                auto audioRow = tcpArea.removeFromTop(contentRowHeight);
-                header.audioInSelector->setBounds(audioRow.removeFromLeft(dropdownWidth));
-                header.audioInSelector->setVisible(true);
-                audioRow.removeFromLeft(spacing);
-                header.audioOutSelector->setBounds(audioRow.removeFromLeft(dropdownWidth));
-                header.audioOutSelector->setVisible(true);
-                tcpArea.removeFromTop(rowGap);
-
-                // MIDI routing row (always visible)
-                auto midiRow = tcpArea.removeFromTop(contentRowHeight);
-                header.midiInSelector->setBounds(midiRow.removeFromLeft(dropdownWidth));
-                header.midiInSelector->setVisible(true);
-                midiRow.removeFromLeft(spacing);
-                header.midiOutSelector->setBounds(midiRow.removeFromLeft(dropdownWidth));
-                header.midiOutSelector->setVisible(true);
-                tcpArea.removeFromTop(rowGap);
-
-                // Volume, Pan, Sends row (always visible)
-                auto mixRow = tcpArea.removeFromTop(contentRowHeight);
-
-                header.volumeLabel->setBounds(mixRow.removeFromLeft(volumeLabelWidth));
-                header.volumeLabel->setVisible(true);
-                mixRow.removeFromLeft(spacing);
+void TrackHeadersPanel::moved() {
+    // Viewport scrolled
+    updateOnScreenHeaders();
+}
 
-                header.panLabel->setBounds(mixRow.removeFromLeft(panLabelWidth));
-                header.panLabel->setVisible(true);
-                mixRow.removeFromLeft(spacing);
+void TrackHeadersPanel::parentSizeChanged() {
+    // Viewport resized: more or fewer headers fit
+    updateOnScreenHeaders();
+}
 
-                // Sends on same row
-                for (auto& sendLabel : header.sendLabels) {
-                    if (mixRow.getWidth() >= sendLabelWidth) {
-                        sendLabel->setBounds(mixRow.removeFromLeft(sendLabelWidth));
-                        sendLabel->setVisible(true);
-                        mixRow.removeFromLeft(spacing);
-                    } else {
-                        sendLabel->setVisible(false);
-                    }
-                }
+void TrackHeadersPanel::layoutTrackHeader(TrackHeader& header, juce::Rectangle<int> headerArea) {
+    // Dynamic layout based on track height
+    // Large (>80px): name, M R fader pan, S input, meters
+    // Medium (60-80px): name + M R S, fader pan, meters
+    // Small (<60px): name + M S R only, meters
+
+    const int meterWidth = 20;
+    const int midiIndicatorWidth = 12;
+    const int meterPadding = 4;
+    const int trackHeight = headerArea.getHeight();
+
+    // Extract meters area on the right (full height)
+    auto workArea = headerArea.reduced(4);
+    auto meterArea = workArea.removeFromRight(meterWidth);
+    workArea.removeFromRight(2);
 
-            } else if (trackHeight >= 55) {
-                // MEDIUM LAYOUT: Buttons + volume/pan only
-                // Row 1: M S R A [volume] [pan]
-                auto row1 = tcpArea.removeFromTop(rowHeight);
-                header.muteButton->setBounds(row1.removeFromLeft(smallButtonSize));
-                row1.removeFromLeft(spacing);
-                header.soloButton->setBounds(row1.removeFromLeft(smallButtonSize));
-                row1.removeFromLeft(spacing);
-                header.recordButton->setBounds(row1.removeFromLeft(smallButtonSize));
-                header.recordButton->setVisible(true);
-                row1.removeFromLeft(spacing);
-                header.automationButton->setBounds(row1.removeFromLeft(smallButtonSize));
-                header.automationButton->setVisible(true);
-                row1.removeFromLeft(spacing + 2);
-
-                header.volumeLabel->setBounds(row1.removeFromLeft(volumeLabelWidth));
-                header.volumeLabel->setVisible(true);
-                row1.removeFromLeft(spacing);
-
-                header.panLabel->setBounds(row1.removeFromLeft(panLabelWidth));
-                header.panLabel->setVisible(true);
-
-                hideAllRouting();
+    // MIDI indicator to the left of audio meters
+    auto midiArea = workArea.removeFromRight(midiIndicatorWidth);
+    workArea.removeFromRight(meterPadding);
 
+    // Audio meter spans full track height
+    header.meterComponent->setBounds(meterArea);
+    header.meterComponent->setVisible(true);
+
+    // MIDI indicator spans full track height
+    header.midiIndicator->setBounds(midiArea);
+    header.midiIndicator->setVisible(header.midiInEnabled);
+    header.midiIndicator->toFront(false);  // Ensure it's on top
+
+    // Apply indentation based on depth for TCP area
+    int indent = header.depth * INDENT_WIDTH;
+    auto tcpArea = workArea.withTrimmedLeft(indent);
+
+    // Constants
+    const int nameRowHeight = 18;
+    const int rowHeight = 16;
+    const int smallButtonSize = 16;
+    const int spacing = 2;
+
+    // Top row: collapse button (if group) + name label
+    auto topRow = tcpArea.removeFromTop(nameRowHeight);
+
+    if (header.isGroup) {
+        header.collapseButton->setBounds(topRow.removeFromLeft(COLLAPSE_BUTTON_SIZE));
+        topRow.removeFromLeft(2);
+        header.collapseButton->setVisible(true);
+    } else {
+        header.collapseButton->setVisible(false);
+    }
+
+    header.nameLabel->setBounds(topRow);
+    tcpArea.removeFromTop(3);
+
+    // Helper to hide all routing selectors and sends
+    auto hideAllRouting = [&]() {
+        header.audioInSelector->setVisible(false);
+        header.audioOutSelector->setVisible(false);
+        header.midiInSelector->setVisible(false);
+        header.midiOutSelector->setVisible(false);
+        for (auto& sendLabel : header.sendLabels) {
+            sendLabel->setVisible(false);
+        }
+    };
+
+    // Label widths for draggable values
+    const int volumeLabelWidth = 42;  // "-60.0" or "+6.0"
+    const int panLabelWidth = 28;     // "L100" or "R100" or "C"
+    const int sendLabelWidth = 28;    // "-inf" or "-12"
+
+    if (trackHeight >= 100) {
+        // LARGE LAYOUT - evenly distributed:
+        // Order: M S R, Audio routing, MIDI routing, Volume/Pan/Sends
+        const int dropdownWidth = 55;
+        const int buttonGap = 2;
+        const int contentRowHeight = rowHeight - 2;
+
+        // Always show routing rows (4 rows total: buttons, audio, MIDI, volume/pan)
+        int numRows = 4;
+
+        // Calculate even spacing between rows
+        int totalContentHeight = numRows * contentRowHeight;
+        int availableSpace = tcpArea.getHeight() - totalContentHeight;
+        int rowGap = numRows > 1 ? std::max(2, availableSpace / (numRows - 1)) : 2;
+
+        // M S R A buttons row (always visible, now on top)
+        auto buttonsRow = tcpArea.removeFromTop(contentRowHeight);
+        header.muteButton->setBounds(buttonsRow.removeFromLeft(smallButtonSize));
+        buttonsRow.removeFromLeft(buttonGap);
+        header.soloButton->setBounds(buttonsRow.removeFromLeft(smallButtonSize));
+        buttonsRow.removeFromLeft(buttonGap);
+        header.recordButton->setBounds(buttonsRow.removeFromLeft(smallButtonSize));
+        header.recordButton->setVisible(true);
+        buttonsRow.removeFromLeft(buttonGap);
+        header.automationButton->setBounds(buttonsRow.removeFromLeft(smallButtonSize));
+        header.automationButton->setVisible(true);
+
+        tcpArea.removeFromTop(rowGap);
+
+        // Audio routing row (always visible)
+        auto audioRow = tcpArea.removeFromTop(contentRowHeight);
+        header.audioInSelector->setBounds(audioRow.removeFromLeft(dropdownWidth));
+        header.audioInSelector->setVisible(true);
+        audioRow.removeFromLeft(spacing);
+        header.audioOutSelector->setBounds(audioRow.removeFromLeft(dropdownWidth));
+        header.audioOutSelector->setVisible(true);
+        tcpArea.removeFromTop(rowGap);
+
+        // MIDI routing row (always visible)
+        auto midiRow = tcpArea.removeFromTop(contentRowHeight);
+        header.midiInSelector->setBounds(midiRow.removeFromLeft(dropdownWidth));
+        header.midiInSelector->setVisible(true);
+        midiRow.removeFromLeft(spacing);
+        header.midiOutSelector->setBounds(midiRow.removeFromLeft(dropdownWidth));
+        header.midiOutSelector->setVisible(true);
+        tcpArea.removeFromTop(rowGap);
+
+        // Volume, Pan, Sends row (always visible)
+        auto mixRow = tcpArea.removeFromTop(contentRowHeight);
+
+        header.volumeLabel->setBounds(mixRow.removeFromLeft(volumeLabelWidth));
+        header.volumeLabel->setVisible(true);
+        mixRow.removeFromLeft(spacing);
+
+        header.panLabel->setBounds(mixRow.removeFromLeft(panLabelWidth));
+        header.panLabel->setVisible(true);
+        mixRow.removeFromLeft(spacing);
+
+        // Sends on same row
+        for (auto& sendLabel : header.sendLabels) {
+            if (mixRow.getWidth() >= sendLabelWidth) {
+                sendLabel->setBounds(mixRow.removeFromLeft(sendLabelWidth));
+                sendLabel->setVisible(true);
+                mixRow.removeFromLeft(spacing);
             } else {
-                // SMALL LAYOUT: Buttons + volume/pan on same row
-                // Row 1: M S R A [volume] [pan]
-                auto row1 = tcpArea.removeFromTop(rowHeight);
-                header.muteButton->setBounds(row1.removeFromLeft(smallButtonSize));
-                row1.removeFromLeft(spacing);
-                header.soloButton->setBounds(row1.removeFromLeft(smallButtonSize));
-                row1.removeFromLeft(spacing);
-                header.recordButton->setBounds(row1.removeFromLeft(smallButtonSize));
-                header.recordButton->setVisible(true);
-                row1.removeFromLeft(spacing);
-                header.automationButton->setBounds(row1.removeFromLeft(smallButtonSize));
-                header.automationButton->setVisible(true);
-                row1.removeFromLeft(spacing + 2);
-
-                header.volumeLabel->setBounds(row1.removeFromLeft(volumeLabelWidth));
-                header.volumeLabel->setVisible(true);
-                row1.removeFromLeft(spacing);
-
-                header.panLabel->setBounds(row1.removeFromLeft(panLabelWidth));
-                header.panLabel->setVisible(true);
-
-                hideAllRouting();
+                sendLabel->setVisible(false);
             }
         }
+
+    } else if (trackHeight >= 55) {
+        // MEDIUM LAYOUT: Buttons + volume/pan only
+        // Row 1: M S R A [volume] [pan]
+        auto row1 = tcpArea.removeFromTop(rowHeight);
+        header.muteButton->setBounds(row1.removeFromLeft(smallButtonSize));
+        row1.removeFromLeft(spacing);
+        header.soloButton->setBounds(row1.removeFromLeft(smallButtonSize));
+        row1.removeFromLeft(spacing);
+        header.recordButton->setBounds(row1.removeFromLeft(smallButtonSize));
+        header.recordButton->setVisible(true);
+        row1.removeFromLeft(spacing);
+        header.automationButton->setBounds(row1.removeFromLeft(smallButtonSize));
+        header.automationButton->setVisible(true);
+        row1.removeFromLeft(spacing + 2);
+
+        header.volumeLabel->setBounds(row1.removeFromLeft(volumeLabelWidth));
+        header.volumeLabel->setVisible(true);
+        row1.removeFromLeft(spacing);
+
+        header.panLabel->setBounds(row1.removeFromLeft(panLabelWidth));
+        header.panLabel->setVisible(true);
+
+        hideAllRouting();
+
+    } else {
+        // SMALL LAYOUT: Buttons + volume/pan on same row
+        // Row 1: M S R A [volume] [pan]
+        auto row1 = tcpArea.removeFromTop(rowHeight);
+        header.muteButton->setBounds(row1.removeFromLeft(smallButtonSize));
+        row1.removeFromLeft(spacing);
+        header.soloButton->setBounds(row1.removeFromLeft(smallButtonSize));
+        row1.removeFromLeft(spacing);
+        header.recordButton->setBounds(row1.removeFromLeft(smallButtonSize));
+        header.recordButton->setVisible(true);
+        row1.removeFromLeft(spacing);
+        header.automationButton->setBounds(row1.removeFromLeft(smallButtonSize));
+        header.automationButton->setVisible(true);
+        row1.removeFromLeft(spacing + 2);
+
+        header.volumeLabel->setBounds(row1.removeFromLeft(volumeLabelWidth));
+        header.volumeLabel->setVisible(true);
+        row1.removeFromLeft(spacing);
+
+        header.panLabel->setBounds(row1.removeFromLeft(panLabelWidth));
+        header.panLabel->setVisible(true);
+
+        hideAllRouting();
     }
 }
 
@@ -1798,8 +1940,81 @@ void TrackHeadersPanel::showContextMenu(int trackIndex, juce::Point<int> positio
     menu.addItem(12, "MIDI In", true, header.midiInEnabled);
     menu.addItem(13, "MIDI Out", true, header.midiOutEnabled);
 
+    // Direct monitoring, for audio tracks, with what it saves over the chain's compensation
+    if (track->type == TrackType::Audio) {
+        juce::String directText = "Direct Monitoring";
+        if (auto* teWrapper = dynamic_cast<TracktionEngineWrapper*>(audioEngine_)) {
+            const double savingMs = teWrapper->getDirectMonitorSavingMs();
+            if (savingMs >= 0.1) {
+                directText << " (" << juce::String(savingMs, 1) << " ms sooner)";
+            }
+        }
+        menu.addItem(directText, true, track->directMonitor,
+                     [trackId = header.trackId, direct = !track->directMonitor] {
+                         TrackManager::getInstance().setTrackDirectMonitor(trackId, direct);
+                     });
+    }
+
+    // Sends into aux tracks: tick to send, then pick each send's tap point and level
+    juce::PopupMenu sendsMenu;
+    const TrackId trackId = header.trackId;
+    for (const auto& aux : allTracks) {
+        if (aux.type != TrackType::Aux || aux.id == trackId) {
+            continue;
+        }
+        const auto sendIt =
+            std::find_if(track->sends.begin(), track->sends.end(),
+                         [&aux](const SendInfo& send) { return send.destinationId == aux.id; });
+        if (sendIt == track->sends.end()) {
+            sendsMenu.addItem(aux.name, [trackId, auxId = aux.id] {
+                TrackManager::getInstance().addSend(trackId, auxId);
+            });
+            continue;
+        }
+
+        const int sendIndex = static_cast<int>(sendIt - track->sends.begin());
+        juce::PopupMenu sendMenu;
+        sendMenu.addItem("Pre-Fader", true, sendIt->preFader,
+                         [trackId, sendIndex, pre = !sendIt->preFader] {
+                             TrackManager::getInstance().setSendPreFader(trackId, sendIndex, pre);
+                         });
+        sendMenu.addSeparator();
+        for (float db : {0.0f, -6.0f, -12.0f, -24.0f}) {
+            const float level = juce::Decibels::decibelsToGain(db);
+            sendMenu.addItem(juce::String(db, 0) + " dB", true,
+                             std::abs(sendIt->level - level) < 0.001f, [trackId, sendIndex, level] {
+                                 TrackManager::getInstance().setSendLevel(trackId, sendIndex,
+                                                                          level);
+                             });
+        }
+        sendMenu.addSeparator();
+        sendMenu.addItem("Remove Send", [trackId, sendIndex] {
+            TrackManager::getInstance().removeSend(trackId, sendIndex);
+        });
+        sendsMenu.addSubMenu(aux.name, sendMenu, true, nullptr, true);
+    }
+    if (sendsMenu.getNumItems() > 0) {
+        menu.addSubMenu("Sends", sendsMenu);
+    }
+
     menu.addSeparator();
 
+    // Freeze (not for groups, which have no chain of their own to render)
+    if (!track->isGroup()) {
+        switch (track->freezeState) {
+            case FreezeState::Unfrozen:
+                menu.addItem(4, "Freeze Track");
+                break;
+            case FreezeState::Freezing:
+                menu.addItem(5, "Cancel Freeze");
+                break;
+            case FreezeState::Frozen:
+                menu.addItem(5, "Unfreeze Track");
+                break;
+        }
+        menu.addSeparator();
+    }
+
     // Delete track
     menu.addItem(3, "Delete Track");
 
@@ -1817,6 +2032,10 @@ void TrackHeadersPanel::showContextMenu(int trackIndex, juce::Point<int> positio
                                // Delete track (through undo system)
                                auto cmd = std::make_unique<DeleteTrackCommand>(trackId);
                                UndoManager::getInstance().executeCommand(std::move(cmd));
+                           } else if (result == 4) {
+                               TrackManager::getInstance().freezeTrack(trackId);
+                           } else if (result == 5) {
+                               TrackManager::getInstance().unfreezeTrack(trackId);
                            } else if (result == 10) {
                                // Toggle Audio In
                                toggleRouting(trackIndex, RoutingType::AudioIn);
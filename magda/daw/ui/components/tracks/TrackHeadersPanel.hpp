@@ -7,10 +7,12 @@
 #include <vector>
 
 #include "../../themes/MixerLookAndFeel.hpp"
+#include "../../utils/FrameScheduler.hpp"
 #include "../common/DraggableValueLabel.hpp"
 #include "../common/SvgButton.hpp"
 #include "../mixer/RoutingSelector.hpp"
 #include "core/AutomationManager.hpp"
+#include "core/Subscription.hpp"
 #include "core/TrackManager.hpp"
 #include "core/ViewModeController.hpp"
 
@@ -33,12 +35,13 @@ class TrackHeadersPanel : public juce::Component,
     TrackHeadersPanel(AudioEngine* audioEngine = nullptr);
     ~TrackHeadersPanel() override;
 
-    // Timer callback for metering updates
+    // Timer callback for MIDI device hot-plug polling
     void timerCallback() override;
 
     // TrackManagerListener
     void tracksChanged() override;
     void trackPropertyChanged(int trackId) override;
+    void trackChangesCoalesced(const TrackChangeSet& changes) override;
 
     // ViewModeListener
     void viewModeChanged(ViewMode mode, const AudioEngineProfile& profile) override;
@@ -49,6 +52,8 @@ class TrackHeadersPanel : public juce::Component,
 
     void paint(juce::Graphics& g) override;
     void resized() override;
+    void moved() override;              // Viewport scrolled
+    void parentSizeChanged() override;  // Viewport resized
 
     // Track management
     void addTrack();
@@ -100,6 +105,7 @@ class TrackHeadersPanel : public juce::Component,
         bool selected = false;
         bool muted = false;
         bool solo = false;
+        FreezeState freezeState = FreezeState::Unfrozen;
         float volume = 0.8f;
         float pan = 0.0f;
         int height = DEFAULT_TRACK_HEIGHT;
@@ -132,6 +138,9 @@ class TrackHeadersPanel : public juce::Component,
         float meterLevelR = 0.0f;
         float midiActivity = 0.0f;  // 0-1, decays over time
 
+        // Components shown and laid out (off-screen headers keep theirs hidden)
+        bool onScreen = false;
+
         TrackHeader(const juce::String& trackName);
         ~TrackHeader() = default;
     };
@@ -144,6 +153,12 @@ class TrackHeadersPanel : public juce::Component,
     ViewMode currentViewMode_ = ViewMode::Arrange;
     MixerLookAndFeel sliderLookAndFeel_;  // Custom look and feel for sliders
     AudioEngine* audioEngine_ = nullptr;  // Reference to audio engine for metering
+    Subscription noteOnSubscription_;     // AudioBridge note-on events -> midiActivity
+    Subscription meterActivitySubscription_;  // Wakes the meters when audio starts
+
+    // Meters and MIDI activity animate on the shared frame clock, idle while silent
+    FrameScheduler::Client frameClient_{*this, 30.0, [this]() { updateMeters(); }};
+    void updateMeters();
 
     // Resize functionality
     bool isResizing = false;
@@ -189,6 +204,18 @@ class TrackHeadersPanel : public juce::Component,
     bool isResizeHandleArea(const juce::Point<int>& point, int& trackIndex) const;
     void updateTrackHeaderLayout();
 
+    // Headers keyed by track ID: kept across structural changes, built only for new tracks
+    void rebuildTrackHeaders();
+    std::unique_ptr<TrackHeader> createTrackHeader(const TrackInfo& track);
+    void updateHeaderFromTrack(TrackHeader& header, const TrackInfo& track);
+
+    // Virtualisation: only headers in (or near) the viewport show and lay out components
+    static constexpr int OFFSCREEN_MARGIN = 200;
+    juce::Rectangle<int> getVisibleHeaderArea() const;
+    void setHeaderOnScreen(TrackHeader& header, bool onScreen);
+    void updateOnScreenHeaders();
+    void layoutTrackHeader(TrackHeader& header, juce::Rectangle<int> headerArea);
+
     // Automation lane height helpers
     int getTrackTotalHeight(int trackIndex) const;
     int getVisibleAutomationLanesHeight(TrackId trackId) const;
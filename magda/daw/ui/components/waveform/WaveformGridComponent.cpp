@@ -3,12 +3,26 @@
 #include "../../themes/DarkTheme.hpp"
 #include "../../themes/FontManager.hpp"
 #include "audio/AudioThumbnailManager.hpp"
+#include "audio/SpectralCache.hpp"
 #include "core/ClipOperations.hpp"
 
 namespace magda::daw::ui {
 
 WaveformGridComponent::WaveformGridComponent() {
     setName("WaveformGrid");
+    magda::AudioThumbnailManager::getInstance().addListener(this);
+    magda::SpectralCache::getInstance().addListener(this);
+}
+
+WaveformGridComponent::~WaveformGridComponent() {
+    magda::AudioThumbnailManager::getInstance().removeListener(this);
+    magda::SpectralCache::getInstance().removeListener(this);
+}
+
+void WaveformGridComponent::changeListenerCallback(juce::ChangeBroadcaster*) {
+    if (editingClipId_ != magda::INVALID_CLIP_ID) {
+        repaint();
+    }
 }
 
 void WaveformGridComponent::paint(juce::Graphics& g) {
@@ -113,17 +127,26 @@ void WaveformGridComponent::paintWaveform(juce::Graphics& g, const magda::ClipIn
         if (waveDrawRect.getWidth() > 0 && waveDrawRect.getHeight() > 0) {
             g.saveState();
             if (g.reduceClipRegion(waveformRect)) {
-                thumbnailManager.drawWaveform(g, waveDrawRect, source.filePath, displayStart,
-                                              displayEnd, clip.colour.brighter(0.2f),
-                                              static_cast<float>(verticalZoom_));
+                if (spectrogramMode_) {
+                    magda::SpectralCache::getInstance().drawSpectrogram(
+                        g, waveDrawRect, source.filePath, displayStart, displayEnd,
+                        clip.colour.brighter(0.2f));
+                } else {
+                    thumbnailManager.drawWaveform(g, waveDrawRect, source.filePath, displayStart,
+                                                  displayEnd, clip.colour.brighter(0.2f),
+                                                  static_cast<float>(verticalZoom_));
+                }
             }
             g.restoreState();
         }
     }
 
-    // Draw center line
-    g.setColour(DarkTheme::getColour(DarkTheme::BORDER));
-    g.drawHorizontalLine(waveformRect.getCentreY(), waveformRect.getX(), waveformRect.getRight());
+    // Draw center line (the waveform's zero)
+    if (!spectrogramMode_) {
+        g.setColour(DarkTheme::getColour(DarkTheme::BORDER));
+        g.drawHorizontalLine(waveformRect.getCentreY(), waveformRect.getX(),
+                             waveformRect.getRight());
+    }
 
     // Draw clip boundary indicator line at clip end
     if (clipEndPixel > waveformRect.getX() && clipEndPixel < waveformRect.getRight()) {
@@ -231,6 +254,13 @@ void WaveformGridComponent::setVerticalZoom(double zoom) {
     }
 }
 
+void WaveformGridComponent::setSpectrogramMode(bool spectrogram) {
+    if (spectrogramMode_ != spectrogram) {
+        spectrogramMode_ = spectrogram;
+        repaint();
+    }
+}
+
 void WaveformGridComponent::updateClipPosition(double startTime, double length) {
     clipStartTime_ = startTime;
     clipLength_ = length;
@@ -326,10 +356,8 @@ void WaveformGridComponent::mouseDown(const juce::MouseEvent& event) {
 
     // Cache file duration for trim clamping
     dragStartFileDuration_ = 0.0;
-    auto* thumbnail = magda::AudioThumbnailManager::getInstance().getThumbnail(source.filePath);
-    if (thumbnail) {
-        dragStartFileDuration_ = thumbnail->getTotalLength();
-    }
+    dragStartFileDuration_ =
+        magda::AudioThumbnailManager::getInstance().getFileDuration(source.filePath);
 }
 
 void WaveformGridComponent::mouseDrag(const juce::MouseEvent& event) {
@@ -10,14 +10,15 @@ namespace magda::daw::ui {
 /**
  * @brief Scrollable waveform grid component
  *
- * Handles waveform drawing and interaction (trim, move, stretch).
+ * Handles waveform drawing and interaction (trim, move, stretch). In spectrogram mode the
+ * source is drawn from its background spectral analysis (SpectralCache) instead.
  * Designed to be placed inside a Viewport for scrolling.
  * Similar to PianoRollGridComponent architecture.
  */
-class WaveformGridComponent : public juce::Component {
+class WaveformGridComponent : public juce::Component, private juce::ChangeListener {
   public:
     WaveformGridComponent();
-    ~WaveformGridComponent() override = default;
+    ~WaveformGridComponent() override;
 
     // Component overrides
     void paint(juce::Graphics& g) override;
@@ -57,6 +58,14 @@ class WaveformGridComponent : public juce::Component {
      */
     void setVerticalZoom(double zoom);
 
+    /**
+     * @brief Draw the frequency content instead of the waveform
+     */
+    void setSpectrogramMode(bool spectrogram);
+    bool isSpectrogramMode() const {
+        return spectrogramMode_;
+    }
+
     /**
      * @brief Set scroll offset for coordinate calculations
      */
@@ -105,6 +114,9 @@ class WaveformGridComponent : public juce::Component {
     std::function<void()> onWaveformChanged;
 
   private:
+    // Repaint once the waveform thumbnail has finished building, or more spectrum is ready
+    void changeListenerCallback(juce::ChangeBroadcaster* source) override;
+
     magda::ClipId editingClipId_ = magda::INVALID_CLIP_ID;
 
     // Timeline mode
@@ -115,6 +127,7 @@ class WaveformGridComponent : public juce::Component {
     // Zoom and scroll
     double horizontalZoom_ = 100.0;  // pixels per second
     double verticalZoom_ = 1.0;      // amplitude multiplier
+    bool spectrogramMode_ = false;
     int scrollOffsetX_ = 0;
     int scrollOffsetY_ = 0;
 
@@ -1,8 +1,14 @@
 #include "DebugDialog.hpp"
 
 #include "../themes/DarkTheme.hpp"
+#include "../components/common/FrameStatsView.hpp"
 #include "../themes/FontManager.hpp"
 #include "DebugSettings.hpp"
+#include "audio/AudioThumbnailManager.hpp"
+#include "profiling/DropoutLog.hpp"
+#include "profiling/LoadProfiler.hpp"
+#include "profiling/MemoryAccounting.hpp"
+#include "profiling/TraceRecorder.hpp"
 
 namespace magda::daw::ui {
 
@@ -11,7 +17,7 @@ std::unique_ptr<DebugDialog> DebugDialog::instance_;
 //==============================================================================
 // Content component with sliders
 //==============================================================================
-class DebugDialog::Content : public juce::Component {
+class DebugDialog::Content : public juce::Component, private juce::Timer {
   public:
     Content() {
         // Title
@@ -100,7 +106,72 @@ class DebugDialog::Content : public juce::Component {
         };
         addAndMakeVisible(paramValueFontSlider_);
 
-        setSize(300, 240);
+        // Waveform cache stats (read-only, refreshed while shown)
+        waveformCacheLabel_.setFont(FontManager::getInstance().getUIFont(12.0f));
+        waveformCacheLabel_.setColour(juce::Label::textColourId,
+                                      DarkTheme::getSecondaryTextColour());
+        waveformCacheLabel_.setJustificationType(juce::Justification::topLeft);
+        addAndMakeVisible(waveformCacheLabel_);
+        updateWaveformCacheStats();
+
+        // Estimated heap per subsystem (refreshed with the cache stats)
+        memoryLabel_.setFont(FontManager::getInstance().getUIFont(12.0f));
+        memoryLabel_.setColour(juce::Label::textColourId, DarkTheme::getSecondaryTextColour());
+        memoryLabel_.setJustificationType(juce::Justification::topLeft);
+        addAndMakeVisible(memoryLabel_);
+        updateMemoryStats();
+
+        // Last startup / project load by phase, with the slowest plugins and thumbnails
+        loadLabel_.setFont(FontManager::getInstance().getUIFont(12.0f));
+        loadLabel_.setColour(juce::Label::textColourId, DarkTheme::getSecondaryTextColour());
+        loadLabel_.setJustificationType(juce::Justification::topLeft);
+        addAndMakeVisible(loadLabel_);
+        updateLoadStats();
+
+        copyLoadReportButton_.onClick = []() {
+            juce::SystemClipboard::copyTextToClipboard(
+                magda::LoadProfiler::getInstance().generateReport());
+        };
+        addAndMakeVisible(copyLoadReportButton_);
+
+        // Audio dropouts with the slowest devices at the time (also in Logs/dropouts.log)
+        dropoutLabel_.setFont(FontManager::getInstance().getUIFont(12.0f));
+        dropoutLabel_.setColour(juce::Label::textColourId, DarkTheme::getSecondaryTextColour());
+        dropoutLabel_.setJustificationType(juce::Justification::topLeft);
+        addAndMakeVisible(dropoutLabel_);
+        updateDropoutStats();
+
+        copyDropoutsButton_.onClick = []() {
+            juce::SystemClipboard::copyTextToClipboard(
+                magda::DropoutLog::getInstance().generateReport());
+        };
+        addAndMakeVisible(copyDropoutsButton_);
+        startTimer(500);
+
+        // UI frame times and the views that dropped frames (refreshes itself)
+        addAndMakeVisible(frameStats_);
+
+        // Profiling trace: record MAGDA_MONITOR_SCOPE timings, save as Chrome trace JSON
+        traceButton_.onClick = [this]() {
+            auto& trace = magda::TraceRecorder::getInstance();
+            if (trace.isRecording()) {
+                trace.stop();
+            } else {
+                trace.start();
+            }
+            updateTraceButtons();
+        };
+        addAndMakeVisible(traceButton_);
+
+        saveTraceButton_.onClick = [this]() { saveTrace(); };
+        addAndMakeVisible(saveTraceButton_);
+        updateTraceButtons();
+
+        setSize(300, 794 + frameStats_.getPreferredHeight() + 10);
+    }
+
+    ~Content() override {
+        stopTimer();
     }
 
     void paint(juce::Graphics& g) override {
@@ -141,6 +212,32 @@ class DebugDialog::Content : public juce::Component {
         row = bounds.removeFromTop(24);
         paramValueFontLabel_.setBounds(row.removeFromLeft(140));
         paramValueFontSlider_.setBounds(row);
+        bounds.removeFromTop(10);
+
+        waveformCacheLabel_.setBounds(bounds.removeFromTop(36));
+        bounds.removeFromTop(10);
+
+        memoryLabel_.setBounds(bounds.removeFromTop(124));
+        bounds.removeFromTop(10);
+
+        loadLabel_.setBounds(bounds.removeFromTop(124));
+        bounds.removeFromTop(10);
+        copyLoadReportButton_.setBounds(bounds.removeFromTop(24));
+        bounds.removeFromTop(10);
+
+        dropoutLabel_.setBounds(bounds.removeFromTop(124));
+        bounds.removeFromTop(10);
+        copyDropoutsButton_.setBounds(bounds.removeFromTop(24));
+        bounds.removeFromTop(10);
+
+        frameStats_.setBounds(bounds.removeFromTop(frameStats_.getPreferredHeight()));
+        bounds.removeFromTop(10);
+
+        // Trace buttons row
+        row = bounds.removeFromTop(24);
+        traceButton_.setBounds(row.removeFromLeft(row.getWidth() / 2 - 3));
+        row.removeFromLeft(6);
+        saveTraceButton_.setBounds(row);
     }
 
   private:
@@ -155,6 +252,97 @@ class DebugDialog::Content : public juce::Component {
     juce::Slider paramFontSlider_;
     juce::Label paramValueFontLabel_;
     juce::Slider paramValueFontSlider_;
+    juce::Label waveformCacheLabel_;
+    juce::Label memoryLabel_;
+    juce::Label loadLabel_;
+    juce::TextButton copyLoadReportButton_{"Copy Load Report"};
+    juce::Label dropoutLabel_;
+    juce::TextButton copyDropoutsButton_{"Copy Dropout Log"};
+    FrameStatsView frameStats_;
+    juce::TextButton traceButton_;
+    juce::TextButton saveTraceButton_{"Save Trace..."};
+    std::unique_ptr<juce::FileChooser> traceChooser_;
+
+    void timerCallback() override {
+        if (isShowing()) {
+            updateWaveformCacheStats();
+            updateMemoryStats();
+            updateLoadStats();
+            updateDropoutStats();
+        }
+    }
+
+    void updateWaveformCacheStats() {
+        const auto stats = AudioThumbnailManager::getInstance().getCacheStats();
+        constexpr double bytesPerMB = 1024.0 * 1024.0;
+
+        waveformCacheLabel_.setText(
+            "Waveform cache: " + juce::String(stats.residentBytes / bytesPerMB, 1) + " / " +
+                juce::String(stats.budgetBytes / bytesPerMB, 0) + " MB, " +
+                juce::String(stats.numResident) + " resident (" +
+                juce::String(stats.numRetained) + " on screen)\nHit rate " +
+                juce::String(stats.getHitRate() * 100.0, 1) + "% (" + juce::String(stats.hits) +
+                " hits, " + juce::String(stats.misses) + " misses), " +
+                juce::String(stats.evictions) + " evictions",
+            juce::dontSendNotification);
+    }
+
+    void updateMemoryStats() {
+        const auto usage = magda::MemoryAccounting::getInstance().collect();
+
+        juce::String text = "Memory (estimated):";
+        for (const auto& entry : usage) {
+            text << "\n  " << entry.subsystem << ": "
+                 << magda::MemoryAccounting::formatBytes(entry.bytes);
+        }
+        text << "\n  Total: "
+             << magda::MemoryAccounting::formatBytes(magda::MemoryAccounting::getTotalBytes(usage));
+        memoryLabel_.setText(text, juce::dontSendNotification);
+    }
+
+    void updateLoadStats() {
+        loadLabel_.setText("Load time:\n" +
+                               magda::LoadProfiler::getInstance().generateSummary(4, 2),
+                           juce::dontSendNotification);
+    }
+
+    void updateDropoutStats() {
+        dropoutLabel_.setText("Audio dropouts: " +
+                                  magda::DropoutLog::getInstance().generateSummary(2),
+                              juce::dontSendNotification);
+    }
+
+    void updateTraceButtons() {
+        const bool recording = magda::TraceRecorder::getInstance().isRecording();
+        traceButton_.setButtonText(recording ? "Stop Trace" : "Start Trace");
+        saveTraceButton_.setEnabled(!recording);
+    }
+
+    void saveTrace() {
+        traceChooser_ = std::make_unique<juce::FileChooser>(
+            "Save Profiling Trace",
+            juce::File::getSpecialLocation(juce::File::userDocumentsDirectory)
+                .getChildFile("magda-trace.json"),
+            "*.json", true);
+
+        auto flags = juce::FileBrowserComponent::saveMode |
+                     juce::FileBrowserComponent::canSelectFiles |
+                     juce::FileBrowserComponent::warnAboutOverwriting;
+
+        traceChooser_->launchAsync(flags, [this](const juce::FileChooser& chooser) {
+            auto file = chooser.getResult();
+            traceChooser_.reset();
+            if (file == juce::File()) {
+                return;  // User cancelled
+            }
+
+            const auto json = magda::TraceRecorder::getInstance().exportChromeTrace();
+            if (!file.replaceWithText(juce::String(json))) {
+                juce::AlertWindow::showMessageBoxAsync(juce::AlertWindow::WarningIcon, "Save Trace",
+                                                       "Couldn't write " + file.getFullPathName());
+            }
+        });
+    }
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Content)
 };
@@ -2,7 +2,10 @@
 
 #include "../themes/DarkTheme.hpp"
 #include "../themes/FontManager.hpp"
+#include "audio/AudioBridge.hpp"
 #include "core/SelectionManager.hpp"
+#include "engine/AudioEngine.hpp"
+#include "ui/components/chain/NodeComponent.hpp"
 
 namespace magda {
 
@@ -49,6 +52,17 @@ class ChainTreeItemBase : public juce::TreeViewItem {
             g.drawText(icon_, bounds.removeFromLeft(20), juce::Justification::centred);
         }
 
+        // CPU column (right edge) while measuring
+        if (cpuVisible_) {
+            auto cpuBounds = bounds.removeFromRight(kCpuColumnWidth);
+            using daw::ui::NodeComponent;
+            g.setColour(cpuMeasured_ ? NodeComponent::getCpuLoadColour(cpuLoad_)
+                                     : DarkTheme::getColour(DarkTheme::TEXT_SECONDARY));
+            g.setFont(FontManager::getInstance().getUIFont(10.0f));
+            g.drawText(cpuMeasured_ ? NodeComponent::formatCpuLoad(cpuLoad_) : juce::String("-"),
+                       cpuBounds, juce::Justification::centredRight);
+        }
+
         // Draw text
         g.setColour(getItemColour());
         g.setFont(getItemFont());
@@ -96,6 +110,38 @@ class ChainTreeItemBase : public juce::TreeViewItem {
         return path_;
     }
 
+    /**
+     * @brief Show a load in the CPU column (nullptr hides the column)
+     */
+    void setCpuUsage(const ChainCpuUsage::Usage* usage) {
+        const bool visible = usage != nullptr;
+        const bool measured = visible && usage->isMeasured();
+        const double load = measured ? usage->load : 0.0;
+        if (visible != cpuVisible_ || measured != cpuMeasured_ || load != cpuLoad_) {
+            cpuVisible_ = visible;
+            cpuMeasured_ = measured;
+            cpuLoad_ = load;
+            repaintItem();
+        }
+    }
+
+    /**
+     * @brief Load for sorting (-1 when unmeasured, so those sink to the bottom)
+     */
+    double getSortLoad() const {
+        return cpuMeasured_ ? cpuLoad_ : -1.0;
+    }
+
+    // Position among its siblings in the chain, to restore after sorting by CPU
+    void setModelOrder(int order) {
+        modelOrder_ = order;
+    }
+    int getModelOrder() const {
+        return modelOrder_;
+    }
+
+    static constexpr int kCpuColumnWidth = 48;
+
   protected:
     virtual juce::Colour getItemColour() const {
         return DarkTheme::getTextColour();
@@ -113,6 +159,30 @@ class ChainTreeItemBase : public juce::TreeViewItem {
     juce::String icon_;
     juce::String secondaryText_;
     ChainNodePath path_;
+
+    bool cpuVisible_ = false;
+    bool cpuMeasured_ = false;
+    double cpuLoad_ = 0.0;
+    int modelOrder_ = 0;
+};
+
+/**
+ * @brief Sibling order: highest CPU load first, or the chain's own order
+ */
+struct ChainTreeItemOrder {
+    bool byCpu = false;
+
+    int compareElements(juce::TreeViewItem* first, juce::TreeViewItem* second) const {
+        auto* a = dynamic_cast<ChainTreeItemBase*>(first);
+        auto* b = dynamic_cast<ChainTreeItemBase*>(second);
+        if (a == nullptr || b == nullptr) {
+            return 0;
+        }
+        if (byCpu && a->getSortLoad() != b->getSortLoad()) {
+            return a->getSortLoad() > b->getSortLoad() ? -1 : 1;
+        }
+        return a->getModelOrder() - b->getModelOrder();
+    }
 };
 
 /**
@@ -208,7 +278,8 @@ class ChainTreeItem : public ChainTreeItemBase {
 
 class ChainTreeDialog::ContentComponent : public juce::Component,
                                           public TrackManagerListener,
-                                          public SelectionManagerListener {
+                                          public SelectionManagerListener,
+                                          private juce::Timer {
   public:
     explicit ContentComponent(TrackId trackId) : trackId_(trackId) {
         // Setup tree view
@@ -221,9 +292,24 @@ class ChainTreeDialog::ContentComponent : public juce::Component,
         treeView_.setIndentSize(20);
         addAndMakeVisible(treeView_);
 
+        // CPU measurement: turns the probes on for every track, not just this one
+        measureButton_.setColour(juce::ToggleButton::tickColourId,
+                                 DarkTheme::getColour(DarkTheme::ACCENT_BLUE));
+        measureButton_.onClick = [this]() {
+            if (auto* bridge = getAudioBridge()) {
+                bridge->setDeviceCpuMeasurementEnabled(measureButton_.getToggleState());
+            }
+            refreshCpuUsage();
+        };
+        addAndMakeVisible(measureButton_);
+
+        sortButton_.setColour(juce::ToggleButton::tickColourId,
+                              DarkTheme::getColour(DarkTheme::ACCENT_BLUE));
+        sortButton_.onClick = [this]() { refreshCpuUsage(); };
+        addAndMakeVisible(sortButton_);
+
         // Info label
-        infoLabel_.setText("Click an item to select it in the chain view",
-                           juce::dontSendNotification);
+        infoLabel_.setText(kDefaultInfo, juce::dontSendNotification);
         infoLabel_.setColour(juce::Label::textColourId,
                              DarkTheme::getColour(DarkTheme::TEXT_SECONDARY));
         infoLabel_.setJustificationType(juce::Justification::centred);
@@ -235,9 +321,12 @@ class ChainTreeDialog::ContentComponent : public juce::Component,
 
         buildTree();
         setSize(400, 500);
+
+        startTimer(kCpuRefreshMs);
     }
 
     ~ContentComponent() override {
+        stopTimer();
         treeView_.setRootItem(nullptr);
         TrackManager::getInstance().removeListener(this);
         SelectionManager::getInstance().removeListener(this);
@@ -249,6 +338,10 @@ class ChainTreeDialog::ContentComponent : public juce::Component,
 
     void resized() override {
         auto bounds = getLocalBounds().reduced(10);
+        auto toolbar = bounds.removeFromTop(24);
+        measureButton_.setBounds(toolbar.removeFromLeft(120));
+        sortButton_.setBounds(toolbar.removeFromLeft(120));
+        bounds.removeFromTop(5);
         infoLabel_.setBounds(bounds.removeFromBottom(25));
         bounds.removeFromBottom(5);
         treeView_.setBounds(bounds);
@@ -300,6 +393,87 @@ class ChainTreeDialog::ContentComponent : public juce::Component,
     }
 
   private:
+    static constexpr int kCpuRefreshMs = 250;
+    static constexpr const char* kDefaultInfo = "Click an item to select it in the chain view";
+
+    static AudioBridge* getAudioBridge() {
+        auto* audioEngine = TrackManager::getInstance().getAudioEngine();
+        return audioEngine ? audioEngine->getAudioBridge() : nullptr;
+    }
+
+    void timerCallback() override {
+        refreshCpuUsage();
+    }
+
+    /**
+     * @brief Fill the CPU column from the bridge's latest readings (and re-sort)
+     */
+    void refreshCpuUsage() {
+        auto* bridge = getAudioBridge();
+        const bool measuring = bridge != nullptr && bridge->isDeviceCpuMeasurementEnabled();
+        measureButton_.setToggleState(measuring, juce::dontSendNotification);
+        sortButton_.setEnabled(measuring);
+
+        auto* root = dynamic_cast<ChainTreeItemBase*>(rootItem_.get());
+        if (root == nullptr) {
+            return;
+        }
+
+        if (!measuring) {
+            applyCpuUsage(root, nullptr);
+            if (showingCpu_) {
+                showingCpu_ = false;
+                sortItems(root, false);
+                infoLabel_.setText(kDefaultInfo, juce::dontSendNotification);
+            }
+            return;
+        }
+
+        const auto usage = bridge->getChainCpuUsage(trackId_);
+        showingCpu_ = true;
+        root->setCpuUsage(&usage.getTrackUsage());
+        for (int i = 0; i < root->getNumSubItems(); ++i) {
+            applyCpuUsage(root->getSubItem(i), &usage);
+        }
+        sortItems(root, sortButton_.getToggleState());
+
+        // Track total and the device to look at first
+        auto info = "Track: " + daw::ui::NodeComponent::formatCpuLoad(usage.getTrackUsage().load);
+        const auto hotspots = usage.getHotspots(1);
+        if (!hotspots.empty()) {
+            info << "  |  Hottest: " << hotspots.front().name << " "
+                 << daw::ui::NodeComponent::formatCpuLoad(hotspots.front().usage.load);
+        }
+        infoLabel_.setText(info, juce::dontSendNotification);
+    }
+
+    static void applyCpuUsage(juce::TreeViewItem* item, const ChainCpuUsage* usage) {
+        if (auto* chainItem = dynamic_cast<ChainTreeItemBase*>(item)) {
+            const auto* node = usage ? usage->find(chainItem->getPath()) : nullptr;
+            chainItem->setCpuUsage(node ? &node->usage : nullptr);
+        }
+        for (int i = 0; i < item->getNumSubItems(); ++i) {
+            applyCpuUsage(item->getSubItem(i), usage);
+        }
+    }
+
+    static void sortItems(juce::TreeViewItem* item, bool byCpu) {
+        ChainTreeItemOrder order{byCpu};
+        item->sortSubItems(order);
+        for (int i = 0; i < item->getNumSubItems(); ++i) {
+            sortItems(item->getSubItem(i), byCpu);
+        }
+    }
+
+    static void rememberModelOrder(juce::TreeViewItem* item) {
+        for (int i = 0; i < item->getNumSubItems(); ++i) {
+            if (auto* chainItem = dynamic_cast<ChainTreeItemBase*>(item->getSubItem(i))) {
+                chainItem->setModelOrder(i);
+            }
+            rememberModelOrder(item->getSubItem(i));
+        }
+    }
+
     ChainTreeItemBase* findTreeItemByPath(juce::TreeViewItem* item, const ChainNodePath& path) {
         if (!item)
             return nullptr;
@@ -345,12 +519,17 @@ class ChainTreeDialog::ContentComponent : public juce::Component,
             }
         }
 
+        rememberModelOrder(root.get());
+
         rootItem_ = std::move(root);
         treeView_.setRootItem(rootItem_.get());
         treeView_.setRootItemVisible(true);
 
         // Expand all items
         expandAllItems(rootItem_.get());
+
+        showingCpu_ = false;
+        refreshCpuUsage();
     }
 
     juce::TreeViewItem* buildRackItem(const RackInfo& rack, const ChainNodePath& rackPath) {
@@ -392,8 +571,11 @@ class ChainTreeDialog::ContentComponent : public juce::Component,
 
     TrackId trackId_;
     juce::TreeView treeView_;
+    juce::ToggleButton measureButton_{"Measure CPU"};
+    juce::ToggleButton sortButton_{"Sort by CPU"};
     juce::Label infoLabel_;
     std::unique_ptr<juce::TreeViewItem> rootItem_;
+    bool showingCpu_ = false;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ContentComponent)
 };
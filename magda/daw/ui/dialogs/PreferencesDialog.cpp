@@ -1,6 +1,7 @@
 #include "PreferencesDialog.hpp"
 
 #include "../themes/DarkTheme.hpp"
+#include "../utils/GpuRenderer.hpp"
 #include "core/Config.hpp"
 
 namespace magda {
@@ -36,6 +37,37 @@ PreferencesDialog::PreferencesDialog() {
     // Setup layout section
     setupSectionHeader(layoutHeader, "Layout");
     setupToggle(leftHandedLayoutToggle, "Headers on Right");
+    setupToggle(gpuRenderingToggle, "GPU rendering (OpenGL)");
+    gpuRenderingToggle.setTooltip("Draw the timeline, mixer and meters on the graphics card, "
+                                  "which keeps high-resolution displays smooth");
+    gpuRenderingToggle.setEnabled(GpuRenderer::isAvailable());
+
+    // Setup audio engine section (0 on the slider means automatic)
+    setupSectionHeader(audioEngineHeader, "Audio Engine");
+    setupSlider(renderThreadsSlider, renderThreadsLabel, "Render Threads", 0.0,
+                static_cast<double>(juce::SystemStats::getNumCpus()), 1.0);
+    renderThreadsSlider.textFromValueFunction = [](double value) {
+        return value < 1.0 ? juce::String("Auto") : juce::String(juce::roundToInt(value));
+    };
+    renderThreadsSlider.updateText();
+    setupToggle(pinRenderThreadsToggle, "Pin render threads to cores");
+    setupToggle(performanceCoresToggle, "Prefer performance cores");
+
+    // What Live mode does with plugins whose latency would hold up monitoring
+    liveLatencyLabel.setText("Live Latent Plugins", juce::dontSendNotification);
+    liveLatencyLabel.setColour(juce::Label::textColourId,
+                               DarkTheme::getColour(DarkTheme::TEXT_PRIMARY));
+    liveLatencyLabel.setJustificationType(juce::Justification::centredLeft);
+    addAndMakeVisible(liveLatencyLabel);
+    liveLatencyCombo.addItem("Compensate all", 1);
+    liveLatencyCombo.addItem("Bypass all", 2);
+    liveLatencyCombo.addItem("Bypass to meet target", 3);
+    liveLatencyCombo.setTooltip("Bypass to meet target keeps plugin delay compensation "
+                                "within the Live profile's latency");
+    addAndMakeVisible(liveLatencyCombo);
+    setupToggle(livePreRenderToggle, "Pre-render idle tracks in Live mode");
+    livePreRenderToggle.setTooltip("Tracks that aren't armed or monitoring play a background "
+                                   "render while stopped, so only live tracks use small blocks");
 
     // Setup keyboard shortcuts section
     setupSectionHeader(shortcutsHeader, "Keyboard Shortcuts");
@@ -77,8 +109,8 @@ PreferencesDialog::PreferencesDialog() {
     // Load current settings
     loadCurrentSettings();
 
-    // Set preferred size (increased height for panels, layout and shortcuts sections)
-    setSize(450, 840);
+    // Set preferred size (increased height for panels, layout, engine and shortcuts sections)
+    setSize(450, 1116);
 }
 
 PreferencesDialog::~PreferencesDialog() = default;
@@ -186,6 +218,44 @@ void PreferencesDialog::resized() {
     // Left-handed layout toggle
     row = bounds.removeFromTop(toggleHeight + 8);
     leftHandedLayoutToggle.setBounds(row.reduced(0, 4));
+    bounds.removeFromTop(4);
+
+    // GPU rendering toggle
+    row = bounds.removeFromTop(toggleHeight + 8);
+    gpuRenderingToggle.setBounds(row.reduced(0, 4));
+
+    bounds.removeFromTop(sectionSpacing);
+
+    // Audio engine section
+    auto audioEngineHeaderBounds = bounds.removeFromTop(headerHeight);
+    audioEngineHeader.setBounds(audioEngineHeaderBounds);
+    bounds.removeFromTop(4);
+
+    // Render threads
+    row = bounds.removeFromTop(rowHeight);
+    renderThreadsLabel.setBounds(row.removeFromLeft(labelWidth));
+    renderThreadsSlider.setBounds(row.reduced(0, (rowHeight - sliderHeight) / 2));
+    bounds.removeFromTop(4);
+
+    // Pin render threads toggle
+    row = bounds.removeFromTop(toggleHeight + 8);
+    pinRenderThreadsToggle.setBounds(row.reduced(0, 4));
+    bounds.removeFromTop(4);
+
+    // Performance cores toggle
+    row = bounds.removeFromTop(toggleHeight + 8);
+    performanceCoresToggle.setBounds(row.reduced(0, 4));
+    bounds.removeFromTop(4);
+
+    // Live latency policy
+    row = bounds.removeFromTop(rowHeight);
+    liveLatencyLabel.setBounds(row.removeFromLeft(labelWidth));
+    liveLatencyCombo.setBounds(row.reduced(0, (rowHeight - sliderHeight) / 2));
+    bounds.removeFromTop(4);
+
+    // Live pre-render toggle
+    row = bounds.removeFromTop(toggleHeight + 8);
+    livePreRenderToggle.setBounds(row.reduced(0, 4));
 
     bounds.removeFromTop(sectionSpacing);
 
@@ -258,6 +328,17 @@ void PreferencesDialog::loadCurrentSettings() {
 
     // Load layout settings
     leftHandedLayoutToggle.setToggleState(config.getScrollbarOnLeft(), juce::dontSendNotification);
+    gpuRenderingToggle.setToggleState(config.getGpuRendering(), juce::dontSendNotification);
+
+    // Load audio engine settings
+    renderThreadsSlider.setValue(config.getRenderThreadCount(), juce::dontSendNotification);
+    pinRenderThreadsToggle.setToggleState(config.getRenderThreadPinning(),
+                                          juce::dontSendNotification);
+    performanceCoresToggle.setToggleState(config.getRenderThreadPerformanceCores(),
+                                          juce::dontSendNotification);
+    liveLatencyCombo.setSelectedId(juce::jlimit(0, 2, config.getLiveLatencyPolicy()) + 1,
+                                   juce::dontSendNotification);
+    livePreRenderToggle.setToggleState(config.getLivePreRender(), juce::dontSendNotification);
 }
 
 void PreferencesDialog::applySettings() {
@@ -285,10 +366,25 @@ void PreferencesDialog::applySettings() {
 
     // Apply layout settings
     config.setScrollbarOnLeft(leftHandedLayoutToggle.getToggleState());
+    config.setGpuRendering(gpuRenderingToggle.getToggleState());
+
+    // Apply audio engine settings
+    config.setRenderThreadCount(juce::roundToInt(renderThreadsSlider.getValue()));
+    config.setRenderThreadPinning(pinRenderThreadsToggle.getToggleState());
+    config.setRenderThreadPerformanceCores(performanceCoresToggle.getToggleState());
+    if (liveLatencyCombo.getSelectedId() > 0) {
+        config.setLiveLatencyPolicy(liveLatencyCombo.getSelectedId() - 1);
+    }
+    config.setLivePreRender(livePreRenderToggle.getToggleState());
+
+    if (onApplied) {
+        onApplied();
+    }
 }
 
-void PreferencesDialog::showDialog(juce::Component* parent) {
+void PreferencesDialog::showDialog(juce::Component* parent, std::function<void()> onApplied) {
     auto* dialog = new PreferencesDialog();
+    dialog->onApplied = std::move(onApplied);
 
     juce::DialogWindow::LaunchOptions options;
     options.dialogTitle = "Preferences";
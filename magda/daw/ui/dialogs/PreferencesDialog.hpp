@@ -2,11 +2,13 @@
 
 #include <juce_gui_basics/juce_gui_basics.h>
 
+#include <functional>
+
 namespace magda {
 
 /**
  * Preferences dialog for editing application configuration.
- * Displays organized sections for zoom, timeline, and transport settings.
+ * Displays organized sections for zoom, timeline, transport and audio engine settings.
  */
 class PreferencesDialog : public juce::Component {
   public:
@@ -20,7 +22,10 @@ class PreferencesDialog : public juce::Component {
     void applySettings();
 
     // Static method to show as modal dialog
-    static void showDialog(juce::Component* parent);
+    // onApplied runs after settings are written to Config, e.g. to re-apply engine settings
+    static void showDialog(juce::Component* parent, std::function<void()> onApplied = nullptr);
+
+    std::function<void()> onApplied;
 
   private:
     // Zoom section
@@ -43,6 +48,14 @@ class PreferencesDialog : public juce::Component {
 
     // Layout section
     juce::ToggleButton leftHandedLayoutToggle;
+    juce::ToggleButton gpuRenderingToggle;
+
+    // Audio engine section
+    juce::Slider renderThreadsSlider;
+    juce::ToggleButton pinRenderThreadsToggle;
+    juce::ToggleButton performanceCoresToggle;
+    juce::ComboBox liveLatencyCombo;  // Item ID is the Config policy + 1
+    juce::ToggleButton livePreRenderToggle;
 
     // Keyboard shortcuts section (read-only display for now)
     juce::Label shortcutsHeader;
@@ -58,6 +71,8 @@ class PreferencesDialog : public juce::Component {
     juce::Label zoomShiftLabel;
     juce::Label timelineLengthLabel;
     juce::Label viewDurationLabel;
+    juce::Label renderThreadsLabel;
+    juce::Label liveLatencyLabel;
 
     // Section headers
     juce::Label zoomHeader;
@@ -65,6 +80,7 @@ class PreferencesDialog : public juce::Component {
     juce::Label transportHeader;
     juce::Label panelsHeader;
     juce::Label layoutHeader;
+    juce::Label audioEngineHeader;
 
     // Buttons
     juce::TextButton okButton;
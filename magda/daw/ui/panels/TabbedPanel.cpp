@@ -256,6 +256,15 @@ PanelContent* TabbedPanel::getOrCreateContent(PanelContentType type) {
     return nullptr;
 }
 
+void TabbedPanel::prewarmContent(PanelContentType type) {
+    if (contentCache_.find(type) != contentCache_.end()) {
+        return;
+    }
+    if (auto* content = getOrCreateContent(type); content != nullptr && content != activeContent_) {
+        content->setVisible(false);
+    }
+}
+
 void TabbedPanel::setAudioEngine(magda::AudioEngine* engine) {
     audioEngine_ = engine;
 
@@ -70,6 +70,11 @@ class TabbedPanel : public juce::Component, public PanelStateListener {
      */
     void setTimelineController(magda::TimelineController* controller);
 
+    /**
+     * @brief Build a content type ahead of its first use, kept hidden until switched to
+     */
+    void prewarmContent(PanelContentType type);
+
   protected:
     /**
      * @brief Override to customize background painting
@@ -1,5 +1,7 @@
 #include "InspectorContent.hpp"
 
+#include <utility>
+
 #include "../../../audio/MidiBridge.hpp"
 #include "../../../engine/AudioEngine.hpp"
 #include "../../state/TimelineController.hpp"
@@ -10,6 +12,130 @@
 
 namespace magda::daw::ui {
 
+namespace {
+constexpr int kDeviceParamRowHeight = 50;
+}  // namespace
+
+//==============================================================================
+// DeviceParamRow - One parameter's controls, re-bound as the list scrolls
+//==============================================================================
+class InspectorContent::DeviceParamRow : public juce::Component {
+  public:
+    explicit DeviceParamRow(InspectorContent& owner) : owner_(owner) {
+        nameLabel_.setFont(FontManager::getInstance().getUIFont(11.0f));
+        nameLabel_.setColour(juce::Label::textColourId, DarkTheme::getTextColour());
+        nameLabel_.setInterceptsMouseClicks(false, false);
+        addAndMakeVisible(nameLabel_);
+
+        valueLabel_.setFont(FontManager::getInstance().getUIFont(10.0f));
+        valueLabel_.setColour(juce::Label::textColourId, DarkTheme::getSecondaryTextColour());
+        valueLabel_.setJustificationType(juce::Justification::centredRight);
+        valueLabel_.setInterceptsMouseClicks(false, false);
+        addAndMakeVisible(valueLabel_);
+
+        slider_.setSliderStyle(juce::Slider::LinearHorizontal);
+        slider_.setTextBoxStyle(juce::Slider::NoTextBox, false, 0, 0);
+        slider_.setColour(juce::Slider::trackColourId, DarkTheme::getColour(DarkTheme::SURFACE));
+        slider_.setColour(juce::Slider::thumbColourId,
+                          DarkTheme::getColour(DarkTheme::ACCENT_BLUE));
+        slider_.onValueChange = [this]() {
+            if (paramIndex_ >= 0) {
+                owner_.setDeviceParamValue(paramIndex_, static_cast<float>(slider_.getValue()));
+            }
+        };
+        addAndMakeVisible(slider_);
+    }
+
+    int getParamIndex() const {
+        return paramIndex_;
+    }
+
+    void bind(int paramIndex, const magda::ParameterInfo& param) {
+        // Only a different parameter needs its range rebuilt
+        if (paramIndex != paramIndex_ || !bound_ || param.minValue != minValue_ ||
+            param.maxValue != maxValue_ || param.scale != scale_) {
+            paramIndex_ = -1;  // Keep range changes from pushing values
+            slider_.setRange(param.minValue, param.maxValue, 0.0);
+            if (param.scale == magda::ParameterScale::Logarithmic) {
+                slider_.setSkewFactorFromMidPoint(std::sqrt(param.minValue * param.maxValue));
+            } else {
+                slider_.setSkewFactor(1.0);
+            }
+            minValue_ = param.minValue;
+            maxValue_ = param.maxValue;
+            scale_ = param.scale;
+            bound_ = true;
+        }
+        paramIndex_ = paramIndex;
+        nameLabel_.setText(param.name, juce::dontSendNotification);
+        showValue(param, param.currentValue);
+    }
+
+    void showValue(const magda::ParameterInfo& param, float value) {
+        slider_.setValue(value, juce::dontSendNotification);
+        valueLabel_.setText(formatDeviceParamValue(param, value), juce::dontSendNotification);
+    }
+
+    void resized() override {
+        const int nameWidth = 120;
+        const int valueWidth = 60;
+        const int padding = 8;
+
+        auto bounds = getLocalBounds().reduced(padding, 0).withTrimmedTop(padding);
+        auto top = bounds.removeFromTop(20);
+        valueLabel_.setBounds(top.removeFromRight(valueWidth));
+        nameLabel_.setBounds(top.removeFromLeft(nameWidth));
+        bounds.removeFromTop(2);
+        slider_.setBounds(bounds.removeFromTop(20));
+    }
+
+  private:
+    InspectorContent& owner_;
+    juce::Label nameLabel_;
+    juce::Label valueLabel_;
+    juce::Slider slider_;
+    int paramIndex_ = -1;
+    bool bound_ = false;
+    float minValue_ = 0.0f;
+    float maxValue_ = 1.0f;
+    magda::ParameterScale scale_ = magda::ParameterScale::Linear;
+};
+
+//==============================================================================
+// DeviceParamListModel - Serves rows from the parameter snapshot
+//==============================================================================
+class InspectorContent::DeviceParamListModel : public juce::ListBoxModel {
+  public:
+    explicit DeviceParamListModel(InspectorContent& owner) : owner_(owner) {}
+
+    int getNumRows() override {
+        return static_cast<int>(owner_.deviceParams_.size());
+    }
+
+    void paintListBoxItem(int, juce::Graphics&, int, int, bool) override {}
+
+    juce::Component* refreshComponentForRow(int row, bool,
+                                            juce::Component* existing) override {
+        auto* paramRow = dynamic_cast<DeviceParamRow*>(existing);
+        if (row < 0 || row >= getNumRows()) {
+            delete existing;
+            return nullptr;
+        }
+        if (paramRow == nullptr) {
+            delete existing;
+            paramRow = new DeviceParamRow(owner_);
+        }
+        paramRow->bind(row, std::as_const(owner_.deviceParams_)[static_cast<size_t>(row)]);
+        return paramRow;
+    }
+
+  private:
+    InspectorContent& owner_;
+};
+
+//==============================================================================
+// InspectorContent
+//==============================================================================
 InspectorContent::InspectorContent() {
     setName("Inspector");
 
@@ -305,15 +431,25 @@ InspectorContent::InspectorContent() {
         std::make_unique<magda::DraggableValueLabel>(magda::DraggableValueLabel::Format::MidiNote);
     notePitchValue_->setRange(0.0, 127.0, 60.0);  // MIDI note range
     notePitchValue_->onValueChange = [this]() {
-        if (noteSelection_.isValid() && noteSelection_.isSingleNote()) {
-            const auto* clip = magda::ClipManager::getInstance().getClip(noteSelection_.clipId);
-            if (clip && noteSelection_.noteIndices[0] < clip->midiNotes.size()) {
-                const auto& note = clip->midiNotes[noteSelection_.noteIndices[0]];
-                int newPitch = static_cast<int>(notePitchValue_->getValue());
-                auto cmd = std::make_unique<magda::MoveMidiNoteCommand>(
-                    noteSelection_.clipId, noteSelection_.noteIndices[0], note.startBeat, newPitch);
-                magda::UndoManager::getInstance().executeCommand(std::move(cmd));
-            }
+        if (!noteSelection_.isValid()) {
+            return;
+        }
+        const auto* clip = magda::ClipManager::getInstance().getClip(noteSelection_.clipId);
+        const auto* note = clip ? clip->midiNotes.find(noteSelection_.noteIds[0]) : nullptr;
+        if (!note) {
+            return;
+        }
+
+        int newPitch = static_cast<int>(notePitchValue_->getValue());
+        if (noteSelection_.isSingleNote()) {
+            auto cmd = std::make_unique<magda::MoveMidiNoteCommand>(
+                noteSelection_.clipId, noteSelection_.noteIds[0], note->startBeat, newPitch);
+            magda::UndoManager::getInstance().executeCommand(std::move(cmd));
+        } else {
+            // Transpose the whole selection by the first note's change
+            int delta = newPitch - note->noteNumber;
+            executeNoteEdit([delta](magda::MidiNote& n) { n.noteNumber += delta; },
+                            "Transpose MIDI Notes");
         }
     };
     addChildComponent(*notePitchValue_);
@@ -328,11 +464,18 @@ InspectorContent::InspectorContent() {
         std::make_unique<magda::DraggableValueLabel>(magda::DraggableValueLabel::Format::Integer);
     noteVelocityValue_->setRange(1.0, 127.0, 100.0);
     noteVelocityValue_->onValueChange = [this]() {
-        if (noteSelection_.isValid() && noteSelection_.isSingleNote()) {
-            int newVelocity = static_cast<int>(noteVelocityValue_->getValue());
+        if (!noteSelection_.isValid()) {
+            return;
+        }
+
+        int newVelocity = static_cast<int>(noteVelocityValue_->getValue());
+        if (noteSelection_.isSingleNote()) {
             auto cmd = std::make_unique<magda::SetMidiNoteVelocityCommand>(
-                noteSelection_.clipId, noteSelection_.noteIndices[0], newVelocity);
+                noteSelection_.clipId, noteSelection_.noteIds[0], newVelocity);
             magda::UndoManager::getInstance().executeCommand(std::move(cmd));
+        } else {
+            executeNoteEdit([newVelocity](magda::MidiNote& n) { n.velocity = newVelocity; },
+                            "Set Notes Velocity");
         }
     };
     addChildComponent(*noteVelocityValue_);
@@ -357,15 +500,28 @@ InspectorContent::InspectorContent() {
         std::make_unique<magda::DraggableValueLabel>(magda::DraggableValueLabel::Format::Beats);
     noteLengthValue_->setRange(0.0625, 16.0, 1.0);  // 1/16 note to 16 beats
     noteLengthValue_->onValueChange = [this]() {
-        if (noteSelection_.isValid() && noteSelection_.isSingleNote()) {
-            double newLength = noteLengthValue_->getValue();
+        if (!noteSelection_.isValid()) {
+            return;
+        }
+
+        double newLength = noteLengthValue_->getValue();
+        if (noteSelection_.isSingleNote()) {
             auto cmd = std::make_unique<magda::ResizeMidiNoteCommand>(
-                noteSelection_.clipId, noteSelection_.noteIndices[0], newLength);
+                noteSelection_.clipId, noteSelection_.noteIds[0], newLength);
             magda::UndoManager::getInstance().executeCommand(std::move(cmd));
+        } else {
+            executeNoteEdit([newLength](magda::MidiNote& n) { n.lengthBeats = newLength; },
+                            "Resize MIDI Notes");
         }
     };
     addChildComponent(*noteLengthValue_);
 
+    // A drag on any note value is one undo step
+    for (auto* label : {notePitchValue_.get(), noteVelocityValue_.get(), noteLengthValue_.get()}) {
+        label->onDragStart = [] { magda::UndoManager::getInstance().beginGesture(); };
+        label->onDragEnd = [] { magda::UndoManager::getInstance().endGesture(); };
+    }
+
     // ========================================================================
     // Chain node properties section
     // ========================================================================
@@ -392,9 +548,12 @@ InspectorContent::InspectorContent() {
     deviceParamsLabel_.setColour(juce::Label::textColourId, DarkTheme::getSecondaryTextColour());
     addChildComponent(deviceParamsLabel_);
 
-    deviceParamsViewport_.setViewedComponent(&deviceParamsContainer_, false);
-    deviceParamsViewport_.setScrollBarsShown(true, false);
-    addChildComponent(deviceParamsViewport_);
+    deviceParamsModel_ = std::make_unique<DeviceParamListModel>(*this);
+    deviceParamsList_.setModel(deviceParamsModel_.get());
+    deviceParamsList_.setRowHeight(kDeviceParamRowHeight);
+    deviceParamsList_.setColour(juce::ListBox::backgroundColourId,
+                                juce::Colours::transparentBlack);
+    addChildComponent(deviceParamsList_);
 
     // Register as listeners
     magda::TrackManager::getInstance().addListener(this);
@@ -412,6 +571,7 @@ InspectorContent::~InspectorContent() {
     magda::TrackManager::getInstance().removeListener(this);
     magda::ClipManager::getInstance().removeListener(this);
     magda::SelectionManager::getInstance().removeListener(this);
+    deviceParamsList_.setModel(nullptr);
 }
 
 void InspectorContent::setTimelineController(magda::TimelineController* controller) {
@@ -575,11 +735,8 @@ void InspectorContent::resized() {
 
             bounds.removeFromTop(4);
 
-            // Viewport takes remaining space
-            deviceParamsViewport_.setBounds(bounds);
-            DBG("InspectorContent::resized - deviceParamsViewport bounds: "
-                << bounds.toString() << " container size: " << deviceParamsContainer_.getWidth()
-                << "x" << deviceParamsContainer_.getHeight());
+            // List takes remaining space
+            deviceParamsList_.setBounds(bounds);
         }
     }
 }
@@ -626,43 +783,18 @@ void InspectorContent::trackSelectionChanged(magda::TrackId trackId) {
 
 void InspectorContent::deviceParameterChanged(magda::DeviceId deviceId, int paramIndex,
                                               float newValue) {
-    // Check if this parameter belongs to the currently selected device
-    if (!selectedChainNode_.isValid()) {
+    // Only the displayed device's parameters, and only rows in view need a repaint
+    if (deviceId != deviceParamsDeviceId_ || paramIndex < 0 ||
+        paramIndex >= static_cast<int>(deviceParams_.size())) {
         return;
     }
 
-    // Get the device ID from the current selection
-    magda::DeviceId selectedDeviceId = magda::INVALID_DEVICE_ID;
-
-    if (selectedChainNode_.getType() == magda::ChainNodeType::TopLevelDevice) {
-        selectedDeviceId = selectedChainNode_.topLevelDeviceId;
-    } else if (selectedChainNode_.getType() == magda::ChainNodeType::Device) {
-        auto resolved = magda::TrackManager::getInstance().resolvePath(selectedChainNode_);
-        if (resolved.valid && resolved.device) {
-            selectedDeviceId = resolved.device->id;
-        }
-    }
-
-    // If this is the selected device, update the UI
-    if (selectedDeviceId == deviceId) {
-        if (paramIndex >= 0 && paramIndex < static_cast<int>(deviceParamControls_.size())) {
-            auto* control = deviceParamControls_[paramIndex].get();
-            if (control) {
-                // Update slider without triggering callback
-                control->slider.setValue(newValue, juce::dontSendNotification);
-
-                // Update value label
-                const auto* device = magda::TrackManager::getInstance().getDevice(
-                    selectedChainNode_.trackId, deviceId);
-                if (device && paramIndex < static_cast<int>(device->parameters.size())) {
-                    const auto& param = device->parameters[paramIndex];
-                    juce::String valueText = juce::String(newValue, 2);
-                    if (param.unit.isNotEmpty()) {
-                        valueText += " " + param.unit;
-                    }
-                    control->valueLabel.setText(valueText, juce::dontSendNotification);
-                }
-            }
+    deviceParams_.setValue(static_cast<size_t>(paramIndex), newValue);
+    if (auto* row =
+            dynamic_cast<DeviceParamRow*>(deviceParamsList_.getComponentForRowNumber(paramIndex))) {
+        if (row->getParamIndex() == paramIndex) {
+            row->showValue(std::as_const(deviceParams_)[static_cast<size_t>(paramIndex)],
+                           newValue);
         }
     }
 }
@@ -1196,6 +1328,16 @@ void InspectorContent::updateFromSelectedChainNode() {
     repaint();
 }
 
+void InspectorContent::executeNoteEdit(const magda::EditMidiNotesCommand::Transform& transform,
+                                       const juce::String& description) {
+    // One command (and one clip notification) for the whole selection
+    auto cmd = std::make_unique<magda::EditMidiNotesCommand>(
+        noteSelection_.clipId, noteSelection_.noteIds, transform, description);
+    if (!cmd->isEmpty()) {
+        magda::UndoManager::getInstance().executeCommand(std::move(cmd));
+    }
+}
+
 void InspectorContent::updateFromSelectedNotes() {
     if (!noteSelection_.isValid()) {
         showNoteControls(false);
@@ -1219,9 +1361,8 @@ void InspectorContent::updateFromSelectedNotes() {
 
     if (noteSelection_.isSingleNote()) {
         // Single note - show editable properties
-        size_t noteIndex = noteSelection_.noteIndices[0];
-        if (noteIndex < clip->midiNotes.size()) {
-            const auto& note = clip->midiNotes[noteIndex];
+        if (const auto* selected = clip->midiNotes.find(noteSelection_.noteIds[0])) {
+            const auto& note = *selected;
 
             notePitchValue_->setValue(note.noteNumber, juce::dontSendNotification);
             noteVelocityValue_->setValue(note.velocity, juce::dontSendNotification);
@@ -1238,10 +1379,9 @@ void InspectorContent::updateFromSelectedNotes() {
         noteCountLabel_.setText(countStr, juce::dontSendNotification);
 
         // For multiple notes, show the first note's values (or could show average/common)
-        if (!noteSelection_.noteIndices.empty()) {
-            size_t firstIndex = noteSelection_.noteIndices[0];
-            if (firstIndex < clip->midiNotes.size()) {
-                const auto& note = clip->midiNotes[firstIndex];
+        if (!noteSelection_.noteIds.empty()) {
+            if (const auto* first = clip->midiNotes.find(noteSelection_.noteIds[0])) {
+                const auto& note = *first;
                 notePitchValue_->setValue(note.noteNumber, juce::dontSendNotification);
                 noteVelocityValue_->setValue(note.velocity, juce::dontSendNotification);
                 noteStartValue_.setText("--", juce::dontSendNotification);
@@ -1704,108 +1844,55 @@ void InspectorContent::createDeviceParamControls(const magda::DeviceInfo& device
     DBG("InspectorContent::createDeviceParamControls - device=" << device.name << " paramCount="
                                                                 << device.parameters.size());
 
-    // Clear existing controls
-    deviceParamControls_.clear();
-    deviceParamsContainer_.removeAllChildren();
+    // Rows are built on demand by the list model, so this is cheap for any parameter count
+    const bool sameDevice = device.id == deviceParamsDeviceId_ &&
+                            device.parameters.size() == deviceParams_.size();
+    deviceParams_ = device.parameters;
+    deviceParamsDeviceId_ = device.id;
+    deviceParamsPath_ = selectedChainNode_;
 
-    if (device.parameters.empty()) {
-        DBG("  No parameters to display");
-        deviceParamsContainer_.setSize(0, 0);
-        return;
+    deviceParamsList_.updateContent();
+    if (!sameDevice) {
+        deviceParamsList_.scrollToEnsureRowIsOnscreen(0);
     }
+    deviceParamsList_.repaint();
+}
 
-    const int rowHeight = 50;
-    const int nameWidth = 120;
-    const int valueWidth = 60;
-    const int padding = 8;
-    const int containerWidth = getWidth() - 20;  // Account for scrollbar
-
-    int y = padding;
-    for (size_t i = 0; i < device.parameters.size(); ++i) {
-        const auto& param = device.parameters[i];
-
-        auto control = std::make_unique<DeviceParamControl>();
-        control->paramIndex = static_cast<int>(i);
-
-        // Name label
-        control->nameLabel.setText(param.name, juce::dontSendNotification);
-        control->nameLabel.setFont(FontManager::getInstance().getUIFont(11.0f));
-        control->nameLabel.setColour(juce::Label::textColourId, DarkTheme::getTextColour());
-        control->nameLabel.setBounds(padding, y, nameWidth, 20);
-        deviceParamsContainer_.addAndMakeVisible(control->nameLabel);
-
-        // Value label (shows current value + unit)
-        juce::String valueText = juce::String(param.currentValue, 2);
-        if (param.unit.isNotEmpty()) {
-            valueText += " " + param.unit;
-        }
-        control->valueLabel.setText(valueText, juce::dontSendNotification);
-        control->valueLabel.setFont(FontManager::getInstance().getUIFont(10.0f));
-        control->valueLabel.setColour(juce::Label::textColourId,
-                                      DarkTheme::getSecondaryTextColour());
-        control->valueLabel.setJustificationType(juce::Justification::centredRight);
-        control->valueLabel.setBounds(containerWidth - valueWidth - padding, y, valueWidth, 20);
-        deviceParamsContainer_.addAndMakeVisible(control->valueLabel);
-
-        // Slider
-        control->slider.setSliderStyle(juce::Slider::LinearHorizontal);
-        control->slider.setTextBoxStyle(juce::Slider::NoTextBox, false, 0, 0);
-        control->slider.setColour(juce::Slider::trackColourId,
-                                  DarkTheme::getColour(DarkTheme::SURFACE));
-        control->slider.setColour(juce::Slider::thumbColourId,
-                                  DarkTheme::getColour(DarkTheme::ACCENT_BLUE));
-
-        // Set range based on parameter type
-        if (param.scale == magda::ParameterScale::Logarithmic) {
-            control->slider.setSkewFactorFromMidPoint(std::sqrt(param.minValue * param.maxValue));
-        }
-        control->slider.setRange(param.minValue, param.maxValue, 0.0);
-        control->slider.setValue(param.currentValue, juce::dontSendNotification);
-
-        // Wire up callback to update parameter via TrackManager
-        int paramIndex = static_cast<int>(i);
-        control->slider.onValueChange = [this, deviceId = device.id,
-                                         trackId = selectedChainNode_.trackId,
-                                         devicePath = selectedChainNode_, paramIndex]() {
-            auto* ctrl = deviceParamControls_[paramIndex].get();
-            if (ctrl) {
-                float newValue = static_cast<float>(ctrl->slider.getValue());
-
-                // Update value label
-                const auto* dev = magda::TrackManager::getInstance().getDevice(trackId, deviceId);
-                if (dev && paramIndex < static_cast<int>(dev->parameters.size())) {
-                    const auto& param = dev->parameters[paramIndex];
-                    juce::String valueText = juce::String(newValue, 2);
-                    if (param.unit.isNotEmpty()) {
-                        valueText += " " + param.unit;
-                    }
-                    ctrl->valueLabel.setText(valueText, juce::dontSendNotification);
-                }
+void InspectorContent::showDeviceParamControls(bool show) {
+    DBG("InspectorContent::showDeviceParamControls(" << (show ? "true" : "false") << ")");
+    deviceParamsLabel_.setVisible(show);
+    deviceParamsList_.setVisible(show);
 
-                // Push parameter change to audio engine
-                magda::TrackManager::getInstance().setDeviceParameterValue(devicePath, paramIndex,
-                                                                           newValue);
-            }
-        };
+    if (!show) {
+        deviceParams_.clear();
+        deviceParamsDeviceId_ = magda::INVALID_DEVICE_ID;
+        deviceParamsList_.updateContent();
+    }
+}
 
-        control->slider.setBounds(padding, y + 22, containerWidth - 2 * padding, 20);
-        deviceParamsContainer_.addAndMakeVisible(control->slider);
+void InspectorContent::setDeviceParamValue(int paramIndex, float newValue) {
+    if (paramIndex < 0 || paramIndex >= static_cast<int>(deviceParams_.size())) {
+        return;
+    }
 
-        deviceParamControls_.push_back(std::move(control));
-        y += rowHeight;
+    deviceParams_.setValue(static_cast<size_t>(paramIndex), newValue);
+    if (auto* row =
+            dynamic_cast<DeviceParamRow*>(deviceParamsList_.getComponentForRowNumber(paramIndex))) {
+        row->showValue(std::as_const(deviceParams_)[static_cast<size_t>(paramIndex)], newValue);
     }
 
-    // Set container size based on parameter count
-    deviceParamsContainer_.setSize(containerWidth, y);
-    DBG("  Created " << deviceParamControls_.size()
-                     << " param controls, container size=" << containerWidth << "x" << y);
+    // Push parameter change to audio engine
+    magda::TrackManager::getInstance().setDeviceParameterValue(deviceParamsPath_, paramIndex,
+                                                               newValue);
 }
 
-void InspectorContent::showDeviceParamControls(bool show) {
-    DBG("InspectorContent::showDeviceParamControls(" << (show ? "true" : "false") << ")");
-    deviceParamsLabel_.setVisible(show);
-    deviceParamsViewport_.setVisible(show);
-    deviceParamsContainer_.setVisible(show);
+juce::String InspectorContent::formatDeviceParamValue(const magda::ParameterInfo& param,
+                                                      float value) {
+    juce::String valueText = juce::String(value, 2);
+    if (param.unit.isNotEmpty()) {
+        valueText += " " + param.unit;
+    }
+    return valueText;
 }
 
 }  // namespace magda::daw::ui
@@ -4,6 +4,7 @@
 #include "../mixer/RoutingSelector.hpp"
 #include "PanelContent.hpp"
 #include "core/ClipManager.hpp"
+#include "core/MidiNoteCommands.hpp"
 #include "core/SelectionManager.hpp"
 #include "core/TrackManager.hpp"
 
@@ -148,22 +149,24 @@ class InspectorContent : public PanelContent,
     juce::Label macrosPanelTitleLabel_;
     juce::Label macrosPanelPathLabel_;
 
-    // Device parameters section
-    struct DeviceParamControl {
-        juce::Label nameLabel;
-        juce::Label valueLabel;
-        juce::Slider slider;
-        int paramIndex;
-    };
+    // Device parameters section - virtualised, only rows in view have components
+    class DeviceParamRow;
+    class DeviceParamListModel;
 
     juce::Label deviceParamsLabel_;
-    juce::Viewport deviceParamsViewport_;
-    juce::Component deviceParamsContainer_;
-    std::vector<std::unique_ptr<DeviceParamControl>> deviceParamControls_;
+    juce::ListBox deviceParamsList_;
+    std::unique_ptr<DeviceParamListModel> deviceParamsModel_;
+
+    // Snapshot of the displayed device's parameters, kept current by deviceParameterChanged
+    magda::ParameterList deviceParams_;
+    magda::DeviceId deviceParamsDeviceId_ = magda::INVALID_DEVICE_ID;
+    magda::ChainNodePath deviceParamsPath_;
 
     void updateFromSelectedTrack();
     void updateFromSelectedClip();
     void updateFromSelectedNotes();
+    void executeNoteEdit(const magda::EditMidiNotesCommand::Transform& transform,
+                         const juce::String& description);
     void updateFromSelectedChainNode();
     void updateFromSelectedModsPanel();
     void updateFromSelectedMacrosPanel();
@@ -183,6 +186,8 @@ class InspectorContent : public PanelContent,
 
     void createDeviceParamControls(const magda::DeviceInfo& device);
     void showDeviceParamControls(bool show);
+    void setDeviceParamValue(int paramIndex, float newValue);
+    static juce::String formatDeviceParamValue(const magda::ParameterInfo& param, float value);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(InspectorContent)
 };
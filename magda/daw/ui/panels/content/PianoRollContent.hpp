@@ -4,6 +4,7 @@
 
 #include "PanelContent.hpp"
 #include "core/ClipManager.hpp"
+#include "profiling/UIFrameProfiler.hpp"
 #include "ui/state/TimelineController.hpp"
 
 namespace magda {
@@ -40,6 +41,7 @@ class PianoRollContent : public PanelContent,
     }
 
     void paint(juce::Graphics& g) override;
+    void paintOverChildren(juce::Graphics& g) override;
     void resized() override;
     void mouseWheelMove(const juce::MouseEvent& e, const juce::MouseWheelDetails& wheel) override;
 
@@ -84,6 +86,8 @@ class PianoRollContent : public PanelContent,
   private:
     magda::ClipId editingClipId_ = magda::INVALID_CLIP_ID;
 
+    magda::UIFrameProfiler::Source paintProfile_{"PianoRoll"};  // paint() to paintOverChildren()
+
     // Layout constants
     static constexpr int SIDEBAR_WIDTH = 32;
     static constexpr int KEYBOARD_WIDTH = 60;
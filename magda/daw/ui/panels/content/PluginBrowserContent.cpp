@@ -41,6 +41,76 @@ PluginBrowserInfo PluginBrowserInfo::createInternal(const juce::String& name,
     return info;
 }
 
+namespace {
+
+// Auto-open every top-level group only while that stays cheap; larger single-level
+// groupings (manufacturer, format) start closed so their rows are built on demand
+constexpr size_t kMaxAutoOpenPlugins = 200;
+
+constexpr int kPluginRowHeight = 24;
+
+void paintPluginRow(juce::Graphics& g, const PluginBrowserInfo& plugin, int width, int height,
+                    bool isSelected) {
+    auto bounds = juce::Rectangle<int>(0, 0, width, height);
+
+    // Highlight if selected
+    if (isSelected) {
+        g.setColour(DarkTheme::getColour(DarkTheme::ACCENT_BLUE).withAlpha(0.3f));
+        g.fillRect(bounds);
+    }
+
+    // Favorite star
+    if (plugin.isFavorite) {
+        g.setColour(juce::Colours::gold);
+        g.setFont(FontManager::getInstance().getUIFont(10.0f));
+        g.drawText(juce::String::fromUTF8("★"), bounds.removeFromLeft(16),
+                   juce::Justification::centred);
+    } else {
+        bounds.removeFromLeft(16);
+    }
+
+    // Plugin type icon: 🎹 for instruments, 🎛️ for effects
+    g.setFont(FontManager::getInstance().getUIFont(11.0f));
+    if (plugin.category == "Instrument") {
+        g.drawText(juce::String::fromUTF8("🎹"), bounds.removeFromLeft(18),
+                   juce::Justification::centred);
+    } else {
+        g.drawText(juce::String::fromUTF8("🎛️"), bounds.removeFromLeft(18),
+                   juce::Justification::centred);
+    }
+    bounds.removeFromLeft(2);
+
+    // Plugin name
+    g.setColour(DarkTheme::getTextColour());
+    g.setFont(FontManager::getInstance().getUIFont(12.0f));
+    g.drawText(plugin.name, bounds.reduced(4, 0), juce::Justification::centredLeft);
+
+    // Format badge on the right
+    auto formatBounds = bounds.removeFromRight(40);
+    g.setColour(DarkTheme::getSecondaryTextColour());
+    g.setFont(FontManager::getInstance().getUIFont(9.0f));
+    g.drawText(plugin.format, formatBounds, juce::Justification::centredRight);
+}
+
+// Encode plugin info as a DynamicObject for drop targets
+juce::var createPluginDragDescription(const PluginBrowserInfo& plugin) {
+    auto* obj = new juce::DynamicObject();
+    obj->setProperty("type", "plugin");
+    obj->setProperty("name", plugin.name);
+    obj->setProperty("manufacturer", plugin.manufacturer);
+    obj->setProperty("category", plugin.category);
+    obj->setProperty("format", plugin.format);
+    obj->setProperty("subcategory", plugin.subcategory);
+    obj->setProperty("isInstrument", plugin.category == "Instrument");
+    obj->setProperty("isExternal", plugin.isExternal);
+    // External plugin identification
+    obj->setProperty("uniqueId", plugin.uniqueId);
+    obj->setProperty("fileOrIdentifier", plugin.fileOrIdentifier);
+    return juce::var(obj);
+}
+
+}  // namespace
+
 //==============================================================================
 // PluginTreeItem - Leaf item representing a single plugin
 //==============================================================================
@@ -54,45 +124,7 @@ class PluginBrowserContent::PluginTreeItem : public juce::TreeViewItem {
     }
 
     void paintItem(juce::Graphics& g, int width, int height) override {
-        auto bounds = juce::Rectangle<int>(0, 0, width, height);
-
-        // Highlight if selected
-        if (isSelected()) {
-            g.setColour(DarkTheme::getColour(DarkTheme::ACCENT_BLUE).withAlpha(0.3f));
-            g.fillRect(bounds);
-        }
-
-        // Favorite star
-        if (plugin_.isFavorite) {
-            g.setColour(juce::Colours::gold);
-            g.setFont(FontManager::getInstance().getUIFont(10.0f));
-            g.drawText(juce::String::fromUTF8("★"), bounds.removeFromLeft(16),
-                       juce::Justification::centred);
-        } else {
-            bounds.removeFromLeft(16);
-        }
-
-        // Plugin type icon: 🎹 for instruments, 🎛️ for effects
-        g.setFont(FontManager::getInstance().getUIFont(11.0f));
-        if (plugin_.category == "Instrument") {
-            g.drawText(juce::String::fromUTF8("🎹"), bounds.removeFromLeft(18),
-                       juce::Justification::centred);
-        } else {
-            g.drawText(juce::String::fromUTF8("🎛️"), bounds.removeFromLeft(18),
-                       juce::Justification::centred);
-        }
-        bounds.removeFromLeft(2);
-
-        // Plugin name
-        g.setColour(DarkTheme::getTextColour());
-        g.setFont(FontManager::getInstance().getUIFont(12.0f));
-        g.drawText(plugin_.name, bounds.reduced(4, 0), juce::Justification::centredLeft);
-
-        // Format badge on the right
-        auto formatBounds = bounds.removeFromRight(40);
-        g.setColour(DarkTheme::getSecondaryTextColour());
-        g.setFont(FontManager::getInstance().getUIFont(9.0f));
-        g.drawText(plugin_.format, formatBounds, juce::Justification::centredRight);
+        paintPluginRow(g, plugin_, width, height, isSelected());
     }
 
     void itemClicked(const juce::MouseEvent& e) override {
@@ -107,7 +139,7 @@ class PluginBrowserContent::PluginTreeItem : public juce::TreeViewItem {
     }
 
     int getItemHeight() const override {
-        return 24;
+        return kPluginRowHeight;
     }
 
     juce::String getUniqueName() const override {
@@ -116,20 +148,7 @@ class PluginBrowserContent::PluginTreeItem : public juce::TreeViewItem {
 
     // Enable drag-and-drop from plugin browser
     juce::var getDragSourceDescription() override {
-        // Encode plugin info as a DynamicObject for drop targets
-        auto* obj = new juce::DynamicObject();
-        obj->setProperty("type", "plugin");
-        obj->setProperty("name", plugin_.name);
-        obj->setProperty("manufacturer", plugin_.manufacturer);
-        obj->setProperty("category", plugin_.category);
-        obj->setProperty("format", plugin_.format);
-        obj->setProperty("subcategory", plugin_.subcategory);
-        obj->setProperty("isInstrument", plugin_.category == "Instrument");
-        obj->setProperty("isExternal", plugin_.isExternal);
-        // External plugin identification
-        obj->setProperty("uniqueId", plugin_.uniqueId);
-        obj->setProperty("fileOrIdentifier", plugin_.fileOrIdentifier);
-        return juce::var(obj);
+        return createPluginDragDescription(plugin_);
     }
 
     bool isInterestedInDragSource(const juce::DragAndDropTarget::SourceDetails&) override {
@@ -146,13 +165,38 @@ class PluginBrowserContent::PluginTreeItem : public juce::TreeViewItem {
 //==============================================================================
 class PluginBrowserContent::CategoryTreeItem : public juce::TreeViewItem {
   public:
-    CategoryTreeItem(const juce::String& name, const juce::String& icon = "")
-        : name_(name), icon_(icon) {}
+    CategoryTreeItem(PluginBrowserContent& owner, const juce::String& name,
+                     const juce::String& icon = "")
+        : owner_(owner), name_(name), icon_(icon) {}
+
+    void addSubCategory(CategoryTreeItem* category) {
+        addSubItem(category);
+        numSubCategories_++;
+    }
+
+    // Plugin rows are only created while the folder is open
+    void addPlugin(size_t pluginIndex) {
+        pluginIndices_.push_back(pluginIndex);
+    }
 
     bool mightContainSubItems() override {
         return true;
     }
 
+    void itemOpennessChanged(bool isNowOpen) override {
+        if (isNowOpen && !populated_) {
+            for (auto index : pluginIndices_) {
+                addSubItem(new PluginTreeItem(owner_.plugins_[index], owner_));
+            }
+            populated_ = true;
+        } else if (!isNowOpen && populated_) {
+            while (getNumSubItems() > numSubCategories_) {
+                removeSubItem(getNumSubItems() - 1);
+            }
+            populated_ = false;
+        }
+    }
+
     void paintItem(juce::Graphics& g, int width, int height) override {
         auto bounds = juce::Rectangle<int>(0, 0, width, height);
 
@@ -183,7 +227,8 @@ class PluginBrowserContent::CategoryTreeItem : public juce::TreeViewItem {
         auto countBounds = bounds.removeFromRight(40);
         g.setColour(DarkTheme::getSecondaryTextColour());
         g.setFont(FontManager::getInstance().getUIFont(10.0f));
-        g.drawText("(" + juce::String(getNumSubItems()) + ")", countBounds,
+        auto count = numSubCategories_ + static_cast<int>(pluginIndices_.size());
+        g.drawText("(" + juce::String(count) + ")", countBounds,
                    juce::Justification::centredRight);
     }
 
@@ -201,8 +246,66 @@ class PluginBrowserContent::CategoryTreeItem : public juce::TreeViewItem {
     }
 
   private:
+    PluginBrowserContent& owner_;
     juce::String name_;
     juce::String icon_;
+    int numSubCategories_ = 0;
+    std::vector<size_t> pluginIndices_;
+    bool populated_ = false;
+};
+
+//==============================================================================
+// SearchResultsModel - Virtualised list of search hits (only visible rows are painted)
+//==============================================================================
+class PluginBrowserContent::SearchResultsModel : public juce::ListBoxModel {
+  public:
+    explicit SearchResultsModel(PluginBrowserContent& owner) : owner_(owner) {}
+
+    int getNumRows() override {
+        return static_cast<int>(owner_.searchResultIds_.size());
+    }
+
+    void paintListBoxItem(int row, juce::Graphics& g, int width, int height,
+                          bool rowIsSelected) override {
+        if (const auto* plugin = getPlugin(row)) {
+            paintPluginRow(g, *plugin, width, height, rowIsSelected);
+        }
+    }
+
+    void listBoxItemClicked(int row, const juce::MouseEvent& e) override {
+        if (e.mods.isRightButtonDown()) {
+            if (const auto* plugin = getPlugin(row)) {
+                owner_.showPluginContextMenu(*plugin, e.getScreenPosition());
+            }
+        }
+    }
+
+    void listBoxItemDoubleClicked(int row, const juce::MouseEvent&) override {
+        if (const auto* plugin = getPlugin(row)) {
+            // Would add plugin to selected track's FX chain
+            DBG("Double-clicked plugin: " + plugin->name);
+        }
+    }
+
+    juce::var getDragSourceDescription(const juce::SparseSet<int>& rows) override {
+        if (rows.isEmpty()) {
+            return {};
+        }
+        if (const auto* plugin = getPlugin(rows[0])) {
+            return createPluginDragDescription(*plugin);
+        }
+        return {};
+    }
+
+  private:
+    const PluginBrowserInfo* getPlugin(int row) const {
+        if (row < 0 || row >= static_cast<int>(owner_.searchResultIds_.size())) {
+            return nullptr;
+        }
+        return &owner_.plugins_[owner_.searchResultIds_[static_cast<size_t>(row)]];
+    }
+
+    PluginBrowserContent& owner_;
 };
 
 //==============================================================================
@@ -286,11 +389,25 @@ PluginBrowserContent::PluginBrowserContent() {
     pluginTree_.setOpenCloseButtonsVisible(false);  // We draw our own
     addAndMakeVisible(pluginTree_);
 
+    // Setup search results list (replaces the tree while a search is active)
+    searchResultsModel_ = std::make_unique<SearchResultsModel>(*this);
+    searchResults_.setModel(searchResultsModel_.get());
+    searchResults_.setRowHeight(kPluginRowHeight);
+    searchResults_.setColour(juce::ListBox::backgroundColourId,
+                             DarkTheme::getColour(DarkTheme::PANEL_BACKGROUND));
+    addChildComponent(searchResults_);
+
     // Build internal plugins and tree (external plugins are loaded when engine is set)
     buildInternalPluginList();
+    rebuildSearchIndex();
     rebuildTree();
 }
 
+PluginBrowserContent::~PluginBrowserContent() {
+    searchResults_.setModel(nullptr);
+    pluginTree_.setRootItem(nullptr);
+}
+
 void PluginBrowserContent::paint(juce::Graphics& g) {
     g.fillAll(DarkTheme::getPanelBackgroundColour());
 }
@@ -319,8 +436,9 @@ void PluginBrowserContent::resized() {
 
     bounds.removeFromTop(6);
 
-    // Tree view takes remaining space
+    // Tree view (or search results) takes remaining space
     pluginTree_.setBounds(bounds);
+    searchResults_.setBounds(bounds);
 }
 
 void PluginBrowserContent::onActivated() {
@@ -369,7 +487,9 @@ void PluginBrowserContent::refreshPluginList() {
     plugins_.clear();
     buildInternalPluginList();
     loadExternalPlugins();
+    rebuildSearchIndex();
     rebuildTree();
+    filterBySearch(searchBox_.getText());
 }
 
 void PluginBrowserContent::startPluginScan() {
@@ -455,11 +575,12 @@ void PluginBrowserContent::rebuildTree() {
     rootItem_.reset();
 
     // Create root based on view mode
-    auto root = std::make_unique<CategoryTreeItem>("Plugins");
+    auto root = std::make_unique<CategoryTreeItem>(*this, "Plugins");
 
     std::map<juce::String, CategoryTreeItem*> categories;
 
-    for (const auto& plugin : plugins_) {
+    for (size_t i = 0; i < plugins_.size(); ++i) {
+        const auto& plugin = plugins_[i];
         juce::String groupKey;
 
         switch (currentViewMode_) {
@@ -487,8 +608,8 @@ void PluginBrowserContent::rebuildTree() {
 
             // Create parent category if needed
             if (categories.find(parentKey) == categories.end()) {
-                auto parentItem = new CategoryTreeItem(parentKey);
-                root->addSubItem(parentItem);
+                auto parentItem = new CategoryTreeItem(*this, parentKey);
+                root->addSubCategory(parentItem);
                 categories[parentKey] = parentItem;
             }
 
@@ -496,22 +617,22 @@ void PluginBrowserContent::rebuildTree() {
             if (childKey.isNotEmpty()) {
                 juce::String fullKey = parentKey + "/" + childKey;
                 if (categories.find(fullKey) == categories.end()) {
-                    auto childItem = new CategoryTreeItem(childKey);
-                    categories[parentKey]->addSubItem(childItem);
+                    auto childItem = new CategoryTreeItem(*this, childKey);
+                    categories[parentKey]->addSubCategory(childItem);
                     categories[fullKey] = childItem;
                 }
-                categories[fullKey]->addSubItem(new PluginTreeItem(plugin, *this));
+                categories[fullKey]->addPlugin(i);
             } else {
-                categories[parentKey]->addSubItem(new PluginTreeItem(plugin, *this));
+                categories[parentKey]->addPlugin(i);
             }
         } else {
             // Single-level grouping
             if (categories.find(groupKey) == categories.end()) {
-                auto item = new CategoryTreeItem(groupKey);
-                root->addSubItem(item);
+                auto item = new CategoryTreeItem(*this, groupKey);
+                root->addSubCategory(item);
                 categories[groupKey] = item;
             }
-            categories[groupKey]->addSubItem(new PluginTreeItem(plugin, *this));
+            categories[groupKey]->addPlugin(i);
         }
     }
 
@@ -519,36 +640,42 @@ void PluginBrowserContent::rebuildTree() {
     pluginTree_.setRootItem(rootItem_.get());
     pluginTree_.setRootItemVisible(false);
 
-    // Open first level
-    for (int i = 0; i < rootItem_->getNumSubItems(); ++i) {
-        rootItem_->getSubItem(i)->setOpen(true);
+    // Open first level (in category view that only reveals the subcategory folders)
+    if (currentViewMode_ == ViewMode::ByCategory || plugins_.size() <= kMaxAutoOpenPlugins) {
+        for (int i = 0; i < rootItem_->getNumSubItems(); ++i) {
+            rootItem_->getSubItem(i)->setOpen(true);
+        }
+    }
+}
+
+void PluginBrowserContent::rebuildSearchIndex() {
+    std::vector<magda::PluginSearchIndex::Entry> entries;
+    entries.reserve(plugins_.size());
+    for (const auto& plugin : plugins_) {
+        entries.push_back({plugin.name.toStdString(), plugin.manufacturer.toStdString(),
+                           (plugin.category + " " + plugin.subcategory).toStdString(),
+                           plugin.format.toStdString()});
     }
+    searchIndex_.build(entries);
 }
 
 void PluginBrowserContent::filterBySearch(const juce::String& searchText) {
-    // For now just rebuild - a real implementation would filter the tree
-    if (searchText.isEmpty()) {
-        rebuildTree();
+    if (searchText.trim().isEmpty()) {
+        searchResultIds_.clear();
+        searchResults_.updateContent();
+        searchResults_.setVisible(false);
+        pluginTree_.setVisible(true);
         return;
     }
 
-    pluginTree_.setRootItem(nullptr);
-    rootItem_.reset();
-
-    auto root = std::make_unique<CategoryTreeItem>("Search Results");
+    searchResultIds_ = searchIndex_.search(searchText.toStdString());
+    searchResults_.deselectAllRows();
+    searchResults_.updateContent();
+    searchResults_.scrollToEnsureRowIsOnscreen(0);
+    searchResults_.repaint();
 
-    for (const auto& plugin : plugins_) {
-        if (plugin.name.containsIgnoreCase(searchText) ||
-            plugin.manufacturer.containsIgnoreCase(searchText) ||
-            plugin.subcategory.containsIgnoreCase(searchText)) {
-            root->addSubItem(new PluginTreeItem(plugin, *this));
-        }
-    }
-
-    rootItem_ = std::move(root);
-    pluginTree_.setRootItem(rootItem_.get());
-    pluginTree_.setRootItemVisible(false);
-    rootItem_->setOpen(true);
+    pluginTree_.setVisible(false);
+    searchResults_.setVisible(true);
 }
 
 void PluginBrowserContent::showPluginContextMenu(const PluginBrowserInfo& plugin,
@@ -4,6 +4,7 @@
 #include <juce_gui_basics/juce_gui_basics.h>
 
 #include "PanelContent.hpp"
+#include "core/PluginSearchIndex.hpp"
 
 namespace magda {
 class TracktionEngineWrapper;
@@ -41,11 +42,15 @@ struct PluginBrowserInfo {
  *
  * Displays a tree view of available plugins organized by category,
  * with search functionality and right-click parameter configuration.
+ *
+ * Tree folders only create their plugin rows when opened, and search queries a
+ * prebuilt PluginSearchIndex and shows the hits in a virtualised list box, so
+ * neither typing nor browsing scales with the size of the plugin list.
  */
 class PluginBrowserContent : public PanelContent, public juce::TreeViewItem {
   public:
     PluginBrowserContent();
-    ~PluginBrowserContent() override = default;
+    ~PluginBrowserContent() override;
 
     PanelContentType getContentType() const override {
         return PanelContentType::PluginBrowser;
@@ -80,6 +85,7 @@ class PluginBrowserContent : public PanelContent, public juce::TreeViewItem {
     // UI Components
     juce::TextEditor searchBox_;
     juce::TreeView pluginTree_;
+    juce::ListBox searchResults_;
     juce::ComboBox viewModeSelector_;
     juce::TextButton scanButton_;
     juce::TextButton clearButton_;
@@ -97,6 +103,10 @@ class PluginBrowserContent : public PanelContent, public juce::TreeViewItem {
     std::vector<PluginBrowserInfo> plugins_;
     magda::TracktionEngineWrapper* engine_ = nullptr;  // For plugin scanning
 
+    // Search (indices into plugins_)
+    magda::PluginSearchIndex searchIndex_;
+    std::vector<uint32_t> searchResultIds_;
+
     // Progress display during scan
     std::unique_ptr<juce::Label> scanProgressLabel_;
     float scanProgress_ = 0.0f;
@@ -106,6 +116,7 @@ class PluginBrowserContent : public PanelContent, public juce::TreeViewItem {
     void buildInternalPluginList();
     void loadExternalPlugins();
     void rebuildTree();
+    void rebuildSearchIndex();
     void filterBySearch(const juce::String& searchText);
 
     // Plugin scanning
@@ -120,8 +131,10 @@ class PluginBrowserContent : public PanelContent, public juce::TreeViewItem {
 
     class PluginTreeItem;
     class CategoryTreeItem;
+    class SearchResultsModel;
 
     std::unique_ptr<juce::TreeViewItem> rootItem_;
+    std::unique_ptr<SearchResultsModel> searchResultsModel_;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PluginBrowserContent)
 };
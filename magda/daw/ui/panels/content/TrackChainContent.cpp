@@ -19,15 +19,14 @@
 #include "ui/components/chain/RackComponent.hpp"
 #include "ui/components/common/SvgButton.hpp"
 #include "ui/components/common/TextSlider.hpp"
+#include "ui/utils/FrameScheduler.hpp"
 
 namespace magda::daw::ui {
 
 //==============================================================================
 // GainMeterComponent - Vertical gain slider with peak meter background
 //==============================================================================
-class GainMeterComponent : public juce::Component,
-                           public juce::Label::Listener,
-                           private juce::Timer {
+class GainMeterComponent : public juce::Component, public juce::Label::Listener {
   public:
     GainMeterComponent() {
         // Editable label for dB value
@@ -46,12 +45,8 @@ class GainMeterComponent : public juce::Component,
 
         updateLabel();
 
-        // Start timer for mock meter animation
-        startTimerHz(30);
-    }
-
-    ~GainMeterComponent() override {
-        stopTimer();
+        // Mock meter animation eases towards the gain, then idles until it changes
+        frameClient_.setActive(true);
     }
 
     void setGainDb(double db, juce::NotificationType notification = juce::sendNotification) {
@@ -59,6 +54,7 @@ class GainMeterComponent : public juce::Component,
         if (std::abs(gainDb_ - db) > 0.01) {
             gainDb_ = db;
             updateLabel();
+            frameClient_.setActive(true);
             repaint();
             if (notification != juce::dontSendNotification && onGainChanged) {
                 onGainChanged(gainDb_);
@@ -189,16 +185,21 @@ class GainMeterComponent : public juce::Component,
         setGainDb(db);
     }
 
-    void timerCallback() override {
-        // Mock meter animation - simulate audio activity
+    void updateMockMeter() {
+        // Mock meter animation - follow the gain
         // In real implementation, this would receive actual audio levels
-        float targetLevel = static_cast<float>((gainDb_ + 60.0) / 66.0) * 0.8f;
-        targetLevel += (juce::Random::getSystemRandom().nextFloat() - 0.5f) * 0.1f;
+        const float targetLevel = static_cast<float>((gainDb_ + 60.0) / 66.0) * 0.8f;
         meterLevel_ = meterLevel_ * 0.9f + targetLevel * 0.1f;
         meterLevel_ = juce::jlimit(0.0f, 1.0f, meterLevel_);
+        if (std::abs(meterLevel_ - targetLevel) < 0.001f) {
+            meterLevel_ = targetLevel;
+            frameClient_.setActive(false);
+        }
         repaint();
     }
 
+    magda::FrameScheduler::Client frameClient_{*this, 30.0, [this]() { updateMockMeter(); }};
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(GainMeterComponent)
 };
 
@@ -1016,28 +1017,53 @@ void TrackChainContent::showHeader(bool show) {
 }
 
 void TrackChainContent::rebuildNodeComponents() {
-    // Save node states (collapsed, expanded chains) BEFORE clearing components
+    // Save node states (collapsed, expanded chains) for nodes that get recreated
     saveNodeStates();
 
-    // Clear existing components
-    unfocusAllComponents();
-    nodeComponents_.clear();
-
     if (selectedTrackId_ == magda::INVALID_TRACK_ID) {
+        unfocusAllComponents();
+        nodeComponents_.clear();
         return;
     }
 
+    // Smart rebuild: nodes still in the chain are kept (by path, so another track's nodes
+    // never match) and updated in place; only added elements get new components
+    auto existingNodes = std::move(nodeComponents_);
+    nodeComponents_.clear();
+    std::vector<NodeComponent*> createdNodes;
+
+    auto takeExisting = [&existingNodes](const magda::ChainNodePath& path) {
+        std::unique_ptr<NodeComponent> node;
+        for (auto it = existingNodes.begin(); it != existingNodes.end(); ++it) {
+            if ((*it)->getNodePath() == path) {
+                node = std::move(*it);
+                existingNodes.erase(it);
+                break;
+            }
+        }
+        return node;
+    };
+
     const auto& elements = magda::TrackManager::getInstance().getChainElements(selectedTrackId_);
 
-    // Create a component for each chain element
+    // Keep or create a component for each chain element
     for (size_t i = 0; i < elements.size(); ++i) {
         const auto& element = elements[i];
 
         if (magda::isDevice(element)) {
-            // Create device slot component
             const auto& device = magda::getDevice(element);
+            const auto path = magda::ChainNodePath::topLevelDevice(selectedTrackId_, device.id);
+            if (auto existing = takeExisting(path)) {
+                if (auto* existingSlot = dynamic_cast<DeviceSlotComponent*>(existing.get())) {
+                    existingSlot->updateFromDevice(device);
+                    nodeComponents_.push_back(std::move(existing));
+                    continue;
+                }
+            }
+
+            // Create device slot component
             auto slot = std::make_unique<DeviceSlotComponent>(device);
-            slot->setNodePath(magda::ChainNodePath::topLevelDevice(selectedTrackId_, device.id));
+            slot->setNodePath(path);
 
             // Wire up device-specific callbacks
             slot->onDeviceLayoutChanged = [this]() {
@@ -1094,13 +1120,24 @@ void TrackChainContent::rebuildNodeComponents() {
             };
 
             chainContainer_->addAndMakeVisible(*slot);
+            createdNodes.push_back(slot.get());
             nodeComponents_.push_back(std::move(slot));
 
         } else if (magda::isRack(element)) {
-            // Create rack component
             const auto& rack = magda::getRack(element);
+            const auto path = magda::ChainNodePath::rack(selectedTrackId_, rack.id);
+            if (auto existing = takeExisting(path)) {
+                if (auto* existingRack = dynamic_cast<RackComponent*>(existing.get())) {
+                    // Reconciles its own chain rows and open chain panel
+                    existingRack->updateFromRack(rack);
+                    nodeComponents_.push_back(std::move(existing));
+                    continue;
+                }
+            }
+
+            // Create rack component
             auto rackComp = std::make_unique<RackComponent>(selectedTrackId_, rack);
-            rackComp->setNodePath(magda::ChainNodePath::rack(selectedTrackId_, rack.id));
+            rackComp->setNodePath(path);
 
             // Wire up callbacks
             rackComp->onSelected = [this]() { selectedDeviceId_ = magda::INVALID_DEVICE_ID; };
@@ -1170,21 +1207,29 @@ void TrackChainContent::rebuildNodeComponents() {
             };
 
             chainContainer_->addAndMakeVisible(*rackComp);
+            createdNodes.push_back(rackComp.get());
             nodeComponents_.push_back(std::move(rackComp));
         }
     }
 
-    // Restore node states (collapsed, expanded chains) for ALL nodes
-    restoreNodeStates();
+    // Nodes whose elements were removed leave the container as they are destroyed
+    if (!existingNodes.empty()) {
+        unfocusAllComponents();
+        existingNodes.clear();
+    }
+
+    // Kept nodes still have their state; restore it for the ones just created
+    for (auto* node : createdNodes) {
+        restoreNodeState(*node);
+    }
 
-    // Restore selection state from SelectionManager
+    // Restore selection state from SelectionManager (kept nodes may have been selected)
     const auto& selectedPath = magda::SelectionManager::getInstance().getSelectedChainNode();
-    if (selectedPath.isValid() && selectedPath.trackId == selectedTrackId_) {
-        for (auto& node : nodeComponents_) {
-            if (node->getNodePath() == selectedPath) {
-                node->setSelected(true);
-                break;
-            }
+    const bool selectionHere = selectedPath.isValid() && selectedPath.trackId == selectedTrackId_;
+    for (auto& node : nodeComponents_) {
+        const bool selected = selectionHere && node->getNodePath() == selectedPath;
+        if (node->isSelected() != selected) {
+            node->setSelected(selected);
         }
     }
 
@@ -1337,30 +1382,29 @@ void TrackChainContent::saveNodeStates() {
     }
 }
 
-void TrackChainContent::restoreNodeStates() {
-    for (auto& node : nodeComponents_) {
-        const auto& path = node->getNodePath();
-        if (path.isValid()) {
-            // Restore collapsed state
-            auto collapsedIt = savedCollapsedStates_.find(path.toString());
-            if (collapsedIt != savedCollapsedStates_.end()) {
-                node->setCollapsed(collapsedIt->second);
-            }
+void TrackChainContent::restoreNodeState(NodeComponent& node) {
+    const auto& path = node.getNodePath();
+    if (!path.isValid()) {
+        return;
+    }
 
-            // Restore param panel (macro panel) visible state
-            auto paramIt = savedParamPanelStates_.find(path.toString());
-            if (paramIt != savedParamPanelStates_.end() && paramIt->second) {
-                node->setParamPanelVisible(true);
-            }
+    // Restore collapsed state
+    auto collapsedIt = savedCollapsedStates_.find(path.toString());
+    if (collapsedIt != savedCollapsedStates_.end()) {
+        node.setCollapsed(collapsedIt->second);
+    }
 
-            // Restore expanded chain for racks
-            if (auto* rack = dynamic_cast<RackComponent*>(node.get())) {
-                auto chainIt = savedExpandedChains_.find(path.toString());
-                if (chainIt != savedExpandedChains_.end() &&
-                    chainIt->second != magda::INVALID_CHAIN_ID) {
-                    rack->showChainPanel(chainIt->second);
-                }
-            }
+    // Restore param panel (macro panel) visible state
+    auto paramIt = savedParamPanelStates_.find(path.toString());
+    if (paramIt != savedParamPanelStates_.end() && paramIt->second) {
+        node.setParamPanelVisible(true);
+    }
+
+    // Restore expanded chain for racks
+    if (auto* rack = dynamic_cast<RackComponent*>(&node)) {
+        auto chainIt = savedExpandedChains_.find(path.toString());
+        if (chainIt != savedExpandedChains_.end() && chainIt->second != magda::INVALID_CHAIN_ID) {
+            rack->showChainPanel(chainIt->second);
         }
     }
 }
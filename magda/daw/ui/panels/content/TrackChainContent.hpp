@@ -161,12 +161,12 @@ class TrackChainContent : public PanelContent,
     // External drop state (plugin drops from browser)
     int dropInsertIndex_ = -1;
 
-    // State preservation during rebuild - preserves ALL nodes' states
+    // State preservation for nodes recreated by a rebuild (kept nodes keep their own)
     std::map<juce::String, bool> savedCollapsedStates_;           // path -> collapsed
     std::map<juce::String, magda::ChainId> savedExpandedChains_;  // rackPath -> expanded chainId
     std::map<juce::String, bool> savedParamPanelStates_;          // path -> paramPanelVisible
     void saveNodeStates();
-    void restoreNodeStates();
+    void restoreNodeState(NodeComponent& node);
 
     // Helper methods for drag-to-reorder
     int findNodeIndex(NodeComponent* node) const;
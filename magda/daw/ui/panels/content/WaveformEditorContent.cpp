@@ -5,6 +5,8 @@
 #include "../../state/TimelineController.hpp"
 #include "../../themes/DarkTheme.hpp"
 #include "../../themes/FontManager.hpp"
+#include "audio/TempoCache.hpp"
+#include "core/ClipOperations.hpp"
 
 namespace magda::daw::ui {
 
@@ -168,6 +170,25 @@ WaveformEditorContent::WaveformEditorContent() {
     timeModeButton_->onClick = [this]() { setRelativeTimeMode(timeModeButton_->getToggleState()); };
     addAndMakeVisible(timeModeButton_.get());
 
+    // Create waveform/spectrogram toggle button
+    spectrogramButton_ = std::make_unique<juce::TextButton>("SPEC");
+    spectrogramButton_->setTooltip("Show the frequency content instead of the waveform");
+    spectrogramButton_->setClickingTogglesState(true);
+    spectrogramButton_->setLookAndFeel(buttonLookAndFeel_.get());
+    spectrogramButton_->onClick = [this]() {
+        gridComponent_->setSpectrogramMode(spectrogramButton_->getToggleState());
+    };
+    addAndMakeVisible(spectrogramButton_.get());
+
+    // Create tempo button: shows the audio's detected tempo, stretches it to the project's
+    tempoButton_ = std::make_unique<juce::TextButton>("-- BPM");
+    tempoButton_->setTooltip("Detected tempo of the audio. Click to stretch the clip to the "
+                             "project tempo");
+    tempoButton_->setLookAndFeel(buttonLookAndFeel_.get());
+    tempoButton_->onClick = [this]() { matchClipToTempo(); };
+    addAndMakeVisible(tempoButton_.get());
+    magda::TempoCache::getInstance().addListener(this);
+
     // Create waveform grid component
     gridComponent_ = std::make_unique<WaveformGridComponent>();
     gridComponent_->setRelativeMode(relativeTimeMode_);
@@ -224,11 +245,18 @@ WaveformEditorContent::~WaveformEditorContent() {
     }
 
     magda::ClipManager::getInstance().removeListener(this);
+    magda::TempoCache::getInstance().removeListener(this);
 
     // Clear look and feel before destruction
     if (timeModeButton_) {
         timeModeButton_->setLookAndFeel(nullptr);
     }
+    if (spectrogramButton_) {
+        spectrogramButton_->setLookAndFeel(nullptr);
+    }
+    if (tempoButton_) {
+        tempoButton_->setLookAndFeel(nullptr);
+    }
 }
 
 // ============================================================================
@@ -249,6 +277,8 @@ void WaveformEditorContent::resized() {
     if (bounds.getHeight() < minHeight || bounds.getWidth() <= 0) {
         // Hide everything when too small to avoid zero-sized paint
         timeModeButton_->setBounds(0, 0, 0, 0);
+        spectrogramButton_->setBounds(0, 0, 0, 0);
+        tempoButton_->setBounds(0, 0, 0, 0);
         timeRuler_->setBounds(0, 0, 0, 0);
         viewport_->setBounds(0, 0, 0, 0);
         if (playheadOverlay_)
@@ -259,6 +289,8 @@ void WaveformEditorContent::resized() {
     // Toolbar at top
     auto toolbarArea = bounds.removeFromTop(TOOLBAR_HEIGHT);
     timeModeButton_->setBounds(toolbarArea.removeFromLeft(60).reduced(2));
+    spectrogramButton_->setBounds(toolbarArea.removeFromLeft(60).reduced(2));
+    tempoButton_->setBounds(toolbarArea.removeFromLeft(80).reduced(2));
 
     // Time ruler below toolbar
     auto rulerArea = bounds.removeFromTop(TIME_RULER_HEIGHT);
@@ -391,6 +423,7 @@ void WaveformEditorContent::clipsChanged() {
         if (!clip) {
             editingClipId_ = magda::INVALID_CLIP_ID;
             gridComponent_->setClip(magda::INVALID_CLIP_ID);
+            updateTempoButton();
         }
     }
 }
@@ -419,6 +452,7 @@ void WaveformEditorContent::clipPropertyChanged(magda::ClipId clipId) {
             scrollToClipStart();
         }
 
+        updateTempoButton();
         updateGridSize();
         repaint();
     }
@@ -452,6 +486,14 @@ void WaveformEditorContent::playheadStateChanged(const TimelineState& state) {
     }
 }
 
+// ============================================================================
+// ChangeListener
+// ============================================================================
+
+void WaveformEditorContent::changeListenerCallback(juce::ChangeBroadcaster* /*source*/) {
+    updateTempoButton();
+}
+
 // ============================================================================
 // Public Methods
 // ============================================================================
@@ -477,6 +519,7 @@ void WaveformEditorContent::setClip(magda::ClipId clipId) {
             timeRuler_->setClipLength(clip->length);
         }
 
+        updateTempoButton();
         updateGridSize();
         scrollToClipStart();
         repaint();
@@ -519,6 +562,35 @@ void WaveformEditorContent::updateGridSize() {
     }
 }
 
+void WaveformEditorContent::updateTempoButton() {
+    std::shared_ptr<const magda::TempoAnalysis> analysis;
+    const auto* clip = magda::ClipManager::getInstance().getClip(editingClipId_);
+    if (clip && !clip->audioSources.empty()) {
+        // Starts the analysis if the file has none yet; the cache calls back when it's done
+        analysis = magda::TempoCache::getInstance().getAnalysis(clip->audioSources[0].filePath);
+    }
+
+    const bool hasTempo = analysis != nullptr && analysis->hasTempo();
+    tempoButton_->setButtonText(hasTempo ? juce::String(analysis->bpm, 1) + " BPM" : "-- BPM");
+    tempoButton_->setEnabled(hasTempo);
+}
+
+void WaveformEditorContent::matchClipToTempo() {
+    auto& cm = magda::ClipManager::getInstance();
+    auto* clip = cm.getClip(editingClipId_);
+    auto* controller = magda::TimelineController::getCurrent();
+    if (!clip || clip->audioSources.empty() || !controller)
+        return;
+
+    auto analysis = magda::TempoCache::getInstance().getAnalysis(clip->audioSources[0].filePath);
+    if (analysis == nullptr || !analysis->hasTempo())
+        return;
+
+    magda::ClipOperations::stretchClipToTempo(*clip, analysis->bpm,
+                                              controller->getState().tempo.bpm);
+    cm.forceNotifyClipPropertyChanged(editingClipId_);
+}
+
 void WaveformEditorContent::scrollToClipStart() {
     if (relativeTimeMode_) {
         // In relative mode, scroll to beginning
@@ -18,13 +18,16 @@ namespace magda::daw::ui {
  * - WaveformGridComponent (scrollable waveform content)
  * - TimeRuler (synchronized with scroll)
  * - ABS/REL mode toggle
+ * - Waveform/spectrogram toggle
+ * - Detected tempo, matched to the project's on click
  * - Zoom controls
  *
  * Architecture based on PianoRollContent pattern.
  */
 class WaveformEditorContent : public PanelContent,
                               public magda::ClipManagerListener,
-                              public TimelineStateListener {
+                              public TimelineStateListener,
+                              public juce::ChangeListener {
   public:
     WaveformEditorContent();
     ~WaveformEditorContent() override;
@@ -60,6 +63,9 @@ class WaveformEditorContent : public PanelContent,
     void timelineStateChanged(const TimelineState& state) override;
     void playheadStateChanged(const TimelineState& state) override;
 
+    // ChangeListener (TempoCache)
+    void changeListenerCallback(juce::ChangeBroadcaster* source) override;
+
     // Set the clip to edit
     void setClip(magda::ClipId clipId);
     magda::ClipId getEditingClipId() const {
@@ -97,6 +103,8 @@ class WaveformEditorContent : public PanelContent,
     std::unique_ptr<WaveformGridComponent> gridComponent_;
     std::unique_ptr<magda::TimeRuler> timeRuler_;
     std::unique_ptr<juce::TextButton> timeModeButton_;
+    std::unique_ptr<juce::TextButton> spectrogramButton_;
+    std::unique_ptr<juce::TextButton> tempoButton_;
 
     // Playhead overlay
     class PlayheadOverlay;
@@ -112,6 +120,10 @@ class WaveformEditorContent : public PanelContent,
     // Update grid size when clip or zoom changes
     void updateGridSize();
 
+    // Show the clip's detected tempo, and stretch the clip to the project's
+    void updateTempoButton();
+    void matchClipToTempo();
+
     // Scroll to show clip start
     void scrollToClipStart();
 
@@ -4,6 +4,7 @@
 #include <iostream>
 
 #include "Config.hpp"
+#include "TempoMap.hpp"
 
 namespace magda {
 
@@ -80,6 +81,62 @@ void TimelineController::removeListener(TimelineStateListener* listener) {
     listeners.erase(std::remove(listeners.begin(), listeners.end(), listener), listeners.end());
 }
 
+// ===== Change Subscriptions =====
+
+Subscription TimelineController::subscribe(ChangeFlags changes, StateCallback callback) {
+    auto subscriber = std::make_shared<Subscriber>();
+    subscriber->mask = static_cast<uint32_t>(changes) & ((1u << kNumChangeFlags) - 1);
+    subscriber->callback = std::move(callback);
+    for (size_t bit = 0; bit < kNumChangeFlags; ++bit) {
+        if ((subscriber->mask & (1u << bit)) != 0) {
+            subscribers_->lists[bit].push_back(subscriber);
+        }
+    }
+
+    std::weak_ptr<Subscribers> weakSubscribers = subscribers_;
+    std::weak_ptr<Subscriber> weakSubscriber = subscriber;
+    return Subscription([weakSubscribers, weakSubscriber]() {
+        auto subscribers = weakSubscribers.lock();
+        auto subscriber = weakSubscriber.lock();
+        if (subscribers && subscriber) {
+            subscribers->remove(subscriber);
+        }
+    });
+}
+
+size_t TimelineController::getSubscriberCount(ChangeFlags change) const {
+    size_t count = 0;
+    for (size_t bit = 0; bit < kNumChangeFlags; ++bit) {
+        if ((static_cast<uint32_t>(change) & (1u << bit)) != 0) {
+            for (const auto& subscriber : subscribers_->lists[bit]) {
+                count += subscriber->active ? 1 : 0;
+            }
+        }
+    }
+    return count;
+}
+
+void TimelineController::Subscribers::remove(const std::shared_ptr<Subscriber>& subscriber) {
+    subscriber->active = false;
+    if (dispatchDepth > 0) {
+        // Its callback may be the one running; drop it once the notification is done
+        needsCompact = true;
+        return;
+    }
+    for (auto& list : lists) {
+        list.erase(std::remove(list.begin(), list.end(), subscriber), list.end());
+    }
+}
+
+void TimelineController::Subscribers::compact() {
+    needsCompact = false;
+    for (auto& list : lists) {
+        list.erase(std::remove_if(list.begin(), list.end(),
+                                  [](const auto& subscriber) { return !subscriber->active; }),
+                   list.end());
+    }
+}
+
 void TimelineController::addAudioEngineListener(AudioEngineListener* listener) {
     if (listener && std::find(audioEngineListeners.begin(), audioEngineListeners.end(), listener) ==
                         audioEngineListeners.end()) {
@@ -94,7 +151,7 @@ void TimelineController::removeAudioEngineListener(AudioEngineListener* listener
 }
 
 void TimelineController::pushUndoState() {
-    undoStack.push_back(state);
+    undoStack.push_back(captureUndoEntry());
 
     // Limit undo stack size
     while (undoStack.size() > maxUndoStates) {
@@ -111,10 +168,10 @@ bool TimelineController::undo() {
     }
 
     // Push current state to redo stack
-    redoStack.push_back(state);
+    redoStack.push_back(captureUndoEntry());
 
     // Restore previous state
-    state = undoStack.back();
+    restoreUndoEntry(undoStack.back());
     undoStack.pop_back();
 
     // Notify all listeners
@@ -129,10 +186,10 @@ bool TimelineController::redo() {
     }
 
     // Push current state to undo stack
-    undoStack.push_back(state);
+    undoStack.push_back(captureUndoEntry());
 
     // Restore next state
-    state = redoStack.back();
+    restoreUndoEntry(redoStack.back());
     redoStack.pop_back();
 
     // Notify all listeners
@@ -141,9 +198,47 @@ bool TimelineController::redo() {
     return true;
 }
 
+TimelineController::UndoEntry TimelineController::captureUndoEntry() {
+    auto sameSection = [](const ArrangementSection& a, const ArrangementSection& b) {
+        return a.startTime == b.startTime && a.endTime == b.endTime && a.name == b.name &&
+               a.colour == b.colour;
+    };
+
+    // Most undo points don't touch sections, so share the previous copy when possible
+    if (!sharedSections_ ||
+        !std::equal(sharedSections_->begin(), sharedSections_->end(), state.sections.begin(),
+                    state.sections.end(), sameSection)) {
+        sharedSections_ = std::make_shared<const std::vector<ArrangementSection>>(state.sections);
+    }
+
+    UndoEntry entry;
+    entry.timelineLength = state.timelineLength;
+    entry.horizontalZoom = state.zoom.horizontalZoom;
+    entry.verticalZoom = state.zoom.verticalZoom;
+    entry.scrollX = state.zoom.scrollX;
+    entry.scrollY = state.zoom.scrollY;
+    entry.loop = state.loop;
+    entry.sections = sharedSections_;
+    entry.selectedSectionIndex = state.selectedSectionIndex;
+    return entry;
+}
+
+void TimelineController::restoreUndoEntry(const UndoEntry& entry) {
+    state.timelineLength = entry.timelineLength;
+    state.zoom.horizontalZoom = entry.horizontalZoom;
+    state.zoom.verticalZoom = entry.verticalZoom;
+    state.zoom.scrollX = entry.scrollX;
+    state.zoom.scrollY = entry.scrollY;
+    state.loop = entry.loop;
+    state.sections = *entry.sections;
+    state.selectedSectionIndex = entry.selectedSectionIndex;
+    sharedSections_ = entry.sections;
+}
+
 void TimelineController::clearUndoHistory() {
     undoStack.clear();
     redoStack.clear();
+    sharedSections_.reset();
 }
 
 // ===== Zoom Event Handlers =====
@@ -526,6 +621,7 @@ TimelineController::ChangeFlags TimelineController::handleEvent(const SetTempoEv
     }
 
     state.tempo.bpm = newBpm;
+    TempoMap::getInstance().setTempo(newBpm);
 
     // Notify audio engine of tempo change
     for (auto* listener : audioEngineListeners) {
@@ -545,6 +641,7 @@ TimelineController::ChangeFlags TimelineController::handleEvent(const SetTimeSig
 
     state.tempo.timeSignatureNumerator = num;
     state.tempo.timeSignatureDenominator = den;
+    TempoMap::getInstance().setTimeSignature(num, den);
 
     // Notify audio engine of time signature change
     for (auto* listener : audioEngineListeners) {
@@ -729,8 +826,40 @@ void TimelineController::notifyListeners(ChangeFlags changes) {
             listener->displayConfigChanged(state);
         }
 
-        // Always call the general handler
-        listener->timelineStateChanged(state);
+        // Always call the general handler, except for playback position ticks: those arrive
+        // many times a second, and listeners that don't handle them get them through the
+        // default playheadStateChanged() anyway
+        if (changes != ChangeFlags::Playhead) {
+            listener->timelineStateChanged(state);
+        }
+    }
+
+    notifySubscribers(changes);
+}
+
+void TimelineController::notifySubscribers(ChangeFlags changes) {
+    // Keep the lists alive even if a callback destroys this controller's last subscriber
+    auto subscribers = subscribers_;
+    const auto changed = static_cast<uint32_t>(changes);
+
+    ++subscribers->dispatchDepth;
+    for (size_t bit = 0; bit < kNumChangeFlags; ++bit) {
+        if ((changed & (1u << bit)) == 0) {
+            continue;
+        }
+        // Index loop: a callback may subscribe someone else and grow the list
+        auto& list = subscribers->lists[bit];
+        for (size_t i = 0; i < list.size(); ++i) {
+            auto subscriber = list[i];
+            // Once per dispatch: only from the list of its lowest flag that changed
+            const uint32_t shared = subscriber->mask & changed;
+            if (subscriber->active && (shared & (~shared + 1)) == (1u << bit)) {
+                subscriber->callback(state);
+            }
+        }
+    }
+    if (--subscribers->dispatchDepth == 0 && subscribers->needsCompact) {
+        subscribers->compact();
     }
 }
 
@@ -2,13 +2,16 @@
 
 #include <juce_gui_basics/juce_gui_basics.h>
 
+#include <array>
 #include <deque>
+#include <functional>
 #include <memory>
 #include <vector>
 
 #include "TimelineEvents.hpp"
 #include "TimelineState.hpp"
 #include "TransportStateListener.hpp"
+#include "core/Subscription.hpp"
 
 namespace magda {
 
@@ -107,6 +110,22 @@ class TimelineController {
         return currentInstance_;
     }
 
+    // ===== Change Flags =====
+    // Indicates what parts of state changed (public for helper functions)
+    enum class ChangeFlags : uint32_t {
+        None = 0,
+        Zoom = 1 << 0,
+        Scroll = 1 << 1,
+        Playhead = 1 << 2,
+        Selection = 1 << 3,
+        Loop = 1 << 4,
+        Tempo = 1 << 5,
+        Display = 1 << 6,
+        Sections = 1 << 7,
+        Timeline = 1 << 8,
+        All = 0xFFFFFFFF
+    };
+
     // ===== State Access =====
 
     /**
@@ -137,6 +156,26 @@ class TimelineController {
      */
     void removeListener(TimelineStateListener* listener);
 
+    // ===== Change Subscriptions =====
+
+    using StateCallback = std::function<void(const TimelineState&)>;
+
+    /**
+     * @brief Call callback after each dispatch that changes any of the given parts
+     *
+     * Unlike listeners, a subscriber only hears about what it asked for, so playback
+     * position ticks reach just the few that subscribe to Playhead. Each subscriber is
+     * kept in a list per flag and called once per dispatch however many of its flags
+     * changed, after the listeners. The Subscription may outlive the controller, and a
+     * callback may reset it (or others) while running.
+     */
+    [[nodiscard]] Subscription subscribe(ChangeFlags changes, StateCallback callback);
+
+    /**
+     * @brief Subscribers that a change of exactly this flag would call
+     */
+    size_t getSubscriberCount(ChangeFlags change) const;
+
     // ===== Audio Engine Listener Management =====
 
     /**
@@ -198,22 +237,6 @@ class TimelineController {
         maxUndoStates = maxStates;
     }
 
-    // ===== Change Flags =====
-    // Indicates what parts of state changed (public for helper functions)
-    enum class ChangeFlags : uint32_t {
-        None = 0,
-        Zoom = 1 << 0,
-        Scroll = 1 << 1,
-        Playhead = 1 << 2,
-        Selection = 1 << 3,
-        Loop = 1 << 4,
-        Tempo = 1 << 5,
-        Display = 1 << 6,
-        Sections = 1 << 7,
-        Timeline = 1 << 8,
-        All = 0xFFFFFFFF
-    };
-
   private:
     // The single source of truth
     TimelineState state;
@@ -222,11 +245,52 @@ class TimelineController {
     std::vector<TimelineStateListener*> listeners;
     std::vector<AudioEngineListener*> audioEngineListeners;
 
+    // Subscribers, listed under each flag they asked for; shared with their Subscriptions
+    static constexpr size_t kNumChangeFlags = 9;  // Zoom through Timeline
+    struct Subscriber {
+        uint32_t mask = 0;
+        StateCallback callback;
+        bool active = true;
+    };
+    struct Subscribers {
+        std::array<std::vector<std::shared_ptr<Subscriber>>, kNumChangeFlags> lists;
+        int dispatchDepth = 0;
+        bool needsCompact = false;
+
+        void remove(const std::shared_ptr<Subscriber>& subscriber);
+        void compact();
+    };
+    std::shared_ptr<Subscribers> subscribers_ = std::make_shared<Subscribers>();
+
+    /**
+     * @brief The undoable slice of TimelineState
+     *
+     * Only what undoable events change (zoom/scroll, loop, sections, length) is kept, not
+     * the playhead, selection or display settings. The sections vector is shared between
+     * consecutive entries until a section edit changes it.
+     */
+    struct UndoEntry {
+        double timelineLength = 0.0;
+        double horizontalZoom = 0.0;
+        double verticalZoom = 1.0;
+        int scrollX = 0;
+        int scrollY = 0;
+        LoopRegion loop;
+        std::shared_ptr<const std::vector<ArrangementSection>> sections;
+        int selectedSectionIndex = -1;
+    };
+
+    UndoEntry captureUndoEntry();
+    void restoreUndoEntry(const UndoEntry& entry);
+
     // Undo/redo stacks
-    std::deque<TimelineState> undoStack;
-    std::deque<TimelineState> redoStack;
+    std::deque<UndoEntry> undoStack;
+    std::deque<UndoEntry> redoStack;
     size_t maxUndoStates = 50;
 
+    // Sections as last captured, reused by the next entry while they are unchanged
+    std::shared_ptr<const std::vector<ArrangementSection>> sharedSections_;
+
     // ===== Event Handlers =====
     // Each handler modifies state and returns flags indicating what changed
 
@@ -277,6 +341,7 @@ class TimelineController {
     // ===== Notification Helpers =====
 
     void notifyListeners(ChangeFlags changes);
+    void notifySubscribers(ChangeFlags changes);
 
     // ===== Helper methods =====
 
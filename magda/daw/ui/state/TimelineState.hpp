@@ -5,6 +5,7 @@
 #include <set>
 #include <vector>
 
+#include "../../core/TempoMap.hpp"
 #include "../layout/LayoutConfig.hpp"
 
 namespace magda {
@@ -301,17 +302,10 @@ struct TimelineState {
                 return juce::String(minutes) + ":" + juce::String(seconds).paddedLeft('0', 2);
             }
         } else {
-            double beatsPerSecond = tempo.bpm / 60.0;
-            double totalBeats = timeInSeconds * beatsPerSecond;
-
-            int bar = static_cast<int>(totalBeats / tempo.timeSignatureNumerator) + 1;
-            int beatInBar =
-                static_cast<int>(std::fmod(totalBeats, tempo.timeSignatureNumerator)) + 1;
-            double beatFraction = std::fmod(totalBeats, 1.0);
-            int subdivision = static_cast<int>(beatFraction * 4) + 1;
-
-            return juce::String(bar) + "." + juce::String(beatInBar) + "." +
-                   juce::String(subdivision);
+            // The controller keeps the shared map matched to tempo
+            const auto position = TempoMap::getInstance().toBarBeat(timeInSeconds);
+            return juce::String(position.bar) + "." + juce::String(position.beat) + "." +
+                   juce::String(position.sixteenth);
         }
     }
 
@@ -0,0 +1,125 @@
+#include "FrameScheduler.hpp"
+
+#include <algorithm>
+
+namespace magda {
+
+// =============================================================================
+// Client
+// =============================================================================
+
+FrameScheduler::Client::Client(juce::Component& owner, double maxHz,
+                               std::function<void()> onFrame)
+    : juce::ComponentMovementWatcher(&owner),
+      owner_(owner),
+      minIntervalMs_(1000.0 / juce::jmax(1.0, maxHz)),
+      onFrame_(std::move(onFrame)) {}
+
+FrameScheduler::Client::~Client() {
+    setActive(false);
+}
+
+void FrameScheduler::Client::setActive(bool shouldBeActive) {
+    if (shouldBeActive == active_) {
+        return;
+    }
+
+    active_ = shouldBeActive;
+    auto& scheduler = FrameScheduler::getInstance();
+    if (active_) {
+        scheduler.addActive(*this);
+    } else {
+        scheduler.removeActive(*this);
+    }
+}
+
+void FrameScheduler::Client::componentPeerChanged() {
+    if (active_) {
+        FrameScheduler::getInstance().updateClock();
+    }
+}
+
+void FrameScheduler::Client::componentVisibilityChanged() {
+    if (active_) {
+        FrameScheduler::getInstance().updateClock();
+    }
+}
+
+// =============================================================================
+// FrameScheduler
+// =============================================================================
+
+FrameScheduler& FrameScheduler::getInstance() {
+    static FrameScheduler instance;
+    return instance;
+}
+
+void FrameScheduler::addActive(Client& client) {
+    client.lastTickMs_ = 0.0;  // Due on the next frame
+    activeClients_.push_back(&client);
+    updateClock();
+}
+
+void FrameScheduler::removeActive(Client& client) {
+    activeClients_.erase(std::remove(activeClients_.begin(), activeClients_.end(), &client),
+                         activeClients_.end());
+    if (clockClient_ == &client) {
+        clockClient_ = nullptr;
+    }
+    updateClock();
+}
+
+void FrameScheduler::updateClock() {
+    // The attachment can't be replaced from inside its own callback
+    if (inTick_) {
+        clockDirty_ = true;
+        return;
+    }
+
+    if (clockClient_ && clockClient_->owner_.isShowing()) {
+        return;
+    }
+
+    vblank_.reset();
+    clockClient_ = nullptr;
+    for (auto* client : activeClients_) {
+        if (client->owner_.isShowing()) {
+            clockClient_ = client;
+            vblank_ = std::make_unique<juce::VBlankAttachment>(&client->owner_,
+                                                               [this]() { tick(); });
+            return;
+        }
+    }
+}
+
+void FrameScheduler::tick() {
+    const double nowMs = juce::Time::getMillisecondCounterHiRes();
+
+    inTick_ = true;
+    ticking_.assign(activeClients_.begin(), activeClients_.end());
+    for (auto* client : ticking_) {
+        // An earlier callback may have deactivated or deleted this client
+        if (std::find(activeClients_.begin(), activeClients_.end(), client) ==
+            activeClients_.end()) {
+            continue;
+        }
+        if (!client->owner_.isShowing()) {
+            continue;
+        }
+        // Allow some jitter, so a 30 Hz client lands on every other 60 Hz frame
+        if (nowMs - client->lastTickMs_ < client->minIntervalMs_ * 0.9) {
+            continue;
+        }
+
+        client->lastTickMs_ = nowMs;
+        client->onFrame_();
+    }
+    inTick_ = false;
+
+    if (clockDirty_) {
+        clockDirty_ = false;
+        updateClock();
+    }
+}
+
+}  // namespace magda
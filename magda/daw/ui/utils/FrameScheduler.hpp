@@ -0,0 +1,92 @@
+#pragma once
+
+#include <juce_gui_basics/juce_gui_basics.h>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace magda {
+
+/**
+ * @brief One display-synchronised clock for UI animation, in place of per-component timers
+ *
+ * Components hold a FrameScheduler::Client and keep it active while they have something to
+ * animate. The scheduler runs off a juce::VBlankAttachment on a showing client, so every
+ * animated component updates in the same frame, and ticks each active client that is on
+ * screen at no more than its own rate. When no active client is showing, the attachment
+ * is released and the UI gets no frame ticks at all.
+ *
+ * Message thread only.
+ */
+class FrameScheduler {
+  public:
+    /**
+     * @brief A component's subscription to display frames
+     *
+     * Hold it as a member of the component it animates; it unregisters on destruction.
+     */
+    class Client : private juce::ComponentMovementWatcher {
+      public:
+        /**
+         * @param owner Component whose visibility gates the ticks
+         * @param maxHz Tick rate limit (the display's rate if that is lower)
+         * @param onFrame Called once per tick while active and showing
+         */
+        Client(juce::Component& owner, double maxHz, std::function<void()> onFrame);
+        ~Client() override;
+
+        void setActive(bool shouldBeActive);
+
+        bool isActive() const {
+            return active_;
+        }
+
+      private:
+        friend class FrameScheduler;
+
+        using juce::ComponentMovementWatcher::componentMovedOrResized;
+        using juce::ComponentMovementWatcher::componentVisibilityChanged;
+        void componentMovedOrResized(bool /*wasMoved*/, bool /*wasResized*/) override {}
+        void componentPeerChanged() override;
+        void componentVisibilityChanged() override;
+
+        juce::Component& owner_;
+        const double minIntervalMs_;
+        std::function<void()> onFrame_;
+        bool active_ = false;
+        double lastTickMs_ = 0.0;
+
+        JUCE_DECLARE_NON_COPYABLE(Client)
+    };
+
+    static FrameScheduler& getInstance();
+
+    /**
+     * @brief True while a vblank attachment is delivering frames
+     */
+    bool isRunning() const {
+        return vblank_ != nullptr;
+    }
+
+    int getNumActiveClients() const {
+        return static_cast<int>(activeClients_.size());
+    }
+
+  private:
+    FrameScheduler() = default;
+
+    void addActive(Client& client);
+    void removeActive(Client& client);
+    void updateClock();
+    void tick();
+
+    std::vector<Client*> activeClients_;
+    std::vector<Client*> ticking_;  // Reused every frame so ticking doesn't allocate
+    std::unique_ptr<juce::VBlankAttachment> vblank_;
+    Client* clockClient_ = nullptr;  // The showing client the attachment follows
+    bool inTick_ = false;
+    bool clockDirty_ = false;  // Clients changed during a tick; re-pick the clock after it
+};
+
+}  // namespace magda
@@ -0,0 +1,44 @@
+#include "GpuRenderer.hpp"
+
+namespace magda {
+
+GpuRenderer::GpuRenderer(juce::Component& target) : target_(target) {
+#if MAGDA_ENABLE_OPENGL
+    // Repaint on demand like the software renderer, in step with the display
+    context_.setComponentPaintingEnabled(true);
+    context_.setContinuousRepainting(false);
+    context_.setSwapInterval(1);
+    context_.setImageCacheSize(kImageCacheBytes);
+#endif
+}
+
+GpuRenderer::~GpuRenderer() {
+    setEnabled(false);
+}
+
+bool GpuRenderer::isAvailable() {
+#if MAGDA_ENABLE_OPENGL
+    return true;
+#else
+    return false;
+#endif
+}
+
+void GpuRenderer::setEnabled(bool shouldBeEnabled) {
+    if (!isAvailable() || shouldBeEnabled == enabled_) {
+        return;
+    }
+
+    enabled_ = shouldBeEnabled;
+#if MAGDA_ENABLE_OPENGL
+    if (enabled_) {
+        context_.attachTo(target_);
+    } else {
+        context_.detach();
+    }
+#endif
+    target_.repaint();
+    DBG("GpuRenderer: " << (enabled_ ? "OpenGL" : "software") << " rendering");
+}
+
+}  // namespace magda
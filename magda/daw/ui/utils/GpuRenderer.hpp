@@ -0,0 +1,54 @@
+#pragma once
+
+#include <juce_gui_basics/juce_gui_basics.h>
+
+#if MAGDA_ENABLE_OPENGL
+#include <juce_opengl/juce_opengl.h>
+#endif
+
+namespace magda {
+
+/**
+ * @brief Optional OpenGL compositing for a component and everything inside it
+ *
+ * While enabled, an OpenGLContext is attached to the target and JUCE's OpenGL renderer paints
+ * it on the GPU: fills (meter bars among them) become batched quads, and images are uploaded
+ * once as textures and redrawn from there. The arrange clips already paint their waveforms
+ * into cached tiles at physical resolution (TileImageCache), so scrolling the timeline on a
+ * 4K or 5K display composites textures instead of rasterising peaks again. The image cache
+ * is sized so those tiles stay resident.
+ *
+ * Only works when built with MAGDA_ENABLE_OPENGL; otherwise setEnabled() does nothing and the
+ * software renderer is used. Message thread only.
+ */
+class GpuRenderer {
+  public:
+    /** @brief GPU memory the texture cache may hold (the default is 8 MB) */
+    static constexpr size_t kImageCacheBytes = 256 * 1024 * 1024;
+
+    explicit GpuRenderer(juce::Component& target);
+    ~GpuRenderer();
+
+    /**
+     * @brief Whether this build can render with OpenGL at all
+     */
+    static bool isAvailable();
+
+    void setEnabled(bool shouldBeEnabled);
+
+    bool isEnabled() const {
+        return enabled_;
+    }
+
+  private:
+    juce::Component& target_;
+    bool enabled_ = false;
+
+#if MAGDA_ENABLE_OPENGL
+    juce::OpenGLContext context_;
+#endif
+
+    JUCE_DECLARE_NON_COPYABLE(GpuRenderer)
+};
+
+}  // namespace magda
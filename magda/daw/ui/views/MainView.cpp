@@ -11,6 +11,7 @@
 #include "../themes/FontManager.hpp"
 #include "Config.hpp"
 #include "audio/AudioBridge.hpp"
+#include "audio/PlayheadClock.hpp"
 #include "core/ClipManager.hpp"
 #include "core/SelectionManager.hpp"
 #include "core/TrackManager.hpp"
@@ -61,6 +62,9 @@ MainView::MainView(AudioEngine* audioEngine)
     // Load configuration
     auto& config = magda::Config::getInstance();
     config.loadFromFile("magda_config.txt");  // Load from file if it exists
+    if (audioEngine_) {
+        audioEngine_->applyRenderThreadSettings();  // The engine started before the file loaded
+    }
     timelineLength = config.getDefaultTimelineLength();
 
     std::cout << "🎯 CONFIG: Timeline length=" << timelineLength << " seconds" << std::endl;
@@ -91,8 +95,8 @@ MainView::MainView(AudioEngine* audioEngine)
     const auto& master = TrackManager::getInstance().getMasterChannel();
     masterVisible_ = master.isVisibleIn(currentViewMode_);
 
-    // Start timer for metering updates (30 FPS)
-    startTimerHz(30);
+    // Master meter ticks until the bridge is up and silent
+    frameClient_.setActive(true);
 }
 
 void MainView::setupTimelineController() {
@@ -276,8 +280,7 @@ void MainView::setupCallbacks() {
 }
 
 MainView::~MainView() {
-    // Stop metering timer
-    stopTimer();
+    meterActivitySubscription_.reset();
 
     // Remove listener before destruction
     if (timelineController) {
@@ -285,7 +288,9 @@ MainView::~MainView() {
     }
 
     // Unregister from TrackManager and ViewModeController
-    TrackManager::getInstance().removeListener(this);
+    if (!suspended_) {
+        TrackManager::getInstance().removeListener(this);
+    }
     ViewModeController::getInstance().removeListener(this);
 
     // Save configuration on shutdown
@@ -294,25 +299,41 @@ MainView::~MainView() {
     std::cout << "🎯 CONFIG: Saved configuration on shutdown" << std::endl;
 }
 
-// ===== Timer Implementation (for metering) =====
+// ===== Master Metering =====
 
-void MainView::timerCallback() {
+void MainView::updateMasterMeter() {
     // Update master metering from audio engine
-    if (!audioEngine_ || !masterHeaderPanel)
+    if (!audioEngine_ || !masterHeaderPanel) {
+        frameClient_.setActive(false);
         return;
+    }
 
     auto* teWrapper = dynamic_cast<TracktionEngineWrapper*>(audioEngine_);
-    if (!teWrapper)
+    if (!teWrapper) {
+        frameClient_.setActive(false);
         return;
+    }
 
     auto* bridge = teWrapper->getAudioBridge();
     if (!bridge)
-        return;
+        return;  // Keep ticking until the bridge exists and can wake us
+
+    if (!meterActivitySubscription_) {
+        meterActivitySubscription_ = bridge->subscribeToEvents(
+            AudioEvent::Type::MeterActivity,
+            [this](const AudioEvent&) { frameClient_.setActive(true); });
+    }
 
     // Update master header panel with real levels
     float masterPeakL = bridge->getMasterPeakL();
     float masterPeakR = bridge->getMasterPeakR();
     masterHeaderPanel->setPeakLevels(masterPeakL, masterPeakR);
+
+    // Idle once the master is silent; the bridge wakes us on MeterActivity
+    const bool silent = masterPeakL <= MeteringBuffer::kSilenceLevel &&
+                        masterPeakR <= MeteringBuffer::kSilenceLevel;
+    if (silent)
+        frameClient_.setActive(false);
 }
 
 // ===== TimelineStateListener Implementation =====
@@ -354,8 +375,7 @@ void MainView::zoomStateChanged(const TimelineState& state) {
 
 void MainView::playheadStateChanged(const TimelineState& state) {
     playheadPosition = state.playhead.getPosition();
-    playheadComponent->setPlayheadPosition(playheadPosition);
-    playheadComponent->repaint();
+    playheadComponent->setPlayheadState(state);
 
     // Notify external listeners about playhead position change
     if (onPlayheadPositionChanged) {
@@ -448,7 +468,26 @@ void MainView::viewModeChanged(ViewMode mode, const AudioEngineProfile& /*profil
     }
 }
 
+void MainView::setSuspended(bool shouldBeSuspended) {
+    if (suspended_ == shouldBeSuspended) {
+        return;
+    }
+    suspended_ = shouldBeSuspended;
+
+    if (suspended_) {
+        TrackManager::getInstance().removeListener(this);
+        meterActivitySubscription_.reset();
+        frameClient_.setActive(false);
+        return;
+    }
+
+    TrackManager::getInstance().addListener(this);
+    masterChannelChanged();
+    frameClient_.setActive(audioEngine_ != nullptr);  // Re-subscribes on its first tick
+}
+
 void MainView::paint(juce::Graphics& g) {
+    paintProfile_.begin();
     g.fillAll(DarkTheme::getColour(DarkTheme::BACKGROUND));
 
     // Draw top border for visual separation from transport above
@@ -460,6 +499,10 @@ void MainView::paint(juce::Graphics& g) {
     paintMasterResizeHandle(g);
 }
 
+void MainView::paintOverChildren(juce::Graphics& /*g*/) {
+    paintProfile_.end();
+}
+
 void MainView::resized() {
     auto bounds = getLocalBounds();
 
@@ -993,9 +1036,9 @@ void MainView::PlayheadComponent::paint(juce::Graphics& g) {
     const auto& state = owner.timelineController->getState();
     int scrollOffset = owner.trackContentViewport->getViewPositionX();
 
-    // Get positions from state
+    // Get positions from state (the play cursor from the audio clock while following it)
     double editPos = state.playhead.editPosition;
-    double playbackPos = state.playhead.playbackPosition;
+    double playbackPos = getDisplayedPlaybackPosition();
     bool isPlaying = state.playhead.isPlaying;
 
     // Calculate edit cursor position in pixels (triangle position)
@@ -1026,9 +1069,56 @@ void MainView::PlayheadComponent::paint(juce::Graphics& g) {
     }
 }
 
-void MainView::PlayheadComponent::setPlayheadPosition(double position) {
-    playheadPosition = position;
-    repaint();
+void MainView::PlayheadComponent::setPlayheadState(const TimelineState& state) {
+    const bool playing = state.playhead.isPlaying;
+    const bool transportChanged = playing != wasPlaying;
+    const bool editMoved = state.playhead.editPosition != lastEditPosition;
+    wasPlaying = playing;
+    lastEditPosition = state.playhead.editPosition;
+
+    const auto* clock = owner.audioEngine_ ? owner.audioEngine_->getPlayheadClock() : nullptr;
+    frameClient.setActive(playing && clock != nullptr);
+    if (!frameClient.isActive()) {
+        livePosition = -1.0;
+    }
+
+    // Position-only updates come from the frame clock; the polled ones are ignored here
+    if (transportChanged || editMoved || !frameClient.isActive()) {
+        repaint();
+    }
+}
+
+void MainView::PlayheadComponent::followAudioClock() {
+    const auto* clock = owner.audioEngine_ ? owner.audioEngine_->getPlayheadClock() : nullptr;
+    PlayheadClock::Sample sample;
+    if (clock == nullptr || !clock->read(sample) || !sample.playing) {
+        return;
+    }
+
+    const double position =
+        juce::jlimit(0.0, owner.timelineLength,
+                     PlayheadClock::extrapolate(sample, juce::Time::getMillisecondCounterHiRes()));
+    const auto oldBounds = getPlayLineBounds(getDisplayedPlaybackPosition());
+    livePosition = position;
+    const auto newBounds = getPlayLineBounds(position);
+
+    // Only the strips the line leaves and enters
+    if (newBounds != oldBounds) {
+        repaint(oldBounds);
+        repaint(newBounds);
+    }
+}
+
+double MainView::PlayheadComponent::getDisplayedPlaybackPosition() const {
+    return livePosition >= 0.0 ? livePosition
+                               : owner.timelineController->getState().playhead.playbackPosition;
+}
+
+juce::Rectangle<int> MainView::PlayheadComponent::getPlayLineBounds(double position) const {
+    const int scrollOffset = owner.trackContentViewport->getViewPositionX();
+    const int playX = static_cast<int>(position * owner.horizontalZoom) +
+                      LayoutConfig::TIMELINE_LEFT_PADDING - scrollOffset;
+    return {playX - 2, 0, 4, getHeight()};
 }
 
 bool MainView::PlayheadComponent::hitTest([[maybe_unused]] int x, [[maybe_unused]] int y) {
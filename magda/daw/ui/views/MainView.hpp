@@ -13,8 +13,11 @@
 #include "../components/tracks/TrackHeadersPanel.hpp"
 #include "../layout/LayoutConfig.hpp"
 #include "../state/TimelineController.hpp"
+#include "../utils/FrameScheduler.hpp"
+#include "core/Subscription.hpp"
 #include "core/TrackManager.hpp"
 #include "core/ViewModeController.hpp"
+#include "profiling/UIFrameProfiler.hpp"
 
 namespace magda {
 
@@ -23,7 +26,6 @@ class AudioEngine;
 
 class MainView : public juce::Component,
                  public juce::ScrollBar::Listener,
-                 public juce::Timer,
                  public TimelineStateListener,
                  public TrackManagerListener,
                  public ViewModeListener {
@@ -32,6 +34,7 @@ class MainView : public juce::Component,
     ~MainView() override;
 
     void paint(juce::Graphics& g) override;
+    void paintOverChildren(juce::Graphics& g) override;
     void resized() override;
 
     // Zoom and scroll controls
@@ -88,8 +91,13 @@ class MainView : public juce::Component,
     // ViewModeListener implementation
     void viewModeChanged(ViewMode mode, const AudioEngineProfile& profile) override;
 
-    // Timer implementation (for metering updates)
-    void timerCallback() override;
+    /**
+     * @brief Stop following the master channel and metering while hidden
+     *
+     * The timeline listener stays attached: its callbacks feed the transport display in
+     * every view. Resuming re-reads the master channel once.
+     */
+    void setSuspended(bool shouldBeSuspended);
 
     // Access to the timeline controller (for child components)
     TimelineController& getTimelineController() {
@@ -151,6 +159,14 @@ class MainView : public juce::Component,
     int masterStripHeight = 60;
     ViewMode currentViewMode_ = ViewMode::Arrange;
     bool masterVisible_ = true;
+    bool suspended_ = false;
+
+    // Master metering on the shared frame clock, idle while silent
+    FrameScheduler::Client frameClient_{*this, 30.0, [this]() { updateMasterMeter(); }};
+    Subscription meterActivitySubscription_;  // Wakes the master meter when audio starts
+    void updateMasterMeter();
+
+    UIFrameProfiler::Source paintProfile_{"MainView"};  // Times paint() to paintOverChildren()
     static constexpr int MIN_MASTER_STRIP_HEIGHT = 40;
     static constexpr int MAX_MASTER_STRIP_HEIGHT = 150;
 
@@ -241,7 +257,12 @@ class MainView::PlayheadComponent : public juce::Component {
     ~PlayheadComponent() override;
 
     void paint(juce::Graphics& g) override;
-    void setPlayheadPosition(double position);
+
+    /**
+     * @brief Follow the controller's playhead; while playing, the line tracks the audio
+     *        clock per frame and only edit-cursor or transport changes repaint everything
+     */
+    void setPlayheadState(const TimelineState& state);
 
     // Hit testing to only intercept clicks near the playhead
     bool hitTest(int x, int y) override;
@@ -254,11 +275,20 @@ class MainView::PlayheadComponent : public juce::Component {
 
   private:
     MainView& owner;
-    double playheadPosition = 0.0;
     bool isDragging = false;
     int dragStartX = 0;
     double dragStartPosition = 0.0;
 
+    // While playing, the line follows the audio clock every display frame
+    FrameScheduler::Client frameClient{*this, 120.0, [this]() { followAudioClock(); }};
+    double livePosition = -1.0;  // Extrapolated playback position, -1 when not following
+    double lastEditPosition = -1.0;
+    bool wasPlaying = false;
+
+    void followAudioClock();
+    double getDisplayedPlaybackPosition() const;
+    juce::Rectangle<int> getPlayLineBounds(double position) const;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PlayheadComponent)
 };
 
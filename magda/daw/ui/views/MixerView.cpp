@@ -1,12 +1,12 @@
 #include "MixerView.hpp"
 
 #include <cmath>
+#include <unordered_map>
 
 #include "../../audio/AudioBridge.hpp"
 #include "../../audio/MeteringBuffer.hpp"
 #include "../../engine/AudioEngine.hpp"
 #include "../../engine/TracktionEngineWrapper.hpp"
-#include "../../profiling/PerformanceProfiler.hpp"
 #include "../themes/DarkTheme.hpp"
 #include "../themes/FontManager.hpp"
 #include "core/SelectionManager.hpp"
@@ -696,15 +696,21 @@ MixerView::MixerView(AudioEngine* audioEngine) : audioEngine_(audioEngine) {
     // debugPanel_ = std::make_unique<MixerDebugPanel>();
     // debugPanel_->setVisible(false);
     // debugPanel_->onMetricsChanged = [this]() { rebuildChannelStrips(); };
+    // debugPanel_->chainStatsSource = [this]() {
+    //     auto* bridge = audioEngine_ ? audioEngine_->getAudioBridge() : nullptr;
+    //     return bridge ? bridge->getChainSuspensionStats() : ChainSilenceGate::Stats{};
+    // };
     // addAndMakeVisible(*debugPanel_);
 
-    // Start timer for meter animation (30fps)
-    startTimer(33);
+    // Meters tick until the bridge is up and silent
+    frameClient_.setActive(true);
 }
 
 MixerView::~MixerView() {
-    stopTimer();
-    TrackManager::getInstance().removeListener(this);
+    meterActivitySubscription_.reset();
+    if (!suspended_) {
+        TrackManager::getInstance().removeListener(this);
+    }
     ViewModeController::getInstance().removeListener(this);
 
     // Explicitly clear all UI components before automatic member destruction
@@ -719,7 +725,14 @@ MixerView::~MixerView() {
 }
 
 void MixerView::rebuildChannelStrips() {
-    // Clear existing strips
+    // Reconcile by track ID: strips for tracks still shown are kept (and reordered), so
+    // adding or removing a track only builds or destroys that track's strip
+    std::unordered_map<TrackId, std::unique_ptr<ChannelStrip>> existing;
+    existing.reserve(channelStrips.size());
+    for (auto& strip : channelStrips) {
+        const auto trackId = strip->getTrackId();
+        existing.emplace(trackId, std::move(strip));
+    }
     channelStrips.clear();
 
     const auto& tracks = TrackManager::getInstance().getTracks();
@@ -730,6 +743,13 @@ void MixerView::rebuildChannelStrips() {
             continue;
         }
 
+        if (const auto it = existing.find(track.id); it != existing.end()) {
+            it->second->updateFromTrack(track);
+            channelStrips.push_back(std::move(it->second));
+            existing.erase(it);
+            continue;
+        }
+
         auto strip = std::make_unique<ChannelStrip>(track, &mixerLookAndFeel_, false);
         strip->onClicked = [this](int trackId, bool isMaster) {
             // Find the index of this track in the visible strips
@@ -744,6 +764,10 @@ void MixerView::rebuildChannelStrips() {
         channelStrips.push_back(std::move(strip));
     }
 
+    // Strips left over belong to removed or hidden tracks; they leave the container as
+    // they are destroyed
+    existing.clear();
+
     // Update master strip visibility
     const auto& master = TrackManager::getInstance().getMasterChannel();
     bool masterVisible = master.isVisibleIn(currentViewMode_);
@@ -756,8 +780,24 @@ void MixerView::rebuildChannelStrips() {
 }
 
 void MixerView::tracksChanged() {
-    // Rebuild all channel strips when tracks are added/removed/reordered
-    rebuildChannelStrips();
+    // Strips are rebuilt from trackChangesCoalesced(), once per burst of edits
+}
+
+void MixerView::trackChangesCoalesced(const TrackChangeSet& changes) {
+    // Only a change to which tracks have strips, or their order, needs a rebuild; collapsing
+    // or resizing in the arrangement doesn't, and property edits are applied per strip
+    bool needsRebuild =
+        changes.reset || changes.reordered || !changes.added.empty() || !changes.removed.empty();
+    for (const auto& [trackId, dirty] : changes.modified) {
+        if (hasFlag(dirty, TrackDirty::Visibility)) {
+            needsRebuild = true;
+            break;
+        }
+    }
+
+    if (needsRebuild) {
+        rebuildChannelStrips();
+    }
 }
 
 void MixerView::trackPropertyChanged(int trackId) {
@@ -776,7 +816,31 @@ void MixerView::trackPropertyChanged(int trackId) {
 
 void MixerView::viewModeChanged(ViewMode mode, const AudioEngineProfile& /*profile*/) {
     currentViewMode_ = mode;
+    if (!suspended_) {
+        rebuildChannelStrips();
+    }
+}
+
+void MixerView::setSuspended(bool shouldBeSuspended) {
+    if (suspended_ == shouldBeSuspended) {
+        return;
+    }
+    suspended_ = shouldBeSuspended;
+
+    auto& trackManager = TrackManager::getInstance();
+    if (suspended_) {
+        trackManager.removeListener(this);
+        meterActivitySubscription_.reset();
+        frameClient_.setActive(false);
+        return;
+    }
+
+    // One reconcile catches up on everything missed: kept strips are refreshed from their
+    // tracks, and the master strip and selection are re-read
+    trackManager.addListener(this);
+    currentViewMode_ = ViewModeController::getInstance().getViewMode();
     rebuildChannelStrips();
+    frameClient_.setActive(audioEngine_ != nullptr);  // Re-subscribes on its first tick
 }
 
 void MixerView::masterChannelChanged() {
@@ -788,10 +852,14 @@ void MixerView::masterChannelChanged() {
 }
 
 void MixerView::paint(juce::Graphics& g) {
-    MAGDA_MONITOR_SCOPE("UIFrame");
+    paintProfile_.begin();
     g.fillAll(DarkTheme::getColour(DarkTheme::BACKGROUND));
 }
 
+void MixerView::paintOverChildren(juce::Graphics& /*g*/) {
+    paintProfile_.end();
+}
+
 void MixerView::resized() {
     const auto& metrics = MixerMetrics::getInstance();
     auto bounds = getLocalBounds();
@@ -821,28 +889,41 @@ void MixerView::resized() {
     }
 }
 
-void MixerView::timerCallback() {
+void MixerView::updateMeters() {
     // Read metering data from AudioBridge
-    if (!audioEngine_)
+    if (!audioEngine_) {
+        frameClient_.setActive(false);
         return;
+    }
 
     auto* teWrapper = dynamic_cast<TracktionEngineWrapper*>(audioEngine_);
-    if (!teWrapper)
+    if (!teWrapper) {
+        frameClient_.setActive(false);
         return;
+    }
 
     auto* bridge = teWrapper->getAudioBridge();
     if (!bridge)
-        return;
+        return;  // Keep ticking until the bridge exists and can wake us
+
+    if (!meterActivitySubscription_) {
+        meterActivitySubscription_ = bridge->subscribeToEvents(
+            AudioEvent::Type::MeterActivity,
+            [this](const AudioEvent&) { frameClient_.setActive(true); });
+    }
 
     auto& meteringBuffer = bridge->getMeteringBuffer();
+    bool animating = false;
 
-    // Update channel strip meters
+    // Update channel strip meters (shared snapshot; the arrange headers read the same one)
     for (auto& strip : channelStrips) {
         int trackId = strip->getTrackId();
         MeterData data;
-        if (meteringBuffer.popLevels(trackId, data)) {
-            // Use stereo peak levels
+        if (meteringBuffer.readLevels(trackId, data)) {
+            // Use stereo peak levels (held and decayed by the buffer)
             strip->setMeterLevels(data.peakL, data.peakR);
+            animating = animating || data.peakL > MeteringBuffer::kSilenceLevel ||
+                        data.peakR > MeteringBuffer::kSilenceLevel;
         }
     }
 
@@ -851,7 +932,13 @@ void MixerView::timerCallback() {
         float masterPeakL = bridge->getMasterPeakL();
         float masterPeakR = bridge->getMasterPeakR();
         masterStrip->setPeakLevels(masterPeakL, masterPeakR);
+        animating = animating || masterPeakL > MeteringBuffer::kSilenceLevel ||
+                    masterPeakR > MeteringBuffer::kSilenceLevel;
     }
+
+    // Idle once every meter has settled; the bridge wakes us on MeterActivity
+    if (!animating)
+        frameClient_.setActive(false);
 }
 
 bool MixerView::keyPressed(const juce::KeyPress& /*key*/) {
@@ -11,8 +11,11 @@
 #include "../components/mixer/RoutingSelector.hpp"
 #include "../themes/MixerLookAndFeel.hpp"
 #include "../themes/MixerMetrics.hpp"
+#include "../utils/FrameScheduler.hpp"
+#include "core/Subscription.hpp"
 #include "core/TrackManager.hpp"
 #include "core/ViewModeController.hpp"
+#include "profiling/UIFrameProfiler.hpp"
 
 namespace magda {
 
@@ -28,7 +31,6 @@ class AudioEngine;
  * - Master channel on the right
  */
 class MixerView : public juce::Component,
-                  public juce::Timer,
                   public TrackManagerListener,
                   public ViewModeListener {
   public:
@@ -37,9 +39,24 @@ class MixerView : public juce::Component,
 
     void setAudioEngine(AudioEngine* audioEngine) {
         audioEngine_ = audioEngine;
+        meterActivitySubscription_.reset();  // Re-subscribed on the new engine's bridge
+        frameClient_.setActive(audioEngine_ != nullptr && !suspended_);
+    }
+
+    /**
+     * @brief Stop following tracks and metering while hidden
+     *
+     * A suspended mixer isn't a TrackManager listener and its meters are off; resuming
+     * rebuilds the strips once for whatever changed in the meantime.
+     */
+    void setSuspended(bool shouldBeSuspended);
+
+    bool isSuspended() const {
+        return suspended_;
     }
 
     void paint(juce::Graphics& g) override;
+    void paintOverChildren(juce::Graphics& g) override;
     void resized() override;
     bool keyPressed(const juce::KeyPress& key) override;
     void mouseMove(const juce::MouseEvent& event) override;
@@ -47,12 +64,10 @@ class MixerView : public juce::Component,
     void mouseDrag(const juce::MouseEvent& event) override;
     void mouseUp(const juce::MouseEvent& event) override;
 
-    // Timer callback for meter animation
-    void timerCallback() override;
-
     // TrackManagerListener
     void tracksChanged() override;
     void trackPropertyChanged(int trackId) override;
+    void trackChangesCoalesced(const TrackChangeSet& changes) override;
     void masterChannelChanged() override;
     void trackSelectionChanged(TrackId trackId) override;
 
@@ -189,6 +204,7 @@ class MixerView : public juce::Component,
 
     // View mode state
     ViewMode currentViewMode_ = ViewMode::Mix;
+    bool suspended_ = false;
 
     // Custom look and feel for faders
     MixerLookAndFeel mixerLookAndFeel_;
@@ -207,6 +223,13 @@ class MixerView : public juce::Component,
     // Audio engine for metering
     AudioEngine* audioEngine_ = nullptr;
 
+    // Meters animate on the shared frame clock, idle while silent
+    FrameScheduler::Client frameClient_{*this, 30.0, [this]() { updateMeters(); }};
+    Subscription meterActivitySubscription_;  // Wakes the meters when audio starts
+    void updateMeters();
+
+    UIFrameProfiler::Source paintProfile_{"MixerView"};  // Times paint() to paintOverChildren()
+
     bool isInChannelResizeZone(const juce::Point<int>& pos) const;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MixerView)
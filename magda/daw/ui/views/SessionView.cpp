@@ -3,38 +3,111 @@
 #include <functional>
 
 #include "../themes/DarkTheme.hpp"
+#include "../themes/FontManager.hpp"
 #include "core/SelectionManager.hpp"
 #include "core/ViewModeController.hpp"
 
 namespace magda {
 
-// Custom grid content that draws track separators
+// Grid content that paints the clip slots itself, so only the cells on screen cost anything
 class SessionView::GridContent : public juce::Component {
   public:
-    GridContent(int clipSize, int separatorWidth)
-        : clipSize_(clipSize), separatorWidth_(separatorWidth) {}
+    explicit GridContent(SessionView& owner) : owner_(owner) {}
 
     void setNumTracks(int numTracks) {
         numTracks_ = numTracks;
+        hoveredTrack_ = -1;
         repaint();
     }
 
+    juce::Rectangle<int> getCellBounds(int trackIndex, int sceneIndex) const {
+        return {trackIndex * COLUMN_WIDTH, sceneIndex * ROW_HEIGHT, CLIP_SLOT_SIZE,
+                CLIP_SLOT_SIZE};
+    }
+
+    void repaintCell(int trackIndex, int sceneIndex) {
+        if (trackIndex >= 0 && trackIndex < numTracks_ && sceneIndex >= 0 &&
+            sceneIndex < NUM_SCENES) {
+            repaint(getCellBounds(trackIndex, sceneIndex));
+        }
+    }
+
     void paint(juce::Graphics& g) override {
         g.fillAll(DarkTheme::getColour(DarkTheme::BACKGROUND));
+        if (numTracks_ == 0) {
+            return;
+        }
+
+        // Only the cells the repaint touches: the viewport's view area, or a single cell
+        const auto area = g.getClipBounds();
+        const int firstTrack = juce::jlimit(0, numTracks_ - 1, area.getX() / COLUMN_WIDTH);
+        const int lastTrack = juce::jlimit(0, numTracks_ - 1, (area.getRight() - 1) / COLUMN_WIDTH);
+        const int firstScene = juce::jlimit(0, NUM_SCENES - 1, area.getY() / ROW_HEIGHT);
+        const int lastScene = juce::jlimit(0, NUM_SCENES - 1, (area.getBottom() - 1) / ROW_HEIGHT);
 
-        // Draw vertical separators between tracks (after each clip slot)
+        // Vertical separators between tracks (after each clip slot)
         g.setColour(DarkTheme::getColour(DarkTheme::SEPARATOR));
-        int trackColumnWidth = clipSize_ + separatorWidth_;
-        for (int i = 0; i < numTracks_; ++i) {
-            int x = i * trackColumnWidth + clipSize_;
-            g.fillRect(x, 0, separatorWidth_, getHeight());
+        for (int track = firstTrack; track <= lastTrack; ++track) {
+            g.fillRect(track * COLUMN_WIDTH + CLIP_SLOT_SIZE, 0, TRACK_SEPARATOR_WIDTH,
+                       getHeight());
+        }
+
+        for (int track = firstTrack; track <= lastTrack; ++track) {
+            for (int scene = firstScene; scene <= lastScene; ++scene) {
+                const bool hovered = track == hoveredTrack_ && scene == hoveredScene_;
+                owner_.paintClipSlot(g, track, scene, getCellBounds(track, scene), hovered);
+            }
+        }
+    }
+
+    void mouseMove(const juce::MouseEvent& e) override {
+        int track = -1, scene = -1;
+        getCellAt(e.getPosition(), track, scene);
+        setHoveredCell(track, scene);
+    }
+
+    void mouseExit(const juce::MouseEvent&) override {
+        setHoveredCell(-1, -1);
+    }
+
+    void mouseUp(const juce::MouseEvent& e) override {
+        // A click is a press and release on the same cell, as it was for a button
+        int downTrack = -1, downScene = -1, upTrack = -1, upScene = -1;
+        if (getCellAt(e.getMouseDownPosition(), downTrack, downScene) &&
+            getCellAt(e.getPosition(), upTrack, upScene) && downTrack == upTrack &&
+            downScene == upScene) {
+            owner_.onClipSlotClicked(upTrack, upScene);
         }
     }
 
   private:
+    static constexpr int COLUMN_WIDTH = CLIP_SLOT_SIZE + TRACK_SEPARATOR_WIDTH;
+    static constexpr int ROW_HEIGHT = CLIP_SLOT_SIZE + CLIP_SLOT_MARGIN;
+
+    SessionView& owner_;
     int numTracks_ = 0;
-    int clipSize_;
-    int separatorWidth_;
+    int hoveredTrack_ = -1;
+    int hoveredScene_ = -1;
+
+    bool getCellAt(juce::Point<int> position, int& trackIndex, int& sceneIndex) const {
+        if (position.x < 0 || position.y < 0) {
+            return false;
+        }
+        trackIndex = position.x / COLUMN_WIDTH;
+        sceneIndex = position.y / ROW_HEIGHT;
+        return trackIndex < numTracks_ && sceneIndex < NUM_SCENES &&
+               getCellBounds(trackIndex, sceneIndex).contains(position);
+    }
+
+    void setHoveredCell(int trackIndex, int sceneIndex) {
+        if (trackIndex == hoveredTrack_ && sceneIndex == hoveredScene_) {
+            return;
+        }
+        repaintCell(hoveredTrack_, hoveredScene_);
+        hoveredTrack_ = trackIndex;
+        hoveredScene_ = sceneIndex;
+        repaintCell(hoveredTrack_, hoveredScene_);
+    }
 };
 
 // Container for track headers with clipping
@@ -74,7 +147,7 @@ SessionView::SessionView() {
     addAndMakeVisible(*sceneContainer);
 
     // Create viewport for scrollable grid with custom grid content
-    gridContent = std::make_unique<GridContent>(CLIP_SLOT_SIZE, TRACK_SEPARATOR_WIDTH);
+    gridContent = std::make_unique<GridContent>(*this);
     gridViewport = std::make_unique<juce::Viewport>();
     gridViewport->setViewedComponent(gridContent.get(), false);
     gridViewport->setScrollBarsShown(true, true);
@@ -104,8 +177,10 @@ SessionView::SessionView() {
 }
 
 SessionView::~SessionView() {
-    TrackManager::getInstance().removeListener(this);
-    ClipManager::getInstance().removeListener(this);
+    if (!suspended_) {
+        TrackManager::getInstance().removeListener(this);
+        ClipManager::getInstance().removeListener(this);
+    }
     ViewModeController::getInstance().removeListener(this);
     gridViewport->getHorizontalScrollBar().removeListener(this);
     gridViewport->getVerticalScrollBar().removeListener(this);
@@ -145,6 +220,27 @@ void SessionView::trackPropertyChanged(int trackId) {
 
 void SessionView::viewModeChanged(ViewMode mode, const AudioEngineProfile& /*profile*/) {
     currentViewMode_ = mode;
+    if (!suspended_) {
+        rebuildTracks();
+    }
+}
+
+void SessionView::setSuspended(bool shouldBeSuspended) {
+    if (suspended_ == shouldBeSuspended) {
+        return;
+    }
+    suspended_ = shouldBeSuspended;
+
+    if (suspended_) {
+        TrackManager::getInstance().removeListener(this);
+        ClipManager::getInstance().removeListener(this);
+        return;
+    }
+
+    // Catch up on everything missed while hidden in one pass
+    TrackManager::getInstance().addListener(this);
+    ClipManager::getInstance().addListener(this);
+    currentViewMode_ = ViewModeController::getInstance().getViewMode();
     rebuildTracks();
 }
 
@@ -159,8 +255,9 @@ void SessionView::masterChannelChanged() {
 void SessionView::rebuildTracks() {
     // Clear existing track headers and clip slots
     trackHeaders.clear();
-    clipSlots.clear();
     visibleTrackIds_.clear();
+    trackColumns_.clear();
+    paintedSlots_.clear();
 
     auto& trackManager = TrackManager::getInstance();
 
@@ -187,8 +284,11 @@ void SessionView::rebuildTracks() {
     }
 
     int numTracks = static_cast<int>(visibleTrackIds_.size());
+    for (int i = 0; i < numTracks; ++i) {
+        trackColumns_[visibleTrackIds_[i]] = i;
+    }
 
-    // Update grid content track count
+    // Update grid content track count (repaints every slot)
     gridContent->setNumTracks(numTracks);
 
     // Create track headers for visible tracks only
@@ -236,34 +336,6 @@ void SessionView::rebuildTracks() {
         trackHeaders.push_back(std::move(header));
     }
 
-    // Create clip slots for each visible track
-    for (int track = 0; track < numTracks; ++track) {
-        std::array<std::unique_ptr<juce::TextButton>, NUM_SCENES> trackSlots;
-
-        for (size_t scene = 0; scene < NUM_SCENES; ++scene) {
-            auto slot = std::make_unique<juce::TextButton>();
-
-            // Empty clip slot
-            slot->setButtonText("");
-            slot->setColour(juce::TextButton::buttonColourId,
-                            DarkTheme::getColour(DarkTheme::SURFACE));
-
-            slot->setColour(juce::TextButton::textColourOffId,
-                            DarkTheme::getColour(DarkTheme::TEXT_PRIMARY));
-
-            int trackIndex = track;
-            int sceneIndex = static_cast<int>(scene);
-            slot->onClick = [this, trackIndex, sceneIndex]() {
-                onClipSlotClicked(trackIndex, sceneIndex);
-            };
-
-            gridContent->addAndMakeVisible(*slot);
-            trackSlots[scene] = std::move(slot);
-        }
-
-        clipSlots.push_back(std::move(trackSlots));
-    }
-
     // Update master strip visibility
     const auto& master = TrackManager::getInstance().getMasterChannel();
     bool masterVisible = master.isVisibleIn(currentViewMode_);
@@ -326,15 +398,6 @@ void SessionView::resized() {
     int gridWidth = numTracks * trackColumnWidth;
     int gridHeight = NUM_SCENES * sceneRowHeight;
     gridContent->setSize(gridWidth, gridHeight);
-
-    // Position clip slots within grid content
-    for (int track = 0; track < numTracks; ++track) {
-        for (size_t scene = 0; scene < NUM_SCENES; ++scene) {
-            int x = track * trackColumnWidth;
-            int y = static_cast<int>(scene) * sceneRowHeight;
-            clipSlots[track][scene]->setBounds(x, y, CLIP_SLOT_SIZE, CLIP_SLOT_SIZE);
-        }
-    }
 }
 
 void SessionView::scrollBarMoved(juce::ScrollBar* scrollBar, double newRangeStart) {
@@ -411,14 +474,9 @@ void SessionView::onClipSlotClicked(int trackIndex, int sceneIndex) {
 }
 
 void SessionView::onSceneLaunched(int sceneIndex) {
-    // Trigger all clips in this scene
-    for (size_t i = 0; i < visibleTrackIds_.size(); ++i) {
-        TrackId trackId = visibleTrackIds_[i];
-        ClipId clipId = ClipManager::getInstance().getClipInSlot(trackId, sceneIndex);
-        if (clipId != INVALID_CLIP_ID) {
-            ClipManager::getInstance().triggerClip(clipId);
-        }
-    }
+    // All clips in this scene start in the same sample, and chain on from there if the
+    // scene has a follow action
+    ClipManager::getInstance().launchScene(sceneIndex, visibleTrackIds_);
 }
 
 void SessionView::onStopAllClicked() {
@@ -474,98 +532,85 @@ void SessionView::updateHeaderSelectionVisuals() {
 // ============================================================================
 
 void SessionView::clipsChanged() {
-    updateAllClipSlots();
+    repaintAllClipSlots();
 }
 
 void SessionView::clipPropertyChanged(ClipId clipId) {
-    // Find clip and update its slot
-    const auto* clip = ClipManager::getInstance().getClip(clipId);
-    if (!clip || clip->sceneIndex < 0)
-        return;
-
-    // Find track index
-    int trackIndex = -1;
-    for (size_t i = 0; i < visibleTrackIds_.size(); ++i) {
-        if (visibleTrackIds_[i] == clip->trackId) {
-            trackIndex = static_cast<int>(i);
-            break;
-        }
-    }
-
-    if (trackIndex >= 0) {
-        updateClipSlotAppearance(trackIndex, clip->sceneIndex);
-    }
+    // Name, colour, scene or track may have changed; the cell always repaints
+    repaintClipSlot(clipId);
 }
 
 void SessionView::clipPlaybackStateChanged(ClipId clipId) {
-    // Update slot appearance when playback state changes
+    // Nothing to repaint if the clip's cell already shows this state
     const auto* clip = ClipManager::getInstance().getClip(clipId);
-    if (!clip || clip->sceneIndex < 0)
+    auto painted = paintedSlots_.find(clipId);
+    auto column = clip ? trackColumns_.find(clip->trackId) : trackColumns_.end();
+    if (painted != paintedSlots_.end() && column != trackColumns_.end() &&
+        painted->second.trackIndex == column->second &&
+        painted->second.sceneIndex == clip->sceneIndex &&
+        painted->second.isPlaying == clip->isPlaying &&
+        painted->second.isQueued == clip->isQueued) {
         return;
+    }
+    repaintClipSlot(clipId);
+}
 
-    // Find track index
-    int trackIndex = -1;
-    for (size_t i = 0; i < visibleTrackIds_.size(); ++i) {
-        if (visibleTrackIds_[i] == clip->trackId) {
-            trackIndex = static_cast<int>(i);
-            break;
+void SessionView::paintClipSlot(juce::Graphics& g, int trackIndex, int sceneIndex,
+                                juce::Rectangle<int> bounds, bool isHovered) {
+    auto& clipManager = ClipManager::getInstance();
+    ClipId clipId = clipManager.getClipInSlot(visibleTrackIds_[trackIndex], sceneIndex);
+    const auto* clip = clipId != INVALID_CLIP_ID ? clipManager.getClip(clipId) : nullptr;
+
+    auto fill = DarkTheme::getColour(DarkTheme::SURFACE);
+    auto text = DarkTheme::getColour(DarkTheme::TEXT_PRIMARY);
+    if (clip) {
+        if (clip->isPlaying) {
+            // Playing: bright green
+            fill = DarkTheme::getColour(DarkTheme::STATUS_SUCCESS);
+            text = DarkTheme::getColour(DarkTheme::BACKGROUND);
+        } else if (clip->isQueued) {
+            // Queued to start at the next launch boundary
+            fill = DarkTheme::getColour(DarkTheme::STATUS_WARNING);
+            text = DarkTheme::getColour(DarkTheme::BACKGROUND);
+        } else {
+            // Has clip but not playing: clip color
+            fill = clip->colour.withAlpha(0.7f);
         }
+        paintedSlots_[clipId] = {trackIndex, sceneIndex, clip->isPlaying, clip->isQueued};
     }
 
-    if (trackIndex >= 0) {
-        updateClipSlotAppearance(trackIndex, clip->sceneIndex);
+    g.setColour(isHovered ? fill.brighter(0.15f) : fill);
+    g.fillRoundedRectangle(bounds.toFloat(), 3.0f);
+
+    if (clip) {
+        g.setColour(text);
+        g.setFont(FontManager::getInstance().getUIFont(11.0f));
+        g.drawFittedText(clip->name, bounds.reduced(4), juce::Justification::centred, 2);
     }
 }
 
-void SessionView::updateClipSlotAppearance(int trackIndex, int sceneIndex) {
-    if (trackIndex < 0 || trackIndex >= static_cast<int>(clipSlots.size()))
-        return;
-    if (sceneIndex < 0 || sceneIndex >= NUM_SCENES)
-        return;
+void SessionView::repaintClipSlot(ClipId clipId) {
+    // The cell it was last painted in, in case it has since moved out of it
+    auto painted = paintedSlots_.find(clipId);
+    if (painted != paintedSlots_.end()) {
+        gridContent->repaintCell(painted->second.trackIndex, painted->second.sceneIndex);
+        paintedSlots_.erase(painted);
+    }
 
-    auto* slot = clipSlots[trackIndex][sceneIndex].get();
-    if (!slot)
+    const auto* clip = ClipManager::getInstance().getClip(clipId);
+    if (!clip || clip->sceneIndex < 0)
         return;
 
-    TrackId trackId = visibleTrackIds_[trackIndex];
-    ClipId clipId = ClipManager::getInstance().getClipInSlot(trackId, sceneIndex);
-
-    if (clipId != INVALID_CLIP_ID) {
-        const auto* clip = ClipManager::getInstance().getClip(clipId);
-        if (clip) {
-            // Show clip name
-            slot->setButtonText(clip->name);
-
-            // Set color based on clip state
-            if (clip->isPlaying) {
-                // Playing: bright green
-                slot->setColour(juce::TextButton::buttonColourId,
-                                DarkTheme::getColour(DarkTheme::STATUS_SUCCESS));
-                slot->setColour(juce::TextButton::textColourOffId,
-                                DarkTheme::getColour(DarkTheme::BACKGROUND));
-            } else {
-                // Has clip but not playing: clip color
-                slot->setColour(juce::TextButton::buttonColourId, clip->colour.withAlpha(0.7f));
-                slot->setColour(juce::TextButton::textColourOffId,
-                                DarkTheme::getColour(DarkTheme::TEXT_PRIMARY));
-            }
-        }
-    } else {
-        // Empty slot
-        slot->setButtonText("");
-        slot->setColour(juce::TextButton::buttonColourId, DarkTheme::getColour(DarkTheme::SURFACE));
-        slot->setColour(juce::TextButton::textColourOffId,
-                        DarkTheme::getColour(DarkTheme::TEXT_PRIMARY));
+    auto column = trackColumns_.find(clip->trackId);
+    if (column != trackColumns_.end()) {
+        gridContent->repaintCell(column->second, clip->sceneIndex);
     }
 }
 
-void SessionView::updateAllClipSlots() {
-    int numTracks = static_cast<int>(visibleTrackIds_.size());
-    for (int trackIndex = 0; trackIndex < numTracks; ++trackIndex) {
-        for (int sceneIndex = 0; sceneIndex < NUM_SCENES; ++sceneIndex) {
-            updateClipSlotAppearance(trackIndex, sceneIndex);
-        }
-    }
+void SessionView::repaintAllClipSlots() {
+    // Only the cells on screen are actually repainted
+    paintedSlots_.clear();
+    gridContent->repaint();
 }
 
 }  // namespace magda
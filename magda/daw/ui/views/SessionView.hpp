@@ -4,6 +4,7 @@
 
 #include <array>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 #include "../components/mixer/MasterChannelStrip.hpp"
@@ -21,6 +22,9 @@ namespace magda {
  * - Track headers at the top
  * - Scene launch buttons on the right
  * - Real-time clip status indicators
+ *
+ * The clip slots aren't components: the grid paints whichever cells are on screen straight
+ * from ClipManager's slot index, and a clip's state change repaints only its own cell.
  */
 class SessionView : public juce::Component,
                     private juce::ScrollBar::Listener,
@@ -48,6 +52,18 @@ class SessionView : public juce::Component,
     // ViewModeListener
     void viewModeChanged(ViewMode mode, const AudioEngineProfile& profile) override;
 
+    /**
+     * @brief Stop following tracks and clips while hidden
+     *
+     * A suspended view isn't a TrackManager or ClipManager listener; resuming rebuilds the
+     * grid once for whatever changed in the meantime.
+     */
+    void setSuspended(bool shouldBeSuspended);
+
+    bool isSuspended() const {
+        return suspended_;
+    }
+
   private:
     // ScrollBar::Listener
     void scrollBarMoved(juce::ScrollBar* scrollBar, double newRangeStart) override;
@@ -67,16 +83,13 @@ class SessionView : public juce::Component,
     // Track headers (dynamic based on TrackManager) - TextButton for clickable groups
     std::vector<std::unique_ptr<juce::TextButton>> trackHeaders;
 
-    // Clip slots grid [track][scene] - dynamic number of tracks
-    std::vector<std::array<std::unique_ptr<juce::TextButton>, NUM_SCENES>> clipSlots;
-
     // Scene launch buttons
     std::array<std::unique_ptr<juce::TextButton>, NUM_SCENES> sceneButtons;
 
     // Master scene button
     std::unique_ptr<juce::TextButton> stopAllButton;
 
-    // Custom grid content component that draws track separators
+    // Grid content that paints the visible clip slots and track separators
     class GridContent;
     std::unique_ptr<juce::Viewport> gridViewport;
     std::unique_ptr<GridContent> gridContent;
@@ -100,14 +113,29 @@ class SessionView : public juce::Component,
     // View mode state
     ViewMode currentViewMode_ = ViewMode::Live;
     std::vector<TrackId> visibleTrackIds_;
+    std::unordered_map<TrackId, int> trackColumns_;  // Index into visibleTrackIds_
+    bool suspended_ = false;
 
     // Selection
     void selectTrack(TrackId trackId);
     void updateHeaderSelectionVisuals();
 
     // Clip slot display
-    void updateClipSlotAppearance(int trackIndex, int sceneIndex);
-    void updateAllClipSlots();
+    struct PaintedSlot {
+        int trackIndex;
+        int sceneIndex;
+        bool isPlaying;
+        bool isQueued;
+    };
+
+    // Where each on-screen clip was last painted and how, so a change that doesn't alter its
+    // cell repaints nothing and a clip that moved also clears the cell it left
+    std::unordered_map<ClipId, PaintedSlot> paintedSlots_;
+
+    void paintClipSlot(juce::Graphics& g, int trackIndex, int sceneIndex,
+                       juce::Rectangle<int> bounds, bool isHovered);
+    void repaintClipSlot(ClipId clipId);
+    void repaintAllClipSlots();
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SessionView)
 };
@@ -1,8 +1,13 @@
 #include "MainWindow.hpp"
 
+#include "../../core/AutomationRecorder.hpp"
 #include "../../core/ClipCommands.hpp"
 #include "../../core/ClipManager.hpp"
+#include "../../profiling/LoadProfiler.hpp"
+#include "../../profiling/MetricsExporter.hpp"
 #include "../../profiling/PerformanceProfiler.hpp"
+#include "../../profiling/StallWatchdog.hpp"
+#include "../../profiling/UIFrameProfiler.hpp"
 #include "../debug/DebugDialog.hpp"
 #include "../debug/DebugSettings.hpp"
 #include "../dialogs/AudioSettingsDialog.hpp"
@@ -20,13 +25,19 @@
 #include "../views/MixerView.hpp"
 #include "../views/SessionView.hpp"
 #include "audio/AudioBridge.hpp"
+#include "audio/AudioFileImporter.hpp"
+#include "audio/ClipProcessor.hpp"
+#include "core/AutosaveManager.hpp"
 #include "core/Config.hpp"
 #include "core/LinkModeManager.hpp"
 #include "core/ModulatorEngine.hpp"
+#include "core/ProjectManager.hpp"
+#include "core/SelectionManager.hpp"
 #include "core/TrackCommands.hpp"
 #include "core/TrackManager.hpp"
 #include "core/UndoManager.hpp"
 #include "engine/PlaybackPositionTimer.hpp"
+#include "engine/ProjectSwitcher.hpp"
 #include "engine/TracktionEngineWrapper.hpp"
 
 namespace magda {
@@ -183,12 +194,31 @@ MainWindow::MainWindow(AudioEngine* audioEngine)
 
     // Start modulation engine at 60 FPS (updates LFO values in background)
     magda::ModulatorEngine::getInstance().startTimer(16);
+
+    // Time message-loop stalls for the frame stats (see UIFrameProfiler)
+    magda::UIFrameProfiler::getInstance().startMessageLatencyProbe();
+
+    // Log the message thread's stack when it hangs for longer (see StallWatchdog)
+    magda::StallWatchdog::getInstance().start();
+
+    // Publish live counters for unattended rigs, if configured
+    const auto& config = magda::Config::getInstance();
+    if (config.getMetricsPort() > 0) {
+        magda::MetricsExporter::getInstance().start(config.getMetricsPort(),
+                                                    !config.getMetricsRemoteAccess());
+    }
+
+    startAutosave();
 }
 
 MainWindow::~MainWindow() {
     std::cout << "  [5a] MainWindow::~MainWindow start" << std::endl;
     std::cout.flush();
 
+    magda::UIFrameProfiler::getInstance().stopMessageLatencyProbe();
+    magda::StallWatchdog::getInstance().stop();
+    magda::MetricsExporter::getInstance().stop();
+
 #if JUCE_DEBUG
     // Print profiling report if enabled, then shutdown to clear JUCE objects
     auto& monitor = magda::PerformanceMonitor::getInstance();
@@ -234,6 +264,7 @@ MainWindow::MainComponent::MainComponent(AudioEngine* externalEngine) {
 
     // Initialize TrackManager with audio engine for routing operations
     TrackManager::getInstance().setAudioEngine(externalEngine);
+    AutomationRecorder::getInstance().setAudioEngine(externalEngine);
 
     // Initialize panel sizes from LayoutConfig
     auto& layout = LayoutConfig::getInstance();
@@ -286,12 +317,6 @@ MainWindow::MainComponent::MainComponent(AudioEngine* externalEngine) {
     mainView = std::make_unique<MainView>(externalEngine);
     addAndMakeVisible(*mainView);
 
-    sessionView = std::make_unique<SessionView>();
-    addChildComponent(*sessionView);
-
-    mixerView = std::make_unique<MixerView>(externalEngine);
-    addChildComponent(*mixerView);
-
     // Wire up callbacks between views and transport
     mainView->onLoopRegionChanged = [this](double start, double end, bool enabled) {
         transportPanel->setLoopRegion(start, end, enabled);
@@ -307,6 +332,10 @@ MainWindow::MainComponent::MainComponent(AudioEngine* externalEngine) {
     setupViewModeListener();
     setupAudioEngineCallbacks(externalEngine);
     setupDeviceLoadingCallback();
+    setupImportProgressCallback();
+    setupClipProcessingProgressCallback();
+    startTimer(kPrewarmDelayMs);
+    gpuRenderer_.setEnabled(config.getGpuRendering());
 
 // Enable profiling if environment variable is set
 #if JUCE_DEBUG
@@ -491,9 +520,54 @@ void MainWindow::MainComponent::setupDeviceLoadingCallback() {
     }
 }
 
+void MainWindow::MainComponent::setupImportProgressCallback() {
+    // Dropped files are prepared in the background; show how far along they are
+    auto& importer = AudioFileImporter::getInstance();
+    importer.onProgress = [this](const AudioFileImporter::Progress& progress) {
+        if (!loadingOverlay_) {
+            return;
+        }
+        if (progress.total > 0) {
+            loadingOverlay_->setMessage("Importing audio files (" +
+                                        juce::String(progress.completed) + " of " +
+                                        juce::String(progress.total) + ")\n" +
+                                        progress.fileName);
+            loadingOverlay_->showWithFade();
+            loadingOverlay_->toFront(false);
+        } else {
+            loadingOverlay_->setMessage("Imported " + juce::String(progress.completed) +
+                                        (progress.completed == 1 ? " file" : " files"));
+            loadingOverlay_->hideWithFade();
+        }
+    };
+}
+
+void MainWindow::MainComponent::setupClipProcessingProgressCallback() {
+    // Normalise, reverse and consolidate render in the background; show how far along
+    ClipProcessor::getInstance().onProgress = [this](const ClipProcessor::Progress& progress) {
+        if (!loadingOverlay_) {
+            return;
+        }
+        if (progress.running > 0) {
+            loadingOverlay_->setMessage("Processing " + juce::String(progress.running) +
+                                        (progress.running == 1 ? " clip (" : " clips (") +
+                                        juce::String(juce::roundToInt(progress.fraction * 100.0f)) +
+                                        "%)\n" + progress.clipName);
+            loadingOverlay_->showWithFade();
+            loadingOverlay_->toFront(false);
+        } else {
+            loadingOverlay_->hideWithFade();
+        }
+    };
+}
+
 MainWindow::MainComponent::~MainComponent() {
     std::cout << "    [5d] MainComponent::~MainComponent start" << std::endl;
     std::cout.flush();
+    stopTimer();
+    gpuRenderer_.setEnabled(false);  // Stop the GL thread before the children go
+    AudioFileImporter::getInstance().onProgress = nullptr;
+    ClipProcessor::getInstance().onProgress = nullptr;
 
     // Stop position timer before destroying
     std::cout << "    [5e] Stopping position timer..." << std::endl;
@@ -546,6 +620,8 @@ MainWindow::MainComponent::~MainComponent() {
     rightResizer.reset();
     bottomResizer.reset();
 
+    AutomationRecorder::getInstance().setAudioEngine(nullptr);
+
     std::cout << "    [5n] Destroying internal audioEngine_..." << std::endl;
     std::cout.flush();
     audioEngine_.reset();
@@ -776,9 +852,50 @@ void MainWindow::MainComponent::layoutSidePanels(juce::Rectangle<int>& bounds) {
 }
 
 void MainWindow::MainComponent::layoutContentArea(juce::Rectangle<int>& bounds) {
+    contentBounds_ = bounds;
     mainView->setBounds(bounds);
-    sessionView->setBounds(bounds);
-    mixerView->setBounds(bounds);
+    if (sessionView) {
+        sessionView->setBounds(bounds);
+    }
+    if (mixerView) {
+        mixerView->setBounds(bounds);
+    }
+}
+
+SessionView& MainWindow::MainComponent::getSessionView() {
+    if (!sessionView) {
+        LoadProfiler::ScopedPhase phase("Session view");
+        sessionView = std::make_unique<SessionView>();
+        sessionView->setSuspended(currentViewMode != ViewMode::Live);  // Prewarmed hidden
+        sessionView->setBounds(contentBounds_);
+        addChildComponent(*sessionView);
+    }
+    return *sessionView;
+}
+
+MixerView& MainWindow::MainComponent::getMixerView() {
+    if (!mixerView) {
+        LoadProfiler::ScopedPhase phase("Mixer view");
+        mixerView = std::make_unique<MixerView>(getAudioEngine());
+        mixerView->setSuspended(currentViewMode != ViewMode::Mix);  // Prewarmed hidden
+        mixerView->setBounds(contentBounds_);
+        addChildComponent(*mixerView);
+    }
+    return *mixerView;
+}
+
+void MainWindow::MainComponent::timerCallback() {
+    stopTimer();
+
+    // From the arrangement people mostly go to the mixer, and from the mixer to the session
+    if (currentViewMode == ViewMode::Mix) {
+        getSessionView();
+    } else {
+        getMixerView();
+    }
+
+    // Selecting a MIDI clip opens the piano roll, the heaviest panel content
+    bottomPanel->prewarmContent(daw::ui::PanelContentType::PianoRoll);
 }
 
 void MainWindow::MainComponent::viewModeChanged(ViewMode mode,
@@ -792,16 +909,20 @@ void MainWindow::MainComponent::viewModeChanged(ViewMode mode,
 void MainWindow::MainComponent::switchToView(ViewMode mode) {
     // Hide all views first
     mainView->setVisible(false);
-    sessionView->setVisible(false);
-    mixerView->setVisible(false);
+    if (sessionView) {
+        sessionView->setVisible(false);
+    }
+    if (mixerView) {
+        mixerView->setVisible(false);
+    }
 
     // Show the appropriate view
     switch (mode) {
         case ViewMode::Live:
-            sessionView->setVisible(true);
+            getSessionView().setVisible(true);
             break;
         case ViewMode::Mix:
-            mixerView->setVisible(true);
+            getMixerView().setVisible(true);
             break;
         case ViewMode::Arrange:
         case ViewMode::Master:
@@ -810,6 +931,15 @@ void MainWindow::MainComponent::switchToView(ViewMode mode) {
             break;
     }
 
+    // Hidden views drop their track and clip listeners and meters; the one shown catches up
+    mainView->setSuspended(!mainView->isVisible());
+    if (sessionView) {
+        sessionView->setSuspended(!sessionView->isVisible());
+    }
+    if (mixerView) {
+        mixerView->setSuspended(!mixerView->isVisible());
+    }
+
     DBG("Switched to view mode: " << getViewModeName(mode));
 }
 
@@ -827,6 +957,178 @@ void MainWindow::setupMenuBar() {
 #endif
 }
 
+// =============================================================================
+// Project files
+// =============================================================================
+
+void MainWindow::openProject() {
+    // Prevent re-entry while a file chooser is already open
+    if (fileChooser_ != nullptr)
+        return;
+
+    fileChooser_ = std::make_unique<juce::FileChooser>(
+        "Open Project", juce::File::getSpecialLocation(juce::File::userDocumentsDirectory),
+        juce::String("*") + ProjectFile::kFileExtension, true);
+
+    auto flags = juce::FileBrowserComponent::openMode | juce::FileBrowserComponent::canSelectFiles;
+    fileChooser_->launchAsync(flags, [this](const juce::FileChooser& chooser) {
+        const auto file = chooser.getResult();
+        fileChooser_.reset();
+        if (file == juce::File())
+            return;  // User cancelled
+
+        juce::Component::SafePointer<MainWindow> safeThis(this);
+        ProjectManager::getInstance().openAsync(file, [safeThis, file](const juce::String& error) {
+            if (safeThis == nullptr)
+                return;
+            if (error.isNotEmpty()) {
+                safeThis->showProjectError("Open Project", error);
+            } else {
+                safeThis->setName("MAGDA - " + file.getFileNameWithoutExtension());
+            }
+        });
+    });
+}
+
+ProjectSwitcher* MainWindow::getProjectSwitcher() {
+    if (projectSwitcher_ == nullptr && mainComponent != nullptr) {
+        if (auto* engine = dynamic_cast<TracktionEngineWrapper*>(mainComponent->getAudioEngine()))
+            projectSwitcher_ = std::make_unique<ProjectSwitcher>(*engine);
+    }
+    return projectSwitcher_.get();
+}
+
+void MainWindow::preloadProject() {
+    if (fileChooser_ != nullptr || getProjectSwitcher() == nullptr)
+        return;
+
+    fileChooser_ = std::make_unique<juce::FileChooser>(
+        "Preload Next Project", juce::File::getSpecialLocation(juce::File::userDocumentsDirectory),
+        juce::String("*") + ProjectFile::kFileExtension, true);
+
+    auto flags = juce::FileBrowserComponent::openMode | juce::FileBrowserComponent::canSelectFiles;
+    fileChooser_->launchAsync(flags, [this](const juce::FileChooser& chooser) {
+        const auto file = chooser.getResult();
+        fileChooser_.reset();
+        if (file == juce::File())
+            return;  // User cancelled
+
+        juce::Component::SafePointer<MainWindow> safeThis(this);
+        projectSwitcher_->preload(file, [safeThis](const juce::String& error) {
+            if (safeThis != nullptr && error.isNotEmpty())
+                safeThis->showProjectError("Preload Project", error);
+        });
+    });
+}
+
+void MainWindow::switchToPreloadedProject() {
+    auto* switcher = getProjectSwitcher();
+    if (switcher == nullptr)
+        return;
+
+    const auto file = switcher->getPreloadedFile();
+    juce::Component::SafePointer<MainWindow> safeThis(this);
+    switcher->switchToPreloaded({}, [safeThis, file](const juce::String& error) {
+        if (safeThis == nullptr)
+            return;
+        if (error.isNotEmpty()) {
+            safeThis->showProjectError("Switch Project", error);
+        } else {
+            safeThis->setName("MAGDA - " + file.getFileNameWithoutExtension());
+        }
+    });
+}
+
+void MainWindow::saveProject(bool chooseFile) {
+    auto& projectManager = ProjectManager::getInstance();
+    juce::Component::SafePointer<MainWindow> safeThis(this);
+    auto onSaved = [safeThis](const juce::String& error) {
+        if (safeThis == nullptr)
+            return;
+        if (error.isNotEmpty()) {
+            safeThis->showProjectError("Save Project", error);
+        } else {
+            const auto& file = ProjectManager::getInstance().getCurrentFile();
+            safeThis->setName("MAGDA - " + file.getFileNameWithoutExtension());
+        }
+    };
+
+    const auto currentFile = projectManager.getCurrentFile();
+    if (!chooseFile && currentFile != juce::File()) {
+        projectManager.saveAsync(currentFile, onSaved);
+        return;
+    }
+
+    if (fileChooser_ != nullptr)
+        return;
+
+    auto initial = currentFile != juce::File()
+                       ? currentFile
+                       : juce::File::getSpecialLocation(juce::File::userDocumentsDirectory)
+                             .getChildFile(juce::String("Untitled") + ProjectFile::kFileExtension);
+    fileChooser_ = std::make_unique<juce::FileChooser>(
+        "Save Project", initial, juce::String("*") + ProjectFile::kFileExtension, true);
+
+    auto flags = juce::FileBrowserComponent::saveMode |
+                 juce::FileBrowserComponent::canSelectFiles |
+                 juce::FileBrowserComponent::warnAboutOverwriting;
+    fileChooser_->launchAsync(flags, [this, onSaved](const juce::FileChooser& chooser) {
+        auto file = chooser.getResult();
+        fileChooser_.reset();
+        if (file == juce::File())
+            return;  // User cancelled
+
+        file = file.withFileExtension(ProjectFile::kFileExtension);
+        ProjectManager::getInstance().saveAsync(file, onSaved);
+    });
+}
+
+void MainWindow::showProjectError(const juce::String& title, const juce::String& error) {
+    juce::AlertWindow::showMessageBoxAsync(juce::AlertWindow::WarningIcon, title, error);
+}
+
+void MainWindow::startAutosave() {
+    auto& autosave = AutosaveManager::getInstance();
+    if (!autosave.hasRecoveryData()) {
+        autosave.start();
+        return;
+    }
+
+    // Files left behind mean the last session didn't exit cleanly
+    auto options = juce::MessageBoxOptions()
+                       .withTitle("Recover Project")
+                       .withMessage("MAGDA didn't shut down properly last time.\n\n"
+                                    "Recover the project from its autosave?")
+                       .withButton("Recover")
+                       .withButton("Discard")
+                       .withIconType(juce::MessageBoxIconType::QuestionIcon);
+
+    juce::Component::SafePointer<MainWindow> safeThis(this);
+    juce::AlertWindow::showAsync(options, [safeThis](int result) {
+        auto& autosave = AutosaveManager::getInstance();
+        if (result != 1) {  // "Discard" button
+            autosave.start();
+            return;
+        }
+
+        auto onRecovered = [safeThis](const juce::String& error) {
+            if (safeThis != nullptr) {
+                if (error.isNotEmpty()) {
+                    safeThis->showProjectError("Recover Project", error);
+                } else {
+                    const auto& file = ProjectManager::getInstance().getCurrentFile();
+                    safeThis->setName("MAGDA - " +
+                                      (file != juce::File() ? file.getFileNameWithoutExtension()
+                                                            : juce::String("Untitled")) +
+                                      " (Recovered)");
+                }
+            }
+            AutosaveManager::getInstance().start();
+        };
+        ProjectManager::getInstance().recoverAsync(autosave.getDirectory(), onRecovered);
+    });
+}
+
 void MainWindow::setupMenuCallbacks() {
     MenuManager::MenuCallbacks callbacks;
 
@@ -837,24 +1139,11 @@ void MainWindow::setupMenuCallbacks() {
                                                "New project functionality not yet implemented.");
     };
 
-    callbacks.onOpenProject = [this]() {
-        // TODO: Implement open project
-        juce::AlertWindow::showMessageBoxAsync(juce::AlertWindow::InfoIcon, "Open Project",
-                                               "Open project functionality not yet implemented.");
-    };
-
-    callbacks.onSaveProject = [this]() {
-        // TODO: Implement save project
-        juce::AlertWindow::showMessageBoxAsync(juce::AlertWindow::InfoIcon, "Save Project",
-                                               "Save project functionality not yet implemented.");
-    };
-
-    callbacks.onSaveProjectAs = [this]() {
-        // TODO: Implement save project as
-        juce::AlertWindow::showMessageBoxAsync(
-            juce::AlertWindow::InfoIcon, "Save Project As",
-            "Save project as functionality not yet implemented.");
-    };
+    callbacks.onOpenProject = [this]() { openProject(); };
+    callbacks.onPreloadProject = [this]() { preloadProject(); };
+    callbacks.onSwitchToPreloadedProject = [this]() { switchToPreloadedProject(); };
+    callbacks.onSaveProject = [this]() { saveProject(false); };
+    callbacks.onSaveProjectAs = [this]() { saveProject(true); };
 
     callbacks.onImportAudio = [this]() {
         if (!mainComponent)
@@ -992,7 +1281,33 @@ void MainWindow::setupMenuCallbacks() {
                                                "Select all functionality not yet implemented.");
     };
 
-    callbacks.onPreferences = [this]() { PreferencesDialog::showDialog(this); };
+    // Selected audio clips are rendered in the background and swapped in as they finish
+    auto processSelectedClips = [](ClipProcessor::Operation operation) {
+        const auto folder = ProjectManager::getInstance().getMediaFolder("Processed Audio");
+        for (ClipId clipId : SelectionManager::getInstance().getSelectedClips()) {
+            ClipProcessor::getInstance().process(clipId, operation, folder);
+        }
+    };
+    callbacks.onNormaliseClips = [processSelectedClips]() {
+        processSelectedClips(ClipProcessor::Operation::Normalise);
+    };
+    callbacks.onReverseClips = [processSelectedClips]() {
+        processSelectedClips(ClipProcessor::Operation::Reverse);
+    };
+    callbacks.onConsolidateClips = [processSelectedClips]() {
+        processSelectedClips(ClipProcessor::Operation::Consolidate);
+    };
+
+    callbacks.onPreferences = [this]() {
+        PreferencesDialog::showDialog(this, [this]() {
+            if (mainComponent) {
+                if (auto* engine = mainComponent->getAudioEngine()) {
+                    engine->applyRenderThreadSettings();
+                }
+                mainComponent->setGpuRendering(magda::Config::getInstance().getGpuRendering());
+            }
+        });
+    };
 
     callbacks.onAudioSettings = [this]() {
         DBG("onAudioSettings called");
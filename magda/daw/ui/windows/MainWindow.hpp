@@ -5,6 +5,7 @@
 #include <memory>
 
 #include "../layout/LayoutConfig.hpp"
+#include "../utils/GpuRenderer.hpp"
 #include "MenuManager.hpp"
 #include "core/ViewModeController.hpp"
 #include "core/ViewModeState.hpp"
@@ -22,6 +23,7 @@ class BottomPanel;
 class FooterBar;
 class AudioEngine;
 class PlaybackPositionTimer;
+class ProjectSwitcher;
 
 class MainWindow : public juce::DocumentWindow {
   public:
@@ -41,15 +43,28 @@ class MainWindow : public juce::DocumentWindow {
     // File chooser for async file import
     std::unique_ptr<juce::FileChooser> fileChooser_;
 
+    // Preloads the next project while this one plays; destroyed before the engine
+    std::unique_ptr<ProjectSwitcher> projectSwitcher_;
+
     void setupMenuBar();
     void setupMenuCallbacks();
 
+    // Project files
+    void openProject();
+    void preloadProject();
+    void switchToPreloadedProject();
+    ProjectSwitcher* getProjectSwitcher();
+    void saveProject(bool chooseFile);
+    void showProjectError(const juce::String& title, const juce::String& error);
+    void startAutosave();
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MainWindow)
 };
 
 class MainWindow::MainComponent : public juce::Component,
                                   public juce::DragAndDropContainer,
-                                  public ViewModeListener {
+                                  public ViewModeListener,
+                                  private juce::Timer {
   public:
     MainComponent(AudioEngine* externalEngine = nullptr);
     ~MainComponent() override;
@@ -74,8 +89,8 @@ class MainWindow::MainComponent : public juce::Component,
 
     std::unique_ptr<TransportPanel> transportPanel;
     std::unique_ptr<MainView> mainView;
-    std::unique_ptr<SessionView> sessionView;
-    std::unique_ptr<MixerView> mixerView;
+    std::unique_ptr<SessionView> sessionView;  // Built on first show (or pre-warm)
+    std::unique_ptr<MixerView> mixerView;      // Built on first show (or pre-warm)
     std::unique_ptr<FooterBar> footerBar;
 
     // Access to audio engine for settings dialog
@@ -84,6 +99,11 @@ class MainWindow::MainComponent : public juce::Component,
         return externalAudioEngine_ ? externalAudioEngine_ : audioEngine_.get();
     }
 
+    // Paint the whole window, timeline and mixer included, through OpenGL
+    void setGpuRendering(bool enabled) {
+        gpuRenderer_.setEnabled(enabled);
+    }
+
   private:
     // Current view mode
     ViewMode currentViewMode = ViewMode::Arrange;
@@ -111,7 +131,7 @@ class MainWindow::MainComponent : public juce::Component,
     std::unique_ptr<ResizeHandle> rightResizer;
     std::unique_ptr<ResizeHandle> bottomResizer;
 
-    // Loading overlay (shown during device initialization)
+    // Loading overlay (shown during device initialization and file imports)
     class LoadingOverlay;
     std::unique_ptr<LoadingOverlay> loadingOverlay_;
 
@@ -120,6 +140,8 @@ class MainWindow::MainComponent : public juce::Component,
     void setupViewModeListener();
     void setupAudioEngineCallbacks(AudioEngine* engine);
     void setupDeviceLoadingCallback();
+    void setupImportProgressCallback();
+    void setupClipProcessingProgressCallback();
 
     // Layout helpers
     void layoutTransportArea(juce::Rectangle<int>& bounds);
@@ -131,6 +153,17 @@ class MainWindow::MainComponent : public juce::Component,
     // View switching helper
     void switchToView(ViewMode mode);
 
+    // Only the arrangement (which owns the timeline) is built up front. The other views, and
+    // panel contents, are built the first time they're shown; once startup has settled the
+    // likeliest next view is built in the idle time so the first switch to it is instant.
+    static constexpr int kPrewarmDelayMs = 1500;
+    SessionView& getSessionView();
+    MixerView& getMixerView();
+
+    GpuRenderer gpuRenderer_{*this};  // Config's gpuRendering
+    juce::Rectangle<int> contentBounds_;
+    void timerCallback() override;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MainComponent)
 };
 
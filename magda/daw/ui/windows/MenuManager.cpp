@@ -52,6 +52,8 @@ juce::PopupMenu MenuManager::getMenuForIndex(int topLevelMenuIndex, const juce::
         menu.addItem(NewProject, "New Project", true, false);
         menu.addSeparator();
         menu.addItem(OpenProject, "Open Project...", true, false);
+        menu.addItem(PreloadProject, "Preload Next Project...", true, false);
+        menu.addItem(SwitchToPreloadedProject, "Switch to Preloaded Project", true, false);
         menu.addSeparator();
         menu.addItem(SaveProject, "Save Project", true, false);
         menu.addItem(SaveProjectAs, "Save Project As...", true, false);
@@ -96,6 +98,10 @@ juce::PopupMenu MenuManager::getMenuForIndex(int topLevelMenuIndex, const juce::
         menu.addItem(Delete, "Delete", hasSelection_, false);
         menu.addSeparator();
         menu.addItem(SelectAll, "Select All", true, false);
+        menu.addSeparator();
+        menu.addItem(NormaliseClips, "Normalise Clips", true, false);
+        menu.addItem(ReverseClips, "Reverse Clips", true, false);
+        menu.addItem(ConsolidateClips, "Consolidate Clips", true, false);
 #if !JUCE_MAC
         menu.addSeparator();
         menu.addItem(Preferences, "Preferences...", true, false);
@@ -183,6 +189,14 @@ void MenuManager::menuItemSelected(int menuItemID, int topLevelMenuIndex) {
             if (callbacks_.onOpenProject)
                 callbacks_.onOpenProject();
             break;
+        case PreloadProject:
+            if (callbacks_.onPreloadProject)
+                callbacks_.onPreloadProject();
+            break;
+        case SwitchToPreloadedProject:
+            if (callbacks_.onSwitchToPreloadedProject)
+                callbacks_.onSwitchToPreloadedProject();
+            break;
         case SaveProject:
             if (callbacks_.onSaveProject)
                 callbacks_.onSaveProject();
@@ -233,6 +247,18 @@ void MenuManager::menuItemSelected(int menuItemID, int topLevelMenuIndex) {
             if (callbacks_.onSelectAll)
                 callbacks_.onSelectAll();
             break;
+        case NormaliseClips:
+            if (callbacks_.onNormaliseClips)
+                callbacks_.onNormaliseClips();
+            break;
+        case ReverseClips:
+            if (callbacks_.onReverseClips)
+                callbacks_.onReverseClips();
+            break;
+        case ConsolidateClips:
+            if (callbacks_.onConsolidateClips)
+                callbacks_.onConsolidateClips();
+            break;
         case Preferences:
             if (callbacks_.onPreferences)
                 callbacks_.onPreferences();
@@ -15,6 +15,8 @@ class MenuManager : public juce::MenuBarModel, public UndoManagerListener {
         // File menu
         std::function<void()> onNewProject;
         std::function<void()> onOpenProject;
+        std::function<void()> onPreloadProject;
+        std::function<void()> onSwitchToPreloadedProject;
         std::function<void()> onSaveProject;
         std::function<void()> onSaveProjectAs;
         std::function<void()> onImportAudio;
@@ -29,6 +31,9 @@ class MenuManager : public juce::MenuBarModel, public UndoManagerListener {
         std::function<void()> onPaste;
         std::function<void()> onDelete;
         std::function<void()> onSelectAll;
+        std::function<void()> onNormaliseClips;
+        std::function<void()> onReverseClips;
+        std::function<void()> onConsolidateClips;
         std::function<void()> onPreferences;
 
         // Settings menu
@@ -117,6 +122,8 @@ class MenuManager : public juce::MenuBarModel, public UndoManagerListener {
         OpenProject,
         SaveProject,
         SaveProjectAs,
+        PreloadProject = 105,
+        SwitchToPreloadedProject,
         ImportAudio = 110,
         ExportAudio,
         Quit = 199,
@@ -129,6 +136,9 @@ class MenuManager : public juce::MenuBarModel, public UndoManagerListener {
         Paste,
         Delete,
         SelectAll = 220,
+        NormaliseClips = 230,
+        ReverseClips,
+        ConsolidateClips,
         Preferences = 299,
 
         // Settings menu (800-899)
@@ -10,15 +10,17 @@ namespace magda {
  * Tracks elapsed time since the last fired update and only allows
  * execution when the configured interval has passed. Call check()
  * on every drag event; it returns true at most once per interval.
+ * Drags preview locally and change the model once, on mouseUp; the
+ * throttle paces side channels such as auditioning the preview.
  *
  * Usage:
  * @code
- * DragThrottle throttle{50};  // 50ms interval
+ * DragThrottle throttle{100};  // 100ms interval
  *
  * void mouseDrag(...) {
- *     // ... compute preview values ...
+ *     // ... compute and draw preview values ...
  *     if (throttle.check()) {
- *         commitToModel();
+ *         auditionPreview();
  *     }
  * }
  *
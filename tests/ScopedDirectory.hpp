@@ -0,0 +1,30 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+namespace magda {
+
+/**
+ * @brief A fresh directory, deleted with everything in it at the end of the test
+ */
+struct ScopedDirectory {
+    /**
+     * @param prefix Name of the directory in the temp folder, made unique if it exists
+     */
+    explicit ScopedDirectory(const juce::String& prefix)
+        : directory(juce::File::getSpecialLocation(juce::File::tempDirectory)
+                        .getNonexistentChildFile(prefix, "", false)) {
+        directory.createDirectory();
+    }
+
+    ~ScopedDirectory() {
+        directory.deleteRecursively();
+    }
+
+    ScopedDirectory(const ScopedDirectory&) = delete;
+    ScopedDirectory& operator=(const ScopedDirectory&) = delete;
+
+    const juce::File directory;
+};
+
+}  // namespace magda
@@ -0,0 +1,65 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "../magda/daw/audio/AudioCallbackStats.hpp"
+
+using namespace magda;
+
+namespace {
+
+AudioCallbackTiming makeTiming(float parametersMs, float modulationMs, float intervalMs) {
+    AudioCallbackTiming timing;
+    timing.stageMs[AudioCallbackTiming::Parameters] = parametersMs;
+    timing.stageMs[AudioCallbackTiming::Modulation] = modulationMs;
+    timing.totalMs = parametersMs + modulationMs;
+    timing.budgetMs = 5.0f;
+    timing.intervalMs = intervalMs;
+    return timing;
+}
+
+}  // namespace
+
+// ============================================================================
+// AudioCallbackTiming Tests
+// ============================================================================
+
+TEST_CASE("AudioCallbackTiming - Overruns are blamed on a stage", "[audio][profiling]") {
+    SECTION("Within budget and on time") {
+        REQUIRE_FALSE(makeTiming(0.5f, 1.0f, 5.0f).overran());
+    }
+
+    SECTION("Running past the budget blames the slowest stage") {
+        auto timing = makeTiming(0.5f, 6.0f, 5.0f);
+        REQUIRE(timing.overran());
+        REQUIRE(timing.slowestStage() == AudioCallbackTiming::Modulation);
+    }
+
+    SECTION("Arriving late without running long blames the engine") {
+        auto timing = makeTiming(0.5f, 1.0f, 9.0f);
+        REQUIRE(timing.overran());
+        REQUIRE(timing.slowestStage() == AudioCallbackTiming::Engine);
+    }
+
+    SECTION("The first callback has no interval") {
+        REQUIRE_FALSE(makeTiming(0.5f, 1.0f, 0.0f).overran());
+    }
+}
+
+// ============================================================================
+// AudioCallbackTimingRing Tests
+// ============================================================================
+
+TEST_CASE("AudioCallbackTimingRing - FIFO with counted drops", "[audio][profiling]") {
+    AudioCallbackTimingRing ring;
+    for (size_t i = 0; i + 1 < AudioCallbackTimingRing::kSize; ++i) {
+        REQUIRE(ring.push(makeTiming(static_cast<float>(i), 0.0f, 5.0f)));
+    }
+    REQUIRE_FALSE(ring.push(makeTiming(0.0f, 0.0f, 5.0f)));
+    REQUIRE(ring.getDroppedCount() == 1);
+
+    AudioCallbackTiming timing;
+    REQUIRE(ring.pop(timing));
+    REQUIRE(timing.stageMs[AudioCallbackTiming::Parameters] == 0.0f);
+    REQUIRE(ring.pop(timing));
+    REQUIRE(timing.stageMs[AudioCallbackTiming::Parameters] == 1.0f);
+    REQUIRE(ring.push(makeTiming(0.0f, 0.0f, 5.0f)));
+}
@@ -1,6 +1,7 @@
 #include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
 
+#include "magda/daw/audio/StretchRenderCache.hpp"
 #include "magda/daw/core/ClipInfo.hpp"
 #include "magda/daw/core/ClipManager.hpp"
 #include "magda/daw/core/ClipOperations.hpp"
@@ -105,6 +106,28 @@ TEST_CASE("ClipManager - setAudioSourceStretchFactor clamping", "[audio][clip][s
     }
 }
 
+TEST_CASE("StretchRenderCache - which stretches are rendered", "[audio][clip][stretch]") {
+    using namespace magda;
+
+    SECTION("Only stretched sources need a render") {
+        REQUIRE_FALSE(StretchRenderCache::needsRender(1.0));
+        REQUIRE_FALSE(StretchRenderCache::needsRender(1.0005));
+        REQUIRE(StretchRenderCache::needsRender(0.5));
+        REQUIRE(StretchRenderCache::needsRender(2.0));
+        REQUIRE_FALSE(StretchRenderCache::needsRender(0.0));
+    }
+
+    SECTION("Clips stretching a file by the same factor share a render") {
+        const juce::File file("/tmp/loop.wav");
+        REQUIRE(StretchRenderCache::getRenderKey(file, 2.0) ==
+                StretchRenderCache::getRenderKey(file, 2.00001));
+        REQUIRE(StretchRenderCache::getRenderKey(file, 2.0) !=
+                StretchRenderCache::getRenderKey(file, 2.5));
+        REQUIRE(StretchRenderCache::getRenderKey(file, 2.0) !=
+                StretchRenderCache::getRenderKey(juce::File("/tmp/other.wav"), 2.0));
+    }
+}
+
 TEST_CASE("Audio Clip - Left edge resize trims file offset", "[audio][clip][trim]") {
     using namespace magda;
 
@@ -591,3 +614,40 @@ TEST_CASE("ClipOperations - stretchSourceFromLeft right edge anchoring bug",
         REQUIRE(source.position == Catch::Approx(15.0));  // 30.0 - 15.0
     }
 }
+
+TEST_CASE("ClipOperations - stretchClipToTempo", "[audio][clip][stretch]") {
+    using namespace magda;
+
+    ClipInfo clip;
+    clip.type = ClipType::Audio;
+    clip.startTime = 4.0;
+    clip.length = 8.0;  // Four bars at 120 BPM
+    AudioSource source;
+    source.filePath = "loop.wav";
+    source.length = 8.0;
+    clip.audioSources.push_back(source);
+
+    SECTION("Slower project tempo stretches the clip longer") {
+        ClipOperations::stretchClipToTempo(clip, 120.0, 100.0);
+
+        REQUIRE(clip.audioSources[0].stretchFactor == Catch::Approx(1.2));
+        REQUIRE(clip.length == Catch::Approx(9.6));
+        REQUIRE(clip.audioSources[0].length == Catch::Approx(9.6));
+        REQUIRE(clip.startTime == Catch::Approx(4.0));
+    }
+
+    SECTION("Matching again after a tempo change starts from the current stretch") {
+        ClipOperations::stretchClipToTempo(clip, 120.0, 100.0);
+        ClipOperations::stretchClipToTempo(clip, 120.0, 240.0);
+
+        REQUIRE(clip.audioSources[0].stretchFactor == Catch::Approx(0.5));
+        REQUIRE(clip.length == Catch::Approx(4.0));
+    }
+
+    SECTION("Unknown tempo leaves the clip alone") {
+        ClipOperations::stretchClipToTempo(clip, 0.0, 100.0);
+
+        REQUIRE(clip.audioSources[0].stretchFactor == 1.0);
+        REQUIRE(clip.length == 8.0);
+    }
+}
@@ -0,0 +1,154 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "../magda/daw/audio/AudioEventQueue.hpp"
+
+using namespace magda;
+
+namespace {
+
+AudioEvent noteOn(TrackId trackId, int note) {
+    return {AudioEvent::Type::NoteOn, trackId, note, 100};
+}
+
+}  // namespace
+
+// ============================================================================
+// AudioEventQueue Tests
+// ============================================================================
+
+TEST_CASE("AudioEventQueue - Events come out in order", "[audio][events]") {
+    AudioEventQueue queue;
+    REQUIRE(queue.push(noteOn(1, 60)));
+    REQUIRE(queue.push({AudioEvent::Type::LoopWrapped}));
+    REQUIRE(queue.push(noteOn(2, 64)));
+
+    AudioEvent event;
+    REQUIRE(queue.pop(event));
+    REQUIRE(event.type == AudioEvent::Type::NoteOn);
+    REQUIRE(event.data1 == 60);
+    REQUIRE(queue.pop(event));
+    REQUIRE(event.type == AudioEvent::Type::LoopWrapped);
+    REQUIRE(queue.pop(event));
+    REQUIRE(event.trackId == 2);
+    REQUIRE_FALSE(queue.pop(event));
+}
+
+TEST_CASE("AudioEventQueue - A full queue drops and counts", "[audio][events]") {
+    AudioEventQueue queue;
+    for (size_t i = 0; i < AudioEventQueue::kQueueSize; ++i) {
+        REQUIRE(queue.push(noteOn(1, static_cast<int>(i % 128))));
+    }
+    REQUIRE_FALSE(queue.push(noteOn(1, 0)));
+    REQUIRE(queue.getDroppedCount() == 1);
+
+    // Popping frees cells for the next lap
+    AudioEvent event;
+    REQUIRE(queue.pop(event));
+    REQUIRE(queue.push(noteOn(1, 0)));
+}
+
+TEST_CASE("AudioEventQueue - Concurrent producers lose nothing", "[audio][events][threading]") {
+    constexpr int kProducers = 4;
+    constexpr int kPerProducer = 20000;
+
+    AudioEventQueue queue;
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&queue, p]() {
+            for (int i = 0; i < kPerProducer; ++i) {
+                AudioEvent event{AudioEvent::Type::Controller, p + 1, i, 0};
+                while (!queue.push(event)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    // Each producer's events must arrive complete and in its own order
+    std::vector<int> next(kProducers, 0);
+    int received = 0;
+    AudioEvent event;
+    while (received < kProducers * kPerProducer) {
+        if (!queue.pop(event)) {
+            std::this_thread::yield();
+            continue;
+        }
+        auto producer = static_cast<size_t>(event.trackId - 1);
+        REQUIRE(event.data1 == next[producer]);
+        ++next[producer];
+        ++received;
+    }
+
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    REQUIRE_FALSE(queue.pop(event));
+}
+
+// ============================================================================
+// AudioEventDispatcher Tests
+// ============================================================================
+
+TEST_CASE("AudioEventDispatcher - Routes events by type", "[audio][events]") {
+    AudioEventQueue queue;
+    AudioEventDispatcher dispatcher;
+
+    std::vector<TrackId> noteTracks;
+    int loops = 0;
+    auto noteSub = dispatcher.subscribe(AudioEvent::Type::NoteOn, [&](const AudioEvent& e) {
+        noteTracks.push_back(e.trackId);
+    });
+    auto loopSub =
+        dispatcher.subscribe(AudioEvent::Type::LoopWrapped, [&](const AudioEvent&) { ++loops; });
+
+    queue.push(noteOn(3, 60));
+    queue.push({AudioEvent::Type::LoopWrapped});
+    queue.push({AudioEvent::Type::Xrun, INVALID_TRACK_ID, 2});  // Nobody listening
+    queue.push(noteOn(5, 62));
+
+    REQUIRE(dispatcher.drain(queue) == 4);
+    REQUIRE(noteTracks == std::vector<TrackId>{3, 5});
+    REQUIRE(loops == 1);
+    REQUIRE(dispatcher.drain(queue) == 0);
+
+    SECTION("Releasing the subscription stops delivery") {
+        noteSub.reset();
+        REQUIRE_FALSE(dispatcher.hasSubscribers(AudioEvent::Type::NoteOn));
+        queue.push(noteOn(3, 60));
+        dispatcher.drain(queue);
+        REQUIRE(noteTracks.size() == 2);
+    }
+}
+
+TEST_CASE("AudioEventDispatcher - Handlers may unsubscribe while dispatching", "[audio][events]") {
+    AudioEventDispatcher dispatcher;
+    int first = 0;
+    int second = 0;
+
+    Subscription secondSub;
+    Subscription firstSub = dispatcher.subscribe(AudioEvent::Type::NoteOn, [&](const AudioEvent&) {
+        ++first;
+        secondSub.reset();
+    });
+    secondSub =
+        dispatcher.subscribe(AudioEvent::Type::NoteOn, [&](const AudioEvent&) { ++second; });
+
+    dispatcher.dispatch(noteOn(1, 60));
+    dispatcher.dispatch(noteOn(1, 60));
+    REQUIRE(first == 2);
+    REQUIRE(second == 0);
+}
+
+TEST_CASE("AudioEventDispatcher - Subscriptions may outlive it", "[audio][events]") {
+    Subscription sub;
+    {
+        AudioEventDispatcher dispatcher;
+        sub = dispatcher.subscribe(AudioEvent::Type::Xrun, [](const AudioEvent&) {});
+    }
+    sub.reset();  // Must not touch the destroyed dispatcher
+    REQUIRE_FALSE(sub);
+}
@@ -0,0 +1,142 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+
+#include "../magda/daw/audio/AudioFileImporter.hpp"
+#include "../magda/daw/audio/AudioThumbnailManager.hpp"
+#include "../magda/daw/audio/TempoCache.hpp"
+#include "ScopedDirectory.hpp"
+
+using namespace magda;
+using Catch::Approx;
+
+namespace {
+
+constexpr double kToneHz = 1000.0;
+constexpr float kToneLevel = 0.5f;
+
+float tone(double seconds) {
+    return kToneLevel *
+           static_cast<float>(std::sin(2.0 * juce::MathConstants<double>::pi * kToneHz * seconds));
+}
+
+juce::File writeTone(const juce::File& file, double sampleRate, int numFrames) {
+    juce::WavAudioFormat wav;
+    std::unique_ptr<juce::AudioFormatWriter> writer(
+        wav.createWriterFor(new juce::FileOutputStream(file), sampleRate, 1, 24, {}, 0));
+    REQUIRE(writer != nullptr);
+    juce::AudioBuffer<float> buffer(1, numFrames);
+    for (int i = 0; i < numFrames; ++i) {
+        buffer.setSample(0, i, tone(i / sampleRate));
+    }
+    writer->writeFromAudioSampleBuffer(buffer, 0, numFrames);
+    return file;
+}
+
+std::unique_ptr<juce::AudioFormatReader> openWav(const juce::File& file) {
+    juce::WavAudioFormat wav;
+    return std::unique_ptr<juce::AudioFormatReader>(
+        wav.createReaderFor(new juce::FileInputStream(file), true));
+}
+
+AudioFileImporter::Format sessionFormat(double sampleRate) {
+    AudioFileImporter::Format format;
+    format.sampleRate = sampleRate;
+    return format;
+}
+
+}  // namespace
+
+// ============================================================================
+// AudioFileImporter Tests
+// ============================================================================
+
+TEST_CASE("AudioFileImporter - Files at the session rate are used in place", "[import]") {
+    ScopedDirectory temp("magda_import_test");
+    juce::AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+    const auto source = writeTone(temp.directory.getChildFile("tone.wav"), 48000.0, 24000);
+
+    const auto result = AudioFileImporter::importFile(formatManager, source,
+                                                      temp.directory.getChildFile("Imported"),
+                                                      sessionFormat(48000.0));
+
+    REQUIRE_FALSE(result.failed);
+    REQUIRE_FALSE(result.converted);
+    REQUIRE(result.file == source);
+    REQUIRE(result.lengthSeconds == Approx(0.5));
+    REQUIRE(result.peaks != nullptr);
+    REQUIRE(AudioThumbnailManager::hasPeaks(source));
+    REQUIRE(result.tempo != nullptr);
+    REQUIRE(result.tempo->lengthInSamples == 24000);
+    REQUIRE(TempoCache::hasTempo(source));
+    REQUIRE_FALSE(temp.directory.getChildFile("Imported").exists());
+
+    // Peaks and tempo already stored aren't built again
+    const auto again = AudioFileImporter::importFile(formatManager, source, temp.directory,
+                                                     sessionFormat(48000.0));
+    REQUIRE(again.peaks == nullptr);
+    REQUIRE(again.tempo == nullptr);
+}
+
+TEST_CASE("AudioFileImporter - Other rates are resampled to the session rate", "[import]") {
+    ScopedDirectory temp("magda_import_test");
+    juce::AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+    const auto source = writeTone(temp.directory.getChildFile("tone.wav"), 44100.0, 44100);
+    const auto folder = temp.directory.getChildFile("Imported");
+
+    const auto result =
+        AudioFileImporter::importFile(formatManager, source, folder, sessionFormat(48000.0));
+
+    REQUIRE_FALSE(result.failed);
+    REQUIRE(result.converted);
+    REQUIRE(result.file.getParentDirectory() == folder);
+    REQUIRE(result.lengthSeconds == Approx(1.0));
+    REQUIRE(result.peaks != nullptr);
+    REQUIRE(result.peaks->getSampleRate() == Approx(48000.0));
+    REQUIRE(AudioThumbnailManager::hasPeaks(result.file));
+
+    auto reader = openWav(result.file);
+    REQUIRE(reader != nullptr);
+    REQUIRE(reader->sampleRate == Approx(48000.0));
+    REQUIRE(reader->bitsPerSample == 24);
+    REQUIRE(reader->lengthInSamples == 48000);
+
+    // Same tone, lined up with the source
+    juce::AudioBuffer<float> read(1, 48000);
+    reader->read(&read, 0, 48000, 0, true, false);
+    for (int i = 12000; i < 36000; i += 997) {
+        REQUIRE(read.getSample(0, i) == Approx(tone(i / 48000.0)).margin(0.05));
+    }
+}
+
+TEST_CASE("AudioFileImporter - Unreadable files fail without output", "[import]") {
+    ScopedDirectory temp("magda_import_test");
+    juce::AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+    const auto source = temp.directory.getChildFile("broken.wav");
+    REQUIRE(source.replaceWithText("not audio"));
+    const auto folder = temp.directory.getChildFile("Imported");
+
+    const auto result =
+        AudioFileImporter::importFile(formatManager, source, folder, sessionFormat(48000.0));
+
+    REQUIRE(result.failed);
+    REQUIRE_FALSE(folder.exists());
+}
+
+TEST_CASE("AudioFileImporter - A cancelled conversion leaves no file", "[import]") {
+    ScopedDirectory temp("magda_import_test");
+    juce::AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+    const auto source = writeTone(temp.directory.getChildFile("tone.wav"), 44100.0, 44100);
+    const auto folder = temp.directory.getChildFile("Imported");
+
+    const auto result = AudioFileImporter::importFile(formatManager, source, folder,
+                                                      sessionFormat(48000.0), [] { return true; });
+
+    REQUIRE(result.file == source);
+    REQUIRE(folder.findChildFiles(juce::File::findFiles, false).isEmpty());
+}
@@ -0,0 +1,160 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "../magda/daw/audio/AudioReadAhead.hpp"
+
+using namespace magda;
+using Catch::Approx;
+
+namespace {
+
+AudioReadAhead::ClipSpan makeSpan(const juce::String& file, double start, double length) {
+    AudioReadAhead::ClipSpan span;
+    span.filePath = file;
+    span.startSeconds = start;
+    span.lengthSeconds = length;
+    return span;
+}
+
+}  // namespace
+
+// ============================================================================
+// AudioReadAhead Tests
+// ============================================================================
+
+TEST_CASE("AudioReadAhead - Window follows direction and speed", "[readahead]") {
+    const auto still = AudioReadAhead::getWindow(0.0);
+    REQUIRE(still.before == still.after);
+
+    const auto playing = AudioReadAhead::getWindow(1.0);
+    REQUIRE(playing.after > playing.before);
+    REQUIRE(playing.after > still.after);
+
+    const auto reverse = AudioReadAhead::getWindow(-1.0);
+    REQUIRE(reverse.before == Approx(playing.after));
+    REQUIRE(reverse.after == Approx(playing.before));
+
+    REQUIRE(AudioReadAhead::getWindow(4.0).after > playing.after);
+    REQUIRE(AudioReadAhead::getWindow(100.0).after == Approx(AudioReadAhead::kMaxAheadSeconds));
+}
+
+TEST_CASE("AudioReadAhead - Plans only the part of each clip inside the window",
+          "[readahead]") {
+    auto span = makeSpan("a.wav", 10.0, 100.0);
+    span.fileOffsetSeconds = 5.0;
+
+    const auto requests = AudioReadAhead::plan(20.0, 1.0, {span, makeSpan("far.wav", 60.0, 10.0)});
+
+    REQUIRE(requests.size() == 1);
+    const auto window = AudioReadAhead::getWindow(1.0);
+    REQUIRE(requests[0].fileStartSeconds == Approx(5.0 + 10.0 - window.before));
+    REQUIRE(requests[0].fileEndSeconds == Approx(5.0 + 10.0 + window.after));
+    REQUIRE(requests[0].distanceSeconds == 0.0);
+}
+
+TEST_CASE("AudioReadAhead - Stretch maps timeline time to file time", "[readahead]") {
+    auto span = makeSpan("a.wav", 0.0, 100.0);
+    span.stretchFactor = 2.0;  // Plays at half speed
+
+    const auto requests = AudioReadAhead::plan(10.0, 0.0, {span});
+
+    REQUIRE(requests.size() == 1);
+    REQUIRE(requests[0].fileStartSeconds == Approx((10.0 - AudioReadAhead::kStillSeconds) / 2));
+    REQUIRE(requests[0].fileEndSeconds == Approx((10.0 + AudioReadAhead::kStillSeconds) / 2));
+}
+
+TEST_CASE("AudioReadAhead - Clips the playhead is heading into come first", "[readahead]") {
+    const std::vector<AudioReadAhead::ClipSpan> clips = {
+        makeSpan("behind.wav", 9.5, 0.4),
+        makeSpan("ahead.wav", 10.5, 1.0),
+        makeSpan("under.wav", 8.0, 4.0),
+    };
+
+    auto forward = AudioReadAhead::plan(10.0, 1.0, clips);
+    REQUIRE(forward.size() == 3);
+    REQUIRE(forward[0].filePath == "under.wav");
+    REQUIRE(forward[1].filePath == "ahead.wav");
+    REQUIRE(forward[2].filePath == "behind.wav");
+
+    auto backward = AudioReadAhead::plan(10.0, -1.0, clips);
+    REQUIRE(backward.size() == 3);
+    REQUIRE(backward[0].filePath == "under.wav");
+    REQUIRE(backward[1].filePath == "behind.wav");
+    REQUIRE(backward[2].filePath == "ahead.wav");
+}
+
+TEST_CASE("AudioReadAhead - Looped clips want their whole loop", "[readahead]") {
+    auto span = makeSpan("loop.wav", 0.0, 600.0);
+    span.looped = true;
+    span.fileOffsetSeconds = 1.0;
+    span.loopFileSeconds = 2.0;
+
+    const auto requests = AudioReadAhead::plan(300.0, 1.0, {span});
+
+    REQUIRE(requests.size() == 1);
+    REQUIRE(requests[0].fileStartSeconds == Approx(1.0));
+    REQUIRE(requests[0].fileEndSeconds == Approx(3.0));
+}
+
+TEST_CASE("AudioReadAhead - Looping reads the loop start ahead of the wrap", "[readahead]") {
+    const std::vector<AudioReadAhead::ClipSpan> clips = {makeSpan("start.wav", 10.0, 2.0),
+                                                         makeSpan("end.wav", 16.0, 4.0),
+                                                         makeSpan("after.wav", 20.0, 10.0)};
+    AudioReadAhead::Loop loop;
+    loop.startSeconds = 10.0;
+    loop.endSeconds = 20.0;
+
+    // Two seconds before the loop end, the window folds back to the loop start
+    const auto requests = AudioReadAhead::plan(18.0, 1.0, clips, loop);
+    REQUIRE(requests.size() == 2);
+    REQUIRE(requests[0].filePath == "end.wav");
+    REQUIRE(requests[1].filePath == "start.wav");
+    REQUIRE(requests[1].distanceSeconds == Approx(2.0));
+    REQUIRE(requests[1].fileStartSeconds == Approx(0.0));
+    REQUIRE(requests[1].fileEndSeconds == Approx(2.0));
+
+    SECTION("Not once the playhead is outside the loop") {
+        const auto outside = AudioReadAhead::plan(25.0, 1.0, clips, loop);
+        REQUIRE(outside.size() == 1);
+        REQUIRE(outside[0].filePath == "after.wav");
+    }
+
+    SECTION("Not without a loop") {
+        const auto unlooped = AudioReadAhead::plan(18.0, 1.0, clips);
+        REQUIRE(unlooped.size() == 2);
+        REQUIRE(unlooped[1].filePath == "after.wav");
+    }
+}
+
+TEST_CASE("AudioReadAhead - Fetches blocks of a mapped file once", "[readahead]") {
+    juce::TemporaryFile temp(".wav");
+    {
+        juce::WavAudioFormat wav;
+        std::unique_ptr<juce::AudioFormatWriter> writer(
+            wav.createWriterFor(new juce::FileOutputStream(temp.getFile()), 8000.0, 1, 16, {}, 0));
+        REQUIRE(writer != nullptr);
+        juce::AudioBuffer<float> silence(1, 8000 * 10);
+        silence.clear();
+        writer->writeFromAudioSampleBuffer(silence, 0, silence.getNumSamples());
+    }
+
+    AudioReadAhead readAhead(1);
+    const std::vector<AudioReadAhead::ClipSpan> clips = {
+        makeSpan(temp.getFile().getFullPathName(), 0.0, 10.0)};
+    readAhead.update(0.0, 0.0, clips);
+
+    // Blocks 0 and 1: the still window reaches kStillSeconds past zero
+    for (int attempt = 0; attempt < 200 && readAhead.getStats().blocksFetched < 2; ++attempt) {
+        juce::Thread::sleep(5);
+    }
+    const auto stats = readAhead.getStats();
+    REQUIRE(stats.blocksFetched == 2);
+    REQUIRE(stats.pagesTouched > 0);
+    REQUIRE(stats.openFiles == 1);
+
+    readAhead.update(0.0, 0.0, clips);
+    REQUIRE(readAhead.getStats().queuedBlocks == 0);
+
+    readAhead.update(0.0, 0.0, {});
+    REQUIRE(readAhead.getStats().openFiles == 0);
+}
@@ -0,0 +1,185 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <vector>
+
+#include "../magda/daw/audio/AudioTaps.hpp"
+
+using namespace magda;
+using Catch::Approx;
+
+// ============================================================================
+// AudioTaps Tests
+// ============================================================================
+// Rendered blocks are copied into a tap's ring only while something taps the
+// point, and handed to its analyser off the render thread, in order.
+
+namespace {
+
+constexpr double kSampleRate = 48000.0;
+
+// Keeps everything it is handed (runs on the analysing thread)
+class RecordingAnalyser : public AudioTaps::Analyser {
+  public:
+    void prepare(double sampleRate) override {
+        preparedRate = sampleRate;
+        ++numPrepares;
+    }
+
+    void process(const float* left, const float* right, int numSamples) override {
+        this->left.insert(this->left.end(), left, left + numSamples);
+        this->right.insert(this->right.end(), right, right + numSamples);
+    }
+
+    double preparedRate = 0.0;
+    int numPrepares = 0;
+    std::vector<float> left;
+    std::vector<float> right;
+};
+
+// Writes a stereo block counting up from first (right is negated)
+void writeRamp(AudioTaps& taps, int point, float first, int numSamples) {
+    std::vector<float> left(static_cast<size_t>(numSamples));
+    std::vector<float> right(static_cast<size_t>(numSamples));
+    for (int i = 0; i < numSamples; ++i) {
+        left[static_cast<size_t>(i)] = first + static_cast<float>(i);
+        right[static_cast<size_t>(i)] = -(first + static_cast<float>(i));
+    }
+    const float* channels[] = {left.data(), right.data()};
+    taps.write(point, channels, 2, numSamples, kSampleRate);
+}
+
+}  // namespace
+
+TEST_CASE("AudioTaps - Untapped points are skipped", "[audiotaps]") {
+    AudioTaps taps(false);
+    auto analyser = std::make_shared<RecordingAnalyser>();
+
+    REQUIRE_FALSE(taps.isTapped(3));
+    writeRamp(taps, 3, 0.0f, 256);  // Nobody listening: dropped
+
+    auto tap = taps.addTap(3, analyser);
+    REQUIRE(tap);
+    REQUIRE(taps.isTapped(3));
+    REQUIRE_FALSE(taps.isTapped(4));
+    writeRamp(taps, 4, 0.0f, 256);  // Another point
+
+    taps.analyse();
+    REQUIRE(analyser->left.empty());
+    REQUIRE(analyser->numPrepares == 0);
+
+    REQUIRE_FALSE(taps.addTap(-1, analyser));
+    REQUIRE_FALSE(taps.addTap(AudioTaps::kNumPoints, analyser));
+    REQUIRE(taps.addTap(AudioTaps::kMasterPoint, analyser));  // Removed again at once
+}
+
+TEST_CASE("AudioTaps - Analysers get blocks in order", "[audiotaps]") {
+    AudioTaps taps(false);
+    auto analyser = std::make_shared<RecordingAnalyser>();
+    auto tap = taps.addTap(AudioTaps::kMasterPoint, analyser);
+
+    // Several blocks between analyses, wrapping around the ring
+    float next = 0.0f;
+    for (int round = 0; round < 20; ++round) {
+        for (int block = 0; block < 5; ++block) {
+            writeRamp(taps, AudioTaps::kMasterPoint, next, 512);
+            next += 512.0f;
+        }
+        taps.analyse();
+    }
+
+    REQUIRE(analyser->numPrepares == 1);
+    REQUIRE(analyser->preparedRate == Approx(kSampleRate));
+    REQUIRE(analyser->left.size() == 20 * 5 * 512);
+    for (size_t i = 0; i < analyser->left.size(); ++i) {
+        REQUIRE(analyser->left[i] == static_cast<float>(i));
+        REQUIRE(analyser->right[i] == -static_cast<float>(i));
+    }
+}
+
+TEST_CASE("AudioTaps - A mono point feeds both sides", "[audiotaps]") {
+    AudioTaps taps(false);
+    auto analyser = std::make_shared<RecordingAnalyser>();
+    auto tap = taps.addTap(1, analyser);
+
+    std::vector<float> mono = {0.1f, 0.2f, 0.3f};
+    const float* channels[] = {mono.data()};
+    taps.write(1, channels, 1, 3, kSampleRate);
+    taps.analyse();
+
+    REQUIRE(analyser->left == mono);
+    REQUIRE(analyser->right == mono);
+}
+
+TEST_CASE("AudioTaps - A reader that falls behind skips to the newest audio", "[audiotaps]") {
+    AudioTaps taps(false);
+    auto analyser = std::make_shared<RecordingAnalyser>();
+    auto tap = taps.addTap(0, analyser);
+
+    // Three rings' worth before anything is analysed
+    const int total = AudioTaps::kRingFrames * 3;
+    for (int written = 0; written < total; written += 1024) {
+        writeRamp(taps, 0, static_cast<float>(written), 1024);
+    }
+    taps.analyse();
+
+    // Half a ring, ending with the last sample written
+    REQUIRE(analyser->left.size() == AudioTaps::kRingFrames / 2);
+    REQUIRE(analyser->left.front() == static_cast<float>(total - AudioTaps::kRingFrames / 2));
+    REQUIRE(analyser->left.back() == static_cast<float>(total - 1));
+}
+
+TEST_CASE("AudioTaps - Removing a tap stops its copies", "[audiotaps]") {
+    AudioTaps taps(false);
+    auto first = std::make_shared<RecordingAnalyser>();
+    auto second = std::make_shared<RecordingAnalyser>();
+
+    auto firstTap = taps.addTap(2, first);
+    auto secondTap = taps.addTap(2, second);
+    REQUIRE(taps.getNumTaps() == 2);
+
+    writeRamp(taps, 2, 0.0f, 64);
+    firstTap.reset();
+    writeRamp(taps, 2, 64.0f, 64);
+    taps.analyse();
+
+    REQUIRE(first->left.empty());
+    REQUIRE(second->left.size() == 128);
+    REQUIRE(taps.isTapped(2));
+
+    secondTap.reset();
+    REQUIRE_FALSE(taps.isTapped(2));
+    REQUIRE(taps.getNumTaps() == 0);
+
+    // A point holds a few taps at most
+    std::vector<Subscription> full;
+    for (int i = 0; i < AudioTaps::kMaxTapsPerPoint; ++i) {
+        full.push_back(taps.addTap(2, first));
+        REQUIRE(full.back());
+    }
+    REQUIRE_FALSE(taps.addTap(2, first));
+}
+
+TEST_CASE("ScopeAnalyser - Keeps the latest audio and its correlation", "[audiotaps]") {
+    ScopeAnalyser scope;
+    scope.prepare(kSampleRate);
+
+    std::vector<float> left(ScopeAnalyser::kScopeFrames + 100);
+    for (size_t i = 0; i < left.size(); ++i) {
+        left[i] = (i % 2 == 0) ? 0.5f : -0.5f;
+    }
+    left.back() = 0.25f;
+    scope.process(left.data(), left.data(), static_cast<int>(left.size()));
+
+    auto snapshot = scope.getSnapshot();
+    REQUIRE(snapshot.left.size() == ScopeAnalyser::kScopeFrames);
+    REQUIRE(snapshot.left.back() == 0.25f);
+    REQUIRE(snapshot.correlation == Approx(1.0f));
+
+    std::vector<float> inverted(left.size());
+    for (size_t i = 0; i < left.size(); ++i) {
+        inverted[i] = -left[i];
+    }
+    scope.process(left.data(), inverted.data(), static_cast<int>(left.size()));
+    REQUIRE(scope.getSnapshot().correlation == Approx(-1.0f));
+}
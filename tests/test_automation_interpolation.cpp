@@ -0,0 +1,156 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <vector>
+
+#include "../magda/daw/core/AutomationManager.hpp"
+
+using namespace magda;
+
+namespace {
+
+AutomationTarget makeVolumeTarget(TrackId trackId) {
+    AutomationTarget target;
+    target.type = AutomationTargetType::TrackVolume;
+    target.trackId = trackId;
+    return target;
+}
+
+}  // namespace
+
+// ============================================================================
+// Segment lookup
+// ============================================================================
+
+TEST_CASE("AutomationManager - Sequential and random reads agree", "[automation]") {
+    auto& manager = AutomationManager::getInstance();
+    manager.clearAll();
+
+    auto laneId = manager.createLane(makeVolumeTarget(1), AutomationLaneType::Absolute);
+    manager.movePoint(laneId, manager.getLane(laneId)->absolutePoints[0].id, 0.0, 0.0);
+    for (int i = 1; i <= 64; ++i) {
+        auto curve = (i % 3 == 0) ? AutomationCurveType::Step : AutomationCurveType::Linear;
+        manager.addPoint(laneId, i * 0.5, (i % 2) ? 1.0 : 0.0, curve);
+    }
+
+    // Reference values from a lane-less lookup, which starts without a cursor
+    std::vector<double> times;
+    for (double t = -1.0; t < 34.0; t += 0.037)
+        times.push_back(t);
+
+    std::vector<double> expected;
+    const auto& points = manager.getLane(laneId)->absolutePoints;
+    for (double t : times) {
+        auto scratch = manager.createLane(makeVolumeTarget(2), AutomationLaneType::Absolute);
+        manager.getLane(scratch)->absolutePoints = points;
+        expected.push_back(manager.getValueAtTime(scratch, t));
+        manager.deleteLane(scratch);
+    }
+
+    SECTION("Forward playback") {
+        for (size_t i = 0; i < times.size(); ++i)
+            REQUIRE(manager.getValueAtTime(laneId, times[i]) == Catch::Approx(expected[i]));
+    }
+
+    SECTION("Jumps backwards and forwards") {
+        for (size_t i = 0; i < times.size(); ++i) {
+            size_t j = (i * 7919) % times.size();
+            REQUIRE(manager.getValueAtTime(laneId, times[j]) == Catch::Approx(expected[j]));
+        }
+    }
+
+    SECTION("Values at point times") {
+        REQUIRE(manager.getValueAtTime(laneId, 1.0) == Catch::Approx(0.0));
+        REQUIRE(manager.getValueAtTime(laneId, 1.25) == Catch::Approx(0.5));
+        REQUIRE(manager.getValueAtTime(laneId, 1.75) == Catch::Approx(1.0));  // Step at 1.5
+        REQUIRE(manager.getValueAtTime(laneId, 100.0) == Catch::Approx(0.0));
+    }
+
+    manager.clearAll();
+}
+
+TEST_CASE("AutomationManager - Clip lookup follows playback", "[automation]") {
+    auto& manager = AutomationManager::getInstance();
+    manager.clearAll();
+
+    auto laneId = manager.createLane(makeVolumeTarget(1), AutomationLaneType::ClipBased);
+    auto first = manager.createClip(laneId, 0.0, 2.0);
+    auto second = manager.createClip(laneId, 4.0, 2.0);
+    manager.addPointToClip(first, 0.0, 0.0);
+    manager.addPointToClip(first, 2.0, 1.0);
+    manager.addPointToClip(second, 0.0, 1.0);
+    manager.addPointToClip(second, 2.0, 0.0);
+
+    REQUIRE(manager.getValueAtTime(laneId, 1.0) == Catch::Approx(0.5));
+    REQUIRE(manager.getValueAtTime(laneId, 3.0) == Catch::Approx(0.5));  // Gap
+    REQUIRE(manager.getValueAtTime(laneId, 4.5) == Catch::Approx(0.75));
+    REQUIRE(manager.getValueAtTime(laneId, 0.5) == Catch::Approx(0.25));
+
+    SECTION("Cursor survives clip deletion") {
+        manager.getValueAtTime(laneId, 5.0);
+        manager.deleteClip(first);
+        REQUIRE(manager.getValueAtTime(laneId, 0.5) == Catch::Approx(0.5));
+        REQUIRE(manager.getValueAtTime(laneId, 5.0) == Catch::Approx(0.5));
+    }
+
+    manager.clearAll();
+}
+
+// ============================================================================
+// Block rendering
+// ============================================================================
+
+TEST_CASE("AutomationManager - renderValues matches getValueAtTime", "[automation]") {
+    auto& manager = AutomationManager::getInstance();
+    manager.clearAll();
+
+    auto laneId = manager.createLane(makeVolumeTarget(1), AutomationLaneType::Absolute);
+    manager.movePoint(laneId, manager.getLane(laneId)->absolutePoints[0].id, 0.0, 0.2);
+    auto bezier = manager.addPoint(laneId, 1.0, 0.9, AutomationCurveType::Bezier);
+    auto tension = manager.addPoint(laneId, 2.0, 0.1);
+    manager.addPoint(laneId, 3.0, 0.6, AutomationCurveType::Step);
+    manager.addPoint(laneId, 3.5, 0.3);
+    manager.addPoint(laneId, 4.0, 0.8);
+
+    BezierHandle in, out;
+    out.time = 0.3;
+    out.value = 0.4;
+    in.time = -0.2;
+    in.value = -0.3;
+    manager.setPointHandles(laneId, bezier, in, out);
+    manager.setPointTension(laneId, tension, 0.7);
+
+    auto requireMatches = [&](AutomationLaneId id, double start, double end, int numSamples) {
+        std::vector<float> rendered(static_cast<size_t>(numSamples));
+        manager.renderValues(id, start, end, rendered.data(), numSamples);
+        double step = (end - start) / numSamples;
+        for (int i = 0; i < numSamples; ++i) {
+            double expected = manager.getValueAtTime(id, start + i * step);
+            REQUIRE(rendered[static_cast<size_t>(i)] == Catch::Approx(expected).margin(1e-5));
+        }
+    };
+
+    SECTION("Whole lane in one block") {
+        requireMatches(laneId, -0.5, 4.5, 5000);
+    }
+
+    SECTION("Consecutive audio blocks") {
+        for (int block = 0; block < 20; ++block)
+            requireMatches(laneId, block * 0.25, (block + 1) * 0.25, 512);
+    }
+
+    SECTION("Clip lane with looping and gaps") {
+        auto clipLane = manager.createLane(makeVolumeTarget(2), AutomationLaneType::ClipBased);
+        auto looped = manager.createClip(clipLane, 0.5, 3.0);
+        manager.setClipLooping(looped, true);
+        manager.setClipLoopLength(looped, 1.0);
+        manager.addPointToClip(looped, 0.0, 0.0);
+        manager.addPointToClip(looped, 1.0, 1.0, AutomationCurveType::Bezier);
+        auto other = manager.createClip(clipLane, 4.0, 1.0);
+        manager.addPointToClip(other, 0.5, 0.7);
+
+        requireMatches(clipLane, 0.0, 6.0, 6000);
+    }
+
+    manager.clearAll();
+}
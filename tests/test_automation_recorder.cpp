@@ -0,0 +1,147 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+#include "../magda/daw/core/AutomationManager.hpp"
+#include "../magda/daw/core/AutomationRecorder.hpp"
+#include "../magda/daw/core/UndoManager.hpp"
+
+using namespace magda;
+
+namespace {
+
+constexpr double kTolerance = 0.005;
+constexpr double kStep = 1.0 / AutomationRecorder::kControlRateHz;
+
+/**
+ * @brief Largest gap between the thinned points' line and the samples they replaced
+ */
+double maxError(const std::vector<AutomationPoint>& points, double (*fn)(double), double end) {
+    double worst = 0.0;
+    for (double t = 0.0; t <= end; t += kStep) {
+        auto next = std::upper_bound(points.begin(), points.end(), t,
+                                     [](double time, const auto& p) { return time < p.time; });
+        if (next == points.begin() || next == points.end())
+            continue;
+        const auto& a = *(next - 1);
+        const auto& b = *next;
+        const double line = a.value + (b.value - a.value) * (t - a.time) / (b.time - a.time);
+        worst = std::max(worst, std::abs(line - fn(t)));
+    }
+    return worst;
+}
+
+AutomationLaneId makeArmedLane() {
+    auto& manager = AutomationManager::getInstance();
+    AutomationTarget target;
+    target.type = AutomationTargetType::Macro;
+    target.trackId = 1;
+    target.macroIndex = 0;
+    auto laneId = manager.createLane(target, AutomationLaneType::Absolute);
+    manager.setLaneArmed(laneId, true);
+    return laneId;
+}
+
+}  // namespace
+
+TEST_CASE("AutomationPointThinner - Thinning", "[automation][recording]") {
+    AutomationPointThinner thinner(kTolerance);
+
+    SECTION("A held value is its two ends") {
+        for (double t = 0.0; t <= 2.0; t += kStep)
+            thinner.addSample(t, 0.3);
+        const auto points = thinner.finish();
+        REQUIRE(points.size() == 2);
+        CHECK(points.back().value == Catch::Approx(0.3));
+        CHECK(thinner.isEmpty());
+    }
+
+    SECTION("A ramp is a line and a corner is kept") {
+        auto ramp = [](double t) { return t < 1.0 ? t * 0.5 : 0.5; };
+        for (double t = 0.0; t <= 2.0; t += kStep)
+            thinner.addSample(t, ramp(t));
+        const auto points = thinner.finish();
+        REQUIRE(points.size() <= 4);
+        CHECK(maxError(points, +ramp, 2.0) <= kTolerance);
+    }
+
+    SECTION("A sweep stays within the tolerance with far fewer points") {
+        auto sweep = [](double t) { return 0.5 + 0.4 * std::sin(t * 3.0); };
+        int samples = 0;
+        for (double t = 0.0; t <= 4.0; t += kStep, ++samples)
+            thinner.addSample(t, sweep(t));
+        const auto points = thinner.finish();
+        CHECK(points.size() < static_cast<size_t>(samples) / 4);
+        CHECK(maxError(points, +sweep, 4.0) <= kTolerance + 1e-9);
+    }
+}
+
+TEST_CASE("AutomationRecorder - Passes", "[automation][recording]") {
+    auto& manager = AutomationManager::getInstance();
+    auto& recorder = AutomationRecorder::getInstance();
+    auto& undoManager = UndoManager::getInstance();
+    manager.clearAll();
+    undoManager.clearHistory();
+
+    const auto laneId = makeArmedLane();
+    manager.addPoint(laneId, 1.5, 1.0);
+    manager.addPoint(laneId, 5.0, 1.0);
+
+    SECTION("Write replaces the played range as one undo step") {
+        recorder.setMode(AutomationRecordMode::Write);
+        double nowMs = 0.0;
+        for (double t = 1.0; t <= 3.0; t += kStep, nowMs += 10.0) {
+            recorder.valueChanged(laneId, 0.2, nowMs);
+            recorder.process(t, true, nowMs);
+        }
+        CHECK(recorder.isWriting(laneId));
+        recorder.process(3.0, false, nowMs);
+        CHECK_FALSE(recorder.isWriting(laneId));
+
+        const auto& points = manager.getLane(laneId)->absolutePoints;
+        REQUIRE(points.size() == 4);  // Initial point, the pass's two ends, the point at 5s
+        CHECK(points[1].time == Catch::Approx(1.0));
+        CHECK(points[2].value == Catch::Approx(0.2));
+        CHECK(manager.getValueAtTime(laneId, 1.5) == Catch::Approx(0.2));
+
+        REQUIRE(undoManager.undo());
+        CHECK(manager.getValueAtTime(laneId, 1.5) == Catch::Approx(1.0));
+        CHECK_FALSE(undoManager.canUndo());
+    }
+
+    SECTION("Touch writes only while the control moves") {
+        recorder.setMode(AutomationRecordMode::Touch);
+        double nowMs = 0.0;
+        for (double t = 0.0; t <= 4.0; t += kStep, nowMs += 10.0) {
+            if (t >= 1.0 && t < 2.0)
+                recorder.valueChanged(laneId, 0.1, nowMs);
+            recorder.process(t, true, nowMs);
+        }
+
+        // Released kTouchReleaseMs after the last move
+        CHECK_FALSE(recorder.isWriting(laneId));
+        CHECK(undoManager.canUndo());
+        CHECK(manager.getValueAtTime(laneId, 2.2) == Catch::Approx(0.1));
+        CHECK(manager.getValueAtTime(laneId, 5.0) == Catch::Approx(1.0));
+        recorder.process(4.0, false, nowMs);
+    }
+
+    SECTION("Latch keeps writing after the move until stop") {
+        recorder.setMode(AutomationRecordMode::Latch);
+        double nowMs = 0.0;
+        for (double t = 0.0; t <= 4.0; t += kStep, nowMs += 10.0) {
+            if (t >= 1.0 && t < 1.2)
+                recorder.valueChanged(laneId, 0.1, nowMs);
+            recorder.process(t, true, nowMs);
+        }
+        CHECK(recorder.isWriting(laneId));
+        recorder.process(4.0, false, nowMs);
+        CHECK(manager.getValueAtTime(laneId, 3.5) == Catch::Approx(0.1));
+    }
+
+    recorder.setMode(AutomationRecordMode::Off);
+    manager.clearAll();
+    undoManager.clearHistory();
+}
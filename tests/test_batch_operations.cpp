@@ -0,0 +1,107 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "../magda/daw/core/BatchOperations.hpp"
+#include "../magda/daw/core/ClipManager.hpp"
+#include "../magda/daw/core/TrackManager.hpp"
+#include "../magda/daw/core/UndoManager.hpp"
+
+using namespace magda;
+
+namespace {
+
+void resetModel() {
+    ClipManager::getInstance().clearAllClips();
+    TrackManager::getInstance().clearAllTracks();
+    UndoManager::getInstance().clearHistory();
+}
+
+BatchOperation operation(BatchOperation::Type type, int idFrom = -1) {
+    BatchOperation op;
+    op.type = type;
+    op.idFrom = idFrom;
+    return op;
+}
+
+}  // namespace
+
+// ============================================================================
+// applyBatch Tests
+// ============================================================================
+
+TEST_CASE("applyBatch - Builds an arrangement as one undo step", "[batch]") {
+    resetModel();
+    auto& trackManager = TrackManager::getInstance();
+    auto& clipManager = ClipManager::getInstance();
+
+    std::vector<BatchOperation> operations;
+    auto track = operation(BatchOperation::Type::CreateTrack);
+    track.trackType = TrackType::Instrument;
+    track.name = "Bass";
+    operations.push_back(track);
+
+    auto clip = operation(BatchOperation::Type::AddMidiClip, 0);
+    clip.startTime = 2.0;
+    clip.length = 4.0;
+    operations.push_back(clip);
+
+    auto notes = operation(BatchOperation::Type::AddNotes, 1);
+    for (int i = 0; i < 3; ++i)
+        notes.notes.push_back(MidiNote{INVALID_MIDI_NOTE_ID, 36 + i, 100, i * 1.0, 0.5});
+    operations.push_back(notes);
+
+    auto volume = operation(BatchOperation::Type::SetTrackVolume, 0);
+    volume.value = 0.5f;
+    operations.push_back(volume);
+
+    const auto results = applyBatch(operations);
+    REQUIRE(results.size() == operations.size());
+    for (const auto& result : results)
+        REQUIRE(result.success);
+
+    const auto trackId = results[0].id;
+    const auto clipId = results[1].id;
+    REQUIRE(trackManager.getTrack(trackId)->name == "Bass");
+    REQUIRE(trackManager.getTrack(trackId)->volume == Catch::Approx(0.5f));
+    REQUIRE(clipManager.getClip(clipId)->trackId == trackId);
+    REQUIRE(clipManager.getClip(clipId)->startTime == Catch::Approx(2.0));
+    REQUIRE(clipManager.getClip(clipId)->midiNotes.size() == 3);
+    REQUIRE(results[2].id == clipId);
+
+    REQUIRE(UndoManager::getInstance().undo());
+    REQUIRE(trackManager.getTrack(trackId) == nullptr);
+    REQUIRE(clipManager.getClip(clipId) == nullptr);
+    REQUIRE_FALSE(UndoManager::getInstance().canUndo());
+
+    resetModel();
+}
+
+TEST_CASE("applyBatch - Failures are reported per operation", "[batch]") {
+    resetModel();
+
+    std::vector<BatchOperation> operations;
+    auto missingTrack = operation(BatchOperation::Type::AddMidiClip);
+    missingTrack.id = 12345;
+    missingTrack.length = 1.0;
+    operations.push_back(missingTrack);
+    operations.push_back(operation(BatchOperation::Type::AddNotes, 0));
+    operations.push_back(operation(BatchOperation::Type::CreateTrack));
+    operations.push_back(operation(BatchOperation::Type::SetTrackPan, 5));
+
+    auto parameter = operation(BatchOperation::Type::SetParameter);
+    parameter.id = 999;
+    parameter.paramIndex = 0;
+    operations.push_back(parameter);
+
+    const auto results = applyBatch(operations);
+    REQUIRE(results.size() == 5);
+    REQUIRE_FALSE(results[0].success);
+    REQUIRE_FALSE(results[0].error.empty());
+    REQUIRE_FALSE(results[1].success);  // Depends on the failed clip
+    REQUIRE(results[2].success);        // Independent operations still apply
+    REQUIRE(TrackManager::getInstance().getTrack(results[2].id) != nullptr);
+    REQUIRE_FALSE(results[3].success);  // idFrom must be earlier
+    REQUIRE_FALSE(results[4].success);
+
+    resetModel();
+}
@@ -0,0 +1,129 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "../magda/daw/profiling/BenchmarkReport.hpp"
+
+using namespace magda;
+using Catch::Approx;
+
+namespace {
+
+BenchmarkReport makeReport(std::initializer_list<std::pair<const char*, double>> medians) {
+    BenchmarkReport report;
+    for (const auto& [phase, ms] : medians) {
+        report.addSample(phase, ms);
+    }
+    return report;
+}
+
+}  // namespace
+
+// ============================================================================
+// BenchmarkReport Tests
+// ============================================================================
+
+TEST_CASE("BenchmarkReport - Summarises samples", "[profiling][benchmark]") {
+    SECTION("Odd count uses the middle sample") {
+        const auto stats = BenchmarkReport::summarise({5.0, 1.0, 3.0});
+        REQUIRE(stats.iterations == 3);
+        REQUIRE(stats.minMs == Approx(1.0));
+        REQUIRE(stats.maxMs == Approx(5.0));
+        REQUIRE(stats.medianMs == Approx(3.0));
+        REQUIRE(stats.meanMs == Approx(3.0));
+    }
+
+    SECTION("Even count averages the middle pair") {
+        const auto stats = BenchmarkReport::summarise({4.0, 1.0, 2.0, 10.0});
+        REQUIRE(stats.medianMs == Approx(3.0));
+        REQUIRE(stats.meanMs == Approx(4.25));
+    }
+
+    SECTION("No samples") {
+        const auto stats = BenchmarkReport::summarise({});
+        REQUIRE(stats.iterations == 0);
+        REQUIRE(stats.medianMs == 0.0);
+    }
+}
+
+TEST_CASE("BenchmarkReport - JSON round trip keeps summaries and config",
+          "[profiling][benchmark]") {
+    BenchmarkReport report;
+    report.setConfig("tracks", 64);
+    report.addSample("sync.full", 12.0);
+    report.addSample("sync.full", 10.0);
+    report.addSample("sync.full", 14.0);
+    report.addSample("render", 250.0);
+
+    const auto parsed = BenchmarkReport::fromJSON(report.toJSON());
+    REQUIRE(parsed.has_value());
+    REQUIRE(static_cast<int>(parsed->getConfig()["tracks"]) == 64);
+
+    const auto sync = parsed->getStats("sync.full");
+    REQUIRE(sync.has_value());
+    REQUIRE(sync->iterations == 3);
+    REQUIRE(sync->medianMs == Approx(12.0));
+    REQUIRE(sync->minMs == Approx(10.0));
+    REQUIRE(sync->maxMs == Approx(14.0));
+
+    REQUIRE(parsed->hasPhase("render"));
+    REQUIRE_FALSE(parsed->hasPhase("undo.undo"));
+}
+
+TEST_CASE("BenchmarkReport - Memory keeps the peak per subsystem and survives JSON",
+          "[profiling][benchmark]") {
+    BenchmarkReport report;
+    report.setMemory("Clips & notes", 4096);
+    report.setMemory("Clips & notes", 1024);
+    report.setMemory("Undo history", 512);
+    REQUIRE(report.getMemory().at("Clips & notes") == 4096);
+
+    const auto parsed = BenchmarkReport::fromJSON(report.toJSON());
+    REQUIRE(parsed.has_value());
+    REQUIRE(parsed->getMemory().size() == 2);
+    REQUIRE(parsed->getMemory().at("Clips & notes") == 4096);
+    REQUIRE(parsed->getMemory().at("Undo history") == 512);
+}
+
+TEST_CASE("BenchmarkReport - Rejects text that isn't a report", "[profiling][benchmark]") {
+    REQUIRE_FALSE(BenchmarkReport::fromJSON("").has_value());
+    REQUIRE_FALSE(BenchmarkReport::fromJSON("[1, 2, 3]").has_value());
+    REQUIRE_FALSE(BenchmarkReport::fromJSON("{\"schema\": 99, \"phases\": {}}").has_value());
+}
+
+TEST_CASE("BenchmarkReport - Flags phases slower than the tolerance", "[profiling][benchmark]") {
+    const auto baseline = makeReport({{"sync.full", 10.0}, {"query", 2.0}, {"render", 100.0}});
+
+    SECTION("Within tolerance") {
+        const auto current = makeReport({{"sync.full", 11.0}, {"query", 1.0}, {"render", 90.0}});
+        REQUIRE(current.findRegressions(baseline, 0.15).empty());
+    }
+
+    SECTION("Beyond tolerance") {
+        const auto current = makeReport({{"sync.full", 13.0}, {"query", 2.0}, {"render", 100.0}});
+        const auto regressions = current.findRegressions(baseline, 0.15);
+        REQUIRE(regressions.size() == 1);
+        REQUIRE(regressions[0].phase == "sync.full");
+        REQUIRE(regressions[0].baselineMs == Approx(10.0));
+        REQUIRE(regressions[0].getRatio() == Approx(1.3));
+    }
+
+    SECTION("Tiny absolute differences are noise") {
+        const auto fast = makeReport({{"query", 0.01}});
+        const auto current = makeReport({{"query", 0.03}});
+        REQUIRE(current.findRegressions(fast, 0.15).empty());
+    }
+
+    SECTION("Phases missing from either side are skipped") {
+        const auto current = makeReport({{"undo.undo", 50.0}, {"sync.full", 10.0}});
+        REQUIRE(current.findRegressions(baseline, 0.15).empty());
+    }
+
+    SECTION("Parsed baselines compare the same way") {
+        const auto stored = BenchmarkReport::fromJSON(baseline.toJSON());
+        REQUIRE(stored.has_value());
+        const auto current = makeReport({{"render", 200.0}});
+        const auto regressions = current.findRegressions(*stored, 0.15);
+        REQUIRE(regressions.size() == 1);
+        REQUIRE(regressions[0].phase == "render");
+    }
+}
@@ -0,0 +1,131 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "../magda/daw/audio/ChainSilenceGate.hpp"
+
+using namespace magda;
+
+namespace {
+
+ChainSilenceGate::Observation silent(int numDevices = 2) {
+    ChainSilenceGate::Observation observation;
+    observation.outputSilent = true;
+    observation.numDevices = numDevices;
+    return observation;
+}
+
+}  // namespace
+
+// =============================================================================
+// Suspending
+// =============================================================================
+
+TEST_CASE("ChainSilenceGate suspends after the tail of silence", "[chaingate]") {
+    ChainSilenceGate gate;
+    gate.setTailSeconds(2.0);
+
+    REQUIRE(gate.update(1, silent(), 0.0) == ChainSilenceGate::Action::None);
+    REQUIRE(gate.update(1, silent(), 1.9) == ChainSilenceGate::Action::None);
+    REQUIRE(gate.update(1, silent(), 2.0) == ChainSilenceGate::Action::Suspend);
+    REQUIRE(gate.isSuspended(1));
+
+    // Only reported once
+    REQUIRE(gate.update(1, silent(), 3.0) == ChainSilenceGate::Action::None);
+}
+
+TEST_CASE("ChainSilenceGate restarts the tail on sound", "[chaingate]") {
+    ChainSilenceGate gate;
+    gate.setTailSeconds(2.0);
+
+    auto sounding = silent();
+    sounding.outputSilent = false;
+
+    gate.update(1, silent(), 0.0);
+    gate.update(1, sounding, 1.5);  // A reverb tail still ringing
+    REQUIRE(gate.update(1, silent(), 3.0) == ChainSilenceGate::Action::None);
+    REQUIRE(gate.update(1, silent(), 3.5) == ChainSilenceGate::Action::Suspend);
+}
+
+TEST_CASE("ChainSilenceGate never suspends what it can't save", "[chaingate]") {
+    ChainSilenceGate gate;
+    gate.setTailSeconds(1.0);
+
+    SECTION("No devices") {
+        gate.update(1, silent(0), 0.0);
+        REQUIRE(gate.update(1, silent(0), 5.0) == ChainSilenceGate::Action::None);
+    }
+
+    SECTION("Suspension turned off") {
+        gate.setTailSeconds(0.0);
+        gate.update(1, silent(), 0.0);
+        REQUIRE(gate.update(1, silent(), 5.0) == ChainSilenceGate::Action::None);
+    }
+}
+
+// =============================================================================
+// Resuming
+// =============================================================================
+
+TEST_CASE("ChainSilenceGate resumes when input is expected", "[chaingate]") {
+    ChainSilenceGate gate;
+    gate.setTailSeconds(1.0);
+    gate.update(1, silent(), 0.0);
+    REQUIRE(gate.update(1, silent(), 1.0) == ChainSilenceGate::Action::Suspend);
+
+    auto clipAhead = silent();
+    clipAhead.inputExpected = true;
+    REQUIRE(gate.update(1, clipAhead, 1.5) == ChainSilenceGate::Action::Resume);
+    REQUIRE_FALSE(gate.isSuspended(1));
+
+    // The tail starts again from the wake
+    REQUIRE(gate.update(1, silent(), 2.0) == ChainSilenceGate::Action::None);
+    REQUIRE(gate.update(1, silent(), 2.5) == ChainSilenceGate::Action::Suspend);
+}
+
+TEST_CASE("ChainSilenceGate::wake reports whether the chain was suspended", "[chaingate]") {
+    ChainSilenceGate gate;
+    gate.setTailSeconds(1.0);
+    REQUIRE_FALSE(gate.wake(1, 0.0));  // Unknown chain
+
+    gate.update(1, silent(), 0.0);
+    gate.update(1, silent(), 1.0);
+    REQUIRE(gate.wake(1, 1.2));
+    REQUIRE_FALSE(gate.wake(1, 1.3));
+    REQUIRE(gate.update(1, silent(), 2.0) == ChainSilenceGate::Action::None);
+
+    gate.update(1, silent(), 2.3);
+    REQUIRE(gate.remove(1));
+    REQUIRE_FALSE(gate.isSuspended(1));
+}
+
+// =============================================================================
+// Statistics
+// =============================================================================
+
+TEST_CASE("ChainSilenceGate reports device time saved", "[chaingate]") {
+    ChainSilenceGate gate;
+    gate.setTailSeconds(1.0);
+
+    // Chain 1 (3 devices) suspends at 1 s; chain 2 (1 device) keeps running
+    auto sounding = silent(1);
+    sounding.outputSilent = false;
+    gate.update(1, silent(3), 0.0);
+    gate.update(2, sounding, 0.0);
+    gate.update(1, silent(3), 1.0);
+    gate.update(2, sounding, 1.0);
+    gate.update(1, silent(3), 3.0);
+    gate.update(2, sounding, 3.0);
+
+    const auto stats = gate.getStats();
+    REQUIRE(stats.chains == 2);
+    REQUIRE(stats.suspendedChains == 1);
+    REQUIRE(stats.devices == 4);
+    REQUIRE(stats.suspendedDevices == 3);
+    REQUIRE(stats.deviceSeconds == Catch::Approx(12.0));
+    REQUIRE(stats.savedDeviceSeconds == Catch::Approx(6.0));
+    REQUIRE(stats.getSavedPercent() == Catch::Approx(50.0));
+
+    gate.resetStats();
+    REQUIRE(gate.getStats().deviceSeconds == 0.0);
+    REQUIRE(gate.getStats().suspendedChains == 1);
+}
@@ -0,0 +1,119 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "magda/daw/core/ClipManager.hpp"
+
+/**
+ * Tests for coalesced change sets
+ *
+ * These tests verify:
+ * - Adds, removes and modifications net out within one delivery
+ * - ClipManager records edits with what changed and delivers them once per flush
+ */
+
+using namespace magda;
+
+TEST_CASE("ChangeSet - Edits net out within a delivery", "[changes]") {
+    ClipChangeSet changes;
+    REQUIRE(changes.empty());
+
+    SECTION("Modifications accumulate flags") {
+        changes.markModified(1, ClipDirty::Position);
+        changes.markModified(1, ClipDirty::Content);
+        REQUIRE(hasFlag(changes.flagsFor(1), ClipDirty::Position));
+        REQUIRE(hasFlag(changes.flagsFor(1), ClipDirty::Content));
+        REQUIRE_FALSE(hasFlag(changes.flagsFor(1), ClipDirty::Appearance));
+        REQUIRE(changes.flagsFor(2) == ClipDirty::None);
+    }
+
+    SECTION("An added id is not also reported as modified") {
+        changes.markAdded(1);
+        changes.markModified(1, ClipDirty::Appearance);
+        REQUIRE(changes.added.count(1) == 1);
+        REQUIRE(changes.modified.empty());
+    }
+
+    SECTION("Adding then removing leaves nothing") {
+        changes.markAdded(1);
+        changes.markModified(1, ClipDirty::Position);
+        changes.markRemoved(1);
+        REQUIRE(changes.empty());
+    }
+
+    SECTION("Removing then restoring reports a full modification") {
+        changes.markModified(1, ClipDirty::Position);
+        changes.markRemoved(1);
+        REQUIRE(changes.modified.empty());
+        REQUIRE(changes.removed.count(1) == 1);
+
+        changes.markAdded(1);
+        REQUIRE(changes.removed.empty());
+        REQUIRE(changes.added.empty());
+        REQUIRE(changes.flagsFor(1) == ClipDirty::All);
+    }
+
+    SECTION("Reset drops the partial ids") {
+        changes.markAdded(1);
+        changes.markModified(2, ClipDirty::Loop);
+        changes.markReset();
+        REQUIRE(changes.reset);
+        REQUIRE(changes.added.empty());
+        REQUIRE(changes.modified.empty());
+        REQUIRE_FALSE(changes.empty());
+    }
+}
+
+namespace {
+
+class RecordingClipListener : public ClipManagerListener {
+  public:
+    void clipsChanged() override {}
+    void clipChangesCoalesced(const ClipChangeSet& changes) override {
+        deliveries.push_back(changes);
+    }
+
+    std::vector<ClipChangeSet> deliveries;
+};
+
+}  // namespace
+
+TEST_CASE("ClipManager - Changes are delivered once per flush", "[clip][changes]") {
+    auto& clipManager = ClipManager::getInstance();
+    clipManager.shutdown();
+
+    ClipId kept = clipManager.createMidiClip(1, 0.0, 1.0);
+    ClipId deleted = clipManager.createMidiClip(1, 2.0, 1.0);
+    clipManager.flushPendingChanges();
+
+    RecordingClipListener listener;
+    clipManager.addListener(&listener);
+
+    clipManager.moveClip(kept, 4.0);
+    clipManager.setClipName(kept, "Renamed");
+    clipManager.deleteClip(deleted);
+    ClipId created = clipManager.createMidiClip(2, 0.0, 1.0);
+    clipManager.setClipColour(created, juce::Colours::red);
+
+    REQUIRE(listener.deliveries.empty());
+    clipManager.flushPendingChanges();
+    REQUIRE(listener.deliveries.size() == 1);
+
+    const auto& changes = listener.deliveries.front();
+    REQUIRE(changes.added.count(created) == 1);
+    REQUIRE(changes.removed.count(deleted) == 1);
+    REQUIRE(changes.modified.size() == 1);
+    REQUIRE(hasFlag(changes.flagsFor(kept), ClipDirty::Position));
+    REQUIRE(hasFlag(changes.flagsFor(kept), ClipDirty::Appearance));
+    REQUIRE_FALSE(hasFlag(changes.flagsFor(kept), ClipDirty::Content));
+
+    // Nothing new since the last flush
+    clipManager.flushPendingChanges();
+    REQUIRE(listener.deliveries.size() == 1);
+
+    clipManager.forceNotifyClipsChanged();
+    clipManager.flushPendingChanges();
+    REQUIRE(listener.deliveries.size() == 2);
+    REQUIRE(listener.deliveries.back().reset);
+
+    clipManager.removeListener(&listener);
+    clipManager.shutdown();
+}
@@ -0,0 +1,186 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <vector>
+
+#include "../magda/daw/audio/ClickGenerator.hpp"
+
+using namespace magda;
+
+// ============================================================================
+// ClickGenerator Tests
+// ============================================================================
+// The metronome adds pre-rendered clicks from the sample each beat lands on,
+// following the bridge's beat clock block by block.
+
+namespace {
+
+// 120 BPM at 48 kHz: a beat is 24000 samples
+constexpr double kSampleRate = 48000.0;
+constexpr double kBpm = 120.0;
+constexpr double kBeatsPerSample = 1.0 / 24000.0;
+constexpr int kBlockSize = 512;
+
+ClickGenerator::Block playingBlock(double startBeat, double beatsPerSample = kBeatsPerSample) {
+    ClickGenerator::Block block;
+    block.startBeat = startBeat;
+    block.beatsPerSample = beatsPerSample;
+    block.numSamples = kBlockSize;
+    block.playing = true;
+    return block;
+}
+
+ClickGenerator::Block stoppedBlock() {
+    ClickGenerator::Block block;
+    block.numSamples = kBlockSize;
+    return block;
+}
+
+// Renders numBlocks blocks into one mono buffer, the clock advancing by tempo
+std::vector<float> play(ClickGenerator& click, double startBeat, int numBlocks,
+                        double beatsPerSample = kBeatsPerSample) {
+    std::vector<float> output(static_cast<size_t>(numBlocks) * kBlockSize, 0.0f);
+    for (int i = 0; i < numBlocks; ++i) {
+        float* channel = output.data() + static_cast<size_t>(i) * kBlockSize;
+        const double beat = startBeat + i * kBlockSize * beatsPerSample;
+        click.process(playingBlock(beat, beatsPerSample), kBpm, &channel, 1);
+    }
+    return output;
+}
+
+// Samples a click starts on: the first non-silent sample after at least a click's silence
+std::vector<long> clickStarts(const std::vector<float>& output) {
+    std::vector<long> starts;
+    long silentSince = -1000000;
+    for (size_t i = 0; i < output.size(); ++i) {
+        if (output[i] != 0.0f) {
+            if (static_cast<long>(i) - silentSince > 1000) {
+                starts.push_back(static_cast<long>(i));
+            }
+            silentSince = static_cast<long>(i);
+        }
+    }
+    return starts;
+}
+
+}  // namespace
+
+TEST_CASE("ClickGenerator - Clicks land on the beat's sample", "[audio][metronome]") {
+    ClickGenerator click;
+    click.prepare(kSampleRate);
+    click.setEnabled(true);
+    click.setLevel(1.0f);
+
+    // From half a beat in: beats 1, 2 and 3 land 12000 samples apart from 24000
+    const auto output = play(click, 0.5, 150);
+    const auto starts = clickStarts(output);
+    // A click's first sample is sin(0) = 0, so it's heard from the sample after
+    REQUIRE(starts == std::vector<long>{12001, 36001, 60001});
+
+    // The output is the rendered click, added from that sample
+    const auto& rendered = click.getClick(false);
+    for (size_t i = 0; i < rendered.size(); ++i) {
+        REQUIRE(output[12000 + i] == rendered[i]);
+    }
+}
+
+TEST_CASE("ClickGenerator - Accents the first beat of each bar", "[audio][metronome]") {
+    ClickGenerator click;
+    click.prepare(kSampleRate);
+    click.setEnabled(true);
+    click.setLevel(1.0f);
+    click.setBeatsPerBar(3);
+
+    const auto output = play(click, 0.0, 290);  // Beats 0 to 6
+    const auto& accent = click.getClick(true);
+    const auto& beat = click.getClick(false);
+    for (int n = 0; n < 6; ++n) {
+        const auto& expected = n % 3 == 0 ? accent : beat;
+        REQUIRE(output[static_cast<size_t>(n) * 24000 + 10] == expected[10]);
+    }
+}
+
+TEST_CASE("ClickGenerator - Disabled or stopped adds nothing", "[audio][metronome]") {
+    ClickGenerator click;
+    click.prepare(kSampleRate);
+
+    const auto disabled = play(click, 0.0, 100);
+    REQUIRE(clickStarts(disabled).empty());
+
+    click.setEnabled(true);
+    std::vector<float> output(kBlockSize, 0.0f);
+    float* channel = output.data();
+    for (int i = 0; i < 100; ++i) {
+        REQUIRE(click.process(stoppedBlock(), kBpm, &channel, 1) == -1);
+    }
+    REQUIRE(clickStarts(output).empty());
+}
+
+TEST_CASE("ClickGenerator - A tempo nudge neither drops nor repeats a beat",
+          "[audio][metronome]") {
+    ClickGenerator click;
+    click.prepare(kSampleRate);
+    click.setEnabled(true);
+
+    // The clock is recomputed from the new tempo: it jumps back just after beat 2 has
+    // clicked, and ahead over beat 3
+    std::vector<float> output(static_cast<size_t>(200) * kBlockSize, 0.0f);
+    double beat = 0.9;
+    for (int i = 0; i < 200; ++i) {
+        if (i == 53) {
+            beat -= 0.05;
+        } else if (i == 100) {
+            beat += 0.05;
+        }
+        float* channel = output.data() + static_cast<size_t>(i) * kBlockSize;
+        click.process(playingBlock(beat), kBpm, &channel, 1);
+        beat += kBlockSize * kBeatsPerSample;
+    }
+    // Beats 1 to 5, once each
+    const auto starts = clickStarts(output);
+    REQUIRE(starts.size() == 5);
+    for (size_t i = 1; i < starts.size(); ++i) {
+        REQUIRE(starts[i] - starts[i - 1] > 20000);
+    }
+}
+
+TEST_CASE("ClickGenerator - Count-in clicks whole beats then reports its end",
+          "[audio][metronome]") {
+    ClickGenerator click;
+    click.prepare(kSampleRate);
+    click.setLevel(1.0f);  // Counts in with the metronome off too
+    click.setBeatsPerBar(4);
+    click.startCountIn(4);
+
+    std::vector<float> output(static_cast<size_t>(200) * kBlockSize, 0.0f);
+    long ended = -1;
+    for (int i = 0; i < 200 && ended < 0; ++i) {
+        float* channel = output.data() + static_cast<size_t>(i) * kBlockSize;
+        REQUIRE(click.isCountingIn() == (i > 0));
+        const int offset = click.process(stoppedBlock(), kBpm, &channel, 1);
+        if (offset >= 0) {
+            ended = static_cast<long>(i) * kBlockSize + offset;
+        }
+    }
+
+    // Four beats from the first sample; recording starts on the fifth
+    REQUIRE(ended == 4 * 24000);
+    REQUIRE(clickStarts(output) == std::vector<long>{1, 24001, 48001, 72001});
+    REQUIRE(output[10] == click.getClick(true)[10]);
+    REQUIRE(output[24010] == click.getClick(false)[10]);
+    REQUIRE_FALSE(click.isCountingIn());
+
+    SECTION("Cancelled, it stops clicking") {
+        click.startCountIn(8);
+        std::vector<float> block(kBlockSize, 0.0f);
+        float* channel = block.data();
+        click.process(stoppedBlock(), kBpm, &channel, 1);
+        REQUIRE(click.isCountingIn());
+
+        click.cancelCountIn();
+        for (int i = 0; i < 200; ++i) {
+            REQUIRE(click.process(stoppedBlock(), kBpm, &channel, 1) == -1);
+        }
+        REQUIRE_FALSE(click.isCountingIn());
+    }
+}
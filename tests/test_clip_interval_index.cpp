@@ -0,0 +1,108 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <vector>
+
+#include "../magda/daw/core/ClipIntervalIndex.hpp"
+
+using namespace magda;
+
+// ============================================================================
+// ClipIntervalIndex Tests
+// ============================================================================
+
+namespace {
+
+std::vector<ClipId> query(const ClipIntervalIndex& index, double start, double end) {
+    std::vector<ClipIntervalIndex::Interval> intervals;
+    index.query(start, end, intervals);
+
+    std::vector<ClipId> ids;
+    for (const auto& interval : intervals) {
+        ids.push_back(interval.id);
+    }
+    return ids;
+}
+
+// Brute-force reference: ids overlapping [start, end) in start order
+std::vector<ClipId> scan(const ClipIntervalIndex& index, double start, double end) {
+    std::vector<ClipId> ids;
+    for (const auto& interval : index.getIntervals()) {
+        if (interval.start < end && interval.end > start) {
+            ids.push_back(interval.id);
+        }
+    }
+    return ids;
+}
+
+}  // namespace
+
+TEST_CASE("ClipIntervalIndex - Empty index returns nothing", "[clip][index]") {
+    ClipIntervalIndex index;
+    REQUIRE(index.empty());
+    REQUIRE(query(index, 0.0, 100.0).empty());
+
+    index.build({});
+    REQUIRE(query(index, 0.0, 100.0).empty());
+}
+
+TEST_CASE("ClipIntervalIndex - Overlap queries", "[clip][index]") {
+    ClipIntervalIndex index;
+    // Unsorted input, including a long clip covering the others
+    index.build({{3, 8.0, 10.0}, {1, 0.0, 2.0}, {2, 4.0, 6.0}, {4, 1.0, 20.0}});
+    REQUIRE(index.size() == 4);
+
+    SECTION("Intervals are sorted by start") {
+        const auto& intervals = index.getIntervals();
+        REQUIRE(intervals.front().id == 1);
+        REQUIRE(intervals.back().id == 3);
+    }
+
+    SECTION("Range inside the long clip") {
+        const std::vector<ClipId> expected{4, 2};
+        REQUIRE(query(index, 4.5, 5.0) == expected);
+    }
+
+    SECTION("Ends are exclusive") {
+        const std::vector<ClipId> expected{4, 2};
+        REQUIRE(query(index, 2.0, 8.0) == expected);
+    }
+
+    SECTION("Empty and inverted ranges") {
+        REQUIRE(query(index, 5.0, 5.0).empty());
+        REQUIRE(query(index, 6.0, 5.0).empty());
+        REQUIRE(query(index, 20.0, 30.0).empty());
+    }
+
+    SECTION("Clear") {
+        index.clear();
+        REQUIRE(query(index, 0.0, 100.0).empty());
+    }
+}
+
+TEST_CASE("ClipIntervalIndex - Matches a linear scan", "[clip][index]") {
+    // Deterministic pseudo-random clips of varied lengths
+    std::vector<ClipIntervalIndex::Interval> intervals;
+    unsigned seed = 12345;
+    auto next = [&seed]() {
+        seed = seed * 1103515245u + 12345u;
+        return static_cast<double>((seed >> 16) % 1000);
+    };
+    for (ClipId id = 0; id < 500; ++id) {
+        const double start = next();
+        intervals.push_back({id, start, start + 1.0 + next() / 20.0});
+    }
+
+    ClipIntervalIndex index;
+    index.build(intervals);
+
+    bool allMatch = true;
+    for (int i = 0; i < 200; ++i) {
+        const double start = next();
+        const double end = start + next() / 10.0;
+        if (query(index, start, end) != scan(index, start, end)) {
+            allMatch = false;
+        }
+    }
+    REQUIRE(allMatch);
+}
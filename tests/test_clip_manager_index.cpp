@@ -0,0 +1,245 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <vector>
+
+#include "magda/daw/core/ClipManager.hpp"
+
+/**
+ * Tests for ClipManager's id and per-track range indexes
+ *
+ * These tests verify:
+ * - Id lookups stay valid across deletes (positions shift)
+ * - Range and position queries follow moves, resizes and track changes
+ * - Direct edits followed by forceNotifyClipsChanged() are picked up
+ * - The geometry table stays row for row with the clips
+ * - Session slot lookups follow scene, track and delete changes
+ * - Duplicates share their notes and sources until one of them is edited
+ */
+
+TEST_CASE("ClipManager - Id lookup survives deletes", "[clip][index]") {
+    using namespace magda;
+
+    auto& clipManager = ClipManager::getInstance();
+    clipManager.shutdown();
+
+    ClipId first = clipManager.createMidiClip(1, 0.0, 1.0);
+    ClipId second = clipManager.createMidiClip(1, 2.0, 1.0);
+    ClipId third = clipManager.createMidiClip(2, 4.0, 1.0);
+
+    clipManager.deleteClip(first);
+
+    REQUIRE(clipManager.getClip(first) == nullptr);
+    REQUIRE(clipManager.getClip(second) != nullptr);
+    REQUIRE(clipManager.getClip(second)->id == second);
+    REQUIRE(clipManager.getClip(third) != nullptr);
+    REQUIRE(clipManager.getClip(third)->id == third);
+    REQUIRE(clipManager.getClipsOnTrack(1) == std::vector<ClipId>{second});
+
+    clipManager.shutdown();
+}
+
+TEST_CASE("ClipManager - Range queries follow edits", "[clip][index]") {
+    using namespace magda;
+
+    auto& clipManager = ClipManager::getInstance();
+    clipManager.shutdown();
+
+    ClipId a = clipManager.createMidiClip(1, 4.0, 2.0);  // [4, 6)
+    ClipId b = clipManager.createMidiClip(1, 0.0, 2.0);  // [0, 2)
+    ClipId c = clipManager.createMidiClip(1, 8.0, 2.0);  // [8, 10)
+
+    SECTION("Results are sorted by start time") {
+        REQUIRE(clipManager.getClipsOnTrack(1) == std::vector<ClipId>{b, a, c});
+        REQUIRE(clipManager.getClipsInRange(1, 1.0, 9.0) == std::vector<ClipId>{b, a, c});
+        REQUIRE(clipManager.getClipsInRange(1, 6.0, 8.0).empty());
+    }
+
+    SECTION("Position queries treat the end as exclusive") {
+        REQUIRE(clipManager.getClipAtPosition(1, 4.0) == a);
+        REQUIRE(clipManager.getClipAtPosition(1, 5.9) == a);
+        REQUIRE(clipManager.getClipAtPosition(1, 6.0) == INVALID_CLIP_ID);
+        REQUIRE(clipManager.getClipAtPosition(2, 4.0) == INVALID_CLIP_ID);
+    }
+
+    SECTION("Move and resize update the index") {
+        clipManager.moveClip(c, 1.0);  // [1, 3)
+        REQUIRE(clipManager.getClipsOnTrack(1) == std::vector<ClipId>{b, c, a});
+        REQUIRE(clipManager.getClipAtPosition(1, 2.5) == c);
+        REQUIRE(clipManager.getClipsInRange(1, 8.0, 10.0).empty());
+
+        clipManager.resizeClip(a, 6.0, false);  // [4, 10)
+        REQUIRE(clipManager.getClipAtPosition(1, 9.0) == a);
+    }
+
+    SECTION("Moving to another track moves the clip between indexes") {
+        clipManager.moveClipToTrack(a, 2);
+        REQUIRE(clipManager.getClipsOnTrack(1) == std::vector<ClipId>{b, c});
+        REQUIRE(clipManager.getClipsOnTrack(2) == std::vector<ClipId>{a});
+        REQUIRE(clipManager.getClipAtPosition(2, 5.0) == a);
+    }
+
+    SECTION("Split indexes both halves") {
+        ClipId right = clipManager.splitClip(a, 5.0);
+        REQUIRE(right != INVALID_CLIP_ID);
+        REQUIRE(clipManager.getClipAtPosition(1, 4.5) == a);
+        REQUIRE(clipManager.getClipAtPosition(1, 5.5) == right);
+    }
+
+    SECTION("Direct edits are picked up by forceNotifyClipsChanged") {
+        clipManager.getClip(b)->trackId = 3;
+        clipManager.getClip(c)->startTime = 20.0;
+        clipManager.forceNotifyClipsChanged();
+
+        REQUIRE(clipManager.getClipsOnTrack(1) == std::vector<ClipId>{a, c});
+        REQUIRE(clipManager.getClipsOnTrack(3) == std::vector<ClipId>{b});
+        REQUIRE(clipManager.getClipAtPosition(1, 21.0) == c);
+    }
+
+    clipManager.shutdown();
+}
+
+TEST_CASE("ClipManager - Geometry rows mirror the clips", "[clip][index]") {
+    using namespace magda;
+
+    auto& clipManager = ClipManager::getInstance();
+    clipManager.shutdown();
+
+    auto requireMirrored = [&clipManager]() {
+        const auto& clips = clipManager.getClips();
+        const auto& geometry = clipManager.getClipGeometry();
+        REQUIRE(geometry.size() == clips.size());
+        for (size_t i = 0; i < clips.size(); ++i) {
+            REQUIRE(geometry[i].id == clips[i].id);
+            REQUIRE(geometry[i].trackId == clips[i].trackId);
+            REQUIRE(geometry[i].startTime == clips[i].startTime);
+            REQUIRE(geometry[i].endTime == clips[i].getEndTime());
+            REQUIRE(geometry[i].sceneIndex == clips[i].sceneIndex);
+            REQUIRE(geometry[i].type == clips[i].type);
+            REQUIRE(geometry[i].isPlaying == clips[i].isPlaying);
+            REQUIRE(geometry[i].isQueued == clips[i].isQueued);
+        }
+    };
+
+    ClipId a = clipManager.createMidiClip(1, 0.0, 2.0);
+    ClipId b = clipManager.createMidiClip(1, 4.0, 2.0);
+    ClipId c = clipManager.createMidiClip(2, 8.0, 2.0);
+    requireMirrored();
+
+    clipManager.moveClip(b, 5.0);
+    clipManager.resizeClip(c, 3.0, false);
+    clipManager.moveClipToTrack(a, 3);
+    clipManager.setClipSceneIndex(c, 2);
+    requireMirrored();
+
+    clipManager.splitClip(b, 6.0);
+    clipManager.deleteClip(a);
+    requireMirrored();
+
+    // Launching without a launcher plays at once; the playback flags follow
+    clipManager.triggerClip(c);
+    REQUIRE(clipManager.getClip(c)->isPlaying);
+    requireMirrored();
+    clipManager.stopAllClips();
+    requireMirrored();
+
+    clipManager.shutdown();
+    REQUIRE(clipManager.getClipGeometry().empty());
+}
+
+TEST_CASE("ClipManager - Slot lookup follows session edits", "[clip][index]") {
+    using namespace magda;
+
+    auto& clipManager = ClipManager::getInstance();
+    clipManager.shutdown();
+
+    ClipId a = clipManager.createMidiClip(1, 0.0, 1.0);
+    ClipId b = clipManager.createMidiClip(1, 2.0, 1.0);
+    ClipId c = clipManager.createMidiClip(2, 4.0, 1.0);
+    clipManager.setClipSceneIndex(a, 0);
+    clipManager.setClipSceneIndex(b, 3);
+    clipManager.setClipSceneIndex(c, 0);
+
+    REQUIRE(clipManager.getClipInSlot(1, 0) == a);
+    REQUIRE(clipManager.getClipInSlot(1, 3) == b);
+    REQUIRE(clipManager.getClipInSlot(2, 0) == c);
+    REQUIRE(clipManager.getClipInSlot(1, 1) == INVALID_CLIP_ID);
+    REQUIRE(clipManager.getClipInSlot(1, 99) == INVALID_CLIP_ID);
+    REQUIRE(clipManager.getClipInSlot(3, 0) == INVALID_CLIP_ID);
+
+    SECTION("Changing scene moves the slot") {
+        clipManager.setClipSceneIndex(b, 1);
+        REQUIRE(clipManager.getClipInSlot(1, 3) == INVALID_CLIP_ID);
+        REQUIRE(clipManager.getClipInSlot(1, 1) == b);
+
+        clipManager.setClipSceneIndex(b, -1);
+        REQUIRE(clipManager.getClipInSlot(1, 1) == INVALID_CLIP_ID);
+    }
+
+    SECTION("Moving to another track moves the slot") {
+        clipManager.moveClipToTrack(b, 2);
+        REQUIRE(clipManager.getClipInSlot(1, 3) == INVALID_CLIP_ID);
+        REQUIRE(clipManager.getClipInSlot(2, 3) == b);
+    }
+
+    SECTION("Deleting the holder hands the slot to a clip sharing it") {
+        ClipId d = clipManager.createMidiClip(1, 6.0, 1.0);
+        clipManager.setClipSceneIndex(d, 0);
+        REQUIRE(clipManager.getClipInSlot(1, 0) == a);
+
+        clipManager.deleteClip(a);
+        REQUIRE(clipManager.getClipInSlot(1, 0) == d);
+
+        clipManager.deleteClip(d);
+        REQUIRE(clipManager.getClipInSlot(1, 0) == INVALID_CLIP_ID);
+    }
+
+    SECTION("Direct edits are picked up by forceNotifyClipsChanged()") {
+        clipManager.getClip(c)->sceneIndex = 5;
+        clipManager.forceNotifyClipsChanged();
+        REQUIRE(clipManager.getClipInSlot(2, 0) == INVALID_CLIP_ID);
+        REQUIRE(clipManager.getClipInSlot(2, 5) == c);
+    }
+
+    clipManager.shutdown();
+}
+
+TEST_CASE("ClipManager - Duplicates share their payload until edited", "[clip][copy]") {
+    using namespace magda;
+
+    auto& clipManager = ClipManager::getInstance();
+    clipManager.shutdown();
+
+    SECTION("MIDI notes") {
+        ClipId original = clipManager.createMidiClip(1, 0.0, 4.0);
+        std::vector<MidiNote> notes(500);
+        for (size_t i = 0; i < notes.size(); ++i) {
+            notes[i].startBeat = static_cast<double>(i) * 0.25;
+        }
+        clipManager.addMidiNotes(original, notes);
+
+        ClipId copy = clipManager.duplicateClip(original);
+        const auto& copyNotes = clipManager.getClip(copy)->midiNotes;
+        REQUIRE(copyNotes.sharesStorageWith(clipManager.getClip(original)->midiNotes));
+
+        clipManager.addMidiNote(copy, MidiNote{});
+        REQUIRE_FALSE(clipManager.getClip(copy)->midiNotes.sharesStorageWith(
+            clipManager.getClip(original)->midiNotes));
+        REQUIRE(clipManager.getClip(original)->midiNotes.size() == 500);
+        REQUIRE(clipManager.getClip(copy)->midiNotes.size() == 501);
+    }
+
+    SECTION("Audio sources") {
+        ClipId original = clipManager.createAudioClip(1, 0.0, 4.0, "/audio/loop.wav");
+        ClipId copy = clipManager.duplicateClipAt(original, 8.0);
+        REQUIRE(clipManager.getClip(copy)->audioSources.sharesStorageWith(
+            clipManager.getClip(original)->audioSources));
+
+        clipManager.setAudioSourceLength(copy, 0, 2.0);
+        REQUIRE_FALSE(clipManager.getClip(copy)->audioSources.sharesStorageWith(
+            clipManager.getClip(original)->audioSources));
+        REQUIRE(clipManager.getClip(original)->audioSources[0].length == 4.0);
+        REQUIRE(clipManager.getClip(copy)->audioSources[0].length == 2.0);
+    }
+
+    clipManager.shutdown();
+}
@@ -0,0 +1,191 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <functional>
+
+#include "../magda/daw/audio/ClipProcessor.hpp"
+#include "ScopedDirectory.hpp"
+
+using namespace magda;
+using Catch::Approx;
+
+namespace {
+
+constexpr double kSampleRate = 48000.0;
+
+juce::File writeWav(const juce::File& file, int numFrames,
+                    const std::function<float(int)>& sample) {
+    juce::WavAudioFormat wav;
+    std::unique_ptr<juce::AudioFormatWriter> writer(
+        wav.createWriterFor(new juce::FileOutputStream(file), kSampleRate, 1, 32, {}, 0));
+    REQUIRE(writer != nullptr);
+    juce::AudioBuffer<float> buffer(1, numFrames);
+    for (int i = 0; i < numFrames; ++i) {
+        buffer.setSample(0, i, sample(i));
+    }
+    writer->writeFromAudioSampleBuffer(buffer, 0, numFrames);
+    return file;
+}
+
+juce::AudioBuffer<float> readWav(const juce::File& file) {
+    juce::WavAudioFormat wav;
+    std::unique_ptr<juce::AudioFormatReader> reader(
+        wav.createReaderFor(new juce::FileInputStream(file), true));
+    REQUIRE(reader != nullptr);
+    juce::AudioBuffer<float> buffer(static_cast<int>(reader->numChannels),
+                                    static_cast<int>(reader->lengthInSamples));
+    reader->read(&buffer, 0, buffer.getNumSamples(), 0, true, true);
+    return buffer;
+}
+
+AudioSource source(const juce::File& file, double position, double length, double offset = 0.0) {
+    AudioSource s;
+    s.filePath = file.getFullPathName();
+    s.position = position;
+    s.length = length;
+    s.offset = offset;
+    return s;
+}
+
+}  // namespace
+
+// ============================================================================
+// ClipProcessor Tests
+// ============================================================================
+
+TEST_CASE("ClipProcessor - Consolidates overlapping sources into one file", "[clipprocessor]") {
+    ScopedDirectory temp("magda_clip_processor_test");
+    juce::AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+    const auto quarter = writeWav(temp.directory.getChildFile("a.wav"), 4800, [](int) {
+        return 0.25f;
+    });
+    const auto half = writeWav(temp.directory.getChildFile("b.wav"), 9600,
+                               [](int i) { return i < 2400 ? 0.0f : 0.5f; });
+
+    // The second source starts halfway through the first, trimmed past its silent start
+    ClipProcessor::Render render;
+    render.sources = {source(quarter, 0.0, 0.1), source(half, 0.05, 0.1, 0.05)};
+    render.length = 0.2;
+    render.operation = ClipProcessor::Operation::Consolidate;
+    const auto output = temp.directory.getChildFile("out.wav");
+
+    float lastProgress = 0.0f;
+    const auto result = ClipProcessor::render(formatManager, render, output, nullptr,
+                                              [&](float fraction) { lastProgress = fraction; });
+
+    REQUIRE_FALSE(result.failed);
+    REQUIRE(result.lengthSeconds == Approx(0.2));
+    REQUIRE(lastProgress == Approx(1.0f));
+
+    const auto mixed = readWav(output);
+    REQUIRE(mixed.getNumSamples() == 9600);
+    REQUIRE(mixed.getSample(0, 100) == Approx(0.25f));
+    REQUIRE(mixed.getSample(0, 3000) == Approx(0.75f));
+    REQUIRE(mixed.getSample(0, 6000) == Approx(0.5f));
+    REQUIRE(mixed.getSample(0, 8000) == Approx(0.0f));
+}
+
+TEST_CASE("ClipProcessor - Reverses and normalises", "[clipprocessor]") {
+    ScopedDirectory temp("magda_clip_processor_test");
+    juce::AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+    const auto ramp = writeWav(temp.directory.getChildFile("ramp.wav"), 4800,
+                               [](int i) { return 0.5f * static_cast<float>(i) / 4800.0f; });
+
+    ClipProcessor::Render render;
+    render.sources = {source(ramp, 0.0, 0.1)};
+    render.length = 0.1;
+
+    render.operation = ClipProcessor::Operation::Reverse;
+    const auto reversedFile = temp.directory.getChildFile("reversed.wav");
+    REQUIRE_FALSE(ClipProcessor::render(formatManager, render, reversedFile).failed);
+    const auto reversed = readWav(reversedFile);
+    REQUIRE(reversed.getSample(0, 0) == Approx(0.5f * 4799.0f / 4800.0f));
+    REQUIRE(reversed.getSample(0, 4799) == Approx(0.0f));
+
+    render.operation = ClipProcessor::Operation::Normalise;
+    const auto normalisedFile = temp.directory.getChildFile("normalised.wav");
+    REQUIRE_FALSE(ClipProcessor::render(formatManager, render, normalisedFile).failed);
+    const auto normalised = readWav(normalisedFile);
+    REQUIRE(normalised.getMagnitude(0, 0, 4800) == Approx(ClipProcessor::kNormalisePeak));
+    REQUIRE(normalised.getSample(0, 2400) ==
+            Approx(ClipProcessor::kNormalisePeak * 2400.0f / 4799.0f));
+}
+
+TEST_CASE("ClipProcessor - Loops sources to the clip's end", "[clipprocessor]") {
+    ScopedDirectory temp("magda_clip_processor_test");
+    juce::AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+    const auto ramp = writeWav(temp.directory.getChildFile("ramp.wav"), 4800,
+                               [](int i) { return static_cast<float>(i) / 4800.0f; });
+
+    ClipProcessor::Render render;
+    render.sources = {source(ramp, 0.0, 0.05)};
+    render.length = 0.125;
+    render.looped = true;
+    const auto output = temp.directory.getChildFile("looped.wav");
+    REQUIRE_FALSE(ClipProcessor::render(formatManager, render, output).failed);
+
+    // 2400 frames a repeat
+    const auto looped = readWav(output);
+    REQUIRE(looped.getNumSamples() == 6000);
+    REQUIRE(looped.getSample(0, 2400) == Approx(0.0f));
+    REQUIRE(looped.getSample(0, 5000) == Approx(200.0f / 4800.0f));
+}
+
+TEST_CASE("ClipProcessor - Applies source fades and crossfades", "[clipprocessor]") {
+    ScopedDirectory temp("magda_clip_processor_test");
+    juce::AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+    const auto file = writeWav(temp.directory.getChildFile("a.wav"), 4800, [](int) {
+        return 0.5f;
+    });
+
+    // The first source fades out over the 2400 frames where the second fades in
+    AudioFade shortFade, crossfade;
+    shortFade.length = 0.01;
+    shortFade.curve = FadeCurve::Linear;
+    crossfade.length = 0.05;
+    crossfade.curve = FadeCurve::Linear;
+
+    ClipProcessor::Render render;
+    render.sources = {source(file, 0.0, 0.1), source(file, 0.05, 0.1)};
+    render.sources[0].fadeIn = shortFade;
+    render.sources[0].fadeOut = crossfade;
+    render.sources[1].fadeIn = crossfade;
+    render.length = 0.15;
+    const auto output = temp.directory.getChildFile("faded.wav");
+    REQUIRE_FALSE(ClipProcessor::render(formatManager, render, output).failed);
+
+    const auto faded = readWav(output);
+    REQUIRE(faded.getNumSamples() == 7200);
+    REQUIRE(faded.getSample(0, 0) == Approx(0.0f));
+    REQUIRE(faded.getSample(0, 240) == Approx(0.25f));
+    REQUIRE(faded.getSample(0, 1000) == Approx(0.5f));
+
+    // Linear fades across the overlap sum to the level either side of it
+    REQUIRE(faded.getSample(0, 3000) == Approx(0.5f));
+    REQUIRE(faded.getSample(0, 4000) == Approx(0.5f));
+    REQUIRE(faded.getSample(0, 6000) == Approx(0.5f));
+}
+
+TEST_CASE("ClipProcessor - Stretched or missing sources fail", "[clipprocessor]") {
+    ScopedDirectory temp("magda_clip_processor_test");
+    juce::AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+    const auto file = writeWav(temp.directory.getChildFile("a.wav"), 4800, [](int) {
+        return 0.25f;
+    });
+
+    ClipProcessor::Render render;
+    render.sources = {source(file, 0.0, 0.2)};
+    render.sources[0].stretchFactor = 2.0;
+    render.length = 0.2;
+    const auto output = temp.directory.getChildFile("out.wav");
+    REQUIRE(ClipProcessor::render(formatManager, render, output).failed);
+
+    render.sources = {source(temp.directory.getChildFile("missing.wav"), 0.0, 0.1)};
+    REQUIRE(ClipProcessor::render(formatManager, render, output).failed);
+    REQUIRE_FALSE(output.existsAsFile());
+}
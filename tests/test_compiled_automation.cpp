@@ -0,0 +1,113 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "../magda/daw/core/AutomationManager.hpp"
+#include "../magda/daw/core/CompiledAutomation.hpp"
+
+using namespace magda;
+
+namespace {
+
+AutomationTarget makeVolumeTarget(TrackId trackId) {
+    AutomationTarget target;
+    target.type = AutomationTargetType::TrackVolume;
+    target.trackId = trackId;
+    return target;
+}
+
+// Every shape a segment can take: bezier, tension, step and plain linear
+AutomationLaneId makeAbsoluteLane(AutomationManager& manager) {
+    auto laneId = manager.createLane(makeVolumeTarget(1), AutomationLaneType::Absolute);
+    manager.movePoint(laneId, manager.getLane(laneId)->absolutePoints[0].id, 0.0, 0.2);
+    auto bezier = manager.addPoint(laneId, 1.0, 0.9, AutomationCurveType::Bezier);
+    auto tension = manager.addPoint(laneId, 2.0, 0.1);
+    manager.addPoint(laneId, 3.0, 0.6, AutomationCurveType::Step);
+    manager.addPoint(laneId, 3.5, 0.3);
+    manager.addPoint(laneId, 4.0, 0.8);
+
+    BezierHandle in, out;
+    out.time = 0.3;
+    out.value = 0.4;
+    in.time = -0.2;
+    in.value = -0.3;
+    manager.setPointHandles(laneId, bezier, in, out);
+    manager.setPointTension(laneId, tension, 0.7);
+    return laneId;
+}
+
+}  // namespace
+
+// ============================================================================
+// CompiledAutomation Tests
+// ============================================================================
+
+TEST_CASE("CompiledAutomation - Absolute lanes match getValueAtTime", "[automation]") {
+    auto& manager = AutomationManager::getInstance();
+    manager.clearAll();
+
+    auto laneId = makeAbsoluteLane(manager);
+    CompiledAutomation compiled;
+    const auto lane = compiled.addLane(manager, *manager.getLane(laneId));
+    REQUIRE(compiled.getLaneId(lane) == laneId);
+    REQUIRE(compiled.getNumPoints() == 6);
+
+    CompiledAutomation::Cursor cursor;
+    auto requireMatches = [&](double time) {
+        double value = 0.0;
+        REQUIRE(compiled.evaluate(lane, time, cursor, value));
+        REQUIRE(value == Catch::Approx(manager.getValueAtTime(laneId, time)).margin(1e-9));
+    };
+
+    SECTION("Forward playback, one read per block") {
+        for (double t = -0.5; t < 4.5; t += 256.0 / 48000.0)
+            requireMatches(t);
+    }
+
+    SECTION("Jumps backwards and forwards") {
+        for (int i = 0; i < 500; ++i)
+            requireMatches(((i * 7919) % 500) * 0.01 - 0.5);
+    }
+
+    manager.clearAll();
+}
+
+TEST_CASE("CompiledAutomation - Clip lanes loop and have no value in gaps", "[automation]") {
+    auto& manager = AutomationManager::getInstance();
+    manager.clearAll();
+
+    auto laneId = manager.createLane(makeVolumeTarget(2), AutomationLaneType::ClipBased);
+    auto other = manager.createClip(laneId, 4.0, 1.0);
+    manager.addPointToClip(other, 0.5, 0.7);
+    auto looped = manager.createClip(laneId, 0.5, 3.0);
+    manager.setClipLooping(looped, true);
+    manager.setClipLoopLength(looped, 1.0);
+    manager.addPointToClip(looped, 0.0, 0.0);
+    manager.addPointToClip(looped, 1.0, 1.0, AutomationCurveType::Bezier);
+
+    CompiledAutomation compiled;
+    const auto lane = compiled.addLane(manager, *manager.getLane(laneId));
+
+    CompiledAutomation::Cursor cursor;
+    for (double t = 0.0; t < 6.0; t += 0.013) {
+        double value = -1.0;
+        const bool inClip = (t >= 0.5 && t < 3.5) || (t >= 4.0 && t < 5.0);
+        REQUIRE(compiled.evaluate(lane, t, cursor, value) == inClip);
+        if (inClip)
+            REQUIRE(value == Catch::Approx(manager.getValueAtTime(laneId, t)).margin(1e-9));
+    }
+
+    SECTION("Lanes are evaluated independently") {
+        auto absoluteId = makeAbsoluteLane(manager);
+        const auto absolute = compiled.addLane(manager, *manager.getLane(absoluteId));
+        REQUIRE(compiled.getNumLanes() == 2);
+
+        CompiledAutomation::Cursor absoluteCursor;
+        double value = 0.0;
+        REQUIRE(compiled.evaluate(absolute, 1.5, absoluteCursor, value));
+        REQUIRE(value == Catch::Approx(manager.getValueAtTime(absoluteId, 1.5)).margin(1e-9));
+        REQUIRE(compiled.evaluate(lane, 4.5, cursor, value));
+        REQUIRE(value == Catch::Approx(0.7));
+    }
+
+    manager.clearAll();
+}
@@ -0,0 +1,75 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "../magda/daw/ui/components/common/curve/CurveGeometry.hpp"
+
+using namespace magda;
+
+namespace {
+
+std::vector<CurvePoint> makePoints(const std::vector<double>& xs) {
+    std::vector<CurvePoint> points;
+    uint32_t id = 1;
+    for (auto x : xs) {
+        CurvePoint point;
+        point.id = id++;
+        point.x = x;
+        points.push_back(point);
+    }
+    return points;
+}
+
+}  // namespace
+
+TEST_CASE("CurveGeometry - findRange", "[curve]") {
+    const auto points = makePoints({0.0, 1.0, 2.0, 2.0, 3.0, 5.0});
+
+    SECTION("Bounds are inclusive") {
+        CHECK(CurveGeometry::findRange(points, 1.0, 3.0) == std::pair<size_t, size_t>{1, 5});
+    }
+
+    SECTION("Points sharing an x are all found") {
+        CHECK(CurveGeometry::findRange(points, 2.0, 2.0) == std::pair<size_t, size_t>{2, 4});
+    }
+
+    SECTION("A gap between points is empty") {
+        const auto [begin, end] = CurveGeometry::findRange(points, 3.5, 4.5);
+        CHECK(begin == end);
+        CHECK(begin == 5);
+    }
+
+    SECTION("Ranges past either end are clamped") {
+        CHECK(CurveGeometry::findRange(points, -10.0, 10.0) == std::pair<size_t, size_t>{0, 6});
+        CHECK(CurveGeometry::findRange({}, 0.0, 1.0) == std::pair<size_t, size_t>{0, 0});
+    }
+}
+
+TEST_CASE("CurveGeometry - simplifyPolyline", "[curve]") {
+    SECTION("Collinear vertices are dropped, the ends kept") {
+        std::vector<juce::Point<float>> line;
+        for (int i = 0; i <= 100; ++i) {
+            line.push_back({static_cast<float>(i), static_cast<float>(i) * 0.5f});
+        }
+        CHECK(CurveGeometry::simplifyPolyline(line, 0.5f) == std::vector<size_t>{0, 100});
+    }
+
+    SECTION("Corners survive") {
+        const std::vector<juce::Point<float>> step{
+            {0.0f, 0.0f}, {5.0f, 0.0f}, {10.0f, 0.0f}, {10.0f, 10.0f}, {20.0f, 10.0f}};
+        CHECK(CurveGeometry::simplifyPolyline(step, 0.5f) == std::vector<size_t>{0, 2, 3, 4});
+    }
+
+    SECTION("Wobble under the tolerance is smoothed over") {
+        std::vector<juce::Point<float>> wobble;
+        for (int i = 0; i <= 50; ++i) {
+            wobble.push_back({static_cast<float>(i), (i % 2 == 0) ? 0.0f : 0.2f});
+        }
+        CHECK(CurveGeometry::simplifyPolyline(wobble, 0.5f) == std::vector<size_t>{0, 50});
+        CHECK(CurveGeometry::simplifyPolyline(wobble, 0.1f).size() == wobble.size());
+    }
+
+    SECTION("Short polylines come back whole") {
+        CHECK(CurveGeometry::simplifyPolyline({}, 0.5f).empty());
+        CHECK(CurveGeometry::simplifyPolyline({{0.0f, 0.0f}, {1.0f, 1.0f}}, 0.5f) ==
+              std::vector<size_t>{0, 1});
+    }
+}
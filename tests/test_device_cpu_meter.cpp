@@ -0,0 +1,213 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "../magda/daw/audio/DeviceCpuMeter.hpp"
+
+using namespace magda;
+
+namespace {
+
+DeviceInfo makeDevice(DeviceId id, const juce::String& name) {
+    DeviceInfo device;
+    device.id = id;
+    device.name = name;
+    return device;
+}
+
+// Track 1: [EQ (1)] [Rack (10): Chain A (20) = [Comp (2)], Chain B (21) = [Verb (3)]]
+TrackInfo makeTrack() {
+    TrackInfo track;
+    track.id = 1;
+    track.name = "Bass";
+    track.chainElements.push_back(makeDeviceElement(makeDevice(1, "EQ")));
+
+    RackInfo rack;
+    rack.id = 10;
+    rack.name = "FX Rack";
+    ChainInfo chainA;
+    chainA.id = 20;
+    chainA.elements.push_back(makeDeviceElement(makeDevice(2, "Comp")));
+    ChainInfo chainB;
+    chainB.id = 21;
+    chainB.elements.push_back(makeDeviceElement(makeDevice(3, "Verb")));
+    rack.chains.push_back(chainA);
+    rack.chains.push_back(chainB);
+    track.chainElements.push_back(makeRackElement(rack));
+    return track;
+}
+
+DeviceCpuMeter::Reading measured(double load) {
+    DeviceCpuMeter::Reading reading;
+    reading.load = load;
+    reading.peakLoad = load;
+    reading.measured = true;
+    return reading;
+}
+
+}  // namespace
+
+// =============================================================================
+// DeviceCpuMeter
+// =============================================================================
+
+TEST_CASE("DeviceCpuMeter reports time spent over audio time", "[devicecpu]") {
+    DeviceCpuMeter meter;
+    auto counters = meter.getCounters(5);
+
+    REQUIRE_FALSE(meter.getReading(5).measured);
+
+    // 1 ms of work for each of two 10 ms blocks
+    counters->add(1'000'000, 10'000'000);
+    counters->add(1'000'000, 10'000'000);
+    meter.update();
+
+    const auto reading = meter.getReading(5);
+    REQUIRE(reading.measured);
+    REQUIRE(reading.load == Catch::Approx(0.1));
+    REQUIRE(reading.peakLoad == Catch::Approx(0.1));
+}
+
+TEST_CASE("DeviceCpuMeter smooths later readings and holds the peak", "[devicecpu]") {
+    DeviceCpuMeter meter;
+    auto counters = meter.getCounters(5);
+
+    counters->add(1'000'000, 10'000'000);
+    meter.update();
+    counters->add(5'000'000, 10'000'000);
+    meter.update();
+
+    const auto reading = meter.getReading(5);
+    const double expected = 0.1 + DeviceCpuMeter::kSmoothing * (0.5 - 0.1);
+    REQUIRE(reading.load == Catch::Approx(expected));
+    REQUIRE(reading.peakLoad == Catch::Approx(0.5));
+
+    // Nothing rendered since: the reading stands
+    meter.update();
+    REQUIRE(meter.getReading(5).load == Catch::Approx(expected));
+}
+
+TEST_CASE("DeviceCpuMeter forgets removed devices", "[devicecpu]") {
+    DeviceCpuMeter meter;
+    auto counters = meter.getCounters(5);
+    counters->add(1'000'000, 10'000'000);
+    meter.update();
+
+    meter.remove(5);
+    REQUIRE_FALSE(meter.getReading(5).measured);
+
+    // The render path may still hold the old counters; charging them is harmless
+    counters->add(1'000'000, 10'000'000);
+    meter.update();
+    REQUIRE_FALSE(meter.getReading(5).measured);
+}
+
+TEST_CASE("DeviceCpuMeter ranks devices by their longest block since the update",
+          "[devicecpu]") {
+    DeviceCpuMeter meter;
+    auto steady = meter.getCounters(1);
+    auto spiky = meter.getCounters(2);
+    meter.getCounters(3);  // Not rendered
+
+    steady->add(2'000'000, 5'000'000);
+    steady->add(2'000'000, 5'000'000);
+    spiky->add(500'000, 5'000'000);
+    spiky->add(4'000'000, 5'000'000);
+    meter.update();
+
+    const auto slowest = meter.getSlowestBlocks(5);
+    REQUIRE(slowest.size() == 2);
+    REQUIRE(slowest[0].first == 2);
+    REQUIRE(slowest[0].second.blockPeakMs == Catch::Approx(4.0));
+    REQUIRE(slowest[1].first == 1);
+    REQUIRE(meter.getSlowestBlocks(1).size() == 1);
+
+    // The peak covers one update only
+    steady->add(1'000'000, 5'000'000);
+    meter.update();
+    REQUIRE(meter.getReading(1).blockPeakMs == Catch::Approx(1.0));
+    REQUIRE(meter.getReading(2).blockPeakMs == 0.0);
+    REQUIRE(meter.getSlowestBlocks(5).size() == 1);
+}
+
+// =============================================================================
+// ChainCpuUsage
+// =============================================================================
+
+TEST_CASE("ChainCpuUsage sums devices up the chain tree", "[devicecpu]") {
+    const auto track = makeTrack();
+    const auto usage = ChainCpuUsage::build(track, [](DeviceId id) {
+        switch (id) {
+            case 1:
+                return measured(0.05);
+            case 2:
+                return measured(0.10);
+            case 3:
+                return measured(0.20);
+            default:
+                return DeviceCpuMeter::Reading();
+        }
+    });
+
+    REQUIRE(usage.getTrackUsage().load == Catch::Approx(0.35));
+    REQUIRE(usage.getTrackUsage().devices == 3);
+    REQUIRE(usage.getTrackUsage().measuredDevices == 3);
+
+    const auto rackPath = ChainNodePath::rack(1, 10);
+    const auto* rack = usage.find(rackPath);
+    REQUIRE(rack != nullptr);
+    REQUIRE(rack->type == ChainNodeType::Rack);
+    REQUIRE(rack->usage.load == Catch::Approx(0.30));
+
+    const auto* chainB = usage.find(rackPath.withChain(21));
+    REQUIRE(chainB != nullptr);
+    REQUIRE(chainB->usage.load == Catch::Approx(0.20));
+
+    const auto* verb = usage.find(rackPath.withChain(21).withDevice(3));
+    REQUIRE(verb != nullptr);
+    REQUIRE(verb->name == "Verb");
+
+    const auto* eq = usage.find(ChainNodePath::topLevelDevice(1, 1));
+    REQUIRE(eq != nullptr);
+    REQUIRE(eq->type == ChainNodeType::TopLevelDevice);
+
+    // Parents come before their children
+    REQUIRE(usage.getNodes().size() == 6);
+    REQUIRE(usage.getNodes()[1].path == rackPath);
+    REQUIRE(usage.getNodes()[2].path == rackPath.withChain(20));
+}
+
+TEST_CASE("ChainCpuUsage leaves unmeasured devices out of the totals", "[devicecpu]") {
+    const auto track = makeTrack();
+    const auto usage = ChainCpuUsage::build(track, [](DeviceId id) {
+        return id == 1 ? measured(0.05) : DeviceCpuMeter::Reading();
+    });
+
+    REQUIRE(usage.getTrackUsage().load == Catch::Approx(0.05));
+    REQUIRE(usage.getTrackUsage().measuredDevices == 1);
+
+    const auto* rack = usage.find(ChainNodePath::rack(1, 10));
+    REQUIRE(rack != nullptr);
+    REQUIRE(rack->usage.devices == 2);
+    REQUIRE_FALSE(rack->usage.isMeasured());
+}
+
+TEST_CASE("ChainCpuUsage lists measured devices by load", "[devicecpu]") {
+    const auto track = makeTrack();
+    const auto usage = ChainCpuUsage::build(track, [](DeviceId id) {
+        switch (id) {
+            case 1:
+                return measured(0.05);
+            case 3:
+                return measured(0.20);
+            default:
+                return DeviceCpuMeter::Reading();
+        }
+    });
+
+    const auto hotspots = usage.getHotspots(5);
+    REQUIRE(hotspots.size() == 2);
+    REQUIRE(hotspots[0].name == "Verb");
+    REQUIRE(hotspots[1].name == "EQ");
+
+    REQUIRE(usage.getHotspots(1).size() == 1);
+}
@@ -0,0 +1,128 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "../magda/daw/audio/DeviceProcessor.hpp"
+
+using namespace magda;
+
+namespace {
+
+// Records what a sync pushes instead of writing to a plugin
+class RecordingProcessor : public DeviceProcessor {
+  public:
+    explicit RecordingProcessor(int numParams) : DeviceProcessor(1, nullptr) {
+        for (int i = 0; i < numParams; ++i) {
+            names_.push_back("Param " + juce::String(i));
+        }
+    }
+
+    std::vector<juce::String> getParameterNames() const override {
+        return names_;
+    }
+
+    // The plugin reports a value of its own (native UI), as ExternalPluginProcessor does
+    void reportFromPlugin(int index, float value) {
+        noteParameterValue(index, value);
+    }
+
+    std::vector<std::pair<int, float>> applied;
+
+  protected:
+    void applyParameter(int index, const juce::String&, float value) override {
+        applied.emplace_back(index, value);
+    }
+
+  private:
+    std::vector<juce::String> names_;
+};
+
+DeviceInfo makeDevice(int numParams) {
+    DeviceInfo device;
+    for (int i = 0; i < numParams; ++i) {
+        ParameterInfo param;
+        param.paramIndex = i;
+        param.currentValue = 0.1f * float(i);
+        device.parameters.push_back(param);
+    }
+    return device;
+}
+
+}  // namespace
+
+// ============================================================================
+// Sparse sync
+// ============================================================================
+
+TEST_CASE("DeviceProcessor - first sync pushes every parameter", "[device][sync]") {
+    RecordingProcessor processor(4);
+    processor.syncFromDeviceInfo(makeDevice(4));
+    REQUIRE(processor.applied.size() == 4);
+}
+
+TEST_CASE("DeviceProcessor - later syncs push only changed parameters", "[device][sync]") {
+    RecordingProcessor processor(4);
+    auto device = makeDevice(4);
+    processor.syncFromDeviceInfo(device);
+    processor.applied.clear();
+
+    SECTION("A bypass toggle pushes no parameters") {
+        device.bypassed = true;
+        processor.syncFromDeviceInfo(device);
+        REQUIRE(processor.applied.empty());
+    }
+
+    SECTION("One edited value is the only one pushed") {
+        device.parameters[2].currentValue = 0.9f;
+        processor.syncFromDeviceInfo(device);
+        REQUIRE(processor.applied == std::vector<std::pair<int, float>>{{2, 0.9f}});
+    }
+
+    SECTION("Invalidating pushes everything again") {
+        processor.invalidateAppliedParameters();
+        processor.syncFromDeviceInfo(device);
+        REQUIRE(processor.applied.size() == 4);
+    }
+}
+
+TEST_CASE("DeviceProcessor - values the plugin reported are not pushed back", "[device][sync]") {
+    RecordingProcessor processor(2);
+    auto device = makeDevice(2);
+    processor.syncFromDeviceInfo(device);
+    processor.applied.clear();
+
+    // The model follows the plugin, then something else triggers a sync
+    processor.reportFromPlugin(1, 0.7f);
+    device.parameters[1].currentValue = 0.7f;
+    processor.syncFromDeviceInfo(device);
+    REQUIRE(processor.applied.empty());
+}
+
+// ============================================================================
+// State snapshots
+// ============================================================================
+
+TEST_CASE("DeviceStateSnapshot - recalling pushes only the parameters that differ",
+          "[device][sync]") {
+    RecordingProcessor processor(4);
+    auto device = makeDevice(4);
+    processor.syncFromDeviceInfo(device);
+    processor.applied.clear();
+
+    DeviceStateSnapshot snapshot;
+    snapshot.parameterValues = {0.0f, 0.5f, 0.2f, 0.8f};
+
+    REQUIRE(snapshot.applyParameters(device.parameters) == 2);
+    processor.syncFromDeviceInfo(device);
+    REQUIRE(processor.applied == std::vector<std::pair<int, float>>{{1, 0.5f}, {3, 0.8f}});
+
+    // Recalled again: already there
+    REQUIRE(snapshot.applyParameters(device.parameters) == 0);
+}
+
+TEST_CASE("DeviceStateSnapshot - a different parameter list sets nothing", "[device][sync]") {
+    auto device = makeDevice(3);
+    DeviceStateSnapshot snapshot;
+    snapshot.parameterValues = {1.0f, 1.0f};
+
+    REQUIRE(snapshot.applyParameters(device.parameters) == -1);
+    REQUIRE(device.parameters[0].currentValue == 0.0f);
+}
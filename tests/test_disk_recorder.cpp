@@ -0,0 +1,151 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "../magda/daw/audio/DiskRecorder.hpp"
+#include "ScopedDirectory.hpp"
+
+using namespace magda;
+using Catch::Approx;
+
+namespace {
+
+DiskRecorder::Options smallOptions() {
+    DiskRecorder::Options options;
+    options.sampleRate = 48000.0;
+    options.chunkFrames = 256;
+    options.bufferSeconds = 0.0;  // The two-chunk minimum: 512 frames
+    return options;
+}
+
+/**
+ * @brief Device input with each channel held at a constant level
+ */
+struct InputBlock {
+    juce::AudioBuffer<float> buffer;
+
+    InputBlock(std::initializer_list<float> levels, int numSamples)
+        : buffer(static_cast<int>(levels.size()), numSamples) {
+        int channel = 0;
+        for (float level : levels) {
+            juce::FloatVectorOperations::fill(buffer.getWritePointer(channel++), level,
+                                              numSamples);
+        }
+    }
+
+    int process(DiskRecorder& recorder, double position) {
+        return recorder.process(buffer.getArrayOfReadPointers(), buffer.getNumChannels(),
+                                buffer.getNumSamples(), position);
+    }
+};
+
+std::unique_ptr<juce::AudioFormatReader> openTake(const juce::File& file) {
+    juce::WavAudioFormat wav;
+    return std::unique_ptr<juce::AudioFormatReader>(
+        wav.createReaderFor(new juce::FileInputStream(file), true));
+}
+
+}  // namespace
+
+// ============================================================================
+// DiskRecorder Tests
+// ============================================================================
+
+TEST_CASE("DiskRecorder - Writes each input's channels to its own file", "[recorder]") {
+    ScopedDirectory temp("magda_recorder_test");
+    DiskRecorder recorder;
+    const auto mono = temp.directory.getChildFile("mono.wav");
+    const auto stereo = temp.directory.getChildFile("stereo.wav");
+    REQUIRE(recorder.start({{1, {0}, mono}, {2, {2, 1}, stereo}}, smallOptions()));
+    REQUIRE(recorder.isRecording());
+
+    InputBlock block({0.25f, 0.5f, -0.5f}, 100);
+    for (int i = 0; i < 10; ++i) {
+        REQUIRE(block.process(recorder, 2.0 + i * 100 / 48000.0) == 0);
+    }
+
+    const auto takes = recorder.stop();
+    REQUIRE_FALSE(recorder.isRecording());
+    REQUIRE(takes.size() == 2);
+    REQUIRE(takes[0].trackId == 1);
+    REQUIRE(takes[0].startSeconds == Approx(2.0));
+    REQUIRE(takes[0].numFrames == 1000);
+    REQUIRE(takes[1].droppedFrames == 0);
+
+    auto monoReader = openTake(mono);
+    REQUIRE(monoReader != nullptr);
+    REQUIRE(monoReader->numChannels == 1);
+    REQUIRE(monoReader->lengthInSamples == 1000);
+
+    auto stereoReader = openTake(stereo);
+    REQUIRE(stereoReader != nullptr);
+    REQUIRE(stereoReader->numChannels == 2);
+    juce::AudioBuffer<float> read(2, 1000);
+    stereoReader->read(&read, 0, 1000, 0, true, true);
+    REQUIRE(read.getSample(0, 999) == Approx(-0.5f));
+    REQUIRE(read.getSample(1, 0) == Approx(0.5f));
+}
+
+TEST_CASE("DiskRecorder - A full ring drops the block and keeps the take in time",
+          "[recorder]") {
+    ScopedDirectory temp("magda_recorder_test");
+    DiskRecorder recorder;
+    const auto file = temp.directory.getChildFile("take.wav");
+    REQUIRE(recorder.start({{1, {0}, file}}, smallOptions()));
+
+    InputBlock small({1.0f}, 64);
+    InputBlock tooLarge({1.0f}, 1024);  // More than the whole ring
+    REQUIRE(small.process(recorder, 0.0) == 0);
+    REQUIRE(tooLarge.process(recorder, 0.0) == 1024);
+    REQUIRE(small.process(recorder, 0.0) == 0);
+
+    const auto stats = recorder.getStats();
+    REQUIRE(stats.dropouts == 1);
+    REQUIRE(stats.droppedFrames == 1024);
+    REQUIRE(stats.peakBufferFill > 0.0f);
+    REQUIRE(stats.peakBufferFill <= 1.0f);
+
+    const auto takes = recorder.stop();
+    REQUIRE(takes.size() == 1);
+    REQUIRE(takes[0].numFrames == 64 + 1024 + 64);
+    REQUIRE(takes[0].droppedFrames == 1024);
+
+    auto reader = openTake(file);
+    REQUIRE(reader != nullptr);
+    juce::AudioBuffer<float> read(1, 64 + 1024 + 64);
+    reader->read(&read, 0, read.getNumSamples(), 0, true, false);
+    REQUIRE(read.getSample(0, 63) == Approx(1.0f));
+    REQUIRE(read.getSample(0, 64) == Approx(0.0f));
+    REQUIRE(read.getSample(0, 64 + 1023) == Approx(0.0f));
+    REQUIRE(read.getSample(0, 64 + 1024) == Approx(1.0f));
+}
+
+TEST_CASE("DiskRecorder - Missing device channels record silence", "[recorder]") {
+    ScopedDirectory temp("magda_recorder_test");
+    DiskRecorder recorder;
+    const auto file = temp.directory.getChildFile("take.wav");
+    REQUIRE(recorder.start({{1, {5}, file}}, smallOptions()));
+
+    InputBlock block({1.0f}, 128);
+    block.process(recorder, 0.0);
+    REQUIRE(recorder.stop().size() == 1);
+
+    auto reader = openTake(file);
+    REQUIRE(reader != nullptr);
+    juce::AudioBuffer<float> read(1, 128);
+    reader->read(&read, 0, 128, 0, true, false);
+    REQUIRE(read.getMagnitude(0, 0, 128) == 0.0f);
+}
+
+TEST_CASE("DiskRecorder - Nothing captured leaves no files", "[recorder]") {
+    ScopedDirectory temp("magda_recorder_test");
+    DiskRecorder recorder;
+    const auto file = temp.directory.getChildFile("take.wav");
+
+    REQUIRE_FALSE(recorder.start({{1, {}, file}}, smallOptions()));
+    REQUIRE(recorder.start({{1, {0}, file}}, smallOptions()));
+    REQUIRE_FALSE(recorder.start({{2, {0}, file}}, smallOptions()));
+    REQUIRE(file.existsAsFile());
+
+    REQUIRE(recorder.stop().empty());
+    REQUIRE_FALSE(file.existsAsFile());
+}
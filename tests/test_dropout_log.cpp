@@ -0,0 +1,108 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "../magda/daw/profiling/DropoutLog.hpp"
+
+using namespace magda;
+
+namespace {
+
+DropoutLog& freshLog() {
+    auto& log = DropoutLog::getInstance();
+    log.setLogFile(juce::File());  // Keep the tests out of the user's log
+    log.collect(nullptr);
+    log.clear();
+    return log;
+}
+
+DropoutLog::Event makeEvent(float callbackMs, int deviceXruns = 0) {
+    DropoutLog::Event event;
+    event.wallTimeMs = juce::Time(2026, 0, 2, 12, 30, 15, 42).toMilliseconds();
+    event.numSamples = 256;
+    event.sampleRate = 48000.0;
+    event.callbackMs = callbackMs;
+    event.budgetMs = 5.33f;
+    event.intervalMs = 5.33f;
+    event.stage = "Modulation";
+    event.deviceXruns = deviceXruns;
+    event.positionSeconds = 12.5;
+    event.bpm = 120.0;
+    event.playing = true;
+    return event;
+}
+
+}  // namespace
+
+// ============================================================================
+// DropoutLog Tests
+// ============================================================================
+
+TEST_CASE("DropoutLog - Collected events carry the hotspots of their window", "[dropout]") {
+    auto& log = freshLog();
+    log.push(makeEvent(7.9f));
+    log.push(makeEvent(2.0f, 2));
+
+    int asked = 0;
+    const int collected = log.collect([&asked]() {
+        ++asked;
+        std::vector<DropoutLog::Hotspot> hotspots;
+        for (int i = 0; i < 5; ++i) {
+            hotspots.push_back({"Synth " + juce::String(i), "Bass", 4.0 - i});
+        }
+        return hotspots;
+    });
+
+    REQUIRE(collected == 2);
+    REQUIRE(asked == 1);
+    const auto records = log.getRecords();
+    REQUIRE(records.size() == 2);
+    REQUIRE(records[0].event.callbackMs == 7.9f);
+    REQUIRE(records[1].event.deviceXruns == 2);
+    REQUIRE(records[0].hotspots.size() == DropoutLog::kMaxHotspots);
+    REQUIRE(records[0].hotspots.front().device == "Synth 0");
+    REQUIRE(log.getTotalCount() == 2);
+
+    // Nothing new: the source isn't asked
+    REQUIRE(log.collect([&asked]() {
+        ++asked;
+        return std::vector<DropoutLog::Hotspot>();
+    }) == 0);
+    REQUIRE(asked == 1);
+}
+
+TEST_CASE("DropoutLog - Records describe the dropout and its devices", "[dropout]") {
+    DropoutLog::Record record;
+    record.event = makeEvent(7.9f);
+    record.hotspots.push_back({"Serum", "Bass", 4.25});
+
+    const auto text = DropoutLog::formatRecord(record);
+    REQUIRE(text.startsWith("2026-01-02 12:30:15.042"));
+    REQUIRE(text.contains("Overrun: callback 7.90 ms of 5.33 ms (Modulation)"));
+    REQUIRE(text.contains("256 samples at 48000 Hz, playing at 12.500 s (beat 25.00)"));
+    REQUIRE(text.contains("\n    Serum on Bass: 4.25 ms\n"));
+
+    record.event.deviceXruns = 3;
+    REQUIRE(DropoutLog::formatRecord(record).contains("Device xrun x3"));
+}
+
+TEST_CASE("DropoutLog - Keeps the newest records and counts a full ring", "[dropout]") {
+    auto& log = freshLog();
+    const auto droppedBefore = log.getDroppedCount();
+
+    // The ring holds one less than its size
+    for (size_t i = 0; i < DropoutLog::kRingSize; ++i) {
+        log.push(makeEvent(static_cast<float>(i)));
+    }
+    REQUIRE(log.getDroppedCount() == droppedBefore + 1);
+    REQUIRE(log.collect(nullptr) == static_cast<int>(DropoutLog::kRingSize - 1));
+
+    for (size_t i = 0; i < DropoutLog::kMaxRecords; ++i) {
+        log.push(makeEvent(100.0f + static_cast<float>(i)));
+        log.collect(nullptr);
+    }
+    const auto records = log.getRecords();
+    REQUIRE(records.size() == DropoutLog::kMaxRecords);
+    REQUIRE(records.front().event.callbackMs == 100.0f);
+    REQUIRE(log.getTotalCount() ==
+            static_cast<int>(DropoutLog::kRingSize - 1 + DropoutLog::kMaxRecords));
+    REQUIRE(log.generateSummary(1).contains("newest first"));
+}
@@ -0,0 +1,91 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <vector>
+
+#include "../magda/daw/audio/FadeCurveCache.hpp"
+
+using namespace magda;
+using Catch::Approx;
+
+namespace {
+
+AudioFade fade(FadeCurve curve, float tension = 0.0f) {
+    AudioFade f;
+    f.length = 1.0;
+    f.curve = curve;
+    f.tension = tension;
+    return f;
+}
+
+}  // namespace
+
+TEST_CASE("FadeCurveCache - Curve shapes", "[fades]") {
+    SECTION("Every curve runs from 0 to 1") {
+        for (auto curve : {FadeCurve::Linear, FadeCurve::EqualPower, FadeCurve::SCurve}) {
+            REQUIRE(FadeCurveCache::getGain(curve, 0.0f, 0.0f) == Approx(0.0f));
+            REQUIRE(FadeCurveCache::getGain(curve, 0.0f, 1.0f) == Approx(1.0f));
+        }
+    }
+
+    SECTION("Midpoints") {
+        REQUIRE(FadeCurveCache::getGain(FadeCurve::Linear, 0.0f, 0.5f) == Approx(0.5f));
+        REQUIRE(FadeCurveCache::getGain(FadeCurve::EqualPower, 0.0f, 0.5f) ==
+                Approx(std::sqrt(0.5f)));
+        REQUIRE(FadeCurveCache::getGain(FadeCurve::SCurve, 0.0f, 0.5f) == Approx(0.5f));
+        REQUIRE(FadeCurveCache::getGain(FadeCurve::SCurve, 0.0f, 0.25f) <
+                FadeCurveCache::getGain(FadeCurve::Linear, 0.0f, 0.25f));
+    }
+
+    SECTION("Tension bends the curve early or late") {
+        REQUIRE(FadeCurveCache::getGain(FadeCurve::Linear, 1.0f, 0.0625f) == Approx(0.5f));
+        REQUIRE(FadeCurveCache::getGain(FadeCurve::Linear, -1.0f, 0.5f) == Approx(0.0625f));
+    }
+}
+
+TEST_CASE("FadeCurveCache - Tables", "[fades]") {
+    auto& cache = FadeCurveCache::getInstance();
+
+    SECTION("Rising and falling tables hold a gain per frame") {
+        const auto rising = cache.getTable(fade(FadeCurve::Linear), 4, true);
+        const auto falling = cache.getTable(fade(FadeCurve::Linear), 4, false);
+        REQUIRE(*rising == std::vector<float>{0.0f, 0.25f, 0.5f, 0.75f});
+        REQUIRE(*falling == std::vector<float>{1.0f, 0.75f, 0.5f, 0.25f});
+    }
+
+    SECTION("An equal-power crossfade keeps constant power") {
+        const auto rising = cache.getTable(fade(FadeCurve::EqualPower), 256, true);
+        const auto falling = cache.getTable(fade(FadeCurve::EqualPower), 256, false);
+        for (size_t i = 0; i < rising->size(); ++i) {
+            const float power = (*rising)[i] * (*rising)[i] + (*falling)[i] * (*falling)[i];
+            REQUIRE(power == Approx(1.0f));
+        }
+    }
+
+    SECTION("An empty fade has no table") {
+        REQUIRE(cache.getTable(fade(FadeCurve::Linear), 0, true) == nullptr);
+    }
+}
+
+TEST_CASE("FadeCurveCache - Identical fades share a table", "[fades]") {
+    auto& cache = FadeCurveCache::getInstance();
+    const int before = cache.getNumTables();
+
+    auto a = cache.getTable(fade(FadeCurve::SCurve, 0.5f), 48000, true);
+    auto b = cache.getTable(fade(FadeCurve::SCurve, 0.5f), 48000, true);
+    auto shorter = cache.getTable(fade(FadeCurve::SCurve, 0.5f), 24000, true);
+    auto falling = cache.getTable(fade(FadeCurve::SCurve, 0.5f), 48000, false);
+
+    REQUIRE(a == b);
+    REQUIRE(a != shorter);
+    REQUIRE(a != falling);
+    REQUIRE(cache.getNumTables() == before + 3);
+
+    // Kept only while something holds them
+    a.reset();
+    b.reset();
+    shorter.reset();
+    falling.reset();
+    REQUIRE(cache.getNumTables() == before);
+}
@@ -0,0 +1,136 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "../magda/daw/ui/components/common/GridLines.hpp"
+
+using namespace magda;
+using Catch::Approx;
+
+namespace {
+
+GridLines::Key beatKey(double interval, double pixelsPerSecond) {
+    GridLines::Key key;
+    key.interval = interval;
+    key.pixelsPerUnit = pixelsPerSecond;
+    key.left = 0;
+    key.right = 1000;
+    key.length = 300.0;
+    return key;
+}
+
+}  // namespace
+
+// ============================================================================
+// GridLines Tests
+// ============================================================================
+
+TEST_CASE("GridLines - Beat grid classifies bars, beats and subdivisions", "[gridlines]") {
+    TempoMap tempo(120.0);
+    GridLines grid;
+
+    // 100 px per second at 120 bpm: a beat every 50 px, a line every 25 px
+    const auto& lines = grid.get(beatKey(0.5, 100.0), &tempo);
+
+    REQUIRE(lines.size() == 41);
+    REQUIRE(lines[0].level == GridLines::Level::Major);
+    REQUIRE(lines[0].bar == 1);
+    REQUIRE(lines[1].level == GridLines::Level::Minor);
+    REQUIRE(lines[2].level == GridLines::Level::Beat);
+    REQUIRE(lines[2].x == 50);
+    REQUIRE(lines[8].level == GridLines::Level::Major);
+    REQUIRE(lines[8].bar == 2);
+    REQUIRE(lines[8].position == Approx(2.0));
+}
+
+TEST_CASE("GridLines - Lines are reused until the key or tempo changes", "[gridlines]") {
+    TempoMap tempo(120.0);
+    GridLines grid;
+    auto key = beatKey(1.0, 100.0);
+
+    grid.get(key, &tempo);
+    grid.get(key, &tempo);
+    REQUIRE(grid.getComputeCount() == 1);
+
+    tempo.setTempo(120.0);
+    grid.get(key, &tempo);
+    REQUIRE(grid.getComputeCount() == 1);
+
+    key.originX = -40;
+    grid.get(key, &tempo);
+    REQUIRE(grid.getComputeCount() == 2);
+
+    tempo.setTempo(90.0);
+    grid.get(key, &tempo);
+    REQUIRE(grid.getComputeCount() == 3);
+}
+
+TEST_CASE("GridLines - Scrolling keeps only the visible columns", "[gridlines]") {
+    TempoMap tempo(120.0);
+    GridLines grid;
+    auto key = beatKey(1.0, 100.0);
+    key.originX = -1010;  // Scrolled just past beat 20
+
+    const auto& lines = grid.get(key, &tempo);
+
+    REQUIRE(!lines.empty());
+    REQUIRE(lines.front().position == Approx(10.5));
+    REQUIRE(lines.front().x == 40);
+    for (const auto& line : lines) {
+        REQUIRE(line.x >= key.left);
+        REQUIRE(line.x <= key.right);
+    }
+}
+
+TEST_CASE("GridLines - Beat lines follow tempo changes", "[gridlines]") {
+    TempoMap tempo;
+    tempo.setTempoChanges({{0.0, 120.0}, {4.0, 60.0}});
+    GridLines grid;
+
+    const auto& lines = grid.get(beatKey(1.0, 100.0), &tempo);
+
+    // Half-second beats for the first bar, then a second each
+    REQUIRE(lines[4].x == 200);
+    REQUIRE(lines[5].x == 300);
+    REQUIRE(lines[5].level == GridLines::Level::Beat);
+}
+
+TEST_CASE("GridLines - Seconds grid marks majors by index", "[gridlines]") {
+    GridLines grid;
+    GridLines::Key key;
+    key.spacing = GridLines::Spacing::Seconds;
+    key.interval = 0.1;
+    key.majorInterval = 1.0;
+    key.pixelsPerUnit = 500.0;
+    key.right = 1000;
+    key.length = 300.0;
+
+    const auto& lines = grid.get(key, nullptr);
+
+    REQUIRE(lines.size() == 21);
+    int majors = 0;
+    for (const auto& line : lines) {
+        majors += line.level == GridLines::Level::Major ? 1 : 0;
+    }
+    REQUIRE(majors == 3);
+    REQUIRE(lines[10].level == GridLines::Level::Major);
+}
+
+TEST_CASE("GridLines - Beats axis stops at the length and finds visible lines", "[gridlines]") {
+    GridLines grid;
+    GridLines::Key key;
+    key.axis = GridLines::Axis::Beats;
+    key.interval = 0.25;
+    key.pixelsPerUnit = 40.0;
+    key.right = 100000;
+    key.length = 16.0;
+
+    const auto& lines = grid.get(key, nullptr);
+
+    REQUIRE(lines.size() == 65);
+    REQUIRE(lines.back().position == Approx(16.0));
+    REQUIRE(lines[16].bar == 2);
+
+    const auto [begin, end] = grid.findVisible(100, 200);
+    REQUIRE(lines[begin].x == 100);
+    REQUIRE(end - begin == 11);
+}
@@ -0,0 +1,87 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "../magda/daw/audio/GroupRenderPlan.hpp"
+
+using namespace magda;
+using Catch::Approx;
+
+namespace {
+
+// Strings group (1) over violins (2) and cellos (3); brass group (4) over horns (5),
+// which also sends to a reverb aux (6); a lone piano (7)
+std::vector<GroupRenderPlan::Track> makeOrchestra() {
+    return {{1, {}, 0.05}, {2, {1}, 0.30}, {3, {1}, 0.20}, {4, {}, 0.05},
+            {5, {4, 6}, 0.10}, {6, {}, 0.20}, {7, {}, 0.15}};
+}
+
+}  // namespace
+
+TEST_CASE("GroupRenderPlan renders inputs before what they feed", "[render]") {
+    const auto plan = GroupRenderPlan::build(makeOrchestra());
+    const auto& nodes = plan.getNodes();
+    REQUIRE(nodes.size() == 7);
+    REQUIRE(plan.getNumCyclicNodes() == 0);
+
+    for (size_t p = 0; p < nodes.size(); ++p) {
+        for (int in : nodes[p].inputs) {
+            REQUIRE(static_cast<size_t>(in) < p);
+        }
+    }
+
+    // Violins lead the longest chain, so they go first
+    REQUIRE(nodes.front().id == 2);
+    const auto& horns = nodes[static_cast<size_t>(plan.find(5))];
+    REQUIRE(horns.outputs.size() == 2);
+    REQUIRE(horns.rank == Approx(0.30));
+    REQUIRE(plan.find(42) == -1);
+}
+
+TEST_CASE("GroupRenderPlan finds the critical path and the useful thread count", "[render]") {
+    const auto plan = GroupRenderPlan::build(makeOrchestra());
+
+    REQUIRE(plan.getTotalCost() == Approx(1.05));
+    REQUIRE(plan.getCriticalPathCost() == Approx(0.35));
+    REQUIRE(plan.getCriticalPath() == std::vector<TrackId>{2, 1});
+    REQUIRE(plan.getParallelism() == Approx(1.05 / 0.35));
+
+    REQUIRE(plan.estimateMakespan(1) == Approx(1.05));
+    REQUIRE(plan.estimateMakespan(16) == Approx(0.35));
+    REQUIRE(plan.estimateMakespan(4) < plan.estimateMakespan(2));
+
+    // Past a few threads everything waits on the violins and their group
+    const int useful = plan.getUsefulThreads(16);
+    REQUIRE(useful > 1);
+    REQUIRE(useful < 16);
+    REQUIRE(plan.estimateMakespan(useful) <= 0.35 * 1.05);
+}
+
+TEST_CASE("GroupRenderPlan serialises a long chain", "[render]") {
+    // Nested groups, each holding the next
+    const auto plan = GroupRenderPlan::build({{1, {}, 0.1}, {2, {1}, 0.1}, {3, {2}, 0.1}});
+
+    REQUIRE(plan.getCriticalPath() == std::vector<TrackId>{3, 2, 1});
+    REQUIRE(plan.getParallelism() == Approx(1.0));
+    REQUIRE(plan.getUsefulThreads(8) == 1);
+    REQUIRE(plan.getNodes()[2].earliestStart == Approx(0.2));
+}
+
+TEST_CASE("GroupRenderPlan places tracks caught in a loop last", "[render]") {
+    const auto plan =
+        GroupRenderPlan::build({{1, {2}, 0.1}, {2, {1}, 0.1}, {3, {}, 0.1}, {4, {4, 9}, 0.1}});
+
+    REQUIRE(plan.getNumCyclicNodes() == 2);
+    REQUIRE(plan.getNodes().size() == 4);
+    REQUIRE(plan.getNodes()[2].id == 1);
+    REQUIRE(plan.getNodes()[3].id == 2);
+    // Feeding itself or an unknown track goes to the master
+    REQUIRE(plan.getNodes()[static_cast<size_t>(plan.find(4))].outputs.empty());
+}
+
+TEST_CASE("GroupRenderPlan costs unmeasured devices", "[render]") {
+    REQUIRE(GroupRenderPlan::estimateTrackCost(0.0, 0, 0) ==
+            Approx(GroupRenderPlan::kTrackBaseLoad));
+    REQUIRE(GroupRenderPlan::estimateTrackCost(0.2, 3, 1) ==
+            Approx(GroupRenderPlan::kTrackBaseLoad + 0.2 +
+                   2 * GroupRenderPlan::kUnmeasuredDeviceLoad));
+}
@@ -0,0 +1,84 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <memory>
+#include <vector>
+
+#include "../magda/daw/audio/IdSlotMap.hpp"
+#include "../magda/daw/core/TypeIds.hpp"
+
+using namespace magda;
+
+// ============================================================================
+// IdSlotMap Tests
+// ============================================================================
+
+TEST_CASE("IdSlotMap - Assign, find and erase", "[idslotmap]") {
+    IdSlotMap<TrackId, int> map;
+
+    REQUIRE(map.empty());
+    REQUIRE(map.find(0) == nullptr);
+
+    REQUIRE(map.assign(3, 30) != nullptr);
+    REQUIRE(map.assign(0, 10) != nullptr);
+    REQUIRE(map.size() == 2);
+    REQUIRE(map.getCapacity() == 4);
+
+    REQUIRE(map.contains(3));
+    REQUIRE_FALSE(map.contains(1));
+    REQUIRE(*map.find(3) == 30);
+
+    SECTION("Assign replaces an existing value") {
+        map.assign(3, 31);
+        REQUIRE(map.size() == 2);
+        REQUIRE(*map.find(3) == 31);
+    }
+
+    SECTION("Erase leaves the other values in place") {
+        REQUIRE(map.erase(3));
+        REQUIRE_FALSE(map.erase(3));
+        REQUIRE(map.find(3) == nullptr);
+        REQUIRE(map.size() == 1);
+        REQUIRE(*map.find(0) == 10);
+    }
+
+    SECTION("Out-of-range and negative IDs are never stored") {
+        REQUIRE(map.find(100) == nullptr);
+        REQUIRE(map.find(INVALID_TRACK_ID) == nullptr);
+        REQUIRE(map.assign(INVALID_TRACK_ID, 1) == nullptr);
+        REQUIRE(map.size() == 2);
+    }
+}
+
+TEST_CASE("IdSlotMap - Iterates in ascending ID order", "[idslotmap]") {
+    IdSlotMap<DeviceId, int> map;
+    map.assign(7, 70);
+    map.assign(2, 20);
+    map.assign(5, 50);
+    map.erase(5);
+
+    std::vector<DeviceId> ids;
+    map.forEach([&ids](DeviceId id, int value) {
+        REQUIRE(value == id * 10);
+        ids.push_back(id);
+    });
+
+    const std::vector<DeviceId> expected{2, 7};
+    REQUIRE(ids == expected);
+}
+
+TEST_CASE("IdSlotMap - Erase destroys move-only values", "[idslotmap]") {
+    IdSlotMap<DeviceId, std::unique_ptr<int>> map;
+    auto value = std::make_unique<int>(42);
+    auto* raw = value.get();
+
+    map.assign(1, std::move(value));
+    REQUIRE(map.find(1)->get() == raw);
+
+    map.erase(1);
+    REQUIRE(map.find(1) == nullptr);
+
+    map.assign(1, std::make_unique<int>(7));
+    map.clear();
+    REQUIRE(map.empty());
+    REQUIRE(map.getCapacity() == 0);
+}
@@ -0,0 +1,76 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "../magda/daw/profiling/InteractionReplay.hpp"
+
+using namespace magda;
+using Catch::Approx;
+using Action = InteractionReplay::Action;
+
+// ============================================================================
+// InteractionReplay Script Tests
+// ============================================================================
+
+TEST_CASE("InteractionReplay - Default script covers every interaction", "[profiling][ui]") {
+    const auto script = InteractionReplay::getDefaultScript();
+
+    std::vector<Action> actions;
+    for (const auto& step : script) {
+        actions.push_back(step.action);
+        REQUIRE(step.frames > 0);
+    }
+    REQUIRE(actions ==
+            std::vector<Action>{Action::Scroll, Action::Zoom, Action::Drag, Action::Mixer,
+                                Action::Macro});
+
+    // Fifty clips dragged in turn
+    REQUIRE(script[2].amount == Approx(50.0));
+}
+
+TEST_CASE("InteractionReplay - Parses scripts", "[profiling][ui]") {
+    SECTION("Missing fields take the defaults") {
+        const auto script = InteractionReplay::parseScript(
+            R"([{"action": "zoom"}, {"action": "Scroll", "name": "fast scroll", "frames": 30,
+                 "amount": 1.5}])");
+        REQUIRE(script.has_value());
+        REQUIRE(script->size() == 2);
+
+        const auto& zoom = (*script)[0];
+        REQUIRE(zoom.action == Action::Zoom);
+        REQUIRE(zoom.frames == 60);
+        REQUIRE(zoom.amount == Approx(InteractionReplay::getDefaultAmount(Action::Zoom)));
+        REQUIRE(zoom.getPhaseName() == "zoom");
+
+        const auto& scroll = (*script)[1];
+        REQUIRE(scroll.action == Action::Scroll);
+        REQUIRE(scroll.frames == 30);
+        REQUIRE(scroll.amount == Approx(1.5));
+        REQUIRE(scroll.getPhaseName() == "fast scroll");
+    }
+
+    SECTION("Unknown actions and non-arrays are rejected") {
+        REQUIRE_FALSE(InteractionReplay::parseScript(R"([{"action": "juggle"}])").has_value());
+        REQUIRE_FALSE(InteractionReplay::parseScript(R"({"action": "zoom"})").has_value());
+        REQUIRE_FALSE(InteractionReplay::parseScript("not json").has_value());
+    }
+
+    SECTION("Frame counts are at least one") {
+        const auto script = InteractionReplay::parseScript(R"([{"action": "idle", "frames": 0}])");
+        REQUIRE(script.has_value());
+        REQUIRE((*script)[0].frames == 1);
+    }
+}
+
+TEST_CASE("InteractionReplay - Scripts round-trip through JSON", "[profiling][ui]") {
+    const auto script = InteractionReplay::getDefaultScript();
+    const auto parsed = InteractionReplay::parseScript(InteractionReplay::toJSON(script));
+    REQUIRE(parsed.has_value());
+    REQUIRE(parsed->size() == script.size());
+
+    for (size_t i = 0; i < script.size(); ++i) {
+        REQUIRE((*parsed)[i].action == script[i].action);
+        REQUIRE((*parsed)[i].frames == script[i].frames);
+        REQUIRE((*parsed)[i].amount == Approx(script[i].amount));
+        REQUIRE((*parsed)[i].getPhaseName() == script[i].getPhaseName());
+    }
+}
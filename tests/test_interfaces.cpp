@@ -6,6 +6,7 @@
 
 #include "../magda/daw/interfaces/clip_interface.hpp"
 #include "../magda/daw/interfaces/mixer_interface.hpp"
+#include "../magda/daw/interfaces/prompt_interface.hpp"
 #include "../magda/daw/interfaces/track_interface.hpp"
 #include "../magda/daw/interfaces/transport_interface.hpp"
 
@@ -337,3 +338,40 @@ TEST_CASE("MidiNote Structure", "[clip]") {
         REQUIRE(high_note.velocity == 127);
     }
 }
+
+TEST_CASE("PromptLineSplitter Reassembles Streamed Lines", "[prompt]") {
+    std::vector<std::string> lines;
+    PromptLineSplitter splitter([&lines](const std::string& line) { lines.push_back(line); });
+
+    SECTION("Lines split across chunks come out whole") {
+        splitter.append("create_tr");
+        splitter.append("ack Bass\nset_vol");
+        REQUIRE(lines == std::vector<std::string>{"create_track Bass"});
+
+        splitter.append("ume 0.5\nplay\n");
+        REQUIRE(lines == std::vector<std::string>{"create_track Bass", "set_volume 0.5", "play"});
+    }
+
+    SECTION("CRLF line endings are stripped, even when the LF arrives alone") {
+        splitter.append("mute 1\r\nsolo 2\r");
+        splitter.append("\n");
+        REQUIRE(lines == std::vector<std::string>{"mute 1", "solo 2"});
+    }
+
+    SECTION("Blank lines are skipped") {
+        splitter.append("\n\nplay\n\r\n");
+        REQUIRE(lines == std::vector<std::string>{"play"});
+    }
+
+    SECTION("Finishing flushes a last line with no newline") {
+        splitter.append("stop");
+        REQUIRE(lines.empty());
+
+        splitter.finish();
+        REQUIRE(lines == std::vector<std::string>{"stop"});
+
+        // Nothing is left to emit twice
+        splitter.finish();
+        REQUIRE(lines.size() == 1);
+    }
+}
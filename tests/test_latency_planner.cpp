@@ -0,0 +1,69 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "../magda/daw/audio/LatencyPlanner.hpp"
+
+using namespace magda;
+
+namespace {
+
+using Policy = LatencyPlanner::Policy;
+
+// Track 0: EQ (0), linear-phase limiter (20 ms), lookahead comp (5 ms)
+// Track 1: convolution reverb (10 ms)
+std::vector<LatencyPlanner::Track> makeTracks() {
+    return {{{0.0, 0.020, 0.005}}, {{0.010}}};
+}
+
+}  // namespace
+
+TEST_CASE("LatencyPlanner compensates everything by default", "[latency]") {
+    const auto plan = LatencyPlanner::plan(makeTracks(), Policy::Compensate, 0.0);
+
+    REQUIRE(plan.bypassedCount == 0);
+    REQUIRE(plan.trackSeconds[0] == Catch::Approx(0.025));
+    REQUIRE(plan.trackSeconds[1] == Catch::Approx(0.010));
+    REQUIRE(plan.compensatedSeconds == Catch::Approx(0.025));
+}
+
+TEST_CASE("LatencyPlanner bypasses every latent plugin", "[latency]") {
+    const auto plan = LatencyPlanner::plan(makeTracks(), Policy::BypassLatent, 1.0);
+
+    REQUIRE(plan.bypassedCount == 3);
+    REQUIRE_FALSE(plan.bypass[0][0]);  // No latency, nothing to gain
+    REQUIRE(plan.bypass[0][1]);
+    REQUIRE(plan.bypass[0][2]);
+    REQUIRE(plan.bypass[1][0]);
+    REQUIRE(plan.compensatedSeconds == Catch::Approx(0.0));
+}
+
+TEST_CASE("LatencyPlanner constrains compensation to the budget", "[latency]") {
+    SECTION("Bypasses the most latent plugin on the worst track first") {
+        const auto plan = LatencyPlanner::plan(makeTracks(), Policy::Constrain, 0.010);
+
+        REQUIRE(plan.bypassedCount == 1);
+        REQUIRE(plan.bypass[0][1]);
+        REQUIRE_FALSE(plan.bypass[0][2]);
+        REQUIRE_FALSE(plan.bypass[1][0]);
+        REQUIRE(plan.compensatedSeconds == Catch::Approx(0.010));
+    }
+
+    SECTION("Keeps going until every track fits") {
+        const auto plan = LatencyPlanner::plan(makeTracks(), Policy::Constrain, 0.004);
+
+        REQUIRE(plan.bypassedCount == 3);
+        REQUIRE(plan.compensatedSeconds == Catch::Approx(0.0));
+    }
+
+    SECTION("Bypasses nothing when already within the budget") {
+        const auto plan = LatencyPlanner::plan(makeTracks(), Policy::Constrain, 0.030);
+
+        REQUIRE(plan.bypassedCount == 0);
+        REQUIRE(plan.compensatedSeconds == Catch::Approx(0.025));
+    }
+}
+
+TEST_CASE("LatencyPlanner budget is the target less the device latency", "[latency]") {
+    REQUIRE(LatencyPlanner::pluginBudgetSeconds(10.0, 0.006) == Catch::Approx(0.004));
+    REQUIRE(LatencyPlanner::pluginBudgetSeconds(3.0, 0.006) == 0.0);
+}
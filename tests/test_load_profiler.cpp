@@ -0,0 +1,88 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "../magda/daw/profiling/LoadProfiler.hpp"
+
+using namespace magda;
+using Catch::Approx;
+
+namespace {
+
+/**
+ * @brief Leaves the profiler idle with nothing pending, whatever the test did
+ */
+struct ProfilerFixture {
+    LoadProfiler& profiler = LoadProfiler::getInstance();
+
+    ~ProfilerFixture() {
+        profiler.setItemsPending(false, 0.0);
+        profiler.finish(0.0);
+    }
+};
+
+}  // namespace
+
+// ============================================================================
+// LoadProfiler Tests
+// ============================================================================
+
+TEST_CASE("LoadProfiler - Phases nest and time from the start of the load", "[profiling]") {
+    ProfilerFixture f;
+    f.profiler.begin("Test load", 1000.0);
+
+    const auto outer = f.profiler.beginPhase("Outer", 1000.0);
+    const auto inner = f.profiler.beginPhase("Inner", 1010.0);
+    f.profiler.endPhase(inner, 1040.0);
+    f.profiler.endPhase(outer, 1050.0);
+    f.profiler.beginPhase("Unfinished", 1050.0);
+    f.profiler.finish(1100.0);
+
+    const auto timeline = f.profiler.getTimeline();
+    CHECK(timeline.finished);
+    CHECK(timeline.totalMs == Approx(100.0));
+    REQUIRE(timeline.phases.size() == 3);
+
+    CHECK(timeline.phases[0].depth == 0);
+    CHECK(timeline.phases[0].durationMs == Approx(50.0));
+    CHECK(timeline.phases[1].depth == 1);
+    CHECK(timeline.phases[1].startMs == Approx(10.0));
+    CHECK(timeline.phases[1].durationMs == Approx(30.0));
+    CHECK_FALSE(timeline.phases[2].finished);
+}
+
+TEST_CASE("LoadProfiler - Finishing waits for pending items", "[profiling]") {
+    ProfilerFixture f;
+    f.profiler.begin("Test load", 0.0);
+    f.profiler.setItemsPending(true, 5.0);
+    f.profiler.recordItem("Plugin", "Slow", 10.0, 400.0, true);
+    f.profiler.finish(20.0);
+    REQUIRE(f.profiler.isRunning());
+
+    f.profiler.recordItem("Plugin", "Broken", 410.0, 90.0, false);
+    f.profiler.setItemsPending(false, 500.0);
+    REQUIRE_FALSE(f.profiler.isRunning());
+
+    const auto timeline = f.profiler.getTimeline();
+    CHECK(timeline.totalMs == Approx(500.0));
+    REQUIRE(timeline.items.size() == 2);
+    CHECK(timeline.items[1].startMs == Approx(410.0));
+    CHECK_FALSE(timeline.items[1].succeeded);
+
+    const auto report = f.profiler.generateReport();
+    CHECK(report.contains("Plugin: 2 in 490.0 ms, 1 failed"));
+    CHECK(report.indexOf("Slow") < report.indexOf("Broken"));  // Slowest first
+}
+
+TEST_CASE("LoadProfiler - Nothing is recorded outside a load", "[profiling]") {
+    ProfilerFixture f;
+    f.profiler.begin("Test load", 0.0);
+    f.profiler.finish(10.0);
+
+    CHECK(f.profiler.beginPhase("Late", 20.0) == -1);
+    f.profiler.recordItem("Thumbnail", "late.wav", 20.0, 5.0, true);
+
+    const auto timeline = f.profiler.getTimeline();
+    CHECK(timeline.phases.empty());
+    CHECK(timeline.items.empty());
+    CHECK(timeline.totalMs == Approx(10.0));
+}
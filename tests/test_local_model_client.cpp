@@ -0,0 +1,38 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+
+#include "../magda/daw/engine/LocalModelClient.hpp"
+
+using namespace magda;
+
+// ============================================================================
+// LocalModelClient Tests
+// ============================================================================
+
+TEST_CASE("LocalModelClient - Prompt carries the DAW context", "[local_model]") {
+    REQUIRE(LocalModelClient::composePrompt("Add a bass track", "") == "Add a bass track");
+    REQUIRE(LocalModelClient::composePrompt("Add a bass track", "{\"tracks\":2}") ==
+            "Current DAW state:\n{\"tracks\":2}\n\nAdd a bass track");
+}
+
+TEST_CASE("LocalModelClient - A missing model fails the request at once", "[local_model]") {
+    LocalModelClient::Settings settings;
+    settings.model = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                         .getNonexistentChildFile("no_such_model", ".gguf");
+    LocalModelClient client(settings);
+
+    int completions = 0;
+    std::string response = "unset";
+    const auto id = client.submit("Hello", "", nullptr, [&](const std::string& text) {
+        ++completions;
+        response = text;
+    });
+
+    REQUIRE(id == 0);
+    REQUIRE(completions == 1);
+    REQUIRE(response.empty());
+    REQUIRE_FALSE(client.isReady());
+    REQUIRE(client.getNumQueued() == 0);
+    REQUIRE(client.getLastError().contains("no_such_model"));
+}
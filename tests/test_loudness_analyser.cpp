@@ -0,0 +1,111 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "../magda/daw/audio/LoudnessAnalyser.hpp"
+#include "../magda/daw/audio/SpectrumAnalyser.hpp"
+
+using namespace magda;
+using Catch::Approx;
+
+// ============================================================================
+// Master analysis Tests
+// ============================================================================
+// Loudness follows ITU-R BS.1770 (K-weighted, gated), and the live spectrum
+// uses the same bands as file spectrograms.
+
+namespace {
+
+constexpr double kSampleRate = 48000.0;
+constexpr double kPi = 3.14159265358979323846;
+
+std::vector<float> sine(double frequency, float gainDb, double seconds, double phase = 0.0) {
+    const float amplitude = std::pow(10.0f, gainDb / 20.0f);
+    std::vector<float> samples(static_cast<size_t>(seconds * kSampleRate));
+    for (size_t i = 0; i < samples.size(); ++i) {
+        samples[i] = amplitude * static_cast<float>(std::sin(
+                                     2.0 * kPi * frequency * static_cast<double>(i) / kSampleRate +
+                                     phase));
+    }
+    return samples;
+}
+
+// Feeds audio in tap-sized stretches, as the analysis thread would
+template <typename Analyser>
+void feed(Analyser& analyser, const std::vector<float>& left, const std::vector<float>& right) {
+    constexpr size_t kStretch = 800;
+    for (size_t start = 0; start < left.size(); start += kStretch) {
+        const auto count = std::min(kStretch, left.size() - start);
+        analyser.process(left.data() + start, right.data() + start, static_cast<int>(count));
+    }
+}
+
+}  // namespace
+
+TEST_CASE("LoudnessAnalyser - A 1 kHz sine reads its level", "[loudness]") {
+    LoudnessAnalyser loudness;
+    loudness.prepare(kSampleRate);
+    REQUIRE(loudness.getIntegratedLufs() == LoudnessAnalyser::kSilenceLufs);
+
+    // -20 dBFS in both channels: -20 LUFS (1 kHz is where K-weighting is calibrated)
+    const auto tone = sine(1000.0, -20.0f, 4.0);
+    feed(loudness, tone, tone);
+
+    REQUIRE(loudness.getMomentaryLufs() == Approx(-20.0f).margin(0.1f));
+    REQUIRE(loudness.getShortTermLufs() == Approx(-20.0f).margin(0.1f));
+    REQUIRE(loudness.getIntegratedLufs() == Approx(-20.0f).margin(0.15f));
+    REQUIRE(loudness.getTruePeakDb() == Approx(-20.0f).margin(0.1f));
+
+    // One channel alone is 3 dB quieter
+    LoudnessAnalyser mono;
+    mono.prepare(kSampleRate);
+    const std::vector<float> silence(tone.size(), 0.0f);
+    feed(mono, tone, silence);
+    REQUIRE(mono.getMomentaryLufs() == Approx(-23.01f).margin(0.1f));
+}
+
+TEST_CASE("LoudnessAnalyser - Gating ignores silence and quiet passages", "[loudness]") {
+    LoudnessAnalyser loudness;
+    loudness.prepare(kSampleRate);
+
+    // Loud, then silent (below the absolute gate), then 30 dB down (below the relative gate)
+    auto signal = sine(1000.0, -10.0f, 5.0);
+    signal.resize(signal.size() + static_cast<size_t>(5.0 * kSampleRate), 0.0f);
+    const auto quiet = sine(1000.0, -40.0f, 5.0);
+    signal.insert(signal.end(), quiet.begin(), quiet.end());
+    feed(loudness, signal, signal);
+
+    REQUIRE(loudness.getIntegratedLufs() == Approx(-10.0f).margin(0.2f));
+    REQUIRE(loudness.getShortTermLufs() == Approx(-40.0f).margin(0.2f));
+}
+
+TEST_CASE("LoudnessAnalyser - True peak sees between samples", "[loudness]") {
+    LoudnessAnalyser loudness;
+    loudness.prepare(kSampleRate);
+
+    // A quarter of the sample rate, phased so every sample lands at 0.707 of the peak
+    const auto tone = sine(kSampleRate / 4.0, 0.0f, 0.5, kPi / 4.0);
+    feed(loudness, tone, tone);
+
+    REQUIRE(loudness.getTruePeakDb() > -0.7f);
+    REQUIRE(loudness.getTruePeakDb() < 0.5f);
+}
+
+TEST_CASE("SpectrumAnalyser - A sine peaks in its band", "[loudness][spectrogram]") {
+    SpectrumAnalyser spectrum;
+    spectrum.prepare(kSampleRate);
+
+    const auto tone = sine(1000.0, -6.0f, 0.5);
+    feed(spectrum, tone, tone);
+    const auto bands = spectrum.getBands();
+
+    REQUIRE(bands.size() == static_cast<size_t>(SpectrumAnalyser::kNumBands));
+    const auto loudest = std::max_element(bands.begin(), bands.end()) - bands.begin();
+    REQUIRE(Spectrogram::getBandFrequency(static_cast<int>(loudest), kSampleRate) <= 1000.0f);
+    REQUIRE(Spectrogram::getBandFrequency(static_cast<int>(loudest) + 1, kSampleRate) >= 1000.0f);
+    REQUIRE(bands[static_cast<size_t>(loudest)] == Approx(-6.0f).margin(1.5f));
+    REQUIRE(bands.front() < -60.0f);
+}
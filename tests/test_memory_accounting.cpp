@@ -0,0 +1,120 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "../magda/daw/core/ClipManager.hpp"
+#include "../magda/daw/core/MidiNoteList.hpp"
+#include "../magda/daw/core/TrackManager.hpp"
+#include "../magda/daw/profiling/MemoryAccounting.hpp"
+
+using namespace magda;
+
+namespace {
+
+DeviceInfo makeDevice(const juce::String& name) {
+    DeviceInfo device;
+    device.name = name;
+    device.pluginId = "eq";
+    device.format = PluginFormat::Internal;
+    return device;
+}
+
+std::vector<MidiNote> makeNotes(int count) {
+    std::vector<MidiNote> notes;
+    for (int i = 0; i < count; ++i) {
+        MidiNote note;
+        note.noteNumber = 36 + i % 48;
+        note.startBeat = i * 0.25;
+        note.lengthBeats = 0.25;
+        notes.push_back(note);
+    }
+    return notes;
+}
+
+}  // namespace
+
+// ============================================================================
+// Size estimates
+// ============================================================================
+
+TEST_CASE("MemoryAccounting - MidiNoteList grows with its notes", "[profiling][memory]") {
+    MidiNoteList list;
+    const size_t empty = list.getSizeInBytes();
+
+    list.add(makeNotes(64));
+    const size_t small = list.getSizeInBytes();
+    REQUIRE(small >= empty + 64 * sizeof(MidiNote));
+
+    list.add(makeNotes(1024));
+    REQUIRE(list.getSizeInBytes() > small);
+}
+
+TEST_CASE("MemoryAccounting - ClipManager counts clips and their notes",
+          "[profiling][memory]") {
+    auto& cm = ClipManager::getInstance();
+    cm.shutdown();
+    const size_t empty = cm.getSizeInBytes();
+
+    const auto clipId = cm.createMidiClip(1, 0.0, 4.0);
+    const size_t oneClip = cm.getSizeInBytes();
+    REQUIRE(oneClip > empty);
+
+    cm.addMidiNotes(clipId, makeNotes(512));
+    REQUIRE(cm.getSizeInBytes() >= oneClip + 512 * sizeof(MidiNote));
+
+    cm.shutdown();
+}
+
+TEST_CASE("MemoryAccounting - TrackManager counts device trees", "[profiling][memory]") {
+    auto& tm = TrackManager::getInstance();
+    tm.clearAllTracks();
+
+    const auto trackId = tm.createTrack("Memory");
+    const size_t bare = tm.getSizeInBytes();
+
+    tm.addDeviceToTrack(trackId, makeDevice("EQ"));
+    const size_t withDevice = tm.getSizeInBytes();
+    REQUIRE(withDevice >= bare + sizeof(DeviceInfo));
+
+    const auto rackPath = ChainNodePath::rack(trackId, tm.addRackToTrack(trackId));
+    const auto chainPath = rackPath.withChain(tm.addChainToRack(rackPath));
+    tm.addDeviceToChainByPath(chainPath, makeDevice("Nested EQ"));
+    REQUIRE(tm.getSizeInBytes() >= withDevice + sizeof(RackInfo) + sizeof(DeviceInfo));
+
+    tm.clearAllTracks();
+}
+
+TEST_CASE("MemoryAccounting - Chain estimate recurses into racks", "[profiling][memory]") {
+    auto& tm = TrackManager::getInstance();
+    tm.clearAllTracks();
+
+    const auto trackId = tm.createTrack("Racks");
+    const auto rackPath = ChainNodePath::rack(trackId, tm.addRackToTrack(trackId));
+    const auto chainPath = rackPath.withChain(tm.addChainToRack(rackPath));
+
+    const auto* track = tm.getTrack(trackId);
+    REQUIRE(track != nullptr);
+    const size_t shallow = estimateChainBytes(track->chainElements);
+
+    const auto nestedPath = chainPath.withRack(tm.addRackToChainByPath(chainPath));
+    tm.addDeviceToChainByPath(nestedPath.withChain(tm.addChainToRack(nestedPath)),
+                              makeDevice("Deep EQ"));
+
+    track = tm.getTrack(trackId);
+    REQUIRE(estimateChainBytes(track->chainElements) >=
+            shallow + sizeof(RackInfo) + sizeof(DeviceInfo));
+
+    tm.clearAllTracks();
+}
+
+// ============================================================================
+// Formatting
+// ============================================================================
+
+TEST_CASE("MemoryAccounting - Formats and totals byte counts", "[profiling][memory]") {
+    REQUIRE(MemoryAccounting::formatBytes(812) == "812 B");
+    REQUIRE(MemoryAccounting::formatBytes(2048) == "2.0 KB");
+    REQUIRE(MemoryAccounting::formatBytes(3 * 1024 * 1024 + 100 * 1024) == "3.1 MB");
+
+    const std::vector<MemoryAccounting::Usage> usage = {{"A", 100}, {"B", 250}};
+    REQUIRE(MemoryAccounting::getTotalBytes(usage) == 350);
+    REQUIRE(MemoryAccounting::getTotalBytes({}) == 0);
+}
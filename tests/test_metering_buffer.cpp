@@ -0,0 +1,239 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+#include "../magda/daw/audio/MeteringBuffer.hpp"
+
+using namespace magda;
+
+// ============================================================================
+// Slot allocation
+// ============================================================================
+
+TEST_CASE("MeteringBuffer - Track IDs beyond the old 128 limit", "[metering]") {
+    MeteringBuffer buffer;
+
+    // Simulate a long session: IDs keep growing while few tracks are alive
+    for (TrackId id = 0; id < 2000; ++id) {
+        REQUIRE(buffer.assignSlot(id) != MeteringBuffer::kNoSlot);
+
+        MeterData in;
+        in.peakL = static_cast<float>(id);
+        REQUIRE(buffer.pushLevels(id, in));
+
+        MeterData out;
+        REQUIRE(buffer.readLevels(id, out));
+        REQUIRE(out.peakL == Catch::Approx(static_cast<float>(id)));
+
+        if (id >= 4)
+            buffer.releaseSlot(id - 4);
+    }
+}
+
+TEST_CASE("MeteringBuffer - Slots are reused densely", "[metering]") {
+    MeteringBuffer buffer;
+
+    int first = buffer.assignSlot(10);
+    int second = buffer.assignSlot(500);
+    REQUIRE(first != second);
+    REQUIRE(buffer.assignSlot(10) == first);  // Already assigned
+
+    buffer.releaseSlot(10);
+    REQUIRE_FALSE(buffer.pushLevels(10, MeterData{}));
+
+    // A new track takes the freed slot and starts empty
+    REQUIRE(buffer.assignSlot(9000) == first);
+    MeterData out;
+    REQUIRE_FALSE(buffer.readLevels(9000, out));
+}
+
+TEST_CASE("MeteringBuffer - Unassigned and out-of-range tracks are ignored", "[metering]") {
+    MeteringBuffer buffer;
+    MeterData out;
+
+    REQUIRE_FALSE(buffer.pushLevels(3, MeterData{}));
+    REQUIRE_FALSE(buffer.readLevels(3, out));
+    REQUIRE(buffer.assignSlot(-1) == MeteringBuffer::kNoSlot);
+    REQUIRE(buffer.assignSlot(MeteringBuffer::kIdsPerPage * MeteringBuffer::kMaxIdPages) ==
+            MeteringBuffer::kNoSlot);
+}
+
+// ============================================================================
+// Reading
+// ============================================================================
+
+TEST_CASE("MeteringBuffer - Readers share the latest reading", "[metering]") {
+    MeteringBuffer buffer;
+    buffer.assignSlot(1);
+
+    MeterData in;
+    in.peakL = 0.5f;
+    in.rmsR = 0.25f;
+    buffer.pushLevels(1, in);
+
+    // Reading doesn't consume: a second view sees the same value
+    MeterData mixer, headers;
+    REQUIRE(buffer.readLevels(1, mixer));
+    REQUIRE(buffer.readLevels(1, headers));
+    REQUIRE(mixer.peakL == Catch::Approx(0.5f));
+    REQUIRE(headers.peakL == Catch::Approx(0.5f));
+    REQUIRE(headers.rmsR == Catch::Approx(0.25f));
+}
+
+TEST_CASE("MeteringBuffer - Peaks are held and decay between polls", "[metering]") {
+    MeteringBuffer buffer;
+    buffer.assignSlot(1);
+
+    MeterData loud;
+    loud.peakL = 1.2f;
+    loud.clipped = true;
+    MeterData quiet;
+    quiet.peakL = 0.1f;
+    quiet.rmsL = 0.05f;
+    buffer.pushLevels(1, loud);
+    buffer.pushLevels(1, quiet);
+
+    // A reader that missed the loud reading still sees it, decayed by one step
+    MeterData out;
+    REQUIRE(buffer.readLevels(1, out));
+    REQUIRE(out.peakL == Catch::Approx(1.2f * MeteringBuffer::kPeakDecay));
+    REQUIRE(out.rmsL == Catch::Approx(0.05f));
+    REQUIRE(out.clipped);
+
+    // Eventually falls back to the signal
+    for (int i = 0; i < 200; ++i)
+        buffer.pushLevels(1, quiet);
+    REQUIRE(buffer.readLevels(1, out));
+    REQUIRE(out.peakL == Catch::Approx(0.1f));
+    REQUIRE_FALSE(out.clipped);
+}
+
+TEST_CASE("MeteringBuffer - Reports audible pushes until consumed", "[metering]") {
+    MeteringBuffer buffer;
+    buffer.assignSlot(1);
+    REQUIRE_FALSE(buffer.consumeAudible());
+
+    MeterData silent;
+    buffer.pushLevels(1, silent);
+    REQUIRE_FALSE(buffer.consumeAudible());
+
+    MeterData signal;
+    signal.peakR = 0.5f;
+    buffer.pushLevels(1, signal);
+    REQUIRE(buffer.consumeAudible());
+    REQUIRE_FALSE(buffer.consumeAudible());
+
+    // Stays audible while the held peak decays, then goes quiet
+    bool audible = true;
+    int pushes = 0;
+    while (audible && pushes < 1000) {
+        buffer.pushLevels(1, silent);
+        audible = buffer.consumeAudible();
+        ++pushes;
+    }
+    REQUIRE_FALSE(audible);
+    REQUIRE(pushes > 1);
+}
+
+TEST_CASE("MeteringBuffer - Concurrent readers never see a torn reading", "[metering]") {
+    MeteringBuffer buffer;
+    buffer.assignSlot(1);
+
+    std::atomic<bool> done{false};
+    std::thread writer([&]() {
+        for (int i = 1; i <= 20000; ++i) {
+            // RMS mirrors the raw peak so a mixed reading is detectable
+            MeterData data;
+            data.peakL = data.peakR = data.rmsL = data.rmsR = static_cast<float>(i);
+            buffer.pushLevels(1, data);
+        }
+        done.store(true);
+    });
+
+    std::vector<std::thread> readers;
+    std::atomic<int> torn{0};
+    for (int r = 0; r < 3; ++r) {
+        readers.emplace_back([&]() {
+            MeterData data;
+            while (!done.load()) {
+                if (buffer.readLevels(1, data) && data.rmsL != data.rmsR)
+                    torn.fetch_add(1);
+            }
+        });
+    }
+
+    writer.join();
+    for (auto& reader : readers)
+        reader.join();
+    REQUIRE(torn.load() == 0);
+}
+
+// ============================================================================
+// Level kernels
+// ============================================================================
+
+TEST_CASE("measureBlock - Matches a scalar peak and sum of squares", "[metering]") {
+    std::vector<float> samples(1037);
+    for (size_t i = 0; i < samples.size(); ++i)
+        samples[i] = std::sin(static_cast<float>(i) * 0.37f) * (i == 700 ? 1.5f : 0.8f);
+
+    float peak = 0.0f;
+    double sumSquares = 0.0;
+    measureBlock(samples.data(), static_cast<int>(samples.size()), peak, sumSquares);
+
+    float expectedPeak = 0.0f;
+    double expectedSum = 0.0;
+    for (float x : samples) {
+        expectedPeak = std::max(expectedPeak, std::abs(x));
+        expectedSum += static_cast<double>(x) * x;
+    }
+
+    REQUIRE(peak == Catch::Approx(expectedPeak));
+    REQUIRE(sumSquares == Catch::Approx(expectedSum).epsilon(1e-5));
+}
+
+TEST_CASE("RMSAccumulator - Mono and multichannel blocks", "[metering]") {
+    std::vector<float> left(256, 0.5f);
+    std::vector<float> right(256, -0.25f);
+    std::vector<float> rear(256, 0.9f);
+
+    SECTION("Mono meters both sides") {
+        RMSAccumulator rms(256);
+        const float* channels[] = {left.data()};
+        rms.addBlock(channels, 1, 256);
+        REQUIRE(rms.isWindowComplete());
+        REQUIRE(rms.getPeakR() == Catch::Approx(0.5f));
+        REQUIRE(rms.getRMSR() == Catch::Approx(0.5f));
+    }
+
+    SECTION("Extra channels fold into the peaks") {
+        RMSAccumulator rms(256);
+        const float* channels[] = {left.data(), right.data(), rear.data()};
+        rms.addBlock(channels, 3, 256);
+        REQUIRE(rms.getPeakL() == Catch::Approx(0.9f));
+        REQUIRE(rms.getPeakR() == Catch::Approx(0.25f));
+        REQUIRE(rms.getRMSL() == Catch::Approx(0.5f));
+    }
+}
+
+TEST_CASE("TruePeakDetector - Finds peaks between samples", "[metering]") {
+    // A quarter-rate sine sampled 45 degrees off its crests never shows a sample above 0.707
+    std::vector<float> samples(2048);
+    for (size_t i = 0; i < samples.size(); ++i)
+        samples[i] = std::sin(1.5707963f * static_cast<float>(i) + 0.7853982f);
+
+    TruePeakDetector detector;
+    detector.process(samples.data(), 64);  // Fill the filter history
+    float truePeak = detector.process(samples.data() + 64, 1984);
+
+    REQUIRE(truePeak > 0.95f);
+    REQUIRE(truePeak < 1.05f);
+
+    RMSAccumulator samplePeak(64);
+    samplePeak.addBlock(samples.data() + 64, samples.data() + 64, 1984);
+    REQUIRE(samplePeak.getPeakL() == Catch::Approx(0.7071f).margin(1e-3));
+}
@@ -0,0 +1,90 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <limits>
+
+#include "../magda/daw/profiling/MetricsExporter.hpp"
+
+using namespace magda;
+
+// ============================================================================
+// MetricsWriter Tests
+// ============================================================================
+
+TEST_CASE("MetricsWriter - Writes each metric's header once, ahead of its samples",
+          "[metrics]") {
+    MetricsWriter writer;
+    writer.gauge("memory_bytes", "Heap by subsystem", 1024, {{"subsystem", "Clips"}});
+    writer.gauge("memory_bytes", "Heap by subsystem", 2.5, {{"subsystem", "Undo \"history\""}});
+    writer.counter("audio_dropouts_total", "Dropouts", 3);
+
+    REQUIRE(writer.getText() == "# HELP magda_memory_bytes Heap by subsystem\n"
+                                "# TYPE magda_memory_bytes gauge\n"
+                                "magda_memory_bytes{subsystem=\"Clips\"} 1024\n"
+                                "magda_memory_bytes{subsystem=\"Undo \\\"history\\\"\"} 2.5\n"
+                                "# HELP magda_audio_dropouts_total Dropouts\n"
+                                "# TYPE magda_audio_dropouts_total counter\n"
+                                "magda_audio_dropouts_total 3\n");
+}
+
+TEST_CASE("MetricsWriter - Durations are summaries in seconds", "[metrics]") {
+    ProfilingCounters::Snapshot snapshot;
+    for (int i = 0; i < 100; ++i) {
+        snapshot.histogram.addNanos(2'000'000);  // 2 ms
+    }
+    snapshot.count = 100;
+    snapshot.sumNanos = 200'000'000;
+
+    MetricsWriter writer;
+    writer.summary("scope_duration_seconds", "Scopes", snapshot, {{"scope", "AudioCallback"}});
+    const auto& text = writer.getText();
+
+    REQUIRE(text.contains("# TYPE magda_scope_duration_seconds summary\n"));
+    // Within the histogram's bucket width of 2 ms
+    REQUIRE(text.contains("magda_scope_duration_seconds{scope=\"AudioCallback\",quantile=\"0.99\"} "
+                          "0.00199"));
+    REQUIRE(text.contains("magda_scope_duration_seconds_sum{scope=\"AudioCallback\"} 0.2\n"));
+    REQUIRE(text.contains("magda_scope_duration_seconds_count{scope=\"AudioCallback\"} 100\n"));
+}
+
+TEST_CASE("MetricsWriter - Values", "[metrics]") {
+    REQUIRE(MetricsWriter::formatValue(42.0) == "42");
+    REQUIRE(MetricsWriter::formatValue(-3.0) == "-3");
+    REQUIRE(MetricsWriter::formatValue(0.125) == "0.125");
+    REQUIRE(MetricsWriter::formatValue(std::numeric_limits<double>::infinity()) == "+Inf");
+    REQUIRE(MetricsWriter::formatValue(std::numeric_limits<double>::quiet_NaN()) == "NaN");
+    REQUIRE(MetricsWriter::escapeLabelValue("a\\b\nc") == "a\\\\b\\nc");
+}
+
+// ============================================================================
+// MetricsExporter Tests
+// ============================================================================
+
+TEST_CASE("MetricsExporter - Sources write into the page while subscribed", "[metrics]") {
+    auto& exporter = MetricsExporter::getInstance();
+    {
+        auto subscription = exporter.addSource(
+            [](MetricsWriter& writer) { writer.gauge("test_source", "Test", 7); });
+        REQUIRE(exporter.collect().contains("magda_test_source 7\n"));
+    }
+    REQUIRE_FALSE(exporter.collect().contains("magda_test_source"));
+}
+
+TEST_CASE("MetricsExporter - Answers HTTP requests", "[metrics]") {
+    const juce::String page = "magda_up 1\n";
+
+    const auto metrics =
+        MetricsExporter::respond("GET /metrics HTTP/1.1\r\nHost: rig\r\n\r\n", page);
+    REQUIRE(metrics.startsWith("HTTP/1.1 200 OK\r\n"));
+    REQUIRE(metrics.contains("Content-Type: text/plain; version=0.0.4"));
+    REQUIRE(metrics.contains("Content-Length: 11\r\n"));
+    REQUIRE(metrics.endsWith("\r\n\r\nmagda_up 1\n"));
+
+    const auto head = MetricsExporter::respond("HEAD /metrics?x=1 HTTP/1.1\r\n\r\n", page);
+    REQUIRE(head.startsWith("HTTP/1.1 200 OK\r\n"));
+    REQUIRE(head.endsWith("\r\n\r\n"));
+
+    REQUIRE(MetricsExporter::respond("GET /other HTTP/1.1\r\n\r\n", page)
+                .startsWith("HTTP/1.1 404 Not Found"));
+    REQUIRE(MetricsExporter::respond("POST /metrics HTTP/1.1\r\n\r\n", page)
+                .startsWith("HTTP/1.1 405 Method Not Allowed"));
+}
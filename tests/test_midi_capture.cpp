@@ -0,0 +1,94 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "../magda/daw/audio/MidiCapture.hpp"
+
+using namespace magda;
+using Catch::Approx;
+
+namespace {
+
+CapturedMidiEvent on(double time, int note, int velocity = 100, int channel = 1) {
+    return {time, static_cast<uint8_t>(channel), static_cast<uint8_t>(note),
+            static_cast<uint8_t>(velocity), true};
+}
+
+CapturedMidiEvent off(double time, int note, int channel = 1) {
+    return {time, static_cast<uint8_t>(channel), static_cast<uint8_t>(note), 0, false};
+}
+
+}  // namespace
+
+// ============================================================================
+// MIDI capture Tests
+// ============================================================================
+
+TEST_CASE("MidiTakeBuilder - Pairs note-ons with their note-offs", "[midi][recording]") {
+    MidiTakeBuilder builder;
+    builder.add(on(1.0, 60, 90));
+    builder.add(on(1.5, 64));
+    REQUIRE(builder.getNumHeld() == 2);
+    REQUIRE(builder.takeFinished().empty());
+
+    builder.add(off(2.0, 60));
+    auto notes = builder.takeFinished();
+    REQUIRE(notes.size() == 1);
+    REQUIRE(notes[0].noteNumber == 60);
+    REQUIRE(notes[0].velocity == 90);
+    REQUIRE(notes[0].startSeconds == Approx(1.0));
+    REQUIRE(notes[0].endSeconds == Approx(2.0));
+
+    // Handed over once
+    REQUIRE(builder.takeFinished().empty());
+
+    // A note-on with velocity 0 is a note-off
+    builder.add(on(2.5, 64, 0));
+    notes = builder.takeFinished();
+    REQUIRE(notes.size() == 1);
+    REQUIRE(notes[0].endSeconds == Approx(2.5));
+    REQUIRE(builder.getNumHeld() == 0);
+    REQUIRE(builder.getLatestEndSeconds() == Approx(2.5));
+}
+
+TEST_CASE("MidiTakeBuilder - Retriggers, channels and held notes", "[midi][recording]") {
+    MidiTakeBuilder builder;
+    builder.add(on(0.0, 60));
+    builder.add(on(0.0, 60, 100, 2));
+    builder.add(on(1.0, 60, 70));  // Ends the first note on channel 1 and starts another
+    auto notes = builder.takeFinished();
+    REQUIRE(notes.size() == 1);
+    REQUIRE(notes[0].endSeconds == Approx(1.0));
+    REQUIRE(builder.getNumHeld() == 2);
+
+    // Stray offs are ignored; finish() ends what is still held
+    builder.add(off(1.2, 72));
+    builder.finish(3.0);
+    notes = builder.takeFinished();
+    REQUIRE(notes.size() == 2);
+    for (const auto& note : notes) {
+        REQUIRE(note.endSeconds == Approx(3.0));
+    }
+    REQUIRE(builder.getNumHeld() == 0);
+
+    // An off at the same time as its on still makes a note
+    builder.add(on(4.0, 48));
+    builder.add(off(4.0, 48));
+    notes = builder.takeFinished();
+    REQUIRE(notes.size() == 1);
+    REQUIRE(notes[0].endSeconds - notes[0].startSeconds ==
+            Approx(MidiTakeBuilder::kMinNoteSeconds));
+}
+
+TEST_CASE("MidiCaptureQueue - Carries events in order", "[midi][recording]") {
+    MidiCaptureQueue queue;
+    REQUIRE(queue.push(on(0.5, 60)));
+    REQUIRE(queue.push(off(0.75, 60)));
+
+    CapturedMidiEvent event;
+    REQUIRE(queue.pop(event));
+    REQUIRE(event.noteOn);
+    REQUIRE(event.timeSeconds == Approx(0.5));
+    REQUIRE(queue.pop(event));
+    REQUIRE_FALSE(event.noteOn);
+    REQUIRE_FALSE(queue.pop(event));
+}
@@ -1,6 +1,8 @@
 #include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
 
+#include "magda/daw/audio/AudioBridge.hpp"
+#include "magda/daw/audio/MidiNoteDiff.hpp"
 #include "magda/daw/core/ClipInfo.hpp"
 #include "magda/daw/core/ClipManager.hpp"
 #include "magda/daw/core/MidiNoteCommands.hpp"
@@ -269,6 +271,80 @@ TEST_CASE("MidiNoteCommands - Observer pattern", "[midi][commands][observer]") {
     }
 }
 
+TEST_CASE("MidiNoteCommands - Batched edits", "[midi][commands][batch]") {
+    using namespace magda;
+
+    struct NotificationCounter : ClipManagerListener {
+        int propertyChanges = 0;
+        void clipsChanged() override {}
+        void clipPropertyChanged(ClipId) override {
+            ++propertyChanges;
+        }
+    };
+
+    auto& clipManager = ClipManager::getInstance();
+    clipManager.shutdown();
+    UndoManager::getInstance().clearHistory();
+
+    ClipId clipId = clipManager.createMidiClip(1, 0.0, 8.0);
+    std::vector<MidiNoteId> ids;
+    for (int i = 0; i < 100; ++i) {
+        MidiNote note;
+        note.startBeat = i * 0.25;
+        note.lengthBeats = 0.25;
+        note.noteNumber = 60;
+        ids.push_back(clipManager.addMidiNote(clipId, note));
+    }
+
+    NotificationCounter counter;
+    clipManager.addListener(&counter);
+    const auto* clip = clipManager.getClip(clipId);
+
+    SECTION("A transform over many notes is one notification and one undo step") {
+        auto cmd = std::make_unique<EditMidiNotesCommand>(
+            clipId, ids, [](MidiNote& note) { note.noteNumber += 12; }, "Transpose MIDI Notes");
+        UndoManager::getInstance().executeCommand(std::move(cmd));
+
+        REQUIRE(counter.propertyChanges == 1);
+        for (const auto& note : clip->midiNotes) {
+            REQUIRE(note.noteNumber == 72);
+        }
+
+        UndoManager::getInstance().undo();
+        REQUIRE(counter.propertyChanges == 2);
+        for (const auto& note : clip->midiNotes) {
+            REQUIRE(note.noteNumber == 60);
+        }
+    }
+
+    SECTION("Transforms are clamped and unchanged notes are skipped") {
+        EditMidiNotesCommand noop(clipId, ids, [](MidiNote&) {}, "Nothing");
+        REQUIRE(noop.isEmpty());
+
+        auto cmd = std::make_unique<EditMidiNotesCommand>(
+            clipId, ids, [](MidiNote& note) { note.velocity = 500; }, "Set Notes Velocity");
+        UndoManager::getInstance().executeCommand(std::move(cmd));
+        REQUIRE(clip->midiNotes[0].velocity == 127);
+    }
+
+    SECTION("Deleting many notes restores them with their ids on undo") {
+        std::vector<MidiNoteId> deleted(ids.begin(), ids.begin() + 50);
+        UndoManager::getInstance().executeCommand(
+            std::make_unique<DeleteMidiNotesCommand>(clipId, deleted));
+
+        REQUIRE(counter.propertyChanges == 1);
+        REQUIRE(clip->midiNotes.size() == 50);
+
+        UndoManager::getInstance().undo();
+        REQUIRE(clip->midiNotes.size() == 100);
+        REQUIRE(clip->midiNotes.indexOf(ids[0]) == 0);
+    }
+
+    clipManager.removeListener(&counter);
+    UndoManager::getInstance().clearHistory();
+    clipManager.shutdown();
+}
+
 TEST_CASE("MidiClip - Real-world scenario", "[midi][clip][integration]") {
     using namespace magda;
 
@@ -318,3 +394,142 @@ TEST_CASE("MidiClip - Real-world scenario", "[midi][clip][integration]") {
         REQUIRE(clip.startTime == 0.0);
     }
 }
+
+TEST_CASE("MidiNoteDiff - Only the edited run differs", "[midi][clip][sync]") {
+    using namespace magda;
+
+    std::vector<MidiNote> notes;
+    for (int i = 0; i < 8; i++) {
+        MidiNote note;
+        note.startBeat = static_cast<double>(i);
+        note.noteNumber = 60 + i;
+        notes.push_back(note);
+    }
+
+    SECTION("Identical notes produce an empty diff") {
+        auto diff = diffMidiNotes(notes, notes);
+        REQUIRE(diff.isEmpty());
+    }
+
+    SECTION("Moving one note touches only that note") {
+        auto edited = notes;
+        edited[3].startBeat = 3.5;
+        edited[3].noteNumber = 72;
+
+        auto diff = diffMidiNotes(notes, edited);
+        REQUIRE(diff.begin == 3);
+        REQUIRE(diff.oldEnd == 4);
+        REQUIRE(diff.newEnd == 4);
+    }
+
+    SECTION("Appending a note adds a run at the end") {
+        auto edited = notes;
+        edited.push_back(MidiNote{});
+
+        auto diff = diffMidiNotes(notes, edited);
+        REQUIRE(diff.begin == 8);
+        REQUIRE(diff.oldEnd == 8);
+        REQUIRE(diff.newEnd == 9);
+    }
+
+    SECTION("Deleting a note removes a run of one") {
+        auto edited = notes;
+        edited.erase(edited.begin() + 5);
+
+        auto diff = diffMidiNotes(notes, edited);
+        REQUIRE(diff.begin == 5);
+        REQUIRE(diff.oldEnd == 6);
+        REQUIRE(diff.newEnd == 5);
+    }
+
+    SECTION("Inserting a note in the middle adds a run of one") {
+        auto edited = notes;
+        MidiNote inserted;
+        inserted.startBeat = 1.5;
+        edited.insert(edited.begin() + 2, inserted);
+
+        auto diff = diffMidiNotes(notes, edited);
+        REQUIRE(diff.begin == 2);
+        REQUIRE(diff.oldEnd == 2);
+        REQUIRE(diff.newEnd == 3);
+    }
+
+    SECTION("Clearing every note removes everything") {
+        auto diff = diffMidiNotes(notes, {});
+        REQUIRE(diff.begin == 0);
+        REQUIRE(diff.oldEnd == 8);
+        REQUIRE(diff.newEnd == 0);
+    }
+}
+
+TEST_CASE("MidiClip - Resizing a looped clip leaves its loop body alone", "[midi][clip][loop]") {
+    using namespace magda;
+
+    auto& clipManager = ClipManager::getInstance();
+    clipManager.shutdown();
+
+    // One bar at 120 BPM, looping a four-beat body of sixteenth notes
+    ClipId clipId = clipManager.createMidiClip(1, 0.0, 2.0);
+    for (int i = 0; i < 16; ++i) {
+        MidiNote note;
+        note.startBeat = i * 0.25;
+        note.lengthBeats = 0.25;
+        note.noteNumber = 60 + i % 4;
+        clipManager.addMidiNote(clipId, note);
+    }
+    clipManager.setClipLoopEnabled(clipId, true);
+    clipManager.setClipLoopLength(clipId, 4.0);
+
+    const auto* clip = clipManager.getClip(clipId);
+    const MidiNoteList before = clip->midiNotes;
+
+    // 500 bars: only the clip's length changes, the body is neither copied nor edited
+    clipManager.resizeClip(clipId, 1000.0, false);
+
+    REQUIRE(clip->length == 1000.0);
+    REQUIRE(clip->internalLoopEnabled);
+    REQUIRE(clip->midiNotes.size() == 16);
+    REQUIRE(clip->midiNotes.sharesStorageWith(before));
+    REQUIRE(diffMidiNotes(before.getNotes(), clip->midiNotes.getNotes()).isEmpty());
+
+    clipManager.shutdown();
+}
+
+TEST_CASE("MidiClip - The engine clip loops the clip's body up to its end", "[midi][clip][loop]") {
+    using namespace magda;
+    namespace te = tracktion;
+
+    juce::ScopedJuceInitialiser_GUI juceInit;
+    te::Engine engine{"MAGDA Tests"};
+    auto edit = te::Edit::createSingleTrackEdit(engine);
+    auto* track = te::getAudioTracks(*edit)[0];
+    auto engineClip = track->insertMIDIClip(
+        te::TimeRange(te::TimePosition(), te::TimePosition::fromSeconds(8.0)), nullptr);
+    REQUIRE(engineClip != nullptr);
+
+    ClipInfo clip;
+    clip.type = ClipType::MIDI;
+    clip.length = 8.0;
+    clip.internalLoopEnabled = true;
+    clip.internalLoopLength = 4.0;
+
+    AudioBridge::syncMidiClipLoop(*engineClip, clip);
+    REQUIRE(engineClip->isLooping());
+    REQUIRE(engineClip->getLoopStartBeats() == te::BeatPosition());
+    REQUIRE(engineClip->getLoopLengthBeats() == te::BeatDuration::fromBeats(4.0));
+
+    // A longer clip keeps the same body; a new loop length moves the range
+    clip.length = 1000.0;
+    engineClip->setEnd(te::TimePosition::fromSeconds(clip.length), false);
+    AudioBridge::syncMidiClipLoop(*engineClip, clip);
+    REQUIRE(engineClip->getLoopLengthBeats() == te::BeatDuration::fromBeats(4.0));
+
+    clip.internalLoopLength = 2.0;
+    AudioBridge::syncMidiClipLoop(*engineClip, clip);
+    REQUIRE(engineClip->getLoopLengthBeats() == te::BeatDuration::fromBeats(2.0));
+
+    // Unlooped, it plays straight through
+    clip.internalLoopEnabled = false;
+    AudioBridge::syncMidiClipLoop(*engineClip, clip);
+    REQUIRE_FALSE(engineClip->isLooping());
+}
@@ -0,0 +1,144 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "../magda/daw/audio/MidiFileImporter.hpp"
+
+using namespace magda;
+using Catch::Approx;
+
+// ============================================================================
+// MidiFileImporter Tests
+// ============================================================================
+// MIDI files are read into sorted notes per track and created through one
+// batch edit, so a large import doesn't go note by note.
+
+namespace {
+
+constexpr int kTicksPerBeat = 480;
+
+juce::MidiMessage at(juce::MidiMessage message, double beat) {
+    message.setTimeStamp(beat * kTicksPerBeat);
+    return message;
+}
+
+}  // namespace
+
+TEST_CASE("MidiFileImporter - Pairs notes in start order", "[midi][import]") {
+    juce::MidiMessageSequence sequence;
+    sequence.addEvent(at(juce::MidiMessage::textMetaEvent(3, "Strings"), 0.0));
+    sequence.addEvent(at(juce::MidiMessage::noteOn(1, 64, static_cast<juce::uint8>(90)), 0.0));
+    sequence.addEvent(at(juce::MidiMessage::noteOn(1, 60, static_cast<juce::uint8>(100)), 0.0));
+    sequence.addEvent(at(juce::MidiMessage::noteOff(1, 60), 1.0));
+    // A note-on at velocity 0 ends a note, as many files write it
+    sequence.addEvent(at(juce::MidiMessage::noteOn(1, 64, static_cast<juce::uint8>(0)), 2.0));
+    // The same pitch twice at once: each note-off ends the earliest
+    sequence.addEvent(at(juce::MidiMessage::noteOn(1, 67, static_cast<juce::uint8>(80)), 2.0));
+    sequence.addEvent(at(juce::MidiMessage::noteOn(1, 67, static_cast<juce::uint8>(70)), 2.5));
+    sequence.addEvent(at(juce::MidiMessage::noteOff(1, 67), 3.0));
+    sequence.addEvent(at(juce::MidiMessage::noteOff(1, 67), 4.0));
+    // The same pitch on another channel is another note
+    sequence.addEvent(at(juce::MidiMessage::noteOn(2, 60, static_cast<juce::uint8>(50)), 4.0));
+    sequence.addEvent(at(juce::MidiMessage::noteOff(1, 60), 4.5));  // Nothing sounding
+    sequence.addEvent(at(juce::MidiMessage::endOfTrack(), 6.0));
+
+    const auto track = MidiFileImporter::readTrack(sequence, kTicksPerBeat);
+
+    REQUIRE(track.name == "Strings");
+    REQUIRE(track.notes.size() == 5);
+
+    REQUIRE(track.notes[0].noteNumber == 60);
+    REQUIRE(track.notes[0].velocity == 100);
+    REQUIRE(track.notes[0].startBeat == Approx(0.0));
+    REQUIRE(track.notes[0].lengthBeats == Approx(1.0));
+
+    REQUIRE(track.notes[1].noteNumber == 64);
+    REQUIRE(track.notes[1].lengthBeats == Approx(2.0));
+
+    REQUIRE(track.notes[2].velocity == 80);
+    REQUIRE(track.notes[2].startBeat == Approx(2.0));
+    REQUIRE(track.notes[2].lengthBeats == Approx(1.0));
+    REQUIRE(track.notes[3].velocity == 70);
+    REQUIRE(track.notes[3].startBeat == Approx(2.5));
+    REQUIRE(track.notes[3].lengthBeats == Approx(1.5));
+
+    // Still sounding at the end of the track: it ends on the track's last event
+    REQUIRE(track.notes[4].noteNumber == 60);
+    REQUIRE(track.notes[4].startBeat == Approx(4.0));
+    REQUIRE(track.notes[4].lengthBeats == Approx(2.0));
+
+    REQUIRE(track.lengthBeats == Approx(6.0));
+}
+
+TEST_CASE("MidiFileImporter - Reads a file's tracks", "[midi][import]") {
+    const auto file = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                          .getNonexistentChildFile("magda_midi_import_test", ".mid", false);
+
+    juce::MidiFile midiFile;
+    midiFile.setTicksPerQuarterNote(kTicksPerBeat);
+
+    juce::MidiMessageSequence conductor;  // Tempo only, so it makes no track
+    conductor.addEvent(juce::MidiMessage::tempoMetaEvent(500000));
+    midiFile.addTrack(conductor);
+
+    juce::MidiMessageSequence piano;
+    for (int i = 0; i < 1000; ++i) {
+        piano.addEvent(at(juce::MidiMessage::noteOn(1, 36 + i % 48, static_cast<juce::uint8>(100)),
+                          i * 0.25));
+        piano.addEvent(at(juce::MidiMessage::noteOff(1, 36 + i % 48), i * 0.25 + 0.2));
+    }
+    midiFile.addTrack(piano);
+    {
+        juce::FileOutputStream stream(file);
+        REQUIRE(stream.openedOk());
+        REQUIRE(midiFile.writeTo(stream));
+    }
+
+    const auto result = MidiFileImporter::readFile(file);
+    file.deleteFile();
+
+    REQUIRE_FALSE(result.failed);
+    REQUIRE(result.tracks.size() == 1);
+    const auto& notes = result.tracks[0].notes;
+    REQUIRE(notes.size() == 1000);
+    REQUIRE(notes[999].startBeat == Approx(999 * 0.25));
+    REQUIRE(notes[999].lengthBeats == Approx(0.2));
+    REQUIRE(result.tracks[0].lengthBeats == Approx(999 * 0.25 + 0.2));
+
+    REQUIRE(MidiFileImporter::readFile(file).failed);
+}
+
+TEST_CASE("MidiFileImporter - Describes the import as one batch", "[midi][import]") {
+    MidiFileImporter::Result result;
+    result.source = juce::File::getCurrentWorkingDirectory().getChildFile("Song.mid");
+    for (int t = 0; t < 2; ++t) {
+        MidiFileImporter::Track track;
+        track.name = t == 0 ? "Bass" : "";
+        track.notes.resize(3);
+        track.lengthBeats = 8.0;
+        result.tracks.push_back(track);
+    }
+
+    const auto operations = MidiFileImporter::makeBatch(result, 2.0, 120.0);
+
+    REQUIRE(operations.size() == 6);
+    for (size_t t = 0; t < 2; ++t) {
+        const auto& createTrack = operations[t * 3];
+        const auto& addClip = operations[t * 3 + 1];
+        const auto& addNotes = operations[t * 3 + 2];
+
+        REQUIRE(createTrack.type == BatchOperation::Type::CreateTrack);
+        REQUIRE(createTrack.trackType == TrackType::Instrument);
+        REQUIRE(addClip.type == BatchOperation::Type::AddMidiClip);
+        REQUIRE(addClip.idFrom == static_cast<int>(t * 3));
+        REQUIRE(addClip.startTime == Approx(2.0));
+        REQUIRE(addClip.length == Approx(4.0));  // 8 beats at 120 BPM
+        REQUIRE(addNotes.type == BatchOperation::Type::AddNotes);
+        REQUIRE(addNotes.idFrom == static_cast<int>(t * 3 + 1));
+        REQUIRE(addNotes.notes.size() == 3);
+    }
+    REQUIRE(operations[0].name == "Bass");
+    REQUIRE(operations[3].name == "Song 2");
+
+    result.failed = true;
+    REQUIRE(MidiFileImporter::makeBatch(result, 0.0, 120.0).empty());
+}
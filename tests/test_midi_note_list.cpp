@@ -0,0 +1,295 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "../magda/daw/core/MidiNoteList.hpp"
+
+using namespace magda;
+
+// ============================================================================
+// MidiNoteList Tests
+// ============================================================================
+
+namespace {
+
+MidiNote makeNote(double startBeat, int noteNumber, double lengthBeats = 1.0) {
+    MidiNote note;
+    note.startBeat = startBeat;
+    note.noteNumber = noteNumber;
+    note.lengthBeats = lengthBeats;
+    return note;
+}
+
+std::vector<MidiNoteId> idsInRange(const MidiNoteList& notes, double start, double end,
+                                   int lowNote, int highNote) {
+    std::vector<size_t> positions;
+    notes.getNotesInRange(start, end, lowNote, highNote, positions);
+
+    std::vector<MidiNoteId> ids;
+    for (size_t position : positions) {
+        ids.push_back(notes[position].id);
+    }
+    return ids;
+}
+
+// Brute-force reference in start order
+std::vector<MidiNoteId> scan(const MidiNoteList& notes, double start, double end, int lowNote,
+                             int highNote) {
+    std::vector<MidiNoteId> ids;
+    for (const auto& note : notes) {
+        if (note.noteNumber >= lowNote && note.noteNumber <= highNote &&
+            note.startBeat < end && note.startBeat + note.lengthBeats > start) {
+            ids.push_back(note.id);
+        }
+    }
+    return ids;
+}
+
+bool isSorted(const MidiNoteList& notes) {
+    return std::is_sorted(notes.begin(), notes.end(), [](const MidiNote& a, const MidiNote& b) {
+        return a.startBeat < b.startBeat;
+    });
+}
+
+}  // namespace
+
+TEST_CASE("MidiNoteList - Notes stay sorted by start", "[midi][notes]") {
+    MidiNoteList notes;
+    MidiNoteId late = notes.add(makeNote(8.0, 60));
+    MidiNoteId early = notes.add(makeNote(0.0, 64));
+    MidiNoteId middle = notes.add(makeNote(4.0, 62));
+
+    REQUIRE(notes.size() == 3);
+    REQUIRE(notes[0].id == early);
+    REQUIRE(notes[1].id == middle);
+    REQUIRE(notes[2].id == late);
+
+    SECTION("Moving a note re-sorts it and keeps its id") {
+        MidiNote moved = *notes.find(late);
+        moved.startBeat = 2.0;
+        REQUIRE(notes.update(moved));
+
+        REQUIRE(notes[1].id == late);
+        REQUIRE(notes.indexOf(late) == 1);
+        REQUIRE(isSorted(notes));
+    }
+
+    SECTION("Deleting shifts positions but not ids") {
+        REQUIRE(notes.remove(early));
+        REQUIRE(notes.find(early) == nullptr);
+        REQUIRE(notes.indexOf(middle) == 0);
+        REQUIRE(notes.find(late)->startBeat == 8.0);
+        REQUIRE_FALSE(notes.remove(early));
+    }
+
+    SECTION("Re-adding a deleted note restores its id") {
+        MidiNote deleted = *notes.find(middle);
+        notes.remove(middle);
+
+        REQUIRE(notes.add(deleted) == middle);
+        REQUIRE(notes.indexOf(middle) == 1);
+    }
+
+    SECTION("Adding a note whose id is in use assigns a new one") {
+        MidiNote copy = *notes.find(middle);
+        MidiNoteId copyId = notes.add(copy);
+
+        REQUIRE(copyId != middle);
+        REQUIRE(notes.size() == 4);
+    }
+}
+
+TEST_CASE("MidiNoteList - Range queries", "[midi][notes]") {
+    MidiNoteList notes;
+    MidiNoteId c = notes.add(makeNote(0.0, 60, 2.0));     // [0, 2)
+    MidiNoteId e = notes.add(makeNote(1.0, 64, 1.0));     // [1, 2)
+    MidiNoteId g = notes.add(makeNote(3.0, 67, 1.0));     // [3, 4)
+    MidiNoteId pad = notes.add(makeNote(0.0, 48, 32.0));  // [0, 32), spans many buckets
+
+    SECTION("Time window across all pitches") {
+        REQUIRE(idsInRange(notes, 1.5, 3.5, 0, 127) == std::vector<MidiNoteId>{pad, c, e, g});
+        REQUIRE(idsInRange(notes, 2.0, 3.0, 0, 127) == std::vector<MidiNoteId>{pad});
+    }
+
+    SECTION("Pitch window") {
+        REQUIRE(idsInRange(notes, 0.0, 8.0, 60, 64) == std::vector<MidiNoteId>{c, e});
+        REQUIRE(idsInRange(notes, 0.0, 8.0, 65, 127) == std::vector<MidiNoteId>{g});
+    }
+
+    SECTION("Long notes reach into later buckets") {
+        REQUIRE(idsInRange(notes, 30.0, 31.0, 0, 127) == std::vector<MidiNoteId>{pad});
+    }
+
+    SECTION("Empty ranges return nothing") {
+        REQUIRE(idsInRange(notes, 4.0, 4.0, 0, 127).empty());
+        REQUIRE(idsInRange(notes, 40.0, 50.0, 0, 127).empty());
+    }
+
+    SECTION("Queries follow edits") {
+        MidiNote moved = *notes.find(g);
+        moved.startBeat = 20.0;
+        moved.noteNumber = 72;
+        notes.update(moved);
+
+        REQUIRE(idsInRange(notes, 3.0, 4.0, 0, 127) == std::vector<MidiNoteId>{pad});
+        REQUIRE(idsInRange(notes, 20.0, 21.0, 70, 80) == std::vector<MidiNoteId>{g});
+    }
+}
+
+TEST_CASE("MidiNoteList - Range queries match a scan", "[midi][notes]") {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> startDist(0.0, 256.0);
+    std::uniform_real_distribution<double> lengthDist(0.0625, 8.0);
+    std::uniform_int_distribution<int> pitchDist(24, 96);
+
+    MidiNoteList notes;
+    for (int i = 0; i < 2000; ++i) {
+        notes.add(makeNote(startDist(rng), pitchDist(rng), lengthDist(rng)));
+    }
+    REQUIRE(isSorted(notes));
+
+    for (int i = 0; i < 200; ++i) {
+        double start = startDist(rng);
+        double end = start + lengthDist(rng) * 4.0;
+        int low = pitchDist(rng);
+        int high = low + 12;
+        REQUIRE(idsInRange(notes, start, end, low, high) == scan(notes, start, end, low, high));
+    }
+}
+
+TEST_CASE("MidiNoteList - Bulk edits", "[midi][notes]") {
+    MidiNoteList notes;
+    std::vector<MidiNoteId> ids;
+    for (int i = 0; i < 8; ++i) {
+        ids.push_back(notes.add(makeNote(static_cast<double>(i), 60)));
+    }
+
+    SECTION("Bulk update re-sorts once and keeps ids") {
+        std::vector<MidiNote> edited;
+        for (MidiNoteId id : ids) {
+            MidiNote note = *notes.find(id);
+            note.startBeat = 7.0 - note.startBeat;  // Reverse the order
+            note.noteNumber += 12;
+            edited.push_back(note);
+        }
+
+        REQUIRE(notes.update(edited) == ids.size());
+        REQUIRE(isSorted(notes));
+        REQUIRE(notes[0].id == ids.back());
+        REQUIRE(idsInRange(notes, 0.0, 1.0, 72, 72) == std::vector<MidiNoteId>{ids.back()});
+        REQUIRE(idsInRange(notes, 0.0, 8.0, 60, 60).empty());
+    }
+
+    SECTION("Bulk update skips unknown ids") {
+        MidiNote unknown = makeNote(0.0, 60);
+        unknown.id = 1000;
+        REQUIRE(notes.update(std::vector<MidiNote>{unknown}) == 0);
+        REQUIRE(notes.size() == ids.size());
+    }
+
+    SECTION("Bulk remove then re-add restores the same notes") {
+        std::vector<MidiNoteId> removedIds{ids[1], ids[4], ids[6]};
+        std::vector<MidiNote> removed;
+        for (MidiNoteId id : removedIds) {
+            removed.push_back(*notes.find(id));
+        }
+
+        REQUIRE(notes.remove(removedIds) == 3);
+        REQUIRE(notes.size() == 5);
+        REQUIRE(notes.find(ids[4]) == nullptr);
+
+        notes.add(removed);
+        REQUIRE(notes.size() == 8);
+        REQUIRE(isSorted(notes));
+        REQUIRE(notes.indexOf(ids[4]) == 4);
+    }
+}
+
+TEST_CASE("MidiNoteList - Copies and sparse clips", "[midi][notes]") {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> start(0.0, 2000.0);
+    std::uniform_int_distribution<int> pitch(0, 127);
+
+    MidiNoteList notes;
+    std::vector<MidiNote> batch;
+    for (int i = 0; i < 2000; ++i) {
+        batch.push_back(makeNote(start(rng), pitch(rng), 0.5));
+    }
+    const auto ids = notes.add(batch);
+    notes.add(makeNote(100000.0, 60));  // One far-off note gives pitch 60 many empty buckets
+
+    SECTION("A copy answers like the original and edits independently") {
+        MidiNoteList copy = notes;
+        REQUIRE(idsInRange(copy, 500.0, 520.0, 0, 127) == scan(notes, 500.0, 520.0, 0, 127));
+        REQUIRE(copy.indexOf(ids[123]) == notes.indexOf(ids[123]));
+
+        REQUIRE(copy.remove(ids[123]));
+        REQUIRE(copy.find(ids[123]) == nullptr);
+        REQUIRE(notes.find(ids[123]) != nullptr);
+        REQUIRE(idsInRange(copy, 0.0, 2001.0, 0, 127).size() == ids.size() - 1);
+    }
+
+    SECTION("Range queries across empty buckets") {
+        REQUIRE(idsInRange(notes, 99999.0, 100001.0, 0, 127).size() == 1);
+        REQUIRE(idsInRange(notes, 5000.0, 6000.0, 60, 60).empty());
+        REQUIRE(idsInRange(notes, 0.0, 100001.0, 60, 60) == scan(notes, 0.0, 100001.0, 60, 60));
+    }
+
+    SECTION("Every id is found at its position") {
+        for (size_t i = 0; i < notes.size(); ++i) {
+            REQUIRE(notes.indexOf(notes[i].id) == static_cast<int>(i));
+        }
+        REQUIRE(notes.indexOf(INVALID_MIDI_NOTE_ID) == -1);
+    }
+}
+
+TEST_CASE("MidiNoteList - Copies share storage until edited", "[midi][notes]") {
+    MidiNoteList notes;
+    std::vector<MidiNote> batch;
+    for (int i = 0; i < 64; ++i) {
+        batch.push_back(makeNote(i * 0.5, 60 + i % 12));
+    }
+    const auto ids = notes.add(batch);
+
+    SECTION("Copying and reading leave the storage shared") {
+        MidiNoteList copy = notes;
+        REQUIRE(copy.sharesStorageWith(notes));
+        REQUIRE(copy.indexOf(ids[10]) == notes.indexOf(ids[10]));
+        REQUIRE(idsInRange(copy, 0.0, 8.0, 0, 127) == scan(notes, 0.0, 8.0, 0, 127));
+        REQUIRE(copy.sharesStorageWith(notes));
+
+        // Removing nothing isn't an edit
+        REQUIRE(copy.remove(std::vector<MidiNoteId>{INVALID_MIDI_NOTE_ID}) == 0);
+        REQUIRE(copy.sharesStorageWith(notes));
+    }
+
+    SECTION("Editing a copy leaves the original alone") {
+        MidiNoteList copy = notes;
+        auto moved = *copy.find(ids[5]);
+        moved.startBeat = 100.0;
+        REQUIRE(copy.update(moved));
+        REQUIRE_FALSE(copy.sharesStorageWith(notes));
+
+        REQUIRE(copy.find(ids[5])->startBeat == 100.0);
+        REQUIRE(notes.find(ids[5])->startBeat == 2.5);
+        REQUIRE(idsInRange(notes, 99.0, 101.0, 0, 127).empty());
+        REQUIRE(idsInRange(copy, 99.0, 101.0, 0, 127) == std::vector<MidiNoteId>{ids[5]});
+    }
+
+    SECTION("Editing the original leaves the copy alone") {
+        const MidiNoteList copy = notes;
+        notes.clear();
+        REQUIRE(notes.empty());
+        REQUIRE(copy.size() == ids.size());
+        REQUIRE(copy.indexOf(ids.back()) == static_cast<int>(ids.size() - 1));
+    }
+
+    SECTION("Copies keep handing out fresh ids") {
+        MidiNoteList copy = notes;
+        const auto added = copy.add(makeNote(40.0, 72));
+        REQUIRE(std::find(ids.begin(), ids.end(), added) == ids.end());
+        REQUIRE(notes.find(added) == nullptr);
+    }
+}
@@ -0,0 +1,103 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <vector>
+
+#include "../magda/daw/audio/MixKernels.hpp"
+
+using namespace magda;
+using Catch::Approx;
+
+// ============================================================================
+// MixKernels Tests
+// ============================================================================
+
+TEST_CASE("MixKernels - Constant-power pan keeps the summed power", "[mix]") {
+    for (float pan : {-1.0f, -0.5f, 0.0f, 0.3f, 1.0f}) {
+        const auto gains = MixKernels::constantPowerPan(pan);
+        REQUIRE(gains.left * gains.left + gains.right * gains.right == Approx(1.0f));
+    }
+    const auto centre = MixKernels::constantPowerPan(0.0f);
+    REQUIRE(centre.left == Approx(centre.right));
+    REQUIRE(MixKernels::constantPowerPan(-1.0f).right == Approx(0.0f).margin(1e-6));
+    REQUIRE(MixKernels::constantPowerPan(5.0f).left == Approx(0.0f).margin(1e-6));
+}
+
+TEST_CASE("MixKernels - Gain ramps meet across consecutive blocks", "[mix]") {
+    std::vector<float> ones(64, 1.0f);
+    MixKernels::applyGain(ones.data(), 32, 0.0f, 0.5f);
+    MixKernels::applyGain(ones.data() + 32, 32, 0.5f, 1.0f);
+
+    for (size_t i = 0; i < ones.size(); ++i) {
+        REQUIRE(ones[i] == Approx(static_cast<float>(i) / 64.0f));
+    }
+
+    std::vector<float> dest(8, 1.0f);
+    const std::vector<float> source(8, 2.0f);
+    MixKernels::addWithGain(dest.data(), source.data(), 8, 0.5f, 0.5f);
+    REQUIRE(dest[7] == Approx(2.0f));
+    MixKernels::addWithGain(dest.data(), source.data(), 8, 1.0f, 0.0f);
+    REQUIRE(dest[0] == Approx(4.0f));
+    REQUIRE(dest[4] == Approx(3.0f));
+}
+
+TEST_CASE("MixKernels - Sums any number of sources", "[mix]") {
+    constexpr int kSamples = 5;
+    std::vector<std::vector<float>> buffers;
+    for (int n = 0; n < 11; ++n) {
+        buffers.emplace_back(kSamples, static_cast<float>(n + 1));
+    }
+
+    for (int count = 0; count <= 11; ++count) {
+        std::vector<const float*> sources;
+        for (int n = 0; n < count; ++n) {
+            sources.push_back(buffers[static_cast<size_t>(n)].data());
+        }
+        std::vector<float> dest(kSamples, -1.0f);
+        MixKernels::sum(dest.data(), sources.data(), count, kSamples);
+        const float expected = static_cast<float>(count * (count + 1) / 2);
+        REQUIRE(dest[0] == Approx(expected));
+        REQUIRE(dest[kSamples - 1] == Approx(expected));
+    }
+}
+
+TEST_CASE("ChainMixer - Volume changes glide, the first setting doesn't", "[mix]") {
+    constexpr double kRate = 1000.0;  // 20 samples of ramp
+    ChainMixer mixer;
+    mixer.setVolumeAndPan(0.0f, 0.0f, kRate);
+
+    std::vector<float> left(10, 1.0f), right(10, 1.0f);
+    std::vector<float> outLeft(10, 0.0f), outRight(10, 0.0f);
+    const float* source[] = {left.data(), right.data()};
+    float* dest[] = {outLeft.data(), outRight.data()};
+
+    mixer.mixInto(dest, source, 2, 10);
+    REQUIRE(outLeft[0] == Approx(1.0f));  // A centred chain is at unity
+    REQUIRE(outRight[9] == Approx(1.0f));
+
+    mixer.setVolumeAndPan(-100.0f, 0.0f, kRate);
+    std::fill(outLeft.begin(), outLeft.end(), 0.0f);
+    mixer.mixInto(dest, source, 2, 10);
+    REQUIRE(outLeft[0] == Approx(1.0f));
+    REQUIRE(outLeft[9] < 1.0f);
+    REQUIRE(outLeft[9] > 0.5f);  // Half way through the ramp
+
+    std::fill(outLeft.begin(), outLeft.end(), 0.0f);
+    mixer.mixInto(dest, source, 2, 10);
+    mixer.mixInto(dest, source, 2, 10);  // Settled: adds silence
+    REQUIRE(outLeft[9] < 0.1f);
+}
+
+TEST_CASE("ChainMixer - Hard pan puts a stereo chain on one side", "[mix]") {
+    ChainMixer mixer;
+    mixer.setVolumeAndPan(0.0f, 1.0f, 48000.0);
+
+    std::vector<float> left(4, 1.0f), right(4, 1.0f);
+    std::vector<float> outLeft(4, 0.0f), outRight(4, 0.0f);
+    const float* source[] = {left.data(), right.data()};
+    float* dest[] = {outLeft.data(), outRight.data()};
+    mixer.mixInto(dest, source, 2, 4);
+
+    REQUIRE(outLeft[0] == Approx(0.0f).margin(1e-6));
+    REQUIRE(outRight[0] == Approx(1.41421356f));
+}
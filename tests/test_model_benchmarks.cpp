@@ -0,0 +1,295 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <vector>
+
+#include "../magda/daw/audio/ParameterQueue.hpp"
+#include "../magda/daw/core/AutomationManager.hpp"
+#include "../magda/daw/core/ClipManager.hpp"
+#include "../magda/daw/core/ParameterConversion.hpp"
+#include "../magda/daw/core/ParameterUtils.hpp"
+#include "../magda/daw/core/TrackManager.hpp"
+
+/**
+ * Microbenchmarks for model hot paths
+ *
+ * Hidden from the default run ([.]); CTest runs them as magda_benchmarks, next to the unit
+ * tests. Run by hand with:  magda_tests "[benchmark]"
+ *
+ * Each case checks its fixture before timing so a broken setup fails instead of
+ * benchmarking an empty model.
+ */
+
+using namespace magda;
+
+namespace {
+
+DeviceInfo makeDevice(const juce::String& name) {
+    DeviceInfo device;
+    device.name = name;
+    device.pluginId = "eq";
+    device.format = PluginFormat::Internal;
+    return device;
+}
+
+/**
+ * @brief Give a rack `chains` chains, each with a device and (above the last level) a nested
+ *        rack built the same way
+ */
+void buildRackTree(TrackManager& tm, const ChainNodePath& rackPath, int depth, int chains) {
+    for (int c = 0; c < chains; ++c) {
+        const auto chainPath = rackPath.withChain(tm.addChainToRack(rackPath));
+        tm.addDeviceToChainByPath(chainPath, makeDevice("EQ"));
+
+        if (depth > 1) {
+            const auto nested = chainPath.withRack(tm.addRackToChainByPath(chainPath));
+            buildRackTree(tm, nested, depth - 1, chains);
+        }
+    }
+}
+
+int countMods(TrackManager& tm) {
+    int mods = 0;
+    tm.forEachMod([&](ModOwner, int, int, ModInfo&) { ++mods; });
+    return mods;
+}
+
+AutomationTarget makeVolumeTarget(TrackId trackId) {
+    AutomationTarget target;
+    target.type = AutomationTargetType::TrackVolume;
+    target.trackId = trackId;
+    return target;
+}
+
+}  // namespace
+
+// ============================================================================
+// TrackManager
+// ============================================================================
+
+TEST_CASE("Benchmark - TrackManager::updateAllMods over large rack trees",
+          "[.][benchmark][modulation]") {
+    auto& tm = TrackManager::getInstance();
+    tm.clearAllTracks();
+
+    // 16 tracks x (device + rack four deep, two chains per rack): 15 racks and 31 devices
+    // per track, each with the default mods
+    for (int t = 0; t < 16; ++t) {
+        const auto trackId = tm.createTrack("Bench " + juce::String(t));
+        tm.addDeviceToTrack(trackId, makeDevice("Synth"));
+        buildRackTree(tm, ChainNodePath::rack(trackId, tm.addRackToTrack(trackId)), 4, 2);
+    }
+    REQUIRE(countMods(tm) == 16 * (15 + 31) * NUM_MODS);
+
+    BENCHMARK("updateAllMods, one 60 Hz frame") {
+        tm.updateAllMods(1.0 / 60.0, 120.0);
+        return tm.getNumTracks();
+    };
+
+    tm.clearAllTracks();
+}
+
+// ============================================================================
+// AutomationManager
+// ============================================================================
+
+TEST_CASE("Benchmark - AutomationManager::getValueAtTime over long lanes",
+          "[.][benchmark][automation]") {
+    auto& am = AutomationManager::getInstance();
+    am.clearAll();
+
+    constexpr int kNumPoints = 10000;
+    constexpr double kLaneLength = 600.0;  // Ten minutes
+    const auto laneId = am.createLane(makeVolumeTarget(1), AutomationLaneType::Absolute);
+    for (int i = 0; i < kNumPoints; ++i) {
+        am.addPoint(laneId, i * (kLaneLength / kNumPoints), (i % 7) / 6.0);
+    }
+    REQUIRE(am.getLane(laneId)->absolutePoints.size() >= kNumPoints);
+
+    BENCHMARK("Sequential reads, 1000 per lane sweep") {
+        double sum = 0.0;
+        for (int i = 0; i < 1000; ++i) {
+            sum += am.getValueAtTime(laneId, i * (kLaneLength / 1000.0));
+        }
+        return sum;
+    };
+
+    BENCHMARK("Random reads, 1000") {
+        double sum = 0.0;
+        uint32_t seed = 12345;
+        for (int i = 0; i < 1000; ++i) {
+            seed = seed * 1664525u + 1013904223u;  // LCG: reproducible, no <random> setup
+            sum += am.getValueAtTime(laneId, (seed >> 8) % 600000 / 1000.0);
+        }
+        return sum;
+    };
+
+    std::vector<float> buffer(512);
+    BENCHMARK("renderValues, 512-sample block") {
+        am.renderValues(laneId, 100.0, 100.0 + 512 / 48000.0, buffer.data(), 512);
+        return buffer[511];
+    };
+
+    am.clearAll();
+}
+
+// ============================================================================
+// ClipManager
+// ============================================================================
+
+TEST_CASE("Benchmark - ClipManager range queries", "[.][benchmark][clip]") {
+    auto& cm = ClipManager::getInstance();
+    cm.shutdown();
+
+    // 32 tracks of 500 back-to-back clips
+    constexpr int kNumTracks = 32;
+    constexpr int kClipsPerTrack = 500;
+    for (TrackId t = 1; t <= kNumTracks; ++t) {
+        for (int c = 0; c < kClipsPerTrack; ++c) {
+            cm.createMidiClip(t, c * 2.0, 2.0);
+        }
+    }
+    cm.flushPendingChanges();
+    REQUIRE(cm.getClipsInRange(1, 0.0, kClipsPerTrack * 2.0).size() == kClipsPerTrack);
+
+    BENCHMARK("getClipsInRange, visible window on every track") {
+        size_t found = 0;
+        for (TrackId t = 1; t <= kNumTracks; ++t) {
+            found += cm.getClipsInRange(t, 400.0, 440.0).size();
+        }
+        return found;
+    };
+
+    BENCHMARK("getClipAtPosition, 1000 lookups") {
+        int found = 0;
+        for (int i = 0; i < 1000; ++i) {
+            found += cm.getClipAtPosition(1 + i % kNumTracks, i * 0.97) != INVALID_CLIP_ID;
+        }
+        return found;
+    };
+
+    BENCHMARK("getClipsOnTrack") {
+        return cm.getClipsOnTrack(kNumTracks / 2).size();
+    };
+
+    cm.shutdown();
+}
+
+// ============================================================================
+// ParameterUtils
+// ============================================================================
+
+TEST_CASE("Benchmark - ParameterUtils conversions", "[.][benchmark][parameter]") {
+    const auto frequency = ParameterPresets::frequency(0, "Cutoff");
+    const auto decibels = ParameterPresets::decibels(1, "Gain");
+    const auto discrete = ParameterPresets::discrete(2, "Mode", {"A", "B", "C", "D"});
+    REQUIRE(ParameterUtils::normalizedToReal(1.0f, frequency) > 1000.0f);
+
+    BENCHMARK("normalizedToReal, 1000 frequency values") {
+        float sum = 0.0f;
+        for (int i = 0; i < 1000; ++i) {
+            sum += ParameterUtils::normalizedToReal(i / 999.0f, frequency);
+        }
+        return sum;
+    };
+
+    BENCHMARK("ParameterConversion, 1000 frequency values") {
+        const ParameterConversion conversion(frequency);
+        float sum = 0.0f;
+        for (int i = 0; i < 1000; ++i) {
+            sum += conversion.toReal(i / 999.0f);
+        }
+        return sum;
+    };
+
+    std::vector<float> sweep(1000);
+    for (size_t i = 0; i < sweep.size(); ++i) {
+        sweep[i] = static_cast<float>(i) / 999.0f;
+    }
+    std::vector<float> converted(sweep.size());
+
+    BENCHMARK("ParameterConversion array, 1000 frequency values") {
+        const ParameterConversion conversion(frequency);
+        conversion.toReal(sweep.data(), converted.data(), static_cast<int>(sweep.size()));
+        return converted.back();
+    };
+
+    ParameterConversion tabled(frequency);
+    tabled.buildTable();
+    BENCHMARK("ParameterConversion table, 1000 frequency values") {
+        tabled.toReal(sweep.data(), converted.data(), static_cast<int>(sweep.size()));
+        return converted.back();
+    };
+
+    BENCHMARK("realToNormalized, 1000 dB values") {
+        float sum = 0.0f;
+        for (int i = 0; i < 1000; ++i) {
+            sum += ParameterUtils::realToNormalized(-60.0f + i * 0.066f, decibels);
+        }
+        return sum;
+    };
+
+    BENCHMARK("Discrete round trip, 1000 values") {
+        float sum = 0.0f;
+        for (int i = 0; i < 1000; ++i) {
+            const float real = ParameterUtils::normalizedToReal(i / 999.0f, discrete);
+            sum += ParameterUtils::realToNormalized(real, discrete);
+        }
+        return sum;
+    };
+
+    BENCHMARK("applyModulation, 1000 bipolar") {
+        float sum = 0.0f;
+        for (int i = 0; i < 1000; ++i) {
+            sum += ParameterUtils::applyModulation(0.5f, i / 999.0f, 0.3f, true);
+        }
+        return sum;
+    };
+}
+
+// ============================================================================
+// ParameterQueue
+// ============================================================================
+
+TEST_CASE("Benchmark - ParameterQueue push/pop throughput", "[.][benchmark][parameter]") {
+    constexpr int kBatch = ParameterQueue::kQueueSize - 1;  // One slot is always empty
+
+    ParameterQueue queue;
+    BENCHMARK("ParameterQueue, fill then drain") {
+        ParameterChange change;
+        for (int i = 0; i < kBatch; ++i) {
+            change.deviceId = i % 32;
+            change.paramIndex = i % 16;
+            change.value = i / float(kBatch);
+            queue.push(change);
+        }
+        int popped = 0;
+        while (queue.pop(change)) {
+            ++popped;
+        }
+        return popped;
+    };
+
+    CoalescingParameterQueue coalescing;
+    BENCHMARK("CoalescingParameterQueue, fill then drain") {
+        ParameterChange change;
+        for (int i = 0; i < kBatch; ++i) {
+            change.deviceId = i % 32;
+            change.paramIndex = i % 16;
+            change.value = i / float(kBatch);
+            coalescing.push(change);
+        }
+        return coalescing.popAll([](const ParameterChange&) {});
+    };
+
+    // Sanity: a full batch fits the ring, and coalescing leaves one change per parameter
+    ParameterChange change;
+    for (int i = 0; i < kBatch; ++i) {
+        change.deviceId = i % 32;
+        change.paramIndex = i % 16;
+        REQUIRE(queue.push(change));
+        coalescing.push(change);
+    }
+    REQUIRE(coalescing.popAll([](const ParameterChange&) {}) == 32);
+}
@@ -1,8 +1,12 @@
 #include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
 
+#include <cmath>
+
+#include "../magda/daw/audio/AudioModulator.hpp"
 #include "../magda/daw/core/MacroInfo.hpp"
 #include "../magda/daw/core/ModInfo.hpp"
+#include "../magda/daw/core/ModulatorEngine.hpp"
 #include "../magda/daw/core/TrackManager.hpp"
 
 using namespace magda;
@@ -135,6 +139,46 @@ TEST_CASE("MacroInfo - Link uniqueness", "[modulation][macro]") {
     }
 }
 
+TEST_CASE("MacroLink - Range and curve shaping", "[modulation][macro]") {
+    MacroLink link{MacroTarget{DeviceId(42), 0}, 0.5f};
+
+    SECTION("Default link is linear over the whole knob") {
+        REQUIRE(link.getContribution(0.0f) == Catch::Approx(0.0f));
+        REQUIRE(link.getContribution(0.5f) == Catch::Approx(0.25f));
+        REQUIRE(link.getContribution(1.0f) == Catch::Approx(0.5f));
+    }
+
+    SECTION("Range clamps outside and scales inside") {
+        link.rangeStart = 0.25f;
+        link.rangeEnd = 0.75f;
+        REQUIRE(link.getContribution(0.1f) == Catch::Approx(0.0f));
+        REQUIRE(link.getContribution(0.5f) == Catch::Approx(0.25f));
+        REQUIRE(link.getContribution(0.9f) == Catch::Approx(0.5f));
+    }
+
+    SECTION("Reversed range inverts the link") {
+        link.rangeStart = 1.0f;
+        link.rangeEnd = 0.0f;
+        REQUIRE(link.getContribution(0.0f) == Catch::Approx(0.5f));
+        REQUIRE(link.getContribution(1.0f) == Catch::Approx(0.0f));
+    }
+
+    SECTION("Curves keep their end points") {
+        for (auto curve : {MacroCurve::Linear, MacroCurve::Exponential, MacroCurve::Logarithmic,
+                           MacroCurve::SCurve}) {
+            REQUIRE(shapeMacroValue(0.0f, 0.0f, 1.0f, curve) == Catch::Approx(0.0f));
+            REQUIRE(shapeMacroValue(1.0f, 0.0f, 1.0f, curve) == Catch::Approx(1.0f));
+        }
+        REQUIRE(shapeMacroValue(0.5f, 0.0f, 1.0f, MacroCurve::Exponential) ==
+                Catch::Approx(0.25f));
+        REQUIRE(shapeMacroValue(0.5f, 0.0f, 1.0f, MacroCurve::Logarithmic) ==
+                Catch::Approx(0.75f));
+        REQUIRE(shapeMacroValue(0.5f, 0.0f, 1.0f, MacroCurve::SCurve) == Catch::Approx(0.5f));
+        REQUIRE(shapeMacroValue(0.25f, 0.0f, 1.0f, MacroCurve::SCurve) <
+                shapeMacroValue(0.25f, 0.0f, 1.0f, MacroCurve::Linear));
+    }
+}
+
 // ============================================================================
 // ModInfo Tests
 // ============================================================================
@@ -417,6 +461,20 @@ TEST_CASE("TrackManager - Rack macro operations", "[modulation][macro][integrati
         REQUIRE(rack->macros[1].getLink(target2)->amount == Catch::Approx(0.6f));
     }
 
+    SECTION("Set rack macro link shape") {
+        MacroTarget target{DeviceId(100), 3};
+        trackManager.setRackMacroLinkAmount(rackPath, 0, target, 1.0f);
+        trackManager.setRackMacroLinkShape(rackPath, 0, target, 0.2f, 1.5f,
+                                           MacroCurve::Exponential);
+
+        auto* rack = trackManager.getRackByPath(rackPath);
+        const auto* link = rack->macros[0].getLink(target);
+        REQUIRE(link != nullptr);
+        REQUIRE(link->rangeStart == Catch::Approx(0.2f));
+        REQUIRE(link->rangeEnd == Catch::Approx(1.0f));  // Clamped
+        REQUIRE(link->curve == MacroCurve::Exponential);
+    }
+
     SECTION("Set rack macro name") {
         trackManager.setRackMacroName(rackPath, 2, "Mix");
 
@@ -479,6 +537,60 @@ TEST_CASE("TrackManager - Device mod operations", "[modulation][mod][integration
     trackManager.deleteTrack(trackId);
 }
 
+TEST_CASE("TrackManager - Modulation sources by parameter", "[modulation][integration]") {
+    auto& trackManager = TrackManager::getInstance();
+
+    TrackId trackId = trackManager.createTrack();
+    DeviceInfo testDevice;
+    testDevice.name = "TestDevice";
+    DeviceId deviceId = trackManager.addDeviceToTrack(trackId, testDevice);
+    RackId rackId = trackManager.addRackToTrack(trackId, "TestRack");
+
+    ChainNodePath devicePath;
+    devicePath.trackId = trackId;
+    devicePath.topLevelDeviceId = deviceId;
+    ChainNodePath rackPath;
+    rackPath.trackId = trackId;
+    rackPath.steps.push_back({ChainStepType::Rack, rackId});
+
+    REQUIRE(trackManager.getModulationSources(deviceId, 3).empty());
+
+    // Device mod, device macro and rack macro on one parameter; a rack mod on another
+    trackManager.setDeviceModLinkAmount(devicePath, 1, ModTarget{deviceId, 3}, 0.4f);
+    trackManager.setDeviceMacroLinkAmount(devicePath, 2, MacroTarget{deviceId, 3}, 0.7f);
+    trackManager.setRackMacroLinkAmount(rackPath, 0, MacroTarget{deviceId, 3}, 0.2f);
+    trackManager.setRackModLinkAmount(rackPath, 5, ModTarget{deviceId, 6}, 0.9f);
+
+    const auto& sources = trackManager.getModulationSources(deviceId, 3);
+    REQUIRE(sources.mods.size() == 1);
+    REQUIRE(sources.mods[0].owner == ModOwner::Device);
+    REQUIRE(sources.mods[0].ownerId == deviceId);
+    REQUIRE(sources.mods[0].modIndex == 1);
+    REQUIRE(sources.mods[0].link.amount == Catch::Approx(0.4f));
+    REQUIRE(sources.macros.size() == 2);
+
+    const auto& other = trackManager.getModulationSources(deviceId, 6);
+    REQUIRE(other.macros.empty());
+    REQUIRE(other.mods.size() == 1);
+    REQUIRE(other.mods[0].owner == ModOwner::Rack);
+    REQUIRE(other.mods[0].ownerId == rackId);
+    REQUIRE(other.mods[0].trackId == trackId);
+
+    // Link edits are seen on the next lookup
+    trackManager.setDeviceModLinkAmount(devicePath, 1, ModTarget{deviceId, 3}, 0.8f);
+    REQUIRE(trackManager.getModulationSources(deviceId, 3).mods[0].link.amount ==
+            Catch::Approx(0.8f));
+    trackManager.removeDeviceModLink(devicePath, 1, ModTarget{deviceId, 3});
+    trackManager.removeDeviceMacroLink(devicePath, 2, MacroTarget{deviceId, 3});
+    REQUIRE(trackManager.getModulationSources(deviceId, 3).mods.empty());
+    REQUIRE(trackManager.getModulationSources(deviceId, 3).macros.size() == 1);
+
+    // And so is the track going away
+    trackManager.deleteTrack(trackId);
+    REQUIRE(trackManager.getModulationSources(deviceId, 3).empty());
+    REQUIRE(trackManager.getModulationSources(deviceId, 6).empty());
+}
+
 TEST_CASE("TrackManager - Rack vs Device macro isolation", "[modulation][macro][integration]") {
     auto& trackManager = TrackManager::getInstance();
 
@@ -584,3 +696,249 @@ TEST_CASE("TrackManager - Modulation calculation scenarios", "[modulation][integ
     // Cleanup
     trackManager.deleteTrack(trackId);
 }
+
+// ============================================================================
+// ModulatorEngine Batch Evaluation Tests
+// ============================================================================
+
+TEST_CASE("ModulatorEngine - Batch waveforms match scalar", "[modulation][mod][batch]") {
+    constexpr int numPhases = 1000;
+    std::vector<float> phases(numPhases);
+    for (int i = 0; i < numPhases; ++i) {
+        phases[static_cast<size_t>(i)] = static_cast<float>(i) / numPhases;
+    }
+    std::vector<float> out(numPhases);
+
+    SECTION("Single waveform over many phases") {
+        for (auto waveform : {LFOWaveform::Sine, LFOWaveform::Triangle, LFOWaveform::Square,
+                              LFOWaveform::Saw, LFOWaveform::ReverseSaw}) {
+            ModulatorEngine::generateWaveformBatch(waveform, phases.data(), out.data(),
+                                                   numPhases);
+            for (int i = 0; i < numPhases; ++i) {
+                auto index = static_cast<size_t>(i);
+                REQUIRE(std::abs(out[index] -
+                                 ModulatorEngine::generateWaveform(waveform, phases[index])) <=
+                        ModulatorEngine::kBatchMaxError);
+            }
+        }
+    }
+
+    SECTION("Mixed waveforms per lane") {
+        std::vector<LFOWaveform> waveforms(numPhases);
+        for (int i = 0; i < numPhases; ++i) {
+            waveforms[static_cast<size_t>(i)] = static_cast<LFOWaveform>(i % 6);
+        }
+        ModulatorEngine::generateWaveformBatch(waveforms.data(), phases.data(), out.data(),
+                                               numPhases);
+        for (int i = 0; i < numPhases; ++i) {
+            auto index = static_cast<size_t>(i);
+            REQUIRE(std::abs(out[index] - ModulatorEngine::generateWaveform(waveforms[index],
+                                                                            phases[index])) <=
+                    ModulatorEngine::kBatchMaxError);
+        }
+    }
+
+    SECTION("Curve presets") {
+        for (auto preset : {CurvePreset::Triangle, CurvePreset::Sine, CurvePreset::RampUp,
+                            CurvePreset::RampDown, CurvePreset::SCurve, CurvePreset::Exponential,
+                            CurvePreset::Logarithmic}) {
+            ModulatorEngine::generateCurvePresetBatch(preset, phases.data(), out.data(),
+                                                      numPhases);
+            for (int i = 0; i < numPhases; ++i) {
+                auto index = static_cast<size_t>(i);
+                REQUIRE(std::abs(out[index] -
+                                 ModulatorEngine::generateCurvePreset(preset, phases[index])) <=
+                        ModulatorEngine::kBatchMaxError);
+            }
+        }
+    }
+}
+
+TEST_CASE("ModulatorEngine - Baked curve tables", "[modulation][mod][batch]") {
+    ModInfo mod(0);
+    mod.waveform = LFOWaveform::Custom;
+
+    std::vector<float> table(ModulatorEngine::kCurveTableSize + 1);
+
+    SECTION("Custom points follow direct evaluation") {
+        mod.curvePoints = {{0.0f, 0.0f, 0.0f}, {0.3f, 1.0f, 1.5f}, {0.7f, 0.2f, -1.0f}};
+        ModulatorEngine::bakeCurveTable(mod, table.data());
+
+        for (int i = 0; i <= 200; ++i) {
+            float phase = static_cast<float>(i) / 200.0f;
+            float direct = ModulatorEngine::evaluateCurvePoints(mod.curvePoints, phase);
+            REQUIRE(ModulatorEngine::lookupCurveTable(table.data(), phase) ==
+                    Catch::Approx(direct).margin(0.01));
+        }
+    }
+
+    SECTION("Preset is used when there are no points") {
+        mod.curvePreset = CurvePreset::RampUp;
+        ModulatorEngine::bakeCurveTable(mod, table.data());
+
+        REQUIRE(ModulatorEngine::lookupCurveTable(table.data(), 0.0f) == Catch::Approx(0.0f));
+        REQUIRE(ModulatorEngine::lookupCurveTable(table.data(), 0.5f) == Catch::Approx(0.5f));
+        REQUIRE(ModulatorEngine::lookupCurveTable(table.data(), 1.0f) == Catch::Approx(1.0f));
+    }
+}
+
+TEST_CASE("ModulatorEngine - Envelope stages", "[modulation][mod][envelope]") {
+    auto stage = ModulatorEngine::EnvelopeStage::Idle;
+    float level = 0.0f;
+    auto step = [&](bool trigger, bool gate, double dt) {
+        return ModulatorEngine::advanceEnvelope(stage, level, trigger, gate, 0.1f, 0.2f, 0.5f,
+                                                0.4f, dt);
+    };
+
+    SECTION("Attack, decay to sustain, release to idle") {
+        REQUIRE(step(true, true, 0.05) == Catch::Approx(0.5f));
+        REQUIRE(stage == ModulatorEngine::EnvelopeStage::Attack);
+
+        // Rest of the attack, then half of the decay
+        REQUIRE(step(false, true, 0.1) == Catch::Approx(0.875f));
+        REQUIRE(stage == ModulatorEngine::EnvelopeStage::Decay);
+
+        REQUIRE(step(false, true, 1.0) == Catch::Approx(0.5f));
+        REQUIRE(stage == ModulatorEngine::EnvelopeStage::Sustain);
+
+        REQUIRE(step(false, false, 0.1) == Catch::Approx(0.25f));
+        REQUIRE(stage == ModulatorEngine::EnvelopeStage::Release);
+
+        REQUIRE(step(false, false, 1.0) == Catch::Approx(0.0f));
+        REQUIRE(stage == ModulatorEngine::EnvelopeStage::Idle);
+    }
+
+    SECTION("Retrigger continues from the current level") {
+        step(true, true, 1.0);
+        step(false, false, 0.1);
+        REQUIRE(level == Catch::Approx(0.25f));
+
+        REQUIRE(step(true, true, 0.025) == Catch::Approx(0.5f));
+        REQUIRE(stage == ModulatorEngine::EnvelopeStage::Attack);
+    }
+
+    SECTION("Zero-length stages are passed straight through") {
+        REQUIRE(ModulatorEngine::advanceEnvelope(stage, level, true, true, 0.0f, 0.0f, 0.3f,
+                                                 0.0f, 0.001) == Catch::Approx(0.3f));
+        REQUIRE(stage == ModulatorEngine::EnvelopeStage::Sustain);
+        REQUIRE(ModulatorEngine::advanceEnvelope(stage, level, false, false, 0.0f, 0.0f, 0.3f,
+                                                 0.0f, 0.001) == Catch::Approx(0.0f));
+        REQUIRE(stage == ModulatorEngine::EnvelopeStage::Idle);
+    }
+}
+
+TEST_CASE("ModulatorEngine - Follower, random and input triggers", "[modulation][mod]") {
+    SECTION("Follower rises with attack and falls with release") {
+        const float up = ModulatorEngine::followLevel(0.0f, 1.0f, 0.01f, 1.0f, 0.01);
+        REQUIRE(up == Catch::Approx(1.0f - std::exp(-1.0f)));
+        const float down = ModulatorEngine::followLevel(1.0f, 0.0f, 0.01f, 1.0f, 0.01);
+        REQUIRE(down > 0.98f);
+        REQUIRE(ModulatorEngine::followLevel(0.2f, 0.8f, 0.0f, 0.0f, 0.01) == 0.8f);
+    }
+
+    SECTION("Random values stay in range and glide when smoothed") {
+        uint32_t state = 12345u;
+        for (int i = 0; i < 1000; ++i) {
+            const float value = ModulatorEngine::nextRandom(state);
+            REQUIRE(value >= 0.0f);
+            REQUIRE(value < 1.0f);
+        }
+        REQUIRE(ModulatorEngine::smoothRandom(0.0f, 1.0f, 0.1f, 0.0f) == 1.0f);
+        REQUIRE(ModulatorEngine::smoothRandom(0.0f, 1.0f, 0.25f, 0.5f) == Catch::Approx(0.5f));
+        REQUIRE(ModulatorEngine::smoothRandom(0.0f, 1.0f, 0.6f, 0.5f) == 1.0f);
+    }
+
+    SECTION("MIDI and Audio modes follow the track's input") {
+        REQUIRE(ModulatorEngine::shouldTrigger(LFOTriggerMode::MIDI, true, false, true, false));
+        REQUIRE_FALSE(ModulatorEngine::shouldTrigger(LFOTriggerMode::MIDI, true, false));
+        REQUIRE(ModulatorEngine::shouldTrigger(LFOTriggerMode::Audio, false, false, false, true));
+        REQUIRE_FALSE(
+            ModulatorEngine::shouldTrigger(LFOTriggerMode::Audio, false, false, true, false));
+    }
+}
+
+TEST_CASE("AudioModulator - Mod resolution", "[modulation][mod]") {
+    ModInfo mod(0);
+    mod.rate = 0.5f;
+
+    SECTION("Auto puts slow LFOs and random mods on control rate") {
+        REQUIRE(AudioModulator::runsAtControlRate(mod));
+        mod.type = ModType::Random;
+        REQUIRE(AudioModulator::runsAtControlRate(mod));
+        mod.rate = 8.0f;
+        REQUIRE_FALSE(AudioModulator::runsAtControlRate(mod));
+    }
+
+    SECTION("Auto keeps envelopes and followers on every block") {
+        mod.type = ModType::Envelope;
+        REQUIRE_FALSE(AudioModulator::runsAtControlRate(mod));
+        mod.type = ModType::Follower;
+        REQUIRE_FALSE(AudioModulator::runsAtControlRate(mod));
+    }
+
+    SECTION("Tempo-synced rates are judged at 120 BPM") {
+        mod.tempoSync = true;
+        mod.syncDivision = SyncDivision::Sixteenth;
+        REQUIRE_FALSE(AudioModulator::runsAtControlRate(mod));
+    }
+
+    SECTION("An explicit resolution wins") {
+        mod.resolution = ModResolution::Block;
+        REQUIRE_FALSE(AudioModulator::runsAtControlRate(mod));
+        mod.type = ModType::Envelope;
+        mod.resolution = ModResolution::Control;
+        REQUIRE(AudioModulator::runsAtControlRate(mod));
+    }
+}
+
+TEST_CASE("AudioModulator - Notes reach envelopes on tracks with high ids", "[modulation][mod]") {
+    auto& trackManager = TrackManager::getInstance();
+
+    // A long session: ids keep growing while few tracks are alive
+    TrackId trackId = trackManager.createTrack();
+    while (trackId < 300) {
+        trackManager.deleteTrack(trackId);
+        trackId = trackManager.createTrack();
+    }
+
+    DeviceInfo testDevice;
+    testDevice.name = "TestDevice";
+    DeviceId deviceId = trackManager.addDeviceToTrack(trackId, testDevice);
+    ChainNodePath devicePath;
+    devicePath.trackId = trackId;
+    devicePath.topLevelDeviceId = deviceId;
+    trackManager.setDeviceModType(devicePath, 0, ModType::Envelope);
+
+    AudioModulator modulator;
+    modulator.compile(trackManager, [](DeviceId, int, AudioModulator::ResolvedTarget&) {
+        return false;
+    });
+
+    auto playNote = [&] {
+        modulator.noteInput(trackId, 1, 60, true);
+        modulator.process(512, 48000.0, {});
+        REQUIRE(modulator.readBack(trackManager));
+        return trackManager.getDeviceInChainByPath(devicePath)->mods[0];
+    };
+
+    SECTION("A track without note state ignores notes") {
+        const auto mod = playNote();
+        REQUIRE_FALSE(mod.triggered);
+        REQUIRE(mod.value == 0.0f);
+    }
+
+    SECTION("An added track triggers its envelopes") {
+        modulator.addTrack(trackId);
+        const auto mod = playNote();
+        REQUIRE(mod.triggered);
+        REQUIRE(mod.value > 0.0f);
+    }
+
+    SECTION("A removed track stops triggering") {
+        modulator.addTrack(trackId);
+        modulator.removeTrack(trackId);
+        REQUIRE_FALSE(playNote().triggered);
+    }
+
+    trackManager.deleteTrack(trackId);
+}
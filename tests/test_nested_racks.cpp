@@ -1,6 +1,7 @@
 #include <juce_core/juce_core.h>
 
 #include <catch2/catch_test_macros.hpp>
+#include <utility>
 
 #include "../magda/daw/core/RackInfo.hpp"
 #include "../magda/daw/core/SelectionManager.hpp"
@@ -926,3 +927,164 @@ TEST_CASE("TrackManager: Rack Bypass Operations", "[trackmanager][rack][bypass]"
         REQUIRE_FALSE(rack->bypassed);
     }
 }
+
+// ============================================================================
+// Copy-on-write chain tree
+// ============================================================================
+
+TEST_CASE("ChainElement copies share nodes until edited", "[rack][cow]") {
+    // Track chain: [EQ, Rack[Chain[Comp]], Limiter]
+    std::vector<ChainElement> elements;
+    DeviceInfo eq;
+    eq.id = 1;
+    eq.name = "EQ";
+    elements.push_back(makeDeviceElement(eq));
+
+    DeviceInfo comp;
+    comp.id = 2;
+    comp.name = "Comp";
+    ChainInfo chain;
+    chain.id = 1;
+    chain.elements.push_back(makeDeviceElement(comp));
+    RackInfo rack;
+    rack.id = 10;
+    rack.chains.push_back(chain);
+    elements.push_back(makeRackElement(rack));
+
+    DeviceInfo limiter;
+    limiter.id = 3;
+    limiter.name = "Limiter";
+    elements.push_back(makeDeviceElement(limiter));
+
+    auto sameNode = [](const ChainElement& a, const ChainElement& b) {
+        if (isDevice(a) && isDevice(b)) {
+            return std::get<CowPtr<DeviceInfo>>(a).sharesNodeWith(std::get<CowPtr<DeviceInfo>>(b));
+        }
+        if (isRack(a) && isRack(b)) {
+            return std::get<CowPtr<RackInfo>>(a).sharesNodeWith(std::get<CowPtr<RackInfo>>(b));
+        }
+        return false;
+    };
+
+    auto snapshot = elements;
+
+    SECTION("A copy shares every node") {
+        for (size_t i = 0; i < elements.size(); ++i) {
+            REQUIRE(sameNode(elements[i], snapshot[i]));
+        }
+    }
+
+    SECTION("Const access and id checks don't unshare") {
+        const auto& constElements = elements;
+        REQUIRE(getDevice(constElements[0]).name == "EQ");
+        REQUIRE(isRackWithId(elements[1], 10));
+        REQUIRE(isDeviceWithId(elements[2], 3));
+        REQUIRE(sameNode(elements[1], snapshot[1]));
+        REQUIRE(sameNode(elements[2], snapshot[2]));
+    }
+
+    SECTION("Editing a nested device copies only its path") {
+        getDevice(getRack(elements[1]).chains[0].elements[0]).bypassed = true;
+
+        // The snapshot still sees the old value
+        const auto& snapshotRack = getRack(std::as_const(snapshot[1]));
+        const auto& snapshotComp = getDevice(snapshotRack.chains[0].elements[0]);
+        REQUIRE_FALSE(snapshotComp.bypassed);
+
+        // The rack on the path was copied; its siblings are still shared
+        REQUIRE_FALSE(sameNode(elements[1], snapshot[1]));
+        REQUIRE(sameNode(elements[0], snapshot[0]));
+        REQUIRE(sameNode(elements[2], snapshot[2]));
+    }
+}
+
+// ============================================================================
+// Id Lookup Tests
+// ============================================================================
+
+TEST_CASE("TrackManager: Id lookups follow structural edits", "[trackmanager][index]") {
+    TrackManagerTestFixture fixture;
+    auto& tm = fixture.tm();
+
+    auto first = tm.createTrack("First");
+    auto second = tm.createTrack("Second");
+
+    DeviceInfo eq;
+    eq.name = "EQ";
+    auto eqId = tm.addDeviceToTrack(second, eq);
+
+    auto rackId = tm.addRackToTrack(second, "Rack");
+    auto chainId = tm.getRack(second, rackId)->chains[0].id;
+    auto chainPath = ChainNodePath::chain(second, rackId, chainId);
+
+    DeviceInfo comp;
+    comp.name = "Comp";
+    auto compId = tm.addDeviceToChainByPath(chainPath, comp);
+
+    SECTION("Tracks are found after deletes and moves") {
+        tm.deleteTrack(first);
+        REQUIRE(tm.getTrack(first) == nullptr);
+        REQUIRE(tm.getTrackIndex(second) == 0);
+
+        auto third = tm.createTrack("Third");
+        tm.moveTrack(third, 0);
+        REQUIRE(tm.getTrackIndex(third) == 0);
+        REQUIRE(tm.getTrack(second)->name == "Second");
+    }
+
+    SECTION("Devices are found at any depth") {
+        REQUIRE(tm.findDevice(eqId)->name == "EQ");
+        REQUIRE(tm.findDevice(compId)->name == "Comp");
+        REQUIRE(tm.getDevice(second, eqId) != nullptr);
+        REQUIRE(tm.getDevice(second, compId) == nullptr);  // Not top-level
+        REQUIRE(tm.getChain(second, rackId, chainId)->id == chainId);
+    }
+
+    SECTION("Device paths resolve back to the device") {
+        auto topPath = tm.findDevicePath(eqId);
+        REQUIRE(topPath.getType() == ChainNodeType::TopLevelDevice);
+        REQUIRE(tm.getDeviceInChainByPath(topPath)->id == eqId);
+
+        auto nestedPath = tm.findDevicePath(compId);
+        REQUIRE(nestedPath == chainPath.withDevice(compId));
+        REQUIRE(tm.getDeviceInChainByPath(nestedPath)->name == "Comp");
+
+        REQUIRE_FALSE(tm.findDevicePath(9999).isValid());
+    }
+
+    SECTION("Lookups follow moves and removals") {
+        tm.moveNode(second, 0, 1);  // Rack now comes first
+        REQUIRE(tm.findDevice(eqId)->name == "EQ");
+        REQUIRE(tm.findDevicePath(compId) == chainPath.withDevice(compId));
+
+        tm.removeDeviceFromTrack(second, eqId);
+        REQUIRE(tm.findDevice(eqId) == nullptr);
+        REQUIRE(tm.findDevice(compId) != nullptr);
+    }
+
+    SECTION("A duplicated track gets its own ids") {
+        tm.setRackMacroTarget(ChainNodePath::rack(second, rackId), 0, {compId, 2});
+
+        auto copy = tm.duplicateTrack(second);
+        REQUIRE(copy == tm.getTracks()[2].id);
+
+        // The original's devices stay where they were
+        REQUIRE(tm.findDevicePath(eqId).trackId == second);
+        REQUIRE(tm.getDevice(copy, eqId) == nullptr);
+        REQUIRE(tm.getRack(copy, rackId) == nullptr);
+
+        const auto& copyElements = tm.getTrack(copy)->chainElements;
+        const auto copyEqId = getDevice(copyElements[0]).id;
+        const auto& copyRack = getRack(copyElements[1]);
+        const auto copyCompId = getDevice(copyRack.chains[0].elements[0]).id;
+        REQUIRE(copyEqId != eqId);
+        REQUIRE(copyCompId != compId);
+        REQUIRE(copyRack.chains[0].id != chainId);
+        REQUIRE(tm.findDevicePath(copyEqId).trackId == copy);
+        REQUIRE(tm.findDevice(copyCompId)->name == "Comp");
+
+        // Links inside the copy follow its devices
+        REQUIRE(copyRack.macros[0].target == MacroTarget{copyCompId, 2});
+        REQUIRE(tm.getRack(second, rackId)->macros[0].target == MacroTarget{compId, 2});
+    }
+}
@@ -0,0 +1,139 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <memory>
+
+#include "../magda/daw/engine/OfflineRenderer.hpp"
+
+using namespace magda;
+
+namespace {
+
+// An empty single-track Edit with no bridge: enough to queue and reject jobs, no device
+struct RenderFixture {
+    juce::ScopedJuceInitialiser_GUI juceInit;
+    te::Engine engine{"MAGDA Tests"};
+    std::unique_ptr<te::Edit> edit = te::Edit::createSingleTrackEdit(engine);
+    OfflineRenderer renderer{*edit, nullptr, nullptr};
+    juce::TemporaryFile output{".wav"};
+
+    OfflineRenderer::RenderRequest makeRequest() const {
+        OfflineRenderer::RenderRequest request;
+        request.output_path = output.getFile().getFullPathName().toStdString();
+        request.start_seconds = 0.0;
+        request.end_seconds = 2.0;
+        return request;
+    }
+};
+
+using RenderStatus = OfflineRenderer::RenderStatus;
+
+}  // namespace
+
+// ============================================================================
+// Stem file names
+// ============================================================================
+
+TEST_CASE("OfflineRenderer - stem names are numbered in track order", "[render]") {
+    REQUIRE(OfflineRenderer::makeStemFileName(1, "Drums") == "01 Drums.wav");
+    REQUIRE(OfflineRenderer::makeStemFileName(12, "Bass") == "12 Bass.wav");
+}
+
+TEST_CASE("OfflineRenderer - stem names are file-safe", "[render]") {
+    REQUIRE(OfflineRenderer::makeStemFileName(3, "  Lead: Vox/Dbl  ") == "03 Lead VoxDbl.wav");
+    REQUIRE(OfflineRenderer::makeStemFileName(4, "") == "04 Track.wav");
+}
+
+// ============================================================================
+// Rejected requests
+// ============================================================================
+
+TEST_CASE("OfflineRenderer - requests that can't be rendered fail up front", "[render]") {
+    RenderFixture fixture;
+    auto request = fixture.makeRequest();
+
+    SECTION("No output path") {
+        request.output_path.clear();
+    }
+    SECTION("Empty range") {
+        request.start_seconds = request.end_seconds = 1.0;
+    }
+    SECTION("Reversed range") {
+        request.start_seconds = 3.0;
+        request.end_seconds = 1.0;
+    }
+    SECTION("To the end of an empty arrangement") {
+        request.end_seconds = -1.0;
+    }
+    SECTION("A track id that isn't a number") {
+        request.track_ids = {"drums"};
+    }
+    SECTION("Tracks with nothing to resolve them against") {
+        request.track_ids = {"7"};
+    }
+    SECTION("Stems with nothing to resolve the tracks against") {
+        request.stems = true;
+    }
+
+    bool finished = false;
+    const auto id = fixture.renderer.startRender(request, [&](const std::string&) {
+        finished = true;
+    });
+
+    // Rejected jobs keep an id and a reason, and never start
+    REQUIRE_FALSE(id.empty());
+    REQUIRE(fixture.renderer.getStatus(id) == RenderStatus::Failed);
+    REQUIRE_FALSE(fixture.renderer.getError(id).empty());
+    REQUIRE(fixture.renderer.getProgress(id) == 0.0);
+    REQUIRE(fixture.renderer.getRenderedFiles(id).empty());
+    REQUIRE_FALSE(fixture.renderer.isRendering());
+    REQUIRE_FALSE(finished);
+}
+
+TEST_CASE("OfflineRenderer - every request gets its own id", "[render]") {
+    RenderFixture fixture;
+    auto request = fixture.makeRequest();
+    request.output_path.clear();
+
+    const auto first = fixture.renderer.startRender(request);
+    const auto second = fixture.renderer.startRender(request);
+    REQUIRE(first != second);
+    REQUIRE(fixture.renderer.getStatus("render_unknown") == RenderStatus::Unknown);
+    REQUIRE(fixture.renderer.getError("render_unknown").empty());
+
+    // Unknown and failed jobs can be cancelled without effect
+    fixture.renderer.cancel("render_unknown");
+    fixture.renderer.cancel(first);
+    REQUIRE(fixture.renderer.getStatus(first) == RenderStatus::Failed);
+}
+
+// ============================================================================
+// Queue
+// ============================================================================
+
+TEST_CASE("OfflineRenderer - jobs run one at a time and queued ones can be cancelled",
+          "[render]") {
+    RenderFixture fixture;
+
+    const auto first = fixture.renderer.startRender(fixture.makeRequest());
+    REQUIRE(fixture.renderer.isRendering());
+    REQUIRE(fixture.renderer.getStatus(first) != RenderStatus::Queued);
+
+    // The first job only hands over once the message loop hears it has ended, so the
+    // second waits behind it however fast the first renders
+    bool secondFinished = false;
+    const auto second = fixture.renderer.startRender(
+        fixture.makeRequest(), [&](const std::string&) { secondFinished = true; });
+    REQUIRE(fixture.renderer.getStatus(second) == RenderStatus::Queued);
+    REQUIRE(fixture.renderer.getProgress(second) == 0.0);
+
+    fixture.renderer.cancel(second);
+    REQUIRE(fixture.renderer.getStatus(second) == RenderStatus::Cancelled);
+    REQUIRE(fixture.renderer.getRenderedFiles(second).empty());
+    REQUIRE_FALSE(secondFinished);
+
+    // Cancelling the running job stops it; the renderer still waits for it on destruction
+    fixture.renderer.cancelAll();
+    const auto progress = fixture.renderer.getProgress(first);
+    REQUIRE(progress >= 0.0);
+    REQUIRE(progress <= 1.0);
+}
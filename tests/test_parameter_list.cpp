@@ -0,0 +1,116 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "../magda/daw/core/DeviceInfo.hpp"
+#include "../magda/daw/core/ParameterList.hpp"
+
+using namespace magda;
+
+// ============================================================================
+// ParameterList Tests
+// ============================================================================
+// External plugins share their metadata per plugin type and keep only values
+// per device; a parameter becomes a full entry only once it's accessed mutably.
+
+namespace {
+
+std::shared_ptr<const ParameterList::Metadata> makeMetadata(int count) {
+    auto metadata = std::make_shared<ParameterList::Metadata>();
+    for (int i = 0; i < count; ++i) {
+        metadata->push_back(ParameterInfo(i, "Param " + juce::String(i), "dB", -24.0f, 24.0f,
+                                          0.0f));
+    }
+    return metadata;
+}
+
+}  // namespace
+
+TEST_CASE("ParameterList - Sparse values over shared metadata", "[device][parameters]") {
+    const auto metadata = makeMetadata(1000);
+    std::vector<float> values(1000, 0.0f);
+    values[500] = 6.0f;
+    ParameterList params(metadata, std::move(values));
+
+    REQUIRE(params.size() == 1000);
+    REQUIRE(params.getNumMaterialised() == 0);
+
+    SECTION("Reading never materialises") {
+        const auto& constParams = params;
+        const auto param = constParams[500];
+        REQUIRE(param.paramIndex == 500);
+        REQUIRE(param.name == "Param 500");
+        REQUIRE(param.unit == "dB");
+        REQUIRE(param.currentValue == 6.0f);
+
+        REQUIRE(params.getValue(500) == 6.0f);
+        params.setValue(10, -3.0f);
+        REQUIRE(constParams[10].currentValue == -3.0f);
+
+        int count = 0;
+        for (const auto& each : constParams) {
+            REQUIRE(each.paramIndex == count++);
+        }
+        REQUIRE(count == 1000);
+        REQUIRE(params.getNumMaterialised() == 0);
+    }
+
+    SECTION("Modifying a parameter materialises only it") {
+        params[42].currentValue = 12.0f;
+        params[42].name = "Renamed";
+
+        REQUIRE(params.getNumMaterialised() == 1);
+        REQUIRE(params.isMaterialised(42));
+        REQUIRE(params.getValue(42) == 12.0f);
+        REQUIRE(std::as_const(params)[42].name == "Renamed");
+
+        params.setValue(42, 1.0f);
+        REQUIRE(params[42].currentValue == 1.0f);
+
+        // The shared metadata is untouched
+        REQUIRE((*metadata)[42].name == "Param 42");
+    }
+
+    SECTION("Copies share the metadata, not the entries") {
+        ParameterList copy = params;
+        copy[7].currentValue = 3.0f;
+        REQUIRE(params.getValue(7) == 0.0f);
+        REQUIRE(params.getNumMaterialised() == 0);
+    }
+
+    SECTION("Holds much less than a full list") {
+        REQUIRE(params.estimateHeapBytes() < 1000 * sizeof(ParameterInfo) / 4);
+    }
+}
+
+TEST_CASE("ParameterList - Built with push_back holds every entry", "[device][parameters]") {
+    ParameterList params;
+    params.push_back(ParameterInfo(0, "Frequency", "Hz", 20.0f, 20000.0f, 440.0f));
+    params.push_back(ParameterInfo(1, "Level", "dB", -60.0f, 0.0f, -6.0f));
+    params[1].currentValue = -12.0f;
+
+    REQUIRE(params.size() == 2);
+    REQUIRE(params.getNumMaterialised() == 2);
+    REQUIRE(params.getValue(0) == 0.5f);  // ParameterInfo's default current value
+    REQUIRE(params.getValue(1) == -12.0f);
+    REQUIRE(std::as_const(params)[1].name == "Level");
+
+    params.clear();
+    REQUIRE(params.empty());
+    REQUIRE(params.getNumMaterialised() == 0);
+}
+
+TEST_CASE("DeviceStateSnapshot - recalls values into a sparse list", "[device][parameters]") {
+    DeviceInfo device;
+    device.parameters = ParameterList(makeMetadata(100), std::vector<float>(100, 0.0f));
+
+    DeviceStateSnapshot snapshot;
+    snapshot.parameterValues.assign(100, 0.0f);
+    snapshot.parameterValues[3] = 9.0f;
+
+    REQUIRE(snapshot.applyParameters(device.parameters) == 1);
+    REQUIRE(device.parameters.getValue(3) == 9.0f);
+    REQUIRE(device.parameters.getNumMaterialised() == 0);
+}
@@ -0,0 +1,140 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <memory>
+#include <vector>
+
+#include "../magda/daw/audio/ParameterQueue.hpp"
+
+using namespace magda;
+
+namespace {
+
+ParameterChange makeChange(DeviceId deviceId, int paramIndex, float value) {
+    ParameterChange change;
+    change.deviceId = deviceId;
+    change.paramIndex = paramIndex;
+    change.value = value;
+    return change;
+}
+
+std::vector<ParameterChange> drain(CoalescingParameterQueue& queue) {
+    std::vector<ParameterChange> changes;
+    queue.popAll([&changes](const ParameterChange& c) { changes.push_back(c); });
+    return changes;
+}
+
+}  // namespace
+
+// ============================================================================
+// CoalescingParameterQueue Tests
+// ============================================================================
+
+TEST_CASE("CoalescingParameterQueue - Latest value wins", "[parameterqueue][coalescing]") {
+    auto queue = std::make_unique<CoalescingParameterQueue>();
+
+    REQUIRE_FALSE(queue->hasPending());
+
+    for (int i = 0; i < 10000; ++i) {
+        REQUIRE(queue->push(makeChange(7, 3, static_cast<float>(i) / 10000.0f)));
+    }
+    REQUIRE(queue->push(makeChange(7, 3, 0.25f)));
+    REQUIRE(queue->hasPending());
+
+    auto changes = drain(*queue);
+    REQUIRE(changes.size() == 1);
+    REQUIRE(changes[0].deviceId == 7);
+    REQUIRE(changes[0].paramIndex == 3);
+    REQUIRE(changes[0].value == Catch::Approx(0.25f));
+    REQUIRE(queue->getCoalescedCount() == 10000);
+    REQUIRE(queue->getDroppedCount() == 0);
+    REQUIRE_FALSE(queue->hasPending());
+}
+
+TEST_CASE("CoalescingParameterQueue - Distinct parameters are kept apart",
+          "[parameterqueue][coalescing]") {
+    auto queue = std::make_unique<CoalescingParameterQueue>();
+
+    queue->push(makeChange(1, 0, 0.1f));
+    queue->push(makeChange(1, 1, 0.2f));
+    queue->push(makeChange(2, 0, 0.3f));
+
+    auto changes = drain(*queue);
+    REQUIRE(changes.size() == 3);
+    REQUIRE(queue->getCoalescedCount() == 0);
+
+    SECTION("Slots are reused after draining") {
+        queue->push(makeChange(1, 1, 0.9f));
+        changes = drain(*queue);
+        REQUIRE(changes.size() == 1);
+        REQUIRE(changes[0].paramIndex == 1);
+        REQUIRE(changes[0].value == Catch::Approx(0.9f));
+    }
+}
+
+TEST_CASE("CoalescingParameterQueue - Drops when every slot is assigned",
+          "[parameterqueue][coalescing]") {
+    auto queue = std::make_unique<CoalescingParameterQueue>();
+
+    for (int i = 0; i < CoalescingParameterQueue::kMaxSlots; ++i) {
+        REQUIRE(queue->push(makeChange(1, i, 0.5f)));
+    }
+    REQUIRE_FALSE(queue->push(makeChange(2, 0, 0.5f)));
+    REQUIRE(queue->getDroppedCount() == 1);
+
+    // Existing pairs can still be updated
+    REQUIRE(queue->push(makeChange(1, 0, 0.75f)));
+    REQUIRE(drain(*queue).size() == static_cast<size_t>(CoalescingParameterQueue::kMaxSlots));
+
+    queue->reset();
+    REQUIRE(queue->push(makeChange(2, 0, 0.5f)));
+}
+
+TEST_CASE("CoalescingParameterQueue - Removed devices hand their slots back",
+          "[parameterqueue][coalescing]") {
+    auto queue = std::make_unique<CoalescingParameterQueue>();
+    constexpr int kParamsPerDevice = 500;
+
+    // Far more distinct pairs over the session than there are slots, never many at once
+    for (DeviceId deviceId = 1; deviceId <= 40; ++deviceId) {
+        for (int i = 0; i < kParamsPerDevice; ++i) {
+            REQUIRE(queue->push(makeChange(deviceId, i, 0.5f)));
+        }
+
+        auto changes = drain(*queue);
+        REQUIRE(changes.size() == static_cast<size_t>(kParamsPerDevice));
+        for (const auto& change : changes) {
+            REQUIRE(change.deviceId == deviceId);
+        }
+
+        queue->releaseDevice(deviceId);
+        REQUIRE(queue->getNumAssignedSlots() == 0);
+        drain(*queue);  // The audio thread moves on
+    }
+    REQUIRE(40 * kParamsPerDevice > CoalescingParameterQueue::kMaxSlots);
+    REQUIRE(queue->getDroppedCount() == 0);
+}
+
+TEST_CASE("CoalescingParameterQueue - Released slots wait for the next drain",
+          "[parameterqueue][coalescing]") {
+    auto queue = std::make_unique<CoalescingParameterQueue>();
+
+    for (int i = 0; i < CoalescingParameterQueue::kMaxSlots; ++i) {
+        REQUIRE(queue->push(makeChange(1, i, 0.5f)));
+    }
+
+    // A removed device's pending values are never delivered
+    queue->releaseDevice(1);
+    REQUIRE_FALSE(queue->hasPending());
+
+    // Until the audio thread has drained, a drain may still be reading the old slots
+    REQUIRE_FALSE(queue->push(makeChange(2, 0, 0.25f)));
+    REQUIRE(drain(*queue).empty());
+
+    REQUIRE(queue->push(makeChange(2, 0, 0.25f)));
+    auto changes = drain(*queue);
+    REQUIRE(changes.size() == 1);
+    REQUIRE(changes[0].deviceId == 2);
+    REQUIRE(changes[0].paramIndex == 0);
+    REQUIRE(changes[0].value == Catch::Approx(0.25f));
+}
@@ -0,0 +1,146 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "../magda/daw/audio/ParameterRamp.hpp"
+
+using namespace magda;
+using Catch::Approx;
+
+namespace {
+
+using Pool = ParameterRampPool<int, 4>;
+
+// The value each key reached by the end of the block
+std::map<int, float> advance(Pool& pool, int numSamples) {
+    std::map<int, float> applied;
+    pool.advance(numSamples,
+                 [&applied](int key, float value, int /*sampleOffset*/) { applied[key] = value; });
+    return applied;
+}
+
+// Every (sampleOffset, value) reported for key during the block
+std::vector<std::pair<int, float>> advanceSteps(Pool& pool, int numSamples, int key) {
+    std::vector<std::pair<int, float>> steps;
+    pool.advance(numSamples, [&steps, key](int applied, float value, int sampleOffset) {
+        if (applied == key) {
+            steps.emplace_back(sampleOffset, value);
+        }
+    });
+    return steps;
+}
+
+}  // namespace
+
+TEST_CASE("ParameterRampPool - Glides to the target and finishes", "[parameterramp]") {
+    Pool pool;
+    REQUIRE(pool.start(1, 0.0f, 1.0f, 100));
+    REQUIRE(pool.getNumActive() == 1);
+
+    auto applied = advance(pool, 25);
+    REQUIRE(applied.at(1) == Approx(0.25f));
+
+    applied = advance(pool, 50);
+    REQUIRE(applied.at(1) == Approx(0.75f));
+
+    // The last block lands exactly on the target, then the ramp is gone
+    applied = advance(pool, 50);
+    REQUIRE(applied.at(1) == 1.0f);
+    REQUIRE(pool.getNumActive() == 0);
+    REQUIRE(advance(pool, 50).empty());
+}
+
+TEST_CASE("ParameterRampPool - Retargeting continues from where the ramp is",
+          "[parameterramp]") {
+    Pool pool;
+    pool.start(1, 0.0f, 1.0f, 100);
+    advance(pool, 50);
+
+    // The current value passed in is ignored: the glide carries on from 0.5
+    REQUIRE(pool.start(1, 0.9f, 0.0f, 50));
+    REQUIRE(pool.getNumActive() == 1);
+
+    auto applied = advance(pool, 25);
+    REQUIRE(applied.at(1) == Approx(0.25f));
+    applied = advance(pool, 25);
+    REQUIRE(applied.at(1) == 0.0f);
+    REQUIRE(pool.getNumActive() == 0);
+}
+
+TEST_CASE("ParameterRampPool - A zero-length change cancels the ramp", "[parameterramp]") {
+    Pool pool;
+    pool.start(1, 0.0f, 1.0f, 100);
+    pool.start(2, 0.0f, 1.0f, 100);
+
+    REQUIRE_FALSE(pool.start(1, 0.0f, 0.3f, 0));
+    REQUIRE(pool.getNumActive() == 1);
+
+    // The value the caller applied instead is left alone
+    auto applied = advance(pool, 10);
+    REQUIRE(applied.count(1) == 0);
+    REQUIRE(applied.at(2) == Approx(0.1f));
+}
+
+TEST_CASE("ParameterRampPool - Refuses new ramps when every slot is busy", "[parameterramp]") {
+    Pool pool;
+    for (int key = 0; key < Pool::kCapacity; ++key) {
+        REQUIRE(pool.start(key, 0.0f, 1.0f, 100));
+    }
+    REQUIRE_FALSE(pool.start(Pool::kCapacity, 0.0f, 1.0f, 100));
+    REQUIRE(pool.getNumActive() == Pool::kCapacity);
+
+    // Ramps already in flight can still be retargeted
+    REQUIRE(pool.start(0, 0.0f, 0.0f, 100));
+
+    // A finished ramp frees its slot
+    advance(pool, 100);
+    REQUIRE(pool.getNumActive() == 0);
+    REQUIRE(pool.start(Pool::kCapacity, 0.0f, 1.0f, 100));
+}
+
+TEST_CASE("ParameterRampPool - Large blocks glide in sub-blocks", "[parameterramp]") {
+    Pool pool;
+    pool.start(1, 0.0f, 1.0f, 1024);
+
+    auto steps = advanceSteps(pool, 512, 1);
+    REQUIRE(steps.size() == static_cast<size_t>(512 / Pool::kSubBlockSamples));
+
+    for (size_t i = 0; i < steps.size(); ++i) {
+        const int offset = static_cast<int>(i + 1) * Pool::kSubBlockSamples;
+        REQUIRE(steps[i].first == offset);
+        REQUIRE(steps[i].second == Approx(static_cast<float>(offset) / 1024.0f));
+    }
+    REQUIRE(pool.getNumActive() == 1);
+}
+
+TEST_CASE("ParameterRampPool - A ramp lands on the sample it ends on", "[parameterramp]") {
+    Pool pool;
+    pool.start(1, 1.0f, 0.0f, 40);
+
+    // Splits at the end of the first sub-block and where the ramp finishes, then holds
+    auto steps = advanceSteps(pool, 256, 1);
+    REQUIRE(steps.size() == 2);
+    REQUIRE(steps[0].first == Pool::kSubBlockSamples);
+    REQUIRE(steps[0].second == Approx(1.0f - static_cast<float>(Pool::kSubBlockSamples) / 40.0f));
+    REQUIRE(steps[1].first == 40);
+    REQUIRE(steps[1].second == 0.0f);
+    REQUIRE(pool.getNumActive() == 0);
+}
+
+TEST_CASE("ParameterRampPool - Values don't depend on how blocks are split", "[parameterramp]") {
+    Pool whole;
+    Pool split;
+    whole.start(1, 0.2f, 0.9f, 3000);
+    split.start(1, 0.2f, 0.9f, 3000);
+
+    const float wholeValue = advance(whole, 2100).at(1);
+    float splitValue = 0.0f;
+    for (int block = 0; block < 300; ++block) {
+        splitValue = advance(split, 7).at(1);
+    }
+    REQUIRE(splitValue == Approx(wholeValue).epsilon(1e-6));
+    REQUIRE(wholeValue == Approx(0.2f + 0.7f * 0.7f));
+}
@@ -1,6 +1,10 @@
 #include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
 
+#include <cmath>
+#include <vector>
+
+#include "../magda/daw/core/ParameterConversion.hpp"
 #include "../magda/daw/core/ParameterInfo.hpp"
 #include "../magda/daw/core/ParameterUtils.hpp"
 
@@ -597,6 +601,109 @@ TEST_CASE("getChoiceString - Empty choices", "[parameter][format]") {
     REQUIRE(ParameterUtils::getChoiceString(0, param) == "0");
 }
 
+// ============================================================================
+// ParameterConversion Tests
+// ============================================================================
+
+namespace {
+
+std::vector<ParameterInfo> conversionPresets() {
+    ParameterInfo curve(0, "Curve", "", 0.0f, 100.0f, 50.0f, ParameterScale::Exponential);
+    curve.skewFactor = 2.0f;
+    return {ParameterPresets::frequency(0, "Cutoff"),
+            ParameterPresets::time(1, "Attack"),
+            ParameterPresets::percent(2, "Mix"),
+            ParameterPresets::decibels(3, "Gain"),
+            ParameterPresets::boolean(4, "Bypass"),
+            ParameterPresets::discrete(5, "Mode", {"A", "B", "C", "D"}),
+            ParameterPresets::faderVolume(6, "Volume"),
+            ParameterPresets::pan(7, "Pan"),
+            curve};
+}
+
+}  // namespace
+
+TEST_CASE("ParameterConversion - Arrays convert as single values", "[parameter][conversion]") {
+    std::vector<float> normalized;
+    for (int i = -10; i <= 110; ++i) {
+        normalized.push_back(static_cast<float>(i) / 100.0f);  // Includes out-of-range values
+    }
+
+    for (const auto& info : conversionPresets()) {
+        INFO(info.name.toStdString());
+        const ParameterConversion conversion(info);
+
+        std::vector<float> real(normalized.size());
+        conversion.toReal(normalized.data(), real.data(), static_cast<int>(real.size()));
+        std::vector<float> back(real.size());
+        conversion.toNormalized(real.data(), back.data(), static_cast<int>(back.size()));
+
+        for (size_t i = 0; i < normalized.size(); ++i) {
+            REQUIRE(real[i] == Catch::Approx(conversion.toReal(normalized[i])));
+            REQUIRE(real[i] ==
+                    Catch::Approx(ParameterUtils::normalizedToReal(normalized[i], info)));
+            REQUIRE(back[i] == Catch::Approx(conversion.toNormalized(real[i])).margin(1e-6));
+        }
+    }
+}
+
+TEST_CASE("ParameterConversion - Converting in place", "[parameter][conversion]") {
+    const ParameterConversion conversion(ParameterPresets::frequency(0, "Cutoff"));
+    std::vector<float> values = {0.0f, 0.5f, 1.0f};
+    conversion.toReal(values.data(), values.data(), 3);
+    REQUIRE(values[0] == Catch::Approx(20.0f));
+    REQUIRE(values[1] == Catch::Approx(std::sqrt(20.0f * 20000.0f)).epsilon(0.01));
+    REQUIRE(values[2] == Catch::Approx(20000.0f));
+
+    conversion.toNormalized(values.data(), values.data(), 3);
+    REQUIRE(values[0] == Catch::Approx(0.0f).margin(1e-6));
+    REQUIRE(values[1] == Catch::Approx(0.5f));
+    REQUIRE(values[2] == Catch::Approx(1.0f));
+}
+
+TEST_CASE("ParameterConversion - Lookup tables", "[parameter][conversion]") {
+    SECTION("A table stays close to the exact curve") {
+        ParameterInfo curve(0, "Curve", "", 0.0f, 100.0f, 50.0f, ParameterScale::Exponential);
+        curve.skewFactor = 3.0f;
+
+        for (const auto& info : {ParameterPresets::frequency(0, "Cutoff"), curve}) {
+            const ParameterConversion exact(info);
+            ParameterConversion tabled(info);
+            tabled.buildTable();
+            REQUIRE(tabled.hasTable());
+
+            // Ends are exact
+            REQUIRE(tabled.toReal(0.0f) == exact.toReal(0.0f));
+            REQUIRE(tabled.toReal(1.0f) == exact.toReal(1.0f));
+
+            for (int i = 0; i <= 10000; ++i) {
+                const float value = static_cast<float>(i) / 10000.0f;
+                const float expected = exact.toReal(value);
+                REQUIRE(tabled.toReal(value) ==
+                        Catch::Approx(expected).epsilon(1e-4).margin(1e-3));
+            }
+
+            // The array form reads the same table
+            std::vector<float> values = {0.123f, 0.456f, 0.789f};
+            std::vector<float> real(values.size());
+            tabled.toReal(values.data(), real.data(), 3);
+            for (size_t i = 0; i < values.size(); ++i) {
+                REQUIRE(real[i] == tabled.toReal(values[i]));
+            }
+        }
+    }
+
+    SECTION("Scales without a curve ignore tables") {
+        for (const auto& info :
+             {ParameterPresets::percent(0, "Mix"), ParameterPresets::faderVolume(1, "Volume"),
+              ParameterPresets::discrete(2, "Mode", {"A", "B"})}) {
+            ParameterConversion conversion(info);
+            conversion.buildTable();
+            REQUIRE_FALSE(conversion.hasTable());
+        }
+    }
+}
+
 // ============================================================================
 // Cutoff Modulation Example (from plan)
 // ============================================================================
@@ -0,0 +1,136 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <vector>
+
+#include "../magda/daw/audio/PeakPyramid.hpp"
+
+using namespace magda;
+using Catch::Approx;
+
+// ============================================================================
+// PeakPyramid Tests
+// ============================================================================
+
+namespace {
+
+constexpr int kBase = PeakPyramid::BASE_SAMPLES_PER_PEAK;
+
+// Two channels: a ramp from -1 to 1 and a constant 0.5
+PeakPyramid makePyramid(int numSamples, int blockSize) {
+    std::vector<float> ramp(static_cast<size_t>(numSamples));
+    std::vector<float> constant(static_cast<size_t>(numSamples), 0.5f);
+    for (int i = 0; i < numSamples; ++i) {
+        ramp[static_cast<size_t>(i)] = -1.0f + 2.0f * i / static_cast<float>(numSamples - 1);
+    }
+
+    PeakPyramid pyramid;
+    pyramid.begin(2, 48000.0);
+    for (int pos = 0; pos < numSamples; pos += blockSize) {
+        const int count = std::min(blockSize, numSamples - pos);
+        const float* channels[] = {ramp.data() + pos, constant.data() + pos};
+        pyramid.addSamples(channels, count);
+    }
+    pyramid.finish();
+    return pyramid;
+}
+
+}  // namespace
+
+TEST_CASE("PeakPyramid - Levels halve down to a single peak", "[peakpyramid]") {
+    auto pyramid = makePyramid(kBase * 10 + 17, 1000);
+
+    REQUIRE(pyramid.getLengthInSamples() == kBase * 10 + 17);
+    REQUIRE(pyramid.getNumChannels() == 2);
+    REQUIRE(pyramid.getNumPeaks(0) == 11);
+    REQUIRE(pyramid.getNumPeaks(1) == 6);
+    REQUIRE(pyramid.getNumPeaks(2) == 3);
+    REQUIRE(pyramid.getNumPeaks(3) == 2);
+    REQUIRE(pyramid.getNumPeaks(4) == 1);
+    REQUIRE(pyramid.getNumLevels() == 5);
+}
+
+TEST_CASE("PeakPyramid - Memory usage covers every level", "[peakpyramid]") {
+    auto pyramid = makePyramid(kBase * 10 + 17, 1000);
+
+    // 11 + 6 + 3 + 2 + 1 peaks, two channels each
+    const size_t expected = 23 * 2 * sizeof(PeakPyramid::Peak);
+    REQUIRE(pyramid.getMemoryUsage() >= expected);
+    REQUIRE(pyramid.getMemoryUsage() < expected * 2);
+    REQUIRE(PeakPyramid().getMemoryUsage() == 0);
+}
+
+TEST_CASE("PeakPyramid - Block size does not change the result", "[peakpyramid]") {
+    auto a = makePyramid(kBase * 9 + 3, 64);
+    auto b = makePyramid(kBase * 9 + 3, 4096);
+
+    std::vector<char> bytesA;
+    std::vector<char> bytesB;
+    a.serialise(bytesA);
+    b.serialise(bytesB);
+    REQUIRE(bytesA == bytesB);
+}
+
+TEST_CASE("PeakPyramid - Ranges aggregate min, max and RMS", "[peakpyramid]") {
+    auto pyramid = makePyramid(kBase * 16, 512);
+
+    SECTION("Whole file at every level") {
+        for (int level = 0; level < pyramid.getNumLevels(); ++level) {
+            auto ramp = pyramid.getRange(level, 0, 0, pyramid.getLengthInSamples());
+            REQUIRE(ramp.min == Approx(-1.0f).margin(1e-4));
+            REQUIRE(ramp.max == Approx(1.0f).margin(1e-4));
+
+            auto constant = pyramid.getRange(level, 1, 0, pyramid.getLengthInSamples());
+            REQUIRE(constant.min == Approx(0.5f).margin(1e-4));
+            REQUIRE(constant.max == Approx(0.5f).margin(1e-4));
+            REQUIRE(constant.rms == Approx(0.5f).margin(1e-4));
+        }
+    }
+
+    SECTION("First half of the ramp stays negative") {
+        auto firstHalf = pyramid.getRange(0, 0, 0, kBase * 8);
+        REQUIRE(firstHalf.min == Approx(-1.0f).margin(1e-4));
+        REQUIRE(firstHalf.max < 0.0f);
+    }
+
+    SECTION("Out-of-range queries are safe") {
+        auto empty = pyramid.getRange(0, 5, 0, 100);
+        REQUIRE(empty.max == 0.0f);
+        auto past = pyramid.getRange(0, 1, kBase * 100, kBase * 101);
+        REQUIRE(past.max == Approx(0.5f).margin(1e-4));
+    }
+}
+
+TEST_CASE("PeakPyramid - Level choice follows zoom", "[peakpyramid]") {
+    auto pyramid = makePyramid(kBase * 64, 4096);
+
+    REQUIRE(pyramid.chooseLevel(kBase / 2.0) == -1);
+    REQUIRE(pyramid.chooseLevel(kBase) == 0);
+    REQUIRE(pyramid.chooseLevel(kBase * 3.0) == 1);
+    REQUIRE(pyramid.chooseLevel(kBase * 4.0) == 2);
+    REQUIRE(pyramid.chooseLevel(1.0e12) == pyramid.getNumLevels() - 1);
+}
+
+TEST_CASE("PeakPyramid - Serialization round trip", "[peakpyramid]") {
+    auto pyramid = makePyramid(kBase * 5 + 100, 777);
+
+    std::vector<char> bytes;
+    pyramid.serialise(bytes);
+
+    PeakPyramid restored;
+    REQUIRE(restored.deserialise(bytes.data(), bytes.size()));
+    REQUIRE(restored.getNumLevels() == pyramid.getNumLevels());
+    REQUIRE(restored.getLengthInSamples() == pyramid.getLengthInSamples());
+    REQUIRE(restored.getSampleRate() == 48000.0);
+
+    std::vector<char> again;
+    restored.serialise(again);
+    REQUIRE(again == bytes);
+
+    SECTION("Truncated data is rejected") {
+        PeakPyramid truncated;
+        REQUIRE_FALSE(truncated.deserialise(bytes.data(), bytes.size() - 1));
+        REQUIRE(truncated.isEmpty());
+    }
+}
@@ -0,0 +1,122 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <thread>
+
+#include "../magda/daw/audio/PlayheadClock.hpp"
+
+using namespace magda;
+using Catch::Approx;
+
+// ============================================================================
+// PlayheadClock Tests
+// ============================================================================
+
+TEST_CASE("PlayheadClock - Nothing to read before the first publish", "[playheadclock]") {
+    PlayheadClock clock;
+    PlayheadClock::Sample sample;
+    REQUIRE_FALSE(clock.read(sample));
+}
+
+TEST_CASE("PlayheadClock - Reads back the published sample", "[playheadclock]") {
+    PlayheadClock clock;
+    PlayheadClock::Sample published;
+    published.positionSeconds = 12.5;
+    published.hostTimeMs = 1000.0;
+    published.playing = true;
+    clock.publish(published);
+
+    PlayheadClock::Sample sample;
+    REQUIRE(clock.read(sample));
+    REQUIRE(sample.positionSeconds == 12.5);
+    REQUIRE(sample.hostTimeMs == 1000.0);
+    REQUIRE(sample.playing);
+}
+
+TEST_CASE("PlayheadClock - Carries each block's transport state together", "[playheadclock]") {
+    PlayheadClock clock;
+    PlayheadClock::Sample published;
+    published.positionSeconds = 4.0;
+    published.bpm = 96.0;
+    published.playing = true;
+    published.justStarted = true;
+    clock.publish(published);
+
+    PlayheadClock::Sample first;
+    REQUIRE(clock.read(first));
+    REQUIRE(first.bpm == 96.0);
+    REQUIRE(first.justStarted);
+    REQUIRE(first.loopWrapSample == -1);
+
+    published.justStarted = false;
+    published.loopWrapSample = 480;
+    clock.publish(published);
+
+    PlayheadClock::Sample second;
+    REQUIRE(clock.read(second));
+    REQUIRE_FALSE(second.justStarted);
+    REQUIRE(second.loopWrapSample == 480);
+
+    // One version per publish, so a reader can tell a new block from one it has seen
+    REQUIRE(second.version == first.version + 1);
+    PlayheadClock::Sample again;
+    REQUIRE(clock.read(again));
+    REQUIRE(again.version == second.version);
+}
+
+TEST_CASE("PlayheadClock - Extrapolates from when the block is heard", "[playheadclock]") {
+    PlayheadClock::Sample sample;
+    sample.positionSeconds = 10.0;
+    sample.hostTimeMs = 5000.0;
+    sample.playing = true;
+
+    REQUIRE(PlayheadClock::extrapolate(sample, 5250.0) == Approx(10.25));
+    // Still hearing the previous block
+    REQUIRE(PlayheadClock::extrapolate(sample, 4980.0) == Approx(9.98));
+
+    sample.playing = false;
+    REQUIRE(PlayheadClock::extrapolate(sample, 9000.0) == Approx(10.0));
+}
+
+TEST_CASE("PlayheadClock - Extrapolation wraps inside the loop", "[playheadclock]") {
+    PlayheadClock::Sample sample;
+    sample.positionSeconds = 3.9;
+    sample.hostTimeMs = 0.0;
+    sample.loopStartSeconds = 2.0;
+    sample.loopEndSeconds = 4.0;
+    sample.playing = true;
+
+    REQUIRE(PlayheadClock::extrapolate(sample, 300.0) == Approx(2.2));
+
+    // Just after a wrap the end of the previous pass is still being heard
+    sample.positionSeconds = 2.01;
+    REQUIRE(PlayheadClock::extrapolate(sample, -20.0) == Approx(3.99));
+}
+
+TEST_CASE("PlayheadClock - Readers never see a torn sample", "[playheadclock]") {
+    PlayheadClock clock;
+    std::atomic<bool> done{false};
+
+    std::thread writer([&clock, &done]() {
+        for (int i = 1; i <= 200000; ++i) {
+            PlayheadClock::Sample sample;
+            sample.positionSeconds = i;
+            sample.hostTimeMs = i * 2.0;
+            sample.playing = true;
+            clock.publish(sample);
+        }
+        done.store(true);
+    });
+
+    bool consistent = true;
+    while (!done.load()) {
+        PlayheadClock::Sample sample;
+        if (clock.read(sample) && sample.hostTimeMs != sample.positionSeconds * 2.0) {
+            consistent = false;
+        }
+    }
+    writer.join();
+
+    REQUIRE(consistent);
+}
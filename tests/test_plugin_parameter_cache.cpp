@@ -0,0 +1,88 @@
+#include <juce_core/juce_core.h>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "../magda/daw/audio/PluginParameterCache.hpp"
+
+using namespace magda;
+
+// ============================================================================
+// PluginParameterCache Tests
+// ============================================================================
+// A plugin's later instances take their parameter metadata from the cache
+// instead of the plugin, so it must come back exactly as it was read.
+
+namespace {
+
+PluginParameterCache::Parameters makeParameters() {
+    PluginParameterCache::Parameters parameters;
+    parameters.push_back(ParameterPresets::frequency(0, "Cutoff"));
+
+    ParameterInfo mode(1, "Mode", "", 0.0f, 2.0f, 1.0f, ParameterScale::Discrete);
+    mode.choices = {"Low", "Band", "High"};
+    mode.modulatable = false;
+    parameters.push_back(mode);
+
+    ParameterInfo drive(2, "Drive", "dB", -12.0f, 24.0f, 0.0f, ParameterScale::Exponential);
+    drive.skewFactor = 0.3f;
+    drive.bipolarModulation = false;
+    parameters.push_back(drive);
+    return parameters;
+}
+
+}  // namespace
+
+TEST_CASE("PluginParameterCache - Keyed by plugin and version", "[plugin][parameters]") {
+    juce::PluginDescription description;
+    description.pluginFormatName = "VST3";
+    description.name = "Filter";
+    description.fileOrIdentifier = "/Plugins/Filter.vst3";
+    description.uniqueId = 1234;
+    description.version = "1.0.0";
+
+    const auto key = PluginParameterCache::getKey(description);
+    REQUIRE(key.startsWith(description.createIdentifierString()));
+
+    description.version = "1.1.0";
+    REQUIRE(PluginParameterCache::getKey(description) != key);
+}
+
+TEST_CASE("PluginParameterCache - Serialises round trip", "[plugin][parameters]") {
+    const auto parameters = makeParameters();
+    const auto tree = PluginParameterCache::toValueTree("VST3-Filter-1.0.0", parameters);
+
+    PluginParameterCache::Parameters loaded;
+    REQUIRE(PluginParameterCache::fromValueTree(tree, "VST3-Filter-1.0.0", loaded));
+    REQUIRE(loaded.size() == parameters.size());
+    for (size_t i = 0; i < parameters.size(); ++i) {
+        REQUIRE(loaded[i].paramIndex == static_cast<int>(i));
+        REQUIRE(loaded[i].name == parameters[i].name);
+        REQUIRE(loaded[i].unit == parameters[i].unit);
+        REQUIRE(loaded[i].minValue == parameters[i].minValue);
+        REQUIRE(loaded[i].maxValue == parameters[i].maxValue);
+        REQUIRE(loaded[i].defaultValue == parameters[i].defaultValue);
+        REQUIRE(loaded[i].scale == parameters[i].scale);
+        REQUIRE(loaded[i].skewFactor == parameters[i].skewFactor);
+        REQUIRE(loaded[i].choices == parameters[i].choices);
+        REQUIRE(loaded[i].modulatable == parameters[i].modulatable);
+        REQUIRE(loaded[i].bipolarModulation == parameters[i].bipolarModulation);
+    }
+
+    SECTION("Survives the binary form written to disk") {
+        juce::MemoryOutputStream data;
+        tree.writeToStream(data);
+        const auto read = juce::ValueTree::readFromData(data.getData(), data.getDataSize());
+
+        PluginParameterCache::Parameters fromDisk;
+        REQUIRE(PluginParameterCache::fromValueTree(read, "VST3-Filter-1.0.0", fromDisk));
+        REQUIRE(fromDisk.size() == parameters.size());
+        REQUIRE(fromDisk[1].choices == parameters[1].choices);
+    }
+
+    SECTION("Another plugin's entry is rejected") {
+        PluginParameterCache::Parameters other;
+        REQUIRE_FALSE(PluginParameterCache::fromValueTree(tree, "VST3-Other-1.0.0", other));
+        REQUIRE_FALSE(PluginParameterCache::fromValueTree({}, "VST3-Filter-1.0.0", other));
+        REQUIRE(other.empty());
+    }
+}
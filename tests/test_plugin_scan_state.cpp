@@ -0,0 +1,86 @@
+#include <juce_core/juce_core.h>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "../magda/daw/engine/PluginScanState.hpp"
+
+using namespace magda;
+
+// ============================================================================
+// PluginScanState Tests
+// ============================================================================
+// The scan state decides which plugin bundles an incremental rescan re-probes,
+// so a stamp must change whenever the file does and survive a save/load.
+
+TEST_CASE("PluginScanState - Stamp tracks file size and modification", "[plugin][scanstate]") {
+    juce::TemporaryFile temp(".vst3");
+    auto file = temp.getFile();
+    REQUIRE(file.replaceWithText("plugin"));
+
+    auto stamp = PluginScanState::stampFor("VST3", file.getFullPathName());
+    REQUIRE(stamp.formatName == "VST3");
+    REQUIRE(stamp.size == file.getSize());
+
+    PluginScanState state;
+    state.set(file.getFullPathName(), stamp);
+    REQUIRE(state.isUnchanged(file.getFullPathName(), stamp));
+
+    SECTION("A rewritten file no longer matches") {
+        REQUIRE(file.replaceWithText("plugin v2"));
+        auto updated = PluginScanState::stampFor("VST3", file.getFullPathName());
+        REQUIRE_FALSE(state.isUnchanged(file.getFullPathName(), updated));
+    }
+
+    SECTION("Unknown files are never unchanged") {
+        REQUIRE_FALSE(state.isUnchanged("/not/scanned.vst3", stamp));
+    }
+}
+
+TEST_CASE("PluginScanState - Bundles are stamped by their contents", "[plugin][scanstate]") {
+    auto bundle = juce::File::createTempFile(".vst3");
+    REQUIRE(bundle.getChildFile("Contents").getChildFile("binary").create());
+    REQUIRE(bundle.getChildFile("Contents").getChildFile("binary").replaceWithText("abc"));
+
+    auto stamp = PluginScanState::stampFor("VST3", bundle.getFullPathName());
+    REQUIRE(stamp.size == 3);
+
+    REQUIRE(bundle.getChildFile("Contents").getChildFile("binary").replaceWithText("abcdef"));
+    auto updated = PluginScanState::stampFor("VST3", bundle.getFullPathName());
+    REQUIRE(updated.size == 6);
+    REQUIRE(updated != stamp);
+
+    bundle.deleteRecursively();
+}
+
+TEST_CASE("PluginScanState - Identifiers that are not paths", "[plugin][scanstate]") {
+    auto stamp = PluginScanState::stampFor("AudioUnit", "AudioUnit:Synths/aumu,abcd,WXYZ");
+    REQUIRE(stamp.modificationTime == 0);
+    REQUIRE(stamp.size == 0);
+    REQUIRE(stamp == PluginScanState::stampFor("AudioUnit", "AudioUnit:Synths/aumu,abcd,WXYZ"));
+}
+
+TEST_CASE("PluginScanState - XML round trip", "[plugin][scanstate]") {
+    PluginScanState state;
+    PluginFileStamp stamp;
+    stamp.formatName = "VST3";
+    stamp.modificationTime = 1700000000123;
+    stamp.size = 5000000000;
+    state.set("/Library/Audio/Plug-Ins/VST3/Synth.vst3", stamp);
+    state.set("/Library/Audio/Plug-Ins/VST3/Delay.vst3", stamp);
+
+    auto xml = state.createXml();
+    REQUIRE(xml != nullptr);
+
+    PluginScanState restored;
+    restored.restoreFromXml(*xml);
+    REQUIRE(restored.size() == 2);
+    REQUIRE(restored.isUnchanged("/Library/Audio/Plug-Ins/VST3/Synth.vst3", stamp));
+
+    const juce::StringArray expected{"/Library/Audio/Plug-Ins/VST3/Delay.vst3",
+                                     "/Library/Audio/Plug-Ins/VST3/Synth.vst3"};
+    REQUIRE(restored.getFiles() == expected);
+
+    restored.remove("/Library/Audio/Plug-Ins/VST3/Delay.vst3");
+    REQUIRE(restored.find("/Library/Audio/Plug-Ins/VST3/Delay.vst3") == nullptr);
+    REQUIRE(restored.size() == 1);
+}
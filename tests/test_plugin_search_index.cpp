@@ -0,0 +1,103 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <vector>
+
+#include "../magda/daw/core/PluginSearchIndex.hpp"
+
+using namespace magda;
+
+// ============================================================================
+// PluginSearchIndex Tests
+// ============================================================================
+
+namespace {
+
+PluginSearchIndex makeIndex() {
+    std::vector<PluginSearchIndex::Entry> entries = {
+        {"Pro-Q 3", "FabFilter", "Effect EQ", "VST3"},
+        {"Serum", "Xfer Records", "Instrument Synth", "VST3"},
+        {"Valhalla Room", "Valhalla DSP", "Effect Reverb", "AudioUnit"},
+        {"Pro-C 2", "FabFilter", "Effect Dynamics", "VST3"},
+        {"Test Tone", "MAGDA", "Effect Utility", "Internal"},
+    };
+
+    PluginSearchIndex index;
+    index.build(entries);
+    return index;
+}
+
+}  // namespace
+
+TEST_CASE("PluginSearchIndex - Empty query returns everything in order", "[plugin][search]") {
+    auto index = makeIndex();
+    REQUIRE(index.size() == 5);
+
+    const std::vector<uint32_t> expected{0, 1, 2, 3, 4};
+    REQUIRE(index.search("") == expected);
+    REQUIRE(index.search("   ") == expected);
+}
+
+TEST_CASE("PluginSearchIndex - Substring terms use trigrams", "[plugin][search]") {
+    auto index = makeIndex();
+
+    SECTION("Case-insensitive match anywhere in a field") {
+        const std::vector<uint32_t> expected{2};
+        REQUIRE(index.search("HALLA r") == expected);
+        REQUIRE(index.search("verb") == expected);
+    }
+
+    SECTION("Manufacturer and format fields are searched") {
+        const std::vector<uint32_t> fabFilter{0, 3};
+        REQUIRE(index.search("filter") == fabFilter);
+
+        const std::vector<uint32_t> audioUnit{2};
+        REQUIRE(index.search("audiounit") == audioUnit);
+    }
+
+    SECTION("A trigram that occurs nowhere matches nothing") {
+        REQUIRE(index.search("zzz").empty());
+    }
+
+    SECTION("Terms do not match across field boundaries") {
+        REQUIRE(index.search("tonemagda").empty());
+    }
+}
+
+TEST_CASE("PluginSearchIndex - Short terms match word prefixes", "[plugin][search]") {
+    auto index = makeIndex();
+
+    const std::vector<uint32_t> pro{0, 3};
+    REQUIRE(index.search("pr") == pro);
+
+    // "ro" is inside "Pro" but only starts "Room"
+    const std::vector<uint32_t> ro{2};
+    REQUIRE(index.search("ro") == ro);
+
+    const std::vector<uint32_t> re{1, 2};
+    REQUIRE(index.search("re") == re);
+}
+
+TEST_CASE("PluginSearchIndex - All terms must match", "[plugin][search]") {
+    auto index = makeIndex();
+
+    const std::vector<uint32_t> expected{3};
+    REQUIRE(index.search("fab dyn") == expected);
+    REQUIRE(index.search("fab synth").empty());
+}
+
+TEST_CASE("PluginSearchIndex - Name prefix matches rank first", "[plugin][search]") {
+    std::vector<PluginSearchIndex::Entry> entries = {
+        {"Tape Echo", "Acme", "Effect Delay", "VST3"},
+        {"Echo Boy", "Soundtoys", "Effect Delay", "VST3"},
+        {"Space Echo", "Roland", "Effect Delay", "VST3"},
+    };
+    PluginSearchIndex index;
+    index.build(entries);
+
+    const std::vector<uint32_t> expected{1, 0, 2};
+    REQUIRE(index.search("echo") == expected);
+
+    index.clear();
+    REQUIRE(index.size() == 0);
+    REQUIRE(index.search("echo").empty());
+}
@@ -0,0 +1,67 @@
+#include <juce_core/juce_core.h>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "../magda/daw/engine/PluginUsageStats.hpp"
+
+using namespace magda;
+
+// ============================================================================
+// PluginUsageStats Tests
+// ============================================================================
+// The usage counts pick which plugins the instance pool keeps warm, so the
+// ranking must be deterministic and survive a save/load.
+
+TEST_CASE("PluginUsageStats - Most used first", "[plugin][usage]") {
+    PluginUsageStats usage;
+    for (int i = 0; i < 3; ++i) {
+        usage.recordUse("VST3-Synth");
+    }
+    usage.recordUse("VST3-Delay");
+    usage.recordUse("VST3-Reverb");
+    usage.recordUse("VST3-Reverb");
+    usage.recordUse("");  // Ignored
+
+    REQUIRE(usage.size() == 3);
+    REQUIRE(usage.getCount("VST3-Synth") == 3);
+    REQUIRE(usage.getCount("VST3-Unknown") == 0);
+
+    juce::StringArray expected{"VST3-Synth", "VST3-Reverb", "VST3-Delay"};
+    REQUIRE(usage.getMostUsed(10) == expected);
+
+    SECTION("Limited by count and minimum uses") {
+        REQUIRE(usage.getMostUsed(1) == juce::StringArray{"VST3-Synth"});
+        juce::StringArray twice{"VST3-Synth", "VST3-Reverb"};
+        REQUIRE(usage.getMostUsed(10, 2) == twice);
+    }
+
+    SECTION("Ties are in identifier order") {
+        usage.recordUse("VST3-Delay");
+        juce::StringArray tied{"VST3-Synth", "VST3-Delay", "VST3-Reverb"};
+        REQUIRE(usage.getMostUsed(10) == tied);
+    }
+}
+
+TEST_CASE("PluginUsageStats - XML round trip", "[plugin][usage]") {
+    PluginUsageStats usage;
+    usage.recordUse("AudioUnit-Synth");
+    usage.recordUse("AudioUnit-Synth");
+    usage.recordUse("VST3-Delay");
+
+    auto xml = usage.createXml();
+    REQUIRE(xml != nullptr);
+
+    PluginUsageStats restored;
+    restored.restoreFromXml(*xml);
+    REQUIRE(restored.size() == 2);
+    REQUIRE(restored.getCount("AudioUnit-Synth") == 2);
+    REQUIRE(restored.getCount("VST3-Delay") == 1);
+
+    restored.remove("VST3-Delay");
+    REQUIRE(restored.size() == 1);
+
+    // Anything else is ignored
+    juce::XmlElement other("PLUGINFILES");
+    restored.restoreFromXml(other);
+    REQUIRE(restored.size() == 0);
+}
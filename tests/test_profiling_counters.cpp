@@ -0,0 +1,84 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <thread>
+#include <vector>
+
+#include "../magda/daw/profiling/ProfilingCounters.hpp"
+
+using namespace magda;
+
+// ============================================================================
+// LatencyHistogram Tests
+// ============================================================================
+
+TEST_CASE("LatencyHistogram - Buckets keep ~6% precision", "[profiling]") {
+    for (uint64_t value : {0ull, 7ull, 15ull, 16ull, 100ull, 1500ull, 123456ull, 98765432ull}) {
+        const double reported = LatencyHistogram::valueOf(LatencyHistogram::bucketFor(value));
+        REQUIRE(reported == Catch::Approx(static_cast<double>(value)).epsilon(0.0625).margin(1.0));
+    }
+
+    // Out of range values land in the last bucket
+    REQUIRE(LatencyHistogram::bucketFor(~0ull) == LatencyHistogram::kNumBuckets - 1);
+}
+
+TEST_CASE("LatencyHistogram - Percentiles", "[profiling]") {
+    LatencyHistogram histogram;
+    REQUIRE(histogram.percentileNanos(0.5) == 0.0);
+
+    for (uint64_t i = 1; i <= 1000; ++i) {
+        histogram.addNanos(i * 1000);  // 1 us .. 1 ms
+    }
+    REQUIRE(histogram.getTotal() == 1000);
+    REQUIRE(histogram.percentileNanos(0.5) == Catch::Approx(500000.0).epsilon(0.07));
+    REQUIRE(histogram.percentileNanos(0.99) == Catch::Approx(990000.0).epsilon(0.07));
+    REQUIRE(histogram.percentileNanos(0.0) == Catch::Approx(1000.0).epsilon(0.07));
+}
+
+// ============================================================================
+// ProfilingCounters Tests
+// ============================================================================
+
+TEST_CASE("ProfilingCounters - Registration is by name", "[profiling]") {
+    auto& counters = ProfilingCounters::getInstance();
+    const auto id = counters.registerCounter("test.registration");
+    REQUIRE(id != ProfilingCounters::kInvalidId);
+    REQUIRE(counters.registerCounter("test.registration") == id);
+    REQUIRE(counters.findCounter("test.registration") == id);
+    REQUIRE(counters.getName(id) == "test.registration");
+    REQUIRE(counters.findCounter("test.never-registered") == ProfilingCounters::kInvalidId);
+}
+
+TEST_CASE("ProfilingCounters - Records merge across threads", "[profiling][threading]") {
+    auto& counters = ProfilingCounters::getInstance();
+    const auto id = counters.registerCounter("test.threads");
+    counters.reset(id);
+
+    counters.setEnabled(false);
+    counters.record(id, 5);
+    REQUIRE(counters.snapshot(id).count == 0);
+
+    counters.setEnabled(true);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 6; ++t) {
+        threads.emplace_back([&counters, id, t]() {
+            for (uint64_t i = 0; i < 1000; ++i) {
+                counters.record(id, 100 + static_cast<uint64_t>(t));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    auto snapshot = counters.snapshot(id);
+    REQUIRE(snapshot.count == 6000);
+    REQUIRE(snapshot.histogram.getTotal() == 6000);
+    REQUIRE(snapshot.minNanos == 100);
+    REQUIRE(snapshot.maxNanos == 105);
+    REQUIRE(snapshot.sumNanos == 1000 * (100 + 101 + 102 + 103 + 104 + 105));
+
+    counters.reset(id);
+    REQUIRE(counters.snapshot(id).count == 0);
+    counters.setEnabled(false);
+}
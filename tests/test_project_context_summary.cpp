@@ -0,0 +1,105 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "magda/daw/core/ProjectContextSummary.hpp"
+
+/**
+ * Tests for ProjectContextSummary
+ *
+ * These tests verify:
+ * - Tracks and clips are described one line each
+ * - The whole project is sent once, then only what changed
+ * - Edits that end where they started, and appearance-only edits, aren't reported
+ */
+
+using namespace magda;
+
+namespace {
+
+void flushChanges() {
+    TrackManager::getInstance().flushPendingChanges();
+    ClipManager::getInstance().flushPendingChanges();
+}
+
+}  // namespace
+
+TEST_CASE("ProjectContextSummary - Describes a track in one line", "[context]") {
+    TrackInfo track;
+    track.id = 3;
+    track.name = "Bass";
+    track.type = TrackType::Instrument;
+    track.volume = 0.5f;
+    track.muted = true;
+
+    DeviceInfo synth;
+    synth.name = "Synth";
+    DeviceInfo eq;
+    eq.name = "EQ";
+    eq.bypassed = true;
+    track.chainElements.push_back(makeDeviceElement(synth));
+    track.chainElements.push_back(makeDeviceElement(eq));
+
+    REQUIRE(ProjectContextSummary::describeTrack(track) ==
+            "Track 3 \"Bass\" (Instrument) -6.0 dB muted; devices: Synth, EQ (bypassed)");
+
+    ClipInfo clip;
+    clip.id = 7;
+    clip.name = "Riff";
+    clip.startTime = 1.0;
+    clip.length = 2.0;
+    REQUIRE(ProjectContextSummary::describeClip(clip) ==
+            "Clip 7 \"Riff\" (MIDI) 1.00-3.00s, 0 notes");
+}
+
+TEST_CASE("ProjectContextSummary - Sends the project once, then what changed", "[context]") {
+    auto& trackManager = TrackManager::getInstance();
+    auto& clipManager = ClipManager::getInstance();
+    trackManager.clearAllTracks();
+    clipManager.shutdown();
+    flushChanges();
+
+    ProjectContextSummary summary;
+    const auto trackId = trackManager.createTrack("Bass", TrackType::Instrument);
+    const auto clipId = clipManager.createMidiClip(trackId, 0.0, 2.0);
+    clipManager.setClipName(clipId, "Riff");
+    flushChanges();
+
+    const auto first = summary.takePromptContext();
+    REQUIRE(first.rfind("Project:\n", 0) == 0);
+    REQUIRE(first.find("\"Bass\" (Instrument)") != std::string::npos);
+    REQUIRE(first.find("\n  Clip " + std::to_string(clipId) + " \"Riff\"") != std::string::npos);
+
+    SECTION("Nothing edited, nothing sent") {
+        REQUIRE(summary.takePromptContext().empty());
+    }
+
+    SECTION("An edit sends that clip's line only") {
+        clipManager.setClipName(clipId, "Hook");
+        flushChanges();
+
+        const auto changes = summary.takePromptContext();
+        REQUIRE(changes.rfind("Changes since the last prompt:\n~ Clip ", 0) == 0);
+        REQUIRE(changes.find("\"Hook\"") != std::string::npos);
+        REQUIRE(changes.find("Bass") == std::string::npos);
+        REQUIRE(summary.getSummary().find("\"Hook\"") != std::string::npos);
+    }
+
+    SECTION("An edit that is put back isn't reported") {
+        clipManager.setClipName(clipId, "Hook");
+        clipManager.setClipName(clipId, "Riff");
+        flushChanges();
+        REQUIRE(summary.takeChanges().empty());
+    }
+
+    SECTION("A removed clip is named as it was") {
+        clipManager.deleteClip(clipId);
+        flushChanges();
+
+        const auto changes = summary.takeChanges();
+        REQUIRE(changes.rfind("- Clip " + std::to_string(clipId) + " \"Riff\"", 0) == 0);
+        REQUIRE(summary.getSummary().find("Riff") == std::string::npos);
+    }
+
+    trackManager.clearAllTracks();
+    clipManager.shutdown();
+    flushChanges();
+}
@@ -0,0 +1,291 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <limits>
+#include <vector>
+
+#include "../magda/daw/core/ProjectFile.hpp"
+
+using namespace magda;
+
+namespace {
+
+DeviceInfo makeDevice(DeviceId id, const juce::String& name) {
+    DeviceInfo device;
+    device.id = id;
+    device.name = name;
+    device.pluginId = "test." + name;
+    device.format = PluginFormat::Internal;
+    device.parameters.push_back(ParameterInfo(0, "Cutoff", "Hz", 20.0f, 20000.0f, 1000.0f,
+                                              ParameterScale::Logarithmic));
+    device.parameters[0].currentValue = 440.0f;
+    device.mods[0].addLink({id, 0}, 0.25f);
+    device.oversampling = 4;
+    return device;
+}
+
+ProjectModel makeModel() {
+    ProjectModel model;
+
+    TrackInfo track;
+    track.id = 3;
+    track.name = "Bass";
+    track.colour = juce::Colour(0xff336699);
+    track.volume = 0.5f;
+    track.muted = true;
+    track.directMonitor = true;
+    track.viewSettings.setHeight(ViewMode::Arrange, 120);
+    SendInfo send;
+    send.destinationId = 6;
+    send.level = 0.5f;
+    send.preFader = true;
+    track.sends.push_back(send);
+    track.chainElements.push_back(makeDeviceElement(makeDevice(7, "Filter")));
+
+    RackInfo rack;
+    rack.id = 2;
+    rack.name = "Parallel";
+    ChainInfo chain;
+    chain.id = 5;
+    chain.elements.push_back(makeDeviceElement(makeDevice(9, "Drive")));
+    rack.chains.push_back(chain);
+    track.chainElements.push_back(makeRackElement(rack));
+    model.tracks.push_back(track);
+
+    model.master.volume = 0.8f;
+
+    ClipInfo clip;
+    clip.id = 11;
+    clip.trackId = 3;
+    clip.name = "Riff";
+    clip.startTime = 2.0;
+    clip.length = 8.0;
+    clip.midiNotes.add(MidiNote{INVALID_MIDI_NOTE_ID, 36, 110, 0.0, 0.5});
+    clip.midiNotes.add(MidiNote{INVALID_MIDI_NOTE_ID, 43, 90, 1.0, 0.25});
+    model.clips.push_back(clip);
+
+    AutomationLaneInfo lane;
+    lane.id = 4;
+    lane.target.type = AutomationTargetType::TrackVolume;
+    lane.target.trackId = 3;
+    AutomationPoint point;
+    point.id = 1;
+    point.time = 1.5;
+    point.value = 0.75;
+    point.curveType = AutomationCurveType::Bezier;
+    point.outHandle.time = 0.25;
+    lane.absolutePoints.push_back(point);
+    model.automationLanes.push_back(lane);
+
+    juce::ValueTree state("PLUGIN");
+    state.setProperty("preset", "Warm", nullptr);
+    model.pluginStates[7].tree = state;
+    return model;
+}
+
+// The model's sections with the named blob property rewritten
+std::vector<ProjectFile::SectionData> withBlob(int sectionType, const juce::Identifier& name,
+                                               const juce::MemoryBlock& blob) {
+    std::vector<ProjectFile::SectionData> sections;
+    ProjectFile::encodeSections(makeModel(), [&](int type, int key, const juce::MemoryBlock& data) {
+        if (type != sectionType) {
+            sections.push_back({type, key, data});
+            return;
+        }
+
+        // A clip section holds its clips; a lane section is the lane
+        auto tree = juce::ValueTree::readFromData(data.getData(), data.getSize());
+        auto target = type == ProjectFile::kClipSection ? tree.getChild(0) : tree;
+        target.setProperty(name, blob, nullptr);
+
+        juce::MemoryOutputStream out;
+        tree.writeToStream(out);
+        sections.push_back({type, key, out.getMemoryBlock()});
+    });
+    return sections;
+}
+
+juce::MemoryBlock blobWithCount(int count, size_t payloadBytes) {
+    juce::MemoryOutputStream out;
+    out.writeInt(count);
+    for (size_t i = 0; i < payloadBytes; ++i) {
+        out.writeByte(static_cast<char>(i));
+    }
+    return out.getMemoryBlock();
+}
+
+}  // namespace
+
+TEST_CASE("ProjectFile - Round trip", "[project]") {
+    juce::TemporaryFile temp(ProjectFile::kFileExtension);
+    const auto model = makeModel();
+    REQUIRE(ProjectFile::write(temp.getFile(), model).isEmpty());
+
+    juce::String error;
+    auto reader = ProjectFile::Reader::open(temp.getFile(), error);
+    REQUIRE(reader != nullptr);
+
+    ProjectModel loaded;
+    REQUIRE(reader->readModel(loaded).isEmpty());
+
+    SECTION("Tracks keep their ids, mixer state and chains") {
+        REQUIRE(loaded.tracks.size() == 1);
+        const auto& track = loaded.tracks[0];
+        CHECK(track.id == 3);
+        CHECK(track.name == "Bass");
+        CHECK(track.colour == juce::Colour(0xff336699));
+        CHECK(track.volume == 0.5f);
+        CHECK(track.muted);
+        CHECK(track.directMonitor);
+        CHECK(track.viewSettings.get(ViewMode::Arrange).height == 120);
+        CHECK(loaded.master.volume == 0.8f);
+        REQUIRE(track.sends.size() == 1);
+        CHECK(track.sends[0].destinationId == 6);
+        CHECK(track.sends[0].level == 0.5f);
+        CHECK(track.sends[0].preFader);
+
+        REQUIRE(track.chainElements.size() == 2);
+        const auto& device = getDevice(track.chainElements[0]);
+        CHECK(device.id == 7);
+        CHECK(device.oversampling == 4);
+        REQUIRE(device.parameters.size() == 1);
+        CHECK(device.parameters[0].currentValue == 440.0f);
+        CHECK(device.parameters[0].scale == ParameterScale::Logarithmic);
+        REQUIRE(device.mods[0].links.size() == 1);
+        CHECK(device.mods[0].links[0].amount == 0.25f);
+
+        const auto& rack = getRack(track.chainElements[1]);
+        CHECK(rack.id == 2);
+        REQUIRE(rack.chains.size() == 1);
+        CHECK(rack.chains[0].id == 5);
+        REQUIRE(rack.chains[0].elements.size() == 1);
+        CHECK(getDevice(rack.chains[0].elements[0]).name == "Drive");
+    }
+
+    SECTION("Clips keep their notes") {
+        REQUIRE(loaded.clips.size() == 1);
+        const auto& clip = loaded.clips[0];
+        CHECK(clip.id == 11);
+        CHECK(clip.startTime == 2.0);
+        REQUIRE(clip.midiNotes.size() == 2);
+        CHECK(clip.midiNotes[0].noteNumber == 36);
+        CHECK(clip.midiNotes[1].velocity == 90);
+        CHECK(clip.midiNotes[1].lengthBeats == 0.25);
+        CHECK(clip.midiNotes[0].id == model.clips[0].midiNotes[0].id);
+    }
+
+    SECTION("Automation keeps its points") {
+        REQUIRE(loaded.automationLanes.size() == 1);
+        const auto& lane = loaded.automationLanes[0];
+        CHECK(lane.target.type == AutomationTargetType::TrackVolume);
+        REQUIRE(lane.absolutePoints.size() == 1);
+        CHECK(lane.absolutePoints[0].value == 0.75);
+        CHECK(lane.absolutePoints[0].curveType == AutomationCurveType::Bezier);
+        CHECK(lane.absolutePoints[0].outHandle.time == 0.25);
+    }
+
+    SECTION("Plugin states are left in the file until taken") {
+        CHECK(loaded.pluginStates.empty());
+        CHECK(reader->hasPluginState(7));
+        CHECK_FALSE(reader->hasPluginState(9));
+
+        const auto state = reader->takePluginState(7);
+        CHECK(state.getProperty("preset").toString() == "Warm");
+        CHECK_FALSE(reader->hasPluginState(7));
+        CHECK_FALSE(reader->takePluginState(7).isValid());
+    }
+
+    SECTION("Pending states survive the reader detaching from the file") {
+        reader->detachFromFile();
+        REQUIRE(temp.getFile().deleteFile());
+        CHECK(reader->takePluginState(7).getProperty("preset").toString() == "Warm");
+    }
+}
+
+TEST_CASE("ProjectFile - Saves replace the file whole", "[project]") {
+    juce::TemporaryFile temp(ProjectFile::kFileExtension);
+    auto model = makeModel();
+    uint64_t firstHash = 0;
+    REQUIRE(ProjectFile::write(temp.getFile(), model, &firstHash).isEmpty());
+    CHECK(firstHash == ProjectFile::hashModel(model));
+
+    model.tracks[0].name = "Lead";
+    uint64_t secondHash = 0;
+    REQUIRE(ProjectFile::write(temp.getFile(), model, &secondHash).isEmpty());
+    CHECK(secondHash != firstHash);
+
+    // Only the project itself is left in the directory: no temporary siblings
+    const auto siblings = temp.getFile().getParentDirectory().findChildFiles(
+        juce::File::findFiles, false, temp.getFile().getFileNameWithoutExtension() + "*");
+    CHECK(siblings.size() == 1);
+
+    juce::String error;
+    auto reader = ProjectFile::Reader::open(temp.getFile(), error);
+    REQUIRE(reader != nullptr);
+    ProjectModel loaded;
+    REQUIRE(reader->readModel(loaded).isEmpty());
+    CHECK(loaded.tracks[0].name == "Lead");
+}
+
+TEST_CASE("ProjectFile - Files that aren't projects are rejected", "[project]") {
+    juce::TemporaryFile temp(ProjectFile::kFileExtension);
+    juce::String error;
+
+    SECTION("Missing") {
+        CHECK(ProjectFile::Reader::open(temp.getFile(), error) == nullptr);
+        CHECK(error.isNotEmpty());
+    }
+
+    SECTION("Not a project") {
+        REQUIRE(temp.getFile().replaceWithText("<xml>not a project</xml>"));
+        CHECK(ProjectFile::Reader::open(temp.getFile(), error) == nullptr);
+        CHECK(error.isNotEmpty());
+    }
+
+    SECTION("Truncated") {
+        REQUIRE(ProjectFile::write(temp.getFile(), makeModel()).isEmpty());
+        juce::MemoryBlock data;
+        REQUIRE(temp.getFile().loadFileAsData(data));
+        data.setSize(data.getSize() / 2);
+        REQUIRE(temp.getFile().replaceWithData(data.getData(), data.getSize()));
+
+        CHECK(ProjectFile::Reader::open(temp.getFile(), error) == nullptr);
+        CHECK(error.isNotEmpty());
+    }
+}
+
+TEST_CASE("ProjectFile - Note and point counts the data can't hold are rejected", "[project]") {
+    const auto check = [](int sectionType, const juce::Identifier& name, size_t recordSize) {
+        // Exactly full is fine
+        ProjectModel model;
+        const auto full = blobWithCount(2, 2 * recordSize);
+        CHECK(ProjectFile::decodeSections(withBlob(sectionType, name, full), model).isEmpty());
+
+        const int maxPayload = 4 * static_cast<int>(recordSize);
+        juce::Random random(0x4d41);
+        std::vector<juce::MemoryBlock> damaged = {
+            blobWithCount(std::numeric_limits<int>::max(), 8),
+            blobWithCount(-1, 0),
+            blobWithCount(2, 2 * recordSize - 1),  // Truncated
+            juce::MemoryBlock(2, true),            // Too short for the count
+        };
+        for (int i = 0; i < 50; ++i) {
+            // Any count past what the payload holds, up to ones that can't be allocated
+            const auto payload = static_cast<size_t>(random.nextInt(maxPayload));
+            const int count = static_cast<int>(payload / recordSize) + 1 + random.nextInt(1 << 30);
+            damaged.push_back(blobWithCount(count, payload));
+        }
+
+        for (const auto& blob : damaged) {
+            ProjectModel damagedModel;
+            juce::String error;
+            REQUIRE_NOTHROW(error = ProjectFile::decodeSections(
+                                withBlob(sectionType, name, blob), damagedModel));
+            CHECK(error.isNotEmpty());
+        }
+    };
+
+    // Note: id, number, velocity, start, length. Point: id, time, value, curve, two handles
+    // (time, value, linked), tension
+    check(ProjectFile::kClipSection, "notes", 4 + 1 + 1 + 8 + 8);
+    check(ProjectFile::kLaneSection, "points", 4 + 8 + 8 + 1 + 2 * (8 + 8 + 1) + 8);
+}
@@ -0,0 +1,204 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "../magda/daw/core/ProjectJournal.hpp"
+#include "ScopedDirectory.hpp"
+
+using namespace magda;
+
+namespace {
+
+TrackInfo makeTrack(TrackId id, const juce::String& name) {
+    TrackInfo track;
+    track.id = id;
+    track.name = name;
+    return track;
+}
+
+/**
+ * @brief The journal records for a model's track sections
+ */
+std::vector<ProjectJournal::Record> trackRecords(const std::vector<TrackInfo>& tracks) {
+    ProjectModel model;
+    model.tracks = tracks;
+
+    std::vector<ProjectJournal::Record> records;
+    ProjectFile::encodeSections(model, [&](int type, int key, const juce::MemoryBlock& data) {
+        if (type == ProjectFile::kTrackSection) {
+            records.push_back({type, key, data, false});
+        }
+    });
+    return records;
+}
+
+ProjectModel decode(const std::vector<ProjectFile::SectionData>& sections) {
+    ProjectModel model;
+    REQUIRE(ProjectFile::decodeSections(sections, model).isEmpty());
+    return model;
+}
+
+std::vector<ProjectFile::SectionData> encode(const ProjectModel& model) {
+    std::vector<ProjectFile::SectionData> sections;
+    ProjectFile::encodeSections(model, [&](int type, int key, const juce::MemoryBlock& data) {
+        sections.push_back({type, key, data});
+    });
+    return sections;
+}
+
+}  // namespace
+
+TEST_CASE("ProjectJournal - Replay", "[project][journal]") {
+    ProjectModel base;
+    base.tracks = {makeTrack(1, "Drums"), makeTrack(2, "Bass")};
+    auto sections = encode(base);
+    juce::File projectFile;
+
+    SECTION("Edited sections are replaced in place") {
+        ProjectJournal::replay(trackRecords({makeTrack(1, "Kit")}), sections, projectFile);
+        const auto model = decode(sections);
+        REQUIRE(model.tracks.size() == 2);
+        CHECK(model.tracks[0].name == "Kit");
+        CHECK(model.tracks[1].name == "Bass");
+    }
+
+    SECTION("New sections are added and the track order applied") {
+        auto records = trackRecords({makeTrack(3, "Keys")});
+        records.push_back(ProjectJournal::makeTrackOrderRecord({3, 1, 2}));
+        ProjectJournal::replay(records, sections, projectFile);
+
+        const auto model = decode(sections);
+        REQUIRE(model.tracks.size() == 3);
+        CHECK(model.tracks[0].id == 3);
+        CHECK(model.tracks[1].id == 1);
+        CHECK(model.tracks[2].id == 2);
+    }
+
+    SECTION("Removed sections are dropped") {
+        ProjectJournal::Record removal;
+        removal.type = ProjectFile::kTrackSection;
+        removal.key = 1;
+        removal.removed = true;
+        ProjectJournal::replay({removal}, sections, projectFile);
+
+        const auto model = decode(sections);
+        REQUIRE(model.tracks.size() == 1);
+        CHECK(model.tracks[0].id == 2);
+    }
+
+    SECTION("The project file follows the last record") {
+        const auto file = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                              .getChildFile("Song.magda");
+        ProjectJournal::replay({ProjectJournal::makeProjectFileRecord(file)}, sections,
+                               projectFile);
+        CHECK(projectFile == file);
+
+        ProjectJournal::replay({ProjectJournal::makeProjectFileRecord(juce::File())}, sections,
+                               projectFile);
+        CHECK(projectFile == juce::File());
+    }
+}
+
+TEST_CASE("ProjectJournal - Reading back", "[project][journal]") {
+    ScopedDirectory temp("magda_journal_test");
+    const auto file = ProjectJournal::getJournalFile(temp.directory, 4);
+
+    juce::String error;
+    auto writer = ProjectJournal::Writer::create(file, 4, error);
+    REQUIRE(writer != nullptr);
+    REQUIRE(writer->append(trackRecords({makeTrack(1, "First")})).isEmpty());
+    REQUIRE(writer->append(trackRecords({makeTrack(1, "Second")})).isEmpty());
+    const auto completeSize = writer->getSize();
+    writer.reset();
+
+    juce::int64 generation = 0;
+    std::vector<ProjectJournal::Record> records;
+
+    SECTION("Every complete batch is read, in order") {
+        REQUIRE(ProjectJournal::read(file, generation, records));
+        CHECK(generation == 4);
+        REQUIRE(records.size() == 2);
+    }
+
+    SECTION("A batch cut short is ignored") {
+        juce::MemoryBlock data;
+        REQUIRE(file.loadFileAsData(data));
+        REQUIRE(static_cast<juce::int64>(data.getSize()) == completeSize);
+        data.setSize(data.getSize() - 3);
+        REQUIRE(file.replaceWithData(data.getData(), data.getSize()));
+
+        REQUIRE(ProjectJournal::read(file, generation, records));
+        REQUIRE(records.size() == 1);
+
+        std::vector<ProjectFile::SectionData> sections;
+        juce::File projectFile;
+        ProjectJournal::replay(records, sections, projectFile);
+        CHECK(decode(sections).tracks[0].name == "First");
+    }
+
+    SECTION("Other files aren't journals") {
+        REQUIRE(file.replaceWithText("not a journal"));
+        CHECK_FALSE(ProjectJournal::read(file, generation, records));
+    }
+}
+
+TEST_CASE("ProjectJournal - Recover", "[project][journal]") {
+    ScopedDirectory temp("magda_journal_test");
+    const auto& directory = temp.directory;
+    CHECK_FALSE(ProjectJournal::hasRecoveryData(directory));
+
+    ProjectModel checkpoint;
+    checkpoint.tracks = {makeTrack(1, "Drums")};
+    checkpoint.pluginStates[5].tree = juce::ValueTree("PLUGIN");
+    REQUIRE(ProjectFile::write(ProjectJournal::getCheckpointFile(directory, 2), checkpoint)
+                .isEmpty());
+    CHECK(ProjectJournal::hasRecoveryData(directory));
+
+    const auto projectFile = directory.getChildFile("Song.magda");
+    juce::String error;
+    {
+        auto writer = ProjectJournal::Writer::create(ProjectJournal::getJournalFile(directory, 2),
+                                                     2, error);
+        REQUIRE(writer != nullptr);
+        REQUIRE(writer->append({ProjectJournal::makeProjectFileRecord(projectFile)}).isEmpty());
+        REQUIRE(writer->append(trackRecords({makeTrack(1, "Kit")})).isEmpty());
+    }
+
+    SECTION("The newest checkpoint gets its journals replayed") {
+        // An older generation's journal no longer applies
+        auto stale = ProjectJournal::Writer::create(ProjectJournal::getJournalFile(directory, 1),
+                                                    1, error);
+        REQUIRE(stale != nullptr);
+        REQUIRE(stale->append(trackRecords({makeTrack(1, "Stale")})).isEmpty());
+        stale.reset();
+
+        ProjectModel model;
+        std::shared_ptr<ProjectFile::Reader> reader;
+        juce::File recoveredFile;
+        REQUIRE(ProjectJournal::recover(directory, model, reader, recoveredFile).isEmpty());
+        REQUIRE(model.tracks.size() == 1);
+        CHECK(model.tracks[0].name == "Kit");
+        CHECK(recoveredFile == projectFile);
+
+        // Plugin states come through the reader, already out of the directory
+        ProjectJournal::deleteGenerationsBefore(directory, 0);
+        CHECK_FALSE(ProjectJournal::hasRecoveryData(directory));
+        REQUIRE(reader != nullptr);
+        CHECK(reader->takePluginState(5).isValid());
+    }
+
+    SECTION("A checkpoint that didn't finish falls back to the one before") {
+        REQUIRE(ProjectJournal::getCheckpointFile(directory, 3).replaceWithText("partial"));
+
+        ProjectModel model;
+        std::shared_ptr<ProjectFile::Reader> reader;
+        juce::File recoveredFile;
+        REQUIRE(ProjectJournal::recover(directory, model, reader, recoveredFile).isEmpty());
+        REQUIRE(model.tracks.size() == 1);
+        CHECK(model.tracks[0].name == "Kit");
+    }
+
+    SECTION("Older generations are deleted once a checkpoint covers them") {
+        ProjectJournal::deleteGenerationsBefore(directory, 3);
+        CHECK_FALSE(ProjectJournal::getCheckpointFile(directory, 2).existsAsFile());
+        CHECK_FALSE(ProjectJournal::getJournalFile(directory, 2).existsAsFile());
+    }
+}
@@ -0,0 +1,103 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "../magda/daw/core/ClipManager.hpp"
+#include "../magda/daw/core/ProjectSnapshot.hpp"
+#include "../magda/daw/core/TrackManager.hpp"
+
+using namespace magda;
+
+namespace {
+
+struct PublisherScope {
+    PublisherScope() {
+        ClipManager::getInstance().clearAllClips();
+        TrackManager::getInstance().clearAllTracks();
+        ProjectSnapshotPublisher::getInstance().start();
+    }
+    ~PublisherScope() {
+        ProjectSnapshotPublisher::getInstance().shutdown();
+    }
+};
+
+}  // namespace
+
+// ============================================================================
+// ProjectSnapshotPublisher Tests
+// ============================================================================
+
+TEST_CASE("ProjectSnapshot - Holds the model as it was when published", "[snapshot]") {
+    PublisherScope scope;
+    auto& publisher = ProjectSnapshotPublisher::getInstance();
+    auto& trackManager = TrackManager::getInstance();
+    auto& clipManager = ClipManager::getInstance();
+
+    const auto trackId = trackManager.createTrack("Keys", TrackType::Instrument);
+    const auto clipId = clipManager.createMidiClip(trackId, 1.0, 4.0);
+    clipManager.addMidiNote(clipId, MidiNote{INVALID_MIDI_NOTE_ID, 60, 100, 0.0, 1.0});
+
+    const auto before = publisher.publishNow();
+    REQUIRE(before->getTrackIds() == std::vector<TrackId>{trackId});
+    REQUIRE(before->findTrack(trackId)->name == "Keys");
+    REQUIRE(before->getClipsOnTrack(trackId).size() == 1);
+    REQUIRE(before->findClip(clipId)->midiNotes.size() == 1);
+
+    trackManager.setTrackName(trackId, "Piano");
+    clipManager.addMidiNote(clipId, MidiNote{INVALID_MIDI_NOTE_ID, 64, 100, 1.0, 1.0});
+    const auto after = publisher.publishNow();
+
+    REQUIRE(after->version > before->version);
+    REQUIRE(after->findTrack(trackId)->name == "Piano");
+    REQUIRE(after->findClip(clipId)->midiNotes.size() == 2);
+
+    // The earlier snapshot is untouched
+    REQUIRE(before->findTrack(trackId)->name == "Keys");
+    REQUIRE(before->findClip(clipId)->midiNotes.size() == 1);
+}
+
+TEST_CASE("ProjectSnapshot - Shares clips that did not change", "[snapshot]") {
+    PublisherScope scope;
+    auto& publisher = ProjectSnapshotPublisher::getInstance();
+    auto& clipManager = ClipManager::getInstance();
+
+    const auto trackId = TrackManager::getInstance().createTrack("Drums", TrackType::Instrument);
+    const auto edited = clipManager.createMidiClip(trackId, 0.0, 4.0);
+    const auto untouched = clipManager.createMidiClip(trackId, 4.0, 4.0);
+    const auto before = publisher.publishNow();
+
+    clipManager.setClipName(edited, "Fill");
+    const auto after = publisher.publishNow();
+
+    REQUIRE(after->findClip(edited)->name == "Fill");
+    REQUIRE(after->findClip(edited) != before->findClip(edited));
+    REQUIRE(after->findClip(untouched) == before->findClip(untouched));
+}
+
+TEST_CASE("ProjectSnapshot - Tracks clips added and removed", "[snapshot]") {
+    PublisherScope scope;
+    auto& publisher = ProjectSnapshotPublisher::getInstance();
+    auto& clipManager = ClipManager::getInstance();
+
+    const auto trackId = TrackManager::getInstance().createTrack("Bass", TrackType::Instrument);
+    const auto first = clipManager.createMidiClip(trackId, 8.0, 4.0);
+    const auto second = clipManager.createMidiClip(trackId, 0.0, 4.0);
+
+    auto snapshot = publisher.publishNow();
+    const auto clips = snapshot->getClipsOnTrack(trackId);
+    REQUIRE(clips.size() == 2);
+    REQUIRE(clips[0]->id == second);  // By start time
+    REQUIRE(clips[1]->id == first);
+
+    clipManager.deleteClip(first);
+    snapshot = publisher.publishNow();
+    REQUIRE(snapshot->findClip(first) == nullptr);
+    REQUIRE(snapshot->getClipsOnTrack(trackId).size() == 1);
+}
+
+TEST_CASE("ProjectSnapshot - Empty after shutdown", "[snapshot]") {
+    {
+        PublisherScope scope;
+        TrackManager::getInstance().createTrack();
+        REQUIRE(ProjectSnapshotPublisher::getInstance().publishNow()->tracks.size() == 1);
+    }
+    REQUIRE(ProjectSnapshotPublisher::getInstance().getLatest()->tracks.empty());
+}
@@ -0,0 +1,31 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "../magda/daw/engine/ProjectSwitcher.hpp"
+
+using namespace magda;
+using Catch::Approx;
+
+TEST_CASE("ProjectSwitcher times the switch to the next bar line", "[project]") {
+    // 120 BPM in 4/4: a bar is two seconds
+    REQUIRE(ProjectSwitcher::secondsToNextBar(0.5, 120.0, 4, 4) == Approx(1.5));
+    REQUIRE(ProjectSwitcher::secondsToNextBar(3.0, 120.0, 4, 4) == Approx(1.0));
+    REQUIRE(ProjectSwitcher::secondsToNextBar(7.999, 120.0, 4, 4) == Approx(0.001));
+}
+
+TEST_CASE("ProjectSwitcher switches at once on a bar line", "[project]") {
+    REQUIRE(ProjectSwitcher::secondsToNextBar(0.0, 120.0, 4, 4) == 0.0);
+    REQUIRE(ProjectSwitcher::secondsToNextBar(4.0, 120.0, 4, 4) == 0.0);
+}
+
+TEST_CASE("ProjectSwitcher measures bars in the time signature's beats", "[project]") {
+    // 6/8 at 120 quarter notes a minute: six eighths are 1.5 seconds
+    REQUIRE(ProjectSwitcher::secondsToNextBar(1.0, 120.0, 6, 8) == Approx(0.5));
+    // 3/4 at 90: three beats are 2 seconds
+    REQUIRE(ProjectSwitcher::secondsToNextBar(2.5, 90.0, 3, 4) == Approx(1.5));
+}
+
+TEST_CASE("ProjectSwitcher switches at once without a usable tempo", "[project]") {
+    REQUIRE(ProjectSwitcher::secondsToNextBar(1.0, 0.0, 4, 4) == 0.0);
+    REQUIRE(ProjectSwitcher::secondsToNextBar(1.0, 120.0, 0, 4) == 0.0);
+}
@@ -0,0 +1,95 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <mutex>
+
+#include "../magda/daw/profiling/RealtimeSafety.hpp"
+
+using namespace magda;
+
+namespace {
+
+int* volatile allocationSink = nullptr;
+
+void allocateAndFree() {
+    allocationSink = new int(1);
+    delete allocationSink;
+    allocationSink = nullptr;
+}
+
+}  // namespace
+
+// ============================================================================
+// RealtimeSafety Tests
+// ============================================================================
+// Nothing is asserted while a context is open: Catch allocates, which would be reported
+// (and halts under RealtimeSanitizer)
+
+TEST_CASE("RealtimeSafety - Contexts nest and can be suspended", "[realtime]") {
+    bool inOuter = false, inInner = false, inSuspension = false, afterInner = false;
+    {
+        ScopedRealtimeContext outer;
+        inOuter = RealtimeSafety::isRealtimeContext();
+        {
+            ScopedRealtimeContext inner;
+            inInner = RealtimeSafety::isRealtimeContext();
+            ScopedRealtimeSuspension suspension;
+            inSuspension = RealtimeSafety::isRealtimeContext();
+        }
+        afterInner = RealtimeSafety::isRealtimeContext();
+    }
+
+    const bool enabled = RealtimeSafety::getMode() != RealtimeSafety::Mode::Off;
+    REQUIRE(inOuter == enabled);
+    REQUIRE(inInner == enabled);
+    REQUIRE_FALSE(inSuspension);
+    REQUIRE(afterInner == enabled);
+    REQUIRE_FALSE(RealtimeSafety::isRealtimeContext());
+}
+
+TEST_CASE("RealtimeSafety - Built-in hooks report allocation", "[realtime]") {
+    if (RealtimeSafety::getMode() != RealtimeSafety::Mode::BuiltIn) {
+        SUCCEED("Built-in hooks not compiled in");
+        return;
+    }
+    RealtimeSafety::setHaltOnViolation(false);
+
+    const int before = RealtimeSafety::getViolationCount();
+    allocateAndFree();
+    const int outside = RealtimeSafety::getViolationCount();
+    {
+        ScopedRealtimeContext realtime;
+        allocateAndFree();
+    }
+    const int inside = RealtimeSafety::getViolationCount();
+    {
+        ScopedRealtimeContext realtime;
+        ScopedRealtimeSuspension suspension;
+        allocateAndFree();
+    }
+    const int suspended = RealtimeSafety::getViolationCount();
+
+    REQUIRE(outside == before);
+    REQUIRE(inside == outside + 2);  // The new and the delete
+    REQUIRE(suspended == inside);
+}
+
+#if defined(__linux__)
+TEST_CASE("RealtimeSafety - Built-in hooks report locks", "[realtime]") {
+    if (RealtimeSafety::getMode() != RealtimeSafety::Mode::BuiltIn) {
+        SUCCEED("Built-in hooks not compiled in");
+        return;
+    }
+    RealtimeSafety::setHaltOnViolation(false);
+
+    std::mutex mutex;
+    const int before = RealtimeSafety::getViolationCount();
+    {
+        ScopedRealtimeContext realtime;
+        mutex.lock();
+        mutex.unlock();
+    }
+    const int after = RealtimeSafety::getViolationCount();
+
+    REQUIRE(after == before + 1);
+}
+#endif
@@ -0,0 +1,48 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <memory>
+
+#include "../magda/daw/audio/RealtimeSnapshot.hpp"
+
+using namespace magda;
+
+// ============================================================================
+// RealtimeSnapshot Tests
+// ============================================================================
+
+TEST_CASE("RealtimeSnapshot - Readers see the latest snapshot", "[audio][snapshot]") {
+    RealtimeSnapshot<int> snapshot;
+    REQUIRE(snapshot.acquire() == nullptr);
+    snapshot.release();
+
+    snapshot.publish(std::make_unique<int>(1));
+    snapshot.publish(std::make_unique<int>(2));
+    REQUIRE(*snapshot.acquire() == 2);
+    snapshot.release();
+    REQUIRE_FALSE(snapshot.hasRetired());
+}
+
+TEST_CASE("RealtimeSnapshot - A pinned snapshot survives replacement", "[audio][snapshot]") {
+    RealtimeSnapshot<int, 3> snapshot;
+    snapshot.publish(std::make_unique<int>(1));
+
+    int* first = snapshot.acquire(0);
+    snapshot.publish(std::make_unique<int>(2));
+    int* second = snapshot.acquire(2);
+    snapshot.publish(std::make_unique<int>(3));
+
+    // Reader 0 holds 1, reader 2 holds 2, 3 is published
+    REQUIRE(snapshot.hasRetired());
+    REQUIRE(*first == 1);
+    REQUIRE(*second == 2);
+
+    snapshot.release(0);
+    snapshot.collectGarbage();
+    REQUIRE(*second == 2);
+    REQUIRE(snapshot.hasRetired());
+
+    snapshot.release(2);
+    snapshot.collectGarbage();
+    REQUIRE_FALSE(snapshot.hasRetired());
+    REQUIRE(*snapshot.getPublished() == 3);
+}
@@ -0,0 +1,168 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <thread>
+
+#include "../magda/daw/core/RackInfo.hpp"
+#include "../magda/daw/profiling/RenderComparison.hpp"
+#include "../magda/daw/profiling/ThreadCpuSampler.hpp"
+
+using namespace magda;
+using Catch::Approx;
+
+namespace {
+
+juce::AudioBuffer<float> makeSine(int channels = 2, int samples = 4410) {
+    juce::AudioBuffer<float> buffer(channels, samples);
+    for (int ch = 0; ch < channels; ++ch) {
+        for (int i = 0; i < samples; ++i) {
+            buffer.setSample(ch, i, 0.5f * std::sin(0.0628f * static_cast<float>(i)));
+        }
+    }
+    return buffer;
+}
+
+DeviceInfo makeDevice(DeviceId id, PluginFormat format) {
+    DeviceInfo device;
+    device.id = id;
+    device.format = format;
+    return device;
+}
+
+}  // namespace
+
+// =============================================================================
+// RenderComparison
+// =============================================================================
+
+TEST_CASE("RenderComparison passes identical renders bit-exact", "[render_check]") {
+    const auto golden = makeSine();
+    const auto comparison = RenderComparison::compare(golden, makeSine());
+
+    REQUIRE(comparison.sameShape);
+    REQUIRE(comparison.bitExact);
+    REQUIRE(comparison.firstDifference == -1);
+    REQUIRE(comparison.passes(true, -80.0));
+}
+
+TEST_CASE("RenderComparison holds built-in renders to the bit", "[render_check]") {
+    const auto golden = makeSine();
+    auto rendered = makeSine();
+    rendered.setSample(1, 1000, rendered.getSample(1, 1000) + 1.0e-7f);
+
+    const auto comparison = RenderComparison::compare(golden, rendered);
+    REQUIRE_FALSE(comparison.bitExact);
+    REQUIRE(comparison.firstDifference == 1000);
+    REQUIRE(comparison.getMaxDiffDb() < -120.0);
+
+    // Inaudible, so fine for an external plugin but not for MAGDA's own devices
+    REQUIRE(comparison.passes(false, -80.0));
+    REQUIRE_FALSE(comparison.passes(true, -80.0));
+}
+
+TEST_CASE("RenderComparison fails differences above the tolerance", "[render_check]") {
+    auto rendered = makeSine();
+    rendered.applyGain(0.5f);
+
+    const auto comparison = RenderComparison::compare(makeSine(), rendered);
+    REQUIRE(comparison.getMaxDiffDb() == Approx(-12.04).margin(0.1));
+    REQUIRE_FALSE(comparison.passes(false, -80.0));
+}
+
+TEST_CASE("RenderComparison treats signed zeros as different bits", "[render_check]") {
+    juce::AudioBuffer<float> golden(1, 16), rendered(1, 16);
+    golden.clear();
+    rendered.clear();
+    rendered.setSample(0, 3, -0.0f);
+
+    const auto comparison = RenderComparison::compare(golden, rendered);
+    REQUIRE_FALSE(comparison.bitExact);
+    REQUIRE(comparison.maxAbsDiff == 0.0f);
+    REQUIRE(comparison.firstDifference == 3);
+}
+
+TEST_CASE("RenderComparison fails renders of another length or width", "[render_check]") {
+    REQUIRE_FALSE(RenderComparison::compare(makeSine(2, 4410), makeSine(2, 4400)).sameShape);
+    REQUIRE_FALSE(RenderComparison::compare(makeSine(2), makeSine(1)).passes(false, 0.0));
+}
+
+// =============================================================================
+// ThreadCpuSampler
+// =============================================================================
+
+TEST_CASE("ThreadCpuSampler utilisation is CPU time over wall time", "[render_check]") {
+    const std::vector<ThreadCpuSampler::ThreadTime> before = {
+        {1, "Message Thread", 1.0}, {2, "Render Thread", 4.0}, {3, "Idle", 2.0}};
+    const std::vector<ThreadCpuSampler::ThreadTime> after = {{1, "Message Thread", 1.5},
+                                                             {2, "Render Thread", 6.0},
+                                                             {3, "Idle", 2.0},
+                                                             {4, "Render Pool", 1.0}};
+
+    const auto result = ThreadCpuSampler::utilisation(before, after, 2.0);
+
+    // Busiest first; the idle thread is below the threshold
+    REQUIRE(result.size() == 3);
+    REQUIRE(result[0].name == "Render Thread");
+    REQUIRE(result[0].fraction == Approx(1.0));
+    REQUIRE(result[1].fraction == Approx(0.5));
+    REQUIRE(result[2].fraction == Approx(0.25));
+
+    // Started after the first sample, so counted from zero
+    REQUIRE(result[1].id == 4);
+}
+
+TEST_CASE("ThreadCpuSampler reports nothing over no wall time", "[render_check]") {
+    REQUIRE(ThreadCpuSampler::utilisation({}, {{1, "A", 1.0}}, 0.0).empty());
+}
+
+#if JUCE_LINUX || JUCE_MAC || JUCE_WINDOWS
+TEST_CASE("ThreadCpuSampler sees a busy thread's CPU time", "[render_check]") {
+    const auto before = ThreadCpuSampler::sample();
+    REQUIRE_FALSE(before.empty());
+
+    const double start = juce::Time::getMillisecondCounterHiRes();
+    std::thread busy([] {
+        const double until = juce::Time::getMillisecondCounterHiRes() + 200.0;
+        volatile double sink = 0.0;
+        while (juce::Time::getMillisecondCounterHiRes() < until) {
+            sink = sink + 1.0;
+        }
+    });
+    // Sampled while the thread is still alive, or it isn't listed
+    juce::Thread::sleep(150);
+    const auto after = ThreadCpuSampler::sample();
+    const double wallSeconds = (juce::Time::getMillisecondCounterHiRes() - start) / 1000.0;
+    busy.join();
+
+    double total = 0.0;
+    for (const auto& thread : ThreadCpuSampler::utilisation(before, after, wallSeconds)) {
+        total += thread.fraction;
+    }
+    REQUIRE(total > 0.3);
+}
+#endif
+
+// =============================================================================
+// Built-in devices
+// =============================================================================
+
+TEST_CASE("usesOnlyBuiltInDevices looks inside racks", "[render_check]") {
+    std::vector<ChainElement> elements;
+    REQUIRE(usesOnlyBuiltInDevices(elements));
+
+    elements.push_back(makeDeviceElement(makeDevice(1, PluginFormat::Internal)));
+    RackInfo rack;
+    rack.id = 10;
+    ChainInfo chain;
+    chain.id = 20;
+    chain.elements.push_back(makeDeviceElement(makeDevice(2, PluginFormat::Internal)));
+    rack.chains.push_back(chain);
+    elements.push_back(makeRackElement(rack));
+    REQUIRE(usesOnlyBuiltInDevices(elements));
+
+    rack.chains.front().elements.push_back(
+        makeDeviceElement(makeDevice(3, PluginFormat::VST3)));
+    elements.back() = makeRackElement(rack);
+    REQUIRE_FALSE(usesOnlyBuiltInDevices(elements));
+}
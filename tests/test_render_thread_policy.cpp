@@ -0,0 +1,90 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <thread>
+
+#include "../magda/daw/audio/RenderThreadPolicy.hpp"
+
+using namespace magda;
+
+// ============================================================================
+// RenderThreadSettings Tests
+// ============================================================================
+
+TEST_CASE("RenderThreadSettings - Resolves the thread count", "[audio][threads]") {
+    RenderThreadSettings settings;
+
+    SECTION("Automatic uses half the cores") {
+        REQUIRE(settings.resolveNumThreads(8) == 4);
+        REQUIRE(settings.resolveNumThreads(1) == 1);
+    }
+
+    SECTION("Explicit count is capped at the core count") {
+        settings.numThreads = 6;
+        REQUIRE(settings.resolveNumThreads(8) == 6);
+        REQUIRE(settings.resolveNumThreads(4) == 4);
+    }
+
+    SECTION("Unknown core count still renders on one thread") {
+        REQUIRE(settings.resolveNumThreads(0) == 1);
+    }
+}
+
+TEST_CASE("RenderThreadSettings - Pins from the last core down", "[audio][threads]") {
+    REQUIRE(RenderThreadSettings::coreForThread(0, 8) == 7);
+    REQUIRE(RenderThreadSettings::coreForThread(1, 8) == 6);
+    REQUIRE(RenderThreadSettings::coreForThread(7, 8) == 0);
+    REQUIRE(RenderThreadSettings::coreForThread(8, 8) == 7);  // Wraps past the last core
+}
+
+TEST_CASE("RenderThreadSettings - Background work gets the cores below rendering",
+          "[audio][threads]") {
+    RenderThreadSettings settings;
+
+    SECTION("Core 0 is left out when others are free") {
+        REQUIRE(settings.backgroundCoreMask(8) == 0b1110u);  // Rendering on 4-7
+        settings.numThreads = 2;
+        REQUIRE(settings.backgroundCoreMask(4) == 0b0010u);
+    }
+
+    SECTION("One free core is core 0") {
+        REQUIRE(settings.backgroundCoreMask(2) == 0b0001u);
+    }
+
+    SECTION("Nothing is free when rendering takes every core") {
+        REQUIRE(settings.backgroundCoreMask(1) == 0u);
+        settings.numThreads = 8;
+        REQUIRE(settings.backgroundCoreMask(8) == 0u);
+    }
+}
+
+// ============================================================================
+// RenderThreadPolicy Tests
+// ============================================================================
+
+TEST_CASE("RenderThreadPolicy - Threads configure once per settings change",
+          "[audio][threads]") {
+    auto& policy = RenderThreadPolicy::getInstance();
+    RenderThreadSettings settings;
+    settings.numThreads = 2;
+    policy.setSettings(settings);
+    REQUIRE(policy.getSettings() == settings);
+    REQUIRE(policy.getNumConfiguredThreads() == 0);
+
+    policy.applyToCurrentThread();
+    policy.applyToCurrentThread();
+    REQUIRE(policy.getNumConfiguredThreads() == 1);
+
+    std::thread other([&policy]() {
+        policy.applyToCurrentThread();
+        policy.applyToCurrentThread();
+    });
+    other.join();
+    REQUIRE(policy.getNumConfiguredThreads() == 2);
+
+    // A change resets the claimed cores; each thread re-applies on its next block
+    settings.performanceCores = false;
+    policy.setSettings(settings);
+    REQUIRE(policy.getNumConfiguredThreads() == 0);
+    policy.applyToCurrentThread();
+    REQUIRE(policy.getNumConfiguredThreads() == 1);
+}
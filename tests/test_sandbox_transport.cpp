@@ -0,0 +1,149 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "../magda/daw/audio/SandboxTransport.hpp"
+
+using namespace magda;
+using namespace std::chrono_literals;
+
+namespace {
+
+// A region as the mapping would give it, zeroed
+struct Region {
+    Region() : bytes(SandboxTransport::getRegionBytes() / sizeof(double) + 1, 0.0) {}
+    void* data() {
+        return bytes.data();
+    }
+    std::vector<double> bytes;
+};
+
+}  // namespace
+
+// ============================================================================
+// SandboxTransport Tests
+// ============================================================================
+
+TEST_CASE("SandboxTransport - Lays out a region", "[audio][sandbox]") {
+    Region region;
+    SandboxTransport transport(region.data());
+    REQUIRE_FALSE(transport.isValid());
+
+    transport.initialise();
+    REQUIRE(transport.isValid());
+    REQUIRE(transport.isIdle());
+
+    SECTION("Channels and MIDI don't overlap") {
+        auto* first = reinterpret_cast<char*>(transport.getChannel(0));
+        auto* last = reinterpret_cast<char*>(transport.getChannel(SandboxTransport::kMaxChannels -
+                                                                  1));
+        REQUIRE(first >= reinterpret_cast<char*>(&transport.header() + 1));
+        REQUIRE(last - first ==
+                static_cast<long>((SandboxTransport::kMaxChannels - 1) *
+                                  SandboxTransport::kMaxFrames * sizeof(float)));
+
+        auto* midiIn = reinterpret_cast<char*>(transport.getMidiIn());
+        auto* midiOut = reinterpret_cast<char*>(transport.getMidiOut());
+        REQUIRE(midiIn >= last + SandboxTransport::kMaxFrames * sizeof(float));
+        REQUIRE(midiOut >= midiIn + SandboxTransport::kMaxMidiEvents *
+                                        sizeof(SandboxTransport::MidiEvent));
+        REQUIRE(midiOut + SandboxTransport::kMaxMidiEvents * sizeof(SandboxTransport::MidiEvent) <=
+                reinterpret_cast<char*>(region.data()) + SandboxTransport::getRegionBytes());
+    }
+
+    SECTION("A second process attaching sees the same layout") {
+        SandboxTransport other(region.data());
+        REQUIRE(other.isValid());
+        REQUIRE(other.getChannel(1) == transport.getChannel(1));
+    }
+}
+
+TEST_CASE("SandboxTransport - Round trips a block", "[audio][sandbox]") {
+    Region region;
+    SandboxTransport daw(region.data());
+    daw.initialise();
+
+    // The host: each requested slot applies its number as a gain, and MIDI is echoed back
+    std::jthread host([&region] {
+        SandboxTransport transport(region.data());
+        uint32_t lastSeen = 0;
+        for (int block = 0; block < 3; ++block) {
+            if (!transport.waitForRequest(lastSeen, 5s)) {
+                return;  // Catch assertions stay on the test's thread; the DAW side fails
+            }
+            auto& h = transport.header();
+            for (int s = 0; s < h.numSlots; ++s) {
+                const float gain = static_cast<float>(h.slots[s]);
+                for (int ch = 0; ch < h.numChannels; ++ch) {
+                    auto* data = transport.getChannel(ch);
+                    for (int i = 0; i < h.numFrames; ++i) {
+                        data[i] *= gain;
+                    }
+                }
+            }
+            auto* out = transport.getMidiOut();
+            for (int e = 0; e < h.numMidiIn; ++e) {
+                out[e] = transport.getMidiIn()[e];
+            }
+            h.numMidiOut = h.numMidiIn;
+            h.hostBusyNs = 1000;
+            transport.reply(lastSeen);
+        }
+    });
+
+    for (int block = 0; block < 3; ++block) {
+        auto& h = daw.header();
+        h.numFrames = 64;
+        h.numChannels = 2;
+        for (int ch = 0; ch < 2; ++ch) {
+            for (int i = 0; i < 64; ++i) {
+                daw.getChannel(ch)[i] = 1.0f;
+            }
+        }
+        // Two plugins batched into one round trip
+        h.numSlots = 2;
+        h.slots[0] = 2;
+        h.slots[1] = 3;
+        h.numMidiIn = 1;
+        daw.getMidiIn()[0] = {10, 3, {0x90, 60, 100}};
+
+        const auto sequence = daw.post();
+        REQUIRE(daw.waitForReply(sequence, 5s));
+        REQUIRE(daw.isIdle());
+        REQUIRE(daw.getChannel(0)[0] == 6.0f);
+        REQUIRE(daw.getChannel(1)[63] == 6.0f);
+        REQUIRE(h.numMidiOut == 1);
+        REQUIRE(daw.getMidiOut()[0].frame == 10);
+        REQUIRE(daw.getMidiOut()[0].data[1] == 60);
+    }
+}
+
+TEST_CASE("SandboxTransport - Gives up at the deadline", "[audio][sandbox]") {
+    Region region;
+    SandboxTransport daw(region.data());
+    daw.initialise();
+
+    SECTION("No host answers") {
+        const auto start = std::chrono::steady_clock::now();
+        const auto sequence = daw.post();
+        REQUIRE_FALSE(daw.waitForReply(sequence, 2ms));
+        REQUIRE(std::chrono::steady_clock::now() - start < 1s);
+        REQUIRE_FALSE(daw.isIdle());
+    }
+
+    SECTION("No request arrives") {
+        uint32_t lastSeen = 0;
+        REQUIRE_FALSE(daw.waitForRequest(lastSeen, 2ms));
+        REQUIRE(lastSeen == 0);
+    }
+
+    SECTION("A late reply is told apart from the next one") {
+        const auto first = daw.post();
+        daw.reply(first);
+        const auto second = daw.post();
+        REQUIRE(second == first + 1);
+        REQUIRE_FALSE(daw.waitForReply(second, 1ms));
+    }
+}
@@ -0,0 +1,205 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <unordered_set>
+
+#include "../magda/daw/core/ClipManager.hpp"
+#include "../magda/daw/core/SelectionManager.hpp"
+#include "../magda/daw/core/TrackManager.hpp"
+#include "../magda/daw/profiling/ScalingAnalysis.hpp"
+
+using namespace magda;
+using Catch::Approx;
+using Complexity = ScalingAnalysis::Complexity;
+
+namespace {
+
+const std::vector<double> kSizes = {125.0, 250.0, 500.0, 1000.0};
+
+void addCurve(ScalingAnalysis& analysis, const juce::String& metric,
+              const std::function<double(double)>& curve) {
+    for (auto n : kSizes) {
+        analysis.addPoint(metric, n, curve(n));
+    }
+}
+
+/**
+ * @brief Best of three, so one descheduled run doesn't read as growth
+ */
+double bestOfThreeMs(const std::function<void()>& fn) {
+    double best = 1.0e9;
+    for (int i = 0; i < 3; ++i) {
+        const double start = juce::Time::getMillisecondCounterHiRes();
+        fn();
+        best = std::min(best, juce::Time::getMillisecondCounterHiRes() - start);
+    }
+    return best;
+}
+
+}  // namespace
+
+// ============================================================================
+// ScalingAnalysis Tests
+// ============================================================================
+
+TEST_CASE("ScalingAnalysis - Fits the growth exponent", "[profiling][scaling]") {
+    std::vector<ScalingAnalysis::Point> linear, quadratic, constant;
+    for (auto n : kSizes) {
+        linear.push_back({n, 3.0 * n});
+        quadratic.push_back({n, 0.01 * n * n});
+        constant.push_back({n, 42.0});
+    }
+
+    REQUIRE(ScalingAnalysis::fitExponent(linear) == Approx(1.0));
+    REQUIRE(ScalingAnalysis::fitExponent(quadratic) == Approx(2.0));
+    REQUIRE(ScalingAnalysis::fitExponent(constant) == Approx(0.0).margin(1e-9));
+
+    SECTION("A single size has no slope") {
+        REQUIRE(ScalingAnalysis::fitExponent({{100.0, 5.0}}) == 0.0);
+    }
+
+    SECTION("Values under the floor read as constant") {
+        const std::vector<ScalingAnalysis::Point> noise = {
+            {125.0, 1e-6}, {250.0, 4e-6}, {500.0, 2e-6}, {1000.0, 9e-6}};
+        REQUIRE(ScalingAnalysis::fitExponent(noise, 1e-3) == Approx(0.0).margin(1e-9));
+    }
+}
+
+TEST_CASE("ScalingAnalysis - Holds each metric to its target class", "[profiling][scaling]") {
+    ScalingAnalysis analysis(0.25);
+
+    analysis.setTarget("linear ok", Complexity::Linear);
+    addCurve(analysis, "linear ok", [](double n) { return 2.0 * n + 10.0; });
+
+    analysis.setTarget("hidden quadratic", Complexity::Linear);
+    addCurve(analysis, "hidden quadratic", [](double n) { return n + 0.01 * n * n; });
+
+    analysis.setTarget("n log n", Complexity::Linearithmic);
+    addCurve(analysis, "n log n", [](double n) { return n * std::log(n); });
+
+    analysis.setTarget("constant", Complexity::Constant);
+    addCurve(analysis, "constant", [](double) { return 5.0; });
+
+    REQUIRE(analysis.getVerdict("linear ok").pass);
+    REQUIRE(analysis.getVerdict("n log n").pass);
+    REQUIRE(analysis.getVerdict("constant").pass);
+
+    const auto failures = analysis.getFailures();
+    REQUIRE(failures.size() == 1);
+    REQUIRE(failures[0].metric == "hidden quadratic");
+    REQUIRE(failures[0].exponent > 1.25);
+
+    SECTION("n log n is allowed its own effective exponent") {
+        const auto verdict = analysis.getVerdict("n log n");
+        REQUIRE(verdict.allowed > 1.25);
+        REQUIRE(verdict.allowed < 1.5);
+    }
+}
+
+TEST_CASE("ScalingAnalysis - JSON carries the verdicts and points", "[profiling][scaling]") {
+    ScalingAnalysis analysis;
+    analysis.setTarget("sync.full", Complexity::Linear);
+    addCurve(analysis, "sync.full", [](double n) { return 0.5 * n; });
+
+    const auto root = juce::JSON::parse(analysis.toJSON());
+    REQUIRE(static_cast<int>(root["schema"]) == ScalingAnalysis::kSchemaVersion);
+
+    const auto metric = root["metrics"]["sync.full"];
+    REQUIRE(metric["target"].toString() == "linear");
+    REQUIRE(static_cast<bool>(metric["pass"]));
+    REQUIRE(static_cast<double>(metric["exponent"]) == Approx(1.0));
+    REQUIRE(metric["points"].size() == static_cast<int>(kSizes.size()));
+    REQUIRE(static_cast<double>(metric["points"][3][0]) == Approx(1000.0));
+}
+
+// ============================================================================
+// Model scalability
+//
+// Hidden from the default run ([.]); CTest runs them as magda_scalability. The engine and
+// view metrics, at up to 1000 tracks and 100k clips, are in magda_bench --scaling.
+// ============================================================================
+
+TEST_CASE("Scalability - Model operations grow no faster than their targets",
+          "[.][scalability]") {
+    auto& tm = TrackManager::getInstance();
+    auto& cm = ClipManager::getInstance();
+    auto& selection = SelectionManager::getInstance();
+    constexpr int kClipsPerTrack = 50;
+    constexpr double kClipLength = 4.0;
+
+    ScalingAnalysis analysis;
+    analysis.setTarget("build", Complexity::Linear);
+    analysis.setTarget("range queries", Complexity::Linearithmic);
+    analysis.setTarget("selection", Complexity::Linear);
+    analysis.setTarget("move all", Complexity::Linear);
+
+    for (auto size : {100, 200, 400, 800}) {
+        selection.clearSelection();
+        cm.clearAllClips();
+        tm.clearAllTracks();
+        tm.flushPendingChanges();
+        cm.flushPendingChanges();
+
+        std::vector<TrackId> tracks;
+        std::vector<ClipId> clips;
+        const double buildMs = bestOfThreeMs([&] {
+            cm.clearAllClips();
+            tm.clearAllTracks();
+            tracks.clear();
+            clips.clear();
+            for (int t = 0; t < size; ++t) {
+                const auto trackId = tm.createTrack("Scale " + juce::String(t));
+                tracks.push_back(trackId);
+                for (int c = 0; c < kClipsPerTrack; ++c) {
+                    clips.push_back(cm.createMidiClip(trackId, c * kClipLength, kClipLength));
+                }
+            }
+            tm.flushPendingChanges();
+            cm.flushPendingChanges();
+        });
+        REQUIRE(clips.size() == static_cast<size_t>(size * kClipsPerTrack));
+        analysis.addPoint("build", size, buildMs);
+
+        size_t hits = 0;
+        analysis.addPoint("range queries", size, bestOfThreeMs([&] {
+                              for (auto trackId : tracks) {
+                                  for (int c = 0; c < kClipsPerTrack; c += 5) {
+                                      hits += cm.getClipsInRange(trackId, c * kClipLength,
+                                                                 (c + 1) * kClipLength)
+                                                  .size();
+                                  }
+                              }
+                          }));
+        REQUIRE(hits > 0);
+
+        const std::unordered_set<ClipId> allClips(clips.begin(), clips.end());
+        analysis.addPoint("selection", size, bestOfThreeMs([&] {
+                              selection.selectClips(allClips);
+                              selection.selectTimeRange(0.0, kClipsPerTrack * kClipLength,
+                                                        tracks);
+                              selection.clearSelection();
+                          }));
+
+        analysis.addPoint("move all", size, bestOfThreeMs([&] {
+                              for (auto clipId : clips) {
+                                  if (const auto* clip = cm.getClip(clipId)) {
+                                      cm.moveClip(clipId, clip->startTime + 0.25, 120.0);
+                                  }
+                              }
+                              cm.flushPendingChanges();
+                          }));
+    }
+
+    selection.clearSelection();
+    cm.clearAllClips();
+    tm.clearAllTracks();
+
+    for (const auto& verdict : analysis.getVerdicts()) {
+        INFO(verdict.metric << ": exponent " << verdict.exponent << ", allowed "
+                            << verdict.allowed);
+        CHECK(verdict.pass);
+    }
+}
@@ -0,0 +1,145 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <vector>
+
+#include "../magda/daw/core/SelectionManager.hpp"
+
+using namespace magda;
+
+// ============================================================================
+// SelectionManager notification Tests
+// ============================================================================
+// Each call announces its changes once with the final state, ScopedBatch stretches that
+// over several calls, and deltas say what was added and removed.
+
+namespace {
+
+struct RecordingListener : SelectionManagerListener {
+    RecordingListener() {
+        SelectionManager::getInstance().addListener(this);
+    }
+    ~RecordingListener() override {
+        SelectionManager::getInstance().removeListener(this);
+    }
+
+    void selectionTypeChanged(SelectionType newType) override {
+        types.push_back(newType);
+    }
+    void multiClipSelectionChanged(const std::unordered_set<ClipId>& clipIds) override {
+        multiClipSizes.push_back(clipIds.size());
+    }
+    void noteSelectionChanged(const NoteSelection& selection) override {
+        noteSelections.push_back(selection);
+    }
+    void clipSelectionDeltaChanged(const ClipSelectionDelta& delta) override {
+        clipDeltas.push_back(delta);
+    }
+    void noteSelectionDeltaChanged(const NoteSelectionDelta& delta) override {
+        noteDeltas.push_back(delta);
+    }
+
+    std::vector<SelectionType> types;
+    std::vector<size_t> multiClipSizes;
+    std::vector<NoteSelection> noteSelections;
+    std::vector<ClipSelectionDelta> clipDeltas;
+    std::vector<NoteSelectionDelta> noteDeltas;
+};
+
+}  // namespace
+
+TEST_CASE("SelectionManager - One notification per change", "[selection]") {
+    auto& selection = SelectionManager::getInstance();
+    selection.clearSelection();
+    RecordingListener listener;
+
+    selection.selectClips({4, 2, 7});
+    REQUIRE(listener.types == std::vector<SelectionType>{SelectionType::MultiClip});
+    REQUIRE(listener.multiClipSizes == std::vector<size_t>{3});
+    REQUIRE(listener.clipDeltas.size() == 1);
+    REQUIRE(listener.clipDeltas[0].added == std::vector<ClipId>{2, 4, 7});
+    REQUIRE(listener.clipDeltas[0].removed.empty());
+
+    // Adding several clips at once is one change, and only the new ones are in the delta
+    selection.addClipsToSelection({7, 9, 11});
+    REQUIRE(listener.types.size() == 1);
+    REQUIRE(listener.multiClipSizes == std::vector<size_t>{3, 5});
+    REQUIRE(listener.clipDeltas.size() == 2);
+    REQUIRE(listener.clipDeltas[1].added == std::vector<ClipId>{9, 11});
+
+    selection.removeClipFromSelection(4);
+    REQUIRE(listener.clipDeltas.size() == 3);
+    REQUIRE(listener.clipDeltas[2].added.empty());
+    REQUIRE(listener.clipDeltas[2].removed == std::vector<ClipId>{4});
+
+    selection.clearSelection();
+    REQUIRE(listener.types.back() == SelectionType::None);
+    REQUIRE(listener.clipDeltas.back().removed == std::vector<ClipId>{2, 7, 9, 11});
+}
+
+TEST_CASE("SelectionManager - Batches coalesce several calls", "[selection]") {
+    auto& selection = SelectionManager::getInstance();
+    selection.clearSelection();
+    RecordingListener listener;
+
+    {
+        const SelectionManager::ScopedBatch batch(selection);
+        selection.selectClip(1);
+        selection.selectClip(2);
+        selection.addClipToSelection(3);
+        selection.addClipToSelection(4);
+        REQUIRE(listener.types.empty());
+        REQUIRE(listener.clipDeltas.empty());
+    }
+
+    REQUIRE(listener.types == std::vector<SelectionType>{SelectionType::MultiClip});
+    REQUIRE(listener.multiClipSizes == std::vector<size_t>{3});
+    REQUIRE(listener.clipDeltas.size() == 1);
+    REQUIRE(listener.clipDeltas[0].added == std::vector<ClipId>{2, 3, 4});
+
+    // Ending on the type it started with sends no type change
+    listener.types.clear();
+    {
+        const SelectionManager::ScopedBatch batch(selection);
+        selection.selectClip(5);
+        selection.selectClips({6, 7});
+    }
+    REQUIRE(listener.types.empty());
+    REQUIRE(listener.clipDeltas.back().added == std::vector<ClipId>{6, 7});
+    REQUIRE(listener.clipDeltas.back().removed == std::vector<ClipId>{2, 3, 4});
+
+    selection.clearSelection();
+}
+
+TEST_CASE("SelectionManager - Note selections are sorted sets", "[selection]") {
+    auto& selection = SelectionManager::getInstance();
+    selection.clearSelection();
+    RecordingListener listener;
+
+    selection.selectNotes(10, {9, 3, 5, 3});
+    REQUIRE(selection.getNoteSelection().noteIds == std::vector<MidiNoteId>{3, 5, 9});
+    REQUIRE(selection.isNoteSelected(10, 5));
+    REQUIRE_FALSE(selection.isNoteSelected(10, 4));
+    REQUIRE_FALSE(selection.isNoteSelected(11, 5));
+    REQUIRE(listener.noteSelections.size() == 1);
+    REQUIRE(listener.noteDeltas.size() == 1);
+    REQUIRE(listener.noteDeltas[0].clipId == 10);
+    REQUIRE(listener.noteDeltas[0].added == std::vector<MidiNoteId>{3, 5, 9});
+
+    selection.addNoteToSelection(10, 4);
+    selection.removeNoteFromSelection(9);
+    REQUIRE(selection.getNoteSelection().noteIds == std::vector<MidiNoteId>{3, 4, 5});
+    REQUIRE(listener.noteDeltas.size() == 3);
+    REQUIRE(listener.noteDeltas[1].added == std::vector<MidiNoteId>{4});
+    REQUIRE(listener.noteDeltas[2].removed == std::vector<MidiNoteId>{9});
+
+    // Moving to another clip removes from the old one, then adds to the new one
+    selection.selectNote(12, 1);
+    REQUIRE(listener.noteDeltas.size() == 5);
+    REQUIRE(listener.noteDeltas[3].clipId == 10);
+    REQUIRE(listener.noteDeltas[3].removed == std::vector<MidiNoteId>{3, 4, 5});
+    REQUIRE(listener.noteDeltas[4].clipId == 12);
+    REQUIRE(listener.noteDeltas[4].added == std::vector<MidiNoteId>{1});
+
+    selection.clearSelection();
+    REQUIRE(listener.noteDeltas.back().removed == std::vector<MidiNoteId>{1});
+}
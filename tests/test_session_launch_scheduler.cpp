@@ -0,0 +1,419 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "../magda/daw/audio/SessionLaunchScheduler.hpp"
+#include "../magda/daw/core/ClipManager.hpp"
+
+using namespace magda;
+
+namespace {
+
+using Action = ClipLaunchRequest::Action;
+
+// 120 BPM at 48 kHz: a beat is 24000 samples
+constexpr double kBeatsPerSample = 1.0 / 24000.0;
+constexpr int kBlockSize = 512;
+
+ClipLaunchRequest launch(ClipId clipId, TrackId trackId, double quantiseBeats = 1.0) {
+    return {Action::Launch, clipId, trackId, quantiseBeats};
+}
+
+SessionLaunchScheduler::Block blockAt(double startBeat, int numSamples = kBlockSize) {
+    SessionLaunchScheduler::Block block;
+    block.startBeat = startBeat;
+    block.beatsPerSample = kBeatsPerSample;
+    block.numSamples = numSamples;
+    block.playing = true;
+    return block;
+}
+
+std::vector<SessionLaunchScheduler::Fired> run(SessionLaunchScheduler& scheduler,
+                                               const SessionLaunchScheduler::Block& block) {
+    std::vector<SessionLaunchScheduler::Fired> fired;
+    scheduler.process(block, [&fired](const auto& f) { fired.push_back(f); });
+    return fired;
+}
+
+// Plays blocks from startBeat until something fires: each clip fired, and on which sample
+// counting from startBeat
+std::vector<std::pair<ClipId, long>> playUntilFired(SessionLaunchScheduler& scheduler,
+                                                    double startBeat, int maxBlocks = 200) {
+    std::vector<std::pair<ClipId, long>> fired;
+    for (int b = 0; b < maxBlocks && fired.empty(); ++b) {
+        const double beat = startBeat + b * kBlockSize * kBeatsPerSample;
+        for (const auto& f : run(scheduler, blockAt(beat))) {
+            fired.emplace_back(f.request.clipId, long(b) * kBlockSize + f.sampleOffset);
+        }
+    }
+    return fired;
+}
+
+class RecordingLauncher : public ClipLauncher {
+  public:
+    bool scheduleClipLaunches(const std::vector<ClipLaunchRequest>& requests) override {
+        batches.push_back(requests);
+        return true;
+    }
+
+    std::vector<std::vector<ClipLaunchRequest>> batches;
+};
+
+}  // namespace
+
+TEST_CASE("SessionLaunchScheduler quantises up to the grid", "[session]") {
+    REQUIRE(SessionLaunchScheduler::quantiseUp(0.3, 1.0) == 1.0);
+    REQUIRE(SessionLaunchScheduler::quantiseUp(4.0, 4.0) == 4.0);
+    REQUIRE(SessionLaunchScheduler::quantiseUp(4.1, 4.0) == 8.0);
+    REQUIRE(SessionLaunchScheduler::quantiseUp(2.5, 0.0) == 2.5);
+}
+
+TEST_CASE("SessionLaunchScheduler fires on the exact sample of the beat", "[session]") {
+    SessionLaunchScheduler scheduler;
+    const double start = 0.25;  // A quarter beat in: the next beat is 18000 samples away
+    REQUIRE(scheduler.push({launch(1, 10)}));
+
+    // Taken in the first block, then waits
+    REQUIRE(run(scheduler, blockAt(start)).empty());
+    REQUIRE(scheduler.getNumPending() == 1);
+
+    const auto fired = playUntilFired(scheduler, start + kBlockSize * kBeatsPerSample);
+    REQUIRE(fired.size() == 1);
+    REQUIRE(fired[0].first == 1);
+    REQUIRE(fired[0].second + kBlockSize == 18000);
+    REQUIRE(scheduler.getNumPending() == 0);
+}
+
+TEST_CASE("SessionLaunchScheduler starts a scene in one sample", "[session]") {
+    SessionLaunchScheduler scheduler;
+    REQUIRE(scheduler.push({launch(1, 10, 4.0), launch(2, 11, 4.0), launch(3, 12, 4.0)}));
+
+    const auto fired = playUntilFired(scheduler, 1.5);
+    REQUIRE(fired.size() == 3);
+    REQUIRE(fired[0].second == fired[1].second);
+    REQUIRE(fired[1].second == fired[2].second);
+    REQUIRE(fired[0].first == 1);  // In the order they were launched
+    REQUIRE(fired[2].first == 3);
+}
+
+TEST_CASE("SessionLaunchScheduler replaces waiting requests", "[session]") {
+    SessionLaunchScheduler scheduler;
+
+    SECTION("A later launch on the same track wins") {
+        REQUIRE(scheduler.push({launch(1, 10)}));
+        REQUIRE(scheduler.push({launch(2, 10)}));
+        const auto fired = playUntilFired(scheduler, 0.5);
+        REQUIRE(fired.size() == 1);
+        REQUIRE(fired[0].first == 2);
+    }
+
+    SECTION("Stopping a clip calls off its launch") {
+        REQUIRE(scheduler.push({launch(1, 10)}));
+        REQUIRE(scheduler.push({{Action::Stop, 1, 10, 1.0}}));
+        run(scheduler, blockAt(0.5));
+        REQUIRE(scheduler.getNumPending() == 1);
+
+        const auto fired = playUntilFired(scheduler, 0.5 + kBlockSize * kBeatsPerSample);
+        REQUIRE(fired.size() == 1);
+    }
+}
+
+TEST_CASE("SessionLaunchScheduler fires at once while stopped", "[session]") {
+    SessionLaunchScheduler scheduler;
+    REQUIRE(scheduler.push({launch(1, 10, 4.0)}));
+
+    SessionLaunchScheduler::Block stopped;
+    stopped.numSamples = kBlockSize;
+    const auto fired = run(scheduler, stopped);
+    REQUIRE(fired.size() == 1);
+    REQUIRE(fired[0].sampleOffset == 0);
+}
+
+TEST_CASE("SessionLaunchScheduler re-times waiting requests after a jump", "[session]") {
+    SessionLaunchScheduler scheduler;
+    REQUIRE(scheduler.push({launch(1, 10, 4.0)}));
+    run(scheduler, blockAt(6.0));  // Waiting for beat 8
+
+    // Looped back to 0: beat 0 is on the grid, so it fires straight away
+    const auto fired = run(scheduler, blockAt(0.0));
+    REQUIRE(fired.size() == 1);
+    REQUIRE(fired[0].sampleOffset == 0);
+}
+
+TEST_CASE("SessionLaunchScheduler refuses a batch that doesn't fit", "[session]") {
+    SessionLaunchScheduler scheduler;
+    std::vector<ClipLaunchRequest> tooMany(SessionLaunchScheduler::kQueueSize + 1,
+                                           launch(1, 10));
+    REQUIRE_FALSE(scheduler.push(tooMany));
+    REQUIRE(scheduler.getDroppedCount() == tooMany.size());
+    REQUIRE(run(scheduler, blockAt(0.5)).empty());
+}
+
+TEST_CASE("SessionLaunchScheduler times follow-ups from their clip's launch", "[session]") {
+    SessionLaunchScheduler scheduler;
+    ClipLaunchRequest followUp{Action::Launch, 2, 10, 0.0, 1, 8.0};
+
+    SECTION("One handed over with the launch waits for it") {
+        REQUIRE(scheduler.push({launch(1, 10, 4.0), followUp}));
+        auto fired = playUntilFired(scheduler, 1.5);  // Launches on beat 4
+        REQUIRE(fired.size() == 1);
+        REQUIRE(fired[0].first == 1);
+        REQUIRE(scheduler.getNumPending() == 1);
+
+        // Eight beats later, on beat 12 to the sample
+        const long played = (fired[0].second / kBlockSize + 1) * kBlockSize;
+        fired = playUntilFired(scheduler, 1.5 + played * kBeatsPerSample, 1000);
+        REQUIRE(fired.size() == 1);
+        REQUIRE(fired[0].first == 2);
+        REQUIRE(played + fired[0].second == static_cast<long>((12.0 - 1.5) / kBeatsPerSample));
+    }
+
+    SECTION("One handed over later still lands on the beat") {
+        REQUIRE(scheduler.push({launch(1, 10, 4.0)}));
+        auto fired = playUntilFired(scheduler, 1.5);
+        REQUIRE(fired.size() == 1);
+
+        REQUIRE(scheduler.push({followUp}));
+        const long played = (fired[0].second / kBlockSize + 1) * kBlockSize;
+        fired = playUntilFired(scheduler, 1.5 + played * kBeatsPerSample, 1000);
+        REQUIRE(fired.size() == 1);
+        REQUIRE(played + fired[0].second == static_cast<long>((12.0 - 1.5) / kBeatsPerSample));
+    }
+
+    SECTION("Never while stopped") {
+        REQUIRE(scheduler.push({launch(1, 10, 4.0), followUp}));
+        SessionLaunchScheduler::Block stopped;
+        stopped.numSamples = kBlockSize;
+        REQUIRE(run(scheduler, stopped).size() == 1);
+        for (int i = 0; i < 10; ++i) {
+            REQUIRE(run(scheduler, stopped).empty());
+        }
+
+        // Playing from a stop counts the clip's eight beats from there
+        const auto fired = playUntilFired(scheduler, 16.0, 1000);
+        REQUIRE(fired.size() == 1);
+        REQUIRE(fired[0].second == static_cast<long>(8.0 / kBeatsPerSample));
+    }
+
+    SECTION("Launching or stopping its clip calls it off") {
+        REQUIRE(scheduler.push({launch(1, 10, 0.0), followUp}));
+        REQUIRE(run(scheduler, blockAt(0.5)).size() == 1);
+
+        REQUIRE(scheduler.push({launch(3, 11, 0.0)}));  // Another track: no effect
+        REQUIRE(run(scheduler, blockAt(0.6)).size() == 1);
+        REQUIRE(scheduler.getNumPending() == 1);
+
+        REQUIRE(scheduler.push({launch(4, 10, 0.0)}));
+        REQUIRE(run(scheduler, blockAt(0.7)).size() == 1);
+        REQUIRE(scheduler.getNumPending() == 0);
+    }
+
+    SECTION("One whose clip already stopped is ignored") {
+        REQUIRE(scheduler.push({{Action::Stop, 1, 10, 0.0}, followUp}));
+        run(scheduler, blockAt(0.5));
+        REQUIRE(scheduler.getNumPending() == 0);
+    }
+}
+
+TEST_CASE("SessionLaunchScheduler fires a chained scene in one sample", "[session]") {
+    SessionLaunchScheduler scheduler;
+
+    // Both tracks move on together, timed from the first track's clip
+    REQUIRE(scheduler.push({launch(1, 10, 0.0), launch(2, 11, 0.0)}));
+    REQUIRE(scheduler.push(
+        {{Action::Launch, 3, 10, 0.0, 1, 4.0}, {Action::Launch, 4, 11, 0.0, 1, 4.0}}));
+    REQUIRE(run(scheduler, blockAt(0.0)).size() == 2);
+
+    const auto fired = playUntilFired(scheduler, kBlockSize * kBeatsPerSample, 1000);
+    REQUIRE(fired.size() == 2);
+    REQUIRE(fired[0].first == 3);
+    REQUIRE(fired[1].first == 4);
+    REQUIRE(fired[0].second == fired[1].second);
+}
+
+// =============================================================================
+// ClipManager session launching
+// =============================================================================
+
+TEST_CASE("ClipManager launches at once without a launcher", "[session]") {
+    auto& clipManager = ClipManager::getInstance();
+    clipManager.clearAllClips();
+    const auto first = clipManager.createMidiClip(1, 0.0, 1.0);
+    const auto second = clipManager.createMidiClip(1, 2.0, 1.0);
+
+    clipManager.triggerClip(first);
+    REQUIRE(clipManager.getClip(first)->isPlaying);
+
+    clipManager.triggerClip(second);
+    REQUIRE(clipManager.getClip(second)->isPlaying);
+    REQUIRE_FALSE(clipManager.getClip(first)->isPlaying);
+
+    clipManager.stopAllClips();
+    REQUIRE_FALSE(clipManager.getClip(second)->isPlaying);
+    clipManager.clearAllClips();
+}
+
+TEST_CASE("ClipManager waits for the launcher to fire", "[session]") {
+    auto& clipManager = ClipManager::getInstance();
+    clipManager.clearAllClips();
+    const auto playing = clipManager.createMidiClip(1, 0.0, 1.0);
+    const auto next = clipManager.createMidiClip(1, 2.0, 1.0);
+    const auto other = clipManager.createMidiClip(2, 0.0, 1.0);
+    clipManager.triggerClip(playing);
+
+    RecordingLauncher launcher;
+    clipManager.setClipLauncher(&launcher);
+    clipManager.setLaunchQuantise(4.0);
+
+    clipManager.launchClips({next, other});
+    REQUIRE(launcher.batches.size() == 1);
+    REQUIRE(launcher.batches[0].size() == 2);
+    REQUIRE(launcher.batches[0][0].quantiseBeats == 4.0);
+
+    // Queued, and the clip it replaces plays on until the beat
+    REQUIRE(clipManager.getClip(next)->isQueued);
+    REQUIRE_FALSE(clipManager.getClip(next)->isPlaying);
+    REQUIRE(clipManager.getClip(playing)->isPlaying);
+
+    clipManager.clipLaunchFired(next);
+    REQUIRE(clipManager.getClip(next)->isPlaying);
+    REQUIRE_FALSE(clipManager.getClip(playing)->isPlaying);
+
+    SECTION("Stopping a queued clip calls its launch off") {
+        clipManager.stopClip(other);
+        REQUIRE_FALSE(clipManager.getClip(other)->isQueued);
+        clipManager.clipLaunchFired(other);
+        REQUIRE_FALSE(clipManager.getClip(other)->isPlaying);
+    }
+
+    SECTION("Stops wait for the beat too") {
+        clipManager.stopClip(next);
+        REQUIRE(clipManager.getClip(next)->isPlaying);
+        clipManager.clipStopFired(next);
+        REQUIRE_FALSE(clipManager.getClip(next)->isPlaying);
+    }
+
+    clipManager.setClipLauncher(nullptr);
+    clipManager.setLaunchQuantise(1.0);
+    clipManager.clearAllClips();
+}
+
+TEST_CASE("ClipManager hands follow-ups to the launcher", "[session]") {
+    auto& clipManager = ClipManager::getInstance();
+    clipManager.clearAllClips();
+    const auto first = clipManager.createMidiClip(1, 0.0, 1.0);
+    const auto second = clipManager.createMidiClip(1, 2.0, 1.0);
+    const auto third = clipManager.createMidiClip(1, 4.0, 1.0);
+    clipManager.setClipSceneIndex(first, 0);
+    clipManager.setClipSceneIndex(second, 1);
+    clipManager.setClipSceneIndex(third, 3);
+
+    RecordingLauncher launcher;
+    clipManager.setClipLauncher(&launcher);
+
+    SECTION("Next moves along the track and wraps round") {
+        clipManager.setClipFollowAction(first, FollowAction::Next, 8.0);
+        clipManager.setClipFollowAction(second, FollowAction::Next, 4.0);
+        clipManager.setClipFollowAction(third, FollowAction::Next, 4.0);
+        clipManager.triggerClip(first);
+
+        // Handed over with the launch, timed from it
+        REQUIRE(launcher.batches.size() == 1);
+        REQUIRE(launcher.batches[0].size() == 2);
+        const auto followUp = launcher.batches[0][1];
+        REQUIRE(followUp.isFollowUp());
+        REQUIRE(followUp.afterClipId == first);
+        REQUIRE(followUp.afterBeats == 8.0);
+        REQUIRE(followUp.clipId == second);
+
+        clipManager.clipLaunchFired(first);
+        REQUIRE(launcher.batches.size() == 1);
+
+        // The follow-up firing plays the clip and hands over the step after it
+        clipManager.clipLaunchFired(second);
+        REQUIRE(clipManager.getClip(second)->isPlaying);
+        REQUIRE_FALSE(clipManager.getClip(first)->isPlaying);
+        REQUIRE(launcher.batches.size() == 2);
+        REQUIRE(launcher.batches[1][0].clipId == third);
+        REQUIRE(launcher.batches[1][0].afterClipId == second);
+
+        clipManager.clipLaunchFired(third);
+        REQUIRE(launcher.batches.back()[0].clipId == first);
+    }
+
+    SECTION("Stop and Random") {
+        clipManager.setClipFollowAction(first, FollowAction::Stop, 4.0);
+        clipManager.triggerClip(first);
+        REQUIRE(launcher.batches[0][1].action == ClipLaunchRequest::Action::Stop);
+        REQUIRE(launcher.batches[0][1].clipId == first);
+
+        clipManager.setClipFollowAction(first, FollowAction::Random, 4.0);
+        clipManager.triggerClip(first);
+        const auto target = launcher.batches[1][1].clipId;
+        REQUIRE((target == second || target == third));
+    }
+
+    SECTION("A follow-up that wasn't handed over is ignored") {
+        clipManager.clipLaunchFired(second);
+        REQUIRE_FALSE(clipManager.getClip(second)->isPlaying);
+    }
+
+    SECTION("Without a launcher follow actions do nothing") {
+        clipManager.setClipLauncher(nullptr);
+        clipManager.setClipFollowAction(first, FollowAction::Next, 4.0);
+        clipManager.triggerClip(first);
+        REQUIRE(clipManager.getClip(first)->isPlaying);
+        REQUIRE_FALSE(clipManager.getClip(second)->isPlaying);
+    }
+
+    clipManager.setClipLauncher(nullptr);
+    clipManager.clearAllClips();
+}
+
+TEST_CASE("ClipManager chains scenes", "[session]") {
+    auto& clipManager = ClipManager::getInstance();
+    clipManager.clearAllClips();
+    const auto a0 = clipManager.createMidiClip(1, 0.0, 1.0);
+    const auto b0 = clipManager.createMidiClip(2, 0.0, 1.0);
+    const auto a1 = clipManager.createMidiClip(1, 2.0, 1.0);
+    const auto b1 = clipManager.createMidiClip(2, 2.0, 1.0);
+    clipManager.setClipSceneIndex(a0, 0);
+    clipManager.setClipSceneIndex(b0, 0);
+    clipManager.setClipSceneIndex(a1, 1);
+    clipManager.setClipSceneIndex(b1, 1);
+    clipManager.setSceneFollowAction(0, FollowAction::Next, 16.0);
+    clipManager.setSceneFollowAction(1, FollowAction::Stop, 8.0);
+
+    RecordingLauncher launcher;
+    clipManager.setClipLauncher(&launcher);
+
+    clipManager.launchScene(0, {1, 2});
+    REQUIRE(launcher.batches.size() == 2);
+    const auto& step = launcher.batches[1];
+    REQUIRE(step.size() == 2);
+    REQUIRE(step[0].clipId == a1);
+    REQUIRE(step[1].clipId == b1);
+    REQUIRE(step[0].afterClipId == a0);
+    REQUIRE(step[1].afterClipId == a0);
+
+    clipManager.clipLaunchFired(a0);
+    clipManager.clipLaunchFired(b0);
+    clipManager.clipLaunchFired(a1);
+    clipManager.clipLaunchFired(b1);
+    REQUIRE(clipManager.getClip(a1)->isPlaying);
+    REQUIRE(clipManager.getClip(b1)->isPlaying);
+
+    // Scene 1 stops after its eight beats, timed from its first clip
+    REQUIRE(launcher.batches.size() == 3);
+    const auto& stop = launcher.batches[2];
+    REQUIRE(stop.size() == 2);
+    REQUIRE(stop[0].action == ClipLaunchRequest::Action::Stop);
+    REQUIRE(stop[0].afterClipId == a1);
+    REQUIRE(stop[0].afterBeats == 8.0);
+
+    clipManager.clipStopFired(a1);
+    clipManager.clipStopFired(b1);
+    REQUIRE_FALSE(clipManager.getClip(a1)->isPlaying);
+    REQUIRE(launcher.batches.size() == 3);
+
+    clipManager.setClipLauncher(nullptr);
+    clipManager.clearAllClips();
+}
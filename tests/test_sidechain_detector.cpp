@@ -0,0 +1,93 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <vector>
+
+#include "../magda/daw/audio/SidechainDetector.hpp"
+
+using namespace magda;
+using Catch::Approx;
+
+namespace {
+
+constexpr double kSampleRate = 48000.0;
+constexpr int kBlock = 480;  // 10 ms
+
+SidechainDetector::Reading feed(SidechainDetector& detector, float level) {
+    std::vector<float> block(kBlock, level);
+    const float* channels[] = {block.data()};
+    return detector.process(channels, 1, kBlock, kSampleRate);
+}
+
+}  // namespace
+
+// ============================================================================
+// SidechainDetector Tests
+// ============================================================================
+
+TEST_CASE("SidechainDetector - Peak and RMS across channels", "[sidechain]") {
+    SidechainDetector detector;
+    std::vector<float> left{0.5f, -0.5f, 0.5f, -0.5f};
+    std::vector<float> right{0.0f, 0.0f, -1.0f, 0.0f};
+    const float* channels[] = {left.data(), right.data(), nullptr};
+
+    const auto reading = detector.process(channels, 3, 4, kSampleRate);
+
+    REQUIRE(reading.peak == Approx(1.0f));
+    REQUIRE(reading.rms == Approx(std::sqrt((4 * 0.25f + 1.0f) / 8.0f)));
+    REQUIRE_FALSE(reading.onset);
+}
+
+TEST_CASE("SidechainDetector - Onsets are jumps over the recent average", "[sidechain]") {
+    SidechainDetector detector;
+
+    // A signal that was already playing isn't an onset
+    REQUIRE_FALSE(feed(detector, 0.5f).onset);
+    REQUIRE_FALSE(feed(detector, 0.5f).onset);
+
+    // Quiet, then a hit well above it
+    for (int i = 0; i < 100; ++i) {
+        REQUIRE_FALSE(feed(detector, 0.05f).onset);
+    }
+    REQUIRE(feed(detector, 0.5f).onset);
+
+    // A sustained sound counts once
+    for (int i = 0; i < 10; ++i) {
+        REQUIRE_FALSE(feed(detector, 0.5f).onset);
+    }
+
+    // Silence and near-silence never trigger
+    for (int i = 0; i < 100; ++i) {
+        REQUIRE_FALSE(feed(detector, 0.0f).onset);
+    }
+    REQUIRE_FALSE(feed(detector, 0.005f).onset);
+    REQUIRE(feed(detector, 0.5f).onset);
+    feed(detector, 0.0f);
+    REQUIRE_FALSE(feed(detector, 0.5f).onset);
+}
+
+TEST_CASE("SidechainBus - Readings and onset counts", "[sidechain]") {
+    SidechainBus bus;
+    REQUIRE_FALSE(bus.isListening(3));
+    bus.setListening(3, true);
+    REQUIRE(bus.isListening(3));
+
+    uint32_t seen = 0;
+    bus.publish(3, {0.8f, 0.4f, true});
+    bus.publish(3, {0.6f, 0.3f, false});
+
+    auto reading = bus.read(3, seen);
+    REQUIRE(reading.peak == Approx(0.6f));
+    REQUIRE(reading.rms == Approx(0.3f));
+    REQUIRE(reading.onset);  // Published between reads, so still seen once
+    REQUIRE_FALSE(bus.read(3, seen).onset);
+
+    bus.setListening(3, false);
+    REQUIRE(bus.read(3, seen).peak == 0.0f);
+
+    // Out of range tracks are ignored
+    bus.setListening(SidechainBus::kMaxTracks, true);
+    REQUIRE_FALSE(bus.isListening(SidechainBus::kMaxTracks));
+    REQUIRE(bus.read(-1, seen).peak == 0.0f);
+}
@@ -0,0 +1,190 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "../magda/daw/audio/SimpleSynthPlugin.hpp"
+
+using namespace magda::daw::audio;
+
+namespace {
+
+std::vector<int> playingNotes(SimpleSynthesiser& synth) {
+    std::vector<int> notes;
+    for (int i = 0; i < synth.getNumVoices(); ++i) {
+        const int note = synth.getVoice(i)->getCurrentlyPlayingNote();
+        if (note >= 0)
+            notes.push_back(note);
+    }
+    std::sort(notes.begin(), notes.end());
+    return notes;
+}
+
+int risingZeroCrossings(const juce::AudioBuffer<float>& buffer, int begin, int end) {
+    const float* data = buffer.getReadPointer(0);
+    int count = 0;
+    for (int i = begin + 1; i < end; ++i) {
+        if (data[i - 1] <= 0.0f && data[i] > 0.0f)
+            ++count;
+    }
+    return count;
+}
+
+float peak(const juce::AudioBuffer<float>& buffer, int begin, int end) {
+    return buffer.findMinMax(0, begin, end - begin).getEnd();
+}
+
+// One note on channel 2 with a message on messageChannel at atSample, rendered in one go
+juce::AudioBuffer<float> renderWithExpression(const juce::MidiMessage& message, int atSample,
+                                              int numSamples) {
+    SimpleSynthesiser synth;
+    synth.setCurrentPlaybackSampleRate(48000.0);
+
+    juce::MidiBuffer midi;
+    midi.addEvent(juce::MidiMessage::noteOn(2, 69, 1.0f), 0);
+    midi.addEvent(message, atSample);
+
+    juce::AudioBuffer<float> buffer(1, numSamples);
+    buffer.clear();
+    synth.renderNextBlock(buffer, midi, 0, numSamples);
+    return buffer;
+}
+
+}  // namespace
+
+// =============================================================================
+// Oscillator kernels
+// =============================================================================
+
+TEST_CASE("SimpleSynthVoice::renderSine matches std::sin over a block", "[simplesynth]") {
+    const double start = 1.234;
+    const double delta = juce::MathConstants<double>::twoPi * 440.0 / 48000.0;
+    std::vector<float> block(SimpleSynthVoice::kBlockSize - 1);  // Not a multiple of 4
+
+    SimpleSynthVoice::renderSine(block.data(), static_cast<int>(block.size()), start, delta);
+
+    for (size_t i = 0; i < block.size(); ++i) {
+        REQUIRE(block[i] == Catch::Approx(std::sin(start + delta * double(i))).margin(1e-5));
+    }
+}
+
+TEST_CASE("SimpleSynthVoice::renderNoise stays in range and advances", "[simplesynth]") {
+    std::array<juce::uint32, 4> state{1u, 2u, 3u, 4u};
+    std::vector<float> block(1000);
+
+    SimpleSynthVoice::renderNoise(block.data(), static_cast<int>(block.size()), state);
+
+    double sum = 0.0;
+    for (float sample : block) {
+        REQUIRE(sample >= -1.0f);
+        REQUIRE(sample < 1.0f);
+        sum += sample;
+    }
+    REQUIRE(std::abs(sum / double(block.size())) < 0.1);
+
+    std::vector<float> next(4);
+    SimpleSynthVoice::renderNoise(next.data(), 4, state);
+    REQUIRE(next[0] != block[0]);
+}
+
+// =============================================================================
+// Polyphony and voice stealing
+// =============================================================================
+
+TEST_CASE("SimpleSynthesiser limits new notes to the polyphony", "[simplesynth]") {
+    SimpleSynthesiser synth;
+    synth.setCurrentPlaybackSampleRate(48000.0);
+    REQUIRE(synth.getNumVoices() == SimpleSynthesiser::kMaxVoices);
+
+    synth.setPolyphony(2);
+    synth.noteOn(1, 60, 1.0f);
+    synth.noteOn(1, 64, 1.0f);
+    synth.noteOn(1, 67, 1.0f);
+    REQUIRE(playingNotes(synth).size() == 2);
+
+    synth.setPolyphony(0);
+    REQUIRE(synth.getPolyphony() == 1);
+    synth.setPolyphony(1000);
+    REQUIRE(synth.getPolyphony() == SimpleSynthesiser::kMaxVoices);
+}
+
+TEST_CASE("SimpleSynthesiser steals released voices first", "[simplesynth]") {
+    SimpleSynthesiser synth;
+    synth.setCurrentPlaybackSampleRate(48000.0);
+    synth.setPolyphony(3);
+
+    synth.noteOn(1, 60, 1.0f);
+    synth.noteOn(1, 64, 1.0f);
+    synth.noteOn(1, 67, 1.0f);
+    synth.noteOff(1, 64, 0.0f, true);  // Still sounding its release
+    synth.noteOn(1, 72, 1.0f);
+
+    REQUIRE(playingNotes(synth) == std::vector<int>{60, 67, 72});
+}
+
+TEST_CASE("SimpleSynthesiser keeps the lowest and highest held notes", "[simplesynth]") {
+    SimpleSynthesiser synth;
+    synth.setCurrentPlaybackSampleRate(48000.0);
+    synth.setPolyphony(3);
+
+    synth.noteOn(1, 48, 1.0f);  // Oldest, but the bass
+    synth.noteOn(1, 64, 1.0f);
+    synth.noteOn(1, 79, 1.0f);
+    synth.noteOn(1, 67, 1.0f);
+
+    REQUIRE(playingNotes(synth) == std::vector<int>{48, 67, 79});
+}
+
+TEST_CASE("SimpleSynthesiser reports when it can sleep", "[simplesynth]") {
+    SimpleSynthesiser synth;
+    synth.setCurrentPlaybackSampleRate(48000.0);
+    REQUIRE_FALSE(synth.hasActiveVoices());
+
+    synth.noteOn(1, 60, 1.0f);
+    REQUIRE(synth.hasActiveVoices());
+
+    juce::AudioBuffer<float> buffer(2, 512);
+    buffer.clear();
+    synth.noteOff(1, 60, 0.0f, true);
+    for (int block = 0; block < 100 && synth.hasActiveVoices(); ++block) {
+        juce::MidiBuffer midi;
+        synth.renderNextBlock(buffer, midi, 0, buffer.getNumSamples());
+    }
+    REQUIRE_FALSE(synth.hasActiveVoices());
+}
+
+// =============================================================================
+// Per-note expression
+// =============================================================================
+
+TEST_CASE("SimpleSynthesiser bends the notes on the bent channel from that sample",
+          "[simplesynth][mpe]") {
+    // A quarter of the member channels' range up: one octave, 440 Hz to 880 Hz
+    const int octaveUp = 8192 + 2048;
+
+    // 0.1 s either side of the bend: 44 cycles of A4, then 88
+    auto bent = renderWithExpression(juce::MidiMessage::pitchWheel(2, octaveUp), 4800, 9600);
+    const int before = risingZeroCrossings(bent, 0, 4800);
+    const int after = risingZeroCrossings(bent, 4800, 9600);
+    REQUIRE(std::abs(before - 44) <= 1);
+    REQUIRE(std::abs(after - 88) <= 1);
+
+    // Another channel's bend leaves the note alone
+    auto other = renderWithExpression(juce::MidiMessage::pitchWheel(3, octaveUp), 4800, 9600);
+    REQUIRE(std::abs(risingZeroCrossings(other, 4800, 9600) - 44) <= 1);
+}
+
+TEST_CASE("SimpleSynthesiser swells the notes on the pressed channel", "[simplesynth][mpe]") {
+    // Well into the sustain before the pressure, ramped in by the end of the next block
+    auto pressed = renderWithExpression(juce::MidiMessage::channelPressureChange(2, 127), 9600,
+                                        12000);
+    const float before = peak(pressed, 8400, 9600);
+    REQUIRE(before > 0.0f);
+    REQUIRE(peak(pressed, 9800, 12000) == Catch::Approx(before * 2.0f).epsilon(0.02));
+
+    auto other = renderWithExpression(juce::MidiMessage::channelPressureChange(3, 127), 9600,
+                                      12000);
+    REQUIRE(peak(other, 9800, 12000) == Catch::Approx(peak(other, 8400, 9600)).epsilon(0.02));
+}
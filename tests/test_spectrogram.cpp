@@ -0,0 +1,140 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "../magda/daw/audio/Spectrogram.hpp"
+
+using namespace magda;
+
+// ============================================================================
+// Spectrogram Tests
+// ============================================================================
+
+namespace {
+
+constexpr double kSampleRate = 48000.0;
+
+// A full-scale sine analysed in uneven blocks
+Spectrogram analyseSine(double frequency, int numSamples, int blockSize = 1000) {
+    std::vector<float> sine(static_cast<size_t>(numSamples));
+    for (int i = 0; i < numSamples; ++i) {
+        sine[static_cast<size_t>(i)] =
+            static_cast<float>(std::sin(2.0 * 3.14159265358979 * frequency * i / kSampleRate));
+    }
+
+    Spectrogram spectrogram;
+    spectrogram.setFormat(kSampleRate, numSamples);
+
+    SpectralAnalyser analyser;
+    analyser.begin(1, kSampleRate);
+    for (int pos = 0; pos < numSamples; pos += blockSize) {
+        const float* channels[] = {sine.data() + pos};
+        analyser.addSamples(channels, std::min(blockSize, numSamples - pos));
+        for (auto& tile : analyser.takeTiles()) {
+            spectrogram.addTile(std::move(tile));
+        }
+    }
+    analyser.finish();
+    for (auto& tile : analyser.takeTiles()) {
+        spectrogram.addTile(std::move(tile));
+    }
+    return spectrogram;
+}
+
+int bandOf(double frequency) {
+    int band = 0;
+    while (band + 1 < Spectrogram::NUM_BANDS &&
+           Spectrogram::getBandFrequency(band + 1, kSampleRate) <= frequency) {
+        ++band;
+    }
+    return band;
+}
+
+}  // namespace
+
+TEST_CASE("Spectrogram - A sine is loudest in its band", "[spectrogram]") {
+    const auto spectrogram = analyseSine(1000.0, 48000);
+
+    REQUIRE(spectrogram.isComplete());
+    REQUIRE(spectrogram.getNumFrames() == (48000 + Spectrogram::HOP_SIZE - 1) /
+                                              Spectrogram::HOP_SIZE);
+
+    const int band = bandOf(1000.0);
+    const auto frame = spectrogram.getNumFrames() / 2;
+    const auto peak = spectrogram.getValue(0, frame, band);
+    REQUIRE(peak >= 250);  // About 0 dB
+    REQUIRE(spectrogram.getValue(0, frame, bandOf(100.0)) < peak / 2);
+    REQUIRE(spectrogram.getValue(0, frame, bandOf(10000.0)) < peak / 2);
+}
+
+TEST_CASE("Spectrogram - Tiles stream in order and carry coarser levels", "[spectrogram]") {
+    // Three and a bit tiles
+    const int numSamples = Spectrogram::HOP_SIZE * (Spectrogram::TILE_FRAMES * 3 + 10);
+    const auto spectrogram = analyseSine(440.0, numSamples, 4096);
+
+    REQUIRE(spectrogram.getNumTiles() == 4);
+    REQUIRE(spectrogram.getNumReadyTiles() == 4);
+    REQUIRE(spectrogram.getTile(3)->numFrames == 10);
+
+    // The coarsest level holds one frame per tile, the loudest of the tile's
+    const int top = Spectrogram::NUM_TILE_LEVELS - 1;
+    const auto* tile = spectrogram.getTile(1);
+    REQUIRE(tile->getNumFrames(top) == 1);
+    const int band = bandOf(440.0);
+    uint8_t loudest = 0;
+    for (int frame = 0; frame < tile->numFrames; ++frame) {
+        loudest = std::max(loudest, tile->getValue(0, frame, band));
+    }
+    REQUIRE(spectrogram.getValue(top, 1, band) == loudest);
+
+    REQUIRE(Spectrogram::chooseLevel(0.5) == 0);
+    REQUIRE(Spectrogram::chooseLevel(5.0) == 2);
+    REQUIRE(Spectrogram::chooseLevel(1.0e6) == top);
+}
+
+TEST_CASE("Spectrogram - Missing tiles read as silence until they arrive", "[spectrogram]") {
+    Spectrogram spectrogram;
+    spectrogram.setFormat(kSampleRate, Spectrogram::HOP_SIZE * Spectrogram::TILE_FRAMES * 2);
+    REQUIRE(spectrogram.getNumTiles() == 2);
+
+    auto tile = std::make_shared<Spectrogram::Tile>();
+    tile->index = 1;
+    tile->numFrames = Spectrogram::TILE_FRAMES;
+    tile->levels.resize(Spectrogram::NUM_TILE_LEVELS);
+    tile->levels[0].assign(static_cast<size_t>(Spectrogram::TILE_FRAMES) * Spectrogram::NUM_BANDS,
+                           200);
+    tile->buildLevels();
+    spectrogram.addTile(tile);
+
+    REQUIRE_FALSE(spectrogram.isComplete());
+    REQUIRE(spectrogram.getValue(0, 0, 10) == 0);
+    REQUIRE(spectrogram.getValue(0, Spectrogram::TILE_FRAMES, 10) == 200);
+
+    // Incomplete spectrograms aren't written
+    std::vector<char> data;
+    spectrogram.serialise(data);
+    REQUIRE(data.empty());
+}
+
+TEST_CASE("Spectrogram - Serialises round trip", "[spectrogram]") {
+    const auto spectrogram = analyseSine(2000.0, 30000);
+
+    std::vector<char> data;
+    spectrogram.serialise(data);
+    REQUIRE_FALSE(data.empty());
+
+    Spectrogram loaded;
+    REQUIRE(loaded.deserialise(data.data(), data.size()));
+    REQUIRE(loaded.isComplete());
+    REQUIRE(loaded.getLengthInSamples() == 30000);
+    REQUIRE(loaded.getMemoryUsage() == spectrogram.getMemoryUsage());
+    const int band = bandOf(2000.0);
+    REQUIRE(loaded.getValue(0, 5, band) == spectrogram.getValue(0, 5, band));
+
+    // Truncated or foreign data is rejected
+    REQUIRE_FALSE(loaded.deserialise(data.data(), data.size() - 1));
+    data[0] = 'X';
+    REQUIRE_FALSE(loaded.deserialise(data.data(), data.size()));
+}
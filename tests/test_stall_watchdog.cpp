@@ -0,0 +1,90 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "../magda/daw/profiling/StallWatchdog.hpp"
+
+using namespace magda;
+
+// ============================================================================
+// StallDetector Tests
+// ============================================================================
+
+TEST_CASE("StallDetector - Steady heartbeats never stall", "[stall]") {
+    StallDetector detector(500.0, 50.0);
+    REQUIRE(detector.poll(0.0) == StallDetector::Event::None);  // No beat yet
+
+    for (double t = 0.0; t <= 2000.0; t += 50.0) {
+        detector.beat(t);
+        REQUIRE(detector.poll(t + 25.0) == StallDetector::Event::None);
+    }
+    REQUIRE_FALSE(detector.isStalled());
+}
+
+TEST_CASE("StallDetector - A missed threshold starts a stall that the next beat ends",
+          "[stall]") {
+    StallDetector detector(500.0, 50.0);
+    detector.beat(0.0);
+
+    REQUIRE(detector.poll(500.0) == StallDetector::Event::None);  // Within threshold + interval
+    REQUIRE(detector.poll(550.0) == StallDetector::Event::Started);
+    REQUIRE(detector.isStalled());
+    REQUIRE(detector.poll(900.0) == StallDetector::Event::None);  // Reported once
+
+    detector.beat(1250.0);
+    REQUIRE(detector.poll(1260.0) == StallDetector::Event::Ended);
+    REQUIRE_FALSE(detector.isStalled());
+    REQUIRE(detector.getLastStallMs() == 1200.0);  // The gap less the heartbeat interval
+
+    detector.beat(1300.0);
+    REQUIRE(detector.poll(1310.0) == StallDetector::Event::None);
+}
+
+TEST_CASE("StallDetector - Short hiccups are not stalls", "[stall]") {
+    StallDetector detector(500.0, 50.0);
+    detector.beat(0.0);
+    REQUIRE(detector.poll(400.0) == StallDetector::Event::None);
+    detector.beat(450.0);
+    REQUIRE(detector.poll(500.0) == StallDetector::Event::None);
+    REQUIRE(detector.poll(1000.0) == StallDetector::Event::Started);
+}
+
+// ============================================================================
+// ActiveScopes Tests
+// ============================================================================
+
+TEST_CASE("ActiveScopes - Counter timers push and pop the thread's scopes", "[stall]") {
+    auto& counters = ProfilingCounters::getInstance();
+    const auto outer = counters.registerCounter("StallTest.Outer");
+    const auto inner = counters.registerCounter("StallTest.Inner");
+    auto& scopes = ActiveScopes::forCurrentThread();
+    const auto before = scopes.snapshot();
+
+    {
+        ScopedCounterTimer outerTimer(outer);
+        {
+            ScopedCounterTimer innerTimer(inner);
+            auto open = scopes.snapshot();
+            REQUIRE(open.size() == before.size() + 2);
+            REQUIRE(open[open.size() - 2] == outer);
+            REQUIRE(open.back() == inner);
+        }
+        REQUIRE(scopes.snapshot().back() == outer);
+    }
+    REQUIRE(scopes.snapshot() == before);
+}
+
+TEST_CASE("ActiveScopes - Nesting past the maximum depth keeps the outermost", "[stall]") {
+    ActiveScopes scopes;
+    for (int i = 0; i < ActiveScopes::kMaxDepth + 4; ++i) {
+        scopes.push(i);
+    }
+    auto open = scopes.snapshot();
+    REQUIRE(open.size() == static_cast<size_t>(ActiveScopes::kMaxDepth));
+    REQUIRE(open.front() == 0);
+
+    for (int i = 0; i < 4; ++i) {
+        scopes.pop();
+    }
+    REQUIRE(scopes.snapshot().size() == static_cast<size_t>(ActiveScopes::kMaxDepth));
+    scopes.pop();
+    REQUIRE(scopes.snapshot().size() == static_cast<size_t>(ActiveScopes::kMaxDepth - 1));
+}
@@ -0,0 +1,108 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstring>
+
+#include "../magda/daw/core/StartupCache.hpp"
+#include "ScopedDirectory.hpp"
+
+using namespace magda;
+
+namespace {
+
+bool holds(const StartupCache::Section& section, const char* text) {
+    return section.isValid() && section.size == std::strlen(text) &&
+           std::memcmp(section.data, text, section.size) == 0;
+}
+
+}  // namespace
+
+TEST_CASE("StartupCache keeps sections across opens", "[startupcache]") {
+    ScopedDirectory temp("magda_startup_cache_test");
+    const auto cacheFile = temp.directory.getChildFile("cache.bin");
+    const auto settings = temp.directory.getChildFile("settings.txt");
+    const auto plugins = temp.directory.getChildFile("plugins.xml");
+    settings.replaceWithText("a=1");
+    plugins.replaceWithText("<PLUGINS/>");
+
+    {
+        StartupCache cache(cacheFile);
+        REQUIRE(cache.getNumSections() == 0);
+        REQUIRE_FALSE(cache.find("Config", settings).isValid());
+
+        REQUIRE(cache.store("Config", settings, "decoded settings", 16));
+        REQUIRE(cache.store("PluginList", plugins, "decoded plugins", 15));
+        REQUIRE(holds(cache.find("Config", settings), "decoded settings"));
+    }
+
+    StartupCache reopened(cacheFile);
+    REQUIRE(reopened.getNumSections() == 2);
+    REQUIRE(holds(reopened.find("Config", settings), "decoded settings"));
+    REQUIRE(holds(reopened.find("PluginList", plugins), "decoded plugins"));
+
+    // A section is only good for the file it was stored for
+    REQUIRE_FALSE(reopened.find("Config", plugins).isValid());
+    REQUIRE_FALSE(reopened.find("Missing", settings).isValid());
+}
+
+TEST_CASE("StartupCache drops a section once its source changes", "[startupcache]") {
+    ScopedDirectory temp("magda_startup_cache_test");
+    const auto settings = temp.directory.getChildFile("settings.txt");
+    const auto plugins = temp.directory.getChildFile("plugins.xml");
+    settings.replaceWithText("a=1");
+    plugins.replaceWithText("<PLUGINS/>");
+
+    StartupCache cache(temp.directory.getChildFile("cache.bin"));
+    cache.store("Config", settings, "old", 3);
+    cache.store("PluginList", plugins, "plugins", 7);
+
+    settings.replaceWithText("a=1\nb=2");
+    REQUIRE_FALSE(cache.find("Config", settings).isValid());
+    REQUIRE(cache.find("PluginList", plugins).isValid());
+
+    // Storing again replaces it and keeps the others that are still current
+    cache.store("Config", settings, "new", 3);
+    REQUIRE(holds(cache.find("Config", settings), "new"));
+    REQUIRE(holds(cache.find("PluginList", plugins), "plugins"));
+
+    plugins.deleteFile();
+    REQUIRE_FALSE(cache.find("PluginList", plugins).isValid());
+    REQUIRE_FALSE(cache.store("PluginList", plugins, "plugins", 7));
+}
+
+TEST_CASE("StartupCache treats a damaged file as empty", "[startupcache]") {
+    ScopedDirectory temp("magda_startup_cache_test");
+    const auto cacheFile = temp.directory.getChildFile("cache.bin");
+    const auto settings = temp.directory.getChildFile("settings.txt");
+    settings.replaceWithText("a=1");
+
+    SECTION("Not a cache") {
+        cacheFile.replaceWithText("definitely not a startup cache");
+        StartupCache cache(cacheFile);
+        REQUIRE(cache.getNumSections() == 0);
+    }
+
+    SECTION("Truncated") {
+        {
+            StartupCache cache(cacheFile);
+            cache.store("Config", settings, "decoded settings", 16);
+        }
+        juce::MemoryBlock bytes;
+        cacheFile.loadFileAsData(bytes);
+        cacheFile.replaceWithData(bytes.getData(), bytes.getSize() - 4);
+
+        StartupCache cache(cacheFile);
+        REQUIRE_FALSE(cache.find("Config", settings).isValid());
+
+        // And is rewritten whole by the next store
+        REQUIRE(cache.store("Config", settings, "again", 5));
+        REQUIRE(holds(StartupCache(cacheFile).find("Config", settings), "again"));
+    }
+
+    SECTION("Cleared") {
+        StartupCache cache(cacheFile);
+        cache.store("Config", settings, "decoded settings", 16);
+        cache.clear();
+        REQUIRE_FALSE(cacheFile.exists());
+        REQUIRE_FALSE(cache.find("Config", settings).isValid());
+    }
+}
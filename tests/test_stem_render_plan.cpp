@@ -0,0 +1,83 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <vector>
+
+#include "../magda/daw/engine/StemRenderPlan.hpp"
+
+using namespace magda;
+
+namespace {
+
+StemRenderPlan::Track makeTrack(TrackId id, TrackId root, double weight,
+                                juce::StringArray files = {}) {
+    StemRenderPlan::Track track;
+    track.id = id;
+    track.root = root;
+    track.name = "Track " + juce::String(id);
+    track.weight = weight;
+    track.audioFiles = std::move(files);
+    return track;
+}
+
+}  // namespace
+
+// ============================================================================
+// StemRenderPlan Tests
+// ============================================================================
+
+TEST_CASE("StemRenderPlan - Nothing to render", "[stem_render]") {
+    REQUIRE(StemRenderPlan::partition({}, 4).empty());
+}
+
+TEST_CASE("StemRenderPlan - Balances tracks across partitions", "[stem_render]") {
+    std::vector<StemRenderPlan::Track> tracks{makeTrack(1, 1, 5.0), makeTrack(2, 2, 3.0),
+                                              makeTrack(3, 3, 2.0), makeTrack(4, 4, 2.0),
+                                              makeTrack(5, 5, 1.0)};
+
+    const auto partitions = StemRenderPlan::partition(tracks, 2);
+
+    REQUIRE(partitions.size() == 2);
+    REQUIRE(partitions[0].weight == 7.0);
+    REQUIRE(partitions[1].weight == 6.0);
+    // Largest first to the lightest: {5, 2} and {3, 2, 1}, each back in project order
+    REQUIRE(partitions[0].trackIds == std::vector<TrackId>{1, 4});
+    REQUIRE(partitions[0].stemNumbers == std::vector<int>{1, 4});
+    REQUIRE(partitions[1].trackIds == std::vector<TrackId>{2, 3, 5});
+    REQUIRE(partitions[1].stemNumbers == std::vector<int>{2, 3, 5});
+    REQUIRE(partitions[1].trackNames[0] == "Track 2");
+}
+
+TEST_CASE("StemRenderPlan - Keeps group subtrees together", "[stem_render]") {
+    // Group 10 with children 11 and 12, then two loose tracks
+    std::vector<StemRenderPlan::Track> tracks{makeTrack(10, 10, 1.0), makeTrack(11, 10, 1.0),
+                                              makeTrack(12, 10, 1.0), makeTrack(20, 20, 1.0),
+                                              makeTrack(30, 30, 1.0)};
+
+    const auto partitions = StemRenderPlan::partition(tracks, 3);
+
+    REQUIRE(partitions.size() == 3);
+    REQUIRE(partitions[0].trackIds == std::vector<TrackId>{10, 11, 12});
+    REQUIRE(partitions[1].trackIds == std::vector<TrackId>{20});
+    REQUIRE(partitions[2].trackIds == std::vector<TrackId>{30});
+    REQUIRE(partitions[2].stemNumbers == std::vector<int>{5});
+}
+
+TEST_CASE("StemRenderPlan - No more partitions than units", "[stem_render]") {
+    std::vector<StemRenderPlan::Track> tracks{makeTrack(1, INVALID_TRACK_ID, 1.0),
+                                              makeTrack(2, 1, 1.0)};
+
+    REQUIRE(StemRenderPlan::partition(tracks, 8).size() == 1);
+    REQUIRE(StemRenderPlan::partition(tracks, 0).size() == 1);
+}
+
+TEST_CASE("StemRenderPlan - Collects each partition's audio files once", "[stem_render]") {
+    std::vector<StemRenderPlan::Track> tracks{makeTrack(1, 1, 1.0, {"/a.wav", "/b.wav"}),
+                                              makeTrack(2, 1, 1.0, {"/b.wav", "/c.wav"}),
+                                              makeTrack(3, 3, 1.0, {"/d.wav"})};
+
+    const auto partitions = StemRenderPlan::partition(tracks, 2);
+
+    REQUIRE(partitions.size() == 2);
+    REQUIRE(partitions[0].audioFiles == juce::StringArray{"/a.wav", "/b.wav", "/c.wav"});
+    REQUIRE(partitions[1].audioFiles == juce::StringArray{"/d.wav"});
+}
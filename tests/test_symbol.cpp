@@ -0,0 +1,95 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "../magda/daw/core/Symbol.hpp"
+#include "../magda/daw/profiling/PerformanceProfiler.hpp"
+
+using namespace magda;
+
+TEST_CASE("Symbol interns equal text to one id", "[symbol]") {
+    const Symbol a("/audio/project/kick.wav");
+    const Symbol b(juce::String("/audio/project/") + "kick.wav");
+    const Symbol c("/audio/project/snare.wav");
+
+    REQUIRE(a == b);
+    REQUIRE(a != c);
+    REQUIRE(a.getString() == "/audio/project/kick.wav");
+
+    // One stored copy: both hand out the same text
+    REQUIRE(a.getString().getCharPointer() == b.getString().getCharPointer());
+}
+
+TEST_CASE("Symbol of the empty string is the default", "[symbol]") {
+    REQUIRE(Symbol().isEmpty());
+    REQUIRE(Symbol("") == Symbol());
+    REQUIRE(Symbol().getString().isEmpty());
+    REQUIRE_FALSE(Symbol("x").isEmpty());
+}
+
+TEST_CASE("Symbol::find never interns", "[symbol]") {
+    const int before = Symbol::getNumSymbols();
+    REQUIRE_FALSE(Symbol::find("symbol test: never interned").has_value());
+    REQUIRE(Symbol::getNumSymbols() == before);
+
+    const Symbol added("symbol test: interned");
+    REQUIRE(Symbol::find("symbol test: interned") == added);
+    REQUIRE(Symbol::find("")->isEmpty());
+}
+
+TEST_CASE("Symbol keys unordered maps", "[symbol]") {
+    std::unordered_map<Symbol, int> counts;
+    ++counts[Symbol("UIPaint.MainView")];
+    ++counts[Symbol("UIPaint.MainView")];
+    ++counts[Symbol("UIPaint.Mixer")];
+
+    REQUIRE(counts.size() == 2);
+    REQUIRE(counts[Symbol("UIPaint.MainView")] == 2);
+}
+
+TEST_CASE("Symbol interns consistently across threads", "[symbol]") {
+    constexpr int kThreads = 4;
+    constexpr int kNames = 500;
+    std::vector<std::vector<Symbol>> seen(kThreads);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([t, &seen] {
+            for (int i = 0; i < kNames; ++i) {
+                seen[static_cast<size_t>(t)].emplace_back("symbol thread " + juce::String(i));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (int i = 0; i < kNames; ++i) {
+        const auto& first = seen[0][static_cast<size_t>(i)];
+        REQUIRE(first.getString() == "symbol thread " + juce::String(i));
+        for (int t = 1; t < kThreads; ++t) {
+            REQUIRE(seen[static_cast<size_t>(t)][static_cast<size_t>(i)] == first);
+        }
+    }
+}
+
+TEST_CASE("PerformanceMonitor records by Symbol and by name alike", "[symbol]") {
+    auto& monitor = PerformanceMonitor::getInstance();
+    monitor.setEnabled(true);
+    monitor.resetAll();
+
+    const Symbol category("SymbolTest.Paint");
+    monitor.addSample(category, 2.0);
+    monitor.addSample("SymbolTest.Paint", 4.0);
+    monitor.setCounter(Symbol("SymbolTest.Dropped"), 3);
+
+    REQUIRE(monitor.getStats("SymbolTest.Paint").count == 2);
+    REQUIRE(monitor.getAllStats().count("SymbolTest.Paint") == 1);
+    REQUIRE(monitor.getCounter("SymbolTest.Dropped") == 3);
+    REQUIRE(monitor.getStats("SymbolTest.Unknown").count == 0);
+
+    monitor.resetAll();
+    monitor.setEnabled(false);
+}
@@ -0,0 +1,125 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "../magda/daw/audio/TempoAnalysis.hpp"
+
+using namespace magda;
+
+// ============================================================================
+// TempoAnalysis Tests
+// ============================================================================
+
+namespace {
+
+constexpr double kSampleRate = 48000.0;
+
+// Decaying noise bursts on every beat, the downbeats louder, over a quiet noise floor
+std::vector<float> makeClicks(double bpm, double seconds) {
+    const auto numSamples = static_cast<size_t>(seconds * kSampleRate);
+    std::vector<float> audio(numSamples);
+    uint32_t noise = 12345;
+    auto nextNoise = [&noise] {
+        noise = noise * 1664525u + 1013904223u;
+        return static_cast<float>(noise >> 8) / static_cast<float>(1u << 24) * 2.0f - 1.0f;
+    };
+    for (auto& sample : audio) {
+        sample = 0.001f * nextNoise();
+    }
+
+    const double samplesPerBeat = 60.0 / bpm * kSampleRate;
+    const auto burstLength = static_cast<size_t>(0.03 * kSampleRate);
+    for (int beat = 0; beat * samplesPerBeat < static_cast<double>(numSamples); ++beat) {
+        const auto start = static_cast<size_t>(std::lround(beat * samplesPerBeat));
+        const float gain = beat % 4 == 0 ? 0.9f : 0.5f;
+        for (size_t i = 0; i < burstLength && start + i < numSamples; ++i) {
+            const float envelope = std::exp(-static_cast<float>(i) / (0.005f * static_cast<float>(kSampleRate)));
+            audio[start + i] += gain * envelope * nextNoise();
+        }
+    }
+    return audio;
+}
+
+TempoAnalysis analyse(const std::vector<float>& audio, int blockSize = 1000) {
+    TempoAnalyser analyser;
+    analyser.begin(1, kSampleRate);
+    const int numSamples = static_cast<int>(audio.size());
+    for (int pos = 0; pos < numSamples; pos += blockSize) {
+        const float* channels[] = {audio.data() + pos};
+        analyser.addSamples(channels, std::min(blockSize, numSamples - pos));
+    }
+    return analyser.finish();
+}
+
+}  // namespace
+
+TEST_CASE("TempoAnalysis - Finds each beat of a click track", "[tempo]") {
+    const auto analysis = analyse(makeClicks(120.0, 8.0));
+
+    REQUIRE(analysis.lengthInSamples == 8 * 48000);
+    REQUIRE(analysis.onsets.size() == 16);
+
+    const double hopSeconds = TempoAnalyser::HOP_SIZE / kSampleRate;
+    for (size_t beat = 0; beat < analysis.onsets.size(); ++beat) {
+        REQUIRE(std::abs(analysis.onsets[beat] - beat * 0.5) <= hopSeconds);
+    }
+
+    // Downbeats are the strongest
+    REQUIRE(analysis.onsetStrengths[0] == Catch::Approx(1.0f).margin(0.15f));
+    REQUIRE(analysis.onsetStrengths[1] < analysis.onsetStrengths[4]);
+
+    REQUIRE(analysis.findOnset(1.2) == 3);
+    REQUIRE(analysis.findOnset(100.0) == analysis.onsets.size());
+}
+
+TEST_CASE("TempoAnalysis - A loop of whole bars gets its exact tempo", "[tempo]") {
+    const auto analysis = analyse(makeClicks(120.0, 8.0));
+
+    REQUIRE(analysis.hasTempo());
+    REQUIRE(analysis.bpm == Catch::Approx(120.0).margin(1.0e-9));
+    REQUIRE(analysis.confidence > 0.3f);
+
+    // Played at 100 BPM the file is stretched longer
+    REQUIRE(analysis.getStretchFactorFor(100.0) == Catch::Approx(1.2));
+}
+
+TEST_CASE("TempoAnalysis - Estimates the tempo of a file that isn't a loop", "[tempo]") {
+    const auto slow = analyse(makeClicks(97.0, 11.3), 4096);
+    REQUIRE(slow.hasTempo());
+    REQUIRE(slow.bpm == Catch::Approx(97.0).margin(1.0));
+
+    const auto fast = analyse(makeClicks(172.0, 9.1));
+    REQUIRE(fast.hasTempo());
+    REQUIRE(fast.bpm == Catch::Approx(172.0).margin(1.0));
+}
+
+TEST_CASE("TempoAnalysis - Silence has no onsets and no tempo", "[tempo]") {
+    const auto analysis = analyse(std::vector<float>(48000 * 4, 0.0f));
+
+    REQUIRE(analysis.onsets.empty());
+    REQUIRE_FALSE(analysis.hasTempo());
+    REQUIRE(analysis.getStretchFactorFor(140.0) == 1.0);
+}
+
+TEST_CASE("TempoAnalysis - Serialises round trip", "[tempo]") {
+    const auto analysis = analyse(makeClicks(120.0, 4.0));
+
+    std::vector<char> data;
+    analysis.serialise(data);
+
+    TempoAnalysis loaded;
+    REQUIRE(loaded.deserialise(data.data(), data.size()));
+    REQUIRE(loaded.bpm == analysis.bpm);
+    REQUIRE(loaded.lengthInSamples == analysis.lengthInSamples);
+    REQUIRE(loaded.onsets == analysis.onsets);
+    REQUIRE(loaded.onsetStrengths == analysis.onsetStrengths);
+
+    // Truncated or foreign data is rejected
+    REQUIRE_FALSE(loaded.deserialise(data.data(), data.size() - 1));
+    data[0] = 'X';
+    REQUIRE_FALSE(loaded.deserialise(data.data(), data.size()));
+}
@@ -0,0 +1,89 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "../magda/daw/core/TempoMap.hpp"
+
+using namespace magda;
+using Catch::Approx;
+
+// ============================================================================
+// TempoMap Tests
+// ============================================================================
+
+TEST_CASE("TempoMap - Constant tempo converts both ways", "[tempomap]") {
+    TempoMap map(120.0);
+
+    REQUIRE(map.beatsToSeconds(4.0) == Approx(2.0));
+    REQUIRE(map.secondsToBeats(3.0) == Approx(6.0));
+    REQUIRE(map.getBpmAtTime(100.0) == Approx(120.0));
+}
+
+TEST_CASE("TempoMap - Piecewise tempo accumulates across changes", "[tempomap]") {
+    TempoMap map;
+    map.setTempoChanges({{8.0, 60.0}, {0.0, 120.0}});  // Unsorted on purpose
+
+    // 8 beats at 120 = 4 s, then 1 s per beat
+    REQUIRE(map.beatsToSeconds(8.0) == Approx(4.0));
+    REQUIRE(map.beatsToSeconds(10.0) == Approx(6.0));
+    REQUIRE(map.secondsToBeats(6.0) == Approx(10.0));
+    REQUIRE(map.secondsToBeats(2.0) == Approx(4.0));
+    REQUIRE(map.getBpmAtBeat(7.9) == Approx(120.0));
+    REQUIRE(map.getBpmAtBeat(8.0) == Approx(60.0));
+
+    for (double beat = 0.0; beat < 20.0; beat += 0.37)
+        REQUIRE(map.secondsToBeats(map.beatsToSeconds(beat)) == Approx(beat));
+}
+
+TEST_CASE("TempoMap - Batch conversion matches point conversion", "[tempomap]") {
+    TempoMap map;
+    map.setTempoChanges({{0.0, 100.0}, {4.0, 140.0}, {9.0, 90.0}});
+
+    std::vector<double> beats;
+    for (double beat = 0.0; beat < 16.0; beat += 0.25)
+        beats.push_back(beat);
+    beats.push_back(2.0);  // Out of order still works
+
+    std::vector<double> seconds(beats.size());
+    map.beatsToSeconds(beats.data(), seconds.data(), beats.size());
+    for (size_t i = 0; i < beats.size(); ++i)
+        REQUIRE(seconds[i] == Approx(map.beatsToSeconds(beats[i])));
+
+    std::vector<MidiNote> notes = {{1, 60, 100, 3.5, 1.0}, {2, 62, 100, 8.5, 1.0}};
+    std::vector<TempoMap::TimeRange> ranges;
+    map.notesToSeconds(notes, 0.0, ranges);
+    REQUIRE(ranges.size() == 2);
+    REQUIRE(ranges[0].start == Approx(map.beatsToSeconds(3.5)));
+    REQUIRE(ranges[0].end == Approx(map.beatsToSeconds(4.5)));
+    REQUIRE(ranges[1].end == Approx(map.beatsToSeconds(9.5)));
+}
+
+TEST_CASE("TempoMap - Version only moves on real changes", "[tempomap]") {
+    TempoMap map(120.0);
+    const auto version = map.getVersion();
+
+    map.setTempo(120.0);
+    map.setTimeSignature(4, 4);
+    REQUIRE(map.getVersion() == version);
+
+    map.setTempo(90.0);
+    REQUIRE(map.getVersion() > version);
+
+    const auto afterTempo = map.getVersion();
+    map.setTimeSignature(3, 4);
+    REQUIRE(map.getVersion() > afterTempo);
+}
+
+TEST_CASE("TempoMap - Bars and beats for display", "[tempomap]") {
+    TempoMap map(120.0, 3, 4);
+
+    auto position = map.toBarBeat(0.0);
+    REQUIRE(position.bar == 1);
+    REQUIRE(position.beat == 1);
+    REQUIRE(position.sixteenth == 1);
+
+    // Beat 7.75 in 3/4: bar 3, beat 2, last sixteenth
+    position = map.toBarBeat(map.beatsToSeconds(7.75));
+    REQUIRE(position.bar == 3);
+    REQUIRE(position.beat == 2);
+    REQUIRE(position.sixteenth == 4);
+}
@@ -0,0 +1,96 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "../magda/daw/ui/state/TimelineController.hpp"
+
+using namespace magda;
+using Flags = TimelineController::ChangeFlags;
+
+namespace {
+
+double nextZoom(const TimelineController& controller) {
+    return controller.getState().zoom.horizontalZoom * 1.5;
+}
+
+}  // namespace
+
+// ============================================================================
+// TimelineController Subscription Tests
+// ============================================================================
+
+TEST_CASE("TimelineController - Subscribers only hear the flags they asked for",
+          "[timeline][subscription]") {
+    TimelineController controller;
+    int zoomCalls = 0;
+    int playheadCalls = 0;
+    auto zoom = controller.subscribe(Flags::Zoom, [&](const TimelineState&) { ++zoomCalls; });
+    auto playhead =
+        controller.subscribe(Flags::Playhead, [&](const TimelineState&) { ++playheadCalls; });
+
+    controller.dispatch(SetPlaybackPositionEvent{1.0});
+    controller.dispatch(SetPlaybackPositionEvent{2.0});
+    REQUIRE(zoomCalls == 0);
+    REQUIRE(playheadCalls == 2);
+
+    controller.dispatch(SetZoomEvent{nextZoom(controller)});
+    REQUIRE(zoomCalls == 1);
+    REQUIRE(playheadCalls == 2);
+}
+
+TEST_CASE("TimelineController - A subscriber is called once per dispatch",
+          "[timeline][subscription]") {
+    TimelineController controller;
+    int calls = 0;
+    auto subscription = controller.subscribe(Flags::Zoom | Flags::Scroll,
+                                             [&](const TimelineState&) { ++calls; });
+
+    // Zoom changes arrive as Zoom | Scroll
+    controller.dispatch(SetZoomEvent{nextZoom(controller)});
+    REQUIRE(calls == 1);
+    REQUIRE(controller.getSubscriberCount(Flags::Zoom) == 1);
+    REQUIRE(controller.getSubscriberCount(Flags::Playhead) == 0);
+}
+
+TEST_CASE("TimelineController - Resetting a subscription stops its calls",
+          "[timeline][subscription]") {
+    TimelineController controller;
+    int calls = 0;
+    auto subscription =
+        controller.subscribe(Flags::Playhead, [&](const TimelineState&) { ++calls; });
+
+    controller.dispatch(SetPlaybackPositionEvent{1.0});
+    subscription.reset();
+    controller.dispatch(SetPlaybackPositionEvent{2.0});
+
+    REQUIRE(calls == 1);
+    REQUIRE(controller.getSubscriberCount(Flags::Playhead) == 0);
+}
+
+TEST_CASE("TimelineController - A callback may unsubscribe itself", "[timeline][subscription]") {
+    TimelineController controller;
+    int calls = 0;
+    int otherCalls = 0;
+    Subscription subscription;
+    subscription = controller.subscribe(Flags::Playhead, [&](const TimelineState&) {
+        ++calls;
+        subscription.reset();
+    });
+    auto other =
+        controller.subscribe(Flags::Playhead, [&](const TimelineState&) { ++otherCalls; });
+
+    controller.dispatch(SetPlaybackPositionEvent{1.0});
+    controller.dispatch(SetPlaybackPositionEvent{2.0});
+
+    REQUIRE(calls == 1);
+    REQUIRE(otherCalls == 2);
+}
+
+TEST_CASE("TimelineController - Subscriptions may outlive the controller",
+          "[timeline][subscription]") {
+    Subscription subscription;
+    {
+        TimelineController controller;
+        subscription = controller.subscribe(Flags::All, [](const TimelineState&) {});
+    }
+    subscription.reset();
+    REQUIRE_FALSE(subscription);
+}
@@ -0,0 +1,111 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <thread>
+
+#include "../magda/daw/profiling/TraceRecorder.hpp"
+
+using namespace magda;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+void recordMicros(ProfilingCounters::Id id, int startMicros, int durationMicros) {
+    const auto start = Clock::now() + std::chrono::microseconds(startMicros);
+    TraceRecorder::getInstance().record(id, start,
+                                        start + std::chrono::microseconds(durationMicros));
+}
+
+}  // namespace
+
+// ============================================================================
+// TraceRecorder Tests
+// ============================================================================
+
+TEST_CASE("TraceRecorder - Records only while recording", "[profiling][trace]") {
+    auto& trace = TraceRecorder::getInstance();
+    const auto id = ProfilingCounters::getInstance().registerCounter("TraceTest.Idle");
+    const auto tid = trace.getCurrentThreadIndex();
+    REQUIRE(tid < TraceRecorder::kMaxThreads);
+
+    trace.start();
+    trace.stop();
+    recordMicros(id, 0, 10);
+    REQUIRE(trace.getEvents(tid).empty());
+
+    trace.start();
+    recordMicros(id, 0, 10);
+    recordMicros(id, 20, 5);
+    trace.stop();
+
+    auto events = trace.getEvents(tid);
+    REQUIRE(events.size() == 2);
+    REQUIRE(events[0].counter == id);
+    REQUIRE(events[0].durationNanos == 10000);
+    REQUIRE(events[1].startNanos - events[0].startNanos >= 20000);
+
+    // Starting again clears the previous trace
+    trace.start();
+    trace.stop();
+    REQUIRE(trace.getEvents(tid).empty());
+}
+
+TEST_CASE("TraceRecorder - Keeps the newest events when a thread's ring wraps",
+          "[profiling][trace]") {
+    auto& trace = TraceRecorder::getInstance();
+    const auto id = ProfilingCounters::getInstance().registerCounter("TraceTest.Wrap");
+    const auto tid = trace.getCurrentThreadIndex();
+
+    trace.start();
+    for (size_t i = 0; i < TraceRecorder::kEventsPerThread + 10; ++i) {
+        recordMicros(id, 0, static_cast<int>(i));
+    }
+    trace.stop();
+
+    auto events = trace.getEvents(tid);
+    REQUIRE(events.size() == TraceRecorder::kEventsPerThread);
+    REQUIRE(events.front().durationNanos == 10 * 1000);
+    REQUIRE(events.back().durationNanos == (TraceRecorder::kEventsPerThread + 9) * 1000);
+}
+
+TEST_CASE("TraceRecorder - Threads get their own slots", "[profiling][trace]") {
+    auto& trace = TraceRecorder::getInstance();
+    const auto id = ProfilingCounters::getInstance().registerCounter("TraceTest.Threads");
+    const auto mainTid = trace.getCurrentThreadIndex();
+
+    trace.start();
+    size_t workerTid = TraceRecorder::kMaxThreads;
+    std::thread worker([&]() {
+        workerTid = trace.getCurrentThreadIndex();
+        recordMicros(id, 0, 7);
+    });
+    worker.join();
+    trace.stop();
+
+    REQUIRE(workerTid != mainTid);
+    REQUIRE(trace.getEvents(mainTid).empty());
+    auto events = trace.getEvents(workerTid);
+    REQUIRE(events.size() == 1);
+    REQUIRE(events[0].durationNanos == 7000);
+}
+
+TEST_CASE("TraceRecorder - Exports Chrome trace JSON", "[profiling][trace]") {
+    auto& trace = TraceRecorder::getInstance();
+    const auto id = ProfilingCounters::getInstance().registerCounter("TraceTest.\"Export\"");
+    trace.setCurrentThreadName("Test Main");
+
+    trace.start();
+    recordMicros(id, 0, 1500);
+    trace.stop();
+
+    const auto json = trace.exportChromeTrace();
+    REQUIRE(json.front() == '{');
+    REQUIRE(json.back() == '}');
+    REQUIRE(json.find(R"("traceEvents":[)") != std::string::npos);
+    REQUIRE(json.find(R"("name":"thread_name")") != std::string::npos);
+    REQUIRE(json.find(R"("args":{"name":"Test Main"})") != std::string::npos);
+    REQUIRE(json.find(R"("ph":"X")") != std::string::npos);
+    REQUIRE(json.find(R"("name":"TraceTest.\"Export\"")") != std::string::npos);
+    REQUIRE(json.find(R"("dur":1500)") != std::string::npos);
+}
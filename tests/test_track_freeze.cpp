@@ -0,0 +1,119 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "../magda/daw/core/ClipManager.hpp"
+#include "../magda/daw/core/TrackManager.hpp"
+#include "../magda/daw/engine/TrackPreRenderer.hpp"
+
+using namespace magda;
+
+namespace {
+
+class FreezeListener : public TrackManagerListener {
+  public:
+    void tracksChanged() override {}
+    void trackPropertyChanged(int trackId) override {
+        changedTracks.push_back(trackId);
+    }
+
+    std::vector<int> changedTracks;
+};
+
+}  // namespace
+
+// ============================================================================
+// Freeze state
+// ============================================================================
+
+TEST_CASE("TrackManager - freezing needs an audio engine", "[freeze]") {
+    auto& tm = TrackManager::getInstance();
+    tm.clearAllTracks();
+    const auto trackId = tm.createTrack("Synth");
+
+    tm.freezeTrack(trackId);
+    REQUIRE(tm.getTrack(trackId)->freezeState == FreezeState::Unfrozen);
+
+    tm.clearAllTracks();
+}
+
+TEST_CASE("TrackManager - freeze state changes notify listeners", "[freeze]") {
+    auto& tm = TrackManager::getInstance();
+    tm.clearAllTracks();
+    const auto trackId = tm.createTrack("Synth");
+
+    FreezeListener listener;
+    tm.addListener(&listener);
+
+    tm.setTrackFreezeState(trackId, FreezeState::Frozen);
+    REQUIRE(tm.getTrack(trackId)->isFrozen());
+    REQUIRE(listener.changedTracks == std::vector<int>{trackId});
+
+    SECTION("Setting the same state again is not a change") {
+        tm.setTrackFreezeState(trackId, FreezeState::Frozen);
+        REQUIRE(listener.changedTracks.size() == 1);
+    }
+
+    SECTION("Unfreezing returns the track to live playback") {
+        tm.unfreezeTrack(trackId);
+        REQUIRE(tm.getTrack(trackId)->freezeState == FreezeState::Unfrozen);
+        REQUIRE(listener.changedTracks.size() == 2);
+    }
+
+    tm.removeListener(&listener);
+    tm.clearAllTracks();
+}
+
+// ============================================================================
+// Pre-render eligibility
+// ============================================================================
+
+TEST_CASE("TrackPreRenderer - only tracks that render the same every pass", "[freeze]") {
+    auto& clipManager = ClipManager::getInstance();
+    clipManager.clearAllClips();
+
+    TrackInfo track;
+    track.id = 42;
+    track.type = TrackType::Instrument;
+    DeviceInfo synth;
+    synth.id = 1;
+    synth.name = "Synth";
+    track.chainElements.push_back(makeDeviceElement(synth));
+    const auto clipId = clipManager.createMidiClip(track.id, 0.0, 4.0);
+
+    REQUIRE(TrackPreRenderer::canPreRender(track));
+
+    SECTION("Armed or monitoring tracks render live") {
+        auto armed = track;
+        armed.recordArmed = true;
+        REQUIRE_FALSE(TrackPreRenderer::canPreRender(armed));
+
+        auto monitoring = track;
+        monitoring.midiInputDevice = "all";
+        REQUIRE_FALSE(TrackPreRenderer::canPreRender(monitoring));
+    }
+
+    SECTION("Buses and user freezes are left alone") {
+        auto aux = track;
+        aux.type = TrackType::Aux;
+        REQUIRE_FALSE(TrackPreRenderer::canPreRender(aux));
+
+        auto frozen = track;
+        frozen.freezeState = FreezeState::Freezing;
+        REQUIRE_FALSE(TrackPreRenderer::canPreRender(frozen));
+    }
+
+    SECTION("Nothing to gain without a chain or clips") {
+        auto bare = track;
+        bare.chainElements.clear();
+        REQUIRE_FALSE(TrackPreRenderer::canPreRender(bare));
+
+        clipManager.clearAllClips();
+        REQUIRE_FALSE(TrackPreRenderer::canPreRender(track));
+    }
+
+    SECTION("Session clips are launched live") {
+        clipManager.getClip(clipId)->sceneIndex = 0;
+        REQUIRE_FALSE(TrackPreRenderer::canPreRender(track));
+    }
+
+    clipManager.clearAllClips();
+}
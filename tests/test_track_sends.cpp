@@ -0,0 +1,56 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "../magda/daw/core/TrackManager.hpp"
+
+using namespace magda;
+
+// ============================================================================
+// Sends
+// ============================================================================
+
+TEST_CASE("TrackManager - Sends only go to other aux tracks", "[sends]") {
+    auto& tm = TrackManager::getInstance();
+    tm.clearAllTracks();
+    const auto source = tm.createTrack("Vocal");
+    const auto aux = tm.createTrack("Reverb", TrackType::Aux);
+    const auto audio = tm.createTrack("Guitar");
+
+    REQUIRE(tm.addSend(source, aux) == 0);
+    REQUIRE(tm.addSend(source, aux) == -1);    // Already sending
+    REQUIRE(tm.addSend(source, audio) == -1);  // Not an aux
+    REQUIRE(tm.addSend(aux, aux) == -1);       // Itself
+    REQUIRE(tm.addSend(source, INVALID_TRACK_ID) == -1);
+
+    const auto& send = tm.getTrack(source)->sends.at(0);
+    REQUIRE(send.destinationId == aux);
+    REQUIRE(send.level == 1.0f);
+    REQUIRE_FALSE(send.preFader);
+
+    tm.clearAllTracks();
+}
+
+TEST_CASE("TrackManager - Send level, tap point and removal", "[sends]") {
+    auto& tm = TrackManager::getInstance();
+    tm.clearAllTracks();
+    const auto source = tm.createTrack("Drums");
+    const auto reverb = tm.createTrack("Reverb", TrackType::Aux);
+    const auto delay = tm.createTrack("Delay", TrackType::Aux);
+    tm.addSend(source, reverb);
+    tm.addSend(source, delay);
+
+    tm.setSendLevel(source, 1, 0.25f);
+    tm.setSendPreFader(source, 1, true);
+    tm.setSendLevel(source, 0, 5.0f);  // Fader range at most
+    tm.setSendLevel(source, 2, 0.1f);  // No such send
+
+    const auto* track = tm.getTrack(source);
+    REQUIRE(track->sends[0].level == 2.0f);
+    REQUIRE(track->sends[1].level == 0.25f);
+    REQUIRE(track->sends[1].preFader);
+
+    tm.removeSend(source, 0);
+    REQUIRE(track->sends.size() == 1);
+    REQUIRE(track->sends[0].destinationId == delay);
+
+    tm.clearAllTracks();
+}
@@ -0,0 +1,79 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <vector>
+
+#include "../magda/daw/core/TrackManager.hpp"
+
+using namespace magda;
+
+namespace {
+
+std::vector<TrackId> toVector(std::span<const TrackId> ids) {
+    return {ids.begin(), ids.end()};
+}
+
+}  // namespace
+
+// ============================================================================
+// Cached view and hierarchy queries
+// ============================================================================
+
+TEST_CASE("TrackManager - Visible track lists follow edits", "[tracks][index]") {
+    auto& tm = TrackManager::getInstance();
+    tm.clearAllTracks();
+    const auto a = tm.createTrack("A");
+    const auto group = tm.createGroupTrack("Group");
+    const auto b = tm.createTrack("B");
+
+    REQUIRE(toVector(tm.getVisibleTracks(ViewMode::Arrange)) == std::vector<TrackId>{a, group, b});
+    REQUIRE(toVector(tm.getVisibleTopLevelTracks(ViewMode::Arrange)) ==
+            std::vector<TrackId>{a, group, b});
+
+    auto version = tm.getStructureVersion();
+    tm.addTrackToGroup(b, group);
+    REQUIRE(tm.getStructureVersion() != version);
+    REQUIRE(toVector(tm.getVisibleTopLevelTracks(ViewMode::Arrange)) ==
+            std::vector<TrackId>{a, group});
+    REQUIRE(toVector(tm.getVisibleTracks(ViewMode::Arrange)) == std::vector<TrackId>{a, group, b});
+
+    // Hidden in one view only
+    version = tm.getStructureVersion();
+    tm.setTrackVisible(a, ViewMode::Mix, false);
+    REQUIRE(tm.getStructureVersion() != version);
+    REQUIRE(toVector(tm.getVisibleTracks(ViewMode::Mix)) == std::vector<TrackId>{group, b});
+    REQUIRE(toVector(tm.getVisibleTracks(ViewMode::Arrange)) == std::vector<TrackId>{a, group, b});
+
+    tm.moveTrack(a, 2);
+    REQUIRE(toVector(tm.getVisibleTracks(ViewMode::Arrange)) == std::vector<TrackId>{group, b, a});
+
+    tm.deleteTrack(group);  // Takes its children with it
+    REQUIRE(toVector(tm.getVisibleTracks(ViewMode::Arrange)) == std::vector<TrackId>{a});
+    REQUIRE(toVector(tm.getTopLevelTracks()) == std::vector<TrackId>{a});
+
+    tm.clearAllTracks();
+    REQUIRE(tm.getVisibleTracks(ViewMode::Arrange).empty());
+}
+
+TEST_CASE("TrackManager - Descendants follow regrouping", "[tracks][index]") {
+    auto& tm = TrackManager::getInstance();
+    tm.clearAllTracks();
+    const auto outer = tm.createGroupTrack("Outer");
+    const auto inner = tm.createTrackInGroup(outer, "Inner");
+    const auto leaf = tm.createTrack("Leaf");
+
+    REQUIRE(toVector(tm.getChildTracks(outer)) == std::vector<TrackId>{inner});
+    REQUIRE(toVector(tm.getAllDescendants(outer)) == std::vector<TrackId>{inner});
+    REQUIRE(tm.getChildTracks(leaf).empty());
+    REQUIRE(tm.getAllDescendants(INVALID_TRACK_ID).empty());
+
+    tm.addTrackToGroup(leaf, outer);
+    auto descendants = toVector(tm.getAllDescendants(outer));
+    std::sort(descendants.begin(), descendants.end());
+    REQUIRE(descendants == std::vector<TrackId>{inner, leaf});
+
+    tm.removeTrackFromGroup(inner);
+    REQUIRE(toVector(tm.getAllDescendants(outer)) == std::vector<TrackId>{leaf});
+
+    tm.clearAllTracks();
+}
@@ -0,0 +1,137 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "../magda/daw/profiling/UIFrameProfiler.hpp"
+
+using namespace magda;
+using Catch::Approx;
+
+namespace {
+
+struct ProfilerFixture {
+    UIFrameProfiler& profiler = UIFrameProfiler::getInstance();
+    UIFrameProfiler::SourceId outer = profiler.registerSource("Test.Outer");
+    UIFrameProfiler::SourceId inner = profiler.registerSource("Test.Inner");
+
+    ProfilerFixture() {
+        profiler.reset();
+        profiler.setFrameBudgetMs(16.0);
+    }
+    ~ProfilerFixture() {
+        profiler.reset();
+        profiler.setFrameBudgetMs(1000.0 / 60.0);
+    }
+
+    UIFrameProfiler::SourceStats stats(UIFrameProfiler::SourceId id) const {
+        return profiler.getSourceStats()[static_cast<size_t>(id)];
+    }
+};
+
+}  // namespace
+
+// ============================================================================
+// UIFrameProfiler Tests
+// ============================================================================
+
+TEST_CASE("UIFrameProfiler - Registering a name twice shares the entry", "[profiling][ui]") {
+    auto& profiler = UIFrameProfiler::getInstance();
+    const auto id = profiler.registerSource("Test.Shared");
+    REQUIRE(profiler.registerSource("Test.Shared") == id);
+    REQUIRE(profiler.getSourceStats()[static_cast<size_t>(id)].name == "Test.Shared");
+}
+
+TEST_CASE("UIFrameProfiler - Outermost span is a frame, inner spans are attributed",
+          "[profiling][ui]") {
+    ProfilerFixture f;
+
+    f.profiler.beginPaint(f.outer, 0.0);
+    f.profiler.beginPaint(f.inner, 1.0);
+    f.profiler.endPaint(f.inner, 5.0);
+    f.profiler.endPaint(f.outer, 6.0);
+
+    const auto frames = f.profiler.getFrameStats();
+    REQUIRE(frames.frames == 1);
+    REQUIRE(frames.droppedFrames == 0);
+    REQUIRE(frames.lastMs == Approx(6.0));
+
+    REQUIRE(f.stats(f.outer).paints == 1);
+    REQUIRE(f.stats(f.outer).lastMs == Approx(6.0));
+    REQUIRE(f.stats(f.inner).paints == 1);
+    REQUIRE(f.stats(f.inner).lastMs == Approx(4.0));
+}
+
+TEST_CASE("UIFrameProfiler - Slow frames are blamed on the most self time",
+          "[profiling][ui]") {
+    ProfilerFixture f;
+
+    SECTION("Inner view over budget") {
+        f.profiler.beginPaint(f.outer, 0.0);
+        f.profiler.beginPaint(f.inner, 1.0);
+        f.profiler.endPaint(f.inner, 21.0);
+        f.profiler.endPaint(f.outer, 22.0);
+
+        REQUIRE(f.profiler.getFrameStats().droppedFrames == 1);
+        REQUIRE(f.stats(f.inner).slowFrames == 1);
+        REQUIRE(f.stats(f.outer).slowFrames == 0);
+    }
+
+    SECTION("Container slow around a quick child") {
+        f.profiler.beginPaint(f.outer, 0.0);
+        f.profiler.beginPaint(f.inner, 1.0);
+        f.profiler.endPaint(f.inner, 2.0);
+        f.profiler.endPaint(f.outer, 30.0);
+
+        REQUIRE(f.stats(f.outer).slowFrames == 1);
+        REQUIRE(f.stats(f.inner).slowFrames == 0);
+    }
+
+    SECTION("Worst offenders put dropped frames first") {
+        f.profiler.beginPaint(f.inner, 0.0);
+        f.profiler.endPaint(f.inner, 20.0);
+        f.profiler.beginPaint(f.outer, 30.0);
+        f.profiler.endPaint(f.outer, 45.0);  // Slower single paint, but within budget
+
+        const auto worst = f.profiler.getWorstOffenders(1);
+        REQUIRE(worst.size() == 1);
+        REQUIRE(worst[0].name == "Test.Inner");
+    }
+}
+
+TEST_CASE("UIFrameProfiler - Unbalanced spans don't corrupt the stack", "[profiling][ui]") {
+    ProfilerFixture f;
+
+    SECTION("End without begin (paint() skipped) is ignored") {
+        f.profiler.endPaint(f.outer, 5.0);
+        REQUIRE(f.profiler.getFrameStats().frames == 0);
+        REQUIRE(f.stats(f.outer).paints == 0);
+    }
+
+    SECTION("Closing the outer span drops an inner span left open") {
+        f.profiler.beginPaint(f.outer, 0.0);
+        f.profiler.beginPaint(f.inner, 1.0);
+        f.profiler.endPaint(f.outer, 4.0);
+        REQUIRE(f.profiler.getFrameStats().frames == 1);
+
+        // The next frame starts from an empty stack
+        f.profiler.beginPaint(f.inner, 10.0);
+        f.profiler.endPaint(f.inner, 12.0);
+        REQUIRE(f.profiler.getFrameStats().frames == 2);
+        REQUIRE(f.stats(f.inner).lastMs == Approx(2.0));
+    }
+}
+
+TEST_CASE("UIFrameProfiler - Message latency and reset", "[profiling][ui]") {
+    ProfilerFixture f;
+
+    f.profiler.recordMessageLatency(2.0);
+    f.profiler.recordMessageLatency(6.0);
+    auto frames = f.profiler.getFrameStats();
+    REQUIRE(frames.latencySamples == 2);
+    REQUIRE(frames.getAverageLatencyMs() == Approx(4.0));
+    REQUIRE(frames.latencyMaxMs == Approx(6.0));
+
+    f.profiler.reset();
+    frames = f.profiler.getFrameStats();
+    REQUIRE(frames.latencySamples == 0);
+    REQUIRE(f.stats(f.outer).name == "Test.Outer");
+}
@@ -0,0 +1,325 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <memory>
+#include <vector>
+
+#include "magda/daw/core/UndoManager.hpp"
+
+/**
+ * Tests for UndoManager history limits
+ *
+ * These tests verify:
+ * - The step limit drops the oldest commands
+ * - The memory budget drops the oldest commands but always keeps the newest
+ * - History size accounting follows undo, redo and new commands
+ * - Mergeable commands collapse per gesture, not across gestures
+ * - Old steps past the resident budget spill to disk and come back when undone
+ */
+
+namespace {
+
+// Command that only reports a size and records how far it got
+class SizedCommand : public magda::UndoableCommand {
+  public:
+    SizedCommand(size_t bytes, int& counter) : bytes_(bytes), counter_(counter) {}
+
+    void execute() override {
+        ++counter_;
+    }
+    void undo() override {
+        --counter_;
+    }
+    juce::String getDescription() const override {
+        return "Sized";
+    }
+    size_t getSizeInBytes() const override {
+        return bytes_;
+    }
+
+  private:
+    size_t bytes_;
+    int& counter_;
+};
+
+// Sets a value on a target; successive sets of the same target merge
+class SetValueCommand : public magda::UndoableCommand {
+  public:
+    SetValueCommand(int target, int value, std::vector<int>& values)
+        : target_(target), newValue_(value), values_(values) {}
+
+    void execute() override {
+        oldValue_ = executed_ ? oldValue_ : values_[static_cast<size_t>(target_)];
+        executed_ = true;
+        values_[static_cast<size_t>(target_)] = newValue_;
+    }
+    void undo() override {
+        values_[static_cast<size_t>(target_)] = oldValue_;
+    }
+    juce::String getDescription() const override {
+        return "Set Value";
+    }
+    bool canMergeWith(const magda::UndoableCommand* other) const override {
+        auto* set = dynamic_cast<const SetValueCommand*>(other);
+        return set != nullptr && set->target_ == target_;
+    }
+    void mergeWith(const magda::UndoableCommand* other) override {
+        newValue_ = static_cast<const SetValueCommand*>(other)->newValue_;
+    }
+
+  private:
+    int target_;
+    int newValue_;
+    int oldValue_ = 0;
+    bool executed_ = false;
+    std::vector<int>& values_;
+};
+
+// Holds a payload it can spill; undo records the payload it had
+class PayloadCommand : public magda::UndoableCommand {
+  public:
+    PayloadCommand(char fill, size_t bytes, std::vector<juce::String>& undone)
+        : payload_(bytes, fill), undone_(undone) {}
+
+    void execute() override {}
+    void undo() override {
+        undone_.push_back(juce::String(payload_.data(), payload_.size()));
+    }
+    juce::String getDescription() const override {
+        return "Payload";
+    }
+    size_t getSizeInBytes() const override {
+        return payload_.size();
+    }
+    bool spillState(juce::OutputStream& out) override {
+        out.writeInt64(static_cast<juce::int64>(payload_.size()));
+        out.write(payload_.data(), payload_.size());
+        std::vector<char>().swap(payload_);
+        return true;
+    }
+    void restoreState(juce::InputStream& in) override {
+        payload_.resize(static_cast<size_t>(in.readInt64()));
+        in.read(payload_.data(), static_cast<int>(payload_.size()));
+    }
+
+  private:
+    std::vector<char> payload_;
+    std::vector<juce::String>& undone_;
+};
+
+class CountingListener : public magda::UndoManagerListener {
+  public:
+    void undoStateChanged() override {
+        ++count;
+    }
+    int count = 0;
+};
+
+size_t countUndoSteps(magda::UndoManager& undoManager) {
+    size_t steps = 0;
+    while (undoManager.undo()) {
+        ++steps;
+    }
+    return steps;
+}
+
+}  // namespace
+
+TEST_CASE("UndoManager - History limits", "[undo]") {
+    using namespace magda;
+
+    auto& undoManager = UndoManager::getInstance();
+    const size_t savedSteps = undoManager.getMaxUndoSteps();
+    const size_t savedBytes = undoManager.getMaxUndoBytes();
+    undoManager.clearHistory();
+
+    int counter = 0;
+
+    SECTION("Step limit drops the oldest commands") {
+        undoManager.setMaxUndoSteps(3);
+        undoManager.setMaxUndoBytes(0);
+        for (int i = 0; i < 5; ++i) {
+            undoManager.executeCommand(std::make_unique<SizedCommand>(10, counter));
+        }
+
+        REQUIRE(counter == 5);
+        REQUIRE(undoManager.getHistorySizeInBytes() == 30);
+
+        int undone = 0;
+        while (undoManager.undo()) {
+            ++undone;
+        }
+        REQUIRE(undone == 3);
+        REQUIRE(counter == 2);
+    }
+
+    SECTION("Memory budget drops the oldest commands") {
+        undoManager.setMaxUndoSteps(100);
+        undoManager.setMaxUndoBytes(1000);
+        for (int i = 0; i < 10; ++i) {
+            undoManager.executeCommand(std::make_unique<SizedCommand>(300, counter));
+        }
+
+        REQUIRE(undoManager.getHistorySizeInBytes() == 900);
+
+        // A single oversized command is still kept
+        undoManager.executeCommand(std::make_unique<SizedCommand>(5000, counter));
+        REQUIRE(undoManager.canUndo());
+        REQUIRE(undoManager.getHistorySizeInBytes() == 5000);
+    }
+
+    SECTION("Accounting follows undo, redo and new commands") {
+        undoManager.setMaxUndoSteps(100);
+        undoManager.setMaxUndoBytes(0);
+        undoManager.executeCommand(std::make_unique<SizedCommand>(100, counter));
+        undoManager.executeCommand(std::make_unique<SizedCommand>(200, counter));
+
+        undoManager.undo();
+        REQUIRE(undoManager.getHistorySizeInBytes() == 300);  // Redo entries still count
+
+        // A new command discards the redo entry
+        undoManager.executeCommand(std::make_unique<SizedCommand>(50, counter));
+        REQUIRE_FALSE(undoManager.canRedo());
+        REQUIRE(undoManager.getHistorySizeInBytes() == 150);
+    }
+
+    undoManager.clearHistory();
+    undoManager.setMaxUndoSteps(savedSteps);
+    undoManager.setMaxUndoBytes(savedBytes);
+}
+
+TEST_CASE("UndoManager - Merging continuous gestures", "[undo]") {
+    using namespace magda;
+
+    auto& undoManager = UndoManager::getInstance();
+    const double savedWindow = undoManager.getMergeWindowMs();
+    undoManager.clearHistory();
+    undoManager.setMergeWindowMs(0.0);  // Only explicit gestures merge, so timing can't matter
+
+    std::vector<int> values(2, 0);
+
+    SECTION("A gesture on one target is one undo step") {
+        undoManager.beginGesture();
+        for (int i = 1; i <= 20; ++i) {
+            undoManager.executeCommand(std::make_unique<SetValueCommand>(0, i, values));
+        }
+        undoManager.endGesture();
+
+        REQUIRE(values[0] == 20);
+        REQUIRE(undoManager.getHistorySizeInBytes() == UndoableCommand::DEFAULT_COMMAND_BYTES);
+        REQUIRE(countUndoSteps(undoManager) == 1);
+        REQUIRE(values[0] == 0);
+    }
+
+    SECTION("Separate gestures and other targets stay separate") {
+        for (int gesture = 0; gesture < 2; ++gesture) {
+            undoManager.beginGesture();
+            undoManager.executeCommand(std::make_unique<SetValueCommand>(0, gesture + 1, values));
+            undoManager.executeCommand(std::make_unique<SetValueCommand>(0, gesture + 5, values));
+            undoManager.endGesture();
+        }
+        undoManager.beginGesture();
+        undoManager.executeCommand(std::make_unique<SetValueCommand>(0, 9, values));
+        undoManager.executeCommand(std::make_unique<SetValueCommand>(1, 9, values));
+        undoManager.endGesture();
+
+        REQUIRE(undoManager.undo());
+        REQUIRE(values[1] == 0);
+        REQUIRE(values[0] == 9);
+        REQUIRE(undoManager.undo());
+        REQUIRE(values[0] == 6);
+        REQUIRE(countUndoSteps(undoManager) == 2);
+        REQUIRE(values[0] == 0);
+    }
+
+    SECTION("Commands outside a gesture merge only within the window") {
+        undoManager.executeCommand(std::make_unique<SetValueCommand>(0, 1, values));
+        undoManager.executeCommand(std::make_unique<SetValueCommand>(0, 2, values));
+        REQUIRE(countUndoSteps(undoManager) == 2);
+
+        undoManager.clearHistory();
+        undoManager.setMergeWindowMs(60000.0);
+        undoManager.executeCommand(std::make_unique<SetValueCommand>(0, 1, values));
+        undoManager.executeCommand(std::make_unique<SetValueCommand>(0, 2, values));
+        REQUIRE(countUndoSteps(undoManager) == 1);
+    }
+
+    SECTION("Undo ends the gesture") {
+        undoManager.executeCommand(std::make_unique<SetValueCommand>(0, 1, values));
+        undoManager.beginGesture();
+        undoManager.executeCommand(std::make_unique<SetValueCommand>(0, 2, values));
+        undoManager.undo();
+        undoManager.executeCommand(std::make_unique<SetValueCommand>(0, 3, values));
+        undoManager.endGesture();
+
+        // The set after the undo didn't fold into the first command
+        REQUIRE(undoManager.undo());
+        REQUIRE(values[0] == 1);
+        REQUIRE(countUndoSteps(undoManager) == 1);
+        REQUIRE(values[0] == 0);
+    }
+
+    SECTION("Listeners hear about a gesture once") {
+        CountingListener listener;
+        undoManager.addListener(&listener);
+        undoManager.beginGesture();
+        for (int i = 1; i <= 10; ++i) {
+            undoManager.executeCommand(std::make_unique<SetValueCommand>(0, i, values));
+        }
+        undoManager.endGesture();
+        undoManager.removeListener(&listener);
+
+        REQUIRE(listener.count == 1);
+    }
+
+    undoManager.clearHistory();
+    undoManager.setMergeWindowMs(savedWindow);
+}
+
+TEST_CASE("UndoManager - Spilling old steps to disk", "[undo]") {
+    using namespace magda;
+
+    auto& undoManager = UndoManager::getInstance();
+    const size_t savedSteps = undoManager.getMaxUndoSteps();
+    const size_t savedBytes = undoManager.getMaxUndoBytes();
+    const size_t savedResident = undoManager.getMaxResidentBytes();
+    undoManager.clearHistory();
+    undoManager.setMaxUndoSteps(100);
+    undoManager.setMaxUndoBytes(0);
+    undoManager.setMaxResidentBytes(2500);
+
+    std::vector<juce::String> undone;
+    const char fills[] = {'a', 'b', 'c', 'd', 'e'};
+    for (char fill : fills) {
+        undoManager.executeCommand(std::make_unique<PayloadCommand>(fill, 1000, undone));
+    }
+
+    SECTION("Oldest steps spill until the history fits") {
+        REQUIRE(undoManager.getNumSpilledSteps() == 3);
+        REQUIRE(undoManager.getHistorySizeInBytes() == 2000);
+        REQUIRE(undoManager.getSpilledBytes() > 3000);
+    }
+
+    SECTION("Spilled steps are paged back in when undone") {
+        while (undoManager.undo()) {
+        }
+        REQUIRE(undone.size() == 5);
+        for (size_t i = 0; i < undone.size(); ++i) {
+            const auto fill = juce::String::charToString(fills[4 - i]);
+            REQUIRE(undone[i] == juce::String::repeatedString(fill, 1000));
+        }
+        REQUIRE(undoManager.getNumSpilledSteps() == 0);
+        REQUIRE(undoManager.getSpilledBytes() == 0);
+    }
+
+    SECTION("Dropped steps release their spilled state") {
+        undoManager.clearHistory();
+        REQUIRE(undoManager.getNumSpilledSteps() == 0);
+        REQUIRE(undoManager.getSpilledBytes() == 0);
+        REQUIRE(undoManager.getHistorySizeInBytes() == 0);
+    }
+
+    undoManager.clearHistory();
+    undoManager.setMaxResidentBytes(savedResident);
+    undoManager.setMaxUndoSteps(savedSteps);
+    undoManager.setMaxUndoBytes(savedBytes);
+}